@@ -0,0 +1,525 @@
+// ------------------------- OpenPose C API -------------------------
+// See include/openpose/c/openpose_c.h
+
+#include <openpose/c/openpose_c.h>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <opencv2/core/core.hpp>
+// Command-line user interface
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+
+namespace op
+{
+    // OPC_FIELD_FACE_RECTANGLES is a view of std::vector<Rectangle<float>>
+    static_assert(sizeof(Rectangle<float>) == 4 * sizeof(float), "Rectangle<float> must be 4 consecutive floats.");
+
+    // Last error of each thread (see opc_last_error())
+    thread_local std::string tLastError;
+
+    // Lease of the pixels of a submitted frame (Datum::inputDataLease), it calls the user callback once released
+    struct OpcInputLease
+    {
+        OpcInputReleasedCallback callback;
+        void* userData;
+
+        ~OpcInputLease()
+        {
+            if (callback != nullptr)
+                callback(userData);
+        }
+    };
+
+    OpcStatus setLastError(const OpcStatus status, const std::string& message)
+    {
+        tLastError = message;
+        return status;
+    }
+
+    void configureWrapper(Wrapper& opWrapper)
+    {
+        try
+        {
+            // logging_level
+            checkBool(
+                0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+                __LINE__, __FUNCTION__, __FILE__);
+            ConfigureLog::setPriorityThreshold((Priority)FLAGS_logging_level);
+            ConfigureLog::setAsynchronous(FLAGS_logging_async);
+            Profiler::setDefaultX(FLAGS_profile_speed);
+
+            // Applying user defined configuration - GFlags to program variables
+            // outputSize
+            const auto outputSize = flagsToPoint(op::String(FLAGS_output_resolution), "-1x-1");
+            // netInputSize
+            const auto netInputSize = flagsToPoint(op::String(FLAGS_net_resolution), "-1x368");
+            const auto netInputSizeMin = flagsToPoint(op::String(FLAGS_net_resolution_min), "-1x256");
+            const auto tiledInputSize = flagsToPoint(op::String(FLAGS_tiled_resolution), "-1x2160");
+            // faceNetInputSize
+            const auto faceNetInputSize = flagsToPoint(
+                op::String(FLAGS_face_net_resolution), "368x368 (multiples of 16)");
+            // faceDetectorNetInputSize
+            const auto faceDetectorNetInputSize = flagsToPoint(
+                op::String(FLAGS_face_detector_net_resolution), "-1x256 (multiples of 32)");
+            // handNetInputSize
+            const auto handNetInputSize = flagsToPoint(
+                op::String(FLAGS_hand_net_resolution), "368x368 (multiples of 16)");
+            // poseMode
+            const auto poseMode = flagsToPoseMode(FLAGS_body);
+            // poseModel
+            const auto poseModel = flagsToPoseModel(op::String(FLAGS_model_pose));
+            // JSON saving
+            if (!FLAGS_write_keypoint.empty())
+                opLog("Flag `write_keypoint` is deprecated and will eventually be removed."
+                        " Please, use `write_json` instead.", Priority::Max);
+            // keypointScaleMode
+            const auto keypointScaleMode = flagsToScaleMode(FLAGS_keypoint_scale);
+            // heatmaps to add
+            const auto heatMapTypes = flagsToHeatMaps(FLAGS_heatmaps_add_parts, FLAGS_heatmaps_add_bkg,
+                                                          FLAGS_heatmaps_add_PAFs);
+            const auto heatMapScaleMode = flagsToHeatMapScaleMode(FLAGS_heatmaps_scale);
+            // >1 camera view?
+            const auto multipleView = (FLAGS_3d || FLAGS_3d_views > 1);
+            // Face and hand detectors
+            const auto faceDetector = flagsToDetector(FLAGS_face_detector);
+            const auto handDetector = flagsToDetector(FLAGS_hand_detector);
+            // Enabling Google Logging
+            const bool enableGoogleLogging = true;
+
+            // Pose configuration (use WrapperStructPose{} for default and recommended configuration)
+            const op::WrapperStructPose wrapperStructPose{
+                poseMode, netInputSize, FLAGS_net_resolution_dynamic, outputSize, keypointScaleMode, FLAGS_num_gpu,
+                FLAGS_num_gpu_start, FLAGS_scale_number, (float)FLAGS_scale_gap,
+                op::flagsToRenderMode(FLAGS_render_pose, multipleView), poseModel, !FLAGS_disable_blending,
+                (float)FLAGS_alpha_pose, (float)FLAGS_alpha_heatmap, FLAGS_part_to_show, op::String(FLAGS_model_folder),
+                heatMapTypes, heatMapScaleMode, FLAGS_part_candidates, (float)FLAGS_render_threshold,
+                FLAGS_number_people_max, FLAGS_maximize_positives, FLAGS_fps_max, op::String(FLAGS_prototxt_path),
+                op::String(FLAGS_caffemodel_path), (float)FLAGS_upsampling_ratio, enableGoogleLogging,
+                FLAGS_batch_size, FLAGS_batch_max_wait, FLAGS_tensorrt_precision,
+                FLAGS_heatmaps_fp16, FLAGS_latency_target, netInputSizeMin, FLAGS_roi_tracking_interval,
+                FLAGS_scale_batch, FLAGS_motion_gate, FLAGS_motion_gate_pixel_threshold,
+                FLAGS_motion_gate_max_skip, FLAGS_cuda_graphs, FLAGS_pose_pipelined,
+                FLAGS_paf_low_resolution, FLAGS_heatmaps_lazy, op::String(FLAGS_net_output_cache),
+                FLAGS_gpu_memory_budget, FLAGS_warm_up, op::String(FLAGS_warm_up_cache),
+                FLAGS_net_memory_sharing, tiledInputSize, (float)FLAGS_tile_overlap, FLAGS_net_stages,
+                (float)FLAGS_scale_adaptive, FLAGS_pose_shared_pool, op::String(FLAGS_cuda_autotune_cache),
+                (float)FLAGS_heatmaps_sparse_threshold};
+            opWrapper.configure(wrapperStructPose);
+            // Face configuration (use WrapperStructFace{} to disable it)
+            const WrapperStructFace wrapperStructFace{
+                FLAGS_face, faceDetector, faceNetInputSize,
+                flagsToRenderMode(FLAGS_face_render, multipleView, FLAGS_render_pose),
+                (float)FLAGS_face_alpha_pose, (float)FLAGS_face_alpha_heatmap, (float)FLAGS_face_render_threshold,
+                faceDetectorNetInputSize, FLAGS_face_detector_scale_number, FLAGS_face_hand_roi_cache,
+                FLAGS_face_hand_adaptive_crop, (float)FLAGS_face_hand_from_body, true,
+                FLAGS_face_hand_lazy_idle_s};
+            opWrapper.configure(wrapperStructFace);
+            // Hand configuration (use WrapperStructHand{} to disable it)
+            const WrapperStructHand wrapperStructHand{
+                FLAGS_hand, handDetector, handNetInputSize, FLAGS_hand_scale_number, (float)FLAGS_hand_scale_range,
+                flagsToRenderMode(FLAGS_hand_render, multipleView, FLAGS_render_pose), (float)FLAGS_hand_alpha_pose,
+                (float)FLAGS_hand_alpha_heatmap, (float)FLAGS_hand_render_threshold,
+                FLAGS_face_hand_concurrent, FLAGS_face_hand_roi_cache, FLAGS_face_hand_adaptive_crop,
+                (float)FLAGS_face_hand_from_body, true, FLAGS_face_hand_lazy_idle_s};
+            opWrapper.configure(wrapperStructHand);
+            // Extra functionality configuration (use WrapperStructExtra{} to disable it)
+            const auto gpuThreadPriority = flagsToThreadPriority(FLAGS_gpu_thread_priority);
+            // Person crops (disabled if empty)
+            const auto personCropSize = (FLAGS_person_crops.empty()
+                ? Point<int>{0,0} : flagsToPoint(String(FLAGS_person_crops), "192x256"));
+            const WrapperStructExtra wrapperStructExtra{
+                FLAGS_3d, FLAGS_3d_min_views, FLAGS_identification, FLAGS_tracking, FLAGS_ik_threads,
+                FLAGS_thread_pool, FLAGS_gpu_numa_affinity, gpuThreadPriority, FLAGS_cpu_worker_threads,
+                FLAGS_gpu_dispatch, FLAGS_reorder_window_ms, FLAGS_tracking_extrapolation,
+                FLAGS_3d_multi_person, FLAGS_auto_configure, personCropSize, (float)FLAGS_person_crops_scale,
+                FLAGS_person_crops_align, FLAGS_person_crops_download, FLAGS_face_hand_gpu, FLAGS_spillover_workers,
+                op::String(FLAGS_spillover_model), FLAGS_spillover_queue, FLAGS_3d_temporal, FLAGS_3d_gpu_affinity,
+                flagsToQueueType(FLAGS_queue_type)};
+            opWrapper.configure(wrapperStructExtra);
+            // Output (comment or use default argument to disable any output)
+            const WrapperStructOutput wrapperStructOutput{
+                FLAGS_cli_verbose, op::String(FLAGS_write_keypoint),
+                op::stringToDataFormat(FLAGS_write_keypoint_format),
+                op::String(FLAGS_write_json), op::String(FLAGS_write_coco_json), FLAGS_write_coco_json_variants,
+                FLAGS_write_coco_json_variant, op::String(FLAGS_write_images), op::String(FLAGS_write_images_format),
+                op::String(FLAGS_write_video), FLAGS_write_video_fps, FLAGS_write_video_with_audio,
+                op::String(FLAGS_write_heatmaps), op::String(FLAGS_write_heatmaps_format),
+                op::String(FLAGS_write_video_3d),
+                op::String(FLAGS_write_video_adam), op::String(FLAGS_write_bvh), op::String(FLAGS_udp_host),
+                op::String(FLAGS_udp_port), FLAGS_metrics_port, op::String(FLAGS_trace_file),
+                op::String(FLAGS_write_binary), FLAGS_write_threads,
+                op::String(FLAGS_write_video_encoder), op::String(FLAGS_stream_keypoints_udp),
+                op::String(FLAGS_stream_keypoints_shm), op::String(FLAGS_write_coco_json_eval),
+                FLAGS_write_jpg_gpu, op::String(FLAGS_stream_video),
+                op::String(FLAGS_stream_video_encoder), (float)FLAGS_stream_keypoints_precision,
+                (float)FLAGS_stream_keypoints_precision_3d, FLAGS_stream_keypoints_keyframe,
+                FLAGS_allocation_metrics, false, op::String(FLAGS_datum_send),
+                op::flagsToDatumWireFields(op::String(FLAGS_datum_send_fields)), FLAGS_datum_send_jpeg_quality,
+                FLAGS_datum_timing};
+            opWrapper.configure(wrapperStructOutput);
+            // No producer, GUI nor display (the frames are submitted and popped by the user)
+            // Set to single-thread (for sequential processing and/or debugging and/or reducing latency)
+            if (FLAGS_disable_multi_thread)
+                opWrapper.disableMultiThreading();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename T>
+    void fillTensor(OpcTensor& tensor, const Array<T>& array, const OpcElementType elementType)
+    {
+        const auto numberDimensions = std::min((int)array.getNumberDimensions(), OPC_MAX_DIMENSIONS);
+        if (array.empty() || numberDimensions < (int)array.getNumberDimensions())
+            return;
+        tensor.data = array.getConstPtr();
+        tensor.elementType = elementType;
+        tensor.numberDimensions = numberDimensions;
+        auto stride = (int64_t)sizeof(T);
+        for (auto i = numberDimensions - 1 ; i >= 0 ; i--)
+        {
+            tensor.sizes[i] = array.getSize(i);
+            tensor.strides[i] = stride;
+            stride *= tensor.sizes[i];
+        }
+        tensor.byteSize = stride;
+    }
+}
+
+// Opaque handles of openpose_c.h
+struct OpcWrapper
+{
+    std::unique_ptr<op::Wrapper> upWrapper;
+    op::DatumPool<op::Datum> datumPool;
+    const unsigned long long maxInFlight;
+    std::mutex mutex;
+    std::condition_variable conditionVariable;
+    unsigned long long inFlight;
+    bool stopped;
+
+    explicit OpcWrapper(const unsigned long long maxInFlight_) :
+        upWrapper{new op::Wrapper{op::ThreadManagerMode::Asynchronous}},
+        // The Datums of the results released by the user are recycled
+        datumPool{maxInFlight_},
+        maxInFlight{maxInFlight_},
+        inFlight{0ull},
+        stopped{false}
+    {
+    }
+};
+
+struct OpcResult
+{
+    // It keeps its Datum (and so the memory its tensors point to) alive
+    std::shared_ptr<std::vector<std::shared_ptr<op::Datum>>> datumsPtr;
+};
+
+extern "C"
+{
+    int32_t opc_get_api_version(void)
+    {
+        return OPC_API_VERSION;
+    }
+
+    const char* opc_last_error(void)
+    {
+        return op::tLastError.c_str();
+    }
+
+    OpcStatus opc_wrapper_create(OpcWrapper** wrapper, int32_t argc, const char* const* argv, int32_t maxInFlight)
+    {
+        try
+        {
+            if (wrapper == nullptr || argc < 0 || (argc > 0 && argv == nullptr))
+                return op::setLastError(OPC_INVALID_ARGUMENT, "opc_wrapper_create: Invalid arguments.");
+            *wrapper = nullptr;
+            // Flags (gflags skips argv[0])
+            std::vector<std::string> arguments{"openpose_c"};
+            for (auto i = 0 ; i < argc ; i++)
+                arguments.emplace_back(argv[i] == nullptr ? "" : argv[i]);
+            std::vector<char*> argumentPtrs;
+            for (auto& argument : arguments)
+                argumentPtrs.emplace_back(&argument[0]);
+            auto size = (int)argumentPtrs.size();
+            auto** argumentsPtr = argumentPtrs.data();
+            gflags::ParseCommandLineFlags(&size, &argumentsPtr, true);
+            // Frames in flight
+            auto finalMaxInFlight = maxInFlight;
+            if (finalMaxInFlight <= 0)
+            {
+                const auto numberGpus = (FLAGS_num_gpu < 0 ? op::getGpuNumber() : FLAGS_num_gpu);
+                finalMaxInFlight = 2 * std::max(1, numberGpus) * std::max(1, FLAGS_batch_size);
+            }
+            std::unique_ptr<OpcWrapper> opcWrapper{new OpcWrapper{(unsigned long long)finalMaxInFlight}};
+            op::configureWrapper(*opcWrapper->upWrapper);
+            *wrapper = opcWrapper.release();
+            return OPC_OK;
+        }
+        catch (const std::exception& e)
+        {
+            return op::setLastError(OPC_ERROR, e.what());
+        }
+    }
+
+    OpcStatus opc_wrapper_start(OpcWrapper* wrapper)
+    {
+        try
+        {
+            if (wrapper == nullptr)
+                return op::setLastError(OPC_INVALID_ARGUMENT, "opc_wrapper_start: Null wrapper.");
+            {
+                const std::lock_guard<std::mutex> lock{wrapper->mutex};
+                wrapper->stopped = false;
+            }
+            wrapper->upWrapper->start();
+            return OPC_OK;
+        }
+        catch (const std::exception& e)
+        {
+            return op::setLastError(OPC_ERROR, e.what());
+        }
+    }
+
+    OpcStatus opc_wrapper_stop(OpcWrapper* wrapper)
+    {
+        try
+        {
+            if (wrapper == nullptr)
+                return op::setLastError(OPC_INVALID_ARGUMENT, "opc_wrapper_stop: Null wrapper.");
+            {
+                const std::lock_guard<std::mutex> lock{wrapper->mutex};
+                wrapper->stopped = true;
+            }
+            wrapper->conditionVariable.notify_all();
+            wrapper->upWrapper->stop();
+            return OPC_OK;
+        }
+        catch (const std::exception& e)
+        {
+            return op::setLastError(OPC_ERROR, e.what());
+        }
+    }
+
+    void opc_wrapper_destroy(OpcWrapper* wrapper)
+    {
+        try
+        {
+            if (wrapper != nullptr)
+            {
+                opc_wrapper_stop(wrapper);
+                delete wrapper;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            op::setLastError(OPC_ERROR, e.what());
+        }
+    }
+
+    OpcStatus opc_submit(
+        OpcWrapper* wrapper, const OpcImage* image, uint64_t tag, OpcInputReleasedCallback inputReleased,
+        void* inputReleasedUserData, int32_t wait)
+    {
+        try
+        {
+            if (wrapper == nullptr || image == nullptr || image->data == nullptr || image->width <= 0
+                || image->height <= 0 || (image->rowStride != 0 && image->rowStride < 3ll * image->width))
+                return op::setLastError(OPC_INVALID_ARGUMENT, "opc_submit: Invalid wrapper or image.");
+            // Frames in flight
+            {
+                std::unique_lock<std::mutex> lock{wrapper->mutex};
+                if (wait)
+                    wrapper->conditionVariable.wait(
+                        lock, [wrapper]{ return wrapper->stopped || wrapper->inFlight < wrapper->maxInFlight; });
+                if (wrapper->stopped || !wrapper->upWrapper->isRunning())
+                    return op::setLastError(OPC_STOPPED, "opc_submit: The wrapper is not running.");
+                if (wrapper->inFlight >= wrapper->maxInFlight)
+                    return op::setLastError(OPC_NOT_READY, "opc_submit: Too many frames in flight.");
+                wrapper->inFlight++;
+            }
+            // Datum wrapping the user pixels (not copied)
+            auto datumPtr = wrapper->datumPool.getDatum();
+            const cv::Mat cvInputData(
+                image->height, image->width, CV_8UC3, (void*)image->data,
+                (image->rowStride == 0 ? cv::Mat::AUTO_STEP : (size_t)image->rowStride));
+            datumPtr->cvInputData = OP_CV2OPCONSTMAT(cvInputData);
+            datumPtr->frameNumber = tag;
+            const auto inputLease = std::make_shared<op::OpcInputLease>();
+            inputLease->callback = inputReleased;
+            inputLease->userData = inputReleasedUserData;
+            datumPtr->inputDataLease = inputLease;
+            auto datumsPtr = std::make_shared<std::vector<std::shared_ptr<op::Datum>>>(1, datumPtr);
+            datumPtr.reset();
+            // The input queue is bounded by the frames in flight, so waiting here is rare
+            const auto emplaced = (wait ? wrapper->upWrapper->waitAndEmplace(datumsPtr)
+                                        : wrapper->upWrapper->tryEmplace(datumsPtr));
+            if (!emplaced)
+            {
+                // The user keeps the ownership of the pixels, so the callback is not called
+                inputLease->callback = nullptr;
+                datumsPtr.reset();
+                {
+                    const std::lock_guard<std::mutex> lock{wrapper->mutex};
+                    wrapper->inFlight--;
+                }
+                wrapper->conditionVariable.notify_all();
+                if (!wrapper->upWrapper->isRunning())
+                    return op::setLastError(OPC_STOPPED, "opc_submit: The wrapper is not running.");
+                return op::setLastError(OPC_NOT_READY, "opc_submit: The input queue is full.");
+            }
+            return OPC_OK;
+        }
+        catch (const std::exception& e)
+        {
+            return op::setLastError(OPC_ERROR, e.what());
+        }
+    }
+
+    OpcStatus opc_pop(OpcWrapper* wrapper, OpcResult** result, int32_t wait)
+    {
+        try
+        {
+            if (wrapper == nullptr || result == nullptr)
+                return op::setLastError(OPC_INVALID_ARGUMENT, "opc_pop: Null wrapper or result.");
+            *result = nullptr;
+            std::shared_ptr<std::vector<std::shared_ptr<op::Datum>>> datumsPtr;
+            const auto popped = (wait ? wrapper->upWrapper->waitAndPop(datumsPtr)
+                                      : wrapper->upWrapper->tryPop(datumsPtr));
+            if (!popped || datumsPtr == nullptr || datumsPtr->empty())
+            {
+                if (!wrapper->upWrapper->isRunning())
+                    return op::setLastError(OPC_STOPPED, "opc_pop: The wrapper is not running.");
+                return op::setLastError(OPC_NOT_READY, "opc_pop: No result ready yet.");
+            }
+            {
+                const std::lock_guard<std::mutex> lock{wrapper->mutex};
+                if (wrapper->inFlight > 0)
+                    wrapper->inFlight--;
+            }
+            wrapper->conditionVariable.notify_all();
+            // If no worker released the pixels (e.g., no pose network), they are not read anymore
+            auto& datum = *datumsPtr->at(0);
+            if (datum.inputDataLease != nullptr)
+            {
+                if (!datum.cvOutputData.empty()
+                    && datum.cvOutputData.getConstCvMat() == datum.cvInputData.getConstCvMat())
+                    datum.cvOutputData = datum.cvInputData.clone();
+                datum.cvInputData = op::Matrix{};
+                datum.inputDataLease.reset();
+            }
+            std::unique_ptr<OpcResult> opcResult{new OpcResult{}};
+            opcResult->datumsPtr = std::move(datumsPtr);
+            *result = opcResult.release();
+            return OPC_OK;
+        }
+        catch (const std::exception& e)
+        {
+            return op::setLastError(OPC_ERROR, e.what());
+        }
+    }
+
+    uint64_t opc_result_get_tag(const OpcResult* result)
+    {
+        return (result == nullptr ? 0ull : (uint64_t)result->datumsPtr->at(0)->frameNumber);
+    }
+
+    int32_t opc_result_get_number_people(const OpcResult* result)
+    {
+        return (result == nullptr ? 0 : (int32_t)result->datumsPtr->at(0)->poseKeypoints.getSize(0));
+    }
+
+    OpcStatus opc_result_get_tensor(const OpcResult* result, OpcField field, OpcTensor* tensor)
+    {
+        try
+        {
+            if (result == nullptr || tensor == nullptr)
+                return op::setLastError(OPC_INVALID_ARGUMENT, "opc_result_get_tensor: Null result or tensor.");
+            *tensor = OpcTensor{};
+            const auto& datum = *result->datumsPtr->at(0);
+            switch (field)
+            {
+                case OPC_FIELD_POSE_KEYPOINTS:
+                    op::fillTensor(*tensor, datum.poseKeypoints, OPC_ELEMENT_FLOAT32);
+                    break;
+                case OPC_FIELD_POSE_SCORES:
+                    op::fillTensor(*tensor, datum.poseScores, OPC_ELEMENT_FLOAT32);
+                    break;
+                case OPC_FIELD_POSE_IDS:
+                    op::fillTensor(*tensor, datum.poseIds, OPC_ELEMENT_INT64);
+                    break;
+                case OPC_FIELD_FACE_KEYPOINTS:
+                    op::fillTensor(*tensor, datum.faceKeypoints, OPC_ELEMENT_FLOAT32);
+                    break;
+                case OPC_FIELD_HAND_LEFT_KEYPOINTS:
+                    op::fillTensor(*tensor, datum.handKeypoints[0], OPC_ELEMENT_FLOAT32);
+                    break;
+                case OPC_FIELD_HAND_RIGHT_KEYPOINTS:
+                    op::fillTensor(*tensor, datum.handKeypoints[1], OPC_ELEMENT_FLOAT32);
+                    break;
+                case OPC_FIELD_POSE_KEYPOINTS_3D:
+                    op::fillTensor(*tensor, datum.poseKeypoints3D, OPC_ELEMENT_FLOAT32);
+                    break;
+                case OPC_FIELD_POSE_HEATMAPS:
+                    op::fillTensor(*tensor, datum.poseHeatMaps, OPC_ELEMENT_FLOAT32);
+                    break;
+                case OPC_FIELD_PERSON_CROPS:
+                    op::fillTensor(*tensor, datum.personCrops, OPC_ELEMENT_FLOAT32);
+                    break;
+                case OPC_FIELD_FACE_RECTANGLES:
+                    if (!datum.faceRectangles.empty())
+                    {
+                        tensor->data = datum.faceRectangles.data();
+                        tensor->elementType = OPC_ELEMENT_FLOAT32;
+                        tensor->numberDimensions = 2;
+                        tensor->sizes[0] = (int64_t)datum.faceRectangles.size();
+                        tensor->sizes[1] = 4;
+                        tensor->strides[0] = (int64_t)sizeof(op::Rectangle<float>);
+                        tensor->strides[1] = (int64_t)sizeof(float);
+                        tensor->byteSize = tensor->sizes[0] * tensor->strides[0];
+                    }
+                    break;
+                case OPC_FIELD_OUTPUT_IMAGE:
+                    if (!datum.cvOutputData.empty())
+                    {
+                        const cv::Mat& cvOutputData = OP_OP2CVCONSTMAT(datum.cvOutputData);
+                        if (cvOutputData.type() != CV_8UC3)
+                            return op::setLastError(OPC_ERROR, "opc_result_get_tensor: Unexpected image type.");
+                        tensor->data = cvOutputData.data;
+                        tensor->elementType = OPC_ELEMENT_UINT8;
+                        tensor->numberDimensions = 3;
+                        tensor->sizes[0] = cvOutputData.rows;
+                        tensor->sizes[1] = cvOutputData.cols;
+                        tensor->sizes[2] = 3;
+                        tensor->strides[0] = (int64_t)cvOutputData.step[0];
+                        tensor->strides[1] = 3;
+                        tensor->strides[2] = 1;
+                        tensor->byteSize = tensor->sizes[0] * tensor->strides[0];
+                    }
+                    break;
+                default:
+                    return op::setLastError(OPC_INVALID_ARGUMENT, "opc_result_get_tensor: Unknown field.");
+            }
+            return OPC_OK;
+        }
+        catch (const std::exception& e)
+        {
+            return op::setLastError(OPC_ERROR, e.what());
+        }
+    }
+
+    void opc_result_release(OpcResult* result)
+    {
+        try
+        {
+            delete result;
+        }
+        catch (const std::exception& e)
+        {
+            op::setLastError(OPC_ERROR, e.what());
+        }
+    }
+}
@@ -0,0 +1,62 @@
+# Based on `FindTensorRT.cmake`
+# NVDEC (nvcuvid from the NVIDIA Video Codec SDK + CUDA driver API) and FFmpeg (demuxing)
+
+unset(NVDEC_FOUND)
+unset(NVDEC_INCLUDE_DIRS)
+unset(NVDEC_LIBS)
+
+set(NVDEC_ROOT "" CACHE PATH "NVIDIA Video Codec SDK root folder")
+
+find_path(NVDEC_NVCUVID_INCLUDE_DIR NAMES
+  nvcuvid.h
+  HINTS
+  ${NVDEC_ROOT}/Interface
+  ${NVDEC_ROOT}/include
+  $ENV{NVDEC_ROOT}/Interface
+  $ENV{NVDEC_ROOT}/include
+  ${CUDA_TOOLKIT_ROOT_DIR}/include
+  /usr/include/
+  /usr/local/include/)
+
+find_path(NVDEC_FFMPEG_INCLUDE_DIR NAMES
+  libavformat/avformat.h
+  HINTS
+  /usr/include/x86_64-linux-gnu/
+  /usr/include/aarch64-linux-gnu/
+  /usr/include/ffmpeg/
+  /usr/local/include/)
+
+find_library(NVDEC_NVCUVID_LIB NAMES nvcuvid
+  HINTS
+  ${NVDEC_ROOT}/Lib/linux/stubs/x86_64
+  ${NVDEC_ROOT}/Lib/x64
+  $ENV{NVDEC_ROOT}/Lib/linux/stubs/x86_64
+  /usr/lib/x86_64-linux-gnu/
+  /usr/lib/aarch64-linux-gnu/
+  /usr/local/lib)
+
+find_library(NVDEC_CUDA_DRIVER_LIB NAMES cuda
+  HINTS
+  ${CUDA_TOOLKIT_ROOT_DIR}/lib64/stubs
+  ${CUDA_TOOLKIT_ROOT_DIR}/lib/x64
+  /usr/lib/x86_64-linux-gnu/
+  /usr/lib/aarch64-linux-gnu/
+  /usr/local/lib)
+
+foreach (FFMPEG_COMPONENT avformat avcodec avutil)
+  string(TOUPPER ${FFMPEG_COMPONENT} FFMPEG_COMPONENT_UPPER)
+  find_library(NVDEC_${FFMPEG_COMPONENT_UPPER}_LIB NAMES ${FFMPEG_COMPONENT}
+    HINTS
+    /usr/lib/x86_64-linux-gnu/
+    /usr/lib/aarch64-linux-gnu/
+    /usr/local/lib)
+endforeach (FFMPEG_COMPONENT)
+
+if (NVDEC_NVCUVID_INCLUDE_DIR AND NVDEC_FFMPEG_INCLUDE_DIR AND NVDEC_NVCUVID_LIB AND NVDEC_CUDA_DRIVER_LIB
+    AND NVDEC_AVFORMAT_LIB AND NVDEC_AVCODEC_LIB AND NVDEC_AVUTIL_LIB)
+  set(NVDEC_FOUND 1)
+  set(NVDEC_INCLUDE_DIRS ${NVDEC_NVCUVID_INCLUDE_DIR} ${NVDEC_FFMPEG_INCLUDE_DIR})
+  set(NVDEC_LIBS ${NVDEC_NVCUVID_LIB} ${NVDEC_CUDA_DRIVER_LIB} ${NVDEC_AVFORMAT_LIB} ${NVDEC_AVCODEC_LIB}
+    ${NVDEC_AVUTIL_LIB})
+endif (NVDEC_NVCUVID_INCLUDE_DIR AND NVDEC_FFMPEG_INCLUDE_DIR AND NVDEC_NVCUVID_LIB AND NVDEC_CUDA_DRIVER_LIB
+  AND NVDEC_AVFORMAT_LIB AND NVDEC_AVCODEC_LIB AND NVDEC_AVUTIL_LIB)
@@ -0,0 +1,37 @@
+# Based on `FindSpinnaker.cmake`
+
+unset(TENSORRT_FOUND)
+unset(TENSORRT_INCLUDE_DIRS)
+unset(TENSORRT_LIBS)
+
+set(TENSORRT_ROOT "" CACHE PATH "TensorRT root folder")
+
+find_path(TENSORRT_INCLUDE_DIRS NAMES
+  NvInfer.h
+  HINTS
+  ${TENSORRT_ROOT}/include
+  $ENV{TENSORRT_ROOT}/include
+  /usr/include/x86_64-linux-gnu/
+  /usr/include/aarch64-linux-gnu/
+  /usr/local/include/)
+
+find_library(TENSORRT_INFER_LIB NAMES nvinfer
+  HINTS
+  ${TENSORRT_ROOT}/lib
+  $ENV{TENSORRT_ROOT}/lib
+  /usr/lib/x86_64-linux-gnu/
+  /usr/lib/aarch64-linux-gnu/
+  /usr/local/lib)
+
+find_library(TENSORRT_ONNX_PARSER_LIB NAMES nvonnxparser
+  HINTS
+  ${TENSORRT_ROOT}/lib
+  $ENV{TENSORRT_ROOT}/lib
+  /usr/lib/x86_64-linux-gnu/
+  /usr/lib/aarch64-linux-gnu/
+  /usr/local/lib)
+
+if (TENSORRT_INCLUDE_DIRS AND TENSORRT_INFER_LIB AND TENSORRT_ONNX_PARSER_LIB)
+  set(TENSORRT_FOUND 1)
+  set(TENSORRT_LIBS ${TENSORRT_INFER_LIB} ${TENSORRT_ONNX_PARSER_LIB})
+endif (TENSORRT_INCLUDE_DIRS AND TENSORRT_INFER_LIB AND TENSORRT_ONNX_PARSER_LIB)
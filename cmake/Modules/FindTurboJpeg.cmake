@@ -0,0 +1,27 @@
+# Based on `FindSpinnaker.cmake`
+
+unset(TURBOJPEG_FOUND)
+unset(TURBOJPEG_INCLUDE_DIRS)
+unset(TURBOJPEG_LIBS)
+
+set(TURBOJPEG_ROOT "" CACHE PATH "libjpeg-turbo root folder")
+
+find_path(TURBOJPEG_INCLUDE_DIRS NAMES
+  turbojpeg.h
+  HINTS
+  ${TURBOJPEG_ROOT}/include
+  $ENV{TURBOJPEG_ROOT}/include
+  /usr/include/
+  /usr/local/include/)
+
+find_library(TURBOJPEG_LIBS NAMES turbojpeg
+  HINTS
+  ${TURBOJPEG_ROOT}/lib
+  $ENV{TURBOJPEG_ROOT}/lib
+  /usr/lib/x86_64-linux-gnu/
+  /usr/lib/aarch64-linux-gnu/
+  /usr/local/lib)
+
+if (TURBOJPEG_INCLUDE_DIRS AND TURBOJPEG_LIBS)
+  set(TURBOJPEG_FOUND 1)
+endif (TURBOJPEG_INCLUDE_DIRS AND TURBOJPEG_LIBS)
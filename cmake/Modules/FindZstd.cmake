@@ -0,0 +1,27 @@
+# Based on `FindSpinnaker.cmake`
+
+unset(ZSTD_FOUND)
+unset(ZSTD_INCLUDE_DIRS)
+unset(ZSTD_LIBS)
+
+set(ZSTD_ROOT "" CACHE PATH "Zstandard root folder")
+
+find_path(ZSTD_INCLUDE_DIRS NAMES
+  zstd.h
+  HINTS
+  ${ZSTD_ROOT}/include
+  $ENV{ZSTD_ROOT}/include
+  /usr/include/
+  /usr/local/include/)
+
+find_library(ZSTD_LIBS NAMES zstd
+  HINTS
+  ${ZSTD_ROOT}/lib
+  $ENV{ZSTD_ROOT}/lib
+  /usr/lib/x86_64-linux-gnu/
+  /usr/lib/aarch64-linux-gnu/
+  /usr/local/lib)
+
+if (ZSTD_INCLUDE_DIRS AND ZSTD_LIBS)
+  set(ZSTD_FOUND 1)
+endif (ZSTD_INCLUDE_DIRS AND ZSTD_LIBS)
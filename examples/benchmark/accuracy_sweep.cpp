@@ -0,0 +1,496 @@
+// ------------------------------------- OpenPose Accuracy/Speed Sweep Harness -------------------------------------
+// This binary measures the COCO keypoint accuracy (AP/AR, see CocoEvaluator) and the latency of the body pipeline for
+// every combination of net resolution, number of scales, NMS threshold (PoseProperty::NMSThreshold), connection
+// threshold (PoseProperty::ConnectInterThreshold) and minimum person score (PoseProperty::ConnectMinSubsetScore),
+// without restarting OpenPose for each setting. E.g.:
+//     ./build/examples/benchmark/accuracy_sweep.bin --sweep_image_dir val2017/
+//         --sweep_annotations person_keypoints_val2017.json --sweep_resolutions "-1x256,-1x368,-1x480"
+//         --sweep_nms_thresholds "0.03,0.05,0.1" --sweep_inter_thresholds "0.03,0.05" --sweep_output sweep.json
+// Steps:
+// 1. The body network is loaded once. For each net resolution and number of scales, it runs over the images and its
+//    raw output (1 per scale) is cached in `--sweep_cache_dir` (1 `.opheat` file, see HeatMapBinarySaver, plus a
+//    `.txt` file with the size and network time of each image). Later runs with the same images, model and setting
+//    reuse the cache, so the network does not run again.
+// 2. For each cached setting, the post-processing (resizeAndMerge, nms and connectBodyParts) runs on the cached
+//    outputs for each threshold combination. Each step is only run once for all the combinations sharing it (e.g.,
+//    resizeAndMerge once per image, nms once per NMS threshold).
+// 3. Each combination is evaluated against `--sweep_annotations`, and the report lists its AP/AR and latency, marking
+//    the Pareto-optimal ones (no other setting is both more accurate and faster).
+// Latency: network_ms is the pre-processing and network forward pass (batch 1, measured in step 1), and
+// postprocessing_ms the time of the CPU versions of resizeAndMerge, nms and connectBodyParts (i.e., an upper bound of
+// the CUDA/OpenCL post-processing of the OpenPose pipeline). For end-to-end pipeline measurements, see
+// openpose_bench.
+
+// Third-party dependencies
+#include <opencv2/opencv.hpp>
+// Command-line user interface
+#define OPENPOSE_FLAGS_DISABLE_PRODUCER
+#define OPENPOSE_FLAGS_DISABLE_DISPLAY
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+// Benchmark utilities
+#include "benchmarkUtilities.hpp"
+// C++ std library dependencies
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+// Custom OpenPose flags
+// Sweep
+DEFINE_string(sweep_image_dir,          "",
+    "Directory of the COCO images (e.g., `val2017/`). Their file names must contain their COCO image ids.");
+DEFINE_uint64(sweep_images_max,         0,
+    "Maximum number of images of `--sweep_image_dir` that are used (in file name order). 0 to use all of them.");
+DEFINE_string(sweep_annotations,        "",
+    "COCO person keypoint annotations JSON file (e.g., `person_keypoints_val2017.json`).");
+DEFINE_string(sweep_resolutions,        "-1x368",
+    "Comma-separated list of net resolutions (with the `--net_resolution` format).");
+DEFINE_string(sweep_scale_numbers,      "1",
+    "Comma-separated list of numbers of scales (`--scale_number`), all of them with `--scale_gap`.");
+DEFINE_string(sweep_nms_thresholds,     "",
+    "Comma-separated list of NMS thresholds (PoseProperty::NMSThreshold). Empty to use the default one of"
+    " `--model_pose`.");
+DEFINE_string(sweep_inter_thresholds,   "",
+    "Comma-separated list of body part connection thresholds (PoseProperty::ConnectInterThreshold). Empty to use the"
+    " default one of `--model_pose`.");
+DEFINE_string(sweep_min_subset_scores,  "",
+    "Comma-separated list of minimum person scores (PoseProperty::ConnectMinSubsetScore). Empty to use the default"
+    " one.");
+DEFINE_string(sweep_cache_dir,          "sweep_cache/",
+    "Directory where the raw network outputs are cached, so later sweeps over the same images (e.g., with other"
+    " thresholds) do not run the network again.");
+DEFINE_string(sweep_output,             "",
+    "Path of the JSON file where the results are written. Empty to print them on the standard output.");
+
+// Cached network outputs of each image
+struct SweepImage
+{
+    std::string name;
+    op::Point<int> size;
+    double networkMs;
+};
+
+// Post-processing thresholds
+struct SweepThresholds
+{
+    float nmsThreshold;
+    float interThreshold;
+    float minSubsetScore;
+};
+
+struct SweepResult
+{
+    std::string netResolution;
+    int scaleNumber;
+    SweepThresholds sweepThresholds;
+    // COCOeval.stats
+    std::array<double, 10> stats;
+    double networkMs;
+    double postProcessingMs;
+    bool pareto;
+};
+
+std::vector<float> parseFloats(const std::string& text, const float defaultValue)
+{
+    try
+    {
+        std::vector<float> values;
+        for (const auto& value : splitList(text))
+            values.emplace_back(std::stof(value));
+        if (values.empty())
+            values.emplace_back(defaultValue);
+        return values;
+    }
+    catch (const std::exception& e)
+    {
+        op::error("Invalid list of numbers: " + text + ". Error details: " + e.what(),
+                  __LINE__, __FUNCTION__, __FILE__);
+        return {};
+    }
+}
+
+std::string getCachePath(const std::string& netResolution, const int scaleNumber)
+{
+    std::stringstream stringStream;
+    stringStream << op::formatAsDirectory(FLAGS_sweep_cache_dir) << FLAGS_model_pose << "_" << netResolution << "_"
+                 << scaleNumber;
+    if (scaleNumber > 1)
+        stringStream << "x" << FLAGS_scale_gap;
+    return stringStream.str();
+}
+
+// It returns the cached images if the cache (.opheat and .txt files) was generated from the same images
+std::vector<SweepImage> readCache(const std::string& cachePath, const std::vector<std::string>& imagePaths)
+{
+    try
+    {
+        if (!op::existFile(cachePath + ".opheat") || !op::existFile(cachePath + ".txt"))
+            return {};
+        std::vector<SweepImage> sweepImages;
+        std::ifstream timesFile{cachePath + ".txt"};
+        SweepImage sweepImage;
+        while (timesFile >> sweepImage.name >> sweepImage.size.x >> sweepImage.size.y >> sweepImage.networkMs)
+            sweepImages.emplace_back(sweepImage);
+        const op::HeatMapBinaryReader heatMapBinaryReader{cachePath + ".opheat"};
+        if (sweepImages.size() != imagePaths.size() || heatMapBinaryReader.getNumberFrames() != imagePaths.size())
+            return {};
+        for (auto i = 0u ; i < imagePaths.size() ; i++)
+            if (sweepImages[i].name != op::getFileNameNoExtension(imagePaths[i])
+                || heatMapBinaryReader.getFrameName(i) != sweepImages[i].name)
+                return {};
+        return sweepImages;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return {};
+    }
+}
+
+// Step 1: Raw network output of each image and scale
+std::vector<SweepImage> cacheNetworkOutputs(
+    op::NetCaffe& netCaffe, const std::vector<std::string>& imagePaths, const std::string& netResolution,
+    const int scaleNumber)
+{
+    try
+    {
+        const auto cachePath = getCachePath(netResolution, scaleNumber);
+        auto sweepImages = readCache(cachePath, imagePaths);
+        if (!sweepImages.empty())
+        {
+            op::opLog("Reusing the cached network outputs of " + cachePath + ".", op::Priority::High);
+            return sweepImages;
+        }
+        op::opLog("Caching the network outputs into " + cachePath + "...", op::Priority::High);
+        const auto poseModel = op::flagsToPoseModel(op::String(FLAGS_model_pose));
+        const op::ScaleAndSizeExtractor scaleAndSizeExtractor{
+            op::flagsToPoint(op::String(netResolution), "-1x368"), (float)FLAGS_net_resolution_dynamic,
+            op::Point<int>{-1, -1}, scaleNumber, FLAGS_scale_gap};
+        op::CvMatToOpInput cvMatToOpInput{poseModel};
+        op::HeatMapBinarySaver heatMapBinarySaver{cachePath + ".opheat"};
+        std::vector<op::Array<float>> netOutputs(scaleNumber);
+        for (auto i = 0u ; i < imagePaths.size() ; i++)
+        {
+            const cv::Mat image = cv::imread(imagePaths[i]);
+            if (image.empty())
+                op::error("Image could not be read: " + imagePaths[i], __LINE__, __FUNCTION__, __FILE__);
+            const op::Point<int> imageSize{image.cols, image.rows};
+            // The first image is processed twice, so the network initialization is not part of the timing
+            for (auto repetition = (i == 0 ? 0 : 1) ; repetition < 2 ; repetition++)
+            {
+                const auto timeBegin = std::chrono::high_resolution_clock::now();
+                const auto scalesAndSizes = scaleAndSizeExtractor.extract(imageSize);
+                const auto netInputArrays = cvMatToOpInput.createArray(
+                    OP_CV2OPCONSTMAT(image), std::get<0>(scalesAndSizes), std::get<1>(scalesAndSizes));
+                for (auto scale = 0u ; scale < netInputArrays.size() ; scale++)
+                {
+                    netCaffe.forwardPass(netInputArrays[scale]);
+                    const auto netOutputBlob = netCaffe.getOutputBlobArray();
+                    // cpu_data() also waits for the network to finish
+                    const auto* const netOutputPtr = netOutputBlob->cpu_data();
+                    netOutputs[scale].reset(
+                        {netOutputBlob->shape(1), netOutputBlob->shape(2), netOutputBlob->shape(3)});
+                    std::memcpy(
+                        netOutputs[scale].getPtr(), netOutputPtr, netOutputs[scale].getVolume() * sizeof(float));
+                }
+                if (repetition == 1)
+                    sweepImages.emplace_back(SweepImage{
+                        op::getFileNameNoExtension(imagePaths[i]), imageSize, durationMs(timeBegin)});
+            }
+            heatMapBinarySaver.save(netOutputs, sweepImages.back().name);
+        }
+        // Image sizes and network times
+        std::ofstream timesFile{cachePath + ".txt"};
+        if (!timesFile.is_open())
+            op::error("Could not open file: " + cachePath + ".txt", __LINE__, __FUNCTION__, __FILE__);
+        timesFile << std::fixed << std::setprecision(4);
+        for (const auto& sweepImage : sweepImages)
+            timesFile << sweepImage.name << " " << sweepImage.size.x << " " << sweepImage.size.y << " "
+                      << sweepImage.networkMs << "\n";
+        return sweepImages;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return {};
+    }
+}
+
+// Steps 2 and 3: Post-processing and evaluation of each threshold combination
+std::vector<SweepResult> sweepThresholds(
+    op::CocoEvaluator& cocoEvaluator, const std::vector<SweepImage>& sweepImages,
+    const std::vector<SweepThresholds>& thresholdCombinations, const std::string& netResolution,
+    const int scaleNumber)
+{
+    try
+    {
+        const auto poseModel = op::flagsToPoseModel(op::String(FLAGS_model_pose));
+        const auto numberBodyParts = (int)op::getPoseNumberBodyParts(poseModel);
+        const auto maxPeaks = (int)op::getPoseMaxPeaks();
+        const auto interMinAboveThreshold = op::getPoseDefaultConnectInterMinAboveThreshold(FLAGS_maximize_positives);
+        const auto minSubsetCnt = (int)op::getPoseDefaultMinSubsetCnt(FLAGS_maximize_positives);
+        const auto upsamplingRatio = (FLAGS_upsampling_ratio <= 0.
+            ? 1. : FLAGS_upsampling_ratio / op::getPoseNetDecreaseFactor(poseModel));
+        const op::ScaleAndSizeExtractor scaleAndSizeExtractor{
+            op::flagsToPoint(op::String(netResolution), "-1x368"), (float)FLAGS_net_resolution_dynamic,
+            op::Point<int>{-1, -1}, scaleNumber, FLAGS_scale_gap};
+        const op::HeatMapBinaryReader heatMapBinaryReader{getCachePath(netResolution, scaleNumber) + ".opheat"};
+        // Keypoints of each combination and image
+        std::vector<std::vector<std::pair<op::Array<float>, op::Array<float>>>> people(
+            thresholdCombinations.size(), std::vector<std::pair<op::Array<float>, op::Array<float>>>(
+                sweepImages.size()));
+        std::vector<double> postProcessingMs(thresholdCombinations.size(), 0.);
+        std::vector<op::Array<float>> netOutputs;
+        std::vector<float> heatMaps;
+        std::vector<float> peaks((size_t)numberBodyParts * (maxPeaks + 1) * 3);
+        std::vector<int> kernel;
+        for (auto i = 0u ; i < sweepImages.size() ; i++)
+        {
+            heatMapBinaryReader.readFrame(netOutputs, i);
+            const auto scalesAndSizes = scaleAndSizeExtractor.extract(sweepImages[i].size);
+            const auto& scaleInputToNetInputs = std::get<0>(scalesAndSizes);
+            const auto& netInputSizes = std::get<1>(scalesAndSizes);
+            // Resize and merge (same for all the combinations)
+            const op::Point<int> heatMapSize{
+                op::positiveIntRound(upsamplingRatio*netInputSizes[0].x),
+                op::positiveIntRound(upsamplingRatio*netInputSizes[0].y)};
+            const auto channels = netOutputs[0].getSize(0);
+            const std::array<int, 4> heatMapsSize{1, channels, heatMapSize.y, heatMapSize.x};
+            std::vector<const float*> sourcePtrs;
+            std::vector<std::array<int, 4>> sourceSizes;
+            std::vector<float> floatScaleRatios;
+            for (auto scale = 0u ; scale < netOutputs.size() ; scale++)
+            {
+                sourcePtrs.emplace_back(netOutputs[scale].getConstPtr());
+                sourceSizes.emplace_back(std::array<int, 4>{
+                    1, channels, netOutputs[scale].getSize(1), netOutputs[scale].getSize(2)});
+                floatScaleRatios.emplace_back(float(scaleInputToNetInputs[scale]));
+            }
+            heatMaps.resize((size_t)channels * heatMapSize.area());
+            kernel.resize((size_t)numberBodyParts * heatMapSize.area());
+            const auto timeBegin = std::chrono::high_resolution_clock::now();
+            op::resizeAndMergeCpu(heatMaps.data(), sourcePtrs, heatMapsSize, sourceSizes, floatScaleRatios);
+            const auto resizeMs = durationMs(timeBegin);
+            // Same scale than PoseExtractorCaffe, so the keypoints are on the image coordinates
+            const auto scaleProducerToNetInput = op::resizeGetScaleFactor(sweepImages[i].size, heatMapSize);
+            const op::Point<int> netSize{
+                op::positiveIntRound(scaleProducerToNetInput*sweepImages[i].size.x),
+                op::positiveIntRound(scaleProducerToNetInput*sweepImages[i].size.y)};
+            const auto scaleNetToOutput = (float)op::resizeGetScaleFactor(netSize, sweepImages[i].size);
+            const auto nmsOffset = float(0.5/double(scaleNetToOutput));
+            const std::array<int, 4> nmsSourceSize{1, numberBodyParts, heatMapSize.y, heatMapSize.x};
+            const std::array<int, 4> peaksSize{1, numberBodyParts, maxPeaks + 1, 3};
+            // NMS (once per NMS threshold, the combinations are sorted by it)
+            auto nmsMs = 0.;
+            for (auto combination = 0u ; combination < thresholdCombinations.size() ; combination++)
+            {
+                const auto& thresholds = thresholdCombinations[combination];
+                if (combination == 0
+                    || thresholds.nmsThreshold != thresholdCombinations[combination-1].nmsThreshold)
+                {
+                    const auto timeBeginNms = std::chrono::high_resolution_clock::now();
+                    op::nmsCpu(peaks.data(), kernel.data(), heatMaps.data(), thresholds.nmsThreshold, peaksSize,
+                               nmsSourceSize, op::Point<float>{nmsOffset, nmsOffset});
+                    nmsMs = durationMs(timeBeginNms);
+                }
+                // Body part connection
+                auto& poseKeypointsAndScores = people[combination][i];
+                const auto timeBeginConnect = std::chrono::high_resolution_clock::now();
+                op::connectBodyPartsCpu(
+                    poseKeypointsAndScores.first, poseKeypointsAndScores.second, heatMaps.data(), peaks.data(),
+                    poseModel, heatMapSize, maxPeaks, interMinAboveThreshold, thresholds.interThreshold,
+                    minSubsetCnt, thresholds.minSubsetScore, thresholds.nmsThreshold, scaleNetToOutput,
+                    FLAGS_maximize_positives, FLAGS_number_people_max);
+                postProcessingMs[combination] += resizeMs + nmsMs + durationMs(timeBeginConnect);
+            }
+        }
+        // COCO accuracy
+        auto networkMs = 0.;
+        for (const auto& sweepImage : sweepImages)
+            networkMs += sweepImage.networkMs;
+        const auto numberImages = (double)std::max(std::size_t(1), sweepImages.size());
+        std::vector<SweepResult> sweepResults;
+        for (auto combination = 0u ; combination < thresholdCombinations.size() ; combination++)
+        {
+            cocoEvaluator.clear();
+            for (auto i = 0u ; i < sweepImages.size() ; i++)
+                cocoEvaluator.addResults(
+                    op::getLastNumber(sweepImages[i].name), people[combination][i].first,
+                    people[combination][i].second, poseModel);
+            sweepResults.emplace_back(SweepResult{
+                netResolution, scaleNumber, thresholdCombinations[combination], cocoEvaluator.evaluate(),
+                networkMs / numberImages, postProcessingMs[combination] / numberImages, false});
+            const auto& sweepResult = sweepResults.back();
+            op::opLog(netResolution + ", " + std::to_string(scaleNumber) + " scale(s), NMS "
+                      + std::to_string(sweepResult.sweepThresholds.nmsThreshold) + ", inter "
+                      + std::to_string(sweepResult.sweepThresholds.interThreshold) + ", min subset score "
+                      + std::to_string(sweepResult.sweepThresholds.minSubsetScore) + ": AP "
+                      + std::to_string(sweepResult.stats[0]) + ", "
+                      + std::to_string(sweepResult.networkMs + sweepResult.postProcessingMs) + " ms.",
+                      op::Priority::High);
+        }
+        return sweepResults;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return {};
+    }
+}
+
+std::string getReport(std::vector<SweepResult>& sweepResults, const unsigned long long numberImages)
+{
+    try
+    {
+        // Pareto-optimal: no other setting is at least as accurate and as fast, and better in 1 of them
+        for (auto& sweepResult : sweepResults)
+        {
+            const auto latencyMs = sweepResult.networkMs + sweepResult.postProcessingMs;
+            sweepResult.pareto = std::none_of(
+                sweepResults.begin(), sweepResults.end(), [&](const SweepResult& other)
+                {
+                    const auto otherLatencyMs = other.networkMs + other.postProcessingMs;
+                    return other.stats[0] >= sweepResult.stats[0] && otherLatencyMs <= latencyMs
+                        && (other.stats[0] > sweepResult.stats[0] || otherLatencyMs < latencyMs);
+                });
+        }
+        std::stringstream stringStream;
+        stringStream << std::fixed << std::setprecision(4)
+            << "{\n"
+            << "  \"openpose_version\": " << toJsonString(OPEN_POSE_VERSION_STRING) << ",\n"
+            << "  \"model_pose\": " << toJsonString(FLAGS_model_pose) << ",\n"
+            << "  \"annotations\": " << toJsonString(FLAGS_sweep_annotations) << ",\n"
+            << "  \"images\": " << numberImages << ",\n"
+            << "  \"settings\": [";
+        for (auto i = 0u ; i < sweepResults.size() ; i++)
+        {
+            const auto& sweepResult = sweepResults[i];
+            stringStream
+                << (i > 0 ? "," : "") << "\n    {"
+                << "\"net_resolution\": " << toJsonString(sweepResult.netResolution)
+                << ", \"scale_number\": " << sweepResult.scaleNumber
+                << ", \"nms_threshold\": " << sweepResult.sweepThresholds.nmsThreshold
+                << ", \"connect_inter_threshold\": " << sweepResult.sweepThresholds.interThreshold
+                << ", \"connect_min_subset_score\": " << sweepResult.sweepThresholds.minSubsetScore
+                << ", \"ap\": " << sweepResult.stats[0]
+                << ", \"ap50\": " << sweepResult.stats[1]
+                << ", \"ap75\": " << sweepResult.stats[2]
+                << ", \"ap_medium\": " << sweepResult.stats[3]
+                << ", \"ap_large\": " << sweepResult.stats[4]
+                << ", \"ar\": " << sweepResult.stats[5]
+                << ", \"network_ms\": " << sweepResult.networkMs
+                << ", \"postprocessing_ms\": " << sweepResult.postProcessingMs
+                << ", \"latency_ms\": " << sweepResult.networkMs + sweepResult.postProcessingMs
+                << ", \"pareto\": " << (sweepResult.pareto ? "true" : "false") << "}";
+        }
+        stringStream << "\n  ]\n}\n";
+        return stringStream.str();
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return "";
+    }
+}
+
+int openPoseAccuracySweep()
+{
+    try
+    {
+        op::opLog("Starting OpenPose accuracy/speed sweep...", op::Priority::High);
+        const auto opTimer = op::getTimerInit();
+
+        // logging_level
+        op::checkBool(
+            0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+            __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+        op::checkBool(!FLAGS_sweep_image_dir.empty() && !FLAGS_sweep_annotations.empty(),
+                      "`--sweep_image_dir` and `--sweep_annotations` are required.", __LINE__, __FUNCTION__, __FILE__);
+
+        // Images (in file name order)
+        auto imagePaths = op::getFilesOnDirectory(FLAGS_sweep_image_dir, op::Extensions::Images);
+        if (FLAGS_sweep_images_max > 0 && imagePaths.size() > FLAGS_sweep_images_max)
+            imagePaths.resize(FLAGS_sweep_images_max);
+        if (imagePaths.empty())
+            op::error("No images found on: " + FLAGS_sweep_image_dir, __LINE__, __FUNCTION__, __FILE__);
+        op::opLog(std::to_string(imagePaths.size()) + " images.", op::Priority::High);
+
+        // Threshold combinations (sorted by NMS threshold, so nms runs once per threshold)
+        const auto poseModel = op::flagsToPoseModel(op::String(FLAGS_model_pose));
+        std::vector<SweepThresholds> thresholdCombinations;
+        for (const auto nmsThreshold : parseFloats(
+            FLAGS_sweep_nms_thresholds, op::getPoseDefaultNmsThreshold(poseModel, FLAGS_maximize_positives)))
+            for (const auto interThreshold : parseFloats(
+                FLAGS_sweep_inter_thresholds,
+                op::getPoseDefaultConnectInterThreshold(poseModel, FLAGS_maximize_positives)))
+                for (const auto minSubsetScore : parseFloats(
+                    FLAGS_sweep_min_subset_scores, op::getPoseDefaultConnectMinSubsetScore(FLAGS_maximize_positives)))
+                    thresholdCombinations.emplace_back(SweepThresholds{nmsThreshold, interThreshold, minSubsetScore});
+        std::stable_sort(thresholdCombinations.begin(), thresholdCombinations.end(),
+                         [](const SweepThresholds& a, const SweepThresholds& b)
+                         { return a.nmsThreshold < b.nmsThreshold; });
+
+        // Body network, loaded once for all the settings
+        const auto modelFolder = op::formatAsDirectory(FLAGS_model_folder);
+        op::NetCaffe netCaffe{
+            modelFolder + (FLAGS_prototxt_path.empty() ? op::getPoseProtoTxt(poseModel) : FLAGS_prototxt_path),
+            modelFolder + (FLAGS_caffemodel_path.empty()
+                ? op::getPoseTrainedModel(poseModel) : FLAGS_caffemodel_path),
+            FLAGS_num_gpu_start};
+        netCaffe.initializationOnThread();
+        op::makeDirectory(FLAGS_sweep_cache_dir);
+        op::CocoEvaluator cocoEvaluator{FLAGS_sweep_annotations};
+
+        // Sweep
+        std::vector<SweepResult> sweepResults;
+        for (const auto& netResolution : splitList(FLAGS_sweep_resolutions))
+        {
+            for (const auto scaleNumber : parseFloats(FLAGS_sweep_scale_numbers, 1.f))
+            {
+                const auto sweepImages = cacheNetworkOutputs(netCaffe, imagePaths, netResolution, (int)scaleNumber);
+                const auto settingResults = sweepThresholds(
+                    cocoEvaluator, sweepImages, thresholdCombinations, netResolution, (int)scaleNumber);
+                sweepResults.insert(sweepResults.end(), settingResults.begin(), settingResults.end());
+            }
+        }
+
+        // Report
+        const auto report = getReport(sweepResults, imagePaths.size());
+        if (FLAGS_sweep_output.empty())
+            std::cout << report;
+        else
+        {
+            std::ofstream reportFile{FLAGS_sweep_output};
+            if (!reportFile.is_open())
+                op::error("Could not open file: " + FLAGS_sweep_output, __LINE__, __FUNCTION__, __FILE__);
+            reportFile << report;
+            op::opLog("Sweep report saved in " + FLAGS_sweep_output + ".", op::Priority::High);
+        }
+
+        // Measuring total time
+        op::printTime(opTimer, "OpenPose accuracy/speed sweep successfully finished. Total time: ", " seconds.",
+                      op::Priority::High);
+
+        // Return successful message
+        return 0;
+    }
+    catch (const std::exception&)
+    {
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running openPoseAccuracySweep
+    return openPoseAccuracySweep();
+}
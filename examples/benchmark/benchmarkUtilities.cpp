@@ -0,0 +1,78 @@
+#include "benchmarkUtilities.hpp"
+// C++ std library dependencies
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+double durationMs(const TimePoint& timeBegin, const TimePoint& timeEnd)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeBegin).count() * 1e-6;
+}
+
+double durationMs(const TimePoint& timeBegin)
+{
+    return durationMs(timeBegin, std::chrono::high_resolution_clock::now());
+}
+
+std::vector<std::string> splitList(const std::string& listString, const std::string& defaultValue)
+{
+    std::vector<std::string> elements;
+    std::stringstream stringStream{listString.empty() ? defaultValue : listString};
+    std::string element;
+    while (std::getline(stringStream, element, ','))
+    {
+        element.erase(0, element.find_first_not_of(" \t"));
+        element.erase(element.find_last_not_of(" \t") + 1);
+        if (!element.empty())
+            elements.emplace_back(element);
+    }
+    return elements;
+}
+
+std::vector<int> splitIntList(const std::string& listString, const std::vector<int>& defaultValues)
+{
+    if (listString.empty())
+        return defaultValues;
+    std::vector<int> elements;
+    for (const auto& element : splitList(listString))
+        elements.emplace_back(std::stoi(element));
+    return elements;
+}
+
+std::string toJsonString(const std::string& string)
+{
+    std::string jsonString{"\""};
+    for (const auto character : string)
+    {
+        if (character == '"' || character == '\\')
+            jsonString += '\\';
+        jsonString += character;
+    }
+    return jsonString + "\"";
+}
+
+double percentile(const std::vector<double>& sortedValues, const double percentage)
+{
+    if (sortedValues.empty())
+        return 0.;
+    const auto rank = (size_t)std::ceil(percentage / 100. * sortedValues.size());
+    return sortedValues.at(std::min(sortedValues.size(), std::max(rank, size_t(1))) - 1);
+}
+
+std::string statisticsToJson(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    double sum = 0.;
+    for (const auto value : values)
+        sum += value;
+    std::stringstream stringStream;
+    stringStream << std::fixed << std::setprecision(3)
+        << "{\"mean\": " << (values.empty() ? 0. : sum / values.size())
+        << ", \"min\": " << (values.empty() ? 0. : values.front())
+        << ", \"p50\": " << percentile(values, 50.)
+        << ", \"p95\": " << percentile(values, 95.)
+        << ", \"p99\": " << percentile(values, 99.)
+        << ", \"max\": " << (values.empty() ? 0. : values.back()) << "}";
+    return stringStream.str();
+}
@@ -0,0 +1,36 @@
+#ifndef OPENPOSE_EXAMPLES_BENCHMARK_BENCHMARK_UTILITIES_HPP
+#define OPENPOSE_EXAMPLES_BENCHMARK_BENCHMARK_UTILITIES_HPP
+
+// Helpers shared by the benchmark tools (openpose_bench, kernel_bench, thread_bench and accuracy_sweep): parsing of
+// the comma-separated flags, timing, and the JSON report writing
+
+// C++ std library dependencies
+#include <chrono>
+#include <string>
+#include <vector>
+
+typedef std::chrono::high_resolution_clock::time_point TimePoint;
+
+// Elapsed time (in milliseconds) from timeBegin to timeEnd
+double durationMs(const TimePoint& timeBegin, const TimePoint& timeEnd);
+
+// Elapsed time (in milliseconds) from timeBegin until now
+double durationMs(const TimePoint& timeBegin);
+
+// Comma-separated elements of listString (or of defaultValue if listString is empty), trimmed and without the empty
+// ones. E.g., " 1x368, 2x736," --> {"1x368", "2x736"}
+std::vector<std::string> splitList(const std::string& listString, const std::string& defaultValue = "");
+
+// splitList() converted into integers, or defaultValues if listString is empty
+std::vector<int> splitIntList(const std::string& listString, const std::vector<int>& defaultValues = {});
+
+// Quoted and escaped JSON string
+std::string toJsonString(const std::string& string);
+
+// Nearest-rank percentile of an already sorted vector
+double percentile(const std::vector<double>& sortedValues, const double percentage);
+
+// JSON object with the mean, min, p50, p95, p99 and max of values
+std::string statisticsToJson(std::vector<double> values);
+
+#endif // OPENPOSE_EXAMPLES_BENCHMARK_BENCHMARK_UTILITIES_HPP
@@ -0,0 +1,730 @@
+// --------------------------------------- OpenPose Kernel Micro-Benchmark ---------------------------------------
+// This binary runs the network post-processing kernels (resizeAndMerge, nms, connectBodyParts, maximum and
+// pyramidalLK) on synthetic heat maps, i.e., without the network nor any input media, with each of the available
+// back-ends (CPU, and CUDA or OpenCL depending on how OpenPose was compiled). It sweeps over net resolutions, heat map
+// channels and number of people, and it reports the average kernel time, the effective memory bandwidth (GB/s) and
+// the speedup with respect to the CPU version as JSON, so kernel changes can be compared against a baseline. E.g.:
+//     ./build/examples/benchmark/kernel_bench.bin --kbench_resolutions "656x368,1312x736" --kbench_people "1,8,32"
+//         --kbench_output kernels.json
+// Synthetic data: each person is a random skeleton of `--model_pose` whose keypoints are Gaussian peaks in the body
+// part heat maps, and whose limbs are unit vectors in the PAF channels, so nms and connectBodyParts find (and
+// assemble) as many people as requested. The heat maps are generated at the network output resolution (8 times
+// smaller than the net resolution) and upsampled with resizeAndMerge for nms and connectBodyParts.
+// - GB/s is the number of bytes each kernel must read and write at least (e.g., source and target heat maps for
+//   resizeAndMerge) divided by its time. connectBodyParts only reads the PAFs along the candidate limbs, so its GB/s
+//   is not reported.
+// - GPU times are measured with CUDA events (or by finishing the OpenCL queue), and they include the uploads and
+//   downloads the kernel functions do themselves (e.g., the peaks of connectBodyParts), but not the input upload.
+
+// Third-party dependencies
+#include <opencv2/opencv.hpp>
+// Command-line user interface
+#define OPENPOSE_FLAGS_DISABLE_PRODUCER
+#define OPENPOSE_FLAGS_DISABLE_DISPLAY
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+// pyramidalLK is not exported by the Windows DLL
+#ifndef _WIN32
+    #include <openpose_private/tracking/pyramidalLK.hpp>
+#endif
+// CUDA dependencies
+#ifdef USE_CUDA
+    #include <cuda_runtime.h>
+    #include <openpose/gpu/cuda.hpp>
+#endif
+// OpenCL dependencies
+#ifdef USE_OPENCL
+    #include <openpose_private/gpu/opencl.hcl>
+    #include <openpose_private/gpu/cl2.hpp>
+#endif
+// Benchmark utilities
+#include "benchmarkUtilities.hpp"
+// C++ std library dependencies
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+// Custom OpenPose flags
+// Kernel benchmark
+DEFINE_string(kbench_kernels,           "resizeAndMerge,nms,connectBodyParts,maximum,pyramidalLK",
+    "Comma-separated list of kernels to benchmark.");
+DEFINE_string(kbench_resolutions,       "656x368,1312x736",
+    "Comma-separated list of net resolutions (the synthetic network output is 8 times smaller, and it is upsampled to"
+    " this resolution). The maximum kernel uses the face/hand net resolution (`--face_net_resolution`) instead.");
+DEFINE_string(kbench_channels,          "",
+    "Comma-separated list of numbers of heat map channels for resizeAndMerge and maximum. Empty to use the channels of"
+    " `--model_pose` for resizeAndMerge, and the face and hand channels (71 and 22) for maximum. nms and"
+    " connectBodyParts always use the channels of `--model_pose`.");
+DEFINE_string(kbench_people,            "1,8,32",
+    "Comma-separated list of numbers of people in the synthetic heat maps (or faces/hands for maximum).");
+DEFINE_int32(kbench_iterations,         50,
+    "Number of measured iterations of each kernel and configuration.");
+DEFINE_int32(kbench_warmup,             5,
+    "Number of iterations run (and excluded from the statistics) before measuring each kernel and configuration.");
+DEFINE_uint64(kbench_max_megabytes,     1024,
+    "Configurations whose heat maps take more memory than this (in MB) are skipped.");
+DEFINE_string(kbench_output,            "",
+    "Path of the JSON file where the results are written. Empty to print them on the standard output.");
+
+struct KernelResult
+{
+    std::string kernel;
+    std::string backend;
+    int width;
+    int height;
+    int channels;
+    int people;
+    double timeMs;
+    double bytes;
+    double speedup;
+};
+
+// Heat maps of a synthetic frame
+struct SyntheticHeatMaps
+{
+    int width;
+    int height;
+    int channels;
+    // 1 x channels x height/8 x width/8
+    std::vector<float> netOutput;
+    // 1 x channels x height x width
+    std::vector<float> heatMaps;
+};
+
+bool isKernelSelected(const std::string& kernel)
+{
+    const auto kernels = splitList(FLAGS_kbench_kernels);
+    return std::find(kernels.begin(), kernels.end(), kernel) != kernels.end();
+}
+
+// Average time (in milliseconds) of function, after `--kbench_warmup` iterations
+template <typename TFunction>
+double timeCpuMs(const TFunction& function)
+{
+    for (auto i = 0 ; i < FLAGS_kbench_warmup ; i++)
+        function();
+    const auto timeBegin = std::chrono::high_resolution_clock::now();
+    for (auto i = 0 ; i < FLAGS_kbench_iterations ; i++)
+        function();
+    return durationMs(timeBegin) / FLAGS_kbench_iterations;
+}
+
+#ifdef USE_CUDA
+    // Analogous to timeCpuMs, but with CUDA events, so the asynchronous kernels are fully measured
+    template <typename TFunction>
+    double timeCudaMs(const TFunction& function)
+    {
+        for (auto i = 0 ; i < FLAGS_kbench_warmup ; i++)
+            function();
+        cudaEvent_t eventBegin, eventEnd;
+        cudaEventCreate(&eventBegin);
+        cudaEventCreate(&eventEnd);
+        cudaEventRecord(eventBegin);
+        for (auto i = 0 ; i < FLAGS_kbench_iterations ; i++)
+            function();
+        cudaEventRecord(eventEnd);
+        cudaEventSynchronize(eventEnd);
+        float timeMs = 0.f;
+        cudaEventElapsedTime(&timeMs, eventBegin, eventEnd);
+        cudaEventDestroy(eventBegin);
+        cudaEventDestroy(eventEnd);
+        op::cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        return timeMs / FLAGS_kbench_iterations;
+    }
+
+    template <typename T>
+    T* uploadCuda(const std::vector<T>& values)
+    {
+        T* gpuPtr;
+        cudaMalloc((void**)&gpuPtr, values.size() * sizeof(T));
+        cudaMemcpy(gpuPtr, values.data(), values.size() * sizeof(T), cudaMemcpyHostToDevice);
+        op::cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        return gpuPtr;
+    }
+#endif
+
+#ifdef USE_OPENCL
+    // Analogous to timeCpuMs, but finishing the OpenCL queue
+    template <typename TFunction>
+    double timeOpenClMs(const TFunction& function)
+    {
+        auto& queue = op::OpenCL::getInstance(FLAGS_num_gpu_start)->getQueue();
+        for (auto i = 0 ; i < FLAGS_kbench_warmup ; i++)
+            function();
+        queue.finish();
+        const auto timeBegin = std::chrono::high_resolution_clock::now();
+        for (auto i = 0 ; i < FLAGS_kbench_iterations ; i++)
+            function();
+        queue.finish();
+        return durationMs(timeBegin) / FLAGS_kbench_iterations;
+    }
+
+    template <typename T>
+    T* uploadOpenCl(const std::vector<T>& values)
+    {
+        auto& context = op::OpenCL::getInstance(FLAGS_num_gpu_start)->getContext();
+        auto clMem = clCreateBuffer(
+            context.operator()(), CL_MEM_READ_WRITE, values.size() * sizeof(T), nullptr, nullptr);
+        op::OpenCL::getInstance(FLAGS_num_gpu_start)->getQueue().enqueueWriteBuffer(
+            cl::Buffer{clMem, true}, CL_TRUE, 0, values.size() * sizeof(T), values.data());
+        return (T*)clMem;
+    }
+#endif
+
+// Random skeletons of poseModel rendered into its body part heat maps and PAFs (at the network output resolution)
+SyntheticHeatMaps createSyntheticHeatMaps(
+    const op::PoseModel poseModel, const int width, const int height, const int numberPeople, const int channels)
+{
+    try
+    {
+        const auto numberBodyParts = (int)op::getPoseNumberBodyParts(poseModel);
+        const auto& bodyPartPairs = op::getPosePartPairs(poseModel);
+        const auto& mapIdx = op::getPoseMapIndex(poseModel);
+        const auto pafOffset = numberBodyParts + (op::addBkgChannel(poseModel) ? 1 : 0);
+        const auto modelChannels = pafOffset + (int)mapIdx.size();
+        SyntheticHeatMaps syntheticHeatMaps;
+        syntheticHeatMaps.width = width;
+        syntheticHeatMaps.height = height;
+        syntheticHeatMaps.channels = (channels > 0 ? channels : modelChannels);
+        const auto netWidth = std::max(1, width / 8);
+        const auto netHeight = std::max(1, height / 8);
+        const auto netArea = netWidth * netHeight;
+        syntheticHeatMaps.netOutput.assign((size_t)syntheticHeatMaps.channels * netArea, 0.f);
+        auto* const netOutputPtr = syntheticHeatMaps.netOutput.data();
+        // Same skeletons for all the configurations with the same number of people
+        std::mt19937 randomGenerator{(unsigned int)numberPeople};
+        std::uniform_real_distribution<float> uniform{0.f, 1.f};
+        const auto personSize = std::max(4.f, netHeight / (1.5f + std::sqrt((float)numberPeople)));
+        for (auto person = 0 ; person < numberPeople ; person++)
+        {
+            // Keypoints of the person
+            const auto centerX = personSize / 2.f + uniform(randomGenerator) * std::max(0.f, netWidth - personSize);
+            const auto centerY = personSize / 2.f + uniform(randomGenerator) * std::max(0.f, netHeight - personSize);
+            std::vector<cv::Point2f> keypoints(numberBodyParts);
+            for (auto& keypoint : keypoints)
+                keypoint = cv::Point2f{
+                    centerX + (uniform(randomGenerator) - 0.5f) * personSize,
+                    centerY + (uniform(randomGenerator) - 0.5f) * personSize};
+            // Body part heat maps: Gaussian peaks (sigma = 1 network output pixel)
+            for (auto part = 0 ; part < numberBodyParts && part < syntheticHeatMaps.channels ; part++)
+            {
+                auto* const channelPtr = netOutputPtr + part * netArea;
+                for (auto y = std::max(0, (int)keypoints[part].y - 3) ;
+                     y < std::min(netHeight, (int)keypoints[part].y + 4) ; y++)
+                    for (auto x = std::max(0, (int)keypoints[part].x - 3) ;
+                         x < std::min(netWidth, (int)keypoints[part].x + 4) ; x++)
+                    {
+                        const auto dx = x - keypoints[part].x;
+                        const auto dy = y - keypoints[part].y;
+                        auto& value = channelPtr[y * netWidth + x];
+                        value = std::max(value, std::exp(-0.5f * (dx*dx + dy*dy)));
+                    }
+            }
+            // PAFs: unit vectors along each limb (1 network output pixel wide)
+            for (auto pair = 0u ; pair < bodyPartPairs.size() / 2 ; pair++)
+            {
+                const auto channelX = pafOffset + (int)mapIdx[2*pair];
+                const auto channelY = pafOffset + (int)mapIdx[2*pair+1];
+                if (channelY >= syntheticHeatMaps.channels)
+                    continue;
+                const auto& keypointA = keypoints[bodyPartPairs[2*pair]];
+                const auto& keypointB = keypoints[bodyPartPairs[2*pair+1]];
+                const auto limb = keypointB - keypointA;
+                const auto limbLength = std::max(1e-3f, std::sqrt(limb.x*limb.x + limb.y*limb.y));
+                const auto unitX = limb.x / limbLength;
+                const auto unitY = limb.y / limbLength;
+                for (auto step = 0 ; step <= (int)std::ceil(limbLength) ; step++)
+                {
+                    const auto ratio = std::min(1.f, step / limbLength);
+                    const cv::Point2f location{keypointA.x + ratio * limb.x, keypointA.y + ratio * limb.y};
+                    for (auto y = std::max(0, (int)location.y - 1) ; y < std::min(netHeight, (int)location.y + 2) ; y++)
+                        for (auto x = std::max(0, (int)location.x - 1) ; x < std::min(netWidth, (int)location.x + 2) ;
+                             x++)
+                        {
+                            netOutputPtr[channelX * netArea + y * netWidth + x] = unitX;
+                            netOutputPtr[channelY * netArea + y * netWidth + x] = unitY;
+                        }
+                }
+            }
+        }
+        // Background channel
+        if (op::addBkgChannel(poseModel) && numberBodyParts < syntheticHeatMaps.channels)
+        {
+            for (auto i = 0 ; i < netArea ; i++)
+            {
+                auto maximum = 0.f;
+                for (auto part = 0 ; part < numberBodyParts ; part++)
+                    maximum = std::max(maximum, netOutputPtr[part * netArea + i]);
+                netOutputPtr[numberBodyParts * netArea + i] = 1.f - maximum;
+            }
+        }
+        // Upsampled heat maps
+        syntheticHeatMaps.heatMaps.resize((size_t)syntheticHeatMaps.channels * width * height);
+        op::resizeAndMergeCpu(
+            syntheticHeatMaps.heatMaps.data(), {syntheticHeatMaps.netOutput.data()},
+            {1, syntheticHeatMaps.channels, height, width}, {{1, syntheticHeatMaps.channels, netHeight, netWidth}});
+        return syntheticHeatMaps;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return SyntheticHeatMaps{};
+    }
+}
+
+void addResult(
+    std::vector<KernelResult>& kernelResults, const std::string& kernel, const std::string& backend,
+    const int width, const int height, const int channels, const int people, const double timeMs, const double bytes)
+{
+    // Speedup with respect to the CPU version of the same configuration (benchmarked first)
+    auto speedup = 1.;
+    for (const auto& kernelResult : kernelResults)
+        if (kernelResult.kernel == kernel && kernelResult.backend == "cpu" && kernelResult.width == width
+            && kernelResult.height == height && kernelResult.channels == channels && kernelResult.people == people)
+            speedup = kernelResult.timeMs / timeMs;
+    kernelResults.emplace_back(KernelResult{kernel, backend, width, height, channels, people, timeMs, bytes, speedup});
+    op::opLog(kernel + " (" + backend + "), " + std::to_string(width) + "x" + std::to_string(height) + ", "
+              + std::to_string(channels) + " channels, " + std::to_string(people) + " people: "
+              + std::to_string(timeMs) + " ms.", op::Priority::High);
+}
+
+void benchmarkResizeAndMerge(std::vector<KernelResult>& kernelResults, const SyntheticHeatMaps& syntheticHeatMaps,
+                             const int people)
+{
+    try
+    {
+        const auto width = syntheticHeatMaps.width;
+        const auto height = syntheticHeatMaps.height;
+        const auto channels = syntheticHeatMaps.channels;
+        const std::array<int, 4> targetSize{1, channels, height, width};
+        const std::vector<std::array<int, 4>> sourceSizes{{1, channels, std::max(1, height/8), std::max(1, width/8)}};
+        const auto bytes = (double)(syntheticHeatMaps.netOutput.size() + syntheticHeatMaps.heatMaps.size())
+                         * sizeof(float);
+        // CPU
+        std::vector<float> target(syntheticHeatMaps.heatMaps.size());
+        const auto timeMs = timeCpuMs([&]{
+            op::resizeAndMergeCpu(target.data(), {syntheticHeatMaps.netOutput.data()}, targetSize, sourceSizes); });
+        addResult(kernelResults, "resizeAndMerge", "cpu", width, height, channels, people, timeMs, bytes);
+        // CUDA
+        #ifdef USE_CUDA
+            auto* sourceGpuPtr = uploadCuda(syntheticHeatMaps.netOutput);
+            auto* targetGpuPtr = uploadCuda(target);
+            const auto timeCudaMsValue = timeCudaMs([&]{
+                op::resizeAndMergeGpu(targetGpuPtr, {sourceGpuPtr}, targetSize, sourceSizes); });
+            addResult(kernelResults, "resizeAndMerge", "cuda", width, height, channels, people, timeCudaMsValue, bytes);
+            cudaFree(sourceGpuPtr);
+            cudaFree(targetGpuPtr);
+        #endif
+        // OpenCL
+        #ifdef USE_OPENCL
+            auto* sourceClPtr = uploadOpenCl(syntheticHeatMaps.netOutput);
+            auto* targetClPtr = uploadOpenCl(target);
+            std::vector<float*> sourceTempPtrs(1, nullptr);
+            const auto timeOpenClMsValue = timeOpenClMs([&]{
+                op::resizeAndMergeOcl(
+                    targetClPtr, {sourceClPtr}, sourceTempPtrs, targetSize, sourceSizes, {1.f}, FLAGS_num_gpu_start);
+            });
+            addResult(kernelResults, "resizeAndMerge", "opencl", width, height, channels, people, timeOpenClMsValue,
+                      bytes);
+            clReleaseMemObject((cl_mem)sourceClPtr);
+            clReleaseMemObject((cl_mem)targetClPtr);
+            for (auto* sourceTempPtr : sourceTempPtrs)
+                if (sourceTempPtr != nullptr)
+                    clReleaseMemObject((cl_mem)sourceTempPtr);
+        #endif
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+void benchmarkNmsAndConnectBodyParts(
+    std::vector<KernelResult>& kernelResults, const SyntheticHeatMaps& syntheticHeatMaps, const int people,
+    const op::PoseModel poseModel)
+{
+    try
+    {
+        const auto width = syntheticHeatMaps.width;
+        const auto height = syntheticHeatMaps.height;
+        const auto channels = syntheticHeatMaps.channels;
+        const auto numberBodyParts = (int)op::getPoseNumberBodyParts(poseModel);
+        const auto maxPeaks = (int)op::getPoseMaxPeaks();
+        const auto nmsThreshold = op::getPoseDefaultNmsThreshold(poseModel);
+        const std::array<int, 4> sourceSize{1, numberBodyParts, height, width};
+        const std::array<int, 4> targetSize{1, numberBodyParts, maxPeaks + 1, 3};
+        const auto sourceVolume = (size_t)numberBodyParts * height * width;
+        const auto nmsBytes = 2. * sourceVolume * sizeof(float);
+        const op::Point<float> offset{0.5f, 0.5f};
+        std::vector<float> peaks((size_t)numberBodyParts * (maxPeaks + 1) * 3);
+        // NMS - CPU
+        std::vector<int> kernel(sourceVolume);
+        if (isKernelSelected("nms") || isKernelSelected("connectBodyParts"))
+        {
+            const auto timeMs = timeCpuMs([&]{
+                op::nmsCpu(peaks.data(), kernel.data(), syntheticHeatMaps.heatMaps.data(), nmsThreshold, targetSize,
+                           sourceSize, offset); });
+            if (isKernelSelected("nms"))
+                addResult(kernelResults, "nms", "cpu", width, height, numberBodyParts, people, timeMs, nmsBytes);
+        }
+        // Connect body parts - CPU
+        const auto interMinAboveThreshold = op::getPoseDefaultConnectInterMinAboveThreshold();
+        const auto interThreshold = op::getPoseDefaultConnectInterThreshold(poseModel);
+        const auto minSubsetCnt = (int)op::getPoseDefaultMinSubsetCnt();
+        const auto minSubsetScore = op::getPoseDefaultConnectMinSubsetScore();
+        const op::Point<int> heatMapSize{width, height};
+        if (isKernelSelected("connectBodyParts"))
+        {
+            op::Array<float> poseKeypoints;
+            op::Array<float> poseScores;
+            const auto timeMs = timeCpuMs([&]{
+                op::connectBodyPartsCpu(
+                    poseKeypoints, poseScores, syntheticHeatMaps.heatMaps.data(), peaks.data(), poseModel,
+                    heatMapSize, maxPeaks, interMinAboveThreshold, interThreshold, minSubsetCnt, minSubsetScore,
+                    nmsThreshold); });
+            addResult(kernelResults, "connectBodyParts", "cpu", width, height, channels, people, timeMs, 0.);
+            if (poseKeypoints.getSize(0) != people)
+                op::opLog("connectBodyParts found " + std::to_string(poseKeypoints.getSize(0)) + " out of "
+                          + std::to_string(people) + " synthetic people.", op::Priority::High);
+        }
+        #ifdef USE_CUDA
+            auto* heatMapsGpuPtr = uploadCuda(syntheticHeatMaps.heatMaps);
+            auto* peaksGpuPtr = uploadCuda(peaks);
+            int* kernelGpuPtr;
+            cudaMalloc((void**)&kernelGpuPtr, sourceVolume * sizeof(int));
+            // NMS - CUDA
+            const auto timeNmsMs = timeCudaMs([&]{
+                op::nmsGpu(peaksGpuPtr, kernelGpuPtr, heatMapsGpuPtr, nmsThreshold, targetSize, sourceSize, offset);
+            });
+            if (isKernelSelected("nms"))
+                addResult(kernelResults, "nms", "cuda", width, height, numberBodyParts, people, timeNmsMs, nmsBytes);
+            // Connect body parts - CUDA (with the GPU people assembly if the model supports it)
+            if (isKernelSelected("connectBodyParts"))
+            {
+                const auto& bodyPartPairs = op::getPosePartPairs(poseModel);
+                auto mapIdx = op::getPoseMapIndex(poseModel);
+                for (auto& i : mapIdx)
+                    i += numberBodyParts + (op::addBkgChannel(poseModel) ? 1 : 0);
+                auto* bodyPartPairsGpuPtr = uploadCuda(bodyPartPairs);
+                auto* mapIdxGpuPtr = uploadCuda(mapIdx);
+                op::Array<float> pairScoresCpu;
+                pairScoresCpu.resetPinned({(int)bodyPartPairs.size() / 2, maxPeaks, maxPeaks});
+                float* pairScoresGpuPtr;
+                cudaMalloc((void**)&pairScoresGpuPtr, pairScoresCpu.getVolume() * sizeof(float));
+                void* assemblyWorkspaceGpuPtr = nullptr;
+                const auto assemblyWorkspaceBytes = op::getConnectBodyPartsGpuWorkspaceBytes<float>(
+                    poseModel, maxPeaks);
+                if (assemblyWorkspaceBytes > 0)
+                    cudaMalloc(&assemblyWorkspaceGpuPtr, assemblyWorkspaceBytes);
+                op::Array<float> poseKeypoints;
+                op::Array<float> poseScores;
+                const auto timeMs = timeCudaMs([&]{
+                    op::connectBodyPartsGpu(
+                        poseKeypoints, poseScores, heatMapsGpuPtr, peaks.data(), poseModel, heatMapSize, maxPeaks,
+                        interMinAboveThreshold, interThreshold, minSubsetCnt, minSubsetScore, nmsThreshold, 1.f,
+                        false, pairScoresCpu, pairScoresGpuPtr, bodyPartPairsGpuPtr, mapIdxGpuPtr, peaksGpuPtr,
+                        assemblyWorkspaceGpuPtr); });
+                addResult(kernelResults, "connectBodyParts", "cuda", width, height, channels, people, timeMs, 0.);
+                // Sparse PAF scoring (same results)
+                int* pafCandidatesGpuPtr;
+                cudaMalloc((void**)&pafCandidatesGpuPtr, (pairScoresCpu.getVolume() + 1) * sizeof(int));
+                const auto timeSparseMs = timeCudaMs([&]{
+                    op::connectBodyPartsGpu(
+                        poseKeypoints, poseScores, heatMapsGpuPtr, peaks.data(), poseModel, heatMapSize, maxPeaks,
+                        interMinAboveThreshold, interThreshold, minSubsetCnt, minSubsetScore, nmsThreshold, 1.f,
+                        false, pairScoresCpu, pairScoresGpuPtr, bodyPartPairsGpuPtr, mapIdxGpuPtr, peaksGpuPtr,
+                        assemblyWorkspaceGpuPtr, nullptr, -1, pafCandidatesGpuPtr); });
+                addResult(kernelResults, "connectBodyParts", "cuda_sparse", width, height, channels, people,
+                          timeSparseMs, 0.);
+                // PAFs read from the network output (bilinear interpolation) rather than from the heat maps
+                const auto pafWidth = std::max(1, width/8);
+                const auto pafHeight = std::max(1, height/8);
+                auto* pafsGpuPtr = uploadCuda(syntheticHeatMaps.netOutput);
+                const auto timePafsMs = timeCudaMs([&]{
+                    op::connectBodyPartsGpu(
+                        poseKeypoints, poseScores, heatMapsGpuPtr, peaks.data(), poseModel, heatMapSize, maxPeaks,
+                        interMinAboveThreshold, interThreshold, minSubsetCnt, minSubsetScore, nmsThreshold, 1.f,
+                        false, pairScoresCpu, pairScoresGpuPtr, bodyPartPairsGpuPtr, mapIdxGpuPtr, peaksGpuPtr,
+                        assemblyWorkspaceGpuPtr, nullptr, -1, pafCandidatesGpuPtr, 1.f, 0.f, pafsGpuPtr,
+                        op::Point<int>{pafWidth, pafHeight}); });
+                addResult(kernelResults, "connectBodyParts", "cuda_paf_low_resolution", width, height, channels,
+                          people, timePafsMs, 0.);
+                cudaFree(pafsGpuPtr);
+                cudaFree(pafCandidatesGpuPtr);
+                cudaFree(bodyPartPairsGpuPtr);
+                cudaFree(mapIdxGpuPtr);
+                cudaFree(pairScoresGpuPtr);
+                if (assemblyWorkspaceGpuPtr != nullptr)
+                    cudaFree(assemblyWorkspaceGpuPtr);
+            }
+            cudaFree(heatMapsGpuPtr);
+            cudaFree(peaksGpuPtr);
+            cudaFree(kernelGpuPtr);
+        #endif
+        #ifdef USE_OPENCL
+            // NMS - OpenCL
+            if (isKernelSelected("nms"))
+            {
+                auto* heatMapsClPtr = uploadOpenCl(std::vector<float>(
+                    syntheticHeatMaps.heatMaps.begin(), syntheticHeatMaps.heatMaps.begin() + sourceVolume));
+                auto* peaksClPtr = uploadOpenCl(peaks);
+                auto* kernelClPtr = (uint8_t*)clCreateBuffer(
+                    op::OpenCL::getInstance(FLAGS_num_gpu_start)->getContext().operator()(), CL_MEM_READ_WRITE,
+                    sourceVolume * sizeof(uint8_t), nullptr, nullptr);
+                std::vector<uint8_t> kernelCpu(sourceVolume);
+                const auto timeMs = timeOpenClMs([&]{
+                    op::nmsOcl(peaksClPtr, kernelClPtr, kernelCpu.data(), heatMapsClPtr, nmsThreshold, targetSize,
+                               sourceSize, offset, FLAGS_num_gpu_start); });
+                addResult(kernelResults, "nms", "opencl", width, height, numberBodyParts, people, timeMs, nmsBytes);
+                clReleaseMemObject((cl_mem)heatMapsClPtr);
+                clReleaseMemObject((cl_mem)peaksClPtr);
+                clReleaseMemObject((cl_mem)kernelClPtr);
+            }
+        #endif
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+void benchmarkMaximum(std::vector<KernelResult>& kernelResults, const int channels, const int people)
+{
+    try
+    {
+        // Face/hand heat maps of `people` faces or hands (batched), with random values
+        const auto netSize = op::flagsToPoint(op::String(FLAGS_face_net_resolution), "368x368");
+        const auto width = netSize.x;
+        const auto height = netSize.y;
+        const std::array<int, 4> sourceSize{people, channels, height, width};
+        const std::array<int, 4> targetSize{people, 1, channels - 1, 3};
+        std::vector<float> source((size_t)people * channels * height * width);
+        cv::Mat sourceMat(1, (int)source.size(), CV_32FC1, source.data());
+        cv::randu(sourceMat, 0.f, 1.f);
+        std::vector<float> target((size_t)people * (channels - 1) * 3);
+        const auto bytes = (double)source.size() * sizeof(float);
+        // CPU
+        const auto timeMs = timeCpuMs([&]{ op::maximumCpu(target.data(), source.data(), targetSize, sourceSize); });
+        addResult(kernelResults, "maximum", "cpu", width, height, channels, people, timeMs, bytes);
+        // CUDA
+        #ifdef USE_CUDA
+            auto* sourceGpuPtr = uploadCuda(source);
+            auto* targetGpuPtr = uploadCuda(target);
+            const auto timeCudaMsValue = timeCudaMs([&]{
+                op::maximumGpu(targetGpuPtr, sourceGpuPtr, targetSize, sourceSize); });
+            addResult(kernelResults, "maximum", "cuda", width, height, channels, people, timeCudaMsValue, bytes);
+            cudaFree(sourceGpuPtr);
+            cudaFree(targetGpuPtr);
+        #endif
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+void benchmarkPyramidalLK(std::vector<KernelResult>& kernelResults, const int width, const int height,
+                          const int people, const op::PoseModel poseModel)
+{
+    try
+    {
+        #ifndef _WIN32
+            // Random texture, and the same texture shifted by (1.5, 0.75) pixels
+            cv::Mat imagePrevious(height, width, CV_8UC1);
+            cv::randu(imagePrevious, 0, 255);
+            cv::GaussianBlur(imagePrevious, imagePrevious, cv::Size{5, 5}, 1.5);
+            cv::Mat imageCurrent;
+            const cv::Mat shift = (cv::Mat_<double>(2, 3) << 1, 0, 1.5, 0, 1, 0.75);
+            cv::warpAffine(imagePrevious, imageCurrent, shift, imagePrevious.size());
+            // 1 point per keypoint of each person
+            const auto numberPoints = people * (int)op::getPoseNumberBodyParts(poseModel);
+            std::mt19937 randomGenerator{(unsigned int)numberPoints};
+            std::uniform_real_distribution<float> uniformX{16.f, width - 16.f};
+            std::uniform_real_distribution<float> uniformY{16.f, height - 16.f};
+            std::vector<cv::Point2f> pointsPrevious(numberPoints);
+            for (auto& point : pointsPrevious)
+                point = cv::Point2f{uniformX(randomGenerator), uniformY(randomGenerator)};
+            const auto bytes = 2. * width * height;
+            const auto channels = 1;
+            // CPU (pyramids of both frames built on every iteration)
+            const auto timeMs = timeCpuMs([&]{
+                auto pointsCurrent = pointsPrevious;
+                std::vector<cv::Mat> pyramidImagesPrevious;
+                std::vector<cv::Mat> pyramidImagesCurrent;
+                std::vector<char> status(numberPoints, 0);
+                op::pyramidalLKCpu(
+                    pointsPrevious, pointsCurrent, pyramidImagesPrevious, pyramidImagesCurrent, status, imagePrevious,
+                    imageCurrent); });
+            addResult(kernelResults, "pyramidalLK", "cpu", width, height, channels, people, timeMs, bytes);
+            // OpenCV
+            const auto timeOcvMs = timeCpuMs([&]{
+                auto pointsCurrent = pointsPrevious;
+                std::vector<cv::Mat> pyramidImagesPrevious;
+                std::vector<cv::Mat> pyramidImagesCurrent;
+                std::vector<char> status(numberPoints, 0);
+                op::pyramidalLKOcv(
+                    pointsPrevious, pointsCurrent, pyramidImagesPrevious, pyramidImagesCurrent, status, imagePrevious,
+                    imageCurrent); });
+            addResult(kernelResults, "pyramidalLK", "opencv", width, height, channels, people, timeOcvMs, bytes);
+            // CUDA (batched version: as in PersonTracker, only the pyramid of the new frame is built)
+            #ifdef USE_CUDA
+                op::PyramidGpu pyramidPrevious;
+                op::PyramidGpu pyramidCurrent;
+                op::buildPyramidGpu(pyramidPrevious, imagePrevious);
+                const auto timeCudaMsValue = timeCudaMs([&]{
+                    auto pointsCurrent = pointsPrevious;
+                    std::vector<char> status(numberPoints, 0);
+                    op::buildPyramidGpu(pyramidCurrent, imageCurrent);
+                    op::pyramidalLKGpu(pointsPrevious, pointsCurrent, status, pyramidPrevious, pyramidCurrent); });
+                addResult(kernelResults, "pyramidalLK", "cuda", width, height, channels, people, timeCudaMsValue,
+                          bytes);
+            #endif
+        #else
+            UNUSED(kernelResults);
+            UNUSED(width);
+            UNUSED(height);
+            UNUSED(people);
+            UNUSED(poseModel);
+            op::opLog("pyramidalLK is not exported on Windows, so it is not benchmarked.", op::Priority::High);
+        #endif
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+int openPoseKernelBenchmark()
+{
+    try
+    {
+        op::opLog("Starting OpenPose kernel benchmark...", op::Priority::High);
+        const auto opTimer = op::getTimerInit();
+
+        // logging_level
+        op::checkBool(
+            0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+            __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+        op::checkBool(FLAGS_kbench_iterations > 0, "`--kbench_iterations` must be greater than 0.",
+                      __LINE__, __FUNCTION__, __FILE__);
+        #ifdef USE_CUDA
+            cudaSetDevice(FLAGS_num_gpu_start);
+        #endif
+
+        const auto poseModel = op::flagsToPoseModel(op::String(FLAGS_model_pose));
+        const auto people = splitIntList(FLAGS_kbench_people, {1});
+        const auto maxBytes = FLAGS_kbench_max_megabytes * 1024. * 1024.;
+        std::vector<KernelResult> kernelResults;
+
+        // resizeAndMerge, nms, connectBodyParts, and pyramidalLK
+        for (const auto& resolution : splitList(FLAGS_kbench_resolutions))
+        {
+            const auto netSize = op::flagsToPoint(op::String(resolution), "656x368");
+            for (const auto numberPeople : people)
+            {
+                // Model channels (nms and connectBodyParts), plus any other channels for resizeAndMerge
+                for (const auto channels : splitIntList(FLAGS_kbench_channels, {-1}))
+                {
+                    const auto modelChannels = (int)op::getPoseNumberBodyParts(poseModel)
+                        + (op::addBkgChannel(poseModel) ? 1 : 0) + (int)op::getPoseMapIndex(poseModel).size();
+                    const auto heatMapsChannels = (channels > 0 ? channels : modelChannels);
+                    if (4. * heatMapsChannels * netSize.x * netSize.y > maxBytes)
+                    {
+                        op::opLog("Skipping " + resolution + " with " + std::to_string(heatMapsChannels)
+                                  + " channels (more than `--kbench_max_megabytes`).", op::Priority::High);
+                        continue;
+                    }
+                    const auto syntheticHeatMaps = createSyntheticHeatMaps(
+                        poseModel, netSize.x, netSize.y, numberPeople, heatMapsChannels);
+                    if (isKernelSelected("resizeAndMerge"))
+                        benchmarkResizeAndMerge(kernelResults, syntheticHeatMaps, numberPeople);
+                    if (heatMapsChannels == modelChannels
+                        && (isKernelSelected("nms") || isKernelSelected("connectBodyParts")))
+                        benchmarkNmsAndConnectBodyParts(kernelResults, syntheticHeatMaps, numberPeople, poseModel);
+                }
+                if (isKernelSelected("pyramidalLK"))
+                    benchmarkPyramidalLK(kernelResults, netSize.x, netSize.y, numberPeople, poseModel);
+            }
+        }
+        // maximum (face and hand heat maps)
+        if (isKernelSelected("maximum"))
+        {
+            const auto faceSize = op::flagsToPoint(op::String(FLAGS_face_net_resolution), "368x368");
+            for (const auto channels : splitIntList(FLAGS_kbench_channels, {71, 22}))
+                for (const auto numberPeople : people)
+                {
+                    if (channels < 2 || 4. * numberPeople * channels * faceSize.x * faceSize.y > maxBytes)
+                        op::opLog("Skipping maximum with " + std::to_string(channels) + " channels and "
+                                  + std::to_string(numberPeople) + " people.", op::Priority::High);
+                    else
+                        benchmarkMaximum(kernelResults, channels, numberPeople);
+                }
+        }
+
+        // Write JSON
+        std::stringstream stringStream;
+        stringStream << std::fixed << std::setprecision(4)
+            << "{\n"
+            << "  \"openpose_version\": " << toJsonString(OPEN_POSE_VERSION_STRING) << ",\n"
+            << "  \"model_pose\": " << toJsonString(FLAGS_model_pose) << ",\n"
+            << "  \"iterations\": " << FLAGS_kbench_iterations << ",\n"
+            << "  \"warmup_iterations\": " << FLAGS_kbench_warmup << ",\n"
+            << "  \"results\": [\n";
+        for (auto i = 0u ; i < kernelResults.size() ; i++)
+        {
+            const auto& kernelResult = kernelResults[i];
+            stringStream
+                << "    {\"kernel\": " << toJsonString(kernelResult.kernel)
+                << ", \"backend\": " << toJsonString(kernelResult.backend)
+                << ", \"width\": " << kernelResult.width
+                << ", \"height\": " << kernelResult.height
+                << ", \"channels\": " << kernelResult.channels
+                << ", \"people\": " << kernelResult.people
+                << ", \"time_ms\": " << kernelResult.timeMs
+                << ", \"gb_per_second\": ";
+            if (kernelResult.bytes > 0. && kernelResult.timeMs > 0.)
+                stringStream << kernelResult.bytes / (kernelResult.timeMs * 1e6);
+            else
+                stringStream << "null";
+            stringStream << ", \"speedup\": " << kernelResult.speedup << "}"
+                << (i + 1 < kernelResults.size() ? ",\n" : "\n");
+        }
+        stringStream << "  ]\n}\n";
+        if (FLAGS_kbench_output.empty())
+            std::cout << stringStream.str();
+        else
+        {
+            std::ofstream jsonFile{FLAGS_kbench_output};
+            if (!jsonFile.is_open())
+                op::error("Could not open file: " + FLAGS_kbench_output, __LINE__, __FUNCTION__, __FILE__);
+            jsonFile << stringStream.str();
+            op::opLog("Kernel benchmark results saved in " + FLAGS_kbench_output + ".", op::Priority::High);
+        }
+
+        // Measuring total time
+        op::printTime(opTimer, "OpenPose kernel benchmark successfully finished. Total time: ", " seconds.",
+                      op::Priority::High);
+
+        // Return successful message
+        return 0;
+    }
+    catch (const std::exception&)
+    {
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running openPoseKernelBenchmark
+    return openPoseKernelBenchmark();
+}
@@ -0,0 +1,794 @@
+// ------------------------------------------- OpenPose Benchmark Harness -------------------------------------------
+// This binary runs the whole OpenPose Wrapper pipeline (pre-processing, network, post-processing, rendering and
+// output) on a fixed set of images, and it reports throughput (FPS), end-to-end latency percentiles, and per-stage
+// timings as JSON. It can sweep over several configurations in a single call, e.g.:
+//     ./build/examples/benchmark/openpose_bench.bin --bench_net_resolutions "-1x368,-1x256" --bench_batch_sizes "1,4"
+//         --bench_output bench.json
+// Each configuration (net resolution x pose model x number of GPUs x batch size x maximum number of people) runs on
+// its own Wrapper instance, so the results of different configurations are independent.
+// Stages:
+// - `pose`: From the frame entering the pipeline until the end of the OpenPose processing (ID generation, scaling,
+//   pre-processing, network forward pass, body part connection, face/hand if enabled and rendering).
+// - `output`: From the end of the OpenPose processing until the frame reaches the benchmark output worker.
+// For a finer-grained (per-worker) breakdown, compile OpenPose with `PROFILER_ENABLED` and use `--profile_speed`.
+// A recording of `openpose --input_record` (e.g., of a live camera) can be used as input with `--bench_replay`, and
+// `--bench_replay_real_time` feeds its frames with their recorded cadence rather than as fast as possible.
+// `--bench_memory` also reports the memory footprint of each configuration: host resident set size and device memory
+// of each used GPU (baseline, peak and steady), and the device memory of each OpenPose component (e.g., `NetCaffe`,
+// `NmsCaffe` or `Renderers`, see `op::CudaMemoryOwner`). Memory that OpenPose does not allocate itself (e.g., the
+// CUDA context or the cuDNN workspaces) is only part of the per-GPU totals.
+
+// Third-party dependencies
+#include <opencv2/opencv.hpp>
+// Command-line user interface
+#define OPENPOSE_FLAGS_DISABLE_PRODUCER
+#define OPENPOSE_FLAGS_DISABLE_DISPLAY
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+#include <openpose/gpu/cudaMemoryPool.hpp> // Not part of openpose/headers.hpp
+// Benchmark utilities
+#include "benchmarkUtilities.hpp"
+// C++ std library dependencies
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <map>
+#include <thread>
+#ifdef _WIN32
+    #include <windows.h>
+    #include <psapi.h> // GetProcessMemoryInfo
+#else
+    #include <unistd.h> // sysconf
+#endif
+
+// Custom OpenPose flags
+// Benchmark
+DEFINE_string(bench_media_dir,          "examples/media/",
+    "Directory of images used as fixed benchmark input. They are read once and cycled through, so disk I/O and image"
+    " decoding are not part of the measurements.");
+DEFINE_string(bench_input_resolution,   "-1x-1",
+    "If not `-1x-1`, the benchmark images are resized to this resolution (once, before the benchmark starts).");
+DEFINE_string(bench_net_resolutions,    "",
+    "Comma-separated list of net resolutions to benchmark (e.g., `-1x368,-1x256`). Empty to use `--net_resolution`.");
+DEFINE_string(bench_models,             "",
+    "Comma-separated list of pose models to benchmark (e.g., `BODY_25,COCO`). Empty to use `--model_pose`.");
+DEFINE_string(bench_num_gpus,           "",
+    "Comma-separated list of numbers of GPUs to benchmark (e.g., `1,2`). Empty to use `--num_gpu`.");
+DEFINE_string(bench_batch_sizes,        "",
+    "Comma-separated list of batch sizes to benchmark (e.g., `1,4,8`). Empty to use `--batch_size`.");
+DEFINE_string(bench_people_max,         "",
+    "Comma-separated list of maximum numbers of people to benchmark (e.g., `-1,1`). Empty to use"
+    " `--number_people_max`.");
+DEFINE_uint64(bench_warmup_frames,      20,
+    "Number of frames processed (and excluded from the statistics) before measuring each configuration.");
+DEFINE_uint64(bench_frames,             200,
+    "Number of frames measured for each configuration.");
+DEFINE_int32(bench_max_in_flight,       0,
+    "Maximum number of frames concurrently inside the pipeline. 0 (default) to use 2 x number of GPUs x batch size,"
+    " which keeps all GPUs busy without latency being dominated by queueing. -1 to not limit it (pure throughput"
+    " measurement, latency then includes the time each frame waits in the input queues).");
+DEFINE_string(bench_replay,             "",
+    "If not empty, the frames of this input recording (see `openpose --input_record`) are used instead of the images"
+    " of `--bench_media_dir` (and `--bench_input_resolution`). Only its first view is used.");
+DEFINE_bool(bench_replay_real_time,     false,
+    "If true, the frames of `--bench_replay` are fed with their recorded arrival times (cycling over the recording),"
+    " rather than as fast as the pipeline accepts them. Useful to reproduce the latency of a live camera.");
+DEFINE_bool(bench_memory,               false,
+    "If true, the host memory (resident set size) and the device memory of each used GPU are sampled while each"
+    " configuration runs, and they are reported (in MB) as baseline (before the Wrapper starts), peak and steady"
+    " (mean while the measured frames run) values, together with the device memory of each OpenPose component.");
+DEFINE_int32(bench_memory_interval_ms,  10,
+    "Sampling interval (in milliseconds) of `--bench_memory`.");
+DEFINE_string(bench_output,             "",
+    "Path of the JSON file where the results are written. Empty to print them on the standard output.");
+
+struct BenchInFlightSlot;
+
+// Datum with the timestamps at each stage of the pipeline
+struct BenchDatum : public op::Datum
+{
+    bool warmup;
+    TimePoint timeInput;
+    TimePoint timePostProcessing;
+    // Shared by the copies of the Datum, released when the last one is destroyed
+    std::shared_ptr<BenchInFlightSlot> inFlightSlot;
+
+    BenchDatum(const bool warmup_ = false) :
+        warmup{warmup_}
+    {}
+};
+
+typedef std::shared_ptr<std::vector<std::shared_ptr<BenchDatum>>> BenchDatumsSP;
+
+// Measurements shared by the input and output workers of a single configuration
+struct BenchState
+{
+    std::mutex mutex;
+    std::condition_variable conditionVariable;
+    int maxInFlight;
+    int inFlight;
+    std::vector<double> latenciesMs;
+    std::vector<double> poseMs;
+    std::vector<double> outputMs;
+    unsigned long long numberPeople;
+    bool firstMeasuredFrameStarted;
+    TimePoint timeFirstMeasuredInput;
+    TimePoint timeLastOutput;
+
+    BenchState(const int maxInFlight_) :
+        maxInFlight{maxInFlight_},
+        inFlight{0},
+        numberPeople{0ull},
+        firstMeasuredFrameStarted{false}
+    {}
+};
+
+// 1 of the BenchState::maxInFlight slots (BenchState::inFlight must be incremented when it is created). It is freed
+// when its Datum is destroyed, so the frames dropped by the pipeline (which never reach WBenchOutput) also free
+// theirs, and WBenchInput does not wait forever for them
+struct BenchInFlightSlot
+{
+    BenchState& rBenchState;
+
+    explicit BenchInFlightSlot(BenchState& benchState) :
+        rBenchState(benchState)
+    {}
+
+    ~BenchInFlightSlot()
+    {
+        const std::lock_guard<std::mutex> lock{rBenchState.mutex};
+        rBenchState.inFlight--;
+        rBenchState.conditionVariable.notify_all();
+    }
+};
+
+// This worker cycles over the pre-loaded images until `warmup + frames` datums have been produced. If
+// `timestampsMs` is not empty, each image is fed at its recorded arrival time (relative to the first datum)
+class WBenchInput : public op::WorkerProducer<BenchDatumsSP>
+{
+public:
+    WBenchInput(
+        const std::vector<cv::Mat>& images, const std::vector<double>& timestampsMs,
+        const unsigned long long warmupFrames, const unsigned long long measuredFrames, BenchState& benchState) :
+        mImages(images),
+        mTimestampsMs(timestampsMs),
+        mWarmupFrames{warmupFrames},
+        mTotalFrames{warmupFrames + measuredFrames},
+        rBenchState(benchState),
+        mCounter{0ull}
+    {
+        // Duration of a cycle over the recording (1 extra average frame interval between its last and first frames)
+        mCycleMs = (mTimestampsMs.size() > 1
+            ? mTimestampsMs.back() * mTimestampsMs.size() / (mTimestampsMs.size() - 1) : 0.);
+    }
+
+    void initializationOnThread() {}
+
+    BenchDatumsSP workProducer()
+    {
+        try
+        {
+            if (mTotalFrames <= mCounter)
+            {
+                this->stop();
+                return nullptr;
+            }
+            // Recorded cadence (frames are never skipped, they are fed right away if the pipeline is late)
+            if (!mTimestampsMs.empty())
+            {
+                if (mCounter == 0ull)
+                    mTimeBegin = std::chrono::high_resolution_clock::now();
+                const auto timeMs = (mCounter / mTimestampsMs.size()) * mCycleMs
+                                  + mTimestampsMs[mCounter % mTimestampsMs.size()];
+                std::this_thread::sleep_until(
+                    mTimeBegin + std::chrono::nanoseconds{(long long)std::round(timeMs * 1e6)});
+            }
+            // Declared before the lock, so it is destroyed (freeing its slot) after unlocking it
+            BenchDatumsSP datumsPtr;
+            // Wait until there is room in the pipeline
+            std::unique_lock<std::mutex> lock{rBenchState.mutex};
+            if (rBenchState.maxInFlight > 0)
+            {
+                while (rBenchState.inFlight >= rBenchState.maxInFlight)
+                {
+                    rBenchState.conditionVariable.wait_for(lock, std::chrono::milliseconds{100});
+                    // Avoid blocking forever if the pipeline was stopped (e.g., due to an error)
+                    if (!this->isRunning())
+                        return nullptr;
+                }
+            }
+            // Create new datum
+            datumsPtr = std::make_shared<std::vector<std::shared_ptr<BenchDatum>>>();
+            datumsPtr->emplace_back(std::make_shared<BenchDatum>(mCounter < mWarmupFrames));
+            auto& datumPtr = datumsPtr->at(0);
+            rBenchState.inFlight++;
+            datumPtr->inFlightSlot = std::make_shared<BenchInFlightSlot>(rBenchState);
+            const cv::Mat& cvInputData = mImages.at(mCounter % mImages.size());
+            datumPtr->cvInputData = OP_CV2OPCONSTMAT(cvInputData);
+            datumPtr->timeInput = std::chrono::high_resolution_clock::now();
+            if (!datumPtr->warmup && !rBenchState.firstMeasuredFrameStarted)
+            {
+                rBenchState.firstMeasuredFrameStarted = true;
+                rBenchState.timeFirstMeasuredInput = datumPtr->timeInput;
+            }
+            mCounter++;
+            return datumsPtr;
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+private:
+    const std::vector<cv::Mat>& mImages;
+    const std::vector<double>& mTimestampsMs;
+    double mCycleMs;
+    TimePoint mTimeBegin;
+    const unsigned long long mWarmupFrames;
+    const unsigned long long mTotalFrames;
+    BenchState& rBenchState;
+    unsigned long long mCounter;
+};
+
+// This worker stamps the end of the OpenPose processing
+class WBenchPostProcessing : public op::Worker<BenchDatumsSP>
+{
+public:
+    void initializationOnThread() {}
+
+    void work(BenchDatumsSP& datumsPtr)
+    {
+        try
+        {
+            if (datumsPtr != nullptr)
+                for (auto& datumPtr : *datumsPtr)
+                    datumPtr->timePostProcessing = std::chrono::high_resolution_clock::now();
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+};
+
+// This worker records the latency of each frame
+class WBenchOutput : public op::WorkerConsumer<BenchDatumsSP>
+{
+public:
+    WBenchOutput(BenchState& benchState) :
+        rBenchState(benchState)
+    {
+    }
+
+    void initializationOnThread() {}
+
+    void workConsumer(const BenchDatumsSP& datumsPtr)
+    {
+        try
+        {
+            if (datumsPtr != nullptr && !datumsPtr->empty())
+            {
+                const auto timeOutput = std::chrono::high_resolution_clock::now();
+                const std::lock_guard<std::mutex> lock{rBenchState.mutex};
+                for (const auto& datumPtr : *datumsPtr)
+                {
+                    if (!datumPtr->warmup)
+                    {
+                        rBenchState.latenciesMs.emplace_back(durationMs(datumPtr->timeInput, timeOutput));
+                        rBenchState.poseMs.emplace_back(
+                            durationMs(datumPtr->timeInput, datumPtr->timePostProcessing));
+                        rBenchState.outputMs.emplace_back(durationMs(datumPtr->timePostProcessing, timeOutput));
+                        rBenchState.numberPeople += datumPtr->poseKeypoints.getSize(0);
+                        rBenchState.timeLastOutput = timeOutput;
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+private:
+    BenchState& rBenchState;
+};
+
+struct BenchConfiguration
+{
+    std::string netResolution;
+    std::string modelPose;
+    int numberGpus;
+    int batchSize;
+    int numberPeopleMax;
+};
+
+// Resident set size of this process in bytes (0 if unknown)
+unsigned long long getHostResidentBytes()
+{
+    #ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS processMemoryCounters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &processMemoryCounters, sizeof(processMemoryCounters)))
+            return processMemoryCounters.WorkingSetSize;
+        return 0ull;
+    #else
+        // Only available on Linux: 2nd field = resident pages
+        std::ifstream statmFile{"/proc/self/statm"};
+        unsigned long long totalPages = 0ull;
+        unsigned long long residentPages = 0ull;
+        if (!(statmFile >> totalPages >> residentPages))
+            return 0ull;
+        return residentPages * (unsigned long long)sysconf(_SC_PAGESIZE);
+    #endif
+}
+
+double bytesToMb(const unsigned long long bytes)
+{
+    return bytes / double(1 << 20);
+}
+
+// Baseline, peak and steady (mean of the samples taken while the measured frames run) values of a memory usage
+struct MemoryStatistics
+{
+    double baselineMb;
+    double peakMb;
+    double steadySumMb;
+    unsigned long long steadySamples;
+
+    MemoryStatistics() :
+        baselineMb{0.},
+        peakMb{0.},
+        steadySumMb{0.},
+        steadySamples{0ull}
+    {}
+
+    void add(const double mb, const bool steady)
+    {
+        peakMb = std::max(peakMb, mb);
+        if (steady)
+        {
+            steadySumMb += mb;
+            steadySamples++;
+        }
+    }
+
+    std::string toJson() const
+    {
+        std::stringstream stringStream;
+        stringStream << std::fixed << std::setprecision(3)
+            << "{\"baseline\": " << baselineMb << ", \"peak\": " << peakMb
+            << ", \"steady\": " << (steadySamples > 0 ? steadySumMb / steadySamples : 0.) << "}";
+        return stringStream.str();
+    }
+};
+
+struct GpuMemoryStatistics
+{
+    int gpuId;
+    double totalMb;
+    MemoryStatistics used;
+    // Owner (see op::CudaMemoryOwner) --> device memory. Its peak is the one tracked by OpenPose (not sampled)
+    std::map<std::string, MemoryStatistics> owners;
+};
+
+// It samples the host and device memory on its own thread while a configuration runs
+class BenchMemorySampler
+{
+public:
+    BenchMemorySampler(const std::vector<int>& gpuIds, const int intervalMs, BenchState& benchState) :
+        mIntervalMs{std::max(1, intervalMs)},
+        rBenchState(benchState),
+        mStop{false}
+    {
+        // Baseline (the memory cached by the previous configurations is released, so they do not affect it)
+        op::cudaPoolReleaseCache();
+        op::resetCudaMemoryPeaks();
+        mHost.baselineMb = bytesToMb(getHostResidentBytes());
+        mHost.peakMb = mHost.baselineMb;
+        for (const auto gpuId : gpuIds)
+        {
+            unsigned long long freeBytes;
+            unsigned long long totalBytes;
+            if (op::getGpuMemory(freeBytes, totalBytes, gpuId))
+            {
+                GpuMemoryStatistics gpuMemoryStatistics;
+                gpuMemoryStatistics.gpuId = gpuId;
+                gpuMemoryStatistics.totalMb = bytesToMb(totalBytes);
+                gpuMemoryStatistics.used.baselineMb = bytesToMb(totalBytes - freeBytes);
+                gpuMemoryStatistics.used.peakMb = gpuMemoryStatistics.used.baselineMb;
+                for (const auto& ownerStats : op::getCudaMemoryOwnerStats(gpuId))
+                    gpuMemoryStatistics.owners[ownerStats.first].baselineMb = bytesToMb(ownerStats.second.usedBytes);
+                mGpus.emplace_back(gpuMemoryStatistics);
+            }
+        }
+        mThread = std::thread{&BenchMemorySampler::threadFunction, this};
+    }
+
+    ~BenchMemorySampler()
+    {
+        stop();
+    }
+
+    void stop()
+    {
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mStop = true;
+        }
+        mConditionVariable.notify_all();
+        if (mThread.joinable())
+        {
+            mThread.join();
+            // Peaks tracked by OpenPose (some allocations might live shorter than the sampling interval)
+            for (auto& gpu : mGpus)
+                for (const auto& ownerStats : op::getCudaMemoryOwnerStats(gpu.gpuId))
+                    gpu.owners[ownerStats.first].peakMb = bytesToMb(ownerStats.second.peakUsedBytes);
+        }
+    }
+
+    std::string toJson() const
+    {
+        std::stringstream stringStream;
+        stringStream << std::fixed << std::setprecision(3)
+            << "{\n"
+            << "        \"interval_ms\": " << mIntervalMs << ",\n"
+            << "        \"host_rss_mb\": " << mHost.toJson() << ",\n"
+            << "        \"gpus\": [";
+        for (auto i = 0u ; i < mGpus.size() ; i++)
+        {
+            const auto& gpu = mGpus[i];
+            const auto poolStats = op::getCudaMemoryPoolStats(gpu.gpuId);
+            stringStream << (i > 0 ? ",\n" : "\n")
+                << "          {\n"
+                << "            \"gpu\": " << gpu.gpuId << ",\n"
+                << "            \"name\": " << toJsonString(op::getGpuName(gpu.gpuId)) << ",\n"
+                << "            \"total_mb\": " << gpu.totalMb << ",\n"
+                << "            \"used_mb\": " << gpu.used.toJson() << ",\n"
+                << "            \"pool_peak_used_mb\": " << bytesToMb(poolStats.peakUsedBytes) << ",\n"
+                << "            \"owners_mb\": {";
+            auto first = true;
+            for (const auto& owner : gpu.owners)
+            {
+                stringStream << (first ? "\n" : ",\n")
+                    << "              " << toJsonString(owner.first) << ": " << owner.second.toJson();
+                first = false;
+            }
+            stringStream << (first ? "}\n" : "\n            }\n") << "          }";
+        }
+        stringStream << (mGpus.empty() ? "]\n" : "\n        ]\n") << "      }";
+        return stringStream.str();
+    }
+
+private:
+    const int mIntervalMs;
+    BenchState& rBenchState;
+    MemoryStatistics mHost;
+    std::vector<GpuMemoryStatistics> mGpus;
+    std::mutex mMutex;
+    std::condition_variable mConditionVariable;
+    bool mStop;
+    std::thread mThread;
+
+    void threadFunction()
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{mMutex};
+            while (!mConditionVariable.wait_for(
+                lock, std::chrono::milliseconds{mIntervalMs}, [this]{ return mStop; }))
+            {
+                // Steady: Between the first and last measured frames
+                bool steady;
+                {
+                    const std::lock_guard<std::mutex> benchLock{rBenchState.mutex};
+                    steady = (rBenchState.firstMeasuredFrameStarted
+                              && rBenchState.latenciesMs.size() < FLAGS_bench_frames);
+                }
+                mHost.add(bytesToMb(getHostResidentBytes()), steady);
+                for (auto& gpu : mGpus)
+                {
+                    unsigned long long freeBytes;
+                    unsigned long long totalBytes;
+                    if (op::getGpuMemory(freeBytes, totalBytes, gpu.gpuId))
+                        gpu.used.add(bytesToMb(totalBytes - freeBytes), steady);
+                    for (const auto& ownerStats : op::getCudaMemoryOwnerStats(gpu.gpuId))
+                        gpu.owners[ownerStats.first].add(bytesToMb(ownerStats.second.usedBytes), steady);
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            op::opLog("Memory sampling stopped: " + std::string{e.what()}, op::Priority::High);
+        }
+    }
+};
+
+void configureWrapper(
+    op::WrapperT<BenchDatum>& opWrapperT, const BenchConfiguration& benchConfiguration,
+    const std::vector<cv::Mat>& images, const std::vector<double>& timestampsMs, BenchState& benchState)
+{
+    try
+    {
+        // Applying user defined configuration - GFlags to program variables
+        // outputSize
+        const auto outputSize = op::flagsToPoint(op::String(FLAGS_output_resolution), "-1x-1");
+        // netInputSize
+        const auto netInputSize = op::flagsToPoint(op::String(benchConfiguration.netResolution), "-1x368");
+        // faceNetInputSize
+        const auto faceNetInputSize = op::flagsToPoint(op::String(FLAGS_face_net_resolution), "368x368 (multiples of 16)");
+        // handNetInputSize
+        const auto handNetInputSize = op::flagsToPoint(op::String(FLAGS_hand_net_resolution), "368x368 (multiples of 16)");
+        // poseMode
+        const auto poseMode = op::flagsToPoseMode(FLAGS_body);
+        // poseModel
+        const auto poseModel = op::flagsToPoseModel(op::String(benchConfiguration.modelPose));
+        // keypointScaleMode
+        const auto keypointScaleMode = op::flagsToScaleMode(FLAGS_keypoint_scale);
+        // heatmaps to add
+        const auto heatMapTypes = op::flagsToHeatMaps(FLAGS_heatmaps_add_parts, FLAGS_heatmaps_add_bkg,
+                                                      FLAGS_heatmaps_add_PAFs);
+        const auto heatMapScaleMode = op::flagsToHeatMapScaleMode(FLAGS_heatmaps_scale);
+        // >1 camera view?
+        const auto multipleView = false;
+        // Face and hand detectors
+        const auto faceDetector = op::flagsToDetector(FLAGS_face_detector);
+        const auto handDetector = op::flagsToDetector(FLAGS_hand_detector);
+        // Enabling Google Logging
+        const bool enableGoogleLogging = true;
+
+        // Initializing the benchmark workers
+        auto wBenchInput = std::make_shared<WBenchInput>(
+            images, timestampsMs, FLAGS_bench_warmup_frames, FLAGS_bench_frames, benchState);
+        auto wBenchPostProcessing = std::make_shared<WBenchPostProcessing>();
+        auto wBenchOutput = std::make_shared<WBenchOutput>(benchState);
+        // Input on its own thread, so frames are fed while the GPU(s) are busy
+        opWrapperT.setWorker(op::WorkerType::Input, wBenchInput, true);
+        opWrapperT.setWorker(op::WorkerType::PostProcessing, wBenchPostProcessing, false);
+        opWrapperT.setWorker(op::WorkerType::Output, wBenchOutput, true);
+
+        // Pose configuration (use WrapperStructPose{} for default and recommended configuration)
+        const op::WrapperStructPose wrapperStructPose{
+            poseMode, netInputSize, FLAGS_net_resolution_dynamic, outputSize, keypointScaleMode,
+            benchConfiguration.numberGpus, FLAGS_num_gpu_start, FLAGS_scale_number, (float)FLAGS_scale_gap,
+            op::flagsToRenderMode(FLAGS_render_pose, multipleView), poseModel, !FLAGS_disable_blending,
+            (float)FLAGS_alpha_pose, (float)FLAGS_alpha_heatmap, FLAGS_part_to_show, op::String(FLAGS_model_folder),
+            heatMapTypes, heatMapScaleMode, FLAGS_part_candidates, (float)FLAGS_render_threshold,
+            benchConfiguration.numberPeopleMax, FLAGS_maximize_positives, FLAGS_fps_max,
+            op::String(FLAGS_prototxt_path), op::String(FLAGS_caffemodel_path), (float)FLAGS_upsampling_ratio,
+            enableGoogleLogging, benchConfiguration.batchSize, FLAGS_batch_max_wait, FLAGS_tensorrt_precision,
+            FLAGS_heatmaps_fp16};
+        opWrapperT.configure(wrapperStructPose);
+        // Face configuration (use op::WrapperStructFace{} to disable it)
+        const op::WrapperStructFace wrapperStructFace{
+            FLAGS_face, faceDetector, faceNetInputSize,
+            op::flagsToRenderMode(FLAGS_face_render, multipleView, FLAGS_render_pose),
+            (float)FLAGS_face_alpha_pose, (float)FLAGS_face_alpha_heatmap, (float)FLAGS_face_render_threshold};
+        opWrapperT.configure(wrapperStructFace);
+        // Hand configuration (use op::WrapperStructHand{} to disable it)
+        const op::WrapperStructHand wrapperStructHand{
+            FLAGS_hand, handDetector, handNetInputSize, FLAGS_hand_scale_number, (float)FLAGS_hand_scale_range,
+            op::flagsToRenderMode(FLAGS_hand_render, multipleView, FLAGS_render_pose), (float)FLAGS_hand_alpha_pose,
+            (float)FLAGS_hand_alpha_heatmap, (float)FLAGS_hand_render_threshold};
+        opWrapperT.configure(wrapperStructHand);
+        // Extra functionality configuration (use op::WrapperStructExtra{} to disable it)
+        const op::WrapperStructExtra wrapperStructExtra{
+            FLAGS_3d, FLAGS_3d_min_views, FLAGS_identification, FLAGS_tracking, FLAGS_ik_threads};
+        opWrapperT.configure(wrapperStructExtra);
+        // No output nor GUI, so only the processing is measured. Equivalent to:
+        // opWrapperT.configure(op::WrapperStructOutput{}) and opWrapperT.configure(op::WrapperStructGui{})
+        // Set to single-thread (for sequential processing and/or debugging and/or reducing latency)
+        if (FLAGS_disable_multi_thread)
+            opWrapperT.disableMultiThreading();
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+std::string benchmarkConfiguration(
+    const BenchConfiguration& benchConfiguration, const std::vector<cv::Mat>& images,
+    const std::vector<double>& timestampsMs)
+{
+    try
+    {
+        op::opLog("Benchmarking net_resolution " + benchConfiguration.netResolution + ", model_pose "
+                  + benchConfiguration.modelPose + ", num_gpu " + std::to_string(benchConfiguration.numberGpus)
+                  + ", batch_size " + std::to_string(benchConfiguration.batchSize) + ", number_people_max "
+                  + std::to_string(benchConfiguration.numberPeopleMax) + "...", op::Priority::High);
+        const auto numberGpus = (benchConfiguration.numberGpus < 0
+            ? op::getGpuNumber() : benchConfiguration.numberGpus);
+        const auto maxInFlight = (FLAGS_bench_max_in_flight == 0
+            ? 2 * std::max(1, numberGpus) * std::max(1, benchConfiguration.batchSize) : FLAGS_bench_max_in_flight);
+        BenchState benchState{maxInFlight};
+        // Memory sampling (on the GPUs used by this configuration)
+        std::unique_ptr<BenchMemorySampler> benchMemorySampler;
+        if (FLAGS_bench_memory)
+        {
+            std::vector<int> gpuIds;
+            for (auto gpuId = FLAGS_num_gpu_start ; gpuId < FLAGS_num_gpu_start + numberGpus ; gpuId++)
+                gpuIds.emplace_back(gpuId);
+            benchMemorySampler.reset(new BenchMemorySampler{gpuIds, FLAGS_bench_memory_interval_ms, benchState});
+        }
+        // New Wrapper for each configuration. exec() blocks this thread until all frames have been processed
+        {
+            op::WrapperT<BenchDatum> opWrapperT;
+            configureWrapper(opWrapperT, benchConfiguration, images, timestampsMs, benchState);
+            opWrapperT.exec();
+            // Before the Wrapper releases its memory
+            if (benchMemorySampler != nullptr)
+                benchMemorySampler->stop();
+        }
+
+        // Results
+        const std::lock_guard<std::mutex> lock{benchState.mutex};
+        const auto measuredFrames = benchState.latenciesMs.size();
+        const auto totalTimeMs = (measuredFrames > 0
+            ? durationMs(benchState.timeFirstMeasuredInput, benchState.timeLastOutput) : 0.);
+        std::stringstream stringStream;
+        stringStream << std::fixed << std::setprecision(3)
+            << "    {\n"
+            << "      \"net_resolution\": " << toJsonString(benchConfiguration.netResolution) << ",\n"
+            << "      \"model_pose\": " << toJsonString(benchConfiguration.modelPose) << ",\n"
+            << "      \"num_gpu\": " << numberGpus << ",\n"
+            << "      \"batch_size\": " << benchConfiguration.batchSize << ",\n"
+            << "      \"number_people_max\": " << benchConfiguration.numberPeopleMax << ",\n"
+            << "      \"max_in_flight\": " << maxInFlight << ",\n"
+            << "      \"frames\": " << measuredFrames << ",\n"
+            << "      \"total_time_ms\": " << totalTimeMs << ",\n"
+            << "      \"fps\": " << (totalTimeMs > 0. ? 1e3 * measuredFrames / totalTimeMs : 0.) << ",\n"
+            << "      \"people_per_frame\": "
+            << (measuredFrames > 0 ? benchState.numberPeople / double(measuredFrames) : 0.) << ",\n"
+            << "      \"latency_ms\": " << statisticsToJson(benchState.latenciesMs) << ",\n"
+            << "      \"stages_ms\": {\n"
+            << "        \"pose\": " << statisticsToJson(benchState.poseMs) << ",\n"
+            << "        \"output\": " << statisticsToJson(benchState.outputMs) << "\n"
+            << "      }";
+        if (benchMemorySampler != nullptr)
+            stringStream << ",\n      \"memory\": " << benchMemorySampler->toJson();
+        stringStream << "\n    }";
+        if (measuredFrames != FLAGS_bench_frames)
+            op::opLog("Only " + std::to_string(measuredFrames) + " out of " + std::to_string(FLAGS_bench_frames)
+                      + " frames were measured.", op::Priority::High);
+        return stringStream.str();
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return "";
+    }
+}
+
+int openPoseBenchmark()
+{
+    try
+    {
+        op::opLog("Starting OpenPose benchmark...", op::Priority::High);
+        const auto opTimer = op::getTimerInit();
+
+        // logging_level
+        op::checkBool(
+            0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+            __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+        op::Profiler::setDefaultX(FLAGS_profile_speed);
+        op::checkBool(FLAGS_bench_frames > 0, "`--bench_frames` must be greater than 0.",
+                      __LINE__, __FUNCTION__, __FILE__);
+
+        std::vector<cv::Mat> images;
+        std::vector<double> timestampsMs;
+        // Read the frames of the input recording once
+        if (!FLAGS_bench_replay.empty())
+        {
+            op::ReplayReader replayReader{FLAGS_bench_replay};
+            while (replayReader.isOpened())
+            {
+                const auto frames = replayReader.getFrames();
+                if (frames.empty() || frames[0].empty())
+                    break;
+                images.emplace_back(OP_OP2CVCONSTMAT(frames[0]));
+                timestampsMs.emplace_back(replayReader.getLastTimestampMs());
+            }
+            if (images.empty())
+                op::error("No frames found on: " + FLAGS_bench_replay, __LINE__, __FUNCTION__, __FILE__);
+            // Relative to the first frame
+            const auto firstTimestampMs = timestampsMs.front();
+            for (auto& timestampMs : timestampsMs)
+                timestampMs -= firstTimestampMs;
+            if (!FLAGS_bench_replay_real_time)
+                timestampsMs.clear();
+        }
+        // Read (and optionally resize) the benchmark images once
+        else
+        {
+            const auto imagePaths = op::getFilesOnDirectory(FLAGS_bench_media_dir, op::Extensions::Images);
+            const auto inputSize = op::flagsToPoint(op::String(FLAGS_bench_input_resolution), "-1x-1");
+            for (const auto& imagePath : imagePaths)
+            {
+                cv::Mat image = cv::imread(imagePath);
+                if (image.empty())
+                    continue;
+                if (inputSize.x > 0 && inputSize.y > 0)
+                    cv::resize(image, image, cv::Size{inputSize.x, inputSize.y}, 0, 0, cv::INTER_CUBIC);
+                images.emplace_back(image);
+            }
+            if (images.empty())
+                op::error("No images found on: " + FLAGS_bench_media_dir, __LINE__, __FUNCTION__, __FILE__);
+        }
+
+        // Configurations to benchmark
+        std::vector<BenchConfiguration> benchConfigurations;
+        for (const auto& netResolution : splitList(FLAGS_bench_net_resolutions, FLAGS_net_resolution))
+            for (const auto& modelPose : splitList(FLAGS_bench_models, FLAGS_model_pose))
+                for (const auto numberGpus : splitIntList(FLAGS_bench_num_gpus, {FLAGS_num_gpu}))
+                    for (const auto batchSize : splitIntList(FLAGS_bench_batch_sizes, {FLAGS_batch_size}))
+                        for (const auto numberPeopleMax : splitIntList(FLAGS_bench_people_max, {FLAGS_number_people_max}))
+                            benchConfigurations.emplace_back(BenchConfiguration{
+                                netResolution, modelPose, numberGpus, batchSize, numberPeopleMax});
+
+        // Run benchmarks
+        std::vector<std::string> results;
+        for (const auto& benchConfiguration : benchConfigurations)
+            results.emplace_back(benchmarkConfiguration(benchConfiguration, images, timestampsMs));
+
+        // Write JSON
+        std::stringstream stringStream;
+        stringStream
+            << "{\n"
+            << "  \"openpose_version\": " << toJsonString(OPEN_POSE_VERSION_STRING) << ",\n"
+            << "  \"media_dir\": " << toJsonString(FLAGS_bench_media_dir) << ",\n"
+            << "  \"replay\": " << toJsonString(FLAGS_bench_replay) << ",\n"
+            << "  \"replay_real_time\": " << (timestampsMs.empty() ? "false" : "true") << ",\n"
+            << "  \"images\": " << images.size() << ",\n"
+            << "  \"input_resolution\": " << toJsonString(FLAGS_bench_input_resolution) << ",\n"
+            << "  \"warmup_frames\": " << FLAGS_bench_warmup_frames << ",\n"
+            << "  \"scale_number\": " << FLAGS_scale_number << ",\n"
+            << "  \"face\": " << (FLAGS_face ? "true" : "false") << ",\n"
+            << "  \"hand\": " << (FLAGS_hand ? "true" : "false") << ",\n"
+            << "  \"results\": [\n";
+        for (auto i = 0u ; i < results.size() ; i++)
+            stringStream << results[i] << (i + 1 < results.size() ? ",\n" : "\n");
+        stringStream << "  ]\n}\n";
+        if (FLAGS_bench_output.empty())
+            std::cout << stringStream.str();
+        else
+        {
+            std::ofstream jsonFile{FLAGS_bench_output};
+            if (!jsonFile.is_open())
+                op::error("Could not open file: " + FLAGS_bench_output, __LINE__, __FUNCTION__, __FILE__);
+            jsonFile << stringStream.str();
+            op::opLog("Benchmark results saved in " + FLAGS_bench_output + ".", op::Priority::High);
+        }
+
+        // Measuring total time
+        op::printTime(opTimer, "OpenPose benchmark successfully finished. Total time: ", " seconds.",
+                      op::Priority::High);
+
+        // Return successful message
+        return 0;
+    }
+    catch (const std::exception&)
+    {
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running openPoseBenchmark
+    return openPoseBenchmark();
+}
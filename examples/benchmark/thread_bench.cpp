@@ -0,0 +1,599 @@
+// --------------------------------------- OpenPose Thread Micro-Benchmark ---------------------------------------
+// This binary measures the overhead of the thread module itself (queues, SubThread handoffs, WQueueOrderer and
+// WQueueAssembler), i.e., without the network nor any input media. Each configuration is a synthetic ThreadManager
+// pipeline: a producer, `stages` stages of no-op workers (each one replicated on `threads` threads), optionally
+// WQueueOrderer (always with several threads per stage, so the frames leave in order) and WQueueAssembler (with
+// several views), and a consumer. It sweeps over queue types, stages, threads, queue sizes and views, e.g.:
+//     ./build/examples/benchmark/thread_bench.bin --tbench_queues "Queue,RingBufferQueue" --tbench_stages "1,4"
+//         --tbench_threads "1,4" --tbench_output threads.json
+// Each configuration runs 2 phases on new ThreadManager instances:
+// - `throughput`: The producer pushes as fast as the queues accept them, i.e., maximum Datums per second. Its
+//   latencies include the time waiting in the (full) queues.
+// - `latency`: Only 1 frame inside the pipeline at a time, i.e., the hop latencies are the pure handoff times.
+// Each hop is the time from a node (producer, stage, orderer or assembler) finishing a Datum until the next one
+// starts working on it. The `residence_us` of WQueueOrderer and WQueueAssembler is the time each Datum waits inside
+// them (for the missing frames or views). With `--tbench_work_us`, each stage busy-waits that time per Datum.
+
+// Command-line user interface
+#define OPENPOSE_FLAGS_DISABLE_PRODUCER
+#define OPENPOSE_FLAGS_DISABLE_DISPLAY
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+// Benchmark utilities
+#include "benchmarkUtilities.hpp"
+// C++ std library dependencies
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <queue> // std::priority_queue
+#include <sstream>
+#include <thread>
+
+// Custom OpenPose flags
+// Thread benchmark
+DEFINE_string(tbench_queues,            "Queue,PriorityQueue,RingBufferQueue",
+    "Comma-separated list of queue types to benchmark (`Queue`, `PriorityQueue` and/or `RingBufferQueue`).");
+DEFINE_string(tbench_stages,            "1,4",
+    "Comma-separated list of numbers of no-op worker stages between the producer and the consumer.");
+DEFINE_string(tbench_threads,           "1,2",
+    "Comma-separated list of numbers of threads (each one with its own worker) of each stage.");
+DEFINE_string(tbench_queue_sizes,       "-1",
+    "Comma-separated list of maximum queue sizes (see `ThreadManager::setDefaultMaxSizeQueues`, -1 to use as many"
+    " elements as threads are connected to each queue).");
+DEFINE_string(tbench_views,             "1",
+    "Comma-separated list of numbers of views per frame. With more than 1, each view is a different Datum until"
+    " WQueueAssembler merges them (as with several cameras).");
+DEFINE_bool(tbench_orderer,             true,
+    "If true, WQueueOrderer is added after the stages (it is always added if threads > 1 or views > 1).");
+DEFINE_uint64(tbench_frames,            20000,
+    "Number of frames measured by the throughput phase of each configuration.");
+DEFINE_uint64(tbench_latency_frames,    2000,
+    "Number of frames measured by the latency phase of each configuration (0 to skip it).");
+DEFINE_uint64(tbench_warmup_frames,     500,
+    "Number of frames processed (and excluded from the statistics) before measuring each phase.");
+DEFINE_int32(tbench_work_us,            0,
+    "Busy-waiting time (in microseconds) of each stage worker per Datum. 0 for no-op workers.");
+DEFINE_string(tbench_output,            "",
+    "Path of the JSON file where the results are written. Empty to print them on the standard output.");
+
+// Datum with the time each node of the pipeline started (arrival) and finished (departure) working on it
+struct TBenchDatum : public op::Datum
+{
+    std::vector<TimePoint> arrivals;
+    std::vector<TimePoint> departures;
+
+    TBenchDatum(const std::size_t numberNodes) :
+        arrivals(numberNodes),
+        departures(numberNodes)
+    {}
+};
+
+typedef std::vector<std::shared_ptr<TBenchDatum>> TBenchDatums;
+typedef std::shared_ptr<TBenchDatums> TBenchDatumsSP;
+typedef std::shared_ptr<op::Worker<TBenchDatumsSP>> TBenchWorker;
+
+// PriorityQueue ordered by frame (and view), i.e., the earliest one is popped first
+struct TBenchDatumsGreater
+{
+    bool operator()(const TBenchDatumsSP& a, const TBenchDatumsSP& b) const
+    {
+        return (*a)[0]->id > (*b)[0]->id || ((*a)[0]->id == (*b)[0]->id && (*a)[0]->subId > (*b)[0]->subId);
+    }
+};
+typedef op::PriorityQueue<TBenchDatumsSP, std::priority_queue<
+    TBenchDatumsSP, std::vector<TBenchDatumsSP>, TBenchDatumsGreater>> TBenchPriorityQueue;
+
+double durationUs(const TimePoint& timeBegin, const TimePoint& timeEnd)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeBegin).count() * 1e-3;
+}
+
+// Measurements shared by the producer and consumer of a phase
+struct TBenchState
+{
+    std::mutex mutex;
+    std::condition_variable conditionVariable;
+    // Maximum number of Datums (views) inside the pipeline, or -1 if not limited
+    const long long maxInFlight;
+    long long inFlight;
+    // Hop h: From node h finishing a Datum until node h+1 starts with it
+    std::vector<std::vector<double>> hopsUs;
+    std::vector<double> endToEndUs;
+    std::vector<double> ordererUs;
+    std::vector<double> assemblerUs;
+    unsigned long long measuredDatums;
+    bool firstMeasuredStarted;
+    TimePoint timeFirstMeasured;
+    TimePoint timeLastOutput;
+
+    TBenchState(const long long maxInFlight_, const std::size_t numberHops) :
+        maxInFlight{maxInFlight_},
+        inFlight{0},
+        hopsUs(numberHops),
+        measuredDatums{0ull},
+        firstMeasuredStarted{false}
+    {}
+};
+
+// Position of each node of the pipeline in TBenchDatum::arrivals and departures
+struct TBenchNodes
+{
+    std::vector<std::string> names;
+    int orderer;
+    int assembler;
+
+    TBenchNodes(const int stages, const bool orderer_, const bool assembler_) :
+        orderer{-1},
+        assembler{-1}
+    {
+        names.emplace_back("producer");
+        for (auto stage = 1 ; stage <= stages ; stage++)
+            names.emplace_back("stage_" + std::to_string(stage));
+        if (orderer_)
+        {
+            orderer = (int)names.size();
+            names.emplace_back("orderer");
+        }
+        if (assembler_)
+        {
+            assembler = (int)names.size();
+            names.emplace_back("assembler");
+        }
+        names.emplace_back("consumer");
+    }
+};
+
+// It produces `warmup + frames` frames (each one as `views` Datums), as fast as TBenchState::maxInFlight allows
+class WTBenchProducer : public op::WorkerProducer<TBenchDatumsSP>
+{
+public:
+    WTBenchProducer(
+        const std::size_t numberNodes, const unsigned long long views, const unsigned long long warmupFrames,
+        const unsigned long long measuredFrames, TBenchState& tBenchState) :
+        mNumberNodes{numberNodes},
+        mViews{views},
+        mWarmupFrames{warmupFrames},
+        mTotalDatums{(warmupFrames + measuredFrames) * views},
+        rTBenchState(tBenchState),
+        mCounter{0ull}
+    {
+    }
+
+    void initializationOnThread() {}
+
+    TBenchDatumsSP workProducer()
+    {
+        try
+        {
+            if (mTotalDatums <= mCounter)
+            {
+                this->stop();
+                return nullptr;
+            }
+            // Wait until there is room in the pipeline
+            if (rTBenchState.maxInFlight > 0)
+            {
+                std::unique_lock<std::mutex> lock{rTBenchState.mutex};
+                while (rTBenchState.inFlight >= rTBenchState.maxInFlight)
+                {
+                    rTBenchState.conditionVariable.wait_for(lock, std::chrono::milliseconds{100});
+                    // Avoid blocking forever if the pipeline was stopped (e.g., due to an error)
+                    if (!this->isRunning())
+                        return nullptr;
+                }
+                rTBenchState.inFlight++;
+            }
+            // New Datum (1 per view, as WQueueSplitter)
+            auto tDatumsPtr = std::make_shared<TBenchDatums>();
+            tDatumsPtr->emplace_back(std::make_shared<TBenchDatum>(mNumberNodes));
+            auto& tDatumPtr = tDatumsPtr->at(0);
+            tDatumPtr->id = mCounter / mViews;
+            tDatumPtr->subId = mCounter % mViews;
+            tDatumPtr->subIdMax = mViews - 1;
+            tDatumPtr->frameNumber = tDatumPtr->id;
+            mCounter++;
+            tDatumPtr->departures[0] = std::chrono::high_resolution_clock::now();
+            if (tDatumPtr->id == mWarmupFrames && tDatumPtr->subId == 0)
+            {
+                const std::lock_guard<std::mutex> lock{rTBenchState.mutex};
+                rTBenchState.firstMeasuredStarted = true;
+                rTBenchState.timeFirstMeasured = tDatumPtr->departures[0];
+            }
+            return tDatumsPtr;
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+private:
+    const std::size_t mNumberNodes;
+    const unsigned long long mViews;
+    const unsigned long long mWarmupFrames;
+    const unsigned long long mTotalDatums;
+    TBenchState& rTBenchState;
+    unsigned long long mCounter;
+};
+
+// No-op stage (or a busy-waiting one with `--tbench_work_us`)
+class WTBenchStage : public op::Worker<TBenchDatumsSP>
+{
+public:
+    WTBenchStage(const int node, const int workUs) :
+        mNode{node},
+        mWorkUs{workUs}
+    {
+    }
+
+    void initializationOnThread() {}
+
+    void work(TBenchDatumsSP& tDatumsPtr)
+    {
+        try
+        {
+            if (tDatumsPtr != nullptr)
+            {
+                const auto timeArrival = std::chrono::high_resolution_clock::now();
+                if (mWorkUs > 0)
+                {
+                    const auto timeEnd = timeArrival + std::chrono::microseconds{mWorkUs};
+                    while (std::chrono::high_resolution_clock::now() < timeEnd)
+                    {
+                    }
+                }
+                const auto timeDeparture = (mWorkUs > 0 ? std::chrono::high_resolution_clock::now() : timeArrival);
+                for (auto& tDatumPtr : *tDatumsPtr)
+                {
+                    tDatumPtr->arrivals[mNode] = timeArrival;
+                    tDatumPtr->departures[mNode] = timeDeparture;
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+private:
+    const int mNode;
+    const int mWorkUs;
+};
+
+// It stamps the arrival into (or departure from) a thread-module worker that runs on the same thread (e.g.,
+// WQueueOrderer), so its residence time and the hops around it can be measured
+class WTBenchStamp : public op::Worker<TBenchDatumsSP>
+{
+public:
+    WTBenchStamp(const int node, const bool arrival) :
+        mNode{node},
+        mArrival{arrival}
+    {
+    }
+
+    void initializationOnThread() {}
+
+    void work(TBenchDatumsSP& tDatumsPtr)
+    {
+        try
+        {
+            if (tDatumsPtr != nullptr)
+            {
+                const auto timeNow = std::chrono::high_resolution_clock::now();
+                for (auto& tDatumPtr : *tDatumsPtr)
+                    (mArrival ? tDatumPtr->arrivals : tDatumPtr->departures)[mNode] = timeNow;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+private:
+    const int mNode;
+    const bool mArrival;
+};
+
+// It records the hop latencies of each measured Datum
+class WTBenchConsumer : public op::WorkerConsumer<TBenchDatumsSP>
+{
+public:
+    WTBenchConsumer(const TBenchNodes& tBenchNodes, const unsigned long long warmupFrames,
+                    TBenchState& tBenchState) :
+        rTBenchNodes(tBenchNodes),
+        mWarmupFrames{warmupFrames},
+        rTBenchState(tBenchState)
+    {
+    }
+
+    void initializationOnThread() {}
+
+    void workConsumer(const TBenchDatumsSP& tDatumsPtr)
+    {
+        try
+        {
+            if (tDatumsPtr != nullptr && !tDatumsPtr->empty())
+            {
+                const auto timeOutput = std::chrono::high_resolution_clock::now();
+                const auto consumer = rTBenchNodes.names.size() - 1;
+                const std::lock_guard<std::mutex> lock{rTBenchState.mutex};
+                for (const auto& tDatumPtr : *tDatumsPtr)
+                {
+                    tDatumPtr->arrivals[consumer] = timeOutput;
+                    if (tDatumPtr->id >= mWarmupFrames)
+                    {
+                        for (auto hop = 0u ; hop < consumer ; hop++)
+                            rTBenchState.hopsUs[hop].emplace_back(
+                                durationUs(tDatumPtr->departures[hop], tDatumPtr->arrivals[hop+1]));
+                        rTBenchState.endToEndUs.emplace_back(durationUs(tDatumPtr->departures[0], timeOutput));
+                        if (rTBenchNodes.orderer >= 0)
+                            rTBenchState.ordererUs.emplace_back(durationUs(
+                                tDatumPtr->arrivals[rTBenchNodes.orderer],
+                                tDatumPtr->departures[rTBenchNodes.orderer]));
+                        if (rTBenchNodes.assembler >= 0)
+                            rTBenchState.assemblerUs.emplace_back(durationUs(
+                                tDatumPtr->arrivals[rTBenchNodes.assembler],
+                                tDatumPtr->departures[rTBenchNodes.assembler]));
+                        rTBenchState.measuredDatums++;
+                        rTBenchState.timeLastOutput = timeOutput;
+                    }
+                }
+                if (rTBenchState.maxInFlight > 0)
+                {
+                    rTBenchState.inFlight -= (long long)tDatumsPtr->size();
+                    rTBenchState.conditionVariable.notify_all();
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+private:
+    const TBenchNodes& rTBenchNodes;
+    const unsigned long long mWarmupFrames;
+    TBenchState& rTBenchState;
+};
+
+struct TBenchConfiguration
+{
+    std::string queue;
+    int stages;
+    int threads;
+    int queueSize;
+    int views;
+    bool orderer;
+};
+
+// It runs 1 phase of a configuration on a new ThreadManager, and it returns its JSON
+template<typename TQueue>
+std::string benchmarkPhase(
+    const TBenchConfiguration& tBenchConfiguration, const TBenchNodes& tBenchNodes,
+    const unsigned long long measuredFrames, const bool latencyPhase)
+{
+    try
+    {
+        TBenchState tBenchState{
+            latencyPhase ? (long long)tBenchConfiguration.views : -1ll, tBenchNodes.names.size() - 1};
+        {
+            op::ThreadManager<TBenchDatumsSP, TBenchWorker, TQueue> threadManager{
+                op::ThreadManagerMode::Synchronous};
+            threadManager.setDefaultMaxSizeQueues(tBenchConfiguration.queueSize);
+            auto threadId = 0ull;
+            auto queueIn = 0ull;
+            // Producer
+            threadManager.add(threadId++, std::make_shared<WTBenchProducer>(
+                tBenchNodes.names.size(), (unsigned long long)tBenchConfiguration.views, FLAGS_tbench_warmup_frames,
+                measuredFrames, tBenchState), queueIn, queueIn+1);
+            queueIn++;
+            // Stages
+            for (auto stage = 1 ; stage <= tBenchConfiguration.stages ; stage++)
+            {
+                for (auto thread = 0 ; thread < tBenchConfiguration.threads ; thread++)
+                    threadManager.add(threadId++, std::make_shared<WTBenchStage>(stage, FLAGS_tbench_work_us),
+                                      queueIn, queueIn+1);
+                queueIn++;
+            }
+            // Thread-module workers (each one with its own thread)
+            for (const auto node : {tBenchNodes.orderer, tBenchNodes.assembler})
+            {
+                if (node >= 0)
+                {
+                    const TBenchWorker worker = (node == tBenchNodes.orderer
+                        ? TBenchWorker{std::make_shared<op::WQueueOrderer<TBenchDatumsSP>>()}
+                        : TBenchWorker{std::make_shared<op::WQueueAssembler<TBenchDatums>>()});
+                    threadManager.add(threadId++, std::vector<TBenchWorker>{
+                        std::make_shared<WTBenchStamp>(node, true), worker,
+                        std::make_shared<WTBenchStamp>(node, false)}, queueIn, queueIn+1);
+                    queueIn++;
+                }
+            }
+            // Consumer
+            threadManager.add(threadId++, std::make_shared<WTBenchConsumer>(
+                tBenchNodes, FLAGS_tbench_warmup_frames, tBenchState), queueIn, queueIn+1);
+            // It blocks this thread until all frames have been processed
+            threadManager.exec();
+        }
+
+        // Results
+        const std::lock_guard<std::mutex> lock{tBenchState.mutex};
+        const auto totalTimeUs = (tBenchState.measuredDatums > 0
+            ? durationUs(tBenchState.timeFirstMeasured, tBenchState.timeLastOutput) : 0.);
+        if (tBenchState.measuredDatums != measuredFrames * tBenchConfiguration.views)
+            op::opLog("Only " + std::to_string(tBenchState.measuredDatums) + " out of "
+                      + std::to_string(measuredFrames * tBenchConfiguration.views) + " Datums were measured.",
+                      op::Priority::High);
+        std::stringstream stringStream;
+        stringStream << std::fixed << std::setprecision(3)
+            << "{\n"
+            << "        \"datums\": " << tBenchState.measuredDatums << ",\n"
+            << "        \"datums_per_second\": "
+            << (totalTimeUs > 0. ? 1e6 * tBenchState.measuredDatums / totalTimeUs : 0.) << ",\n"
+            << "        \"end_to_end_us\": " << statisticsToJson(tBenchState.endToEndUs) << ",\n"
+            << "        \"hops_us\": {\n";
+        for (auto hop = 0u ; hop < tBenchState.hopsUs.size() ; hop++)
+            stringStream << "          " << toJsonString(tBenchNodes.names[hop] + "->" + tBenchNodes.names[hop+1])
+                << ": " << statisticsToJson(tBenchState.hopsUs[hop])
+                << (hop + 1 < tBenchState.hopsUs.size() ? ",\n" : "\n");
+        stringStream << "        },\n"
+            << "        \"residence_us\": {";
+        if (tBenchNodes.orderer >= 0)
+            stringStream << "\"orderer\": " << statisticsToJson(tBenchState.ordererUs)
+                << (tBenchNodes.assembler >= 0 ? ", " : "");
+        if (tBenchNodes.assembler >= 0)
+            stringStream << "\"assembler\": " << statisticsToJson(tBenchState.assemblerUs);
+        stringStream << "}\n"
+            << "      }";
+        return stringStream.str();
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return "";
+    }
+}
+
+template<typename TQueue>
+std::string benchmarkConfiguration(const TBenchConfiguration& tBenchConfiguration)
+{
+    try
+    {
+        op::opLog("Benchmarking " + tBenchConfiguration.queue + " with " + std::to_string(tBenchConfiguration.stages)
+                  + " stages x " + std::to_string(tBenchConfiguration.threads) + " threads, queue size "
+                  + std::to_string(tBenchConfiguration.queueSize) + ", " + std::to_string(tBenchConfiguration.views)
+                  + " views...", op::Priority::High);
+        const TBenchNodes tBenchNodes{
+            tBenchConfiguration.stages, tBenchConfiguration.orderer, tBenchConfiguration.views > 1};
+        std::stringstream stringStream;
+        stringStream
+            << "    {\n"
+            << "      \"queue\": " << toJsonString(tBenchConfiguration.queue) << ",\n"
+            << "      \"stages\": " << tBenchConfiguration.stages << ",\n"
+            << "      \"threads\": " << tBenchConfiguration.threads << ",\n"
+            << "      \"queue_size\": " << tBenchConfiguration.queueSize << ",\n"
+            << "      \"views\": " << tBenchConfiguration.views << ",\n"
+            << "      \"orderer\": " << (tBenchConfiguration.orderer ? "true" : "false") << ",\n"
+            << "      \"throughput\": "
+            << benchmarkPhase<TQueue>(tBenchConfiguration, tBenchNodes, FLAGS_tbench_frames, false);
+        if (FLAGS_tbench_latency_frames > 0)
+            stringStream << ",\n      \"latency\": "
+                << benchmarkPhase<TQueue>(tBenchConfiguration, tBenchNodes, FLAGS_tbench_latency_frames, true);
+        stringStream << "\n    }";
+        return stringStream.str();
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return "";
+    }
+}
+
+int openPoseThreadBenchmark()
+{
+    try
+    {
+        op::opLog("Starting OpenPose thread benchmark...", op::Priority::High);
+        const auto opTimer = op::getTimerInit();
+
+        // logging_level
+        op::checkBool(
+            0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+            __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+        op::checkBool(FLAGS_tbench_frames > 0, "`--tbench_frames` must be greater than 0.",
+                      __LINE__, __FUNCTION__, __FILE__);
+
+        // Configurations to benchmark
+        std::vector<TBenchConfiguration> tBenchConfigurations;
+        for (const auto& queue : splitList(FLAGS_tbench_queues))
+            for (const auto stages : splitIntList(FLAGS_tbench_stages))
+                for (const auto threads : splitIntList(FLAGS_tbench_threads))
+                    for (const auto queueSize : splitIntList(FLAGS_tbench_queue_sizes))
+                        for (const auto views : splitIntList(FLAGS_tbench_views))
+                        {
+                            if (stages < 0 || threads < 1 || views < 1)
+                                op::error("`--tbench_stages` must be >= 0, and `--tbench_threads` and"
+                                          " `--tbench_views` >= 1.", __LINE__, __FUNCTION__, __FILE__);
+                            // Frames leave the stages out of order with several threads, and the views of each
+                            // frame must be consecutive for WQueueAssembler
+                            const auto orderer = (FLAGS_tbench_orderer || (threads > 1 && stages > 0) || views > 1);
+                            tBenchConfigurations.emplace_back(TBenchConfiguration{
+                                queue, stages, threads, queueSize, views, orderer});
+                        }
+
+        // Run benchmarks
+        std::vector<std::string> results;
+        for (const auto& tBenchConfiguration : tBenchConfigurations)
+        {
+            if (tBenchConfiguration.queue == "Queue")
+                results.emplace_back(benchmarkConfiguration<op::Queue<TBenchDatumsSP>>(tBenchConfiguration));
+            else if (tBenchConfiguration.queue == "PriorityQueue")
+                results.emplace_back(benchmarkConfiguration<TBenchPriorityQueue>(tBenchConfiguration));
+            else if (tBenchConfiguration.queue == "RingBufferQueue")
+                results.emplace_back(
+                    benchmarkConfiguration<op::RingBufferQueue<TBenchDatumsSP>>(tBenchConfiguration));
+            else
+                op::error("Unknown queue type `" + tBenchConfiguration.queue + "` (it must be `Queue`,"
+                          " `PriorityQueue` or `RingBufferQueue`).", __LINE__, __FUNCTION__, __FILE__);
+        }
+
+        // Write JSON
+        std::stringstream stringStream;
+        stringStream
+            << "{\n"
+            << "  \"openpose_version\": " << toJsonString(OPEN_POSE_VERSION_STRING) << ",\n"
+            << "  \"hardware_concurrency\": " << std::thread::hardware_concurrency() << ",\n"
+            << "  \"frames\": " << FLAGS_tbench_frames << ",\n"
+            << "  \"latency_frames\": " << FLAGS_tbench_latency_frames << ",\n"
+            << "  \"warmup_frames\": " << FLAGS_tbench_warmup_frames << ",\n"
+            << "  \"work_us\": " << FLAGS_tbench_work_us << ",\n"
+            << "  \"results\": [\n";
+        for (auto i = 0u ; i < results.size() ; i++)
+            stringStream << results[i] << (i + 1 < results.size() ? ",\n" : "\n");
+        stringStream << "  ]\n}\n";
+        if (FLAGS_tbench_output.empty())
+            std::cout << stringStream.str();
+        else
+        {
+            std::ofstream jsonFile{FLAGS_tbench_output};
+            if (!jsonFile.is_open())
+                op::error("Could not open file: " + FLAGS_tbench_output, __LINE__, __FUNCTION__, __FILE__);
+            jsonFile << stringStream.str();
+            op::opLog("Thread benchmark results saved in " + FLAGS_tbench_output + ".", op::Priority::High);
+        }
+
+        // Measuring total time
+        op::printTime(opTimer, "OpenPose thread benchmark successfully finished. Total time: ", " seconds.",
+                      op::Priority::High);
+
+        // Return successful message
+        return 0;
+    }
+    catch (const std::exception&)
+    {
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running openPoseThreadBenchmark
+    return openPoseThreadBenchmark();
+}
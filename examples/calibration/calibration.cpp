@@ -17,6 +17,9 @@ DEFINE_string(calibration_image_dir,    "images/intrinsics/", "Directory where t
 DEFINE_double(grid_square_size_mm,      127.0,          "Chessboard square length (in millimeters).");
 DEFINE_string(grid_number_inner_corners,"9x6",          "Number of inner corners in width and height, i.e., number of total squares in width"
                                                         " and height minus 1.");
+DEFINE_bool(corner_cache,               true,           "Whether to save the grid corners found in each image in `{calibration_image_dir}/corners_cache/`,"
+                                                        " so later runs over the same images skip the chessboard detection. Disable it (or"
+                                                        " remove that folder) if the images were replaced by others with the same name and size.");
 // Mode 1 - Intrinsics
 DEFINE_string(camera_serial_number,     "18079958",     "Camera serial number.");
 // Mode 2 - Extrinsics
@@ -67,7 +70,7 @@ int openPoseDemo()
             op::estimateAndSaveIntrinsics(
                 gridInnerCorners, gridSqureSizeMm, flags,
                 op::formatAsDirectory(FLAGS_camera_parameter_folder), calibrationImageDir, FLAGS_camera_serial_number,
-                saveImagesWithCorners);
+                saveImagesWithCorners, FLAGS_corner_cache);
             op::opLog("Intrinsic calibration completed!", op::Priority::High);
         }
 
@@ -78,7 +81,7 @@ int openPoseDemo()
             // Run calibration
             op::estimateAndSaveExtrinsics(
                 FLAGS_camera_parameter_folder, calibrationImageDir, gridInnerCorners, gridSqureSizeMm,
-                FLAGS_cam0, FLAGS_cam1, FLAGS_omit_distortion, FLAGS_combine_cam0_extrinsics);
+                FLAGS_cam0, FLAGS_cam1, FLAGS_omit_distortion, FLAGS_combine_cam0_extrinsics, FLAGS_corner_cache);
             // Logging
             op::opLog("Extrinsic calibration completed!", op::Priority::High);
         }
@@ -96,7 +99,7 @@ int openPoseDemo()
             // Run calibration
             op::refineAndSaveExtrinsics(
                 FLAGS_camera_parameter_folder, calibrationImageDir, gridInnerCorners, gridSqureSizeMm,
-                FLAGS_number_cameras, FLAGS_omit_distortion, saveImagesWithCorners);
+                FLAGS_number_cameras, FLAGS_omit_distortion, saveImagesWithCorners, FLAGS_corner_cache);
             // Logging
             op::opLog("Extrinsic calibration (bundle adjustment) completed!", op::Priority::High);
         }
@@ -54,7 +54,8 @@ namespace op
                 // Debugging log
                 opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
-                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
                 for (auto& datum : *tDatums)
                 {
                     // THESE 2 ARE THE ONLY LINES THAT THE USER MUST MODIFY ON THIS HPP FILE, by using the proper
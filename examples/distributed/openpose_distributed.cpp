@@ -0,0 +1,732 @@
+// --------------------------------------- OpenPose C++ Distributed Processing ---------------------------------------
+// This example splits the offline processing of long videos across several nodes (and GPUs). The nodes share a job
+// directory (e.g., an NFS or SMB share), which is the only way they communicate:
+    // 1. The coordinator (`--distributed_mode coordinator`) splits each video into chunks of consecutive frames
+    //    (aligned with its keyframe interval, so each chunk starts decoding from a keyframe) and writes the job list.
+    // 2. Each worker (`--distributed_mode worker`) loads the models once, and then claims and processes the chunks
+    //    one by one, until there are none left. Chunks are not pre-assigned, so faster nodes simply process more of
+    //    them. Run 1 worker per GPU (`--num_gpu 1 --num_gpu_start <gpu index>`) or 1 per node (all its GPUs).
+    // 3. A chunk whose worker died or hung (its claim was not renewed for `--distributed_lease_s`) is re-run by
+    //    another worker, up to `--distributed_max_attempts` times.
+    // 4. Once all the chunks are done, the coordinator merges them into 1 result per video, ordered by frame, and
+    //    stitches the person IDs across the chunk boundaries.
+// For more details, see doc/advanced/distributed.md.
+
+// Third-party dependencies
+#include <opencv2/opencv.hpp>
+#ifdef _WIN32
+    #include <process.h> // _getpid
+#else
+    #include <unistd.h> // getpid
+#endif
+#include <algorithm>
+#include <chrono>
+#include <cmath> // std::ceil, std::sqrt
+#include <cstdio> // std::fopen, std::rename, std::remove
+#include <cstdlib> // std::getenv
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <tuple>
+// Command-line user interface
+#define OPENPOSE_FLAGS_DISABLE_PRODUCER
+#define OPENPOSE_FLAGS_DISABLE_DISPLAY
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+
+// Custom OpenPose flags
+// Distributed processing
+DEFINE_string(distributed_mode,         "worker",
+    "Either `coordinator` (it splits the videos into chunks, waits for them, and merges their results) or `worker`"
+    " (it processes chunks until all of them are done). Run 1 coordinator and any number of workers.");
+DEFINE_string(distributed_job_dir,      "",
+    "Directory shared by the coordinator and all the workers (e.g., an NFS mount). All of them must see the videos"
+    " with the same paths too.");
+DEFINE_string(distributed_videos,       "",
+    "Coordinator only. Comma-separated list of the videos to process.");
+DEFINE_int32(distributed_chunk_frames,  3000,
+    "Coordinator only. Number of frames of each chunk (rounded up to a multiple of"
+    " `--distributed_keyframe_interval`). Smaller chunks balance the work better, but each one costs 1 seek.");
+DEFINE_int32(distributed_keyframe_interval, 0,
+    "Coordinator only. Keyframe interval (GOP size) of the videos, so each chunk starts at a keyframe and its seek"
+    " does not decode (and throw away) the frames before it. 0 to not align the chunks.");
+DEFINE_double(distributed_lease_s,      120.,
+    "Seconds without renewing its claim after which a chunk is considered abandoned (e.g., its worker crashed), so"
+    " another worker re-runs it. Claims are renewed by their worker every `--distributed_lease_s`/4 seconds.");
+DEFINE_int32(distributed_max_attempts,  3,
+    "Maximum number of times a chunk is started. After that, it is marked as failed and the coordinator reports it.");
+DEFINE_int32(distributed_pipeline_depth, 8,
+    "Worker only. Maximum number of frames inside OpenPose at the same time. It should be at least `--batch_size` x"
+    " number of GPUs, so all the GPUs are busy.");
+DEFINE_double(distributed_id_max_distance, 50.,
+    "Coordinator only. Maximum average keypoint distance (in the `--keypoint_scale` units) between the last frame"
+    " of a chunk and the first one of the next chunk to consider 2 people the same one. Only used with"
+    " `--tracking` or `--identification`, i.e., if the people have an ID.");
+DEFINE_string(distributed_output,       "",
+    "Coordinator only. Directory where the merged results (1 `<video name>.jsonl` per video) are saved. If empty,"
+    " `--distributed_job_dir` is used.");
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+    typedef std::shared_ptr<std::vector<std::shared_ptr<op::Datum>>> DatumsSP;
+
+    const std::string JOBS_FILE_NAME{"jobs.txt"};
+    const std::string JOBS_FILE_HEADER{"# OpenPose distributed jobs v1: <chunk> <first frame> <last frame> <video>"};
+    const auto FRAME_LAST_UNKNOWN = std::numeric_limits<unsigned long long>::max();
+
+    struct Chunk
+    {
+        unsigned int index;
+        unsigned long long frameFirst;
+        unsigned long long frameLast; // FRAME_LAST_UNKNOWN = until the end of the video
+        std::string videoPath;
+    };
+
+    std::string getChunkPath(const std::string& jobDirectory, const unsigned int chunkIndex, const std::string& suffix)
+    {
+        char chunkName[32];
+        std::snprintf(chunkName, sizeof(chunkName), "chunk_%06u", chunkIndex);
+        return jobDirectory + chunkName + suffix;
+    }
+
+    std::string getClaimPath(const std::string& jobDirectory, const unsigned int chunkIndex, const int attempt)
+    {
+        return getChunkPath(jobDirectory, chunkIndex, ".claim." + std::to_string(attempt));
+    }
+
+    std::string getWorkerName()
+    {
+        #ifdef _WIN32
+            const auto* const hostName = std::getenv("COMPUTERNAME");
+            const auto processId = (long long)_getpid();
+        #else
+            const auto* const hostName = std::getenv("HOSTNAME");
+            const auto processId = (long long)getpid();
+        #endif
+        return std::string{hostName == nullptr ? "unknown" : hostName} + "_" + std::to_string(processId);
+    }
+
+    // It creates the file only if it does not exist yet (atomically, thus only 1 of the workers trying to create it
+    // at the same time succeeds). "x" (exclusive) is C11, supported by glibc, macOS and MSVC 2015 or higher
+    bool createFileExclusive(const std::string& filePath, const std::string& content)
+    {
+        auto* const file = std::fopen(filePath.c_str(), "wx");
+        if (file == nullptr)
+            return false;
+        std::fwrite(content.data(), 1, content.size(), file);
+        std::fclose(file);
+        return true;
+    }
+
+    void writeFile(const std::string& filePath, const std::string& content)
+    {
+        std::ofstream file{filePath, std::ios::binary | std::ios::trunc};
+        if (!file.is_open())
+            op::error("File " + filePath + " could not be written.", __LINE__, __FUNCTION__, __FILE__);
+        file << content;
+    }
+
+    std::string readFile(const std::string& filePath)
+    {
+        std::ifstream file{filePath, std::ios::binary};
+        std::ostringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    // It writes into a temporary file and renames it, so readers see either the whole file or no file
+    void writeFileAtomic(const std::string& filePath, const std::string& content, const std::string& temporarySuffix)
+    {
+        const auto temporaryPath = filePath + temporarySuffix;
+        writeFile(temporaryPath, content);
+        if (std::rename(temporaryPath.c_str(), filePath.c_str()) != 0)
+        {
+            std::remove(temporaryPath.c_str());
+            // E.g., on Windows, if another attempt of the same chunk already finished
+            if (!op::existFile(filePath))
+                op::error("File " + temporaryPath + " could not be renamed.", __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<Chunk> readJobs(const std::string& jobDirectory)
+    {
+        std::vector<Chunk> chunks;
+        std::ifstream jobsFile{jobDirectory + JOBS_FILE_NAME};
+        std::string line;
+        while (std::getline(jobsFile, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+            std::istringstream lineStream{line};
+            Chunk chunk;
+            lineStream >> chunk.index >> chunk.frameFirst >> chunk.frameLast;
+            std::getline(lineStream >> std::ws, chunk.videoPath);
+            if (lineStream.fail() || chunk.videoPath.empty())
+                op::error("Wrong line in " + JOBS_FILE_NAME + ": `" + line + "`.", __LINE__, __FUNCTION__, __FILE__);
+            chunks.emplace_back(chunk);
+        }
+        return chunks;
+    }
+
+    bool isChunkFinished(const std::string& jobDirectory, const Chunk& chunk)
+    {
+        return op::existFile(getChunkPath(jobDirectory, chunk.index, ".jsonl"))
+            || op::existFile(getChunkPath(jobDirectory, chunk.index, ".failed"));
+    }
+
+    // A claim is stale if its content (rewritten by its worker heartbeat) did not change for `--distributed_lease_s`.
+    // It is measured with the local clock since this worker first saw that content, so the clocks (and the file
+    // modification times) of the nodes do not need to be in sync
+    class LeaseObserver
+    {
+    public:
+        bool isStale(const std::string& claimPath)
+        {
+            const auto content = readFile(claimPath);
+            const auto now = Clock::now();
+            auto entry = mLastChanges.find(claimPath);
+            if (entry == mLastChanges.end() || entry->second.first != content)
+            {
+                mLastChanges[claimPath] = std::make_pair(content, now);
+                return false;
+            }
+            return std::chrono::duration<double>(now - entry->second.second).count() > FLAGS_distributed_lease_s;
+        }
+
+    private:
+        std::map<std::string, std::pair<std::string, Clock::time_point>> mLastChanges;
+    };
+
+    // It returns the attempt number of the claimed chunk, or -1 if it could not be claimed
+    int tryClaimChunk(
+        const std::string& jobDirectory, const Chunk& chunk, const std::string& workerName,
+        LeaseObserver& leaseObserver)
+    {
+        if (isChunkFinished(jobDirectory, chunk))
+            return -1;
+        auto attempt = -1;
+        for (auto tentativeAttempt = 0 ; tentativeAttempt < FLAGS_distributed_max_attempts ; tentativeAttempt++)
+            if (op::existFile(getClaimPath(jobDirectory, chunk.index, tentativeAttempt)))
+                attempt = tentativeAttempt;
+        // Not started yet
+        if (attempt < 0)
+            return (createFileExclusive(getClaimPath(jobDirectory, chunk.index, 0), workerName) ? 0 : -1);
+        // Running (or its worker died less than `--distributed_lease_s` ago)
+        if (!leaseObserver.isStale(getClaimPath(jobDirectory, chunk.index, attempt)))
+            return -1;
+        // Its worker died or hung: Re-run it, unless it already failed too many times
+        if (attempt + 1 >= FLAGS_distributed_max_attempts)
+        {
+            if (createFileExclusive(getChunkPath(jobDirectory, chunk.index, ".failed"), workerName))
+                op::opLog("Chunk " + std::to_string(chunk.index) + " was abandoned "
+                          + std::to_string(attempt + 1) + " times, it will not be retried.", op::Priority::High);
+            return -1;
+        }
+        const auto newAttempt = attempt + 1;
+        if (!createFileExclusive(getClaimPath(jobDirectory, chunk.index, newAttempt), workerName))
+            return -1;
+        op::opLog("Re-running abandoned chunk " + std::to_string(chunk.index) + " (attempt "
+                  + std::to_string(newAttempt + 1) + ").", op::Priority::High);
+        return newAttempt;
+    }
+
+    // 1 line per frame: {"frame_number":N,"people":[{"person_id":ID,"pose_keypoints_2d":[x,y,score,...]},...]}
+    std::string datumToJsonLine(const op::Datum& datum)
+    {
+        const op::ArrayView3<const float> poseKeypoints{datum.poseKeypoints};
+        std::ostringstream line;
+        line << "{\"frame_number\":" << datum.frameNumber << ",\"people\":[";
+        for (auto person = 0 ; person < poseKeypoints.getSize(0) ; person++)
+        {
+            const auto personId = ((size_t)person < datum.poseIds.getVolume() ? datum.poseIds[person] : -1ll);
+            line << (person > 0 ? "," : "") << "{\"person_id\":" << personId << ",\"pose_keypoints_2d\":[";
+            const auto* const keypointsPtr = poseKeypoints.getPtr(person);
+            const auto numberValues = poseKeypoints.getSize(1) * poseKeypoints.getSize(2);
+            for (auto value = 0 ; value < numberValues ; value++)
+                line << (value > 0 ? "," : "") << keypointsPtr[value];
+            line << "]}";
+        }
+        line << "]}\n";
+        return line.str();
+    }
+
+    // All frames of the chunk are processed in order, keeping up to `--distributed_pipeline_depth` of them inside
+    // OpenPose, so its GPU workers stay busy. It returns false if its video could not be opened
+    bool processChunk(
+        op::Wrapper& opWrapper, const std::string& jobDirectory, const Chunk& chunk, const int attempt,
+        const std::string& workerName, cv::VideoCapture& videoCapture, std::string& openedVideoPath)
+    {
+        if (openedVideoPath != chunk.videoPath)
+        {
+            openedVideoPath.clear();
+            if (!videoCapture.open(chunk.videoPath))
+                return false;
+            openedVideoPath = chunk.videoPath;
+        }
+        // OpenCV seeks to the previous keyframe and decodes from there, i.e., chunks aligned with the keyframes do
+        // not decode any frame twice
+        videoCapture.set(cv::CAP_PROP_POS_FRAMES, (double)chunk.frameFirst);
+        const auto claimPath = getClaimPath(jobDirectory, chunk.index, attempt);
+        const auto heartbeatPeriod = std::chrono::duration<double>(FLAGS_distributed_lease_s / 4.);
+        auto lastHeartbeat = Clock::now();
+        auto numberHeartbeats = 0ull;
+        const auto pipelineDepth = (unsigned int)FLAGS_distributed_pipeline_depth;
+        auto framesInFlight = 0u;
+        auto nextFrameNumber = chunk.frameFirst;
+        auto endOfChunk = false;
+        std::map<unsigned long long, std::string> lines;
+        while (true)
+        {
+            // Fill the pipeline
+            while (!endOfChunk && framesInFlight < pipelineDepth)
+            {
+                // A new cv::Mat each time, since read() would overwrite the buffer of frames still in OpenPose
+                cv::Mat frame;
+                if (nextFrameNumber > chunk.frameLast || !videoCapture.read(frame) || frame.empty())
+                {
+                    endOfChunk = true;
+                    break;
+                }
+                auto datumsPtr = std::make_shared<std::vector<std::shared_ptr<op::Datum>>>();
+                datumsPtr->emplace_back(std::make_shared<op::Datum>());
+                datumsPtr->at(0)->cvInputData = OP_CV2OPCONSTMAT(frame);
+                datumsPtr->at(0)->frameNumber = nextFrameNumber;
+                if (!opWrapper.waitAndEmplace(datumsPtr))
+                    op::error("OpenPose stopped while processing chunk " + std::to_string(chunk.index) + ".",
+                              __LINE__, __FUNCTION__, __FILE__);
+                nextFrameNumber++;
+                framesInFlight++;
+            }
+            if (framesInFlight == 0u)
+                break;
+            // Retrieve the oldest frame
+            DatumsSP datumsPtr;
+            if (!opWrapper.waitAndPop(datumsPtr))
+                op::error("OpenPose stopped while processing chunk " + std::to_string(chunk.index) + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+            framesInFlight--;
+            if (datumsPtr != nullptr)
+                for (const auto& datumPtr : *datumsPtr)
+                    lines[datumPtr->frameNumber] = datumToJsonLine(*datumPtr);
+            // Renew the claim
+            if (Clock::now() - lastHeartbeat > heartbeatPeriod)
+            {
+                lastHeartbeat = Clock::now();
+                writeFile(claimPath, workerName + " " + std::to_string(++numberHeartbeats) + " "
+                          + std::to_string(nextFrameNumber));
+            }
+        }
+        // Result
+        std::string result;
+        for (const auto& line : lines)
+            result += line.second;
+        writeFileAtomic(getChunkPath(jobDirectory, chunk.index, ".jsonl"), result, ".tmp." + workerName);
+        return true;
+    }
+
+    void runWorker(op::Wrapper& opWrapper, const std::string& jobDirectory)
+    {
+        const auto workerName = getWorkerName();
+        op::opLog("Worker " + workerName + " waiting for " + jobDirectory + JOBS_FILE_NAME + "...",
+                  op::Priority::High);
+        while (!op::existFile(jobDirectory + JOBS_FILE_NAME))
+            std::this_thread::sleep_for(std::chrono::seconds{1});
+        const auto chunks = readJobs(jobDirectory);
+        LeaseObserver leaseObserver;
+        cv::VideoCapture videoCapture;
+        std::string openedVideoPath;
+        auto numberProcessed = 0u;
+        while (true)
+        {
+            auto allFinished = true;
+            auto claimedAny = false;
+            for (const auto& chunk : chunks)
+            {
+                if (isChunkFinished(jobDirectory, chunk))
+                    continue;
+                allFinished = false;
+                const auto attempt = tryClaimChunk(jobDirectory, chunk, workerName, leaseObserver);
+                if (attempt < 0)
+                    continue;
+                claimedAny = true;
+                const auto chunkTimer = op::getTimerInit();
+                if (processChunk(opWrapper, jobDirectory, chunk, attempt, workerName, videoCapture, openedVideoPath))
+                {
+                    numberProcessed++;
+                    op::printTime(chunkTimer, "Chunk " + std::to_string(chunk.index) + " processed in ", " seconds.",
+                                  op::Priority::High);
+                }
+                // Not recoverable by retrying it (e.g., missing or unreadable video)
+                else if (createFileExclusive(getChunkPath(jobDirectory, chunk.index, ".failed"), workerName))
+                    op::opLog("Video " + chunk.videoPath + " could not be opened, chunk "
+                              + std::to_string(chunk.index) + " failed.", op::Priority::High);
+            }
+            if (allFinished)
+                break;
+            // The remaining chunks are being processed by other workers, keep watching them in case they die
+            if (!claimedAny)
+                std::this_thread::sleep_for(std::chrono::seconds{1});
+        }
+        op::opLog("All chunks finished (" + std::to_string(numberProcessed) + " of them processed by this worker).",
+                  op::Priority::High);
+    }
+
+    void splitJobs(const std::string& jobDirectory)
+    {
+        const auto jobsPath = jobDirectory + JOBS_FILE_NAME;
+        if (op::existFile(jobsPath))
+        {
+            op::opLog("Resuming the jobs of " + jobsPath + ".", op::Priority::High);
+            return;
+        }
+        if (FLAGS_distributed_chunk_frames < 1 || FLAGS_distributed_keyframe_interval < 0)
+            op::error("`--distributed_chunk_frames` must be at least 1 and `--distributed_keyframe_interval` at"
+                      " least 0.", __LINE__, __FUNCTION__, __FILE__);
+        auto chunkFrames = (unsigned long long)FLAGS_distributed_chunk_frames;
+        if (FLAGS_distributed_keyframe_interval > 0)
+        {
+            const auto keyframeInterval = (unsigned long long)FLAGS_distributed_keyframe_interval;
+            chunkFrames = (chunkFrames + keyframeInterval - 1) / keyframeInterval * keyframeInterval;
+        }
+        std::ostringstream jobs;
+        jobs << JOBS_FILE_HEADER << "\n";
+        auto chunkIndex = 0u;
+        std::istringstream videos{FLAGS_distributed_videos};
+        std::string videoPath;
+        while (std::getline(videos, videoPath, ','))
+        {
+            if (videoPath.empty())
+                continue;
+            cv::VideoCapture videoCapture{videoPath};
+            if (!videoCapture.isOpened())
+                op::error("Video " + videoPath + " could not be opened.", __LINE__, __FUNCTION__, __FILE__);
+            // Approximated by some containers, so the last chunk is processed until the end of the video
+            const auto frameCount = std::max(0., videoCapture.get(cv::CAP_PROP_FRAME_COUNT));
+            const auto numberChunks = std::max(1ull, (unsigned long long)std::ceil(frameCount / chunkFrames));
+            for (auto chunk = 0ull ; chunk < numberChunks ; chunk++)
+                jobs << chunkIndex++ << " " << chunk * chunkFrames << " "
+                     << (chunk + 1 < numberChunks ? (chunk + 1) * chunkFrames - 1 : FRAME_LAST_UNKNOWN) << " "
+                     << videoPath << "\n";
+            op::opLog("Video " + videoPath + ": " + std::to_string(numberChunks) + " chunk(s).", op::Priority::High);
+        }
+        if (chunkIndex == 0u)
+            op::error("No video was specified (`--distributed_videos`).", __LINE__, __FUNCTION__, __FILE__);
+        writeFileAtomic(jobsPath, jobs.str(), ".tmp");
+    }
+
+    struct ParsedPerson
+    {
+        long long id;
+        std::size_t idBegin; // Position of the ID in the JSON line
+        std::size_t idEnd;
+        std::vector<float> keypoints;
+    };
+
+    // It only parses the lines written by datumToJsonLine()
+    std::vector<ParsedPerson> parsePeople(const std::string& line)
+    {
+        std::vector<ParsedPerson> people;
+        const std::string idKey{"\"person_id\":"};
+        const std::string keypointsKey{"\"pose_keypoints_2d\":["};
+        auto position = line.find(idKey);
+        while (position != std::string::npos)
+        {
+            ParsedPerson person;
+            person.idBegin = position + idKey.size();
+            person.idEnd = line.find(',', person.idBegin);
+            person.id = std::stoll(line.substr(person.idBegin, person.idEnd - person.idBegin));
+            const auto keypointsBegin = line.find(keypointsKey, person.idEnd) + keypointsKey.size();
+            const auto keypointsEnd = line.find(']', keypointsBegin);
+            std::istringstream keypoints{line.substr(keypointsBegin, keypointsEnd - keypointsBegin)};
+            std::string value;
+            while (std::getline(keypoints, value, ','))
+                person.keypoints.emplace_back(std::stof(value));
+            people.emplace_back(person);
+            position = line.find(idKey, keypointsEnd);
+        }
+        return people;
+    }
+
+    // Average distance between the keypoints detected in both people (infinite if they have none in common)
+    float getPersonDistance(const std::vector<float>& keypointsA, const std::vector<float>& keypointsB)
+    {
+        auto distance = 0.f;
+        auto numberCommon = 0;
+        for (auto index = 0u ; index + 2 < std::min(keypointsA.size(), keypointsB.size()) ; index += 3)
+        {
+            if (keypointsA[index+2] > 0.f && keypointsB[index+2] > 0.f)
+            {
+                distance += std::sqrt((keypointsA[index] - keypointsB[index])*(keypointsA[index] - keypointsB[index])
+                    + (keypointsA[index+1] - keypointsB[index+1])*(keypointsA[index+1] - keypointsB[index+1]));
+                numberCommon++;
+            }
+        }
+        return (numberCommon > 0 ? distance / numberCommon : std::numeric_limits<float>::infinity());
+    }
+
+    // Each chunk numbers its people independently. The people of the first frame of a chunk are greedily matched
+    // (closest pairs first) with the ones of the last frame of the previous chunk, inheriting their global ID. The
+    // unmatched ones get a new global ID
+    std::map<long long, long long> stitchPersonIds(
+        const std::vector<ParsedPerson>& previousPeople, const std::vector<ParsedPerson>& firstPeople)
+    {
+        std::vector<std::tuple<float, std::size_t, std::size_t>> pairs;
+        for (auto first = 0u ; first < firstPeople.size() ; first++)
+            for (auto previous = 0u ; previous < previousPeople.size() ; previous++)
+            {
+                if (firstPeople[first].id < 0 || previousPeople[previous].id < 0)
+                    continue;
+                const auto distance = getPersonDistance(firstPeople[first].keypoints,
+                                                        previousPeople[previous].keypoints);
+                if (distance < FLAGS_distributed_id_max_distance)
+                    pairs.emplace_back(std::make_tuple(distance, first, previous));
+            }
+        std::sort(pairs.begin(), pairs.end());
+        std::map<long long, long long> idMap;
+        std::vector<bool> previousUsed(previousPeople.size(), false);
+        for (const auto& pair : pairs)
+        {
+            const auto& firstPerson = firstPeople[std::get<1>(pair)];
+            if (idMap.count(firstPerson.id) == 0 && !previousUsed[std::get<2>(pair)])
+            {
+                idMap[firstPerson.id] = previousPeople[std::get<2>(pair)].id;
+                previousUsed[std::get<2>(pair)] = true;
+            }
+        }
+        return idMap;
+    }
+
+    void mergeResults(const std::string& jobDirectory, const std::vector<Chunk>& chunks)
+    {
+        const auto outputDirectory = op::formatAsDirectory(
+            FLAGS_distributed_output.empty() ? jobDirectory : FLAGS_distributed_output);
+        op::makeDirectory(outputDirectory);
+        std::map<std::string, std::vector<Chunk>> videoChunks;
+        for (const auto& chunk : chunks)
+            videoChunks[chunk.videoPath].emplace_back(chunk);
+        for (auto& video : videoChunks)
+        {
+            std::sort(video.second.begin(), video.second.end(),
+                      [](const Chunk& a, const Chunk& b) { return a.frameFirst < b.frameFirst; });
+            const auto outputPath = outputDirectory + op::getFileNameNoExtension(video.first) + ".jsonl";
+            std::ofstream outputFile{outputPath, std::ios::binary | std::ios::trunc};
+            if (!outputFile.is_open())
+                op::error("File " + outputPath + " could not be written.", __LINE__, __FUNCTION__, __FILE__);
+            auto nextGlobalId = 0ll;
+            std::vector<ParsedPerson> previousPeople;
+            for (const auto& chunk : video.second)
+            {
+                std::ifstream chunkFile{getChunkPath(jobDirectory, chunk.index, ".jsonl")};
+                std::vector<std::string> lines;
+                std::string line;
+                while (std::getline(chunkFile, line))
+                    if (!line.empty())
+                        lines.emplace_back(line);
+                if (lines.empty())
+                    continue;
+                auto idMap = stitchPersonIds(previousPeople, parsePeople(lines.front()));
+                for (auto lineIndex = 0u ; lineIndex < lines.size() ; lineIndex++)
+                {
+                    auto people = parsePeople(lines[lineIndex]);
+                    // Rewrite the IDs (people with ID -1 are not tracked, they are kept as they are)
+                    std::string mergedLine;
+                    auto copiedUntil = std::size_t{0};
+                    for (auto& person : people)
+                    {
+                        if (person.id < 0)
+                            continue;
+                        auto globalId = idMap.find(person.id);
+                        if (globalId == idMap.end())
+                            globalId = idMap.emplace(person.id, nextGlobalId++).first;
+                        mergedLine += lines[lineIndex].substr(copiedUntil, person.idBegin - copiedUntil)
+                            + std::to_string(globalId->second);
+                        copiedUntil = person.idEnd;
+                        person.id = globalId->second;
+                    }
+                    mergedLine += lines[lineIndex].substr(copiedUntil);
+                    outputFile << mergedLine << "\n";
+                    if (lineIndex + 1 == lines.size())
+                        previousPeople = people;
+                }
+            }
+            op::opLog("Results of " + video.first + " saved in " + outputPath + ".", op::Priority::High);
+        }
+    }
+
+    void runCoordinator(const std::string& jobDirectory)
+    {
+        splitJobs(jobDirectory);
+        const auto chunks = readJobs(jobDirectory);
+        op::opLog("Waiting for the workers to process " + std::to_string(chunks.size()) + " chunk(s)...",
+                  op::Priority::High);
+        auto numberFinishedLogged = std::numeric_limits<std::size_t>::max();
+        std::vector<unsigned int> failedChunks;
+        while (true)
+        {
+            auto numberFinished = std::size_t{0};
+            failedChunks.clear();
+            for (const auto& chunk : chunks)
+            {
+                if (op::existFile(getChunkPath(jobDirectory, chunk.index, ".jsonl")))
+                    numberFinished++;
+                else if (op::existFile(getChunkPath(jobDirectory, chunk.index, ".failed")))
+                {
+                    numberFinished++;
+                    failedChunks.emplace_back(chunk.index);
+                }
+            }
+            if (numberFinished != numberFinishedLogged)
+            {
+                numberFinishedLogged = numberFinished;
+                op::opLog(std::to_string(numberFinished) + "/" + std::to_string(chunks.size()) + " chunk(s) finished.",
+                          op::Priority::High);
+            }
+            if (numberFinished == chunks.size())
+                break;
+            std::this_thread::sleep_for(std::chrono::seconds{2});
+        }
+        if (!failedChunks.empty())
+        {
+            std::string failedList;
+            for (const auto failedChunk : failedChunks)
+                failedList += (failedList.empty() ? "" : ", ") + std::to_string(failedChunk);
+            op::error("Chunk(s) " + failedList + " failed. Remove their `.failed` and `.claim.*` files from "
+                      + jobDirectory + " and run the coordinator and the workers again to retry them.",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+        mergeResults(jobDirectory, chunks);
+    }
+}
+
+void configureWrapper(op::Wrapper& opWrapper)
+{
+    try
+    {
+        // Configuring OpenPose
+
+        // logging_level
+        op::checkBool(
+            0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+            __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+        op::ConfigureLog::setAsynchronous(FLAGS_logging_async);
+        op::Profiler::setDefaultX(FLAGS_profile_speed);
+
+        // Applying user defined configuration - GFlags to program variables
+        // outputSize
+        const auto outputSize = op::flagsToPoint(op::String(FLAGS_output_resolution), "-1x-1");
+        // netInputSize
+        const auto netInputSize = op::flagsToPoint(op::String(FLAGS_net_resolution), "-1x368");
+        const auto netInputSizeMin = op::flagsToPoint(op::String(FLAGS_net_resolution_min), "-1x256");
+        // poseMode
+        const auto poseMode = op::flagsToPoseMode(FLAGS_body);
+        // poseModel
+        const auto poseModel = op::flagsToPoseModel(op::String(FLAGS_model_pose));
+        // keypointScaleMode
+        const auto keypointScaleMode = op::flagsToScaleMode(FLAGS_keypoint_scale);
+        // heatmaps to add
+        const auto heatMapTypes = op::flagsToHeatMaps(FLAGS_heatmaps_add_parts, FLAGS_heatmaps_add_bkg,
+                                                      FLAGS_heatmaps_add_PAFs);
+        const auto heatMapScaleMode = op::flagsToHeatMapScaleMode(FLAGS_heatmaps_scale);
+        // Enabling Google Logging
+        const bool enableGoogleLogging = true;
+
+        // Pose configuration (use WrapperStructPose{} for default and recommended configuration). Rendering is
+        // disabled, only the keypoints are saved
+        const op::WrapperStructPose wrapperStructPose{
+            poseMode, netInputSize, FLAGS_net_resolution_dynamic, outputSize, keypointScaleMode, FLAGS_num_gpu,
+            FLAGS_num_gpu_start, FLAGS_scale_number, (float)FLAGS_scale_gap, op::RenderMode::None, poseModel,
+            !FLAGS_disable_blending, (float)FLAGS_alpha_pose, (float)FLAGS_alpha_heatmap, FLAGS_part_to_show,
+            op::String(FLAGS_model_folder), heatMapTypes, heatMapScaleMode, FLAGS_part_candidates,
+            (float)FLAGS_render_threshold, FLAGS_number_people_max, FLAGS_maximize_positives, FLAGS_fps_max,
+            op::String(FLAGS_prototxt_path), op::String(FLAGS_caffemodel_path), (float)FLAGS_upsampling_ratio,
+            enableGoogleLogging, FLAGS_batch_size, FLAGS_batch_max_wait, FLAGS_tensorrt_precision,
+            FLAGS_heatmaps_fp16, FLAGS_latency_target, netInputSizeMin, FLAGS_roi_tracking_interval,
+            FLAGS_scale_batch, FLAGS_motion_gate, FLAGS_motion_gate_pixel_threshold, FLAGS_motion_gate_max_skip,
+            FLAGS_cuda_graphs, FLAGS_pose_pipelined, FLAGS_paf_low_resolution, FLAGS_heatmaps_lazy};
+        opWrapper.configure(wrapperStructPose);
+        // Extra functionality configuration (use op::WrapperStructExtra{} to disable it)
+        const auto gpuThreadPriority = op::flagsToThreadPriority(FLAGS_gpu_thread_priority);
+        const op::WrapperStructExtra wrapperStructExtra{
+            false, -1, FLAGS_identification, FLAGS_tracking, FLAGS_ik_threads, FLAGS_thread_pool,
+            FLAGS_gpu_numa_affinity, gpuThreadPriority, FLAGS_cpu_worker_threads, FLAGS_gpu_dispatch,
+            FLAGS_reorder_window_ms, FLAGS_tracking_extrapolation};
+        opWrapper.configure(wrapperStructExtra);
+        // Output (the chunk results are saved by the worker itself)
+        op::WrapperStructOutput wrapperStructOutput;
+        wrapperStructOutput.verbose = FLAGS_cli_verbose;
+        wrapperStructOutput.metricsPort = FLAGS_metrics_port;
+        wrapperStructOutput.allocationMetrics = FLAGS_allocation_metrics;
+        wrapperStructOutput.traceFile = op::String(FLAGS_trace_file);
+        opWrapper.configure(wrapperStructOutput);
+        // No GUI. Equivalent to: opWrapper.configure(op::WrapperStructGui{});
+        // Set to single-thread (for sequential processing and/or debugging and/or reducing latency)
+        if (FLAGS_disable_multi_thread)
+            opWrapper.disableMultiThreading();
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+int openPoseDistributed()
+{
+    try
+    {
+        const auto opTimer = op::getTimerInit();
+
+        // Sanity checks
+        if (FLAGS_distributed_job_dir.empty())
+            op::error("`--distributed_job_dir` must be specified.", __LINE__, __FUNCTION__, __FILE__);
+        if (FLAGS_distributed_lease_s <= 0. || FLAGS_distributed_max_attempts < 1
+            || FLAGS_distributed_pipeline_depth < 1)
+            op::error("`--distributed_lease_s`, `--distributed_max_attempts` and `--distributed_pipeline_depth` must"
+                      " be positive.", __LINE__, __FUNCTION__, __FILE__);
+        const auto jobDirectory = op::formatAsDirectory(FLAGS_distributed_job_dir);
+        op::makeDirectory(jobDirectory);
+
+        if (FLAGS_distributed_mode == "coordinator")
+        {
+            op::opLog("Starting OpenPose distributed coordinator...", op::Priority::High);
+            runCoordinator(jobDirectory);
+        }
+        else if (FLAGS_distributed_mode == "worker")
+        {
+            op::opLog("Starting OpenPose distributed worker...", op::Priority::High);
+            op::Wrapper opWrapper{op::ThreadManagerMode::Asynchronous};
+            configureWrapper(opWrapper);
+            op::opLog("Starting thread(s)...", op::Priority::High);
+            opWrapper.start();
+            runWorker(opWrapper, jobDirectory);
+            op::opLog("Stopping thread(s)", op::Priority::High);
+            opWrapper.stop();
+        }
+        else
+            op::error("`--distributed_mode` must be `coordinator` or `worker`.", __LINE__, __FUNCTION__, __FILE__);
+
+        // Measuring total time
+        op::printTime(opTimer, "OpenPose distributed " + FLAGS_distributed_mode
+                      + " successfully finished. Total time: ", " seconds.", op::Priority::High);
+
+        // Return
+        return 0;
+    }
+    catch (const std::exception&)
+    {
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running openPoseDistributed
+    return openPoseDistributed();
+}
@@ -24,6 +24,7 @@ void configureWrapper(op::Wrapper& opWrapper)
             0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
             __LINE__, __FUNCTION__, __FILE__);
         op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+        op::ConfigureLog::setAsynchronous(FLAGS_logging_async);
         op::Profiler::setDefaultX(FLAGS_profile_speed);
 
         // Applying user defined configuration - GFlags to program variables
@@ -32,15 +33,21 @@ void configureWrapper(op::Wrapper& opWrapper)
         op::String producerString;
         std::tie(producerType, producerString) = op::flagsToProducer(
             op::String(FLAGS_image_dir), op::String(FLAGS_video), op::String(FLAGS_ip_camera), FLAGS_camera,
-            FLAGS_flir_camera, FLAGS_flir_camera_index);
+            FLAGS_flir_camera, FLAGS_flir_camera_index, op::String(FLAGS_input_replay),
+            op::String(FLAGS_shm_input));
         // cameraSize
         const auto cameraSize = op::flagsToPoint(op::String(FLAGS_camera_resolution), "-1x-1");
         // outputSize
         const auto outputSize = op::flagsToPoint(op::String(FLAGS_output_resolution), "-1x-1");
         // netInputSize
         const auto netInputSize = op::flagsToPoint(op::String(FLAGS_net_resolution), "-1x368");
+        const auto netInputSizeMin = op::flagsToPoint(op::String(FLAGS_net_resolution_min), "-1x256");
+        const auto tiledInputSize = op::flagsToPoint(op::String(FLAGS_tiled_resolution), "-1x2160");
         // faceNetInputSize
         const auto faceNetInputSize = op::flagsToPoint(op::String(FLAGS_face_net_resolution), "368x368 (multiples of 16)");
+        // faceDetectorNetInputSize
+        const auto faceDetectorNetInputSize = op::flagsToPoint(
+            op::String(FLAGS_face_detector_net_resolution), "-1x256 (multiples of 32)");
         // handNetInputSize
         const auto handNetInputSize = op::flagsToPoint(op::String(FLAGS_hand_net_resolution), "368x368 (multiples of 16)");
         // poseMode
@@ -74,29 +81,57 @@ void configureWrapper(op::Wrapper& opWrapper)
             (float)FLAGS_alpha_pose, (float)FLAGS_alpha_heatmap, FLAGS_part_to_show, op::String(FLAGS_model_folder),
             heatMapTypes, heatMapScaleMode, FLAGS_part_candidates, (float)FLAGS_render_threshold,
             FLAGS_number_people_max, FLAGS_maximize_positives, FLAGS_fps_max, op::String(FLAGS_prototxt_path),
-            op::String(FLAGS_caffemodel_path), (float)FLAGS_upsampling_ratio, enableGoogleLogging};
+            op::String(FLAGS_caffemodel_path), (float)FLAGS_upsampling_ratio, enableGoogleLogging,
+            FLAGS_batch_size, FLAGS_batch_max_wait, FLAGS_tensorrt_precision,
+            FLAGS_heatmaps_fp16, FLAGS_latency_target, netInputSizeMin, FLAGS_roi_tracking_interval,
+            FLAGS_scale_batch, FLAGS_motion_gate, FLAGS_motion_gate_pixel_threshold, FLAGS_motion_gate_max_skip,
+            FLAGS_cuda_graphs, FLAGS_pose_pipelined, FLAGS_paf_low_resolution, FLAGS_heatmaps_lazy,
+            op::String(FLAGS_net_output_cache), FLAGS_gpu_memory_budget, FLAGS_warm_up,
+            op::String(FLAGS_warm_up_cache), FLAGS_net_memory_sharing, tiledInputSize, (float)FLAGS_tile_overlap,
+            FLAGS_net_stages, (float)FLAGS_scale_adaptive, FLAGS_pose_shared_pool,
+            op::String(FLAGS_cuda_autotune_cache), (float)FLAGS_heatmaps_sparse_threshold};
         opWrapper.configure(wrapperStructPose);
         // Face configuration (use op::WrapperStructFace{} to disable it)
         const op::WrapperStructFace wrapperStructFace{
             FLAGS_face, faceDetector, faceNetInputSize,
             op::flagsToRenderMode(FLAGS_face_render, multipleView, FLAGS_render_pose),
-            (float)FLAGS_face_alpha_pose, (float)FLAGS_face_alpha_heatmap, (float)FLAGS_face_render_threshold};
+            (float)FLAGS_face_alpha_pose, (float)FLAGS_face_alpha_heatmap, (float)FLAGS_face_render_threshold,
+            faceDetectorNetInputSize, FLAGS_face_detector_scale_number, FLAGS_face_hand_roi_cache,
+            FLAGS_face_hand_adaptive_crop, (float)FLAGS_face_hand_from_body, true, FLAGS_face_hand_lazy_idle_s};
         opWrapper.configure(wrapperStructFace);
         // Hand configuration (use op::WrapperStructHand{} to disable it)
         const op::WrapperStructHand wrapperStructHand{
             FLAGS_hand, handDetector, handNetInputSize, FLAGS_hand_scale_number, (float)FLAGS_hand_scale_range,
             op::flagsToRenderMode(FLAGS_hand_render, multipleView, FLAGS_render_pose), (float)FLAGS_hand_alpha_pose,
-            (float)FLAGS_hand_alpha_heatmap, (float)FLAGS_hand_render_threshold};
+            (float)FLAGS_hand_alpha_heatmap, (float)FLAGS_hand_render_threshold, FLAGS_face_hand_concurrent,
+            FLAGS_face_hand_roi_cache, FLAGS_face_hand_adaptive_crop,
+            (float)FLAGS_face_hand_from_body, true, FLAGS_face_hand_lazy_idle_s};
         opWrapper.configure(wrapperStructHand);
         // Extra functionality configuration (use op::WrapperStructExtra{} to disable it)
+        const auto gpuThreadPriority = op::flagsToThreadPriority(FLAGS_gpu_thread_priority);
+        // Person crops (disabled if empty)
+        const auto personCropSize = (FLAGS_person_crops.empty()
+            ? op::Point<int>{0,0} : op::flagsToPoint(op::String(FLAGS_person_crops), "192x256"));
         const op::WrapperStructExtra wrapperStructExtra{
-            FLAGS_3d, FLAGS_3d_min_views, FLAGS_identification, FLAGS_tracking, FLAGS_ik_threads};
+            FLAGS_3d, FLAGS_3d_min_views, FLAGS_identification, FLAGS_tracking, FLAGS_ik_threads,
+            FLAGS_thread_pool, FLAGS_gpu_numa_affinity, gpuThreadPriority, FLAGS_cpu_worker_threads,
+            FLAGS_gpu_dispatch, FLAGS_reorder_window_ms, FLAGS_tracking_extrapolation,
+            FLAGS_3d_multi_person, FLAGS_auto_configure, personCropSize, (float)FLAGS_person_crops_scale,
+            FLAGS_person_crops_align, FLAGS_person_crops_download, FLAGS_face_hand_gpu, FLAGS_spillover_workers,
+            op::String(FLAGS_spillover_model), FLAGS_spillover_queue, FLAGS_3d_temporal, FLAGS_3d_gpu_affinity,
+            op::flagsToQueueType(FLAGS_queue_type)};
         opWrapper.configure(wrapperStructExtra);
         // Producer (use default to disable any input)
         const op::WrapperStructInput wrapperStructInput{
             producerType, producerString, FLAGS_frame_first, FLAGS_frame_step, FLAGS_frame_last,
             FLAGS_process_real_time, FLAGS_frame_flip, FLAGS_frame_rotate, FLAGS_frames_repeat,
-            cameraSize, op::String(FLAGS_camera_parameter_path), FLAGS_frame_undistort, FLAGS_3d_views};
+            cameraSize, op::String(FLAGS_camera_parameter_path), FLAGS_frame_undistort, FLAGS_3d_views,
+            FLAGS_video_nvdec, FLAGS_image_dir_threads, FLAGS_datum_pool_size,
+            FLAGS_flir_camera_bayer_gpu, FLAGS_flir_camera_sync_ms, FLAGS_frame_undistort_keypoints,
+            op::String(FLAGS_input_record), op::String(FLAGS_input_record_format), FLAGS_video_decoders,
+            FLAGS_video_segment_frames, FLAGS_image_dir_stream, op::String(FLAGS_input_roi),
+            op::String(FLAGS_source_priority), op::String(FLAGS_source_max_latency_ms), FLAGS_decode_ahead,
+            FLAGS_camera_v4l2, FLAGS_camera_v4l2_fps, op::String(FLAGS_datum_receive), FLAGS_datum_receive_window};
         opWrapper.configure(wrapperStructInput);
         // Output (comment or use default argument to disable any output)
         const op::WrapperStructOutput wrapperStructOutput{
@@ -106,11 +141,21 @@ void configureWrapper(op::Wrapper& opWrapper)
             op::String(FLAGS_write_video), FLAGS_write_video_fps, FLAGS_write_video_with_audio,
             op::String(FLAGS_write_heatmaps), op::String(FLAGS_write_heatmaps_format), op::String(FLAGS_write_video_3d),
             op::String(FLAGS_write_video_adam), op::String(FLAGS_write_bvh), op::String(FLAGS_udp_host),
-            op::String(FLAGS_udp_port)};
+            op::String(FLAGS_udp_port), FLAGS_metrics_port, op::String(FLAGS_trace_file),
+            op::String(FLAGS_write_binary), FLAGS_write_threads,
+            op::String(FLAGS_write_video_encoder), op::String(FLAGS_stream_keypoints_udp),
+            op::String(FLAGS_stream_keypoints_shm), op::String(FLAGS_write_coco_json_eval),
+            FLAGS_write_jpg_gpu, op::String(FLAGS_stream_video),
+            op::String(FLAGS_stream_video_encoder), (float)FLAGS_stream_keypoints_precision,
+            (float)FLAGS_stream_keypoints_precision_3d, FLAGS_stream_keypoints_keyframe,
+            FLAGS_allocation_metrics, false, op::String(FLAGS_datum_send),
+            op::flagsToDatumWireFields(op::String(FLAGS_datum_send_fields)), FLAGS_datum_send_jpeg_quality,
+            FLAGS_datum_timing};
         opWrapper.configure(wrapperStructOutput);
         // GUI (comment or use default argument to disable any visual output)
         const op::WrapperStructGui wrapperStructGui{
-            op::flagsToDisplayMode(FLAGS_display, FLAGS_3d), !FLAGS_no_gui_verbose, FLAGS_fullscreen};
+            op::flagsToDisplayMode(FLAGS_display, FLAGS_3d), !FLAGS_no_gui_verbose, FLAGS_fullscreen,
+            FLAGS_display_vsync, FLAGS_display_skip_stale, FLAGS_display_overlay};
         opWrapper.configure(wrapperStructGui);
         // Set to single-thread (for sequential processing and/or debugging and/or reducing latency)
         if (FLAGS_disable_multi_thread)
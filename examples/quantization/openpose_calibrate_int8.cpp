@@ -0,0 +1,511 @@
+// --------------------------------------- OpenPose INT8 Calibration Tool ---------------------------------------
+// This binary generates the INT8 calibration caches of the OpenPose networks, and it reports the accuracy and speed
+// of the INT8 model with respect to the float (Caffe) one on the same images. E.g.:
+//     ./build/examples/quantization/openpose_calibrate_int8.bin --calibration_image_dir calibration_images/
+//         --int8_model_path pose/body_25/pose_iter_584000.onnx --calibration_report int8_report.json
+// Steps:
+// 1. The float Wrapper (the Caffe models) runs over the calibration images, storing their keypoints and timings.
+// 2. The body network (and the face and hand networks, if `--face` / `--hand`) runs again over the same inputs (the
+//    face and hand crops come from the rectangles found in step 1), and the histogram of each of its blobs is added
+//    to an Int8Calibrator. The body cache is written in `model_folder + int8_model_path + ".int8.calib"`, which is
+//    where NetTensorRt and NetOpenVino read it from in INT8 precision (`--tensorrt_precision 8`). The face and hand
+//    caches are written next to their Caffe models (`*.caffemodel.int8.calib`).
+// 3. The INT8 Wrapper (`--caffemodel_path int8_model_path --tensorrt_precision 8`) runs over the same images, and
+//    its keypoints and timings are compared with the float ones (see `--calibration_report`).
+// The ONNX / OpenVINO IR export of the model must keep the blob names of its Caffe prototxt as tensor names.
+
+// Third-party dependencies
+#include <opencv2/opencv.hpp>
+// Command-line user interface
+#define OPENPOSE_FLAGS_DISABLE_PRODUCER
+#define OPENPOSE_FLAGS_DISABLE_DISPLAY
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+// C++ std library dependencies
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+// Custom OpenPose flags
+// Calibration
+DEFINE_string(calibration_image_dir,    "examples/media/",
+    "Directory of the calibration images. They should be representative of the images processed later (e.g., a few"
+    " hundred frames of the target cameras).");
+DEFINE_uint64(calibration_images_max,   500,
+    "Maximum number of images of `--calibration_image_dir` that are used.");
+DEFINE_string(int8_model_path,          "",
+    "ONNX (TensorRT or OpenVINO) or OpenVINO IR model of the body network, relative to `--model_folder`. Its"
+    " calibration cache is written next to it. If empty, the default Caffe model path of `--model_pose` (or"
+    " `--caffemodel_path`) with the `.onnx` extension.");
+DEFINE_uint64(calibration_bins,         2048,
+    "Number of bins of the activation histograms.");
+DEFINE_bool(calibration_only,           false,
+    "If true, only the calibration caches are generated, i.e., the INT8 model does not run and the accuracy-versus-"
+    "speed report is not generated (e.g., if the ONNX model is not exported yet).");
+DEFINE_string(calibration_report,       "",
+    "Path of the JSON file where the accuracy-versus-speed report is written. Empty to print it on the standard"
+    " output.");
+
+// Keypoints and processing time of each image
+struct CalibrationResult
+{
+    op::Array<float> poseKeypoints;
+    op::Array<float> faceKeypoints;
+    std::array<op::Array<float>, 2> handKeypoints;
+    std::vector<op::Rectangle<float>> faceRectangles;
+    std::vector<std::array<op::Rectangle<float>, 2>> handRectangles;
+    double timeMs;
+};
+
+// Accuracy of the INT8 keypoints with respect to the float ones
+struct KeypointComparison
+{
+    unsigned long long keypoints;
+    unsigned long long missedKeypoints;
+    unsigned long long correctKeypoints;
+    double errorSum;
+    unsigned long long people;
+    unsigned long long peopleDifference;
+
+    KeypointComparison() :
+        keypoints{0ull},
+        missedKeypoints{0ull},
+        correctKeypoints{0ull},
+        errorSum{0.},
+        people{0ull},
+        peopleDifference{0ull}
+    {}
+};
+
+double durationMs(const std::chrono::high_resolution_clock::time_point& timeBegin)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now() - timeBegin).count() * 1e-6;
+}
+
+std::string replaceExtension(const std::string& path, const std::string& extension)
+{
+    const auto dotPosition = path.find_last_of('.');
+    return (dotPosition == std::string::npos ? path : path.substr(0, dotPosition)) + extension;
+}
+
+void configureWrapper(op::Wrapper& opWrapper, const std::string& caffeModelPath, const int precision)
+{
+    try
+    {
+        // Applying user defined configuration - GFlags to program variables
+        // outputSize
+        const auto outputSize = op::flagsToPoint(op::String(FLAGS_output_resolution), "-1x-1");
+        // netInputSize
+        const auto netInputSize = op::flagsToPoint(op::String(FLAGS_net_resolution), "-1x368");
+        // netInputSizeMin
+        const auto netInputSizeMin = op::flagsToPoint(op::String(FLAGS_net_resolution_min), "-1x256");
+        // faceNetInputSize
+        const auto faceNetInputSize = op::flagsToPoint(op::String(FLAGS_face_net_resolution), "368x368 (multiples of 16)");
+        // handNetInputSize
+        const auto handNetInputSize = op::flagsToPoint(op::String(FLAGS_hand_net_resolution), "368x368 (multiples of 16)");
+        // poseMode
+        const auto poseMode = op::flagsToPoseMode(FLAGS_body);
+        // poseModel
+        const auto poseModel = op::flagsToPoseModel(op::String(FLAGS_model_pose));
+        // keypointScaleMode
+        const auto keypointScaleMode = op::flagsToScaleMode(FLAGS_keypoint_scale);
+        // Face and hand detectors
+        const auto faceDetector = op::flagsToDetector(FLAGS_face_detector);
+        const auto handDetector = op::flagsToDetector(FLAGS_hand_detector);
+        // Enabling Google Logging
+        const bool enableGoogleLogging = true;
+
+        // Pose configuration (no rendering, so only the keypoint estimation is timed)
+        const op::WrapperStructPose wrapperStructPose{
+            poseMode, netInputSize, FLAGS_net_resolution_dynamic, outputSize, keypointScaleMode, FLAGS_num_gpu,
+            FLAGS_num_gpu_start, FLAGS_scale_number, (float)FLAGS_scale_gap, op::RenderMode::None, poseModel,
+            !FLAGS_disable_blending, (float)FLAGS_alpha_pose, (float)FLAGS_alpha_heatmap, FLAGS_part_to_show,
+            op::String(FLAGS_model_folder), {}, op::ScaleMode::UnsignedChar, false, (float)FLAGS_render_threshold,
+            FLAGS_number_people_max, FLAGS_maximize_positives, -1., op::String(FLAGS_prototxt_path),
+            op::String(caffeModelPath), (float)FLAGS_upsampling_ratio, enableGoogleLogging, FLAGS_batch_size,
+            FLAGS_batch_max_wait, precision, false, FLAGS_latency_target, netInputSizeMin};
+        opWrapper.configure(wrapperStructPose);
+        // Face configuration (use op::WrapperStructFace{} to disable it)
+        const op::WrapperStructFace wrapperStructFace{
+            FLAGS_face, faceDetector, faceNetInputSize, op::RenderMode::None};
+        opWrapper.configure(wrapperStructFace);
+        // Hand configuration (use op::WrapperStructHand{} to disable it)
+        const op::WrapperStructHand wrapperStructHand{
+            FLAGS_hand, handDetector, handNetInputSize, FLAGS_hand_scale_number, (float)FLAGS_hand_scale_range,
+            op::RenderMode::None};
+        opWrapper.configure(wrapperStructHand);
+        // No output nor GUI, so only the processing is measured
+        // Set to single-thread (for sequential processing and/or debugging and/or reducing latency)
+        if (FLAGS_disable_multi_thread)
+            opWrapper.disableMultiThreading();
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+std::vector<CalibrationResult> runWrapper(
+    const std::vector<cv::Mat>& images, const std::string& caffeModelPath, const int precision)
+{
+    try
+    {
+        std::vector<CalibrationResult> calibrationResults;
+        op::Wrapper opWrapper{op::ThreadManagerMode::Asynchronous};
+        configureWrapper(opWrapper, caffeModelPath, precision);
+        opWrapper.start();
+        // The first image is processed twice, so the network initialization is not part of the timing
+        if (!images.empty())
+            opWrapper.emplaceAndPop(OP_CV2OPCONSTMAT(images.front()));
+        for (const auto& image : images)
+        {
+            const auto timeBegin = std::chrono::high_resolution_clock::now();
+            const auto datumsPtr = opWrapper.emplaceAndPop(OP_CV2OPCONSTMAT(image));
+            const auto timeMs = durationMs(timeBegin);
+            if (datumsPtr == nullptr || datumsPtr->empty())
+                op::error("The image could not be processed.", __LINE__, __FUNCTION__, __FILE__);
+            const auto& datum = *datumsPtr->at(0);
+            calibrationResults.emplace_back(CalibrationResult{
+                datum.poseKeypoints.clone(), datum.faceKeypoints.clone(),
+                {datum.handKeypoints[0].clone(), datum.handKeypoints[1].clone()}, datum.faceRectangles,
+                datum.handRectangles, timeMs});
+        }
+        opWrapper.stop();
+        return calibrationResults;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return {};
+    }
+}
+
+// Square crops (as FaceExtractorCaffe and HandExtractorCaffe, without the horizontal flip of the left hands, which
+// does not change the activation ranges)
+void addCrop(
+    op::Int8Calibrator& int8Calibrator, op::NetCaffe& netCaffe, op::Array<float>& netInput, const cv::Mat& image,
+    const op::Rectangle<float>& rectangle, const op::Point<int>& netInputSize)
+{
+    try
+    {
+        if (rectangle.area() <= 0.f)
+            return;
+        const auto scale = rectangle.width / (double)netInputSize.x;
+        cv::Mat affineMatrix = cv::Mat::eye(2, 3, CV_64F);
+        affineMatrix.at<double>(0,0) = scale;
+        affineMatrix.at<double>(1,1) = scale;
+        affineMatrix.at<double>(0,2) = rectangle.x;
+        affineMatrix.at<double>(1,2) = rectangle.y;
+        cv::Mat crop;
+        cv::warpAffine(image, crop, affineMatrix, cv::Size{netInputSize.x, netInputSize.y},
+                       cv::INTER_LINEAR | cv::WARP_INVERSE_MAP, cv::BORDER_CONSTANT, cv::Scalar{0,0,0});
+        netInput.reset({1, 3, netInputSize.y, netInputSize.x});
+        op::uCharCvMatToFloatPtr(netInput.getPtr(), OP_CV2OPMAT(crop), true);
+        netCaffe.forwardPass(netInput);
+        int8Calibrator.addNet(netCaffe);
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+void calibrate(
+    const std::vector<cv::Mat>& images, const std::vector<CalibrationResult>& floatResults,
+    const std::string& bodyCalibrationCachePath)
+{
+    try
+    {
+        const auto modelFolder = FLAGS_model_folder;
+        const auto poseModel = op::flagsToPoseModel(op::String(FLAGS_model_pose));
+        const auto gpuId = FLAGS_num_gpu_start;
+        const auto numberBins = (int)FLAGS_calibration_bins;
+
+        // Body: Same pre-processing as the Wrapper (largest scale only)
+        {
+            op::opLog("Calibrating the body network...", op::Priority::High);
+            const auto netInputSize = op::flagsToPoint(op::String(FLAGS_net_resolution), "-1x368");
+            const auto outputSize = op::flagsToPoint(op::String(FLAGS_output_resolution), "-1x-1");
+            const op::ScaleAndSizeExtractor scaleAndSizeExtractor{
+                netInputSize, (float)FLAGS_net_resolution_dynamic, outputSize, 1, FLAGS_scale_gap};
+            op::CvMatToOpInput cvMatToOpInput{poseModel};
+            op::NetCaffe netCaffe{
+                modelFolder + (FLAGS_prototxt_path.empty() ? op::getPoseProtoTxt(poseModel) : FLAGS_prototxt_path),
+                modelFolder + (FLAGS_caffemodel_path.empty()
+                    ? op::getPoseTrainedModel(poseModel) : FLAGS_caffemodel_path), gpuId};
+            netCaffe.initializationOnThread();
+            op::Int8Calibrator int8Calibrator{numberBins};
+            for (const auto& image : images)
+            {
+                const auto scalesAndSizes = scaleAndSizeExtractor.extract(op::Point<int>{image.cols, image.rows});
+                const auto netInputArrays = cvMatToOpInput.createArray(
+                    OP_CV2OPCONSTMAT(image), std::get<0>(scalesAndSizes), std::get<1>(scalesAndSizes));
+                netCaffe.forwardPass(netInputArrays.at(0));
+                int8Calibrator.addNet(netCaffe);
+            }
+            int8Calibrator.writeCalibrationCache(bodyCalibrationCachePath);
+            op::opLog("Body calibration cache saved in " + bodyCalibrationCachePath + ".", op::Priority::High);
+        }
+
+        // Face: Crops of the face rectangles of the float Wrapper
+        if (FLAGS_face)
+        {
+            op::opLog("Calibrating the face network...", op::Priority::High);
+            const auto netInputSize = op::flagsToPoint(
+                op::String(FLAGS_face_net_resolution), "368x368 (multiples of 16)");
+            op::NetCaffe netCaffe{modelFolder + op::FACE_PROTOTXT, modelFolder + op::FACE_TRAINED_MODEL, gpuId};
+            netCaffe.initializationOnThread();
+            op::Int8Calibrator int8Calibrator{numberBins};
+            op::Array<float> netInput;
+            for (auto i = 0u ; i < images.size() ; i++)
+                for (const auto& faceRectangle : floatResults[i].faceRectangles)
+                    addCrop(int8Calibrator, netCaffe, netInput, images[i], faceRectangle, netInputSize);
+            const auto calibrationCachePath = modelFolder + op::FACE_TRAINED_MODEL + ".int8.calib";
+            int8Calibrator.writeCalibrationCache(calibrationCachePath);
+            op::opLog("Face calibration cache saved in " + calibrationCachePath + ".", op::Priority::High);
+        }
+
+        // Hand: Crops of the hand rectangles of the float Wrapper
+        if (FLAGS_hand)
+        {
+            op::opLog("Calibrating the hand network...", op::Priority::High);
+            const auto netInputSize = op::flagsToPoint(
+                op::String(FLAGS_hand_net_resolution), "368x368 (multiples of 16)");
+            op::NetCaffe netCaffe{modelFolder + op::HAND_PROTOTXT, modelFolder + op::HAND_TRAINED_MODEL, gpuId};
+            netCaffe.initializationOnThread();
+            op::Int8Calibrator int8Calibrator{numberBins};
+            op::Array<float> netInput;
+            for (auto i = 0u ; i < images.size() ; i++)
+                for (const auto& handRectangles : floatResults[i].handRectangles)
+                    for (const auto& handRectangle : handRectangles)
+                        addCrop(int8Calibrator, netCaffe, netInput, images[i], handRectangle, netInputSize);
+            const auto calibrationCachePath = modelFolder + op::HAND_TRAINED_MODEL + ".int8.calib";
+            int8Calibrator.writeCalibrationCache(calibrationCachePath);
+            op::opLog("Hand calibration cache saved in " + calibrationCachePath + ".", op::Priority::High);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+// Each float person is greedily matched with the closest unmatched INT8 person. The keypoint errors are normalized
+// by the diagonal of the bounding box of the float person, and a keypoint is correct if its error is below 5% of it
+// (PCK@0.05)
+void compareKeypoints(
+    KeypointComparison& keypointComparison, const op::Array<float>& floatKeypoints,
+    const op::Array<float>& int8Keypoints, const float threshold)
+{
+    try
+    {
+        const auto numberFloatPeople = (floatKeypoints.empty() ? 0 : floatKeypoints.getSize(0));
+        const auto numberInt8People = (int8Keypoints.empty() ? 0 : int8Keypoints.getSize(0));
+        keypointComparison.people += numberFloatPeople;
+        keypointComparison.peopleDifference += std::abs(numberFloatPeople - numberInt8People);
+        if (numberFloatPeople == 0)
+            return;
+        const auto numberKeypoints = floatKeypoints.getSize(1);
+        std::vector<bool> int8Matched(numberInt8People, false);
+        for (auto floatPerson = 0 ; floatPerson < numberFloatPeople ; floatPerson++)
+        {
+            auto bestInt8Person = -1;
+            auto bestDistance = std::numeric_limits<float>::max();
+            for (auto int8Person = 0 ; int8Person < numberInt8People ; int8Person++)
+            {
+                if (int8Matched[int8Person])
+                    continue;
+                const auto distance = op::getDistanceAverage(
+                    floatKeypoints, floatPerson, int8Keypoints, int8Person, threshold);
+                if (distance < bestDistance)
+                {
+                    bestDistance = distance;
+                    bestInt8Person = int8Person;
+                }
+            }
+            if (bestInt8Person >= 0)
+                int8Matched[bestInt8Person] = true;
+            const auto rectangle = op::getKeypointsRectangle(floatKeypoints, floatPerson, threshold);
+            const auto diagonal = std::sqrt(rectangle.width*rectangle.width + rectangle.height*rectangle.height);
+            for (auto part = 0 ; part < numberKeypoints ; part++)
+            {
+                const auto floatIndex = 3*(floatPerson*numberKeypoints + part);
+                if (floatKeypoints[floatIndex+2] < threshold)
+                    continue;
+                keypointComparison.keypoints++;
+                const auto int8Index = 3*(bestInt8Person*numberKeypoints + part);
+                if (bestInt8Person < 0 || int8Keypoints[int8Index+2] < threshold)
+                {
+                    keypointComparison.missedKeypoints++;
+                    continue;
+                }
+                const auto dx = floatKeypoints[floatIndex] - int8Keypoints[int8Index];
+                const auto dy = floatKeypoints[floatIndex+1] - int8Keypoints[int8Index+1];
+                const auto error = (diagonal > 0.f ? std::sqrt(dx*dx + dy*dy) / diagonal : 0.f);
+                keypointComparison.errorSum += error;
+                if (error < 0.05f)
+                    keypointComparison.correctKeypoints++;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+std::string comparisonToJson(const KeypointComparison& keypointComparison)
+{
+    const auto matchedKeypoints = keypointComparison.keypoints - keypointComparison.missedKeypoints;
+    std::stringstream stringStream;
+    stringStream << std::fixed << std::setprecision(5)
+        << "{\"keypoints\": " << keypointComparison.keypoints
+        << ", \"missed_keypoints\": " << keypointComparison.missedKeypoints
+        << ", \"mean_normalized_error\": "
+        << (matchedKeypoints > 0 ? keypointComparison.errorSum / matchedKeypoints : 0.)
+        << ", \"pck_0.05\": " << (keypointComparison.keypoints > 0
+            ? keypointComparison.correctKeypoints / double(keypointComparison.keypoints) : 0.)
+        << ", \"people\": " << keypointComparison.people
+        << ", \"people_count_difference\": " << keypointComparison.peopleDifference << "}";
+    return stringStream.str();
+}
+
+std::string getReport(
+    const std::string& int8ModelPath, const std::vector<CalibrationResult>& floatResults,
+    const std::vector<CalibrationResult>& int8Results)
+{
+    try
+    {
+        const auto threshold = (float)FLAGS_render_threshold;
+        KeypointComparison poseComparison;
+        KeypointComparison faceComparison;
+        KeypointComparison handComparison;
+        auto floatTimeMs = 0.;
+        auto int8TimeMs = 0.;
+        for (auto i = 0u ; i < floatResults.size() ; i++)
+        {
+            compareKeypoints(poseComparison, floatResults[i].poseKeypoints, int8Results[i].poseKeypoints, threshold);
+            compareKeypoints(faceComparison, floatResults[i].faceKeypoints, int8Results[i].faceKeypoints,
+                             (float)FLAGS_face_render_threshold);
+            for (auto hand = 0 ; hand < 2 ; hand++)
+                compareKeypoints(handComparison, floatResults[i].handKeypoints[hand],
+                                 int8Results[i].handKeypoints[hand], (float)FLAGS_hand_render_threshold);
+            floatTimeMs += floatResults[i].timeMs;
+            int8TimeMs += int8Results[i].timeMs;
+        }
+        const auto numberImages = std::max(std::size_t(1), floatResults.size());
+        std::stringstream stringStream;
+        stringStream << std::fixed << std::setprecision(3)
+            << "{\n"
+            << "  \"openpose_version\": \"" << OPEN_POSE_VERSION_STRING << "\",\n"
+            << "  \"model_pose\": \"" << FLAGS_model_pose << "\",\n"
+            << "  \"int8_model\": \"" << int8ModelPath << "\",\n"
+            << "  \"net_resolution\": \"" << FLAGS_net_resolution << "\",\n"
+            << "  \"images\": " << floatResults.size() << ",\n"
+            << "  \"float_ms_per_image\": " << floatTimeMs / numberImages << ",\n"
+            << "  \"int8_ms_per_image\": " << int8TimeMs / numberImages << ",\n"
+            << "  \"speedup\": " << (int8TimeMs > 0. ? floatTimeMs / int8TimeMs : 0.) << ",\n"
+            << "  \"pose\": " << comparisonToJson(poseComparison);
+        if (FLAGS_face)
+            stringStream << ",\n  \"face\": " << comparisonToJson(faceComparison);
+        if (FLAGS_hand)
+            stringStream << ",\n  \"hand\": " << comparisonToJson(handComparison);
+        stringStream << "\n}\n";
+        return stringStream.str();
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return "";
+    }
+}
+
+int openPoseCalibrateInt8()
+{
+    try
+    {
+        op::opLog("Starting OpenPose INT8 calibration...", op::Priority::High);
+        const auto opTimer = op::getTimerInit();
+
+        // logging_level
+        op::checkBool(
+            0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+            __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+        op::Profiler::setDefaultX(FLAGS_profile_speed);
+        op::checkBool(FLAGS_scale_number == 1, "The calibration only supports `--scale_number 1`.",
+                      __LINE__, __FUNCTION__, __FILE__);
+
+        // Read the calibration images (ImageDirectoryReader keeps its file order)
+        std::vector<cv::Mat> images;
+        op::ImageDirectoryReader imageDirectoryReader{FLAGS_calibration_image_dir};
+        while (imageDirectoryReader.isOpened() && images.size() < FLAGS_calibration_images_max)
+        {
+            const auto frame = imageDirectoryReader.getFrame();
+            if (frame.empty())
+                break;
+            images.emplace_back(OP_OP2CVCONSTMAT(frame).clone());
+        }
+        if (images.empty())
+            op::error("No images found on: " + FLAGS_calibration_image_dir, __LINE__, __FUNCTION__, __FILE__);
+        op::opLog(std::to_string(images.size()) + " calibration images.", op::Priority::High);
+
+        // INT8 model and calibration cache paths
+        const auto poseModel = op::flagsToPoseModel(op::String(FLAGS_model_pose));
+        const auto int8ModelPath = (FLAGS_int8_model_path.empty()
+            ? replaceExtension(FLAGS_caffemodel_path.empty()
+                ? op::getPoseTrainedModel(poseModel) : FLAGS_caffemodel_path, ".onnx")
+            : FLAGS_int8_model_path);
+        const auto bodyCalibrationCachePath = FLAGS_model_folder + int8ModelPath + ".int8.calib";
+
+        // Float keypoints and timing, and calibration
+        op::opLog("Running the float models...", op::Priority::High);
+        const auto floatResults = runWrapper(images, FLAGS_caffemodel_path, 32);
+        calibrate(images, floatResults, bodyCalibrationCachePath);
+
+        // INT8 keypoints and timing, and accuracy-versus-speed report
+        if (!FLAGS_calibration_only)
+        {
+            op::opLog("Running the INT8 body model...", op::Priority::High);
+            const auto int8Results = runWrapper(images, int8ModelPath, 8);
+            const auto report = getReport(int8ModelPath, floatResults, int8Results);
+            if (FLAGS_calibration_report.empty())
+                std::cout << report;
+            else
+            {
+                std::ofstream reportFile{FLAGS_calibration_report};
+                if (!reportFile.is_open())
+                    op::error("Could not open file: " + FLAGS_calibration_report, __LINE__, __FUNCTION__, __FILE__);
+                reportFile << report;
+                op::opLog("INT8 report saved in " + FLAGS_calibration_report + ".", op::Priority::High);
+            }
+        }
+
+        // Measuring total time
+        op::printTime(opTimer, "OpenPose INT8 calibration successfully finished. Total time: ", " seconds.",
+                      op::Priority::High);
+
+        // Return successful message
+        return 0;
+    }
+    catch (const std::exception&)
+    {
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running openPoseCalibrateInt8
+    return openPoseCalibrateInt8();
+}
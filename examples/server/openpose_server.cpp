@@ -0,0 +1,1003 @@
+// ----------------------------------------------- OpenPose C++ Server -----------------------------------------------
+// This example runs OpenPose as an inference server, so several clients (processes or hosts) share the same
+// OpenPose instance (and its GPUs) instead of running 1 OpenPose per client. It...
+    // 1. Receives frames (encoded images or raw BGR pixels) by HTTP/1.1 (`POST /v1/pose`). Each connection is a
+    //    stream: the client can pipeline several frames on it without waiting for the previous results.
+    // 2. Schedules the frames of all the clients into a single asynchronous OpenPose Wrapper, earliest deadline
+    //    first. Frames whose deadline already passed are dropped before being processed. The GPU workers batch the
+    //    frames of all the clients together (see `--batch_size`).
+    // 3. Returns the keypoints of each frame in the binary keypoint packet format (see doc/02_output.md), in the same
+    //    order in which each connection sent them.
+// Backpressure: each connection can have at most `--server_client_queue` frames in progress (further ones are not
+// read from its socket until one finishes), and frames are rejected with `503` if the global queue is full.
+// Admission control (`--server_admission`): frames whose deadline cannot be met given the measured service time are
+// rejected (`503`) right away, or processed at `--server_degraded_resolution` if that is enough to meet it.
+// For more details, see doc/advanced/server.md.
+
+// Third-party dependencies
+#include <opencv2/opencv.hpp>
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <arpa/inet.h> // inet_pton
+    #include <netinet/in.h> // sockaddr_in
+    #include <netinet/tcp.h> // TCP_NODELAY
+    #include <sys/select.h> // select
+    #include <sys/socket.h>
+    #include <unistd.h> // close
+#endif
+#include <algorithm> // std::max, std::min
+#include <atomic>
+#include <cctype> // std::isalnum, std::tolower
+#include <cmath> // std::pow
+#include <condition_variable>
+#include <csignal>
+#include <cstring> // std::memcpy
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+// Command-line user interface
+#define OPENPOSE_FLAGS_DISABLE_PRODUCER
+#define OPENPOSE_FLAGS_DISABLE_DISPLAY
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+
+// Custom OpenPose flags
+// Server
+DEFINE_string(server_host,              "0.0.0.0",
+    "IP address to listen to (e.g., `127.0.0.1` to only accept local clients).");
+DEFINE_int32(server_port,               8080,
+    "TCP port to listen to.");
+DEFINE_int32(server_queue_size,         64,
+    "Maximum number of frames (of all the clients) waiting to be processed. Further frames are rejected (HTTP"
+    " status 503) until the queue has room again.");
+DEFINE_int32(server_client_queue,       4,
+    "Maximum number of frames in progress per connection (i.e., pipelined without their result yet). Further frames"
+    " are not read from the connection until one of them finishes (TCP backpressure).");
+DEFINE_int32(server_pipeline_depth,     8,
+    "Maximum number of frames inside OpenPose at the same time. It should be at least `--batch_size` x number of"
+    " GPUs, so all the GPUs are busy, but the higher it is, the later the scheduler can react to urgent deadlines.");
+DEFINE_int32(server_deadline_ms,        0,
+    "Default deadline (in milliseconds since the frame is received) of the frames without `X-Deadline-Ms` header."
+    " Frames not started before their deadline are dropped (HTTP status 504). 0 to disable it.");
+DEFINE_int32(server_max_request_mb,     64,
+    "Maximum size of each request body (in megabytes).");
+DEFINE_bool(server_admission,           false,
+    "Admission control. The time each frame would wait before being processed is estimated from its position in the"
+    " queue and the measured service time of OpenPose, and frames that would miss their deadline are rejected (HTTP"
+    " status 503) when they arrive, rather than waiting until their deadline passes. Frames without deadline are"
+    " always admitted.");
+DEFINE_string(server_degraded_resolution, "",
+    "Only if `--server_admission`. Network resolution (e.g., `-1x256`) used while the server is overloaded: frames"
+    " that would miss their deadline at `--net_resolution` but not at this one are admitted, and OpenPose switches to"
+    " it until the queue empties. Empty to only reject them.");
+
+namespace
+{
+    #ifdef _WIN32
+        typedef SOCKET SocketType;
+        const SocketType INVALID_SOCKET_TYPE = INVALID_SOCKET;
+        void closeSocket(const SocketType socketDescriptor)
+        {
+            closesocket(socketDescriptor);
+        }
+    #else
+        typedef int SocketType;
+        const SocketType INVALID_SOCKET_TYPE = -1;
+        void closeSocket(const SocketType socketDescriptor)
+        {
+            close(socketDescriptor);
+        }
+    #endif
+
+    typedef std::chrono::steady_clock Clock;
+
+    // Period (in msec) to check whether the server must stop
+    const auto SERVER_TIMEOUT_MS = 200;
+    // Admission control: minimum time (in msec) at the degraded resolution once it is needed, and weight of each new
+    // service time measurement
+    const auto DEGRADED_MIN_MS = 1000;
+    const auto SERVICE_INTERVAL_EMA = 0.05;
+    // Maximum number of clients with their own stats (the rest are aggregated)
+    const auto MAX_CLIENT_STATS = 1024u;
+
+    std::atomic<bool> sServerRunning{true};
+
+    void stopServer(int)
+    {
+        sServerRunning = false;
+    }
+
+    bool waitForSocket(const SocketType socketDescriptor, const int timeoutMs)
+    {
+        fd_set readSockets;
+        FD_ZERO(&readSockets);
+        FD_SET(socketDescriptor, &readSockets);
+        timeval timeout{timeoutMs / 1000, (timeoutMs % 1000) * 1000};
+        return select((int)socketDescriptor + 1, &readSockets, nullptr, nullptr, &timeout) > 0;
+    }
+
+    bool sendAll(const SocketType socketDescriptor, const std::string& message)
+    {
+        #ifdef MSG_NOSIGNAL
+            // Avoid SIGPIPE if the client closed the connection
+            const auto flags = MSG_NOSIGNAL;
+        #else
+            const auto flags = 0;
+        #endif
+        auto bytesSent = 0ull;
+        while (bytesSent < message.size())
+        {
+            const auto result = send(
+                socketDescriptor, message.data() + bytesSent, (int)(message.size() - bytesSent), flags);
+            if (result <= 0)
+                return false;
+            bytesSent += (unsigned long long)result;
+        }
+        return true;
+    }
+
+    std::string toLower(std::string text)
+    {
+        for (auto& character : text)
+            character = (char)std::tolower((unsigned char)character);
+        return text;
+    }
+
+    // Client ids are user-provided (`X-Client-Id`), so they are limited to a safe set of characters for the stats
+    std::string toClientId(const std::string& text)
+    {
+        auto clientId = text.substr(0, 64);
+        for (auto& character : clientId)
+            if (!std::isalnum((unsigned char)character) && character != '.' && character != ':' && character != '-'
+                && character != '_')
+                character = '_';
+        return clientId;
+    }
+
+    double toMilliseconds(const Clock::duration& duration)
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+}
+
+// Frame received from a client, and its response once it is processed
+struct ServerRequest
+{
+    cv::Mat frame;
+    std::string clientId;
+    Clock::time_point receivedTime;
+    Clock::time_point deadline;
+    Clock::time_point dispatchTime;
+    bool hasDeadline;
+    bool degraded;
+    unsigned long long arrivalIndex;
+
+    ServerRequest() :
+        hasDeadline{false},
+        degraded{false},
+        arrivalIndex{0ull},
+        mFinished{false}
+    {
+    }
+
+    void finish(const std::string& status, const std::string& contentType, const std::string& body)
+    {
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mResponse = "HTTP/1.1 " + status + "\r\n"
+                + "Content-Type: " + contentType + "\r\n"
+                + "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                + "X-Processing-Ms: " + std::to_string(
+                    std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - receivedTime).count())
+                + "\r\n"
+                + (status.find("503") == 0 ? "Retry-After: 1\r\n" : "")
+                + (degraded ? "X-Degraded: 1\r\n" : "")
+                + "\r\n"
+                + body;
+            mFinished = true;
+        }
+        mConditionVariable.notify_all();
+    }
+
+    std::string waitForResponse()
+    {
+        std::unique_lock<std::mutex> lock{mMutex};
+        mConditionVariable.wait(lock, [this]{ return mFinished; });
+        return mResponse;
+    }
+
+private:
+    std::mutex mMutex;
+    std::condition_variable mConditionVariable;
+    bool mFinished;
+    std::string mResponse;
+};
+
+// Each frame carries its request through OpenPose, so the scheduler can match the output with its client
+struct ServerDatum : public op::Datum
+{
+    std::shared_ptr<ServerRequest> spRequest;
+};
+
+typedef op::WrapperT<ServerDatum> ServerWrapper;
+typedef std::shared_ptr<std::vector<std::shared_ptr<ServerDatum>>> ServerDatumsSP;
+
+// Earliest deadline first (frames without deadline go last, in arrival order)
+struct ServerRequestEarlier
+{
+    bool operator()(const std::shared_ptr<ServerRequest>& a, const std::shared_ptr<ServerRequest>& b) const
+    {
+        if (a->hasDeadline != b->hasDeadline)
+            return a->hasDeadline;
+        if (a->hasDeadline && a->deadline != b->deadline)
+            return a->deadline < b->deadline;
+        return a->arrivalIndex < b->arrivalIndex;
+    }
+};
+
+// Counters of each client (see `GET /v1/stats`)
+struct ClientStats
+{
+    unsigned long long admitted = 0ull;
+    unsigned long long completed = 0ull;
+    unsigned long long degraded = 0ull;
+    // Rejected on arrival because their deadline could not be met (`--server_admission`)
+    unsigned long long shed = 0ull;
+    // Rejected on arrival because the queue was full
+    unsigned long long rejectedFull = 0ull;
+    // Dropped because their deadline passed while queued
+    unsigned long long expired = 0ull;
+};
+
+// It feeds the frames of all the clients into the asynchronous ServerWrapper, and returns its results
+class DeadlineScheduler
+{
+public:
+    /**
+     * @param admission Whether to reject the frames whose deadline cannot be met (`--server_admission`).
+     * @param netInputSize Network resolution (`--net_resolution`).
+     * @param degradedNetInputSize Network resolution while overloaded ({0, 0} to never degrade).
+     * @param degradedCostRatio Estimated service time at degradedNetInputSize relative to netInputSize, until it is
+     * measured.
+     */
+    DeadlineScheduler(
+        ServerWrapper& serverWrapper, const unsigned int maxQueueSize, const unsigned int pipelineDepth,
+        const bool admission, const op::Point<int>& netInputSize, const op::Point<int>& degradedNetInputSize,
+        const double degradedCostRatio) :
+        mServerWrapper(serverWrapper),
+        mMaxQueueSize{maxQueueSize},
+        mPipelineDepth{pipelineDepth},
+        mAdmission{admission},
+        mNetInputSize{netInputSize},
+        mDegradedNetInputSize{degradedNetInputSize},
+        mCanDegrade{degradedNetInputSize.x != 0 || degradedNetInputSize.y != 0},
+        mDegradedCostRatio{degradedCostRatio},
+        mNumberInPipeline{0u},
+        mArrivalCounter{0ull},
+        mServiceIntervalMs{0., 0.},
+        mDegraded{false},
+        mDegradedApplied{false},
+        mRunning{true}
+    {
+        mDispatcherThread = std::thread{&DeadlineScheduler::dispatch, this};
+        mCollectorThread = std::thread{&DeadlineScheduler::collect, this};
+    }
+
+    ~DeadlineScheduler()
+    {
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mRunning = false;
+        }
+        mConditionVariable.notify_all();
+        // Stopping the wrapper releases waitAndEmplace and waitAndPop
+        mServerWrapper.stop();
+        mDispatcherThread.join();
+        mCollectorThread.join();
+        // Frames that will never be processed
+        for (auto& request : mQueue)
+            request->finish("503 Service Unavailable", "text/plain", "OpenPose server is stopping.\n");
+        for (auto& request : mInPipeline)
+            request->finish("503 Service Unavailable", "text/plain", "OpenPose server is stopping.\n");
+    }
+
+    // It queues request, or it answers it right away (503) if the queue is full or its deadline cannot be met
+    void push(const std::shared_ptr<ServerRequest>& request)
+    {
+        std::unique_lock<std::mutex> lock{mMutex};
+        auto& clientStats = getClientStats(request->clientId);
+        if (mQueue.size() >= mMaxQueueSize)
+        {
+            clientStats.rejectedFull++;
+            lock.unlock();
+            request->finish("503 Service Unavailable", "text/plain", "OpenPose server queue is full.\n");
+            return;
+        }
+        request->arrivalIndex = mArrivalCounter++;
+        // Admission control: time until it would start, given the frames scheduled before it (earliest deadline
+        // first) and the measured service time
+        if (mAdmission && request->hasDeadline)
+        {
+            const auto now = Clock::now();
+            auto framesAhead = 0u;
+            for (const auto& queuedRequest : mQueue)
+            {
+                if (!ServerRequestEarlier{}(queuedRequest, request))
+                    break;
+                framesAhead++;
+            }
+            const auto budgetMs = toMilliseconds(request->deadline - now);
+            const auto waitMs = estimateWaitMs(framesAhead, mServiceIntervalMs[0]);
+            if (waitMs > budgetMs)
+            {
+                const auto degradedIntervalMs = (mServiceIntervalMs[1] > 0.
+                    ? mServiceIntervalMs[1] : mDegradedCostRatio * mServiceIntervalMs[0]);
+                if (mCanDegrade && estimateWaitMs(framesAhead, degradedIntervalMs) <= budgetMs)
+                {
+                    // It keeps the degraded resolution for a while, so it does not flip on every frame
+                    mDegraded = true;
+                    mDegradedUntil = now + std::chrono::milliseconds{DEGRADED_MIN_MS};
+                }
+                else
+                {
+                    clientStats.shed++;
+                    lock.unlock();
+                    request->finish(
+                        "503 Service Unavailable", "text/plain", "Frame deadline cannot be met (estimated wait of "
+                        + std::to_string((long long)waitMs) + " ms).\n");
+                    return;
+                }
+            }
+        }
+        clientStats.admitted++;
+        mQueue.emplace(request);
+        lock.unlock();
+        mConditionVariable.notify_all();
+    }
+
+    // JSON with the scheduler state and the counters of each client
+    std::string getStats()
+    {
+        const std::lock_guard<std::mutex> lock{mMutex};
+        std::string stats = "{\"queue\": " + std::to_string(mQueue.size())
+            + ", \"pipeline\": " + std::to_string(mNumberInPipeline)
+            + ", \"degraded\": " + (mDegraded ? "true" : "false")
+            + ", \"service_interval_ms\": " + std::to_string(mServiceIntervalMs[0])
+            + ", \"degraded_service_interval_ms\": " + std::to_string(mServiceIntervalMs[1])
+            + ", \"clients\": {";
+        auto first = true;
+        for (const auto& clientStats : mClientStats)
+        {
+            stats += std::string{first ? "" : ", "} + "\"" + clientStats.first + "\": {"
+                + "\"admitted\": " + std::to_string(clientStats.second.admitted)
+                + ", \"completed\": " + std::to_string(clientStats.second.completed)
+                + ", \"degraded\": " + std::to_string(clientStats.second.degraded)
+                + ", \"shed\": " + std::to_string(clientStats.second.shed)
+                + ", \"rejected_full\": " + std::to_string(clientStats.second.rejectedFull)
+                + ", \"expired\": " + std::to_string(clientStats.second.expired) + "}";
+            first = false;
+        }
+        return stats + "}}\n";
+    }
+
+private:
+    ServerWrapper& mServerWrapper;
+    const unsigned int mMaxQueueSize;
+    const unsigned int mPipelineDepth;
+    const bool mAdmission;
+    const op::Point<int> mNetInputSize;
+    const op::Point<int> mDegradedNetInputSize;
+    const bool mCanDegrade;
+    const double mDegradedCostRatio;
+    std::mutex mMutex;
+    std::condition_variable mConditionVariable;
+    std::set<std::shared_ptr<ServerRequest>, ServerRequestEarlier> mQueue;
+    std::list<std::shared_ptr<ServerRequest>> mInPipeline;
+    unsigned int mNumberInPipeline;
+    unsigned long long mArrivalCounter;
+    // Service interval (moving average time between 2 frames finishing) at full ([0]) and degraded ([1]) resolution
+    double mServiceIntervalMs[2];
+    Clock::time_point mLastFinished;
+    bool mDegraded;
+    Clock::time_point mDegradedUntil;
+    // Only accessed by the dispatcher thread
+    bool mDegradedApplied;
+    std::map<std::string, ClientStats> mClientStats;
+    bool mRunning;
+    std::thread mDispatcherThread;
+    std::thread mCollectorThread;
+
+    // It requires mMutex to be locked
+    ClientStats& getClientStats(const std::string& clientId)
+    {
+        auto clientStats = mClientStats.find(clientId);
+        if (clientStats != mClientStats.end())
+            return clientStats->second;
+        return mClientStats[mClientStats.size() < MAX_CLIENT_STATS ? clientId : "(other)"];
+    }
+
+    // Time (in msec) until a frame with framesAhead frames scheduled before it enters OpenPose. It requires mMutex
+    // to be locked
+    double estimateWaitMs(const unsigned int framesAhead, const double serviceIntervalMs) const
+    {
+        const auto freeSlots = mPipelineDepth - std::min(mNumberInPipeline, mPipelineDepth);
+        return (framesAhead < freeSlots ? 0. : (framesAhead - freeSlots + 1u) * serviceIntervalMs);
+    }
+
+    void dispatch()
+    {
+        try
+        {
+            while (true)
+            {
+                // Most urgent frame, once OpenPose has room for it. The frames are kept in mQueue until then, so
+                // a more urgent frame received meanwhile overtakes them
+                std::shared_ptr<ServerRequest> request;
+                auto degraded = false;
+                {
+                    std::unique_lock<std::mutex> lock{mMutex};
+                    mConditionVariable.wait(lock, [this]{
+                        return !mRunning || (!mQueue.empty() && mNumberInPipeline < mPipelineDepth); });
+                    if (!mRunning)
+                        break;
+                    request = *mQueue.begin();
+                    mQueue.erase(mQueue.begin());
+                    const auto now = Clock::now();
+                    if (request->hasDeadline && request->deadline < now)
+                    {
+                        getClientStats(request->clientId).expired++;
+                        lock.unlock();
+                        request->finish("504 Gateway Timeout", "text/plain", "Frame deadline exceeded.\n");
+                        continue;
+                    }
+                    // Back to the full resolution once the overload is over
+                    if (mDegraded && mQueue.empty() && mDegradedUntil < now)
+                        mDegraded = false;
+                    degraded = mDegraded;
+                    request->degraded = degraded;
+                    request->dispatchTime = now;
+                    mNumberInPipeline++;
+                    mInPipeline.emplace_back(request);
+                }
+                // Network resolution switch (applied between 2 frames, without reloading the network)
+                if (degraded != mDegradedApplied)
+                {
+                    mServerWrapper.reconfigure(op::WrapperStructRuntime{
+                        degraded ? mDegradedNetInputSize : mNetInputSize});
+                    mDegradedApplied = degraded;
+                }
+                // Push it into OpenPose
+                auto datumsPtr = std::make_shared<std::vector<std::shared_ptr<ServerDatum>>>();
+                datumsPtr->emplace_back(std::make_shared<ServerDatum>());
+                auto& datumPtr = datumsPtr->at(0);
+                datumPtr->spRequest = request;
+                datumPtr->cvInputData = OP_CV2OPCONSTMAT(request->frame);
+                if (!mServerWrapper.waitAndEmplace(datumsPtr))
+                    break;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void collect()
+    {
+        try
+        {
+            std::vector<char> packet;
+            ServerDatumsSP datumsPtr;
+            while (mServerWrapper.waitAndPop(datumsPtr))
+            {
+                for (const auto& datumPtr : *datumsPtr)
+                {
+                    auto request = datumPtr->spRequest;
+                    op::datumToKeypointPacket(packet, *datumPtr);
+                    {
+                        const std::lock_guard<std::mutex> lock{mMutex};
+                        mNumberInPipeline--;
+                        mInPipeline.remove(request);
+                        // Service interval: time since the previous frame finished (while OpenPose is busy), or
+                        // since this one entered OpenPose (if it was idle)
+                        const auto now = Clock::now();
+                        const auto intervalMs = toMilliseconds(now - std::max(mLastFinished, request->dispatchTime));
+                        auto& serviceIntervalMs = mServiceIntervalMs[request->degraded ? 1 : 0];
+                        serviceIntervalMs = (serviceIntervalMs > 0.
+                            ? (1. - SERVICE_INTERVAL_EMA) * serviceIntervalMs + SERVICE_INTERVAL_EMA * intervalMs
+                            : intervalMs);
+                        mLastFinished = now;
+                        auto& clientStats = getClientStats(request->clientId);
+                        clientStats.completed++;
+                        if (request->degraded)
+                            clientStats.degraded++;
+                    }
+                    mConditionVariable.notify_all();
+                    request->finish("200 OK", "application/x-openpose-keypoints",
+                                    std::string{packet.begin(), packet.end()});
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+};
+
+// 1 HTTP/1.1 client connection. It reads (and schedules) the requests on its own thread, while another one sends
+// their responses back in order
+class ServerConnection
+{
+public:
+    ServerConnection(const SocketType clientSocket, const std::string& clientAddress,
+                     DeadlineScheduler& deadlineScheduler) :
+        mClientSocket{clientSocket},
+        mClientAddress{clientAddress},
+        mDeadlineScheduler(deadlineScheduler),
+        mReading{true},
+        mFinished{false}
+    {
+        mReaderThread = std::thread{&ServerConnection::read, this};
+        mWriterThread = std::thread{&ServerConnection::write, this};
+    }
+
+    ~ServerConnection()
+    {
+        stopReading();
+        mWriterThread.join();
+        closeSocket(mClientSocket);
+    }
+
+    // It blocks until the reader thread finishes (i.e., until no more requests are scheduled)
+    void stopReading()
+    {
+        if (mReaderThread.joinable())
+            mReaderThread.join();
+    }
+
+    bool isFinished() const
+    {
+        return mFinished;
+    }
+
+private:
+    const SocketType mClientSocket;
+    // Default client id of its requests (if no `X-Client-Id` header)
+    const std::string mClientAddress;
+    DeadlineScheduler& mDeadlineScheduler;
+    std::string mBuffer;
+    std::mutex mMutex;
+    std::condition_variable mConditionVariable;
+    std::deque<std::shared_ptr<ServerRequest>> mPending;
+    bool mReading;
+    std::atomic<bool> mFinished;
+    std::thread mReaderThread;
+    std::thread mWriterThread;
+
+    // It appends data from the socket into mBuffer until it has at least minimumSize bytes
+    bool receive(const unsigned long long minimumSize)
+    {
+        char buffer[65536];
+        while (mBuffer.size() < minimumSize)
+        {
+            if (!sServerRunning)
+                return false;
+            if (!waitForSocket(mClientSocket, SERVER_TIMEOUT_MS))
+                continue;
+            const auto bytesReceived = recv(mClientSocket, buffer, (int)sizeof(buffer), 0);
+            if (bytesReceived <= 0)
+                return false;
+            mBuffer.append(buffer, (size_t)bytesReceived);
+        }
+        return true;
+    }
+
+    void addResponse(const std::shared_ptr<ServerRequest>& request)
+    {
+        std::unique_lock<std::mutex> lock{mMutex};
+        // Per-client backpressure: it stops reading the socket until the client has room again
+        while (mPending.size() >= (size_t)FLAGS_server_client_queue && sServerRunning)
+            mConditionVariable.wait_for(lock, std::chrono::milliseconds{SERVER_TIMEOUT_MS});
+        mPending.emplace_back(request);
+        lock.unlock();
+        mConditionVariable.notify_all();
+    }
+
+    void addResponse(const std::string& status, const std::string& contentType, const std::string& body)
+    {
+        auto request = std::make_shared<ServerRequest>();
+        request->receivedTime = Clock::now();
+        request->finish(status, contentType, body);
+        addResponse(request);
+    }
+
+    void addError(const std::string& status, const std::string& message)
+    {
+        addResponse(status, "text/plain", message + "\n");
+    }
+
+    // It returns false if the connection must be closed
+    bool readRequest()
+    {
+        // Request line and headers
+        auto headersEnd = std::string::npos;
+        while ((headersEnd = mBuffer.find("\r\n\r\n")) == std::string::npos)
+        {
+            if (mBuffer.size() > 65536u)
+            {
+                addError("431 Request Header Fields Too Large", "Too large headers.");
+                return false;
+            }
+            if (!receive(mBuffer.size() + 1u))
+                return false;
+        }
+        const auto receivedTime = Clock::now();
+        const auto headers = mBuffer.substr(0, headersEnd);
+        mBuffer.erase(0, headersEnd + 4u);
+        const auto requestLine = headers.substr(0, headers.find("\r\n"));
+        const auto methodEnd = requestLine.find(' ');
+        const auto pathEnd = requestLine.find(' ', methodEnd + 1);
+        const auto method = requestLine.substr(0, methodEnd);
+        const auto path = (methodEnd == std::string::npos
+            ? "" : requestLine.substr(methodEnd + 1, pathEnd - methodEnd - 1));
+        auto contentLength = 0ull;
+        auto contentType = std::string{};
+        auto clientId = mClientAddress;
+        auto deadlineMs = (long long)FLAGS_server_deadline_ms;
+        auto width = 0;
+        auto height = 0;
+        auto keepAlive = (requestLine.find("HTTP/1.0") == std::string::npos);
+        auto lineStart = headers.find("\r\n");
+        while (lineStart != std::string::npos)
+        {
+            lineStart += 2u;
+            const auto lineEnd = headers.find("\r\n", lineStart);
+            const auto line = headers.substr(lineStart, lineEnd - lineStart);
+            lineStart = lineEnd;
+            const auto colon = line.find(':');
+            if (colon == std::string::npos)
+                continue;
+            const auto name = toLower(line.substr(0, colon));
+            const auto valueStart = line.find_first_not_of(' ', colon + 1);
+            const auto value = (valueStart == std::string::npos ? "" : line.substr(valueStart));
+            try
+            {
+                if (name == "content-length")
+                    contentLength = std::stoull(value);
+                else if (name == "content-type")
+                    contentType = toLower(value);
+                else if (name == "x-client-id")
+                    clientId = toClientId(value);
+                else if (name == "x-deadline-ms")
+                    deadlineMs = std::stoll(value);
+                else if (name == "x-frame-width")
+                    width = std::stoi(value);
+                else if (name == "x-frame-height")
+                    height = std::stoi(value);
+                else if (name == "connection")
+                    keepAlive = (toLower(value) != "close");
+            }
+            catch (const std::exception&)
+            {
+                addError("400 Bad Request", "Invalid `" + line.substr(0, colon) + "` header.");
+                return false;
+            }
+        }
+        // Body
+        if (contentLength > (unsigned long long)FLAGS_server_max_request_mb * 1024ull * 1024ull)
+        {
+            addError("413 Payload Too Large", "The frame exceeds `--server_max_request_mb`.");
+            return false;
+        }
+        if (!receive(contentLength))
+            return false;
+        const auto body = mBuffer.substr(0, contentLength);
+        mBuffer.erase(0, contentLength);
+        // Routing
+        if (path == "/health")
+            addError("200 OK", "OK");
+        else if (path == "/v1/stats")
+            addResponse("200 OK", "application/json", mDeadlineScheduler.getStats());
+        else if (path != "/v1/pose")
+            addError("404 Not Found", "Frames must be sent to `POST /v1/pose`.");
+        else if (method != "POST")
+            addError("405 Method Not Allowed", "Frames must be sent to `POST /v1/pose`.");
+        else
+        {
+            auto request = std::make_shared<ServerRequest>();
+            request->clientId = clientId;
+            request->receivedTime = receivedTime;
+            request->hasDeadline = (deadlineMs > 0);
+            request->deadline = receivedTime + std::chrono::milliseconds{deadlineMs};
+            // Raw BGR pixels (no decoding)
+            if (contentType == "application/x-raw-bgr")
+            {
+                if (width <= 0 || height <= 0 || (unsigned long long)width * height * 3u != body.size())
+                {
+                    addError("400 Bad Request", "Raw BGR frames require `X-Frame-Width` and `X-Frame-Height`"
+                             " headers, and exactly width x height x 3 bytes.");
+                    return keepAlive;
+                }
+                request->frame = cv::Mat(height, width, CV_8UC3);
+                std::memcpy(request->frame.data, body.data(), body.size());
+            }
+            // Encoded image (JPEG, PNG, etc.)
+            else
+            {
+                const cv::Mat encodedFrame(1, (int)body.size(), CV_8UC1, (void*)body.data());
+                request->frame = cv::imdecode(encodedFrame, cv::IMREAD_COLOR);
+                if (request->frame.empty())
+                {
+                    addError("400 Bad Request", "The frame could not be decoded.");
+                    return keepAlive;
+                }
+            }
+            mDeadlineScheduler.push(request);
+            addResponse(request);
+        }
+        return keepAlive;
+    }
+
+    void read()
+    {
+        try
+        {
+            while (sServerRunning && readRequest())
+            {
+            }
+        }
+        catch (const std::exception& e)
+        {
+            op::opLog("Client connection error: " + std::string{e.what()}, op::Priority::High);
+        }
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mReading = false;
+        }
+        mConditionVariable.notify_all();
+    }
+
+    void write()
+    {
+        auto connected = true;
+        while (true)
+        {
+            std::shared_ptr<ServerRequest> request;
+            {
+                std::unique_lock<std::mutex> lock{mMutex};
+                mConditionVariable.wait(lock, [this]{ return !mPending.empty() || !mReading; });
+                if (mPending.empty())
+                    break;
+                request = mPending.front();
+            }
+            // Responses in the same order than their requests
+            const auto response = request->waitForResponse();
+            // If the client disconnected, the remaining responses are just discarded
+            connected = connected && sendAll(mClientSocket, response);
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                mPending.pop_front();
+            }
+            mConditionVariable.notify_all();
+        }
+        mFinished = true;
+    }
+};
+
+void configureWrapper(ServerWrapper& serverWrapper)
+{
+    try
+    {
+        // Configuring OpenPose
+
+        // logging_level
+        op::checkBool(
+            0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+            __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+        op::ConfigureLog::setAsynchronous(FLAGS_logging_async);
+        op::Profiler::setDefaultX(FLAGS_profile_speed);
+
+        // Applying user defined configuration - GFlags to program variables
+        // outputSize
+        const auto outputSize = op::flagsToPoint(op::String(FLAGS_output_resolution), "-1x-1");
+        // netInputSize
+        const auto netInputSize = op::flagsToPoint(op::String(FLAGS_net_resolution), "-1x368");
+        const auto netInputSizeMin = op::flagsToPoint(op::String(FLAGS_net_resolution_min), "-1x256");
+        // poseMode
+        const auto poseMode = op::flagsToPoseMode(FLAGS_body);
+        // poseModel
+        const auto poseModel = op::flagsToPoseModel(op::String(FLAGS_model_pose));
+        // keypointScaleMode
+        const auto keypointScaleMode = op::flagsToScaleMode(FLAGS_keypoint_scale);
+        // heatmaps to add
+        const auto heatMapTypes = op::flagsToHeatMaps(FLAGS_heatmaps_add_parts, FLAGS_heatmaps_add_bkg,
+                                                      FLAGS_heatmaps_add_PAFs);
+        const auto heatMapScaleMode = op::flagsToHeatMapScaleMode(FLAGS_heatmaps_scale);
+        // Enabling Google Logging
+        const bool enableGoogleLogging = true;
+
+        // Pose configuration (use WrapperStructPose{} for default and recommended configuration). Rendering is
+        // disabled, only the keypoints are returned
+        const op::WrapperStructPose wrapperStructPose{
+            poseMode, netInputSize, FLAGS_net_resolution_dynamic, outputSize, keypointScaleMode, FLAGS_num_gpu,
+            FLAGS_num_gpu_start, FLAGS_scale_number, (float)FLAGS_scale_gap, op::RenderMode::None, poseModel,
+            !FLAGS_disable_blending, (float)FLAGS_alpha_pose, (float)FLAGS_alpha_heatmap, FLAGS_part_to_show,
+            op::String(FLAGS_model_folder), heatMapTypes, heatMapScaleMode, FLAGS_part_candidates,
+            (float)FLAGS_render_threshold, FLAGS_number_people_max, FLAGS_maximize_positives, FLAGS_fps_max,
+            op::String(FLAGS_prototxt_path), op::String(FLAGS_caffemodel_path), (float)FLAGS_upsampling_ratio,
+            enableGoogleLogging, FLAGS_batch_size, FLAGS_batch_max_wait, FLAGS_tensorrt_precision,
+            FLAGS_heatmaps_fp16, FLAGS_latency_target, netInputSizeMin, FLAGS_roi_tracking_interval,
+            FLAGS_scale_batch, FLAGS_motion_gate, FLAGS_motion_gate_pixel_threshold, FLAGS_motion_gate_max_skip,
+            FLAGS_cuda_graphs, FLAGS_pose_pipelined, FLAGS_paf_low_resolution, FLAGS_heatmaps_lazy};
+        serverWrapper.configure(wrapperStructPose);
+        // Extra functionality configuration (use op::WrapperStructExtra{} to disable it)
+        const auto gpuThreadPriority = op::flagsToThreadPriority(FLAGS_gpu_thread_priority);
+        const op::WrapperStructExtra wrapperStructExtra{
+            false, -1, false, FLAGS_tracking, FLAGS_ik_threads, FLAGS_thread_pool, FLAGS_gpu_numa_affinity,
+            gpuThreadPriority, FLAGS_cpu_worker_threads, FLAGS_gpu_dispatch, FLAGS_reorder_window_ms,
+            FLAGS_tracking_extrapolation};
+        serverWrapper.configure(wrapperStructExtra);
+        // Output (only the verbose and metrics ones make sense for a server)
+        op::WrapperStructOutput wrapperStructOutput;
+        wrapperStructOutput.verbose = FLAGS_cli_verbose;
+        wrapperStructOutput.metricsPort = FLAGS_metrics_port;
+        wrapperStructOutput.allocationMetrics = FLAGS_allocation_metrics;
+        wrapperStructOutput.traceFile = op::String(FLAGS_trace_file);
+        serverWrapper.configure(wrapperStructOutput);
+        // No GUI. Equivalent to: serverWrapper.configure(op::WrapperStructGui{});
+        // Set to single-thread (for sequential processing and/or debugging and/or reducing latency)
+        if (FLAGS_disable_multi_thread)
+            serverWrapper.disableMultiThreading();
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+int openPoseServer()
+{
+    try
+    {
+        op::opLog("Starting OpenPose server...", op::Priority::High);
+        const auto opTimer = op::getTimerInit();
+
+        // Sanity checks
+        if (FLAGS_server_queue_size < 1 || FLAGS_server_client_queue < 1 || FLAGS_server_pipeline_depth < 1)
+            op::error("`--server_queue_size`, `--server_client_queue` and `--server_pipeline_depth` must be"
+                      " positive.", __LINE__, __FUNCTION__, __FILE__);
+        // Admission control
+        const auto netInputSize = op::flagsToPoint(op::String(FLAGS_net_resolution), "-1x368");
+        const auto degradedNetInputSize = (FLAGS_server_degraded_resolution.empty()
+            ? op::Point<int>{0, 0} : op::flagsToPoint(op::String(FLAGS_server_degraded_resolution), "-1x256"));
+        auto degradedCostRatio = 1.;
+        if (!FLAGS_server_degraded_resolution.empty())
+        {
+            if (!FLAGS_server_admission)
+                op::error("`--server_degraded_resolution` requires `--server_admission`.",
+                          __LINE__, __FUNCTION__, __FILE__);
+            if (FLAGS_latency_target > 0. || FLAGS_net_resolution_dynamic != 1.)
+                op::error("`--server_degraded_resolution` is not compatible with `--latency_target` nor"
+                          " `--net_resolution_dynamic`.", __LINE__, __FUNCTION__, __FILE__);
+            if ((degradedNetInputSize.x > 0) != (netInputSize.x > 0)
+                || (degradedNetInputSize.y > 0) != (netInputSize.y > 0))
+                op::error("`--server_degraded_resolution` and `--net_resolution` must have their `-1` in the same"
+                          " dimension.", __LINE__, __FUNCTION__, __FILE__);
+            // Initial guess until the service time at the degraded resolution is measured: proportional to the
+            // network area (the unknown dimension scales like the known one)
+            degradedCostRatio = (degradedNetInputSize.x > 0 && degradedNetInputSize.y > 0
+                ? degradedNetInputSize.area() / (double)netInputSize.area()
+                : std::pow(std::max(degradedNetInputSize.x, degradedNetInputSize.y)
+                           / (double)std::max(netInputSize.x, netInputSize.y), 2));
+        }
+
+        // Configuring OpenPose
+        op::opLog("Configuring OpenPose...", op::Priority::High);
+        ServerWrapper serverWrapper{op::ThreadManagerMode::Asynchronous};
+        configureWrapper(serverWrapper);
+
+        // Start processing
+        op::opLog("Starting thread(s)...", op::Priority::High);
+        serverWrapper.start();
+
+        // Bind and listen
+        #ifdef _WIN32
+            WSADATA wsaData;
+            if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+                op::error("WSAStartup failed.", __LINE__, __FUNCTION__, __FILE__);
+        #else
+            std::signal(SIGPIPE, SIG_IGN);
+        #endif
+        std::signal(SIGINT, stopServer);
+        std::signal(SIGTERM, stopServer);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons((unsigned short)FLAGS_server_port);
+        if (inet_pton(AF_INET, FLAGS_server_host.c_str(), &address.sin_addr) != 1)
+            op::error("Invalid server host IP address (`" + FLAGS_server_host + "`).", __LINE__, __FUNCTION__,
+                      __FILE__);
+        const auto listenSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (listenSocket == INVALID_SOCKET_TYPE)
+            op::error("Server socket could not be created.", __LINE__, __FUNCTION__, __FILE__);
+        const int reuseAddress = 1;
+        setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, (const char*)&reuseAddress, (int)sizeof(reuseAddress));
+        if (bind(listenSocket, (const sockaddr*)&address, (int)sizeof(address)) != 0
+            || listen(listenSocket, 64) != 0)
+        {
+            closeSocket(listenSocket);
+            op::error("Server could not listen on " + FLAGS_server_host + ":" + std::to_string(FLAGS_server_port)
+                      + " (is the port already in use?).", __LINE__, __FUNCTION__, __FILE__);
+        }
+        op::opLog("OpenPose server listening on http://" + FLAGS_server_host + ":"
+                  + std::to_string(FLAGS_server_port) + "/v1/pose (Ctrl+C to stop it)", op::Priority::High);
+
+        // Serve until Ctrl+C (or SIGTERM)
+        {
+            std::unique_ptr<DeadlineScheduler> upDeadlineScheduler{new DeadlineScheduler{
+                serverWrapper, (unsigned int)FLAGS_server_queue_size, (unsigned int)FLAGS_server_pipeline_depth,
+                FLAGS_server_admission, netInputSize, degradedNetInputSize, degradedCostRatio}};
+            std::list<std::unique_ptr<ServerConnection>> connections;
+            while (sServerRunning && serverWrapper.isRunning())
+            {
+                if (waitForSocket(listenSocket, SERVER_TIMEOUT_MS))
+                {
+                    sockaddr_in clientAddress{};
+                    socklen_t clientAddressSize = (socklen_t)sizeof(clientAddress);
+                    const auto clientSocket = accept(listenSocket, (sockaddr*)&clientAddress, &clientAddressSize);
+                    if (clientSocket != INVALID_SOCKET_TYPE)
+                    {
+                        const int noDelay = 1;
+                        setsockopt(clientSocket, IPPROTO_TCP, TCP_NODELAY, (const char*)&noDelay,
+                                   (int)sizeof(noDelay));
+                        char clientIp[INET_ADDRSTRLEN] = "";
+                        inet_ntop(AF_INET, &clientAddress.sin_addr, clientIp, (socklen_t)sizeof(clientIp));
+                        connections.emplace_back(
+                            new ServerConnection{clientSocket, std::string{clientIp}, *upDeadlineScheduler});
+                    }
+                }
+                // Release the closed connections
+                connections.remove_if([](const std::unique_ptr<ServerConnection>& connection)
+                                      { return connection->isFinished(); });
+            }
+            sServerRunning = false;
+            op::opLog("Stopping thread(s)", op::Priority::High);
+            // No more requests are scheduled, then the scheduler (and OpenPose) are stopped, which gives a response
+            // to all the pending requests, and finally their connections send them and close
+            for (auto& connection : connections)
+                connection->stopReading();
+            upDeadlineScheduler.reset();
+            connections.clear();
+        }
+        closeSocket(listenSocket);
+        #ifdef _WIN32
+            WSACleanup();
+        #endif
+
+        // Measuring total time
+        op::printTime(opTimer, "OpenPose server successfully finished. Total time: ", " seconds.", op::Priority::High);
+
+        // Return
+        return 0;
+    }
+    catch (const std::exception&)
+    {
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running openPoseServer
+    return openPoseServer();
+}
@@ -200,7 +200,13 @@ namespace op
             if (wrapperStructHand.enable)
             {
                 spWPoses.resize(gpuNumber);
-                const auto handDetector = std::make_shared<HandDetectorFromTxt>(handGroundTruth);
+                // A KeypointBinarySaver file (memory-mapped and prefetched), or a directory of txt files
+                const auto fromBinary = !existDirectory(handGroundTruth);
+                const auto handDetectorFromBinary = (fromBinary
+                    ? std::make_shared<HandDetectorFromBinary>(handGroundTruth, wrapperStructPose.poseModel)
+                    : nullptr);
+                const auto handDetector = (fromBinary
+                    ? nullptr : std::make_shared<HandDetectorFromTxt>(handGroundTruth));
                 for (auto gpuId = 0u; gpuId < spWPoses.size(); gpuId++)
                 {
                     // Hand detector
@@ -208,6 +214,9 @@ namespace op
                     if (wrapperStructHand.detector == Detector::BodyWithTracking)
                         error("Tracking not valid for hand detector from JSON files.", __LINE__, __FUNCTION__, __FILE__);
                     // If detection
+                    else if (fromBinary)
+                        spWPoses.at(gpuId) = {
+                            std::make_shared<WHandDetectorFromBinary<TDatumsPtr>>(handDetectorFromBinary)};
                     else
                         spWPoses.at(gpuId) = {std::make_shared<WHandDetectorFromTxt<TDatumsPtr>>(handDetector)};
                     // Hand keypoint extractor
@@ -190,10 +190,8 @@ int tutorialApiCpp()
         const auto imagePaths = op::getFilesOnDirectory(FLAGS_image_dir, op::Extensions::Images);
 
         // Process and display images
-        // Option a) Harder to implement but the fastest method
-        // Create 2 different threads:
-        //     1. One pushing images to OpenPose all the time.
-        //     2. A second one retrieving those frames.
+        // Option a) The fastest method: opWrapper.emplaceBatch(), which pushes the images to OpenPose all the time
+        // (so all the GPUs are always busy) and returns 1 std::future per image (see doc/04_cpp_api.md).
         // Option b) Much easier and faster to implement but slightly slower runtime performance
         if (!FLAGS_latency_is_irrelevant_and_computer_with_lots_of_ram)
         {
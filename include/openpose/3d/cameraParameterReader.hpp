@@ -44,12 +44,30 @@ namespace op
 
         const std::vector<Matrix>& getCameraExtrinsicsInitial() const;
 
+        /**
+         * Static region of interest of each camera (see Datum::inputRoi), read from the optional `InputRoi` node
+         * (#points x 2 (x,y) matrix) of its XML file. Empty for the cameras without it.
+         */
+        const std::vector<std::vector<Point<int>>>& getInputRois() const;
+
         bool getUndistortImage() const;
 
         void setUndistortImage(const bool undistortImage);
 
+        /**
+         * It undistorts frame with cv::remap. The remap tables of each camera are computed (with
+         * cv::initUndistortRectifyMap) only for its first frame, or if its resolution changes.
+         */
         void undistort(Matrix& frame, const unsigned int cameraIndex = 0u);
 
+        /**
+         * GPU analog of the undistort() remap tables: width x height interleaved (x, y) float source coordinates of
+         * each undistorted pixel, in the GPU memory of gpuId (see FrameGpu::undistortMapPtr). As in undistort(), it
+         * is computed and uploaded only once per camera (and resolution). It is thread-safe.
+         */
+        std::shared_ptr<float> getUndistortMapGpu(
+            const unsigned int cameraIndex, const int width, const int height, const int gpuId);
+
     private:
         // PIMPL idiom
         // http://www.cppsamples.com/common-tasks/pimpl.html
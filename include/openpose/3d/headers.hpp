@@ -4,6 +4,7 @@
 // 3d module
 #include <openpose/3d/cameraParameterReader.hpp>
 #include <openpose/3d/jointAngleEstimation.hpp>
+#include <openpose/3d/poseAssociation.hpp>
 #include <openpose/3d/poseTriangulation.hpp>
 #include <openpose/3d/wJointAngleEstimation.hpp>
 #include <openpose/3d/wPoseTriangulation.hpp>
@@ -25,6 +25,12 @@ namespace op
 
         void initializationOnThread();
 
+        /**
+         * Fits the Adam model to the first person of poseKeypoints3D. The first frame (or after the person is lost)
+         * runs the full multi-stage Adam_FastFit_Initialize, while the following ones run the single-stage
+         * Adam_FastFit warm-started from the latest fitted frame of any JointAngleEstimation (i.e., shared by all
+         * the `ik_threads`).
+         */
         void adamFastFit(Eigen::Matrix<double, 62, 3, Eigen::RowMajor>& adamPose,
                          Eigen::Vector3d& adamTranslation,
                          Eigen::Matrix<double, Eigen::Dynamic, 1>& vtVec,
@@ -0,0 +1,54 @@
+#ifndef OPENPOSE_3D_POSE_ASSOCIATION_HPP
+#define OPENPOSE_3D_POSE_ASSOCIATION_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * It returns the fundamental matrix (3x3, CV_64F) between 2 views given their camera (projection) matrices (e.g.,
+     * the ones of CameraParameterReader::getCameraMatrices()), such that x1^T * F * x0 = 0 for the pixel coordinates
+     * x0 and x1 of the same 3-D point on each view.
+     */
+    OP_API Matrix getFundamentalMatrix(const Matrix& cameraMatrix0, const Matrix& cameraMatrix1);
+
+    /**
+     * PoseAssociation finds which person of each view is the same 3-D person, so PoseTriangulation can reconstruct
+     * all of them rather than assuming that the person i of each view is the same one:
+     * 1. The distance of each pair of people of each pair of views is the average symmetric epipolar distance of
+     *    their body keypoints visible on both (given the fundamental matrix of both views). The pairs of views are
+     *    computed in parallel.
+     * 2. The people are clustered greedily, from the closest pair to the furthest one below the maximum distance.
+     *    2 clusters are merged if they do not have any view in common (i.e., each 3-D person has at most 1 person
+     *    per view) and the average distance between their people is below the maximum distance.
+     * E.g., 8 views with 10 people each are 28 pairs of views of 100 pairs of people each.
+     */
+    class OP_API PoseAssociation
+    {
+    public:
+        /**
+         * @param maxEpipolarDistance Maximum average epipolar distance (in pixels) of 2 people of different views to
+         * be the same one. If <= 0, 25 pixels for 1280x1024 images (as the maximum reprojection error of
+         * PoseTriangulation), proportional for other resolutions.
+         * @param minCommonParts Minimum number of body keypoints that 2 people must have visible to be compared.
+         */
+        explicit PoseAssociation(const double maxEpipolarDistance = -1., const int minCommonParts = 3);
+
+        virtual ~PoseAssociation();
+
+        /**
+         * It returns the 3-D people found on poseKeypointsVector (the 2-D body keypoints of each view). Each one is
+         * the index of its person on each view (-1 if it is not visible on that view), and it is visible on at least
+         * 2 views. They are sorted by number of views (the most visible ones first).
+         */
+        std::vector<std::vector<int>> associate(
+            const std::vector<Array<float>>& poseKeypointsVector, const std::vector<Matrix>& cameraMatrices,
+            const std::vector<Point<int>>& imageSizes) const;
+
+    private:
+        const double mMaxEpipolarDistance;
+        const int mMinCommonParts;
+    };
+}
+
+#endif // OPENPOSE_3D_POSE_ASSOCIATION_HPP
@@ -5,25 +5,56 @@
 
 namespace op
 {
+    class PoseAssociation;
+
     class OP_API PoseTriangulation
     {
     public:
-        PoseTriangulation(const int minViews3d);
+        /**
+         * @param multiPerson If false, the person i of each view is assumed to be the same one, and only the first
+         * one is reconstructed. If true, the people of the views are associated with PoseAssociation (from their body
+         * keypoints), and all the ones visible on at least 2 views are reconstructed.
+         * @param temporal If true, each keypoint reconstructed on a recent frame (see frameId in reconstructArray())
+         * is initialized from it and refined with a single Gauss-Newton step, and it is only triangulated from scratch
+         * (DLT and view rejection) if its reprojection error jumps. Each 3-D person is matched with the previous frame
+         * by the poseIds of the first view that sees it (or it is the only person if not multiPerson).
+         */
+        PoseTriangulation(const int minViews3d, const bool multiPerson = false, const bool temporal = false);
 
         virtual ~PoseTriangulation();
 
         void initializationOnThread();
 
+        /**
+         * It triangulates the 2-D keypoints of each view (keypointsVector) into 3-D.
+         * If cameraDistortions is not empty, the 2-D keypoints of each view with a non-empty distortion are
+         * undistorted first (with cv::undistortPoints and its cameraIntrinsics), so the frames themselves do not need
+         * to be undistorted (see Datum::cameraDistortion). The input keypoints are not modified.
+         * The output has 1 person per 3-D person (see the constructor), sorted as PoseAssociation::associate().
+         */
         Array<float> reconstructArray(
             const std::vector<Array<float>>& keypointsVector, const std::vector<Matrix>& cameraMatrices,
-            const std::vector<Point<int>>& imageSizes) const;
-
+            const std::vector<Point<int>>& imageSizes, const std::vector<Matrix>& cameraIntrinsics = {},
+            const std::vector<Matrix>& cameraDistortions = {}) const;
+
+        /**
+         * Analogous to the previous one, for several elements (e.g., body, face and hands) of the same people.
+         * @param poseIds Only used if temporal and multiPerson: Datum::poseIds of each view.
+         * @param frameId Only used if temporal: Frame id (e.g., Datum::id), so only the reconstruction of a recent
+         * frame is used as initial estimate (e.g., if frames are lost or reconstructed by several threads).
+         */
         std::vector<Array<float>> reconstructArray(
             const std::vector<std::vector<Array<float>>>& keypointsVector, const std::vector<Matrix>& cameraMatrices,
-            const std::vector<Point<int>>& imageSizes) const;
+            const std::vector<Point<int>>& imageSizes, const std::vector<Matrix>& cameraIntrinsics = {},
+            const std::vector<Matrix>& cameraDistortions = {}, const std::vector<Array<long long>>& poseIds = {},
+            const unsigned long long frameId = 0ull) const;
 
     private:
+        struct TemporalState;
+
         const int mMinViews3d;
+        const std::shared_ptr<PoseAssociation> spPoseAssociation;
+        const std::shared_ptr<TemporalState> spTemporalState;
     };
 }
 
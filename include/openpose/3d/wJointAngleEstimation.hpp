@@ -69,7 +69,8 @@ namespace op
                 // Debugging log
                 opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
-                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
                 // Input
                 auto& tDatumPtr = tDatums->at(0);
                 const auto& poseKeypoints3D = tDatumPtr->poseKeypoints3D;
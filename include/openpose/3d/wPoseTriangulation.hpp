@@ -68,14 +68,18 @@ namespace op
                 // Debugging log
                 opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
-                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
                 // 3-D triangulation and reconstruction
                 std::vector<Matrix> cameraMatrices;
+                std::vector<Matrix> cameraIntrinsics;
+                std::vector<Matrix> cameraDistortions;
                 std::vector<Array<float>> poseKeypointVector;
                 std::vector<Array<float>> faceKeypointVector;
                 std::vector<Array<float>> leftHandKeypointVector;
                 std::vector<Array<float>> rightHandKeypointVector;
                 std::vector<Point<int>> imageSizes;
+                std::vector<Array<long long>> poseIds;
                 for (auto& tDatumPtr : *tDatums)
                 {
                     poseKeypointVector.emplace_back(tDatumPtr->poseKeypoints);
@@ -83,13 +87,15 @@ namespace op
                     leftHandKeypointVector.emplace_back(tDatumPtr->handKeypoints[0]);
                     rightHandKeypointVector.emplace_back(tDatumPtr->handKeypoints[1]);
                     cameraMatrices.emplace_back(tDatumPtr->cameraMatrix);
-                    imageSizes.emplace_back(
-                        Point<int>{tDatumPtr->cvInputData.cols(), tDatumPtr->cvInputData.rows()});
+                    cameraIntrinsics.emplace_back(tDatumPtr->cameraIntrinsics);
+                    cameraDistortions.emplace_back(tDatumPtr->cameraDistortion);
+                    imageSizes.emplace_back(tDatumPtr->getInputSize());
+                    poseIds.emplace_back(tDatumPtr->poseIds);
                 }
                 // Pose 3-D reconstruction
                 auto poseKeypoints3Ds = spPoseTriangulation->reconstructArray(
                     {poseKeypointVector, faceKeypointVector, leftHandKeypointVector, rightHandKeypointVector},
-                    cameraMatrices, imageSizes);
+                    cameraMatrices, imageSizes, cameraIntrinsics, cameraDistortions, poseIds, tDatums->at(0)->id);
                 // Assign to all tDatums
                 for (auto& tDatumPtr : *tDatums)
                 {
@@ -0,0 +1,171 @@
+#ifndef OPENPOSE_C_OPENPOSE_C_H
+#define OPENPOSE_C_OPENPOSE_C_H
+
+/*
+ * OpenPose C API (library `openpose_c`, CMake flag `BUILD_C_API`). Plain C ABI for foreign-language bindings (e.g.,
+ * Go cgo, Rust FFI, C#): only opaque handles, fixed-layout structs and C types cross the library boundary.
+ *
+ * Usage:
+ * 1. opc_wrapper_create() with the same flags as the demo (e.g., "--model_folder", "models/"), and
+ *    opc_wrapper_start().
+ * 2. opc_submit() each frame. The pixels are not copied: the caller keeps the buffer unmodified until
+ *    inputReleased is called (once OpenPose has built its network input, or at the latest when the result of that
+ *    frame is released).
+ * 3. opc_pop() each result (in submission order) and read its fields with opc_result_get_tensor(). The tensors
+ *    point into the native memory of the result (recycled for the next frames), so they are not copied either and
+ *    they remain valid until opc_result_release().
+ * 4. opc_wrapper_destroy().
+ *
+ * All the functions can be called from any thread (e.g., a thread submitting and another one popping), and none of
+ * them throws or aborts: they return an OpcStatus, and opc_last_error() describes the last failure of the calling
+ * thread.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef _WIN32
+    #define OPC_API
+#elif defined OPC_EXPORTS
+    #define OPC_API __declspec(dllexport)
+#else
+    #define OPC_API __declspec(dllimport)
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Incremented on any incompatible change of this header */
+#define OPC_API_VERSION 1
+#define OPC_MAX_DIMENSIONS 4
+
+typedef enum OpcStatus
+{
+    OPC_OK = 0,
+    /* Any other failure (see opc_last_error()) */
+    OPC_ERROR = 1,
+    OPC_INVALID_ARGUMENT = 2,
+    /* Non-blocking call that would have to wait (input queue full or no result ready yet) */
+    OPC_NOT_READY = 3,
+    /* The wrapper is not running (not started yet, stopped or destroyed) */
+    OPC_STOPPED = 4
+} OpcStatus;
+
+typedef enum OpcElementType
+{
+    OPC_ELEMENT_FLOAT32 = 0,
+    OPC_ELEMENT_INT64 = 1,
+    OPC_ELEMENT_UINT8 = 2
+} OpcElementType;
+
+/* Fields of a result, with their element type and sizes */
+typedef enum OpcField
+{
+    /* Float32 [people x parts x 3 (x, y, score)] */
+    OPC_FIELD_POSE_KEYPOINTS = 0,
+    /* Float32 [people] */
+    OPC_FIELD_POSE_SCORES = 1,
+    /* Int64 [people] (`--tracking` or `--identification`) */
+    OPC_FIELD_POSE_IDS = 2,
+    /* Float32 [people x parts x 3] */
+    OPC_FIELD_FACE_KEYPOINTS = 3,
+    OPC_FIELD_HAND_LEFT_KEYPOINTS = 4,
+    OPC_FIELD_HAND_RIGHT_KEYPOINTS = 5,
+    /* Float32 [people x parts x 4 (x, y, z, score)] (`--3d`) */
+    OPC_FIELD_POSE_KEYPOINTS_3D = 6,
+    /* Float32 [people x 4 (x, y, width, height)] */
+    OPC_FIELD_FACE_RECTANGLES = 7,
+    /* Float32 [channels x height x width] (`--heatmaps_add_*`) */
+    OPC_FIELD_POSE_HEATMAPS = 8,
+    /* UInt8 [height x width x 3] (BGR rendered image, if rendering is enabled) */
+    OPC_FIELD_OUTPUT_IMAGE = 9,
+    /* Float32 [people x 3 x height x width] (`--person_crops` with `--person_crops_download`) */
+    OPC_FIELD_PERSON_CROPS = 10
+} OpcField;
+
+/* BGR image with 8 bits per channel (the layout of cv::Mat CV_8UC3) */
+typedef struct OpcImage
+{
+    const uint8_t* data;
+    int32_t width;
+    int32_t height;
+    /* Bytes between the beginning of 2 consecutive rows (0 for width x 3) */
+    int64_t rowStride;
+} OpcImage;
+
+/* View into the native memory of a result (empty if numberDimensions == 0) */
+typedef struct OpcTensor
+{
+    const void* data;
+    int32_t elementType; /* OpcElementType */
+    int32_t numberDimensions;
+    int64_t sizes[OPC_MAX_DIMENSIONS];
+    /* In bytes */
+    int64_t strides[OPC_MAX_DIMENSIONS];
+    int64_t byteSize;
+} OpcTensor;
+
+typedef struct OpcWrapper OpcWrapper;
+typedef struct OpcResult OpcResult;
+
+/* Called (from an OpenPose thread) once the pixels of a submitted frame are no longer read */
+typedef void (*OpcInputReleasedCallback)(void* userData);
+
+/* OPC_API_VERSION of the library (it should match the one of this header) */
+OPC_API int32_t opc_get_api_version(void);
+
+/* Last error message of the calling thread (empty if none), valid until its next failing call */
+OPC_API const char* opc_last_error(void);
+
+/*
+ * It configures an asynchronous wrapper (no producer, GUI or display) with the demo flags (argv[0] is not skipped,
+ * e.g., {"--model_folder", "models/", "--net_resolution", "-1x256"}).
+ * @param maxInFlight Maximum number of submitted frames whose result was not popped yet (opc_submit() blocks or
+ * returns OPC_NOT_READY beyond it), which also bounds the memory of the recycled results. 0 for 2 x GPUs x
+ * `--batch_size`.
+ */
+OPC_API OpcStatus opc_wrapper_create(
+    OpcWrapper** wrapper, int32_t argc, const char* const* argv, int32_t maxInFlight);
+
+OPC_API OpcStatus opc_wrapper_start(OpcWrapper* wrapper);
+
+/* It stops the wrapper (the pending opc_submit() and opc_pop() calls return OPC_STOPPED) */
+OPC_API OpcStatus opc_wrapper_stop(OpcWrapper* wrapper);
+
+/* It stops and destroys the wrapper. The results not released yet remain valid. */
+OPC_API void opc_wrapper_destroy(OpcWrapper* wrapper);
+
+/*
+ * It submits a frame (not copied, see inputReleased).
+ * @param tag Caller value returned by opc_result_get_tag() (e.g., a frame index or a pointer).
+ * @param inputReleased Optional (NULL if the buffer outlives the wrapper). It is always called once if OPC_OK is
+ * returned, and never otherwise.
+ * @param wait Non-zero to block while maxInFlight frames are in flight, 0 to return OPC_NOT_READY instead.
+ */
+OPC_API OpcStatus opc_submit(
+    OpcWrapper* wrapper, const OpcImage* image, uint64_t tag, OpcInputReleasedCallback inputReleased,
+    void* inputReleasedUserData, int32_t wait);
+
+/*
+ * It pops the result of the oldest submitted frame (the results are returned in submission order).
+ * @param wait Non-zero to block until it is processed, 0 to return OPC_NOT_READY instead.
+ */
+OPC_API OpcStatus opc_pop(OpcWrapper* wrapper, OpcResult** result, int32_t wait);
+
+OPC_API uint64_t opc_result_get_tag(const OpcResult* result);
+
+/* Number of people detected (the first size of the keypoint fields) */
+OPC_API int32_t opc_result_get_number_people(const OpcResult* result);
+
+/* It fills tensor with the given field (empty tensor if that field was not computed) */
+OPC_API OpcStatus opc_result_get_tensor(const OpcResult* result, OpcField field, OpcTensor* tensor);
+
+/* It gives the result (and the memory of its tensors) back to the wrapper, so it is recycled */
+OPC_API void opc_result_release(OpcResult* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OPENPOSE_C_OPENPOSE_C_H */
@@ -12,25 +12,28 @@ namespace op
      * @param flags Integer with the OpenCV flags for calibration (e.g., CALIB_RATIONAL_MODEL,
      * CALIB_THIN_PRISM_MODEL, or CALIB_TILTED_MODEL)
      * @param outputFilePath String with the name of the file where to write
+     * @param useCornerCache Whether to keep the grid corners found in each image in `{imageFolder}/corners_cache/`,
+     * so later runs over the same images skip the chessboard detection. The images are processed in parallel in any
+     * case.
      */
     OP_API void estimateAndSaveIntrinsics(
         const Point<int>& gridInnerCorners, const float gridSquareSizeMm, const int flags,
         const std::string& outputParameterFolder, const std::string& imageFolder, const std::string& serialNumber,
-        const bool saveImagesWithCorners = false);
+        const bool saveImagesWithCorners = false, const bool useCornerCache = true);
 
     OP_API void estimateAndSaveExtrinsics(
         const std::string& parameterFolder, const std::string& imageFolder, const Point<int>& gridInnerCorners,
         const float gridSquareSizeMm, const int index0, const int index1, const bool imagesAreUndistorted,
-        const bool combineCam0Extrinsics);
+        const bool combineCam0Extrinsics, const bool useCornerCache = true);
 
     OP_API void refineAndSaveExtrinsics(
         const std::string& parameterFolder, const std::string& imageFolder, const Point<int>& gridInnerCorners,
         const float gridSquareSizeMm, const int numberCameras, const bool imagesAreUndistorted,
-        const bool saveImagesWithCorners = false);
+        const bool saveImagesWithCorners = false, const bool useCornerCache = true);
 
     OP_API void estimateAndSaveSiftFile(
         const Point<int>& gridInnerCorners, const std::string& imageFolder, const int numberCameras,
-        const bool saveImagesWithCorners = false);
+        const bool saveImagesWithCorners = false, const bool useCornerCache = true);
 }
 
 #endif // OPENPOSE_CALIBRATION_CAMERA_PARAMETER_ESTIMATION_HPP
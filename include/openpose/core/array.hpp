@@ -16,6 +16,8 @@ namespace op
      * It wraps a Matrix and a std::shared_ptr, both of them pointing to the same raw data. I.e. they both share the
      * same memory, so we can read and modify this data in both formats with no performance impact.
      * Hence, it keeps high performance while adding high-level functions.
+     * The Matrix wrapper is only created on the first getConstCvMat() or getCvMat() call, so the many small Arrays
+     * never converted into Matrix (e.g., keypoints, scores or IDs) do not pay for it.
      */
     template<typename T>
     class Array
@@ -150,9 +152,25 @@ namespace op
          */
         Array<T> clone() const;
 
+        /**
+         * Copy-on-write helpers, analog to Matrix::isShared() and Matrix::makeUnique().
+         * @return Whether the data is also referenced by other Array<T> objects or it is external memory not owned by
+         * this Array<T> (e.g., Array(sizes, dataPtr) or Array(array, index, true)).
+         */
+        bool isShared() const;
+
+        /**
+         * It clone()s the data only if it isShared(), so this Array<T> can be modified in place without altering any
+         * other Array<T>.
+         */
+        void makeUnique();
+
         /**
          * Data allocation function.
          * It allocates the required space for the memory (it does not initialize that memory).
+         * If this Array<T> is the only owner of the memory it allocated before and the new volume fits in it, it
+         * reuses it rather than re-allocating (e.g., for the Arrays of the Datums reused by DatumPool). Resetting it
+         * to empty keeps that memory for the next reset(). Use `array = Array<T>{}` to release it.
          * @param size Integer with the number of T element to be allocated. E.g., size = 5 is internally similar to
          * `new T[5]`.
          */
@@ -204,6 +222,25 @@ namespace op
          */
         void reset(const std::vector<int>& sizes, T* const dataPtr);
 
+        /**
+         * Data allocation function.
+         * Similar to reset(const std::vector<int>& sizes, T* const dataPtr), but this Array (and all its copies)
+         * share the ownership of owner, so dataPtr remains valid as long as any of them exists (e.g., to wrap a numpy
+         * array without copying it).
+         * @param owner Object that owns the memory of dataPtr (its deleter frees it or releases it).
+         */
+        void reset(const std::vector<int>& sizes, T* const dataPtr, const std::shared_ptr<void>& owner);
+
+        /**
+         * Data allocation function.
+         * Similar to reset(const std::vector<int>& sizes), but it uses page-locked (pinned) host memory from the
+         * pinned memory pool (see pinnedMemory.hpp) if available, or regular memory otherwise. Recommended for Arrays
+         * copied from/to the GPU on each frame.
+         * @param sizes Vector with the size of each dimension. E.g., size = {3, 5, 2} is internally similar to:
+         * `new T[3*5*2]`.
+         */
+        void resetPinned(const std::vector<int>& sizes);
+
         /**
          * Data allocation function.
          * It internally allocates memory and copies the data of the argument to the Array allocated memory.
@@ -218,6 +255,13 @@ namespace op
          */
         void setTo(const T value);
 
+        /**
+         * It keeps the first `size0` elements of the first dimension (e.g., the first `size0` people of a keypoint
+         * Array), without re-allocating nor moving the data.
+         * @param size0 New size of the first dimension, in the range [0, getSize(0)]. If 0, the Array is reset.
+         */
+        void shrinkFirstDimension(const int size0);
+
 
 
         // ------------------------------ Data Information Functions ------------------------------ //
@@ -232,10 +276,12 @@ namespace op
 
         /**
          * Return a vector with the size of each dimension allocated.
+         * It returns a reference (no copy nor allocation), valid until the Array is reset. For element access in hot
+         * loops, see ArrayView3 (openpose/core/arrayView.hpp).
          * @return A std::vector<int> with the size of each dimension. If no memory has been allocated, it will return
          * an empty std::vector.
          */
-        inline std::vector<int> getSize() const
+        inline const std::vector<int>& getSize() const
         {
             return mSize;
         }
@@ -341,6 +387,8 @@ namespace op
          *     editedCvMat = array.getConstCvMat().clone();
          *     // modify data
          *     array.setFrom(editedCvMat)
+         * The Matrix is created on the first call (and after each reset()), so that first call must not happen
+         * concurrently from several threads on the same Array<T> object.
          * @return A const Matrix pointing to the data.
          */
         const Matrix& getConstCvMat() const;
@@ -479,7 +527,10 @@ namespace op
         size_t mVolume;
         std::shared_ptr<T> spData;
         T* pData; // pData is a wrapper of spData. Used for Pybind11 binding.
-        std::pair<bool, Matrix> mCvMatData;
+        // Number of T elements allocated by this Array<T> in spData (0 if it does not own it, e.g., dataPtr)
+        size_t mCapacity;
+        // Matrix wrapper of pData, created on the first getConstCvMat() or getCvMat() call (nullptr until then)
+        mutable std::shared_ptr<Matrix> spCvMatData;
 
         /**
          * Auxiliar function that both operator[](const std::vector<int>& indexes) and
@@ -506,6 +557,11 @@ namespace op
          */
         T& commonAt(const int index) const;
 
+        /**
+         * Auxiliar function that both getConstCvMat() and getCvMat() use. It creates spCvMatData if needed.
+         */
+        Matrix& commonCvMat() const;
+
         void resetAuxiliary(const std::vector<int>& sizes, T* const dataPtr = nullptr);
     };
 
@@ -0,0 +1,109 @@
+#ifndef OPENPOSE_CORE_ARRAY_VIEW_HPP
+#define OPENPOSE_CORE_ARRAY_VIEW_HPP
+
+#include <type_traits> // std::remove_const
+#include <openpose/core/array.hpp>
+
+namespace op
+{
+    /**
+     * ArrayView3<T>: Non-owning, fixed-rank view of a 3-dimensional Array<T> (e.g., the keypoints, of size
+     * #people x #parts x 3).
+     * Its sizes and strides are stored inline when it is created. Thus, operator() is plain pointer arithmetic, while
+     * the multi-dimensional Array<T>::operator[]({p, kp, 0}) builds an std::vector<int> for each element. Create it
+     * once outside the loop (it is cheap to copy) and index with it inside.
+     * It does not keep the data alive, so the Array must not be reset nor destroyed while the view is in use.
+     * Use ArrayView3<const T> to read from a const Array<T>.
+     */
+    template<typename T>
+    class ArrayView3
+    {
+    public:
+        typedef typename std::remove_const<T>::type ValueType;
+
+        /**
+         * Empty view.
+         */
+        ArrayView3() :
+            ArrayView3{nullptr, 0, 0, 0}
+        {
+        }
+
+        /**
+         * @param dataPtr Pointer to the first element of a contiguous, row-major size0 x size1 x size2 buffer.
+         */
+        ArrayView3(T* const dataPtr, const int size0, const int size1, const int size2) :
+            pData{dataPtr},
+            mSize{size0, size1, size2},
+            mStride0{size1*size2}
+        {
+        }
+
+        /**
+         * @param array Empty or 3-dimensional Array<T>. An empty one results in an empty view.
+         */
+        explicit ArrayView3(Array<ValueType>& array) :
+            ArrayView3{array.getPtr(), array.getSize(0), array.getSize(1), array.getSize(2)}
+        {
+            checkNumberDimensions(array);
+        }
+
+        /**
+         * Same than ArrayView3(Array<ValueType>& array), only available for ArrayView3<const T>.
+         */
+        explicit ArrayView3(const Array<ValueType>& array) :
+            ArrayView3{array.getConstPtr(), array.getSize(0), array.getSize(1), array.getSize(2)}
+        {
+            checkNumberDimensions(array);
+        }
+
+        /**
+         * Element at [index0, index1, index2]. As Array<T>::operator[], it does not check the bounds.
+         */
+        inline T& operator()(const int index0, const int index1, const int index2) const
+        {
+            return pData[index0*mStride0 + index1*mSize[2] + index2];
+        }
+
+        /**
+         * Pointer to the element [index0, index1, 0], e.g., to the (x,y,score) of a keypoint, or to all the keypoints
+         * of a person if index1 = 0.
+         */
+        inline T* getPtr(const int index0 = 0, const int index1 = 0) const
+        {
+            return pData + index0*mStride0 + index1*mSize[2];
+        }
+
+        /**
+         * @param index Dimension, in the range [0, 2].
+         */
+        inline int getSize(const int index) const
+        {
+            return mSize[index];
+        }
+
+        inline int getVolume() const
+        {
+            return mSize[0]*mStride0;
+        }
+
+        inline bool empty() const
+        {
+            return (getVolume() == 0);
+        }
+
+    private:
+        T* pData;
+        int mSize[3];
+        int mStride0;
+
+        static void checkNumberDimensions(const Array<ValueType>& array)
+        {
+            if (!array.empty() && array.getNumberDimensions() != 3)
+                error("ArrayView3 requires an empty or 3-dimensional Array, while this one has size "
+                      + array.printSize() + ".", __LINE__, __FUNCTION__, __FILE__);
+        }
+    };
+}
+
+#endif // OPENPOSE_CORE_ARRAY_VIEW_HPP
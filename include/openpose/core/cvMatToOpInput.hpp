@@ -2,6 +2,7 @@
 #define OPENPOSE_CORE_CV_MAT_TO_OP_INPUT_HPP
 
 #include <openpose/core/common.hpp>
+#include <openpose/core/frameGpu.hpp>
 #include <openpose/pose/enumClasses.hpp>
 
 namespace op
@@ -13,9 +14,19 @@ namespace op
 
         virtual ~CvMatToOpInput();
 
+        /**
+         * If inputDataGpu is not empty (e.g., frames decoded by NvDecReader or raw Bayer FLIR frames), it is resized,
+         * converted into BGR and normalized directly on its GPU (it requires gpuResize = true) and inputData is
+         * ignored (it might be empty).
+         * If inputRoi is not empty (see Datum::inputRoi), only inputRoiRectangle (its bounding box, see
+         * Datum::getInputRoiRectangle()) of inputData is processed, so scaleInputToNetInputs and netInputSizes must
+         * refer to its size. If inputRoi is a polygon (3 or more points), the area outside it is filled in black.
+         * It requires the frame in CPU memory (i.e., inputDataGpu empty).
+         */
         std::vector<Array<float>> createArray(
             const Matrix& inputData, const std::vector<double>& scaleInputToNetInputs,
-            const std::vector<Point<int>>& netInputSizes);
+            const std::vector<Point<int>>& netInputSizes, const FrameGpu& inputDataGpu = FrameGpu{},
+            const std::vector<Point<int>>& inputRoi = {}, const Rectangle<int>& inputRoiRectangle = Rectangle<int>{});
 
     private:
         const PoseModel mPoseModel;
@@ -2,6 +2,7 @@
 #define OPENPOSE_CORE_CV_MAT_TO_OP_OUTPUT_HPP
 
 #include <openpose/core/common.hpp>
+#include <openpose/core/renderTargetGpu.hpp>
 
 namespace op
 {
@@ -18,6 +19,15 @@ namespace op
         Array<float> createArray(
             const Matrix& inputData, const double scaleInputToOutput, const Point<int>& outputResolution);
 
+        /**
+         * Similar to createArray(inputData, scaleInputToOutput, outputResolution), but the GPU resize writes the
+         * image into outputDataGpu (i.e., the render target of this Datum) rather than into the memory shared with
+         * the following GPU renderers, so several frames can be in flight at the same time (e.g., batches).
+         */
+        Array<float> createArray(
+            const Matrix& inputData, const double scaleInputToOutput, const Point<int>& outputResolution,
+            RenderTargetGpu& outputDataGpu);
+
     private:
         const bool mGpuResize;
         unsigned char* pInputImageCuda;
@@ -25,6 +35,10 @@ namespace op
         unsigned long long pInputMaxSize;
         std::shared_ptr<unsigned long long> spOutputMaxSize;
         std::shared_ptr<bool> spGpuMemoryAllocated;
+
+        Array<float> createArray(
+            const Matrix& inputData, const double scaleInputToOutput, const Point<int>& outputResolution,
+            RenderTargetGpu* const outputDataGpu);
     };
 }
 
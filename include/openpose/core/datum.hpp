@@ -6,7 +6,15 @@
         #include <Eigen/Core>
     #endif
 #endif
+#include <chrono>
+#include <functional>
 #include <openpose/core/common.hpp>
+#include <openpose/core/datumTiming.hpp>
+#include <openpose/core/enumClasses.hpp>
+#include <openpose/core/frameGpu.hpp>
+#include <openpose/core/personCropsGpu.hpp>
+#include <openpose/core/renderTargetGpu.hpp>
+#include <openpose/core/sparseHeatMaps.hpp>
 
 namespace op
 {
@@ -37,6 +45,37 @@ namespace op
          */
         unsigned long long frameNumber;
 
+        /**
+         * Index of the frames source (e.g., camera) of this frame, when several sources are multiplexed into the same
+         * pipeline (see MultiSourceProducer). It is 0 otherwise.
+         */
+        unsigned long long sourceId;
+
+        /**
+         * Maximum sourceId (i.e., number of sources - 1). Savers only split their output per source if it is > 0.
+         */
+        unsigned long long sourceIdMax;
+
+        /**
+         * Scheduling priority class of this frame (e.g., of its source, see MultiSourceProducer::setSourceSchedule()).
+         * Frames of a higher class are served first by the schedulers (MultiSourceProducer and DeadlineQueue).
+         * It is 0 by default.
+         */
+        int priority;
+
+        /**
+         * Time after which this frame is useless (e.g., a live camera frame that would be displayed too late), so the
+         * schedulers drop it rather than processing it late. Default-constructed (i.e., the clock epoch) for no
+         * deadline.
+         */
+        std::chrono::steady_clock::time_point deadline;
+
+        /**
+         * Per-stage timing record of this frame (see DatumTiming). Only filled while DatumTiming::isEnabled() (e.g.,
+         * `--datum_timing`), empty otherwise. Copies share it, clone() deep copies it.
+         */
+        std::shared_ptr<DatumTiming> timing;
+
         // ------------------------------ Input image and rendered version parameters ------------------------------ //
         /**
          * Original image to be processed in cv::Mat uchar format.
@@ -44,6 +83,32 @@ namespace op
          */
         Matrix cvInputData;
 
+        /**
+         * Original image to be processed, in GPU memory (see FrameGpu for its formats).
+         * Only filled by producers that decode into GPU memory (e.g., NvDecReader). In that case, the network input is
+         * directly computed from it (see CvMatToOpInput), and cvInputData is only filled if some worker requires the
+         * image in CPU memory (e.g., rendering or face/hand detection), so it might be empty. Workers that only
+         * require it after the pose estimation get it downloaded right before them (see WInputDataGpuDownload), and
+         * custom workers can download it on demand with getCvInputData().
+         * Size: input_width x input_height (see getInputSize())
+         */
+        FrameGpu inputDataGpu;
+
+        /**
+         * If not empty, cvInputData wraps memory owned by the producer (e.g., a shared memory slot of
+         * SharedMemoryReader), which is given back to it once the last copy of this lease is released.
+         * WCvMatToOpInput releases it once inputNetData is computed. If any later worker requires the input image,
+         * cvInputData is deep copied first. Otherwise, only its size (see getInputSize()) is still valid.
+         */
+        std::shared_ptr<void> inputDataLease;
+
+        /**
+         * If not empty, the credit of the producer flow control (see FrameCredits) taken for this frame. It is given
+         * back once the frame leaves the pose estimation (see WFrameCredits), or once the last copy of this Datum is
+         * released (e.g., if the frame is dropped before). clone() does not copy it.
+         */
+        std::shared_ptr<void> frameCredit;
+
         /**
          * Original image to be processed in Array<float> format.
          * It has been resized to the net input resolution, as well as reformatted Array<float> format to be compatible
@@ -63,6 +128,14 @@ namespace op
          */
         Array<float> outputData;
 
+        /**
+         * Rendered image in GPU memory (same format than outputData).
+         * Only filled if the frame is rendered on the GPU and resized on the GPU (see CvMatToOpOutput). In that case,
+         * the GPU renderers draw into it rather than into outputData, and it is released once OpOutputToCvMat
+         * downloads it into cvOutputData.
+         */
+        RenderTargetGpu outputDataGpu;
+
         /**
          * Rendered image in cv::Mat uchar format.
          * It has been resized to the desired output resolution (e.g., `resolution` flag in the demo).
@@ -103,6 +176,12 @@ namespace op
          */
         Array<float> poseScores;
 
+        /**
+         * Whether poseKeypoints and poseScores were not computed for this frame, but reused from a previous one that
+         * looked the same (i.e., the body network was skipped, see MotionGate and `--motion_gate`).
+         */
+        bool poseKeypointsReused;
+
         /**
          * Body pose heatmaps (body parts, background and/or PAFs) for the whole image.
          * This parameter is by default empty and disabled for performance. Each group (body parts, background and
@@ -117,17 +196,48 @@ namespace op
          */
         Array<float> poseHeatMaps;
 
+        /**
+         * Pending download of poseHeatMaps, only set with `--heatmaps_lazy` (WrapperStructPose::heatMapsLazy). In that
+         * case, poseHeatMaps is left empty and the heat maps stay on the GPU until getPoseHeatMaps() is called, so
+         * frames whose heat maps are never read skip their GPU-to-CPU copy. See PoseExtractorNet::getHeatMapsDownload.
+         */
+        std::function<Array<float>()> poseHeatMapsDownload;
+
+        /**
+         * Sparse version of poseHeatMaps, only filled (instead of poseHeatMaps) with `--heatmaps_sparse_threshold`
+         * (WrapperStructPose::heatMapsSparseThreshold). Only the values whose absolute value is higher than that
+         * threshold are kept (thresholded and compacted on the GPU with CUDA), without any `heatmaps_scale` scaling
+         * (i.e., [0, 1] for the body parts and background, and [-1, 1] for the PAFs). Same channels than
+         * poseHeatMaps.
+         */
+        SparseHeatMaps poseHeatMapsSparse;
+
         /**
          * Body pose candidates for the whole image.
          * This parameter is by default empty and disabled for performance. It can be enabled with `candidates_body`.
          * Candidates refer to all the detected body parts, before being assembled into people. Note that the number
          * of candidates is equal or higher than the number of body parts after being assembled into people.
          * Size: #body parts x min(part candidates, POSE_MAX_PEOPLE) x 3 (x,y,score).
-         * Rather than vector, it should ideally be:
-         * std::array<std::vector<std::array<float,3>>, #BP> poseCandidates;
+         * OpenPose fills the flat poseCandidatesArray and poseCandidatesOffsets instead, and this nested copy is only
+         * built from them (on demand) by getPoseCandidates(). Code reading the candidates should use the flat
+         * version or getPoseCandidates().
          */
         std::vector<std::vector<std::array<float,3>>> poseCandidates;
 
+        /**
+         * Flat (CSR-like) version of poseCandidates, filled directly from the NMS output with a single allocation:
+         * the candidates of all the body parts, one after the other, where the ones of body part `part` are the rows
+         * [poseCandidatesOffsets[part], poseCandidatesOffsets[part+1]).
+         * Size: #candidates x 3 (x,y,score), or empty if there are no candidates.
+         */
+        Array<float> poseCandidatesArray;
+
+        /**
+         * First row of poseCandidatesArray of each body part, and total number of candidates as last element.
+         * Size: #body parts + 1, or empty if the candidates are disabled.
+         */
+        std::vector<int> poseCandidatesOffsets;
+
         /**
          * Face detection locations (x,y,width,height) for each person in the image.
          * It is resized to cvInputData.size().
@@ -208,6 +318,44 @@ namespace op
          */
         Matrix cameraIntrinsics;
 
+        /**
+         * Distortion parameters of the camera (as in its XML file), only filled if cvInputData is still distorted
+         * and only the 2-D keypoints must be undistorted before the 3-D reconstruction (e.g.,
+         * `--frame_undistort_keypoints`). Empty if the frames were undistorted (or there is no distortion).
+         */
+        Matrix cameraDistortion;
+
+        /**
+         * Static region of interest (ROI) of the camera (e.g., `--input_roi` or the `InputRoi` node of its camera
+         * parameter file). If it is not empty, the body pose network only processes its bounding box (see
+         * getInputRoiRectangle()) and, if it is a polygon, the image area outside it is masked out. The resulting
+         * keypoints (and body part candidates) are still in full-frame (cvInputData) coordinates, while the heat
+         * maps refer to the bounding box.
+         * Size: 2 points (top-left and bottom-right corners of a rectangle) or 3 or more points (polygon), or empty
+         * for the whole image.
+         */
+        std::vector<Point<int>> inputRoi;
+
+        // ------------------------------ Person crops ------------------------------ //
+        /**
+         * Aligned crop of each person (see `--person_crops` and PersonCropExtractor), in GPU memory.
+         * Size: #people x 3 x crop_height x crop_width (normalized floats, as the network inputs)
+         */
+        PersonCropsGpu personCropsGpu;
+
+        /**
+         * Copy of personCropsGpu in pinned host memory (only if `--person_crops_download`).
+         * Size: #people x 3 x crop_height x crop_width
+         */
+        Array<float> personCrops;
+
+        /**
+         * Affine matrix of each crop (2x3, row-major), which maps the crop pixel coordinates into the cvInputData
+         * ones (e.g., to map the results of a second model back into the frame).
+         * Size: #people
+         */
+        std::vector<std::array<float, 6>> personCropMatrices;
+
         /**
          * If it is not empty, OpenPose will not run its internal body pose estimation network and will instead use
          * this data as the substitute of its network. The size of this element must match the size of the output of
@@ -249,6 +397,13 @@ namespace op
          */
         std::pair<int, std::string> elementRendered;
 
+        /**
+         * Optional fields filled by the pipeline that produced this Datum (DatumField::All by default, i.e., for the
+         * Datums not created by DatumProducer). The disabled ones are empty and skipped by clone(), so custom
+         * workers filling one of them must also enable it here. See getDatumFields() in wrapper/wrapperAuxiliary.hpp.
+         */
+        DatumField fields;
+
         // 3D/Adam parameters (experimental code not meant to be publicly used)
         #ifdef USE_3D_ADAM_MODEL
             // Adam/Unity params
@@ -332,6 +487,56 @@ namespace op
          */
         Datum clone() const;
 
+        /**
+         * Analog to clone(), but the input image and the network input (cvInputData, inputDataGpu and inputNetData),
+         * which no OpenPose worker modifies, are shared with the original Datum rather than copied if
+         * shareInputData is true. cvOutputData is also shared while it still refers to cvInputData (i.e., it
+         * has not been rendered yet).
+         * Copy-on-write: call Matrix::makeUnique() or Array<T>::makeUnique() before modifying them in place.
+         * @param shareInputData const bool parameter indicating whether the input data is shared (true) or deep
+         * copied (false, equivalent to clone()).
+         * @return The resulting Datum.
+         */
+        Datum clone(const bool shareInputData) const;
+
+        /**
+         * Size (width x height) of the original image, i.e., of cvInputData or, if it is empty, of inputDataGpu.
+         * @return Point<int> with the input image size, or {0, 0} if there is no input image.
+         */
+        Point<int> getInputSize() const;
+
+        /**
+         * Bounding box of inputRoi, clipped to getInputSize(). It is the whole image if inputRoi is empty (or its
+         * bounding box does not overlap the image).
+         */
+        Rectangle<int> getInputRoiRectangle() const;
+
+        /**
+         * It returns cvInputData, downloading inputDataGpu first (see FrameGpu::download()) if cvInputData is empty.
+         * cvOutputData is also set to it if it was empty (i.e., not rendered yet), as DatumProducer would have done.
+         */
+        const Matrix& getCvInputData();
+
+        /**
+         * It returns poseHeatMaps, downloading them first if they are still pending (see poseHeatMapsDownload). Code
+         * reading the heat maps should use it rather than poseHeatMaps if `--heatmaps_lazy` might be enabled.
+         */
+        const Array<float>& getPoseHeatMaps();
+
+        /**
+         * It returns poseCandidates, filling it first from poseCandidatesArray and poseCandidatesOffsets if they are
+         * not empty and poseCandidates is.
+         */
+        const std::vector<std::vector<std::array<float,3>>>& getPoseCandidates();
+
+        /**
+         * Whether all the given fields are enabled in fields, i.e., whether they might have been filled.
+         */
+        inline bool hasField(const DatumField field) const
+        {
+            return (fields & field) == field;
+        }
+
 
 
 
@@ -0,0 +1,108 @@
+#ifndef OPENPOSE_CORE_DATUM_TIMING_HPP
+#define OPENPOSE_CORE_DATUM_TIMING_HPP
+
+#include <atomic>
+#include <memory> // std::shared_ptr
+#include <mutex>
+#include <vector>
+#include <openpose/core/macros.hpp>
+
+namespace op
+{
+    /**
+     * 1 stage of the timing record of a Datum (see DatumTiming).
+     */
+    struct DatumTimingEvent
+    {
+        // Stage name, with static lifetime (e.g., a string literal or the result of Tracer::getName())
+        const char* name;
+        // std::chrono::steady_clock time (in nanoseconds since its epoch)
+        long long beginNs;
+        long long endNs;
+    };
+
+    /**
+     * Timing record of a single Datum (see Datum::timing): the begin and end time of each stage that processed it,
+     * on the monotonic clock (std::chrono::steady_clock, in nanoseconds), so the latency of each frame can be
+     * broken down from the C++, Python and JSON outputs:
+     * - SubThread records each worker call (named after the worker type, e.g., `WPoseExtractor`, including the
+     *   producer read) and the time the Datum waited in each queue (`Queue <id>`).
+     * - PoseExtractorCaffe adds the GPU time of the network forward pass and of the post-processing (measured with
+     *   CUDA events), anchored to the end of the post-processing.
+     * It is disabled by default. While disabled, Datum::timing is empty and the instrumented code only checks
+     * isEnabled() (a single atomic load).
+     */
+    class OP_API DatumTiming
+    {
+    public:
+        static void setEnabled(const bool enabled);
+
+        static bool isEnabled();
+
+        /**
+         * Current std::chrono::steady_clock time in nanoseconds.
+         */
+        static long long now();
+
+        /**
+         * It returns *datumTiming, allocating it first if it is empty.
+         */
+        static DatumTiming& get(std::shared_ptr<DatumTiming>& datumTiming);
+
+        explicit DatumTiming(const std::vector<DatumTimingEvent>& events = {});
+
+        /**
+         * Thread-safe.
+         * @param name Stage name, with static lifetime (e.g., a string literal or the result of Tracer::getName()).
+         */
+        void record(const char* const name, const long long beginNs, const long long endNs);
+
+        /**
+         * It marks the time the Datum entered a queue. The next closeQueue() records the time since then.
+         */
+        void openQueue(const long long beginNs);
+
+        /**
+         * It records the time since the last openQueue() (if any) as the stage name.
+         */
+        void closeQueue(const char* const name, const long long endNs);
+
+        /**
+         * Copy of the recorded stages, in recording order.
+         */
+        std::vector<DatumTimingEvent> getEvents() const;
+
+    private:
+        static std::atomic<bool> sEnabled;
+        mutable std::mutex mMutex;
+        std::vector<DatumTimingEvent> mEvents;
+        long long mQueueBeginNs;
+
+        DELETE_COPY(DatumTiming);
+    };
+
+    /**
+     * It calls function(datumTiming) for the DatumTiming of each Datum of tDatums (allocating it if needed).
+     */
+    template<typename TDatum, typename TFunction>
+    inline void forEachDatumTiming(
+        const std::shared_ptr<std::vector<std::shared_ptr<TDatum>>>& tDatums, const TFunction& function)
+    {
+        if (tDatums != nullptr)
+            for (auto& tDatumPtr : *tDatums)
+                if (tDatumPtr != nullptr)
+                    function(DatumTiming::get(tDatumPtr->timing));
+    }
+
+    /**
+     * Any other TDatums type has no DatumTiming.
+     */
+    template<typename TDatums, typename TFunction>
+    inline void forEachDatumTiming(const TDatums& tDatums, const TFunction& function)
+    {
+        UNUSED(tDatums);
+        UNUSED(function);
+    }
+}
+
+#endif // OPENPOSE_CORE_DATUM_TIMING_HPP
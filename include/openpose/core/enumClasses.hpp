@@ -38,6 +38,60 @@ namespace op
         AddKeypoints,
         AddPAFs,
     };
+
+    /**
+     * Pixel format of a FrameGpu. The Bayer ones are raw 8-bit (1 byte per pixel) sensor images, named after the
+     * order of the colors in each 2x2 tile (1st row, then 2nd one).
+     */
+    enum class FrameGpuFormat : unsigned char
+    {
+        Nv12,
+        BayerRggb,
+        BayerBggr,
+        BayerGrbg,
+        BayerGbrg,
+        Bgr, // Interleaved 8-bit BGR (3 bytes per pixel), i.e., the cvInputData format
+    };
+
+    /**
+     * Memory layout of a 4-D blob (e.g., the network output, see Net::getOutputLayout()). Its ArrayCpuGpu shape is
+     * always the NCHW one ({num, channels, height, width}), only the order of its elements changes.
+     */
+    enum class BlobLayout : unsigned char
+    {
+        Nchw, // Caffe: Each channel is a contiguous height x width plane
+        Nhwc, // Channel-last: The channels of each pixel are contiguous (e.g., TensorRT HWC or OpenVINO outputs)
+    };
+
+    /**
+     * Bit mask of the optional Datum fields filled by a pipeline (see Datum::fields and getDatumFields() in
+     * wrapper/wrapperAuxiliary.hpp). The disabled ones are always empty, so they are skipped when the Datum is
+     * cloned or sent to the Python/Unity bindings.
+     */
+    enum class DatumField : unsigned short
+    {
+        None = 0,
+        PoseHeatMaps = 1, // poseHeatMaps (and poseHeatMapsDownload)
+        PoseCandidates = 2, // poseCandidates, poseCandidatesArray and poseCandidatesOffsets
+        Face = 4, // faceRectangles and faceKeypoints
+        FaceHeatMaps = 8, // faceHeatMaps
+        Hand = 16, // handRectangles and handKeypoints
+        HandHeatMaps = 32, // handHeatMaps
+        Keypoints3D = 64, // poseKeypoints3D, faceKeypoints3D and handKeypoints3D
+        CameraParameters = 128, // cameraMatrix, cameraExtrinsics, cameraIntrinsics and cameraDistortion
+        Adam = 256, // Adam/Unity parameters (only with USE_3D_ADAM_MODEL)
+        All = 511,
+    };
+
+    inline DatumField operator|(const DatumField a, const DatumField b)
+    {
+        return DatumField((unsigned short)a | (unsigned short)b);
+    }
+
+    inline DatumField operator&(const DatumField a, const DatumField b)
+    {
+        return DatumField((unsigned short)a & (unsigned short)b);
+    }
 }
 
 #endif // OPENPOSE_CORE_ENUM_CLASSES_HPP
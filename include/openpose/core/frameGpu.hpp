@@ -0,0 +1,120 @@
+#ifndef OPENPOSE_CORE_FRAME_GPU_HPP
+#define OPENPOSE_CORE_FRAME_GPU_HPP
+
+#include <memory> // std::shared_ptr
+#include <openpose/core/enumClasses.hpp>
+#include <openpose/core/macros.hpp>
+#include <openpose/core/matrix.hpp>
+
+// Forward declaration of cudaStream_t, so CUDA headers are not required
+struct CUstream_st;
+
+namespace op
+{
+    /**
+     * FrameGpu is an image stored in GPU memory, either in NV12 format (e.g., a video frame decoded with NVDEC by
+     * NvDecReader): a luma (Y) plane of `height` rows and `width` bytes, followed by a chroma plane of `height`/2 rows
+     * with `width`/2 interleaved (U, V) pairs, both with a row stride of `pitch` bytes; as a raw 8-bit Bayer image
+     * (e.g., a FLIR camera frame uploaded by SpinnakerWrapper) of `height` rows of `width` bytes (stride `pitch`); or
+     * as an interleaved BGR image of `height` rows of 3 x `width` bytes (stride `pitch`).
+     * Datum::inputDataGpu carries it through the pipeline, and the host copy (see download()) is only made if a worker
+     * requires the image in CPU memory (see Datum::requireCvInputData()).
+     * Copies are shallow (they share the same GPU memory, which is released when the last copy is destroyed), and the
+     * frame must be considered read-only.
+     */
+    struct OP_API FrameGpu
+    {
+        /**
+         * GPU memory with the Y plane followed by the UV plane (i.e., `pitch` x `height` x 3/2 bytes) for NV12, or
+         * with the `pitch` x `height` Bayer or BGR image.
+         */
+        std::shared_ptr<unsigned char> dataPtr;
+
+        int width;
+
+        int height;
+
+        /**
+         * Row stride (in bytes) of both the Y and UV planes (NV12), or of the image (Bayer and BGR).
+         */
+        int pitch;
+
+        /**
+         * CUDA device in which dataPtr is allocated.
+         */
+        int gpuId;
+
+        /**
+         * YUV to RGB conversion: BT.709 (HD content) if true, BT.601 otherwise.
+         */
+        bool bt709;
+
+        /**
+         * Full (0-255) if true, limited (16-235) range otherwise.
+         */
+        bool fullRange;
+
+        /**
+         * Pixel format (FrameGpuFormat::Nv12 by default). bt709 and fullRange only apply to NV12.
+         */
+        FrameGpuFormat format;
+
+        /**
+         * Capture time given by the camera (in nanoseconds, e.g., the Spinnaker image timestamp, so the views of a
+         * multi-camera system can be synchronized), or 0 if unknown.
+         */
+        unsigned long long timestamp;
+
+        /**
+         * Optional (null by default) remap table in the same GPU, with the width x height interleaved (x, y) float
+         * source coordinates of each undistorted pixel (see CameraParameterReader::getUndistortMapGpu()). If set,
+         * the frame is undistorted while being resized (e.g., `--frame_undistort`), so dataPtr keeps the raw image.
+         */
+        std::shared_ptr<float> undistortMapPtr;
+
+        /**
+         * Rotation (0, 90, 180 or 270 degrees, or their negative equivalents) and flip to apply to the frame, with the
+         * same convention than rotateAndFlipFrame() (e.g., `--frame_rotate` and `--frame_flip`). They are folded into
+         * the resize into the network input (an index remap), so dataPtr keeps the raw (non-rotated) image, while
+         * the keypoints refer to the rotated one (see getOrientedWidth() and getOrientedHeight()).
+         */
+        int rotation;
+
+        bool flip;
+
+        /**
+         * Stream in which dataPtr is (asynchronously) written, or nullptr (default) for the default stream or if it
+         * was written synchronously. The workers reading dataPtr queue their work in it (or synchronize it first).
+         */
+        CUstream_st* cudaStream;
+
+        FrameGpu();
+
+        inline bool empty() const
+        {
+            return dataPtr == nullptr || width < 1 || height < 1;
+        }
+
+        /**
+         * Width of the frame once rotated (i.e., height if rotated 90 or 270 degrees).
+         */
+        inline int getOrientedWidth() const
+        {
+            return (rotation % 180 == 0 ? width : height);
+        }
+
+        inline int getOrientedHeight() const
+        {
+            return (rotation % 180 == 0 ? height : width);
+        }
+
+        /**
+         * It downloads the frame into frame (in CPU memory), in the interleaved BGR format of Datum::cvInputData,
+         * rotated and flipped (see rotation), i.e., the same host image that its producer would have returned.
+         * It is not undistorted (undistortMapPtr is ignored). It waits for the GPU (it synchronizes cudaStream).
+         */
+        void download(Matrix& frame) const;
+    };
+}
+
+#endif // OPENPOSE_CORE_FRAME_GPU_HPP
@@ -5,6 +5,7 @@
 #include <tuple>
 #include <openpose/core/common.hpp>
 #include <openpose/core/renderer.hpp>
+#include <openpose/core/renderTargetGpu.hpp>
 
 namespace op
 {
@@ -31,9 +32,22 @@ namespace op
             const std::tuple<std::shared_ptr<float*>, std::shared_ptr<bool>,
                 std::shared_ptr<unsigned long long>>& tuple);
 
+        /**
+         * It sets the render target of the following render calls (i.e., the GPU image of the Datum, see
+         * Datum::outputDataGpu). If nullptr or empty, the memory shared between the renderers of this thread is used.
+         * The rendering workers (WPoseRenderer, WFaceRenderer and WHandRenderer) set it to each Datum before rendering
+         * it, and back to nullptr once the whole batch of Datums is rendered.
+         */
+        void setRenderTargetGpu(RenderTargetGpu* const renderTargetGpu);
+
     protected:
         std::shared_ptr<float*> spGpuMemory;
 
+        /**
+         * GPU image to draw into: the render target (if set) or spGpuMemory.
+         */
+        float* getGpuMemory() const;
+
         void cpuToGpuMemoryIfNotCopiedYet(const float* const cpuMemory, const unsigned long long memoryVolume);
 
         void gpuToCpuMemoryIfLastRenderer(float* cpuMemory, const unsigned long long memoryVolume);
@@ -43,6 +57,9 @@ namespace op
         bool mIsFirstRenderer;
         bool mIsLastRenderer;
         std::shared_ptr<bool> spGpuMemoryAllocated;
+        RenderTargetGpu* pRenderTargetGpu;
+
+        bool usesRenderTargetGpu() const;
 
         DELETE_COPY(GpuRenderer);
     };
@@ -14,8 +14,17 @@ namespace op
 
         Array<float> keepTopPeople(const Array<float>& peopleArrays, const Array<float>& poseScores) const;
 
+        /**
+         * Equivalent to keepTopPeople(), but it compacts peopleArrays in place (i.e., without allocating a new
+         * Array) and it also removes the discarded people from poseScores.
+         */
+        void keepTopPeopleInPlace(Array<float>& peopleArrays, Array<float>& poseScores) const;
+
     private:
         const int mNumberPeopleMax;
+
+        // Indexes of the top mNumberPeopleMax people (in increasing order)
+        std::vector<int> getTopPeopleIndexes(const Array<float>& peopleArrays, const Array<float>& poseScores) const;
     };
 }
 
@@ -0,0 +1,88 @@
+#ifndef OPENPOSE_CORE_KEYPOINT_ROI_CACHE_HPP
+#define OPENPOSE_CORE_KEYPOINT_ROI_CACHE_HPP
+
+#include <array>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * KeypointRoiCache keeps, for each person ID (Datum::poseIds, given by `--identification` or `--tracking`), the
+     * last face or hand keypoints computed by the keypoint network together with their rectangle (ROI). If the
+     * rectangle of that person barely moved since then (center and size within maxMotion of its side) and the
+     * cached keypoints were confident enough (average score not lower than minAverageScore), the network is skipped
+     * for that rectangle and the cached keypoints are reused, shifted and scaled with the motion of the rectangle.
+     * The keypoints of each person are recomputed (refreshed) at least every maxSkippedFrames + 1 frames.
+     * Each slot (e.g., each camera view, and each hand) has its own people. It is not thread-safe, i.e., each thread
+     * (e.g., each GPU) must have its own KeypointRoiCache.
+     */
+    class OP_API KeypointRoiCache
+    {
+    public:
+        /**
+         * @param maxSkippedFrames Maximum number of consecutive frames that reuse the keypoints of the same person.
+         * @param minAverageScore Minimum average keypoint score of the cached keypoints in order to be reused.
+         * @param maxMotion Maximum displacement of the rectangle center and maximum relative change of its size, in
+         * both cases relative to the side of the rectangle.
+         */
+        KeypointRoiCache(const int maxSkippedFrames, const float minAverageScore = 0.5f, const float maxMotion = 0.1f);
+
+        virtual ~KeypointRoiCache();
+
+        /**
+         * It returns a copy of rectangles where the ones of the people whose cached keypoints can be reused are
+         * empty (0 x 0), so the keypoint extractor skips them. It must be followed by update() with the keypoints
+         * computed from those rectangles.
+         */
+        std::vector<Rectangle<float>> select(
+            const std::vector<Rectangle<float>>& rectangles, const Array<long long>& poseIds,
+            const unsigned long long slot);
+
+        /**
+         * It fills the keypoints of the people skipped by the last select() of that slot with their cached ones, and
+         * it caches the keypoints of the others.
+         * @param rectangles The same rectangles given to select() (not the returned ones).
+         */
+        void update(
+            Array<float>& keypoints, const std::vector<Rectangle<float>>& rectangles, const Array<long long>& poseIds,
+            const unsigned long long slot);
+
+        /**
+         * Analogous to select() for the 2 hands (left and right) of each person, in the slots 2*slot and 2*slot+1.
+         */
+        std::vector<std::array<Rectangle<float>, 2>> select(
+            const std::vector<std::array<Rectangle<float>, 2>>& handRectangles, const Array<long long>& poseIds,
+            const unsigned long long slot);
+
+        /**
+         * Analogous to update() for the 2 hands (left and right) of each person, in the slots 2*slot and 2*slot+1.
+         */
+        void update(
+            std::array<Array<float>, 2>& handKeypoints,
+            const std::vector<std::array<Rectangle<float>, 2>>& handRectangles, const Array<long long>& poseIds,
+            const unsigned long long slot);
+
+        /**
+         * Number of rectangles checked and number of them that reused the cached keypoints.
+         */
+        std::pair<unsigned long long, unsigned long long> getStats() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplKeypointRoiCache;
+        std::unique_ptr<ImplKeypointRoiCache> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(KeypointRoiCache);
+    };
+
+    /**
+     * Side of the network input crop for a face or hand rectangle of roiSide pixels: the smallest of 128, 256, and
+     * netInputSide that is not smaller than roiSide (upsampling the crop further does not add image detail).
+     */
+    OP_API int getRoiCropSide(const float roiSide, const int netInputSide);
+}
+
+#endif // OPENPOSE_CORE_KEYPOINT_ROI_CACHE_HPP
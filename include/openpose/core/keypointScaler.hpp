@@ -22,6 +22,14 @@ namespace op
         void scale(std::vector<std::vector<std::array<float,3>>>& poseCandidates, const double scaleInputToOutput,
                    const double scaleNetToOutput, const Point<int>& producerSize) const;
 
+        /**
+         * It rescales all the keypoint arrays and the part candidates of a frame with a single scale and offset,
+         * in a single pass over their memory.
+         */
+        void scale(std::vector<Array<float>>& arraysToScale,
+                   std::vector<std::vector<std::array<float,3>>>& poseCandidates, const double scaleInputToOutput,
+                   const double scaleNetToOutput, const Point<int>& producerSize) const;
+
     private:
         const ScaleMode mScaleMode;
     };
@@ -126,8 +126,33 @@ namespace op
          */
         explicit Matrix(const int rows, const int cols, const int type, void* cvMatPtr);
 
+        /**
+         * Similar to Matrix(const int rows, const int cols, const int type, void* cvMatPtr), but this Matrix (and all
+         * its copies) share the ownership of owner, so the borrowed memory remains valid as long as any of them exists
+         * (e.g., to wrap a numpy array without copying it). Plain cv::Mat copies of it (e.g., OP_OP2CVMAT) do not
+         * extend its lifetime.
+         * @param owner Object that owns the memory of cvMatPtr (its deleter frees it or releases it).
+         */
+        explicit Matrix(
+            const int rows, const int cols, const int type, void* cvMatPtr, const std::shared_ptr<void>& owner);
+
         Matrix clone() const;
 
+        /**
+         * Copy-on-write helpers. Copying a Matrix (or assigning it, e.g., Datum::cvOutputData = Datum::cvInputData)
+         * only copies the reference, so read-only consumers can share a single frame buffer.
+         * @return Whether the raw data is also referenced by other Matrix or cv::Mat objects, or it is external
+         * memory not owned by this Matrix (e.g., a numpy array or a sub-matrix).
+         */
+        bool isShared() const;
+
+        /**
+         * It deep copies the raw data only if it isShared(), so this Matrix can be modified in place without altering
+         * any other Matrix (e.g., cvOutputData before drawing on it when it still shares memory with cvInputData).
+         * Other Matrix objects keep referencing the original data.
+         */
+        void makeUnique();
+
         /**
          * @return cv::Mat*.
          */
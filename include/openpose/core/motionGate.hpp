@@ -0,0 +1,76 @@
+#ifndef OPENPOSE_CORE_MOTION_GATE_HPP
+#define OPENPOSE_CORE_MOTION_GATE_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/core/frameGpu.hpp>
+
+namespace op
+{
+    /**
+     * MotionGate detects the frames that did not change with respect to the last frame whose keypoints were computed
+     * (keyframe), so the body network forward pass can be skipped for them and the keypoints of the keyframe reused
+     * (e.g., static cameras with long stretches of empty or static scenes). Each frame is reduced to a small
+     * grayscale thumbnail (from cvInputData, or from the luma plane of the FrameGpu for GPU frames, so only a few of
+     * its rows are downloaded), and it is considered static if the ratio of thumbnail pixels whose intensity changed
+     * more than pixelThreshold is not higher than changedRatioThreshold. A static frame is still processed (and it
+     * becomes the new keyframe) after maxSkippedFrames consecutive skipped frames.
+     * Each camera view (index inside TDatums) has its own keyframe. It is not thread-safe, i.e., each pose thread
+     * (e.g., each GPU) must have its own MotionGate.
+     */
+    class OP_API MotionGate
+    {
+    public:
+        /**
+         * @param changedRatioThreshold Maximum ratio (in the range [0, 1]) of changed thumbnail pixels of a static
+         * frame.
+         * @param pixelThreshold Minimum intensity difference (in the range [0, 255]) of a changed thumbnail pixel.
+         * @param maxSkippedFrames Maximum number of consecutive skipped frames of each view.
+         * @param thumbnailWidth Width of the thumbnail (its height keeps the aspect ratio of the frame).
+         */
+        MotionGate(
+            const double changedRatioThreshold, const int pixelThreshold = 12, const int maxSkippedFrames = 30,
+            const int thumbnailWidth = 80);
+
+        virtual ~MotionGate();
+
+        /**
+         * Whether the frame of the view viewIndex (given by cvInputData, or by frameGpu if cvInputData is empty) did
+         * not change since its keyframe, so getKeyframeResults() can be used instead of running the network. If it
+         * returns false, the frame becomes the new keyframe, and its results must be given with
+         * setKeyframeResults() once they are computed.
+         */
+        bool isStatic(const Matrix& cvInputData, const FrameGpu& frameGpu, const unsigned long long viewIndex);
+
+        /**
+         * It keeps a copy of the keypoints of the last keyframe of the view viewIndex (see isStatic()).
+         */
+        void setKeyframeResults(
+            const unsigned long long viewIndex, const Array<float>& poseKeypoints, const Array<float>& poseScores,
+            const double scaleNetToOutput);
+
+        /**
+         * It fills poseKeypoints, poseScores, and scaleNetToOutput with a copy of the results of the last keyframe of
+         * the view viewIndex.
+         */
+        void getKeyframeResults(
+            const unsigned long long viewIndex, Array<float>& poseKeypoints, Array<float>& poseScores,
+            double& scaleNetToOutput) const;
+
+        /**
+         * Number of frames checked and number of them that were static.
+         */
+        std::pair<unsigned long long, unsigned long long> getStats() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplMotionGate;
+        std::unique_ptr<ImplMotionGate> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(MotionGate);
+    };
+}
+
+#endif // OPENPOSE_CORE_MOTION_GATE_HPP
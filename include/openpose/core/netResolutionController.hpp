@@ -0,0 +1,86 @@
+#ifndef OPENPOSE_CORE_NET_RESOLUTION_CONTROLLER_HPP
+#define OPENPOSE_CORE_NET_RESOLUTION_CONTROLLER_HPP
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * NetResolutionController adapts the network input resolution to keep the per-frame latency close to a target
+     * latency (SLO). It measures the latency of each frame between frameStarted() (called by WScaleAndSizeExtractor
+     * right before choosing the network input size) and frameFinished() (called by WNetResolutionController once the
+     * frame keypoints are ready), and it moves across a fixed set of network input resolutions (levels) in multiples
+     * of 16, evenly spaced from minNetInputResolution to maxNetInputResolution:
+     * - If the (exponential moving average) latency is above targetLatencyMs * (1 + hysteresis), it steps down.
+     * - If it is below targetLatencyMs * (1 - hysteresis), and the number of people is not higher than when it last
+     * stepped down (more people means more post-processing time), it steps up.
+     * - After each change, it waits framesBetweenChanges frames, so the latency of the new resolution is measured
+     * before changing again.
+     * It starts at maxNetInputResolution. All the functions are thread-safe.
+     */
+    class OP_API NetResolutionController
+    {
+    public:
+        /**
+         * @param minNetInputResolution Minimum network input resolution (multiples of 16). A dimension can be -1 (as
+         * in `--net_resolution`), but it must then be -1 in maxNetInputResolution too.
+         * @param maxNetInputResolution Maximum network input resolution (multiples of 16).
+         * @param targetLatencyMs Target latency per frame (in milliseconds).
+         * @param maxNumberLevels Maximum number of resolutions. Each one might require its own network reshape (and
+         * TensorRT engine), so only a few of them are recommended.
+         * @param hysteresis Relative distance to targetLatencyMs within which the resolution is not changed.
+         */
+        NetResolutionController(
+            const Point<int>& minNetInputResolution, const Point<int>& maxNetInputResolution,
+            const double targetLatencyMs, const unsigned int maxNumberLevels = 5u, const double hysteresis = 0.1,
+            const unsigned int framesBetweenChanges = 10u);
+
+        virtual ~NetResolutionController();
+
+        /**
+         * Current network input resolution (to be used by ScaleAndSizeExtractor).
+         */
+        Point<int> getNetInputResolution() const;
+
+        /**
+         * All the possible network input resolutions, from the smallest to the largest one.
+         */
+        const std::vector<Point<int>>& getNetInputResolutions() const;
+
+        void frameStarted(const unsigned long long frameId);
+
+        void frameFinished(const unsigned long long frameId, const int numberPeople);
+
+        /**
+         * Network input sizes (for each scale) of each resolution of getNetInputResolutions(), so the networks can
+         * be reshaped for all of them in advance (see PoseExtractorNet::reserveNetInputSizes()). They depend on the
+         * input frame resolution, so they are set by WScaleAndSizeExtractor once the first frame arrives.
+         */
+        void setNetInputSizes(const std::vector<std::vector<Point<int>>>& netInputSizes);
+
+        /**
+         * It returns an empty std::vector until setNetInputSizes() is called.
+         */
+        std::vector<std::vector<Point<int>>> getNetInputSizes() const;
+
+    private:
+        const std::vector<Point<int>> mNetInputResolutions;
+        const double mTargetLatencyMs;
+        const double mHysteresis;
+        const unsigned int mFramesBetweenChanges;
+        mutable std::mutex mMutex;
+        std::size_t mLevel;
+        double mLatencyMs;
+        unsigned int mFramesSinceChange;
+        int mNumberPeopleAtStepDown;
+        std::map<unsigned long long, std::chrono::high_resolution_clock::time_point> mFrameBegins;
+        std::vector<std::vector<Point<int>>> mNetInputSizes;
+
+        DELETE_COPY(NetResolutionController);
+    };
+}
+
+#endif // OPENPOSE_CORE_NET_RESOLUTION_CONTROLLER_HPP
@@ -0,0 +1,91 @@
+#ifndef OPENPOSE_CORE_NET_WARM_UP_HPP
+#define OPENPOSE_CORE_NET_WARM_UP_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * NetWarmUp keeps the network input sizes that each pose network runs once on its own thread (see
+     * PoseExtractorNet::warmUp()) before processing the first frame, so the first frames do not pay the one-time
+     * costs of each new network shape (blob and workspace allocations, convolution algorithm selection and kernel
+     * loading) as a latency spike. They are:
+     * - The network input sizes of the input resolutions given to the constructor (e.g., WrapperT::warmUp() or the
+     * producer resolution), converted by the wrapper with addNetInputSizes().
+     * - If cacheFile is not empty, the network input sizes seen in previous runs with the same key (GPU, CUDA
+     * versions and model, see getKey()). New ones are recorded with addCachedNetInputSizes(), and the file is
+     * re-written each time a new one is added (a single text line per key and network input size).
+     * It also counts how many workers have not finished warming up yet (see waitUntilWarmedUp()). All the functions
+     * are thread-safe.
+     */
+    class OP_API NetWarmUp
+    {
+    public:
+        /**
+         * @param inputSizes Input image resolutions to warm up.
+         * @param cacheFile Optional. File with the network input sizes of the previous runs (it is created if it does
+         * not exist).
+         */
+        explicit NetWarmUp(const std::vector<Point<int>>& inputSizes = {}, const std::string& cacheFile = "");
+
+        virtual ~NetWarmUp();
+
+        const std::vector<Point<int>>& getInputSizes() const;
+
+        /**
+         * It adds the network input sizes (1 per scale) to be warmed up regardless of the key (e.g., the ones of
+         * getInputSizes()).
+         */
+        void addNetInputSizes(const std::vector<Point<int>>& netInputSizes);
+
+        /**
+         * It returns the network input sizes to be warmed up for the given key, i.e., the ones of addNetInputSizes()
+         * followed by the cached ones, without duplicates.
+         */
+        std::vector<std::vector<Point<int>>> getNetInputSizes(const std::string& key) const;
+
+        /**
+         * It records the network input sizes of a processed frame for the given key, saving the cache file if they
+         * are new. It does nothing if cacheFile is empty.
+         */
+        void addCachedNetInputSizes(const std::string& key, const std::vector<Point<int>>& netInputSizes);
+
+        /**
+         * Cache key of the given GPU and model: GPU name and compute capability, CUDA driver and runtime versions,
+         * and modelKey (e.g., the model and prototxt file of the network).
+         */
+        static std::string getKey(const int gpuId, const std::string& modelKey);
+
+        /**
+         * It registers a worker that will call setWarmedUp() once it finishes warming up.
+         */
+        void addWorker();
+
+        void setWarmedUp();
+
+        /**
+         * It waits until all the workers of addWorker() have called setWarmedUp(), or until timeout.
+         * @return Whether all of them have finished warming up.
+         */
+        bool waitUntilWarmedUp(const std::chrono::milliseconds& timeout);
+
+    private:
+        const std::vector<Point<int>> mInputSizes;
+        const std::string mCacheFile;
+        mutable std::mutex mMutex;
+        std::condition_variable mConditionVariable;
+        std::vector<std::vector<Point<int>>> mNetInputSizes;
+        std::map<std::string, std::vector<std::vector<Point<int>>>> mCachedNetInputSizes;
+        unsigned int mPendingWorkers;
+
+        void saveCacheFile() const;
+
+        DELETE_COPY(NetWarmUp);
+    };
+}
+
+#endif // OPENPOSE_CORE_NET_WARM_UP_HPP
@@ -2,13 +2,19 @@
 #define OPENPOSE_CORE_OP_OUTPUT_TO_CV_MAT_HPP
 
 #include <openpose/core/common.hpp>
+#include <openpose/core/renderTargetGpu.hpp>
 
 namespace op
 {
     class OP_API OpOutputToCvMat
     {
     public:
-        OpOutputToCvMat(const bool gpuResize = false);
+        /**
+         * @param keepRenderTargetGpu If true, the GPU render target of each Datum (outputDataGpu) is not released
+         * after downloading it into cvOutputData, so the following workers can still read it (e.g., ImageSaver with
+         * GPU JPEG encoding). It is then released with the Datum.
+         */
+        OpOutputToCvMat(const bool gpuResize = false, const bool keepRenderTargetGpu = false);
 
         virtual ~OpOutputToCvMat();
 
@@ -17,8 +23,16 @@ namespace op
 
         Matrix formatToCvMat(const Array<float>& outputData);
 
+        /**
+         * Similar to formatToCvMat(outputData), but the GPU version reads the image from outputDataGpu (i.e., the
+         * render target of this Datum, see CvMatToOpOutput) if it is up to date. It is converted into unsigned char on
+         * the GPU and downloaded at once, and then outputDataGpu is released (unless keepRenderTargetGpu).
+         */
+        Matrix formatToCvMat(const Array<float>& outputData, RenderTargetGpu& outputDataGpu);
+
     private:
         const bool mGpuResize;
+        const bool mKeepRenderTargetGpu;
         // Shared variables
         std::shared_ptr<float*> spOutputImageFloatCuda;
         std::shared_ptr<unsigned long long> spOutputMaxSize;
@@ -26,6 +40,8 @@ namespace op
         // Local variables
         unsigned char* pOutputImageUCharCuda;
         unsigned long long mOutputMaxSizeUChar;
+
+        Matrix formatToCvMat(const Array<float>& outputData, RenderTargetGpu* const outputDataGpu);
     };
 }
 
@@ -0,0 +1,53 @@
+#ifndef OPENPOSE_CORE_PERSON_CROPS_GPU_HPP
+#define OPENPOSE_CORE_PERSON_CROPS_GPU_HPP
+
+#include <memory> // std::shared_ptr
+#include <openpose/core/macros.hpp>
+
+namespace op
+{
+    /**
+     * PersonCropsGpu are the aligned crops of the people of a Datum (see PersonCropExtractor) in GPU memory:
+     * `numberCrops` consecutive normalized planar images of 3 x `height` x `width` floats, i.e., the layout of a
+     * batched network input, so they can be fed into a second model without any host round-trip.
+     * Copies are shallow (they share the same GPU memory, which is released when the last copy is destroyed), and the
+     * crops must be considered read-only.
+     */
+    struct OP_API PersonCropsGpu
+    {
+        /**
+         * GPU memory with the crops (`numberCrops` x 3 x `height` x `width` floats).
+         */
+        std::shared_ptr<float> dataPtr;
+
+        int numberCrops;
+
+        int width;
+
+        int height;
+
+        /**
+         * CUDA device in which dataPtr is allocated.
+         */
+        int gpuId;
+
+        PersonCropsGpu();
+
+        /**
+         * It allocates dataPtr in the current CUDA device (from the CUDA memory pool). Its content is undefined.
+         */
+        void allocate(const int numberCrops, const int width, const int height);
+
+        inline bool empty() const
+        {
+            return dataPtr == nullptr || numberCrops < 1 || width < 1 || height < 1;
+        }
+
+        inline unsigned long long getVolume() const
+        {
+            return 3ull * (unsigned long long)numberCrops * (unsigned long long)width * (unsigned long long)height;
+        }
+    };
+}
+
+#endif // OPENPOSE_CORE_PERSON_CROPS_GPU_HPP
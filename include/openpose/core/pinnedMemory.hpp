@@ -0,0 +1,51 @@
+#ifndef OPENPOSE_CORE_PINNED_MEMORY_HPP
+#define OPENPOSE_CORE_PINNED_MEMORY_HPP
+
+#include <openpose/core/macros.hpp>
+
+namespace op
+{
+    // Page-locked (pinned) host memory pool. Host-device copies from/to pinned memory skip the driver staging copy
+    // and can run asynchronously, so it is used for the data that crosses the PCIe bus on each frame (e.g., see
+    // Array<T>::resetPinned()).
+    // Blocks are grouped in size buckets (up to 25% bigger than requested). They are not freed when the last
+    // std::shared_ptr is released, but kept in the pool for the next request of the same bucket, removing the
+    // per-frame (and slow) cudaHostAlloc/cudaFreeHost calls.
+
+    /**
+     * It returns a page-locked memory block of at least `bytes` bytes (page aligned). The block returns to the pool
+     * once the last copy of the returned std::shared_ptr is destroyed.
+     * It returns an empty std::shared_ptr if pinned memory is not available (e.g., OpenPose not compiled with CUDA or
+     * no GPU found), so the caller can fall back to regular memory.
+     */
+    OP_API std::shared_ptr<unsigned char> getPinnedMemory(const unsigned long long bytes);
+
+    /**
+     * It returns whether ptr is the beginning of a page-locked memory block that was obtained with
+     * getPinnedMemory() and is still in use.
+     */
+    OP_API bool isPinnedMemory(const void* const ptr);
+
+    /**
+     * It returns the device address of a block obtained with getPinnedMemory() (all of them are mapped into the
+     * device address space), or nullptr if ptr is not one of them or the current GPU cannot map host memory. With
+     * unified virtual addressing (UVA), it is the same address than ptr. It is meant for integrated GPUs (see
+     * isIntegratedGpu()), where the GPU reads the block at full speed and the host-device copy can be skipped.
+     */
+    OP_API void* getPinnedMemoryDevicePtr(const void* const ptr);
+
+    /**
+     * It frees all the pinned memory blocks that are not currently in use.
+     */
+    OP_API void releasePinnedMemoryCache();
+
+    /**
+     * Pinned memory currently in use (i.e., referenced by some std::shared_ptr) and cached (i.e., free but kept for
+     * re-use), in bytes.
+     */
+    OP_API unsigned long long getPinnedMemoryUsedBytes();
+
+    OP_API unsigned long long getPinnedMemoryCachedBytes();
+}
+
+#endif // OPENPOSE_CORE_PINNED_MEMORY_HPP
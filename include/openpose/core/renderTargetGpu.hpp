@@ -0,0 +1,58 @@
+#ifndef OPENPOSE_CORE_RENDER_TARGET_GPU_HPP
+#define OPENPOSE_CORE_RENDER_TARGET_GPU_HPP
+
+#include <memory> // std::shared_ptr
+#include <openpose/core/macros.hpp>
+
+namespace op
+{
+    /**
+     * RenderTargetGpu is the rendered image of a Datum (i.e., Datum::outputData) in GPU memory: `height` x `width`
+     * x 3 floats, with the same layout than outputData. CvMatToOpOutput (GPU resize) fills it with the input frame,
+     * all the GPU renderers (pose, face and hand) draw into it, and OpOutputToCvMat downloads it once into
+     * cvOutputData. Being per Datum (rather than per renderer), the frames buffered by the batched network forward
+     * pass do not overwrite each other.
+     * Copies are shallow (they share the same GPU memory, which is released when the last copy is destroyed).
+     */
+    struct OP_API RenderTargetGpu
+    {
+        /**
+         * GPU memory with the float BGR image (`height` x `width` x 3 floats).
+         */
+        std::shared_ptr<float> dataPtr;
+
+        int width;
+
+        int height;
+
+        /**
+         * CUDA device in which dataPtr is allocated.
+         */
+        int gpuId;
+
+        /**
+         * Whether dataPtr has the latest version of the rendered image (so Datum::outputData is outdated).
+         */
+        bool upToDate;
+
+        RenderTargetGpu();
+
+        /**
+         * It allocates dataPtr in the current CUDA device (from the CUDA memory pool) unless it already has this
+         * size on this device. Its content is undefined after a new allocation, and upToDate is set to false.
+         */
+        void allocate(const int width, const int height);
+
+        inline bool empty() const
+        {
+            return dataPtr == nullptr || width < 1 || height < 1;
+        }
+
+        inline unsigned long long getVolume() const
+        {
+            return 3ull * (unsigned long long)width * (unsigned long long)height;
+        }
+    };
+}
+
+#endif // OPENPOSE_CORE_RENDER_TARGET_GPU_HPP
@@ -46,8 +46,9 @@ namespace op
         std::atomic<bool> mShowGooglyEyes;
 
     private:
-        float mAlphaKeypoint;
-        float mAlphaHeatMap;
+        // Atomic, so they can be changed while rendering (e.g., see RuntimeConfigurator)
+        std::atomic<float> mAlphaKeypoint;
+        std::atomic<float> mAlphaHeatMap;
 
         DELETE_COPY(Renderer);
     };
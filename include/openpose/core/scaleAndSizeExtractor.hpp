@@ -9,20 +9,32 @@ namespace op
     class OP_API ScaleAndSizeExtractor
     {
     public:
+        /**
+         * @param smallestScaleOnly If true, extract() only returns the smallest of the scaleNumber scales (e.g., for
+         * AdaptiveMultiScale, which runs the largest one only where needed).
+         */
         ScaleAndSizeExtractor(const Point<int>& netInputResolution, const float netInputResolutionDynamicBehavior,
-            const Point<int>& outputResolution, const int scaleNumber = 1, const double scaleGap = 0.25);
+            const Point<int>& outputResolution, const int scaleNumber = 1, const double scaleGap = 0.25,
+            const bool smallestScaleOnly = false);
 
         virtual ~ScaleAndSizeExtractor();
 
         std::tuple<std::vector<double>, std::vector<Point<int>>, double, Point<int>> extract(
             const Point<int>& inputResolution) const;
 
+        /**
+         * It changes the network input resolution (e.g., see NetResolutionController). Not thread-safe with
+         * respect to extract().
+         */
+        void setNetInputResolution(const Point<int>& netInputResolution);
+
     private:
-        const Point<int> mNetInputResolution;
+        Point<int> mNetInputResolution;
         const float mNetInputResolutionDynamicBehavior;
         const Point<int> mOutputSize;
         const int mScaleNumber;
         const double mScaleGap;
+        const bool mSmallestScaleOnly;
     };
 }
 
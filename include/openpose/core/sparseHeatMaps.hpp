@@ -0,0 +1,67 @@
+#ifndef OPENPOSE_CORE_SPARSE_HEAT_MAPS_HPP
+#define OPENPOSE_CORE_SPARSE_HEAT_MAPS_HPP
+
+#include <vector>
+#include <openpose/core/array.hpp>
+#include <openpose/core/macros.hpp>
+
+namespace op
+{
+    /**
+     * Sparse version of a [#channels x height x width] heat map Array (e.g., Datum::poseHeatMapsSparse): only the
+     * values whose absolute value is higher than the threshold are kept, as a list of (index, value) per channel
+     * (sorted by index). The remaining ones are 0.
+     */
+    struct OP_API SparseHeatMaps
+    {
+        /**
+         * Size of the dense heat maps: #channels x height x width. Empty if there are no heat maps.
+         */
+        std::vector<int> size;
+
+        /**
+         * The values of the channel c are [offsets[c], offsets[c+1]) in indices and values, so it has #channels + 1
+         * elements (the last one is the total number of values).
+         */
+        std::vector<int> offsets;
+
+        /**
+         * Position of each value in its channel (y * width + x).
+         */
+        std::vector<int> indices;
+
+        std::vector<float> values;
+
+        /**
+         * Threshold used to build them. The absolute value of all the kept values is higher than it.
+         */
+        float threshold;
+
+        SparseHeatMaps();
+
+        /**
+         * Sparse version of heatMaps (CPU).
+         * @param heatMaps Array of size [#channels x height x width].
+         */
+        SparseHeatMaps(const Array<float>& heatMaps, const float threshold);
+
+        bool empty() const;
+
+        /**
+         * Number of values kept.
+         */
+        int getNumberValues() const;
+
+        /**
+         * It clears all the elements (keeping their memory).
+         */
+        void clear();
+
+        /**
+         * Dense version (0 for the values not kept).
+         */
+        Array<float> toDense() const;
+    };
+}
+
+#endif // OPENPOSE_CORE_SPARSE_HEAT_MAPS_HPP
@@ -11,7 +11,13 @@ namespace op
     class WCvMatToOpInput : public Worker<TDatums>
     {
     public:
-        explicit WCvMatToOpInput(const std::shared_ptr<CvMatToOpInput>& cvMatToOpInput);
+        /**
+         * @param keepInputData Whether any later worker requires the input image (e.g., rendering or face/hand
+         * detection). If so, the frames wrapping producer memory (see Datum::inputDataLease) are deep copied before
+         * their lease is released.
+         */
+        explicit WCvMatToOpInput(
+            const std::shared_ptr<CvMatToOpInput>& cvMatToOpInput, const bool keepInputData = true);
 
         virtual ~WCvMatToOpInput();
 
@@ -21,6 +27,7 @@ namespace op
 
     private:
         const std::shared_ptr<CvMatToOpInput> spCvMatToOpInput;
+        const bool mKeepInputData;
 
         DELETE_COPY(WCvMatToOpInput);
     };
@@ -35,8 +42,10 @@ namespace op
 namespace op
 {
     template<typename TDatums>
-    WCvMatToOpInput<TDatums>::WCvMatToOpInput(const std::shared_ptr<CvMatToOpInput>& cvMatToOpInput) :
-        spCvMatToOpInput{cvMatToOpInput}
+    WCvMatToOpInput<TDatums>::WCvMatToOpInput(
+        const std::shared_ptr<CvMatToOpInput>& cvMatToOpInput, const bool keepInputData) :
+        spCvMatToOpInput{cvMatToOpInput},
+        mKeepInputData{keepInputData}
     {
     }
 
@@ -60,11 +69,29 @@ namespace op
                 // Debugging log
                 opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
-                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
                 // cv::Mat -> float*
                 for (auto& tDatumPtr : *tDatums)
+                {
                     tDatumPtr->inputNetData = spCvMatToOpInput->createArray(
-                        tDatumPtr->cvInputData, tDatumPtr->scaleInputToNetInputs, tDatumPtr->netInputSizes);
+                        tDatumPtr->cvInputData, tDatumPtr->scaleInputToNetInputs, tDatumPtr->netInputSizes,
+                        tDatumPtr->inputDataGpu, tDatumPtr->inputRoi,
+                        (tDatumPtr->inputRoi.empty() ? Rectangle<int>{} : tDatumPtr->getInputRoiRectangle()));
+                    // Give the producer memory back (e.g., the shared memory slot of SharedMemoryReader)
+                    if (tDatumPtr->inputDataLease != nullptr)
+                    {
+                        if (mKeepInputData)
+                        {
+                            const auto notRenderedYet = (tDatumPtr->cvOutputData.getConstCvMat()
+                                                         == tDatumPtr->cvInputData.getConstCvMat());
+                            tDatumPtr->cvInputData = tDatumPtr->cvInputData.clone();
+                            if (notRenderedYet)
+                                tDatumPtr->cvOutputData = tDatumPtr->cvInputData;
+                        }
+                        tDatumPtr->inputDataLease.reset();
+                    }
+                }
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
                 Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
@@ -63,11 +63,13 @@ namespace op
                 // T* to T
                 auto& tDatumsNoPtr = *tDatums;
                 // Profiling speed
-                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
                 // cv::Mat -> float*
                 for (auto& tDatumPtr : tDatumsNoPtr)
                     tDatumPtr->outputData = spCvMatToOpOutput->createArray(
-                        tDatumPtr->cvInputData, tDatumPtr->scaleInputToOutput, tDatumPtr->netOutputSize);
+                        tDatumPtr->cvInputData, tDatumPtr->scaleInputToOutput, tDatumPtr->netOutputSize,
+                        tDatumPtr->outputDataGpu);
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
                 Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
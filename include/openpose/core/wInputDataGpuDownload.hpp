@@ -0,0 +1,85 @@
+#ifndef OPENPOSE_CORE_W_INPUT_DATA_GPU_DOWNLOAD_HPP
+#define OPENPOSE_CORE_W_INPUT_DATA_GPU_DOWNLOAD_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    /**
+     * It downloads the GPU input frames (Datum::inputDataGpu) into cvInputData (see Datum::getCvInputData()). The
+     * Wrapper adds it right before the first worker that requires the input image in CPU memory, so the frames are
+     * only copied into host memory if (and once) needed, and not by the producer thread. E.g., if only the face and
+     * hand extractors (or the output workers) read them, the pose estimation starts from the GPU frame directly.
+     */
+    template<typename TDatums>
+    class WInputDataGpuDownload : public Worker<TDatums>
+    {
+    public:
+        explicit WInputDataGpuDownload();
+
+        virtual ~WInputDataGpuDownload();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WInputDataGpuDownload<TDatums>::WInputDataGpuDownload()
+    {
+    }
+
+    template<typename TDatums>
+    WInputDataGpuDownload<TDatums>::~WInputDataGpuDownload()
+    {
+    }
+
+    template<typename TDatums>
+    void WInputDataGpuDownload<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WInputDataGpuDownload<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
+                // Download the GPU frames (if not downloaded yet)
+                for (auto& tDatumPtr : *tDatums)
+                    tDatumPtr->getCvInputData();
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WInputDataGpuDownload);
+}
+
+#endif // OPENPOSE_CORE_W_INPUT_DATA_GPU_DOWNLOAD_HPP
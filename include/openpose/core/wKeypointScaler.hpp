@@ -19,6 +19,11 @@ namespace op
 
         void work(TDatums& tDatums);
 
+        /**
+         * Skipped if no Datum has keypoints nor part candidates to scale, see Worker::isSkippable().
+         */
+        bool isSkippable(const TDatums& tDatums) const;
+
     private:
         std::shared_ptr<KeypointScaler> spKeypointScaler;
     };
@@ -58,20 +63,18 @@ namespace op
                 // Debugging log
                 opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
-                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
                 // Rescale pose data
                 for (auto& tDatumPtr : *tDatums)
                 {
                     std::vector<Array<float>> arraysToScale{
                         tDatumPtr->poseKeypoints, tDatumPtr->handKeypoints[0],
-                        tDatumPtr->handKeypoints[1], tDatumPtr->faceKeypoints};
-                    spKeypointScaler->scale(
-                        arraysToScale, tDatumPtr->scaleInputToOutput, tDatumPtr->scaleNetToOutput,
-                        Point<int>{tDatumPtr->cvInputData.cols(), tDatumPtr->cvInputData.rows()});
-                    // Rescale part candidates
+                        tDatumPtr->handKeypoints[1], tDatumPtr->faceKeypoints, tDatumPtr->poseCandidatesArray};
+                    // Rescale them and the part candidates at once
                     spKeypointScaler->scale(
-                        tDatumPtr->poseCandidates, tDatumPtr->scaleInputToOutput, tDatumPtr->scaleNetToOutput,
-                        Point<int>{tDatumPtr->cvInputData.cols(), tDatumPtr->cvInputData.rows()});
+                        arraysToScale, tDatumPtr->poseCandidates, tDatumPtr->scaleInputToOutput,
+                        tDatumPtr->scaleNetToOutput, tDatumPtr->getInputSize());
                 }
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
@@ -88,6 +91,35 @@ namespace op
         }
     }
 
+    template<typename TDatums>
+    bool WKeypointScaler<TDatums>::isSkippable(const TDatums& tDatums) const
+    {
+        try
+        {
+            // Nothing to scale
+            if (!checkNoNullNorEmpty(tDatums))
+                return false;
+            for (const auto& tDatumPtr : *tDatums)
+            {
+                if (!tDatumPtr->poseKeypoints.empty() || !tDatumPtr->faceKeypoints.empty())
+                    return false;
+                if (!tDatumPtr->handKeypoints[0].empty() || !tDatumPtr->handKeypoints[1].empty())
+                    return false;
+                if (!tDatumPtr->poseCandidatesArray.empty())
+                    return false;
+                for (const auto& bodyPartCandidates : tDatumPtr->poseCandidates)
+                    if (!bodyPartCandidates.empty())
+                        return false;
+            }
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
     COMPILE_TEMPLATE_DATUM(WKeypointScaler);
 }
 
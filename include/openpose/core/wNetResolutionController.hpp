@@ -0,0 +1,94 @@
+#ifndef OPENPOSE_CORE_W_NET_RESOLUTION_CONTROLLER_HPP
+#define OPENPOSE_CORE_W_NET_RESOLUTION_CONTROLLER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/core/netResolutionController.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    /**
+     * It reports each finished frame (and its number of people) to the NetResolutionController. It should be placed
+     * after the keypoint extraction (the frame latency is measured since WScaleAndSizeExtractor).
+     */
+    template<typename TDatums>
+    class WNetResolutionController : public Worker<TDatums>
+    {
+    public:
+        explicit WNetResolutionController(const std::shared_ptr<NetResolutionController>& netResolutionController);
+
+        virtual ~WNetResolutionController();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        const std::shared_ptr<NetResolutionController> spNetResolutionController;
+
+        DELETE_COPY(WNetResolutionController);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WNetResolutionController<TDatums>::WNetResolutionController(
+        const std::shared_ptr<NetResolutionController>& netResolutionController) :
+        spNetResolutionController{netResolutionController}
+    {
+    }
+
+    template<typename TDatums>
+    WNetResolutionController<TDatums>::~WNetResolutionController()
+    {
+    }
+
+    template<typename TDatums>
+    void WNetResolutionController<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WNetResolutionController<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
+                // Frame latency
+                auto numberPeople = 0;
+                for (const auto& tDatumPtr : *tDatums)
+                    numberPeople = fastMax(numberPeople, tDatumPtr->poseKeypoints.getSize(0));
+                spNetResolutionController->frameFinished(tDatums->at(0)->id, numberPeople);
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WNetResolutionController);
+}
+
+#endif // OPENPOSE_CORE_W_NET_RESOLUTION_CONTROLLER_HPP
@@ -2,6 +2,7 @@
 #define OPENPOSE_CORE_W_SCALE_AND_SIZE_EXTRACTOR_HPP
 
 #include <openpose/core/common.hpp>
+#include <openpose/core/netResolutionController.hpp>
 #include <openpose/core/scaleAndSizeExtractor.hpp>
 #include <openpose/thread/worker.hpp>
 
@@ -11,7 +12,13 @@ namespace op
     class WScaleAndSizeExtractor : public Worker<TDatums>
     {
     public:
-        explicit WScaleAndSizeExtractor(const std::shared_ptr<ScaleAndSizeExtractor>& scaleAndSizeExtractor);
+        /**
+         * @param netResolutionController Optional. If not nullptr, the network input resolution of each frame is the
+         * one chosen by it (rather than a fixed one), and the frame latency starts being measured here.
+         */
+        explicit WScaleAndSizeExtractor(
+            const std::shared_ptr<ScaleAndSizeExtractor>& scaleAndSizeExtractor,
+            const std::shared_ptr<NetResolutionController>& netResolutionController = nullptr);
 
         virtual ~WScaleAndSizeExtractor();
 
@@ -21,6 +28,10 @@ namespace op
 
     private:
         const std::shared_ptr<ScaleAndSizeExtractor> spScaleAndSizeExtractor;
+        const std::shared_ptr<NetResolutionController> spNetResolutionController;
+        bool mNetInputSizesSet;
+
+        void setNetInputSizes(const Point<int>& inputSize);
 
         DELETE_COPY(WScaleAndSizeExtractor);
     };
@@ -36,8 +47,11 @@ namespace op
 {
     template<typename TDatums>
     WScaleAndSizeExtractor<TDatums>::WScaleAndSizeExtractor(
-        const std::shared_ptr<ScaleAndSizeExtractor>& scaleAndSizeExtractor) :
-        spScaleAndSizeExtractor{scaleAndSizeExtractor}
+        const std::shared_ptr<ScaleAndSizeExtractor>& scaleAndSizeExtractor,
+        const std::shared_ptr<NetResolutionController>& netResolutionController) :
+        spScaleAndSizeExtractor{scaleAndSizeExtractor},
+        spNetResolutionController{netResolutionController},
+        mNetInputSizesSet{false}
     {
     }
 
@@ -61,13 +75,32 @@ namespace op
                 // Debugging log
                 opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
-                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
+                // Adaptive network resolution
+                if (spNetResolutionController != nullptr)
+                {
+                    if (!mNetInputSizesSet)
+                        setNetInputSizes(tDatums->at(0)->getInputSize());
+                    spScaleAndSizeExtractor->setNetInputResolution(
+                        spNetResolutionController->getNetInputResolution());
+                    spNetResolutionController->frameStarted(tDatums->at(0)->id);
+                }
                 // cv::Mat -> float*
                 for (auto& tDatumPtr : *tDatums)
                 {
-                    const Point<int> inputSize{tDatumPtr->cvInputData.cols(), tDatumPtr->cvInputData.rows()};
+                    const auto inputSize = tDatumPtr->getInputSize();
                     std::tie(tDatumPtr->scaleInputToNetInputs, tDatumPtr->netInputSizes, tDatumPtr->scaleInputToOutput,
                         tDatumPtr->netOutputSize) = spScaleAndSizeExtractor->extract(inputSize);
+                    // Static region of interest: The network only processes its bounding box (see CvMatToOpInput),
+                    // while the output resolution still refers to the whole image
+                    if (!tDatumPtr->inputRoi.empty())
+                    {
+                        const auto inputRoiRectangle = tDatumPtr->getInputRoiRectangle();
+                        std::tie(tDatumPtr->scaleInputToNetInputs, tDatumPtr->netInputSizes, std::ignore, std::ignore)
+                            = spScaleAndSizeExtractor->extract(
+                                Point<int>{inputRoiRectangle.width, inputRoiRectangle.height});
+                    }
                 }
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
@@ -84,6 +117,27 @@ namespace op
         }
     }
 
+    template<typename TDatums>
+    void WScaleAndSizeExtractor<TDatums>::setNetInputSizes(const Point<int>& inputSize)
+    {
+        try
+        {
+            // Network input sizes of each resolution, so the GPU workers can reshape their networks in advance
+            std::vector<std::vector<Point<int>>> netInputSizes;
+            for (const auto& netInputResolution : spNetResolutionController->getNetInputResolutions())
+            {
+                spScaleAndSizeExtractor->setNetInputResolution(netInputResolution);
+                netInputSizes.emplace_back(std::get<1>(spScaleAndSizeExtractor->extract(inputSize)));
+            }
+            spNetResolutionController->setNetInputSizes(netInputSizes);
+            mNetInputSizesSet = true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     COMPILE_TEMPLATE_DATUM(WScaleAndSizeExtractor);
 }
 
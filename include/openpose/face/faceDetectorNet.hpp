@@ -0,0 +1,53 @@
+#ifndef OPENPOSE_FACE_FACE_DETECTOR_NET_HPP
+#define OPENPOSE_FACE_FACE_DETECTOR_NET_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * CNN-based face rectangle detector, alternative to FaceDetectorOpenCV when the body is not detected. It runs a
+     * small fully convolutional network (center-based, e.g., CenterFace) through the Net abstraction: TensorRT (or
+     * OpenVINO) if `face/face_detector.onnx` exists in the model folder, Caffe otherwise
+     * (`face/face_detector_deploy.prototxt` and `face/face_detector.caffemodel`).
+     * The network input follows the OpenPose body networks (see CvMatToOpInput). Its output (last blob, named
+     * `net_output` in the ONNX model) is {#scales, 5, netInputHeight/stride, netInputWidth/stride}: face center score
+     * (in the range [0, 1]), log(height/stride), log(width/stride), and the y and x offsets of the center (in output
+     * cells, i.e., the concatenated heat map, scale, and offset outputs of CenterFace).
+     * All the scales are batched into a single forward pass, each one padded into netInputSize.
+     * Not thread-safe, 1 instance per thread (e.g., per GPU).
+     */
+    class OP_API FaceDetectorNet
+    {
+    public:
+        /**
+         * @param netInputSize Network input resolution of each scale. A -1 dimension is computed from the first
+         * frame, keeping its aspect ratio (as a multiple of 32).
+         * @param numberScales Number of scales. Scale i shrinks the frame into netInputSize by scaleGap^i, i.e.,
+         * additional scales detect faces larger than the receptive field of the network.
+         * @param scoreThreshold Minimum face center score.
+         * @param precision TensorRT or OpenVINO precision (32, 16 or 8) of the ONNX model.
+         */
+        explicit FaceDetectorNet(
+            const std::string& modelFolder, const int gpuId = 0, const Point<int>& netInputSize = Point<int>{-1, 256},
+            const int numberScales = 1, const float scaleGap = 0.5f, const float scoreThreshold = 0.5f,
+            const int precision = 16, const bool enableGoogleLogging = true);
+
+        virtual ~FaceDetectorNet();
+
+        void initializationOnThread();
+
+        // No thread-save
+        std::vector<Rectangle<float>> detectFaces(const Matrix& inputData);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplFaceDetectorNet;
+        std::unique_ptr<ImplFaceDetectorNet> upImpl;
+
+        DELETE_COPY(FaceDetectorNet);
+    };
+}
+
+#endif // OPENPOSE_FACE_FACE_DETECTOR_NET_HPP
@@ -3,7 +3,9 @@
 
 #include <openpose/core/common.hpp>
 #include <openpose/core/enumClasses.hpp>
+#include <openpose/gpu/gpuMemoryBudget.hpp>
 #include <openpose/face/faceExtractorNet.hpp>
+#include <openpose/net/netMemoryArena.hpp>
 
 namespace op
 {
@@ -17,12 +19,18 @@ namespace op
          * Constructor of the FaceExtractor class.
          * @param netInputSize Size at which the cropped image (where the face is located) is resized.
          * @param netOutputSize Size of the final results. At the moment, it must be equal than netOutputSize.
+         * @param adaptiveCropSize If true, each face is cropped at the smallest of 128, 256, and netInputSize that
+         * is not smaller than its rectangle (see getRoiCropSide()), rather than always at netInputSize. Ignored if
+         * heatMapTypes is not empty (the heat maps of all the faces must have the same size).
+         * @param netMemoryArena If not nullptr, the intermediate blobs of the network are placed into it (see
+         * NetCaffe).
          */
         FaceExtractorCaffe(const Point<int>& netInputSize, const Point<int>& netOutputSize,
                            const std::string& modelFolder, const int gpuId,
                            const std::vector<HeatMapType>& heatMapTypes = {},
                            const ScaleMode heatMapScaleMode = ScaleMode::ZeroToOneFixedAspect,
-                           const bool enableGoogleLogging = true);
+                           const bool enableGoogleLogging = true, const bool adaptiveCropSize = false,
+                           const std::shared_ptr<NetMemoryArena>& netMemoryArena = nullptr);
 
         virtual ~FaceExtractorCaffe();
 
@@ -32,6 +40,11 @@ namespace op
          */
         void netInitializationOnThread();
 
+        /**
+         * It releases the network and its GPU memory (see FaceExtractorNet::setLazyLoading()).
+         */
+        void netReleaseOnThread();
+
         /**
          * This function extracts the face keypoints for each detected face in the image.
          * @param faceRectangles location of the faces in the image. It is a length-variable std::vector, where
@@ -42,6 +55,14 @@ namespace op
          */
         void forwardPass(const std::vector<Rectangle<float>>& faceRectangles, const Matrix& inputData);
 
+        /**
+         * Projected GPU memory (see gpuMemoryBudget.hpp) of each FaceExtractorCaffe: the model weights, the network
+         * blobs and heat maps of a full batch of FACE_MAX_BATCH_SIZE crops, and the input frame it crops them from.
+         * @param inputSize Size of the input frames.
+         */
+        static GpuMemoryFootprint getGpuMemoryFootprint(
+            const Point<int>& netInputSize, const std::string& modelFolder, const Point<int>& inputSize);
+
     private:
         // PIMPL idiom
         // http://www.cppsamples.com/common-tasks/pimpl.html
@@ -2,6 +2,7 @@
 #define OPENPOSE_FACE_FACE_EXTRACTOR_HPP
 
 #include <atomic>
+#include <chrono>
 #include <openpose/core/common.hpp>
 #include <openpose/core/enumClasses.hpp>
 
@@ -57,8 +58,21 @@ namespace op
 
         bool getEnabled() const;
 
+        /**
+         * It enables or disables the face keypoint detection (it can be called from any thread). If it is disabled
+         * before initializationOnThread(), the network is not loaded until it is enabled (lazy loading).
+         */
         void setEnabled(const bool enabled);
 
+        /**
+         * Lazy loading policy. It must be called before initializationOnThread().
+         * @param idleSeconds If 0 or positive, the network is not loaded on initializationOnThread() but on the
+         * first frame with any face to be processed. If positive, it is also released (freeing its GPU memory) once
+         * no face has been processed for idleSeconds, and loaded again on the next one. Negative (default) loads it
+         * on initializationOnThread() and never releases it.
+         */
+        void setLazyLoading(const double idleSeconds);
+
     protected:
         const Point<int> mNetOutputSize;
         Array<float> mFaceImageCrop;
@@ -72,9 +86,27 @@ namespace op
 
         virtual void netInitializationOnThread() = 0;
 
+        /**
+         * It releases what netInitializationOnThread() loaded (e.g., the network and its GPU memory), so it can be
+         * run again later. By default, it does nothing.
+         */
+        virtual void netReleaseOnThread();
+
+        /**
+         * Whether the network can run on this frame. If it is enabled and netNeeded (i.e., there is any face to be
+         * processed), it also runs netInitializationOnThread() if the network is not loaded (lazy loading, or
+         * disabled on initializationOnThread()). Otherwise, it releases the network if it has been idle for longer
+         * than the setLazyLoading() time. It must be called from the thread of initializationOnThread(), i.e., at
+         * the beginning of forwardPass().
+         */
+        bool isNetReady(const bool netNeeded);
+
     private:
         // Init with thread
         std::thread::id mThreadId;
+        bool mNetInitialized;
+        double mLazyIdleSeconds;
+        std::chrono::steady_clock::time_point mLastNetUse;
 
         void checkThread() const;
 
@@ -22,8 +22,14 @@ namespace op
 
     // Constant parameters
     const auto FACE_CCN_DECREASE_FACTOR = 8.f;
+    // Maximum number of faces per network forward pass (the network memory grows linearly with it)
+    const auto FACE_MAX_BATCH_SIZE = 8;
     const std::string FACE_PROTOTXT{"face/pose_deploy.prototxt"};
     const std::string FACE_TRAINED_MODEL{"face/pose_iter_116000.caffemodel"};
+    // CNN face rectangle detector (FaceDetectorNet), ONNX model if it exists, Caffe model otherwise
+    const std::string FACE_DETECTOR_ONNX_MODEL{"face/face_detector.onnx"};
+    const std::string FACE_DETECTOR_PROTOTXT{"face/face_detector_deploy.prototxt"};
+    const std::string FACE_DETECTOR_TRAINED_MODEL{"face/face_detector.caffemodel"};
 
     // Rendering parameters
     const auto FACE_DEFAULT_ALPHA_KEYPOINT = POSE_DEFAULT_ALPHA_KEYPOINT;
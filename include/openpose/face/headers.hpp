@@ -3,6 +3,7 @@
 
 // face module
 #include <openpose/face/faceDetector.hpp>
+#include <openpose/face/faceDetectorNet.hpp>
 #include <openpose/face/faceDetectorOpenCV.hpp>
 #include <openpose/face/faceExtractorCaffe.hpp>
 #include <openpose/face/faceExtractorNet.hpp>
@@ -11,7 +12,9 @@
 #include <openpose/face/faceGpuRenderer.hpp>
 #include <openpose/face/faceRenderer.hpp>
 #include <openpose/face/renderFace.hpp>
+#include <openpose/face/wFaceAndHandExtractorNet.hpp>
 #include <openpose/face/wFaceDetector.hpp>
+#include <openpose/face/wFaceDetectorNet.hpp>
 #include <openpose/face/wFaceDetectorOpenCV.hpp>
 #include <openpose/face/wFaceExtractorNet.hpp>
 #include <openpose/face/wFaceRenderer.hpp>
@@ -0,0 +1,318 @@
+#ifndef OPENPOSE_FACE_W_FACE_AND_HAND_EXTRACTOR_NET_HPP
+#define OPENPOSE_FACE_W_FACE_AND_HAND_EXTRACTOR_NET_HPP
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <openpose/core/common.hpp>
+#include <openpose/core/keypointRoiCache.hpp>
+#include <openpose/face/faceExtractorNet.hpp>
+#include <openpose/hand/handExtractorNet.hpp>
+#include <openpose/pose/body135FaceHand.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    /**
+     * It replaces WFaceExtractorNet + WHandExtractorNet, running the face and hand keypoint extractors at the same
+     * time rather than one after the other, so the latency of both is the maximum of them rather than their sum.
+     * The face one is initialized and run on its own std::thread (Caffe keeps a context per thread), while the hand
+     * one runs on the thread of this Worker. Both must be placed after their face and hand detectors.
+     */
+    template<typename TDatums>
+    class WFaceAndHandExtractorNet : public Worker<TDatums>
+    {
+    public:
+        /**
+         * @param faceRoiCache Optional. Analogous to the roiCache of WFaceExtractorNet.
+         * @param handRoiCache Optional. Analogous to the roiCache of WHandExtractorNet.
+         * @param body135FaceHand Optional. Analogous to the body135FaceHand of WFaceExtractorNet and
+         * WHandExtractorNet.
+         */
+        explicit WFaceAndHandExtractorNet(
+            const std::shared_ptr<FaceExtractorNet>& faceExtractorNet,
+            const std::shared_ptr<HandExtractorNet>& handExtractorNet,
+            const std::shared_ptr<KeypointRoiCache>& faceRoiCache = nullptr,
+            const std::shared_ptr<KeypointRoiCache>& handRoiCache = nullptr,
+            const std::shared_ptr<Body135FaceHand>& body135FaceHand = nullptr);
+
+        virtual ~WFaceAndHandExtractorNet();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+        /**
+         * Skipped if no Datum has face nor hand rectangles and there are no ROI caches, see
+         * Worker::isSkippable().
+         */
+        bool isSkippable(const TDatums& tDatums) const;
+
+    private:
+        std::shared_ptr<FaceExtractorNet> spFaceExtractorNet;
+        std::shared_ptr<HandExtractorNet> spHandExtractorNet;
+        const std::shared_ptr<KeypointRoiCache> spFaceRoiCache;
+        const std::shared_ptr<KeypointRoiCache> spHandRoiCache;
+        const std::shared_ptr<Body135FaceHand> spBody135FaceHand;
+        // Face thread
+        std::thread mFaceThread;
+        std::mutex mFaceMutex;
+        std::condition_variable mFaceConditionVariable;
+        std::function<void()> mFaceJob;
+        bool mFaceJobDone;
+        bool mFaceThreadStop;
+        std::string mFaceErrorMessage;
+
+        void faceThreadFunction();
+
+        void runOnFaceThread(const std::function<void()>& faceJob);
+
+        // It returns the error message of the face job (empty if none)
+        std::string waitForFaceThread();
+
+        DELETE_COPY(WFaceAndHandExtractorNet);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WFaceAndHandExtractorNet<TDatums>::WFaceAndHandExtractorNet(
+        const std::shared_ptr<FaceExtractorNet>& faceExtractorNet,
+        const std::shared_ptr<HandExtractorNet>& handExtractorNet,
+        const std::shared_ptr<KeypointRoiCache>& faceRoiCache,
+        const std::shared_ptr<KeypointRoiCache>& handRoiCache,
+        const std::shared_ptr<Body135FaceHand>& body135FaceHand) :
+        spFaceExtractorNet{faceExtractorNet},
+        spHandExtractorNet{handExtractorNet},
+        spFaceRoiCache{faceRoiCache},
+        spHandRoiCache{handRoiCache},
+        spBody135FaceHand{body135FaceHand},
+        mFaceJobDone{true},
+        mFaceThreadStop{false}
+    {
+    }
+
+    template<typename TDatums>
+    WFaceAndHandExtractorNet<TDatums>::~WFaceAndHandExtractorNet()
+    {
+        try
+        {
+            {
+                const std::lock_guard<std::mutex> lock{mFaceMutex};
+                mFaceThreadStop = true;
+            }
+            mFaceConditionVariable.notify_all();
+            if (mFaceThread.joinable())
+                mFaceThread.join();
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void WFaceAndHandExtractorNet<TDatums>::initializationOnThread()
+    {
+        try
+        {
+            if (!mFaceThread.joinable())
+                mFaceThread = std::thread{&WFaceAndHandExtractorNet::faceThreadFunction, this};
+            // Both networks are also initialized at the same time
+            runOnFaceThread([this]{ spFaceExtractorNet->initializationOnThread(); });
+            std::string handErrorMessage;
+            try
+            {
+                spHandExtractorNet->initializationOnThread();
+            }
+            catch (const std::exception& e)
+            {
+                handErrorMessage = e.what();
+            }
+            const auto faceErrorMessage = waitForFaceThread();
+            if (!faceErrorMessage.empty() || !handErrorMessage.empty())
+                error(faceErrorMessage.empty() ? handErrorMessage : faceErrorMessage,
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void WFaceAndHandExtractorNet<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
+                // Extract people face (on the face thread)
+                runOnFaceThread([this, &tDatums]
+                {
+                    for (auto i = 0u ; i < tDatums->size() ; i++)
+                    {
+                        auto& tDatumPtr = (*tDatums)[i];
+                        const auto faceRectangles = (spBody135FaceHand == nullptr
+                            ? tDatumPtr->faceRectangles
+                            : spBody135FaceHand->select(tDatumPtr->faceRectangles, tDatumPtr->poseKeypoints));
+                        if (spFaceRoiCache == nullptr)
+                            spFaceExtractorNet->forwardPass(faceRectangles, tDatumPtr->cvInputData);
+                        else
+                            spFaceExtractorNet->forwardPass(
+                                spFaceRoiCache->select(faceRectangles, tDatumPtr->poseIds, i), tDatumPtr->cvInputData);
+                        tDatumPtr->faceHeatMaps = spFaceExtractorNet->getHeatMaps().clone();
+                        tDatumPtr->faceKeypoints = spFaceExtractorNet->getFaceKeypoints().clone();
+                        if (spFaceRoiCache != nullptr)
+                            spFaceRoiCache->update(tDatumPtr->faceKeypoints, faceRectangles, tDatumPtr->poseIds, i);
+                        if (spBody135FaceHand != nullptr)
+                            spBody135FaceHand->update(
+                                tDatumPtr->faceKeypoints, tDatumPtr->faceRectangles, tDatumPtr->poseKeypoints);
+                    }
+                });
+                // Extract people hands (meanwhile, they only write different Datum members)
+                std::string handErrorMessage;
+                try
+                {
+                    for (auto i = 0u ; i < tDatums->size() ; i++)
+                    {
+                        auto& tDatumPtr = (*tDatums)[i];
+                        const auto handRectangles = (spBody135FaceHand == nullptr
+                            ? tDatumPtr->handRectangles
+                            : spBody135FaceHand->select(tDatumPtr->handRectangles, tDatumPtr->poseKeypoints));
+                        if (spHandRoiCache == nullptr)
+                            spHandExtractorNet->forwardPass(handRectangles, tDatumPtr->cvInputData);
+                        else
+                            spHandExtractorNet->forwardPass(
+                                spHandRoiCache->select(handRectangles, tDatumPtr->poseIds, i), tDatumPtr->cvInputData);
+                        for (auto hand = 0 ; hand < 2 ; hand++)
+                        {
+                            tDatumPtr->handHeatMaps[hand] = spHandExtractorNet->getHeatMaps()[hand].clone();
+                            tDatumPtr->handKeypoints[hand] = spHandExtractorNet->getHandKeypoints()[hand].clone();
+                        }
+                        if (spHandRoiCache != nullptr)
+                            spHandRoiCache->update(tDatumPtr->handKeypoints, handRectangles, tDatumPtr->poseIds, i);
+                        if (spBody135FaceHand != nullptr)
+                            spBody135FaceHand->update(
+                                tDatumPtr->handKeypoints, tDatumPtr->handRectangles, tDatumPtr->poseKeypoints);
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    handErrorMessage = e.what();
+                }
+                // The face thread must be finished with tDatums before returning (even if the hand one failed)
+                const auto faceErrorMessage = waitForFaceThread();
+                if (!faceErrorMessage.empty() || !handErrorMessage.empty())
+                    error(faceErrorMessage.empty() ? handErrorMessage : faceErrorMessage,
+                          __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void WFaceAndHandExtractorNet<TDatums>::faceThreadFunction()
+    {
+        while (true)
+        {
+            std::function<void()> faceJob;
+            {
+                std::unique_lock<std::mutex> lock{mFaceMutex};
+                mFaceConditionVariable.wait(lock, [this]{ return mFaceThreadStop || mFaceJob != nullptr; });
+                if (mFaceThreadStop)
+                    return;
+                faceJob = std::move(mFaceJob);
+                mFaceJob = nullptr;
+            }
+            std::string errorMessage;
+            try
+            {
+                faceJob();
+            }
+            catch (const std::exception& e)
+            {
+                errorMessage = e.what();
+            }
+            {
+                const std::lock_guard<std::mutex> lock{mFaceMutex};
+                mFaceErrorMessage = errorMessage;
+                mFaceJobDone = true;
+            }
+            mFaceConditionVariable.notify_all();
+        }
+    }
+
+    template<typename TDatums>
+    void WFaceAndHandExtractorNet<TDatums>::runOnFaceThread(const std::function<void()>& faceJob)
+    {
+        try
+        {
+            {
+                const std::lock_guard<std::mutex> lock{mFaceMutex};
+                mFaceJob = faceJob;
+                mFaceJobDone = false;
+            }
+            mFaceConditionVariable.notify_all();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    std::string WFaceAndHandExtractorNet<TDatums>::waitForFaceThread()
+    {
+        std::unique_lock<std::mutex> lock{mFaceMutex};
+        mFaceConditionVariable.wait(lock, [this]{ return mFaceJobDone; });
+        return mFaceErrorMessage;
+    }
+
+    template<typename TDatums>
+    bool WFaceAndHandExtractorNet<TDatums>::isSkippable(const TDatums& tDatums) const
+    {
+        try
+        {
+            // No face nor hand rectangles, so no face nor hand keypoints
+            if (spFaceRoiCache != nullptr || spHandRoiCache != nullptr || !checkNoNullNorEmpty(tDatums))
+                return false;
+            for (const auto& tDatumPtr : *tDatums)
+                if (!tDatumPtr->faceRectangles.empty() || !tDatumPtr->handRectangles.empty())
+                    return false;
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WFaceAndHandExtractorNet);
+}
+
+#endif // OPENPOSE_FACE_W_FACE_AND_HAND_EXTRACTOR_NET_HPP
@@ -19,6 +19,11 @@ namespace op
 
         void work(TDatums& tDatums);
 
+        /**
+         * Skipped if no Datum has body keypoints (no face rectangles), see Worker::isSkippable().
+         */
+        bool isSkippable(const TDatums& tDatums) const;
+
     private:
         std::shared_ptr<FaceDetector> spFaceDetector;
 
@@ -60,7 +65,8 @@ namespace op
                 // Debugging log
                 opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
-                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
                 // Detect people face
                 for (auto& tDatumPtr : *tDatums)
                     tDatumPtr->faceRectangles = spFaceDetector->detectFaces(tDatumPtr->poseKeypoints);
@@ -79,6 +85,26 @@ namespace op
         }
     }
 
+    template<typename TDatums>
+    bool WFaceDetector<TDatums>::isSkippable(const TDatums& tDatums) const
+    {
+        try
+        {
+            // No people, so no face rectangles
+            if (!checkNoNullNorEmpty(tDatums))
+                return false;
+            for (const auto& tDatumPtr : *tDatums)
+                if (!tDatumPtr->poseKeypoints.empty())
+                    return false;
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
     COMPILE_TEMPLATE_DATUM(WFaceDetector);
 }
 
@@ -2,7 +2,9 @@
 #define OPENPOSE_FACE_W_FACE_DETECTOR_NET_HPP
 
 #include <openpose/core/common.hpp>
+#include <openpose/core/keypointRoiCache.hpp>
 #include <openpose/face/faceRenderer.hpp>
+#include <openpose/pose/body135FaceHand.hpp>
 #include <openpose/thread/worker.hpp>
 
 namespace op
@@ -11,7 +13,16 @@ namespace op
     class WFaceExtractorNet : public Worker<TDatums>
     {
     public:
-        explicit WFaceExtractorNet(const std::shared_ptr<FaceExtractorNet>& faceExtractorNet);
+        /**
+         * @param roiCache Optional. If not nullptr, the faces of the people whose last keypoints can be reused (see
+         * KeypointRoiCache) skip the face network.
+         * @param body135FaceHand Optional. If not nullptr, the faces of the people whose BODY_135 face keypoints are
+         * confident (see Body135FaceHand) are filled from them and skip the face network.
+         */
+        explicit WFaceExtractorNet(
+            const std::shared_ptr<FaceExtractorNet>& faceExtractorNet,
+            const std::shared_ptr<KeypointRoiCache>& roiCache = nullptr,
+            const std::shared_ptr<Body135FaceHand>& body135FaceHand = nullptr);
 
         virtual ~WFaceExtractorNet();
 
@@ -19,8 +30,16 @@ namespace op
 
         void work(TDatums& tDatums);
 
+        /**
+         * Skipped if no Datum has face rectangles and there is no roiCache (whose update() removes the people
+         * not found), see Worker::isSkippable().
+         */
+        bool isSkippable(const TDatums& tDatums) const;
+
     private:
         std::shared_ptr<FaceExtractorNet> spFaceExtractorNet;
+        const std::shared_ptr<KeypointRoiCache> spRoiCache;
+        const std::shared_ptr<Body135FaceHand> spBody135FaceHand;
 
         DELETE_COPY(WFaceExtractorNet);
     };
@@ -35,8 +54,13 @@ namespace op
 namespace op
 {
     template<typename TDatums>
-    WFaceExtractorNet<TDatums>::WFaceExtractorNet(const std::shared_ptr<FaceExtractorNet>& faceExtractorNet) :
-        spFaceExtractorNet{faceExtractorNet}
+    WFaceExtractorNet<TDatums>::WFaceExtractorNet(
+        const std::shared_ptr<FaceExtractorNet>& faceExtractorNet,
+        const std::shared_ptr<KeypointRoiCache>& roiCache,
+        const std::shared_ptr<Body135FaceHand>& body135FaceHand) :
+        spFaceExtractorNet{faceExtractorNet},
+        spRoiCache{roiCache},
+        spBody135FaceHand{body135FaceHand}
     {
     }
 
@@ -61,13 +85,29 @@ namespace op
                 // Debugging log
                 opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
-                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
                 // Extract people face
-                for (auto& tDatumPtr : *tDatums)
+                for (auto i = 0u ; i < tDatums->size() ; i++)
                 {
-                    spFaceExtractorNet->forwardPass(tDatumPtr->faceRectangles, tDatumPtr->cvInputData);
+                    auto& tDatumPtr = (*tDatums)[i];
+                    // BODY_135: The faces whose BODY_135 face keypoints are confident skip the network
+                    const auto faceRectangles = (spBody135FaceHand == nullptr
+                        ? tDatumPtr->faceRectangles
+                        : spBody135FaceHand->select(tDatumPtr->faceRectangles, tDatumPtr->poseKeypoints));
+                    // ROI cache: The faces whose last keypoints are reused skip the network
+                    if (spRoiCache == nullptr)
+                        spFaceExtractorNet->forwardPass(faceRectangles, tDatumPtr->cvInputData);
+                    else
+                        spFaceExtractorNet->forwardPass(
+                            spRoiCache->select(faceRectangles, tDatumPtr->poseIds, i), tDatumPtr->cvInputData);
                     tDatumPtr->faceHeatMaps = spFaceExtractorNet->getHeatMaps().clone();
                     tDatumPtr->faceKeypoints = spFaceExtractorNet->getFaceKeypoints().clone();
+                    if (spRoiCache != nullptr)
+                        spRoiCache->update(tDatumPtr->faceKeypoints, faceRectangles, tDatumPtr->poseIds, i);
+                    if (spBody135FaceHand != nullptr)
+                        spBody135FaceHand->update(
+                            tDatumPtr->faceKeypoints, tDatumPtr->faceRectangles, tDatumPtr->poseKeypoints);
                 }
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
@@ -84,6 +124,26 @@ namespace op
         }
     }
 
+    template<typename TDatums>
+    bool WFaceExtractorNet<TDatums>::isSkippable(const TDatums& tDatums) const
+    {
+        try
+        {
+            // No face rectangles, so no face keypoints nor heat maps
+            if (spRoiCache != nullptr || !checkNoNullNorEmpty(tDatums))
+                return false;
+            for (const auto& tDatumPtr : *tDatums)
+                if (!tDatumPtr->faceRectangles.empty())
+                    return false;
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
     COMPILE_TEMPLATE_DATUM(WFaceExtractorNet);
 }
 
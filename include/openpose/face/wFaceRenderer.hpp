@@ -2,6 +2,7 @@
 #define OPENPOSE_FACE_W_FACE_RENDERER_HPP
 
 #include <openpose/core/common.hpp>
+#include <openpose/core/gpuRenderer.hpp>
 #include <openpose/face/faceRenderer.hpp>
 #include <openpose/thread/worker.hpp>
 
@@ -19,8 +20,16 @@ namespace op
 
         void work(TDatums& tDatums);
 
+        /**
+         * Skipped if no Datum has face keypoints and it renders on the CPU (the GPU renderers must always run,
+         * the last one downloads the image shared with the other renderers), see Worker::isSkippable().
+         */
+        bool isSkippable(const TDatums& tDatums) const;
+
     private:
         std::shared_ptr<FaceRenderer> spFaceRenderer;
+        // Same object than spFaceRenderer if it renders on the GPU, nullptr otherwise
+        GpuRenderer* const pGpuRenderer;
 
         DELETE_COPY(WFaceRenderer);
     };
@@ -36,7 +45,8 @@ namespace op
 {
     template<typename TDatums>
     WFaceRenderer<TDatums>::WFaceRenderer(const std::shared_ptr<FaceRenderer>& faceRenderer) :
-        spFaceRenderer{faceRenderer}
+        spFaceRenderer{faceRenderer},
+        pGpuRenderer{dynamic_cast<GpuRenderer*>(faceRenderer.get())}
     {
     }
 
@@ -61,11 +71,18 @@ namespace op
                 // Debugging log
                 opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
-                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
                 // Render people face
                 for (auto& tDatumPtr : *tDatums)
+                {
+                    if (pGpuRenderer != nullptr)
+                        pGpuRenderer->setRenderTargetGpu(&tDatumPtr->outputDataGpu);
                     spFaceRenderer->renderFace(
                         tDatumPtr->outputData, tDatumPtr->faceKeypoints, (float)tDatumPtr->scaleInputToOutput);
+                }
+                if (pGpuRenderer != nullptr)
+                    pGpuRenderer->setRenderTargetGpu(nullptr);
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
                 Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
@@ -81,6 +98,26 @@ namespace op
         }
     }
 
+    template<typename TDatums>
+    bool WFaceRenderer<TDatums>::isSkippable(const TDatums& tDatums) const
+    {
+        try
+        {
+            // No face keypoints, so nothing to draw
+            if (pGpuRenderer != nullptr || !checkNoNullNorEmpty(tDatums))
+                return false;
+            for (const auto& tDatumPtr : *tDatums)
+                if (!tDatumPtr->faceKeypoints.empty())
+                    return false;
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
     COMPILE_TEMPLATE_DATUM(WFaceRenderer);
 }
 
@@ -9,12 +9,18 @@
 
 namespace op
 {
+    /**
+     * BvhSaver writes the Adam poses into a BVH file while they are processed, so its memory does not grow with the
+     * length of the capture: every chunkFrames frames are converted and appended to the file by a background thread,
+     * and the frame count of its header is updated after each chunk.
+     */
     class OP_API BvhSaver
     {
     public:
         BvhSaver(const std::string bvhFilePath,
                  const std::shared_ptr<const TotalModel>& totalModel = nullptr,
-                 const double fps = 30.);
+                 const double fps = 30.,
+                 const int chunkFrames = 300);
 
         virtual ~BvhSaver();
 
@@ -0,0 +1,81 @@
+#ifndef OPENPOSE_FILESTREAM_COCO_EVALUATOR_HPP
+#define OPENPOSE_FILESTREAM_COCO_EVALUATOR_HPP
+
+#include <array>
+#include <openpose/core/common.hpp>
+#include <openpose/pose/enumClasses.hpp>
+
+namespace op
+{
+    /**
+     * CocoEvaluator computes the COCO keypoint accuracy of the body results (17 COCO keypoints) directly in C++,
+     * following the official COCOeval (pycocotools) with iouType = 'keypoints': OKS matching for the thresholds
+     * 0.5:0.05:0.95, 101 recall thresholds, and up to 20 detections per image. Thus, accuracy sweeps do not need to
+     * save the results and run the Python evaluation.
+     * Only the images given to addImage() or addResult() are evaluated (analogous to setting COCOeval.params.imgIds
+     * to the processed images). It is thread-safe.
+     */
+    class OP_API CocoEvaluator
+    {
+    public:
+        /**
+         * @param annotationsFilePath COCO keypoint annotations JSON file (e.g., person_keypoints_val2017.json).
+         */
+        explicit CocoEvaluator(const std::string& annotationsFilePath);
+
+        virtual ~CocoEvaluator();
+
+        /**
+         * Images without any result must also be added, so their ground truth counts as missed.
+         */
+        void addImage(const unsigned long long imageId);
+
+        /**
+         * @param keypoints 17 (x, y, visibility) keypoints in COCO order, as saved in the COCO JSON results (i.e.,
+         * x = y = -1 for the missing ones).
+         */
+        void addResult(const unsigned long long imageId, const std::vector<float>& keypoints, const float score);
+
+        /**
+         * Analogous to addResult() for all the people of poseKeypoints (e.g., the PoseExtractor output), converted
+         * into the COCO body keypoints as CocoJsonSaver does.
+         */
+        void addResults(
+            const unsigned long long imageId, const Array<float>& poseKeypoints, const Array<float>& poseScores,
+            const PoseModel poseModel);
+
+        /**
+         * It removes all the images and results (but not the annotations), e.g., to evaluate another setting.
+         */
+        void clear();
+
+        /**
+         * COCOeval.stats: AP, AP (OKS = 0.5), AP (OKS = 0.75), AP (medium), AP (large), AR, AR (OKS = 0.5),
+         * AR (OKS = 0.75), AR (medium), and AR (large). -1 if there is no ground truth to evaluate.
+         */
+        std::array<double, 10> evaluate() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplCocoEvaluator;
+        std::unique_ptr<ImplCocoEvaluator> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(CocoEvaluator);
+    };
+
+    /**
+     * Indexes of the 17 COCO body keypoints (in COCO order) in the keypoints of poseModel, or empty if it does not
+     * have them.
+     */
+    OP_API std::vector<int> getCocoBodyIndexes(const PoseModel poseModel, const int numberBodyParts);
+
+    /**
+     * Human-readable version of CocoEvaluator::evaluate(), in the same format as COCOeval.summarize().
+     */
+    OP_API std::string cocoStatsToString(const std::array<double, 10>& stats);
+}
+
+#endif // OPENPOSE_FILESTREAM_COCO_EVALUATOR_HPP
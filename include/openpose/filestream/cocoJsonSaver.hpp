@@ -1,7 +1,10 @@
 #ifndef OPENPOSE_FILESTREAM_POSE_JSON_COCO_SAVER_HPP
 #define OPENPOSE_FILESTREAM_POSE_JSON_COCO_SAVER_HPP
 
+#include <mutex>
+#include <thread>
 #include <openpose/core/common.hpp>
+#include <openpose/filestream/cocoEvaluator.hpp>
 #include <openpose/filestream/enumClasses.hpp>
 #include <openpose/pose/enumClasses.hpp>
 #include <openpose/filestream/jsonOfstream.hpp>
@@ -11,6 +14,10 @@ namespace op
     /**
      *  The CocoJsonSaver class creates a COCO validation json file with details about the processed images. It
      * inherits from Recorder.
+     * record() is thread-safe: the first thread writes directly into the final files, while each other thread
+     * streams its results into its own temporary shard files (`<file>.shard<N>.tmp`), which are appended into the
+     * final files (and removed) when the CocoJsonSaver is destroyed. Thus, the memory is bounded by the JsonOfstream
+     * buffers regardless of the number of images.
      */
     class OP_API CocoJsonSaver
     {
@@ -20,11 +27,13 @@ namespace op
          * constructor.
          * @param filePathToSave const std::string parameter with the final file path where the generated json file
          * will be saved.
+         * @param cocoEvaluator If not nullptr, the body results (CocoJsonFormat::Body) are also added into it, and
+         * its COCO accuracy is displayed when the CocoJsonSaver is destroyed.
          */
         explicit CocoJsonSaver(
             const std::string& filePathToSave, const PoseModel poseModel, const bool humanReadable = true,
             const int cocoJsonVariants = 1, const CocoJsonFormat cocoJsonFormat = CocoJsonFormat::Body,
-            const int cocoJsonVariant = 0);
+            const int cocoJsonVariant = 0, const std::shared_ptr<CocoEvaluator>& cocoEvaluator = nullptr);
 
         virtual ~CocoJsonSaver();
 
@@ -33,9 +42,19 @@ namespace op
             const unsigned long long frameNumber);
 
     private:
+        struct CocoJsonShard;
+
         const PoseModel mPoseModel;
         const int mCocoJsonVariant;
-        std::vector<std::tuple<JsonOfstream, CocoJsonFormat, bool>> mJsonOfstreams;
+        const bool mHumanReadable;
+        const std::shared_ptr<CocoEvaluator> spCocoEvaluator;
+        // Final file path and format of each COCO JSON file
+        std::vector<std::pair<std::string, CocoJsonFormat>> mFiles;
+        std::mutex mShardsMutex;
+        // Thread and shard, being the first one the final files
+        std::vector<std::pair<std::thread::id, std::unique_ptr<CocoJsonShard>>> mShards;
+
+        CocoJsonShard& getShard();
 
         DELETE_COPY(CocoJsonSaver);
     };
@@ -0,0 +1,57 @@
+#ifndef OPENPOSE_FILESTREAM_DATUM_RECEIVER_HPP
+#define OPENPOSE_FILESTREAM_DATUM_RECEIVER_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * DatumReceiver listens to a TCP port and receives the frame sets of a DatumSender of another process (see
+     * filestream/datumWireFormat.hpp). It accepts a single sender, and it finishes once that one ends (or closes its
+     * connection).
+     * It grants the sender window credits once connected, and then 1 per frame set once its last credit lease is
+     * released (see takeCredit()), so at most window frame sets are in the network or in the receiver pipeline.
+     * It is thread-safe, and the credit leases can outlive it.
+     */
+    class OP_API DatumReceiver
+    {
+    public:
+        /**
+         * @param address `[host:]port` to listen to, e.g., `9000` (all the interfaces) or `127.0.0.1:9000`.
+         * @param window Maximum number of frame sets sent but not finished yet by the receiver. At least 1.
+         */
+        explicit DatumReceiver(const std::string& address, const unsigned int window = 8u);
+
+        virtual ~DatumReceiver();
+
+        /**
+         * It waits up to timeoutMs for the next frame set (accepting the sender connection first if needed), and it
+         * returns whether it was received. If so, payload contains its numberDatums serialized Datums (see
+         * DatumSerializer::deserialize()).
+         */
+        bool receive(std::vector<char>& payload, unsigned int& numberDatums, const int timeoutMs);
+
+        /**
+         * Whether the sender finished (no more frame sets will be received).
+         */
+        bool isFinished() const;
+
+        /**
+         * It returns the credit lease of a received frame set: The credit is granted back to the sender once the last
+         * copy of the lease is released (e.g., the one in Datum::frameCredit, so once the receiver pipeline is done
+         * with that frame set).
+         */
+        std::shared_ptr<void> takeCredit();
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        // Shared with the credit leases, so they can be granted back after DatumReceiver is destroyed
+        struct ImplDatumReceiver;
+        std::shared_ptr<ImplDatumReceiver> spImpl;
+
+        DELETE_COPY(DatumReceiver);
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_DATUM_RECEIVER_HPP
@@ -0,0 +1,64 @@
+#ifndef OPENPOSE_FILESTREAM_DATUM_SENDER_HPP
+#define OPENPOSE_FILESTREAM_DATUM_SENDER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/filestream/enumClasses.hpp>
+
+namespace op
+{
+    /**
+     * DatumSender sends the selected fields of each frame set to a DatumReceiver of another process (on the same or
+     * another node) through TCP (see filestream/datumWireFormat.hpp), so the pipeline can be split across processes
+     * (e.g., decoding on a CPU node and the network inference on a GPU node).
+     * Flow control: It can only send as many frame sets as credits the receiver granted, i.e., its window minus the
+     * frame sets that the receiver pipeline has not finished yet. So a slower receiver slows down the sender rather
+     * than filling the memory of any of them.
+     */
+    class OP_API DatumSender
+    {
+    public:
+        /**
+         * @param address `host:port` of the DatumReceiver (e.g., `192.168.1.10:9000`).
+         * @param datumWireFields Fields sent, see DatumSerializer.
+         * @param jpegQuality JPEG quality of the frames (or 0 for raw frames), see DatumSerializer.
+         * @param connectionTimeoutSeconds It keeps retrying to connect for this long (so the receiver can be started
+         * after the sender).
+         */
+        DatumSender(
+            const std::string& address, const DatumWireField datumWireFields, const int jpegQuality = 90,
+            const double connectionTimeoutSeconds = 60.);
+
+        virtual ~DatumSender();
+
+        /**
+         * It waits up to timeoutMs for a credit of the receiver (connecting to it first if needed), and it returns
+         * whether there is one. It throws an error if the connection is lost or cannot be established.
+         */
+        bool waitForCredit(const int timeoutMs);
+
+        /**
+         * It sends the frame set (1 Datum per view) and it spends 1 credit (see waitForCredit()).
+         */
+        void send(const std::vector<const Datum*>& datums);
+
+        /**
+         * It tells the receiver that there are no more frames and it closes the connection (the destructor calls
+         * it as well).
+         */
+        void end();
+
+        DatumWireField getDatumWireFields() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplDatumSender;
+        std::unique_ptr<ImplDatumSender> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(DatumSender);
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_DATUM_SENDER_HPP
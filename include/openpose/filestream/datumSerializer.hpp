@@ -0,0 +1,46 @@
+#ifndef OPENPOSE_FILESTREAM_DATUM_SERIALIZER_HPP
+#define OPENPOSE_FILESTREAM_DATUM_SERIALIZER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/filestream/enumClasses.hpp>
+
+namespace op
+{
+    /**
+     * DatumSerializer converts the selected fields of a Datum into the binary format of DatumSender (see
+     * filestream/datumWireFormat.hpp) and back.
+     */
+    class OP_API DatumSerializer
+    {
+    public:
+        /**
+         * @param datumWireFields Fields to send (the ones not selected are not sent, so they are empty on the
+         * receiver).
+         * @param jpegQuality JPEG quality (1-100) of cvInputData and cvOutputData. If 0, they are sent raw (lossless).
+         */
+        explicit DatumSerializer(const DatumWireField datumWireFields, const int jpegQuality = 90);
+
+        virtual ~DatumSerializer();
+
+        /**
+         * It appends the Datum to buffer (DatumWireDatumHeader and its blocks).
+         * cvInputData must be on the CPU (i.e., call Datum::getCvInputData() first if it might only be on the GPU).
+         */
+        void serialize(std::vector<char>& buffer, const Datum& datum);
+
+        /**
+         * It fills datum with the Datum serialized at data (which must not be longer than maxBytes), and it returns
+         * its number of bytes. It throws an error if the data is not a valid serialized Datum.
+         */
+        static unsigned long long deserialize(Datum& datum, const char* const data, const unsigned long long maxBytes);
+
+    private:
+        const DatumWireField mDatumWireFields;
+        const int mJpegQuality;
+        std::vector<unsigned char> mJpegBuffer;
+
+        DELETE_COPY(DatumSerializer);
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_DATUM_SERIALIZER_HPP
@@ -0,0 +1,110 @@
+#ifndef OPENPOSE_FILESTREAM_DATUM_WIRE_FORMAT_HPP
+#define OPENPOSE_FILESTREAM_DATUM_WIRE_FORMAT_HPP
+
+#include <cstdint>
+
+namespace op
+{
+    // Wire format of DatumSender and DatumReceiver (see doc/advanced/distributed.md), i.e., a TCP stream of
+    // messages. All the values are in the native (little-endian) byte order, and every block is padded to 8 bytes.
+    // Message: DatumWireMessageHeader + payloadBytes of payload.
+    // - Datums (sender -> receiver): The frame set (value = number of Datums, i.e., views), each one as
+    //   DatumWireDatumHeader + the name (nameBytes, padded) + numberBlocks x (DatumWireBlockHeader + the padded data).
+    // - Credits (receiver -> sender): value = number of new Datums messages that the sender is allowed to send (flow
+    //   control, no payload). The receiver grants its whole window once connected, and then 1 credit per frame set
+    //   once its pipeline has finished with it.
+    // - End (sender -> receiver): The sender has no more frames (no payload).
+    // Unknown blocks are skipped, so new ones can be added without breaking older receivers.
+    const auto DATUM_WIRE_MAGIC = 0x4d57444fu; // "ODWM"
+    const auto DATUM_WIRE_VERSION = 1u;
+
+    enum class DatumWireMessage : uint32_t
+    {
+        Datums = 0,
+        Credits,
+        End,
+    };
+
+    struct DatumWireMessageHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t message; // DatumWireMessage
+        uint32_t value; // Number of Datums (Datums) or of credits (Credits)
+        uint64_t payloadBytes; // Not including this header
+    };
+
+    struct DatumWireDatumHeader
+    {
+        uint64_t id;
+        uint64_t subId;
+        uint64_t subIdMax;
+        uint64_t frameNumber;
+        uint64_t sourceId;
+        uint64_t sourceIdMax;
+        int32_t priority;
+        uint32_t fields; // DatumWireField sent
+        uint32_t numberBlocks;
+        uint32_t nameBytes;
+    };
+
+    enum class DatumWireBlock : uint32_t
+    {
+        // DatumWireField::Frame
+        CvInputData = 0, // Raw Matrix (rows, cols, channels)
+        CvInputDataJpeg, // JPEG file (its size in bytes)
+        CameraMatrix, // Raw Matrix
+        CameraExtrinsics,
+        CameraIntrinsics,
+        CameraDistortion,
+        // DatumWireField::NetInput
+        InputNetData, // Raw Array (sizes of the Array), index = scale
+        ScaleInputToNetInputs, // Float64 (number of scales)
+        NetInputSizes, // Int32 (number of scales, 2): width and height
+        NetScales, // Float64 (4): scaleInputToOutput, scaleNetToOutput and netOutputSize (width, height)
+        // DatumWireField::Keypoints
+        PoseKeypoints, // Raw Array
+        PoseIds,
+        PoseScores,
+        FaceRectangles, // Float32 (number of people, 4): x, y, width, height
+        FaceKeypoints,
+        HandRectangles, // Float32 (number of people, 2, 4): left and right hands
+        HandKeypoints, // index = 0 (left hand) or 1 (right hand)
+        // DatumWireField::Keypoints3D
+        PoseKeypoints3D,
+        FaceKeypoints3D,
+        HandKeypoints3D, // index = 0 (left hand) or 1 (right hand)
+        // DatumWireField::OutputFrame
+        CvOutputData,
+        CvOutputDataJpeg,
+    };
+
+    enum class DatumWireElement : uint32_t
+    {
+        UInt8 = 0,
+        Int32,
+        Int64,
+        Float32,
+        Float64,
+    };
+
+    // Maximum number of dimensions of a block
+    const auto DATUM_WIRE_MAX_DIMENSIONS = 6u;
+
+    struct DatumWireBlockHeader
+    {
+        uint32_t block; // DatumWireBlock
+        uint32_t element; // DatumWireElement
+        uint32_t index;
+        uint32_t numberDimensions;
+        int32_t sizes[DATUM_WIRE_MAX_DIMENSIONS]; // Unused ones are 0
+        uint64_t dataBytes; // Not including the padding
+    };
+
+    inline uint64_t datumWirePaddedBytes(const uint64_t bytes)
+    {
+        return (bytes + 7u) & ~(uint64_t)7u;
+    }
+}
+
+#endif // OPENPOSE_FILESTREAM_DATUM_WIRE_FORMAT_HPP
@@ -21,6 +21,42 @@ namespace op
         Car,
         Size,
     };
+
+    // Precision of the heat maps saved by HeatMapBinarySaver
+    enum class HeatMapPrecision : unsigned char
+    {
+        Float32, // Lossless
+        Float16, // IEEE half precision (~3 significant digits)
+        UInt8, // Linear quantization into [0, 255] between the minimum and maximum of each channel
+        Size,
+    };
+
+    /**
+     * Bit mask of the Datum fields sent by DatumSender (see filestream/datumWireFormat.hpp). The Datum IDs, name,
+     * frame number, source IDs and priority are always sent.
+     */
+    enum class DatumWireField : unsigned char
+    {
+        None = 0,
+        Frame = 1, // cvInputData and the camera parameters
+        NetInput = 2, // inputNetData, scaleInputToNetInputs, netInputSizes, scaleInputToOutput, netOutputSize and
+                      // scaleNetToOutput
+        Keypoints = 4, // poseKeypoints, poseIds, poseScores, faceRectangles, faceKeypoints, handRectangles and
+                       // handKeypoints
+        Keypoints3D = 8, // poseKeypoints3D, faceKeypoints3D and handKeypoints3D
+        OutputFrame = 16, // cvOutputData
+        All = 31,
+    };
+
+    inline DatumWireField operator|(const DatumWireField a, const DatumWireField b)
+    {
+        return DatumWireField((unsigned char)a | (unsigned char)b);
+    }
+
+    inline DatumWireField operator&(const DatumWireField a, const DatumWireField b)
+    {
+        return DatumWireField((unsigned char)a & (unsigned char)b);
+    }
 }
 
 #endif // OPENPOSE_FILESTREAM_ENUM_CLASSES_HPP
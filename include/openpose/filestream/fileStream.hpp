@@ -2,6 +2,7 @@
 #define OPENPOSE_FILESTREAM_FILE_STREAM_HPP
 
 #include <openpose/core/common.hpp>
+#include <openpose/core/datumTiming.hpp>
 #include <openpose/filestream/enumClasses.hpp>
 #include <openpose/utilities/openCv.hpp>
 
@@ -44,11 +45,30 @@ namespace op
         const Array<float>& keypoints, const std::vector<std::vector<std::array<float,3>>>& candidates,
         const std::string& keypointName, const std::string& fileName, const bool humanReadable);
 
-    // It will save a bunch of Array<float> elements
+    // It will save a bunch of Array<float> elements (and, if not empty, the timing record of the frame as `timing`,
+    // see DatumTiming)
     OP_API void savePeopleJson(
         const std::vector<std::pair<Array<float>, std::string>>& keypointVector,
         const std::vector<std::vector<std::array<float,3>>>& candidates, const std::string& fileName,
-        const bool humanReadable);
+        const bool humanReadable, const std::vector<DatumTimingEvent>& timingEvents = {});
+
+    // Analogous to savePeopleJson, but it appends the JSON text into jsonString rather than saving it
+    OP_API void peopleJsonToString(
+        std::string& jsonString, const std::vector<std::pair<Array<float>, std::string>>& keypointVector,
+        const std::vector<std::vector<std::array<float,3>>>& candidates, const bool humanReadable,
+        const std::vector<DatumTimingEvent>& timingEvents = {});
+
+    // Analogous to the savePeopleJson and peopleJsonToString above, but with the flat part candidates (see
+    // Datum::poseCandidatesArray and Datum::poseCandidatesOffsets)
+    OP_API void savePeopleJson(
+        const std::vector<std::pair<Array<float>, std::string>>& keypointVector, const Array<float>& candidates,
+        const std::vector<int>& candidateOffsets, const std::string& fileName, const bool humanReadable,
+        const std::vector<DatumTimingEvent>& timingEvents = {});
+
+    OP_API void peopleJsonToString(
+        std::string& jsonString, const std::vector<std::pair<Array<float>, std::string>>& keypointVector,
+        const Array<float>& candidates, const std::vector<int>& candidateOffsets, const bool humanReadable,
+        const std::vector<DatumTimingEvent>& timingEvents = {});
 
     // Save/load image
     OP_API void saveImage(
@@ -3,27 +3,48 @@
 
 // fileStream module
 #include <openpose/filestream/bvhSaver.hpp>
+#include <openpose/filestream/cocoEvaluator.hpp>
 #include <openpose/filestream/cocoJsonSaver.hpp>
+#include <openpose/filestream/datumReceiver.hpp>
+#include <openpose/filestream/datumSender.hpp>
+#include <openpose/filestream/datumSerializer.hpp>
+#include <openpose/filestream/datumWireFormat.hpp>
 #include <openpose/filestream/enumClasses.hpp>
 #include <openpose/filestream/fileSaver.hpp>
 #include <openpose/filestream/fileStream.hpp>
+#include <openpose/filestream/heatMapBinaryReader.hpp>
+#include <openpose/filestream/heatMapBinarySaver.hpp>
 #include <openpose/filestream/heatMapSaver.hpp>
 #include <openpose/filestream/imageSaver.hpp>
 #include <openpose/filestream/jsonOfstream.hpp>
+#include <openpose/filestream/keypointBinaryReader.hpp>
+#include <openpose/filestream/keypointBinarySaver.hpp>
 #include <openpose/filestream/keypointSaver.hpp>
+#include <openpose/filestream/keypointStreamer.hpp>
+#include <openpose/filestream/keypointStreamFormat.hpp>
+#include <openpose/filestream/keypointStreamReader.hpp>
+#include <openpose/filestream/metricsHttpExporter.hpp>
+#include <openpose/filestream/netOutputCache.hpp>
+#include <openpose/filestream/peopleJsonReader.hpp>
 #include <openpose/filestream/peopleJsonSaver.hpp>
 #include <openpose/filestream/udpSender.hpp>
 #include <openpose/filestream/videoSaver.hpp>
+#include <openpose/filestream/videoStreamer.hpp>
 #include <openpose/filestream/wBvhSaver.hpp>
 #include <openpose/filestream/wCocoJsonSaver.hpp>
+#include <openpose/filestream/wDatumReceiver.hpp>
+#include <openpose/filestream/wDatumSender.hpp>
 #include <openpose/filestream/wFaceSaver.hpp>
 #include <openpose/filestream/wHandSaver.hpp>
 #include <openpose/filestream/wImageSaver.hpp>
+#include <openpose/filestream/wKeypointBinarySaver.hpp>
+#include <openpose/filestream/wKeypointStreamer.hpp>
 #include <openpose/filestream/wHeatMapSaver.hpp>
 #include <openpose/filestream/wPeopleJsonSaver.hpp>
 #include <openpose/filestream/wPoseSaver.hpp>
 #include <openpose/filestream/wUdpSender.hpp>
 #include <openpose/filestream/wVideoSaver.hpp>
 #include <openpose/filestream/wVideoSaver3D.hpp>
+#include <openpose/filestream/wVideoStreamer.hpp>
 
 #endif // OPENPOSE_FILESTREAM_HEADERS_HPP
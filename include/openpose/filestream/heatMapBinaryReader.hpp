@@ -0,0 +1,50 @@
+#ifndef OPENPOSE_FILESTREAM_HEAT_MAP_BINARY_READER_HPP
+#define OPENPOSE_FILESTREAM_HEAT_MAP_BINARY_READER_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * HeatMapBinaryReader reads the files of HeatMapBinarySaver. Analogously to KeypointBinaryReader, the file is
+     * memory-mapped and only the frame headers are read when opening it, so any frame can be read in constant time.
+     * Reading Zstandard-compressed files requires OpenPose compiled with `WITH_ZSTD`.
+     */
+    class OP_API HeatMapBinaryReader
+    {
+    public:
+        explicit HeatMapBinaryReader(const std::string& filePath);
+
+        virtual ~HeatMapBinaryReader();
+
+        unsigned long long getNumberFrames() const;
+
+        /**
+         * It returns the name given to HeatMapBinarySaver::save() for the frameIndex-th frame.
+         */
+        std::string getFrameName(const unsigned long long frameIndex) const;
+
+        /**
+         * It fills heatMaps with the float heat maps of the frameIndex-th frame, each one with size
+         * [#channels x height x width] (the float16 and 8-bit ones are converted back into float). The sparse ones
+         * are converted into dense arrays (0 for the values not kept).
+         */
+        void readFrame(std::vector<Array<float>>& heatMaps, const unsigned long long frameIndex) const;
+
+        /**
+         * Sparse version of readFrame(). The dense heat maps are converted into SparseHeatMaps with threshold 0 (i.e.,
+         * all their non-zero values).
+         */
+        void readFrame(std::vector<SparseHeatMaps>& heatMaps, const unsigned long long frameIndex) const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplHeatMapBinaryReader;
+        std::unique_ptr<ImplHeatMapBinaryReader> upImpl;
+
+        DELETE_COPY(HeatMapBinaryReader);
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_HEAT_MAP_BINARY_READER_HPP
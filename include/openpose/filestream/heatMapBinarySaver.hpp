@@ -0,0 +1,69 @@
+#ifndef OPENPOSE_FILESTREAM_HEAT_MAP_BINARY_SAVER_HPP
+#define OPENPOSE_FILESTREAM_HEAT_MAP_BINARY_SAVER_HPP
+
+#include <fstream> // std::ofstream
+#include <openpose/core/common.hpp>
+#include <openpose/filestream/enumClasses.hpp>
+
+namespace op
+{
+    /**
+     * HeatMapBinarySaver appends the floating heat maps of each frame into a single chunked binary file, in float32,
+     * float16 or 8-bit (quantized per channel) precision. Each channel is compressed with Zstandard (if OpenPose was
+     * compiled with `WITH_ZSTD`) in parallel. It is the fast and lossless (with HeatMapPrecision::Float32)
+     * alternative to the PNG images of HeatMapSaver, and it can be read with HeatMapBinaryReader. The SparseHeatMaps
+     * (e.g., Datum::poseHeatMapsSparse) are saved sparse, so only their kept values are encoded. See
+     * doc/advanced/heatmap_output.md for its layout.
+     */
+    class OP_API HeatMapBinarySaver
+    {
+    public:
+        /**
+         * @param filePath Output file path (e.g., `heatmaps.opheat`). Any existing file is overwritten.
+         * @param compressionLevel Zstandard compression level (1 is the fastest one). Ignored without `WITH_ZSTD`.
+         */
+        explicit HeatMapBinarySaver(
+            const std::string& filePath, const HeatMapPrecision heatMapPrecision = HeatMapPrecision::Float32,
+            const int compressionLevel = 1);
+
+        virtual ~HeatMapBinarySaver();
+
+        /**
+         * @param heatMaps Heat maps of the frame (e.g., the Datum::poseHeatMaps of each view), each one with size
+         * [#channels x height x width].
+         * @param name Name of the frame (e.g., Datum::name), returned by HeatMapBinaryReader::getFrameName().
+         */
+        void save(const std::vector<Array<float>>& heatMaps, const std::string& name);
+
+        /**
+         * Sparse version of save(): only the kept values (and their indices) are saved.
+         * @param heatMaps Sparse heat maps of the frame (e.g., the Datum::poseHeatMapsSparse of each view).
+         */
+        void save(const std::vector<SparseHeatMaps>& heatMaps, const std::string& name);
+
+    private:
+        const std::string mFilePath;
+        const HeatMapPrecision mHeatMapPrecision;
+        const int mCompressionLevel;
+        std::ofstream mOfstream;
+        // Each frame is serialized in here first, so it is written at once
+        std::vector<char> mFrameBuffer;
+        std::size_t mFrameNameBytes;
+        // 1 per channel, so they are filled in parallel
+        std::vector<std::vector<char>> mRawBuffers;
+        std::vector<std::vector<char>> mCompressedBuffers;
+
+        void beginFrame(const std::string& name);
+
+        // Dense if sparseHeatMaps is nullptr
+        void appendArray(
+            const int numberChannels, const int height, const int width, const float* const denseValues,
+            const SparseHeatMaps* const sparseHeatMaps);
+
+        void endFrame(const std::size_t numberArrays);
+
+        DELETE_COPY(HeatMapBinarySaver);
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_HEAT_MAP_BINARY_SAVER_HPP
@@ -6,17 +6,41 @@
 
 namespace op
 {
+    class AsyncFileWriter;
+    class AsyncJobQueue;
+    class HeatMapBinarySaver;
+    class JpegEncoderGpu;
+
     class OP_API HeatMapSaver : public FileSaver
     {
     public:
-        HeatMapSaver(const std::string& directoryPath, const std::string& imageFormat);
+        /**
+         * @param imageFormat Image format of each frame (e.g., `png` or `jpg`), `float` (1 raw float file per frame),
+         * or `opheat`, `opheat_fp16` or `opheat_uint8` to append all the frames into the single compressed file
+         * `heatmaps.opheat` (see HeatMapBinarySaver) with float32, float16 or 8-bit (per channel) precision.
+         * @param numberThreads If different than 0, the heat maps are converted and written by background threads
+         * (see ImageSaver). If 0 (default), saveHeatMaps() writes them before returning.
+         * @param gpuEncoding If true and imageFormat is `jpg` or `jpeg`, all the heat maps of each saveHeatMaps() call
+         * are encoded as a single batch on the GPU (see ImageSaver).
+         */
+        HeatMapSaver(const std::string& directoryPath, const std::string& imageFormat, const int numberThreads = 0,
+                     const bool gpuEncoding = false);
 
         virtual ~HeatMapSaver();
 
         void saveHeatMaps(const std::vector<Array<float>>& heatMaps, const std::string& fileName) const;
 
+        /**
+         * The `opheat` formats save them sparse (see HeatMapBinarySaver). The other ones save their dense version.
+         */
+        void saveHeatMaps(const std::vector<SparseHeatMaps>& heatMaps, const std::string& fileName) const;
+
     private:
         const std::string mImageFormat;
+        const std::shared_ptr<AsyncJobQueue> spAsyncJobQueue;
+        const std::shared_ptr<JpegEncoderGpu> spJpegEncoderGpu;
+        const std::shared_ptr<AsyncFileWriter> spAsyncFileWriter;
+        std::shared_ptr<HeatMapBinarySaver> spHeatMapBinarySaver;
     };
 }
 
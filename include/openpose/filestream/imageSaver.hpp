@@ -2,23 +2,46 @@
 #define OPENPOSE_FILESTREAM_IMAGE_SAVER_HPP
 
 #include <openpose/core/common.hpp>
+#include <openpose/core/renderTargetGpu.hpp>
 #include <openpose/filestream/fileSaver.hpp>
 
 namespace op
 {
+    class AsyncFileWriter;
+    class AsyncJobQueue;
+    class JpegEncoderGpu;
+
     class OP_API ImageSaver : public FileSaver
     {
     public:
-        ImageSaver(const std::string& directoryPath, const std::string& imageFormat);
+        /**
+         * @param numberThreads If > 0, the images are encoded and written by numberThreads background threads, so
+         * saveImages() only copies them (-1 for the default number of threads). They are all written once the
+         * ImageSaver is destroyed. If 0 (default), saveImages() encodes and writes them before returning.
+         * @param gpuEncoding If true and imageFormat is `jpg` or `jpeg`, the images are encoded on the GPU with nvJPEG
+         * (see JpegEncoderGpu) by saveImages(), and only their compressed bytes are copied to the CPU and written by a
+         * background thread (regardless of numberThreads). It requires OpenPose compiled with `WITH_NVJPEG`. Other
+         * formats are encoded on the CPU.
+         */
+        ImageSaver(const std::string& directoryPath, const std::string& imageFormat, const int numberThreads = 0,
+                   const bool gpuEncoding = false);
 
         virtual ~ImageSaver();
 
         void saveImages(const Matrix& cvOutputData, const std::string& fileName) const;
 
-        void saveImages(const std::vector<Matrix>& matOutputDatas, const std::string& fileName) const;
+        /**
+         * @param renderTargets Optional GPU render targets of matOutputDatas (e.g., Datum::outputDataGpu). With
+         * gpuEncoding, each up-to-date one is encoded straight from the GPU memory rather than uploading its image.
+         */
+        void saveImages(const std::vector<Matrix>& matOutputDatas, const std::string& fileName,
+                        const std::vector<RenderTargetGpu>& renderTargets = {}) const;
 
     private:
         const std::string mImageFormat;
+        const std::shared_ptr<AsyncJobQueue> spAsyncJobQueue;
+        const std::shared_ptr<JpegEncoderGpu> spJpegEncoderGpu;
+        const std::shared_ptr<AsyncFileWriter> spAsyncFileWriter;
     };
 }
 
@@ -6,11 +6,22 @@
 
 namespace op
 {
+    /**
+     * JSON writer. The text is formatted into a memory buffer (with the shortest decimal representation that reads
+     * back to the same float, rather than the slow std::ofstream formatted output), which is written into the file
+     * at once when the JsonOfstream is destroyed (or every few MB if it becomes bigger).
+     */
     class OP_API JsonOfstream
     {
     public:
         explicit JsonOfstream(const std::string& filePath, const bool humanReadable = true);
 
+        /**
+         * In-memory version: the JSON text is appended into *jsonString instead of saved into a file. Its memory can
+         * then be reused for the following ones (e.g., with AsyncFileWriter). jsonString must outlive it.
+         */
+        JsonOfstream(std::string* const jsonString, const bool humanReadable = true);
+
         /**
          * Move constructor.
          * It destroys the original JsonOfstream to be moved.
@@ -40,15 +51,24 @@ namespace op
 
         void key(const std::string& string);
 
+        // Integer types
         template <typename T>
         inline void plainText(const T& value)
         {
-            *upOfstream << value;
+            pJsonString->append(std::to_string(value));
         }
 
+        void plainText(const std::string& text);
+
+        void plainText(const char* const text);
+
+        void plainText(const float value);
+
+        void plainText(const double value);
+
         inline void comma()
         {
-            *upOfstream << ",";
+            pJsonString->push_back(',');
         }
 
         void enter();
@@ -58,6 +78,11 @@ namespace op
         long long mBracesCounter;
         long long mBracketsCounter;
         std::unique_ptr<std::ofstream> upOfstream; // std::unique_ptr to solve std::move issue in GCC < 5
+        // Buffer of upOfstream (std::unique_ptr so pJsonString remains valid after moving it)
+        std::unique_ptr<std::string> upFileString;
+        std::string* pJsonString;
+
+        void flushIfFull();
 
         DELETE_COPY(JsonOfstream);
     };
@@ -0,0 +1,46 @@
+#ifndef OPENPOSE_FILESTREAM_KEYPOINT_BINARY_READER_HPP
+#define OPENPOSE_FILESTREAM_KEYPOINT_BINARY_READER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/core/datum.hpp>
+
+namespace op
+{
+    /**
+     * KeypointBinaryReader reads the files of KeypointBinarySaver. The file is memory-mapped and only the frame headers
+     * are read when opening it, so any frame can then be read in constant time without parsing the rest. If the last
+     * frame is incomplete (e.g., OpenPose was killed while saving it), it is ignored.
+     */
+    class OP_API KeypointBinaryReader
+    {
+    public:
+        explicit KeypointBinaryReader(const std::string& filePath);
+
+        virtual ~KeypointBinaryReader();
+
+        unsigned long long getNumberFrames() const;
+
+        /**
+         * It returns the frame index (for readFrame) of the given Datum::id and Datum::sourceId (the first one if
+         * several Datums had them, e.g., the views of a 3-D camera rig), or -1 if that frame is not in the file.
+         */
+        long long getFrameIndex(const unsigned long long frameId, const unsigned long long sourceId = 0ull) const;
+
+        /**
+         * It fills the id, frameNumber, sourceId, subId, poseIds and 2-D and 3-D keypoint members of datum with the
+         * frameIndex-th frame of the file (the other members are not modified). The keypoints are copied, so the
+         * datum can outlive this KeypointBinaryReader.
+         */
+        void readFrame(Datum& datum, const unsigned long long frameIndex) const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplKeypointBinaryReader;
+        std::unique_ptr<ImplKeypointBinaryReader> upImpl;
+
+        DELETE_COPY(KeypointBinaryReader);
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_KEYPOINT_BINARY_READER_HPP
@@ -0,0 +1,38 @@
+#ifndef OPENPOSE_FILESTREAM_KEYPOINT_BINARY_SAVER_HPP
+#define OPENPOSE_FILESTREAM_KEYPOINT_BINARY_SAVER_HPP
+
+#include <fstream> // std::ofstream
+#include <openpose/core/common.hpp>
+#include <openpose/core/datum.hpp>
+
+namespace op
+{
+    /**
+     * KeypointBinarySaver appends the people of each frame (frame id and number, source id, person ids and the 2-D
+     * and 3-D body/face/hand keypoints with their scores) into a single binary file, one contiguous float column
+     * per keypoint type. It is the compact alternative to the 1-JSON-file-per-frame PeopleJsonSaver, and it can be
+     * read with random access per frame by KeypointBinaryReader. See doc/02_output.md for its layout.
+     */
+    class OP_API KeypointBinarySaver
+    {
+    public:
+        /**
+         * @param filePath Output file path (e.g., `keypoints.opbin`). Any existing file is overwritten.
+         */
+        explicit KeypointBinarySaver(const std::string& filePath);
+
+        virtual ~KeypointBinarySaver();
+
+        void save(const Datum& datum);
+
+    private:
+        const std::string mFilePath;
+        std::ofstream mOfstream;
+        // Each frame is serialized in here first, so it is written at once
+        std::vector<char> mFrameBuffer;
+
+        DELETE_COPY(KeypointBinarySaver);
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_KEYPOINT_BINARY_SAVER_HPP
@@ -0,0 +1,107 @@
+#ifndef OPENPOSE_FILESTREAM_KEYPOINT_STREAM_FORMAT_HPP
+#define OPENPOSE_FILESTREAM_KEYPOINT_STREAM_FORMAT_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace op
+{
+    // Layout of the packets of KeypointStreamer (see doc/02_output.md). It has no OpenPose dependencies, so clients
+    // (e.g., game engines or robot controllers) can include it directly. All the values are in the native
+    // (little-endian) byte order, and every block is padded to 8 bytes.
+    // Packet: KeypointPacketHeader + numberBlocks x KeypointPacketBlockHeader + the data of each block (floats, or
+    // the compressed blocks below)
+    const auto KEYPOINT_PACKET_MAGIC = 0x534b504fu; // "OPKS"
+    const auto KEYPOINT_PACKET_VERSION = 1u;
+    // Maximum size of a packet (the UDP datagram limit). People that do not fit in it are not sent.
+    const auto KEYPOINT_PACKET_MAX_BYTES = 65507u;
+
+    enum class KeypointPacketBlock : uint32_t
+    {
+        PoseKeypoints = 0, // Datum::poseKeypoints: people x parts x 3 (x, y, score)
+        PoseKeypoints3D, // Datum::poseKeypoints3D: people x parts x 4 (x, y, z, score)
+        PoseKeypointsCompressed, // Same as PoseKeypoints, but compressed (see KeypointCompressedBlockHeader)
+        PoseKeypoints3DCompressed, // Same as PoseKeypoints3D, but compressed
+    };
+
+    struct KeypointPacketHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t sequence; // Consecutive for all the packets of a KeypointStreamer (so lost packets can be detected)
+        uint64_t timestampUs; // Sending time, in microseconds since the Unix epoch (system clock)
+        uint64_t frameId; // Datum::id
+        uint64_t sourceId; // Datum::sourceId (e.g., camera index of a MultiSourceProducer)
+        uint32_t numberBlocks;
+        uint32_t packetBytes; // Including this header
+    };
+
+    struct KeypointPacketBlockHeader
+    {
+        uint32_t block; // KeypointPacketBlock
+        uint32_t numberPeople;
+        uint32_t numberParts;
+        uint32_t numberChannels;
+    };
+
+    // Compressed blocks: KeypointCompressedBlockHeader + dataBytes of bitstream (most significant bit first), and
+    // the following for each person:
+    // - 1 bit: whether it is a residual of the same poseId on the packet referenceSequence (otherwise, absolute).
+    // - Exp-Golomb code of (poseId + 1), i.e., 0 if the person is not tracked.
+    // - The parts x channels integer values, i.e., round(coordinate / precision) and round(score x 255), minus
+    // the ones of the referred person if it is a residual. Each one is zig-zag mapped (u = 2v if v >= 0, else
+    // -2v - 1) and coded with an adaptive Rice code: with k as the smallest value such that (count << k) >= sum,
+    // the quotient (u >> k) is sent in unary (that many 1s followed by a 0), followed by the k lowest bits of u. If
+    // the quotient is at least KEYPOINT_RICE_ESCAPE, KEYPOINT_RICE_ESCAPE 1s are sent, followed by u in 32 bits.
+    // Then sum += u and count++ (and both are halved when count reaches KEYPOINT_RICE_RESET). There are 4 (sum,
+    // count) contexts, for absolute and residual coordinates and scores, starting at (16, 1) on every block.
+    // A person refers to the previous packet with the same block (and with the same parts and channels) if that one
+    // had its poseId. So a receiver that lost a packet cannot decode the following ones until the next keyframe (a
+    // packet with no residuals, sent every few packets).
+    const auto KEYPOINT_COMPRESSED_REFERENCE = 1u; // KeypointCompressedBlockHeader::flags: it has residuals
+    const auto KEYPOINT_SCORE_SCALE = 255.f;
+    const auto KEYPOINT_RICE_ESCAPE = 24u;
+    const auto KEYPOINT_RICE_RESET = 64u;
+
+    struct KeypointCompressedBlockHeader
+    {
+        uint64_t referenceSequence; // Packet of the residuals (only meaningful with KEYPOINT_COMPRESSED_REFERENCE)
+        float precision; // Quantization step of the coordinates (in pixels for 2-D, calibration units for 3-D)
+        uint32_t flags;
+        uint32_t dataBytes; // Bitstream bytes (not including this header nor the padding)
+        uint32_t reserved;
+    };
+
+    // Same-host shared memory transport: a ring buffer of the last numberSlots packets. The writer never waits for
+    // the readers, and each slot is a sequence lock: its sequence is odd while it is being written, so a reader
+    // copies the slot and then checks that the sequence did not change (otherwise the packet was overwritten meanwhile
+    // and it must retry).
+    // Shared memory: KeypointRingHeader + numberSlots x (KeypointRingSlotHeader + slotBytes)
+    const auto KEYPOINT_RING_MAGIC = 0x474e524bu; // "KRNG"
+    const auto KEYPOINT_RING_SLOT_BYTES = 65512u; // KEYPOINT_PACKET_MAX_BYTES padded to 8 bytes
+
+    struct KeypointRingHeader
+    {
+        uint32_t magic;
+        uint32_t version; // KEYPOINT_PACKET_VERSION
+        uint32_t numberSlots;
+        uint32_t slotBytes;
+        std::atomic<uint64_t> writeSequence; // Number of packets written so far
+    };
+
+    struct KeypointRingSlotHeader
+    {
+        std::atomic<uint64_t> sequence; // 2 x (packet sequence + 1), odd while writing
+        uint64_t packetBytes;
+    };
+
+    static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "The shared memory ring buffer requires lock-free 64-bit atomics.");
+
+    // Offset of the slotIndex-th slot header (or the size of the whole ring buffer if slotIndex = numberSlots)
+    inline uint64_t getKeypointRingSlotOffset(const uint32_t slotIndex, const uint32_t slotBytes)
+    {
+        return sizeof(KeypointRingHeader) + (uint64_t)slotIndex * (sizeof(KeypointRingSlotHeader) + slotBytes);
+    }
+}
+
+#endif // OPENPOSE_FILESTREAM_KEYPOINT_STREAM_FORMAT_HPP
@@ -0,0 +1,85 @@
+#ifndef OPENPOSE_FILESTREAM_KEYPOINT_STREAM_READER_HPP
+#define OPENPOSE_FILESTREAM_KEYPOINT_STREAM_READER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/core/datum.hpp>
+#include <openpose/filestream/keypointStreamFormat.hpp>
+
+namespace op
+{
+    /**
+     * KeypointStreamReader reads the shared memory ring buffer of KeypointStreamer from another process of the same
+     * host. It never blocks the writer nor the other readers (see keypointStreamFormat.hpp).
+     */
+    class OP_API KeypointStreamReader
+    {
+    public:
+        explicit KeypointStreamReader(const std::string& sharedMemoryName);
+
+        virtual ~KeypointStreamReader();
+
+        /**
+         * It fills the id, sourceId, poseKeypoints and poseKeypoints3D of datum with the last packet of the ring
+         * buffer.
+         * @return Whether there was a new packet since the last call (otherwise datum is not modified).
+         */
+        bool readLatest(Datum& datum);
+
+        /**
+         * Header (sequence, timestamp, etc.) of the last packet read by readLatest().
+         */
+        const KeypointPacketHeader& getLastPacketHeader() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplKeypointStreamReader;
+        std::unique_ptr<ImplKeypointStreamReader> upImpl;
+
+        DELETE_COPY(KeypointStreamReader);
+    };
+
+    /**
+     * KeypointPacketDecoder decodes the packets of KeypointStreamer (e.g., received by UDP), including the compressed
+     * ones (see KeypointPacketEncoder). Since those refer to the previous packet, the same instance must decode all
+     * the packets of a stream, in order.
+     */
+    class OP_API KeypointPacketDecoder
+    {
+    public:
+        KeypointPacketDecoder();
+
+        virtual ~KeypointPacketDecoder();
+
+        /**
+         * It fills the id, sourceId, poseKeypoints and poseKeypoints3D of datum with packet (and poseIds, if
+         * poseKeypoints was compressed).
+         * @return Whether all its blocks were decoded. If a compressed block refers to a packet that was not decoded
+         * (e.g., a lost UDP datagram), those keypoints are left empty until the next keyframe.
+         */
+        bool decode(Datum& datum, const void* const packet, const unsigned long long packetBytes);
+
+        /**
+         * Header (sequence, timestamp, etc.) of the last packet decoded.
+         */
+        const KeypointPacketHeader& getLastPacketHeader() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplKeypointPacketDecoder;
+        std::unique_ptr<ImplKeypointPacketDecoder> upImpl;
+
+        DELETE_COPY(KeypointPacketDecoder);
+    };
+
+    /**
+     * It fills the id, sourceId, poseKeypoints and poseKeypoints3D of datum with a packet of KeypointStreamer (e.g.,
+     * received by UDP), and it returns its header. The compressed blocks with residuals are left empty (use
+     * KeypointPacketDecoder for them).
+     */
+    OP_API KeypointPacketHeader keypointPacketToDatum(
+        Datum& datum, const void* const packet, const unsigned long long packetBytes);
+}
+
+#endif // OPENPOSE_FILESTREAM_KEYPOINT_STREAM_READER_HPP
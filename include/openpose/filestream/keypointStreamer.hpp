@@ -0,0 +1,93 @@
+#ifndef OPENPOSE_FILESTREAM_KEYPOINT_STREAMER_HPP
+#define OPENPOSE_FILESTREAM_KEYPOINT_STREAMER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/core/datum.hpp>
+
+namespace op
+{
+    /**
+     * KeypointPacketEncoder builds the keypoint packets of KeypointStreamer (see keypointStreamFormat.hpp). With a
+     * positive precision, the keypoints are quantized to it, each tracked person (Datum::poseIds) is sent as the
+     * residual of the previous packet (i.e., its motion, usually a few pixels), and those integers are entropy coded
+     * (adaptive Rice codes), so the packets are several times smaller than the raw floats. A receiver decodes them
+     * with KeypointPacketDecoder. Every keyframeInterval packets, a keyframe (with no residuals) is sent, so a
+     * receiver that lost a packet recovers.
+     */
+    class OP_API KeypointPacketEncoder
+    {
+    public:
+        /**
+         * @param precision Quantization step of Datum::poseKeypoints (in pixels, e.g., 0.25), or 0 to send them as
+         * raw floats.
+         * @param precision3D Same for Datum::poseKeypoints3D (in the units of the camera calibration, e.g., 1 mm).
+         * @param keyframeInterval The packets whose sequence is a multiple of it are keyframes.
+         */
+        explicit KeypointPacketEncoder(
+            const float precision = 0.f, const float precision3D = 0.f, const unsigned int keyframeInterval = 30u);
+
+        virtual ~KeypointPacketEncoder();
+
+        /**
+         * It fills packet with the keypoint packet of datum. The compressed blocks refer to the last encode() call,
+         * so each receiver must decode all the packets in order.
+         * @return Whether all the people fit into KEYPOINT_PACKET_MAX_BYTES (otherwise, only the first ones are saved).
+         */
+        bool encode(std::vector<char>& packet, const Datum& datum, const unsigned long long sequence);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplKeypointPacketEncoder;
+        std::unique_ptr<ImplKeypointPacketEncoder> upImpl;
+
+        DELETE_COPY(KeypointPacketEncoder);
+    };
+
+    /**
+     * KeypointStreamer sends the 2-D and 3-D body keypoints of each frame (Datum::poseKeypoints and
+     * Datum::poseKeypoints3D) as 1 compact binary packet (see keypointStreamFormat.hpp and doc/02_output.md), so
+     * other applications (e.g., game engines or robot controllers) receive them with minimal latency:
+     * - By UDP (1 datagram per frame), to any host.
+     * - By a shared memory ring buffer, to the processes of the same host (see KeypointStreamReader), with no
+     * sockets and lock-free readers: the writer never waits for them.
+     */
+    class OP_API KeypointStreamer
+    {
+    public:
+        /**
+         * @param udpAddress `host:port` of the UDP receiver (e.g., `127.0.0.1:8052`), or empty to disable it.
+         * @param sharedMemoryName Name of the shared memory ring buffer (e.g., `openpose_keypoints`), or empty to
+         * disable it.
+         * @param numberSlots Number of packets kept in the ring buffer, so slow readers can still read the last ones.
+         * @param precision, precision3D, keyframeInterval Compression of the UDP packets (see KeypointPacketEncoder),
+         * disabled by default. The shared memory packets are always raw floats, since its readers might skip some.
+         */
+        KeypointStreamer(
+            const std::string& udpAddress, const std::string& sharedMemoryName = "",
+            const unsigned int numberSlots = 8u, const float precision = 0.f, const float precision3D = 0.f,
+            const unsigned int keyframeInterval = 30u);
+
+        virtual ~KeypointStreamer();
+
+        void send(const Datum& datum);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplKeypointStreamer;
+        std::unique_ptr<ImplKeypointStreamer> upImpl;
+
+        DELETE_COPY(KeypointStreamer);
+    };
+
+    /**
+     * It fills packet with the raw (uncompressed) keypoint packet of datum (see keypointStreamFormat.hpp), the same
+     * one sent by KeypointStreamer.
+     * @return Whether all the people fit into KEYPOINT_PACKET_MAX_BYTES (otherwise, only the first ones are saved).
+     */
+    OP_API bool datumToKeypointPacket(
+        std::vector<char>& packet, const Datum& datum, const unsigned long long sequence = 0ull);
+}
+
+#endif // OPENPOSE_FILESTREAM_KEYPOINT_STREAMER_HPP
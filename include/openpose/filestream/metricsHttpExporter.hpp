@@ -0,0 +1,53 @@
+#ifndef OPENPOSE_FILESTREAM_METRICS_HTTP_EXPORTER_HPP
+#define OPENPOSE_FILESTREAM_METRICS_HTTP_EXPORTER_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * MetricsHttpExporter is a minimal embedded HTTP server (on its own thread) that exposes Metrics::toOpenMetrics()
+     * on `http://<host>:<port>/metrics`, so Prometheus (or any other OpenMetrics-compatible scraper) can scrape the
+     * OpenPose metrics while it runs.
+     * It can be started and stopped at any time. It does not enable the Metrics recording itself (see
+     * Metrics::setEnabled()).
+     */
+    class OP_API MetricsHttpExporter
+    {
+    public:
+        /**
+         * Constructor of MetricsHttpExporter. It does not start the server, see start().
+         * @param port const int parameter with the TCP port to listen to.
+         * @param host const std::string parameter with the IP address to bind to (e.g., `127.0.0.1` to only accept
+         * local connections). By default, it listens to all the interfaces.
+         */
+        explicit MetricsHttpExporter(const int port, const std::string& host = "0.0.0.0");
+
+        virtual ~MetricsHttpExporter();
+
+        /**
+         * It binds the port and starts serving on a new thread. It throws an error if the port cannot be bound. It
+         * does nothing if it is already running.
+         */
+        void start();
+
+        /**
+         * It stops serving and closes the port (blocking until the server thread finishes).
+         */
+        void stop();
+
+        bool isRunning() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplMetricsHttpExporter;
+        std::unique_ptr<ImplMetricsHttpExporter> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(MetricsHttpExporter);
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_METRICS_HTTP_EXPORTER_HPP
@@ -0,0 +1,62 @@
+#ifndef OPENPOSE_FILESTREAM_NET_OUTPUT_CACHE_HPP
+#define OPENPOSE_FILESTREAM_NET_OUTPUT_CACHE_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * NetOutputCache is a content-addressed store of the raw network outputs, so re-processing the same images
+     * (e.g., with different post-processing, face or hand settings) does not run the network again. Each entry is
+     * addressed by a hash of the network input (i.e., the image content, net resolution and scales) and of the model,
+     * and it is saved in float16 (Zstandard-compressed if OpenPose was compiled with `WITH_ZSTD`) into the
+     * append-only HeatMapBinarySaver files `cache_<N>.opheat` of the cache directory.
+     * The existing files are memory-mapped (HeatMapBinaryReader) when opening the cache, while the new entries are
+     * appended into a new file, so they are available from the next run on. get() and add() are thread-safe, so a
+     * single instance can be shared by all the GPU threads. Only 1 process should use the same directory at a time.
+     */
+    class OP_API NetOutputCache
+    {
+    public:
+        /**
+         * @param cacheDirectory Directory of the cache files. It is created if it does not exist.
+         * @param compressionLevel Zstandard compression level (1 is the fastest one). Ignored without `WITH_ZSTD`.
+         */
+        explicit NetOutputCache(const std::string& cacheDirectory, const int compressionLevel = 1);
+
+        virtual ~NetOutputCache();
+
+        /**
+         * It returns the key of the network output of inputNetData (the network input of each scale).
+         * @param modelKey Any string identifying the network (e.g., model and precision), so different models do not
+         * share their entries.
+         */
+        std::string getKey(const std::vector<Array<float>>& inputNetData, const std::string& modelKey) const;
+
+        /**
+         * It fills netOutputs (1 array per scale, each one with size [#channels x height x width]) and returns true
+         * if key is on the cache. Otherwise, it returns false.
+         */
+        bool get(std::vector<Array<float>>& netOutputs, const std::string& key);
+
+        /**
+         * It appends netOutputs (1 array per scale, each one with size [#channels x height x width]) with key into
+         * the cache. Keys that are already on the cache are ignored.
+         */
+        void add(const std::vector<Array<float>>& netOutputs, const std::string& key);
+
+        unsigned long long getNumberHits() const;
+
+        unsigned long long getNumberMisses() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplNetOutputCache;
+        std::unique_ptr<ImplNetOutputCache> upImpl;
+
+        DELETE_COPY(NetOutputCache);
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_NET_OUTPUT_CACHE_HPP
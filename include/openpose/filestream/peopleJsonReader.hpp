@@ -0,0 +1,62 @@
+#ifndef OPENPOSE_FILESTREAM_PEOPLE_JSON_READER_HPP
+#define OPENPOSE_FILESTREAM_PEOPLE_JSON_READER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/core/datum.hpp>
+
+namespace op
+{
+    /**
+     * PeopleJsonReader reads back the JSON files of PeopleJsonSaver (`--write_json`). Each file is memory-mapped and
+     * parsed in a single streaming pass straight into the keypoint Arrays of the Datum (no JSON tree is built), with
+     * SIMD instructions to skip the whitespace and the unknown elements (e.g., `part_candidates`) if the CPU
+     * supports them. readFrames() parses several files in parallel.
+     */
+    class OP_API PeopleJsonReader
+    {
+    public:
+        /**
+         * @param path Directory with the JSON files (sorted as the frames, see getFilesOnDirectory()) or a single
+         * JSON file.
+         */
+        explicit PeopleJsonReader(const std::string& path);
+
+        virtual ~PeopleJsonReader();
+
+        unsigned long long getNumberFrames() const;
+
+        const std::string& getFilePath(const unsigned long long frameIndex) const;
+
+        /**
+         * It fills the name, poseIds and 2-D and 3-D keypoint members of datum with the frameIndex-th file (the other
+         * members are not modified). The name is the one of the file without its `_keypoints.json` suffix. The
+         * keypoints of the people with an empty array in the file (e.g., no face detected) are 0.
+         */
+        void readFrame(Datum& datum, const unsigned long long frameIndex) const;
+
+        /**
+         * Equivalent to readFrame() for the numberFrames frames starting at firstFrame, parsed in parallel.
+         * @param datums It is resized to the number of frames read (fewer than numberFrames at the end of the
+         * files).
+         */
+        void readFrames(
+            std::vector<Datum>& datums, const unsigned long long firstFrame, const unsigned long long numberFrames)
+            const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplPeopleJsonReader;
+        std::unique_ptr<ImplPeopleJsonReader> upImpl;
+
+        DELETE_COPY(PeopleJsonReader);
+    };
+
+    /**
+     * It parses a people JSON string (e.g., the one of peopleJsonToString()) into the poseIds and 2-D and 3-D
+     * keypoint members of datum, as PeopleJsonReader::readFrame().
+     */
+    OP_API void parsePeopleJson(Datum& datum, const char* const jsonPtr, const unsigned long long jsonSize);
+}
+
+#endif // OPENPOSE_FILESTREAM_PEOPLE_JSON_READER_HPP
@@ -2,21 +2,44 @@
 #define OPENPOSE_FILESTREAM_PEOPLE_JSON_SAVER_HPP
 
 #include <openpose/core/common.hpp>
+#include <openpose/core/datumTiming.hpp>
 #include <openpose/filestream/fileSaver.hpp>
 
 namespace op
 {
+    class AsyncFileWriter;
+
     class OP_API PeopleJsonSaver : public FileSaver
     {
     public:
-        PeopleJsonSaver(const std::string& directoryPath);
+        /**
+         * @param asynchronous If true (default), the JSON text is generated on the calling thread, but the files are
+         * written on a background thread (see AsyncFileWriter), so slow disks do not block the caller. They are all
+         * written once the PeopleJsonSaver is destroyed.
+         */
+        PeopleJsonSaver(const std::string& directoryPath, const bool asynchronous = true);
 
         virtual ~PeopleJsonSaver();
 
+        /**
+         * @param timingEvents If not empty, the timing record of the frame (see DatumTiming) is also saved, as
+         * `timing`.
+         */
         void save(
             const std::vector<std::pair<Array<float>, std::string>>& keypointVector,
             const std::vector<std::vector<std::array<float,3>>>& candidates, const std::string& fileName,
-            const bool humanReadable = true) const;
+            const bool humanReadable = true, const std::vector<DatumTimingEvent>& timingEvents = {}) const;
+
+        /**
+         * Analogous to the other save(), but with the flat part candidates (see Datum::poseCandidatesArray).
+         */
+        void save(
+            const std::vector<std::pair<Array<float>, std::string>>& keypointVector, const Array<float>& candidates,
+            const std::vector<int>& candidateOffsets, const std::string& fileName,
+            const bool humanReadable = true, const std::vector<DatumTimingEvent>& timingEvents = {}) const;
+
+    private:
+        const std::shared_ptr<AsyncFileWriter> spAsyncFileWriter;
     };
 }
 
@@ -8,9 +8,17 @@ namespace op
     class OP_API VideoSaver
     {
     public:
+        /**
+         * @param numberThreads If different than 0, write() only copies the frames, and they are encoded and written
+         * on background threads in the same order (1 thread for the OpenCV video, numberThreads for the temporary JPG
+         * images of the MP4 one, or -1 for the default number). If 0 (default), write() writes them before returning.
+         * @param ffmpegEncoder FFmpeg encoder of the MP4 videos (e.g., `libx264`, or `h264_nvenc` or `hevc_nvenc` to
+         * use the NVIDIA GPU hardware encoder, if the installed FFmpeg supports it).
+         */
         VideoSaver(
             const std::string& videoSaverPath, const int cvFourcc, const double fps,
-            const std::string& addAudioFromThisVideo = "");
+            const std::string& addAudioFromThisVideo = "", const int numberThreads = 0,
+            const std::string& ffmpegEncoder = "libx264");
 
         virtual ~VideoSaver();
 
@@ -0,0 +1,53 @@
+#ifndef OPENPOSE_FILESTREAM_VIDEO_STREAMER_HPP
+#define OPENPOSE_FILESTREAM_VIDEO_STREAMER_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * VideoStreamer sends the rendered frames as a live low-latency video stream (e.g., for remote monitoring). They
+     * are encoded by an FFmpeg process (e.g., with the NVENC `h264_nvenc` or the VAAPI `h264_vaapi` hardware
+     * encoders, with no B-frames and their low-latency settings), which receives the raw frames through a pipe and
+     * sends them to the stream URL. The frames are written into that pipe by a background thread, and write() never
+     * waits for it: if the previous frame is still pending (e.g., the network or the encoder are slower than
+     * OpenPose), it is replaced by the new one (i.e., dropped).
+     */
+    class OP_API VideoStreamer
+    {
+    public:
+        /**
+         * @param url Stream URL. Its protocol selects the container: `rtsp://` (RTSP over TCP, published into an
+         * RTSP server, e.g., MediaMTX, which serves it to the clients, including WebRTC ones if the server supports
+         * them), `rtmp://` (FLV), or `srt://`, `udp://` and `tcp://` (MPEG-TS).
+         * @param fps Expected frame rate (for the rate control and the key frame interval of the encoder). The
+         * timestamps are the time each frame is sent, so dropped frames do not accelerate the video.
+         * @param ffmpegEncoder FFmpeg video encoder, e.g., `h264_nvenc` (default), `hevc_nvenc`, `h264_vaapi` or
+         * `libx264`.
+         */
+        VideoStreamer(const std::string& url, const double fps = 30., const std::string& ffmpegEncoder = "h264_nvenc");
+
+        virtual ~VideoStreamer();
+
+        /**
+         * It queues the frame (the horizontal concatenation of matsToSend, e.g., the views of multiple cameras) and
+         * returns right away. The stream resolution is the one of the first frame (the following ones are resized to
+         * it). If the stream failed (e.g., FFmpeg could not connect to the URL), it throws that error.
+         */
+        void write(const std::vector<Matrix>& matsToSend);
+
+        unsigned long long getNumberFramesSent() const;
+
+        unsigned long long getNumberFramesDropped() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplVideoStreamer;
+        std::unique_ptr<ImplVideoStreamer> upImpl;
+
+        DELETE_COPY(VideoStreamer);
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_VIDEO_STREAMER_HPP
@@ -0,0 +1,140 @@
+#ifndef OPENPOSE_FILESTREAM_W_DATUM_RECEIVER_HPP
+#define OPENPOSE_FILESTREAM_W_DATUM_RECEIVER_HPP
+
+#include <queue> // std::queue
+#include <openpose/core/common.hpp>
+#include <openpose/filestream/datumReceiver.hpp>
+#include <openpose/thread/workerProducer.hpp>
+
+namespace op
+{
+    /**
+     * Producer of the frame sets received by DatumReceiver (i.e., sent by the DatumSender of another process). It
+     * replaces WDatumProducer, and it stops once the sender finishes.
+     * The Datums are renumbered (consecutive id), but they keep the frameNumber, name and sourceId of the sender.
+     * Each frame set holds the credit of the receiver (see Datum::frameCredit), so it is granted back to the sender
+     * once this pipeline releases it.
+     */
+    template<typename TDatum>
+    class WDatumReceiver : public WorkerProducer<std::shared_ptr<std::vector<std::shared_ptr<TDatum>>>>
+    {
+    public:
+        explicit WDatumReceiver(const std::shared_ptr<DatumReceiver>& datumReceiver);
+
+        virtual ~WDatumReceiver();
+
+        void initializationOnThread();
+
+        std::shared_ptr<std::vector<std::shared_ptr<TDatum>>> workProducer();
+
+    private:
+        const std::shared_ptr<DatumReceiver> spDatumReceiver;
+        unsigned long long mNextId;
+        std::vector<char> mPayload;
+        std::queue<std::shared_ptr<std::vector<std::shared_ptr<TDatum>>>> mQueuedElements;
+
+        DELETE_COPY(WDatumReceiver);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/core/datum.hpp>
+#include <openpose/filestream/datumSerializer.hpp>
+namespace op
+{
+    // Maximum time blocked waiting for a frame set in each workProducer() call (so the thread can be stopped)
+    const auto W_DATUM_RECEIVER_WAIT_MS = 100;
+
+    template<typename TDatum>
+    WDatumReceiver<TDatum>::WDatumReceiver(const std::shared_ptr<DatumReceiver>& datumReceiver) :
+        spDatumReceiver{datumReceiver},
+        mNextId{0ull}
+    {
+    }
+
+    template<typename TDatum>
+    WDatumReceiver<TDatum>::~WDatumReceiver()
+    {
+    }
+
+    template<typename TDatum>
+    void WDatumReceiver<TDatum>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatum>
+    std::shared_ptr<std::vector<std::shared_ptr<TDatum>>> WDatumReceiver<TDatum>::workProducer()
+    {
+        try
+        {
+            // Debugging log
+            opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            std::shared_ptr<std::vector<std::shared_ptr<TDatum>>> tDatums;
+            if (mQueuedElements.empty())
+            {
+                // Next frame set
+                unsigned int numberDatums = 0u;
+                if (!spDatumReceiver->receive(mPayload, numberDatums, W_DATUM_RECEIVER_WAIT_MS))
+                {
+                    // Stop Worker if the sender finished
+                    if (spDatumReceiver->isFinished())
+                        this->stop();
+                    return nullptr;
+                }
+                // Profiling speed
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
+                // Deserialize it (1 credit per frame set, shared by its views)
+                const auto credit = spDatumReceiver->takeCredit();
+                tDatums = std::make_shared<std::vector<std::shared_ptr<TDatum>>>();
+                auto offset = 0ull;
+                for (auto i = 0u ; i < numberDatums ; i++)
+                {
+                    auto tDatumPtr = std::make_shared<TDatum>();
+                    offset += DatumSerializer::deserialize(
+                        *tDatumPtr, mPayload.data() + offset, mPayload.size() - offset);
+                    tDatumPtr->id = mNextId;
+                    tDatumPtr->subId = i;
+                    tDatumPtr->subIdMax = numberDatums - 1u;
+                    tDatumPtr->frameCredit = credit;
+                    tDatums->emplace_back(tDatumPtr);
+                }
+                mNextId++;
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+            // Equivalent to WQueueSplitter
+            // Queued elements - Multiple views --> Split views into different shared pointers
+            if (tDatums != nullptr && tDatums->size() > 1)
+                for (auto& tDatumPtr : *tDatums)
+                    mQueuedElements.emplace(
+                        std::make_shared<std::vector<std::shared_ptr<TDatum>>>(
+                            std::vector<std::shared_ptr<TDatum>>{tDatumPtr}));
+            // Queued elements - Multiple views --> Return oldest view
+            if (!mQueuedElements.empty())
+            {
+                tDatums = mQueuedElements.front();
+                mQueuedElements.pop();
+            }
+            // Return result
+            return (tDatums != nullptr && !tDatums->empty() ? tDatums : nullptr);
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    extern template class WDatumReceiver<BASE_DATUM>;
+}
+
+#endif // OPENPOSE_FILESTREAM_W_DATUM_RECEIVER_HPP
@@ -0,0 +1,105 @@
+#ifndef OPENPOSE_FILESTREAM_W_DATUM_SENDER_HPP
+#define OPENPOSE_FILESTREAM_W_DATUM_SENDER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/filestream/datumSender.hpp>
+#include <openpose/thread/workerConsumer.hpp>
+
+namespace op
+{
+    /**
+     * It sends each frame set to a DatumReceiver (see DatumSender). It blocks while the receiver has not granted a
+     * credit, so the flow control reaches the rest of the pipeline through its input queue.
+     */
+    template<typename TDatums>
+    class WDatumSender : public WorkerConsumer<TDatums>
+    {
+    public:
+        explicit WDatumSender(const std::shared_ptr<DatumSender>& datumSender);
+
+        virtual ~WDatumSender();
+
+        void initializationOnThread();
+
+        void workConsumer(const TDatums& tDatums);
+
+    private:
+        const std::shared_ptr<DatumSender> spDatumSender;
+
+        DELETE_COPY(WDatumSender);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    // Maximum time blocked waiting for a credit in each waitForCredit() call (so the thread can be stopped)
+    const auto W_DATUM_SENDER_CREDIT_WAIT_MS = 100;
+
+    template<typename TDatums>
+    WDatumSender<TDatums>::WDatumSender(const std::shared_ptr<DatumSender>& datumSender) :
+        spDatumSender{datumSender}
+    {
+    }
+
+    template<typename TDatums>
+    WDatumSender<TDatums>::~WDatumSender()
+    {
+    }
+
+    template<typename TDatums>
+    void WDatumSender<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WDatumSender<TDatums>::workConsumer(const TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Flow control: Wait for the receiver
+                while (!spDatumSender->waitForCredit(W_DATUM_SENDER_CREDIT_WAIT_MS))
+                    if (!this->isRunning())
+                        return;
+                // Profiling speed
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
+                // Frames only kept on the GPU are downloaded if sent
+                const auto sendsFrame = (
+                    (spDatumSender->getDatumWireFields() & DatumWireField::Frame) != DatumWireField::None);
+                std::vector<const Datum*> datums;
+                for (auto& tDatumPtr : *tDatums)
+                {
+                    if (sendsFrame)
+                        tDatumPtr->getCvInputData();
+                    datums.emplace_back(tDatumPtr.get());
+                }
+                // Send the frame set
+                spDatumSender->send(datums);
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WDatumSender);
+}
+
+#endif // OPENPOSE_FILESTREAM_W_DATUM_SENDER_HPP
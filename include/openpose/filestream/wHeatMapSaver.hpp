@@ -60,16 +60,28 @@ namespace op
                 // Debugging log
                 opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
-                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
                 // T* to T
                 auto& tDatumsNoPtr = *tDatums;
                 // Record pose heatmap image(s) on disk
-                std::vector<Array<float>> poseHeatMaps(tDatumsNoPtr.size());
-                for (auto i = 0u; i < tDatumsNoPtr.size(); i++)
-                    poseHeatMaps[i] = tDatumsNoPtr[i]->poseHeatMaps;
                 const auto fileName = (!tDatumsNoPtr[0]->name.empty()
                     ? tDatumsNoPtr[0]->name : std::to_string(tDatumsNoPtr[0]->id)) + "_pose_heatmaps";
-                spHeatMapSaver->saveHeatMaps(poseHeatMaps, fileName);
+                // Sparse heat maps (`--heatmaps_sparse_threshold`)
+                if (!tDatumsNoPtr[0]->poseHeatMapsSparse.empty())
+                {
+                    std::vector<SparseHeatMaps> poseHeatMapsSparse(tDatumsNoPtr.size());
+                    for (auto i = 0u; i < tDatumsNoPtr.size(); i++)
+                        poseHeatMapsSparse[i] = tDatumsNoPtr[i]->poseHeatMapsSparse;
+                    spHeatMapSaver->saveHeatMaps(poseHeatMapsSparse, fileName);
+                }
+                else
+                {
+                    std::vector<Array<float>> poseHeatMaps(tDatumsNoPtr.size());
+                    for (auto i = 0u; i < tDatumsNoPtr.size(); i++)
+                        poseHeatMaps[i] = tDatumsNoPtr[i]->getPoseHeatMaps();
+                    spHeatMapSaver->saveHeatMaps(poseHeatMaps, fileName);
+                }
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
                 Profiler::printAveragedTimeMsOnIterationX(profilerKey,
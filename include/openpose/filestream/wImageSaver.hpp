@@ -60,16 +60,21 @@ namespace op
                 // Debugging log
                 opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
-                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
                 // T* to T
                 auto& tDatumsNoPtr = *tDatums;
                 // Record image(s) on disk
                 std::vector<Matrix> opOutputDatas(tDatumsNoPtr.size());
+                std::vector<RenderTargetGpu> renderTargets(tDatumsNoPtr.size());
                 for (auto i = 0u; i < tDatumsNoPtr.size(); i++)
+                {
                     opOutputDatas[i] = tDatumsNoPtr[i]->cvOutputData;
+                    renderTargets[i] = tDatumsNoPtr[i]->outputDataGpu;
+                }
                 const auto fileName = (!tDatumsNoPtr[0]->name.empty()
                     ? tDatumsNoPtr[0]->name : std::to_string(tDatumsNoPtr[0]->id));
-                spImageSaver->saveImages(opOutputDatas, fileName);
+                spImageSaver->saveImages(opOutputDatas, fileName, renderTargets);
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
                 Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
@@ -0,0 +1,86 @@
+#ifndef OPENPOSE_FILESTREAM_W_KEYPOINT_BINARY_SAVER_HPP
+#define OPENPOSE_FILESTREAM_W_KEYPOINT_BINARY_SAVER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/filestream/keypointBinarySaver.hpp>
+#include <openpose/thread/workerConsumer.hpp>
+
+namespace op
+{
+    template<typename TDatums>
+    class WKeypointBinarySaver : public WorkerConsumer<TDatums>
+    {
+    public:
+        explicit WKeypointBinarySaver(const std::shared_ptr<KeypointBinarySaver>& keypointBinarySaver);
+
+        virtual ~WKeypointBinarySaver();
+
+        void initializationOnThread();
+
+        void workConsumer(const TDatums& tDatums);
+
+    private:
+        const std::shared_ptr<KeypointBinarySaver> spKeypointBinarySaver;
+
+        DELETE_COPY(WKeypointBinarySaver);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WKeypointBinarySaver<TDatums>::WKeypointBinarySaver(
+        const std::shared_ptr<KeypointBinarySaver>& keypointBinarySaver) :
+        spKeypointBinarySaver{keypointBinarySaver}
+    {
+    }
+
+    template<typename TDatums>
+    WKeypointBinarySaver<TDatums>::~WKeypointBinarySaver()
+    {
+    }
+
+    template<typename TDatums>
+    void WKeypointBinarySaver<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WKeypointBinarySaver<TDatums>::workConsumer(const TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
+                // Append body/face/hand keypoints to the binary file (all the sources into the same one)
+                for (const auto& tDatumPtr : *tDatums)
+                    spKeypointBinarySaver->save(*tDatumPtr);
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WKeypointBinarySaver);
+}
+
+#endif // OPENPOSE_FILESTREAM_W_KEYPOINT_BINARY_SAVER_HPP
@@ -0,0 +1,86 @@
+#ifndef OPENPOSE_FILESTREAM_W_KEYPOINT_STREAMER_HPP
+#define OPENPOSE_FILESTREAM_W_KEYPOINT_STREAMER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/filestream/keypointStreamer.hpp>
+#include <openpose/thread/workerConsumer.hpp>
+
+namespace op
+{
+    template<typename TDatums>
+    class WKeypointStreamer : public WorkerConsumer<TDatums>
+    {
+    public:
+        explicit WKeypointStreamer(const std::shared_ptr<KeypointStreamer>& keypointStreamer);
+
+        virtual ~WKeypointStreamer();
+
+        void initializationOnThread();
+
+        void workConsumer(const TDatums& tDatums);
+
+    private:
+        const std::shared_ptr<KeypointStreamer> spKeypointStreamer;
+
+        DELETE_COPY(WKeypointStreamer);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WKeypointStreamer<TDatums>::WKeypointStreamer(
+        const std::shared_ptr<KeypointStreamer>& keypointStreamer) :
+        spKeypointStreamer{keypointStreamer}
+    {
+    }
+
+    template<typename TDatums>
+    WKeypointStreamer<TDatums>::~WKeypointStreamer()
+    {
+    }
+
+    template<typename TDatums>
+    void WKeypointStreamer<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WKeypointStreamer<TDatums>::workConsumer(const TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
+                // Stream the keypoints (1 packet per source)
+                for (const auto& tDatumPtr : *tDatums)
+                    spKeypointStreamer->send(*tDatumPtr);
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WKeypointStreamer);
+}
+
+#endif // OPENPOSE_FILESTREAM_W_KEYPOINT_STREAMER_HPP
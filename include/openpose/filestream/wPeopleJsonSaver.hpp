@@ -13,6 +13,12 @@ namespace op
     public:
         explicit WPeopleJsonSaver(const std::shared_ptr<PeopleJsonSaver>& peopleJsonSaver);
 
+        /**
+         * Constructor for several multiplexed sources (see MultiSourceProducer), with one PeopleJsonSaver (i.e.,
+         * output directory) per source (indexed by Datum::sourceId).
+         */
+        explicit WPeopleJsonSaver(const std::vector<std::shared_ptr<PeopleJsonSaver>>& peopleJsonSavers);
+
         virtual ~WPeopleJsonSaver();
 
         void initializationOnThread();
@@ -20,7 +26,7 @@ namespace op
         void workConsumer(const TDatums& tDatums);
 
     private:
-        const std::shared_ptr<PeopleJsonSaver> spPeopleJsonSaver;
+        const std::vector<std::shared_ptr<PeopleJsonSaver>> mPeopleJsonSavers;
 
         DELETE_COPY(WPeopleJsonSaver);
     };
@@ -36,8 +42,24 @@ namespace op
 {
     template<typename TDatums>
     WPeopleJsonSaver<TDatums>::WPeopleJsonSaver(const std::shared_ptr<PeopleJsonSaver>& peopleJsonSaver) :
-        spPeopleJsonSaver{peopleJsonSaver}
+        mPeopleJsonSavers{peopleJsonSaver}
+    {
+    }
+
+    template<typename TDatums>
+    WPeopleJsonSaver<TDatums>::WPeopleJsonSaver(
+        const std::vector<std::shared_ptr<PeopleJsonSaver>>& peopleJsonSavers) :
+        mPeopleJsonSavers{peopleJsonSavers}
     {
+        try
+        {
+            if (mPeopleJsonSavers.empty())
+                error("At least 1 PeopleJsonSaver is required.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     template<typename TDatums>
@@ -60,12 +82,19 @@ namespace op
                 // Debugging log
                 opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
-                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
                 // Save body/face/hand keypoints to JSON file
                 const auto& tDatumFirstPtr = (*tDatums)[0];
                 const auto baseFileName = (!tDatumFirstPtr->name.empty() ? tDatumFirstPtr->name
                                             : std::to_string(tDatumFirstPtr->id)) + "_keypoints";
                 const bool humanReadable = false;
+                // Directory of the source of these frames
+                const auto sourceId = (mPeopleJsonSavers.size() > 1 ? tDatumFirstPtr->sourceId : 0ull);
+                if (sourceId >= mPeopleJsonSavers.size())
+                    error("No PeopleJsonSaver for source " + std::to_string(sourceId) + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+                const auto& peopleJsonSaver = mPeopleJsonSavers[sourceId];
                 for (auto i = 0u ; i < tDatums->size() ; i++)
                 {
                     const auto& tDatumPtr = (*tDatums)[i];
@@ -89,9 +118,17 @@ namespace op
                         std::make_pair(tDatumPtr->handKeypoints3D[0], "hand_left_keypoints_3d"),
                         std::make_pair(tDatumPtr->handKeypoints3D[1], "hand_right_keypoints_3d")
                     };
-                    // Save keypoints
-                    spPeopleJsonSaver->save(
-                        keypointVector, tDatumPtr->poseCandidates, fileName, humanReadable);
+                    // Timing record (if any) up to this worker
+                    const auto timingEvents = (tDatumPtr->timing != nullptr
+                        ? tDatumPtr->timing->getEvents() : std::vector<DatumTimingEvent>{});
+                    // Save keypoints (and the flat part candidates, or the nested ones if set by user code)
+                    if (!tDatumPtr->poseCandidatesOffsets.empty())
+                        peopleJsonSaver->save(
+                            keypointVector, tDatumPtr->poseCandidatesArray, tDatumPtr->poseCandidatesOffsets,
+                            fileName, humanReadable, timingEvents);
+                    else
+                        peopleJsonSaver->save(
+                            keypointVector, tDatumPtr->poseCandidates, fileName, humanReadable, timingEvents);
                 }
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
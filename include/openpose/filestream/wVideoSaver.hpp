@@ -13,6 +13,12 @@ namespace op
     public:
         explicit WVideoSaver(const std::shared_ptr<VideoSaver>& videoSaver);
 
+        /**
+         * Constructor for several multiplexed sources (see MultiSourceProducer), with one VideoSaver per source
+         * (indexed by Datum::sourceId).
+         */
+        explicit WVideoSaver(const std::vector<std::shared_ptr<VideoSaver>>& videoSavers);
+
         virtual ~WVideoSaver();
 
         void initializationOnThread();
@@ -20,7 +26,7 @@ namespace op
         void workConsumer(const TDatums& tDatums);
 
     private:
-        std::shared_ptr<VideoSaver> spVideoSaver;
+        std::vector<std::shared_ptr<VideoSaver>> mVideoSavers;
 
         DELETE_COPY(WVideoSaver);
     };
@@ -36,8 +42,23 @@ namespace op
 {
     template<typename TDatums>
     WVideoSaver<TDatums>::WVideoSaver(const std::shared_ptr<VideoSaver>& videoSaver) :
-        spVideoSaver{videoSaver}
+        mVideoSavers{videoSaver}
+    {
+    }
+
+    template<typename TDatums>
+    WVideoSaver<TDatums>::WVideoSaver(const std::vector<std::shared_ptr<VideoSaver>>& videoSavers) :
+        mVideoSavers{videoSavers}
     {
+        try
+        {
+            if (mVideoSavers.empty())
+                error("At least 1 VideoSaver is required.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     template<typename TDatums>
@@ -60,14 +81,20 @@ namespace op
                 // Debugging log
                 opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
-                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
                 // T* to T
                 auto& tDatumsNoPtr = *tDatums;
                 // Record video(s)
                 std::vector<Matrix> opOutputDatas(tDatumsNoPtr.size());
                 for (auto i = 0u ; i < opOutputDatas.size() ; i++)
                     opOutputDatas[i] = tDatumsNoPtr[i]->cvOutputData;
-                spVideoSaver->write(opOutputDatas);
+                // Video of the source of these frames
+                const auto sourceId = (mVideoSavers.size() > 1 ? tDatumsNoPtr[0]->sourceId : 0ull);
+                if (sourceId >= mVideoSavers.size())
+                    error("No VideoSaver for source " + std::to_string(sourceId) + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+                mVideoSavers[sourceId]->write(opOutputDatas);
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
                 Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
@@ -0,0 +1,89 @@
+#ifndef OPENPOSE_FILESTREAM_W_VIDEO_STREAMER_HPP
+#define OPENPOSE_FILESTREAM_W_VIDEO_STREAMER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/filestream/videoStreamer.hpp>
+#include <openpose/thread/workerConsumer.hpp>
+
+namespace op
+{
+    template<typename TDatums>
+    class WVideoStreamer : public WorkerConsumer<TDatums>
+    {
+    public:
+        explicit WVideoStreamer(const std::shared_ptr<VideoStreamer>& videoStreamer);
+
+        virtual ~WVideoStreamer();
+
+        void initializationOnThread();
+
+        void workConsumer(const TDatums& tDatums);
+
+    private:
+        const std::shared_ptr<VideoStreamer> spVideoStreamer;
+
+        DELETE_COPY(WVideoStreamer);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WVideoStreamer<TDatums>::WVideoStreamer(const std::shared_ptr<VideoStreamer>& videoStreamer) :
+        spVideoStreamer{videoStreamer}
+    {
+    }
+
+    template<typename TDatums>
+    WVideoStreamer<TDatums>::~WVideoStreamer()
+    {
+    }
+
+    template<typename TDatums>
+    void WVideoStreamer<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WVideoStreamer<TDatums>::workConsumer(const TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
+                // T* to T
+                auto& tDatumsNoPtr = *tDatums;
+                // Stream frame(s)
+                std::vector<Matrix> opOutputDatas(tDatumsNoPtr.size());
+                for (auto i = 0u ; i < opOutputDatas.size() ; i++)
+                    opOutputDatas[i] = tDatumsNoPtr[i]->cvOutputData;
+                spVideoStreamer->write(opOutputDatas);
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WVideoStreamer);
+}
+
+#endif // OPENPOSE_FILESTREAM_W_VIDEO_STREAMER_HPP
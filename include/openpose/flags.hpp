@@ -19,10 +19,62 @@
 DEFINE_int32(logging_level,             3,              "The logging level. Integer in the range [0, 255]. 0 will output any opLog() message,"
                                                         " while 255 will not output any. Current OpenPose library messages are in the range 0-4:"
                                                         " 1 for low priority messages and 4 for important ones.");
+DEFINE_bool(logging_async,              false,          "If true, opLog() messages are only enqueued by the calling thread (in a lock-free buffer)"
+                                                        " and a background thread composes and prints them, so low `--logging_level` values (e.g.,"
+                                                        " while profiling) do not slow down the worker threads. Errors are still printed right"
+                                                        " away.");
 DEFINE_bool(disable_multi_thread,       false,          "It would slightly reduce the frame rate in order to highly reduce the lag. Mainly useful"
                                                         " for 1) Cases where it is needed a low latency (e.g., webcam in real-time scenarios with"
                                                         " low-range GPU devices); and 2) Debugging OpenPose when it is crashing to locate the"
                                                         " error.");
+DEFINE_int32(thread_pool,               0,              "Number of threads of a shared work-stealing thread pool running the CPU stages (e.g.,"
+                                                        " frame sorting, CPU rendering, saving), rather than one thread per stage. The producer,"
+                                                        " the GPU pose threads and the GUI keep their own threads. Select 0 (default) to disable"
+                                                        " it, or -1 to use as many threads as CPU cores.");
+DEFINE_int32(auto_configure,            0,              "If positive, it logs the probed hardware (CPU cores, NUMA nodes and GPUs) and, after a"
+                                                        " 10-frame warm-up, it measures the time each thread takes per frame over the next"
+                                                        " `auto_configure` frames. From that, it sets the size of each queue (longer right"
+                                                        " before the slowest stage so it is never idle, and minimal after it for the lowest"
+                                                        " latency), and it logs the resulting topology, its bottleneck and whether more replicas"
+                                                        " of it (e.g., `--num_gpu`) would help. Select 0 (default) to disable it, or e.g. 100.");
+DEFINE_int32(queue_type,                0,              "Queue type between the threads. 0 (default) for the mutex-based queues, or 1 for the"
+                                                        " lock-free ring buffer queues, which reduce the lock contention with many threads"
+                                                        " (e.g., several GPUs plus `--thread_pool`).");
+DEFINE_bool(gpu_numa_affinity,          true,           "Whether to bind each GPU thread (CPU cores and host memory) to the NUMA node its GPU is"
+                                                        " attached to. It does nothing on single-socket machines.");
+DEFINE_int32(gpu_thread_priority,       0,              "OS priority of the GPU threads. 0 for the OS default, 1 for low, 2 for high and 3 for"
+                                                        " real-time (2 and 3 require administrator rights, e.g., CAP_SYS_NICE on Linux).");
+DEFINE_int32(cpu_worker_threads,        -1,             "CPU-only version: Number of compute threads (OpenMP and MKL) of each CPU pose worker"
+                                                        " (see `--num_gpu`). Select -1 (default) to split the CPU cores evenly among the"
+                                                        " workers, or 0 for the library default (i.e., each worker uses all the cores).");
+DEFINE_bool(gpu_dispatch,                true,           "Multi-GPU (or multi-CPU worker) only. If true, each frame goes to the GPU that would"
+                                                        " finish it first (given the average frame time of each GPU and the frames it already"
+                                                        " has), rather than to the first idle GPU, so slower GPUs do not hold back the ordered"
+                                                        " output. It only changes the dispatch with GPUs of different speeds. The per-GPU"
+                                                        " statistics are logged when OpenPose closes.");
+DEFINE_int32(spillover_workers,          0,              "GPU mode only. Number of extra CPU body pose workers (running the OpenVINO model of"
+                                                        " `--spillover_model`) next to the GPU ones, which only take a frame when more than"
+                                                        " `--spillover_queue` frames are waiting for the GPUs, so bursts are absorbed by the idle"
+                                                        " CPU cores rather than waiting or being dropped. The output keeps its order. With `--face`"
+                                                        " or `--hand`, it requires `--face_hand_gpu`. Select 0 (default) to disable them.");
+DEFINE_string(spillover_model,          "",             "OpenVINO model of `--spillover_workers` (`.xml`, or `.onnx` if OpenPose was not compiled"
+                                                        " with TensorRT), relative to `--model_folder` (e.g., `pose/body_25/pose_iter_584000.xml`),"
+                                                        " converted from the body model of `--model_pose`. OpenPose must be compiled with"
+                                                        " `WITH_OPENVINO`.");
+DEFINE_int32(spillover_queue,           2,              "Number of frames waiting for the GPU workers beyond which the `--spillover_workers` take"
+                                                        " them.");
+DEFINE_int32(face_hand_gpu,              -1,             "Pipeline-parallel multi-GPU placement (`--face` and/or `--hand`). If 0 or positive, the"
+                                                        " face and hand detectors and keypoint networks run on their own thread on this GPU, after"
+                                                        " the body one(s) of `--num_gpu` and `--num_gpu_start` (which should not include it),"
+                                                        " rather than on each body GPU thread. Consecutive frames are then pipelined (the face and"
+                                                        " hand of a frame run while the body of the next one does), so the latency of each frame"
+                                                        " is no longer the sum of the 3 networks on the same GPU. The rendering is done on CPU."
+                                                        " Select -1 (default) to disable it.");
+DEFINE_double(reorder_window_ms,        0.,             "Multi-GPU (or multi-CPU worker) only. Maximum time (in ms) that the processed frames wait"
+                                                        " for an earlier one that is still being processed, before it is skipped. If it arrives"
+                                                        " later, it is dropped with real-time live sources (webcam, IP or FLIR camera with"
+                                                        " `--process_real_time`), or forwarded out of order otherwise. Select 0 (default) to"
+                                                        " wait until it arrives (or the reordering buffer is full).");
 DEFINE_int32(profile_speed,             1000,           "If PROFILER_ENABLED was set in CMake or Makefile.config files, OpenPose will show some"
                                                         " runtime statistics at this frame number.");
 #ifndef OPENPOSE_FLAGS_DISABLE_POSE
@@ -33,41 +85,153 @@ DEFINE_int32(camera,                    -1,             "The camera index for cv
 DEFINE_string(camera_resolution,        "-1x-1",        "Set the camera resolution (either `--camera` or `--flir_camera`). `-1x-1` will use the"
                                                         " default 1280x720 for `--camera`, or the maximum flir camera resolution available for"
                                                         " `--flir_camera`");
+DEFINE_bool(camera_v4l2,                false,          "Linux only (OpenPose compiled with `WITH_V4L2`). If true, `--camera` is read directly"
+                                                        " through V4L2 rather than cv::VideoCapture: memory-mapped driver buffers, only the newest"
+                                                        " frame is decoded (MJPEG with libjpeg-turbo if compiled with `WITH_TURBOJPEG`, or YUYV)"
+                                                        " into a pool of frames reused without copies, and no buffering thread.");
+DEFINE_int32(camera_v4l2_fps,           0,              "Desired webcam frame rate with `--camera_v4l2` (the driver selects the closest one)."
+                                                        " Select 0 (default) for the driver default.");
 DEFINE_string(video,                    "",             "Use a video file instead of the camera. Use `examples/media/video.avi` for our default"
-                                                        " example video.");
+                                                        " example video. Several comma-separated videos are multiplexed"
+                                                        " into the same pipeline (and output saved per video).");
 DEFINE_string(image_dir,                "",             "Process a directory of images. Use `examples/media/` for our default example folder with 20"
                                                         " images. Read all standard formats (jpg, png, bmp, etc.).");
 DEFINE_bool(flir_camera,                false,          "Whether to use FLIR (Point-Grey) stereo camera.");
 DEFINE_int32(flir_camera_index,         -1,             "Select -1 (default) to run on all detected flir cameras at once. Otherwise, select the flir"
                                                         " camera index to run, where 0 corresponds to the detected flir camera with the lowest"
                                                         " serial number, and `n` to the `n`-th lowest serial number camera.");
-DEFINE_string(ip_camera,                "",             "String with the IP camera URL. It supports protocols like RTSP and HTTP.");
+DEFINE_bool(flir_camera_bayer_gpu,      false,          "Complementary option for `--flir_camera`. If enabled, the raw Bayer images (8-bit Bayer"
+                                                        " pixel format required) are uploaded into the GPU, where they are debayered together with"
+                                                        " the network input resize, rather than being converted into BGR on the CPU. The BGR"
+                                                        " frames are only downloaded if some enabled feature needs them. With `--frame_undistort`,"
+                                                        " they are undistorted in the same GPU resize, and analogously rotated"
+                                                        " and flipped with `--frame_rotate` and `--frame_flip`.");
+DEFINE_double(flir_camera_sync_ms,      5.,             "Complementary option for `--flir_camera`. Each camera is read by its own thread, and the"
+                                                        " images of the different cameras are assembled into the same frame set if their"
+                                                        " timestamps are within this tolerance (in milliseconds, after removing the clock offset"
+                                                        " between cameras). Images without a counterpart in the other cameras are dropped.");
+DEFINE_string(ip_camera,                "",             "String with the IP camera URL. It supports protocols like RTSP and HTTP. Several"
+                                                        " comma-separated URLs are multiplexed into the same pipeline"
+                                                        " (and output saved per camera). Each stream is received in its own"
+                                                        " thread, which only keeps the latest frame and reconnects in the"
+                                                        " background if the stream is lost.");
 DEFINE_uint64(frame_first,              0,              "Start on desired frame number. Indexes are 0-based, i.e., the first frame has index 0.");
 DEFINE_uint64(frame_step,               1,              "Step or gap between processed frames. E.g., `--frame_step 5` would read and process frames"
                                                         " 0, 5, 10, etc..");
 DEFINE_uint64(frame_last,               -1,             "Finish on desired frame number. Select -1 to disable. Indexes are 0-based, e.g., if set to"
                                                         " 10, it will process 11 frames (0-10).");
 DEFINE_bool(frame_flip,                 false,          "Flip/mirror each frame (e.g., for real time webcam demonstrations).");
-DEFINE_int32(frame_rotate,              0,              "Rotate each frame, 4 possible values: 0, 90, 180, 270.");
+DEFINE_int32(frame_rotate,              0,              "Rotate each frame, 4 possible values: 0, 90, 180, 270. The frames in GPU memory (e.g.,"
+                                                        " `--video_nvdec`) are rotated (and flipped) while resized into the network input.");
 DEFINE_bool(frames_repeat,              false,          "Repeat frames when finished.");
 DEFINE_bool(process_real_time,          false,          "Enable to keep the original source frame rate (e.g., for video). If the processing time is"
-                                                        " too long, it will skip frames. If it is too fast, it will slow it down.");
+                                                        " too long, it will skip frames. If it is too fast, it will slow it down. For live sources"
+                                                        " (webcam, IP and FLIR cameras), only the latest frame is queued if the processing is slower"
+                                                        " than the camera, bounding the latency to about 1 frame.");
 DEFINE_string(camera_parameter_path,    "models/cameraParameters/flir/", "String with the folder where the camera parameters are located. If there"
                                                         " is only 1 XML file (for single video, webcam, or images from the same camera), you must"
                                                         " specify the whole XML file path (ending in .xml).");
 DEFINE_bool(frame_undistort,            false,          "If false (default), it will not undistort the image, if true, it will undistortionate them"
-                                                        " based on the camera parameters found in `camera_parameter_path`");
+                                                        " based on the camera parameters found in `camera_parameter_path`. The remap tables of"
+                                                        " each camera are computed once (per resolution), and the GPU frames (e.g.,"
+                                                        " `--video_nvdec`) are undistorted while resized into the network input.");
+DEFINE_bool(frame_undistort_keypoints,  false,          "Alternative to `--frame_undistort` for the 3-D reconstruction (`--3d`). If true, the"
+                                                        " frames are not undistorted (so the network runs on the raw distorted frames), but only"
+                                                        " the 2-D keypoints (body, face, and hands) right before their triangulation, based on the"
+                                                        " camera parameters found in `camera_parameter_path`. The 2-D keypoints of the output and"
+                                                        " GUI remain distorted. It is not compatible with `--frame_undistort`.");
+DEFINE_bool(video_nvdec,                false,          "Complementary option for `--video`. If true, the video is decoded by the NVIDIA GPU"
+                                                        " hardware decoder (NVDEC) into GPU memory (on `--num_gpu_start`), and the network input is"
+                                                        " resized there, so the frames are only copied into CPU memory if required (e.g., for"
+                                                        " rendering, face, hand or video/image saving). OpenPose must be compiled with `WITH_NVDEC`.");
+DEFINE_int32(image_dir_threads,         0,              "Complementary option for `--image_dir`. Number of threads decoding the next images in"
+                                                        " parallel (with a look-ahead of 2 images per thread), while they are still processed in"
+                                                        " order. Useful when image decoding (e.g., JPEG) is the bottleneck. Select 0 to load each"
+                                                        " image synchronously.");
+DEFINE_bool(image_dir_stream,           false,          "Complementary option for `--image_dir`. If enabled, the directory is listed in a background"
+                                                        " thread and its first images are processed while the listing continues, rather than"
+                                                        " listing and sorting all of them first (which might take a while for directories with"
+                                                        " millions of images). The images are then processed in file system order (i.e., not"
+                                                        " sorted by name). Not compatible with `--frame_last`.");
+DEFINE_string(input_roi,                "",             "Static region of interest of the camera(s), so the body network only processes its bounding"
+                                                        " box (at `--net_resolution`) rather than the whole frame (e.g., only the floor of a fixed"
+                                                        " camera). Space-separated `x,y` pixel points: 2 points for a rectangle (top-left and"
+                                                        " bottom-right corners, e.g., `0,300 1920,1080`) or 3 or more for a polygon (the area"
+                                                        " outside it is masked out). Separate them with `;` to give a different one to each view"
+                                                        " or source (e.g., `0,300 1920,1080;0,0 1280,720`). The keypoints are still in full-frame"
+                                                        " coordinates. If empty (default), the optional `InputRoi` node (#points x 2 matrix) of"
+                                                        " each camera parameter file is used instead (if they are read, e.g., `--3d` or"
+                                                        " `--frame_undistort`). It requires the frames in CPU memory.");
+DEFINE_string(source_priority,          "",             "Complementary option for several multiplexed sources (e.g., comma-separated `--ip_camera`"
+                                                        " or `--video`). Comma-separated priority class of each source (e.g., `1,0` for a live"
+                                                        " camera and an archive video): the frames of the highest class available are processed"
+                                                        " first, and the lower classes fill the idle cycles. Empty (default) for the same class,"
+                                                        " i.e., round-robin across all of them.");
+DEFINE_string(source_max_latency_ms,    "",             "Complementary option for several multiplexed sources. Comma-separated maximum time (in"
+                                                        " milliseconds) each frame of each source can wait before being processed, e.g., `100,0`."
+                                                        " The frames exceeding it are dropped rather than processed late. 0 or empty (default)"
+                                                        " for no limit (e.g., for videos, so no frame is lost).");
+DEFINE_int32(video_decoders,            0,              "Complementary option for `--video` (offline processing). Number of decoders (each one with"
+                                                        " its own cv::VideoCapture and thread) decoding consecutive segments of the same video in"
+                                                        " parallel, while the frames are still returned in order. Useful when a single decoder"
+                                                        " (e.g., 4K H.265) is slower than the GPUs. Each decoder keeps up to 1 segment of frames"
+                                                        " in memory. Select 0 to decode it with a single cv::VideoCapture.");
+DEFINE_int32(video_segment_frames,      250,            "Complementary option for `--video_decoders`. Number of frames of each segment. Segments"
+                                                        " start at multiples of it, so it should be a multiple of the keyframe interval (GOP"
+                                                        " size) of the video, otherwise each seek also decodes the frames since the previous"
+                                                        " keyframe.");
+DEFINE_int32(datum_pool_size,           0,              "Maximum number of released Datums (frames) that are kept and recycled for the next"
+                                                        " frames, rather than allocating new ones for each frame. It should be around the number"
+                                                        " of frames processed at the same time (e.g., 2 x the number of GPUs + 4). Select 0 to"
+                                                        " disable it.");
+DEFINE_int32(decode_ahead,              -1,             "Video, image directory and input replay only. If 0 or positive, credit-based flow"
+                                                        " control: the producer only reads a new frame while fewer than (`--num_gpu` x"
+                                                        " `--batch_size` + `decode_ahead`) frames are between it and the end of the GPU threads,"
+                                                        " regardless of the queue sizes. It bounds the memory of the decoded frames (e.g., 4K"
+                                                        " ones) while keeping the GPUs busy, e.g., 2 to 4. Select -1 (default) to disable it.");
+DEFINE_string(input_replay,             "",             "Use an input recording of `--input_record` instead of the camera. Its frames are re-emitted"
+                                                        " with their recorded frame numbers and camera parameters, as fast as possible, or following"
+                                                        " the recorded arrival time of each frame with `--process_real_time`.");
+DEFINE_string(shm_input,                "",             "Use the frames written by another process of the same host into this shared memory frame"
+                                                        " ring buffer (see `include/openpose/producer/frameRingFormat.hpp`) instead of the"
+                                                        " camera. The BGR frames are not copied, each slot is given back to the writer once its"
+                                                        " network input has been computed.");
+DEFINE_string(datum_receive,            "",             "Use the frame sets sent by the `--datum_send` of another OpenPose process (on this or"
+                                                        " another node) instead of the camera, listening on this `[host:]port` (e.g., `9000`). It"
+                                                        " stops once the sender finishes. It splits the pipeline across processes, e.g., decoding on"
+                                                        " a CPU node and the pose estimation on a GPU one.");
+DEFINE_int32(datum_receive_window,      8,              "Flow control of `--datum_receive`: maximum number of frame sets sent but not fully"
+                                                        " processed yet by this process. The sender waits once it is reached.");
+DEFINE_string(input_record,             "",             "If not empty, the frames read by the producer (e.g., a camera), their arrival times, frame"
+                                                        " numbers, and camera parameters are recorded into this file, so the same input can be"
+                                                        " replayed later on with `--input_replay` (or `openpose_bench --bench_replay`), e.g., to"
+                                                        " reproduce performance issues of a live camera.");
+DEFINE_string(input_record_format,      "jpg",          "Image format of the frames of `--input_record`, e.g., `jpg` (smaller) or `png` (lossless)."
+                                                        " Any format supported by cv::imencode.");
 #endif // OPENPOSE_FLAGS_DISABLE_PRODUCER
 // OpenPose
 DEFINE_string(model_folder,             "models/",      "Folder path (absolute or relative) where the models (pose, face, ...) are located.");
 DEFINE_string(prototxt_path,            "",             "The combination `--model_folder` + `--prototxt_path` represents the whole path to the"
                                                         " prototxt file. If empty, it will use the default OpenPose ProtoTxt file.");
 DEFINE_string(caffemodel_path,          "",             "The combination `--model_folder` + `--caffemodel_path` represents the whole path to the"
-                                                        " caffemodel file. If empty, it will use the default OpenPose CaffeModel file.");
+                                                        " caffemodel file. If empty, it will use the default OpenPose CaffeModel file. If it is"
+                                                        " an ONNX model (`.onnx` extension), the TensorRT backend is used instead of Caffe"
+                                                        " (OpenPose must be compiled with `WITH_TENSORRT`). If it is an OpenVINO IR model (`.xml`"
+                                                        " extension), or an ONNX model without TensorRT, the OpenVINO backend is used (CPU-only"
+                                                        " version compiled with `WITH_OPENVINO`).");
+DEFINE_int32(tensorrt_precision,        16,             "Only if `--caffemodel_path` is an ONNX or OpenVINO model. TensorRT precision: 32"
+                                                        " (FP32), 16 (FP16, default and recommended) or 8 (INT8, it requires the TensorRT"
+                                                        " calibration cache `{model}.int8.calib` next to the ONNX model, e.g., generated with"
+                                                        " `openpose_calibrate_int8`). The TensorRT engines are cached next to the ONNX model, so"
+                                                        " they are only built (which takes a few minutes) once. With the OpenVINO backend"
+                                                        " (CPU-only version, `--caffemodel_path` ending in `.xml`), 32 (FP32), 16 (BF16 if the"
+                                                        " CPU supports it) or 8 (INT8, it requires a quantized model or the same calibration"
+                                                        " cache).");
 DEFINE_string(output_resolution,        "-1x-1",        "The image resolution (display and output). Use \"-1x-1\" to force the program to use the"
                                                         " input image resolution.");
 DEFINE_int32(num_gpu,                   -1,             "The number of GPU devices to use. If negative, it will use all the available GPUs in your"
-                                                        " machine.");
+                                                        " machine. In the CPU-only version, the number of CPU pose workers processing"
+                                                        " different frames concurrently (1 if negative).");
 DEFINE_int32(num_gpu_start,             0,              "GPU device start number.");
 DEFINE_int32(keypoint_scale,            0,              "Scaling of the (x,y) coordinates of the final pose data array, i.e., the scale of the (x,y)"
                                                         " coordinates that will be saved with the `write_json` & `write_keypoint` flags."
@@ -126,8 +290,19 @@ DEFINE_bool(heatmaps_add_bkg,           false,          "Same functionality as `
 DEFINE_bool(heatmaps_add_PAFs,          false,          "Same functionality as `add_heatmaps_parts`, but adding the PAFs.");
 DEFINE_int32(heatmaps_scale,            2,              "Set 0 to scale op::Datum::poseHeatMaps in the range [-1,1], 1 for [0,1]; 2 for integer"
                                                         " rounded [0,255]; and 3 for no scaling.");
+DEFINE_bool(heatmaps_lazy,              false,          "Only for CUDA. If true, the heat maps (`--heatmaps_add_*`) are kept on the GPU and only"
+                                                        " downloaded the first time they are read (e.g., by `--write_heatmaps` or by"
+                                                        " op::Datum::getPoseHeatMaps()), rather than on every frame. op::Datum::poseHeatMaps is"
+                                                        " empty until then.");
+DEFINE_double(heatmaps_sparse_threshold, -1.,           "If >= 0, the heat maps (`--heatmaps_add_*`) are filled into op::Datum::poseHeatMapsSparse"
+                                                        " rather than op::Datum::poseHeatMaps: only the values whose absolute value is higher"
+                                                        " than this threshold (e.g., 0.05) are kept, as (index, value) lists per channel. With"
+                                                        " CUDA, they are thresholded and compacted on the GPU, so only the kept values are"
+                                                        " downloaded. They are not scaled (`--heatmaps_scale` 3), and `--write_heatmaps` with the"
+                                                        " `opheat` formats saves them sparse too.");
 DEFINE_bool(part_candidates,            false,          "Also enable `write_json` in order to save this information. If true, it will fill the"
-                                                        " op::Datum::poseCandidates array with the body part candidates. Candidates refer to all"
+                                                        " op::Datum::poseCandidatesArray (flat, see op::Datum::poseCandidatesOffsets) with the body"
+                                                        " part candidates (op::Datum::getPoseCandidates() for the nested version). Candidates refer to all"
                                                         " the detected body parts, before being assembled into people. Note that the number of"
                                                         " candidates is equal or higher than the number of final body parts (i.e., after being"
                                                         " assembled into people). The empty body parts are filled with 0s. Program speed will"
@@ -135,6 +310,117 @@ DEFINE_bool(part_candidates,            false,          "Also enable `write_json
                                                         " use this information.");
 DEFINE_double(upsampling_ratio,         0.,             "Upsampling ratio between the `net_resolution` and the output net results. A value less"
                                                         " or equal than 0 (default) will use the network default value (recommended).");
+DEFINE_int32(batch_size,                1,              "Maximum number of frames that each GPU stacks into a single network forward pass. 1"
+                                                        " (default) processes each frame independently. Greater values increase the GPU"
+                                                        " utilization (e.g., when processing many streams at once) at the cost of latency and GPU"
+                                                        " memory. Not compatible with `--tracking` > 0.");
+DEFINE_int64(batch_max_wait,            5000,           "Only if `--batch_size` > 1. Maximum time (in microseconds) that each GPU waits for"
+                                                        " `batch_size` frames before running a partial batch.");
+DEFINE_int32(gpu_memory_budget,         0,              "Only for CUDA. GPU memory (in MB) that this process can use in each GPU, e.g., when"
+                                                        " several OpenPose instances share the same GPUs. If positive, the GPU memory of the body,"
+                                                        " face and hand networks and the GPU renderers is projected at start-up, `--batch_size` is"
+                                                        " decreased to the maximum that fits, and OpenPose stops with a report of each component"
+                                                        " if not even 1 frame fits (rather than going out of memory at runtime). -1 uses the free"
+                                                        " memory of each GPU at start-up. 0 (default) disables it.");
+DEFINE_bool(warm_up,                    false,          "If true, each GPU runs the body network once on the network input sizes of the producer"
+                                                        " resolution (and the ones of `--warm_up_cache`) before processing the first frame, so the"
+                                                        " first frames do not suffer the latency spike of the network memory allocation,"
+                                                        " convolution algorithm selection and kernel loading.");
+DEFINE_string(warm_up_cache,            "",             "If not empty, text file where the network input sizes processed on each GPU model are"
+                                                        " recorded (keyed by GPU, CUDA versions and model), so the following runs also warm them up"
+                                                        " (e.g., with `--latency_target` or `--net_resolution_dynamic` that change them at"
+                                                        " runtime). It implies `--warm_up`.");
+DEFINE_bool(net_memory_sharing,         false,          "If true, the body, face and hand Caffe networks of each GPU thread place their intermediate"
+                                                        " activations into a single GPU memory block (as they run one after the other), so they use"
+                                                        " the activation memory of the largest network rather than the sum of all of them. Only"
+                                                        " for CUDA.");
+DEFINE_string(tiled_resolution,         "0x0",          "Tiled inference for very high resolution inputs (e.g., 8K cameras with small people). If"
+                                                        " not `0x0`, the frame is resized to this resolution (multiples of 16, `-1` keeps the aspect"
+                                                        " ratio as in `--net_resolution`) and split into overlapping tiles of `--net_resolution`"
+                                                        " (squared if one of its dimensions is -1), which run as a single batch and whose heat maps"
+                                                        " and PAFs are stitched before the NMS and the body part connection. Thus, the network"
+                                                        " memory grows with the number of tiles. Combine it with `--paf_low_resolution` so the"
+                                                        " stitched heat maps are not upsampled to the whole resolution. It sets `--scale_number 1`"
+                                                        " and `--batch_size 1`.");
+DEFINE_double(tile_overlap,             0.25,           "Only if `--tiled_resolution` is not `0x0`. Minimum overlap between neighbouring tiles, as a"
+                                                        " ratio of the tile size, in [0, 0.5). The overlaps are blended linearly.");
+DEFINE_int32(net_stages,                0,              "Stage-truncated body network (Caffe models only), for latency-critical applications. If"
+                                                        " positive, only the first `net_stages` refinement stages of each branch (heat maps and"
+                                                        " PAFs) of the body network are run and their outputs are used as the network output,"
+                                                        " trading accuracy for speed. E.g., COCO and MPI have 6 stages (`MPI_4_layers` 4), and"
+                                                        " BODY_25 has 4 PAF and 2 heat map stages (and its heat map stages read its last PAF"
+                                                        " stage, so only the heat map stages are truncated). 0 (default) to run all of them. See"
+                                                        " doc/06_maximizing_openpose_speed.md for the compute of each stage.");
+DEFINE_bool(pose_shared_pool,           false,          "If true, the body network of each GPU is loaded once per process and shared by all the"
+                                                        " OpenPose pipelines (e.g., several `op::Wrapper` instances of the same Python or C++"
+                                                        " program) with the same model and network options, which submit their frames to it"
+                                                        " in round-robin order. The post-processing (e.g., thresholds, heat maps, face, hand,"
+                                                        " tracking) is still configured per pipeline. Not compatible with"
+                                                        " `--roi_tracking_interval`.");
+DEFINE_double(scale_adaptive,           0.,             "Adaptive multi-scale, only if `--scale_number` > 1. If positive, the whole frame only runs"
+                                                        " the smallest scale, and the largest one (`--net_resolution`) only runs on crops around"
+                                                        " the people whose height (relative to the image height) is lower than this value (e.g.,"
+                                                        " 0.25) or whose keypoints are not confident, so the small people keep the accuracy of"
+                                                        " the largest scale without paying for it on every frame. Not compatible with"
+                                                        " `--batch_size` > 1, `--pose_pipelined` nor `--roi_tracking_interval`.");
+DEFINE_bool(scale_batch,                false,          "Only if `--scale_number` > 1. If true, all the scales are padded to the size of the"
+                                                        " largest one and processed by a single network forward pass (i.e., a batch of"
+                                                        " `scale_number` images), rather than by one network per scale. It saves GPU memory and"
+                                                        " it is usually faster, but the keypoints might slightly change due to the extra padding."
+                                                        " Not compatible with `--batch_size` > 1.");
+DEFINE_bool(heatmaps_fp16,              false,          "Only for CUDA. If true, the upsampled body heat maps are internally stored in half"
+                                                        " precision (FP16), halving the GPU memory and bandwidth of the resize, NMS and PAF"
+                                                        " scoring steps (the computations are still done in FP32). The keypoints might slightly"
+                                                        " change. Heat map outputs and rendering get an FP32 copy on demand.");
+DEFINE_bool(cuda_graphs,                false,          "Only for CUDA 11 or higher. If true, the per-frame kernels of the body heat map resize and"
+                                                        " NMS are captured into a CUDA Graph once per shape (a few shapes are cached, e.g., for"
+                                                        " `--latency_target`), and only that graph is launched on the next frames, reducing the"
+                                                        " launch overhead at small `net_resolution`. The output does not change.");
+DEFINE_string(cuda_autotune_cache,      "",             "Only for CUDA. If not empty, the block sizes of the body heat map resize, fused NMS and"
+                                                        " keypoint rendering kernels are autotuned: the first time each kernel runs with a given"
+                                                        " shape on a GPU model, its candidate block sizes are benchmarked (a one-time latency"
+                                                        " spike) and the fastest one is used from then on. The results are saved into this text"
+                                                        " file (keyed by GPU model, kernel and shape), so the following runs reuse them. Remove it"
+                                                        " to tune them again (e.g., after a driver update).");
+DEFINE_bool(paf_low_resolution,         false,          "Only for CUDA. If true, the PAF channels are not upsampled, the body part connection"
+                                                        " samples them directly at network resolution with bilinear interpolation (only the body"
+                                                        " part heat maps are upsampled for the NMS). It saves most of the memory and bandwidth of"
+                                                        " the upsampled heat maps. The keypoints might slightly change. It is ignored with"
+                                                        " `--scale_number` > 1 or if any heat map is requested (`--heatmaps_add_*`).");
+DEFINE_bool(pose_pipelined,             false,          "Only for CUDA. If true, each GPU thread queues the body network of the next frame before"
+                                                        " post-processing (NMS, body part connection and `number_people_max`) the current one, so"
+                                                        " the CPU post-processing overlaps the GPU network. It increases the throughput at the"
+                                                        " cost of 1 frame of latency. The output does not change. Not compatible with"
+                                                        " `--batch_size` > 1, `--motion_gate`, `--roi_tracking_interval` nor `--tracking`.");
+DEFINE_string(net_output_cache,         "",             "Directory of a cache of the body network outputs (e.g., `cache/`), useful to re-process the same"
+                                                        " images with different post-processing, face or hand settings. The network output of each"
+                                                        " frame is addressed by the content of its network input (i.e., image, `--net_resolution`"
+                                                        " and scales) and model, so the network only runs on a miss and its output is saved in"
+                                                        " float16 (Zstandard-compressed if OpenPose was compiled with `WITH_ZSTD`). The new entries"
+                                                        " are available from the next run on. Not used with `--batch_size` > 1. Leave empty to"
+                                                        " disable it.");
+DEFINE_double(latency_target,           0.,             "Target latency per frame (in milliseconds). If positive, the network resolution is"
+                                                        " adapted at runtime between `net_resolution_min` and `net_resolution` (in multiples of"
+                                                        " 16) to keep the latency of each frame close to it, e.g., lowering it when there are"
+                                                        " many people or the GPU is shared. 0 (default) disables it.");
+DEFINE_string(net_resolution_min,       "-1x256",       "Only if `--latency_target` > 0. Minimum network resolution. Its `-1` must be in the"
+                                                        " same dimension than in `net_resolution`.");
+DEFINE_int32(roi_tracking_interval,     0,              "ROI tracking mode for videos and webcams. If greater than 1, the full-frame body"
+                                                        " detection only runs once every `roi_tracking_interval` frames (or earlier if any person"
+                                                        " is lost), and the frames in between only run the body network on an enlarged crop"
+                                                        " around each person of the previous frame, which is much faster for a few large"
+                                                        " people. New people only appear on the full-frame detections. Not compatible with the"
+                                                        " heat maps nor `--part_candidates`. 0 or 1 (default) disables it.");
+DEFINE_double(motion_gate,              0.,             "Motion-gated inference for static cameras (e.g., surveillance). If greater than 0, the"
+                                                        " frames in which at most this ratio (in the range [0, 1], e.g., 0.005) of the pixels of a"
+                                                        " small grayscale thumbnail changed with respect to the last processed frame skip the body"
+                                                        " network, and reuse its body keypoints. Not compatible with `--batch_size` > 1, the heat"
+                                                        " maps nor `--part_candidates`. 0 (default) disables it.");
+DEFINE_int32(motion_gate_pixel_threshold, 12,           "Only if `--motion_gate` > 0. Minimum intensity difference (in the range [0, 255]) of a"
+                                                        " changed thumbnail pixel. Higher values ignore more sensor noise and lighting flicker.");
+DEFINE_int32(motion_gate_max_skip,      30,             "Only if `--motion_gate` > 0. Maximum number of consecutive frames that reuse the"
+                                                        " keypoints of the same processed frame, so the keypoints are refreshed at least once"
+                                                        " every `motion_gate_max_skip` + 1 frames.");
 // OpenPose Face
 DEFINE_bool(face,                       false,          "Enables face keypoint detection. It will share some parameters from the body pose, e.g."
                                                         " `model_folder`. Note that this will considerable slow down the performance and increse"
@@ -146,7 +432,13 @@ DEFINE_int32(face_detector,             0,              "Kind of face rectangle
                                                         " also apply hand tracking (only for hand). Hand tracking might improve hand keypoint"
                                                         " detection for webcam (if the frame rate is high enough, i.e., >7 FPS per GPU) and video."
                                                         " This is not person ID tracking, it simply looks for hands in positions at which hands were"
-                                                        " located in previous frames, but it does not guarantee the same person ID among frames.");
+                                                        " located in previous frames, but it does not guarantee the same person ID among frames. Select 4"
+                                                        " to select the CNN face detector (not implemented for hands), which runs on the GPU and"
+                                                        " requires the `face/face_detector.*` model in `model_folder`.");
+DEFINE_string(face_detector_net_resolution, "-1x256", "Multiples of 32. Analogous to `net_resolution` but applied to the CNN face"
+                                                        " detector (`--face_detector 4`), -1 keeps the input aspect ratio.");
+DEFINE_int32(face_detector_scale_number, 1,             "Analogous to `scale_number` but applied to the CNN face detector. All the"
+                                                        " scales are processed in a single batched forward pass.");
 DEFINE_string(face_net_resolution,      "368x368",      "Multiples of 16 and squared. Analogous to `net_resolution` but applied to the face keypoint"
                                                         " detector. 320x320 usually works fine while giving a substantial speed up when multiple"
                                                         " faces on the image.");
@@ -162,11 +454,35 @@ DEFINE_int32(hand_scale_number,         1,              "Analogous to `scale_num
 DEFINE_double(hand_scale_range,         0.4,            "Analogous purpose than `scale_gap` but applied to the hand keypoint detector. Total range"
                                                         " between smallest and biggest scale. The scales will be centered in ratio 1. E.g., if"
                                                         " scaleRange = 0.4 and scalesNumber = 2, then there will be 2 scales, 0.8 and 1.2.");
+DEFINE_bool(face_hand_concurrent,       false,          "If both `--face` and `--hand` are enabled, it runs the face and hand keypoint detectors at"
+                                                        " the same time (each one in its own thread) rather than one after the other. It reduces"
+                                                        " the latency when both are used, at the cost of 1 extra CPU thread per GPU.");
+DEFINE_int32(face_hand_roi_cache,       0,              "If greater than 0, the face and hand keypoints of each person are reused for up to this"
+                                                        " number of consecutive frames while its face or hand rectangle barely moves and its last"
+                                                        " computed keypoints were confident, skipping the face and hand networks for them. It"
+                                                        " requires the person IDs of `--identification` or `--tracking`. Not compatible with the"
+                                                        " face and hand heat maps.");
+DEFINE_bool(face_hand_adaptive_crop,    false,          "If true, each face and hand is cropped at the smallest of 128, 256, and"
+                                                        " `--face_net_resolution` (or `--hand_net_resolution`) that is not smaller than its"
+                                                        " rectangle, rather than always at the net resolution, so small faces and hands are"
+                                                        " faster. Not compatible with the face and hand heat maps.");
+DEFINE_double(face_hand_from_body,      -1.,            "Only for `--model_pose BODY_135` (which also predicts the face and hand keypoints). If 0"
+                                                        " or positive, the face and hand keypoints of each person are filled directly from the"
+                                                        " BODY_135 body keypoints if the average score of its BODY_135 face (or hand) parts is not"
+                                                        " lower than this value, so the face and hand networks (`--face`, `--hand`) only refine"
+                                                        " the people whose BODY_135 face or hand is not confident enough. 0 never runs them (the"
+                                                        " whole-body output costs a single body network forward pass). Negative disables it.");
+DEFINE_double(face_hand_lazy_idle_s,    -1.,            "If 0 or positive, the face and hand networks (`--face`, `--hand`) are not loaded at"
+                                                        " startup but on the first frame with a face (or hand) to be processed, so views where"
+                                                        " they are never visible do not use their GPU memory. If positive, each network is also"
+                                                        " released after this number of seconds without any face (or hand), returning its GPU"
+                                                        " memory (e.g., to the body network batches), and loaded again when needed. -1 (default)"
+                                                        " loads them at startup.");
 // OpenPose 3-D Reconstruction
 DEFINE_bool(3d,                         false,          "Running OpenPose 3-D reconstruction demo: 1) Reading from a stereo camera system."
                                                         " 2) Performing 3-D reconstruction from the multiple views. 3) Displaying 3-D reconstruction"
-                                                        " results. Note that it will only display 1 person. If multiple people is present, it will"
-                                                        " fail.");
+                                                        " results. Note that it will only display 1 person (unless `--3d_multi_person`). If"
+                                                        " multiple people is present, it will fail.");
 DEFINE_int32(3d_min_views,              -1,             "Minimum number of views required to reconstruct each keypoint. By default (-1), it will"
                                                         " require max(2, min(4, #cameras-1)) cameras to see the keypoint in order to reconstruct"
                                                         " it.");
@@ -174,15 +490,45 @@ DEFINE_int32(3d_views,                  -1,             "Complementary option fo
                                                         " iteration, allowing tasks such as stereo camera processing (`--3d`). Note that"
                                                         " `--camera_parameter_path` must be set. OpenPose must find as many `xml` files in the"
                                                         " parameter folder as this number indicates.");
+DEFINE_bool(3d_multi_person,            false,          "If true, the people of each view are associated across the views (from the epipolar"
+                                                        " distances of their body keypoints), and all the ones visible on at least 2 views are"
+                                                        " reconstructed. Otherwise (default), the first person of each view is assumed to be the"
+                                                        " same one, and only that one is reconstructed.");
+DEFINE_bool(3d_temporal,                false,          "If true, each 3-D keypoint is initialized from its reconstruction on the previous frame and"
+                                                        " refined with a single Gauss-Newton step, and it is only triangulated from scratch (with"
+                                                        " the reprojection-error-based view rejection) if its reprojection error jumps, which is"
+                                                        " much faster in continuous capture. With `--3d_multi_person`, the people are matched"
+                                                        " across frames by their ids, so it also requires `--tracking` or `--identification`.");
+DEFINE_bool(3d_gpu_affinity,            false,          "Multi-GPU only. If true, each camera view of the 3-D frame sets goes to a fixed GPU (view i to"
+                                                        " GPU i % `--num_gpu`), so the views of each set run in parallel on all the GPUs and each GPU"
+                                                        " always processes the same cameras. Otherwise, each view goes to the next available GPU (see"
+                                                        " `--gpu_dispatch`), which can take several views of the same set.");
 // Extra algorithms
 DEFINE_bool(identification,             false,          "Experimental, not available yet. Whether to enable people identification across frames.");
 DEFINE_int32(tracking,                  -1,             "Experimental, not available yet. Whether to enable people tracking across frames. The"
                                                         " value indicates the number of frames where tracking is run between each OpenPose keypoint"
                                                         " detection. Select -1 (default) to disable it or 0 to run simultaneously OpenPose keypoint"
                                                         " detector and tracking for potentially higher accurary than only OpenPose.");
+DEFINE_bool(tracking_extrapolation,     false,          "Only if `--tracking` > 0. If true, the frames between the OpenPose keypoint detections"
+                                                        " get their body keypoints from a per-person constant-velocity Kalman filter of each"
+                                                        " keypoint (by person ID, so multiple people require `--identification`), rather than from"
+                                                        " the LK tracking of the images. It is much cheaper (e.g., `--tracking 3` on a high frame"
+                                                        " rate camera only runs the body network on 1 of every 4 frames), but less accurate for"
+                                                        " sudden motions.");
 DEFINE_int32(ik_threads,                0,              "Experimental, not available yet. Whether to enable inverse kinematics (IK) from 3-D"
                                                         " keypoints to obtain 3-D joint angles. By default (0 threads), it is disabled. Increasing"
                                                         " the number of threads will increase the speed but also the global system latency.");
+DEFINE_string(person_crops,             "",             "If not empty (e.g., `192x256`), it produces a crop of each detected person of that"
+                                                        " resolution (width x height) on the GPU, in `op::Datum::personCropsGpu` (batched, 3 x"
+                                                        " height x width normalized floats per person, as the network inputs), e.g., for a second"
+                                                        " model (like action recognition) without any host round-trip. Each crop is the bounding"
+                                                        " box of the body keypoints above `--render_threshold`, enlarged by `--person_crops_scale`"
+                                                        " and padded to the crop aspect ratio. It requires CUDA.");
+DEFINE_double(person_crops_scale,       1.2,            "Only if `--person_crops`. Enlargement factor of the keypoint bounding box of each crop.");
+DEFINE_bool(person_crops_align,         false,          "Only if `--person_crops`. If true, each crop is rotated so the torso (mid-hip to neck) of"
+                                                        " its person is vertical, rather than axis-aligned.");
+DEFINE_bool(person_crops_download,      false,          "Only if `--person_crops`. If true, the crops are also copied into pinned host memory"
+                                                        " (`op::Datum::personCrops`).");
 // OpenPose Rendering
 DEFINE_int32(part_to_show,              0,              "Prediction channel to visualize: 0 (default) for all the body parts, 1 for the background"
                                                         " heat map, 2 for the superposition of heatmaps, 3 for the superposition of PAFs,"
@@ -226,6 +572,16 @@ DEFINE_bool(no_gui_verbose,             false,          "Do not write text on ou
 DEFINE_int32(display,                   -1,             "Display mode: -1 for automatic selection; 0 for no display (useful if there is no X server"
                                                         " and/or to slightly speed up the processing if visual output is not required); 2 for 2-D"
                                                         " display; 3 for 3-D display (if `--3d` enabled); and 1 for both 2-D and 3-D display.");
+DEFINE_bool(display_vsync,              false,          "Synchronize the display with the monitor refresh rate (it might block the GUI thread up to a"
+                                                        " refresh period per frame). It requires OpenPose compiled with `WITH_OPENCV_WITH_OPENGL`.");
+DEFINE_bool(display_skip_stale,         false,          "Do not display the frames that are older than the next frame already waiting for the GUI,"
+                                                        " so a slow display (e.g., 4K) never slows down the processing. Each displayed frame might"
+                                                        " not be the following one (i.e., the video looks choppy).");
+DEFINE_bool(display_overlay,            false,          "For the 2-D display, keep the GUI text (e.g., number of current frame and people) in its own"
+                                                        " overlay layer, composited over each frame when displaying it (on the GPU if OpenPose is"
+                                                        " compiled with `WITH_OPENCV_WITH_OPENGL`), and only drawn again when its values change."
+                                                        " The frames themselves are not modified, so the saved and returned frames do not contain"
+                                                        " that text.");
 #endif // OPENPOSE_FLAGS_DISABLE_DISPLAY
 // Command Line Interface Verbose
 DEFINE_double(cli_verbose,              -1.f,           "If -1, it will be disabled (default). If it is a positive integer number, it will print on"
@@ -235,6 +591,12 @@ DEFINE_double(cli_verbose,              -1.f,           "If -1, it will be disab
 DEFINE_string(write_images,             "",             "Directory to write rendered frames in `write_images_format` image format.");
 DEFINE_string(write_images_format,      "png",          "File extension and format for `write_images`, e.g., png, jpg or bmp. Check the OpenCV"
                                                         " function cv::imwrite for all compatible extensions.");
+DEFINE_bool(write_jpg_gpu,              false,          "Only for CUDA and OpenPose compiled with `WITH_NVJPEG`. If true, the `jpg` images of"
+                                                        " `write_images` and `write_heatmaps` are encoded on the GPU with nvJPEG (the rendered"
+                                                        " frames straight from the GPU rendering, if any), and only their compressed bytes are"
+                                                        " copied to the CPU and written by a background thread. Other formats are still encoded"
+                                                        " with OpenCV. Changes to op::Datum::cvOutputData after the GPU rendering (e.g., by a"
+                                                        " custom post-processing worker) are not included in the rendered images.");
 DEFINE_string(write_video,              "",             "Full file path to write rendered frames in motion JPEG video format. It might fail if the"
                                                         " final path does not finish in `.avi`. It internally uses cv::VideoWriter. Flag"
                                                         " `write_video_fps` controls FPS. Alternatively, the video extension can be `.mp4`,"
@@ -250,10 +612,29 @@ DEFINE_double(write_video_fps,          -1.,            "Frame rate for the reco
 DEFINE_bool(write_video_with_audio,     false,          "If the input is video and the output is so too, it will save the video with audio. It"
                                                         " requires the output video file path finishing in `.mp4` format (see `write_video` for"
                                                         " details).");
+DEFINE_string(write_video_encoder,      "libx264",      "FFmpeg encoder of the `.mp4` videos of `write_video` and `write_video_3d`. E.g., `h264_nvenc`"
+                                                        " or `hevc_nvenc` to encode them with the NVIDIA GPU hardware encoder (it requires an FFmpeg"
+                                                        " compiled with NVENC support).");
+DEFINE_string(stream_video,             "",             "URL to stream the rendered frames as a live low-latency video (e.g., for remote"
+                                                        " monitoring), e.g., `rtsp://localhost:8554/openpose` to publish it into an RTSP server"
+                                                        " (e.g., MediaMTX, which can also serve it over WebRTC), or `rtmp://`, `srt://`, `udp://`"
+                                                        " or `tcp://` URLs. It requires FFmpeg installed. Frames are dropped (never queued) if the"
+                                                        " encoder or the network are slower than OpenPose.");
+DEFINE_string(stream_video_encoder,     "h264_nvenc",   "FFmpeg encoder of `stream_video`, e.g., `h264_nvenc` or `hevc_nvenc` (NVIDIA GPU hardware"
+                                                        " encoder), `h264_vaapi` (VAAPI hardware encoder on `/dev/dri/renderD128`) or `libx264`"
+                                                        " (CPU).");
+DEFINE_int32(write_threads,             -1,             "Number of background threads encoding and writing the images, heat maps and videos of"
+                                                        " `write_images`, `write_heatmaps`, `write_video` and `write_video_3d` (keeping the frame"
+                                                        " order), so the pipeline does not wait for the disk. -1 for the default (up to 4), 0 to"
+                                                        " write them on the output thread (previous behavior).");
 DEFINE_string(write_video_3d,           "",             "Analogous to `--write_video`, but applied to the 3D output.");
 DEFINE_string(write_video_adam,         "",             "Experimental, not available yet. Analogous to `--write_video`, but applied to Adam model.");
 DEFINE_string(write_json,               "",             "Directory to write OpenPose output in JSON format. It includes body, hand, and face pose"
                                                         " keypoints (2-D and 3-D), as well as pose candidates (if `--part_candidates` enabled).");
+DEFINE_string(write_binary,             "",             "Full file path (e.g., `keypoints.opbin`) to write the body, hand, and face pose keypoints"
+                                                        " (2-D and 3-D) and person ids of all the frames into a single binary file, much smaller"
+                                                        " and faster to save and load than `write_json`. Read it with `KeypointBinaryReader` (C++"
+                                                        " or Python). See `doc/02_output.md` for its format.");
 DEFINE_string(write_coco_json,          "",             "Full file path to write people pose data with JSON COCO validation format. If foot, face,"
                                                         " hands, etc. JSON is also desired (`--write_coco_json_variants`), they are saved with"
                                                         " different file name suffix.");
@@ -261,11 +642,17 @@ DEFINE_int32(write_coco_json_variants,  1,              "Add 1 for body, add 2 f
                                                         " possible candidates. E.g., 7 would mean body+foot+face COCO JSON.");
 DEFINE_int32(write_coco_json_variant,   0,              "Currently, this option is experimental and only makes effect on car JSON generation. It"
                                                         " selects the COCO variant for cocoJsonSaver.");
+DEFINE_string(write_coco_json_eval,     "",             "COCO keypoint annotations JSON file (e.g., `person_keypoints_val2017.json`). If set, the"
+                                                        " body results of `--write_coco_json` are directly evaluated in C++ (OKS-based COCO AP"
+                                                        " and AR, as pycocotools), and displayed when OpenPose finishes.");
 DEFINE_string(write_heatmaps,           "",             "Directory to write body pose heatmaps in PNG format. At least 1 `add_heatmaps_X` flag"
                                                         " must be enabled.");
 DEFINE_string(write_heatmaps_format,    "png",          "File extension and format for `write_heatmaps`, analogous to `write_images_format`."
                                                         " For lossless compression, recommended `png` for integer `heatmaps_scale` and `float` for"
-                                                        " floating values. See `doc/02_output.md` for more details.");
+                                                        " floating values. `opheat` saves all the frames as floating values into a single"
+                                                        " compressed file (`opheat_fp16` and `opheat_uint8` for float16 and 8-bit per-channel"
+                                                        " quantization), much faster and smaller than `png`. See `doc/02_output.md` for more"
+                                                        " details.");
 DEFINE_string(write_keypoint,           "",             "(Deprecated, use `write_json`) Directory to write the people pose keypoint data. Set format"
                                                         " with `write_keypoint_format`.");
 DEFINE_string(write_keypoint_format,    "yml",          "(Deprecated, use `write_json`) File extension and format for `write_keypoint`: json, xml,"
@@ -275,6 +662,42 @@ DEFINE_string(write_bvh,                "",             "Experimental, not avail
 // UDP Communication
 DEFINE_string(udp_host,                 "",             "Experimental, not available yet. IP for UDP communication. E.g., `192.168.0.1`.");
 DEFINE_string(udp_port,                 "8051",         "Experimental, not available yet. Port number for UDP communication.");
+// Keypoint Streaming
+DEFINE_string(stream_keypoints_udp,     "",             "Send the 2-D and 3-D body keypoints of each frame as 1 binary UDP packet to this"
+                                                        " `host:port` (e.g., `127.0.0.1:8052`). See doc/02_output.md for its layout.");
+DEFINE_string(stream_keypoints_shm,     "",             "Same as `stream_keypoints_udp`, but writing the packets into a shared memory ring"
+                                                        " buffer with this name (e.g., `openpose_keypoints`), read with KeypointStreamReader"
+                                                        " by the processes of the same host.");
+DEFINE_double(stream_keypoints_precision, 0.,           "If positive, the 2-D keypoints of the `stream_keypoints_udp` packets are quantized to this"
+                                                        " step (in pixels, e.g., 0.25), delta-encoded against the previous packet for each tracked"
+                                                        " person (see `tracking` and `identification`) and entropy-coded, so the packets are"
+                                                        " several times smaller. Decode them with KeypointPacketDecoder. If 0, raw floats are sent.");
+DEFINE_double(stream_keypoints_precision_3d, 0.,        "Same as `stream_keypoints_precision`, but for the 3-D keypoints (in the units of the"
+                                                        " camera calibration, e.g., 1 for 1 mm).");
+DEFINE_int32(stream_keypoints_keyframe, 30,             "Interval (in packets) between the keyframes of the compressed `stream_keypoints_udp`"
+                                                        " packets (with no deltas, so a receiver that lost a packet recovers with the next one).");
+DEFINE_string(datum_send,               "",             "Send each frame set, once processed by this process, to the `--datum_receive` of another"
+                                                        " OpenPose process at this `host:port` (e.g., `192.168.1.10:9000`), through TCP. It waits"
+                                                        " (up to 60 seconds) for the receiver to listen.");
+DEFINE_string(datum_send_fields,        "frame,keypoints", "Comma-separated Datum fields sent by `--datum_send`: `frame` (input frame and camera"
+                                                        " parameters), `net_input` (network input and its scales), `keypoints` (2-D keypoints, IDs"
+                                                        " and face/hand rectangles), `keypoints_3d`, and `output_frame` (rendered frame), or `all`.");
+DEFINE_int32(datum_send_jpeg_quality,   90,             "JPEG quality (1-100) of the frames sent by `--datum_send`. Select 0 to send them raw"
+                                                        " (lossless, but about 10 times larger).");
+// Metrics and Tracing
+DEFINE_int32(metrics_port,              -1,             "Port of the embedded HTTP server exposing the OpenPose metrics (per-worker processing"
+                                                        " time, queue waiting time and queue size histograms) in the OpenMetrics (Prometheus)"
+                                                        " format on `http://<ip>:<metrics_port>/metrics`. Select -1 (default) to disable it.");
+DEFINE_bool(allocation_metrics,         false,          "If true (and `metrics_port` is set), the metrics also include the memory allocated (count"
+                                                        " and bytes, on CPU and GPU) and copied (host-device bytes) by each worker per frame."
+                                                        " Each hook is a single atomic check while disabled.");
+DEFINE_string(trace_file,               "",             "Output file path (e.g., `trace.json`) of the pipeline timeline in the Chrome Trace JSON"
+                                                        " format (each worker call per frame and each queue wait), saved when OpenPose stops."
+                                                        " Open it with chrome://tracing or https://ui.perfetto.dev. Leave empty to disable it.");
+DEFINE_bool(datum_timing,               false,          "If true, each frame records the begin and end time (monotonic clock) of each stage that"
+                                                        " processed it: producer read, each queue wait and worker call, and the GPU time of the"
+                                                        " pose network and post-processing. It is saved into the `write_json` files (`timing`)"
+                                                        " and exposed as `Datum::timing` (C++) and `datum.timing` (Python).");
 #endif // OPENPOSE_FLAGS_DISABLE_POSE
 
 #endif // OPENPOSE_FLAGS_HPP
@@ -4,6 +4,10 @@
 #include <utility> // std::pair
 #include <openpose/core/common.hpp>
 
+// Forward declaration of cudaStream_t and the CUDA half precision type, so CUDA headers are not required
+struct CUstream_st;
+struct __half;
+
 namespace op
 {
     const auto CUDA_NUM_THREADS = 512u;
@@ -12,6 +16,13 @@ namespace op
 
     OP_API int getCudaGpuNumber();
 
+    /**
+     * It returns whether gpuId is an integrated GPU (e.g., NVIDIA Jetson / Tegra), i.e., whether it shares the
+     * physical memory with the CPU, so mapped pinned host memory can be read by the GPU without any copy.
+     * It returns false if OpenPose was not compiled with CUDA.
+     */
+    OP_API bool isIntegratedGpu(const int gpuId);
+
     inline unsigned int getNumberCudaBlocks(
         const unsigned int totalRequired, const unsigned int numberCudaThreads = CUDA_NUM_THREADS)
     {
@@ -21,12 +32,91 @@ namespace op
     OP_API void getNumberCudaThreadsAndBlocks(
         dim3& numberCudaThreads, dim3& numberCudaBlocks, const Point<unsigned int>& frameSize);
 
+    /**
+     * NV12 (see FrameGpu) into interleaved BGR (targetPtr must hold 3 x width x height bytes). The call is
+     * asynchronous in cudaStream.
+     */
+    OP_API void nv12ToBgr(
+        unsigned char* targetPtr, const unsigned char* const nv12Ptr, const int width, const int height,
+        const int pitch, const bool bt709, const bool fullRange, CUstream_st* const cudaStream = nullptr);
+
+    /**
+     * It returns the position (redX, redY; 0 or 1) of the red pixel in the 2x2 tiles of a Bayer FrameGpuFormat.
+     */
+    OP_API void getBayerRedPixel(int& redX, int& redY, const FrameGpuFormat bayerFormat);
+
+    /**
+     * It returns the index remap (see orientCoordinatesCuda()) that maps each pixel of a frame rotated and flipped as
+     * rotateAndFlipFrame() (see FrameGpu::rotation and FrameGpu::flip) into its raw pixel, 0 if none.
+     */
+    OP_API int getOrientationMask(const int rotation, const bool flip);
+
+    /**
+     * Raw 8-bit Bayer image (see FrameGpu) into interleaved BGR (targetPtr must hold 3 x width x height bytes), with
+     * bilinear demosaicing. The call is asynchronous in cudaStream.
+     */
+    OP_API void bayerToBgr(
+        unsigned char* targetPtr, const unsigned char* const bayerPtr, const int width, const int height,
+        const int pitch, const FrameGpuFormat bayerFormat, CUstream_st* const cudaStream = nullptr);
+
+    /**
+     * Interleaved float BGR image (e.g., RenderTargetGpu) into the 8-bit RGBA CUDA surface object surfaceObject
+     * (cudaSurfaceObject_t, e.g., a graphics texture mapped into CUDA, see GraphicsTextureCuda) of
+     * targetWidth x targetHeight pixels. It is bilinearly resized if both sizes differ, and flipped upside down if
+     * flipVertically (e.g., bottom-up textures). The call is asynchronous in cudaStream.
+     */
+    OP_API void bgrFloatToRgbaSurface(
+        const unsigned long long surfaceObject, const int targetWidth, const int targetHeight,
+        const float* const bgrPtr, const int sourceWidth, const int sourceHeight, const bool flipVertically,
+        CUstream_st* const cudaStream = nullptr);
+
     template <typename T>
     void reorderAndNormalize(
         T* targetPtr, const unsigned char* const srcPtr, const int width, const int height, const int channels);
 
     template <typename T>
     void uCharImageCast(unsigned char* targetPtr, const T* const srcPtr, const int volume);
+
+    // Half precision (FP16) to T (e.g., FP16 heat maps into float). The call is asynchronous in cudaStream.
+    template <typename T>
+    void halfCast(T* targetPtr, const __half* const srcPtr, const int volume, CUstream_st* const cudaStream = nullptr);
+
+    /**
+     * Contiguous range of channels of gatherScaledChannels().
+     */
+    struct GpuChannelRange
+    {
+        unsigned long long sourceOffset;
+        unsigned long long volume;
+        // Each value becomes scale x clamp(value, minValue, maxValue) + shift (if round, also rounded and saturated
+        // into [0, 255], i.e., ScaleMode::UnsignedChar, whatever the target type)
+        float minValue;
+        float maxValue;
+        float scale;
+        float shift;
+        bool round;
+    };
+
+    /**
+     * It gathers the channelRanges of sourcePtr into the contiguous targetPtr (one after the other, both in device
+     * memory), scaling each value as its GpuChannelRange. The unsigned char ones are always rounded and saturated
+     * into [0, 255]. The call is asynchronous in cudaStream.
+     */
+    template <typename T>
+    void gatherScaledChannels(
+        T* targetPtr, const float* const sourcePtr, const std::vector<GpuChannelRange>& channelRanges,
+        CUstream_st* const cudaStream = nullptr);
+
+    /**
+     * Stream compaction of the channel-major sourcePtr (numberChannels x channelArea, in device memory) on the GPU:
+     * Only the values whose absolute value is higher than threshold are downloaded, and appended into values (and
+     * their position in their channel into indices, sorted). The first element of each channel (in values) is
+     * appended into offsets (see SparseHeatMaps). It returns once they are downloaded.
+     */
+    void sparsifyChannels(
+        std::vector<int>& offsets, std::vector<int>& indices, std::vector<float>& values,
+        const float* const sourcePtr, const int numberChannels, const int channelArea, const float threshold,
+        CUstream_st* const cudaStream = nullptr);
 }
 
 #endif // OPENPOSE_GPU_CUDA_HPP
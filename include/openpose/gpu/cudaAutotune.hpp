@@ -0,0 +1,64 @@
+#ifndef OPENPOSE_GPU_CUDA_AUTOTUNE_HPP
+#define OPENPOSE_GPU_CUDA_AUTOTUNE_HPP
+
+#include <functional>
+#include <openpose/core/common.hpp>
+
+// Forward declaration of cudaStream_t, so CUDA headers are not required
+struct CUstream_st;
+
+namespace op
+{
+    // Autotuning of the CUDA launch configurations (`--cuda_autotune`).
+    // The first time a kernel runs with a given shape (e.g., a heat map or frame size) on a GPU model, each candidate
+    // block shape is benchmarked and the fastest one is used from then on. The results are saved into a cache file
+    // (keyed by GPU model, kernel and shape), so later runs do not benchmark them again. The benchmark runs on the
+    // stream of the kernel while the other GPU threads keep working, so it is a best-effort measure: remove the cache
+    // file to tune them again (e.g., after a driver update).
+
+    /**
+     * It enables (or disables if empty) the autotuning, with cacheFile as its cache file. Thread-safe, but it should be
+     * called before any kernel runs (e.g., when the Wrapper is configured).
+     */
+    OP_API void setCudaAutotuneCacheFile(const std::string& cacheFile);
+
+    /**
+     * Whether setCudaAutotuneCacheFile() enabled the autotuning.
+     */
+    OP_API bool isCudaAutotuneEnabled();
+
+    /**
+     * It returns in block the tuned block shape of kernelName and shapeKey on the current GPU, benchmarking
+     * candidateBlocks (and the input block) if they have not been tuned yet. The input block (the default) is left
+     * as it is if the autotuning is disabled, if cudaStream is being captured into a CUDA Graph (and the kernel has
+     * not been tuned yet), or if none of the candidates can be launched.
+     * Thread-safe.
+     * @param candidateBlocks The ones exceeding the device limits are skipped.
+     * @param benchmarkLaunch It must queue the kernel into cudaStream with the given block shape (and its matching
+     * grid). It must not modify any data that the caller reads later (e.g., blending into the output frame), since
+     * it runs several times per candidate: either the kernel overwrites its output, or it is launched on scratch
+     * memory.
+     */
+    OP_API void getCudaAutotunedBlock(
+        dim3& block, const std::string& kernelName, const std::string& shapeKey,
+        const std::vector<dim3>& candidateBlocks, const std::function<void(const dim3&)>& benchmarkLaunch,
+        CUstream_st* const cudaStream = nullptr);
+
+    /**
+     * Autotuned getNumberCudaThreadsAndBlocks() for the rendering kernels, which are launched as
+     * <<<numberCudaThreads, numberCudaBlocks>>> (i.e., numberCudaBlocks is their block shape). The candidates have at
+     * least 256 threads, since the rendering kernels fill their shared bounding boxes (up to 2 x POSE_MAX_PEOPLE) with
+     * the threads of each block.
+     * Since the rendering kernels blend into the frame, they are benchmarked on a scratch copy of it, which is only
+     * allocated (and copied from framePtr) if the kernel has not been tuned yet.
+     * @param framePtr GPU frame that the kernel renders into, of frameBytes bytes.
+     * @param benchmarkLaunch It receives the grid and block shapes and the scratch frame to render into (launched on
+     * the default stream), see getCudaAutotunedBlock().
+     */
+    OP_API void getAutotunedCudaThreadsAndBlocks(
+        dim3& numberCudaThreads, dim3& numberCudaBlocks, const Point<unsigned int>& frameSize,
+        const std::string& kernelName, const float* const framePtr, const unsigned long long frameBytes,
+        const std::function<void(const dim3&, const dim3&, float*)>& benchmarkLaunch);
+}
+
+#endif // OPENPOSE_GPU_CUDA_AUTOTUNE_HPP
@@ -0,0 +1,79 @@
+#ifndef OPENPOSE_GPU_CUDA_GRAPH_HPP
+#define OPENPOSE_GPU_CUDA_GRAPH_HPP
+
+#include <cstring> // std::memcpy
+#include <functional>
+#include <openpose/core/common.hpp>
+
+// Forward declaration of cudaStream_t, so CUDA headers are not required
+struct CUstream_st;
+
+namespace op
+{
+    /**
+     * Small cache of CUDA Graphs, one per key (e.g., per shape), for fixed sequences of kernels that are launched on
+     * every frame. Replaying a graph costs a single launch, rather than 1 launch (and its host-side argument setup)
+     * per kernel.
+     * The first time a key is seen, its kernels are run directly (so any lazy allocation or synchronous copy happens
+     * outside of the capture). The second time, they are captured from the stream into a CUDA Graph, which is
+     * launched from then on instead. If the capture fails, that key keeps running its kernels directly.
+     * It requires CUDA 11 or higher, otherwise (or without CUDA) the kernels are always run directly.
+     * Not thread-safe, each thread (e.g., each GPU worker) must use its own cache.
+     */
+    class OP_API CudaGraphCache
+    {
+    public:
+        /**
+         * @param maxGraphs Maximum number of cached graphs. The least recently used one is destroyed when a new key
+         * exceeds it.
+         */
+        explicit CudaGraphCache(const unsigned int maxGraphs = 4u);
+
+        virtual ~CudaGraphCache();
+
+        /**
+         * It queues (or replays) kernelLaunches into cudaStream.
+         * @param key It must identify every argument of the kernels (sizes, pointers, and scalar parameters), since
+         * the graph replays them exactly as they were captured. See cudaGraphKeyAppend().
+         * @param kernelLaunches It must only queue asynchronous work into cudaStream (no synchronization, allocation,
+         * nor copy from pageable host memory, and no work into other streams).
+         */
+        void run(
+            const std::vector<unsigned long long>& key, CUstream_st* const cudaStream,
+            const std::function<void()>& kernelLaunches);
+
+        /**
+         * It destroys all the cached graphs (e.g., if any buffer used by them is reallocated).
+         */
+        void clear();
+
+        /**
+         * Number of graphs currently cached.
+         */
+        unsigned int size() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplCudaGraphCache;
+        std::unique_ptr<ImplCudaGraphCache> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(CudaGraphCache);
+    };
+
+    /**
+     * It appends the bytes of value (a pointer or an arithmetic value of at most 8 bytes) into a CudaGraphCache key.
+     */
+    template <typename T>
+    inline void cudaGraphKeyAppend(std::vector<unsigned long long>& key, const T value)
+    {
+        static_assert(sizeof(T) <= sizeof(unsigned long long), "Key values must have at most 8 bytes.");
+        unsigned long long word = 0ull;
+        std::memcpy(&word, &value, sizeof(T));
+        key.emplace_back(word);
+    }
+}
+
+#endif // OPENPOSE_GPU_CUDA_GRAPH_HPP
@@ -0,0 +1,105 @@
+#ifndef OPENPOSE_GPU_CUDA_MEMORY_POOL_HPP
+#define OPENPOSE_GPU_CUDA_MEMORY_POOL_HPP
+
+#include <map>
+#include <openpose/core/common.hpp>
+
+// Forward declaration of cudaStream_t, so CUDA headers are not required
+struct CUstream_st;
+
+namespace op
+{
+    // Per-GPU caching allocator for CUDA device memory.
+    // cudaMalloc and cudaFree are slow and cudaFree implicitly synchronizes the device. With this pool, freed blocks
+    // are kept in size buckets (up to 25% bigger than requested) and re-used by later requests on the same GPU,
+    // so buffers that are (re)allocated on each frame or on each Reshape do not reach the CUDA driver.
+    // Stream-aware re-use: A block freed on a stream can be re-used right away on that same stream (CUDA keeps the
+    // order of the operations within a stream), while other streams only re-use it once the work queued before its
+    // cudaPoolFree() has finished.
+
+    struct OP_API CudaMemoryPoolStats
+    {
+        unsigned long long requestedBytes;  // Bytes requested by the blocks in use
+        unsigned long long usedBytes;       // Bytes of the blocks in use (bucket size)
+        unsigned long long cachedBytes;     // Bytes of the free blocks kept for re-use
+        unsigned long long peakUsedBytes;   // Maximum usedBytes so far
+        unsigned long long fragmentedBytes; // Reserved but not requested, i.e., usedBytes-requestedBytes+cachedBytes
+        unsigned long long cudaMallocs;     // Number of requests that required an actual cudaMalloc
+        unsigned long long cacheHits;       // Number of requests served from the cached blocks
+    };
+
+    struct OP_API CudaMemoryOwnerStats
+    {
+        unsigned long long usedBytes;       // Bytes in use (pool blocks and memory added with addCudaMemoryOwnerBytes)
+        unsigned long long peakUsedBytes;   // Maximum usedBytes since the last resetCudaMemoryPeaks()
+    };
+
+    /**
+     * While it exists, the device memory allocated by the calling thread with cudaPoolMalloc() (and by ArrayCpuGpu)
+     * is attributed to owner (e.g., `NmsCaffe`) in getCudaMemoryOwnerStats(). Scopes can be nested (the innermost one
+     * is used). Memory allocated outside any scope is attributed to `Other`.
+     */
+    class OP_API CudaMemoryOwner
+    {
+    public:
+        /**
+         * @param owner It must outlive this object (e.g., a string literal), it is not copied.
+         */
+        explicit CudaMemoryOwner(const char* const owner);
+
+        virtual ~CudaMemoryOwner();
+
+        /**
+         * @return Owner of the innermost CudaMemoryOwner of the calling thread, or nullptr if none.
+         */
+        static const char* getCurrentOwner();
+
+    private:
+        const char* const pPreviousOwner;
+
+        DELETE_COPY(CudaMemoryOwner);
+    };
+
+    /**
+     * It allocates `bytes` bytes in the current CUDA device, re-using a cached block if possible. The returned
+     * memory must be released with cudaPoolFree().
+     * @param cudaStream Stream where the memory will be used (nullptr = default stream).
+     */
+    OP_API void* cudaPoolMalloc(const unsigned long long bytes, CUstream_st* const cudaStream = nullptr);
+
+    /**
+     * It returns gpuPtr (obtained with cudaPoolMalloc) to the pool. It does not wait for the GPU and it does not
+     * free the memory. nullptr is ignored.
+     * @param cudaStream Last stream where the memory was used (nullptr = default stream).
+     */
+    OP_API void cudaPoolFree(void* const gpuPtr, CUstream_st* const cudaStream = nullptr);
+
+    /**
+     * It frees (cudaFree) all the cached blocks of all the GPUs. Blocks in use are not affected.
+     */
+    OP_API void cudaPoolReleaseCache();
+
+    /**
+     * Memory statistics of the given GPU (or the current one if gpuId < 0).
+     */
+    OP_API CudaMemoryPoolStats getCudaMemoryPoolStats(const int gpuId = -1);
+
+    /**
+     * It attributes bytes (negative to release them) of device memory allocated outside the pool (e.g., by Caffe) to
+     * owner (nullptr = `Other`) on the given GPU.
+     */
+    OP_API void addCudaMemoryOwnerBytes(const char* const owner, const int gpuId, const long long bytes);
+
+    /**
+     * Memory of each owner (see CudaMemoryOwner) on the given GPU (or the current one if gpuId < 0).
+     */
+    OP_API std::map<std::string, CudaMemoryOwnerStats> getCudaMemoryOwnerStats(const int gpuId = -1);
+
+    /**
+     * It resets the peaks (CudaMemoryPoolStats::peakUsedBytes and CudaMemoryOwnerStats::peakUsedBytes) of all the
+     * GPUs to their current usage, e.g., to measure each benchmark configuration independently.
+     */
+    OP_API void resetCudaMemoryPeaks();
+}
+
+#endif // OPENPOSE_GPU_CUDA_MEMORY_POOL_HPP
@@ -9,6 +9,25 @@ namespace op
     OP_API int getGpuNumber();
 
     OP_API GpuMode getGpuMode();
+
+    /**
+     * It returns the NUMA node the GPU gpuId is attached to (i.e., the one of its PCIe root), or -1 if unknown (e.g.,
+     * single-socket machines, non-CUDA builds or non-Linux systems).
+     */
+    OP_API int getGpuNumaNode(const int gpuId);
+
+    /**
+     * It returns the model name of the GPU gpuId (e.g., `NVIDIA GeForce RTX 3090`), or an empty std::string if
+     * unknown (e.g., non-CUDA builds).
+     */
+    OP_API std::string getGpuName(const int gpuId);
+
+    /**
+     * It fills the free and total device memory of the GPU gpuId (in bytes, as reported by the driver, i.e., including
+     * the memory of other processes and of the CUDA contexts).
+     * @return Whether it could be read (false e.g., for non-CUDA builds).
+     */
+    OP_API bool getGpuMemory(unsigned long long& freeBytes, unsigned long long& totalBytes, const int gpuId);
 }
 
 #endif // OPENPOSE_GPU_GPU_HPP
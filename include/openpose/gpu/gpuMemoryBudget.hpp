@@ -0,0 +1,87 @@
+#ifndef OPENPOSE_GPU_GPU_MEMORY_BUDGET_HPP
+#define OPENPOSE_GPU_GPU_MEMORY_BUDGET_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    // Per-GPU memory budgeting (`--gpu_memory_budget`).
+    // Each GPU component (e.g., PoseExtractorCaffe, FaceExtractorCaffe, HandExtractorCaffe or PoseGpuRenderer)
+    // projects its GPU memory footprint for the configured resolution and batch before allocating anything, so the
+    // wrapper can choose the maximum batch size and queue sizes that fit into the budget (or report what does not
+    // fit) at configuration time rather than running out of memory at runtime. The projections are conservative
+    // approximations (e.g., the network blobs are estimated from the network input area), not exact allocations.
+
+    /**
+     * Projected GPU memory of a component.
+     */
+    struct OP_API GpuMemoryFootprint
+    {
+        /**
+         * Name of the component (used in the budget report).
+         */
+        std::string component;
+
+        /**
+         * Bytes independent of the batch size (e.g., network weights, workspaces or rendering buffers).
+         */
+        unsigned long long fixedBytes;
+
+        /**
+         * Additional bytes for each frame of the network batch (e.g., network blobs and heat maps).
+         */
+        unsigned long long perFrameBytes;
+    };
+
+    /**
+     * Result of fitGpuMemoryBudget().
+     */
+    struct OP_API GpuMemoryPlan
+    {
+        /**
+         * Maximum batch size (not higher than the requested one) that fits, or 0 if not even 1 frame fits.
+         */
+        int batchSize;
+
+        /**
+         * Projected bytes with batchSize (or with a batch size of 1 if batchSize = 0).
+         */
+        unsigned long long projectedBytes;
+
+        /**
+         * Bytes of the budget left with batchSize (0 if it does not fit).
+         */
+        unsigned long long remainingBytes;
+
+        /**
+         * Human-readable report with the footprint of each component.
+         */
+        std::string report;
+    };
+
+    /**
+     * Projected GPU memory of the CUDA context (created once per process and GPU).
+     */
+    OP_API GpuMemoryFootprint getCudaContextFootprint();
+
+    /**
+     * It returns the free memory (in bytes) of the GPU gpuId, or 0 if it is unknown (e.g., non-CUDA builds).
+     */
+    OP_API unsigned long long getGpuFreeMemory(const int gpuId);
+
+    /**
+     * Size (in bytes) of the given model file (e.g., a caffemodel, whose weights are loaded as they are into GPU
+     * memory), or defaultBytes if it cannot be read.
+     */
+    OP_API unsigned long long getModelFileBytes(const std::string& modelPath, const unsigned long long defaultBytes);
+
+    /**
+     * It chooses the maximum batch size (up to batchSize) whose projected memory fits into budgetBytes, i.e.,
+     * sum(fixedBytes) + batchSize x sum(perFrameBytes) <= budgetBytes.
+     */
+    OP_API GpuMemoryPlan fitGpuMemoryBudget(
+        const unsigned long long budgetBytes, const std::vector<GpuMemoryFootprint>& footprints,
+        const int batchSize);
+}
+
+#endif // OPENPOSE_GPU_GPU_MEMORY_BUDGET_HPP
@@ -3,7 +3,11 @@
 
 // gpu module
 #include <openpose/gpu/cuda.hpp>
+#include <openpose/gpu/cudaAutotune.hpp>
+#include <openpose/gpu/cudaGraph.hpp>
+#include <openpose/gpu/cudaMemoryPool.hpp>
 #include <openpose/gpu/enumClasses.hpp>
 #include <openpose/gpu/gpu.hpp>
+#include <openpose/gpu/gpuMemoryBudget.hpp>
 
 #endif // OPENPOSE_GPU_HEADERS_HPP
@@ -19,9 +19,13 @@ namespace op
          * @param initialWindowedSize const Point<int> with the initial window output resolution (width and height).
          * @param fullScreen bool from which the FrameDisplayer::FullScreenMode property mFullScreenMode will be set,
          * i.e., specifying the type of initial display (it can be changed later).
+         * @param vSync bool specifying whether to synchronize the display with the monitor refresh rate. Only
+         * applied if OpenPose was compiled with WITH_OPENCV_WITH_OPENGL (otherwise the default of the OpenCV window
+         * is kept).
          */
         FrameDisplayer(const std::string& windowedName = OPEN_POSE_NAME_AND_VERSION,
-                       const Point<int>& initialWindowedSize = Point<int>{}, const bool fullScreen = false);
+                       const Point<int>& initialWindowedSize = Point<int>{}, const bool fullScreen = false,
+                       const bool vSync = false);
 
         virtual ~FrameDisplayer();
 
@@ -41,7 +45,9 @@ namespace op
         void switchFullScreenMode();
 
         /**
-         * This function displays an image on the display.
+         * This function displays an image on the display. If OpenPose was compiled with WITH_OPENCV_WITH_OPENGL, the
+         * image is uploaded once (through a pixel buffer) into 1 of 2 persistent OpenGL textures, which are
+         * displayed alternately (so the upload of a frame does not wait for the display of the previous one).
          * @param frame Mat image to display.
          * @param waitKeyValue int value that specifies the argument parameter for cv::waitKey (see OpenCV
          * documentation for more information). Special cases: select -1
@@ -55,10 +61,26 @@ namespace op
          */
         void displayFrame(const std::vector<Matrix>& frames, const int waitKeyValue = -1);
 
+        /**
+         * It sets the BGRA overlay composited (alpha blended) over the top-left corner of the following displayed
+         * frames (e.g., GuiInfoAdder::updateOverlay()), so the frames themselves are not modified. If OpenPose was
+         * compiled with WITH_OPENCV_WITH_OPENGL, it is uploaded once into its own OpenGL texture and blended on the
+         * GPU when displaying each frame. Otherwise, it is blended into a copy of each displayed frame.
+         * It keeps sharing the memory of overlay, so it must be called again whenever overlay is modified.
+         * @param overlay CV_8UC4 Mat, or empty to disable the overlay.
+         */
+        void setOverlay(const Matrix& overlay);
+
     private:
         const std::string mWindowName;
         Point<int> mWindowedSize;
         FullScreenMode mFullScreenMode;
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplFrameDisplayer;
+        std::unique_ptr<ImplFrameDisplayer> upImpl;
+
+        DELETE_COPY(FrameDisplayer);
     };
 }
 
@@ -2,6 +2,7 @@
 #define OPENPOSE_GUI_GUI_HPP
 
 #include <atomic>
+#include <chrono>
 #include <openpose/core/common.hpp>
 #include <openpose/core/renderer.hpp>
 #include <openpose/gui/frameDisplayer.hpp>
@@ -21,7 +22,8 @@ namespace op
             const std::vector<std::shared_ptr<FaceExtractorNet>>& faceExtractorNets = {},
             const std::vector<std::shared_ptr<HandExtractorNet>>& handExtractorNets = {},
             const std::vector<std::shared_ptr<Renderer>>& renderers = {},
-            const DisplayMode displayMode = DisplayMode::Display2D);
+            const DisplayMode displayMode = DisplayMode::Display2D, const bool vSync = false,
+            const bool skipStaleFrames = false);
 
         virtual ~Gui();
 
@@ -31,8 +33,21 @@ namespace op
 
         void setImage(const std::vector<Matrix>& cvMatOutputs);
 
+        /**
+         * BGRA overlay composited over the following displayed images (see FrameDisplayer::setOverlay()).
+         */
+        void setOverlay(const Matrix& overlay);
+
         virtual void update();
 
+        /**
+         * Whether the current frame should be neither displayed nor followed by update(), because newer frames are
+         * already waiting (so the display never slows down the processing). Only if skipStaleFrames was enabled, and
+         * never for more than 100 msec in a row (so the display and the user input are not frozen).
+         * @param queueInBacklog Number of frames waiting after the current one (see Worker::getQueueInBacklog()).
+         */
+        bool isStaleFrame(const unsigned long long queueInBacklog);
+
     protected:
         std::shared_ptr<std::atomic<bool>> spIsRunning;
         DisplayMode mDisplayMode;
@@ -47,6 +62,8 @@ namespace op
         std::vector<std::shared_ptr<HandExtractorNet>> mHandExtractorNets;
         std::vector<std::shared_ptr<Renderer>> mRenderers;
         std::shared_ptr<std::pair<std::atomic<bool>, std::atomic<int>>> spVideoSeek;
+        const bool mSkipStaleFrames;
+        std::chrono::high_resolution_clock::time_point mLastFrameDisplayed;
     };
 }
 
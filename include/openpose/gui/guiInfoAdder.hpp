@@ -18,6 +18,21 @@ namespace op
                      const Array<long long>& poseIds = Array<long long>{},
                      const Array<float>& poseKeypoints = Array<float>{});
 
+        /**
+         * Analog of addInfo(), but rather than drawing the information on the frame, it keeps it in its own BGRA
+         * overlay (transparent outside the texts) of size frameSize, to be composited over the frame when
+         * displaying it (see FrameDisplayer::setOverlay()). Only the texts that changed since the previous call are
+         * drawn again.
+         * @param overlay It will share the memory of the internal overlay, which is modified in place by the next
+         * call.
+         * @return Whether the overlay changed since the previous call.
+         */
+        bool updateOverlay(Matrix& overlay, const Point<int>& frameSize, const int numberPeople,
+                           const unsigned long long id, const std::string& elementRenderedName,
+                           const unsigned long long frameNumber,
+                           const Array<long long>& poseIds = Array<long long>{},
+                           const Array<float>& poseKeypoints = Array<float>{});
+
     private:
         // Const variables
         const int mNumberGpus;
@@ -29,6 +44,15 @@ namespace op
         std::string mLastElementRenderedName;
         int mLastElementRenderedCounter;
         unsigned long long mLastId;
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplGuiInfoAdder;
+        std::shared_ptr<ImplGuiInfoAdder> spImpl;
+
+        // Texts to draw for this frame
+        void updateTexts(const Point<int>& frameSize, const int numberPeople, const unsigned long long id,
+                         const std::string& elementRenderedName, const unsigned long long frameNumber,
+                         const Array<long long>& poseIds, const Array<float>& poseKeypoints);
     };
 }
 
@@ -3,6 +3,7 @@
 
 #include <openpose/core/common.hpp>
 #include <openpose/gui/gui.hpp>
+#include <openpose/gui/guiInfoAdder.hpp>
 #include <openpose/thread/workerConsumer.hpp>
 
 namespace op
@@ -11,7 +12,11 @@ namespace op
     class WGui : public WorkerConsumer<TDatums>
     {
     public:
-        explicit WGui(const std::shared_ptr<Gui>& gui);
+        /**
+         * @param guiInfoAdder If not nullptr, the GUI information of each frame is displayed as an overlay on top of
+         * it (see GuiInfoAdder::updateOverlay()), so it is not added into the frame itself.
+         */
+        explicit WGui(const std::shared_ptr<Gui>& gui, const std::shared_ptr<GuiInfoAdder>& guiInfoAdder = nullptr);
 
         virtual ~WGui();
 
@@ -21,6 +26,7 @@ namespace op
 
     private:
         std::shared_ptr<Gui> spGui;
+        std::shared_ptr<GuiInfoAdder> spGuiInfoAdder;
 
         DELETE_COPY(WGui);
     };
@@ -35,8 +41,9 @@ namespace op
 namespace op
 {
     template<typename TDatums>
-    WGui<TDatums>::WGui(const std::shared_ptr<Gui>& gui) :
-        spGui{gui}
+    WGui<TDatums>::WGui(const std::shared_ptr<Gui>& gui, const std::shared_ptr<GuiInfoAdder>& guiInfoAdder) :
+        spGui{gui},
+        spGuiInfoAdder{guiInfoAdder}
     {
     }
 
@@ -66,10 +73,26 @@ namespace op
             // tDatums might be empty but we still wanna update the GUI
             if (tDatums != nullptr)
             {
+                // GUI information overlay (also for the skipped frames, so the fps counts all of them)
+                if (spGuiInfoAdder != nullptr && !tDatums->empty() && !tDatums->at(0)->cvOutputData.empty())
+                {
+                    const auto& tDatumPtr = tDatums->at(0);
+                    Matrix overlay;
+                    if (spGuiInfoAdder->updateOverlay(
+                        overlay, {tDatumPtr->cvOutputData.cols(), tDatumPtr->cvOutputData.rows()},
+                        std::max(tDatumPtr->poseKeypoints.getSize(0), tDatumPtr->faceKeypoints.getSize(0)),
+                        tDatumPtr->id, tDatumPtr->elementRendered.second, tDatumPtr->frameNumber,
+                        tDatumPtr->poseIds, tDatumPtr->poseKeypoints))
+                        spGui->setOverlay(overlay);
+                }
+                // Newer frames already waiting
+                if (!tDatums->empty() && spGui->isStaleFrame(this->getQueueInBacklog()))
+                    return;
                 // Debugging log
                 opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
-                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
                 // Update cvMat
                 if (!tDatums->empty())
                 {
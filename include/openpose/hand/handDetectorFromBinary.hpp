@@ -0,0 +1,47 @@
+#ifndef OPENPOSE_HAND_HAND_DETECTOR_FROM_BINARY_HPP
+#define OPENPOSE_HAND_HAND_DETECTOR_FROM_BINARY_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/pose/enumClasses.hpp>
+
+namespace op
+{
+    /**
+     * HandDetectorFromBinary is the binary alternative to HandDetectorFromTxt: It returns the hand rectangles of each
+     * frame of a KeypointBinarySaver file (`--write_keypoint_binary`), in file order. The file is memory-mapped (see
+     * KeypointBinaryReader) and the rectangles of the next frames are computed ahead on a background thread, so
+     * detectHands() does not parse any file.
+     * The rectangles of each person are the ones of HandDetector from its body keypoints or, if the file does not
+     * contain the body keypoints, the square around its hand keypoints.
+     * It is thread-safe (several GPU threads can share it, each call returns the next frame).
+     */
+    class OP_API HandDetectorFromBinary
+    {
+    public:
+        /**
+         * @param filePath KeypointBinarySaver file.
+         * @param poseModel Body model of the keypoints of the file.
+         * @param prefetchFrames Maximum number of frames computed ahead (0 computes each frame in detectHands()).
+         */
+        explicit HandDetectorFromBinary(
+            const std::string& filePath, const PoseModel poseModel, const int prefetchFrames = 16);
+
+        virtual ~HandDetectorFromBinary();
+
+        unsigned long long getNumberFrames() const;
+
+        std::vector<std::array<Rectangle<float>, 2>> detectHands();
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplHandDetectorFromBinary;
+        std::unique_ptr<ImplHandDetectorFromBinary> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(HandDetectorFromBinary);
+    };
+}
+
+#endif // OPENPOSE_HAND_HAND_DETECTOR_FROM_BINARY_HPP
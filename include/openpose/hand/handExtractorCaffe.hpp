@@ -3,7 +3,9 @@
 
 #include <openpose/core/common.hpp>
 #include <openpose/core/enumClasses.hpp>
+#include <openpose/gpu/gpuMemoryBudget.hpp>
 #include <openpose/hand/handExtractorNet.hpp>
+#include <openpose/net/netMemoryArena.hpp>
 
 namespace op
 {
@@ -22,13 +24,19 @@ namespace op
          * @param numberScales Number of scales to run. The more scales, the slower it will be but possibly also more
          * accurate.
          * @param rangeScales The range between the smaller and bigger scale.
+         * @param adaptiveCropSize If true, each hand is cropped at the smallest of 128, 256, and netInputSize that
+         * is not smaller than its rectangle (see getRoiCropSide()), rather than always at netInputSize. Ignored if
+         * heatMapTypes is not empty (the heat maps of all the hands must have the same size).
+         * @param netMemoryArena If not nullptr, the intermediate blobs of the network are placed into it (see
+         * NetCaffe).
          */
         HandExtractorCaffe(const Point<int>& netInputSize, const Point<int>& netOutputSize,
                            const std::string& modelFolder, const int gpuId,
                            const int numberScales = 1, const float rangeScales = 0.4f,
                            const std::vector<HeatMapType>& heatMapTypes = {},
                            const ScaleMode heatMapScaleMode = ScaleMode::ZeroToOneFixedAspect,
-                           const bool enableGoogleLogging = true);
+                           const bool enableGoogleLogging = true, const bool adaptiveCropSize = false,
+                           const std::shared_ptr<NetMemoryArena>& netMemoryArena = nullptr);
 
         /**
          * Virtual destructor of the HandExtractor class.
@@ -42,6 +50,11 @@ namespace op
          */
         void netInitializationOnThread();
 
+        /**
+         * It releases the network and its GPU memory (see HandExtractorNet::setLazyLoading()).
+         */
+        void netReleaseOnThread();
+
         /**
          * This function extracts the hand keypoints for each detected hand in the image.
          * @param handRectangles location of the hands in the image. It is a length-variable std::vector, where
@@ -53,6 +66,14 @@ namespace op
          */
         void forwardPass(const std::vector<std::array<Rectangle<float>, 2>> handRectangles, const Matrix& inputData);
 
+        /**
+         * Projected GPU memory (see gpuMemoryBudget.hpp) of each HandExtractorCaffe: the model weights, the network
+         * blobs and heat maps of a full batch of HAND_MAX_BATCH_SIZE crops, and the input frame it crops them from.
+         * @param inputSize Size of the input frames.
+         */
+        static GpuMemoryFootprint getGpuMemoryFootprint(
+            const Point<int>& netInputSize, const std::string& modelFolder, const Point<int>& inputSize);
+
     private:
         // PIMPL idiom
         // http://www.cppsamples.com/common-tasks/pimpl.html
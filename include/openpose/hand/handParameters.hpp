@@ -41,6 +41,9 @@ namespace op
 
     // Constant parameters
     const auto HAND_CCN_DECREASE_FACTOR = 8.f;
+    // Maximum number of hand crops (of any hand, person or scale) per network forward pass (the network memory grows
+    // linearly with it)
+    const auto HAND_MAX_BATCH_SIZE = 8;
     const std::string HAND_PROTOTXT{"hand/pose_deploy.prototxt"};
     const std::string HAND_TRAINED_MODEL{"hand/pose_iter_102000.caffemodel"};
 
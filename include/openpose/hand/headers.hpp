@@ -3,6 +3,7 @@
 
 // hand module
 #include <openpose/hand/handDetector.hpp>
+#include <openpose/hand/handDetectorFromBinary.hpp>
 #include <openpose/hand/handDetectorFromTxt.hpp>
 #include <openpose/hand/handExtractorCaffe.hpp>
 #include <openpose/hand/handExtractorNet.hpp>
@@ -12,6 +13,7 @@
 #include <openpose/hand/handRenderer.hpp>
 #include <openpose/hand/renderHand.hpp>
 #include <openpose/hand/wHandDetector.hpp>
+#include <openpose/hand/wHandDetectorFromBinary.hpp>
 #include <openpose/hand/wHandDetectorFromTxt.hpp>
 #include <openpose/hand/wHandDetectorTracking.hpp>
 #include <openpose/hand/wHandDetectorUpdate.hpp>
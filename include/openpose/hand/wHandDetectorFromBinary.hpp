@@ -0,0 +1,87 @@
+#ifndef OPENPOSE_HAND_W_HAND_DETECTOR_FROM_BINARY_HPP
+#define OPENPOSE_HAND_W_HAND_DETECTOR_FROM_BINARY_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/hand/handDetectorFromBinary.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    template<typename TDatums>
+    class WHandDetectorFromBinary : public Worker<TDatums>
+    {
+    public:
+        explicit WHandDetectorFromBinary(const std::shared_ptr<HandDetectorFromBinary>& handDetectorFromBinary);
+
+        virtual ~WHandDetectorFromBinary();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        std::shared_ptr<HandDetectorFromBinary> spHandDetectorFromBinary;
+
+        DELETE_COPY(WHandDetectorFromBinary);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WHandDetectorFromBinary<TDatums>::WHandDetectorFromBinary(
+        const std::shared_ptr<HandDetectorFromBinary>& handDetectorFromBinary) :
+        spHandDetectorFromBinary{handDetectorFromBinary}
+    {
+    }
+
+    template<typename TDatums>
+    WHandDetectorFromBinary<TDatums>::~WHandDetectorFromBinary()
+    {
+    }
+
+    template<typename TDatums>
+    void WHandDetectorFromBinary<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WHandDetectorFromBinary<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
+                // Detect people hand
+                for (auto& tDatumPtr : *tDatums)
+                    tDatumPtr->handRectangles = spHandDetectorFromBinary->detectHands();
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WHandDetectorFromBinary);
+}
+
+#endif // OPENPOSE_HAND_W_HAND_DETECTOR_FROM_BINARY_HPP
@@ -2,7 +2,9 @@
 #define OPENPOSE_HAND_W_HAND_EXTRACTOR_NET_HPP
 
 #include <openpose/core/common.hpp>
+#include <openpose/core/keypointRoiCache.hpp>
 #include <openpose/hand/handRenderer.hpp>
+#include <openpose/pose/body135FaceHand.hpp>
 #include <openpose/thread/worker.hpp>
 
 namespace op
@@ -11,7 +13,16 @@ namespace op
     class WHandExtractorNet : public Worker<TDatums>
     {
     public:
-        explicit WHandExtractorNet(const std::shared_ptr<HandExtractorNet>& handExtractorNet);
+        /**
+         * @param roiCache Optional. If not nullptr, the hands of the people whose last keypoints can be reused (see
+         * KeypointRoiCache) skip the hand network.
+         * @param body135FaceHand Optional. If not nullptr, the hands whose BODY_135 hand keypoints are confident (see
+         * Body135FaceHand) are filled from them and skip the hand network.
+         */
+        explicit WHandExtractorNet(
+            const std::shared_ptr<HandExtractorNet>& handExtractorNet,
+            const std::shared_ptr<KeypointRoiCache>& roiCache = nullptr,
+            const std::shared_ptr<Body135FaceHand>& body135FaceHand = nullptr);
 
         virtual ~WHandExtractorNet();
 
@@ -19,8 +30,16 @@ namespace op
 
         void work(TDatums& tDatums);
 
+        /**
+         * Skipped if no Datum has hand rectangles and there is no roiCache (whose update() removes the people
+         * not found), see Worker::isSkippable().
+         */
+        bool isSkippable(const TDatums& tDatums) const;
+
     private:
         std::shared_ptr<HandExtractorNet> spHandExtractorNet;
+        const std::shared_ptr<KeypointRoiCache> spRoiCache;
+        const std::shared_ptr<Body135FaceHand> spBody135FaceHand;
 
         DELETE_COPY(WHandExtractorNet);
     };
@@ -35,8 +54,13 @@ namespace op
 namespace op
 {
     template<typename TDatums>
-    WHandExtractorNet<TDatums>::WHandExtractorNet(const std::shared_ptr<HandExtractorNet>& handExtractorNet) :
-        spHandExtractorNet{handExtractorNet}
+    WHandExtractorNet<TDatums>::WHandExtractorNet(
+        const std::shared_ptr<HandExtractorNet>& handExtractorNet,
+        const std::shared_ptr<KeypointRoiCache>& roiCache,
+        const std::shared_ptr<Body135FaceHand>& body135FaceHand) :
+        spHandExtractorNet{handExtractorNet},
+        spRoiCache{roiCache},
+        spBody135FaceHand{body135FaceHand}
     {
     }
 
@@ -61,16 +85,32 @@ namespace op
                 // Debugging log
                 opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
-                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
                 // Extract people hands
-                for (auto& tDatumPtr : *tDatums)
+                for (auto i = 0u ; i < tDatums->size() ; i++)
                 {
-                    spHandExtractorNet->forwardPass(tDatumPtr->handRectangles, tDatumPtr->cvInputData);
+                    auto& tDatumPtr = (*tDatums)[i];
+                    // BODY_135: The hands whose BODY_135 hand keypoints are confident skip the network
+                    const auto handRectangles = (spBody135FaceHand == nullptr
+                        ? tDatumPtr->handRectangles
+                        : spBody135FaceHand->select(tDatumPtr->handRectangles, tDatumPtr->poseKeypoints));
+                    // ROI cache: The hands whose last keypoints are reused skip the network
+                    if (spRoiCache == nullptr)
+                        spHandExtractorNet->forwardPass(handRectangles, tDatumPtr->cvInputData);
+                    else
+                        spHandExtractorNet->forwardPass(
+                            spRoiCache->select(handRectangles, tDatumPtr->poseIds, i), tDatumPtr->cvInputData);
                     for (auto hand = 0 ; hand < 2 ; hand++)
                     {
                         tDatumPtr->handHeatMaps[hand] = spHandExtractorNet->getHeatMaps()[hand].clone();
                         tDatumPtr->handKeypoints[hand] = spHandExtractorNet->getHandKeypoints()[hand].clone();
                     }
+                    if (spRoiCache != nullptr)
+                        spRoiCache->update(tDatumPtr->handKeypoints, handRectangles, tDatumPtr->poseIds, i);
+                    if (spBody135FaceHand != nullptr)
+                        spBody135FaceHand->update(
+                            tDatumPtr->handKeypoints, tDatumPtr->handRectangles, tDatumPtr->poseKeypoints);
                 }
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
@@ -87,6 +127,26 @@ namespace op
         }
     }
 
+    template<typename TDatums>
+    bool WHandExtractorNet<TDatums>::isSkippable(const TDatums& tDatums) const
+    {
+        try
+        {
+            // No hand rectangles, so no hand keypoints nor heat maps
+            if (spRoiCache != nullptr || !checkNoNullNorEmpty(tDatums))
+                return false;
+            for (const auto& tDatumPtr : *tDatums)
+                if (!tDatumPtr->handRectangles.empty())
+                    return false;
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
     COMPILE_TEMPLATE_DATUM(WHandExtractorNet);
 }
 
@@ -4,16 +4,45 @@
 #include <openpose/core/common.hpp>
 #include <openpose/pose/enumClasses.hpp>
 
+// Forward declaration of cudaStream_t, so CUDA headers are not required
+struct CUstream_st;
+// Forward declaration of the CUDA half precision type, so CUDA headers are not required
+struct __half;
+
 namespace op
 {
+    /**
+     * If numberPeopleMax > 0, the greedy people assembly (pafVectorIntoPeopleVector and its GPU version) stops
+     * creating new people once CONNECTOR_PEOPLE_MAX_FACTOR * numberPeopleMax of them already satisfy minSubsetCnt
+     * and minSubsetScore with their partial score. The connections are sorted by score, so the later new people
+     * tend to be the weaker ones, while the existing ones can still be completed.
+     * After the thresholds, only the top numberPeopleMax people are kept (same criterion than KeepTopNPeople).
+     */
+    const auto CONNECTOR_PEOPLE_MAX_FACTOR = 3;
+
     template <typename T>
     void connectBodyPartsCpu(
         Array<T>& poseKeypoints, Array<T>& poseScores, const T* const heatMapPtr, const T* const peaksPtr,
         const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks, const T interMinAboveThreshold,
         const T interThreshold, const int minSubsetCnt, const T minSubsetScore, const T defaultNmsThreshold,
-        const T scaleFactor = 1.f, const bool maximizePositives = false);
+        const T scaleFactor = 1.f, const bool maximizePositives = false, const int numberPeopleMax = -1);
 
     // Windows: Cuda functions do not include OP_API
+    /**
+     * If assemblyWorkspaceGpuPtr is not nullptr (see getConnectBodyPartsGpuWorkspaceBytes), the whole people assembly
+     * (candidate sorting, greedy matching and thresholding) also runs on the GPU and only the final poseKeypoints and
+     * poseScores are downloaded. In that case, peaksPtr and pairScoresCpu are not used.
+     * All GPU work is queued in cudaStream (nullptr = default stream), which is synchronized before returning.
+     * If pafCandidatesGpuPtr is not nullptr (GPU buffer of 1 + pairScoresCpu.getVolume() elements), the PAF scores are
+     * sparse: A pruning pass first compacts the candidate pairs of peaks, and only those are scored. The candidates
+     * are the pairs of (existing) peaks at most maxLimbLength apart (relative to the heat map diagonal, 1 = no
+     * limit) and whose 2 peaks score at least minPeakScore. The remaining pair scores are set to -1 (no connection).
+     * With the default values, the result is the same than with pafCandidatesGpuPtr = nullptr.
+     * If pafGpuPtr is not nullptr, the PAF channels are read from it rather than from heatMapGpuPtr. It has the same
+     * channels than heatMapGpuPtr, but at network resolution (pafSize), and it is sampled with bilinear interpolation
+     * (so the PAF channels of heatMapGpuPtr do not need to be upsampled). pafLayout is its memory layout (e.g., the
+     * one of the network output, see Net::getOutputLayout()) and pafChannels its number of channels.
+     */
     template <typename T>
     void connectBodyPartsGpu(
         Array<T>& poseKeypoints, Array<T>& poseScores, const T* const heatMapGpuPtr, const T* const peaksPtr,
@@ -21,7 +50,32 @@ namespace op
         const T interThreshold, const int minSubsetCnt, const T minSubsetScore, const T defaultNmsThreshold,
         const T scaleFactor, const bool maximizePositives, Array<T> pairScoresCpu, T* pairScoresGpuPtr,
         const unsigned int* const bodyPartPairsGpuPtr, const unsigned int* const mapIdxGpuPtr,
-        const T* const peaksGpuPtr);
+        const T* const peaksGpuPtr, void* const assemblyWorkspaceGpuPtr = nullptr,
+        CUstream_st* const cudaStream = nullptr, const int numberPeopleMax = -1,
+        int* const pafCandidatesGpuPtr = nullptr, const T maxLimbLength = 1, const T minPeakScore = 0,
+        const T* const pafGpuPtr = nullptr, const Point<int>& pafSize = Point<int>{0, 0},
+        const BlobLayout pafLayout = BlobLayout::Nchw, const int pafChannels = 0);
+
+    // Same as above, but reading half precision (FP16) heat maps. PAF scores are still accumulated in T.
+    template <typename T>
+    void connectBodyPartsGpu(
+        Array<T>& poseKeypoints, Array<T>& poseScores, const __half* const heatMapGpuPtr, const T* const peaksPtr,
+        const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks, const T interMinAboveThreshold,
+        const T interThreshold, const int minSubsetCnt, const T minSubsetScore, const T defaultNmsThreshold,
+        const T scaleFactor, const bool maximizePositives, Array<T> pairScoresCpu, T* pairScoresGpuPtr,
+        const unsigned int* const bodyPartPairsGpuPtr, const unsigned int* const mapIdxGpuPtr,
+        const T* const peaksGpuPtr, void* const assemblyWorkspaceGpuPtr = nullptr,
+        CUstream_st* const cudaStream = nullptr, const int numberPeopleMax = -1,
+        int* const pafCandidatesGpuPtr = nullptr, const T maxLimbLength = 1, const T minPeakScore = 0,
+        const T* const pafGpuPtr = nullptr, const Point<int>& pafSize = Point<int>{0, 0},
+        const BlobLayout pafLayout = BlobLayout::Nchw, const int pafChannels = 0);
+
+    /**
+     * Bytes of GPU memory required by connectBodyPartsGpu to run the people assembly on the GPU. It returns 0 if the
+     * model is not supported by the GPU assembly (models with face keypoints, which require the CPU face merging).
+     */
+    template <typename T>
+    unsigned long long getConnectBodyPartsGpuWorkspaceBytes(const PoseModel poseModel, const int maxPeaks);
 
     template <typename T>
     void connectBodyPartsOcl(
@@ -31,7 +85,7 @@ namespace op
         const T scaleFactor = 1.f, const bool maximizePositives = false,
         Array<T> pairScoresCpu = Array<T>{}, T* pairScoresGpuPtr = nullptr,
         const unsigned int* const bodyPartPairsGpuPtr = nullptr, const unsigned int* const mapIdxGpuPtr = nullptr,
-        const T* const peaksGpuPtr = nullptr, const int gpuID = 0);
+        const T* const peaksGpuPtr = nullptr, const int gpuID = 0, const int numberPeopleMax = -1);
 
     // Private functions used by the 2 above functions
     template <typename T>
@@ -48,6 +102,13 @@ namespace op
         std::vector<std::pair<std::vector<int>, T>>& subsets, const unsigned int numberBodyParts,
         const int minSubsetCnt, const T minSubsetScore, const bool maximizePositives, const T* const peaksPtr);
 
+    // It keeps the numberPeopleMax validSubsetIndexes with the highest score * sqrt(area), in their original order
+    template <typename T>
+    void keepTopPeopleIndexes(
+        std::vector<int>& validSubsetIndexes, int& numberPeople,
+        const std::vector<std::pair<std::vector<int>, T>>& peopleVector, const unsigned int numberBodyParts,
+        const T* const peaksPtr, const int numberPeopleMax);
+
     template <typename T>
     void peopleVectorToPeopleArray(
         Array<T>& poseKeypoints, Array<T>& poseScores, const T scaleFactor,
@@ -63,7 +124,8 @@ namespace op
     template <typename T>
     std::vector<std::pair<std::vector<int>, T>> pafVectorIntoPeopleVector(
         const std::vector<std::tuple<T, T, int, int, int>>& pairScores, const T* const peaksPtr, const int maxPeaks,
-        const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyParts);
+        const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyParts,
+        const int numberPeopleMax = -1, const int minSubsetCnt = 0, const T minSubsetScore = T(0));
 }
 
 #endif // OPENPOSE_POSE_BODY_PARTS_CONNECTOR_HPP
@@ -4,6 +4,10 @@
 #include <openpose/core/common.hpp>
 #include <openpose/pose/enumClasses.hpp>
 
+// Forward declaration of cudaStream_t and the CUDA half precision type, so CUDA headers are not required
+struct CUstream_st;
+struct __half;
+
 namespace op
 {
     // It mostly follows the Caffe::layer implementation, so Caffe users can easily use it. However, in order to keep
@@ -35,8 +39,46 @@ namespace op
 
         void setMinSubsetScore(const T minSubsetScore);
 
+        /**
+         * Candidate pruning of the (sparse) GPU PAF scoring, see connectBodyPartsGpu(): Maximum distance between the
+         * 2 peaks of a limb, relative to the heat map diagonal. Default: 1 (no limit).
+         */
+        void setMaxLimbLength(const T maxLimbLength);
+
+        /**
+         * Candidate pruning of the (sparse) GPU PAF scoring: Minimum score of both peaks of a limb. Default: 0 (no
+         * other limit than the NMS threshold).
+         */
+        void setMinPeakScore(const T minPeakScore);
+
+        /**
+         * If numberPeopleMax > 0, only the top numberPeopleMax people are assembled and returned (see
+         * CONNECTOR_PEOPLE_MAX_FACTOR in bodyPartConnectorBase.hpp). Default: -1 (no limit).
+         */
+        void setNumberPeopleMax(const int numberPeopleMax);
+
         void setScaleNetToOutput(const T scaleNetToOutput);
 
+        /**
+         * CUDA stream where Forward_gpu queues its kernels and copies (nullptr = default stream).
+         */
+        void setCudaStream(CUstream_st* cudaStream);
+
+        /**
+         * If not nullptr, Forward_gpu reads the heat maps from this half precision (FP16) GPU buffer (with the size
+         * of bottom.at(0)) rather than from bottom.at(0).
+         */
+        void setHalfPrecisionHeatMaps(const __half* heatMapsHalfGpuPtr);
+
+        /**
+         * If not nullptr, Forward_gpu reads the PAF channels from this blob (with the same channels than bottom.at(0)
+         * but at network resolution, e.g., the network output) with bilinear interpolation, rather than from
+         * bottom.at(0), whose PAF channels do not need to be upsampled then. lowResolutionLayout is its memory layout
+         * (e.g., Net::getOutputLayout()).
+         */
+        void setLowResolutionPafs(
+            ArrayCpuGpu<T>* lowResolutionPafs, const BlobLayout lowResolutionLayout = BlobLayout::Nchw);
+
         virtual void Forward(const std::vector<ArrayCpuGpu<T>*>& bottom, Array<T>& poseKeypoints,
                              Array<T>& poseScores);
 
@@ -63,6 +105,9 @@ namespace op
         T mInterThreshold;
         int mMinSubsetCnt;
         T mMinSubsetScore;
+        T mMaxLimbLength;
+        T mMinPeakScore;
+        int mNumberPeopleMax;
         T mScaleNetToOutput;
         std::array<int, 4> mHeatMapsSize;
         std::array<int, 4> mPeaksSize;
@@ -72,6 +117,13 @@ namespace op
         unsigned int* pMapIdxGpuPtr;
         Array<T> mFinalOutputCpu;
         T* pFinalOutputGpuPtr;
+        bool mFinalOutputZeroCopy; // Whether pFinalOutputGpuPtr is the (mapped) mFinalOutputCpu
+        void* pAssemblyWorkspaceGpuPtr;
+        int* pPafCandidatesGpuPtr;
+        CUstream_st* pCudaStream;
+        const __half* pHeatMapsHalfGpuPtr;
+        ArrayCpuGpu<T>* pLowResolutionPafs;
+        BlobLayout mLowResolutionLayout;
         int mGpuID;
 
         DELETE_COPY(BodyPartConnectorCaffe);
@@ -4,14 +4,19 @@
 // net module
 #include <openpose/net/bodyPartConnectorBase.hpp>
 #include <openpose/net/bodyPartConnectorCaffe.hpp>
+#include <openpose/net/int8Calibrator.hpp>
 #include <openpose/net/maximumBase.hpp>
 #include <openpose/net/maximumCaffe.hpp>
 #include <openpose/net/net.hpp>
 #include <openpose/net/netCaffe.hpp>
+#include <openpose/net/netMemoryArena.hpp>
 #include <openpose/net/netOpenCv.hpp>
+#include <openpose/net/netOpenVino.hpp>
+#include <openpose/net/netTensorRt.hpp>
 #include <openpose/net/nmsBase.hpp>
 #include <openpose/net/nmsCaffe.hpp>
 #include <openpose/net/resizeAndMergeBase.hpp>
 #include <openpose/net/resizeAndMergeCaffe.hpp>
+#include <openpose/net/tileStitchBase.hpp>
 
 #endif // OPENPOSE_NET_HEADERS_HPP
@@ -0,0 +1,60 @@
+#ifndef OPENPOSE_NET_INT8_CALIBRATOR_HPP
+#define OPENPOSE_NET_INT8_CALIBRATOR_HPP
+
+#include <map>
+#include <openpose/core/common.hpp>
+#include <openpose/net/netCaffe.hpp>
+
+namespace op
+{
+    /**
+     * Int8Calibrator collects, for each tensor (i.e., blob) of a network, the histogram of its absolute values over
+     * a set of calibration images, and it picks the INT8 quantization threshold of each tensor that minimizes the KL
+     * divergence between its float and quantized distributions (i.e., the TensorRT entropy calibration). The result
+     * is written as a TensorRT calibration cache (symmetric per-tensor scales, keyed by tensor name), which is read
+     * by NetTensorRt and NetOpenVino in INT8 precision. The tensor names of the ONNX/IR export must match the blob
+     * names of the Caffe prototxt.
+     */
+    class OP_API Int8Calibrator
+    {
+    public:
+        explicit Int8Calibrator(const int numberBins = 2048);
+
+        virtual ~Int8Calibrator();
+
+        /**
+         * It adds the count values of dataPtr (CPU memory) to the histogram of tensorName.
+         */
+        void addTensor(const std::string& tensorName, const float* const dataPtr, const long long count);
+
+        /**
+         * It adds all the blobs of netCaffe, after its forwardPass() on a calibration image.
+         */
+        void addNet(const NetCaffe& netCaffe);
+
+        /**
+         * Threshold (maximum absolute value represented, i.e., 127 x scale) of each tensor.
+         */
+        std::map<std::string, float> getThresholds() const;
+
+        void writeCalibrationCache(const std::string& calibrationCachePath) const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplInt8Calibrator;
+        std::unique_ptr<ImplInt8Calibrator> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(Int8Calibrator);
+    };
+
+    /**
+     * It reads a TensorRT calibration cache (e.g., written by Int8Calibrator), and it returns the threshold (127 x
+     * scale) of each tensor.
+     */
+    OP_API std::map<std::string, float> readInt8CalibrationCache(const std::string& calibrationCachePath);
+}
+
+#endif // OPENPOSE_NET_INT8_CALIBRATOR_HPP
@@ -14,7 +14,29 @@ namespace op
 
         virtual void forwardPass(const Array<float>& inputData) const = 0;
 
+        /**
+         * It prepares the network for all the given input sizes ({batch size, 3 (RGB), height, width}) in advance,
+         * so later forwardPass() calls switching between them do not allocate memory (nor build TensorRT engines).
+         * It must be called from the same thread than initializationOnThread(). By default, it does nothing (i.e.,
+         * the network is reshaped on demand by forwardPass()).
+         */
+        virtual void reserveInputSizes(const std::vector<std::vector<int>>& inputSizes4D)
+        {
+            UNUSED(inputSizes4D);
+        }
+
         virtual std::shared_ptr<ArrayCpuGpu<float>> getOutputBlobArray() const = 0;
+
+        /**
+         * Memory layout of the getOutputBlobArray() blob, whose shape is always {num, channels, height, width}. The
+         * GPU post-processing (ResizeAndMergeCaffe, NmsCaffe and BodyPartConnectorCaffe) reads it in this layout, so
+         * channel-last outputs are not transposed. It might change after forwardPass() (e.g., one engine per input
+         * size). By default, BlobLayout::Nchw (Caffe).
+         */
+        virtual BlobLayout getOutputLayout() const
+        {
+            return BlobLayout::Nchw;
+        }
     };
 }
 
@@ -3,14 +3,26 @@
 
 #include <openpose/core/common.hpp>
 #include <openpose/net/net.hpp>
+#include <openpose/net/netMemoryArena.hpp>
 
 namespace op
 {
     class OP_API NetCaffe : public Net
     {
     public:
+        /**
+         * @param netMemoryArena Optional. If not nullptr, the intermediate activation blobs (all but the input and
+         * output ones) are placed into it right before each forward pass, so the networks sharing it (which must run
+         * on the same thread) share that GPU memory. Only for CUDA (and not for NVCaffe, which already pools it).
+         * @param netStages Optional. If positive, multi-stage networks (e.g., the body ones) only run their first
+         * netStages stages of each branch: The layer of lastBlobName concatenates the outputs of those stages
+         * (`Mconv7_stage<N><branch>`) instead of the last ones, and the layers of the later stages are removed from
+         * caffeProto when the network is loaded. A branch required by another one (e.g., the PAF stages of BODY_25,
+         * which its heat map stages read) still outputs its last stage.
+         */
         NetCaffe(const std::string& caffeProto, const std::string& caffeTrainedModel, const int gpuId = 0,
-                 const bool enableGoogleLogging = true, const std::string& lastBlobName = "net_output");
+                 const bool enableGoogleLogging = true, const std::string& lastBlobName = "net_output",
+                 const std::shared_ptr<NetMemoryArena>& netMemoryArena = nullptr, const int netStages = 0);
 
         virtual ~NetCaffe();
 
@@ -18,8 +30,35 @@ namespace op
 
         void forwardPass(const Array<float>& inputNetData) const;
 
+        /**
+         * It reshapes the network for inputSize4D ({batch size, 3 (RGB), height, width}) and returns the GPU memory
+         * of its input blob, so it can be written directly on the GPU (e.g., by warpAffineCropsGpu) and then
+         * processed with forwardPassOnGpuInput(). This avoids the host copy and upload of forwardPass().
+         * It returns nullptr if OpenPose was not compiled with CUDA.
+         */
+        float* getInputGpuPtr(const std::vector<int>& inputSize4D);
+
+        /**
+         * It runs the network on the input already written into getInputGpuPtr().
+         */
+        void forwardPassOnGpuInput() const;
+
+        void reserveInputSizes(const std::vector<std::vector<int>>& inputSizes4D);
+
         std::shared_ptr<ArrayCpuGpu<float>> getOutputBlobArray() const;
 
+        /**
+         * Names of all the blobs of the network (the input one, the intermediate activations and the outputs), in
+         * order. E.g., used by Int8Calibrator to collect the activation statistics.
+         */
+        std::vector<std::string> getBlobNames() const;
+
+        /**
+         * It returns the blob named blobName (e.g., an intermediate activation after forwardPass()), or nullptr if
+         * the network does not have that blob. Its memory is owned by the network.
+         */
+        std::shared_ptr<ArrayCpuGpu<float>> getBlobArray(const std::string& blobName) const;
+
     private:
         // PIMPL idiom
         // http://www.cppsamples.com/common-tasks/pimpl.html
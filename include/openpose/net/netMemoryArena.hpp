@@ -0,0 +1,53 @@
+#ifndef OPENPOSE_NET_NET_MEMORY_ARENA_HPP
+#define OPENPOSE_NET_NET_MEMORY_ARENA_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * NetMemoryArena is a GPU memory block shared by the networks (e.g., body, face and hand NetCaffe instances) that
+     * run one after the other on the same thread and GPU. Each network places its intermediate activation blobs into
+     * it right before its forward pass (all but its input and output ones, see NetCaffe), so the GPU memory of the
+     * activations is the one of the largest network, rather than the sum of all of them.
+     * It is not thread-safe: It must only be shared by networks of the same thread (whose forward passes are
+     * serialized in the same CUDA stream).
+     */
+    class OP_API NetMemoryArena
+    {
+    public:
+        explicit NetMemoryArena(const int gpuId);
+
+        virtual ~NetMemoryArena();
+
+        /**
+         * It returns a GPU memory block of at least `bytes` bytes. If the current block is smaller, it is freed and
+         * a bigger one is allocated, invalidating the previously returned pointers (and increasing getGeneration()).
+         * It returns nullptr if OpenPose was not compiled with CUDA.
+         */
+        void* reserve(const unsigned long long bytes);
+
+        /**
+         * Size of the current block (in bytes).
+         */
+        unsigned long long getBytes() const;
+
+        /**
+         * Number of times the block has been re-allocated, so each network knows whether it must place its blobs
+         * again.
+         */
+        unsigned long long getGeneration() const;
+
+        int getGpuId() const;
+
+    private:
+        const int mGpuId;
+        void* pGpuPtr;
+        unsigned long long mBytes;
+        unsigned long long mGeneration;
+
+        DELETE_COPY(NetMemoryArena);
+    };
+}
+
+#endif // OPENPOSE_NET_NET_MEMORY_ARENA_HPP
@@ -0,0 +1,58 @@
+#ifndef OPENPOSE_NET_NET_OPEN_VINO_HPP
+#define OPENPOSE_NET_NET_OPEN_VINO_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/net/net.hpp>
+
+namespace op
+{
+    /**
+     * OpenVINO (CPU plugin, i.e., oneDNN) implementation of Net. It runs an OpenVINO IR (.xml + .bin) or ONNX export
+     * of the OpenPose models (e.g., BODY_25 or COCO). Its output is a Caffe blob in CPU memory, so
+     * ResizeAndMergeCaffe, NmsCaffe and BodyPartConnectorCaffe work exactly as with NetCaffe in the CPU-only version.
+     * That CPU post-processing only reads NCHW blobs, so channel-last model outputs (e.g., with an "NHWC" layout) are
+     * transposed by OpenVINO itself, and its output layout is always BlobLayout::Nchw.
+     * The model is compiled (in throughput mode) once per network input size, and the compiled models are shared by
+     * all the NetOpenVino instances of the same model (e.g., several CPU workers), so their requests are run by the
+     * same pool of OpenVINO CPU streams. Each image of the input batch (e.g., each scale) is run by a different
+     * asynchronous infer request.
+     */
+    class OP_API NetOpenVino : public Net
+    {
+    public:
+        /**
+         * @param model Path to the OpenVINO IR (.xml, with its .bin next to it) or ONNX model.
+         * @param precision 32 (FP32), 16 (BF16, only on the CPUs with native BF16 support, e.g., AMX or
+         * AVX512-BF16, FP32 otherwise) or 8 (INT8, it requires a quantized model, e.g., calibrated with the OpenVINO/
+         * NNCF post-training quantization, or the calibration cache `model`.int8.calib of Int8Calibrator, whose
+         * per-tensor thresholds are added as quantization layers to the convolutions. It runs with VNNI/AMX INT8 if
+         * available).
+         * @param numberRequests Number of asynchronous infer requests of this instance. If <= 0, the optimal one
+         * reported by OpenVINO (i.e., its number of CPU streams).
+         */
+        NetOpenVino(const std::string& model, const int precision = 16, const int numberRequests = -1,
+                    const std::string& lastBlobName = "net_output");
+
+        virtual ~NetOpenVino();
+
+        void initializationOnThread();
+
+        void forwardPass(const Array<float>& inputNetData) const;
+
+        void reserveInputSizes(const std::vector<std::vector<int>>& inputSizes4D);
+
+        std::shared_ptr<ArrayCpuGpu<float>> getOutputBlobArray() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplNetOpenVino;
+        std::unique_ptr<ImplNetOpenVino> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(NetOpenVino);
+    };
+}
+
+#endif // OPENPOSE_NET_NET_OPEN_VINO_HPP
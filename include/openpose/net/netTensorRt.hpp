@@ -0,0 +1,54 @@
+#ifndef OPENPOSE_NET_NET_TENSOR_RT_HPP
+#define OPENPOSE_NET_NET_TENSOR_RT_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/net/net.hpp>
+
+namespace op
+{
+    /**
+     * TensorRT implementation of Net. It runs an ONNX export of the OpenPose models (e.g., BODY_25 or COCO).
+     * Its output is a Caffe blob in GPU memory, so ResizeAndMergeCaffe, NmsCaffe and BodyPartConnectorCaffe work
+     * exactly as with NetCaffe. With FP16 and INT8, TensorRT might keep it channel-last (HWC), which they read
+     * directly (see getOutputLayout()).
+     * TensorRT engines are optimized for a fixed input size, so one engine is built for each network input size
+     * (i.e., batch size and resolution). Each engine is serialized next to the ONNX file (it is GPU architecture
+     * and TensorRT version specific), so it is only built (which takes some minutes) the first time.
+     */
+    class OP_API NetTensorRt : public Net
+    {
+    public:
+        /**
+         * @param onnxModel Path to the ONNX model.
+         * @param precision 32 (FP32), 16 (FP16, recommended) or 8 (INT8, it requires the calibration cache
+         * `onnxModel`.int8.calib generated with TensorRT, e.g., with its `trtexec` tool, or with Int8Calibrator).
+         */
+        NetTensorRt(const std::string& onnxModel, const int gpuId = 0, const int precision = 16,
+                    const std::string& lastBlobName = "net_output");
+
+        virtual ~NetTensorRt();
+
+        void initializationOnThread();
+
+        void forwardPass(const Array<float>& inputNetData) const;
+
+        void reserveInputSizes(const std::vector<std::vector<int>>& inputSizes4D);
+
+        std::shared_ptr<ArrayCpuGpu<float>> getOutputBlobArray() const;
+
+        // Layout of the engine of the last forwardPass() (TensorRT picks it for each engine)
+        BlobLayout getOutputLayout() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplNetTensorRt;
+        std::unique_ptr<ImplNetTensorRt> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(NetTensorRt);
+    };
+}
+
+#endif // OPENPOSE_NET_NET_TENSOR_RT_HPP
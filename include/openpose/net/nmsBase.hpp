@@ -3,6 +3,11 @@
 
 #include <openpose/core/common.hpp>
 
+// Forward declaration of cudaStream_t, so CUDA headers are not required
+struct CUstream_st;
+// Forward declaration of the CUDA half precision type, so CUDA headers are not required
+struct __half;
+
 namespace op
 {
     template <typename T>
@@ -11,15 +16,52 @@ namespace op
       const std::array<int, 4>& sourceSize, const Point<T>& offset);
 
     // Windows: Cuda functions do not include OP_API
+    // cudaStream: CUDA stream where the kernels are queued (nullptr = default stream). The call is asynchronous.
+    // scratchGpuPtr: If not nullptr, GPU buffer of getNmsGpuScratchBytes() bytes where all the temporary memory is
+    // taken from. The call then only queues kernels into cudaStream (no allocation nor synchronization), e.g., so it
+    // can be captured into a CUDA Graph (see CudaGraphCache). It requires CUDA 11 or higher.
+    // kernelPtr must have at least sourceSize[0] * targetSize[1] * sourceSize[2] * sourceSize[3] elements. Unless the
+    // heat maps are very small, it holds the peak lists of the tiled NMS (1 pass over each channel, no scan), and
+    // scratchGpuPtr is not used.
     template <typename T>
     void nmsGpu(
       T* targetPtr, int* kernelPtr, const T* const sourcePtr, const T threshold, const std::array<int, 4>& targetSize,
-      const std::array<int, 4>& sourceSize, const Point<T>& offset);
+      const std::array<int, 4>& sourceSize, const Point<T>& offset, CUstream_st* const cudaStream = nullptr,
+      void* const scratchGpuPtr = nullptr);
+
+    // Same as above, but reading half precision (FP16) heat maps. Peaks and refinement are computed in T.
+    template <typename T>
+    void nmsGpu(
+      T* targetPtr, int* kernelPtr, const __half* const sourcePtr, const T threshold,
+      const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize, const Point<T>& offset,
+      CUstream_st* const cudaStream = nullptr, void* const scratchGpuPtr = nullptr);
+
+    /**
+     * Fused resize and NMS. Approximates the output of resizeAndMergeGpu + nmsGpu, but sourcePtr is the low
+     * resolution heat map (e.g., the network output) and the upsampled heat maps (of size resizedSize) are never
+     * materialized: Only the neighborhood of each low resolution local maximum is upsampled (bicubic) in order to
+     * find and refine the full resolution peaks. Peaks whose low resolution neighborhood has no local maximum might
+     * be missed, and flat plateaus keep exactly one peak (the first one in raster order) rather than none.
+     * It only applies to the first targetSize[1] channels of each source image.
+     * kernelPtr must have at least sourceSize[0] * targetSize[1] * sourceSize[2] * sourceSize[3] elements.
+     * sourceLayout is the memory layout of sourcePtr (sourceSize is still the NCHW one), so channel-last network
+     * outputs are read directly.
+     */
+    template <typename T>
+    void resizeAndNmsGpu(
+      T* targetPtr, int* kernelPtr, const T* const sourcePtr, const T threshold, const std::array<int, 4>& targetSize,
+      const std::array<int, 4>& sourceSize, const Point<int>& resizedSize, const Point<T>& offset,
+      CUstream_st* const cudaStream = nullptr, void* const scratchGpuPtr = nullptr,
+      const BlobLayout sourceLayout = BlobLayout::Nchw);
+
+    // Size (in bytes) of the scratchGpuPtr buffer of nmsGpu (resizeAndNms = false) and resizeAndNmsGpu (true)
+    unsigned long long getNmsGpuScratchBytes(
+      const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize, const bool resizeAndNms);
 
     // Windows: OpenCL functions do not include OP_API
     template <typename T>
     void nmsOcl(
-      T* targetPtr, uint8_t* kernelGpuPtr, uint8_t* kernelCpuPtr, const T* const sourcePtr, const T threshold, const std::array<int, 4>& targetSize,
+      T* targetPtr, uint8_t* kernelGpuPtr, const T* const sourcePtr, const T threshold, const std::array<int, 4>& targetSize,
       const std::array<int, 4>& sourceSize, const Point<T>& offset, const int gpuID = 0);
 }
 
@@ -3,6 +3,10 @@
 
 #include <openpose/core/common.hpp>
 
+// Forward declaration of cudaStream_t and the CUDA half precision type, so CUDA headers are not required
+struct CUstream_st;
+struct __half;
+
 namespace op
 {
     // It mostly follows the Caffe::layer implementation, so Caffe users can easily use it. However, in order to keep
@@ -28,6 +32,32 @@ namespace op
         // Empirically gives better results (copied from Matlab original code)
         void setOffset(const Point<T>& offset);
 
+        /**
+         * CUDA stream where Forward_gpu queues its kernels (nullptr = default stream).
+         */
+        void setCudaStream(CUstream_st* cudaStream);
+
+        /**
+         * If not nullptr, Forward_gpu reads the heat maps from this half precision (FP16) GPU buffer (with the size
+         * of bottom) rather than from bottom.
+         */
+        void setHalfPrecisionBottom(const __half* bottomHalfGpuPtr);
+
+        /**
+         * If not nullptr, Forward_gpu runs the fused resize and NMS (resizeAndNmsGpu) over this low resolution blob
+         * (e.g., the network output), as if it were upsampled to the bottom size. Bottom is not read then, so it does
+         * not need to be filled. lowResolutionLayout is its memory layout (e.g., Net::getOutputLayout()).
+         */
+        void setLowResolutionBottom(
+            ArrayCpuGpu<T>* lowResolutionBottom, const BlobLayout lowResolutionLayout = BlobLayout::Nchw);
+
+        /**
+         * If true, Forward_gpu captures its kernels into a CUDA Graph (one per shape, parameters, and buffers, see
+         * CudaGraphCache) and replays it afterwards. Its temporary memory is then kept between calls. It only applies
+         * on a non-default CUDA stream (see setCudaStream), otherwise the kernels are launched directly.
+         */
+        void setCudaGraphs(const bool cudaGraphs);
+
         virtual void Forward(const std::vector<ArrayCpuGpu<T>*>& bottom, const std::vector<ArrayCpuGpu<T>*>& top);
 
         virtual void Forward_cpu(const std::vector<ArrayCpuGpu<T>*>& bottom, const std::vector<ArrayCpuGpu<T>*>& top);
@@ -45,6 +75,10 @@ namespace op
     private:
         T mThreshold;
         Point<T> mOffset;
+        CUstream_st* pCudaStream;
+        const __half* pBottomHalfGpuPtr;
+        ArrayCpuGpu<T>* pLowResolutionBottom;
+        BlobLayout mLowResolutionLayout;
         int mGpuID;
 
         // PIMPL idiom
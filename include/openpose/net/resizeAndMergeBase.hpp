@@ -3,6 +3,11 @@
 
 #include <openpose/core/common.hpp>
 
+// Forward declaration of cudaStream_t, so CUDA headers are not required
+struct CUstream_st;
+// Forward declaration of the CUDA half precision type, so CUDA headers are not required
+struct __half;
+
 namespace op
 {
     template <typename T>
@@ -11,10 +16,26 @@ namespace op
         const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<T>& scaleInputToNetInputs = {1.f});
 
     // Windows: Cuda functions do not include OP_API
+    // cudaStream: CUDA stream where the kernels are queued (nullptr = default stream). The call is asynchronous.
+    // sourceLayout: Memory layout of the source blobs (their sizes are still the NCHW ones), the target is always
+    // NCHW. So channel-last network outputs are read directly, rather than transposed first.
+    // sourceChannels: Only for BlobLayout::Nhwc, channels of each source pixel in memory, if sourcePtrs point to a
+    // channel range of larger blobs (<= 0 for targetSize[1]).
     template <typename T>
     void resizeAndMergeGpu(
         T* targetPtr, const std::vector<const T*>& sourcePtrs, const std::array<int, 4>& targetSize,
-        const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<T>& scaleInputToNetInputs = {1.f});
+        const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<T>& scaleInputToNetInputs = {1.f},
+        CUstream_st* const cudaStream = nullptr, const BlobLayout sourceLayout = BlobLayout::Nchw,
+        const int sourceChannels = 0);
+
+    // Same as above, but storing the resulting heat maps in half precision (FP16). The interpolation and the
+    // multi-scale averaging are still computed in T.
+    template <typename T>
+    void resizeAndMergeGpu(
+        __half* targetPtr, const std::vector<const T*>& sourcePtrs, const std::array<int, 4>& targetSize,
+        const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<T>& scaleInputToNetInputs = {1.f},
+        CUstream_st* const cudaStream = nullptr, const BlobLayout sourceLayout = BlobLayout::Nchw,
+        const int sourceChannels = 0);
 
     // Windows: OpenCL functions do not include OP_API
     template <typename T>
@@ -33,5 +54,79 @@ namespace op
     void resizeAndPadRbgGpu(
         T* targetPtr, const unsigned char* const srcPtr, const int sourceWidth, const int sourceHeight,
         const int targetWidth, const int targetHeight, const T scaleFactor);
+
+    /**
+     * Resize and pad a BGR (8-bit, interleaved, e.g., cv::Mat) GPU image into the interleaved BGR float format of
+     * Datum::outputData (targetHeight x targetWidth x 3), i.e., the GPU analog of resizeFixedAspectRatio +
+     * cv::Mat::convertTo (bicubic when upsampling, bilinear otherwise, black padding). The call is asynchronous in
+     * cudaStream.
+     */
+    template <typename T>
+    void resizeAndPadBgrGpu(
+        T* targetPtr, const unsigned char* const srcPtr, const int sourceWidth, const int sourceHeight,
+        const int targetWidth, const int targetHeight, const T scaleFactor, CUstream_st* const cudaStream = nullptr);
+
+    /**
+     * Resize, pad and normalize (see uCharCvMatToFloatPtr) an NV12 GPU frame (see FrameGpu) into the planar BGR
+     * network input format (3 x targetHeight x targetWidth), matching the CPU path of CvMatToOpInput (i.e.,
+     * resizeFixedAspectRatio + uCharCvMatToFloatPtr). The call is asynchronous in cudaStream.
+     * If undistortMapPtr is not null (see FrameGpu::undistortMapPtr), the frame is also undistorted in the same
+     * gather, i.e., the GPU analog of CameraParameterReader::undistort() + the previous CPU path. Analogously,
+     * rotation and flip (see FrameGpu::rotation) replace rotateAndFlipFrame() by an index remap, so the target is the
+     * resized rotated frame (the source sizes are the raw ones).
+     */
+    template <typename T>
+    void resizeAndPadNv12Gpu(
+        T* targetPtr, const unsigned char* const nv12Ptr, const int sourceWidth, const int sourceHeight,
+        const int sourcePitch, const bool bt709, const bool fullRange, const int targetWidth, const int targetHeight,
+        const T scaleFactor, const int normalize, CUstream_st* const cudaStream = nullptr,
+        const float* const undistortMapPtr = nullptr, const int rotation = 0, const bool flip = false);
+
+    /**
+     * Analogous to resizeAndPadNv12Gpu() for a raw 8-bit Bayer GPU frame (see FrameGpu), so the demosaicing is fused
+     * with the resize (bilinear, see bayerToBgr()), rotation/flip, undistortion (if any) and normalization.
+     */
+    template <typename T>
+    void resizeAndPadBayerGpu(
+        T* targetPtr, const unsigned char* const bayerPtr, const int sourceWidth, const int sourceHeight,
+        const int sourcePitch, const FrameGpuFormat bayerFormat, const int targetWidth, const int targetHeight,
+        const T scaleFactor, const int normalize, CUstream_st* const cudaStream = nullptr,
+        const float* const undistortMapPtr = nullptr, const int rotation = 0, const bool flip = false);
+
+    /**
+     * Analogous to resizeAndPadNv12Gpu() for an interleaved 8-bit BGR GPU frame (FrameGpuFormat::Bgr) with a row
+     * stride of sourcePitch bytes.
+     */
+    template <typename T>
+    void resizeAndPadBgrFrameGpu(
+        T* targetPtr, const unsigned char* const bgrPtr, const int sourceWidth, const int sourceHeight,
+        const int sourcePitch, const int targetWidth, const int targetHeight, const T scaleFactor,
+        const int normalize, CUstream_st* const cudaStream = nullptr, const float* const undistortMapPtr = nullptr,
+        const int rotation = 0, const bool flip = false);
+
+    // Functions for the face and hand crops
+    /**
+     * It warps numberCrops = affineMatrices.size() crops of the BGR (8-bit, interleaved) GPU image srcPtr into
+     * consecutive normalized (see uCharCvMatToFloatPtr) 3 x targetHeight x targetWidth network inputs, i.e., the GPU
+     * analog of cv::warpAffine (bilinear, cv::WARP_INVERSE_MAP, black border) + uCharCvMatToFloatPtr for each crop.
+     * Each affine matrix (2x3, row-major) maps the target (crop) pixel coordinates into the source ones. The call is
+     * asynchronous in cudaStream.
+     */
+    template <typename T>
+    void warpAffineCropsGpu(
+        T* targetPtr, const unsigned char* const srcPtr, const int sourceWidth, const int sourceHeight,
+        const std::vector<std::array<T, 6>>& affineMatrices, const int targetWidth, const int targetHeight,
+        const int normalize, CUstream_st* const cudaStream = nullptr);
+
+    /**
+     * Analogous to the function above for an already normalized planar (3 x sourceHeight x sourceWidth) float GPU
+     * image (e.g., the network input of the whole frame, see PoseExtractorCaffe), whose pixels outside the image take
+     * the border value of their channel (e.g., the normalized black pixel).
+     */
+    template <typename T>
+    void warpAffineCropsGpu(
+        T* targetPtr, const T* const srcPtr, const int sourceWidth, const int sourceHeight,
+        const std::vector<std::array<T, 6>>& affineMatrices, const int targetWidth, const int targetHeight,
+        const std::array<T, 3>& borderValues, CUstream_st* const cudaStream = nullptr);
 }
 #endif // OPENPOSE_NET_RESIZE_AND_MERGE_BASE_HPP
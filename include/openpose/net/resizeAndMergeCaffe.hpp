@@ -3,8 +3,14 @@
 
 #include <openpose/core/common.hpp>
 
+// Forward declaration of cudaStream_t and the CUDA half precision type, so CUDA headers are not required
+struct CUstream_st;
+struct __half;
+
 namespace op
 {
+    class CudaGraphCache;
+
     // It mostly follows the Caffe::layer implementation, so Caffe users can easily use it. However, in order to keep
     // the compatibility with any generic Caffe version, we keep this 'layer' inside our library rather than in the
     // Caffe code.
@@ -26,6 +32,38 @@ namespace op
 
         void setScaleRatios(const std::vector<T>& scaleRatios);
 
+        /**
+         * CUDA stream where Forward_gpu queues its kernels (nullptr = default stream).
+         */
+        void setCudaStream(CUstream_st* cudaStream);
+
+        /**
+         * If not nullptr, Forward_gpu stores the resulting heat maps in this half precision (FP16) GPU buffer (with
+         * the size of top) rather than in top, which is then left untouched.
+         */
+        void setHalfPrecisionTarget(__half* targetHalfGpuPtr);
+
+        /**
+         * Forward_gpu only resizes the channels [firstChannel, firstChannel + numberChannels) (numberChannels < 0
+         * means until the last one), the other ones are left untouched. Only for a single image (i.e., top and bottom
+         * with shape(0) = 1).
+         */
+        void setChannelRange(const int firstChannel, const int numberChannels = -1);
+
+        /**
+         * Memory layout of bottom (e.g., Net::getOutputLayout() if bottom is the network output). Forward_gpu reads
+         * channel-last (BlobLayout::Nhwc) bottoms directly, top is always NCHW. Forward_cpu and Forward_ocl only
+         * support BlobLayout::Nchw (default).
+         */
+        void setBottomLayout(const BlobLayout bottomLayout);
+
+        /**
+         * If true, Forward_gpu captures its kernels into a CUDA Graph (one per shape, channel range, and buffers, see
+         * CudaGraphCache) and replays it afterwards. It only applies to a single scale (i.e., 1 bottom) on a
+         * non-default CUDA stream (see setCudaStream), otherwise the kernels are launched directly.
+         */
+        void setCudaGraphs(const bool cudaGraphs);
+
         virtual void Forward(const std::vector<ArrayCpuGpu<T>*>& bottom, const std::vector<ArrayCpuGpu<T>*>& top);
 
         virtual void Forward_cpu(const std::vector<ArrayCpuGpu<T>*>& bottom, const std::vector<ArrayCpuGpu<T>*>& top);
@@ -45,7 +83,13 @@ namespace op
         std::vector<T> mScaleRatios;
         std::vector<std::array<int, 4>> mBottomSizes;
         std::array<int, 4> mTopSize;
+        CUstream_st* pCudaStream;
+        __half* pTargetHalfGpuPtr;
+        int mFirstChannel;
+        int mNumberChannels;
+        BlobLayout mBottomLayout;
         int mGpuID;
+        std::shared_ptr<CudaGraphCache> spCudaGraphCache;
 
         DELETE_COPY(ResizeAndMergeCaffe);
     };
@@ -0,0 +1,44 @@
+#ifndef OPENPOSE_NET_TILE_STITCH_BASE_HPP
+#define OPENPOSE_NET_TILE_STITCH_BASE_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    // Maximum number of tiles along each axis of a TileGrid
+    const auto TILE_GRID_MAX_TILES = 32;
+
+    /**
+     * Regular grid of overlapping tiles (row-major, i.e., tile index = tileY * numberX + tileX), in pixels of the
+     * tiled image (or of the network output of each tile). Each origin is the top-left corner of its tile, they are
+     * sorted, and the last tile can exceed the image size (e.g., if the image is smaller than a single tile).
+     */
+    struct TileGrid
+    {
+        int tileWidth;
+        int tileHeight;
+        int numberX;
+        int numberY;
+        int originsX[TILE_GRID_MAX_TILES];
+        int originsY[TILE_GRID_MAX_TILES];
+    };
+
+    /**
+     * It stitches the tiles of sourcePtr (e.g., the network output of each tile, with size {number tiles, channels,
+     * tileHeight, tileWidth}) into targetPtr (size {1, channels, height, width}). Where neighbouring tiles overlap,
+     * they are blended with linear weights (1 at the inner part of each tile, decreasing towards its edge), so the
+     * result is continuous across the tile borders.
+     */
+    template <typename T>
+    void tileStitchCpu(
+        T* targetPtr, const T* const sourcePtr, const std::array<int, 4>& targetSize,
+        const std::array<int, 4>& sourceSize, const TileGrid& tileGrid);
+
+    // Windows: Cuda functions do not include OP_API
+    template <typename T>
+    void tileStitchGpu(
+        T* targetPtr, const T* const sourcePtr, const std::array<int, 4>& targetSize,
+        const std::array<int, 4>& sourceSize, const TileGrid& tileGrid);
+}
+
+#endif // OPENPOSE_NET_TILE_STITCH_BASE_HPP
@@ -0,0 +1,73 @@
+#ifndef OPENPOSE_POSE_ADAPTIVE_MULTI_SCALE_HPP
+#define OPENPOSE_POSE_ADAPTIVE_MULTI_SCALE_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/core/cvMatToOpInput.hpp>
+#include <openpose/pose/enumClasses.hpp>
+#include <openpose/pose/poseExtractor.hpp>
+
+namespace op
+{
+    /**
+     * AdaptiveMultiScale runs the extra scales of the multi-scale mode (`--scale_number`, `--scale_gap`) only where
+     * they are needed. The whole frame is processed at the smallest scale (i.e., ScaleAndSizeExtractor with
+     * smallestScaleOnly = true), and refine() re-runs the body network at the largest scale (the network resolution)
+     * only on crops around the people of that result that are small (height lower than maxPersonHeight times the
+     * input height) or not confident (average score of their detected keypoints lower than minAverageScore). The
+     * people found in each crop replace the ones that triggered it (or are added if they were missed), while the
+     * rest of people of the smallest scale are kept. The body part candidates and heat maps are the ones of the
+     * smallest scale.
+     * It is not thread-safe, i.e., each WPoseExtractor must have its own AdaptiveMultiScale.
+     */
+    class OP_API AdaptiveMultiScale
+    {
+    public:
+        /**
+         * @param scaleNumber Number of scales of the multi-scale mode (it must be greater than 1).
+         * @param scaleGap Gap between scales of the multi-scale mode (see ScaleAndSizeExtractor).
+         * @param maxPersonHeight Maximum height of a small person, relative to the input (or Datum::inputRoi)
+         * height.
+         * @param minAverageScore Minimum average score of the detected keypoints of a confident person.
+         */
+        AdaptiveMultiScale(
+            const PoseModel poseModel, const int scaleNumber, const double scaleGap, const float maxPersonHeight,
+            const float minAverageScore = 0.4f);
+
+        virtual ~AdaptiveMultiScale();
+
+        /**
+         * It runs poseExtractor on the crops of the small or not confident people of poseKeypoints (in full-frame
+         * coordinates), and merges their people into poseKeypoints and poseScores. It must be called after the
+         * forwardPass() of poseExtractor on the whole frame (whose results are overwritten).
+         * @param scaleInputToNetInputs The one of the whole frame (only the smallest scale).
+         * @param inputRoi Datum::inputRoi (the crops are limited to inputRoiRectangle, and polygons are masked out).
+         * @param inputRoiRectangle Datum::getInputRoiRectangle().
+         */
+        void refine(
+            PoseExtractor& poseExtractor, Array<float>& poseKeypoints, Array<float>& poseScores,
+            const Matrix& inputData, const std::vector<double>& scaleInputToNetInputs,
+            const std::vector<Point<int>>& inputRoi, const Rectangle<int>& inputRoiRectangle,
+            const long long frameId = -1ll);
+
+        /**
+         * Number of frames refined and number of crops run.
+         */
+        std::pair<unsigned long long, unsigned long long> getStats() const;
+
+    private:
+        const double mSmallestScale;
+        const float mMaxPersonHeight;
+        const float mMinAverageScore;
+        CvMatToOpInput mCvMatToOpInput;
+        unsigned long long mFrames;
+        unsigned long long mCrops;
+
+        std::vector<Rectangle<int>> getCrops(
+            const Array<float>& poseKeypoints, const Rectangle<int>& inputRoiRectangle,
+            std::vector<char>& selected) const;
+
+        DELETE_COPY(AdaptiveMultiScale);
+    };
+}
+
+#endif // OPENPOSE_POSE_ADAPTIVE_MULTI_SCALE_HPP
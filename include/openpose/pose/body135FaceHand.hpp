@@ -0,0 +1,85 @@
+#ifndef OPENPOSE_POSE_BODY_135_FACE_HAND_HPP
+#define OPENPOSE_POSE_BODY_135_FACE_HAND_HPP
+
+#include <array>
+#include <openpose/core/common.hpp>
+#include <openpose/pose/enumClasses.hpp>
+
+namespace op
+{
+    /**
+     * Body135FaceHand fills the face and hand keypoints directly from the face and hand parts of the BODY_135 body
+     * keypoints (PoseModel::BODY_135 predicts them in the same forward pass as the body), so the separate face and
+     * hand networks only refine the people whose BODY_135 face (or hand) is not confident enough (average score
+     * lower than faceMinAverageScore or handMinAverageScore). The face parts of BODY_135 follow the same order than
+     * the 70 face keypoints, and its hand parts (together with the wrist) the same order than the 21 hand keypoints.
+     * It follows the select() + update() scheme of KeypointRoiCache (both can be combined, select() of this class
+     * first and update() of this class last). It has no state, so it is thread-safe.
+     */
+    class OP_API Body135FaceHand
+    {
+    public:
+        /**
+         * @param faceMinAverageScore Minimum average score of the BODY_135 face parts of a person in order to use
+         * them rather than running the face network for that person. 0 uses all of them, and negative disables it
+         * (the face select() and update() do nothing).
+         * @param handMinAverageScore Analogous to faceMinAverageScore for each hand.
+         */
+        Body135FaceHand(const PoseModel poseModel, const float faceMinAverageScore, const float handMinAverageScore);
+
+        virtual ~Body135FaceHand();
+
+        /**
+         * It returns a copy of faceRectangles where the ones of the people whose BODY_135 face is confident are empty
+         * (0 x 0), so the face extractor skips them. It must be followed by update() with the face keypoints computed
+         * from those rectangles.
+         */
+        std::vector<Rectangle<float>> select(
+            const std::vector<Rectangle<float>>& faceRectangles, const Array<float>& poseKeypoints) const;
+
+        /**
+         * It fills the face keypoints of the people skipped by select() (and of the ones whose rectangle was already
+         * empty, i.e., not run by the network) with their BODY_135 face parts.
+         * @param faceRectangles The same rectangles given to select() (not the returned ones).
+         */
+        void update(
+            Array<float>& faceKeypoints, const std::vector<Rectangle<float>>& faceRectangles,
+            const Array<float>& poseKeypoints) const;
+
+        /**
+         * Analogous to select() for the 2 hands (left and right) of each person.
+         */
+        std::vector<std::array<Rectangle<float>, 2>> select(
+            const std::vector<std::array<Rectangle<float>, 2>>& handRectangles,
+            const Array<float>& poseKeypoints) const;
+
+        /**
+         * Analogous to update() for the 2 hands (left and right) of each person.
+         */
+        void update(
+            std::array<Array<float>, 2>& handKeypoints,
+            const std::vector<std::array<Rectangle<float>, 2>>& handRectangles,
+            const Array<float>& poseKeypoints) const;
+
+    private:
+        const float mFaceMinAverageScore;
+        const float mHandMinAverageScore;
+        // BODY_135 part of each face keypoint, and of each hand keypoint of the left and right hands
+        std::vector<unsigned int> mFaceParts;
+        std::array<std::vector<unsigned int>, 2> mHandParts;
+
+        bool isConfident(
+            const Array<float>& poseKeypoints, const int person, const std::vector<unsigned int>& parts,
+            const float minAverageScore) const;
+
+        // It fills the keypoints of the people whose BODY_135 parts are confident or whose rectangle is empty
+        void fill(
+            Array<float>& keypoints, const std::vector<Rectangle<float>>& rectangles,
+            const Array<float>& poseKeypoints, const std::vector<unsigned int>& parts,
+            const float minAverageScore) const;
+
+        DELETE_COPY(Body135FaceHand);
+    };
+}
+
+#endif // OPENPOSE_POSE_BODY_135_FACE_HAND_HPP
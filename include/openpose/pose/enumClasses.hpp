@@ -36,6 +36,8 @@ namespace op
         ConnectInterThreshold,
         ConnectMinSubsetCnt,
         ConnectMinSubsetScore,
+        ConnectMaxLimbLength,   /**< Relative to the heat map diagonal (1 = no limit). Only used by the GPU version. */
+        ConnectMinPeakScore,    /**< Minimum score of both peaks of a limb. Only used by the GPU version. */
         Size,
     };
 }
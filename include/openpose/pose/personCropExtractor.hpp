@@ -0,0 +1,76 @@
+#ifndef OPENPOSE_POSE_PERSON_CROP_EXTRACTOR_HPP
+#define OPENPOSE_POSE_PERSON_CROP_EXTRACTOR_HPP
+
+#include <array>
+#include <openpose/core/common.hpp>
+#include <openpose/core/personCropsGpu.hpp>
+#include <openpose/pose/enumClasses.hpp>
+
+namespace op
+{
+    /**
+     * PersonCropExtractor produces an aligned crop of each detected person on the GPU (e.g., for a second model such
+     * as action recognition), reusing the batched affine crop kernel of the face and hand extractors
+     * (warpAffineCropsGpu): the frame is uploaded once and all the crops are warped from it in a single call, into
+     * consecutive normalized (as the body network input) 3 x height x width planes.
+     * Each crop is the bounding box of the body keypoints of its person above a score threshold, enlarged by a scale
+     * factor, padded to the aspect ratio of the crop and, optionally, rotated so the torso (mid-hip to neck) is
+     * vertical.
+     * It is not thread-safe, and it requires CUDA.
+     */
+    class OP_API PersonCropExtractor
+    {
+    public:
+        /**
+         * @param cropSize Resolution (width x height) of each crop.
+         * @param scale Enlargement factor of the keypoint bounding box of each crop.
+         * @param align Whether each crop is rotated so the torso of its person is vertical.
+         * @param threshold Minimum score of the keypoints used for the bounding boxes.
+         * @param download Whether the crops are also copied into pinned host memory.
+         * @param gpuId CUDA device of the crops.
+         */
+        PersonCropExtractor(
+            const PoseModel poseModel, const Point<int>& cropSize, const float scale, const bool align,
+            const float threshold, const bool download, const int gpuId);
+
+        virtual ~PersonCropExtractor();
+
+        void initializationOnThread();
+
+        /**
+         * It fills the crops of the people of poseKeypoints (and their affine matrices), or empties them if there
+         * are no people. It blocks until the crops are ready.
+         * @param inputData Original frame (Datum::cvInputData, BGR).
+         * @param poseKeypoints Body keypoints in input resolution (i.e., before KeypointScaler).
+         */
+        void extract(
+            PersonCropsGpu& personCropsGpu, Array<float>& personCrops,
+            std::vector<std::array<float, 6>>& personCropMatrices, const Matrix& inputData,
+            const Array<float>& poseKeypoints);
+
+        /**
+         * Affine matrix (2x3, row-major, crop pixel -> input pixel) of each person of poseKeypoints, skipping none
+         * (people without any keypoint above the threshold get an empty crop centered on the origin).
+         */
+        std::vector<std::array<float, 6>> getCropMatrices(const Array<float>& poseKeypoints) const;
+
+    private:
+        const Point<int> mCropSize;
+        const float mScale;
+        const float mThreshold;
+        const bool mDownload;
+        const int mGpuId;
+        // Torso keypoints for the alignment (-1 if not available in this model)
+        int mNeckIndex;
+        int mMidHipIndex;
+        int mRHipIndex;
+        int mLHipIndex;
+        // Uploaded frame
+        unsigned char* pFrameGpuPtr;
+        unsigned long long mFrameGpuBytes;
+
+        DELETE_COPY(PersonCropExtractor);
+    };
+}
+
+#endif // OPENPOSE_POSE_PERSON_CROP_EXTRACTOR_HPP
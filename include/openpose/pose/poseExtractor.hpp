@@ -6,6 +6,7 @@
 #include <openpose/core/keepTopNPeople.hpp>
 #include <openpose/pose/poseParameters.hpp>
 #include <openpose/pose/poseExtractorNet.hpp>
+#include <openpose/tracking/keypointExtrapolator.hpp>
 #include <openpose/tracking/personIdExtractor.hpp>
 #include <openpose/tracking/personTracker.hpp>
 
@@ -14,11 +15,19 @@ namespace op
     class OP_API PoseExtractor
     {
     public:
+        /**
+         * @param keypointExtrapolators Optional alternative to personTracker (only 1 of them should be non-empty).
+         * If not empty, the frames between the body detections (see tracking) get their keypoints from the
+         * constant-velocity filters of the KeypointExtrapolator of their view, instead of from the LK tracking. As
+         * personTracker, it must be shared among all the PoseExtractor (e.g., GPUs).
+         */
         PoseExtractor(const std::shared_ptr<PoseExtractorNet>& poseExtractorNet,
                       const std::shared_ptr<KeepTopNPeople>& keepTopNPeople = nullptr,
                       const std::shared_ptr<PersonIdExtractor>& personIdExtractor = nullptr,
                       const std::shared_ptr<std::vector<std::shared_ptr<PersonTracker>>>& personTracker = {},
-                      const int numberPeopleMax = -1, const int tracking = -1);
+                      const int numberPeopleMax = -1, const int tracking = -1,
+                      const std::shared_ptr<std::vector<std::shared_ptr<KeypointExtrapolator>>>&
+                          keypointExtrapolators = {});
 
         virtual ~PoseExtractor();
 
@@ -30,19 +39,46 @@ namespace op
                          const Array<float>& poseNetOutput = Array<float>{},
                          const long long frameId = -1ll);
 
+        // See PoseExtractorNet::reserveNetInputSizes
+        void reserveNetInputSizes(const std::vector<std::vector<Point<int>>>& netInputSizes);
+
+        // See PoseExtractorNet::warmUp
+        void warmUp(const std::vector<std::vector<Point<int>>>& netInputSizes, const int batchSize = 1);
+
+        // Batched forward pass (see PoseExtractorNet::forwardPassBatch). Not compatible with tracking.
+        void forwardPassBatch(const std::vector<std::vector<Array<float>>>& inputNetDatas);
+
+        void postProcessBatchElement(const int batchIndex, const std::vector<Array<float>>& inputNetData,
+                                     const Point<int>& inputDataSize, const std::vector<double>& scaleRatios);
+
+        // Pipelined forward pass (see PoseExtractorNet::forwardPassPipelined). Not compatible with tracking.
+        void forwardPassPipelined(const std::vector<Array<float>>& inputNetData);
+
+        void postProcessPipelined(const std::vector<Array<float>>& inputNetData, const Point<int>& inputDataSize,
+                                  const std::vector<double>& scaleRatios);
+
         // PoseExtractorNet functions
         Array<float> getHeatMapsCopy() const;
 
+        std::function<Array<float>()> getHeatMapsDownload() const;
+
+        void getHeatMapsSparse(SparseHeatMaps& heatMapsSparse, const float threshold) const;
+
         std::vector<std::vector<std::array<float, 3>>> getCandidatesCopy() const;
 
+        void getCandidates(Array<float>& candidates, std::vector<int>& offsets) const;
+
         Array<float> getPoseKeypoints() const;
 
         Array<float> getPoseScores() const;
 
         float getScaleNetToOutput() const;
 
+        std::vector<DatumTimingEvent> takeGpuTimingEvents();
+
         // KeepTopNPeople functions
-        void keepTopPeople(Array<float>& poseKeypoints, const Array<float>& poseScores) const;
+        // It removes the extra people from both poseKeypoints and poseScores (in place)
+        void keepTopPeople(Array<float>& poseKeypoints, Array<float>& poseScores) const;
 
         // PersonIdExtractor functions
         // Not thread-safe
@@ -70,6 +106,13 @@ namespace op
         const std::shared_ptr<KeepTopNPeople> spKeepTopNPeople;
         const std::shared_ptr<PersonIdExtractor> spPersonIdExtractor;
         const std::shared_ptr<std::vector<std::shared_ptr<PersonTracker>>> spPersonTrackers;
+        const std::shared_ptr<std::vector<std::shared_ptr<KeypointExtrapolator>>> spKeypointExtrapolators;
+
+        // Whether the body network runs on this frame (see tracking)
+        bool isKeyframe(const long long frameId) const;
+
+        // KeypointExtrapolator of the view imageViewIndex (created if required)
+        std::shared_ptr<KeypointExtrapolator> getKeypointExtrapolator(const unsigned long long imageViewIndex);
 
         DELETE_COPY(PoseExtractor);
     };
@@ -1,21 +1,44 @@
 #ifndef OPENPOSE_POSE_POSE_EXTRACTOR_CAFFE_HPP
 #define OPENPOSE_POSE_POSE_EXTRACTOR_CAFFE_HPP
 
+#include <queue> // std::queue
 #include <openpose/core/common.hpp>
+#include <openpose/filestream/netOutputCache.hpp>
+#include <openpose/gpu/gpuMemoryBudget.hpp>
 #include <openpose/net/bodyPartConnectorCaffe.hpp>
 #include <openpose/net/maximumCaffe.hpp>
 #include <openpose/net/netCaffe.hpp>
 #include <openpose/net/netOpenCv.hpp>
+#include <openpose/net/netOpenVino.hpp>
+#include <openpose/net/netTensorRt.hpp>
 #include <openpose/net/nmsCaffe.hpp>
 #include <openpose/net/resizeAndMergeCaffe.hpp>
 #include <openpose/pose/enumClasses.hpp>
 #include <openpose/pose/poseExtractorNet.hpp>
 
+// Forward declaration of cudaEvent_t and the CUDA half precision type, so CUDA headers are not required
+struct CUevent_st;
+struct __half;
+
 namespace op
 {
     class OP_API PoseExtractorCaffe : public PoseExtractorNet
     {
     public:
+        /**
+         * @param netOutputCache If not nullptr, forwardPass() looks for the network output of each frame in it (and
+         * only runs the network and adds its output on a miss). The batched forward pass does not use it.
+         * @param netMemoryArena If not nullptr, the intermediate blobs of the Caffe networks are placed into it (see
+         * NetCaffe).
+         * @param netTileSize If positive, tiled inference: Each network input larger than netTileSize (single scale
+         * only) is split into overlapping tiles of netTileSize, which run as a single batch, and their network output
+         * is stitched (blending the overlaps, see tileStitchCpu) into the one of the whole input before the NMS and
+         * the body part connection. Thus, the network memory grows with the number of tiles rather than with the
+         * input area.
+         * @param netTileOverlap Minimum overlap between neighbouring tiles, as a ratio of netTileSize (in [0, 0.5)).
+         * @param netStages If positive, the Caffe body network only runs its first netStages stages (see NetCaffe),
+         * trading accuracy for speed.
+         */
         PoseExtractorCaffe(
             const PoseModel poseModel, const std::string& modelFolder, const int gpuId,
             const std::vector<HeatMapType>& heatMapTypes = {},
@@ -23,7 +46,13 @@ namespace op
             const bool addPartCandidates = false, const bool maximizePositives = false,
             const std::string& protoTxtPath = "", const std::string& caffeModelPath = "",
             const float upsamplingRatio = 0.f, const bool enableNet = true,
-            const bool enableGoogleLogging = true);
+            const bool enableGoogleLogging = true, const int tensorRtPrecision = 16,
+            const bool heatMapsFp16 = false, const int roiTrackingInterval = 0, const int numberPeopleMax = -1,
+            const bool scaleBatch = false, const bool cudaGraphs = false, const bool pafLowResolution = false,
+            const std::shared_ptr<NetOutputCache>& netOutputCache = nullptr,
+            const std::shared_ptr<NetMemoryArena>& netMemoryArena = nullptr,
+            const Point<int>& netTileSize = Point<int>{0, 0}, const float netTileOverlap = 0.25f,
+            const int netStages = 0);
 
         virtual ~PoseExtractorCaffe();
 
@@ -41,6 +70,20 @@ namespace op
             const std::vector<double>& scaleInputToNetInputs = {1.f},
             const Array<float>& poseNetOutput = Array<float>{});
 
+        virtual void forwardPassBatch(const std::vector<std::vector<Array<float>>>& inputNetDatas);
+
+        virtual void postProcessBatchElement(
+            const int batchIndex, const std::vector<Array<float>>& inputNetData, const Point<int>& inputDataSize,
+            const std::vector<double>& scaleInputToNetInputs = {1.f});
+
+        virtual void forwardPassPipelined(const std::vector<Array<float>>& inputNetData);
+
+        virtual void postProcessPipelined(
+            const std::vector<Array<float>>& inputNetData, const Point<int>& inputDataSize,
+            const std::vector<double>& scaleInputToNetInputs = {1.f});
+
+        virtual void reserveNetInputSizes(const std::vector<std::vector<Point<int>>>& netInputSizes);
+
         const float* getCandidatesCpuConstPtr() const;
 
         const float* getCandidatesGpuConstPtr() const;
@@ -51,8 +94,21 @@ namespace op
 
         std::vector<int> getHeatMapSize() const;
 
+        const float* getNetOutputGpuConstPtr() const;
+
+        std::vector<int> getNetOutputSize() const;
+
         const float* getPoseGpuConstPtr() const;
 
+        /**
+         * Projected GPU memory (see gpuMemoryBudget.hpp) of each PoseExtractorCaffe: the model weights, and, per
+         * batch frame, the network blobs and heat maps of all its scales.
+         * @param netInputSizes Network input size of each scale (see ScaleAndSizeExtractor).
+         */
+        static GpuMemoryFootprint getGpuMemoryFootprint(
+            const PoseModel poseModel, const std::string& modelFolder, const std::vector<Point<int>>& netInputSizes,
+            const std::string& caffeModelPath = "");
+
     private:
         // Used when increasing spNets
         const PoseModel mPoseModel;
@@ -63,6 +119,14 @@ namespace op
         const float mUpsamplingRatio;
         const bool mEnableNet;
         const bool mEnableGoogleLogging;
+        const int mTensorRtPrecision;
+        const bool mHeatMapsFp16;
+        const bool mFusedNmsEnabled;
+        const bool mPafLowResolutionEnabled;
+        // ROI tracking (full-frame detection only every mRoiTrackingInterval frames)
+        const int mRoiTrackingInterval;
+        int mFramesSinceFullDetection;
+        Point<int> mRoiTrackingInputDataSize;
         // General parameters
         std::vector<std::shared_ptr<Net>> spNets;
         std::shared_ptr<ResizeAndMergeCaffe<float>> spResizeAndMergeCaffe;
@@ -75,6 +139,97 @@ namespace op
         std::shared_ptr<ArrayCpuGpu<float>> spHeatMapsBlob;
         std::shared_ptr<ArrayCpuGpu<float>> spPeaksBlob;
         std::shared_ptr<ArrayCpuGpu<float>> spMaximumPeaksBlob;
+        // Multi-scale batch (all the scales padded to a common size and processed with a single forward pass)
+        const bool mScaleBatch;
+        Array<float> mScaleBatchInputNetData;
+        std::vector<std::shared_ptr<ArrayCpuGpu<float>>> spScaleBatchBlobs;
+        // Tiled inference (overlapping tiles of mNetTileSize processed as a single batch and stitched)
+        const Point<int> mNetTileSize;
+        const float mNetTileOverlap;
+        Array<float> mTiledInputNetData;
+        std::vector<std::shared_ptr<ArrayCpuGpu<float>>> spTiledBlobs;
+        // Batched forward pass
+        int mBatchSize;
+        std::vector<Array<float>> mBatchInputNetData;
+        std::vector<std::shared_ptr<ArrayCpuGpu<float>>> spBatchElementBlobs;
+        // Copy of the batched network output, only with the top-down refinement (it runs the network again on the
+        // crops of each element, overwriting spCaffeNetOutputBlobs before the next elements are post-processed)
+        std::vector<std::shared_ptr<ArrayCpuGpu<float>>> spBatchNetOutputBlobs;
+        // Top-down refinement and ROI tracking (see refinePeopleOnRois()): Whole network input on the GPU (the crops
+        // are resized from it), CPU crops (if not CUDA), and network output of each crop
+        std::shared_ptr<ArrayCpuGpu<float>> spRoiFrameBlob;
+        Array<float> mRoiInputNetData;
+        std::shared_ptr<ArrayCpuGpu<float>> spRoiElementBlob;
+        // Pipelined forward pass: Copy of the network output of each frame not post-processed yet (-1 if it was
+        // not staged, i.e., postProcessPipelined() runs its whole forwardPass()), and its event
+        std::vector<std::vector<std::shared_ptr<ArrayCpuGpu<float>>>> spPipelinedBlobs;
+        std::vector<CUevent_st*> pPipelinedEvents;
+        std::vector<int> mPipelinedFreeSlots;
+        std::queue<int> mPipelinedSlots;
+        // Post-processing (resize and merge, NMS, body part connector) CUDA stream, it waits for the network output
+        CUstream_st* pCudaStream;
+        CUevent_st* pNetOutputEvent;
+        // If not nullptr, the next post-processing waits for it rather than for the current network output
+        CUevent_st* pStagedNetOutputEvent;
+        // Per-Datum timing (see DatumTiming): Events before and after the network forward pass and after the
+        // post-processing (created on the first timed frame)
+        std::vector<CUevent_st*> pGpuTimingEvents;
+        // Resize and merge and NMS replayed from CUDA Graphs
+        const bool mCudaGraphs;
+        // FP16 heat maps (spHeatMapsBlob is only filled, in FP32, if the heat maps are requested)
+        __half* pHeatMapsHalfGpuPtr;
+        // Fused resize and NMS (the body part channels are only upsampled if the heat maps are requested)
+        bool mFusedNms;
+        // Network resolution PAFs (the PAF channels are only upsampled if the heat maps are requested)
+        bool mPafLowResolution;
+        // Network output of the channels not upsampled yet (fused NMS or network resolution PAFs)
+        std::vector<ArrayCpuGpu<float>*> mLowResolutionNetOutputBlobs;
+        mutable bool mHeatMapsBlobUpdated;
+        // Single scale and channel-first network output of the last frame (see getNetOutputGpuConstPtr())
+        ArrayCpuGpu<float>* pSingleScaleNetOutputBlob;
+        // Network output cache (and the model part of its keys)
+        const std::shared_ptr<NetOutputCache> spNetOutputCache;
+        const std::string mNetOutputCacheModelKey;
+        std::vector<Array<float>> mNetOutputCacheArrays;
+        const std::shared_ptr<NetMemoryArena> spNetMemoryArena;
+        const int mNetStages;
+
+        void waitForNetOutputOnStream();
+
+        // It records the event eventIndex of pGpuTimingEvents on cudaStream (nullptr for the default stream)
+        void recordGpuTimingEvent(const unsigned int eventIndex, CUstream_st* const cudaStream);
+
+        // It fills mGpuTimingEvents from pGpuTimingEvents, once the post-processing finished
+        void finishGpuTiming();
+
+        // It fills the network output blobs of the numberScales scales from spNetOutputCache, returning false on a miss
+        bool readNetOutputCache(const std::string& key, const std::size_t numberScales);
+
+        void addNetOutputCache(const std::string& key, const std::size_t numberScales);
+
+        // It stacks all the scales of inputNetData (padded to the largest one) into a single network input, runs
+        // spNets[0] once, and crops the valid network output of each scale into spScaleBatchBlobs.
+        void forwardPassScaleBatch(const std::vector<Array<float>>& inputNetData);
+
+        // It splits inputNetData into overlapping tiles of mNetTileSize, runs them with a single forward pass of
+        // spNets[0], and stitches their network output into spTiledBlobs.
+        void forwardPassTiled(const Array<float>& inputNetData);
+
+        void updateHeatMapsBlob() const;
+
+        // It re-runs the network on a crop around each person of mPoseKeypoints (enlarged by roiEnlargement),
+        // replacing each person by the matching one of its crop. The crops share a squared size, so they are resized
+        // on the GPU (if CUDA) and run in batches of up to TOP_DOWN_MAX_BATCH_SIZE crops. In tracking mode,
+        // mPoseKeypoints are the ones of the previous frame, and the people not found again are removed. It returns the
+        // number of people found.
+        int refinePeopleOnRois(
+            const std::vector<Array<float>>& inputNetData, const std::vector<double>& scaleInputToNetInputs,
+            const float roiEnlargement, const bool trackingMode);
+
+        void postProcessNetOutput(
+            const std::vector<std::shared_ptr<ArrayCpuGpu<float>>>& netOutputBlobs,
+            const std::vector<Array<float>>& inputNetData, const Point<int>& inputDataSize,
+            const std::vector<double>& scaleInputToNetInputs);
 
         DELETE_COPY(PoseExtractorCaffe);
     };
@@ -2,7 +2,9 @@
 #define OPENPOSE_POSE_POSE_EXTRACTOR_NET_HPP
 
 #include <atomic>
+#include <functional>
 #include <openpose/core/common.hpp>
+#include <openpose/core/datumTiming.hpp>
 #include <openpose/core/enumClasses.hpp>
 #include <openpose/pose/poseParameters.hpp>
 
@@ -25,6 +27,60 @@ namespace op
             const std::vector<Array<float>>& inputNetData, const Point<int>& inputDataSize,
             const std::vector<double>& scaleRatios = {1.f}, const Array<float>& poseNetOutput = Array<float>{}) = 0;
 
+        /**
+         * Batched network forward pass. It runs the network once over all the elements of inputNetDatas (stacked
+         * along the network input batch axis), but it does not post-process them (resize and merge, NMS and body
+         * part connection). postProcessBatchElement() must be called afterwards for each element of the batch.
+         * The default implementation does nothing, so postProcessBatchElement() runs the whole forwardPass().
+         * @param inputNetDatas Each element is the inputNetData of 1 frame. All of them must share the same size.
+         */
+        virtual void forwardPassBatch(const std::vector<std::vector<Array<float>>>& inputNetDatas);
+
+        /**
+         * Post-process the element batchIndex of the last forwardPassBatch(). After it, the getters (e.g.,
+         * getPoseKeypoints() or getHeatMapsCopy()) return the results of that element.
+         */
+        virtual void postProcessBatchElement(
+            const int batchIndex, const std::vector<Array<float>>& inputNetData, const Point<int>& inputDataSize,
+            const std::vector<double>& scaleRatios = {1.f});
+
+        /**
+         * Pipelined network forward pass. It queues the network forward pass of inputNetData and keeps a copy of its
+         * output, but it does not post-process it. postProcessPipelined() must be called afterwards (in the same
+         * order) for each frame, so the post-processing of a frame can run while the network of the following one
+         * is still running on the GPU.
+         * The default implementation does nothing, so postProcessPipelined() runs the whole forwardPass().
+         */
+        virtual void forwardPassPipelined(const std::vector<Array<float>>& inputNetData);
+
+        /**
+         * Post-process the oldest frame of forwardPassPipelined() not post-processed yet. After it, the getters
+         * (e.g., getPoseKeypoints() or getHeatMapsCopy()) return the results of that frame.
+         */
+        virtual void postProcessPipelined(
+            const std::vector<Array<float>>& inputNetData, const Point<int>& inputDataSize,
+            const std::vector<double>& scaleRatios = {1.f});
+
+        /**
+         * It prepares the network(s) in advance for all the given network input sizes, so switching between them
+         * later on (e.g., see NetResolutionController) does not allocate memory during the processing. It must be
+         * called from the same thread than initializationOnThread(). The default implementation does nothing.
+         * @param netInputSizes Each element contains the network input size of each scale (as in
+         * Datum::netInputSizes) of 1 network resolution.
+         */
+        virtual void reserveNetInputSizes(const std::vector<std::vector<Point<int>>>& netInputSizes);
+
+        /**
+         * It runs the whole pipeline (network forward pass and post-processing) once on a blank input of each of the
+         * given network input sizes (after reserveNetInputSizes() for all of them), so the first frames of each size
+         * do not pay the one-time costs of a new network shape (e.g., memory allocation, convolution algorithm
+         * selection or kernel loading). It must be called from the same thread than initializationOnThread(), and
+         * before processing any frame.
+         * @param netInputSizes As in reserveNetInputSizes().
+         * @param batchSize If > 1, it warms up the batched forward pass (see forwardPassBatch()) instead.
+         */
+        void warmUp(const std::vector<std::vector<Point<int>>>& netInputSizes, const int batchSize = 1);
+
         virtual const float* getCandidatesCpuConstPtr() const = 0;
 
         virtual const float* getCandidatesGpuConstPtr() const = 0;
@@ -35,10 +91,55 @@ namespace op
 
         virtual std::vector<int> getHeatMapSize() const = 0;
 
+        /**
+         * Network output of the last frame (CUDA device pointer, single scale, channel-first, same channel order
+         * than getHeatMapGpuConstPtr()), only while the heat maps have not been upsampled for this frame (e.g., with
+         * fused NMS, network resolution PAFs or FP16 heat maps, in which getHeatMapGpuConstPtr() would upsample
+         * all their channels first). The GPU renderer draws the heat maps from it instead. Otherwise (default
+         * implementation), nullptr.
+         */
+        virtual const float* getNetOutputGpuConstPtr() const;
+
+        /**
+         * Size of getNetOutputGpuConstPtr() (as in getHeatMapSize()), or empty if it is nullptr.
+         */
+        virtual std::vector<int> getNetOutputSize() const;
+
+        /**
+         * It returns the requested heat maps (body parts, background and/or PAFs), scaled by heatMapScaleMode. With
+         * CUDA, they are gathered and scaled on the GPU, and downloaded at once into pinned memory (as 8-bit values
+         * with ScaleMode::UnsignedChar).
+         */
         Array<float> getHeatMapsCopy() const;
 
+        /**
+         * Lazy version of getHeatMapsCopy(). It only gathers and scales the requested heat maps into a device buffer
+         * (reused across frames), and the returned function downloads them into CPU memory the first time it is
+         * called (from any thread), releasing that buffer. Thus, frames whose heat maps are never read skip their
+         * GPU-to-CPU copy. See Datum::poseHeatMapsDownload.
+         * Only for CUDA, otherwise the returned function just returns the result of getHeatMapsCopy().
+         * @return An empty function if no heat map was requested.
+         */
+        std::function<Array<float>()> getHeatMapsDownload() const;
+
+        /**
+         * Sparse version of getHeatMapsCopy() (see Datum::poseHeatMapsSparse): Only the values whose absolute value is
+         * higher than threshold are kept, without any heatMapScaleMode scaling. With CUDA, they are thresholded and
+         * compacted on the GPU, so only the kept values are downloaded.
+         * @param heatMapsSparse Output, cleared for each call (and left empty if no heat map was requested).
+         */
+        void getHeatMapsSparse(SparseHeatMaps& heatMapsSparse, const float threshold) const;
+
         std::vector<std::vector<std::array<float,3>>> getCandidatesCopy() const;
 
+        /**
+         * Flat version of getCandidatesCopy() (see Datum::poseCandidatesArray), filled with a single allocation.
+         * @param candidates Output #candidates x 3 (x,y,score) Array, reset for each call.
+         * @param offsets Output first row of candidates of each body part, plus the total number of candidates as
+         * last element. Both outputs are left empty if the part candidates are disabled.
+         */
+        void getCandidates(Array<float>& candidates, std::vector<int>& offsets) const;
+
         virtual const float* getPoseGpuConstPtr() const = 0;
 
         Array<float> getPoseKeypoints() const;
@@ -47,6 +148,13 @@ namespace op
 
         float getScaleNetToOutput() const;
 
+        /**
+         * GPU time of the network forward pass and of the post-processing of the last forwardPass() (see
+         * DatumTiming), which are cleared by this call. Only filled while DatumTiming::isEnabled() (and only by
+         * the subclasses that measure them, e.g., PoseExtractorCaffe with CUDA).
+         */
+        std::vector<DatumTimingEvent> takeGpuTimingEvents();
+
         double get(const PoseProperty property) const;
 
         void set(const PoseProperty property, const double value);
@@ -61,6 +169,10 @@ namespace op
         Array<float> mPoseKeypoints;
         Array<float> mPoseScores;
         float mScaleNetToOutput;
+        // True while warmUp() runs (e.g., so its blank inputs are not added to any cache)
+        bool mWarmingUp;
+        // See takeGpuTimingEvents()
+        std::vector<DatumTimingEvent> mGpuTimingEvents;
 
         void checkThread() const;
 
@@ -72,6 +184,9 @@ namespace op
         const bool mAddPartCandidates;
         std::array<std::atomic<double>, (int)PoseProperty::Size> mProperties;
         std::thread::id mThreadId;
+        // Device buffers of getHeatMapsDownload() (only for CUDA)
+        struct HeatMapsDevicePool;
+        std::shared_ptr<HeatMapsDevicePool> spHeatMapsDevicePool;
 
         DELETE_COPY(PoseExtractorNet);
     };
@@ -0,0 +1,112 @@
+#ifndef OPENPOSE_POSE_POSE_EXTRACTOR_POOL_HPP
+#define OPENPOSE_POSE_POSE_EXTRACTOR_POOL_HPP
+
+#include <functional>
+#include <openpose/core/common.hpp>
+#include <openpose/pose/poseExtractorNet.hpp>
+
+namespace op
+{
+    /**
+     * Frame (or reservation) submitted to a PoseExtractorPool, and its results. See PoseExtractorShared.
+     */
+    struct OP_API PoseExtractorPoolRequest
+    {
+        // Input
+        /**
+         * If not empty, it only runs PoseExtractorNet::reserveNetInputSizes() with them (no forward pass).
+         */
+        std::vector<std::vector<Point<int>>> netInputSizes;
+        std::vector<Array<float>> inputNetData;
+        Point<int> inputDataSize;
+        std::vector<double> scaleInputToNetInputs;
+        Array<float> poseNetOutput;
+        /**
+         * Value of each PoseProperty of the pipeline, applied to the shared network before its forward pass.
+         */
+        std::vector<double> properties;
+        bool copyHeatMaps;
+        /**
+         * Number of values of the body part candidates to be copied (0 for none).
+         */
+        size_t candidatesVolume;
+
+        // Output
+        Array<float> poseKeypoints;
+        Array<float> poseScores;
+        float scaleNetToOutput;
+        std::vector<int> heatMapSize;
+        /**
+         * Copy of the whole heat map blob (heatMapSize), in device memory for CUDA (re-used across frames, and
+         * released by its owner) and in CPU memory otherwise.
+         */
+        float* heatMapsGpuPtr;
+        size_t heatMapsGpuVolume;
+        Array<float> heatMapsCpu;
+        /**
+         * Copy of PoseExtractorNet::getCandidatesCpuConstPtr() (candidatesVolume values).
+         */
+        std::vector<float> candidates;
+
+        PoseExtractorPoolRequest();
+    };
+
+    /**
+     * PoseExtractorPool runs a single body network (PoseExtractorNet) on its own thread on behalf of several
+     * pipelines (e.g., several Wrapper instances of the same process), so its weights and GPU memory are only loaded
+     * once per GPU. Each pipeline submits its frames through its own PoseExtractorShared, which keeps its own
+     * post-processing parameters (see PoseProperty), heat map types and part candidates. The pool serves the
+     * pipelines with frames waiting in round-robin order (1 frame each), so a pipeline with a high frame rate does
+     * not starve the other ones.
+     * The pools are process-wide: get() returns the existing one of the same key (e.g., same model and GPU) or
+     * creates it, and each pool is released with its last PoseExtractorShared. It is thread-safe.
+     */
+    class OP_API PoseExtractorPool
+    {
+    public:
+        /**
+         * It returns the pool of key, or it creates it with the network returned by netFactory (only called if no
+         * pool of key is alive). The key must identify everything that changes the output of the network (e.g., its
+         * model, GPU and options), since pipelines with the same key share it.
+         */
+        static std::shared_ptr<PoseExtractorPool> get(
+            const std::string& key, const std::function<std::shared_ptr<PoseExtractorNet>()>& netFactory);
+
+        explicit PoseExtractorPool(const std::shared_ptr<PoseExtractorNet>& poseExtractorNet);
+
+        virtual ~PoseExtractorPool();
+
+        /**
+         * It registers a new pipeline and returns its id. The first call starts the thread of the pool and waits
+         * until its network is initialized on it.
+         */
+        unsigned long long addClient();
+
+        /**
+         * It unregisters the pipeline clientId (its statistics are kept for getStatsString()).
+         */
+        void removeClient(const unsigned long long clientId);
+
+        /**
+         * It queues request and blocks until the thread of the pool has processed it.
+         */
+        void run(const unsigned long long clientId, PoseExtractorPoolRequest& request);
+
+        /**
+         * Human-readable summary of the frames processed and the average waiting time of each pipeline.
+         */
+        std::string getStatsString() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplPoseExtractorPool;
+        std::unique_ptr<ImplPoseExtractorPool> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(PoseExtractorPool);
+    };
+}
+
+#endif // OPENPOSE_POSE_POSE_EXTRACTOR_POOL_HPP
@@ -0,0 +1,68 @@
+#ifndef OPENPOSE_POSE_POSE_EXTRACTOR_SHARED_HPP
+#define OPENPOSE_POSE_POSE_EXTRACTOR_SHARED_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/pose/poseExtractorNet.hpp>
+#include <openpose/pose/poseExtractorPool.hpp>
+
+namespace op
+{
+    /**
+     * PoseExtractorShared is the PoseExtractorNet of a pipeline whose body network is shared with other pipelines of
+     * the same process (see PoseExtractorPool). Each forwardPass() is run by the thread of the pool with the
+     * PoseProperty values of this pipeline, and its results (and its heat maps and part candidates, if required) are
+     * copied back, so the getters and the renderers of the pipeline work as with its own network.
+     * The pose GPU pointer is not available. For CUDA, the heat maps are only available in GPU memory (as
+     * getHeatMapsCopy() and PoseGpuRenderer read them), and only in CPU memory otherwise.
+     */
+    class OP_API PoseExtractorShared : public PoseExtractorNet
+    {
+    public:
+        /**
+         * @param gpuId GPU of the pool (the same one of the pipeline).
+         * @param copyHeatMaps Whether the heat maps are copied after each frame. It is required by heatMapTypes and
+         * by the GPU rendering of the heat maps.
+         */
+        PoseExtractorShared(
+            const std::shared_ptr<PoseExtractorPool>& poseExtractorPool, const PoseModel poseModel, const int gpuId,
+            const std::vector<HeatMapType>& heatMapTypes = {},
+            const ScaleMode heatMapScaleMode = ScaleMode::ZeroToOneFixedAspect,
+            const bool addPartCandidates = false, const bool maximizePositives = false,
+            const bool copyHeatMaps = false);
+
+        virtual ~PoseExtractorShared();
+
+        virtual void netInitializationOnThread();
+
+        virtual void forwardPass(
+            const std::vector<Array<float>>& inputNetData, const Point<int>& inputDataSize,
+            const std::vector<double>& scaleInputToNetInputs = {1.f},
+            const Array<float>& poseNetOutput = Array<float>{});
+
+        virtual void reserveNetInputSizes(const std::vector<std::vector<Point<int>>>& netInputSizes);
+
+        const float* getCandidatesCpuConstPtr() const;
+
+        const float* getCandidatesGpuConstPtr() const;
+
+        const float* getHeatMapCpuConstPtr() const;
+
+        const float* getHeatMapGpuConstPtr() const;
+
+        std::vector<int> getHeatMapSize() const;
+
+        const float* getPoseGpuConstPtr() const;
+
+    private:
+        const std::shared_ptr<PoseExtractorPool> spPoseExtractorPool;
+        const int mGpuId;
+        bool mRegistered;
+        unsigned long long mClientId;
+        // Inputs and results of the last frame (re-used, e.g., its device heat maps)
+        PoseExtractorPoolRequest mRequest;
+
+        DELETE_COPY(PoseExtractorShared);
+    };
+}
+
+#endif // OPENPOSE_POSE_POSE_EXTRACTOR_SHARED_HPP
@@ -3,6 +3,7 @@
 
 #include <openpose/core/common.hpp>
 #include <openpose/core/gpuRenderer.hpp>
+#include <openpose/gpu/gpuMemoryBudget.hpp>
 #include <openpose/pose/enumClasses.hpp>
 #include <openpose/pose/poseExtractorNet.hpp>
 #include <openpose/pose/poseParameters.hpp>
@@ -28,6 +29,13 @@ namespace op
                                                const float scaleInputToOutput,
                                                const float scaleNetToOutput = -1.f);
 
+        /**
+         * Projected GPU memory (see gpuMemoryBudget.hpp) of each PoseGpuRenderer, including the face and hand GPU
+         * renderers sharing its GPU memory: the rendered frame (float BGR) and the keypoint buffers.
+         * @param outputSize Size of the rendered frames.
+         */
+        static GpuMemoryFootprint getGpuMemoryFootprint(const Point<int>& outputSize);
+
     private:
         const std::shared_ptr<PoseExtractorNet> spPoseExtractorNet;
         // Init with thread
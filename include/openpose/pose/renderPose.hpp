@@ -22,10 +22,12 @@ namespace op
         const float scaleToKeepRatio, const unsigned int part,
         const float alphaBlending = POSE_DEFAULT_ALPHA_HEAT_MAP);
 
+    // interpolate (also for renderPosePAFsGpu): Bilinear rather than nearest neighbor sampling of the channels, for
+    // heat maps at lower resolution than the frame (e.g., the network output)
     void renderPoseHeatMapsGpu(
         float* frame, const PoseModel poseModel, const Point<unsigned int>& frameSize, const float* const heatMapPtr,
         const Point<int>& heatMapSize, const float scaleToKeepRatio,
-        const float alphaBlending = POSE_DEFAULT_ALPHA_HEAT_MAP);
+        const float alphaBlending = POSE_DEFAULT_ALPHA_HEAT_MAP, const bool interpolate = false);
 
     void renderPosePAFGpu(
         float* framePtr, const PoseModel poseModel, const Point<unsigned int>& frameSize, const float* const heatMapPtr,
@@ -35,7 +37,7 @@ namespace op
     void renderPosePAFsGpu(
         float* framePtr, const PoseModel poseModel, const Point<unsigned int>& frameSize, const float* const heatMapPtr,
         const Point<int>& heatMapSize, const float scaleToKeepRatio,
-        const float alphaBlending = POSE_DEFAULT_ALPHA_HEAT_MAP);
+        const float alphaBlending = POSE_DEFAULT_ALPHA_HEAT_MAP, const bool interpolate = false);
 
     void renderPoseDistanceGpu(
         float* framePtr, const Point<unsigned int>& frameSize, const float* const heatMapPtr, const Point<int>& heatMapSize,
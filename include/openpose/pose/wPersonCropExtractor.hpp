@@ -0,0 +1,98 @@
+#ifndef OPENPOSE_POSE_W_PERSON_CROP_EXTRACTOR_HPP
+#define OPENPOSE_POSE_W_PERSON_CROP_EXTRACTOR_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/pose/personCropExtractor.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    template<typename TDatums>
+    class WPersonCropExtractor : public Worker<TDatums>
+    {
+    public:
+        explicit WPersonCropExtractor(const std::shared_ptr<PersonCropExtractor>& personCropExtractor);
+
+        virtual ~WPersonCropExtractor();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        std::shared_ptr<PersonCropExtractor> spPersonCropExtractor;
+
+        DELETE_COPY(WPersonCropExtractor);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WPersonCropExtractor<TDatums>::WPersonCropExtractor(
+        const std::shared_ptr<PersonCropExtractor>& personCropExtractor) :
+        spPersonCropExtractor{personCropExtractor}
+    {
+    }
+
+    template<typename TDatums>
+    WPersonCropExtractor<TDatums>::~WPersonCropExtractor()
+    {
+    }
+
+    template<typename TDatums>
+    void WPersonCropExtractor<TDatums>::initializationOnThread()
+    {
+        try
+        {
+            spPersonCropExtractor->initializationOnThread();
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void WPersonCropExtractor<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
+                // Person crops of each Datum
+                for (auto& tDatumPtr : *tDatums)
+                    spPersonCropExtractor->extract(
+                        tDatumPtr->personCropsGpu, tDatumPtr->personCrops, tDatumPtr->personCropMatrices,
+                        tDatumPtr->cvInputData, tDatumPtr->poseKeypoints);
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WPersonCropExtractor);
+}
+
+#endif // OPENPOSE_POSE_W_PERSON_CROP_EXTRACTOR_HPP
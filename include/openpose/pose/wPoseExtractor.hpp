@@ -1,9 +1,16 @@
 #ifndef OPENPOSE_POSE_W_POSE_EXTRACTOR_HPP
 #define OPENPOSE_POSE_W_POSE_EXTRACTOR_HPP
 
+#include <queue> // std::queue
 #include <openpose/core/common.hpp>
+#include <openpose/core/motionGate.hpp>
+#include <openpose/core/netResolutionController.hpp>
+#include <openpose/core/netWarmUp.hpp>
+#include <openpose/pose/adaptiveMultiScale.hpp>
 #include <openpose/pose/poseExtractor.hpp>
 #include <openpose/thread/worker.hpp>
+#include <openpose/utilities/keypoint.hpp>
+#include <openpose/utilities/profiler.hpp>
 
 namespace op
 {
@@ -11,7 +18,40 @@ namespace op
     class WPoseExtractor : public Worker<TDatums>
     {
     public:
-        explicit WPoseExtractor(const std::shared_ptr<PoseExtractor>& poseExtractorSharedPtr);
+        /**
+         * @param batchSize Maximum number of Datums stacked into a single network forward pass. If > 1, this
+         * worker buffers the incoming TDatums until either batchSize Datums are available or batchMaxWaitMicroseconds
+         * have passed since the oldest buffered one, and returns them one by one afterwards.
+         * @param netResolutionController Optional. If not nullptr, the networks are reshaped in advance for all its
+         * network resolutions (once they are known).
+         * @param motionGate Optional (only if batchSize = 1). If not nullptr, the frames that did not change since the
+         * last processed one skip the network and reuse its keypoints (see MotionGate and Datum::poseKeypointsReused).
+         * It must not be shared with other WPoseExtractor.
+         * @param pipelined Only if batchSize = 1 and motionGate is nullptr. If true, the network forward pass of each
+         * incoming TDatums is queued before post-processing (and returning) the previous one, so its post-processing
+         * runs while the GPU is busy with the network of the next frame (see PoseExtractor::forwardPassPipelined).
+         * It adds 1 frame of latency while the input queue is not empty (the pending frame is returned right away
+         * otherwise).
+         * @param heatMapsLazy If true, the heat maps (if any) are not downloaded, but left pending in
+         * Datum::poseHeatMapsDownload (see PoseExtractorNet::getHeatMapsDownload).
+         * @param netWarmUp Optional. If not nullptr, the network is warmed up (see PoseExtractorNet::warmUp) on the
+         * network input sizes of netWarmUp for netWarmUpKey right after initializationOnThread(), and the network
+         * input sizes of the processed frames are recorded into its cache.
+         * @param adaptiveMultiScale Optional (only if batchSize = 1 and pipelined = false). If not nullptr, the
+         * largest scale is run on the crops of the small or not confident people of each frame (see
+         * AdaptiveMultiScale). It must not be shared with other WPoseExtractor.
+         * @param heatMapsSparseThreshold If >= 0, the heat maps (if any) are filled into Datum::poseHeatMapsSparse
+         * with this threshold (see PoseExtractorNet::getHeatMapsSparse), rather than into Datum::poseHeatMaps.
+         */
+        explicit WPoseExtractor(const std::shared_ptr<PoseExtractor>& poseExtractorSharedPtr,
+                                const int batchSize = 1, const long long batchMaxWaitMicroseconds = 0ll,
+                                const std::shared_ptr<NetResolutionController>& netResolutionController = nullptr,
+                                const std::shared_ptr<MotionGate>& motionGate = nullptr,
+                                const bool pipelined = false, const bool heatMapsLazy = false,
+                                const std::shared_ptr<NetWarmUp>& netWarmUp = nullptr,
+                                const std::string& netWarmUpKey = "",
+                                const std::shared_ptr<AdaptiveMultiScale>& adaptiveMultiScale = nullptr,
+                                const float heatMapsSparseThreshold = -1.f);
 
         virtual ~WPoseExtractor();
 
@@ -19,8 +59,34 @@ namespace op
 
         void work(TDatums& tDatums);
 
+        void tryStop();
+
     private:
         std::shared_ptr<PoseExtractor> spPoseExtractor;
+        const unsigned int mBatchSize;
+        const double mBatchMaxWaitSeconds;
+        bool mStopWhenEmpty;
+        unsigned int mPendingDatums;
+        std::chrono::time_point<std::chrono::high_resolution_clock> mPendingTimerInit;
+        std::queue<TDatums> mPendingTDatums;
+        std::queue<TDatums> mProcessedTDatums;
+        const std::shared_ptr<NetResolutionController> spNetResolutionController;
+        bool mNetInputSizesReserved;
+        const std::shared_ptr<MotionGate> spMotionGate;
+        const bool mPipelined;
+        TDatums mPipelinedTDatums;
+        const bool mHeatMapsLazy;
+        const std::shared_ptr<NetWarmUp> spNetWarmUp;
+        const std::string mNetWarmUpKey;
+        std::vector<Point<int>> mLastNetInputSizes;
+        const std::shared_ptr<AdaptiveMultiScale> spAdaptiveMultiScale;
+        const float mHeatMapsSparseThreshold;
+
+        void reserveNetInputSizes();
+
+        void fillDatum(TDatums& tDatums, const unsigned long long index, const bool reused = false);
+
+        void processPendingBatch();
 
         DELETE_COPY(WPoseExtractor);
     };
@@ -32,12 +98,43 @@ namespace op
 
 // Implementation
 #include <openpose/utilities/pointerContainer.hpp>
+#include <openpose/utilities/standard.hpp>
 namespace op
 {
     template<typename TDatums>
-    WPoseExtractor<TDatums>::WPoseExtractor(const std::shared_ptr<PoseExtractor>& poseExtractorSharedPtr) :
-        spPoseExtractor{poseExtractorSharedPtr}
+    WPoseExtractor<TDatums>::WPoseExtractor(const std::shared_ptr<PoseExtractor>& poseExtractorSharedPtr,
+                                            const int batchSize, const long long batchMaxWaitMicroseconds,
+                                            const std::shared_ptr<NetResolutionController>& netResolutionController,
+                                            const std::shared_ptr<MotionGate>& motionGate,
+                                            const bool pipelined, const bool heatMapsLazy,
+                                            const std::shared_ptr<NetWarmUp>& netWarmUp,
+                                            const std::string& netWarmUpKey,
+                                            const std::shared_ptr<AdaptiveMultiScale>& adaptiveMultiScale,
+                                            const float heatMapsSparseThreshold) :
+        spPoseExtractor{poseExtractorSharedPtr},
+        mBatchSize{(unsigned int)(batchSize > 1 ? batchSize : 1)},
+        mBatchMaxWaitSeconds{batchMaxWaitMicroseconds > 0 ? batchMaxWaitMicroseconds * 1e-6 : 0.},
+        mStopWhenEmpty{false},
+        mPendingDatums{0u},
+        spNetResolutionController{netResolutionController},
+        mNetInputSizesReserved{false},
+        spMotionGate{motionGate},
+        mPipelined{pipelined && mBatchSize == 1u && motionGate == nullptr},
+        mHeatMapsLazy{heatMapsLazy},
+        spNetWarmUp{netWarmUp},
+        mNetWarmUpKey{netWarmUpKey},
+        spAdaptiveMultiScale{mBatchSize == 1u && !mPipelined ? adaptiveMultiScale : nullptr},
+        mHeatMapsSparseThreshold{heatMapsSparseThreshold}
     {
+        try
+        {
+            if (spNetWarmUp != nullptr)
+                spNetWarmUp->addWorker();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     template<typename TDatums>
@@ -51,6 +148,20 @@ namespace op
         try
         {
             spPoseExtractor->initializationOnThread();
+            // Warm-up before the first frame
+            if (spNetWarmUp != nullptr)
+            {
+                const auto netInputSizes = spNetWarmUp->getNetInputSizes(mNetWarmUpKey);
+                if (!netInputSizes.empty())
+                {
+                    const auto timerInit = getTimerInit();
+                    spPoseExtractor->warmUp(netInputSizes, mBatchSize);
+                    opLog("Pose network warmed up for " + std::to_string(netInputSizes.size())
+                          + " network input size(s) in " + std::to_string(int(getTimeSeconds(timerInit) * 1e3))
+                          + " ms.", Priority::High);
+                }
+                spNetWarmUp->setWarmedUp();
+            }
         }
         catch (const std::exception& e)
         {
@@ -63,35 +174,114 @@ namespace op
     {
         try
         {
-            if (checkNoNullNorEmpty(tDatums))
+            // Adaptive network resolution: Nets reshaped for all its resolutions in advance
+            if (!mNetInputSizesReserved && spNetResolutionController != nullptr)
+                reserveNetInputSizes();
+            // Batched mode
+            if (mBatchSize > 1u)
+            {
+                // Enqueue new TDatums
+                if (checkNoNullNorEmpty(tDatums))
+                {
+                    // Frames with a different net input size cannot be stacked together -> flush current batch
+                    if (!mPendingTDatums.empty()
+                        && !vectorsAreEqual(
+                            (*mPendingTDatums.front())[0]->inputNetData.at(0).getSize(),
+                            (*tDatums)[0]->inputNetData.at(0).getSize()))
+                        processPendingBatch();
+                    if (mPendingTDatums.empty())
+                        mPendingTimerInit = getTimerInit();
+                    mPendingDatums += (unsigned int)tDatums->size();
+                    mPendingTDatums.emplace(tDatums);
+                }
+                tDatums = nullptr;
+                // Run batch if full, if waited for too long, or if stopping
+                if (!mPendingTDatums.empty()
+                    && (mPendingDatums >= mBatchSize || mStopWhenEmpty
+                        || getTimeSeconds(mPendingTimerInit) >= mBatchMaxWaitSeconds))
+                    processPendingBatch();
+                // Return oldest processed TDatums
+                if (!mProcessedTDatums.empty())
+                {
+                    tDatums = mProcessedTDatums.front();
+                    mProcessedTDatums.pop();
+                }
+                // Close if all frames were returned
+                if (mStopWhenEmpty && mPendingTDatums.empty() && mProcessedTDatums.empty())
+                    this->stop();
+            }
+            // Pipelined mode
+            else if (mPipelined)
+            {
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
+                // Queue the OpenPose net forward pass of the new frame
+                auto previousTDatums = mPipelinedTDatums;
+                mPipelinedTDatums = nullptr;
+                if (checkNoNullNorEmpty(tDatums))
+                {
+                    for (const auto& tDatumPtr : *tDatums)
+                        spPoseExtractor->forwardPassPipelined(tDatumPtr->inputNetData);
+                    mPipelinedTDatums = tDatums;
+                }
+                // OpenPose keypoint detector of the previous frame (while the GPU runs the new one)
+                if (previousTDatums != nullptr)
+                {
+                    for (auto i = 0u ; i < previousTDatums->size() ; i++)
+                    {
+                        auto& tDatumPtr = (*previousTDatums)[i];
+                        const auto inputRoiRectangle = tDatumPtr->getInputRoiRectangle();
+                        spPoseExtractor->postProcessPipelined(
+                            tDatumPtr->inputNetData, Point<int>{inputRoiRectangle.width, inputRoiRectangle.height},
+                            tDatumPtr->scaleInputToNetInputs);
+                        fillDatum(previousTDatums, i);
+                    }
+                    // Profiling speed
+                    Profiler::timerEnd(profilerKey);
+                    Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                }
+                tDatums = previousTDatums;
+                // Close if all frames were returned
+                if (mStopWhenEmpty && mPipelinedTDatums == nullptr)
+                    this->stop();
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+            // Frame by frame mode
+            else if (checkNoNullNorEmpty(tDatums))
             {
                 // Debugging log
                 opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
-                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
                 // Extract people pose
                 for (auto i = 0u ; i < tDatums->size() ; i++)
                 // for (auto& tDatum : *tDatums)
                 {
                     auto& tDatumPtr = (*tDatums)[i];
-                    // OpenPose net forward pass
+                    // Motion gate: Unchanged frames reuse the keypoints of the last processed one
+                    if (spMotionGate != nullptr
+                        && spMotionGate->isStatic(tDatumPtr->cvInputData, tDatumPtr->inputDataGpu, i))
+                    {
+                        fillDatum(tDatums, i, true);
+                        continue;
+                    }
+                    // OpenPose net forward pass (on the bounding box of Datum::inputRoi, if any)
+                    const auto inputRoiRectangle = tDatumPtr->getInputRoiRectangle();
                     spPoseExtractor->forwardPass(
-                        tDatumPtr->inputNetData, Point<int>{tDatumPtr->cvInputData.cols(), tDatumPtr->cvInputData.rows()},
+                        tDatumPtr->inputNetData, Point<int>{inputRoiRectangle.width, inputRoiRectangle.height},
                         tDatumPtr->scaleInputToNetInputs, tDatumPtr->poseNetOutput, tDatumPtr->id);
+                    // GPU time of the network and of the post-processing (see DatumTiming)
+                    if (DatumTiming::isEnabled())
+                        for (const auto& gpuTimingEvent : spPoseExtractor->takeGpuTimingEvents())
+                            DatumTiming::get(tDatumPtr->timing).record(
+                                gpuTimingEvent.name, gpuTimingEvent.beginNs, gpuTimingEvent.endNs);
                     // OpenPose keypoint detector
-                    tDatumPtr->poseCandidates = spPoseExtractor->getCandidatesCopy();
-                    tDatumPtr->poseHeatMaps = spPoseExtractor->getHeatMapsCopy();
-                    tDatumPtr->poseKeypoints = spPoseExtractor->getPoseKeypoints().clone();
-                    tDatumPtr->poseScores = spPoseExtractor->getPoseScores().clone();
-                    tDatumPtr->scaleNetToOutput = spPoseExtractor->getScaleNetToOutput();
-                    // Keep desired top N people
-                    spPoseExtractor->keepTopPeople(tDatumPtr->poseKeypoints, tDatumPtr->poseScores);
-                    // ID extractor (experimental)
-                    tDatumPtr->poseIds = spPoseExtractor->extractIdsLockThread(
-                        tDatumPtr->poseKeypoints, tDatumPtr->cvInputData, i, tDatumPtr->id);
-                    // Tracking (experimental)
-                    spPoseExtractor->trackLockThread(
-                        tDatumPtr->poseKeypoints, tDatumPtr->poseIds, tDatumPtr->cvInputData, i, tDatumPtr->id);
+                    fillDatum(tDatums, i);
                 }
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
@@ -108,6 +298,155 @@ namespace op
         }
     }
 
+    template<typename TDatums>
+    void WPoseExtractor<TDatums>::tryStop()
+    {
+        try
+        {
+            // Close if all frames were retrieved from the batch and pipeline buffers
+            if (mPendingTDatums.empty() && mProcessedTDatums.empty() && mPipelinedTDatums == nullptr)
+                this->stop();
+            mStopWhenEmpty = true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void WPoseExtractor<TDatums>::reserveNetInputSizes()
+    {
+        try
+        {
+            // Empty until WScaleAndSizeExtractor receives the first frame
+            const auto netInputSizes = spNetResolutionController->getNetInputSizes();
+            if (!netInputSizes.empty())
+            {
+                spPoseExtractor->reserveNetInputSizes(netInputSizes);
+                mNetInputSizesReserved = true;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void WPoseExtractor<TDatums>::fillDatum(TDatums& tDatums, const unsigned long long index, const bool reused)
+    {
+        try
+        {
+            auto& tDatumPtr = (*tDatums)[index];
+            // Keypoints of the last processed frame (see MotionGate)
+            if (reused)
+                spMotionGate->getKeyframeResults(
+                    index, tDatumPtr->poseKeypoints, tDatumPtr->poseScores, tDatumPtr->scaleNetToOutput);
+            // OpenPose keypoint detector
+            else
+            {
+                spPoseExtractor->getCandidates(tDatumPtr->poseCandidatesArray, tDatumPtr->poseCandidatesOffsets);
+                if (mHeatMapsSparseThreshold >= 0.f)
+                    spPoseExtractor->getHeatMapsSparse(tDatumPtr->poseHeatMapsSparse, mHeatMapsSparseThreshold);
+                else if (mHeatMapsLazy)
+                    tDatumPtr->poseHeatMapsDownload = spPoseExtractor->getHeatMapsDownload();
+                else
+                    tDatumPtr->poseHeatMaps = spPoseExtractor->getHeatMapsCopy();
+                tDatumPtr->poseKeypoints = spPoseExtractor->getPoseKeypoints().clone();
+                tDatumPtr->poseScores = spPoseExtractor->getPoseScores().clone();
+                tDatumPtr->scaleNetToOutput = spPoseExtractor->getScaleNetToOutput();
+                // Static region of interest: From its bounding box into full-frame coordinates
+                if (!tDatumPtr->inputRoi.empty())
+                {
+                    const auto inputRoiRectangle = tDatumPtr->getInputRoiRectangle();
+                    offsetKeypoints2d(
+                        tDatumPtr->poseKeypoints, (float)inputRoiRectangle.x, (float)inputRoiRectangle.y);
+                    offsetKeypoints2d(
+                        tDatumPtr->poseCandidatesArray, (float)inputRoiRectangle.x, (float)inputRoiRectangle.y);
+                }
+                // Adaptive multi-scale: Largest scale only on the crops of the small or not confident people
+                if (spAdaptiveMultiScale != nullptr)
+                    spAdaptiveMultiScale->refine(
+                        *spPoseExtractor, tDatumPtr->poseKeypoints, tDatumPtr->poseScores, tDatumPtr->cvInputData,
+                        tDatumPtr->scaleInputToNetInputs, tDatumPtr->inputRoi, tDatumPtr->getInputRoiRectangle(),
+                        tDatumPtr->id);
+                // Keep desired top N people
+                spPoseExtractor->keepTopPeople(tDatumPtr->poseKeypoints, tDatumPtr->poseScores);
+                if (spMotionGate != nullptr)
+                    spMotionGate->setKeyframeResults(
+                        index, tDatumPtr->poseKeypoints, tDatumPtr->poseScores, tDatumPtr->scaleNetToOutput);
+                // Warm-up cache (only checked when the network input sizes change)
+                if (spNetWarmUp != nullptr && mLastNetInputSizes != tDatumPtr->netInputSizes)
+                {
+                    mLastNetInputSizes = tDatumPtr->netInputSizes;
+                    spNetWarmUp->addCachedNetInputSizes(mNetWarmUpKey, mLastNetInputSizes);
+                }
+            }
+            tDatumPtr->poseKeypointsReused = reused;
+            // ID extractor (experimental)
+            tDatumPtr->poseIds = spPoseExtractor->extractIdsLockThread(
+                tDatumPtr->poseKeypoints, tDatumPtr->cvInputData, index, tDatumPtr->id);
+            // Tracking (experimental)
+            spPoseExtractor->trackLockThread(
+                tDatumPtr->poseKeypoints, tDatumPtr->poseIds, tDatumPtr->cvInputData, index, tDatumPtr->id);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void WPoseExtractor<TDatums>::processPendingBatch()
+    {
+        try
+        {
+            // Debugging log
+            opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            // Profiling speed
+            static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+            const auto profilerKey = Profiler::timerInit(profilerTimerId);
+            // Network forward pass with all the pending Datums stacked together
+            std::vector<TDatums> batchTDatums;
+            std::vector<std::vector<Array<float>>> inputNetDatas;
+            while (!mPendingTDatums.empty())
+            {
+                batchTDatums.emplace_back(mPendingTDatums.front());
+                mPendingTDatums.pop();
+                for (const auto& tDatumPtr : *batchTDatums.back())
+                    inputNetDatas.emplace_back(tDatumPtr->inputNetData);
+            }
+            mPendingDatums = 0u;
+            spPoseExtractor->forwardPassBatch(inputNetDatas);
+            // Post-processing of each element of the batch
+            auto batchIndex = 0;
+            for (auto& tDatumsElement : batchTDatums)
+            {
+                for (auto i = 0u ; i < tDatumsElement->size() ; i++)
+                {
+                    auto& tDatumPtr = (*tDatumsElement)[i];
+                    const auto inputRoiRectangle = tDatumPtr->getInputRoiRectangle();
+                    spPoseExtractor->postProcessBatchElement(
+                        batchIndex++, tDatumPtr->inputNetData,
+                        Point<int>{inputRoiRectangle.width, inputRoiRectangle.height},
+                        tDatumPtr->scaleInputToNetInputs);
+                    fillDatum(tDatumsElement, i);
+                }
+                mProcessedTDatums.emplace(tDatumsElement);
+            }
+            // Profiling speed
+            Profiler::timerEnd(profilerKey);
+            Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+            // Debugging log
+            opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     COMPILE_TEMPLATE_DATUM(WPoseExtractor);
 }
 
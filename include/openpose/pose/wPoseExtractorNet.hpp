@@ -68,14 +68,15 @@ namespace op
                 // Debugging log
                 opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
-                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
                 // Extract people pose
                 for (auto& tDatumPtr : *tDatums)
                 {
                     spPoseExtractorNet->forwardPass(
-                        tDatumPtr->inputNetData, Point<int>{tDatumPtr->cvInputData.cols(), tDatumPtr->cvInputData.rows()},
+                        tDatumPtr->inputNetData, tDatumPtr->getInputSize(),
                         tDatumPtr->scaleInputToNetInputs, tDatumPtr->poseNetOutput);
-                    tDatumPtr->poseCandidates = spPoseExtractorNet->getCandidatesCopy();
+                    spPoseExtractorNet->getCandidates(tDatumPtr->poseCandidatesArray, tDatumPtr->poseCandidatesOffsets);
                     tDatumPtr->poseHeatMaps = spPoseExtractorNet->getHeatMapsCopy();
                     tDatumPtr->poseKeypoints = spPoseExtractorNet->getPoseKeypoints().clone();
                     tDatumPtr->poseScores = spPoseExtractorNet->getPoseScores().clone();
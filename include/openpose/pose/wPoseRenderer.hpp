@@ -2,6 +2,7 @@
 #define OPENPOSE_POSE_W_POSE_RENDERER_HPP
 
 #include <openpose/core/common.hpp>
+#include <openpose/core/gpuRenderer.hpp>
 #include <openpose/pose/poseRenderer.hpp>
 #include <openpose/thread/worker.hpp>
 
@@ -21,6 +22,8 @@ namespace op
 
     private:
         std::shared_ptr<PoseRenderer> spPoseRenderer;
+        // Same object than spPoseRenderer if it renders on the GPU, nullptr otherwise
+        GpuRenderer* const pGpuRenderer;
 
         DELETE_COPY(WPoseRenderer);
     };
@@ -36,7 +39,8 @@ namespace op
 {
     template<typename TDatums>
     WPoseRenderer<TDatums>::WPoseRenderer(const std::shared_ptr<PoseRenderer>& poseRendererSharedPtr) :
-        spPoseRenderer{poseRendererSharedPtr}
+        spPoseRenderer{poseRendererSharedPtr},
+        pGpuRenderer{dynamic_cast<GpuRenderer*>(poseRendererSharedPtr.get())}
     {
     }
 
@@ -68,12 +72,19 @@ namespace op
                 // Debugging log
                 opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
-                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                const auto profilerKey = Profiler::timerInit(profilerTimerId);
                 // Render people pose
                 for (auto& tDatumPtr : *tDatums)
+                {
+                    if (pGpuRenderer != nullptr)
+                        pGpuRenderer->setRenderTargetGpu(&tDatumPtr->outputDataGpu);
                     tDatumPtr->elementRendered = spPoseRenderer->renderPose(
                         tDatumPtr->outputData, tDatumPtr->poseKeypoints, (float)tDatumPtr->scaleInputToOutput,
                         (float)tDatumPtr->scaleNetToOutput);
+                }
+                if (pGpuRenderer != nullptr)
+                    pGpuRenderer->setRenderTargetGpu(nullptr);
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
                 Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
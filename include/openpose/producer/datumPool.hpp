@@ -0,0 +1,159 @@
+#ifndef OPENPOSE_PRODUCER_DATUM_POOL_HPP
+#define OPENPOSE_PRODUCER_DATUM_POOL_HPP
+
+#include <functional>
+#include <mutex>
+#include <openpose/core/common.hpp>
+#include <openpose/core/datum.hpp>
+
+namespace op
+{
+    /**
+     * It resets all the Datum members to their default (empty) values, but it keeps the memory already reserved by
+     * its std::string and std::vector members. Used by DatumPool before recycling a Datum.
+     */
+    OP_API void resetPooledDatum(Datum& datum);
+
+    /**
+     * DatumPool recycles the Datums of the previous frames, rather than allocating new ones for each frame.
+     * getDatum() returns a std::shared_ptr whose deleter does not delete the Datum, but it resets it (with
+     * resetFunction) and returns it to the pool once the last consumer releases it. At most maxNumberDatums free
+     * Datums are kept (and the rest are deleted), so it should be around the number of frames in flight in the
+     * pipeline (i.e., the queue sizes).
+     * The pool can be destroyed before the Datums it returned (they are then simply deleted). All the functions are
+     * thread-safe.
+     */
+    template<typename TDatum>
+    class DatumPool
+    {
+    public:
+        /**
+         * @param resetFunction Function called on each released Datum before it is recycled. If empty,
+         * resetPooledDatum() is used, which only resets the Datum members. Custom TDatum classes deriving from Datum
+         * should provide one that also resets their own members.
+         */
+        explicit DatumPool(
+            const unsigned long long maxNumberDatums = 64ull,
+            const std::function<void(TDatum&)>& resetFunction = nullptr);
+
+        virtual ~DatumPool();
+
+        /**
+         * It returns a recycled Datum (or a new one if none is free).
+         */
+        std::shared_ptr<TDatum> getDatum();
+
+        unsigned long long getNumberFreeDatums() const;
+
+    private:
+        struct FreeDatums
+        {
+            FreeDatums(const unsigned long long maxNumberDatums_, const std::function<void(TDatum&)>& resetFunction_) :
+                maxNumberDatums{maxNumberDatums_},
+                resetFunction{resetFunction_}
+            {
+            }
+
+            const unsigned long long maxNumberDatums;
+            const std::function<void(TDatum&)> resetFunction;
+            std::mutex mutex;
+            std::vector<std::unique_ptr<TDatum>> datums;
+        };
+        std::shared_ptr<FreeDatums> spFreeDatums;
+
+        DELETE_COPY(DatumPool);
+    };
+}
+
+
+
+
+
+// Implementation
+namespace op
+{
+    template<typename TDatum>
+    DatumPool<TDatum>::DatumPool(
+        const unsigned long long maxNumberDatums, const std::function<void(TDatum&)>& resetFunction) :
+        spFreeDatums{std::make_shared<FreeDatums>(
+            maxNumberDatums, (resetFunction ? resetFunction : [](TDatum& datum) { resetPooledDatum(datum); }))}
+    {
+        try
+        {
+            spFreeDatums->datums.reserve(maxNumberDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatum>
+    DatumPool<TDatum>::~DatumPool()
+    {
+    }
+
+    template<typename TDatum>
+    std::shared_ptr<TDatum> DatumPool<TDatum>::getDatum()
+    {
+        try
+        {
+            std::unique_ptr<TDatum> datum;
+            {
+                const std::lock_guard<std::mutex> lock{spFreeDatums->mutex};
+                if (!spFreeDatums->datums.empty())
+                {
+                    datum = std::move(spFreeDatums->datums.back());
+                    spFreeDatums->datums.pop_back();
+                }
+            }
+            if (datum == nullptr)
+                datum.reset(new TDatum{});
+            // The deleter returns it to the pool (if the pool still exists)
+            const std::weak_ptr<FreeDatums> freeDatumsWeakPtr = spFreeDatums;
+            return std::shared_ptr<TDatum>(datum.release(), [freeDatumsWeakPtr](TDatum* datumPtr)
+            {
+                try
+                {
+                    std::unique_ptr<TDatum> releasedDatum{datumPtr};
+                    const auto freeDatums = freeDatumsWeakPtr.lock();
+                    if (freeDatums != nullptr)
+                    {
+                        freeDatums->resetFunction(*releasedDatum);
+                        const std::lock_guard<std::mutex> lock{freeDatums->mutex};
+                        if (freeDatums->datums.size() < freeDatums->maxNumberDatums)
+                            freeDatums->datums.emplace_back(std::move(releasedDatum));
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            });
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    template<typename TDatum>
+    unsigned long long DatumPool<TDatum>::getNumberFreeDatums() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{spFreeDatums->mutex};
+            return spFreeDatums->datums.size();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    extern template class DatumPool<BASE_DATUM>;
+}
+
+#endif // OPENPOSE_PRODUCER_DATUM_POOL_HPP
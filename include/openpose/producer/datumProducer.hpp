@@ -6,6 +6,7 @@
 #include <openpose/core/common.hpp>
 #include <openpose/core/datum.hpp>
 #include <openpose/utilities/fastMath.hpp>
+#include <openpose/producer/datumPool.hpp>
 #include <openpose/producer/producer.hpp>
 
 namespace op
@@ -18,7 +19,9 @@ namespace op
             const std::shared_ptr<Producer>& producerSharedPtr,
             const unsigned long long frameFirst = 0, const unsigned long long frameStep = 1,
             const unsigned long long frameLast = std::numeric_limits<unsigned long long>::max(),
-            const std::shared_ptr<std::pair<std::atomic<bool>, std::atomic<int>>>& videoSeekSharedPtr = nullptr);
+            const std::shared_ptr<std::pair<std::atomic<bool>, std::atomic<int>>>& videoSeekSharedPtr = nullptr,
+            const std::shared_ptr<DatumPool<TDatum>>& datumPool = nullptr,
+            const DatumField datumFields = DatumField::All);
 
         virtual ~DatumProducer();
 
@@ -31,6 +34,12 @@ namespace op
         unsigned long long mFrameStep;
         unsigned int mNumberConsecutiveEmptyFrames;
         std::shared_ptr<std::pair<std::atomic<bool>, std::atomic<int>>> spVideoSeek;
+        // If not nullptr, the Datums are recycled rather than allocated for each frame
+        const std::shared_ptr<DatumPool<TDatum>> spDatumPool;
+        // Field manifest of the pipeline (see getDatumFields()), stamped into each Datum
+        const DatumField mDatumFields;
+
+        std::shared_ptr<TDatum> getNewDatum() const;
 
         void checkIfTooManyConsecutiveEmptyFrames(
             unsigned int& numberConsecutiveEmptyFrames, const bool emptyFrame) const;
@@ -69,14 +78,17 @@ namespace op
         const std::shared_ptr<Producer>& producerSharedPtr,
         const unsigned long long frameFirst, const unsigned long long frameStep,
         const unsigned long long frameLast,
-        const std::shared_ptr<std::pair<std::atomic<bool>, std::atomic<int>>>& videoSeekSharedPtr) :
+        const std::shared_ptr<std::pair<std::atomic<bool>, std::atomic<int>>>& videoSeekSharedPtr,
+        const std::shared_ptr<DatumPool<TDatum>>& datumPool, const DatumField datumFields) :
         mNumberFramesToProcess{(frameLast != std::numeric_limits<unsigned long long>::max()
                                 ? frameLast - frameFirst : frameLast)},
         spProducer{producerSharedPtr},
         mGlobalCounter{0ll},
         mFrameStep{frameStep},
         mNumberConsecutiveEmptyFrames{0u},
-        spVideoSeek{videoSeekSharedPtr}
+        spVideoSeek{videoSeekSharedPtr},
+        spDatumPool{datumPool},
+        mDatumFields{datumFields}
     {
         try
         {
@@ -112,31 +124,51 @@ namespace op
                 const unsigned long long nextFrameNumber = datumProducerConstructorRunningAndGetNextFrameNumber(
                     spProducer);
                 const std::vector<Matrix> matrices = spProducer->getFrames();
+                // Frames in GPU memory (if the producer decodes into GPU memory, e.g., NvDecReader)
+                const std::vector<FrameGpu> framesGpu = spProducer->getLastFramesGpu();
+                // Leases of the frames wrapping memory owned by the producer (e.g., SharedMemoryReader)
+                const std::vector<std::shared_ptr<void>> frameLeases = spProducer->getLastFrameLeases();
                 // Check frames are not empty
                 checkIfTooManyConsecutiveEmptyFrames(
-                    mNumberConsecutiveEmptyFrames, matrices.empty() || matrices[0].empty());
+                    mNumberConsecutiveEmptyFrames,
+                    matrices.empty() || (matrices[0].empty() && (framesGpu.empty() || framesGpu[0].empty())));
                 if (!matrices.empty())
                 {
                     // Get camera parameters
                     const std::vector<Matrix> cameraMatrices = spProducer->getCameraMatrices();
                     const std::vector<Matrix> cameraExtrinsics = spProducer->getCameraExtrinsics();
                     const std::vector<Matrix> cameraIntrinsics = spProducer->getCameraIntrinsics();
+                    const std::vector<Matrix> cameraDistortions = spProducer->getCameraDistortions();
+                    // Static regions of interest (a single one is applied to all the views)
+                    const auto inputRois = spProducer->getInputRois();
                     // Resize datum
                     datums->resize(matrices.size());
                     // Datum cannot be assigned before resize()
                     auto& datumPtr = (*datums)[0];
-                    datumPtr = std::make_shared<TDatum>();
+                    datumPtr = getNewDatum();
                     // Filling first element
                     std::swap(datumPtr->name, nextFrameName);
                     datumPtr->frameNumber = nextFrameNumber;
+                    datumPtr->sourceId = spProducer->getLastSourceId();
+                    datumPtr->sourceIdMax = spProducer->getNumberSources() - 1;
+                    datumPtr->priority = spProducer->getLastPriority();
+                    datumPtr->deadline = spProducer->getLastDeadline();
                     datumPtr->cvInputData = matrices[0];
                     datumProducerConstructorRunningAndGetDatumFrameIntegrity(datumPtr->cvInputData);
-                    if (!cameraMatrices.empty())
+                    if (!framesGpu.empty())
+                        datumPtr->inputDataGpu = framesGpu[0];
+                    if (!frameLeases.empty())
+                        datumPtr->inputDataLease = frameLeases[0];
+                    if (!cameraMatrices.empty() && datumPtr->hasField(DatumField::CameraParameters))
                     {
                         datumPtr->cameraMatrix = cameraMatrices[0];
                         datumPtr->cameraExtrinsics = cameraExtrinsics[0];
                         datumPtr->cameraIntrinsics = cameraIntrinsics[0];
+                        if (!cameraDistortions.empty())
+                            datumPtr->cameraDistortion = cameraDistortions[0];
                     }
+                    if (!inputRois.empty())
+                        datumPtr->inputRoi = inputRois[0];
                     // Initially, cvOutputData = cvInputData. No performance hit (both cv::Mat share raw memory)
                     datumPtr->cvOutputData = datumPtr->cvInputData;
                     // Resize if it's stereo-system
@@ -146,22 +178,34 @@ namespace op
                         for (auto i = 1u ; i < datums->size() ; i++)
                         {
                             auto& datumIPtr = (*datums)[i];
-                            datumIPtr = std::make_shared<TDatum>();
+                            datumIPtr = getNewDatum();
                             datumIPtr->name = datumPtr->name;
                             datumIPtr->frameNumber = datumPtr->frameNumber;
+                            datumIPtr->sourceId = datumPtr->sourceId;
+                            datumIPtr->sourceIdMax = datumPtr->sourceIdMax;
+                            datumIPtr->priority = datumPtr->priority;
+                            datumIPtr->deadline = datumPtr->deadline;
                             datumIPtr->cvInputData = matrices[i];
                             datumProducerConstructorRunningAndGetDatumFrameIntegrity(datumPtr->cvInputData);
                             datumIPtr->cvOutputData = datumIPtr->cvInputData;
-                            if (cameraMatrices.size() > i)
+                            if (framesGpu.size() > i)
+                                datumIPtr->inputDataGpu = framesGpu[i];
+                            if (frameLeases.size() > i)
+                                datumIPtr->inputDataLease = frameLeases[i];
+                            if (cameraMatrices.size() > i && datumIPtr->hasField(DatumField::CameraParameters))
                             {
                                 datumIPtr->cameraMatrix = cameraMatrices[i];
                                 datumIPtr->cameraExtrinsics = cameraExtrinsics[i];
                                 datumIPtr->cameraIntrinsics = cameraIntrinsics[i];
+                                if (cameraDistortions.size() > i)
+                                    datumIPtr->cameraDistortion = cameraDistortions[i];
                             }
+                            if (inputRois.size() == 1u || inputRois.size() > i)
+                                datumIPtr->inputRoi = inputRois[(inputRois.size() > i ? i : 0u)];
                         }
                     }
                     // Check producer is running
-                    if ((*datums)[0]->cvInputData.empty())
+                    if ((*datums)[0]->cvInputData.empty() && (*datums)[0]->inputDataGpu.empty())
                         datums = nullptr;
                     // Increase counter if successful image
                     if (datums != nullptr)
@@ -178,6 +222,14 @@ namespace op
         }
     }
 
+    template<typename TDatum>
+    std::shared_ptr<TDatum> DatumProducer<TDatum>::getNewDatum() const
+    {
+        auto datumPtr = (spDatumPool != nullptr ? spDatumPool->getDatum() : std::make_shared<TDatum>());
+        datumPtr->fields = mDatumFields;
+        return datumPtr;
+    }
+
     template<typename TDatum>
     void DatumProducer<TDatum>::checkIfTooManyConsecutiveEmptyFrames(
         unsigned int& numberConsecutiveEmptyFrames, const bool emptyFrame) const
@@ -40,6 +40,10 @@ namespace op
         Video,
         /** A webcam frames extractor, extending the functionality of cv::VideoCapture. */
         Webcam,
+        /** A replay of the frames recorded by InputRecorder (see ReplayReader). */
+        Replay,
+        /** A shared memory frame ring buffer written by another process (see SharedMemoryReader). */
+        SharedMemory,
         /** No type defined. Default state when no specific Producer has been picked yet. */
         None,
     };
@@ -17,18 +17,28 @@ namespace op
     public:
         /**
          * Constructor of FlirReader. It opens all the available FLIR cameras
+         * If bayerGpuId >= 0, the raw Bayer images are uploaded into that GPU (see SpinnakerWrapper and
+         * getLastFramesGpu()), and the CPU frames are only filled if downloadFrames is true.
+         * syncToleranceMs is the maximum timestamp difference among the images of the same frame set.
          */
         explicit FlirReader(const std::string& cameraParametersPath, const Point<int>& cameraResolution,
-                            const bool undistortImage = true, const int cameraIndex = -1);
+                            const bool undistortImage = true, const int cameraIndex = -1, const int bayerGpuId = -1,
+                            const bool downloadFrames = true, const double syncToleranceMs = 5.);
 
         virtual ~FlirReader();
 
+        std::vector<FrameGpu> getLastFramesGpu();
+
         std::vector<Matrix> getCameraMatrices();
 
         std::vector<Matrix> getCameraExtrinsics();
 
         std::vector<Matrix> getCameraIntrinsics();
 
+        std::vector<Matrix> getCameraDistortions();
+
+        void setUndistortKeypoints(const bool undistortKeypoints);
+
         std::string getNextFrameName();
 
         bool isOpened() const;
@@ -0,0 +1,62 @@
+#ifndef OPENPOSE_PRODUCER_FRAME_RING_FORMAT_HPP
+#define OPENPOSE_PRODUCER_FRAME_RING_FORMAT_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace op
+{
+    // Layout of the shared memory frame ring buffer read by SharedMemoryReader (`--shm_input`).
+    // It has no OpenPose dependencies, so the writer process (e.g., a capture or decoding service) can include it
+    // directly. All the values are in the native (little-endian) byte order, and every block is padded to 8 bytes.
+    // Shared memory: FrameRingHeader + numberSlots x (FrameRingSlotHeader + slotBytes). The writer process creates it
+    // (and fills its header) before OpenPose attaches to it.
+    // Protocol (single writer, single reader): frame s (s = 0, 1, ...) goes into the slot s % numberSlots.
+    //     Writer: It waits until releaseSequence + numberSlots > s (i.e., OpenPose released frame s - numberSlots),
+    //             fills the slot payload and header, and then stores sequence = s + 1 into the slot header and
+    //             writeSequence = s + 1 into the ring header (both with release semantics).
+    //     Reader: It waits until writeSequence > s, reads the slot in place (no copies), and stores
+    //             releaseSequence = s + 1 once it is done with all the frames up to s. It starts from
+    //             releaseSequence, so OpenPose can be restarted without restarting the writer.
+    // slotBytes must be a multiple of 8.
+    const auto FRAME_RING_MAGIC = 0x474e5246u; // "FRNG"
+    const auto FRAME_RING_VERSION = 1u;
+
+    enum class FrameRingFormat : uint32_t
+    {
+        Bgr = 0, // 8-bit interleaved BGR, height rows of step bytes
+        Nv12, // 8-bit Y plane (height rows of step bytes) followed by the interleaved UV plane (height/2 rows)
+    };
+
+    struct FrameRingHeader
+    {
+        uint32_t magic;
+        uint32_t version; // FRAME_RING_VERSION
+        uint32_t numberSlots;
+        std::atomic<uint32_t> writerClosed; // 1 once the writer will not write any more frames
+        uint64_t slotBytes; // Maximum payload size of each slot
+        std::atomic<uint64_t> writeSequence; // Number of frames written so far
+        std::atomic<uint64_t> releaseSequence; // Number of frames released so far (by the reader)
+    };
+
+    struct FrameRingSlotHeader
+    {
+        std::atomic<uint64_t> sequence; // Frame sequence + 1, 0 if never written
+        uint64_t timestampUs; // Capture time, in microseconds (any clock monotonic for the writer)
+        uint64_t payloadBytes;
+        uint32_t width;
+        uint32_t height;
+        uint32_t step; // Bytes per row (of the Y plane for FrameRingFormat::Nv12)
+        uint32_t format; // FrameRingFormat
+    };
+
+    static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "The shared memory ring buffer requires lock-free 64-bit atomics.");
+
+    // Offset of the slotIndex-th slot header (or the size of the whole ring buffer if slotIndex = numberSlots)
+    inline uint64_t getFrameRingSlotOffset(const uint32_t slotIndex, const uint64_t slotBytes)
+    {
+        return sizeof(FrameRingHeader) + (uint64_t)slotIndex * (sizeof(FrameRingSlotHeader) + slotBytes);
+    }
+}
+
+#endif // OPENPOSE_PRODUCER_FRAME_RING_FORMAT_HPP
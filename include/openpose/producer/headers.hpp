@@ -2,13 +2,21 @@
 #define OPENPOSE_PRODUCER_HEADERS_HPP
 
 // producer module
+#include <openpose/producer/datumPool.hpp>
 #include <openpose/producer/datumProducer.hpp>
 #include <openpose/producer/enumClasses.hpp>
 #include <openpose/producer/flirReader.hpp>
+#include <openpose/producer/frameRingFormat.hpp>
 #include <openpose/producer/imageDirectoryReader.hpp>
+#include <openpose/producer/inputRecorder.hpp>
 #include <openpose/producer/ipCameraReader.hpp>
+#include <openpose/producer/multiSourceProducer.hpp>
+#include <openpose/producer/nvDecReader.hpp>
 #include <openpose/producer/producer.hpp>
+#include <openpose/producer/replayReader.hpp>
+#include <openpose/producer/sharedMemoryReader.hpp>
 #include <openpose/producer/spinnakerWrapper.hpp>
+#include <openpose/producer/v4l2Reader.hpp>
 #include <openpose/producer/videoCaptureReader.hpp>
 #include <openpose/producer/videoReader.hpp>
 #include <openpose/producer/webcamReader.hpp>
@@ -22,10 +22,18 @@ namespace op
          * parameters (only required if imageDirectorystereo > 1).
          * @param numberViews const int parameter with the number of images per iteration (>1 would represent
          * stereo processing).
+         * @param numberDecodingThreads const int parameter with the number of threads decoding the next images in
+         * parallel (look-ahead of 2 images per thread), while they are returned in their original order. 0 to load
+         * each image synchronously when it is requested.
+         * @param streamFiles const bool parameter. If true, the directory is listed in a background thread and the
+         * images are returned as soon as they are listed (in file system order, i.e., unsorted), so huge directories
+         * can be processed without waiting for the whole list. Otherwise, the images are returned in natural order
+         * once the whole directory has been listed and sorted.
          */
         explicit ImageDirectoryReader(
             const std::string& imageDirectoryPath, const std::string& cameraParameterPath = "",
-            const bool undistortImage = false, const int numberViews = -1);
+            const bool undistortImage = false, const int numberViews = -1, const int numberDecodingThreads = 0,
+            const bool streamFiles = false);
 
         virtual ~ImageDirectoryReader();
 
@@ -36,10 +44,7 @@ namespace op
             return (mFrameNameCounter >= 0);
         }
 
-        inline void release()
-        {
-            mFrameNameCounter = {-1ll};
-        }
+        void release();
 
         double get(const int capProperty);
 
@@ -47,9 +52,15 @@ namespace op
 
     private:
         const std::string mImageDirectoryPath;
-        const std::vector<std::string> mFilePaths;
         Point<int> mResolution;
         long long mFrameNameCounter;
+        // Image paths (listed in a background thread if streaming)
+        struct ImageDirectoryListing;
+        std::unique_ptr<ImageDirectoryListing> upListing;
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplImageDirectoryReader;
+        std::unique_ptr<ImplImageDirectoryReader> upImpl;
 
         Matrix getRawFrame();
 
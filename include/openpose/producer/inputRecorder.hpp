@@ -0,0 +1,50 @@
+#ifndef OPENPOSE_PRODUCER_INPUT_RECORDER_HPP
+#define OPENPOSE_PRODUCER_INPUT_RECORDER_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * InputRecorder saves the frames that enter the OpenPose pipeline (i.e., the output of the producer, see
+     * WDatumProducer) into a single chunked file, so the same input stream can later be re-run deterministically with
+     * ReplayReader (e.g., to reproduce a performance regression of a live camera). Each chunk contains the compressed
+     * frame of each view, its arrival time, name, frameNumber, source IDs, and camera parameters.
+     * The frames are copied on the calling thread, but compressed and written on a background thread, so the producer
+     * is not slowed down by the encoding.
+     */
+    class OP_API InputRecorder
+    {
+    public:
+        /**
+         * @param filePath Path of the recording (it is overwritten if it exists).
+         * @param imageFormat Compression of the frames, any format supported by cv::imencode (e.g., "jpg" or the
+         * lossless "png").
+         */
+        explicit InputRecorder(const std::string& filePath, const std::string& imageFormat = "jpg");
+
+        virtual ~InputRecorder();
+
+        /**
+         * It records the frames of a frame set (1 per view) with the current time as arrival time. All the camera
+         * parameter vectors can be empty.
+         */
+        void record(
+            const std::string& frameName, const unsigned long long frameNumber, const unsigned long long sourceId,
+            const unsigned long long sourceIdMax, const std::vector<Matrix>& frames,
+            const std::vector<Matrix>& cameraMatrices, const std::vector<Matrix>& cameraExtrinsics,
+            const std::vector<Matrix>& cameraIntrinsics, const std::vector<Matrix>& cameraDistortions);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplInputRecorder;
+        std::unique_ptr<ImplInputRecorder> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(InputRecorder);
+    };
+}
+
+#endif // OPENPOSE_PRODUCER_INPUT_RECORDER_HPP
@@ -2,18 +2,62 @@
 #define OPENPOSE_PRODUCER_IP_CAMERA_READER_HPP
 
 #include <openpose/core/common.hpp>
-#include <openpose/producer/videoCaptureReader.hpp>
+#include <openpose/producer/producer.hpp>
 
 namespace op
 {
     /**
-     * IpCameraReader is a wrapper of the cv::VideoCapture class for IP camera streaming.
+     * Reception statistics of an IpCameraReader.
      */
-    class OP_API IpCameraReader : public VideoCaptureReader
+    struct OP_API IpCameraStats
+    {
+        /**
+         * Number of frames decoded by the receiving thread.
+         */
+        unsigned long long framesReceived;
+
+        /**
+         * Number of frames decoded but replaced by a newer one before being retrieved (only the latest one is kept).
+         */
+        unsigned long long framesDropped;
+
+        /**
+         * Number of times the stream was lost (and re-opened in the background).
+         */
+        unsigned long long reconnections;
+
+        /**
+         * Average time between consecutive received frames (in milliseconds, exponential moving average).
+         */
+        double intervalMs;
+
+        /**
+         * Jitter of the time between consecutive received frames (in milliseconds, RFC 3550 mean deviation).
+         */
+        double jitterMs;
+
+        /**
+         * Whether the stream is currently opened (false while reconnecting).
+         */
+        bool connected;
+    };
+
+    /**
+     * IpCameraReader is a wrapper of the cv::VideoCapture class for IP camera streaming (e.g., RTSP or HTTP).
+     * The stream is received and decoded by its own thread, which only keeps the latest decoded frame, so the
+     * latency is not increased by the buffering of the stream (nor the older frames processed) if OpenPose is slower
+     * than the camera. Unless the `OPENCV_FFMPEG_CAPTURE_OPTIONS` environment variable is already set, the FFmpeg
+     * low-latency options are used (RTSP over TCP, no input buffering, and a socket timeout so a stalled camera is
+     * detected). If the stream is lost, it is re-opened in the background (with an increasing delay), while
+     * getFrames() keeps returning a "reconnecting" black frame once per second, so the pipeline is never stopped nor
+     * blocked.
+     */
+    class OP_API IpCameraReader : public Producer
     {
     public:
         /**
-         * Constructor of IpCameraReader. It opens the IP camera as a wrapper of cv::VideoCapture.
+         * Constructor of IpCameraReader. It opens the IP camera as a wrapper of cv::VideoCapture and starts its
+         * receiving thread.
          * @param cameraPath const std::string parameter with the full camera IP link.
          */
         explicit IpCameraReader(const std::string& cameraPath, const std::string& cameraParameterPath = "",
@@ -23,23 +67,24 @@ namespace op
 
         std::string getNextFrameName();
 
-        inline bool isOpened() const
-        {
-            return VideoCaptureReader::isOpened();
-        }
+        /**
+         * It returns the reception statistics (thread-safe).
+         */
+        IpCameraStats getStats() const;
+
+        bool isOpened() const;
+
+        void release();
 
-        inline double get(const int capProperty)
-        {
-            return VideoCaptureReader::get(capProperty);
-        }
+        double get(const int capProperty);
 
-        inline void set(const int capProperty, const double value)
-        {
-            VideoCaptureReader::set(capProperty, value);
-        }
+        void set(const int capProperty, const double value);
 
     private:
-        const std::string mPathName;
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplIpCameraReader;
+        std::unique_ptr<ImplIpCameraReader> upImpl;
 
         Matrix getRawFrame();
 
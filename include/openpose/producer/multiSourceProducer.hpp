@@ -0,0 +1,112 @@
+#ifndef OPENPOSE_PRODUCER_MULTI_SOURCE_PRODUCER_HPP
+#define OPENPOSE_PRODUCER_MULTI_SOURCE_PRODUCER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/producer/producer.hpp>
+
+namespace op
+{
+    /**
+     * MultiSourceProducer multiplexes several Producer instances (e.g., several IP cameras or videos) into a single
+     * one, so a single OpenPose pipeline (and a single copy of the network models) processes all of them.
+     * Each source is read by its own thread into a small buffer, and the frames are returned in round-robin order
+     * across the sources (skipping the ones with no frame available yet). getLastSourceId() returns the source index
+     * of the last frame (DatumProducer stores it in Datum::sourceId), so the savers can split their output per source.
+     * Frame names are prefixed with `source<index>_` so they are unique across sources.
+     * The frames of live sources (webcam and IP cameras) are dropped (oldest first) when their buffer is full, so
+     * the latest frame of each camera is always the one processed. Recorded sources (videos) wait instead, so no
+     * frame is lost.
+     * With setSourceSchedule(), the sources of a higher priority class are served first (round-robin within each
+     * class, so the lower ones fill the idle cycles), and the frames waiting longer than the maximum latency of
+     * their source are dropped rather than processed late.
+     * With setSourceBatching(), the frames are grouped instead: once every source has a frame (or has finished),
+     * the oldest frame of each source is returned, in source order, before any later frame. So consecutive Datums
+     * (e.g., the ones of a batched forward pass with `--batch_size` equal to the number of sources) hold the same
+     * moment of all the sources. A live source that stops sending frames (without closing) stalls all of them.
+     */
+    class OP_API MultiSourceProducer : public Producer
+    {
+    public:
+        /**
+         * Constructor of MultiSourceProducer.
+         * @param producers std::vector<std::shared_ptr<Producer>> with the sources, all of them of the same
+         * ProducerType (ImageDirectory and FlirCamera are not supported) and with a single view.
+         * @param bufferSize const unsigned int parameter with the maximum number of frames buffered per source.
+         */
+        explicit MultiSourceProducer(
+            const std::vector<std::shared_ptr<Producer>>& producers, const unsigned int bufferSize = 2u);
+
+        virtual ~MultiSourceProducer();
+
+        std::vector<Matrix> getCameraMatrices();
+
+        std::vector<Matrix> getCameraExtrinsics();
+
+        std::vector<Matrix> getCameraIntrinsics();
+
+        std::vector<Matrix> getCameraDistortions();
+
+        void setUndistortKeypoints(const bool undistortKeypoints);
+
+        /**
+         * With one region per source in setInputRois(), each source gets its own one. Otherwise, the ones of
+         * setInputRois() or, if empty, the ones of the current source.
+         */
+        std::vector<std::vector<Point<int>>> getInputRois();
+
+        std::vector<FrameGpu> getLastFramesGpu();
+
+        unsigned long long getLastSourceId();
+
+        int getLastPriority();
+
+        std::chrono::steady_clock::time_point getLastDeadline();
+
+        /**
+         * It sets the scheduling of the sources. It must be called before the first frame.
+         * @param priorities Priority class of each source (higher first, see Datum::priority), or empty for 0 in all
+         * of them.
+         * @param maxLatenciesMs Maximum time (in milliseconds) each frame of each source can wait in its buffer before
+         * being dropped (see Datum::deadline), or empty. 0 or negative for no limit.
+         */
+        void setSourceSchedule(const std::vector<int>& priorities, const std::vector<double>& maxLatenciesMs);
+
+        /**
+         * It enables (or disables) the batch mode, which groups 1 frame of each source (see the class description)
+         * rather than interleaving them in round-robin order. The priority classes of setSourceSchedule() are ignored
+         * in this mode (the maximum latencies still apply). It must be called before the first frame.
+         */
+        void setSourceBatching(const bool batchSources);
+
+        /**
+         * Number of frames dropped so far because they exceeded the maximum latency of their source.
+         */
+        unsigned long long getNumberExpired() const;
+
+        unsigned long long getNumberSources();
+
+        std::string getNextFrameName();
+
+        bool isOpened() const;
+
+        void release();
+
+        double get(const int capProperty);
+
+        void set(const int capProperty, const double value);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplMultiSourceProducer;
+        std::unique_ptr<ImplMultiSourceProducer> upImpl;
+
+        Matrix getRawFrame();
+
+        std::vector<Matrix> getRawFrames();
+
+        DELETE_COPY(MultiSourceProducer);
+    };
+}
+
+#endif // OPENPOSE_PRODUCER_MULTI_SOURCE_PRODUCER_HPP
@@ -0,0 +1,65 @@
+#ifndef OPENPOSE_PRODUCER_NVDEC_READER_HPP
+#define OPENPOSE_PRODUCER_NVDEC_READER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/producer/producer.hpp>
+
+namespace op
+{
+    /**
+     * NvDecReader is a video Producer (ProducerType::Video) that decodes with the NVIDIA hardware video decoder
+     * (NVDEC, through the `nvcuvid` API of the NVIDIA Video Codec SDK), using FFmpeg (libavformat) as demuxer.
+     * Decoded frames are kept in GPU memory as NV12 (see FrameGpu) and returned by getLastFramesGpu(), so
+     * CvMatToOpInput (with gpuResize = true) can create the network input from them without any CPU decoding nor
+     * host-to-device copy of the frame.
+     * The frames are only converted into BGR and downloaded into CPU memory (i.e., returned by getFrames()) if
+     * downloadFrames is true (e.g., rendering, face or hand estimation, or image/video saving are enabled). Otherwise
+     * getFrames() returns empty Matrix objects.
+     * Supported codecs: MPEG-1/2/4, VC-1, H.264, HEVC, VP8, VP9 and AV1 (8-bit, subject to the GPU support).
+     */
+    class OP_API NvDecReader : public Producer
+    {
+    public:
+        /**
+         * Constructor of NvDecReader. It opens the video and creates the NVDEC parser in the given GPU.
+         * @param videoPath const std::string parameter with the full video path location.
+         * @param downloadFrames const bool parameter indicating whether the decoded frames should also be returned
+         * in CPU memory (BGR) by getFrames().
+         * @param gpuId const int parameter with the GPU where the frames are decoded (and kept).
+         * @param cameraParameterPath and undistortImage as in VideoReader. The GPU frames are undistorted while
+         * resized (see FrameGpu::undistortMapPtr), and the downloaded ones (if any) as in any other Producer.
+         */
+        explicit NvDecReader(
+            const std::string& videoPath, const bool downloadFrames = true, const int gpuId = 0,
+            const std::string& cameraParameterPath = "", const bool undistortImage = false);
+
+        virtual ~NvDecReader();
+
+        std::vector<FrameGpu> getLastFramesGpu();
+
+        std::string getNextFrameName();
+
+        bool isOpened() const;
+
+        void release();
+
+        double get(const int capProperty);
+
+        void set(const int capProperty, const double value);
+
+    private:
+        const std::string mPathName;
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplNvDecReader;
+        std::unique_ptr<ImplNvDecReader> upImpl;
+
+        Matrix getRawFrame();
+
+        std::vector<Matrix> getRawFrames();
+
+        DELETE_COPY(NvDecReader);
+    };
+}
+
+#endif // OPENPOSE_PRODUCER_NVDEC_READER_HPP
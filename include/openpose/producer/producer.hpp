@@ -1,8 +1,10 @@
 #ifndef OPENPOSE_PRODUCER_PRODUCER_HPP
 #define OPENPOSE_PRODUCER_PRODUCER_HPP
 
+#include <chrono>
 #include <openpose/3d/cameraParameterReader.hpp>
 #include <openpose/core/common.hpp>
+#include <openpose/core/frameGpu.hpp>
 #include <openpose/producer/enumClasses.hpp>
 
 namespace op
@@ -59,6 +61,89 @@ namespace op
          */
         virtual std::vector<Matrix> getCameraIntrinsics();
 
+        /**
+         * It retrieves and returns the camera distortion parameters from the frames producer, but only if they are
+         * still present in the frames, i.e., if only the keypoints must be undistorted (see setUndistortKeypoints()).
+         * Virtual class because FlirReader implements their own.
+         * @return std::vector<Mat> with the camera distortion parameters, or empty if the frames are not distorted
+         * (or undistorted by the producer).
+         */
+        virtual std::vector<Matrix> getCameraDistortions();
+
+        /**
+         * If true, the frames are not undistorted, even if the producer was created with undistortImage = true (which
+         * is still required for it to read the camera parameters), and getCameraDistortions() returns their
+         * distortion parameters instead, so only the 2-D keypoints are undistorted (see PoseTriangulation).
+         * Virtual class because FlirReader and MultiSourceProducer implement their own.
+         */
+        virtual void setUndistortKeypoints(const bool undistortKeypoints);
+
+        /**
+         * It returns the static region of interest of each view (see Datum::inputRoi), i.e., the ones of
+         * setInputRois() or, if empty, the `InputRoi` nodes of the camera parameter files.
+         * Virtual class because MultiSourceProducer implements its own.
+         * @return std::vector<std::vector<Point<int>>> with one region per view, a single one for all the views, or
+         * empty if the whole images are processed.
+         */
+        virtual std::vector<std::vector<Point<int>>> getInputRois();
+
+        /**
+         * It sets the static region of interest of each view (e.g., `--input_roi`), overriding the ones of the
+         * camera parameter files. A single region is applied to all the views.
+         */
+        void setInputRois(const std::vector<std::vector<Point<int>>>& inputRois);
+
+        /**
+         * It returns the frames in GPU memory (one per view) retrieved by the last getFrame()/getFrames() call, for
+         * producers that decode into GPU memory (e.g., NvDecReader). In that case, the Matrices returned by
+         * getFrames() might be empty (i.e., if the frames were not also downloaded into CPU memory).
+         * Virtual class because NvDecReader implements its own.
+         * @return std::vector<FrameGpu> with the GPU frames, empty for the producers that decode into CPU memory.
+         */
+        virtual std::vector<FrameGpu> getLastFramesGpu();
+
+        /**
+         * It returns the leases (one per view) of the frames retrieved by the last getFrame()/getFrames() call, for
+         * producers whose frames wrap memory they own (e.g., the shared memory slots of SharedMemoryReader). Each
+         * frame stays valid until its lease (see Datum::inputDataLease) and all its copies are released.
+         * Virtual class because SharedMemoryReader implements its own.
+         * @return std::vector<std::shared_ptr<void>> with the leases, empty for the producers that return frames
+         * owning their own memory.
+         */
+        virtual std::vector<std::shared_ptr<void>> getLastFrameLeases();
+
+        /**
+         * It returns the index of the source of the frames retrieved by the last getFrame()/getFrames() call, for
+         * producers that multiplex several sources (e.g., MultiSourceProducer).
+         * Virtual class because MultiSourceProducer implements its own.
+         * @return unsigned long long with the source index, always 0 for the single-source producers.
+         */
+        virtual unsigned long long getLastSourceId();
+
+        /**
+         * It returns the scheduling priority class (see Datum::priority) of the frames retrieved by the last
+         * getFrame()/getFrames() call.
+         * Virtual class because MultiSourceProducer implements its own.
+         * @return int with the priority, always 0 for the single-source producers.
+         */
+        virtual int getLastPriority();
+
+        /**
+         * It returns the deadline (see Datum::deadline) of the frames retrieved by the last getFrame()/getFrames()
+         * call.
+         * Virtual class because MultiSourceProducer implements its own.
+         * @return std::chrono::steady_clock::time_point with the deadline, always default-constructed (i.e., no
+         * deadline) for the single-source producers.
+         */
+        virtual std::chrono::steady_clock::time_point getLastDeadline();
+
+        /**
+         * It returns the number of sources multiplexed by this producer.
+         * Virtual class because MultiSourceProducer implements its own.
+         * @return unsigned long long with the number of sources, always 1 for the single-source producers.
+         */
+        virtual unsigned long long getNumberSources();
+
         /**
          * This function returns a unique frame name (e.g., the frame number for video, the
          * frame counter for webcam, the image name for image directory reader, etc.).
@@ -66,6 +151,13 @@ namespace op
          */
         virtual std::string getNextFrameName() = 0;
 
+        /**
+         * This function returns the frame number of the next frame (see Datum::frameNumber).
+         * Virtual class because ReplayReader implements its own (the recorded frame numbers).
+         * @return unsigned long long with the frame number, get(CV_CAP_PROP_POS_FRAMES) by default.
+         */
+        virtual unsigned long long getNextFrameNumber();
+
         /**
          * This function sets whether the producer must keep the original fps frame rate or extract the frames as quick
          * as possible.
@@ -82,6 +174,15 @@ namespace op
             return mType;
         }
 
+        /**
+         * This function returns the ProducerFpsMode set with setProducerFpsMode.
+         * @return ProducerFpsMode with the current fps mode.
+         */
+        inline ProducerFpsMode getProducerFpsMode() const
+        {
+            return mProducerFpsMode;
+        }
+
         /**
          * This function returns whether the Producer instance is still opened and able
          * to retrieve more frames.
@@ -146,6 +247,20 @@ namespace op
          */
         void keepDesiredFrameRate();
 
+        /**
+         * Protected function for the children classes that keep their frames in GPU memory (see getLastFramesGpu()).
+         * If `--frame_undistort`, it attaches the cached remap table of each camera (see FrameGpu::undistortMapPtr),
+         * so the frames are undistorted while being resized into the network input.
+         */
+        void setUndistortMapsGpu(std::vector<FrameGpu>& framesGpu);
+
+        /**
+         * Analogous to setUndistortMapsGpu() for `--frame_flip` and `--frame_rotate`: it sets FrameGpu::rotation and
+         * FrameGpu::flip, so the GPU frames are rotated and flipped while being resized (rather than by
+         * rotateAndFlipFrame(), which only applies to the CPU frames).
+         */
+        void setOrientationGpu(std::vector<FrameGpu>& framesGpu);
+
         /**
          * Function to be defined by its children class. It retrieves and returns a new frame from the frames producer.
          * @return Mat with the new frame.
@@ -159,11 +274,23 @@ namespace op
          */
         virtual std::vector<Matrix> getRawFrames() = 0;
 
+        /**
+         * It discards the next numberFrames frames (e.g., to catch up with the original frame rate in
+         * keepDesiredFrameRate()). By default, they are retrieved with getRawFrames() and discarded.
+         * Virtual class because VideoCaptureReader and VideoReader implement their own, which do not convert the
+         * skipped frames into BGR images.
+         */
+        virtual void skipRawFrames(const unsigned long long numberFrames);
+
     private:
         const ProducerType mType;
         ProducerFpsMode mProducerFpsMode;
         std::array<double, (int)ProducerProperty::Size> mProperties;
         unsigned int mNumberEmptyFrames;
+        // Camera parameters read because of undistortImage, but only the keypoints undistorted
+        const bool mUndistortImage;
+        bool mUndistortKeypoints;
+        std::vector<std::vector<Point<int>>> mInputRois;
         // For ProducerFpsMode::OriginalFps
         bool mTrackingFps;
         unsigned long long mFirstFrameTrackingFps;
@@ -178,12 +305,33 @@ namespace op
 
     /**
      * This function returns the desired producer given the input parameters.
+     * @param producerString For ProducerType::Video and IPCamera, several comma-separated videos or IP camera URLs
+     * are multiplexed into a single MultiSourceProducer.
+     * @param nvDecodeGpuId If >= 0 and producerType is ProducerType::Video, the video is decoded by NvDecReader on
+     * that GPU.
+     * @param nvDecodeDownload Only used with NvDecReader, whether the frames must also be available in CPU memory.
+     * @param imageDecodingThreads Only used with ProducerType::ImageDirectory, number of threads decoding the images
+     * in parallel (see ImageDirectoryReader). 0 to load them synchronously.
+     * @param flirBayerGpuId If >= 0 and producerType is ProducerType::FlirCamera, the raw Bayer images are uploaded
+     * into that GPU and debayered there (see SpinnakerWrapper). nvDecodeDownload also sets whether they are
+     * downloaded into CPU memory.
+     * @param flirSyncToleranceMs Only used with ProducerType::FlirCamera, maximum timestamp difference (in
+     * milliseconds) among the images of the different cameras of the same frame set.
+     * @param undistortKeypoints If true, the camera parameters are read (as with undistortImage), but the frames are
+     * not undistorted, only the 2-D keypoints (see Producer::setUndistortKeypoints()).
+     * @param videoDecoders Only used with ProducerType::Video (without NVDEC), number of decoders decoding consecutive
+     * segments of videoSegmentFrames frames of the video in parallel (see VideoReader). 0 to use a single decoder.
+     * @param imageDirectoryStream Only used with ProducerType::ImageDirectory, whether to return the images while the
+     * directory is still being listed (unsorted, see ImageDirectoryReader).
      */
     OP_API std::shared_ptr<Producer> createProducer(
         const ProducerType producerType = ProducerType::None, const std::string& producerString = "",
         const Point<int>& cameraResolution = Point<int>{-1,-1},
         const std::string& cameraParameterPath = "models/cameraParameters/", const bool undistortImage = true,
-        const int numberViews = -1);
+        const int numberViews = -1, const int nvDecodeGpuId = -1, const bool nvDecodeDownload = true,
+        const int imageDecodingThreads = 0, const int flirBayerGpuId = -1, const double flirSyncToleranceMs = 5.,
+        const bool undistortKeypoints = false, const int videoDecoders = 0, const int videoSegmentFrames = 250,
+        const bool imageDirectoryStream = false, const bool webcamV4l2 = false, const int webcamFps = 0);
 }
 
 #endif // OPENPOSE_PRODUCER_PRODUCER_HPP
@@ -0,0 +1,76 @@
+#ifndef OPENPOSE_PRODUCER_REPLAY_READER_HPP
+#define OPENPOSE_PRODUCER_REPLAY_READER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/producer/producer.hpp>
+
+namespace op
+{
+    /**
+     * ReplayReader re-emits the frames saved by InputRecorder, with their original name, frameNumber, source IDs, and
+     * camera parameters, so the same input stream can be re-run deterministically (e.g., for throughput and latency
+     * tests). With ProducerFpsMode::OriginalFps, each frame is returned at its recorded arrival time (relative to the
+     * first returned one), reproducing the original cadence rather than a constant frame rate (frames are never
+     * skipped, they are returned right away if the processing is slower than the recording). Otherwise, they are
+     * returned as fast as they are requested.
+     * The recorded frames already include the flip, rotation, and undistortion of the original producer (if any).
+     */
+    class OP_API ReplayReader : public Producer
+    {
+    public:
+        /**
+         * Constructor of ReplayReader. It reads the index of the frames of the recording (the frames themselves are
+         * read and decoded when requested).
+         * @param replayPath const std::string parameter with the path of the recording (see InputRecorder).
+         */
+        explicit ReplayReader(const std::string& replayPath);
+
+        virtual ~ReplayReader();
+
+        std::vector<Matrix> getCameraMatrices();
+
+        std::vector<Matrix> getCameraExtrinsics();
+
+        std::vector<Matrix> getCameraIntrinsics();
+
+        std::vector<Matrix> getCameraDistortions();
+
+        unsigned long long getLastSourceId();
+
+        unsigned long long getNumberSources();
+
+        std::string getNextFrameName();
+
+        unsigned long long getNextFrameNumber();
+
+        /**
+         * Recorded arrival time (in milliseconds, relative to the first recorded frame) of the frames returned by the
+         * last getFrames() call.
+         */
+        double getLastTimestampMs() const;
+
+        bool isOpened() const;
+
+        void release();
+
+        double get(const int capProperty);
+
+        void set(const int capProperty, const double value);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplReplayReader;
+        std::unique_ptr<ImplReplayReader> upImpl;
+
+        bool hasNextFrame() const;
+
+        Matrix getRawFrame();
+
+        std::vector<Matrix> getRawFrames();
+
+        DELETE_COPY(ReplayReader);
+    };
+}
+
+#endif // OPENPOSE_PRODUCER_REPLAY_READER_HPP
@@ -0,0 +1,66 @@
+#ifndef OPENPOSE_PRODUCER_SHARED_MEMORY_READER_HPP
+#define OPENPOSE_PRODUCER_SHARED_MEMORY_READER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/producer/producer.hpp>
+
+namespace op
+{
+    /**
+     * SharedMemoryReader reads the frames written by another process of the same host (e.g., a capture or decoding
+     * service) into a shared memory ring buffer (see frameRingFormat.hpp), so no encoding, sockets nor copies are
+     * needed between both processes. The BGR frames are not copied: each one is returned as a Matrix wrapping its
+     * slot of the ring buffer, and the slot is only given back to the writer once its Datum::inputDataLease is
+     * released (see getLastFrameLeases(), by default by WCvMatToOpInput once the network input has been computed).
+     * The NV12 frames are converted into BGR when read, so their slot is released right away.
+     */
+    class OP_API SharedMemoryReader : public Producer
+    {
+    public:
+        /**
+         * Constructor of SharedMemoryReader. It attaches to the existing ring buffer (so the writer process must be
+         * started first).
+         * @param sharedMemoryName const std::string parameter with the name of the shared memory block.
+         * @param cameraParameterPath const std::string parameter with the folder path containing the camera
+         * parameters (only required if undistortImage is true).
+         * @param undistortImage const bool parameter with whether to undistort the images (which copies them).
+         */
+        explicit SharedMemoryReader(
+            const std::string& sharedMemoryName, const std::string& cameraParameterPath = "",
+            const bool undistortImage = false);
+
+        virtual ~SharedMemoryReader();
+
+        std::vector<std::shared_ptr<void>> getLastFrameLeases();
+
+        std::string getNextFrameName();
+
+        /**
+         * Timestamp (FrameRingSlotHeader::timestampUs, in microseconds) of the frame returned by the last
+         * getFrames() call.
+         */
+        unsigned long long getLastTimestampUs() const;
+
+        bool isOpened() const;
+
+        void release();
+
+        double get(const int capProperty);
+
+        void set(const int capProperty, const double value);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplSharedMemoryReader;
+        std::unique_ptr<ImplSharedMemoryReader> upImpl;
+
+        Matrix getRawFrame();
+
+        std::vector<Matrix> getRawFrames();
+
+        DELETE_COPY(SharedMemoryReader);
+    };
+}
+
+#endif // OPENPOSE_PRODUCER_SHARED_MEMORY_READER_HPP
@@ -2,6 +2,7 @@
 #define OPENPOSE_PRODUCER_SPINNAKER_WRAPPER_HPP
 
 #include <openpose/core/common.hpp>
+#include <openpose/core/frameGpu.hpp>
 
 namespace op
 {
@@ -15,14 +16,26 @@ namespace op
         /**
          * Constructor of SpinnakerWrapper. It opens all the available FLIR cameras
          * cameraIndex = -1 means that all cameras are taken
+         * If bayerGpuId >= 0, the raw Bayer images are uploaded into that GPU instead of being converted into BGR on
+         * the CPU (see getLastFramesGpu()), and getRawFrames() only returns them (debayered on the GPU) if
+         * downloadFrames is true. Undistortion is not applied in that case.
+         * Each camera is read by its own thread into its own ring buffer, and getRawFrames() returns the images whose
+         * timestamps (after removing the clock offset between cameras) are within syncToleranceMs milliseconds.
          */
         explicit SpinnakerWrapper(const std::string& cameraParameterPath, const Point<int>& cameraResolution,
-                                  const bool undistortImage, const int cameraIndex = -1);
+                                  const bool undistortImage, const int cameraIndex = -1, const int bayerGpuId = -1,
+                                  const bool downloadFrames = true, const double syncToleranceMs = 5.);
 
         virtual ~SpinnakerWrapper();
 
         std::vector<Matrix> getRawFrames();
 
+        /**
+         * Raw Bayer GPU frames (with their Spinnaker timestamps) of the last getRawFrames() call, or empty if
+         * bayerGpuId < 0.
+         */
+        std::vector<FrameGpu> getLastFramesGpu() const;
+
         /**
          * Note: The camera parameters are only read if undistortImage is true. This should be changed to add a
          * new bool flag in the constructor, e.g., readCameraParameters
@@ -33,6 +46,17 @@ namespace op
 
         std::vector<Matrix> getCameraIntrinsics() const;
 
+        /**
+         * Empty unless setUndistortKeypoints(true), see Producer::getCameraDistortions().
+         */
+        std::vector<Matrix> getCameraDistortions() const;
+
+        /**
+         * If true, the images are not undistorted (but the camera parameters are still read if undistortImage is
+         * true), so only the keypoints are (see Producer::setUndistortKeypoints()).
+         */
+        void setUndistortKeypoints(const bool undistortKeypoints);
+
         Point<int> getResolution() const;
 
         bool isOpened() const;
@@ -0,0 +1,65 @@
+#ifndef OPENPOSE_PRODUCER_V4L2_READER_HPP
+#define OPENPOSE_PRODUCER_V4L2_READER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/producer/producer.hpp>
+
+namespace op
+{
+    /**
+     * V4l2Reader reads a Linux webcam (/dev/video<index>) directly through V4L2 (OpenPose must be compiled with
+     * `WITH_V4L2`), as a lighter alternative to WebcamReader (`--camera_v4l2`):
+     * - The driver fills memory-mapped (MMAP) buffers, and the reader waits for them with poll() (no polling thread).
+     * - Only the newest frame is decoded, the older ones are given back to the driver as they are (so the latency is
+     *   bounded to 1 frame, and the frames skipped are never decoded).
+     * - MJPEG frames are decoded straight from the driver buffer (with libjpeg-turbo if compiled with
+     *   `WITH_TURBOJPEG`, cv::imdecode otherwise) into a pool of BGR frames, and YUYV frames are converted into it.
+     *   The pooled frames are not copied: each one is reused once its Datum::inputDataLease is released (see
+     *   getLastFrameLeases(), by default by WCvMatToOpInput once the network input has been computed).
+     */
+    class OP_API V4l2Reader : public Producer
+    {
+    public:
+        /**
+         * Constructor of V4l2Reader. It opens the device and starts streaming.
+         * @param webcamIndex const int parameter with the index of the device (/dev/video<webcamIndex>).
+         * @param webcamResolution const Point<int> parameter with the desired resolution (the driver selects the
+         * closest one).
+         * @param fps const int parameter with the desired frame rate, 0 for the driver default.
+         * @param throwExceptionIfNoOpened const bool parameter with whether to throw an exception if the device
+         * cannot be opened (otherwise, isOpened() returns false).
+         */
+        explicit V4l2Reader(
+            const int webcamIndex = 0, const Point<int>& webcamResolution = Point<int>{},
+            const int fps = 0, const bool throwExceptionIfNoOpened = true, const std::string& cameraParameterPath = "",
+            const bool undistortImage = false);
+
+        virtual ~V4l2Reader();
+
+        std::vector<std::shared_ptr<void>> getLastFrameLeases();
+
+        std::string getNextFrameName();
+
+        bool isOpened() const;
+
+        void release();
+
+        double get(const int capProperty);
+
+        void set(const int capProperty, const double value);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplV4l2Reader;
+        std::unique_ptr<ImplV4l2Reader> upImpl;
+
+        Matrix getRawFrame();
+
+        std::vector<Matrix> getRawFrames();
+
+        DELETE_COPY(V4l2Reader);
+    };
+}
+
+#endif // OPENPOSE_PRODUCER_V4L2_READER_HPP
@@ -51,6 +51,12 @@ namespace op
 
         virtual std::vector<Matrix> getRawFrames() = 0;
 
+        /**
+         * The skipped frames are grabbed (or seeked over for videos, if it was measured to be cheaper) but never
+         * retrieved (i.e., converted into BGR).
+         */
+        virtual void skipRawFrames(const unsigned long long numberFrames);
+
         void resetWebcam(const int index, const bool throwExceptionIfNoOpened);
 
     private:
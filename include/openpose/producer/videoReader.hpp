@@ -21,10 +21,18 @@ namespace op
          * parameters (only required if imageDirectorystereo > 1).
          * @param numberViews const int parameter with the number of images per iteration (>1 would represent
          * stereo processing).
+         * @param numberDecoders const int parameter with the number of decoders (each one with its own
+         * cv::VideoCapture and thread) decoding the next segments of the video in parallel, while the frames are
+         * returned in their original order (so the frame numbers and the Datum ids stay consecutive, as with a
+         * single decoder). Each decoder keeps up to 1 segment of decoded frames in memory. 0 to read each frame
+         * synchronously when it is requested.
+         * @param segmentFrames const int parameter with the number of frames of each segment. Segments start at
+         * the multiples of it, so they start at a keyframe if it is a multiple of the keyframe interval of the video.
          */
         explicit VideoReader(
             const std::string& videoPath, const std::string& cameraParameterPath = "",
-            const bool undistortImage = false, const int numberViews = -1);
+            const bool undistortImage = false, const int numberViews = -1, const int numberDecoders = 0,
+            const int segmentFrames = 250);
 
         virtual ~VideoReader();
 
@@ -35,17 +43,26 @@ namespace op
             return VideoCaptureReader::isOpened();
         }
 
+        void release();
+
         double get(const int capProperty);
 
         void set(const int capProperty, const double value);
 
     private:
         const std::string mPathName;
+        long long mFramePosition;
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplVideoReader;
+        std::unique_ptr<ImplVideoReader> upImpl;
 
         Matrix getRawFrame();
 
         std::vector<Matrix> getRawFrames();
 
+        void skipRawFrames(const unsigned long long numberFrames);
+
         DELETE_COPY(VideoReader);
     };
 }
@@ -5,6 +5,8 @@
 #include <queue> // std::queue
 #include <openpose/core/common.hpp>
 #include <openpose/producer/datumProducer.hpp>
+#include <openpose/producer/inputRecorder.hpp>
+#include <openpose/thread/frameCredits.hpp>
 #include <openpose/thread/workerProducer.hpp>
 
 namespace op
@@ -13,7 +15,15 @@ namespace op
     class WDatumProducer : public WorkerProducer<std::shared_ptr<std::vector<std::shared_ptr<TDatum>>>>
     {
     public:
-        explicit WDatumProducer(const std::shared_ptr<DatumProducer<TDatum>>& datumProducer);
+        /**
+         * @param inputRecorder If not nullptr, every frame set leaving the producer is recorded (see InputRecorder).
+         * @param frameCredits If not nullptr, a new frame is only read once there is a free credit (and each view
+         * takes one, see FrameCredits). Otherwise, it reads as fast as its output queue allows.
+         */
+        explicit WDatumProducer(
+            const std::shared_ptr<DatumProducer<TDatum>>& datumProducer,
+            const std::shared_ptr<InputRecorder>& inputRecorder = nullptr,
+            const std::shared_ptr<FrameCredits>& frameCredits = nullptr);
 
         virtual ~WDatumProducer();
 
@@ -23,8 +33,12 @@ namespace op
 
     private:
         std::shared_ptr<DatumProducer<TDatum>> spDatumProducer;
+        const std::shared_ptr<InputRecorder> spInputRecorder;
+        const std::shared_ptr<FrameCredits> spFrameCredits;
         std::queue<std::shared_ptr<std::vector<std::shared_ptr<TDatum>>>> mQueuedElements;
 
+        void recordInput(const std::vector<std::shared_ptr<TDatum>>& tDatums);
+
         DELETE_COPY(WDatumProducer);
     };
 }
@@ -37,10 +51,16 @@ namespace op
 #include <openpose/core/datum.hpp>
 namespace op
 {
+    // Maximum time blocked waiting for a frame credit in each workProducer() call (so the thread can be stopped)
+    const auto W_DATUM_PRODUCER_CREDIT_WAIT_MICROSECONDS = 1000ll;
+
     template<typename TDatum>
     WDatumProducer<TDatum>::WDatumProducer(
-        const std::shared_ptr<DatumProducer<TDatum>>& datumProducer) :
-        spDatumProducer{datumProducer}
+        const std::shared_ptr<DatumProducer<TDatum>>& datumProducer,
+        const std::shared_ptr<InputRecorder>& inputRecorder, const std::shared_ptr<FrameCredits>& frameCredits) :
+        spDatumProducer{datumProducer},
+        spInputRecorder{inputRecorder},
+        spFrameCredits{frameCredits}
     {
     }
 
@@ -62,8 +82,13 @@ namespace op
         {
             // Debugging log
             opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            // Flow control: No new frame until the downstream stages grant a credit back
+            if (mQueuedElements.empty() && spFrameCredits != nullptr
+                && !spFrameCredits->waitForCredit(W_DATUM_PRODUCER_CREDIT_WAIT_MICROSECONDS))
+                return nullptr;
             // Profiling speed
-            const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+            static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+            const auto profilerKey = Profiler::timerInit(profilerTimerId);
             // Create and fill final shared pointer
             std::shared_ptr<std::vector<std::shared_ptr<TDatum>>> tDatums;
             // Producer
@@ -74,6 +99,14 @@ namespace op
                 // Stop Worker if producer finished
                 if (!isRunning)
                     this->stop();
+                // 1 credit per view
+                if (spFrameCredits != nullptr && tDatums != nullptr)
+                    for (auto& tDatumPtr : *tDatums)
+                        if (tDatumPtr != nullptr)
+                            tDatumPtr->frameCredit = spFrameCredits->takeCredit();
+                // Record input (before splitting the views)
+                if (spInputRecorder != nullptr && tDatums != nullptr && !tDatums->empty())
+                    recordInput(*tDatums);
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
                 Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
@@ -112,6 +145,35 @@ namespace op
         }
     }
 
+    template<typename TDatum>
+    void WDatumProducer<TDatum>::recordInput(const std::vector<std::shared_ptr<TDatum>>& tDatums)
+    {
+        try
+        {
+            std::vector<Matrix> frames;
+            std::vector<Matrix> cameraMatrices;
+            std::vector<Matrix> cameraExtrinsics;
+            std::vector<Matrix> cameraIntrinsics;
+            std::vector<Matrix> cameraDistortions;
+            for (const auto& tDatumPtr : tDatums)
+            {
+                frames.emplace_back(tDatumPtr->cvInputData);
+                cameraMatrices.emplace_back(tDatumPtr->cameraMatrix);
+                cameraExtrinsics.emplace_back(tDatumPtr->cameraExtrinsics);
+                cameraIntrinsics.emplace_back(tDatumPtr->cameraIntrinsics);
+                cameraDistortions.emplace_back(tDatumPtr->cameraDistortion);
+            }
+            const auto& tDatumPtr = tDatums[0];
+            spInputRecorder->record(
+                tDatumPtr->name, tDatumPtr->frameNumber, tDatumPtr->sourceId, tDatumPtr->sourceIdMax, frames,
+                cameraMatrices, cameraExtrinsics, cameraIntrinsics, cameraDistortions);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     extern template class WDatumProducer<BASE_DATUM>;
 }
 
@@ -0,0 +1,181 @@
+#ifndef OPENPOSE_THREAD_DEADLINE_QUEUE_HPP
+#define OPENPOSE_THREAD_DEADLINE_QUEUE_HPP
+
+#include <chrono>
+#include <queue> // std::priority_queue
+#include <openpose/core/common.hpp>
+#include <openpose/thread/queueBase.hpp>
+
+namespace op
+{
+    /**
+     * Ordering of DeadlineQueue: higher Datum::priority first, then the earliest Datum::deadline (the ones with no
+     * deadline last), and then the lowest Datum::id and Datum::subId (i.e., the same order than the producer).
+     * The first Datum of each TDatums is the one compared.
+     */
+    template<typename TDatums>
+    struct DeadlineComparator
+    {
+        bool operator()(const TDatums& a, const TDatums& b) const
+        {
+            // Empty ones first, so they are quickly discarded
+            if (a == nullptr || a->empty())
+                return false;
+            if (b == nullptr || b->empty())
+                return true;
+            const auto& datumA = *a->at(0);
+            const auto& datumB = *b->at(0);
+            if (datumA.priority != datumB.priority)
+                return datumA.priority < datumB.priority;
+            const std::chrono::steady_clock::time_point none{};
+            if (datumA.deadline != datumB.deadline)
+                return (datumA.deadline == none || (datumB.deadline != none && datumB.deadline < datumA.deadline));
+            if (datumA.id != datumB.id)
+                return datumA.id > datumB.id;
+            return datumA.subId > datumB.subId;
+        }
+    };
+
+    /**
+     * Queue that pops the TDatums following DeadlineComparator, and drops (rather than pops) the ones whose
+     * Datum::deadline has already passed. It can be used as TQueue of ThreadManager in custom pipelines whose workers
+     * do not require the frames in order (e.g., it cannot be followed by WQueueOrderer, which would wait for the
+     * dropped ids).
+     * The default OpenPose pipeline applies the same scheduling before the ids are assigned (see
+     * MultiSourceProducer::setSourceSchedule()), so the output order is kept.
+     */
+    template<typename TDatums, typename TQueue = std::priority_queue<TDatums, std::vector<TDatums>,
+                                                                      DeadlineComparator<TDatums>>>
+    class DeadlineQueue : public QueueBase<TDatums, TQueue>
+    {
+    public:
+        explicit DeadlineQueue(const long long maxSize = 256);
+
+        virtual ~DeadlineQueue();
+
+        TDatums front() const;
+
+        /**
+         * Number of TDatums dropped so far because their deadline had passed.
+         */
+        unsigned long long getNumberExpired() const;
+
+    private:
+        unsigned long long mNumberExpired;
+
+        bool pop(TDatums& tDatums);
+
+        DELETE_COPY(DeadlineQueue);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <type_traits> // std::is_same
+namespace op
+{
+    template<typename TDatums, typename TQueue>
+    DeadlineQueue<TDatums, TQueue>::DeadlineQueue(const long long maxSize) :
+        QueueBase<TDatums, TQueue>{maxSize},
+        mNumberExpired{0ull}
+    {
+        // Check TDatums = underlying value type of TQueue
+        typedef typename TQueue::value_type underlyingValueType;
+        static_assert(std::is_same<TDatums, underlyingValueType>::value,
+                      "Error: The type of the queue must be the same as the type of the container");
+    }
+
+    template<typename TDatums, typename TQueue>
+    DeadlineQueue<TDatums, TQueue>::~DeadlineQueue()
+    {
+        try
+        {
+            if (mNumberExpired > 0ull)
+                opLog("DeadlineQueue dropped " + std::to_string(mNumberExpired) + " frames that exceeded their"
+                      " deadline.", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    TDatums DeadlineQueue<TDatums, TQueue>::front() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{this->mMutex};
+            return this->mTQueue.top();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return TDatums{};
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    unsigned long long DeadlineQueue<TDatums, TQueue>::getNumberExpired() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{this->mMutex};
+            return mNumberExpired;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    bool DeadlineQueue<TDatums, TQueue>::pop(TDatums& tDatums)
+    {
+        try
+        {
+            if (this->mPopIsStopped)
+                return false;
+            // Expired ones are dropped (and their space released to the pushers)
+            const std::chrono::steady_clock::time_point none{};
+            const auto now = std::chrono::steady_clock::now();
+            auto dropped = false;
+            while (!this->mTQueue.empty())
+            {
+                const auto& top = this->mTQueue.top();
+                if (top == nullptr || top->empty() || top->at(0)->deadline == none || top->at(0)->deadline >= now)
+                    break;
+                this->mTQueue.pop();
+                mNumberExpired++;
+                dropped = true;
+            }
+            if (this->mTQueue.empty())
+            {
+                if (dropped)
+                    this->mConditionVariable.notify_all();
+                return false;
+            }
+
+            tDatums = {std::move(this->mTQueue.top())};
+            this->mTQueue.pop();
+            if (dropped)
+                this->mConditionVariable.notify_all();
+            else
+                this->mConditionVariable.notify_one();
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(DeadlineQueue);
+}
+
+#endif // OPENPOSE_THREAD_DEADLINE_QUEUE_HPP
@@ -22,6 +22,41 @@ namespace op
          */
         Synchronous,
     };
+
+    /**
+     * What a queue does when an element is pushed while it is full.
+     * Any policy but Block drops elements, so producers never wait (e.g., to bound the latency of live cameras when
+     * the following stages are slower than them).
+     */
+    enum class QueueOverflowPolicy : unsigned char
+    {
+        Block,          /**< Default: The pusher waits until there is space (no element is lost). */
+        DropOldest,     /**< The oldest element in the queue is removed to make room for the new one. */
+        DropNewest,     /**< The new element is discarded. */
+        KeepLatest,     /**< The queue is emptied before pushing, so it only keeps the latest element. */
+    };
+
+    /**
+     * OS scheduling priority of a thread (see ThreadAffinity).
+     */
+    enum class ThreadPriority : unsigned char
+    {
+        Default,        /**< The OS default (inherited from the creating thread). */
+        Low,            /**< Below normal (e.g., for non-critical saving threads). */
+        High,           /**< Above normal (Linux: nice -10, which requires CAP_SYS_NICE). */
+        RealTime,       /**< Real-time scheduling (Linux: SCHED_FIFO, which requires CAP_SYS_NICE). Use with care. */
+        Size,
+    };
+
+    /**
+     * Queue type between the workers of WrapperT (see WrapperStructExtra::queueType).
+     */
+    enum class QueueType : unsigned char
+    {
+        Mutex,          /**< Default: The mutex-based Queue. */
+        RingBuffer,     /**< The lock-free RingBufferQueue, with less lock contention between many threads. */
+        Size,
+    };
 }
 
 #endif // OPENPOSE_THREAD_ENUM_CLASSES_HPP
@@ -0,0 +1,63 @@
+#ifndef OPENPOSE_THREAD_FRAME_CREDITS_HPP
+#define OPENPOSE_THREAD_FRAME_CREDITS_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * FrameCredits is a credit-based flow control between the producer and the stages that bound the pipeline
+     * throughput (e.g., the GPU pose threads). The producer takes a credit before it decodes each frame. The credit
+     * lives with the frame (see Datum::frameCredit) and it is granted back once the frame leaves those stages (see
+     * WFrameCredits), or once the frame is released if it does not reach them (e.g., if it is dropped). Thus, the
+     * producer only decodes ahead a bounded number of frames (its credits), regardless of the queue sizes, so the
+     * memory stays bounded while the GPUs stay busy.
+     * It is thread-safe, and the credits can outlive it.
+     */
+    class OP_API FrameCredits
+    {
+    public:
+        /**
+         * @param numberCredits Maximum number of frames between the producer and the stage granting the credits back
+         * (e.g., the frames the GPU threads process at the same time plus the frames decoded ahead). At least 1.
+         */
+        explicit FrameCredits(const unsigned long long numberCredits);
+
+        virtual ~FrameCredits();
+
+        /**
+         * It blocks until there is a free credit or timeoutMicroseconds pass, and it returns whether there is one.
+         * Each credit granted back wakes it up.
+         */
+        bool waitForCredit(const long long timeoutMicroseconds);
+
+        /**
+         * It takes a credit (even if there is none free, e.g., for the views of a frame that already took one), and
+         * it returns it as a lease: it is granted back once the last copy of the lease is released.
+         */
+        std::shared_ptr<void> takeCredit();
+
+        unsigned long long getNumberCredits() const;
+
+        /**
+         * Number of credits currently taken, i.e., frames between the producer and the stage granting them back.
+         */
+        unsigned long long getNumberInFlight() const;
+
+        /**
+         * Human-readable summary (peak frames in flight and time the producer waited for a credit).
+         */
+        std::string getStatsString() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        // Shared with the credits, so they can be granted back after FrameCredits is destroyed
+        struct ImplFrameCredits;
+        std::shared_ptr<ImplFrameCredits> spImpl;
+
+        DELETE_COPY(FrameCredits);
+    };
+}
+
+#endif // OPENPOSE_THREAD_FRAME_CREDITS_HPP
@@ -0,0 +1,100 @@
+#ifndef OPENPOSE_THREAD_GPU_DISPATCHER_HPP
+#define OPENPOSE_THREAD_GPU_DISPATCHER_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Statistics of each GPU (or CPU worker) of a GpuDispatcher.
+     */
+    struct OP_API GpuDispatcherStats
+    {
+        /**
+         * Number of frames finished.
+         */
+        unsigned long long frames;
+
+        /**
+         * Number of times the GPU was idle but left the next frame to a faster one.
+         */
+        unsigned long long deferrals;
+
+        /**
+         * Number of frames currently inside the GPU thread (e.g., > 1 while a batch is being filled).
+         */
+        unsigned int inFlight;
+
+        /**
+         * Average processing time of each frame (in milliseconds, exponential moving average).
+         */
+        double frameMs;
+
+        /**
+         * Frames per second finished by the GPU since its first frame.
+         */
+        double fps;
+    };
+
+    /**
+     * GpuDispatcher distributes the frames among the multi-GPU pose threads, which pop them from the same queue.
+     * Without it, each idle GPU takes the next frame, so with mixed GPUs (e.g., a fast one and a few slow ones) the
+     * slow GPUs keep frames that a fast one would finish earlier, and WQueueOrderer holds the following frames until
+     * them. GpuDispatcher keeps the average processing time of each GPU and the number of frames inside it, and an
+     * idle GPU only takes the next frame if it would finish it before the others were free for it (i.e., weighted
+     * least-loaded), or if the input queue has enough frames for all the faster GPUs. With identical GPUs, it behaves
+     * as the default first-idle-takes-it dispatch.
+     * Spillover workers (e.g., CPU workers next to the GPU ones, indexes numberGpus and above) only take a frame if
+     * more than spilloverQueueSize frames are waiting, i.e., when the GPUs cannot keep up with a burst.
+     * It is thread-safe. See WGpuDispatch for the workers that report to it.
+     */
+    class OP_API GpuDispatcher
+    {
+    public:
+        /**
+         * @param numberGpus Number of GPU (or CPU worker) threads.
+         * @param numberSpilloverWorkers Number of spillover worker threads (indexes numberGpus and above).
+         * @param spilloverQueueSize Number of waiting frames beyond which the spillover workers take them.
+         */
+        explicit GpuDispatcher(
+            const int numberGpus, const int numberSpilloverWorkers = 0,
+            const unsigned long long spilloverQueueSize = 0ull);
+
+        virtual ~GpuDispatcher();
+
+        /**
+         * Whether the idle GPU gpu should pop a new frame.
+         * @param queueSize Number of frames waiting in the shared input queue.
+         */
+        bool shouldAccept(const int gpu, const unsigned long long queueSize);
+
+        /**
+         * To be called when gpu pops numberFrames frames.
+         */
+        void start(const int gpu, const unsigned int numberFrames);
+
+        /**
+         * To be called when gpu finishes numberFrames frames (in the same order as start()).
+         */
+        void finish(const int gpu, const unsigned int numberFrames);
+
+        std::vector<GpuDispatcherStats> getStats() const;
+
+        /**
+         * Human-readable summary of getStats(), one line per GPU.
+         */
+        std::string getStatsString() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplGpuDispatcher;
+        std::unique_ptr<ImplGpuDispatcher> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(GpuDispatcher);
+    };
+}
+
+#endif // OPENPOSE_THREAD_GPU_DISPATCHER_HPP
@@ -3,22 +3,31 @@
 
 // thread module
 #include <openpose/thread/enumClasses.hpp>
+#include <openpose/thread/deadlineQueue.hpp>
+#include <openpose/thread/frameCredits.hpp>
+#include <openpose/thread/gpuDispatcher.hpp>
 #include <openpose/thread/priorityQueue.hpp>
 #include <openpose/thread/queue.hpp>
 #include <openpose/thread/queueBase.hpp>
+#include <openpose/thread/ringBufferQueue.hpp>
 #include <openpose/thread/subThread.hpp>
 #include <openpose/thread/subThreadNoQueue.hpp>
 #include <openpose/thread/subThreadQueueIn.hpp>
 #include <openpose/thread/subThreadQueueInOut.hpp>
 #include <openpose/thread/subThreadQueueOut.hpp>
 #include <openpose/thread/thread.hpp>
+#include <openpose/thread/threadAffinity.hpp>
 #include <openpose/thread/threadManager.hpp>
+#include <openpose/thread/threadPool.hpp>
 #include <openpose/thread/worker.hpp>
 #include <openpose/thread/workerProducer.hpp>
 #include <openpose/thread/workerConsumer.hpp>
 #include <openpose/thread/wFpsMax.hpp>
+#include <openpose/thread/wFrameCredits.hpp>
+#include <openpose/thread/wGpuDispatch.hpp>
 #include <openpose/thread/wIdGenerator.hpp>
 #include <openpose/thread/wQueueAssembler.hpp>
 #include <openpose/thread/wQueueOrderer.hpp>
+#include <openpose/thread/wViewGpuAffinity.hpp>
 
 #endif // OPENPOSE_THREAD_HEADERS_HPP
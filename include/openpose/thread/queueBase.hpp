@@ -1,10 +1,13 @@
 #ifndef OPENPOSE_THREAD_QUEUE_BASE_HPP
 #define OPENPOSE_THREAD_QUEUE_BASE_HPP
 
+#include <chrono>
 #include <condition_variable>
+#include <functional> // std::function
 #include <mutex>
 #include <queue> // std::queue & std::priority_queue
 #include <openpose/core/common.hpp>
+#include <openpose/thread/enumClasses.hpp>
 
 namespace op
 {
@@ -32,10 +35,30 @@ namespace op
 
         bool tryPop();
 
+        /**
+         * Analogous to tryPop(), but the next element is only popped if accept(element) returns true, checked while
+         * the queue is locked (so no other popper can take it in between). Otherwise, it is left in the queue (e.g.,
+         * for the other threads popping from it, see Worker::acceptsInput()) and it returns false.
+         */
+        bool tryPopIf(TDatums& tDatums, const std::function<bool(const TDatums&)>& accept);
+
         bool waitAndPop(TDatums& tDatums);
 
         bool waitAndPop();
 
+        /**
+         * It blocks until there is an element to pop, the queue is stopped, or timeoutMicroseconds pass, and it
+         * returns whether there is an element. Unlike polling empty() with sleeps, a new element wakes it up right
+         * away.
+         */
+        bool waitUntilNotEmpty(const long long timeoutMicroseconds);
+
+        /**
+         * Analogous to waitUntilNotEmpty() for isFull(): It returns whether a new element can be pushed without
+         * waiting. Each pop wakes it up.
+         */
+        bool waitUntilNotFull(const long long timeoutMicroseconds);
+
         bool empty() const;
 
         void stop();
@@ -48,12 +71,34 @@ namespace op
 
         bool isRunning() const;
 
+        /**
+         * It returns whether a new element would have to wait. It is always false if the overflow policy drops
+         * elements (i.e., it is not QueueOverflowPolicy::Block).
+         */
         bool isFull() const;
 
         size_t size() const;
 
         void clear();
 
+        /**
+         * It sets what the try* and waitAnd* push/emplace functions do if the queue is full (see
+         * QueueOverflowPolicy). The force* functions always drop the oldest element.
+         */
+        void setOverflowPolicy(const QueueOverflowPolicy overflowPolicy);
+
+        /**
+         * It returns the number of elements dropped so far due to the overflow policy.
+         */
+        unsigned long long getNumberDropped() const;
+
+        /**
+         * It changes the maximum number of elements of the queue while it is running (e.g., by the
+         * ThreadManager auto-configuration). Elements already above the new size are kept (the pushers wait until
+         * they are popped). -1 sets it back to automatic (as many elements as pushers or poppers).
+         */
+        void setMaxSize(const long long maxSize);
+
         virtual TDatums front() const = 0;
 
     protected:
@@ -71,7 +116,9 @@ namespace op
         unsigned long long getMaxSize() const;
 
     private:
-        const long long mMaxSize;
+        long long mMaxSize;
+        QueueOverflowPolicy mOverflowPolicy;
+        unsigned long long mNumberDropped;
 
         bool emplace(TDatums& tDatums);
 
@@ -81,6 +128,8 @@ namespace op
 
         void updateMaxPoppersPushers();
 
+        bool applyOverflowPolicy();
+
         DELETE_COPY(QueueBase);
     };
 }
@@ -94,13 +143,28 @@ namespace op
 #include <openpose/utilities/fastMath.hpp>
 namespace op
 {
+    // Next element popped by std::queue and std::priority_queue
+    template<typename TDatums, typename TContainer>
+    inline const TDatums& getQueueFront(const std::queue<TDatums, TContainer>& tQueue)
+    {
+        return tQueue.front();
+    }
+
+    template<typename TDatums, typename TContainer, typename TCompare>
+    inline const TDatums& getQueueFront(const std::priority_queue<TDatums, TContainer, TCompare>& tQueue)
+    {
+        return tQueue.top();
+    }
+
     template<typename TDatums, typename TQueue>
     QueueBase<TDatums, TQueue>::QueueBase(const long long maxSize) :
         mPoppers{0ll},
         mPushers{0ll},
         mPopIsStopped{false},
         mPushIsStopped{false},
-        mMaxSize{maxSize}
+        mMaxSize{maxSize},
+        mOverflowPolicy{QueueOverflowPolicy::Block},
+        mNumberDropped{0ull}
     {
     }
 
@@ -143,7 +207,7 @@ namespace op
         try
         {
             const std::lock_guard<std::mutex> lock{mMutex};
-            if (mTQueue.size() >= getMaxSize())
+            if (!applyOverflowPolicy())
                 return false;
             return emplace(tDatums);
         }
@@ -160,7 +224,11 @@ namespace op
         try
         {
             std::unique_lock<std::mutex> lock{mMutex};
-            mConditionVariable.wait(lock, [this]{return mTQueue.size() < getMaxSize() || mPushIsStopped; });
+            if (mOverflowPolicy == QueueOverflowPolicy::Block)
+                mConditionVariable.wait(lock, [this]{return mTQueue.size() < getMaxSize() || mPushIsStopped; });
+            // The new element is dropped (not an error, the queue is still running)
+            else if (!applyOverflowPolicy())
+                return !mPushIsStopped;
             return emplace(tDatums);
         }
         catch (const std::exception& e)
@@ -193,7 +261,7 @@ namespace op
         try
         {
             const std::lock_guard<std::mutex> lock{mMutex};
-            if (mTQueue.size() >= getMaxSize())
+            if (!applyOverflowPolicy())
                 return false;
             return push(tDatums);
         }
@@ -210,7 +278,11 @@ namespace op
         try
         {
             std::unique_lock<std::mutex> lock{mMutex};
-            mConditionVariable.wait(lock, [this]{return mTQueue.size() < getMaxSize() || mPushIsStopped; });
+            if (mOverflowPolicy == QueueOverflowPolicy::Block)
+                mConditionVariable.wait(lock, [this]{return mTQueue.size() < getMaxSize() || mPushIsStopped; });
+            // The new element is dropped (not an error, the queue is still running)
+            else if (!applyOverflowPolicy())
+                return !mPushIsStopped;
             return push(tDatums);
         }
         catch (const std::exception& e)
@@ -250,6 +322,24 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TQueue>
+    bool QueueBase<TDatums, TQueue>::tryPopIf(
+        TDatums& tDatums, const std::function<bool(const TDatums&)>& accept)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            if (mPopIsStopped || mTQueue.empty() || !accept(getQueueFront(mTQueue)))
+                return false;
+            return pop(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
     template<typename TDatums, typename TQueue>
     bool QueueBase<TDatums, TQueue>::waitAndPop(TDatums& tDatums)
     {
@@ -282,6 +372,45 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TQueue>
+    bool QueueBase<TDatums, TQueue>::waitUntilNotEmpty(const long long timeoutMicroseconds)
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{mMutex};
+            mConditionVariable.wait_for(
+                lock, std::chrono::microseconds{timeoutMicroseconds},
+                [this]{return !mTQueue.empty() || mPopIsStopped || mPushIsStopped; });
+            return !mTQueue.empty();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    bool QueueBase<TDatums, TQueue>::waitUntilNotFull(const long long timeoutMicroseconds)
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{mMutex};
+            const auto isNotFull = [this]{
+                return mOverflowPolicy != QueueOverflowPolicy::Block || mTQueue.size() < getMaxSize();
+            };
+            mConditionVariable.wait_for(
+                lock, std::chrono::microseconds{timeoutMicroseconds},
+                [this, &isNotFull]{return isNotFull() || mPushIsStopped; });
+            return isNotFull();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
     template<typename TDatums, typename TQueue>
     bool QueueBase<TDatums, TQueue>::empty() const
     {
@@ -391,7 +520,7 @@ namespace op
         try
         {
             // No mutex required because the size() and getMaxSize() are already thread-safe
-            return size() == getMaxSize();
+            return mOverflowPolicy == QueueOverflowPolicy::Block && size() == getMaxSize();
         }
         catch (const std::exception& e)
         {
@@ -430,6 +559,53 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::setOverflowPolicy(const QueueOverflowPolicy overflowPolicy)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mOverflowPolicy = overflowPolicy;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    unsigned long long QueueBase<TDatums, TQueue>::getNumberDropped() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            return mNumberDropped;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::setMaxSize(const long long maxSize)
+    {
+        try
+        {
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                mMaxSize = maxSize;
+            }
+            // Pushers waiting for space might be able to push now
+            mConditionVariable.notify_all();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template<typename TDatums, typename TQueue>
     unsigned long long QueueBase<TDatums, TQueue>::getMaxSize() const
     {
@@ -514,6 +690,44 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TQueue>
+    bool QueueBase<TDatums, TQueue>::applyOverflowPolicy()
+    {
+        try
+        {
+            // It must be called with mMutex locked. It returns whether the new element can be pushed.
+            if (mOverflowPolicy == QueueOverflowPolicy::KeepLatest)
+            {
+                while (!mTQueue.empty())
+                {
+                    mTQueue.pop();
+                    mNumberDropped++;
+                }
+                return true;
+            }
+            if (mTQueue.size() < getMaxSize())
+                return true;
+            if (mOverflowPolicy == QueueOverflowPolicy::DropOldest)
+            {
+                while (mTQueue.size() >= getMaxSize())
+                {
+                    mTQueue.pop();
+                    mNumberDropped++;
+                }
+                return true;
+            }
+            else if (mOverflowPolicy == QueueOverflowPolicy::DropNewest)
+                mNumberDropped++;
+            // Block (or DropNewest): No space for the new element
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
     extern template class QueueBase<BASE_DATUMS_SH, std::queue<BASE_DATUMS_SH>>;
     extern template class QueueBase<
         BASE_DATUMS_SH,
@@ -0,0 +1,912 @@
+#ifndef OPENPOSE_THREAD_RING_BUFFER_QUEUE_HPP
+#define OPENPOSE_THREAD_RING_BUFFER_QUEUE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <functional> // std::function
+#include <mutex>
+#include <vector>
+#include <openpose/core/common.hpp>
+#include <openpose/thread/enumClasses.hpp>
+
+namespace op
+{
+    /**
+     * Bounded lock-free multi-producer multi-consumer (MPMC) ring buffer. It follows the same contract than Queue
+     * (i.e., it can be used as TQueue of ThreadManager, SubThreadQueueIn/InOut/Out and WrapperT), but push and pop do not
+     * take any lock. Each slot keeps its own sequence number, so producers and consumers only contend on 2 atomic
+     * indexes.
+     * The wait* functions spin for a few iterations and then park the thread on a condition variable, which is only
+     * notified if some thread is actually parked. Thus, the uncontended path never touches a mutex.
+     */
+    template<typename TDatums>
+    class RingBufferQueue
+    {
+    public:
+        /**
+         * @param maxSize Maximum number of elements. If <= 0, it will be automatically set to the maximum between the
+         * number of poppers and pushers connected to the queue (same behavior than Queue).
+         */
+        explicit RingBufferQueue(const long long maxSize = -1);
+
+        virtual ~RingBufferQueue();
+
+        bool forceEmplace(TDatums& tDatums);
+
+        bool tryEmplace(TDatums& tDatums);
+
+        bool waitAndEmplace(TDatums& tDatums);
+
+        bool forcePush(const TDatums& tDatums);
+
+        bool tryPush(const TDatums& tDatums);
+
+        bool waitAndPush(const TDatums& tDatums);
+
+        bool tryPop(TDatums& tDatums);
+
+        bool tryPop();
+
+        /**
+         * Analogous to QueueBase::tryPopIf(). The filtered poppers are serialized by a mutex (only taken by this
+         * function), so no other one moves the element out while accept() reads it. Thus, all the consumers of the
+         * queue must pop with this function (e.g., all the threads whose first TWorker filters its input).
+         */
+        bool tryPopIf(TDatums& tDatums, const std::function<bool(const TDatums&)>& accept);
+
+        bool waitAndPop(TDatums& tDatums);
+
+        bool waitAndPop();
+
+        /**
+         * It spins and parks (same than the wait* functions) until there is an element to pop, the queue is stopped,
+         * or timeoutMicroseconds pass, and it returns whether there is an element.
+         */
+        bool waitUntilNotEmpty(const long long timeoutMicroseconds);
+
+        /**
+         * Analogous to waitUntilNotEmpty() for isFull(): It returns whether a new element can be pushed without
+         * waiting.
+         */
+        bool waitUntilNotFull(const long long timeoutMicroseconds);
+
+        bool empty() const;
+
+        void stop();
+
+        void stopPusher();
+
+        void addPopper();
+
+        void addPusher();
+
+        bool isRunning() const;
+
+        /**
+         * It returns whether a new element would have to wait. It is always false if the overflow policy drops
+         * elements (i.e., it is not QueueOverflowPolicy::Block).
+         */
+        bool isFull() const;
+
+        size_t size() const;
+
+        void clear();
+
+        /**
+         * It sets what the try* and waitAnd* push/emplace functions do if the queue is full (see
+         * QueueOverflowPolicy). The force* functions always drop the oldest element.
+         * Not thread-safe, it must be set before the queue is used (e.g., by ThreadManager).
+         */
+        void setOverflowPolicy(const QueueOverflowPolicy overflowPolicy);
+
+        /**
+         * It returns the number of elements dropped so far due to the overflow policy.
+         */
+        unsigned long long getNumberDropped() const;
+
+        /**
+         * Analogous to QueueBase::setMaxSize(), thread-safe. The ring buffer keeps the capacity allocated by the
+         * constructor (256 elements if automatically sized), so larger sizes are truncated to it.
+         */
+        void setMaxSize(const long long maxSize);
+
+        /**
+         * It returns a copy of the oldest element (or an empty TDatums if the queue is empty). Note that other consumers
+         * might pop it at any time, so the result is only reliable with a single consumer.
+         */
+        TDatums front() const;
+
+    private:
+        struct Cell
+        {
+            std::atomic<unsigned long long> sequence;
+            TDatums tDatums;
+        };
+        // Cache line padding to avoid false sharing between producer and consumer indexes
+        static const unsigned int CACHE_LINE_SIZE = 64u;
+
+        std::atomic<long long> mMaxSize;
+        const unsigned long long mCapacityMask;
+        std::vector<Cell> mCells;
+        char mPadding0[CACHE_LINE_SIZE];
+        std::atomic<unsigned long long> mPushPosition;
+        char mPadding1[CACHE_LINE_SIZE];
+        std::atomic<unsigned long long> mPopPosition;
+        char mPadding2[CACHE_LINE_SIZE];
+        std::atomic<long long> mPoppers;
+        std::atomic<long long> mPushers;
+        std::atomic<long long> mMaxPoppersPushers;
+        std::atomic<bool> mPopIsStopped;
+        std::atomic<bool> mPushIsStopped;
+        QueueOverflowPolicy mOverflowPolicy;
+        std::atomic<unsigned long long> mNumberDropped;
+        // Parking (only used after spinning)
+        std::atomic<int> mParkedThreads;
+        std::mutex mParkingMutex;
+        std::condition_variable mConditionVariable;
+        // Filtered pops (tryPopIf())
+        std::mutex mFilteredPopMutex;
+
+        bool emplace(TDatums& tDatums);
+
+        bool pop(TDatums& tDatums);
+
+        bool drop();
+
+        bool applyOverflowPolicy();
+
+        unsigned long long getMaxSize() const;
+
+        void updateMaxPoppersPushers();
+
+        void notifyParkedThreads();
+
+        /**
+         * It returns the final value of condition(). If timeoutMicroseconds < 0, it waits until condition() is true.
+         */
+        template<typename TCondition>
+        bool spinAndPark(const TCondition& condition, const long long timeoutMicroseconds = -1);
+
+        DELETE_COPY(RingBufferQueue);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <chrono>
+#include <thread>
+#include <openpose/core/datum.hpp>
+#include <openpose/utilities/fastMath.hpp>
+namespace op
+{
+    // Iterations that wait* functions busy-poll before parking the thread
+    const auto RING_BUFFER_QUEUE_SPINS = 256;
+    // Maximum time parked before re-checking the queue (safety net, notify is the main wake-up mechanism)
+    const auto RING_BUFFER_QUEUE_PARK_MICROSECONDS = 1000;
+
+    inline unsigned long long getRingBufferQueueCapacity(const long long maxSize)
+    {
+        // Power of 2 (fast index wrapping), able to hold maxSize elements (or 256 if automatically sized)
+        const auto minimumCapacity = (maxSize > 0 ? (unsigned long long)maxSize : 256ull);
+        auto capacity = 2ull;
+        while (capacity < minimumCapacity)
+            capacity <<= 1;
+        return capacity;
+    }
+
+    template<typename TDatums>
+    RingBufferQueue<TDatums>::RingBufferQueue(const long long maxSize) :
+        mMaxSize{maxSize},
+        mCapacityMask{getRingBufferQueueCapacity(maxSize) - 1},
+        mCells(mCapacityMask + 1),
+        mPushPosition{0ull},
+        mPopPosition{0ull},
+        mPoppers{0ll},
+        mPushers{0ll},
+        mMaxPoppersPushers{0ll},
+        mPopIsStopped{false},
+        mPushIsStopped{false},
+        mOverflowPolicy{QueueOverflowPolicy::Block},
+        mNumberDropped{0ull},
+        mParkedThreads{0}
+    {
+        try
+        {
+            for (auto i = 0ull ; i < mCells.size() ; i++)
+                mCells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    RingBufferQueue<TDatums>::~RingBufferQueue()
+    {
+        try
+        {
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            stop();
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::forceEmplace(TDatums& tDatums)
+    {
+        try
+        {
+            if (size() >= getMaxSize())
+                drop();
+            return emplace(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::tryEmplace(TDatums& tDatums)
+    {
+        try
+        {
+            if (!applyOverflowPolicy())
+                return false;
+            return emplace(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::waitAndEmplace(TDatums& tDatums)
+    {
+        try
+        {
+            // Several producers might see the same free slot, so retry until emplaced or stopped
+            while (true)
+            {
+                if (mOverflowPolicy == QueueOverflowPolicy::Block)
+                    spinAndPark([this]{ return size() < getMaxSize() || mPushIsStopped; });
+                // The new element is dropped (not an error, the queue is still running)
+                else if (!applyOverflowPolicy())
+                    return !mPushIsStopped;
+                if (mPushIsStopped)
+                    return false;
+                if (emplace(tDatums))
+                    return true;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::forcePush(const TDatums& tDatums)
+    {
+        try
+        {
+            auto tDatumsCopy = tDatums;
+            return forceEmplace(tDatumsCopy);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::tryPush(const TDatums& tDatums)
+    {
+        try
+        {
+            auto tDatumsCopy = tDatums;
+            return tryEmplace(tDatumsCopy);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::waitAndPush(const TDatums& tDatums)
+    {
+        try
+        {
+            auto tDatumsCopy = tDatums;
+            return waitAndEmplace(tDatumsCopy);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::tryPop(TDatums& tDatums)
+    {
+        try
+        {
+            return pop(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::tryPop()
+    {
+        try
+        {
+            TDatums tDatums;
+            return pop(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::tryPopIf(
+        TDatums& tDatums, const std::function<bool(const TDatums&)>& accept)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mFilteredPopMutex};
+            if (mPopIsStopped)
+                return false;
+            const auto position = mPopPosition.load(std::memory_order_acquire);
+            auto& cell = mCells[position & mCapacityMask];
+            // Empty or rejected
+            if (cell.sequence.load(std::memory_order_acquire) != position + 1 || !accept(cell.tDatums))
+                return false;
+            return pop(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::waitAndPop(TDatums& tDatums)
+    {
+        try
+        {
+            // Several consumers might see the same element, so retry until popped or stopped
+            while (true)
+            {
+                spinAndPark([this]{ return !empty() || mPopIsStopped || mPushIsStopped; });
+                if (pop(tDatums))
+                    return true;
+                if (mPopIsStopped || (mPushIsStopped && empty()))
+                    return false;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::waitAndPop()
+    {
+        try
+        {
+            TDatums tDatums;
+            return waitAndPop(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::waitUntilNotEmpty(const long long timeoutMicroseconds)
+    {
+        try
+        {
+            spinAndPark([this]{ return !empty() || mPopIsStopped || mPushIsStopped; }, timeoutMicroseconds);
+            return !empty();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::waitUntilNotFull(const long long timeoutMicroseconds)
+    {
+        try
+        {
+            spinAndPark([this]{ return !isFull() || mPushIsStopped; }, timeoutMicroseconds);
+            return !isFull();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::empty() const
+    {
+        try
+        {
+            return size() == 0;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    void RingBufferQueue<TDatums>::stop()
+    {
+        try
+        {
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            mPushIsStopped = true;
+            mPopIsStopped = true;
+            clear();
+            // Wake up every thread, whether parked or not
+            const std::lock_guard<std::mutex> lock{mParkingMutex};
+            mConditionVariable.notify_all();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void RingBufferQueue<TDatums>::stopPusher()
+    {
+        try
+        {
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            if (--mPushers == 0)
+            {
+                mPushIsStopped = true;
+                if (empty())
+                    mPopIsStopped = true;
+                const std::lock_guard<std::mutex> lock{mParkingMutex};
+                mConditionVariable.notify_all();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void RingBufferQueue<TDatums>::addPopper()
+    {
+        try
+        {
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            mPoppers++;
+            updateMaxPoppersPushers();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void RingBufferQueue<TDatums>::addPusher()
+    {
+        try
+        {
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            mPushers++;
+            updateMaxPoppersPushers();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::isRunning() const
+    {
+        try
+        {
+            return !(mPushIsStopped && (mPopIsStopped || empty()));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::isFull() const
+    {
+        try
+        {
+            return mOverflowPolicy == QueueOverflowPolicy::Block && size() >= getMaxSize();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    size_t RingBufferQueue<TDatums>::size() const
+    {
+        try
+        {
+            // Pop position is read first, so the difference can never be negative
+            const auto popPosition = mPopPosition.load(std::memory_order_acquire);
+            const auto pushPosition = mPushPosition.load(std::memory_order_acquire);
+            return size_t(pushPosition > popPosition ? pushPosition - popPosition : 0ull);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0;
+        }
+    }
+
+    template<typename TDatums>
+    void RingBufferQueue<TDatums>::clear()
+    {
+        try
+        {
+            while (size() > 0)
+                drop();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void RingBufferQueue<TDatums>::setOverflowPolicy(const QueueOverflowPolicy overflowPolicy)
+    {
+        try
+        {
+            mOverflowPolicy = overflowPolicy;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    unsigned long long RingBufferQueue<TDatums>::getNumberDropped() const
+    {
+        try
+        {
+            return mNumberDropped.load();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    template<typename TDatums>
+    void RingBufferQueue<TDatums>::setMaxSize(const long long maxSize)
+    {
+        try
+        {
+            mMaxSize = maxSize;
+            // Pushers parked on a full queue might be able to push now
+            notifyParkedThreads();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    TDatums RingBufferQueue<TDatums>::front() const
+    {
+        try
+        {
+            const auto position = mPopPosition.load(std::memory_order_acquire);
+            const auto& cell = mCells[position & mCapacityMask];
+            if (cell.sequence.load(std::memory_order_acquire) == position + 1)
+                return cell.tDatums;
+            return TDatums{};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return TDatums{};
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::emplace(TDatums& tDatums)
+    {
+        try
+        {
+            if (mPushIsStopped)
+                return false;
+
+            auto position = mPushPosition.load(std::memory_order_relaxed);
+            while (true)
+            {
+                auto& cell = mCells[position & mCapacityMask];
+                const auto sequence = cell.sequence.load(std::memory_order_acquire);
+                const auto difference = (long long)(sequence - position);
+                // Free slot -> reserve it
+                if (difference == 0)
+                {
+                    if (mPushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        cell.tDatums = std::move(tDatums);
+                        cell.sequence.store(position + 1, std::memory_order_release);
+                        notifyParkedThreads();
+                        return true;
+                    }
+                }
+                // Buffer physically full
+                else if (difference < 0)
+                    return false;
+                // Another producer took this slot
+                else
+                    position = mPushPosition.load(std::memory_order_relaxed);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::pop(TDatums& tDatums)
+    {
+        try
+        {
+            if (mPopIsStopped)
+                return false;
+
+            auto position = mPopPosition.load(std::memory_order_relaxed);
+            while (true)
+            {
+                auto& cell = mCells[position & mCapacityMask];
+                const auto sequence = cell.sequence.load(std::memory_order_acquire);
+                const auto difference = (long long)(sequence - (position + 1));
+                // Filled slot -> take it
+                if (difference == 0)
+                {
+                    if (mPopPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        tDatums = std::move(cell.tDatums);
+                        cell.tDatums = TDatums{};
+                        cell.sequence.store(position + mCapacityMask + 1, std::memory_order_release);
+                        notifyParkedThreads();
+                        return true;
+                    }
+                }
+                // Empty
+                else if (difference < 0)
+                    return false;
+                // Another consumer took this element
+                else
+                    position = mPopPosition.load(std::memory_order_relaxed);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::drop()
+    {
+        try
+        {
+            // Same than pop(), but ignoring mPopIsStopped (used by stop() and clear()). It returns whether an element
+            // was dropped
+            auto position = mPopPosition.load(std::memory_order_relaxed);
+            while (true)
+            {
+                auto& cell = mCells[position & mCapacityMask];
+                const auto sequence = cell.sequence.load(std::memory_order_acquire);
+                const auto difference = (long long)(sequence - (position + 1));
+                if (difference == 0)
+                {
+                    if (mPopPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        cell.tDatums = TDatums{};
+                        cell.sequence.store(position + mCapacityMask + 1, std::memory_order_release);
+                        notifyParkedThreads();
+                        return true;
+                    }
+                }
+                else if (difference < 0)
+                    return false;
+                else
+                    position = mPopPosition.load(std::memory_order_relaxed);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool RingBufferQueue<TDatums>::applyOverflowPolicy()
+    {
+        try
+        {
+            // It returns whether the new element can be pushed
+            if (mOverflowPolicy == QueueOverflowPolicy::KeepLatest)
+            {
+                while (size() > 0)
+                    if (drop())
+                        mNumberDropped++;
+                return true;
+            }
+            if (size() < getMaxSize())
+                return true;
+            if (mOverflowPolicy == QueueOverflowPolicy::DropOldest)
+            {
+                while (size() >= getMaxSize())
+                    if (drop())
+                        mNumberDropped++;
+                return true;
+            }
+            else if (mOverflowPolicy == QueueOverflowPolicy::DropNewest)
+                mNumberDropped++;
+            // Block (or DropNewest): No space for the new element
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    unsigned long long RingBufferQueue<TDatums>::getMaxSize() const
+    {
+        try
+        {
+            const auto maxSizeSet = mMaxSize.load();
+            const auto maxSize = (maxSizeSet > 0 ? maxSizeSet : fastMax(1ll, mMaxPoppersPushers.load()));
+            return fastMin((unsigned long long)maxSize, mCapacityMask + 1);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 1ull;
+        }
+    }
+
+    template<typename TDatums>
+    void RingBufferQueue<TDatums>::updateMaxPoppersPushers()
+    {
+        try
+        {
+            mMaxPoppersPushers = fastMax(mPoppers.load(), mPushers.load());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void RingBufferQueue<TDatums>::notifyParkedThreads()
+    {
+        try
+        {
+            // Full fence + sequentially consistent load, paired with the increment in spinAndPark(), so a thread that
+            // is about to park is either seen here or sees the new state before waiting
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (mParkedThreads.load() > 0)
+            {
+                const std::lock_guard<std::mutex> lock{mParkingMutex};
+                mConditionVariable.notify_all();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    template<typename TCondition>
+    bool RingBufferQueue<TDatums>::spinAndPark(const TCondition& condition, const long long timeoutMicroseconds)
+    {
+        try
+        {
+            // Spin
+            for (auto i = 0 ; i < RING_BUFFER_QUEUE_SPINS ; i++)
+            {
+                if (condition())
+                    return true;
+                std::this_thread::yield();
+            }
+            // Park
+            const auto deadline = std::chrono::steady_clock::now()
+                                + std::chrono::microseconds{fastMax(0ll, timeoutMicroseconds)};
+            std::unique_lock<std::mutex> lock{mParkingMutex};
+            mParkedThreads++;
+            auto conditionIsMet = condition();
+            while (!conditionIsMet)
+            {
+                auto wakeUp = std::chrono::steady_clock::now()
+                            + std::chrono::microseconds{RING_BUFFER_QUEUE_PARK_MICROSECONDS};
+                if (timeoutMicroseconds >= 0)
+                {
+                    if (std::chrono::steady_clock::now() >= deadline)
+                        break;
+                    wakeUp = fastMin(wakeUp, deadline);
+                }
+                mConditionVariable.wait_until(lock, wakeUp);
+                conditionIsMet = condition();
+            }
+            mParkedThreads--;
+            return conditionIsMet;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(RingBufferQueue);
+}
+
+#endif // OPENPOSE_THREAD_RING_BUFFER_QUEUE_HPP
@@ -1,8 +1,13 @@
 #ifndef OPENPOSE_THREAD_SUB_THREAD_HPP
 #define OPENPOSE_THREAD_SUB_THREAD_HPP
 
+#include <chrono>
 #include <openpose/core/common.hpp>
+#include <openpose/core/datumTiming.hpp>
 #include <openpose/thread/worker.hpp>
+#include <openpose/utilities/allocationTracker.hpp>
+#include <openpose/utilities/metrics.hpp>
+#include <openpose/utilities/tracer.hpp>
 
 namespace op
 {
@@ -19,6 +24,35 @@ namespace op
 
         virtual bool work() = 0;
 
+        /**
+         * It registers the Metrics and Tracer names of this SubThread: the work() time of each TWorker and, if it has
+         * an input queue, the time waiting for a new element and the queue size (and, for the Tracer, the time
+         * blocked by a full output queue). They are only recorded while Metrics::isEnabled() or
+         * Tracer::isEnabled(). ThreadManager calls it with the ids given to ThreadManager::add().
+         * While AllocationTracker::isEnabled() too, the memory allocated and copied by each TWorker is also recorded.
+         * While DatumTiming::isEnabled(), the same worker calls and queue waits are also recorded into the
+         * Datum::timing of each processed Datum.
+         */
+        void setInstrumentationIds(
+            const unsigned long long threadId, const unsigned long long queueInId,
+            const unsigned long long queueOutId);
+
+        /**
+         * Maximum time that work() blocks waiting for an element in its input queue (or for space in its output
+         * queue) before calling the TWorkers anyway, e.g., so WQueueOrderer can release its frames after a timeout.
+         * Pushes and pops wake it up right away, so lower values do not reduce the latency. It defaults to
+         * SUB_THREAD_QUEUE_WAIT_MICROSECONDS. ThreadPool lowers it, so an idle task does not keep its pool thread
+         * from running the other tasks.
+         */
+        void setQueueWaitMicroseconds(const long long queueWaitMicroseconds);
+
+        /**
+         * If not nullptr, the time of all its TWorkers (on each work() call that received or produced some TDatums)
+         * is recorded into serviceTimeHistogram, regardless of Metrics::isEnabled() (e.g., for the ThreadManager
+         * auto-configuration).
+         */
+        void setServiceTimeHistogram(const std::shared_ptr<Histogram>& serviceTimeHistogram);
+
     protected:
         inline size_t getTWorkersSize() const
         {
@@ -27,8 +61,76 @@ namespace op
 
         bool workTWorkers(TDatums& tDatums, const bool inputIsRunning);
 
+        /**
+         * To be called after each successful pop from the input queue, with the queue size right before the pop.
+         * The waiting time is the time since the previous element finished or, if later, since the output queue
+         * stopped being full (see recordQueueOutFull()).
+         */
+        void recordQueueInMetrics(const size_t queueSize);
+
+        /**
+         * To be called after each successful pop from the input queue, with the queue size right after the pop. It
+         * sets the Worker::getQueueInBacklog() of its TWorkers.
+         */
+        void setQueueInBacklog(const size_t queueInBacklog);
+
+        /**
+         * Worker::isReadyForInput() of its first TWorker.
+         */
+        inline bool tWorkersAreReadyForInput(const size_t queueInSize)
+        {
+            return mTWorkers.front()->isReadyForInput(queueInSize);
+        }
+
+        /**
+         * Worker::filtersInput() of its first TWorker.
+         */
+        inline bool tWorkersFilterInput() const
+        {
+            return mTWorkers.front()->filtersInput();
+        }
+
+        /**
+         * Worker::acceptsInput() of its first TWorker.
+         */
+        inline bool tWorkersAcceptInput(const TDatums& tDatums)
+        {
+            return mTWorkers.front()->acceptsInput(tDatums);
+        }
+
+        /**
+         * To be called on each work() iteration of the SubThreads with an output queue, indicating whether it is
+         * full (so they must wait for it). The time blocked is recorded as a Tracer event.
+         */
+        void recordQueueOutFull(const bool queueOutIsFull);
+
+        inline long long getQueueWaitMicroseconds() const
+        {
+            return mQueueWaitMicroseconds;
+        }
+
     private:
         std::vector<TWorker> mTWorkers;
+        std::string mMetricsThreadId;
+        std::string mMetricsQueueInId;
+        std::vector<std::shared_ptr<Histogram>> mWorkHistograms;
+        std::vector<std::string> mWorkerLabels;
+        // Per TWorker: host and GPU allocations, host and GPU allocated bytes, and copied bytes per MemoryCopy
+        std::vector<std::vector<std::shared_ptr<Histogram>>> mAllocationHistograms;
+        std::shared_ptr<Histogram> spQueueWaitHistogram;
+        std::shared_ptr<Histogram> spQueueSizeHistogram;
+        std::shared_ptr<Histogram> spServiceTimeHistogram;
+        std::vector<const char*> mTraceWorkerNames;
+        const char* pTraceQueueInName;
+        const char* pTraceQueueOutName;
+        const char* pTimingQueueInName;
+        std::chrono::high_resolution_clock::time_point mLastWorkEnd;
+        bool mQueueOutIsFull;
+        std::chrono::high_resolution_clock::time_point mQueueOutFullBegin;
+        long long mQueueWaitMicroseconds;
+
+        // It records the allocations and copies of 1 work() call of the TWorker workerIndex
+        void recordAllocationMetrics(const unsigned int workerIndex, const AllocationCounters& allocationCounters);
 
         DELETE_COPY(SubThread);
     };
@@ -41,9 +143,18 @@ namespace op
 // Implementation
 namespace op
 {
+    // Maximum time blocked on a queue in each SubThread::work() iteration (safety net, pushes/pops wake it up)
+    const auto SUB_THREAD_QUEUE_WAIT_MICROSECONDS = 1000ll;
+
     template<typename TDatums, typename TWorker>
     SubThread<TDatums, TWorker>::SubThread(const std::vector<TWorker>& tWorkers) :
-        mTWorkers{tWorkers}
+        mTWorkers{tWorkers},
+        pTraceQueueInName{nullptr},
+        pTraceQueueOutName{nullptr},
+        pTimingQueueInName{nullptr},
+        mLastWorkEnd{std::chrono::high_resolution_clock::now()},
+        mQueueOutIsFull{false},
+        mQueueWaitMicroseconds{SUB_THREAD_QUEUE_WAIT_MICROSECONDS}
     {
     }
 
@@ -74,11 +185,33 @@ namespace op
                 // Iterate over all workers and check whether some of them stopped
                 auto allRunning = true;
                 auto lastOneStopped = false;
-                for (auto& worker : mTWorkers)
+                const auto recordMetrics = Metrics::isEnabled() && !mWorkHistograms.empty();
+                const auto recordAllocations = recordMetrics && AllocationTracker::isEnabled();
+                const auto recordTrace = Tracer::isEnabled() && !mTraceWorkerNames.empty();
+                const auto recordTiming = DatumTiming::isEnabled() && !mTraceWorkerNames.empty();
+                const auto hadTDatumsBegin = (tDatums != nullptr);
+                // Time waited in the input queue (since the previous SubThread pushed it)
+                if (recordTiming && hadTDatumsBegin)
+                {
+                    const auto queueEnd = DatumTiming::now();
+                    forEachDatumTiming(tDatums, [&](DatumTiming& datumTiming) {
+                        datumTiming.closeQueue(pTimingQueueInName, queueEnd); });
+                }
+                const auto serviceBegin = (spServiceTimeHistogram != nullptr
+                    ? std::chrono::high_resolution_clock::now() : std::chrono::high_resolution_clock::time_point{});
+                for (auto i = 0u ; i < mTWorkers.size() ; i++)
                 {
+                    auto& worker = mTWorkers[i];
                     if (lastOneStopped)
                         worker->tryStop();
 
+                    const auto hadTDatums = (tDatums != nullptr);
+                    const auto traceId = (recordTrace && hadTDatums ? getTraceId(tDatums) : -1ll);
+                    const auto workBegin = (recordMetrics || recordTrace
+                        ? std::chrono::high_resolution_clock::now() : std::chrono::high_resolution_clock::time_point{});
+                    const auto allocationsBegin = (
+                        recordAllocations ? AllocationTracker::getThreadCounters() : AllocationCounters{});
+                    const auto timingBegin = (recordTiming ? DatumTiming::now() : 0ll);
                     if (!worker->checkAndWork(tDatums))
                     {
                         allRunning = false;
@@ -86,7 +219,37 @@ namespace op
                     }
                     else
                         lastOneStopped = false;
+                    // The call is recorded into the TDatums it returns (e.g., the new ones of a producer)
+                    if (recordTiming && tDatums != nullptr)
+                    {
+                        const auto timingEnd = DatumTiming::now();
+                        forEachDatumTiming(tDatums, [&](DatumTiming& datumTiming) {
+                            datumTiming.record(mTraceWorkerNames[i], timingBegin, timingEnd); });
+                    }
+                    // Only the calls that received or produced some TDatums are actual work
+                    if ((recordMetrics || recordTrace) && (hadTDatums || tDatums != nullptr))
+                    {
+                        const auto workEnd = std::chrono::high_resolution_clock::now();
+                        if (recordMetrics)
+                            mWorkHistograms[i]->record(Metrics::getMicroseconds(workBegin, workEnd));
+                        if (recordAllocations)
+                            recordAllocationMetrics(i, AllocationTracker::getThreadCounters() - allocationsBegin);
+                        if (recordTrace)
+                            Tracer::record(
+                                mTraceWorkerNames[i], (hadTDatums ? traceId : getTraceId(tDatums)), workBegin,
+                                workEnd);
+                    }
                 }
+                if (tDatums != nullptr)
+                    mLastWorkEnd = std::chrono::high_resolution_clock::now();
+                if (recordTiming && tDatums != nullptr)
+                {
+                    const auto queueBegin = DatumTiming::now();
+                    forEachDatumTiming(tDatums, [&](DatumTiming& datumTiming) { datumTiming.openQueue(queueBegin); });
+                }
+                if (spServiceTimeHistogram != nullptr && (hadTDatumsBegin || tDatums != nullptr))
+                    spServiceTimeHistogram->record(
+                        Metrics::getMicroseconds(serviceBegin, std::chrono::high_resolution_clock::now()));
 
                 if (allRunning)
                     return true;
@@ -142,6 +305,8 @@ namespace op
     {
         try
         {
+            if (!mMetricsThreadId.empty())
+                Tracer::setThreadName("Thread " + mMetricsThreadId);
             for (auto& tWorker : mTWorkers)
                 tWorker->initializationOnThreadNoException();
         }
@@ -151,6 +316,174 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TWorker>
+    void SubThread<TDatums, TWorker>::setInstrumentationIds(
+        const unsigned long long threadId, const unsigned long long queueInId, const unsigned long long queueOutId)
+    {
+        try
+        {
+            mMetricsThreadId = std::to_string(threadId);
+            mMetricsQueueInId = std::to_string(queueInId);
+            mWorkHistograms.resize(mTWorkers.size());
+            mWorkerLabels.resize(mTWorkers.size());
+            mAllocationHistograms.clear();
+            mAllocationHistograms.resize(mTWorkers.size());
+            mTraceWorkerNames.resize(mTWorkers.size());
+            for (auto i = 0u ; i < mTWorkers.size() ; i++)
+            {
+                const auto typeName = Metrics::getTypeName(typeid(*mTWorkers[i]));
+                mWorkerLabels[i] = "thread=\"" + mMetricsThreadId + "\",worker=\"" + std::to_string(i) + "\",type=\""
+                    + typeName + "\"";
+                mWorkHistograms[i] = Metrics::getHistogram(
+                    "openpose_worker_seconds", mWorkerLabels[i],
+                    "Time spent on Worker::work() per processed element.", true);
+                mTraceWorkerNames[i] = Tracer::getName(typeName);
+            }
+            pTraceQueueInName = Tracer::getName("Waiting for queue " + mMetricsQueueInId);
+            pTraceQueueOutName = Tracer::getName("Blocked by full queue " + std::to_string(queueOutId));
+            pTimingQueueInName = Tracer::getName("Queue " + mMetricsQueueInId);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void SubThread<TDatums, TWorker>::recordAllocationMetrics(
+        const unsigned int workerIndex, const AllocationCounters& allocationCounters)
+    {
+        try
+        {
+            auto& histograms = mAllocationHistograms.at(workerIndex);
+            // Registered on the first record, so they are not exported unless AllocationTracker is enabled
+            if (histograms.empty())
+            {
+                const auto& labels = mWorkerLabels.at(workerIndex);
+                for (const auto& device : {"cpu", "gpu"})
+                    histograms.emplace_back(Metrics::getHistogram(
+                        "openpose_worker_allocations", labels + ",device=\"" + device + "\"",
+                        "Memory allocations per processed element (see AllocationTracker).", false));
+                for (const auto& device : {"cpu", "gpu"})
+                    histograms.emplace_back(Metrics::getHistogram(
+                        "openpose_worker_allocated_bytes", labels + ",device=\"" + device + "\"",
+                        "Bytes of memory allocated per processed element (see AllocationTracker).", false));
+                for (const auto& direction : {"host_to_host", "host_to_device", "device_to_host", "device_to_device"})
+                    histograms.emplace_back(Metrics::getHistogram(
+                        "openpose_worker_copied_bytes", labels + ",direction=\"" + direction + "\"",
+                        "Bytes of memory copied per processed element (see AllocationTracker).", false));
+            }
+            histograms[0]->record(allocationCounters.hostAllocations);
+            histograms[1]->record(allocationCounters.gpuAllocations);
+            histograms[2]->record(allocationCounters.hostAllocatedBytes);
+            histograms[3]->record(allocationCounters.gpuAllocatedBytes);
+            for (auto i = 0u ; i < (unsigned char)MemoryCopy::Size ; i++)
+                histograms[4+i]->record(allocationCounters.copiedBytes[i]);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void SubThread<TDatums, TWorker>::setQueueWaitMicroseconds(const long long queueWaitMicroseconds)
+    {
+        try
+        {
+            mQueueWaitMicroseconds = queueWaitMicroseconds;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void SubThread<TDatums, TWorker>::setServiceTimeHistogram(const std::shared_ptr<Histogram>& serviceTimeHistogram)
+    {
+        try
+        {
+            spServiceTimeHistogram = serviceTimeHistogram;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void SubThread<TDatums, TWorker>::recordQueueInMetrics(const size_t queueSize)
+    {
+        try
+        {
+            if (Tracer::isEnabled() && pTraceQueueInName != nullptr)
+                Tracer::record(pTraceQueueInName, -1ll, mLastWorkEnd, std::chrono::high_resolution_clock::now());
+            if (Metrics::isEnabled() && !mMetricsQueueInId.empty())
+            {
+                // Lazily registered, only SubThreads with an input queue call this function
+                if (spQueueWaitHistogram == nullptr)
+                {
+                    spQueueWaitHistogram = Metrics::getHistogram(
+                        "openpose_queue_wait_seconds",
+                        "thread=\"" + mMetricsThreadId + "\",queue=\"" + mMetricsQueueInId + "\"",
+                        "Time each thread waits for a new element of its input queue.", true);
+                    spQueueSizeHistogram = Metrics::getHistogram(
+                        "openpose_queue_size", "queue=\"" + mMetricsQueueInId + "\"",
+                        "Number of elements in the queue when an element is popped.", false);
+                }
+                spQueueWaitHistogram->record(
+                    Metrics::getMicroseconds(mLastWorkEnd, std::chrono::high_resolution_clock::now()));
+                spQueueSizeHistogram->record(queueSize);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void SubThread<TDatums, TWorker>::setQueueInBacklog(const size_t queueInBacklog)
+    {
+        try
+        {
+            for (auto& tWorker : mTWorkers)
+                tWorker->setQueueInBacklog(queueInBacklog);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void SubThread<TDatums, TWorker>::recordQueueOutFull(const bool queueOutIsFull)
+    {
+        try
+        {
+            // Only the transitions (full <-> not full) are timed
+            if (queueOutIsFull != mQueueOutIsFull)
+            {
+                const auto now = std::chrono::high_resolution_clock::now();
+                if (queueOutIsFull)
+                    mQueueOutFullBegin = now;
+                else
+                {
+                    if (Tracer::isEnabled() && pTraceQueueOutName != nullptr)
+                        Tracer::record(pTraceQueueOutName, -1ll, mQueueOutFullBegin, now);
+                    // So the time blocked is not also counted as time waiting for the input queue
+                    mLastWorkEnd = now;
+                }
+                mQueueOutIsFull = queueOutIsFull;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     COMPILE_TEMPLATE_DATUM(SubThread);
 }
 
@@ -51,11 +51,16 @@ namespace op
     {
         try
         {
-            // Pop TDatums
-            if (spTQueueIn->empty())
-                std::this_thread::sleep_for(std::chrono::microseconds{100});
+            // Pop TDatums (woken up as soon as an element is pushed)
+            spTQueueIn->waitUntilNotEmpty(this->getQueueWaitMicroseconds());
             TDatums tDatums;
+            const auto queueSize = (Metrics::isEnabled() ? spTQueueIn->size() : 0);
             bool queueIsRunning = spTQueueIn->tryPop(tDatums);
+            if (queueIsRunning)
+            {
+                this->recordQueueInMetrics(queueSize);
+                this->setQueueInBacklog(spTQueueIn->size());
+            }
             // Check queue not empty
             if (!queueIsRunning)
                 queueIsRunning = spTQueueIn->isRunning();
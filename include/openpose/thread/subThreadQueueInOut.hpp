@@ -22,6 +22,8 @@ namespace op
     private:
         std::shared_ptr<TQueue> spTQueueIn;
         std::shared_ptr<TQueue> spTQueueOut;
+        // Whether the last work() pushed something (e.g., WQueueOrderer releasing its buffered frames one by one)
+        bool mLastWorkHadOutput;
 
         DELETE_COPY(SubThreadQueueInOut);
     };
@@ -40,7 +42,8 @@ namespace op
                                                                        const std::shared_ptr<TQueue>& tQueueOut) :
         SubThread<TDatums, TWorker>{tWorkers},
         spTQueueIn{tQueueIn},
-        spTQueueOut{tQueueOut}
+        spTQueueOut{tQueueOut},
+        mLastWorkHadOutput{false}
     {
         // spTQueueIn->addPopper();
         spTQueueOut->addPusher();
@@ -67,19 +70,47 @@ namespace op
             {
                 // Don't work until next queue is not full
                 // This reduces latency to half
-                if (!spTQueueOut->isFull())
+                const auto queueOutIsFull = spTQueueOut->isFull();
+                this->recordQueueOutFull(queueOutIsFull);
+                if (!queueOutIsFull)
                 {
-                    // Pop TDatums
-                    if (spTQueueIn->empty())
-                        std::this_thread::sleep_for(std::chrono::microseconds{100});
+                    // Pop TDatums (woken up as soon as an element is pushed). No wait if the TWorkers just returned
+                    // something, as they might have more TDatums buffered
+                    if (!mLastWorkHadOutput)
+                        spTQueueIn->waitUntilNotEmpty(this->getQueueWaitMicroseconds());
                     TDatums tDatums;
-                    bool workersAreRunning = spTQueueIn->tryPop(tDatums);
-                    // Check queue not stopped
-                    if (!workersAreRunning)
-                        workersAreRunning = spTQueueIn->isRunning();
+                    const auto queueSize = spTQueueIn->size();
+                    bool workersAreRunning = true;
+                    // Frames left to other threads (e.g., to a faster GPU)
+                    if (!this->tWorkersAreReadyForInput(queueSize))
+                        std::this_thread::sleep_for(std::chrono::microseconds{100});
+                    else
+                    {
+                        // Filtered pop (e.g., only the camera views of this GPU)
+                        const auto filtersInput = this->tWorkersFilterInput();
+                        workersAreRunning = (
+                            filtersInput
+                                ? spTQueueIn->tryPopIf(
+                                    tDatums, [this](const TDatums& next) { return this->tWorkersAcceptInput(next); })
+                                : spTQueueIn->tryPop(tDatums));
+                        if (workersAreRunning)
+                        {
+                            this->recordQueueInMetrics(queueSize);
+                            this->setQueueInBacklog(spTQueueIn->size());
+                        }
+                        // Check queue not stopped
+                        if (!workersAreRunning)
+                        {
+                            workersAreRunning = spTQueueIn->isRunning();
+                            // Next element left to another thread
+                            if (filtersInput && workersAreRunning && !spTQueueIn->empty())
+                                std::this_thread::sleep_for(std::chrono::microseconds{100});
+                        }
+                    }
                     // Process TDatums
                     workersAreRunning = this->workTWorkers(tDatums, workersAreRunning);
                     // Push/emplace tDatums if successfully processed
+                    mLastWorkHadOutput = (tDatums != nullptr);
                     if (workersAreRunning)
                     {
                         if (tDatums != nullptr)
@@ -95,7 +126,7 @@ namespace op
                 }
                 else
                 {
-                    std::this_thread::sleep_for(std::chrono::microseconds{100});
+                    spTQueueOut->waitUntilNotFull(this->getQueueWaitMicroseconds());
                     return true;
                 }
             }
@@ -76,7 +76,7 @@ namespace op
                 }
                 else
                 {
-                    std::this_thread::sleep_for(std::chrono::microseconds{100});
+                    spTQueueOut->waitUntilNotFull(this->getQueueWaitMicroseconds());
                     return true;
                 }
             }
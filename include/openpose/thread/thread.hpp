@@ -4,6 +4,7 @@
 #include <atomic>
 #include <openpose/core/common.hpp>
 #include <openpose/thread/subThread.hpp>
+#include <openpose/thread/threadAffinity.hpp>
 #include <openpose/thread/worker.hpp>
 
 namespace op
@@ -27,6 +28,12 @@ namespace op
 
         void add(const std::shared_ptr<SubThread<TDatums, TWorker>>& subThread);
 
+        /**
+         * It sets the CPU affinity, NUMA node and priority of the thread. It is applied when the thread starts, before
+         * the initialization of its TWorkers, so their host memory is allocated on that NUMA node.
+         */
+        void setAffinity(const ThreadAffinity& threadAffinity);
+
         void exec(const std::shared_ptr<std::atomic<bool>>& isRunningSharedPtr);
 
         void startInThread();
@@ -38,9 +45,15 @@ namespace op
             return *spIsRunning;
         }
 
+        inline bool empty() const
+        {
+            return mSubThreads.empty();
+        }
+
     private:
         std::shared_ptr<std::atomic<bool>> spIsRunning;
         std::vector<std::shared_ptr<SubThread<TDatums, TWorker>>> mSubThreads;
+        ThreadAffinity mThreadAffinity;
         std::thread mThread;
 
         void initializationOnThread();
@@ -73,6 +86,7 @@ namespace op
         spIsRunning{std::make_shared<std::atomic<bool>>(t.spIsRunning->load())}
     {
         std::swap(mSubThreads, t.mSubThreads);
+        std::swap(mThreadAffinity, t.mThreadAffinity);
         std::swap(mThread, t.mThread);
     }
 
@@ -80,6 +94,7 @@ namespace op
     Thread<TDatums, TWorker>& Thread<TDatums, TWorker>::operator=(Thread<TDatums, TWorker>&& t)
     {
         std::swap(mSubThreads, t.mSubThreads);
+        std::swap(mThreadAffinity, t.mThreadAffinity);
         std::swap(mThread, t.mThread);
         spIsRunning = {std::make_shared<std::atomic<bool>>(t.spIsRunning->load())};
         return *this;
@@ -113,6 +128,19 @@ namespace op
         add(std::vector<std::shared_ptr<SubThread<TDatums, TWorker>>>{subThread});
     }
 
+    template<typename TDatums, typename TWorker>
+    void Thread<TDatums, TWorker>::setAffinity(const ThreadAffinity& threadAffinity)
+    {
+        try
+        {
+            mThreadAffinity = threadAffinity;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template<typename TDatums, typename TWorker>
     void Thread<TDatums, TWorker>::exec(const std::shared_ptr<std::atomic<bool>>& isRunningSharedPtr)
     {
@@ -165,6 +193,8 @@ namespace op
         try
         {
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            if (!mThreadAffinity.isDefault())
+                setThreadAffinity(mThreadAffinity);
             for (auto& subThread : mSubThreads)
                 subThread->initializationOnThread();
         }
@@ -0,0 +1,63 @@
+#ifndef OPENPOSE_THREAD_THREAD_AFFINITY_HPP
+#define OPENPOSE_THREAD_THREAD_AFFINITY_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/thread/enumClasses.hpp>
+
+namespace op
+{
+    /**
+     * ThreadAffinity: CPU affinity, NUMA node, OS priority and compute threads of a thread (see
+     * ThreadManager::setThreadAffinity()).
+     * Binding a thread to a NUMA node restricts it to the CPUs of that node and makes its host memory allocations
+     * (e.g., the Caffe blobs and pinned buffers allocated by that thread) prefer that node.
+     * Each setting is only a hint: If the OS does not support it or the process lacks the permissions (e.g., higher
+     * priorities on Linux require CAP_SYS_NICE), a warning is logged and the thread keeps running.
+     */
+    struct OP_API ThreadAffinity
+    {
+        /**
+         * Ids of the CPU cores the thread can run on. If empty (default), any (or the ones of numaNode).
+         */
+        std::vector<int> cpuIds;
+
+        /**
+         * NUMA node whose CPUs and memory the thread uses. If negative (default), any.
+         */
+        int numaNode;
+
+        /**
+         * OS scheduling priority of the thread.
+         */
+        ThreadPriority priority;
+
+        /**
+         * Maximum number of threads the parallel math libraries (OpenMP and MKL) use for the computations (e.g., the
+         * CPU Caffe layers) called from this thread, so several CPU workers do not oversubscribe the cores. If <= 0
+         * (default), the library default (usually all the cores).
+         */
+        int computeThreads;
+
+        ThreadAffinity(
+            const std::vector<int>& cpuIds = {}, const int numaNode = -1,
+            const ThreadPriority priority = ThreadPriority::Default, const int computeThreads = -1);
+
+        /**
+         * Whether it keeps the OS default for everything (so there is nothing to apply).
+         */
+        bool isDefault() const;
+    };
+
+    /**
+     * It applies threadAffinity to the calling thread.
+     */
+    OP_API void setThreadAffinity(const ThreadAffinity& threadAffinity);
+
+    /**
+     * It returns the ids of the CPU cores of the NUMA node numaNode, or an empty std::vector if unknown (e.g., if the
+     * node does not exist, or in non-Linux systems).
+     */
+    OP_API std::vector<int> getNumaNodeCpuIds(const int numaNode);
+}
+
+#endif // OPENPOSE_THREAD_THREAD_AFFINITY_HPP
@@ -2,13 +2,19 @@
 #define OPENPOSE_THREAD_THREAD_MANAGER_HPP
 
 #include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
 #include <set> // std::multiset
+#include <thread>
 #include <tuple>
 #include <openpose/core/common.hpp>
 #include <openpose/thread/enumClasses.hpp>
 #include <openpose/thread/queue.hpp>
 #include <openpose/thread/thread.hpp>
+#include <openpose/thread/threadPool.hpp>
 #include <openpose/thread/worker.hpp>
+#include <openpose/utilities/metrics.hpp>
 
 namespace op
 {
@@ -32,11 +38,61 @@ namespace op
          */
         void setDefaultMaxSizeQueues(const long long defaultMaxSizeQueues = -1);
 
+        long long getDefaultMaxSizeQueues() const;
+
+        /**
+         * It adds the TWorker(s) to the desired thread, reading from queueInId and writing into queueOutId.
+         * @param queueOutOverflowPolicy QueueOverflowPolicy of the queueOutId queue (i.e., what happens if these
+         * TWorkers push into it while it is full). If several calls set it for the same queue, the last one is kept
+         * (unless it is the default QueueOverflowPolicy::Block).
+         */
         void add(const unsigned long long threadId, const std::vector<TWorker>& tWorkers,
-                 const unsigned long long queueInId, const unsigned long long queueOutId);
+                 const unsigned long long queueInId, const unsigned long long queueOutId,
+                 const QueueOverflowPolicy queueOutOverflowPolicy = QueueOverflowPolicy::Block);
 
         void add(const unsigned long long threadId, const TWorker& tWorker, const unsigned long long queueInId,
-                 const unsigned long long queueOutId);
+                 const unsigned long long queueOutId,
+                 const QueueOverflowPolicy queueOutOverflowPolicy = QueueOverflowPolicy::Block);
+
+        /**
+         * Work-stealing execution mode: Rather than one std::thread per thread id, the SubThreads of all the thread
+         * ids but dedicatedThreadIds and the last one (which exec() runs on the calling thread, e.g., for the GUI)
+         * become tasks of a shared ThreadPool, so the CPU-heavy stages can use any idle core.
+         * reset() disables it again.
+         * @param numberThreads Number of ThreadPool threads. 0 (default) disables it (one std::thread per thread id)
+         * and -1 uses as many threads as CPU cores.
+         * @param dedicatedThreadIds Thread ids that keep their own std::thread, e.g., the ones whose TWorkers keep
+         * per-thread state (such as the GPU device of Caffe) or block (such as a camera producer).
+         */
+        void setThreadPool(const int numberThreads, const std::set<unsigned long long>& dedicatedThreadIds = {});
+
+        /**
+         * It sets the maximum number of SubThreads (i.e., ThreadManager::add() calls) of threadId that the ThreadPool
+         * can run at the same time. By default, 1, i.e., the same guarantee as on their own std::thread. Only
+         * increase it if those TWorkers do not share any non-thread-safe state.
+         */
+        void setThreadPoolConcurrency(const unsigned long long threadId, const unsigned int maxConcurrency);
+
+        /**
+         * It sets the CPU affinity, NUMA node and OS priority of the std::thread of threadId (see ThreadAffinity).
+         * It is ignored (with a warning) if threadId runs on the ThreadPool. reset() removes it.
+         */
+        void setThreadAffinity(const unsigned long long threadId, const ThreadAffinity& threadAffinity);
+
+        /**
+         * Auto-configuration of the queue sizes: After a warm-up (the first AUTO_CONFIGURATION_WARM_UP_FRAMES
+         * frames, e.g., with the CUDA and cuDNN initialization), it measures the service time of each SubThread over
+         * calibrationFrames frames (counted at the last thread). Then, with the throughput of each stage (i.e., the
+         * SubThreads with the same input and output queues, whose replicas add up) and the bottleneck one, it sets
+         * each queue to as many elements as SubThreads are connected to it, plus a margin for the service time
+         * variability of the stage it feeds that is proportional to its utilization. I.e., the queues before the
+         * bottleneck keep it busy, while the ones after it remain short (low latency). The resulting topology is
+         * logged. The number of replicas of each stage cannot be changed while running, so it is only logged as a
+         * recommendation if the bottleneck would benefit from it. The sizes are lower or equal than
+         * setDefaultMaxSizeQueues() (if positive). reset() disables it again.
+         * @param calibrationFrames Number of frames measured. 0 (default) disables it.
+         */
+        void setAutoConfiguration(const unsigned long long calibrationFrames);
 
         void reset();
 
@@ -75,6 +131,27 @@ namespace op
         std::multiset<std::tuple<unsigned long long, std::vector<TWorker>, unsigned long long, unsigned long long>> mThreadWorkerQueues;
         std::vector<std::shared_ptr<Thread<TDatums, TWorker>>> mThreads;
         std::vector<std::shared_ptr<TQueue>> mTQueues;
+        std::map<unsigned long long, QueueOverflowPolicy> mQueueOverflowPolicies;
+        unsigned int mThreadPoolThreads;
+        std::set<unsigned long long> mDedicatedThreadIds;
+        std::map<unsigned long long, unsigned int> mThreadPoolConcurrencies;
+        std::map<unsigned long long, ThreadAffinity> mThreadAffinities;
+        std::shared_ptr<ThreadPool<TDatums, TWorker>> spThreadPool;
+        // Auto-configuration
+        struct ServiceTime
+        {
+            unsigned long long threadId;
+            unsigned long long queueIn;
+            unsigned long long queueOut;
+            std::string workerNames;
+            std::shared_ptr<Histogram> spHistogram;
+        };
+        unsigned long long mAutoConfigurationFrames;
+        std::vector<ServiceTime> mServiceTimes;
+        std::thread mAutoConfigurationThread;
+        std::mutex mAutoConfigurationMutex;
+        std::condition_variable mAutoConfigurationConditionVariable;
+        bool mAutoConfigurationStopped;
 
         void add(const std::vector<std::tuple<unsigned long long, std::vector<TWorker>, unsigned long long, unsigned long long>>& threadWorkerQueues);
 
@@ -86,6 +163,21 @@ namespace op
 
         void checkAndCreateQueues();
 
+        // It returns the actual queue of queueId, or nullptr if it is not a queue (e.g., the first and last ones in
+        // ThreadManagerMode::Synchronous)
+        std::shared_ptr<TQueue> getTQueue(const unsigned long long queueId) const;
+
+        void startAutoConfiguration();
+
+        void stopAutoConfiguration();
+
+        // It blocks until the last thread has processed numberFrames frames (since the last histogram reset), and it
+        // returns false if stopAutoConfiguration() was called first
+        bool waitForAutoConfigurationFrames(const unsigned long long numberFrames);
+
+        // Function of mAutoConfigurationThread
+        void autoConfigure();
+
         DELETE_COPY(ThreadManager);
     };
 }
@@ -95,6 +187,9 @@ namespace op
 
 
 // Implementation
+#include <cmath> // std::ceil
+#include <iomanip> // std::setprecision
+#include <sstream> // std::stringstream
 #include <utility> // std::pair
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/thread/subThread.hpp>
@@ -104,17 +199,33 @@ namespace op
 #include <openpose/thread/subThreadQueueOut.hpp>
 namespace op
 {
+    // Frames processed before the auto-configuration starts measuring (e.g., CUDA initialization, cuDNN auto-tuning)
+    const auto AUTO_CONFIGURATION_WARM_UP_FRAMES = 10ull;
+    // Maximum margin of each queue (times the SubThreads reading from it) for the service time variability
+    const auto AUTO_CONFIGURATION_MAX_VARIABILITY = 2.;
+
     template<typename TDatums, typename TWorker, typename TQueue>
     ThreadManager<TDatums, TWorker, TQueue>::ThreadManager(const ThreadManagerMode threadManagerMode) :
         mThreadManagerMode{threadManagerMode},
         spIsRunning{std::make_shared<std::atomic<bool>>(false)},
-        mDefaultMaxSizeQueues{-1ll}
+        mDefaultMaxSizeQueues{-1ll},
+        mThreadPoolThreads{0u},
+        mAutoConfigurationFrames{0ull},
+        mAutoConfigurationStopped{false}
     {
     }
 
     template<typename TDatums, typename TWorker, typename TQueue>
     ThreadManager<TDatums, TWorker, TQueue>::~ThreadManager()
     {
+        try
+        {
+            stopAutoConfiguration();
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     template<typename TDatums, typename TWorker, typename TQueue>
@@ -130,15 +241,24 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TWorker, typename TQueue>
+    long long ThreadManager<TDatums, TWorker, TQueue>::getDefaultMaxSizeQueues() const
+    {
+        return mDefaultMaxSizeQueues;
+    }
+
     template<typename TDatums, typename TWorker, typename TQueue>
     void ThreadManager<TDatums, TWorker, TQueue>::add(const unsigned long long threadId,
                                                       const std::vector<TWorker>& tWorkers,
                                                       const unsigned long long queueInId,
-                                                      const unsigned long long queueOutId)
+                                                      const unsigned long long queueOutId,
+                                                      const QueueOverflowPolicy queueOutOverflowPolicy)
     {
         try
         {
             add({std::make_tuple(threadId, tWorkers, queueInId, queueOutId)});
+            if (queueOutOverflowPolicy != QueueOverflowPolicy::Block)
+                mQueueOverflowPolicies[queueOutId] = queueOutOverflowPolicy;
         }
         catch (const std::exception& e)
         {
@@ -150,11 +270,76 @@ namespace op
     void ThreadManager<TDatums, TWorker, TQueue>::add(const unsigned long long threadId,
                                                       const TWorker& tWorker,
                                                       const unsigned long long queueInId,
-                                                      const unsigned long long queueOutId)
+                                                      const unsigned long long queueOutId,
+                                                      const QueueOverflowPolicy queueOutOverflowPolicy)
+    {
+        try
+        {
+            add(threadId, std::vector<TWorker>{tWorker}, queueInId, queueOutId, queueOutOverflowPolicy);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::setThreadPool(
+        const int numberThreads, const std::set<unsigned long long>& dedicatedThreadIds)
+    {
+        try
+        {
+            // Sanity check
+            if (numberThreads < -1)
+                error("The number of ThreadPool threads must be -1 (number of CPU cores), 0 (disabled) or positive.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            mThreadPoolThreads = (numberThreads == -1
+                ? fastMax(1u, std::thread::hardware_concurrency()) : (unsigned int)numberThreads);
+            mDedicatedThreadIds = dedicatedThreadIds;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::setThreadPoolConcurrency(
+        const unsigned long long threadId, const unsigned int maxConcurrency)
+    {
+        try
+        {
+            // Sanity check
+            if (maxConcurrency == 0)
+                error("The maximum concurrency must be at least 1.", __LINE__, __FUNCTION__, __FILE__);
+            mThreadPoolConcurrencies[threadId] = maxConcurrency;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::setThreadAffinity(
+        const unsigned long long threadId, const ThreadAffinity& threadAffinity)
+    {
+        try
+        {
+            mThreadAffinities[threadId] = threadAffinity;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::setAutoConfiguration(const unsigned long long calibrationFrames)
     {
         try
         {
-            add({std::make_tuple(threadId, std::vector<TWorker>{tWorker}, queueInId, queueOutId)});
+            mAutoConfigurationFrames = calibrationFrames;
         }
         catch (const std::exception& e)
         {
@@ -169,7 +354,16 @@ namespace op
         {
             mThreadWorkerQueues.clear();
             mThreads.clear();
+            spThreadPool.reset();
             mTQueues.clear();
+            mQueueOverflowPolicies.clear();
+            mThreadPoolThreads = 0u;
+            mDedicatedThreadIds.clear();
+            mThreadPoolConcurrencies.clear();
+            mThreadAffinities.clear();
+            stopAutoConfiguration();
+            mAutoConfigurationFrames = 0ull;
+            mServiceTimes.clear();
         }
         catch (const std::exception& e)
         {
@@ -189,8 +383,11 @@ namespace op
             {
                 opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Start threads
+                if (spThreadPool != nullptr)
+                    spThreadPool->startInThread();
                 for (auto i = 0u; i < mThreads.size() - 1; i++)
                     mThreads.at(i)->startInThread();
+                startAutoConfiguration();
                 (*mThreads.rbegin())->exec(spIsRunning);
                 // Stop threads - It will arrive here when the exec() command has finished
                 stop();
@@ -212,8 +409,11 @@ namespace op
             // Set threads
             multisetToThreads();
             // Start threads
+            if (spThreadPool != nullptr)
+                spThreadPool->startInThread();
             for (auto& thread : mThreads)
                 thread->startInThread();
+            startAutoConfiguration();
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
         }
         catch (const std::exception& e)
@@ -228,12 +428,15 @@ namespace op
         try
         {
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            stopAutoConfiguration();
             for (auto& tQueue : mTQueues)
                 tQueue->stop();
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             *spIsRunning = false;
             for (auto& thread : mThreads)
                 thread->stopAndJoin();
+            if (spThreadPool != nullptr)
+                spThreadPool->stopAndJoin();
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             checkWorkerErrors();
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
@@ -409,11 +612,25 @@ namespace op
 
                 // Data
                 const auto maxQueueIdSynchronous = mTQueues.size()+1;
+                const auto maxThreadId = mThreads.size()-1;
+
+                // Auto-configuration (if enabled)
+                mServiceTimes.clear();
+
+                // Work-stealing ThreadPool (if enabled)
+                spThreadPool.reset();
+                if (mThreadPoolThreads > 0u)
+                {
+                    spThreadPool = std::make_shared<ThreadPool<TDatums, TWorker>>(mThreadPoolThreads);
+                    for (const auto& threadPoolConcurrency : mThreadPoolConcurrencies)
+                        spThreadPool->setMaxConcurrency(threadPoolConcurrency.first, threadPoolConcurrency.second);
+                }
 
                 // Set up threads
                 for (const auto& threadWorkerQueue : mThreadWorkerQueues)
                 {
-                    auto& thread = mThreads[std::get<0>(threadWorkerQueue)];
+                    const auto threadId = std::get<0>(threadWorkerQueue);
+                    auto& thread = mThreads[threadId];
                     const auto& tWorkers = std::get<1>(threadWorkerQueue);
                     const auto queueIn = std::get<2>(threadWorkerQueue);
                     const auto queueOut = std::get<3>(threadWorkerQueue);
@@ -450,7 +667,43 @@ namespace op
                     // Case no queue
                     else // if (queueIn == 0 && queueOut == maxQueueIdSynchronous)
                         subThread = {std::make_shared<SubThreadNoQueue<TDatums, TWorker>>(tWorkers)};
-                    thread->add(subThread);
+                    subThread->setInstrumentationIds(threadId, queueIn, queueOut);
+                    if (mAutoConfigurationFrames > 0ull)
+                    {
+                        std::string workerNames;
+                        for (const auto& tWorker : tWorkers)
+                            workerNames += (workerNames.empty() ? "" : ", ") + Metrics::getTypeName(typeid(*tWorker));
+                        mServiceTimes.emplace_back(
+                            ServiceTime{threadId, queueIn, queueOut, workerNames, std::make_shared<Histogram>()});
+                        subThread->setServiceTimeHistogram(mServiceTimes.back().spHistogram);
+                    }
+                    // The last thread always runs on its own (exec() runs it on the calling thread)
+                    if (spThreadPool != nullptr && threadId != maxThreadId
+                        && mDedicatedThreadIds.find(threadId) == mDedicatedThreadIds.end())
+                        spThreadPool->add(subThread, threadId);
+                    else
+                        thread->add(subThread);
+                }
+                // Thread affinities
+                for (const auto& threadAffinity : mThreadAffinities)
+                {
+                    if (threadAffinity.first < mThreads.size() && !mThreads[threadAffinity.first]->empty())
+                        mThreads[threadAffinity.first]->setAffinity(threadAffinity.second);
+                    else
+                        opLog("Thread id " + std::to_string(threadAffinity.first) + " does not run on its own thread,"
+                              " its affinity is ignored.", Priority::High, __LINE__, __FUNCTION__, __FILE__);
+                }
+                // Threads with all their SubThreads on the ThreadPool are not started
+                if (spThreadPool != nullptr)
+                {
+                    const auto lastThread = mThreads.back();
+                    std::vector<std::shared_ptr<Thread<TDatums, TWorker>>> threads;
+                    for (auto& thread : mThreads)
+                        if (!thread->empty() || thread == lastThread)
+                            threads.emplace_back(thread);
+                    std::swap(mThreads, threads);
+                    opLog("ThreadPool of " + std::to_string(mThreadPoolThreads) + " threads, plus "
+                          + std::to_string(mThreads.size()) + " dedicated threads.", Priority::Normal);
                 }
             }
             else
@@ -540,6 +793,17 @@ namespace op
                     error("Unknown ThreadManagerMode", __LINE__, __FUNCTION__, __FILE__);
                 for (auto& tQueue : mTQueues)
                     tQueue = std::make_shared<TQueue>(mDefaultMaxSizeQueues);
+                // Overflow policies
+                for (const auto& queueOverflowPolicy : mQueueOverflowPolicies)
+                {
+                    const auto queueId = queueOverflowPolicy.first;
+                    const auto tQueue = getTQueue(queueId);
+                    if (tQueue != nullptr)
+                        tQueue->setOverflowPolicy(queueOverflowPolicy.second);
+                    else
+                        opLog("Queue id " + std::to_string(queueId) + " is not an actual queue, its overflow policy"
+                              " is ignored.", Priority::High, __LINE__, __FUNCTION__, __FILE__);
+                }
             }
         }
         catch (const std::exception& e)
@@ -548,6 +812,245 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TWorker, typename TQueue>
+    std::shared_ptr<TQueue> ThreadManager<TDatums, TWorker, TQueue>::getTQueue(const unsigned long long queueId) const
+    {
+        try
+        {
+            // Queue ids are shifted by 1 if the first one is not an actual queue
+            const auto queueIdOffset = (mThreadManagerMode == ThreadManagerMode::Asynchronous
+                                        || mThreadManagerMode == ThreadManagerMode::AsynchronousIn ? 0ull : 1ull);
+            if (queueId >= queueIdOffset && queueId - queueIdOffset < mTQueues.size())
+                return mTQueues[queueId - queueIdOffset];
+            return nullptr;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::startAutoConfiguration()
+    {
+        try
+        {
+            if (mAutoConfigurationFrames > 0ull && !mServiceTimes.empty() && !mAutoConfigurationThread.joinable())
+            {
+                mAutoConfigurationStopped = false;
+                mAutoConfigurationThread = std::thread{&ThreadManager<TDatums, TWorker, TQueue>::autoConfigure, this};
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::stopAutoConfiguration()
+    {
+        try
+        {
+            if (mAutoConfigurationThread.joinable())
+            {
+                {
+                    const std::lock_guard<std::mutex> lock{mAutoConfigurationMutex};
+                    mAutoConfigurationStopped = true;
+                }
+                mAutoConfigurationConditionVariable.notify_all();
+                mAutoConfigurationThread.join();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    bool ThreadManager<TDatums, TWorker, TQueue>::waitForAutoConfigurationFrames(
+        const unsigned long long numberFrames)
+    {
+        try
+        {
+            // Last thread: The SubThreads writing into the last queue
+            auto lastQueueOut = 0ull;
+            for (const auto& serviceTime : mServiceTimes)
+                lastQueueOut = fastMax(lastQueueOut, serviceTime.queueOut);
+            std::unique_lock<std::mutex> lock{mAutoConfigurationMutex};
+            while (true)
+            {
+                auto processedFrames = 0ull;
+                for (const auto& serviceTime : mServiceTimes)
+                    if (serviceTime.queueOut == lastQueueOut)
+                        processedFrames += serviceTime.spHistogram->getCount();
+                if (processedFrames >= numberFrames)
+                    return true;
+                // Polling the histograms, so the SubThreads do not have to notify anything
+                if (mAutoConfigurationConditionVariable.wait_for(
+                        lock, std::chrono::milliseconds{20}, [this]{ return mAutoConfigurationStopped; }))
+                    return false;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::autoConfigure()
+    {
+        try
+        {
+            // Warm-up (not measured)
+            if (!waitForAutoConfigurationFrames(AUTO_CONFIGURATION_WARM_UP_FRAMES))
+                return;
+            for (auto& serviceTime : mServiceTimes)
+                serviceTime.spHistogram->reset();
+            // Calibration
+            if (!waitForAutoConfigurationFrames(mAutoConfigurationFrames))
+                return;
+
+            // Stages: SubThreads with the same input and output queues (i.e., replicas of each other)
+            struct Stage
+            {
+                std::string threadIds;
+                std::string workerNames;
+                unsigned long long replicas;
+                unsigned long long count;
+                unsigned long long sumMicroseconds;
+                unsigned long long p90Microseconds;
+                double throughput; // Elements per second of all its replicas
+            };
+            std::map<std::pair<unsigned long long, unsigned long long>, Stage> stages;
+            auto maxQueueId = 0ull;
+            for (const auto& serviceTime : mServiceTimes)
+            {
+                const auto key = std::make_pair(serviceTime.queueIn, serviceTime.queueOut);
+                if (stages.find(key) == stages.end())
+                    stages[key] = Stage{"", serviceTime.workerNames, 0ull, 0ull, 0ull, 0ull, 0.};
+                auto& stage = stages[key];
+                stage.threadIds += (stage.threadIds.empty() ? "" : ", ") + std::to_string(serviceTime.threadId);
+                stage.replicas++;
+                const auto& histogram = *serviceTime.spHistogram;
+                const auto count = histogram.getCount();
+                if (count > 0ull)
+                {
+                    stage.count += count;
+                    stage.sumMicroseconds += histogram.getSum();
+                    stage.p90Microseconds = fastMax(stage.p90Microseconds, histogram.getValueAtQuantile(0.9));
+                    stage.throughput += 1e6 * count / fastMax(1ull, histogram.getSum());
+                }
+                maxQueueId = fastMax(maxQueueId, fastMax(serviceTime.queueIn, serviceTime.queueOut));
+            }
+            // Bottleneck (and the next slowest stage, i.e., the one limiting the benefit of more replicas of it)
+            const Stage* bottleneck = nullptr;
+            auto nextThroughput = -1.;
+            for (const auto& stage : stages)
+            {
+                if (stage.second.count == 0ull)
+                    continue;
+                if (bottleneck == nullptr || stage.second.throughput < bottleneck->throughput)
+                {
+                    if (bottleneck != nullptr)
+                        nextThroughput = bottleneck->throughput;
+                    bottleneck = &stage.second;
+                }
+                else if (nextThroughput < 0. || stage.second.throughput < nextThroughput)
+                    nextThroughput = stage.second.throughput;
+            }
+            if (bottleneck == nullptr)
+            {
+                opLog("Auto-configuration: No stage processed any frame, the queue sizes are not changed.",
+                      Priority::High);
+                return;
+            }
+            const auto maxThroughput = bottleneck->throughput;
+            const auto getVariability = [](const Stage& stage)
+            {
+                if (stage.count == 0ull || stage.sumMicroseconds == 0ull)
+                    return 0.;
+                const auto meanMicroseconds = stage.sumMicroseconds / double(stage.count);
+                return fastTruncate(
+                    stage.p90Microseconds / meanMicroseconds - 1., 0., AUTO_CONFIGURATION_MAX_VARIABILITY);
+            };
+            // Queue sizes: 1 element per SubThread connected to it, plus a margin for the service time variability
+            // of its producers and consumers, times the utilization of its consumers (i.e., up to the maximum margin
+            // right before the bottleneck, and almost none after it)
+            std::stringstream stringStream;
+            stringStream << std::fixed << std::setprecision(1);
+            for (auto queueId = 0ull ; queueId <= maxQueueId ; queueId++)
+            {
+                const auto tQueue = getTQueue(queueId);
+                if (tQueue == nullptr)
+                    continue;
+                auto producers = 0ull;
+                auto consumers = 0ull;
+                auto consumerThroughput = 0.;
+                auto variability = 0.;
+                for (const auto& stage : stages)
+                {
+                    if (stage.first.second == queueId)
+                    {
+                        producers += stage.second.replicas;
+                        variability = fastMax(variability, getVariability(stage.second));
+                    }
+                    if (stage.first.first == queueId)
+                    {
+                        consumers += stage.second.replicas;
+                        consumerThroughput += stage.second.throughput;
+                        variability = fastMax(variability, getVariability(stage.second));
+                    }
+                }
+                const auto utilization = (consumerThroughput > 0.
+                                          ? fastMin(1., maxThroughput / consumerThroughput) : 1.);
+                auto maxSize = (long long)(fastMax(producers, consumers)
+                                           + std::ceil(consumers * utilization * variability - 1e-3));
+                if (mDefaultMaxSizeQueues > 0)
+                    maxSize = fastMin(maxSize, mDefaultMaxSizeQueues);
+                maxSize = fastMax(1ll, maxSize);
+                tQueue->setMaxSize(maxSize);
+                stringStream << (stringStream.tellp() > 0 ? ", " : "") << queueId << ": " << maxSize;
+            }
+            const auto queueSizes = stringStream.str();
+            // Log topology
+            stringStream.str("");
+            stringStream << "Auto-configuration (" << mAutoConfigurationFrames << " frames): " << maxThroughput
+                << " fps, bottleneck: thread " << bottleneck->threadIds << " (" << bottleneck->workerNames << ").";
+            for (const auto& stage : stages)
+            {
+                stringStream << "\n    Thread " << stage.second.threadIds << " (" << stage.second.workerNames
+                    << "), queue " << stage.first.first << " -> " << stage.first.second << ", " << stage.second.replicas
+                    << " replica(s): ";
+                if (stage.second.count == 0ull)
+                    stringStream << "no frames.";
+                else
+                    stringStream << stage.second.sumMicroseconds / (1e3 * stage.second.count) << " ms/frame (p90 "
+                        << stage.second.p90Microseconds / 1e3 << " ms), up to " << stage.second.throughput
+                        << " fps, " << 100. * fastMin(1., maxThroughput / stage.second.throughput) << "% busy.";
+            }
+            stringStream << "\n    Queue sizes (queue id: elements): " << queueSizes << ".";
+            // Replicas cannot be added while running
+            const auto replicaThroughput = maxThroughput * (bottleneck->replicas + 1) / bottleneck->replicas;
+            const auto expectedThroughput = (nextThroughput > 0. ? fastMin(replicaThroughput, nextThroughput)
+                                                                 : replicaThroughput);
+            if (expectedThroughput > 1.1 * maxThroughput)
+                stringStream << "\n    Another replica of the bottleneck (e.g., 1 more GPU with `--num_gpu` for the"
+                    " pose estimation, or the thread pool of `--thread_pool` for the CPU stages) would increase it to"
+                    " up to " << expectedThroughput << " fps.";
+            opLog(stringStream.str(), Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            // Background thread: Reported by stop()
+            errorWorker(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     COMPILE_TEMPLATE_DATUM(ThreadManager);
 }
 
@@ -0,0 +1,370 @@
+#ifndef OPENPOSE_THREAD_THREAD_POOL_HPP
+#define OPENPOSE_THREAD_THREAD_POOL_HPP
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <openpose/core/common.hpp>
+#include <openpose/thread/subThread.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    /**
+     * ThreadPool runs SubThreads as tasks on a fixed number of threads, rather than one std::thread per group of
+     * SubThreads (see Thread). Each pool thread keeps its own deque of tasks: it runs one SubThread::work() call of
+     * the task at the front and pushes it back, and when its own deque is empty, it steals the task at the back of
+     * another one. Thus, idle threads borrow the work of any busy stage.
+     * Tasks are grouped (ThreadManager uses the thread id as group id) and each group has a concurrency limit, i.e.,
+     * the maximum number of its tasks running at the same time (by default, 1, the same as if they were on their own
+     * Thread). A task is never run by 2 pool threads at the same time, and its SubThread::initializationOnThread()
+     * is called by the first pool thread that runs it. Therefore, SubThreads whose TWorkers keep per-thread state
+     * (e.g., the GPU device of Caffe) must not be added to a ThreadPool.
+     */
+    template<typename TDatums, typename TWorker = std::shared_ptr<Worker<TDatums>>>
+    class ThreadPool
+    {
+    public:
+        /**
+         * @param numberThreads Number of pool threads. It is reduced to the number of tasks if there are less tasks.
+         */
+        explicit ThreadPool(const unsigned int numberThreads);
+
+        virtual ~ThreadPool();
+
+        /**
+         * It adds the SubThread as a new task of the group groupId.
+         */
+        void add(const std::shared_ptr<SubThread<TDatums, TWorker>>& subThread, const unsigned long long groupId);
+
+        /**
+         * It sets the maximum number of tasks of the group groupId that can run at the same time. By default, 1.
+         */
+        void setMaxConcurrency(const unsigned long long groupId, const unsigned int maxConcurrency);
+
+        void startInThread();
+
+        void stopAndJoin();
+
+        inline bool isRunning() const
+        {
+            return mIsRunning;
+        }
+
+        inline bool empty() const
+        {
+            return mTasks.empty();
+        }
+
+    private:
+        struct Task
+        {
+            std::shared_ptr<SubThread<TDatums, TWorker>> subThread;
+            unsigned long long groupId;
+            bool initialized;
+        };
+        struct TaskDeque
+        {
+            std::mutex mutex;
+            std::deque<std::size_t> taskIndexes;
+        };
+        struct TaskGroup
+        {
+            unsigned int maxConcurrency;
+            std::atomic<unsigned int> running;
+        };
+
+        const unsigned int mNumberThreads;
+        std::atomic<bool> mIsRunning;
+        std::atomic<unsigned long long> mNumberOpenTasks;
+        std::vector<Task> mTasks;
+        std::map<unsigned long long, std::unique_ptr<TaskGroup>> mTaskGroups;
+        std::vector<std::unique_ptr<TaskDeque>> mTaskDeques;
+        std::vector<std::thread> mThreads;
+
+        bool popTask(const unsigned int threadIndex, std::size_t& taskIndex);
+
+        void pushTask(const unsigned int threadIndex, const std::size_t taskIndex);
+
+        void threadFunction(const unsigned int threadIndex);
+
+        void stop();
+
+        void join();
+
+        DELETE_COPY(ThreadPool);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/tracer.hpp>
+namespace op
+{
+    template<typename TDatums, typename TWorker>
+    ThreadPool<TDatums, TWorker>::ThreadPool(const unsigned int numberThreads) :
+        mNumberThreads{numberThreads},
+        mIsRunning{false},
+        mNumberOpenTasks{0ull}
+    {
+        try
+        {
+            // Sanity check
+            if (numberThreads == 0)
+                error("The ThreadPool requires at least 1 thread.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    ThreadPool<TDatums, TWorker>::~ThreadPool()
+    {
+        try
+        {
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            stopAndJoin();
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void ThreadPool<TDatums, TWorker>::add(
+        const std::shared_ptr<SubThread<TDatums, TWorker>>& subThread, const unsigned long long groupId)
+    {
+        try
+        {
+            if (mIsRunning)
+                error("Tasks cannot be added while the ThreadPool is running.", __LINE__, __FUNCTION__, __FILE__);
+            // Tasks share the pool threads, so they do not block on their queues longer than the old polling period
+            subThread->setQueueWaitMicroseconds(100ll);
+            mTasks.emplace_back(Task{subThread, groupId, false});
+            if (mTaskGroups.find(groupId) == mTaskGroups.end())
+                setMaxConcurrency(groupId, 1u);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void ThreadPool<TDatums, TWorker>::setMaxConcurrency(
+        const unsigned long long groupId, const unsigned int maxConcurrency)
+    {
+        try
+        {
+            // Sanity checks
+            if (maxConcurrency == 0)
+                error("The maximum concurrency must be at least 1.", __LINE__, __FUNCTION__, __FILE__);
+            if (mIsRunning)
+                error("The concurrency cannot be changed while the ThreadPool is running.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            auto& taskGroup = mTaskGroups[groupId];
+            if (taskGroup == nullptr)
+                taskGroup.reset(new TaskGroup{});
+            taskGroup->maxConcurrency = maxConcurrency;
+            taskGroup->running = 0u;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void ThreadPool<TDatums, TWorker>::startInThread()
+    {
+        try
+        {
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            stopAndJoin();
+            if (!mTasks.empty())
+            {
+                // Tasks distributed round-robin over the pool threads
+                const auto numberThreads = (unsigned int)fastMin((std::size_t)mNumberThreads, mTasks.size());
+                mTaskDeques.clear();
+                for (auto i = 0u ; i < numberThreads ; i++)
+                    mTaskDeques.emplace_back(new TaskDeque{});
+                for (auto taskIndex = 0u ; taskIndex < mTasks.size() ; taskIndex++)
+                    mTaskDeques[taskIndex % numberThreads]->taskIndexes.emplace_back(taskIndex);
+                for (auto& taskGroup : mTaskGroups)
+                    taskGroup.second->running = 0u;
+                mNumberOpenTasks = mTasks.size();
+                // Start threads
+                mIsRunning = true;
+                for (auto i = 0u ; i < numberThreads ; i++)
+                    mThreads.emplace_back(&ThreadPool::threadFunction, this, i);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void ThreadPool<TDatums, TWorker>::stopAndJoin()
+    {
+        try
+        {
+            stop();
+            join();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    bool ThreadPool<TDatums, TWorker>::popTask(const unsigned int threadIndex, std::size_t& taskIndex)
+    {
+        try
+        {
+            // Own tasks (from the front)
+            {
+                auto& taskDeque = *mTaskDeques[threadIndex];
+                const std::lock_guard<std::mutex> lock{taskDeque.mutex};
+                if (!taskDeque.taskIndexes.empty())
+                {
+                    taskIndex = taskDeque.taskIndexes.front();
+                    taskDeque.taskIndexes.pop_front();
+                    return true;
+                }
+            }
+            // Otherwise, steal a task from the back of the next non-empty deque
+            for (auto i = 1u ; i < mTaskDeques.size() ; i++)
+            {
+                auto& taskDeque = *mTaskDeques[(threadIndex + i) % mTaskDeques.size()];
+                const std::lock_guard<std::mutex> lock{taskDeque.mutex};
+                if (!taskDeque.taskIndexes.empty())
+                {
+                    taskIndex = taskDeque.taskIndexes.back();
+                    taskDeque.taskIndexes.pop_back();
+                    return true;
+                }
+            }
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void ThreadPool<TDatums, TWorker>::pushTask(const unsigned int threadIndex, const std::size_t taskIndex)
+    {
+        try
+        {
+            auto& taskDeque = *mTaskDeques[threadIndex];
+            const std::lock_guard<std::mutex> lock{taskDeque.mutex};
+            taskDeque.taskIndexes.emplace_back(taskIndex);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void ThreadPool<TDatums, TWorker>::threadFunction(const unsigned int threadIndex)
+    {
+        try
+        {
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            const auto threadName = "Pool thread " + std::to_string(threadIndex);
+            Tracer::setThreadName(threadName);
+            while (isRunning())
+            {
+                std::size_t taskIndex;
+                // All tasks being run by other threads
+                if (!popTask(threadIndex, taskIndex))
+                {
+                    std::this_thread::sleep_for(std::chrono::microseconds{100});
+                    continue;
+                }
+                auto& task = mTasks[taskIndex];
+                // Concurrency limit of its group reached: Another task is tried
+                auto& taskGroup = *mTaskGroups.at(task.groupId);
+                if (++taskGroup.running > taskGroup.maxConcurrency)
+                {
+                    taskGroup.running--;
+                    pushTask(threadIndex, taskIndex);
+                    std::this_thread::yield();
+                    continue;
+                }
+                // Run task (only 1 thread can own it at a time)
+                if (!task.initialized)
+                {
+                    task.subThread->initializationOnThread();
+                    task.initialized = true;
+                    // SubThread::initializationOnThread() names the thread after its own thread id
+                    Tracer::setThreadName(threadName);
+                }
+                const auto taskIsOpen = task.subThread->work();
+                taskGroup.running--;
+                if (taskIsOpen)
+                    pushTask(threadIndex, taskIndex);
+                // Closed task: Not pushed again, and the pool stops once all of them are closed
+                else if (--mNumberOpenTasks == 0)
+                {
+                    opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                    stop();
+                }
+            }
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void ThreadPool<TDatums, TWorker>::stop()
+    {
+        try
+        {
+            mIsRunning = false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void ThreadPool<TDatums, TWorker>::join()
+    {
+        try
+        {
+            for (auto& thread : mThreads)
+                if (thread.joinable())
+                    thread.join();
+            mThreads.clear();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(ThreadPool);
+}
+
+#endif // OPENPOSE_THREAD_THREAD_POOL_HPP
@@ -58,7 +58,8 @@ namespace op
             // Debugging log
             opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             // Profiling speed
-            const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+            static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+            const auto profilerKey = Profiler::timerInit(profilerTimerId);
             // tDatums not used --> Avoid warning
             UNUSED(tDatums);
             // Sleep the desired time
@@ -0,0 +1,74 @@
+#ifndef OPENPOSE_THREAD_W_FRAME_CREDITS_HPP
+#define OPENPOSE_THREAD_W_FRAME_CREDITS_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    /**
+     * It grants back the FrameCredits credit of each frame (see Datum::frameCredit), so the producer can decode the
+     * next one. It is added right after the stages bounding the pipeline throughput (e.g., at the end of each GPU
+     * pose thread).
+     */
+    template<typename TDatums>
+    class WFrameCredits : public Worker<TDatums>
+    {
+    public:
+        explicit WFrameCredits();
+
+        virtual ~WFrameCredits();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        DELETE_COPY(WFrameCredits);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WFrameCredits<TDatums>::WFrameCredits()
+    {
+    }
+
+    template<typename TDatums>
+    WFrameCredits<TDatums>::~WFrameCredits()
+    {
+    }
+
+    template<typename TDatums>
+    void WFrameCredits<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WFrameCredits<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+                for (auto& tDatumPtr : *tDatums)
+                    tDatumPtr->frameCredit.reset();
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WFrameCredits);
+}
+
+#endif // OPENPOSE_THREAD_W_FRAME_CREDITS_HPP
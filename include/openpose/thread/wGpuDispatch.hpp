@@ -0,0 +1,103 @@
+#ifndef OPENPOSE_THREAD_W_GPU_DISPATCH_HPP
+#define OPENPOSE_THREAD_W_GPU_DISPATCH_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/thread/gpuDispatcher.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    /**
+     * WGpuDispatch reports the frames of a GPU pose thread to its GpuDispatcher. Each GPU thread has 2 of them: The
+     * first TWorker (isBegin = true), which also decides whether the thread pops a new frame (see
+     * Worker::isReadyForInput()), and the last one (isBegin = false), which marks them as finished.
+     */
+    template<typename TDatums>
+    class WGpuDispatch : public Worker<TDatums>
+    {
+    public:
+        explicit WGpuDispatch(const std::shared_ptr<GpuDispatcher>& gpuDispatcher, const int gpu, const bool isBegin);
+
+        virtual ~WGpuDispatch();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+        bool isReadyForInput(const unsigned long long queueInSize);
+
+    private:
+        const std::shared_ptr<GpuDispatcher> spGpuDispatcher;
+        const int mGpu;
+        const bool mIsBegin;
+
+        DELETE_COPY(WGpuDispatch);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WGpuDispatch<TDatums>::WGpuDispatch(
+        const std::shared_ptr<GpuDispatcher>& gpuDispatcher, const int gpu, const bool isBegin) :
+        spGpuDispatcher{gpuDispatcher},
+        mGpu{gpu},
+        mIsBegin{isBegin}
+    {
+    }
+
+    template<typename TDatums>
+    WGpuDispatch<TDatums>::~WGpuDispatch()
+    {
+    }
+
+    template<typename TDatums>
+    void WGpuDispatch<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WGpuDispatch<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                if (mIsBegin)
+                    spGpuDispatcher->start(mGpu, (unsigned int)tDatums->size());
+                else
+                    spGpuDispatcher->finish(mGpu, (unsigned int)tDatums->size());
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    bool WGpuDispatch<TDatums>::isReadyForInput(const unsigned long long queueInSize)
+    {
+        try
+        {
+            return (!mIsBegin || spGpuDispatcher->shouldAccept(mGpu, queueInSize));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WGpuDispatch);
+}
+
+#endif // OPENPOSE_THREAD_W_GPU_DISPATCH_HPP
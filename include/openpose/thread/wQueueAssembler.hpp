@@ -60,7 +60,8 @@ namespace op
         try
         {
             // Profiling speed
-            const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+            static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+            const auto profilerKey = Profiler::timerInit(profilerTimerId);
             // Input TDatums -> enqueue it
             if (checkNoNullNorEmpty(tDatums))
             {
@@ -94,9 +95,6 @@ namespace op
                 else
                     tDatums = nullptr;
             }
-            // Sleep if no new tDatums to either pop or push
-            else
-                std::this_thread::sleep_for(std::chrono::milliseconds{1});
         }
         catch (const std::exception& e)
         {
@@ -1,18 +1,33 @@
 #ifndef OPENPOSE_THREAD_W_QUEUE_ORDERER_HPP
 #define OPENPOSE_THREAD_W_QUEUE_ORDERER_HPP
 
-#include <queue> // std::priority_queue
+#include <deque>
 #include <openpose/core/common.hpp>
 #include <openpose/thread/worker.hpp>
 #include <openpose/utilities/pointerContainer.hpp>
 
 namespace op
 {
+    /**
+     * WQueueOrderer returns the TDatums sorted by id (and subId). The ones arriving before an earlier one are kept in
+     * a ring-indexed reorder window (slot = sequence % window size, where sequence = id * views + subId), so
+     * inserting one and releasing the next one are O(1).
+     */
     template<typename TDatums>
     class WQueueOrderer : public Worker<TDatums>
     {
     public:
-        explicit WQueueOrderer(const unsigned int maxBufferSize = 64u);
+        /**
+         * @param maxBufferSize Size of the reorder window, i.e., maximum distance between the next expected TDatums
+         * and the latest one buffered. If a newer one arrives, the missing ones are skipped and the earlier ones are
+         * released.
+         * @param maxWaitMs If > 0, maximum time (in milliseconds) the earliest TDatums waits for the missing ones
+         * before being released. If <= 0, only maxBufferSize limits it.
+         * @param dropLateFrames Whether the TDatums arriving after they were skipped are dropped (e.g., live
+         * sources) or forwarded out of order.
+         */
+        explicit WQueueOrderer(
+            const unsigned int maxBufferSize = 64u, const double maxWaitMs = 0., const bool dropLateFrames = false);
 
         virtual ~WQueueOrderer();
 
@@ -23,11 +38,26 @@ namespace op
         void tryStop();
 
     private:
-        const unsigned int mMaxBufferSize;
+        const double mMaxWaitSeconds;
+        const bool mDropLateFrames;
         bool mStopWhenEmpty;
-        unsigned long long mNextExpectedId;
-        unsigned long long mNextExpectedSubId;
-        std::priority_queue<TDatums, std::vector<TDatums>, PointerContainerGreater<TDatums>> mPriorityQueueBuffer;
+        unsigned long long mNextSequence;
+        std::vector<TDatums> mWindow;
+        std::size_t mWindowElements;
+        // TDatums already skipped over but not returned yet (work() returns 1 TDatums at a time)
+        std::deque<TDatums> mReleasedTDatums;
+        // Timer of the time waited for the current mNextSequence
+        bool mWaiting;
+        unsigned long long mWaitingSequence;
+        std::chrono::time_point<std::chrono::high_resolution_clock> mWaitingTimerInit;
+
+        unsigned long long getSequence(const TDatums& tDatums) const;
+
+        void skipUntil(const unsigned long long sequence);
+
+        TDatums release();
+
+        bool waitedTooLong();
 
         DELETE_COPY(WQueueOrderer);
     };
@@ -38,14 +68,19 @@ namespace op
 
 
 // Implementation
+#include <openpose/utilities/fastMath.hpp>
 namespace op
 {
     template<typename TDatums>
-    WQueueOrderer<TDatums>::WQueueOrderer(const unsigned int maxBufferSize) :
-        mMaxBufferSize{maxBufferSize},
+    WQueueOrderer<TDatums>::WQueueOrderer(
+        const unsigned int maxBufferSize, const double maxWaitMs, const bool dropLateFrames) :
+        mMaxWaitSeconds{maxWaitMs > 0. ? maxWaitMs * 1e-3 : 0.},
+        mDropLateFrames{dropLateFrames},
         mStopWhenEmpty{false},
-        mNextExpectedId{0},
-        mNextExpectedSubId{0}
+        mNextSequence{0ull},
+        mWindow(fastMax(1u, maxBufferSize)),
+        mWindowElements{0},
+        mWaiting{false}
     {
     }
 
@@ -65,78 +100,42 @@ namespace op
         try
         {
             // Profiling speed
-            const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+            static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+            const auto profilerKey = Profiler::timerInit(profilerTimerId);
             bool profileSpeed = (tDatums != nullptr);
             // Input TDatum -> enqueue or return it back
             if (checkNoNullNorEmpty(tDatums))
             {
-                // T* to T
-                auto& tDatumsNoPtr = *tDatums;
-                // tDatums is the next expected, update counter
-                if (tDatumsNoPtr[0]->id == mNextExpectedId && tDatumsNoPtr[0]->subId == mNextExpectedSubId)
+                const auto sequence = getSequence(tDatums);
+                // If it was already skipped (or repeated) -> drop it or forward it out of order
+                if (sequence < mNextSequence
+                    || (sequence < mNextSequence + mWindow.size() && mWindow[sequence % mWindow.size()] != nullptr))
                 {
-                    // If single-view
-                    if (tDatumsNoPtr[0]->subIdMax == 0)
-                        mNextExpectedId++;
-                    // If muilti-view system
-                    else
+                    if (mDropLateFrames)
                     {
-                        mNextExpectedSubId++;
-                        if (mNextExpectedSubId > tDatumsNoPtr[0]->subIdMax)
-                        {
-                            mNextExpectedSubId = 0;
-                            mNextExpectedId++;
-                        }
+                        opLogIfDebug("Late frame " + std::to_string((*tDatums)[0]->id) + " dropped.",
+                                     Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                        tDatums = nullptr;
                     }
                 }
-                // Else push it to our buffered queue
+                // Else push it to the reorder window
                 else
                 {
-                    // Enqueue current tDatums
-                    mPriorityQueueBuffer.emplace(tDatums);
+                    // Out of the window -> skip the missing ones
+                    if (sequence >= mNextSequence + mWindow.size())
+                        skipUntil(sequence + 1 - mWindow.size());
+                    mWindow[sequence % mWindow.size()] = tDatums;
+                    mWindowElements++;
                     tDatums = nullptr;
-                    // Else if buffer full -> remove one tDatums
-                    if (mPriorityQueueBuffer.size() > mMaxBufferSize)
-                    {
-                        tDatums = mPriorityQueueBuffer.top();
-                        mPriorityQueueBuffer.pop();
-                    }
                 }
             }
-            // If input TDatum enqueued -> check if previously enqueued next desired frame and pop it
+            // If input TDatum enqueued -> return the next one in order (if any)
             if (!checkNoNullNorEmpty(tDatums))
             {
-                // Retrieve frame if next is desired frame or if we want to stop this worker
-                if (!mPriorityQueueBuffer.empty()
-                    && (mStopWhenEmpty ||
-                        ((*mPriorityQueueBuffer.top())[0]->id == mNextExpectedId
-                          && (*mPriorityQueueBuffer.top())[0]->subId == mNextExpectedSubId)))
-                {
-                    tDatums = { mPriorityQueueBuffer.top() };
-                    mPriorityQueueBuffer.pop();
-                }
-            }
-            // If TDatum ready to be returned -> updated next expected id
-            if (checkNoNullNorEmpty(tDatums))
-            {
-                const auto& tDatumsNoPtr = *tDatums;
-                // If single-view
-                if (tDatumsNoPtr[0]->subIdMax == 0)
-                    mNextExpectedId = tDatumsNoPtr[0]->id + 1;
-                // If muilti-view system
-                else
-                {
-                    mNextExpectedSubId = tDatumsNoPtr[0]->subId + 1;
-                    if (mNextExpectedSubId > tDatumsNoPtr[0]->subIdMax)
-                    {
-                        mNextExpectedSubId = 0;
-                        mNextExpectedId = tDatumsNoPtr[0]->id + 1;
-                    }
-                }
+                auto tDatumsReleased = release();
+                if (tDatumsReleased != nullptr)
+                    tDatums = tDatumsReleased;
             }
-            // Sleep if no new tDatums to either pop or push
-            if (!checkNoNullNorEmpty(tDatums) && mPriorityQueueBuffer.size() < mMaxBufferSize / 2u)
-                std::this_thread::sleep_for(std::chrono::milliseconds{1});
             // If TDatum popped and/or pushed
             if (profileSpeed || tDatums != nullptr)
             {
@@ -161,7 +160,7 @@ namespace op
         try
         {
             // Close if all frames were retrieved from the queue
-            if (mPriorityQueueBuffer.empty())
+            if (mWindowElements == 0 && mReleasedTDatums.empty())
                 this->stop();
             mStopWhenEmpty = true;
 
@@ -172,6 +171,108 @@ namespace op
         }
     }
 
+    template<typename TDatums>
+    unsigned long long WQueueOrderer<TDatums>::getSequence(const TDatums& tDatums) const
+    {
+        try
+        {
+            // Single-view: the id. Multi-view: all the views of a frame are consecutive
+            const auto& tDatum = (*tDatums)[0];
+            return tDatum->id * (tDatum->subIdMax + 1) + tDatum->subId;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    template<typename TDatums>
+    void WQueueOrderer<TDatums>::skipUntil(const unsigned long long sequence)
+    {
+        try
+        {
+            // The buffered ones before sequence are released in order (at most 1 window to visit)
+            const auto lastSequence = fastMin(sequence, mNextSequence + mWindow.size());
+            for (auto currentSequence = mNextSequence ; currentSequence < lastSequence ; currentSequence++)
+            {
+                auto& slot = mWindow[currentSequence % mWindow.size()];
+                if (slot != nullptr)
+                {
+                    mReleasedTDatums.emplace_back(slot);
+                    slot = nullptr;
+                    mWindowElements--;
+                }
+            }
+            mNextSequence = sequence;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    TDatums WQueueOrderer<TDatums>::release()
+    {
+        try
+        {
+            // Already skipped over
+            if (!mReleasedTDatums.empty())
+            {
+                auto tDatums = mReleasedTDatums.front();
+                mReleasedTDatums.pop_front();
+                return tDatums;
+            }
+            if (mWindowElements == 0)
+                return nullptr;
+            // Next expected one missing -> keep waiting for it unless it waited for too long or we want to stop this
+            // worker, in which case the missing ones are skipped (the window is not empty, so at most 1 window)
+            if (mWindow[mNextSequence % mWindow.size()] == nullptr)
+            {
+                if (!mStopWhenEmpty && !waitedTooLong())
+                    return nullptr;
+                while (mWindow[mNextSequence % mWindow.size()] == nullptr)
+                    mNextSequence++;
+            }
+            // Release the next one
+            TDatums tDatums;
+            std::swap(tDatums, mWindow[mNextSequence % mWindow.size()]);
+            mWindowElements--;
+            mNextSequence++;
+            return tDatums;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    template<typename TDatums>
+    bool WQueueOrderer<TDatums>::waitedTooLong()
+    {
+        try
+        {
+            if (mMaxWaitSeconds <= 0.)
+                return false;
+            // New missing frame -> restart timer
+            if (!mWaiting || mWaitingSequence != mNextSequence)
+            {
+                mWaiting = true;
+                mWaitingSequence = mNextSequence;
+                mWaitingTimerInit = getTimerInit();
+                return false;
+            }
+            return getTimeSeconds(mWaitingTimerInit) > mMaxWaitSeconds;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
     COMPILE_TEMPLATE_DATUM(WQueueOrderer);
 }
 
@@ -0,0 +1,111 @@
+#ifndef OPENPOSE_THREAD_W_VIEW_GPU_AFFINITY_HPP
+#define OPENPOSE_THREAD_W_VIEW_GPU_AFFINITY_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    /**
+     * WViewGpuAffinity assigns each camera view of the multi-view frame sets (split by WDatumProducer, 1 view per
+     * TDatums) to a fixed GPU pose thread: view subId goes to GPU subId % numberGpus. Thus, the views of each frame
+     * set run in parallel on all the GPUs (rather than whichever GPU pops them, which can take several views of the
+     * same set while the other GPUs are busy with the next one), and each GPU always processes the same cameras.
+     * WQueueAssembler merges them back (after WQueueOrderer sorts them by id and subId) before the 3-D
+     * reconstruction. It must be the first TWorker of each GPU thread, and all the GPU threads popping from the same
+     * queue must have one (see Worker::acceptsInput()). The single-view TDatums are accepted by any GPU.
+     */
+    template<typename TDatums>
+    class WViewGpuAffinity : public Worker<TDatums>
+    {
+    public:
+        explicit WViewGpuAffinity(const int gpu, const int numberGpus);
+
+        virtual ~WViewGpuAffinity();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+        bool filtersInput() const;
+
+        bool acceptsInput(const TDatums& tDatums);
+
+    private:
+        const int mGpu;
+        const int mNumberGpus;
+
+        DELETE_COPY(WViewGpuAffinity);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WViewGpuAffinity<TDatums>::WViewGpuAffinity(const int gpu, const int numberGpus) :
+        mGpu{gpu},
+        mNumberGpus{numberGpus}
+    {
+        try
+        {
+            if (mNumberGpus < 1 || mGpu < 0 || mGpu >= mNumberGpus)
+                error("Invalid GPU (" + std::to_string(mGpu) + ") or number of GPUs ("
+                      + std::to_string(mNumberGpus) + ").", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    WViewGpuAffinity<TDatums>::~WViewGpuAffinity()
+    {
+    }
+
+    template<typename TDatums>
+    void WViewGpuAffinity<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WViewGpuAffinity<TDatums>::work(TDatums& tDatums)
+    {
+        UNUSED(tDatums);
+    }
+
+    template<typename TDatums>
+    bool WViewGpuAffinity<TDatums>::filtersInput() const
+    {
+        return true;
+    }
+
+    template<typename TDatums>
+    bool WViewGpuAffinity<TDatums>::acceptsInput(const TDatums& tDatums)
+    {
+        try
+        {
+            // Empty ones (e.g., end of the producer) and single views are accepted by any GPU
+            if (!checkNoNullNorEmpty(tDatums))
+                return true;
+            const auto& tDatumPtr = (*tDatums)[0];
+            return (tDatumPtr == nullptr || tDatumPtr->subIdMax == 0
+                    || (int)(tDatumPtr->subId % (unsigned long long)mNumberGpus) == mGpu);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WViewGpuAffinity);
+}
+
+#endif // OPENPOSE_THREAD_W_VIEW_GPU_AFFINITY_HPP
@@ -34,6 +34,64 @@ namespace op
             stop();
         }
 
+        /**
+         * Number of TDatums still waiting in the input queue of its thread right after the current TDatums was popped
+         * (0 if its thread has no input queue). Workers can use it to skip stale work (e.g., WGui).
+         */
+        inline unsigned long long getQueueInBacklog() const
+        {
+            return mQueueInBacklog;
+        }
+
+        inline void setQueueInBacklog(const unsigned long long queueInBacklog)
+        {
+            mQueueInBacklog = queueInBacklog;
+        }
+
+        /**
+         * Whether a new TDatums should be popped from the input queue of its thread (which has queueInSize
+         * elements). Only checked for the first TWorker of the threads with an input and an output queue. If false,
+         * the TDatums are left in the queue for the other threads popping from it (e.g., WGpuDispatch), and the
+         * TWorkers work with nullptr TDatums (e.g., to keep emptying their buffers).
+         */
+        inline virtual bool isReadyForInput(const unsigned long long queueInSize)
+        {
+            UNUSED(queueInSize);
+            return true;
+        }
+
+        /**
+         * Whether acceptsInput() filters the TDatums popped by its thread. Only checked for the first TWorker of the
+         * threads with an input and an output queue.
+         */
+        inline virtual bool filtersInput() const
+        {
+            return false;
+        }
+
+        /**
+         * If filtersInput(), whether its thread should pop tDatums, the next element of its input queue (checked
+         * while the queue is locked, see QueueBase::tryPopIf()). If false, tDatums is left in the queue for the other
+         * threads popping from it (e.g., WViewGpuAffinity), as with isReadyForInput().
+         */
+        inline virtual bool acceptsInput(const TDatums& tDatums)
+        {
+            UNUSED(tDatums);
+            return true;
+        }
+
+        /**
+         * Whether work() can be skipped for the (non-empty) tDatums because all the Datum fields that this TWorker
+         * reads are empty (e.g., no people detected), so its output fields would keep their default (empty) values.
+         * checkAndWork() checks it before each work() call. It defaults to false, so only the TWorkers that override
+         * it (e.g., WFaceDetector, WHandExtractorNet or WKeypointScaler) are ever skipped.
+         */
+        inline virtual bool isSkippable(const TDatums& tDatums) const
+        {
+            UNUSED(tDatums);
+            return false;
+        }
+
     protected:
         virtual void initializationOnThread() = 0;
 
@@ -41,6 +99,7 @@ namespace op
 
     private:
         bool mIsRunning;
+        unsigned long long mQueueInBacklog;
 
         DELETE_COPY(Worker);
     };
@@ -55,7 +114,8 @@ namespace op
 {
     template<typename TDatums>
     Worker<TDatums>::Worker() :
-        mIsRunning{true}
+        mIsRunning{true},
+        mQueueInBacklog{0ull}
     {
     }
 
@@ -83,7 +143,7 @@ namespace op
     {
         try
         {
-            if (mIsRunning)
+            if (mIsRunning && !isSkippable(tDatums))
                 work(tDatums);
             return mIsRunning;
         }
@@ -2,6 +2,7 @@
 #define OPENPOSE_TRACKING_HEADERS_HPP
 
 // tracking module
+#include <openpose/tracking/keypointExtrapolator.hpp>
 #include <openpose/tracking/personIdExtractor.hpp>
 #include <openpose/tracking/personTracker.hpp>
 #include <openpose/tracking/wPersonIdExtractor.hpp>
@@ -0,0 +1,62 @@
+#ifndef OPENPOSE_TRACKING_KEYPOINT_EXTRAPOLATOR_HPP
+#define OPENPOSE_TRACKING_KEYPOINT_EXTRAPOLATOR_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * KeypointExtrapolator is an image-free alternative to PersonTracker for `--tracking` > 0, i.e., when the body
+     * network only runs once every few frames (keyframes). Each keypoint of each person (by person ID, see
+     * PersonIdExtractor) has a constant-velocity Kalman filter, updated with the detected keypoints of the keyframes,
+     * and the frames in between get the keypoints predicted by them. Unlike the LK tracking of PersonTracker, it does
+     * not read the images, so its cost does not depend on the image resolution and the GPU frames (e.g.,
+     * `--video_nvdec`) do not need to be downloaded.
+     */
+    class OP_API KeypointExtrapolator
+    {
+    public:
+        /**
+         * @param confidenceThreshold Minimum score of a detected keypoint to update its filter.
+         * @param processNoise Variance of the (random) acceleration of the keypoints between consecutive frames (in
+         * squared pixels). Higher values follow faster the velocity changes.
+         * @param measurementNoise Variance of the detected keypoint locations (in squared pixels). Higher values
+         * smooth more the keypoints of the keyframes.
+         */
+        KeypointExtrapolator(
+            const float confidenceThreshold = 0.05f, const float processNoise = 4.f,
+            const float measurementNoise = 4.f);
+
+        virtual ~KeypointExtrapolator();
+
+        /**
+         * It must be called for every frame, in order.
+         * @param poseKeypoints Keypoints of the frame. If isKeyframe, the filters are updated with them (and they are
+         * not modified). Otherwise, they are replaced by the predicted ones.
+         * @param poseIds IDs of each person of poseKeypoints. If empty or -1 (i.e., no person identification), the
+         * person index is used as ID (only valid for 1 person). If not isKeyframe, they are replaced by the IDs of the
+         * predicted people.
+         * @param isKeyframe Whether poseKeypoints were detected by the body network in this frame.
+         */
+        void track(Array<float>& poseKeypoints, Array<long long>& poseIds, const bool isKeyframe);
+
+        /**
+         * Same than track(), but thread-safe, and waiting for the previous frameId to be tracked first (so several
+         * GPU threads can call it).
+         */
+        void trackLockThread(
+            Array<float>& poseKeypoints, Array<long long>& poseIds, const bool isKeyframe, const long long frameId);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplKeypointExtrapolator;
+        std::unique_ptr<ImplKeypointExtrapolator> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(KeypointExtrapolator);
+    };
+}
+
+#endif // OPENPOSE_TRACKING_KEYPOINT_EXTRAPOLATOR_HPP
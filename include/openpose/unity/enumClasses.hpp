@@ -0,0 +1,19 @@
+#ifndef OPENPOSE_UNITY_ENUM_CLASSES_HPP
+#define OPENPOSE_UNITY_ENUM_CLASSES_HPP
+
+namespace op
+{
+    /**
+     * Graphics API of the Unity native textures (see GraphicsTextureCuda). Its values match the ones of the Unity
+     * `UnityEngine.Rendering.GraphicsDeviceType` enum (i.e., `SystemInfo.graphicsDeviceType`).
+     */
+    enum class UnityGraphicsApi : unsigned char
+    {
+        Direct3D11 = 2,
+        OpenGLCore = 17,
+        Direct3D12 = 18,
+        Vulkan = 21,
+    };
+}
+
+#endif // OPENPOSE_UNITY_ENUM_CLASSES_HPP
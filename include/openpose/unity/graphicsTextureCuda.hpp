@@ -0,0 +1,52 @@
+#ifndef OPENPOSE_UNITY_GRAPHICS_TEXTURE_CUDA_HPP
+#define OPENPOSE_UNITY_GRAPHICS_TEXTURE_CUDA_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/core/renderTargetGpu.hpp>
+#include <openpose/unity/enumClasses.hpp>
+
+namespace op
+{
+    /**
+     * GraphicsTextureCuda writes the GPU render target of a Datum (Datum::outputDataGpu) straight into a native
+     * texture of a graphics API (e.g., the one of a Unity `Texture2D.GetNativeTexturePtr()`) with the CUDA graphics
+     * interoperability, so the rendered frames never go through the CPU memory. The texture must be an 8-bit RGBA
+     * one (e.g., `TextureFormat.RGBA32`) created on the same GPU than the render target, and it is resized if it does
+     * not have the size of the render target.
+     * Supported APIs: Direct3D 11 (Windows) and OpenGL Core. Direct3D 12 and Vulkan textures can only be imported into
+     * CUDA if they were allocated as exportable (shared) memory, which is not the case for the Unity ones.
+     * It requires OpenPose compiled with CUDA and `BUILD_UNITY_SUPPORT`.
+     */
+    class OP_API GraphicsTextureCuda
+    {
+    public:
+        /**
+         * @param nativeTexture ID3D11Texture2D* (Direct3D 11) or texture name (OpenGL, i.e., a GLuint cast into a
+         * pointer).
+         */
+        GraphicsTextureCuda(void* const nativeTexture, const UnityGraphicsApi graphicsApi);
+
+        virtual ~GraphicsTextureCuda();
+
+        /**
+         * It copies renderTarget into the texture (with a single CUDA synchronization), registering the texture on
+         * the device of renderTarget the first time. With OpenGL, it must be called from the thread owning the
+         * OpenGL context (e.g., the Unity render thread, see `GL.IssuePluginEvent()`), and so must be the destructor.
+         * @param flipVertically Whether to write the rows bottom-up (e.g., Unity textures, whose first row is the
+         * bottom one).
+         */
+        void copyFrom(const RenderTargetGpu& renderTarget, const bool flipVertically = true);
+
+        void* getNativeTexture() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplGraphicsTextureCuda;
+        std::unique_ptr<ImplGraphicsTextureCuda> upImpl;
+
+        DELETE_COPY(GraphicsTextureCuda);
+    };
+}
+
+#endif // OPENPOSE_UNITY_GRAPHICS_TEXTURE_CUDA_HPP
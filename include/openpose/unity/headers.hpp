@@ -2,6 +2,8 @@
 #define OPENPOSE_UNITY_HEADERS_HPP
 
 // unity module
+#include <openpose/unity/enumClasses.hpp>
+#include <openpose/unity/graphicsTextureCuda.hpp>
 #include <openpose/unity/unityBinding.hpp>
 
 #endif // OPENPOSE_UNITY_HEADERS_HPP
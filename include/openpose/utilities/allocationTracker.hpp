@@ -0,0 +1,62 @@
+#ifndef OPENPOSE_UTILITIES_ALLOCATION_TRACKER_HPP
+#define OPENPOSE_UTILITIES_ALLOCATION_TRACKER_HPP
+
+#include <atomic>
+#include <openpose/core/macros.hpp>
+#include <openpose/utilities/enumClasses.hpp>
+
+namespace op
+{
+    /**
+     * Allocations and copies recorded by AllocationTracker on a thread.
+     */
+    struct OP_API AllocationCounters
+    {
+        unsigned long long hostAllocations;
+        unsigned long long hostAllocatedBytes;
+        unsigned long long gpuAllocations;
+        unsigned long long gpuAllocatedBytes;
+        unsigned long long copiedBytes[(unsigned char)MemoryCopy::Size];
+
+        AllocationCounters();
+
+        /**
+         * @return Allocations and copies recorded since begin (a previous getThreadCounters() of the same thread).
+         */
+        AllocationCounters operator-(const AllocationCounters& begin) const;
+    };
+
+    /**
+     * AllocationTracker counts the memory allocated and copied by the instrumented OpenPose code (Array, Matrix,
+     * ArrayCpuGpu, cudaPoolMalloc and the main host-device copies of the pipeline). The counters are thread-local,
+     * so SubThread attributes them to the Worker that was running (exported by Metrics as the
+     * `openpose_worker_allocated_bytes`, `openpose_worker_allocations` and `openpose_worker_copied_bytes`
+     * histograms, with 1 value per processed frame).
+     * It is disabled by default and, while disabled, each hook only checks isEnabled() (a single atomic load).
+     * Only the memory that OpenPose allocates or copies is counted, e.g., not the one allocated internally by Caffe
+     * or OpenCV functions.
+     */
+    class OP_API AllocationTracker
+    {
+    public:
+        static void setEnabled(const bool enabled);
+
+        static bool isEnabled();
+
+        /**
+         * @return The counters of the calling thread (monotonically increasing since it started).
+         */
+        static AllocationCounters getThreadCounters();
+
+        static void recordHostAllocation(const unsigned long long bytes);
+
+        static void recordGpuAllocation(const unsigned long long bytes);
+
+        static void recordCopy(const unsigned long long bytes, const MemoryCopy memoryCopy);
+
+    private:
+        static std::atomic<bool> sEnabled;
+    };
+}
+
+#endif // OPENPOSE_UTILITIES_ALLOCATION_TRACKER_HPP
@@ -33,6 +33,18 @@ namespace op
         Images, // jpg, png, ...
         Size
     };
+
+    /**
+     * Direction of a memory copy (same order as cudaMemcpyKind).
+     */
+    enum class MemoryCopy : unsigned char
+    {
+        HostToHost = 0,
+        HostToDevice,
+        DeviceToHost,
+        DeviceToDevice,
+        Size,
+    };
 }
 
 #endif // OPENPOSE_UTILITIES_ENUM_CLASSES_HPP
@@ -75,6 +75,34 @@ namespace op
         errorDestructor(tToString(message), line, function, file);
     }
 
+    // This class is not fully thread-safe
+    namespace ConfigureLog
+    {
+        OP_API Priority getPriorityThreshold();
+
+        OP_API const std::vector<LogMode>& getLogModes();
+
+        // This function is not thread-safe. It must be run at the beginning
+        OP_API void setPriorityThreshold(const Priority priorityThreshold);
+
+        // This function is not thread-safe. It must be run at the beginning
+        OP_API void setLogModes(const std::vector<LogMode>& loggingModes);
+
+        OP_API bool getAsynchronous();
+
+        /**
+         * Asynchronous logging: opLog() only enqueues the raw message (into a lock-free buffer of the calling
+         * thread), and a background thread composes it (location and time) and writes it (std::cout, file logging,
+         * and Unity), so the calling threads are not blocked by the output. Errors are still written synchronously,
+         * after the pending messages.
+         * This function is not thread-safe. It must be run at the beginning
+         */
+        OP_API void setAsynchronous(const bool asynchronous);
+
+        // It blocks until all the pending asynchronous messages are written
+        OP_API void flush();
+    }
+
     // Printing info - How to use:
         // It will print info if desiredPriority >= sPriorityThreshold
         // opLog(message, desiredPriority, __LINE__, __FUNCTION__, __FILE__);
@@ -87,7 +115,9 @@ namespace op
         const T& message, const Priority priority = Priority::Max, const int line = -1,
         const std::string& function = "", const std::string& file = "")
     {
-        opLog(tToString(message), priority, line, function, file);
+        // Not converted into std::string if it is not going to be printed
+        if (priority >= ConfigureLog::getPriorityThreshold())
+            opLog(tToString(message), priority, line, function, file);
     }
 
     // If only desired on debug mode (no computational cost at all on release mode):
@@ -116,20 +146,6 @@ namespace op
 
         OP_API void setErrorModes(const std::vector<ErrorMode>& errorModes);
     }
-
-    // This class is not fully thread-safe
-    namespace ConfigureLog
-    {
-        OP_API Priority getPriorityThreshold();
-
-        OP_API const std::vector<LogMode>& getLogModes();
-
-        // This function is not thread-safe. It must be run at the beginning
-        OP_API void setPriorityThreshold(const Priority priorityThreshold);
-
-        // This function is not thread-safe. It must be run at the beginning
-        OP_API void setLogModes(const std::vector<LogMode>& loggingModes);
-    }
 }
 
 #endif // OPENPOSE_UTILITIES_ERROR_AND_LOG_HPP
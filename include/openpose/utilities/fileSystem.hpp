@@ -1,6 +1,7 @@
 #ifndef OPENPOSE_UTILITIES_FILE_SYSTEM_HPP
 #define OPENPOSE_UTILITIES_FILE_SYSTEM_HPP
 
+#include <functional>
 #include <openpose/core/common.hpp>
 
 namespace op
@@ -85,6 +86,36 @@ namespace op
     OP_API std::vector<std::string> getFilesOnDirectory(
         const std::string& directoryPath, const Extensions extensions);
 
+    /**
+     * This function lists the files of a directory without loading nor sorting the whole list: onFile is called
+     * with each file path (with one of the desired extensions) as soon as it is read, in the order given by the
+     * file system. Useful to start processing the first files of huge directories while the listing continues.
+     * @param directoryPath std::string with the directory path.
+     * @param extensions std::vector<std::string> with the extensions of the desired files (empty for all of them).
+     * @param onFile Function called with each one of the desired file paths.
+     * @return Number of desired files found.
+     */
+    OP_API unsigned long long forEachFileOnDirectory(
+        const std::string& directoryPath, const std::vector<std::string>& extensions,
+        const std::function<void(std::string&&)>& onFile);
+
+    /**
+     * Analogous to forEachFileOnDirectory(const std::string& directoryPath,
+     * const std::vector<std::string>& extensions, const std::function<void(std::string&&)>& onFile), but
+     * for a kind of extensions (e.g., Extensions:Images).
+     */
+    OP_API unsigned long long forEachFileOnDirectory(
+        const std::string& directoryPath, const Extensions extensions,
+        const std::function<void(std::string&&)>& onFile);
+
+    /**
+     * This function sorts the strings in natural order (e.g., `image_2.jpg` before `image_10.jpg`, and case
+     * insensitive), as done by getFilesOnDirectory. Each string is tokenized only once, so sorting millions of
+     * paths does not allocate on each comparison.
+     * @param strings std::vector<std::string> with the strings to sort.
+     */
+    OP_API void sortNatural(std::vector<std::string>& strings);
+
     OP_API std::string removeSpecialsCharacters(const std::string& stringToVariate);
 
     OP_API void removeAllOcurrencesOfSubString(std::string& stringToModify, const std::string& substring);
@@ -3,9 +3,11 @@
 
 #include <openpose/core/common.hpp>
 #include <openpose/core/enumClasses.hpp>
+#include <openpose/filestream/enumClasses.hpp>
 #include <openpose/gui/enumClasses.hpp>
 #include <openpose/pose/enumClasses.hpp>
 #include <openpose/producer/enumClasses.hpp>
+#include <openpose/thread/enumClasses.hpp>
 #include <openpose/wrapper/enumClasses.hpp>
 
 namespace op
@@ -20,14 +22,24 @@ namespace op
 
     OP_API Detector flagsToDetector(const int detector);
 
+    OP_API ThreadPriority flagsToThreadPriority(const int threadPriority);
+
+    OP_API QueueType flagsToQueueType(const int queueType);
+
     // Determine type of frame source
     OP_API ProducerType flagsToProducerType(
         const String& imageDirectory, const String& videoPath, const String& ipCameraPath,
-        const int webcamIndex, const bool flirCamera);
+        const int webcamIndex, const bool flirCamera, const String& replayPath = String(""),
+        const String& sharedMemoryName = String(""));
 
+    /**
+     * @param replayPath If not empty, path of an input recording (see ReplayReader).
+     * @param sharedMemoryName If not empty, name of a shared memory frame ring buffer (see SharedMemoryReader).
+     */
     OP_API std::pair<ProducerType, String> flagsToProducer(
         const String& imageDirectory, const String& videoPath, const String& ipCameraPath = String(""),
-        const int webcamIndex = -1, const bool flirCamera = false, const int flirCameraIndex = -1);
+        const int webcamIndex = -1, const bool flirCamera = false, const int flirCameraIndex = -1,
+        const String& replayPath = String(""), const String& sharedMemoryName = String(""));
 
     OP_API std::vector<HeatMapType> flagsToHeatMaps(
         const bool heatMapsAddParts = false, const bool heatMapsAddBkg = false,
@@ -43,6 +55,25 @@ namespace op
      * E.g., const Point<int> resolution = flagsToPoint(resolutionString, "1280x720");
      */
     OP_API Point<int> flagsToPoint(const String& pointString, const String& pointExample);
+
+    /**
+     * E.g., flagsToInputRois(op::String(FLAGS_input_roi)) with "0,300 1920,1080;0,0 100,0 100,100" returns a
+     * rectangle (2 points) for the first view and a triangle for the second one. Empty string for no region.
+     */
+    OP_API std::vector<std::vector<Point<int>>> flagsToInputRois(const String& inputRoisString);
+
+    /**
+     * E.g., flagsToDoubles(op::String(FLAGS_source_max_latency_ms)) with "100,0" returns {100., 0.}. Empty string
+     * for an empty vector.
+     */
+    OP_API std::vector<double> flagsToDoubles(const String& doublesString);
+
+    /**
+     * E.g., flagsToDatumWireFields(op::String(FLAGS_datum_send_fields)) with "frame,keypoints" returns
+     * DatumWireField::Frame | DatumWireField::Keypoints. The fields are `frame`, `net_input`, `keypoints`,
+     * `keypoints_3d`, `output_frame` and `all`.
+     */
+    OP_API DatumWireField flagsToDatumWireFields(const String& datumWireFieldsString);
 }
 
 #endif // OPENPOSE_UTILITIES_FLAGS_TO_OPEN_POSE_HPP
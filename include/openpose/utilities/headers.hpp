@@ -2,6 +2,7 @@
 #define OPENPOSE_UTILITIES_HEADERS_HPP
 
 // utilities module
+#include <openpose/utilities/allocationTracker.hpp>
 #include <openpose/utilities/check.hpp>
 #include <openpose/utilities/enumClasses.hpp>
 #include <openpose/utilities/errorAndLog.hpp>
@@ -9,10 +10,13 @@
 #include <openpose/utilities/fileSystem.hpp>
 #include <openpose/utilities/flagsToOpenPose.hpp>
 #include <openpose/utilities/keypoint.hpp>
+#include <openpose/utilities/keypointSoa.hpp>
+#include <openpose/utilities/metrics.hpp>
 #include <openpose/utilities/openCv.hpp>
 #include <openpose/utilities/pointerContainer.hpp>
 #include <openpose/utilities/profiler.hpp>
 #include <openpose/utilities/standard.hpp>
 #include <openpose/utilities/string.hpp>
+#include <openpose/utilities/tracer.hpp>
 
 #endif // OPENPOSE_UTILITIES_HEADERS_HPP
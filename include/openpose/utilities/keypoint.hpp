@@ -20,6 +20,13 @@ namespace op
     template <typename T>
     void scaleKeypoints2d(Array<T>& keypoints, const T scaleX, const T scaleY, const T offsetX, const T offsetY);
 
+    /**
+     * It adds (offsetX, offsetY) to the (x,y,score) elements of keypoints (any size whose last dimension is 3, e.g.,
+     * #people x #parts x 3 or #candidates x 3) with score > 0, so the non-detected ones are still (0,0,0).
+     */
+    template <typename T>
+    void offsetKeypoints2d(Array<T>& keypoints, const T offsetX, const T offsetY);
+
     template <typename T>
     void renderKeypointsCpu(
         Array<T>& frameArray, const Array<T>& keypoints, const std::vector<unsigned int>& pairs,
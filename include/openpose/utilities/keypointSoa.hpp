@@ -0,0 +1,105 @@
+#ifndef OPENPOSE_UTILITIES_KEYPOINT_SOA_HPP
+#define OPENPOSE_UTILITIES_KEYPOINT_SOA_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * KeypointSoa is a structure-of-arrays copy of the usual {#people, #parts, 3} keypoint Array<float> (e.g.,
+     * Datum::poseKeypoints), i.e., each person is stored as 3 consecutive planes (x, y and score), each one 32-byte
+     * aligned and padded (with 0s) to a multiple of 8 parts. Its reductions are the analogs of the ones of
+     * keypoint.hpp (same results, up to the floating point rounding of the sums), vectorized with AVX2 if
+     * available. It is meant to be built once per frame when several of them are called over the same keypoints.
+     * As Array, its copies share the same data (see clone() for a deep copy).
+     */
+    class OP_API KeypointSoa
+    {
+    public:
+        KeypointSoa();
+
+        explicit KeypointSoa(const Array<float>& keypoints);
+
+        /**
+         * It converts (and copies) keypoints (with size {#people, #parts, 3} or empty) into this SoA layout.
+         */
+        void reset(const Array<float>& keypoints);
+
+        KeypointSoa clone() const;
+
+        /**
+         * It converts it back into the usual {#people, #parts, 3} layout (an empty Array if empty()).
+         */
+        Array<float> toArray() const;
+
+        void toArray(Array<float>& keypoints) const;
+
+        inline bool empty() const
+        {
+            return mNumberPeople == 0;
+        }
+
+        inline int getNumberPeople() const
+        {
+            return mNumberPeople;
+        }
+
+        inline int getNumberParts() const
+        {
+            return mNumberParts;
+        }
+
+        /**
+         * Number of elements of each plane (i.e., getNumberParts() rounded up to a multiple of 8).
+         */
+        inline int getStride() const
+        {
+            return mStride;
+        }
+
+        const float* getXPtr(const int person) const;
+
+        const float* getYPtr(const int person) const;
+
+        const float* getScorePtr(const int person) const;
+
+        float* getXPtr(const int person);
+
+        float* getYPtr(const int person);
+
+        float* getScorePtr(const int person);
+
+        // Analog of getKeypointsRectangle()
+        Rectangle<float> getRectangle(
+            const int person, const float threshold, const int firstIndex = 0, const int lastIndex = -1) const;
+
+        // Analog of getAverageScore()
+        float getAverageScore(const int person) const;
+
+        // Analog of getKeypointsArea()
+        float getArea(const int person, const float threshold) const;
+
+        // Analog of getBiggestPerson()
+        int getBiggestPerson(const float threshold) const;
+
+        // Analog of getNonZeroKeypoints()
+        int getNonZeroKeypoints(const int person, const float threshold) const;
+
+        // Analog of getDistanceAverage()
+        float getDistanceAverage(
+            const int personA, const KeypointSoa& keypointsB, const int personB, const float threshold) const;
+
+        // Analog of getKeypointsRoi()
+        float getRoi(const int personA, const KeypointSoa& keypointsB, const int personB, const float threshold) const;
+
+    private:
+        int mNumberPeople;
+        int mNumberParts;
+        int mStride;
+        std::shared_ptr<float> spData;
+
+        void checkPerson(const int person) const;
+    };
+}
+
+#endif // OPENPOSE_UTILITIES_KEYPOINT_SOA_HPP
@@ -0,0 +1,113 @@
+#ifndef OPENPOSE_UTILITIES_METRICS_HPP
+#define OPENPOSE_UTILITIES_METRICS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <typeinfo>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Lock-free HDR (high dynamic range) histogram of non-negative integer values (e.g., microseconds).
+     * Values are stored in log-linear buckets (each power of 2 is split into 16 linear sub-buckets), so the relative
+     * error of any recorded value (and therefore of any quantile) is lower than 6.25% over the whole range.
+     * record() only performs relaxed atomic operations, so any number of threads can record concurrently (and while
+     * the histogram is being read) without locks.
+     */
+    class OP_API Histogram
+    {
+    public:
+        Histogram();
+
+        virtual ~Histogram();
+
+        void record(const unsigned long long value);
+
+        unsigned long long getCount() const;
+
+        unsigned long long getSum() const;
+
+        unsigned long long getMax() const;
+
+        /**
+         * @param quantile Quantile in the range [0, 1] (e.g., 0.99 for the 99th percentile).
+         * @return Approximated value (upper bound of its bucket) at the desired quantile, or 0 if it is empty.
+         */
+        unsigned long long getValueAtQuantile(const double quantile) const;
+
+        /**
+         * Cumulative count of the recorded values that are lower or equal than each upperBounds element.
+         * Values lying in a bucket that contains an upper bound are counted on the next upper bound.
+         * @param upperBounds Increasingly sorted upper bounds (in the same units as record()).
+         * @return Cumulative counts, one per upperBounds element.
+         */
+        std::vector<unsigned long long> getCumulativeCounts(const std::vector<unsigned long long>& upperBounds) const;
+
+        void reset();
+
+    private:
+        std::vector<std::atomic<unsigned long long>> mBuckets;
+        std::atomic<unsigned long long> mCount;
+        std::atomic<unsigned long long> mSum;
+        std::atomic<unsigned long long> mMax;
+
+        DELETE_COPY(Histogram);
+    };
+
+    /**
+     * Metrics is a global registry of the OpenPose Histogram's (e.g., the Worker processing time, the time each
+     * SubThread waits for its input queue, and the depth of each ThreadManager queue), exported in the OpenMetrics
+     * (Prometheus) text format by toOpenMetrics() (e.g., by MetricsHttpExporter).
+     * It is disabled by default and can be enabled or disabled at any time (e.g., while OpenPose is running) with
+     * setEnabled(). While disabled, the instrumented code only checks isEnabled() (a single atomic load).
+     */
+    class OP_API Metrics
+    {
+    public:
+        static void setEnabled(const bool enabled);
+
+        static bool isEnabled();
+
+        /**
+         * It returns the Histogram of the given metric and labels, creating it the first time. Thread-safe, but it
+         * locks a mutex, so it should be called once per instrumented element (not on each record).
+         * @param name Metric family name, following the OpenMetrics conventions (e.g., `openpose_worker_seconds`).
+         * @param labels Comma-separated OpenMetrics labels (e.g., `thread="1",worker="0"`), or empty.
+         * @param help Description of the metric family.
+         * @param isTime If true, the values are recorded in microseconds and exported in seconds. Otherwise, they
+         * are exported as recorded (e.g., queue sizes), with byte buckets (1 KB to 1 GB) if name ends with `_bytes`.
+         */
+        static std::shared_ptr<Histogram> getHistogram(
+            const std::string& name, const std::string& labels, const std::string& help, const bool isTime);
+
+        /**
+         * @return All the registered histograms in the OpenMetrics text format (ended with `# EOF`).
+         */
+        static std::string toOpenMetrics();
+
+        /**
+         * It resets the values of all the registered histograms (they remain registered).
+         */
+        static void reset();
+
+        /**
+         * @return Human-readable class name (without namespace nor template arguments) of typeInfo, e.g.,
+         * `WPoseExtractor` for `typeid(*spWPoseExtractor)`. Used to label the metrics of each Worker.
+         */
+        static std::string getTypeName(const std::type_info& typeInfo);
+
+        // Auxiliary function for the instrumented code
+        static inline unsigned long long getMicroseconds(
+            const std::chrono::high_resolution_clock::time_point& begin,
+            const std::chrono::high_resolution_clock::time_point& end)
+        {
+            return (unsigned long long)std::chrono::duration_cast<std::chrono::microseconds>(end-begin).count();
+        }
+
+    private:
+        static std::atomic<bool> sEnabled;
+    };
+}
+
+#endif // OPENPOSE_UTILITIES_METRICS_HPP
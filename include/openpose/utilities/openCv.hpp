@@ -9,6 +9,17 @@ namespace op
 
     OP_API void uCharCvMatToFloatPtr(float* floatPtrImage, const Matrix& matImage, const int normalize);
 
+    /**
+     * Fused resizeFixedAspectRatio (i.e., cv::warpAffine with black padding) + uCharCvMatToFloatPtr for all the
+     * scales at once, without intermediate images: the BGR uchar matImage is read only once, in bands of rows (in
+     * parallel), and each band is resized, padded, split into channels and normalized into every floatPtrImages[i]
+     * (3 x targetSizes[i].y x targetSizes[i].x) while it is still in cache. Interpolation: bilinear if
+     * scaleFactors[i] <= 1 and bicubic otherwise (as in resizeFixedAspectRatio), with the weights in float.
+     */
+    OP_API void resizeAndPadUCharCvMatToFloatPtrs(
+        const std::vector<float*>& floatPtrImages, const Matrix& matImage, const std::vector<double>& scaleFactors,
+        const std::vector<Point<int>>& targetSizes, const int normalize);
+
     OP_API double resizeGetScaleFactor(const Point<int>& initialSize, const Point<int>& targetSize);
 
     OP_API void keepRoiInside(Rectangle<int>& roi, const int imageWidth, const int imageHeight);
@@ -3,6 +3,7 @@
 
 #include <chrono>
 #include <string>
+#include <vector>
 #include <openpose/core/macros.hpp>
 #include <openpose/utilities/enumClasses.hpp>
 
@@ -63,13 +64,38 @@ namespace op
         cudaCheck(__LINE__, __FUNCTION__, __FILE__); \
     }
 
-    // Enable PROFILER_ENABLED on Makefile.config or CMake in order to use this function. Otherwise nothing will be outputted.
+    // Started timer of Profiler::timerInit()
+    struct ProfilerKey
+    {
+        unsigned int timerId;
+        unsigned long long ticks;
+    };
+
+    // Aggregated statistics of a timer (all threads), see Profiler::getTimerStats()
+    struct ProfilerTimerStats
+    {
+        // file:function():line of the timer
+        std::string name;
+        unsigned long long calls;
+        double totalMs;
+        double averageMs;
+        // Since the previous background aggregation (about 1 second)
+        unsigned long long lastPeriodCalls;
+        double lastPeriodAverageMs;
+    };
+
+    // The timers are always running (they cost a couple of time-stamp counter reads and a few non-locking writes into
+    // the accumulators of the calling thread), and their statistics can be queried anytime with getTimerStats(). The
+    // accumulators of all threads are aggregated by a background thread. Enable PROFILER_ENABLED on Makefile.config
+    // or CMake in order to also print them (printAveraged...() functions) and profileGpuMemory(). Otherwise, those
+    // functions do not output anything.
     // How to use - example:
     // For GPU - It can only be applied in the main.cpp file:
         // Profiler::profileGpuMemory(__LINE__, __FUNCTION__, __FILE__);
     // For time:
         // // ... inside continuous loop ...
-        // const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+        // static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+        // const auto profilerKey = Profiler::timerInit(profilerTimerId);
         // // functions to do...
         // Profiler::timerEnd(profilerKey);
         // Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__, NUMBER_ITERATIONS);
@@ -81,18 +107,35 @@ namespace op
         // Non-thread safe, it must be performed at the beginning of the code before any parallelization occurs
         static void setDefaultX(const unsigned long long defaultX);
 
-        static const std::string timerInit(const int line, const std::string& function, const std::string& file);
+        /**
+         * It returns the ID of the timer of that location (the same ID if it was already registered). It locks, so
+         * it should be called once per location (e.g., into a function-local static variable).
+         */
+        static unsigned int registerTimer(const int line, const std::string& function, const std::string& file);
+
+        static ProfilerKey timerInit(const unsigned int timerId);
 
-        static void timerEnd(const std::string& key);
+        // Analogous to timerInit(registerTimer(line, function, file)), i.e., it locks on every call
+        static ProfilerKey timerInit(const int line, const std::string& function, const std::string& file);
 
+        static void timerEnd(const ProfilerKey& profilerKey);
+
+        // It prints the average time of the calling thread when its number of timerEnd() calls reaches x
         static void printAveragedTimeMsOnIterationX(
-            const std::string& key, const int line, const std::string& function, const std::string& file,
+            const ProfilerKey& profilerKey, const int line, const std::string& function, const std::string& file,
             const unsigned long long x = DEFAULT_X);
 
+        // It prints (and restarts) the average time of the calling thread every x timerEnd() calls
         static void printAveragedTimeMsEveryXIterations(
-            const std::string& key, const int line, const std::string& function, const std::string& file,
+            const ProfilerKey& profilerKey, const int line, const std::string& function, const std::string& file,
             const unsigned long long x = DEFAULT_X);
 
+        /**
+         * Statistics of all the timers that have been called at least once, with the accumulators of all threads up
+         * to this call. Thread-safe.
+         */
+        static std::vector<ProfilerTimerStats> getTimerStats();
+
         static void profileGpuMemory(const int line, const std::string& function, const std::string& file);
     };
 }
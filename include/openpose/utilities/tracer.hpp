@@ -0,0 +1,112 @@
+#ifndef OPENPOSE_UTILITIES_TRACER_HPP
+#define OPENPOSE_UTILITIES_TRACER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Tracer records timeline events (begin and end time, name and Datum id) into a ring buffer per thread, and
+     * saves them in the Chrome Trace JSON format (viewable with chrome://tracing or https://ui.perfetto.dev), so a
+     * single file shows which worker processed each Datum and when, and which thread was waiting for (or blocked
+     * by) which queue.
+     * SubThread records each worker call and queue wait, and TraceRange is used around the network forward pass and
+     * the GPU post-processing (resize and merge, NMS, and body part connection). If OpenPose is compiled with
+     * WITH_NVTX, TraceRange also adds NVTX ranges, so the same ranges appear in NVIDIA Nsight Systems next to the
+     * CUDA kernels.
+     * It is disabled by default. While disabled, the instrumented code only checks isEnabled() (a single atomic
+     * load).
+     */
+    class OP_API Tracer
+    {
+    public:
+        /**
+         * Enable or disable the recording. Enabling it (again) clears any previous event.
+         * @param maxEventsPerThread Size of each thread ring buffer. Once full, the oldest events are overwritten.
+         */
+        static void setEnabled(const bool enabled, const unsigned long long maxEventsPerThread = 100000ull);
+
+        static bool isEnabled();
+
+        /**
+         * It returns a pointer to a permanent copy of name, which can be used with record() and TraceRange. It
+         * locks a mutex, so it should be called once per name (not on each record).
+         */
+        static const char* getName(const std::string& name);
+
+        /**
+         * Thread-safe. Each thread records into its own ring buffer.
+         * @param name Event name, with static lifetime (e.g., a string literal or the result of getName()).
+         * @param id Datum id (or -1 if unknown).
+         */
+        static void record(
+            const char* const name, const long long id, const std::chrono::high_resolution_clock::time_point& begin,
+            const std::chrono::high_resolution_clock::time_point& end);
+
+        /**
+         * Name of the calling thread in the trace (e.g., `Thread 2`).
+         */
+        static void setThreadName(const std::string& threadName);
+
+        /**
+         * It saves all the recorded events in the Chrome Trace JSON format.
+         */
+        static void saveChromeTrace(const std::string& filePath);
+
+    private:
+        static std::atomic<bool> sEnabled;
+    };
+
+    /**
+     * TraceRange records a Tracer event (and an NVTX range, if compiled with WITH_NVTX) covering its lifetime. Usage:
+     * {
+     *     const TraceRange traceRange{"NetCaffe::forwardPass"};
+     *     // ... code to trace
+     * }
+     * Note that GPU kernels are asynchronous, so the Tracer event only covers the CPU time launching them unless the
+     * code synchronizes (the NVTX range lets Nsight Systems correlate it with the actual kernel execution).
+     */
+    class OP_API TraceRange
+    {
+    public:
+        /**
+         * @param name Event name, with static lifetime (e.g., a string literal or the result of Tracer::getName()).
+         * @param id Datum id (or -1 if unknown).
+         */
+        explicit TraceRange(const char* const name, const long long id = -1ll);
+
+        virtual ~TraceRange();
+
+    private:
+        const char* const pName;
+        const long long mId;
+        const bool mEnabled;
+        const std::chrono::high_resolution_clock::time_point mBegin;
+
+        DELETE_COPY(TraceRange);
+    };
+
+    /**
+     * Datum id of the first element of TDatums (or -1 if empty), for the Tracer events.
+     */
+    template<typename TDatum>
+    inline long long getTraceId(const std::shared_ptr<std::vector<std::shared_ptr<TDatum>>>& tDatums)
+    {
+        return (tDatums != nullptr && !tDatums->empty() && tDatums->at(0) != nullptr
+            ? (long long)tDatums->at(0)->id : -1ll);
+    }
+
+    /**
+     * Any other TDatums type has no known Datum id.
+     */
+    template<typename TDatums>
+    inline long long getTraceId(const TDatums& tDatums)
+    {
+        UNUSED(tDatums);
+        return -1ll;
+    }
+}
+
+#endif // OPENPOSE_UTILITIES_TRACER_HPP
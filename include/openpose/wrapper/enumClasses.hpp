@@ -17,6 +17,7 @@ namespace op
         OpenCV,
         Provided,
         BodyWithTracking,
+        Net,
         Size,
     };
 
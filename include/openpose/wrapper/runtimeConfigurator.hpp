@@ -0,0 +1,71 @@
+#ifndef OPENPOSE_WRAPPER_RUNTIME_CONFIGURATOR_HPP
+#define OPENPOSE_WRAPPER_RUNTIME_CONFIGURATOR_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/core/renderer.hpp>
+#include <openpose/core/scaleAndSizeExtractor.hpp>
+#include <openpose/face/faceExtractorNet.hpp>
+#include <openpose/hand/handExtractorNet.hpp>
+#include <openpose/wrapper/wrapperStructRuntime.hpp>
+
+namespace op
+{
+    /**
+     * RuntimeConfigurator applies the changes of WrapperT::reconfigure() to the components of a running pipeline,
+     * without stopping it nor reloading its networks:
+     * - The face and hand networks are enabled or disabled (see FaceExtractorNet::setEnabled()), and a network that
+     *   started disabled is loaded the first time it is enabled.
+     * - The render settings are changed directly on the pose renderers (their setters are thread-safe).
+     * - The network input resolution is only applied between 2 frames by applyPending(), called by
+     *   WRuntimeConfigurator on the thread of the ScaleAndSizeExtractor, and the networks are reshaped by their
+     *   next forward pass.
+     * reconfigure() can be called from any thread.
+     */
+    class OP_API RuntimeConfigurator
+    {
+    public:
+        RuntimeConfigurator();
+
+        virtual ~RuntimeConfigurator();
+
+        /**
+         * It sets the components of the pipeline that can be reconfigured (any of them can be nullptr or empty).
+         * @param netInputSizeEditable Whether netInputSize can be changed (e.g., not with the adaptive network
+         * resolution nor with tiled inference, which already control it).
+         */
+        void setComponents(
+            const std::shared_ptr<ScaleAndSizeExtractor>& scaleAndSizeExtractor, const bool netInputSizeEditable,
+            const std::vector<std::shared_ptr<FaceExtractorNet>>& faceExtractorNets,
+            const std::vector<std::shared_ptr<HandExtractorNet>>& handExtractorNets,
+            const std::vector<std::shared_ptr<Renderer>>& poseRenderers);
+
+        /**
+         * It releases the components of the last configured pipeline (e.g., once it is stopped).
+         */
+        void clear();
+
+        /**
+         * It validates and applies wrapperStructRuntime (or queues it for applyPending()). It throws if any of its
+         * elements cannot be applied to the current pipeline, in which case nothing is changed.
+         */
+        void reconfigure(const WrapperStructRuntime& wrapperStructRuntime);
+
+        /**
+         * It applies the queued network input resolution, if any. It must be called from the thread that uses the
+         * ScaleAndSizeExtractor, between 2 frames.
+         */
+        void applyPending();
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplRuntimeConfigurator;
+        std::unique_ptr<ImplRuntimeConfigurator> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(RuntimeConfigurator);
+    };
+}
+
+#endif // OPENPOSE_WRAPPER_RUNTIME_CONFIGURATOR_HPP
@@ -0,0 +1,84 @@
+#ifndef OPENPOSE_WRAPPER_W_RUNTIME_CONFIGURATOR_HPP
+#define OPENPOSE_WRAPPER_W_RUNTIME_CONFIGURATOR_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/thread/worker.hpp>
+#include <openpose/wrapper/runtimeConfigurator.hpp>
+
+namespace op
+{
+    /**
+     * It applies the pending changes of its RuntimeConfigurator before each frame. It must run on the same thread
+     * than (and right before) WScaleAndSizeExtractor.
+     */
+    template<typename TDatums>
+    class WRuntimeConfigurator : public Worker<TDatums>
+    {
+    public:
+        explicit WRuntimeConfigurator(const std::shared_ptr<RuntimeConfigurator>& runtimeConfigurator);
+
+        virtual ~WRuntimeConfigurator();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        const std::shared_ptr<RuntimeConfigurator> spRuntimeConfigurator;
+
+        DELETE_COPY(WRuntimeConfigurator);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WRuntimeConfigurator<TDatums>::WRuntimeConfigurator(
+        const std::shared_ptr<RuntimeConfigurator>& runtimeConfigurator) :
+        spRuntimeConfigurator{runtimeConfigurator}
+    {
+    }
+
+    template<typename TDatums>
+    WRuntimeConfigurator<TDatums>::~WRuntimeConfigurator()
+    {
+    }
+
+    template<typename TDatums>
+    void WRuntimeConfigurator<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WRuntimeConfigurator<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Apply the changes queued by WrapperT::reconfigure()
+                spRuntimeConfigurator->applyPending();
+                // Debugging log
+                opLogIfDebug("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WRuntimeConfigurator);
+}
+
+#endif // OPENPOSE_WRAPPER_W_RUNTIME_CONFIGURATOR_HPP
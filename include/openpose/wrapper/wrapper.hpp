@@ -2,8 +2,12 @@
 #define OPENPOSE_WRAPPER_WRAPPER_HPP
 
 #include <openpose/core/common.hpp>
+#include <openpose/core/netWarmUp.hpp>
+#include <openpose/filestream/metricsHttpExporter.hpp>
 #include <openpose/thread/headers.hpp>
 #include <openpose/wrapper/enumClasses.hpp>
+#include <openpose/wrapper/runtimeConfigurator.hpp>
+#include <openpose/wrapper/wrapperBatchSubmitter.hpp>
 #include <openpose/wrapper/wrapperStructExtra.hpp>
 #include <openpose/wrapper/wrapperStructFace.hpp>
 #include <openpose/wrapper/wrapperStructGui.hpp>
@@ -11,6 +15,7 @@
 #include <openpose/wrapper/wrapperStructInput.hpp>
 #include <openpose/wrapper/wrapperStructOutput.hpp>
 #include <openpose/wrapper/wrapperStructPose.hpp>
+#include <openpose/wrapper/wrapperStructRuntime.hpp>
 
 namespace op
 {
@@ -28,11 +33,17 @@ namespace op
      *           workersInput, {}, true)
      *         - Asynchronous input + synchronous output: call the constructor
      *           WrapperT(ThreadManagerMode::Synchronous, nullptr, workersOutput, irrelevantBoolean, true)
+     *
+     * TQueue is the queue type used between the workers. It defaults to the mutex-based Queue. The lock-free
+     * RingBufferQueue (to reduce lock contention between many threads) can be selected at runtime with
+     * WrapperStructExtra::queueType (e.g., `--queue_type 1`), without changing the WrapperT type, or at compile time
+     * with TQueue (e.g., WrapperRingBufferQueue).
      */
     template<typename TDatum = BASE_DATUM,
              typename TDatums = std::vector<std::shared_ptr<TDatum>>,
              typename TDatumsSP = std::shared_ptr<TDatums>,
-             typename TWorker = std::shared_ptr<Worker<TDatumsSP>>>
+             typename TWorker = std::shared_ptr<Worker<TDatumsSP>>,
+             typename TQueue = Queue<TDatumsSP>>
     class WrapperT
     {
     public:
@@ -102,6 +113,16 @@ namespace op
          */
         void configure(const WrapperStructGui& wrapperStructGui);
 
+        /**
+         * It enables the network warm-up (see WrapperStructPose::warmUp) for the next exec() or start(), so each GPU
+         * runs the body network once on the network input sizes of the given input resolutions (plus the producer
+         * and WrapperStructPose::warmUpCacheFile ones, if any) before processing the first frame. Thus, start()
+         * only returns once all the GPU threads are warmed up, and the first frames do not suffer a latency spike.
+         * It must be called before exec() or start(), and each call adds its input resolutions to the previous ones.
+         * @param inputSizes Input image resolutions (e.g., the ones that will be pushed with waitAndEmplace()).
+         */
+        void warmUp(const std::vector<Point<int>>& inputSizes = {});
+
         /**
          * Function to start multi-threading.
          * Similar to start(), but exec() blocks the thread that calls the function (it saves 1 thread). Use exec()
@@ -133,6 +154,15 @@ namespace op
          */
         bool isRunning() const;
 
+        /**
+         * It changes the configuration of the running WrapperT without stopping it nor reloading its networks (see
+         * WrapperStructRuntime for the elements that can be changed and RuntimeConfigurator for how they are
+         * applied). It can be called from any thread while it is running (e.g., after start()).
+         * @param wrapperStructRuntime Elements to be changed (the default ones are kept). If any of them cannot be
+         * applied, it throws and nothing is changed.
+         */
+        void reconfigure(const WrapperStructRuntime& wrapperStructRuntime);
+
         /**
          * It sets the maximum number of elements in the queue.
          * For maximum speed, set to a very large number, but the trade-off would be:
@@ -226,9 +256,42 @@ namespace op
          */
         TDatumsSP emplaceAndPop(const Matrix& matrix);
 
+        /**
+         * Asynchronous batch submission: it queues M independent frames and returns immediately. OpenPose is fed
+         * internally as soon as its input queue has room, so its queues (and the network batches of
+         * WrapperStructPose::batchSize) are kept full without any user thread pool.
+         * Only valid if ThreadManagerMode::Asynchronous, and the WrapperT must be running (start()). Do not mix it
+         * with tryPop()/waitAndPop()/emplaceAndPop() while there are frames in flight: the processed frames are
+         * popped internally and only returned by the futures.
+         * @param tDatumsBatch Independent frames (each one a TDatumsSP, as for waitAndEmplace()).
+         * @param callback Optional function called (on an internal thread) with each processed frame, before its
+         * future becomes ready.
+         * @return 1 future per frame, with the processed frame, or an exception if the WrapperT was stopped first.
+         */
+        std::vector<std::future<TDatumsSP>> emplaceBatch(
+            const std::vector<TDatumsSP>& tDatumsBatch,
+            const std::function<void(const TDatumsSP&)>& callback = nullptr);
+
+        /**
+         * Similar to emplaceBatch(const std::vector<TDatumsSP>& tDatumsBatch), but it takes Matrix's as input.
+         * @param matrices Matrix's with the images to be processed.
+         */
+        std::vector<std::future<TDatumsSP>> emplaceBatch(
+            const std::vector<Matrix>& matrices, const std::function<void(const TDatumsSP&)>& callback = nullptr);
+
+        /**
+         * Synchronous version of emplaceBatch(): it processes all the frames and waits for all of them.
+         * @param tDatumsBatch Independent frames, replaced by the processed ones.
+         * @return Boolean specifying whether all the frames could be processed.
+         */
+        bool emplaceAndPopBatch(std::vector<TDatumsSP>& tDatumsBatch);
+
     private:
         const ThreadManagerMode mThreadManagerMode;
-        ThreadManager<TDatumsSP> mThreadManager;
+        ThreadManager<TDatumsSP, TWorker, TQueue> mThreadManager;
+        // Used instead of mThreadManager if WrapperStructExtra::queueType is QueueType::RingBuffer (see exec/start)
+        ThreadManager<TDatumsSP, TWorker, RingBufferQueue<TDatumsSP>> mThreadManagerRingBuffer;
+        bool mRingBufferQueue;
         bool mMultiThreadEnabled;
         // Configuration
         WrapperStructPose mWrapperStructPose;
@@ -238,15 +301,50 @@ namespace op
         WrapperStructInput mWrapperStructInput;
         WrapperStructOutput mWrapperStructOutput;
         WrapperStructGui mWrapperStructGui;
+        // Network warm-up (see warmUp())
+        bool mWarmUp;
+        std::vector<Point<int>> mWarmUpInputSizes;
         // User configurable workers
         std::array<bool, int(WorkerType::Size)> mUserWsOnNewThread;
         std::array<std::vector<TWorker>, int(WorkerType::Size)> mUserWs;
+        // Metrics exporter
+        std::unique_ptr<MetricsHttpExporter> upMetricsHttpExporter;
+        // Batch submission (created by the first emplaceBatch() call of each start())
+        std::mutex mBatchSubmitterMutex;
+        std::unique_ptr<WrapperBatchSubmitter<TDatumsSP>> upWrapperBatchSubmitter;
+        // Runtime reconfiguration (see reconfigure())
+        const std::shared_ptr<RuntimeConfigurator> spRuntimeConfigurator;
+
+        /**
+         * It enables the Metrics and starts the MetricsHttpExporter if WrapperStructOutput::metricsPort is set, it
+         * enables the AllocationTracker (and the Metrics) if WrapperStructOutput::allocationMetrics is set, and it
+         * enables the Tracer if WrapperStructOutput::traceFile is set.
+         */
+        void configureInstrumentation();
+
+        /**
+         * It saves the Tracer events into WrapperStructOutput::traceFile (if set) and disables the Tracer, so the
+         * trace is only saved once.
+         */
+        void saveTrace();
+
+        /**
+         * It joins the batch submission threads of the previous start() (if any), already released by stop().
+         */
+        void resetBatchSubmitter();
+
+        /**
+         * It returns the NetWarmUp of the next exec() or start(), or nullptr if the warm-up is disabled.
+         */
+        std::shared_ptr<NetWarmUp> createNetWarmUp() const;
 
         DELETE_COPY(WrapperT);
     };
 
     // Type
     typedef WrapperT<BASE_DATUM> Wrapper;
+    typedef WrapperT<BASE_DATUM, BASE_DATUMS, BASE_DATUMS_SH, std::shared_ptr<Worker<BASE_DATUMS_SH>>,
+                     RingBufferQueue<BASE_DATUMS_SH>> WrapperRingBufferQueue;
 }
 
 
@@ -257,22 +355,30 @@ namespace op
 #include <openpose/wrapper/wrapperAuxiliary.hpp>
 namespace op
 {
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::WrapperT(const ThreadManagerMode threadManagerMode) :
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::WrapperT(const ThreadManagerMode threadManagerMode) :
         mThreadManagerMode{threadManagerMode},
         mThreadManager{threadManagerMode},
-        mMultiThreadEnabled{true}
+        mThreadManagerRingBuffer{threadManagerMode},
+        mRingBufferQueue{false},
+        mMultiThreadEnabled{true},
+        mWarmUp{false},
+        spRuntimeConfigurator{std::make_shared<RuntimeConfigurator>()}
     {
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::~WrapperT()
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::~WrapperT()
     {
         try
         {
             stop();
+            // Join the batch submission threads (released by stop())
+            upWrapperBatchSubmitter.reset();
             // Reset mThreadManager
             mThreadManager.reset();
+            mThreadManagerRingBuffer.reset();
+            spRuntimeConfigurator->clear();
             // Reset user workers
             for (auto& userW : mUserWs)
                 userW.clear();
@@ -283,8 +389,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::disableMultiThreading()
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::disableMultiThreading()
     {
         try
         {
@@ -296,8 +402,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::setWorker(
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::setWorker(
         const WorkerType workerType, const TWorker& worker, const bool workerOnNewThread)
     {
         try
@@ -316,8 +422,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::configure(const WrapperStructPose& wrapperStructPose)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::configure(const WrapperStructPose& wrapperStructPose)
     {
         try
         {
@@ -329,8 +435,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::configure(const WrapperStructFace& wrapperStructFace)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::configure(const WrapperStructFace& wrapperStructFace)
     {
         try
         {
@@ -342,8 +448,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::configure(const WrapperStructHand& wrapperStructHand)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::configure(const WrapperStructHand& wrapperStructHand)
     {
         try
         {
@@ -355,8 +461,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::configure(const WrapperStructExtra& wrapperStructExtra)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::configure(const WrapperStructExtra& wrapperStructExtra)
     {
         try
         {
@@ -368,8 +474,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::configure(const WrapperStructInput& wrapperStructInput)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::configure(const WrapperStructInput& wrapperStructInput)
     {
         try
         {
@@ -381,8 +487,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::configure(const WrapperStructOutput& wrapperStructOutput)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::configure(const WrapperStructOutput& wrapperStructOutput)
     {
         try
         {
@@ -394,8 +500,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::configure(const WrapperStructGui& wrapperStructGui)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::configure(const WrapperStructGui& wrapperStructGui)
     {
         try
         {
@@ -407,17 +513,47 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::exec()
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::warmUp(const std::vector<Point<int>>& inputSizes)
+    {
+        try
+        {
+            if (isRunning())
+                error("warmUp() must be called before exec() or start().", __LINE__, __FUNCTION__, __FILE__);
+            mWarmUp = true;
+            mWarmUpInputSizes.insert(mWarmUpInputSizes.end(), inputSizes.begin(), inputSizes.end());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::exec()
     {
         try
         {
-            configureThreadManager<TDatum, TDatums, TDatumsSP, TWorker>(
-                mThreadManager, mMultiThreadEnabled, mThreadManagerMode, mWrapperStructPose, mWrapperStructFace,
-                mWrapperStructHand, mWrapperStructExtra, mWrapperStructInput, mWrapperStructOutput, mWrapperStructGui,
-                mUserWs, mUserWsOnNewThread);
+            mRingBufferQueue = (mWrapperStructExtra.queueType == QueueType::RingBuffer);
+            if (mRingBufferQueue)
+                configureThreadManager<TDatum, TDatums, TDatumsSP, TWorker>(
+                    mThreadManagerRingBuffer, mMultiThreadEnabled, mThreadManagerMode, mWrapperStructPose,
+                    mWrapperStructFace, mWrapperStructHand, mWrapperStructExtra, mWrapperStructInput,
+                    mWrapperStructOutput, mWrapperStructGui, mUserWs, mUserWsOnNewThread, createNetWarmUp(),
+                    spRuntimeConfigurator);
+            else
+                configureThreadManager<TDatum, TDatums, TDatumsSP, TWorker, TQueue>(
+                    mThreadManager, mMultiThreadEnabled, mThreadManagerMode, mWrapperStructPose, mWrapperStructFace,
+                    mWrapperStructHand, mWrapperStructExtra, mWrapperStructInput, mWrapperStructOutput,
+                    mWrapperStructGui, mUserWs, mUserWsOnNewThread, createNetWarmUp(), spRuntimeConfigurator);
+            configureInstrumentation();
+            resetBatchSubmitter();
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
-            mThreadManager.exec();
+            if (mRingBufferQueue)
+                mThreadManagerRingBuffer.exec();
+            else
+                mThreadManager.exec();
+            saveTrace();
         }
         catch (const std::exception& e)
         {
@@ -425,17 +561,35 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::start()
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::start()
     {
         try
         {
-            configureThreadManager<TDatum, TDatums, TDatumsSP, TWorker>(
-                mThreadManager, mMultiThreadEnabled, mThreadManagerMode, mWrapperStructPose, mWrapperStructFace,
-                mWrapperStructHand, mWrapperStructExtra, mWrapperStructInput, mWrapperStructOutput, mWrapperStructGui,
-                mUserWs, mUserWsOnNewThread);
+            const auto netWarmUp = createNetWarmUp();
+            mRingBufferQueue = (mWrapperStructExtra.queueType == QueueType::RingBuffer);
+            if (mRingBufferQueue)
+                configureThreadManager<TDatum, TDatums, TDatumsSP, TWorker>(
+                    mThreadManagerRingBuffer, mMultiThreadEnabled, mThreadManagerMode, mWrapperStructPose,
+                    mWrapperStructFace, mWrapperStructHand, mWrapperStructExtra, mWrapperStructInput,
+                    mWrapperStructOutput, mWrapperStructGui, mUserWs, mUserWsOnNewThread, netWarmUp,
+                    spRuntimeConfigurator);
+            else
+                configureThreadManager<TDatum, TDatums, TDatumsSP, TWorker>(
+                    mThreadManager, mMultiThreadEnabled, mThreadManagerMode, mWrapperStructPose, mWrapperStructFace,
+                    mWrapperStructHand, mWrapperStructExtra, mWrapperStructInput, mWrapperStructOutput,
+                    mWrapperStructGui, mUserWs, mUserWsOnNewThread, netWarmUp, spRuntimeConfigurator);
+            configureInstrumentation();
+            resetBatchSubmitter();
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
-            mThreadManager.start();
+            if (mRingBufferQueue)
+                mThreadManagerRingBuffer.start();
+            else
+                mThreadManager.start();
+            // Wait for the warm-up of all the GPU threads (unless any of them stops the WrapperT)
+            if (netWarmUp != nullptr)
+                while (!netWarmUp->waitUntilWarmedUp(std::chrono::milliseconds{100}) && isRunning())
+                    ;
         }
         catch (const std::exception& e)
         {
@@ -443,12 +597,16 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::stop()
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::stop()
     {
         try
         {
-            mThreadManager.stop();
+            if (mRingBufferQueue)
+                mThreadManagerRingBuffer.stop();
+            else
+                mThreadManager.stop();
+            saveTrace();
         }
         catch (const std::exception& e)
         {
@@ -456,12 +614,12 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::isRunning() const
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::isRunning() const
     {
         try
         {
-            return mThreadManager.isRunning();
+            return (mRingBufferQueue ? mThreadManagerRingBuffer.isRunning() : mThreadManager.isRunning());
         }
         catch (const std::exception& e)
         {
@@ -470,12 +628,30 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::setDefaultMaxSizeQueues(const long long defaultMaxSizeQueues)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::reconfigure(
+        const WrapperStructRuntime& wrapperStructRuntime)
+    {
+        try
+        {
+            if (!isRunning())
+                error("reconfigure() can only be called while the Wrapper is running (after start()). Use the"
+                      " configure() functions otherwise.", __LINE__, __FUNCTION__, __FILE__);
+            spRuntimeConfigurator->reconfigure(wrapperStructRuntime);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::setDefaultMaxSizeQueues(const long long defaultMaxSizeQueues)
     {
         try
         {
             mThreadManager.setDefaultMaxSizeQueues(defaultMaxSizeQueues);
+            mThreadManagerRingBuffer.setDefaultMaxSizeQueues(defaultMaxSizeQueues);
         }
         catch (const std::exception& e)
         {
@@ -483,8 +659,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::tryEmplace(TDatumsSP& tDatums)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::tryEmplace(TDatumsSP& tDatums)
     {
         try
         {
@@ -494,7 +670,8 @@ namespace op
             // tryEmplace for 1 camera
             if (tDatums->size() < 2)
             {
-                return mThreadManager.tryEmplace(tDatums);
+                return (mRingBufferQueue
+                    ? mThreadManagerRingBuffer.tryEmplace(tDatums) : mThreadManager.tryEmplace(tDatums));
             }
             // tryEmplace for multiview
             else
@@ -519,8 +696,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::waitAndEmplace(TDatumsSP& tDatums)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::waitAndEmplace(TDatumsSP& tDatums)
     {
         try
         {
@@ -530,7 +707,8 @@ namespace op
             // waitAndEmplace for 1 camera
             if (tDatums->size() < 2)
             {
-                return mThreadManager.waitAndEmplace(tDatums);
+                return (mRingBufferQueue
+                    ? mThreadManagerRingBuffer.waitAndEmplace(tDatums) : mThreadManager.waitAndEmplace(tDatums));
             }
             // waitAndEmplace for multiview
             else
@@ -557,8 +735,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::waitAndEmplace(Matrix& matrix)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::waitAndEmplace(Matrix& matrix)
     {
         try
         {
@@ -579,15 +757,16 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::tryPush(const TDatumsSP& tDatums)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::tryPush(const TDatumsSP& tDatums)
     {
         try
         {
             if (!mUserWs[int(WorkerType::Input)].empty())
                 error("Push cannot be called if an input worker was already selected.",
                       __LINE__, __FUNCTION__, __FILE__);
-            return mThreadManager.tryPush(tDatums);
+            return (mRingBufferQueue
+                ? mThreadManagerRingBuffer.tryPush(tDatums) : mThreadManager.tryPush(tDatums));
         }
         catch (const std::exception& e)
         {
@@ -596,15 +775,16 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::waitAndPush(const TDatumsSP& tDatums)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::waitAndPush(const TDatumsSP& tDatums)
     {
         try
         {
             if (!mUserWs[int(WorkerType::Input)].empty())
                 error("Push cannot be called if an input worker was already selected.",
                       __LINE__, __FUNCTION__, __FILE__);
-            return mThreadManager.waitAndPush(tDatums);
+            return (mRingBufferQueue
+                ? mThreadManagerRingBuffer.waitAndPush(tDatums) : mThreadManager.waitAndPush(tDatums));
         }
         catch (const std::exception& e)
         {
@@ -613,8 +793,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::waitAndPush(const Matrix& matrix)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::waitAndPush(const Matrix& matrix)
     {
         try
         {
@@ -635,15 +815,16 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::tryPop(TDatumsSP& tDatums)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::tryPop(TDatumsSP& tDatums)
     {
         try
         {
             if (!mUserWs[int(WorkerType::Output)].empty())
                 error("Pop cannot be called if an output worker was already selected.",
                       __LINE__, __FUNCTION__, __FILE__);
-            return mThreadManager.tryPop(tDatums);
+            return (mRingBufferQueue
+                ? mThreadManagerRingBuffer.tryPop(tDatums) : mThreadManager.tryPop(tDatums));
         }
         catch (const std::exception& e)
         {
@@ -652,15 +833,16 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::waitAndPop(TDatumsSP& tDatums)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::waitAndPop(TDatumsSP& tDatums)
     {
         try
         {
             if (!mUserWs[int(WorkerType::Output)].empty())
                 error("Pop cannot be called if an output worker was already selected.",
                       __LINE__, __FUNCTION__, __FILE__);
-            return mThreadManager.waitAndPop(tDatums);
+            return (mRingBufferQueue
+                ? mThreadManagerRingBuffer.waitAndPop(tDatums) : mThreadManager.waitAndPop(tDatums));
         }
         catch (const std::exception& e)
         {
@@ -669,8 +851,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::emplaceAndPop(TDatumsSP& tDatums)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::emplaceAndPop(TDatumsSP& tDatums)
     {
         try
         {
@@ -686,8 +868,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    TDatumsSP WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::emplaceAndPop(const Matrix& matrix)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    TDatumsSP WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::emplaceAndPop(const Matrix& matrix)
     {
         try
         {
@@ -710,7 +892,162 @@ namespace op
         }
     }
 
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    std::vector<std::future<TDatumsSP>> WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::emplaceBatch(
+        const std::vector<TDatumsSP>& tDatumsBatch, const std::function<void(const TDatumsSP&)>& callback)
+    {
+        try
+        {
+            if (mThreadManagerMode != ThreadManagerMode::Asynchronous)
+                error("emplaceBatch() is only valid if ThreadManagerMode::Asynchronous.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (!isRunning())
+                error("emplaceBatch() requires a running WrapperT (call start() first).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            const std::lock_guard<std::mutex> lock{mBatchSubmitterMutex};
+            if (upWrapperBatchSubmitter == nullptr)
+                upWrapperBatchSubmitter.reset(new WrapperBatchSubmitter<TDatumsSP>{
+                    [this](TDatumsSP& tDatums) { return waitAndEmplace(tDatums); },
+                    [this](TDatumsSP& tDatums) { return waitAndPop(tDatums); }});
+            return upWrapperBatchSubmitter->submit(tDatumsBatch, callback);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    std::vector<std::future<TDatumsSP>> WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::emplaceBatch(
+        const std::vector<Matrix>& matrices, const std::function<void(const TDatumsSP&)>& callback)
+    {
+        try
+        {
+            std::vector<TDatumsSP> tDatumsBatch(matrices.size());
+            for (auto i = 0u ; i < matrices.size() ; i++)
+            {
+                tDatumsBatch[i] = std::make_shared<TDatums>();
+                tDatumsBatch[i]->emplace_back(std::make_shared<TDatum>());
+                tDatumsBatch[i]->at(0)->cvInputData = matrices[i];
+            }
+            return emplaceBatch(tDatumsBatch, callback);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::emplaceAndPopBatch(
+        std::vector<TDatumsSP>& tDatumsBatch)
+    {
+        try
+        {
+            auto futures = emplaceBatch(tDatumsBatch);
+            auto successfulBatch = true;
+            for (auto i = 0u ; i < futures.size() ; i++)
+            {
+                try
+                {
+                    tDatumsBatch[i] = futures[i].get();
+                }
+                catch (const std::runtime_error&)
+                {
+                    // The WrapperT was stopped before processing it
+                    successfulBatch = false;
+                }
+            }
+            return successfulBatch;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::resetBatchSubmitter()
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mBatchSubmitterMutex};
+            upWrapperBatchSubmitter.reset();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    std::shared_ptr<NetWarmUp> WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::createNetWarmUp() const
+    {
+        try
+        {
+            if (!mWarmUp && !mWrapperStructPose.warmUp && mWrapperStructPose.warmUpCacheFile.empty())
+                return nullptr;
+            return std::make_shared<NetWarmUp>(mWarmUpInputSizes, mWrapperStructPose.warmUpCacheFile.getStdString());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::configureInstrumentation()
+    {
+        try
+        {
+            if (mWrapperStructOutput.metricsPort >= 0)
+            {
+                Metrics::setEnabled(true);
+                if (upMetricsHttpExporter == nullptr)
+                    upMetricsHttpExporter.reset(new MetricsHttpExporter{mWrapperStructOutput.metricsPort});
+                upMetricsHttpExporter->start();
+            }
+            if (mWrapperStructOutput.allocationMetrics)
+            {
+                Metrics::setEnabled(true);
+                AllocationTracker::setEnabled(true);
+            }
+            if (!mWrapperStructOutput.traceFile.empty())
+                Tracer::setEnabled(true);
+            if (mWrapperStructOutput.datumTiming)
+                DatumTiming::setEnabled(true);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::saveTrace()
+    {
+        try
+        {
+            if (!mWrapperStructOutput.traceFile.empty() && Tracer::isEnabled())
+            {
+                Tracer::setEnabled(false);
+                Tracer::saveChromeTrace(mWrapperStructOutput.traceFile.getStdString());
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     extern template class WrapperT<BASE_DATUM>;
+    extern template class WrapperT<
+        BASE_DATUM, BASE_DATUMS, BASE_DATUMS_SH, std::shared_ptr<Worker<BASE_DATUMS_SH>>,
+        RingBufferQueue<BASE_DATUMS_SH>>;
 }
 
 #endif // OPENPOSE_WRAPPER_WRAPPER_HPP
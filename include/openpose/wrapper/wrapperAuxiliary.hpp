@@ -1,8 +1,10 @@
 #ifndef OPENPOSE_WRAPPER_WRAPPER_AUXILIARY_HPP
 #define OPENPOSE_WRAPPER_WRAPPER_AUXILIARY_HPP
 
+#include <openpose/core/netWarmUp.hpp>
 #include <openpose/thread/headers.hpp>
 #include <openpose/wrapper/enumClasses.hpp>
+#include <openpose/wrapper/runtimeConfigurator.hpp>
 #include <openpose/wrapper/wrapperStructExtra.hpp>
 #include <openpose/wrapper/wrapperStructFace.hpp>
 #include <openpose/wrapper/wrapperStructGui.hpp>
@@ -34,6 +36,17 @@ namespace op
         const bool userOutputWsEmpty, const std::shared_ptr<Producer>& producerSharedPtr,
         const ThreadManagerMode threadManagerMode);
 
+    /**
+     * Field manifest of the pipeline, i.e., the optional Datum fields that the given configuration might fill (see
+     * DatumField). DatumProducer stamps it into each Datum::fields, so workers, clone() and the Python/Unity
+     * bindings can skip the fields of the disabled options (e.g., heat maps, face, hand or 3-D ones for a body-only
+     * deployment).
+     */
+    OP_API DatumField getDatumFields(
+        const WrapperStructPose& wrapperStructPose, const WrapperStructFace& wrapperStructFace,
+        const WrapperStructHand& wrapperStructHand, const WrapperStructExtra& wrapperStructExtra,
+        const WrapperStructInput& wrapperStructInput);
+
     /**
      * Thread ID increase (private internal function).
      * If multi-threading mode, it increases the thread ID.
@@ -53,15 +66,18 @@ namespace op
     template<typename TDatum,
              typename TDatums = std::vector<std::shared_ptr<TDatum>>,
              typename TDatumsSP = std::shared_ptr<TDatums>,
-             typename TWorker = std::shared_ptr<Worker<TDatumsSP>>>
+             typename TWorker = std::shared_ptr<Worker<TDatumsSP>>,
+             typename TQueue = Queue<TDatumsSP>>
     void configureThreadManager(
-        ThreadManager<TDatumsSP>& threadManager, const bool multiThreadEnabled,
+        ThreadManager<TDatumsSP, TWorker, TQueue>& threadManager, const bool multiThreadEnabled,
         const ThreadManagerMode threadManagerMode, const WrapperStructPose& wrapperStructPose,
         const WrapperStructFace& wrapperStructFace, const WrapperStructHand& wrapperStructHand,
         const WrapperStructExtra& wrapperStructExtra, const WrapperStructInput& wrapperStructInput,
         const WrapperStructOutput& wrapperStructOutput, const WrapperStructGui& wrapperStructGui,
         const std::array<std::vector<TWorker>, int(WorkerType::Size)>& userWs,
-        const std::array<bool, int(WorkerType::Size)>& userWsOnNewThread);
+        const std::array<bool, int(WorkerType::Size)>& userWsOnNewThread,
+        const std::shared_ptr<NetWarmUp>& netWarmUp = nullptr,
+        const std::shared_ptr<RuntimeConfigurator>& runtimeConfigurator = nullptr);
 
     /**
      * It fills camera parameters and splits the cvMat depending on how many camera parameter matrices are found.
@@ -80,40 +96,41 @@ namespace op
 
 
 // Implementation
+#include <cmath> // std::round
 #include <openpose/3d/headers.hpp>
 #include <openpose/core/headers.hpp>
 #include <openpose/face/headers.hpp>
 #include <openpose/filestream/headers.hpp>
+#include <openpose/gpu/cudaAutotune.hpp>
 #include <openpose/gpu/gpu.hpp>
+#include <openpose/gpu/gpuMemoryBudget.hpp>
 #include <openpose/gui/headers.hpp>
 #include <openpose/hand/headers.hpp>
 #include <openpose/pose/headers.hpp>
 #include <openpose/producer/headers.hpp>
 #include <openpose/tracking/headers.hpp>
 #include <openpose/utilities/fileSystem.hpp>
+#include <openpose/utilities/flagsToOpenPose.hpp>
 #include <openpose/utilities/standard.hpp>
+#include <openpose/wrapper/wRuntimeConfigurator.hpp>
 namespace op
 {
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
     void configureThreadManager(
-        ThreadManager<TDatumsSP>& threadManager, const bool multiThreadEnabledTemp,
+        ThreadManager<TDatumsSP, TWorker, TQueue>& threadManager, const bool multiThreadEnabledTemp,
         const ThreadManagerMode threadManagerMode, const WrapperStructPose& wrapperStructPoseTemp,
         const WrapperStructFace& wrapperStructFace, const WrapperStructHand& wrapperStructHand,
         const WrapperStructExtra& wrapperStructExtra, const WrapperStructInput& wrapperStructInput,
         const WrapperStructOutput& wrapperStructOutput, const WrapperStructGui& wrapperStructGui,
         const std::array<std::vector<TWorker>, int(WorkerType::Size)>& userWs,
-        const std::array<bool, int(WorkerType::Size)>& userWsOnNewThread)
+        const std::array<bool, int(WorkerType::Size)>& userWsOnNewThread,
+        const std::shared_ptr<NetWarmUp>& netWarmUp,
+        const std::shared_ptr<RuntimeConfigurator>& runtimeConfigurator)
     {
         try
         {
             opLog("Running configureThreadManager...", Priority::Normal);
 
-            // Create producer
-            auto producerSharedPtr = createProducer(
-                wrapperStructInput.producerType, wrapperStructInput.producerString.getStdString(),
-                wrapperStructInput.cameraResolution, wrapperStructInput.cameraParameterPath.getStdString(),
-                wrapperStructInput.undistortImage, wrapperStructInput.numberViews);
-
             // Editable arguments
             auto wrapperStructPose = wrapperStructPoseTemp;
             auto multiThreadEnabled = multiThreadEnabledTemp;
@@ -136,18 +153,25 @@ namespace op
 
             // Required parameters
             const auto gpuMode = getGpuMode();
-            const auto renderModePose = (
-                wrapperStructPose.renderMode != RenderMode::Auto
-                    ? wrapperStructPose.renderMode
-                    : (gpuMode == GpuMode::Cuda ? RenderMode::Gpu : RenderMode::Cpu));
-            const auto renderModeFace = (
-                wrapperStructFace.renderMode != RenderMode::Auto
-                    ? wrapperStructFace.renderMode
-                    : (gpuMode == GpuMode::Cuda ? RenderMode::Gpu : RenderMode::Cpu));
-            const auto renderModeHand = (
-                wrapperStructHand.renderMode != RenderMode::Auto
-                    ? wrapperStructHand.renderMode
-                    : (gpuMode == GpuMode::Cuda ? RenderMode::Gpu : RenderMode::Cpu));
+            // Face and hand on their own GPU thread (pipeline-parallel): Everything is rendered on CPU, since the GPU
+            // renderers share the render target of their body GPU thread
+            const auto faceHandPipelined = wrapperStructExtra.faceHandGpu >= 0 && gpuMode == GpuMode::Cuda
+                && multiThreadEnabled && (wrapperStructFace.enable || wrapperStructHand.enable);
+            // CPU spillover workers next to the GPU ones (see GpuDispatcher)
+            const auto spilloverWorkers = (
+                gpuMode == GpuMode::Cuda && multiThreadEnabled && wrapperStructPose.poseMode != PoseMode::Disabled
+                    ? fastMax(0, wrapperStructExtra.spilloverWorkers) : 0);
+            const auto getRenderMode = [&](const RenderMode renderMode)
+            {
+                const auto renderModeFinal = (
+                    renderMode != RenderMode::Auto
+                        ? renderMode
+                        : (gpuMode == GpuMode::Cuda ? RenderMode::Gpu : RenderMode::Cpu));
+                return (faceHandPipelined && renderModeFinal == RenderMode::Gpu ? RenderMode::Cpu : renderModeFinal);
+            };
+            const auto renderModePose = getRenderMode(wrapperStructPose.renderMode);
+            const auto renderModeFace = getRenderMode(wrapperStructFace.renderMode);
+            const auto renderModeHand = getRenderMode(wrapperStructHand.renderMode);
             const auto renderOutput = renderModePose != RenderMode::None
                                         || renderModeFace != RenderMode::None
                                         || renderModeHand != RenderMode::None;
@@ -157,6 +181,9 @@ namespace op
             const bool renderFace = wrapperStructFace.enable && renderModeFace != RenderMode::None;
             const bool renderHand = wrapperStructHand.enable && renderModeHand != RenderMode::None;
             const bool renderHandGpu = wrapperStructHand.enable && renderModeHand == RenderMode::Gpu;
+            if (wrapperStructOutput.keepRenderTargetGpu && !renderOutputGpu)
+                opLog("Warning: The GPU render target (WrapperStructOutput::keepRenderTargetGpu) is only filled by the"
+                      " GPU rendering, so Datum::outputDataGpu will be empty.", Priority::High);
             opLog("renderModePose = " + std::to_string(int(renderModePose)), Priority::Normal);
             opLog("renderModeFace = " + std::to_string(int(renderModeFace)), Priority::Normal);
             opLog("renderModeHand = " + std::to_string(int(renderModeHand)), Priority::Normal);
@@ -166,6 +193,73 @@ namespace op
             opLog("renderHand = " + std::to_string(int(renderHand)), Priority::Normal);
             opLog("renderHandGpu = " + std::to_string(int(renderHandGpu)), Priority::Normal);
 
+            // Create producer
+            // NVDEC and FLIR GPU debayering: Frames are only downloaded into CPU memory if something needs the input
+            // image. The producer downloads them if a worker before the pose estimation (or the producer itself)
+            // needs them, or if they are undistorted (see FrameGpu::download()). Otherwise, they are downloaded
+            // after the pose estimation (see WInputDataGpuDownload)
+            const auto nvDecodeDownloadInProducer = renderOutput || wrapperStructPose.poseMode != PoseMode::Enabled
+                || !userPreProcessingWs.empty() || !wrapperStructInput.inputRecordPath.empty();
+            const auto nvDecodeDownload = nvDecodeDownloadInProducer
+                || wrapperStructFace.enable || wrapperStructHand.enable || wrapperStructExtra.reconstruct3d
+                || wrapperStructExtra.identification
+                || (wrapperStructExtra.tracking > -1 && !wrapperStructExtra.trackingExtrapolation)
+                || wrapperStructGui.displayMode != DisplayMode::NoDisplay
+                || !wrapperStructOutput.writeImages.empty() || !wrapperStructOutput.writeVideo.empty()
+                || !wrapperStructOutput.writeVideo3D.empty() || !wrapperStructOutput.writeVideoAdam.empty()
+                || !wrapperStructOutput.streamVideo.empty()
+                || !userPostProcessingWs.empty() || !userOutputWs.empty()
+                || (wrapperStructExtra.personCropSize.x > 0 && wrapperStructExtra.personCropSize.y > 0);
+            const auto nvDecodeDownloadLate = nvDecodeDownload && !nvDecodeDownloadInProducer
+                && !wrapperStructInput.undistortImage
+                && (wrapperStructInput.nvDecode || wrapperStructInput.flirBayerGpu);
+            if (wrapperStructInput.nvDecode || wrapperStructInput.flirBayerGpu)
+            {
+                opLog("nvDecodeDownload = " + std::to_string(int(nvDecodeDownload)), Priority::Normal);
+                opLog("nvDecodeDownloadLate = " + std::to_string(int(nvDecodeDownloadLate)), Priority::Normal);
+            }
+            // SharedMemoryReader: The frames wrapping its shared memory are only deep copied (before WCvMatToOpInput
+            // gives them back to the writer process) if any later worker requires them
+            const auto keepInputData = nvDecodeDownload || wrapperStructPose.motionGateRatio > 0.
+                || (wrapperStructPose.scaleAdaptiveHeight > 0.f && wrapperStructPose.scalesNumber > 1);
+            // Frame sets received from another process (see WDatumReceiver) replace the producer
+            auto producerSharedPtr = (!wrapperStructInput.datumReceive.empty() ? nullptr : createProducer(
+                wrapperStructInput.producerType, wrapperStructInput.producerString.getStdString(),
+                wrapperStructInput.cameraResolution, wrapperStructInput.cameraParameterPath.getStdString(),
+                wrapperStructInput.undistortImage, wrapperStructInput.numberViews,
+                (wrapperStructInput.nvDecode ? wrapperStructPose.gpuNumberStart : -1),
+                nvDecodeDownload && !nvDecodeDownloadLate,
+                wrapperStructInput.imageDecodingThreads,
+                (wrapperStructInput.flirBayerGpu ? wrapperStructPose.gpuNumberStart : -1),
+                wrapperStructInput.flirSyncToleranceMs, wrapperStructInput.undistortKeypoints,
+                wrapperStructInput.videoDecoders, wrapperStructInput.videoSegmentFrames,
+                wrapperStructInput.imageDirectoryStream, wrapperStructInput.cameraV4l2,
+                wrapperStructInput.cameraV4l2Fps));
+            // Static regions of interest (otherwise, the ones of the camera parameter files, if any)
+            if (producerSharedPtr != nullptr && !wrapperStructInput.inputRoi.empty())
+                producerSharedPtr->setInputRois(flagsToInputRois(wrapperStructInput.inputRoi));
+            // Source scheduling (priority classes and maximum latencies)
+            if (!wrapperStructInput.sourcePriority.empty() || !wrapperStructInput.sourceMaxLatencyMs.empty())
+            {
+                const auto multiSourceProducer = std::dynamic_pointer_cast<MultiSourceProducer>(producerSharedPtr);
+                if (multiSourceProducer == nullptr)
+                    error("The source priorities and maximum latencies (`--source_priority`,"
+                          " `--source_max_latency_ms`) require several multiplexed sources (e.g., comma-separated"
+                          " `--ip_camera` or `--video`).", __LINE__, __FUNCTION__, __FILE__);
+                std::vector<int> priorities;
+                for (const auto priority : flagsToDoubles(wrapperStructInput.sourcePriority))
+                    priorities.emplace_back((int)std::round(priority));
+                multiSourceProducer->setSourceSchedule(
+                    priorities, flagsToDoubles(wrapperStructInput.sourceMaxLatencyMs));
+            }
+            // Batched network: 1 frame of each multiplexed source per group (unless they have priority classes)
+            if (wrapperStructPose.batchSize > 1 && wrapperStructInput.sourcePriority.empty())
+            {
+                const auto multiSourceProducer = std::dynamic_pointer_cast<MultiSourceProducer>(producerSharedPtr);
+                if (multiSourceProducer != nullptr)
+                    multiSourceProducer->setSourceBatching(true);
+            }
+
             // Check no wrong/contradictory flags enabled
             const bool userInputAndPreprocessingWsEmpty = userInputWs.empty() && userPreProcessingWs.empty();
             const bool userOutputWsEmpty = userOutputWs.empty();
@@ -182,15 +276,30 @@ namespace op
             auto gpuNumberStart = wrapperStructPose.gpuNumberStart;
             opLog("numberGpuThreads = " + std::to_string(numberGpuThreads), Priority::Normal);
             opLog("gpuNumberStart = " + std::to_string(gpuNumberStart), Priority::Normal);
-            // CPU --> 1 thread or no pose extraction
+            // CPU --> 1 thread (by default), N CPU workers (if gpuNumber > 1), or no pose extraction
+            auto cpuWorkerThreads = 0;
             if (gpuMode == GpuMode::NoGpu)
             {
-                numberGpuThreads = (wrapperStructPose.gpuNumber == 0 ? 0 : 1);
+                numberGpuThreads = (wrapperStructPose.gpuNumber < 0 ? 1 : wrapperStructPose.gpuNumber);
                 gpuNumberStart = 0;
-                // Disabling multi-thread makes the code 400 ms faster (2.3 sec vs. 2.7 in i7-6850K)
+                // Single worker: Disabling multi-thread makes the code 400 ms faster (2.3 sec vs. 2.7 in i7-6850K)
                 // and fixes the bug that the screen was not properly displayed and only refreshed sometimes
                 // Note: The screen bug could be also fixed by using waitKey(30) rather than waitKey(1)
-                multiThreadEnabled = false;
+                if (numberGpuThreads < 2)
+                    multiThreadEnabled = false;
+                // Several workers: Each one processes (network + post-processing) a different frame, so their
+                // compute threads are bounded to avoid oversubscribing the cores
+                else
+                {
+                    cpuWorkerThreads = wrapperStructExtra.cpuWorkerThreads;
+                    if (cpuWorkerThreads < 0)
+                        cpuWorkerThreads = fastMax(
+                            1, (int)std::thread::hardware_concurrency() / numberGpuThreads);
+                    opLog("Using " + std::to_string(numberGpuThreads) + " CPU pose workers"
+                        + (cpuWorkerThreads > 0
+                           ? " with " + std::to_string(cpuWorkerThreads) + " compute threads each." : "."),
+                        Priority::High);
+                }
             }
             // GPU --> user picks (<= #GPUs)
             else
@@ -218,6 +327,37 @@ namespace op
                           + std::to_string(numberGpuThreads) + " vs. "
                           + std::to_string(totalGpuNumber) + ").",
                           __LINE__, __FUNCTION__, __FILE__);
+                if (faceHandPipelined && wrapperStructExtra.faceHandGpu >= totalGpuNumber)
+                    error("The face and hand GPU (`--face_hand_gpu`) must be lower than the total number of GPUs in"
+                          " your machine (" + std::to_string(totalGpuNumber) + ").", __LINE__, __FUNCTION__, __FILE__);
+            }
+
+            // Auto-configuration: Hardware probing
+            if (wrapperStructExtra.autoConfigure > 0)
+            {
+                std::string hardware = "Auto-configuration hardware: "
+                    + std::to_string(std::thread::hardware_concurrency()) + " logical CPU cores";
+                auto numaNodes = 0;
+                for (auto cpuIds = getNumaNodeCpuIds(0) ; !cpuIds.empty() ; cpuIds = getNumaNodeCpuIds(++numaNodes))
+                    hardware += (numaNodes == 0 ? " (NUMA node " : ", node ") + std::to_string(numaNodes) + ": "
+                              + std::to_string(cpuIds.size()) + " cores";
+                hardware += (numaNodes > 0 ? ")." : ".");
+                if (gpuMode != GpuMode::NoGpu)
+                {
+                    hardware += " Using " + std::to_string(numberGpuThreads) + " of "
+                              + std::to_string(getGpuNumber()) + " GPU(s):";
+                    for (auto gpuId = gpuNumberStart ; gpuId < gpuNumberStart + numberGpuThreads ; gpuId++)
+                    {
+                        const auto gpuName = getGpuName(gpuId);
+                        const auto numaNode = getGpuNumaNode(gpuId);
+                        hardware += "\n    GPU " + std::to_string(gpuId) + ": "
+                                  + (gpuName.empty() ? "Unknown" : gpuName)
+                                  + (numaNode >= 0 ? " (NUMA node " + std::to_string(numaNode) + ")" : "") + ".";
+                    }
+                }
+                else
+                    hardware += " Using " + std::to_string(numberGpuThreads) + " CPU pose worker(s).";
+                opLog(hardware, Priority::High);
             }
 
             // Proper format
@@ -236,6 +376,7 @@ namespace op
             auto finalOutputSize = wrapperStructPose.outputSize;
             Point<int> producerSize{-1,-1};
             const auto oPProducer = (producerSharedPtr != nullptr);
+            const auto numberSources = (oPProducer ? producerSharedPtr->getNumberSources() : 1ull);
             if (oPProducer)
             {
                 // 1. Set producer properties
@@ -257,20 +398,58 @@ namespace op
 
             // Producer
             TWorker datumProducerW;
+            std::shared_ptr<FrameCredits> frameCredits;
             if (oPProducer)
             {
+                // Datum pool (only for Datum, custom TDatum members could not be reset)
+                std::shared_ptr<DatumPool<TDatum>> datumPool;
+                if (wrapperStructInput.datumPoolSize > 0)
+                {
+                    if (std::is_same<TDatum, BASE_DATUM>::value)
+                        datumPool = std::make_shared<DatumPool<TDatum>>(wrapperStructInput.datumPoolSize);
+                    else
+                        opLog("The Datum pool (`--datum_pool_size`) is disabled for custom TDatum classes.",
+                              Priority::High);
+                }
                 const auto datumProducer = std::make_shared<DatumProducer<TDatum>>(
                     producerSharedPtr, wrapperStructInput.frameFirst, wrapperStructInput.frameStep,
-                    wrapperStructInput.frameLast, spVideoSeek
+                    wrapperStructInput.frameLast, spVideoSeek, datumPool,
+                    getDatumFields(wrapperStructPose, wrapperStructFace, wrapperStructHand, wrapperStructExtra,
+                                   wrapperStructInput)
                 );
-                datumProducerW = std::make_shared<WDatumProducer<TDatum>>(datumProducer);
+                // Input recording
+                std::shared_ptr<InputRecorder> inputRecorder;
+                if (!wrapperStructInput.inputRecordPath.empty())
+                    inputRecorder = std::make_shared<InputRecorder>(
+                        wrapperStructInput.inputRecordPath.getStdString(),
+                        wrapperStructInput.inputRecordFormat.getStdString());
+                // Flow control (offline producers only): As many credits as frames in the GPU threads (at most, the
+                // GPU memory budget might reduce the batch size later on) plus the ones decoded ahead
+                const auto producerType = producerSharedPtr->getType();
+                if (wrapperStructInput.decodeAhead >= 0 && multiThreadEnabled
+                    && (producerType == ProducerType::Video || producerType == ProducerType::ImageDirectory
+                        || producerType == ProducerType::Replay))
+                {
+                    const auto numberCredits = (unsigned long long)(fastMax(1, numberGpuThreads)
+                        * fastMax(1, wrapperStructPose.batchSize) + wrapperStructInput.decodeAhead);
+                    frameCredits = std::make_shared<FrameCredits>(numberCredits);
+                    opLog("Flow control: The producer reads ahead up to " + std::to_string(numberCredits)
+                          + " frames.", Priority::High);
+                }
+                datumProducerW = std::make_shared<WDatumProducer<TDatum>>(datumProducer, inputRecorder, frameCredits);
             }
+            else if (!wrapperStructInput.datumReceive.empty())
+                datumProducerW = std::make_shared<WDatumReceiver<TDatum>>(
+                    std::make_shared<DatumReceiver>(
+                        wrapperStructInput.datumReceive.getStdString(),
+                        (unsigned int)fastMax(1, wrapperStructInput.datumReceiveWindow)));
             else
                 datumProducerW = nullptr;
 
             std::vector<std::shared_ptr<PoseExtractorNet>> poseExtractorNets;
             std::vector<std::shared_ptr<FaceExtractorNet>> faceExtractorNets;
             std::vector<std::shared_ptr<HandExtractorNet>> handExtractorNets;
+            std::vector<std::shared_ptr<KeypointRoiCache>> faceRoiCaches;
             std::vector<std::shared_ptr<PoseGpuRenderer>> poseGpuRenderers;
             // CUDA vs. CPU resize
             std::vector<std::shared_ptr<CvMatToOpOutput>> cvMatToOpOutputs;
@@ -283,16 +462,103 @@ namespace op
             bool addCvMatToOpOutput = renderOutput;
             bool addCvMatToOpOutputInCpu = addCvMatToOpOutput;
             std::vector<std::vector<TWorker>> poseExtractorsWs;
+            std::vector<std::vector<TWorker>> faceHandExtractorsWs;
             std::vector<std::vector<TWorker>> poseTriangulationsWs;
             std::vector<std::vector<TWorker>> jointAngleEstimationsWs;
             std::vector<TWorker> postProcessingWs;
+            std::shared_ptr<NetResolutionController> netResolutionController;
+            std::shared_ptr<ScaleAndSizeExtractor> scaleAndSizeExtractor;
+            // GPU memory left by the budget (`--gpu_memory_budget`) once the batch size is fitted
+            auto gpuMemoryRemainingBytes = 0ull;
+            // Tiled inference: The frame is resized to tiledInputSize, and netInputSize is the size of each tile
+            const auto tiled = (wrapperStructPose.tiledInputSize.x != 0 || wrapperStructPose.tiledInputSize.y != 0);
+            const auto poseNetInputSize = (tiled ? wrapperStructPose.tiledInputSize : wrapperStructPose.netInputSize);
             if (numberGpuThreads > 0)
             {
+                // Adaptive network resolution (between netInputSizeMin and netInputSize) given a latency target
+                if (wrapperStructPose.latencyTargetMs > 0.)
+                    netResolutionController = std::make_shared<NetResolutionController>(
+                        wrapperStructPose.netInputSizeMin, wrapperStructPose.netInputSize,
+                        wrapperStructPose.latencyTargetMs);
                 // Get input scales and sizes
-                const auto scaleAndSizeExtractor = std::make_shared<ScaleAndSizeExtractor>(
-                    wrapperStructPose.netInputSize, (float)wrapperStructPose.netInputSizeDynamicBehavior, finalOutputSize,
-                    wrapperStructPose.scalesNumber, wrapperStructPose.scaleGap);
-                scaleAndSizeExtractorW = std::make_shared<WScaleAndSizeExtractor<TDatumsSP>>(scaleAndSizeExtractor);
+                // Adaptive multi-scale: The whole frame only runs the smallest scale
+                const auto scaleAdaptive = (wrapperStructPose.scaleAdaptiveHeight > 0.f
+                                            && wrapperStructPose.scalesNumber > 1);
+                scaleAndSizeExtractor = std::make_shared<ScaleAndSizeExtractor>(
+                    poseNetInputSize, (float)wrapperStructPose.netInputSizeDynamicBehavior, finalOutputSize,
+                    wrapperStructPose.scalesNumber, wrapperStructPose.scaleGap, scaleAdaptive);
+                scaleAndSizeExtractorW = std::make_shared<WScaleAndSizeExtractor<TDatumsSP>>(
+                    scaleAndSizeExtractor, netResolutionController);
+
+                // GPU memory budget: Maximum batch size whose projected GPU memory fits into each GPU
+                if (wrapperStructPose.gpuMemoryBudget != 0)
+                {
+                    // Budget (-1 = the smallest free memory of the used GPUs, which already excludes the CUDA
+                    // context of this process)
+                    auto budgetBytes = (unsigned long long)wrapperStructPose.gpuMemoryBudget << 20;
+                    std::vector<GpuMemoryFootprint> footprints;
+                    if (wrapperStructPose.gpuMemoryBudget > 0)
+                        footprints.emplace_back(getCudaContextFootprint());
+                    else
+                    {
+                        budgetBytes = std::numeric_limits<unsigned long long>::max();
+                        for (auto gpuId = 0; gpuId < numberGpuThreads; gpuId++)
+                            budgetBytes = fastMin(budgetBytes, getGpuFreeMemory(gpuId + gpuNumberStart));
+                    }
+                    // Projected footprints (for a 1280x720 input if its size is unknown yet, e.g., user input)
+                    const auto inputSize = (producerSize.area() > 0 ? producerSize : Point<int>{1280, 720});
+                    const auto scalesAndSizes = scaleAndSizeExtractor->extract(inputSize);
+                    if (wrapperStructPose.poseMode == PoseMode::Enabled)
+                        footprints.emplace_back(PoseExtractorCaffe::getGpuMemoryFootprint(
+                            wrapperStructPose.poseModel, modelFolder, std::get<1>(scalesAndSizes),
+                            wrapperStructPose.caffeModelPath.getStdString()));
+                    if (wrapperStructFace.enable)
+                        footprints.emplace_back(FaceExtractorCaffe::getGpuMemoryFootprint(
+                            wrapperStructFace.netInputSize, modelFolder, inputSize));
+                    if (wrapperStructHand.enable)
+                        footprints.emplace_back(HandExtractorCaffe::getGpuMemoryFootprint(
+                            wrapperStructHand.netInputSize, modelFolder, inputSize));
+                    if (renderOutputGpu)
+                        footprints.emplace_back(PoseGpuRenderer::getGpuMemoryFootprint(std::get<3>(scalesAndSizes)));
+                    // Fit the batch size
+                    const auto gpuMemoryPlan = fitGpuMemoryBudget(
+                        budgetBytes, footprints, wrapperStructPose.batchSize);
+                    if (gpuMemoryPlan.batchSize < 1)
+                        error(gpuMemoryPlan.report + "\nThe configuration does not fit into the GPU memory budget"
+                              " (`--gpu_memory_budget`). Reduce `--net_resolution` or `--scale_number`, disable the"
+                              " face or hand detectors, or increase the budget.", __LINE__, __FUNCTION__, __FILE__);
+                    opLog(gpuMemoryPlan.report, Priority::High);
+                    if (gpuMemoryPlan.batchSize < wrapperStructPose.batchSize)
+                    {
+                        opLog("The batch size (`--batch_size`) has been decreased from "
+                              + std::to_string(wrapperStructPose.batchSize) + " to "
+                              + std::to_string(gpuMemoryPlan.batchSize) + " to fit into the GPU memory budget.",
+                              Priority::High);
+                        wrapperStructPose.batchSize = gpuMemoryPlan.batchSize;
+                    }
+                    gpuMemoryRemainingBytes = gpuMemoryPlan.remainingBytes;
+                }
+
+                // Network warm-up: Network input sizes of the producer resolution and the WrapperT::warmUp() ones,
+                // for each network resolution of the latency target (if any)
+                if (netWarmUp != nullptr && wrapperStructPose.poseMode == PoseMode::Enabled)
+                {
+                    auto inputSizes = netWarmUp->getInputSizes();
+                    if (producerSize.area() > 0)
+                        inputSizes.emplace_back(producerSize);
+                    const auto netInputResolutions = (netResolutionController != nullptr
+                        ? netResolutionController->getNetInputResolutions()
+                        : std::vector<Point<int>>{poseNetInputSize});
+                    for (const auto& netInputResolution : netInputResolutions)
+                    {
+                        const ScaleAndSizeExtractor warmUpScaleAndSizeExtractor{
+                            netInputResolution, (float)wrapperStructPose.netInputSizeDynamicBehavior,
+                            finalOutputSize, wrapperStructPose.scalesNumber, wrapperStructPose.scaleGap,
+                            scaleAdaptive};
+                        for (const auto& inputSize : inputSizes)
+                            netWarmUp->addNetInputSizes(std::get<1>(warmUpScaleAndSizeExtractor.extract(inputSize)));
+                    }
+                }
 
                 // Input cvMat to OpenPose input & output format
                 // Note: resize on GPU reduces accuracy about 0.1%
@@ -300,17 +566,18 @@ namespace op
                 // const auto resizeOnCpu = (wrapperStructPose.poseMode != PoseMode::Enabled);
                 if (resizeOnCpu)
                 {
-                    const auto gpuResize = false;
+                    // NVDEC (NV12) and FLIR GPU debayering (raw Bayer) frames are already in GPU memory
+                    const auto gpuResize = (oPProducer
+                        && (wrapperStructInput.nvDecode || wrapperStructInput.flirBayerGpu));
                     const auto cvMatToOpInput = std::make_shared<CvMatToOpInput>(
                         wrapperStructPose.poseModel, gpuResize);
-                    cvMatToOpInputW = std::make_shared<WCvMatToOpInput<TDatumsSP>>(cvMatToOpInput);
+                    cvMatToOpInputW = std::make_shared<WCvMatToOpInput<TDatumsSP>>(
+                        cvMatToOpInput, keepInputData);
                 }
                 // Note: We realized that somehow doing it on GPU for any number of GPUs does speedup the whole OP
                 resizeOnCpu = false;
                 addCvMatToOpOutputInCpu = addCvMatToOpOutput
-                    && (resizeOnCpu || !renderOutputGpu || wrapperStructPose.poseMode != PoseMode::Enabled
-                        // Resize in GPU causing bug
-                        || wrapperStructPose.outputSize.x != -1 || wrapperStructPose.outputSize.y != -1);
+                    && (resizeOnCpu || !renderOutputGpu || wrapperStructPose.poseMode != PoseMode::Enabled);
                 if (addCvMatToOpOutputInCpu)
                 {
                     const auto gpuResize = false;
@@ -318,23 +585,105 @@ namespace op
                     cvMatToOpOutputW = std::make_shared<WCvMatToOpOutput<TDatumsSP>>(cvMatToOpOutput);
                 }
 
+                // CUDA autotuning (process-wide, each kernel is tuned once per GPU model and shape)
+                if (!wrapperStructPose.cudaAutotuneCacheFile.empty())
+                    setCudaAutotuneCacheFile(wrapperStructPose.cudaAutotuneCacheFile.getStdString());
+
+                // Network memory arenas (1 per GPU thread, shared by its body, face and hand networks)
+                std::vector<std::shared_ptr<NetMemoryArena>> netMemoryArenas(numberGpuThreads);
+                if (wrapperStructPose.netMemorySharing)
+                    for (auto gpuId = 0; gpuId < numberGpuThreads; gpuId++)
+                        netMemoryArenas.at(gpuId) = std::make_shared<NetMemoryArena>(gpuId + gpuNumberStart);
+
                 // Pose estimators & renderers
                 std::vector<TWorker> cpuRenderers;
                 poseExtractorsWs.clear();
                 poseExtractorsWs.resize(numberGpuThreads);
                 if (wrapperStructPose.poseMode != PoseMode::Disabled)
                 {
+                    // Network output cache (shared by all the GPU threads)
+                    const auto netOutputCache = (wrapperStructPose.netOutputCacheDirectory.empty()
+                        ? nullptr : std::make_shared<NetOutputCache>(
+                            wrapperStructPose.netOutputCacheDirectory.getStdString()));
                     // Pose estimators
                     for (auto gpuId = 0; gpuId < numberGpuThreads; gpuId++)
+                    {
+                        if (!wrapperStructPose.sharedPool)
+                            poseExtractorNets.emplace_back(std::make_shared<PoseExtractorCaffe>(
+                                wrapperStructPose.poseModel, modelFolder, gpuId + gpuNumberStart,
+                                wrapperStructPose.heatMapTypes, wrapperStructPose.heatMapScaleMode,
+                                wrapperStructPose.addPartCandidates, wrapperStructPose.maximizePositives,
+                                wrapperStructPose.protoTxtPath.getStdString(),
+                                wrapperStructPose.caffeModelPath.getStdString(),
+                                wrapperStructPose.upsamplingRatio, wrapperStructPose.poseMode == PoseMode::Enabled,
+                                wrapperStructPose.enableGoogleLogging, wrapperStructPose.tensorRtPrecision,
+                                wrapperStructPose.heatMapsFp16, wrapperStructPose.roiTrackingInterval,
+                                wrapperStructPose.numberPeopleMax, wrapperStructPose.scaleBatch,
+                                wrapperStructPose.cudaGraphs, wrapperStructPose.pafLowResolution, netOutputCache,
+                                netMemoryArenas.at(gpuId),
+                                (tiled ? wrapperStructPose.netInputSize : Point<int>{0, 0}),
+                                wrapperStructPose.tileOverlap, wrapperStructPose.netStages
+                            ));
+                        // Body network shared with the other pipelines of the process with the same options. Its
+                        // heat maps and part candidates are selected by each pipeline, and it runs on the thread of
+                        // the pool (so it cannot use the memory arena of this GPU thread)
+                        else
+                        {
+                            const auto key = std::to_string(int(wrapperStructPose.poseModel)) + " | " + modelFolder
+                                + " | GPU " + std::to_string(gpuId + gpuNumberStart) + " | "
+                                + wrapperStructPose.protoTxtPath.getStdString() + " | "
+                                + wrapperStructPose.caffeModelPath.getStdString() + " | "
+                                + std::to_string(wrapperStructPose.upsamplingRatio) + " "
+                                + std::to_string(wrapperStructPose.maximizePositives) + " "
+                                + std::to_string(wrapperStructPose.enableGoogleLogging) + " "
+                                + std::to_string(wrapperStructPose.tensorRtPrecision) + " "
+                                + std::to_string(wrapperStructPose.heatMapsFp16) + " "
+                                + std::to_string(wrapperStructPose.numberPeopleMax) + " "
+                                + std::to_string(wrapperStructPose.scaleBatch) + " "
+                                + std::to_string(wrapperStructPose.cudaGraphs) + " "
+                                + std::to_string(wrapperStructPose.pafLowResolution) + " "
+                                + wrapperStructPose.netOutputCacheDirectory.getStdString() + " "
+                                + (tiled ? wrapperStructPose.netInputSize.toString() : "untiled") + " "
+                                + std::to_string(wrapperStructPose.tileOverlap) + " "
+                                + std::to_string(wrapperStructPose.netStages);
+                            const auto gpuIdPool = gpuId + gpuNumberStart;
+                            const auto poseExtractorPool = PoseExtractorPool::get(
+                                key, [&, gpuIdPool]() -> std::shared_ptr<PoseExtractorNet>
+                                {
+                                    return std::make_shared<PoseExtractorCaffe>(
+                                        wrapperStructPose.poseModel, modelFolder, gpuIdPool,
+                                        std::vector<HeatMapType>{}, wrapperStructPose.heatMapScaleMode, false,
+                                        wrapperStructPose.maximizePositives,
+                                        wrapperStructPose.protoTxtPath.getStdString(),
+                                        wrapperStructPose.caffeModelPath.getStdString(),
+                                        wrapperStructPose.upsamplingRatio, true,
+                                        wrapperStructPose.enableGoogleLogging, wrapperStructPose.tensorRtPrecision,
+                                        wrapperStructPose.heatMapsFp16, 0, wrapperStructPose.numberPeopleMax,
+                                        wrapperStructPose.scaleBatch, wrapperStructPose.cudaGraphs,
+                                        wrapperStructPose.pafLowResolution, netOutputCache, nullptr,
+                                        (tiled ? wrapperStructPose.netInputSize : Point<int>{0, 0}),
+                                        wrapperStructPose.tileOverlap, wrapperStructPose.netStages);
+                                });
+                            poseExtractorNets.emplace_back(std::make_shared<PoseExtractorShared>(
+                                poseExtractorPool, wrapperStructPose.poseModel, gpuIdPool,
+                                wrapperStructPose.heatMapTypes, wrapperStructPose.heatMapScaleMode,
+                                wrapperStructPose.addPartCandidates, wrapperStructPose.maximizePositives,
+                                renderOutputGpu));
+                        }
+                    }
+                    // CPU spillover workers: OpenVINO body network (its post-processing runs on the first GPU)
+                    for (auto worker = 0; worker < spilloverWorkers; worker++)
                         poseExtractorNets.emplace_back(std::make_shared<PoseExtractorCaffe>(
-                            wrapperStructPose.poseModel, modelFolder, gpuId + gpuNumberStart,
+                            wrapperStructPose.poseModel, modelFolder, gpuNumberStart,
                             wrapperStructPose.heatMapTypes, wrapperStructPose.heatMapScaleMode,
-                            wrapperStructPose.addPartCandidates, wrapperStructPose.maximizePositives,
-                            wrapperStructPose.protoTxtPath.getStdString(),
-                            wrapperStructPose.caffeModelPath.getStdString(),
-                            wrapperStructPose.upsamplingRatio, wrapperStructPose.poseMode == PoseMode::Enabled,
-                            wrapperStructPose.enableGoogleLogging
-                        ));
+                            wrapperStructPose.addPartCandidates, wrapperStructPose.maximizePositives, "",
+                            wrapperStructExtra.spilloverModelPath.getStdString(), wrapperStructPose.upsamplingRatio,
+                            wrapperStructPose.poseMode == PoseMode::Enabled, wrapperStructPose.enableGoogleLogging,
+                            wrapperStructPose.tensorRtPrecision, wrapperStructPose.heatMapsFp16,
+                            wrapperStructPose.roiTrackingInterval, wrapperStructPose.numberPeopleMax,
+                            wrapperStructPose.scaleBatch, false, wrapperStructPose.pafLowResolution, netOutputCache,
+                            nullptr, (tiled ? wrapperStructPose.netInputSize : Point<int>{0, 0}),
+                            wrapperStructPose.tileOverlap, wrapperStructPose.netStages));
 
                     // Pose renderers
                     if (renderOutputGpu || renderModePose == RenderMode::Cpu)
@@ -371,6 +720,13 @@ namespace op
 
                     // Pose extractor(s)
                     poseExtractorsWs.resize(poseExtractorNets.size());
+                    // Warm-up cache key of each GPU
+                    std::vector<std::string> netWarmUpKeys(poseExtractorNets.size());
+                    if (netWarmUp != nullptr)
+                        for (auto i = 0u; i < netWarmUpKeys.size(); i++)
+                            netWarmUpKeys[i] = NetWarmUp::getKey(
+                                (int)i + gpuNumberStart, std::to_string(int(wrapperStructPose.poseModel)) + " | "
+                                + modelFolder + " | " + wrapperStructPose.protoTxtPath.getStdString());
                     const auto personIdExtractor = (wrapperStructExtra.identification
                         ? std::make_shared<PersonIdExtractor>() : nullptr);
                     // Keep top N people
@@ -384,7 +740,10 @@ namespace op
                         : nullptr);
                     // Person tracker
                     auto personTrackers = std::make_shared<std::vector<std::shared_ptr<PersonTracker>>>();
-                    if (wrapperStructExtra.tracking > -1)
+                    // Or keypoint extrapolation (1 per view, created on demand)
+                    const auto keypointExtrapolators = (wrapperStructExtra.trackingExtrapolation
+                        ? std::make_shared<std::vector<std::shared_ptr<KeypointExtrapolator>>>() : nullptr);
+                    if (wrapperStructExtra.tracking > -1 && keypointExtrapolators == nullptr)
                         personTrackers->emplace_back(
                             std::make_shared<PersonTracker>(wrapperStructExtra.tracking == 0));
                     for (auto i = 0u; i < poseExtractorsWs.size(); i++)
@@ -393,7 +752,7 @@ namespace op
                         //    + ID extractor (experimental) + tracking (experimental)
                         const auto poseExtractor = std::make_shared<PoseExtractor>(
                             poseExtractorNets.at(i), keepTopNPeople, personIdExtractor, personTrackers,
-                            wrapperStructPose.numberPeopleMax, wrapperStructExtra.tracking);
+                            wrapperStructPose.numberPeopleMax, wrapperStructExtra.tracking, keypointExtrapolators);
                         // If we want the initial image resize on GPU
                         if (cvMatToOpInputW == nullptr)
                         {
@@ -401,7 +760,7 @@ namespace op
                             const auto cvMatToOpInput = std::make_shared<CvMatToOpInput>(
                                 wrapperStructPose.poseModel, gpuResize);
                             poseExtractorsWs.at(i).emplace_back(
-                                std::make_shared<WCvMatToOpInput<TDatumsSP>>(cvMatToOpInput));
+                                std::make_shared<WCvMatToOpInput<TDatumsSP>>(cvMatToOpInput, keepInputData));
                         }
                         // If we want the final image resize on GPU
                         if (addCvMatToOpOutput && cvMatToOpOutputW == nullptr)
@@ -411,8 +770,31 @@ namespace op
                             poseExtractorsWs.at(i).emplace_back(
                                 std::make_shared<WCvMatToOpOutput<TDatumsSP>>(cvMatToOpOutputs.back()));
                         }
+                        // Motion gate (1 per pose thread, it keeps the last processed frame of that thread)
+                        const auto motionGate = (wrapperStructPose.motionGateRatio > 0.
+                            ? std::make_shared<MotionGate>(
+                                wrapperStructPose.motionGateRatio, wrapperStructPose.motionGatePixelThreshold,
+                                wrapperStructPose.motionGateMaxSkip)
+                            : nullptr);
                         poseExtractorsWs.at(i).emplace_back(
-                            std::make_shared<WPoseExtractor<TDatumsSP>>(poseExtractor));
+                            std::make_shared<WPoseExtractor<TDatumsSP>>(
+                                poseExtractor, wrapperStructPose.batchSize,
+                                wrapperStructPose.batchMaxWaitMicroseconds, netResolutionController, motionGate,
+                                wrapperStructPose.pipelined, wrapperStructPose.heatMapsLazy,
+                                (wrapperStructPose.poseMode == PoseMode::Enabled && (int)i < numberGpuThreads
+                                    ? netWarmUp : nullptr),
+                                netWarmUpKeys.at(i),
+                                // 1 per GPU thread (it runs the crops on its PoseExtractor)
+                                (scaleAdaptive && wrapperStructPose.poseMode == PoseMode::Enabled
+                                    ? std::make_shared<AdaptiveMultiScale>(
+                                        wrapperStructPose.poseModel, wrapperStructPose.scalesNumber,
+                                        wrapperStructPose.scaleGap, wrapperStructPose.scaleAdaptiveHeight)
+                                    : nullptr),
+                                wrapperStructPose.heatMapsSparseThreshold));
+                        // GPU input frames only required in CPU memory after the pose estimation
+                        if (nvDecodeDownloadLate)
+                            poseExtractorsWs.at(i).emplace_back(
+                                std::make_shared<WInputDataGpuDownload<TDatumsSP>>());
                         // poseExtractorsWs.at(i) = {std::make_shared<WPoseExtractor<TDatumsSP>>(poseExtractor)};
                         // // Just OpenPose keypoint detector
                         // poseExtractorsWs.at(i) = {std::make_shared<WPoseExtractorNet<TDatumsSP>>(
@@ -450,6 +832,30 @@ namespace op
                 }
                 opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
 
+                // Face and hand extractors run at the same time (WFaceAndHandExtractorNet)
+                const auto faceAndHandConcurrent = wrapperStructFace.enable && wrapperStructHand.enable
+                    && wrapperStructHand.concurrentWithFace;
+                // BODY_135 face and hand keypoints (shared by all the GPU threads, it has no state)
+                const auto faceFromBodyThreshold = (
+                    wrapperStructFace.enable ? wrapperStructFace.fromBodyThreshold : -1.f);
+                const auto handFromBodyThreshold = (
+                    wrapperStructHand.enable ? wrapperStructHand.fromBodyThreshold : -1.f);
+                const auto body135FaceHand = (faceFromBodyThreshold >= 0.f || handFromBodyThreshold >= 0.f
+                    ? std::make_shared<Body135FaceHand>(
+                        wrapperStructPose.poseModel, faceFromBodyThreshold, handFromBodyThreshold)
+                    : nullptr);
+                // Face and hand workers: Added to each body GPU thread, or to a single thread on their own GPU if
+                // pipelined (faceHandWs.size() == 1, added after the body GPU threads)
+                faceHandExtractorsWs.clear();
+                if (faceHandPipelined)
+                    faceHandExtractorsWs.resize(1);
+                auto& faceHandWs = (faceHandPipelined ? faceHandExtractorsWs : poseExtractorsWs);
+                const auto faceHandGpuStart = (faceHandPipelined ? wrapperStructExtra.faceHandGpu : gpuNumberStart);
+                auto faceHandArenas = netMemoryArenas;
+                if (faceHandPipelined)
+                    faceHandArenas = {(wrapperStructPose.netMemorySharing
+                        ? std::make_shared<NetMemoryArena>(faceHandGpuStart) : nullptr)};
+
                 // Face extractor(s)
                 if (wrapperStructFace.enable)
                 {
@@ -465,7 +871,7 @@ namespace op
                                   __LINE__, __FUNCTION__, __FILE__);
                         // Constructors
                         const auto faceDetector = std::make_shared<FaceDetector>(wrapperStructPose.poseModel);
-                        for (auto& wPose : poseExtractorsWs)
+                        for (auto& wPose : faceHandWs)
                             wPose.emplace_back(std::make_shared<WFaceDetector<TDatumsSP>>(faceDetector));
                     }
                     // OpenCV face detector
@@ -473,7 +879,7 @@ namespace op
                     {
                         opLog("Body keypoint detection is disabled. Hence, using OpenCV face detector (much less"
                             " accurate but faster).", Priority::High);
-                        for (auto& wPose : poseExtractorsWs)
+                        for (auto& wPose : faceHandWs)
                         {
                             // 1 FaceDetectorOpenCV per thread, OpenCV face detector is not thread-safe
                             const auto faceDetectorOpenCV = std::make_shared<FaceDetectorOpenCV>(modelFolder);
@@ -482,24 +888,51 @@ namespace op
                             );
                         }
                     }
+                    // CNN face detector
+                    else if (wrapperStructFace.detector == Detector::Net)
+                    {
+                        for (auto gpu = 0u; gpu < faceHandWs.size(); gpu++)
+                        {
+                            // 1 FaceDetectorNet per GPU, each one with its own network
+                            const auto faceDetectorNet = std::make_shared<FaceDetectorNet>(
+                                modelFolder, gpu + faceHandGpuStart, wrapperStructFace.detectorNetInputSize,
+                                wrapperStructFace.detectorScaleNumber, 0.5f, 0.5f, wrapperStructPose.tensorRtPrecision,
+                                wrapperStructPose.enableGoogleLogging);
+                            faceHandWs.at(gpu).emplace_back(
+                                std::make_shared<WFaceDetectorNet<TDatumsSP>>(faceDetectorNet));
+                        }
+                    }
                     // If provided by user: We do not need to create a FaceDetector
                     // Unknown face Detector
                     else if (wrapperStructFace.detector != Detector::Provided)
                         error("Unknown face Detector. Select a valid face Detector (`--face_detector`).",
                               __LINE__, __FUNCTION__, __FILE__);
                     // Face keypoint extractor
-                    for (auto gpu = 0u; gpu < poseExtractorsWs.size(); gpu++)
+                    for (auto gpu = 0u; gpu < faceHandWs.size(); gpu++)
                     {
                         // Face keypoint extractor
                         const auto netOutputSize = wrapperStructFace.netInputSize;
                         const auto faceExtractorNet = std::make_shared<FaceExtractorCaffe>(
                             wrapperStructFace.netInputSize, netOutputSize, modelFolder,
-                            gpu + gpuNumberStart, wrapperStructPose.heatMapTypes, wrapperStructPose.heatMapScaleMode,
-                            wrapperStructPose.enableGoogleLogging
+                            gpu + faceHandGpuStart, wrapperStructPose.heatMapTypes, wrapperStructPose.heatMapScaleMode,
+                            wrapperStructPose.enableGoogleLogging, wrapperStructFace.adaptiveCropSize,
+                            // If concurrent with the hand, the face network runs on its own thread
+                            (faceAndHandConcurrent && faceHandArenas.at(gpu) != nullptr
+                                ? std::make_shared<NetMemoryArena>(gpu + faceHandGpuStart) : faceHandArenas.at(gpu))
                         );
+                        // Lazy loading: Its network is only loaded once enabled (see WrapperT::reconfigure())
+                        if (!wrapperStructFace.startEnabled)
+                            faceExtractorNet->setEnabled(false);
+                        faceExtractorNet->setLazyLoading(wrapperStructFace.lazyIdleSeconds);
                         faceExtractorNets.emplace_back(faceExtractorNet);
-                        poseExtractorsWs.at(gpu).emplace_back(
-                            std::make_shared<WFaceExtractorNet<TDatumsSP>>(faceExtractorNet));
+                        // ROI cache (1 per GPU thread, it keeps the last face keypoints of each person in that thread)
+                        faceRoiCaches.emplace_back(wrapperStructFace.roiCacheMaxSkip > 0
+                            ? std::make_shared<KeypointRoiCache>(wrapperStructFace.roiCacheMaxSkip) : nullptr);
+                        // If concurrent with the hand: Added with the hand keypoint extractor
+                        if (!faceAndHandConcurrent)
+                            faceHandWs.at(gpu).emplace_back(
+                                std::make_shared<WFaceExtractorNet<TDatumsSP>>(
+                                    faceExtractorNet, faceRoiCaches.back(), body135FaceHand));
                     }
                 }
                 opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
@@ -509,7 +942,7 @@ namespace op
                 {
                     opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                     const auto handDetector = std::make_shared<HandDetector>(wrapperStructPose.poseModel);
-                    for (auto gpu = 0u; gpu < poseExtractorsWs.size(); gpu++)
+                    for (auto gpu = 0u; gpu < faceHandWs.size(); gpu++)
                     {
                         // Sanity check
                         if ((wrapperStructHand.detector == Detector::BodyWithTracking
@@ -522,13 +955,13 @@ namespace op
                         // OpenPose body-based hand detector with tracking
                         if (wrapperStructHand.detector == Detector::BodyWithTracking)
                         {
-                            poseExtractorsWs.at(gpu).emplace_back(
+                            faceHandWs.at(gpu).emplace_back(
                                 std::make_shared<WHandDetectorTracking<TDatumsSP>>(handDetector));
                         }
                         // OpenPose body-based hand detector
                         else if (wrapperStructHand.detector == Detector::Body)
                         {
-                            poseExtractorsWs.at(gpu).emplace_back(
+                            faceHandWs.at(gpu).emplace_back(
                                 std::make_shared<WHandDetector<TDatumsSP>>(handDetector));
                         }
                         // If provided by user: We do not need to create a FaceDetector
@@ -540,17 +973,31 @@ namespace op
                         const auto netOutputSize = wrapperStructHand.netInputSize;
                         const auto handExtractorNet = std::make_shared<HandExtractorCaffe>(
                             wrapperStructHand.netInputSize, netOutputSize, modelFolder,
-                            gpu + gpuNumberStart, wrapperStructHand.scalesNumber, wrapperStructHand.scaleRange,
+                            gpu + faceHandGpuStart, wrapperStructHand.scalesNumber, wrapperStructHand.scaleRange,
                             wrapperStructPose.heatMapTypes, wrapperStructPose.heatMapScaleMode,
-                            wrapperStructPose.enableGoogleLogging
+                            wrapperStructPose.enableGoogleLogging, wrapperStructHand.adaptiveCropSize,
+                            faceHandArenas.at(gpu)
                         );
+                        // Lazy loading: Its network is only loaded once enabled (see WrapperT::reconfigure())
+                        if (!wrapperStructHand.startEnabled)
+                            handExtractorNet->setEnabled(false);
+                        handExtractorNet->setLazyLoading(wrapperStructHand.lazyIdleSeconds);
                         handExtractorNets.emplace_back(handExtractorNet);
-                        poseExtractorsWs.at(gpu).emplace_back(
-                            std::make_shared<WHandExtractorNet<TDatumsSP>>(handExtractorNet)
-                            );
+                        // ROI cache (1 per GPU thread)
+                        const auto handRoiCache = (wrapperStructHand.roiCacheMaxSkip > 0
+                            ? std::make_shared<KeypointRoiCache>(wrapperStructHand.roiCacheMaxSkip) : nullptr);
+                        if (faceAndHandConcurrent)
+                            faceHandWs.at(gpu).emplace_back(
+                                std::make_shared<WFaceAndHandExtractorNet<TDatumsSP>>(
+                                    faceExtractorNets.at(gpu), handExtractorNet, faceRoiCaches.at(gpu),
+                                    handRoiCache, body135FaceHand));
+                        else
+                            faceHandWs.at(gpu).emplace_back(
+                                std::make_shared<WHandExtractorNet<TDatumsSP>>(
+                                    handExtractorNet, handRoiCache, body135FaceHand));
                         // If OpenPose body-based hand detector with tracking
                         if (wrapperStructHand.detector == Detector::BodyWithTracking)
-                            poseExtractorsWs.at(gpu).emplace_back(
+                            faceHandWs.at(gpu).emplace_back(
                                 std::make_shared<WHandDetectorUpdate<TDatumsSP>>(handDetector));
                     }
                 }
@@ -651,7 +1098,13 @@ namespace op
                     for (auto i = 0u ; i < poseExtractorsWs.size() ; ++i)
                     {
                         const auto gpuResize = true;
-                        opOutputToCvMats.emplace_back(std::make_shared<OpOutputToCvMat>(gpuResize));
+                        // The GPU JPEG encoding of the rendered images (and the user workers if keepRenderTargetGpu)
+                        // read their render target
+                        const auto keepRenderTargetGpu = (wrapperStructOutput.keepRenderTargetGpu
+                                                          || (wrapperStructOutput.writeJpgGpu
+                                                              && !writeImagesCleaned.empty()));
+                        opOutputToCvMats.emplace_back(
+                            std::make_shared<OpOutputToCvMat>(gpuResize, keepRenderTargetGpu));
                         poseExtractorsWs.at(i).emplace_back(
                             std::make_shared<WOpOutputToCvMat<TDatumsSP>>(opOutputToCvMats.back()));
                         // Assign shared parameters
@@ -668,10 +1121,17 @@ namespace op
                     opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                     // For all (body/face/hands): PoseTriangulations ~30 msec, 8 GPUS ~30 msec for keypoint estimation
                     poseTriangulationsWs.resize(fastMax(1, int(poseExtractorsWs.size() / 4)));
+                    // Temporal mode: a single PoseTriangulation (thread-safe), so all the threads share the previous
+                    // frame reconstruction
+                    const auto sharedPoseTriangulation = (wrapperStructExtra.temporal3d
+                        ? std::make_shared<PoseTriangulation>(
+                            wrapperStructExtra.minViews3d, wrapperStructExtra.multiPerson3d, true)
+                        : nullptr);
                     for (auto i = 0u ; i < poseTriangulationsWs.size() ; i++)
                     {
-                        const auto poseTriangulation = std::make_shared<PoseTriangulation>(
-                            wrapperStructExtra.minViews3d);
+                        const auto poseTriangulation = (sharedPoseTriangulation != nullptr
+                            ? sharedPoseTriangulation : std::make_shared<PoseTriangulation>(
+                                wrapperStructExtra.minViews3d, wrapperStructExtra.multiPerson3d));
                         poseTriangulationsWs.at(i) = {std::make_shared<WPoseTriangulation<TDatumsSP>>(
                             poseTriangulation)};
                     }
@@ -696,20 +1156,35 @@ namespace op
                     postProcessingWs.emplace_back(std::make_shared<WOpOutputToCvMat<TDatumsSP>>(opOutputToCvMat));
                 }
                 opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Aligned person crops on the GPU (before re-scaling the keypoints, so they are in input resolution)
+                if (wrapperStructExtra.personCropSize.x > 0 && wrapperStructExtra.personCropSize.y > 0)
+                {
+                    const auto personCropExtractor = std::make_shared<PersonCropExtractor>(
+                        wrapperStructPose.poseModel, wrapperStructExtra.personCropSize,
+                        wrapperStructExtra.personCropScale, wrapperStructExtra.personCropAlign,
+                        wrapperStructPose.renderThreshold, wrapperStructExtra.personCropDownload,
+                        fastMax(0, wrapperStructPose.gpuNumberStart));
+                    postProcessingWs.emplace_back(
+                        std::make_shared<WPersonCropExtractor<TDatumsSP>>(personCropExtractor));
+                }
                 // Re-scale pose if desired
                 // If desired scale is not the current input
                 if (wrapperStructPose.keypointScaleMode != ScaleMode::InputResolution
                     // and desired scale is not output when size(input) = size(output)
                     && !(wrapperStructPose.keypointScaleMode == ScaleMode::OutputResolution &&
                          (finalOutputSize == producerSize || finalOutputSize.x <= 0 || finalOutputSize.y <= 0))
-                    // and desired scale is not net output when size(input) = size(net output)
+                    // and desired scale is not net output when size(input) = size(net output) (fixed one)
                     && !(wrapperStructPose.keypointScaleMode == ScaleMode::NetOutputResolution
-                         && producerSize == wrapperStructPose.netInputSize))
+                         && producerSize == poseNetInputSize && netResolutionController == nullptr))
                 {
                     // Then we must rescale the keypoints
                     auto keypointScaler = std::make_shared<KeypointScaler>(wrapperStructPose.keypointScaleMode);
                     postProcessingWs.emplace_back(std::make_shared<WKeypointScaler<TDatumsSP>>(keypointScaler));
                 }
+                // Frame latency for the adaptive network resolution
+                if (netResolutionController != nullptr)
+                    postProcessingWs.emplace_back(
+                        std::make_shared<WNetResolutionController<TDatumsSP>>(netResolutionController));
             }
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
 
@@ -757,6 +1232,29 @@ namespace op
             }
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
 #endif
+            // Stream the keypoints as binary packets (UDP and/or shared memory). It is the first output worker after
+            // the verbose printer, so the keypoints are sent before any file writing
+            if (!wrapperStructOutput.streamKeypointsUdp.empty() || !wrapperStructOutput.streamKeypointsShm.empty())
+            {
+                opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                const auto keypointStreamer = std::make_shared<KeypointStreamer>(
+                    wrapperStructOutput.streamKeypointsUdp.getStdString(),
+                    wrapperStructOutput.streamKeypointsShm.getStdString(), 8u,
+                    wrapperStructOutput.streamKeypointsPrecision, wrapperStructOutput.streamKeypointsPrecision3D,
+                    (unsigned int)fastMax(1, wrapperStructOutput.streamKeypointsKeyframe));
+                outputWs.emplace_back(std::make_shared<WKeypointStreamer<TDatumsSP>>(keypointStreamer));
+            }
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            // Send the frame sets to the next process of a pipeline split across processes or nodes
+            if (!wrapperStructOutput.datumSend.empty())
+            {
+                opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                const auto datumSender = std::make_shared<DatumSender>(
+                    wrapperStructOutput.datumSend.getStdString(), wrapperStructOutput.datumSendFields,
+                    wrapperStructOutput.datumSendJpegQuality);
+                outputWs.emplace_back(std::make_shared<WDatumSender<TDatumsSP>>(datumSender));
+            }
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             // Write people pose data on disk (json for OpenCV >= 3, xml, yml...)
             if (!writeKeypointCleaned.empty())
             {
@@ -775,8 +1273,29 @@ namespace op
             if (!writeJsonCleaned.empty())
             {
                 opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
-                const auto peopleJsonSaver = std::make_shared<PeopleJsonSaver>(writeJsonCleaned);
-                outputWs.emplace_back(std::make_shared<WPeopleJsonSaver<TDatumsSP>>(peopleJsonSaver));
+                // Several multiplexed sources (MultiSourceProducer): 1 sub-directory per source
+                if (numberSources > 1)
+                {
+                    std::vector<std::shared_ptr<PeopleJsonSaver>> peopleJsonSavers(numberSources);
+                    for (auto i = 0ull ; i < numberSources ; i++)
+                        peopleJsonSavers[i] = std::make_shared<PeopleJsonSaver>(
+                            writeJsonCleaned + "source" + std::to_string(i) + "/");
+                    outputWs.emplace_back(std::make_shared<WPeopleJsonSaver<TDatumsSP>>(peopleJsonSavers));
+                }
+                else
+                {
+                    const auto peopleJsonSaver = std::make_shared<PeopleJsonSaver>(writeJsonCleaned);
+                    outputWs.emplace_back(std::make_shared<WPeopleJsonSaver<TDatumsSP>>(peopleJsonSaver));
+                }
+            }
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            // Write OpenPose output data on disk in binary format (all the frames and sources into 1 file)
+            if (!wrapperStructOutput.writeBinary.empty())
+            {
+                opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                const auto keypointBinarySaver = std::make_shared<KeypointBinarySaver>(
+                    wrapperStructOutput.writeBinary.getStdString());
+                outputWs.emplace_back(std::make_shared<WKeypointBinarySaver<TDatumsSP>>(keypointBinarySaver));
             }
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             // Write people pose/foot/face/hand/etc. data on disk (COCO validation JSON format)
@@ -785,13 +1304,15 @@ namespace op
                 opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // If humanFormat: bigger size (& maybe slower to process), but easier for user to read it
                 const auto humanFormat = true;
+                const auto cocoEvaluator = (wrapperStructOutput.writeCocoJsonEval.empty()
+                    ? nullptr : std::make_shared<CocoEvaluator>(wrapperStructOutput.writeCocoJsonEval.getStdString()));
                 const auto cocoJsonSaver = std::make_shared<CocoJsonSaver>(
                     wrapperStructOutput.writeCocoJson.getStdString(), wrapperStructPose.poseModel, humanFormat,
                     wrapperStructOutput.writeCocoJsonVariants,
                     (wrapperStructPose.poseModel != PoseModel::CAR_22
                         && wrapperStructPose.poseModel != PoseModel::CAR_12
                         ? CocoJsonFormat::Body : CocoJsonFormat::Car),
-                    wrapperStructOutput.writeCocoJsonVariant);
+                    wrapperStructOutput.writeCocoJsonVariant, cocoEvaluator);
                 outputWs.emplace_back(std::make_shared<WCocoJsonSaver<TDatumsSP>>(cocoJsonSaver));
             }
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
@@ -801,7 +1322,8 @@ namespace op
             {
                 opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 const auto imageSaver = std::make_shared<ImageSaver>(
-                    writeImagesCleaned, wrapperStructOutput.writeImagesFormat.getStdString());
+                    writeImagesCleaned, wrapperStructOutput.writeImagesFormat.getStdString(),
+                    wrapperStructOutput.writeThreads, wrapperStructOutput.writeJpgGpu);
                 outputWs.emplace_back(std::make_shared<WImageSaver<TDatumsSP>>(imageSaver));
             }
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
@@ -835,11 +1357,45 @@ namespace op
                     error("Audio can only be added to the output saved video if the input is also a video (either"
                           " disable `--write_video_with_audio` or use a video as input with `--video`).",
                           __LINE__, __FUNCTION__, __FILE__);
+                if (wrapperStructOutput.writeVideoWithAudio && numberSources > 1)
+                    error("Audio cannot be added to the output saved videos if several input sources are"
+                          " multiplexed (disable `--write_video_with_audio`).", __LINE__, __FUNCTION__, __FILE__);
                 // Create video saver worker
-                const auto videoSaver = std::make_shared<VideoSaver>(
-                    wrapperStructOutput.writeVideo.getStdString(), getCvFourcc('M','J','P','G'), originalVideoFps,
-                    (wrapperStructOutput.writeVideoWithAudio ? wrapperStructInput.producerString.getStdString() : ""));
-                outputWs.emplace_back(std::make_shared<WVideoSaver<TDatumsSP>>(videoSaver));
+                // Several multiplexed sources (MultiSourceProducer): 1 video per source (`<name>_source<i>.<ext>`)
+                if (numberSources > 1)
+                {
+                    const auto writeVideo = wrapperStructOutput.writeVideo.getStdString();
+                    std::vector<std::shared_ptr<VideoSaver>> videoSavers(numberSources);
+                    for (auto i = 0ull ; i < numberSources ; i++)
+                        videoSavers[i] = std::make_shared<VideoSaver>(
+                            getFullFilePathNoExtension(writeVideo) + "_source" + std::to_string(i) + "."
+                            + getFileExtension(writeVideo), getCvFourcc('M','J','P','G'), originalVideoFps, "",
+                            wrapperStructOutput.writeThreads, wrapperStructOutput.writeVideoEncoder.getStdString());
+                    outputWs.emplace_back(std::make_shared<WVideoSaver<TDatumsSP>>(videoSavers));
+                }
+                else
+                {
+                    const auto videoSaver = std::make_shared<VideoSaver>(
+                        wrapperStructOutput.writeVideo.getStdString(), getCvFourcc('M','J','P','G'), originalVideoFps,
+                        (wrapperStructOutput.writeVideoWithAudio
+                            ? wrapperStructInput.producerString.getStdString() : ""),
+                        wrapperStructOutput.writeThreads, wrapperStructOutput.writeVideoEncoder.getStdString());
+                    outputWs.emplace_back(std::make_shared<WVideoSaver<TDatumsSP>>(videoSaver));
+                }
+            }
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            // Stream frames as live video (it never waits for the network, so it can use the frame producer FPS)
+            if (!wrapperStructOutput.streamVideo.empty())
+            {
+                opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                const auto streamVideoFps = (
+                    wrapperStructOutput.writeVideoFps > 0 ? wrapperStructOutput.writeVideoFps
+                    : (oPProducer && producerSharedPtr->get(getCvCapPropFrameFps()) > 0
+                        ? producerSharedPtr->get(getCvCapPropFrameFps()) : 30.));
+                const auto videoStreamer = std::make_shared<VideoStreamer>(
+                    wrapperStructOutput.streamVideo.getStdString(), streamVideoFps,
+                    wrapperStructOutput.streamVideoEncoder.getStdString());
+                outputWs.emplace_back(std::make_shared<WVideoStreamer<TDatumsSP>>(videoStreamer));
             }
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             // Write joint angles as *.bvh file on hard disk
@@ -859,15 +1415,24 @@ namespace op
             {
                 opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 const auto heatMapSaver = std::make_shared<HeatMapSaver>(
-                    writeHeatMapsCleaned, wrapperStructOutput.writeHeatMapsFormat.getStdString());
+                    writeHeatMapsCleaned, wrapperStructOutput.writeHeatMapsFormat.getStdString(),
+                    wrapperStructOutput.writeThreads, wrapperStructOutput.writeJpgGpu);
                 outputWs.emplace_back(std::make_shared<WHeatMapSaver<TDatumsSP>>(heatMapSaver));
             }
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             // Add frame information for GUI
             const bool guiEnabled = (wrapperStructGui.displayMode != DisplayMode::NoDisplay);
+            // Overlay mode: the information is only composited when displaying the frames (by WGui)
+            auto guiOverlay = (wrapperStructGui.overlay && wrapperStructGui.guiVerbose && guiEnabled);
+            if (guiOverlay && wrapperStructGui.displayMode != DisplayMode::Display2D)
+            {
+                opLog("The GUI overlay (`--display_overlay`) is only available for the 2-D display (`--display 2`),"
+                      " so it will be disabled.", Priority::High);
+                guiOverlay = false;
+            }
             // If this WGuiInfoAdder instance is placed before the WImageSaver or WVideoSaver, then the resulting
             // recorded frames will look exactly as the final displayed image by the GUI
-            if (wrapperStructGui.guiVerbose && (guiEnabled || !userOutputWs.empty()
+            if (wrapperStructGui.guiVerbose && !guiOverlay && (guiEnabled || !userOutputWs.empty()
                                                 || threadManagerMode == ThreadManagerMode::Asynchronous
                                                 || threadManagerMode == ThreadManagerMode::AsynchronousOut))
             {
@@ -876,19 +1441,27 @@ namespace op
                 outputWs.emplace_back(std::make_shared<WGuiInfoAdder<TDatumsSP>>(guiInfoAdder));
             }
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            // PoseRenderers to Renderers
+            std::vector<std::shared_ptr<Renderer>> renderers;
+            if (renderModePose == RenderMode::Cpu)
+            {
+                if (poseCpuRenderer != nullptr)
+                    renderers.emplace_back(std::static_pointer_cast<Renderer>(poseCpuRenderer));
+            }
+            else
+                for (const auto& poseGpuRenderer : poseGpuRenderers)
+                    renderers.emplace_back(std::static_pointer_cast<Renderer>(poseGpuRenderer));
+            // Components that WrapperT::reconfigure() can change while running
+            if (runtimeConfigurator != nullptr)
+                runtimeConfigurator->setComponents(
+                    scaleAndSizeExtractor, (netResolutionController == nullptr && !tiled), faceExtractorNets,
+                    handExtractorNets, renderers);
             // Minimal graphical user interface (GUI)
             TWorker guiW;
             TWorker videoSaver3DW;
             if (guiEnabled)
             {
                 opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
-                // PoseRenderers to Renderers
-                std::vector<std::shared_ptr<Renderer>> renderers;
-                if (renderModePose == RenderMode::Cpu)
-                    renderers.emplace_back(std::static_pointer_cast<Renderer>(poseCpuRenderer));
-                else
-                    for (const auto& poseGpuRenderer : poseGpuRenderers)
-                        renderers.emplace_back(std::static_pointer_cast<Renderer>(poseGpuRenderer));
                 // Display
                 const auto numberViews = (producerSharedPtr != nullptr
                     ? positiveIntRound(producerSharedPtr->get(ProducerProperty::NumberViews)) : 1);
@@ -933,7 +1506,8 @@ namespace op
                     if (!wrapperStructOutput.writeVideo3D.empty())
                     {
                         const auto videoSaver = std::make_shared<VideoSaver>(
-                            wrapperStructOutput.writeVideo3D.getStdString(), getCvFourcc('M','J','P','G'), originalVideoFps, "");
+                            wrapperStructOutput.writeVideo3D.getStdString(), getCvFourcc('M','J','P','G'), originalVideoFps, "",
+                            wrapperStructOutput.writeThreads, wrapperStructOutput.writeVideoEncoder.getStdString());
                         videoSaver3DW = std::make_shared<WVideoSaver3D<TDatumsSP>>(videoSaver);
                     }
                 }
@@ -944,10 +1518,13 @@ namespace op
                     // Gui
                     const auto gui = std::make_shared<Gui>(
                         finalOutputSizeGui, wrapperStructGui.fullScreen, threadManager.getIsRunningSharedPtr(),
-                        spVideoSeek, poseExtractorNets, faceExtractorNets, handExtractorNets, renderers
+                        spVideoSeek, poseExtractorNets, faceExtractorNets, handExtractorNets, renderers,
+                        DisplayMode::Display2D, wrapperStructGui.vSync, wrapperStructGui.skipStaleFrames
                     );
                     // WGui
-                    guiW = {std::make_shared<WGui<TDatumsSP>>(gui)};
+                    const auto guiInfoAdder = (guiOverlay
+                        ? std::make_shared<GuiInfoAdder>(numberGpuThreads, guiEnabled) : nullptr);
+                    guiW = {std::make_shared<WGui<TDatumsSP>>(gui, guiInfoAdder)};
                     // Write 3D frames as *.avi video on hard disk
                     if (!wrapperStructOutput.writeVideo3D.empty())
                         error("3D video can only be recorded if 3D render is enabled.",
@@ -994,6 +1571,8 @@ namespace op
             unsigned long long threadId = 0ull;
             auto queueIn = 0ull;
             auto queueOut = 1ull;
+            // Threads kept out of the work-stealing thread pool (blocking producers, per-thread GPU state and GUI)
+            std::set<unsigned long long> dedicatedThreadIds;
             // After producer
             // ID generator (before any multi-threading or any function that requires the ID)
             const auto wIdGenerator = std::make_shared<WIdGenerator<TDatumsSP>>();
@@ -1011,7 +1590,13 @@ namespace op
             workersAux = mergeVectors(workersAux, {wIdGenerator});
             // Scale & cv::Mat to OP format
             if (scaleAndSizeExtractorW != nullptr)
+            {
+                // Changes queued by WrapperT::reconfigure(), applied right before WScaleAndSizeExtractor
+                if (runtimeConfigurator != nullptr)
+                    workersAux = mergeVectors(
+                        workersAux, {std::make_shared<WRuntimeConfigurator<TDatumsSP>>(runtimeConfigurator)});
                 workersAux = mergeVectors(workersAux, {scaleAndSizeExtractorW});
+            }
             if (cvMatToOpInputW != nullptr)
                 workersAux = mergeVectors(workersAux, {cvMatToOpInputW});
             // cv::Mat to output format
@@ -1024,6 +1609,7 @@ namespace op
             {
                 // Thread 0, queues 0 -> 1
                 opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                dedicatedThreadIds.emplace(threadId);
                 threadManager.add(threadId, userInputWs, queueIn++, queueOut++);
                 threadIdPP(threadId, multiThreadEnabled);
             }
@@ -1037,9 +1623,20 @@ namespace op
             else if (threadManagerMode != ThreadManagerMode::Asynchronous
                      && threadManagerMode != ThreadManagerMode::AsynchronousIn)
                 error("No input selected.", __LINE__, __FUNCTION__, __FILE__);
+            // Real-time live sources: Only the latest frame is kept if the following stages are slower than the
+            // camera, so the latency is bounded to about 1 frame rather than to the queue size
+            const auto keepLatestFrame = wrapperStructInput.realTimeProcessing && datumProducerW != nullptr
+                && userInputWs.empty() && producerSharedPtr != nullptr
+                && (producerSharedPtr->getType() == ProducerType::Webcam
+                    || producerSharedPtr->getType() == ProducerType::IPCamera
+                    || producerSharedPtr->getType() == ProducerType::FlirCamera
+                    || producerSharedPtr->getType() == ProducerType::SharedMemory);
             // Thread 0 or 1, queues 0 -> 1
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
-            threadManager.add(threadId, workersAux, queueIn++, queueOut++);
+            dedicatedThreadIds.emplace(threadId);
+            threadManager.add(
+                threadId, workersAux, queueIn++, queueOut++,
+                (keepLatestFrame ? QueueOverflowPolicy::KeepLatest : QueueOverflowPolicy::Block));
             // Increase thread
             threadIdPP(threadId, multiThreadEnabled);
 
@@ -1049,9 +1646,47 @@ namespace op
             {
                 if (multiThreadEnabled)
                 {
-                    for (auto& wPose : poseExtractorsWs)
+                    // Each camera view of the 3-D frame sets on a fixed GPU
+                    const auto viewGpuAffinity = wrapperStructExtra.viewGpuAffinity
+                        && wrapperStructExtra.reconstruct3d && poseExtractorsWs.size() > 1u;
+                    if (viewGpuAffinity)
+                        opLog("Camera view i processed by GPU thread i % " + std::to_string(poseExtractorsWs.size())
+                              + " (`--3d_gpu_affinity`).", Priority::High);
+                    // Capacity-aware dispatch of the frames among the GPUs (and the spillover workers, which are
+                    // the last pose threads)
+                    const auto gpuDispatcher = (
+                        (wrapperStructExtra.gpuDispatch || spilloverWorkers > 0) && poseExtractorsWs.size() > 1u
+                        && !viewGpuAffinity
+                        ? std::make_shared<GpuDispatcher>(
+                            (int)poseExtractorsWs.size() - spilloverWorkers, spilloverWorkers,
+                            (unsigned long long)fastMax(0, wrapperStructExtra.spilloverQueueSize))
+                        : nullptr);
+                    for (auto i = 0u ; i < poseExtractorsWs.size() ; i++)
                     {
+                        auto& wPose = poseExtractorsWs[i];
+                        if (gpuDispatcher != nullptr)
+                        {
+                            wPose.insert(wPose.begin(), std::make_shared<WGpuDispatch<TDatumsSP>>(
+                                gpuDispatcher, (int)i, true));
+                            wPose.emplace_back(std::make_shared<WGpuDispatch<TDatumsSP>>(
+                                gpuDispatcher, (int)i, false));
+                        }
+                        if (viewGpuAffinity)
+                            wPose.insert(wPose.begin(), std::make_shared<WViewGpuAffinity<TDatumsSP>>(
+                                (int)i, (int)poseExtractorsWs.size()));
+                        // The frames leaving the GPU threads give their credits back to the producer
+                        if (frameCredits != nullptr)
+                            wPose.emplace_back(std::make_shared<WFrameCredits<TDatumsSP>>());
                         opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                        dedicatedThreadIds.emplace(threadId);
+                        // Each GPU thread on the NUMA node of its GPU
+                        const auto numaNode = (wrapperStructExtra.gpuNumaAffinity && gpuMode != GpuMode::NoGpu
+                                               && (int)i < numberGpuThreads
+                            ? getGpuNumaNode(gpuNumberStart + (int)i) : -1);
+                        const ThreadAffinity threadAffinity{
+                            {}, numaNode, wrapperStructExtra.gpuThreadPriority, cpuWorkerThreads};
+                        if (!threadAffinity.isDefault())
+                            threadManager.setThreadAffinity(threadId, threadAffinity);
                         threadManager.add(threadId, wPose, queueIn, queueOut);
                         threadIdPP(threadId, multiThreadEnabled);
                     }
@@ -1060,11 +1695,30 @@ namespace op
                     // Sort frames - Required own thread
                     if (poseExtractorsWs.size() > 1u)
                     {
-                        const auto wQueueOrderer = std::make_shared<WQueueOrderer<TDatumsSP>>();
+                        // If frames are dropped, ids have gaps, so the orderer must not wait for many frames
+                        const auto wQueueOrderer = std::make_shared<WQueueOrderer<TDatumsSP>>(
+                            (keepLatestFrame ? 2u*(unsigned int)poseExtractorsWs.size() : 64u),
+                            wrapperStructExtra.reorderWindowMs, keepLatestFrame);
                         opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                         threadManager.add(threadId, wQueueOrderer, queueIn++, queueOut++);
                         threadIdPP(threadId, multiThreadEnabled);
                     }
+                    // Face and hand on their own GPU thread (pipeline-parallel), so they process a frame while the
+                    // body GPU threads process the next ones
+                    if (!faceHandExtractorsWs.empty())
+                    {
+                        opLog("Face and hand keypoint detection on their own GPU thread (GPU "
+                              + std::to_string(wrapperStructExtra.faceHandGpu) + ").", Priority::High);
+                        dedicatedThreadIds.emplace(threadId);
+                        const auto numaNode = (wrapperStructExtra.gpuNumaAffinity
+                            ? getGpuNumaNode(wrapperStructExtra.faceHandGpu) : -1);
+                        const ThreadAffinity threadAffinity{
+                            {}, numaNode, wrapperStructExtra.gpuThreadPriority, cpuWorkerThreads};
+                        if (!threadAffinity.isDefault())
+                            threadManager.setThreadAffinity(threadId, threadAffinity);
+                        threadManager.add(threadId, faceHandExtractorsWs.at(0), queueIn++, queueOut++);
+                        threadIdPP(threadId, multiThreadEnabled);
+                    }
                 }
                 else
                 {
@@ -1201,6 +1855,7 @@ namespace op
             {
                 // Thread Y+1, queues Q+1 -> Q+2
                 opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                dedicatedThreadIds.emplace(threadId);
                 threadManager.add(threadId, guiW, queueIn++, queueOut++);
                 // Saving 3D output
                 if (videoSaver3DW != nullptr)
@@ -1215,6 +1870,39 @@ namespace op
                 threadManager.add(threadId, wFpsMax, queueIn++, queueOut++);
                 threadIdPP(threadId, multiThreadEnabled);
             }
+            // GPU memory budget: Queue sizes for the frames decoded into GPU memory (NVDEC and FLIR GPU debayering),
+            // so the frames waiting in the queues also fit into the budget left by the batch size
+            if (wrapperStructPose.gpuMemoryBudget != 0 && oPProducer && producerSize.area() > 0
+                && (wrapperStructInput.nvDecode || wrapperStructInput.flirBayerGpu))
+            {
+                // NV12 (1.5 bytes per pixel) or raw Bayer (1 byte per pixel) frames
+                const auto frameBytes = (unsigned long long)producerSize.area()
+                                      * (wrapperStructInput.nvDecode ? 3ull : 2ull) / 2ull;
+                const auto numberQueues = fastMax(1ull, queueIn);
+                const auto maxSizeQueues = (long long)(gpuMemoryRemainingBytes / (frameBytes * numberQueues));
+                // Current size (-1 = automatic, about as many elements as the threads connected to each queue)
+                const auto defaultMaxSizeQueues = threadManager.getDefaultMaxSizeQueues();
+                const auto currentMaxSizeQueues = (defaultMaxSizeQueues > 0
+                                                   ? defaultMaxSizeQueues : (long long)numberGpuThreads + 1ll);
+                if (maxSizeQueues < currentMaxSizeQueues)
+                {
+                    threadManager.setDefaultMaxSizeQueues(fastMax(1ll, maxSizeQueues));
+                    opLog("The queue sizes have been limited to " + std::to_string(fastMax(1ll, maxSizeQueues))
+                          + " frames each to fit the GPU frames into the GPU memory budget.", Priority::High);
+                }
+            }
+            // Work-stealing thread pool for the remaining threads
+            if (multiThreadEnabled && wrapperStructExtra.threadPool != 0)
+                threadManager.setThreadPool(wrapperStructExtra.threadPool, dedicatedThreadIds);
+            // Auto-configuration of the queue sizes (a single thread does not use them)
+            if (wrapperStructExtra.autoConfigure > 0)
+            {
+                if (multiThreadEnabled)
+                    threadManager.setAutoConfiguration((unsigned long long)wrapperStructExtra.autoConfigure);
+                else
+                    opLog("The auto-configuration (`--auto_configure`) only applies if multi-threading is enabled"
+                          " (e.g., without `--disable_multi_thread`).", Priority::High);
+            }
         }
         catch (const std::exception& e)
         {
@@ -0,0 +1,280 @@
+#ifndef OPENPOSE_WRAPPER_WRAPPER_BATCH_SUBMITTER_HPP
+#define OPENPOSE_WRAPPER_WRAPPER_BATCH_SUBMITTER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * WrapperBatchSubmitter is the asynchronous batch submission of WrapperT::emplaceBatch(). A feeder thread emplaces
+     * the frames into the (asynchronous) WrapperT as soon as its input queue has room for them, so its queues (and
+     * the network batches of WrapperStructPose::batchSize) are always full, while a collector thread pops the
+     * processed frames and completes their futures (and callbacks), whatever the order they come out of OpenPose.
+     * Each frame is identified by its first TDatum, so the same TDatum cannot be submitted twice at the same time.
+     * It finishes once WrapperT is stopped, failing the futures of the frames not processed yet.
+     */
+    template<typename TDatumsSP>
+    class WrapperBatchSubmitter
+    {
+    public:
+        typedef std::function<void(const TDatumsSP&)> Callback;
+
+        explicit WrapperBatchSubmitter(
+            const std::function<bool(TDatumsSP&)>& waitAndEmplace, const std::function<bool(TDatumsSP&)>& waitAndPop);
+
+        virtual ~WrapperBatchSubmitter();
+
+        /**
+         * It queues the frames and returns immediately (it never blocks).
+         * @param tDatumsBatch Independent frames (each one a TDatumsSP, as for WrapperT::waitAndEmplace()).
+         * @param callback Optional function called (on the collector thread) with each processed frame, before its
+         * future becomes ready.
+         * @return 1 future per frame, with the processed frame or an exception if OpenPose was stopped first.
+         */
+        std::vector<std::future<TDatumsSP>> submit(
+            const std::vector<TDatumsSP>& tDatumsBatch, const Callback& callback = nullptr);
+
+        /**
+         * Whether it still accepts frames (i.e., WrapperT was not stopped).
+         */
+        bool isRunning() const;
+
+    private:
+        struct Frame
+        {
+            TDatumsSP tDatums;
+            std::promise<TDatumsSP> promise;
+            Callback callback;
+        };
+
+        const std::function<bool(TDatumsSP&)> fWaitAndEmplace;
+        const std::function<bool(TDatumsSP&)> fWaitAndPop;
+        mutable std::mutex mMutex;
+        std::condition_variable mConditionVariable;
+        bool mRunning;
+        bool mCollecting;
+        std::deque<std::shared_ptr<Frame>> mPending;
+        // Frames inside OpenPose, by their first TDatum
+        std::unordered_map<const void*, std::shared_ptr<Frame>> mInFlight;
+        std::thread mFeederThread;
+        std::thread mCollectorThread;
+
+        void feed();
+
+        void collect();
+
+        void finish(const std::string& reason);
+
+        DELETE_COPY(WrapperBatchSubmitter);
+    };
+}
+
+
+
+
+
+// Implementation
+namespace op
+{
+    template<typename TDatumsSP>
+    WrapperBatchSubmitter<TDatumsSP>::WrapperBatchSubmitter(
+        const std::function<bool(TDatumsSP&)>& waitAndEmplace, const std::function<bool(TDatumsSP&)>& waitAndPop) :
+        fWaitAndEmplace{waitAndEmplace},
+        fWaitAndPop{waitAndPop},
+        mRunning{true},
+        mCollecting{true}
+    {
+        try
+        {
+            mFeederThread = std::thread{&WrapperBatchSubmitter::feed, this};
+            mCollectorThread = std::thread{&WrapperBatchSubmitter::collect, this};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatumsSP>
+    WrapperBatchSubmitter<TDatumsSP>::~WrapperBatchSubmitter()
+    {
+        try
+        {
+            // WrapperT must be already stopped, so waitAndEmplace and waitAndPop do not block anymore
+            finish("WrapperBatchSubmitter destroyed.");
+            if (mFeederThread.joinable())
+                mFeederThread.join();
+            if (mCollectorThread.joinable())
+                mCollectorThread.join();
+            // Frames lost inside OpenPose (e.g., if the collector could not be started)
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                mCollecting = false;
+            }
+            finish("WrapperBatchSubmitter destroyed.");
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatumsSP>
+    std::vector<std::future<TDatumsSP>> WrapperBatchSubmitter<TDatumsSP>::submit(
+        const std::vector<TDatumsSP>& tDatumsBatch, const Callback& callback)
+    {
+        try
+        {
+            std::vector<std::future<TDatumsSP>> futures;
+            futures.reserve(tDatumsBatch.size());
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                if (!mRunning)
+                    error("OpenPose was stopped, no more frames can be submitted.", __LINE__, __FUNCTION__, __FILE__);
+                for (const auto& tDatums : tDatumsBatch)
+                {
+                    if (tDatums == nullptr || tDatums->empty())
+                        error("Empty frame submitted.", __LINE__, __FUNCTION__, __FILE__);
+                    auto frame = std::make_shared<Frame>();
+                    frame->tDatums = tDatums;
+                    frame->callback = callback;
+                    futures.emplace_back(frame->promise.get_future());
+                    mPending.emplace_back(frame);
+                }
+            }
+            mConditionVariable.notify_all();
+            return futures;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    template<typename TDatumsSP>
+    bool WrapperBatchSubmitter<TDatumsSP>::isRunning() const
+    {
+        const std::lock_guard<std::mutex> lock{mMutex};
+        return mRunning;
+    }
+
+    template<typename TDatumsSP>
+    void WrapperBatchSubmitter<TDatumsSP>::feed()
+    {
+        try
+        {
+            while (true)
+            {
+                std::shared_ptr<Frame> frame;
+                {
+                    std::unique_lock<std::mutex> lock{mMutex};
+                    mConditionVariable.wait(lock, [this]{ return !mRunning || !mPending.empty(); });
+                    if (!mRunning)
+                        break;
+                    frame = mPending.front();
+                    mPending.pop_front();
+                    // Registered before emplacing it, so the collector always finds it
+                    mInFlight[frame->tDatums->at(0).get()] = frame;
+                }
+                // It blocks while the input queue is full (so OpenPose never starves nor overflows)
+                auto tDatums = frame->tDatums;
+                if (!fWaitAndEmplace(tDatums))
+                    break;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            opLog("WrapperBatchSubmitter stopped feeding OpenPose due to an error: " + std::string{e.what()},
+                  Priority::High, __LINE__, __FUNCTION__, __FILE__);
+        }
+        finish("OpenPose was stopped before processing this frame.");
+    }
+
+    template<typename TDatumsSP>
+    void WrapperBatchSubmitter<TDatumsSP>::collect()
+    {
+        try
+        {
+            TDatumsSP tDatums;
+            while (fWaitAndPop(tDatums))
+            {
+                if (tDatums == nullptr || tDatums->empty())
+                    continue;
+                std::shared_ptr<Frame> frame;
+                {
+                    const std::lock_guard<std::mutex> lock{mMutex};
+                    const auto frameIterator = mInFlight.find(tDatums->at(0).get());
+                    if (frameIterator != mInFlight.end())
+                    {
+                        frame = frameIterator->second;
+                        mInFlight.erase(frameIterator);
+                    }
+                }
+                // Frames not submitted by it (e.g., emplaced with waitAndEmplace()) are discarded
+                if (frame == nullptr)
+                    continue;
+                if (frame->callback)
+                {
+                    try
+                    {
+                        frame->callback(tDatums);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        opLog("Exception in the WrapperBatchSubmitter callback: " + std::string{e.what()},
+                              Priority::High, __LINE__, __FUNCTION__, __FILE__);
+                    }
+                }
+                frame->promise.set_value(tDatums);
+                tDatums.reset();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            opLog("WrapperBatchSubmitter stopped collecting OpenPose results due to an error: "
+                  + std::string{e.what()}, Priority::High, __LINE__, __FUNCTION__, __FILE__);
+        }
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mCollecting = false;
+        }
+        finish("OpenPose was stopped before processing this frame.");
+    }
+
+    template<typename TDatumsSP>
+    void WrapperBatchSubmitter<TDatumsSP>::finish(const std::string& reason)
+    {
+        try
+        {
+            std::deque<std::shared_ptr<Frame>> pending;
+            std::unordered_map<const void*, std::shared_ptr<Frame>> inFlight;
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                mRunning = false;
+                std::swap(pending, mPending);
+                // The frames inside OpenPose might still come out (until the collector finishes)
+                if (!mCollecting)
+                    std::swap(inFlight, mInFlight);
+            }
+            mConditionVariable.notify_all();
+            for (auto& frame : pending)
+                frame->promise.set_exception(std::make_exception_ptr(std::runtime_error{reason}));
+            for (auto& frame : inFlight)
+                frame.second->promise.set_exception(std::make_exception_ptr(std::runtime_error{reason}));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
+
+#endif // OPENPOSE_WRAPPER_WRAPPER_BATCH_SUBMITTER_HPP
@@ -2,6 +2,7 @@
 #define OPENPOSE_WRAPPER_WRAPPER_STRUCT_EXTRA_HPP
 
 #include <openpose/core/common.hpp>
+#include <openpose/thread/enumClasses.hpp>
 
 namespace op
 {
@@ -46,6 +47,135 @@ namespace op
          */
         int ikThreads;
 
+        /**
+         * Number of threads of the shared work-stealing ThreadPool (see ThreadManager::setThreadPool()) that runs
+         * the CPU stages (e.g., sorting, rendering on CPU, saving, and user post-processing), so they can use any idle
+         * core rather than one thread each. The producer, the GPU pose extractors and the GUI keep their own
+         * threads. By default (0), it is disabled, and -1 uses as many threads as CPU cores.
+         */
+        int threadPool;
+
+        /**
+         * Whether to bind each GPU pose extractor thread (CPUs and host memory) to the NUMA node its GPU is attached
+         * to, so it does not migrate to a socket far from the GPU PCIe root. It does nothing on single-socket
+         * machines.
+         */
+        bool gpuNumaAffinity;
+
+        /**
+         * OS scheduling priority of the GPU pose extractor threads.
+         */
+        ThreadPriority gpuThreadPriority;
+
+        /**
+         * Number of compute threads (OpenMP and MKL, see ThreadAffinity::computeThreads) of each CPU pose extractor
+         * worker, only used in CPU mode (in which WrapperStructPose::gpuNumber sets the number of workers). If -1
+         * (default), the CPU cores are split evenly among the workers. If 0, the library default, i.e., each worker
+         * would use all the cores.
+         */
+        int cpuWorkerThreads;
+
+        /**
+         * Multi-GPU (or multi-CPU worker) only. Whether each frame goes to the GPU that would finish it first, given
+         * the average frame time of each GPU and the frames inside it (see GpuDispatcher), rather than to the first
+         * idle GPU. It only changes the dispatch with GPUs of different speeds.
+         */
+        bool gpuDispatch;
+
+        /**
+         * Multi-GPU (or multi-CPU worker) only. Maximum time (in milliseconds) that WQueueOrderer holds the frames
+         * already processed while waiting for an earlier one. After it, the missing frame is skipped, and if it
+         * arrives later, it is dropped with real-time live sources (see WrapperStructInput::realTimeProcessing) or
+         * forwarded out of order otherwise. If <= 0 (default), the frames wait until the missing one arrives or the
+         * reordering buffer is full.
+         */
+        double reorderWindowMs;
+
+        /**
+         * Only if tracking > 0. Whether the frames between the body keypoint detections get their keypoints from a
+         * per-person constant-velocity Kalman filter of each keypoint (see KeypointExtrapolator), rather than from
+         * the LK tracking of the images (PersonTracker). It is much cheaper (e.g., for high frame rate cameras), and
+         * it does not use the images.
+         */
+        bool trackingExtrapolation;
+
+        /**
+         * Only if reconstruct3d. Whether the people of each view are associated across views (see PoseAssociation),
+         * so all of them are reconstructed, rather than only the first one of each view.
+         */
+        bool multiPerson3d;
+
+        /**
+         * Number of frames of the auto-configuration of the queue sizes (see ThreadManager::setAutoConfiguration()),
+         * which also logs the probed hardware. 0 (default) disables it.
+         */
+        int autoConfigure;
+
+        /**
+         * Resolution (width x height) of the aligned crop of each person produced on the GPU after the pose estimation
+         * (see PersonCropExtractor and Datum::personCropsGpu). Any non-positive value (default) disables it.
+         */
+        Point<int> personCropSize;
+
+        /**
+         * Only if personCropSize is enabled. Enlargement factor of the keypoint bounding box of each crop.
+         */
+        float personCropScale;
+
+        /**
+         * Only if personCropSize is enabled. Whether each crop is rotated so the torso of its person is vertical.
+         */
+        bool personCropAlign;
+
+        /**
+         * Only if personCropSize is enabled. Whether the crops are also copied into pinned host memory
+         * (Datum::personCrops).
+         */
+        bool personCropDownload;
+
+        /**
+         * Pipeline-parallel multi-GPU placement. If 0 or positive, the face and hand detectors and extractors run on
+         * their own thread on this GPU (after the body GPU threads and their WQueueOrderer), rather than on each body
+         * GPU thread. The rendering is done on CPU in that case (the GPU renderers share the render target of their
+         * body GPU thread). -1 (default) disables it.
+         */
+        int faceHandGpu;
+
+        /**
+         * GPU mode only. Number of extra CPU body pose workers (with the OpenVINO model spilloverModelPath), which
+         * only take a frame when more than spilloverQueueSize frames are waiting for the GPU workers (see
+         * GpuDispatcher). 0 (default) disables them.
+         */
+        int spilloverWorkers;
+
+        /**
+         * Only if spilloverWorkers > 0. OpenVINO model (relative to the model folder) of the spillover workers.
+         */
+        String spilloverModelPath;
+
+        /**
+         * Only if spilloverWorkers > 0. Number of waiting frames beyond which the spillover workers take them.
+         */
+        int spilloverQueueSize;
+
+        /**
+         * Only if reconstruct3d. Whether each 3-D keypoint starts from its previous frame reconstruction (see
+         * PoseTriangulation temporal), rather than being triangulated from scratch on each frame.
+         */
+        bool temporal3d;
+
+        /**
+         * Only if reconstruct3d with several GPUs. Whether each camera view goes to a fixed GPU thread (view subId to
+         * GPU subId % number of GPUs, see WViewGpuAffinity), rather than to the next available one.
+         */
+        bool viewGpuAffinity;
+
+        /**
+         * Queue type between the workers (see QueueType). QueueType::RingBuffer makes WrapperT use RingBufferQueue,
+         * without changing the WrapperT type.
+         */
+        QueueType queueType;
+
         /**
          * Constructor of the struct.
          * It has the recommended and default values we recommend for each element of the struct.
@@ -53,7 +183,15 @@ namespace op
          */
         WrapperStructExtra(
             const bool reconstruct3d = false, const int minViews3d = -1, const bool identification = false,
-            const int tracking = -1, const int ikThreads = 0);
+            const int tracking = -1, const int ikThreads = 0, const int threadPool = 0,
+            const bool gpuNumaAffinity = true, const ThreadPriority gpuThreadPriority = ThreadPriority::Default,
+            const int cpuWorkerThreads = -1, const bool gpuDispatch = true, const double reorderWindowMs = 0.,
+            const bool trackingExtrapolation = false, const bool multiPerson3d = false, const int autoConfigure = 0,
+            const Point<int>& personCropSize = Point<int>{0,0}, const float personCropScale = 1.2f,
+            const bool personCropAlign = false, const bool personCropDownload = false, const int faceHandGpu = -1,
+            const int spilloverWorkers = 0, const String& spilloverModelPath = "", const int spilloverQueueSize = 2,
+            const bool temporal3d = false, const bool viewGpuAffinity = false,
+            const QueueType queueType = QueueType::Mutex);
     };
 }
 
@@ -61,6 +61,53 @@ namespace op
          */
         float renderThreshold;
 
+        /**
+         * CNN face detector (Detector::Net) input size. Both width and height must be divisible by 32, and at most
+         * one of them can be -1 (computed from the input aspect ratio).
+         */
+        Point<int> detectorNetInputSize;
+
+        /**
+         * Number of scales of the CNN face detector (Detector::Net). They are processed as a single batch.
+         */
+        int detectorScaleNumber;
+
+        /**
+         * If greater than 0, the face keypoints of each person (it requires the person IDs of Datum::poseIds, i.e.,
+         * `--identification` or `--tracking`) are reused for up to this number of consecutive frames while its
+         * rectangle barely moves and the last computed keypoints are confident (see KeypointRoiCache), skipping the
+         * face network for that person. 0 (default) disables it. Not compatible with the face heat maps.
+         */
+        int roiCacheMaxSkip;
+
+        /**
+         * Whether to crop each face at the smallest of 128, 256, and netInputSize that is not smaller than its
+         * rectangle (see getRoiCropSide()), rather than always at netInputSize. Not compatible with the face heat
+         * maps.
+         */
+        bool adaptiveCropSize;
+
+        /**
+         * If 0 or positive and the body model is BODY_135, the face keypoints of the people whose BODY_135 face
+         * parts are confident (average score not lower than this value) are filled directly from them (see
+         * Body135FaceHand), skipping the face network for those people. Negative (default) disables it.
+         */
+        float fromBodyThreshold;
+
+        /**
+         * Whether the face network is enabled when the Wrapper starts. If enable is true but this is false, the face
+         * network is only loaded the first time that it is enabled with Wrapper::reconfigure(), so a face detector
+         * that is rarely needed does not use GPU memory until then.
+         */
+        bool startEnabled;
+
+        /**
+         * Lazy loading of the face network (see FaceExtractorNet::setLazyLoading()). If 0 or positive, it is only
+         * loaded on the first frame with any face, and if positive, it is also released after lazyIdleSeconds
+         * seconds without any face. Negative (default) loads it at startup.
+         */
+        double lazyIdleSeconds;
+
         /**
          * Constructor of the struct.
          * It has the recommended and default values we recommend for each element of the struct.
@@ -70,7 +117,10 @@ namespace op
             const bool enable = false, const Detector detector = Detector::Body,
             const Point<int>& netInputSize = Point<int>{368, 368}, const RenderMode renderMode = RenderMode::Auto,
             const float alphaKeypoint = FACE_DEFAULT_ALPHA_KEYPOINT,
-            const float alphaHeatMap = FACE_DEFAULT_ALPHA_HEAT_MAP, const float renderThreshold = 0.4f);
+            const float alphaHeatMap = FACE_DEFAULT_ALPHA_HEAT_MAP, const float renderThreshold = 0.4f,
+            const Point<int>& detectorNetInputSize = Point<int>{-1, 256}, const int detectorScaleNumber = 1,
+            const int roiCacheMaxSkip = 0, const bool adaptiveCropSize = false, const float fromBodyThreshold = -1.f,
+            const bool startEnabled = true, const double lazyIdleSeconds = -1.);
     };
 }
 
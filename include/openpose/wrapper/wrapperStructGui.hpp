@@ -34,6 +34,25 @@ namespace op
          */
         bool fullScreen;
 
+        /**
+         * Whether to synchronize the display with the monitor refresh rate (only if OpenPose was compiled with
+         * WITH_OPENCV_WITH_OPENGL).
+         */
+        bool vSync;
+
+        /**
+         * Whether to skip the display of a frame if newer frames are already waiting for the GUI (so displaying never
+         * slows down the processing). The frames are not dropped, they are still returned to the user.
+         */
+        bool skipStaleFrames;
+
+        /**
+         * Whether the 2-D GUI displays the guiVerbose information as an overlay composited over each frame (only
+         * drawn again when it changes), rather than adding it into the frame itself (so it is neither saved on disk
+         * nor returned to the user).
+         */
+        bool overlay;
+
         /**
          * Constructor of the struct.
          * It has the recommended and default values we recommend for each element of the struct.
@@ -41,7 +60,8 @@ namespace op
          */
         WrapperStructGui(
             const DisplayMode displayMode = DisplayMode::NoDisplay, const bool guiVerbose = false,
-            const bool fullScreen = false);
+            const bool fullScreen = false, const bool vSync = false, const bool skipStaleFrames = false,
+            const bool overlay = false);
     };
 }
 
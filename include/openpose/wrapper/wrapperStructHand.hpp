@@ -80,6 +80,48 @@ namespace op
          */
         float renderThreshold;
 
+        /**
+         * Whether to run the hand and face keypoint extractors at the same time (see WFaceAndHandExtractorNet),
+         * rather than one after the other. Only used if the face is also enabled.
+         */
+        bool concurrentWithFace;
+
+        /**
+         * If greater than 0, the hand keypoints of each person (it requires the person IDs of Datum::poseIds, i.e.,
+         * `--identification` or `--tracking`) are reused for up to this number of consecutive frames while its
+         * rectangle barely moves and the last computed keypoints are confident (see KeypointRoiCache), skipping the
+         * hand network for that person. 0 (default) disables it. Not compatible with the hand heat maps.
+         */
+        int roiCacheMaxSkip;
+
+        /**
+         * Whether to crop each hand at the smallest of 128, 256, and netInputSize that is not smaller than its
+         * rectangle (see getRoiCropSide()), rather than always at netInputSize. Not compatible with the hand heat
+         * maps.
+         */
+        bool adaptiveCropSize;
+
+        /**
+         * If 0 or positive and the body model is BODY_135, the hand keypoints of the people whose BODY_135 hand
+         * parts are confident (average score not lower than this value) are filled directly from them (see
+         * Body135FaceHand), skipping the hand network for those people. Negative (default) disables it.
+         */
+        float fromBodyThreshold;
+
+        /**
+         * Whether the hand network is enabled when the Wrapper starts. If enable is true but this is false, the hand
+         * network is only loaded the first time that it is enabled with Wrapper::reconfigure(), so a hand detector
+         * that is rarely needed does not use GPU memory until then.
+         */
+        bool startEnabled;
+
+        /**
+         * Lazy loading of the hand network (see HandExtractorNet::setLazyLoading()). If 0 or positive, it is only
+         * loaded on the first frame with any hand, and if positive, it is also released after lazyIdleSeconds
+         * seconds without any hand. Negative (default) loads it at startup.
+         */
+        double lazyIdleSeconds;
+
         /**
          * Constructor of the struct.
          * It has the recommended and default values we recommend for each element of the struct.
@@ -90,7 +132,10 @@ namespace op
             const Point<int>& netInputSize = Point<int>{368, 368}, const int scalesNumber = 1,
             const float scaleRange = 0.4f, const RenderMode renderMode = RenderMode::Auto,
             const float alphaKeypoint = HAND_DEFAULT_ALPHA_KEYPOINT,
-            const float alphaHeatMap = HAND_DEFAULT_ALPHA_HEAT_MAP, const float renderThreshold = 0.2f);
+            const float alphaHeatMap = HAND_DEFAULT_ALPHA_HEAT_MAP, const float renderThreshold = 0.2f,
+            const bool concurrentWithFace = false, const int roiCacheMaxSkip = 0, const bool adaptiveCropSize = false,
+            const float fromBodyThreshold = -1.f, const bool startEnabled = true,
+            const double lazyIdleSeconds = -1.);
     };
 }
 
@@ -91,6 +91,132 @@ namespace op
          */
         int numberViews;
 
+        /**
+         * Whether to decode the video (ProducerType::Video only) with NVDEC (see NvDecReader).
+         * The frames are kept in GPU memory and the network input is created from them on the GPU. They are copied
+         * into CPU memory (Datum::cvInputData) only if some enabled feature requires it.
+         */
+        bool nvDecode;
+
+        /**
+         * Number of threads decoding the images in parallel (ProducerType::ImageDirectory only, see
+         * ImageDirectoryReader), while they are still processed in their original order.
+         * 0 to load each image synchronously on the producer thread.
+         */
+        int imageDecodingThreads;
+
+        /**
+         * Maximum number of released Datums kept by the DatumPool of the producer, so they are recycled for the next
+         * frames rather than allocated again. 0 to disable it (a new Datum is allocated for each frame).
+         * Only used if TDatum is Datum (custom TDatum classes must create their own DatumPool with their own reset
+         * function).
+         */
+        int datumPoolSize;
+
+        /**
+         * Whether to upload the raw Bayer images of the FLIR cameras (ProducerType::FlirCamera only) into the GPU and
+         * debayer them there (see SpinnakerWrapper), fused with the network input resize. As with nvDecode, they are
+         * copied into CPU memory (Datum::cvInputData) only if some enabled feature requires it.
+         */
+        bool flirBayerGpu;
+
+        /**
+         * Maximum timestamp difference (in milliseconds) among the images of the different FLIR cameras
+         * (ProducerType::FlirCamera only) assembled into the same frame set. Each camera is read by its own thread,
+         * and the images without a counterpart in the other cameras are dropped.
+         */
+        double flirSyncToleranceMs;
+
+        /**
+         * Alternative to undistortImage for the 3-D reconstruction. Whether to read the camera parameters (with
+         * cameraParameterPath) but, rather than undistorting the images, only undistort the 2-D keypoints right
+         * before their triangulation (see Datum::cameraDistortion and PoseTriangulation). It is not compatible with
+         * undistortImage.
+         */
+        bool undistortKeypoints;
+
+        /**
+         * If not empty, path of the file where the input frames (as they leave the producer), their arrival times,
+         * frame numbers, and camera parameters are recorded (see InputRecorder), so they can be replayed later on with
+         * ProducerType::Replay (see ReplayReader).
+         * It requires the frames in CPU memory (i.e., the frames of nvDecode and flirBayerGpu are downloaded).
+         */
+        String inputRecordPath;
+
+        /**
+         * Image format of the frames of inputRecordPath (any format supported by cv::imencode, e.g., "jpg" or "png").
+         */
+        String inputRecordFormat;
+
+        /**
+         * Number of decoders decoding consecutive segments of the video in parallel (ProducerType::Video only, see
+         * VideoReader), while its frames are still returned in order. 0 to decode it with a single cv::VideoCapture.
+         */
+        int videoDecoders;
+
+        /**
+         * Number of frames of each segment of videoDecoders. It should be a multiple of the keyframe interval of the
+         * video.
+         */
+        int videoSegmentFrames;
+
+        /**
+         * Whether to list the directory (ProducerType::ImageDirectory only, see ImageDirectoryReader) in a background
+         * thread while its first images are already processed, rather than listing and sorting all of them first.
+         * The images are then processed in file system order (i.e., unsorted).
+         */
+        bool imageDirectoryStream;
+
+        /**
+         * Static region of interest of each view (see Datum::inputRoi and Producer::setInputRois()), with the format
+         * of flagsToInputRois() (e.g., "0,300 1920,1080"). If empty, the ones of the camera parameter files (if
+         * any).
+         */
+        String inputRoi;
+
+        /**
+         * Priority class of each multiplexed source (see MultiSourceProducer::setSourceSchedule()), comma-separated
+         * (e.g., "1,0"). Empty for the same class in all of them.
+         */
+        String sourcePriority;
+
+        /**
+         * Maximum latency (in milliseconds) of the frames of each multiplexed source (see
+         * MultiSourceProducer::setSourceSchedule()), comma-separated (e.g., "100,0"). Empty or 0 for no limit.
+         */
+        String sourceMaxLatencyMs;
+
+        /**
+         * ProducerType::Video, ImageDirectory and Replay only. If 0 or positive, the producer takes a FrameCredits
+         * credit per frame, which the GPU threads grant back (see WFrameCredits). There are as many credits as
+         * frames the GPU threads process at the same time (number of GPUs x batch size), plus decodeAhead. -1
+         * (default) disables it.
+         */
+        int decodeAhead;
+
+        /**
+         * ProducerType::Webcam only (Linux). Whether to read the webcam directly through V4L2 (see V4l2Reader)
+         * rather than OpenCV.
+         */
+        bool cameraV4l2;
+
+        /**
+         * ProducerType::Webcam with cameraV4l2 only. Desired webcam frame rate, 0 for the driver default.
+         */
+        int cameraV4l2Fps;
+
+        /**
+         * `[host:]port` to receive the frame sets of the DatumSender of another OpenPose process (see
+         * WrapperStructOutput::datumSend). If not empty, they replace the producer (producerType is ignored).
+         */
+        String datumReceive;
+
+        /**
+         * datumReceive only. Maximum number of received frame sets not finished yet by this pipeline (the sender
+         * waits once they are reached).
+         */
+        int datumReceiveWindow;
+
         /**
          * Constructor of the struct.
          * It has the recommended and default values we recommend for each element of the struct.
@@ -103,7 +229,14 @@ namespace op
             const bool realTimeProcessing = false, const bool frameFlip = false, const int frameRotate = 0,
             const bool framesRepeat = false, const Point<int>& cameraResolution = Point<int>{-1,-1},
             const String& cameraParameterPath = "models/cameraParameters/",
-            const bool undistortImage = false, const int numberViews = -1);
+            const bool undistortImage = false, const int numberViews = -1, const bool nvDecode = false,
+            const int imageDecodingThreads = 0, const int datumPoolSize = 0, const bool flirBayerGpu = false,
+            const double flirSyncToleranceMs = 5., const bool undistortKeypoints = false,
+            const String& inputRecordPath = "", const String& inputRecordFormat = "jpg", const int videoDecoders = 0,
+            const int videoSegmentFrames = 250, const bool imageDirectoryStream = false,
+            const String& inputRoi = "", const String& sourcePriority = "", const String& sourceMaxLatencyMs = "",
+            const int decodeAhead = -1, const bool cameraV4l2 = false, const int cameraV4l2Fps = 0,
+            const String& datumReceive = "", const int datumReceiveWindow = 8);
     };
 }
 
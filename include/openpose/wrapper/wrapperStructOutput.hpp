@@ -142,6 +142,131 @@ namespace op
          */
         String udpPort;
 
+        /**
+         * TCP port of the embedded HTTP server exposing the OpenPose Metrics (per-worker processing time, queue
+         * waiting time and queue size histograms) in the OpenMetrics (Prometheus) format on `/metrics`.
+         * Setting it also enables the Metrics recording (Metrics::setEnabled()).
+         * If it is negative (default), it is disabled.
+         */
+        int metricsPort;
+
+        /**
+         * Output file path (e.g., `trace.json`) of the pipeline timeline (each worker call per Datum id, and the time
+         * each thread waited for or was blocked by each queue) in the Chrome Trace JSON format, viewable with
+         * chrome://tracing or https://ui.perfetto.dev. Setting it enables the Tracer and the file is saved when
+         * OpenPose stops.
+         * If it is empty (default), it is disabled.
+         */
+        String traceFile;
+
+        /**
+         * Output file path (e.g., `keypoints.opbin`) of the binary keypoint file (see KeypointBinarySaver), with the
+         * body/face/hand keypoints and person ids of all the frames.
+         * If it is empty (default), it is disabled.
+         */
+        String writeBinary;
+
+        /**
+         * Number of background threads encoding and writing the images, heat maps and videos (see ImageSaver and
+         * VideoSaver), keeping the frame order.
+         * If it is -1 (default), the default number of threads (up to 4). If 0, they are written on the output thread.
+         */
+        int writeThreads;
+
+        /**
+         * FFmpeg encoder of the MP4 videos (writeVideo and writeVideo3D finishing in `.mp4`), e.g., `libx264`
+         * (default), or `h264_nvenc` or `hevc_nvenc` for the NVIDIA GPU hardware encoder.
+         */
+        String writeVideoEncoder;
+
+        /**
+         * `host:port` of the UDP receiver of the binary keypoint packets (see KeypointStreamer), or empty to disable
+         * it.
+         */
+        String streamKeypointsUdp;
+
+        /**
+         * Name of the shared memory ring buffer of the binary keypoint packets (see KeypointStreamer and
+         * KeypointStreamReader), or empty to disable it.
+         */
+        String streamKeypointsShm;
+
+        /**
+         * COCO keypoint annotations JSON file (e.g., `person_keypoints_val2017.json`) to directly evaluate the body
+         * results of writeCocoJson (see CocoEvaluator), whose COCO AP/AR are displayed when OpenPose stops.
+         * If it is empty (default), it is disabled.
+         */
+        String writeCocoJsonEval;
+
+        /**
+         * Whether to encode the `jpg` images of writeImages and writeHeatMaps on the GPU with nvJPEG (see ImageSaver
+         * and HeatMapSaver). The rendered images are encoded straight from their GPU render target if the rendering
+         * is on the GPU. It requires OpenPose compiled with `WITH_NVJPEG`.
+         */
+        bool writeJpgGpu;
+
+        /**
+         * URL of the live video stream of the rendered frames (see VideoStreamer), e.g.,
+         * `rtsp://localhost:8554/openpose`, or empty to disable it.
+         */
+        String streamVideo;
+
+        /**
+         * FFmpeg encoder of streamVideo, e.g., `h264_nvenc` (default), `hevc_nvenc`, `h264_vaapi` or `libx264`.
+         */
+        String streamVideoEncoder;
+
+        /**
+         * Quantization step of the 2-D keypoints of the UDP keypoint packets (in pixels), which are then compressed
+         * (see KeypointPacketEncoder). If it is 0 (default), they are sent as raw floats.
+         */
+        float streamKeypointsPrecision;
+
+        /**
+         * Same as streamKeypointsPrecision, but for the 3-D keypoints (in the units of the camera calibration).
+         */
+        float streamKeypointsPrecision3D;
+
+        /**
+         * Interval (in packets) between the keyframes of the compressed UDP keypoint packets.
+         */
+        int streamKeypointsKeyframe;
+
+        /**
+         * Whether to also record the memory allocated and copied by each Worker (see AllocationTracker) into the
+         * Metrics (exported if metricsPort is set).
+         */
+        bool allocationMetrics;
+
+        /**
+         * Whether to keep the GPU render target of each Datum (Datum::outputDataGpu) after it is downloaded into
+         * cvOutputData, so later workers can read the rendered frame on the GPU (e.g., to share it as a graphics
+         * texture, see GraphicsTextureCuda). It only applies to the GPU rendering.
+         */
+        bool keepRenderTargetGpu;
+
+        /**
+         * `host:port` of the DatumReceiver of another OpenPose process (see WrapperStructInput::datumReceive) to send
+         * each frame set to, after all the processing of this one (see DatumSender). Empty to disable it.
+         */
+        String datumSend;
+
+        /**
+         * datumSend only. Datum fields sent.
+         */
+        DatumWireField datumSendFields;
+
+        /**
+         * datumSend only. JPEG quality of the frames sent (1-100), or 0 to send them raw (lossless).
+         */
+        int datumSendJpegQuality;
+
+        /**
+         * Whether to record the per-stage timing of each frame into Datum::timing (see DatumTiming), which is also
+         * saved into its writeJson file.
+         */
+        bool datumTiming;
+
         /**
          * Constructor of the struct.
          * It has the recommended and default values we recommend for each element of the struct.
@@ -157,7 +282,16 @@ namespace op
             const String& writeHeatMaps = "", const String& writeHeatMapsFormat = "png",
             const String& writeVideo3D = "", const String& writeVideoAdam = "",
             const String& writeBvh = "", const String& udpHost = "",
-            const String& udpPort = "8051");
+            const String& udpPort = "8051", const int metricsPort = -1,
+            const String& traceFile = "", const String& writeBinary = "", const int writeThreads = -1,
+            const String& writeVideoEncoder = "libx264", const String& streamKeypointsUdp = "",
+            const String& streamKeypointsShm = "", const String& writeCocoJsonEval = "",
+            const bool writeJpgGpu = false, const String& streamVideo = "",
+            const String& streamVideoEncoder = "h264_nvenc", const float streamKeypointsPrecision = 0.f,
+            const float streamKeypointsPrecision3D = 0.f, const int streamKeypointsKeyframe = 30,
+            const bool allocationMetrics = false, const bool keepRenderTargetGpu = false, const String& datumSend = "",
+            const DatumWireField datumSendFields = DatumWireField::Frame | DatumWireField::Keypoints,
+            const int datumSendJpegQuality = 90, const bool datumTiming = false);
     };
 }
 
@@ -213,6 +213,193 @@ namespace op
          */
         bool enableGoogleLogging;
 
+        /**
+         * Maximum number of frames stacked along the network batch axis and processed with a single network forward
+         * pass by each GPU worker. 1 (default) processes each frame independently. Greater values increase the GPU
+         * utilization (e.g., when processing several streams at once) at the cost of latency and GPU memory.
+         * With several multiplexed sources (MultiSourceProducer) and no source priorities, greater values also group
+         * their frames (1 per source, see MultiSourceProducer::setSourceBatching()) rather than interleaving them.
+         */
+        int batchSize;
+
+        /**
+         * Maximum time (in microseconds) that each GPU worker waits for `batchSize` frames before running a partial
+         * batch. It only applies if batchSize > 1.
+         */
+        long long batchMaxWaitMicroseconds;
+
+        /**
+         * Only applicable if caffeModelPath is an ONNX model (i.e., it uses the TensorRT backend) or an OpenVINO
+         * model (NetOpenVino).
+         * TensorRT precision: 32 (FP32), 16 (FP16, default) or 8 (INT8, it requires a calibration cache).
+         * OpenVINO precision: 32 (FP32), 16 (BF16, if supported by the CPU) or 8 (INT8, it requires a quantized model
+         * or a calibration cache).
+         */
+        int tensorRtPrecision;
+
+        /**
+         * Whether to internally store the upsampled body heat maps in half precision (FP16) rather than FP32. It
+         * halves the GPU memory and bandwidth of the post-processing (computations are still done in FP32).
+         * Only applicable with CUDA.
+         */
+        bool heatMapsFp16;
+
+        /**
+         * Target latency per frame (in milliseconds) of the adaptive network resolution. If positive, the network
+         * input resolution is changed at runtime between netInputSizeMin and netInputSize to keep the latency of
+         * each frame close to it (see NetResolutionController). 0 (default) disables it (i.e., the network input
+         * resolution is always netInputSize).
+         */
+        double latencyTargetMs;
+
+        /**
+         * Only applicable if latencyTargetMs > 0. Minimum network input resolution of the adaptive network
+         * resolution. Its `-1` must be in the same dimension than in netInputSize.
+         */
+        Point<int> netInputSizeMin;
+
+        /**
+         * ROI tracking mode for videos and webcams. If greater than 1, the full-frame body detection only runs once
+         * every roiTrackingInterval frames (or earlier if any person is lost), while the frames in between only run
+         * the body network on an enlarged crop around each person of the previous frame. New people are only found
+         * on the full-frame detections. 0 or 1 (default) disables it.
+         */
+        int roiTrackingInterval;
+
+        /**
+         * Multi-scale batch. If true and scalesNumber > 1, all the scales are padded (at the right and bottom) to the
+         * size of the largest one and processed by a single network forward pass (with batch size scalesNumber),
+         * rather than by one network (and forward pass) per scale. It saves GPU memory and launch overhead, while
+         * the keypoints might slightly change due to the extra padding. Not compatible with batchSize > 1.
+         */
+        bool scaleBatch;
+
+        /**
+         * Motion-gated inference for static cameras. If greater than 0, the frames in which at most this ratio (in
+         * the range [0, 1]) of the pixels of a small grayscale thumbnail changed more than motionGatePixelThreshold
+         * with respect to the last processed frame skip the body network, and they reuse its body keypoints (see
+         * MotionGate and Datum::poseKeypointsReused). 0 (default) disables it. Not compatible with batchSize > 1.
+         */
+        double motionGateRatio;
+
+        /**
+         * Only if motionGateRatio > 0. Minimum intensity difference (in the range [0, 255]) of a changed pixel.
+         */
+        int motionGatePixelThreshold;
+
+        /**
+         * Only if motionGateRatio > 0. Maximum number of consecutive frames that reuse the keypoints of the same
+         * processed frame.
+         */
+        int motionGateMaxSkip;
+
+        /**
+         * Whether to capture the per-frame kernels of the body heat map resize and NMS into a CUDA Graph (one per
+         * shape, see CudaGraphCache) and replay it on the following frames, rather than launching each kernel.
+         * Only applicable with CUDA 11 or higher.
+         */
+        bool cudaGraphs;
+
+        /**
+         * Whether each GPU worker queues the network forward pass of the next frame before post-processing (resize
+         * and merge, NMS, body part connection and KeepTopNPeople) the current one, so the post-processing overlaps
+         * the network of the following frame (see WPoseExtractor). It adds 1 frame of latency. Only applicable with
+         * CUDA, and not compatible with batchSize > 1, the motion gate, the ROI tracking mode nor tracking.
+         */
+        bool pipelined;
+
+        /**
+         * Whether the body part connector samples the PAF channels at network resolution (with bilinear
+         * interpolation), rather than upsampling them first with the body part heat maps. Only applicable with CUDA,
+         * and it is ignored with several scales or if heatMapTypes is not empty.
+         */
+        bool pafLowResolution;
+
+        /**
+         * Whether the heat maps (heatMapTypes) are left on the GPU and only downloaded when read (see
+         * Datum::poseHeatMapsDownload and Datum::getPoseHeatMaps()), rather than on every frame. Only applicable with
+         * CUDA.
+         */
+        bool heatMapsLazy;
+
+        /**
+         * If not empty, directory of the NetOutputCache shared by all the GPU threads, so the body network only runs
+         * on the frames whose network input (image, net resolution and scales) was not already cached.
+         */
+        String netOutputCacheDirectory;
+
+        /**
+         * GPU memory (in MB) that this process can use in each GPU (see gpuMemoryBudget.hpp). If positive, the batch
+         * size (and the queue sizes for frames decoded into GPU memory) are decreased to the maximum that fits.
+         * -1 uses the free memory of each GPU at configuration time, and 0 disables it.
+         */
+        int gpuMemoryBudget;
+
+        /**
+         * Whether to warm up the body network (see PoseExtractorNet::warmUp) before the first frame, on the network
+         * input sizes of the producer resolution (if known), the ones of WrapperT::warmUp(), and the ones of
+         * warmUpCacheFile. WrapperT::start() returns once all the GPU threads are warmed up.
+         */
+        bool warmUp;
+
+        /**
+         * If not empty, file (see NetWarmUp) where the network input sizes processed on each GPU model are recorded,
+         * so later runs warm them up too. It implies warmUp.
+         */
+        String warmUpCacheFile;
+
+        /**
+         * Whether the body, face and hand Caffe networks of each GPU thread share a single GPU memory block for their
+         * intermediate activations (see NetMemoryArena). Only for CUDA.
+         */
+        bool netMemorySharing;
+
+        /**
+         * Tiled inference (see PoseExtractorCaffe). If not {0, 0}, the frame is resized to tiledInputSize (as
+         * netInputSize, -1 keeps the aspect ratio) rather than to netInputSize, and netInputSize is the size of each
+         * tile (squared if one of its dimensions is -1).
+         */
+        Point<int> tiledInputSize;
+
+        /**
+         * Only if tiledInputSize is not {0, 0}. Minimum overlap between neighbouring tiles, as a ratio of the tile
+         * size, in [0, 0.5).
+         */
+        float tileOverlap;
+
+        /**
+         * If positive, the body network only runs its first netStages stages of each branch (see NetCaffe and
+         * PoseExtractorCaffe). 0 to run all of them.
+         */
+        int netStages;
+
+        /**
+         * Adaptive multi-scale. If positive and scalesNumber > 1, the whole frame only runs the smallest scale, and
+         * the largest one (netInputSize) only runs on crops around the people whose height (relative to the input
+         * height) is lower than this value or whose keypoints are not confident (see AdaptiveMultiScale). 0 to run
+         * all the scales on the whole frame. Not compatible with batchSize > 1, pipelined nor roiTrackingInterval.
+         */
+        float scaleAdaptiveHeight;
+
+        /**
+         * Whether to share the body network of each GPU with the other pipelines (e.g., Wrapper instances) of the
+         * process with the same network options (see PoseExtractorPool), so it is only loaded once.
+         */
+        bool sharedPool;
+
+        /**
+         * If not empty, the CUDA launch configurations of the post-processing and rendering kernels are autotuned
+         * and cached into this file (see gpu/cudaAutotune.hpp).
+         */
+        String cudaAutotuneCacheFile;
+
+        /**
+         * If >= 0, the heat maps (heatMapTypes) are filled into Datum::poseHeatMapsSparse (rather than
+         * Datum::poseHeatMaps), only keeping the values whose absolute value is higher than this threshold (see
+         * PoseExtractorNet::getHeatMapsSparse). heatMapScaleMode and heatMapsLazy do not apply to them.
+         */
+        float heatMapsSparseThreshold;
+
         /**
          * Constructor of the struct.
          * It has the recommended and default values we recommend for each element of the struct.
@@ -231,7 +418,18 @@ namespace op
             const ScaleMode heatMapScaleMode = ScaleMode::UnsignedChar, const bool addPartCandidates = false,
             const float renderThreshold = 0.05f, const int numberPeopleMax = -1, const bool maximizePositives = false,
             const double fpsMax = -1., const String& protoTxtPath = "", const String& caffeModelPath = "",
-            const float upsamplingRatio = 0.f, const bool enableGoogleLogging = true);
+            const float upsamplingRatio = 0.f, const bool enableGoogleLogging = true, const int batchSize = 1,
+            const long long batchMaxWaitMicroseconds = 5000ll, const int tensorRtPrecision = 16,
+            const bool heatMapsFp16 = false, const double latencyTargetMs = 0.,
+            const Point<int>& netInputSizeMin = Point<int>{-1, 256}, const int roiTrackingInterval = 0,
+            const bool scaleBatch = false, const double motionGateRatio = 0., const int motionGatePixelThreshold = 12,
+            const int motionGateMaxSkip = 30, const bool cudaGraphs = false, const bool pipelined = false,
+            const bool pafLowResolution = false, const bool heatMapsLazy = false,
+            const String& netOutputCacheDirectory = "", const int gpuMemoryBudget = 0, const bool warmUp = false,
+            const String& warmUpCacheFile = "", const bool netMemorySharing = false,
+            const Point<int>& tiledInputSize = Point<int>{0, 0}, const float tileOverlap = 0.25f,
+            const int netStages = 0, const float scaleAdaptiveHeight = 0.f, const bool sharedPool = false,
+            const String& cudaAutotuneCacheFile = "", const float heatMapsSparseThreshold = -1.f);
     };
 }
 
@@ -0,0 +1,68 @@
+#ifndef OPENPOSE_WRAPPER_WRAPPER_STRUCT_RUNTIME_HPP
+#define OPENPOSE_WRAPPER_WRAPPER_STRUCT_RUNTIME_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * WrapperStructRuntime: Changes applied to a running WrapperT (see WrapperT::reconfigure()), without stopping
+     * it. Each element keeps its current value by default, so only the ones to be changed need to be filled.
+     */
+    struct OP_API WrapperStructRuntime
+    {
+        /**
+         * New network input resolution of the body network (as WrapperStructPose::netInputSize). It is applied
+         * between 2 frames, and the networks are reshaped by their next forward pass (rather than reloaded).
+         * Not compatible with the adaptive network resolution (WrapperStructPose::latencyTargetMs).
+         * {0, 0} (default) keeps the current one.
+         */
+        Point<int> netInputSize;
+
+        /**
+         * Whether the face keypoint detection is enabled: 1 to enable it, 0 to disable it, and -1 (default) to keep
+         * it. The face must have been configured (WrapperStructFace::enable), but it can start disabled
+         * (WrapperStructFace::startEnabled = false), in which case its network is only loaded the first time it is
+         * enabled.
+         */
+        int face;
+
+        /**
+         * Analogous to face for the hand keypoint detection.
+         */
+        int hand;
+
+        /**
+         * New WrapperStructPose::blendOriginalFrame of the pose renderers: 1, 0, or -1 (default) to keep it.
+         */
+        int blendOriginalFrame;
+
+        /**
+         * New WrapperStructPose::alphaKeypoint of the pose renderers. Negative (default) to keep it.
+         */
+        float alphaKeypoint;
+
+        /**
+         * New WrapperStructPose::alphaHeatMap of the pose renderers. Negative (default) to keep it.
+         */
+        float alphaHeatMap;
+
+        /**
+         * New element rendered by the pose renderers (as WrapperStructPose::defaultPartToRender). Negative (default)
+         * to keep it.
+         */
+        int elementToRender;
+
+        /**
+         * Constructor of the struct.
+         * It has the recommended and default values we recommend for each element of the struct.
+         * Since all the elements of the struct are public, they can also be manually filled.
+         */
+        WrapperStructRuntime(
+            const Point<int>& netInputSize = Point<int>{0, 0}, const int face = -1, const int hand = -1,
+            const int blendOriginalFrame = -1, const float alphaKeypoint = -1.f, const float alphaHeatMap = -1.f,
+            const int elementToRender = -1);
+    };
+}
+
+#endif // OPENPOSE_WRAPPER_WRAPPER_STRUCT_RUNTIME_HPP
@@ -6,6 +6,12 @@
 
 namespace op
 {
+    /**
+     * Whether the 2-D keypoint (x, y, score) is used for the 3-D reconstruction: Its score is high enough, and it is
+     * not on the image border (where it is most probably out of the image).
+     */
+    bool isValidKeypoint(const float* const keypointPtr, const Point<int>& imageSize);
+
     /**
      * 3D triangulation given known camera parameter matrices and based on linear DLT algorithm.
      * The returned cv::Mat is a 4x1 matrix, where the last coordinate is 1.
@@ -23,6 +29,41 @@ namespace op
     double triangulateWithOptimization(
         cv::Mat& reconstructedPoint, const std::vector<cv::Mat>& cameraMatrices,
         const std::vector<cv::Point2d>& pointsOnEachCamera, const double reprojectionMaxAcceptable);
+
+    /**
+     * Batched linear triangulation of numberPoints points at once, in a structure-of-arrays layout:
+     * xs[camera*numberPoints + point] (analogously ys and visibilities, the latter being 1 if that camera sees that
+     * point or 0 otherwise). Rather than the SVD of each DLT system, it solves its 3x3 normal equations (fixing the
+     * homogeneous coordinate to 1) in closed form, 4 points at once with AVX2 if available.
+     * reconstructedPoints: [3*numberPoints], x-y-z of each point. reprojectionErrors: [numberPoints], averaged over
+     * the cameras that see that point. Degenerate points (e.g., < 2 views) are not finite.
+     */
+    void triangulateBatch(
+        std::vector<double>& reconstructedPoints, std::vector<double>& reprojectionErrors,
+        const std::vector<cv::Mat>& cameraMatrices, const std::vector<double>& xs, const std::vector<double>& ys,
+        const std::vector<double>& visibilities, const int numberPoints);
+
+    /**
+     * Single Gauss-Newton step on the reprojection error of each point, from an initial 3-D estimate (e.g., the
+     * previous frame one), with the same layout than triangulateBatch(). It is much cheaper than a new
+     * triangulation, but only accurate if the initial estimate is already close (see PoseTriangulation temporal).
+     * reconstructedPoints: [3*numberPoints], the initial x-y-z of each point, replaced by the refined ones.
+     * reprojectionErrors: [numberPoints], as in triangulateBatch().
+     */
+    void refineTriangulationBatch(
+        std::vector<double>& reconstructedPoints, std::vector<double>& reprojectionErrors,
+        const std::vector<cv::Mat>& cameraMatrices, const std::vector<double>& xs, const std::vector<double>& ys,
+        const std::vector<double>& visibilities, const int numberPoints);
+
+    /**
+     * Batched equivalent of triangulateWithOptimization(), with the same layout than triangulateBatch(). Only the
+     * points whose triangulateBatch() result is degenerate or whose reprojection error triggers its RANSAC or LMA
+     * refinement are re-triangulated with triangulateWithOptimization().
+     */
+    void triangulateWithOptimizationBatch(
+        std::vector<double>& reconstructedPoints, std::vector<double>& reprojectionErrors,
+        const std::vector<cv::Mat>& cameraMatrices, const std::vector<double>& xs, const std::vector<double>& ys,
+        const std::vector<double>& visibilities, const int numberPoints, const double reprojectionMaxAcceptable);
 }
 
 #endif // OPENPOSE_PRIVATE_3D_POSE_TRIANGULATION_PRIVATE_HPP
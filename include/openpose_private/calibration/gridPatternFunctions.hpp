@@ -17,6 +17,16 @@ namespace op
     std::pair<bool, std::vector<cv::Point2f>> findAccurateGridCorners(
         const cv::Mat& image, const cv::Size& gridInnerCorners);
 
+    /**
+     * Same as findAccurateGridCorners(), but the result for imagePath is cached as a YML file in cacheFolder, so
+     * later calibration runs over the same images skip the chessboard detection. The cache of an image is ignored if
+     * the grid size, the image resolution or the image file size changed. cacheFolder must exist (or be empty to
+     * disable the cache).
+     */
+    std::pair<bool, std::vector<cv::Point2f>> findAccurateGridCornersCached(
+        const cv::Mat& image, const cv::Size& gridInnerCorners, const std::string& imagePath,
+        const std::string& cacheFolder);
+
     std::vector<cv::Point3f> getObjects3DVector(
         const cv::Size& gridInnerCorners, const float gridSquareSizeMm);
 
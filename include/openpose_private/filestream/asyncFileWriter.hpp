@@ -0,0 +1,52 @@
+#ifndef OPENPOSE_PRIVATE_FILESTREAM_ASYNC_FILE_WRITER_HPP
+#define OPENPOSE_PRIVATE_FILESTREAM_ASYNC_FILE_WRITER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * It writes files on its own background thread, so slow disks do not block the worker that generates them (e.g.,
+     * the 1 JSON file per frame of PeopleJsonSaver). The content strings are recycled (see getBuffer()) so their
+     * memory is reused. If more than maxQueueSize files are pending, write() waits for the oldest one to be written.
+     * The destructor writes all the pending files.
+     */
+    class AsyncFileWriter
+    {
+    public:
+        explicit AsyncFileWriter(const unsigned long long maxQueueSize = 32ull);
+
+        virtual ~AsyncFileWriter();
+
+        /**
+         * It returns an empty string, with the memory reserved by a previously written one (if any).
+         */
+        std::string getBuffer();
+
+        /**
+         * It queues content to be written into filePath, and returns before it is written. If a previous file could
+         * not be written, it throws that error.
+         */
+        void write(const std::string& filePath, std::string&& content);
+
+    private:
+        const unsigned long long mMaxQueueSize;
+        std::mutex mMutex;
+        std::condition_variable mConditionVariable;
+        std::deque<std::pair<std::string, std::string>> mQueue;
+        std::vector<std::string> mFreeBuffers;
+        std::string mErrorMessage;
+        bool mStop;
+        std::thread mThread;
+
+        void threadFunction();
+
+        DELETE_COPY(AsyncFileWriter);
+    };
+}
+
+#endif // OPENPOSE_PRIVATE_FILESTREAM_ASYNC_FILE_WRITER_HPP
@@ -0,0 +1,50 @@
+#ifndef OPENPOSE_PRIVATE_FILESTREAM_DATUM_SOCKET_HPP
+#define OPENPOSE_PRIVATE_FILESTREAM_DATUM_SOCKET_HPP
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <winsock2.h>
+#endif
+#include <openpose/core/common.hpp>
+#include <openpose/filestream/datumWireFormat.hpp>
+
+namespace op
+{
+    // TCP socket helpers shared by DatumSender and DatumReceiver (blocking sockets)
+    #ifdef _WIN32
+        typedef SOCKET DatumSocketType;
+        const DatumSocketType INVALID_DATUM_SOCKET = INVALID_SOCKET;
+    #else
+        typedef int DatumSocketType;
+        const DatumSocketType INVALID_DATUM_SOCKET = -1;
+    #endif
+
+    // WSAStartup/WSACleanup on Windows, nothing otherwise
+    void startDatumSockets();
+
+    void stopDatumSockets();
+
+    void closeDatumSocket(const DatumSocketType socketDescriptor);
+
+    // Small messages (e.g., the credits) are sent right away, rather than waiting to be merged with later ones
+    void setDatumSocketNoDelay(const DatumSocketType socketDescriptor);
+
+    // It returns whether the socket can be read (or accepted from) within timeoutMs
+    bool waitForDatumSocket(const DatumSocketType socketDescriptor, const int timeoutMs);
+
+    // They return false if the connection was closed (or failed)
+    bool sendDatumSocket(const DatumSocketType socketDescriptor, const void* const dataPtr, const uint64_t bytes);
+
+    bool receiveDatumSocket(const DatumSocketType socketDescriptor, void* const dataPtr, const uint64_t bytes);
+
+    // It returns false if the connection was closed. It throws an error if the header is not a valid one
+    bool receiveDatumWireMessageHeader(const DatumSocketType socketDescriptor, DatumWireMessageHeader& header);
+
+    bool sendDatumWireMessage(
+        const DatumSocketType socketDescriptor, const DatumWireMessage message, const uint32_t value,
+        const std::vector<char>& payload = {});
+}
+
+#endif // OPENPOSE_PRIVATE_FILESTREAM_DATUM_SOCKET_HPP
@@ -0,0 +1,138 @@
+#ifndef OPENPOSE_PRIVATE_FILESTREAM_HEAT_MAP_BINARY_FORMAT_HPP
+#define OPENPOSE_PRIVATE_FILESTREAM_HEAT_MAP_BINARY_FORMAT_HPP
+
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    // Layout of the files of HeatMapBinarySaver and HeatMapBinaryReader (see doc/advanced/heatmap_output.md). All
+    // the values are saved in the native (little-endian) byte order, and every block is padded to 8 bytes.
+    // File: HeatMapBinaryFileHeader + one frame after the other (append-only)
+    // Frame: HeatMapBinaryFrameHeader + name + numberArrays x (HeatMapBinaryArrayHeader
+    //        + numberChannels x HeatMapBinaryChannelHeader + the (compressed) data of each channel)
+    // Version 1 files have no sparse arrays, and their array headers end at width (16 bytes).
+    const char HEAT_MAP_BINARY_MAGIC[8] = {'O', 'P', 'H', 'M', 'B', 'I', 'N', '\0'};
+    const auto HEAT_MAP_BINARY_VERSION = 2u;
+    const auto HEAT_MAP_BINARY_ARRAY_HEADER_BYTES_V1 = 16u;
+    const auto HEAT_MAP_BINARY_FRAME_MAGIC = 0x50414d48u; // "HMAP"
+
+    enum class HeatMapBinaryCompression : uint32_t
+    {
+        None = 0,
+        Zstd,
+    };
+
+    enum class HeatMapBinaryLayout : uint32_t
+    {
+        Dense = 0,
+        Sparse, // SparseHeatMaps
+    };
+
+    struct HeatMapBinaryFileHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+    };
+
+    struct HeatMapBinaryFrameHeader
+    {
+        uint32_t magic;
+        uint32_t numberArrays; // E.g., 1 per Datum for the pose heat maps
+        uint64_t frameBytes; // Including this header
+        uint64_t nameBytes; // Without the padding
+    };
+
+    // Each array is [numberChannels x height x width]
+    struct HeatMapBinaryArrayHeader
+    {
+        uint32_t precision; // HeatMapPrecision
+        uint32_t numberChannels;
+        uint32_t height;
+        uint32_t width;
+        uint32_t layout; // HeatMapBinaryLayout
+        float threshold; // SparseHeatMaps::threshold (0 if Dense)
+    };
+
+    // Each channel is compressed independently (so they are compressed in parallel). Float32 and Float16 channels are
+    // byte-shuffled before compressing them (all the 1st bytes of the values, then all the 2nd ones, etc.).
+    // Value = offset + scale x saved value (offset = 0 and scale = 1 unless UInt8)
+    // Sparse channels save the numberValues indices first (as uint32 differences with the previous index, also
+    // byte-shuffled), followed by their values. Offset and scale only cover the kept values.
+    struct HeatMapBinaryChannelHeader
+    {
+        float offset;
+        float scale;
+        uint32_t compression; // HeatMapBinaryCompression
+        uint32_t numberValues; // Number of kept values if Sparse (0 if Dense)
+        uint64_t dataBytes; // Saved bytes, without the padding
+    };
+
+    inline uint64_t heatMapBinaryPaddedBytes(const uint64_t bytes)
+    {
+        return (bytes + 7u) & ~(uint64_t)7u;
+    }
+
+    // IEEE 754 binary16 conversions (round to nearest even)
+    inline uint16_t floatToHalf(const float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(float));
+        const auto sign = (uint16_t)((bits >> 16) & 0x8000u);
+        const auto absBits = bits & 0x7fffffffu;
+        // NaN and infinity (and overflow)
+        if (absBits >= 0x47800000u)
+            return (uint16_t)(sign | (absBits > 0x7f800000u ? 0x7e00u : 0x7c00u));
+        // Normal
+        if (absBits >= 0x38800000u)
+        {
+            const auto rounded = absBits + 0x0fffu + ((absBits >> 13) & 1u);
+            return (uint16_t)(sign | ((rounded - 0x38000000u) >> 13));
+        }
+        // Subnormal or zero
+        if (absBits < 0x33000000u)
+            return sign;
+        const auto exponent = absBits >> 23;
+        const auto mantissa = (absBits & 0x7fffffu) | 0x800000u;
+        const auto shift = 126u - exponent;
+        const auto halfwayAndOdd = (1u << (shift - 1u)) - 1u + ((mantissa >> shift) & 1u);
+        return (uint16_t)(sign | ((mantissa + halfwayAndOdd) >> shift));
+    }
+
+    inline float halfToFloat(const uint16_t half)
+    {
+        const auto sign = (uint32_t)(half & 0x8000u) << 16;
+        const auto exponent = (half >> 10) & 0x1fu;
+        auto mantissa = (uint32_t)(half & 0x3ffu);
+        uint32_t bits;
+        // Zero and subnormal
+        if (exponent == 0u)
+        {
+            if (mantissa == 0u)
+                bits = sign;
+            else
+            {
+                auto exponentFloat = 113u;
+                while ((mantissa & 0x400u) == 0u)
+                {
+                    mantissa <<= 1;
+                    exponentFloat--;
+                }
+                bits = sign | (exponentFloat << 23) | ((mantissa & 0x3ffu) << 13);
+            }
+        }
+        // NaN and infinity
+        else if (exponent == 0x1fu)
+            bits = sign | 0x7f800000u | (mantissa << 13);
+        // Normal
+        else
+            bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+        float value;
+        std::memcpy(&value, &bits, sizeof(float));
+        return value;
+    }
+}
+
+#endif // OPENPOSE_PRIVATE_FILESTREAM_HEAT_MAP_BINARY_FORMAT_HPP
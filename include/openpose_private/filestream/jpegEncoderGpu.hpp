@@ -0,0 +1,51 @@
+#ifndef OPENPOSE_PRIVATE_FILESTREAM_JPEG_ENCODER_GPU_HPP
+#define OPENPOSE_PRIVATE_FILESTREAM_JPEG_ENCODER_GPU_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/core/renderTargetGpu.hpp>
+
+namespace op
+{
+    /**
+     * It returns whether imageFormat (e.g., the one of `--write_images_format`) is JPEG, i.e., `jpg` or `jpeg`.
+     */
+    bool isJpegFormat(const std::string& imageFormat);
+
+    /**
+     * JpegEncoderGpu compresses images into JPEG files with nvJPEG (it requires OpenPose compiled with
+     * `WITH_NVJPEG`). All the images of each encode() call are encoded as a single batch on the GPU (with 1 CUDA
+     * synchronization), and only their compressed bytes are copied back to the CPU. Each instance must be used by 1
+     * thread at a time.
+     */
+    class JpegEncoderGpu
+    {
+    public:
+        /**
+         * @param quality JPEG quality in the range [1, 100], 95 by default (as cv::imwrite).
+         */
+        explicit JpegEncoderGpu(const int quality = 95);
+
+        virtual ~JpegEncoderGpu();
+
+        /**
+         * It encodes each image into its JPEG file content (jpegs is resized to images.size()).
+         * @param images 8-bit BGR (CV_8UC3) or grayscale (CV_8UC1) images.
+         * @param renderTargets Optional render targets of the images (e.g., Datum::outputDataGpu). If the i-th one is
+         * up to date and has the size of the i-th image, it is encoded straight from the GPU memory (and that image is
+         * not read), rather than uploading the image.
+         */
+        void encode(
+            std::vector<std::string>& jpegs, const std::vector<Matrix>& images,
+            const std::vector<RenderTargetGpu>& renderTargets = {});
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplJpegEncoderGpu;
+        std::unique_ptr<ImplJpegEncoderGpu> upImpl;
+
+        DELETE_COPY(JpegEncoderGpu);
+    };
+}
+
+#endif // OPENPOSE_PRIVATE_FILESTREAM_JPEG_ENCODER_GPU_HPP
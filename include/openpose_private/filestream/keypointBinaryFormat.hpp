@@ -0,0 +1,66 @@
+#ifndef OPENPOSE_PRIVATE_FILESTREAM_KEYPOINT_BINARY_FORMAT_HPP
+#define OPENPOSE_PRIVATE_FILESTREAM_KEYPOINT_BINARY_FORMAT_HPP
+
+#include <cstdint>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    // Layout of the files of KeypointBinarySaver and KeypointBinaryReader (see doc/02_output.md). All the values are
+    // saved in the native (little-endian) byte order, and every block is padded to 8 bytes, so the columns of a
+    // memory-mapped file can be read in place.
+    // File: KeypointBinaryFileHeader + one frame after the other (append-only)
+    // Frame: KeypointBinaryFrameHeader + numberColumns x KeypointBinaryColumnHeader + the data of each column
+    const char KEYPOINT_BINARY_MAGIC[8] = {'O', 'P', 'K', 'P', 'B', 'I', 'N', '\0'};
+    const auto KEYPOINT_BINARY_VERSION = 1u;
+    const auto KEYPOINT_BINARY_FRAME_MAGIC = 0x4d415246u; // "FRAM"
+
+    enum class KeypointBinaryColumn : uint32_t
+    {
+        PersonIds = 0, // long long (Datum::poseIds)
+        PoseKeypoints, // float (Datum::poseKeypoints)
+        FaceKeypoints,
+        HandLeftKeypoints,
+        HandRightKeypoints,
+        PoseKeypoints3D,
+        FaceKeypoints3D,
+        HandLeftKeypoints3D,
+        HandRightKeypoints3D,
+        Size,
+    };
+
+    struct KeypointBinaryFileHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+    };
+
+    struct KeypointBinaryFrameHeader
+    {
+        uint32_t magic;
+        uint32_t numberColumns;
+        uint64_t frameBytes; // Including this header
+        uint64_t frameId; // Datum::id
+        uint64_t frameNumber;
+        uint64_t sourceId;
+        uint64_t subId;
+    };
+
+    // Empty columns are not saved. Each one is a contiguous [numberPeople x numberParts x numberChannels] array
+    // (numberParts = numberChannels = 1 for PersonIds)
+    struct KeypointBinaryColumnHeader
+    {
+        uint32_t column; // KeypointBinaryColumn
+        uint32_t numberPeople;
+        uint32_t numberParts;
+        uint32_t numberChannels;
+    };
+
+    inline uint64_t keypointBinaryPaddedBytes(const uint64_t bytes)
+    {
+        return (bytes + 7u) & ~(uint64_t)7u;
+    }
+}
+
+#endif // OPENPOSE_PRIVATE_FILESTREAM_KEYPOINT_BINARY_FORMAT_HPP
@@ -0,0 +1,59 @@
+#ifndef OPENPOSE_PRIVATE_FILESTREAM_KEYPOINT_COMPRESSION_HPP
+#define OPENPOSE_PRIVATE_FILESTREAM_KEYPOINT_COMPRESSION_HPP
+
+#include <cstdint>
+#include <map>
+#include <openpose/core/common.hpp>
+#include <openpose/filestream/keypointStreamFormat.hpp>
+
+namespace op
+{
+    /**
+     * Quantized keypoints of the last packet with a compressed block (by poseId), i.e., the reference of the
+     * residuals of the next one. The encoder and the decoder keep the same one, so the quantization error does not
+     * accumulate.
+     */
+    struct KeypointCompressionState
+    {
+        bool valid;
+        uint64_t sequence;
+        uint32_t numberParts;
+        uint32_t numberChannels;
+        std::map<long long, std::vector<int32_t>> people;
+
+        KeypointCompressionState();
+
+        void reset();
+    };
+
+    /**
+     * It appends the compressed block of keypoints (KeypointCompressedBlockHeader + bitstream, padded to 8 bytes)
+     * into packet, and it updates state with it.
+     * @param poseIds Datum::poseIds (if it does not match keypoints, all the people are absolute).
+     * @param keyframe Whether to send all the people as absolute (rather than residuals of state).
+     * @param maxNumberPeople The first people that fit into maxBytes (and at most maxNumberPeople) are compressed.
+     * @return Number of people compressed.
+     */
+    unsigned int compressKeypoints(
+        std::vector<char>& packet, KeypointCompressionState& state, const Array<float>& keypoints,
+        const Array<long long>& poseIds, const float precision, const bool keyframe, const uint64_t sequence,
+        const unsigned int maxNumberPeople, const uint64_t maxBytes);
+
+    /**
+     * It decompresses the keypoints (and their poseIds) of a compressed block, and it updates state with them.
+     * @param data Block data (KeypointCompressedBlockHeader + bitstream).
+     * @return False if it refers to a packet that was not decoded with state (keypoints and poseIds are then empty,
+     * and so is state until the next keyframe).
+     */
+    bool decompressKeypoints(
+        Array<float>& keypoints, Array<long long>& poseIds, KeypointCompressionState& state,
+        const KeypointPacketBlockHeader& blockHeader, const char* const data, const uint64_t dataBytes,
+        const uint64_t sequence);
+
+    /**
+     * Bytes of the data of a compressed block (without padding), or 0 if dataBytes cannot fit its header.
+     */
+    uint64_t getCompressedBlockBytes(const char* const data, const uint64_t dataBytes);
+}
+
+#endif // OPENPOSE_PRIVATE_FILESTREAM_KEYPOINT_COMPRESSION_HPP
@@ -37,8 +37,30 @@ namespace op
                                                    bool getFromVienna = false);
         ~OpenCL();
 
+        /**
+         * Queue of the network (and the one of Caffe if getFromVienna).
+         */
         cl::CommandQueue& getQueue();
 
+        /**
+         * In-order queue for the post-processing kernels (resize and merge, NMS and body part connection), so they
+         * do not share the network queue. Use enqueueWait() to synchronize both of them.
+         */
+        cl::CommandQueue& getPostProcessingQueue();
+
+        /**
+         * getPostProcessingQueue() after making it wait (with enqueueWait()) for all the commands already enqueued in
+         * the network queue, i.e., the queue where the post-processing kernels of the current network output must be
+         * enqueued. The host is not blocked.
+         */
+        cl::CommandQueue& getPostProcessingQueueAfterNetwork();
+
+        /**
+         * It makes waitingQueue wait (on the device, without blocking the host) until all the commands already
+         * enqueued in queue are finished.
+         */
+        static void enqueueWait(cl::CommandQueue& waitingQueue, cl::CommandQueue& queue);
+
         cl::Device& getDevice();
 
         cl::Context& getContext();
@@ -59,6 +81,14 @@ namespace op
 
         int getAlignment();
 
+        /**
+         * Whether the device shares the physical memory with the host (e.g., Intel and AMD integrated GPUs). If so,
+         * the buffers read or written by the host on each frame (e.g., the NMS kernel and the PAF scores) are
+         * created with CL_MEM_ALLOC_HOST_PTR, so mapping them is zero-copy. Otherwise, they stay in device memory
+         * (host memory would slow down the kernels writing them) and mapping them copies them.
+         */
+        bool hasUnifiedMemory();
+
         static std::string clErrorToString(int err);
 
         static int getTotalGPU();
@@ -0,0 +1,63 @@
+#ifndef OPENPOSE_PRIVATE_PRODUCER_INPUT_RECORDING_FORMAT_HPP
+#define OPENPOSE_PRIVATE_PRODUCER_INPUT_RECORDING_FORMAT_HPP
+
+#include <cstdint>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    // Layout of the files of InputRecorder and ReplayReader (see doc/01_demo.md). All the values are saved in the
+    // native (little-endian) byte order, and every block is padded to 8 bytes.
+    // File: InputRecordingFileHeader + one frame chunk after the other (append-only, so a recording interrupted by a
+    // crash is still readable up to its last complete chunk)
+    // Frame chunk: InputRecordingFrameHeader + frame name + numberViews x (InputRecordingViewHeader + encoded image +
+    // INPUT_RECORDING_MATRICES x (InputRecordingMatrixHeader + matrix data))
+    const char INPUT_RECORDING_MAGIC[8] = {'O', 'P', 'R', 'E', 'C', 'I', 'N', '\0'};
+    const auto INPUT_RECORDING_VERSION = 1u;
+    const auto INPUT_RECORDING_FRAME_MAGIC = 0x4d415246u; // "FRAM"
+    // Camera matrix, extrinsics, intrinsics, and distortion of each view (empty ones have 0 rows)
+    const auto INPUT_RECORDING_MATRICES = 4u;
+
+    struct InputRecordingFileHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+    };
+
+    struct InputRecordingFrameHeader
+    {
+        uint32_t magic;
+        uint32_t numberViews;
+        uint64_t frameBytes; // Including this header
+        int64_t timestampNs; // Arrival time, relative to the first recorded frame
+        uint64_t frameNumber;
+        uint64_t sourceId;
+        uint64_t sourceIdMax;
+        uint32_t nameBytes;
+        int32_t width; // Of the first view
+        int32_t height;
+        uint32_t reserved;
+    };
+
+    struct InputRecordingViewHeader
+    {
+        uint32_t imageBytes; // Encoded (e.g., JPEG) image
+        uint32_t numberMatrices;
+    };
+
+    struct InputRecordingMatrixHeader
+    {
+        int32_t rows;
+        int32_t cols;
+        int32_t type; // OpenCV type (e.g., CV_64FC1)
+        uint32_t dataBytes;
+    };
+
+    inline uint64_t inputRecordingPaddedBytes(const uint64_t bytes)
+    {
+        return (bytes + 7u) & ~(uint64_t)7u;
+    }
+}
+
+#endif // OPENPOSE_PRIVATE_PRODUCER_INPUT_RECORDING_FORMAT_HPP
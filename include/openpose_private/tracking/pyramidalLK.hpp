@@ -22,6 +22,44 @@ namespace op
         std::vector<cv::Mat>& pyramidImagesPrevious, std::vector<cv::Mat>& pyramidImagesCurrent,
         std::vector<char>& status, const cv::Mat& imagePrevious, const cv::Mat& imageCurrent,
         const int levels = 3, const int patchSize = 21, const bool initFlow = false);
+
+    /**
+     * Gaussian pyramid of a gray frame stored on the GPU (CUDA only). Each frame is uploaded and downsampled only
+     * once, and the same pyramid is then re-used as the previous one when tracking the next frame. Its GPU memory is
+     * kept (and only re-allocated if the frame size changes).
+     */
+    struct PyramidGpu
+    {
+        std::vector<float*> levelPtrs;
+        std::vector<cv::Size> levelSizes;
+        float* gpuPtr;
+        unsigned long long gpuBytes;
+        unsigned char* frameGpuPtr;
+        unsigned long long frameGpuBytes;
+
+        PyramidGpu();
+
+        virtual ~PyramidGpu();
+
+        bool empty() const;
+
+        DELETE_COPY(PyramidGpu);
+    };
+
+    /**
+     * It uploads image (CV_8UC1 or CV_8UC3), converts it into gray and builds its `levels` pyramid levels.
+     */
+    void buildPyramidGpu(PyramidGpu& pyramid, const cv::Mat& image, const int levels = 3);
+
+    /**
+     * Batched version of pyramidalLKGpu: ptsI can contain the keypoints of all the people, and all of them are
+     * tracked from pyramidPrevious into pyramidCurrent with a single kernel launch (one CUDA thread per keypoint
+     * running all the pyramid levels). As in pyramidalLKCpu, points with status != 0 are ignored, and status is
+     * set for the points that could not be tracked.
+     */
+    void pyramidalLKGpu(
+        std::vector<cv::Point2f>& ptsI, std::vector<cv::Point2f>& ptsJ, std::vector<char>& status,
+        const PyramidGpu& pyramidPrevious, const PyramidGpu& pyramidCurrent, const int patchSize = 21);
 }
 
 #endif // OPENPOSE_PRIVATE_TRACKING_LKPYRAMIDAL_HPP
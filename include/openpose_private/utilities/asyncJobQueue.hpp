@@ -0,0 +1,63 @@
+#ifndef OPENPOSE_PRIVATE_UTILITIES_ASYNC_JOB_QUEUE_HPP
+#define OPENPOSE_PRIVATE_UTILITIES_ASYNC_JOB_QUEUE_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * It runs the pushed jobs on numberThreads background threads (e.g., the image encoding and writing of the
+     * savers), so the pushing thread does not wait for them. With 1 thread, the jobs run in the order they were
+     * pushed (e.g., the frames of a video). If maxQueueSize jobs are pending, push() waits for the oldest one to
+     * start. The destructor runs all the pending jobs.
+     * The jobs must own (i.e., copy) their data, since they run after push() returns.
+     */
+    class AsyncJobQueue
+    {
+    public:
+        explicit AsyncJobQueue(const unsigned int numberThreads = 1u, const unsigned long long maxQueueSize = 8ull);
+
+        virtual ~AsyncJobQueue();
+
+        /**
+         * It queues job and returns before it runs. If a previous job threw an exception, it throws that error.
+         */
+        void push(std::function<void()> job);
+
+        /**
+         * It waits until all the pushed jobs have finished, and it throws the error of any of them (if any).
+         */
+        void wait();
+
+    private:
+        const unsigned long long mMaxQueueSize;
+        std::mutex mMutex;
+        std::condition_variable mConditionVariable;
+        std::deque<std::function<void()>> mJobs;
+        unsigned long long mNumberRunningJobs;
+        std::string mErrorMessage;
+        bool mStop;
+        std::vector<std::thread> mThreads;
+
+        void threadFunction();
+
+        void throwPendingError();
+
+        DELETE_COPY(AsyncJobQueue);
+    };
+
+    /**
+     * Job queue of the encoder threads of the image, heat map and video savers.
+     * @param numberThreads Number of threads, 0 for none (it returns nullptr, i.e., the savers write on the calling
+     * thread), or -1 for the default (up to 4, leaving half of the cores for the rest of the pipeline).
+     */
+    std::shared_ptr<AsyncJobQueue> createEncoderJobQueue(const int numberThreads);
+}
+
+#endif // OPENPOSE_PRIVATE_UTILITIES_ASYNC_JOB_QUEUE_HPP
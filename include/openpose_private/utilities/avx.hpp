@@ -10,6 +10,9 @@
     #include <cstdint> // uintptr_t
     #include <memory> // shared_ptr
     #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h> // __cpuid, __cpuidex
+    #endif
     #include <openpose/utilities/errorAndLog.hpp>
 
     namespace op
@@ -22,6 +25,50 @@
             #error Unknown environment!
         #endif
 
+        // Functions compiled for AVX2 or AVX-512 (regardless of the compiler flags), so they are only called if
+        // cpuSupportsAvx2() or cpuSupportsAvx512() (MSVC does not need it to use their intrinsics)
+        #ifdef __GNUC__
+            #define OP_TARGET_AVX2 __attribute__((target("avx2")))
+            #define OP_TARGET_AVX512 __attribute__((target("avx512f")))
+        #else
+            #define OP_TARGET_AVX2
+            #define OP_TARGET_AVX512
+        #endif
+
+        // Runtime (CPUID) detection, so a binary compiled with WITH_AVX can fall back to the non-SIMD code
+        inline bool cpuSupportsAvx2()
+        {
+            #ifdef _MSC_VER
+                int cpuInfo[4];
+                __cpuid(cpuInfo, 0);
+                if (cpuInfo[0] < 7)
+                    return false;
+                // OSXSAVE and OS support for the YMM registers
+                __cpuid(cpuInfo, 1);
+                if ((cpuInfo[2] & (1 << 27)) == 0 || (_xgetbv(0) & 0x6) != 0x6)
+                    return false;
+                __cpuidex(cpuInfo, 7, 0);
+                return (cpuInfo[1] & (1 << 5)) != 0;
+            #else
+                return __builtin_cpu_supports("avx2");
+            #endif
+        }
+        inline bool cpuSupportsAvx512()
+        {
+            #ifdef _MSC_VER
+                if (!cpuSupportsAvx2())
+                    return false;
+                // OS support for the ZMM registers
+                if ((_xgetbv(0) & 0xE6) != 0xE6)
+                    return false;
+                int cpuInfo[4];
+                __cpuidex(cpuInfo, 7, 0);
+                return (cpuInfo[1] & (1 << 16)) != 0;
+            #else
+                return __builtin_cpu_supports("avx512f");
+            #endif
+        }
+
         // Functions
         // Sources:
         // - https://stackoverflow.com/questions/32612190/how-to-solve-the-32-byte-alignment-issue-for-avx-load-store-operations
@@ -0,0 +1,44 @@
+#ifndef OPENPOSE_PRIVATE_UTILITIES_MEMORY_MAPPED_FILE_HPP
+#define OPENPOSE_PRIVATE_UTILITIES_MEMORY_MAPPED_FILE_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Read-only memory mapping of a whole file. The OS loads its pages on demand and keeps them in its page cache,
+     * so reading it does not copy it into the process memory (e.g., for the trained model files).
+     */
+    class MemoryMappedFile
+    {
+    public:
+        explicit MemoryMappedFile(const std::string& filePath);
+
+        virtual ~MemoryMappedFile();
+
+        const unsigned char* getData() const;
+
+        unsigned long long getSize() const;
+
+        const std::string& getFilePath() const;
+
+    private:
+        const std::string mFilePath;
+        const unsigned char* pData;
+        unsigned long long mSize;
+        #ifdef _WIN32
+            void* pFileHandle;
+            void* pMappingHandle;
+        #endif
+
+        DELETE_COPY(MemoryMappedFile);
+    };
+
+    /**
+     * It returns the MemoryMappedFile of filePath, shared by all the threads of the process while any of them keeps
+     * it (e.g., the GPU threads loading the same network at the same time).
+     */
+    std::shared_ptr<const MemoryMappedFile> getMemoryMappedFile(const std::string& filePath);
+}
+
+#endif // OPENPOSE_PRIVATE_UTILITIES_MEMORY_MAPPED_FILE_HPP
@@ -0,0 +1,36 @@
+#ifndef OPENPOSE_PRIVATE_UTILITIES_NEON_HPP
+#define OPENPOSE_PRIVATE_UTILITIES_NEON_HPP
+
+// Warning:
+// This file contains auxiliary functions for NEON (ARM, e.g., Jetson boards).
+// This file should only be included from cpp files.
+// Default #include <openpose/headers.hpp> does not include it.
+
+#ifdef WITH_NEON
+    #if !defined(__ARM_NEON) && !defined(__ARM_NEON__)
+        #error WITH_NEON requires an ARM compiler with NEON enabled (e.g., `-mfpu=neon` for 32-bit ARM).
+    #endif
+    #include <arm_neon.h>
+    #if defined(__linux__) && !defined(__aarch64__)
+        #include <sys/auxv.h> // getauxval
+        #include <asm/hwcap.h> // HWCAP_NEON
+    #endif
+
+    namespace op
+    {
+        // Runtime detection, so a 32-bit ARM binary compiled with WITH_NEON can fall back to the non-SIMD code. NEON
+        // is mandatory in AArch64 (ARMv8), so it is always available there
+        inline bool cpuSupportsNeon()
+        {
+            #if defined(__aarch64__)
+                return true;
+            #elif defined(__linux__)
+                return (getauxval(AT_HWCAP) & HWCAP_NEON) != 0;
+            #else
+                return true;
+            #endif
+        }
+    }
+#endif
+
+#endif // OPENPOSE_PRIVATE_UTILITIES_NEON_HPP
@@ -7,9 +7,19 @@
 
 namespace op
 {
+    /**
+     * It draws the text (with a black shadow). If mask is not nullptr (a CV_8UC1 cv::Mat of the size of cvMat), it
+     * also sets to 255 the pixels drawn.
+     */
     void putTextOnCvMat(
         cv::Mat& cvMat, const std::string& textToDisplay, const Point<int>& position,
-        const cv::Scalar& color, const bool normalizeWidth, const int imageWidth);
+        const cv::Scalar& color, const bool normalizeWidth, const int imageWidth, cv::Mat* mask = nullptr);
+
+    /**
+     * Rectangle containing all the pixels that putTextOnCvMat() would draw with the same arguments.
+     */
+    cv::Rect getTextOnCvMatRectangle(
+        const std::string& textToDisplay, const Point<int>& position, const bool normalizeWidth, const int imageWidth);
 
     void resizeFixedAspectRatio(
         cv::Mat& resizedCvMat, const cv::Mat& cvMat, const double scaleFactor, const Point<int>& targetSize,
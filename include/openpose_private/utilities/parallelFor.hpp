@@ -0,0 +1,25 @@
+#ifndef OPENPOSE_PRIVATE_UTILITIES_PARALLEL_FOR_HPP
+#define OPENPOSE_PRIVATE_UTILITIES_PARALLEL_FOR_HPP
+
+#include <functional>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * It runs function(i) for each i in [begin, end) on a process-wide pool of CPU threads (created on the first
+     * call, one per core), and returns once all of them have finished. The calling thread also runs some of them,
+     * so it can be nested or called from several threads at the same time. The order is not guaranteed, so each
+     * function(i) must be independent from the others (e.g., the channels of a heat map).
+     * It is meant for the CPU-only post-processing (e.g., NMS and resize), where each function(i) takes at least
+     * some microseconds.
+     */
+    void parallelFor(const int begin, const int end, const std::function<void(const int)>& function);
+
+    /**
+     * Number of threads used by parallelFor() (including the calling thread).
+     */
+    unsigned int getParallelForThreads();
+}
+
+#endif // OPENPOSE_PRIVATE_UTILITIES_PARALLEL_FOR_HPP
@@ -0,0 +1,35 @@
+#ifndef OPENPOSE_PRIVATE_UTILITIES_RENDER_CPU_HPP
+#define OPENPOSE_PRIVATE_UTILITIES_RENDER_CPU_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Anti-aliased CPU drawing primitive: a capsule (the points within radiusOuter of the segment from (x1, y1) to
+     * (x2, y2), i.e., a thick line with round ends) or, if both points are the same, a disc. If radiusInner > 0,
+     * the points within radiusInner are excluded (i.e., a ring for a disc).
+     */
+    template <typename T>
+    struct RenderPrimitiveCpu
+    {
+        T x1;
+        T y1;
+        T x2;
+        T y2;
+        T radiusOuter;
+        T radiusInner;
+        T bgr[3]; // [0-255]
+    };
+
+    /**
+     * It draws the primitives (in order, each one over the previous ones) into the interleaved BGR frame of size
+     * {height, width, 3}. The frame is split into tiles drawn in parallel, and only the tiles (and pixels) inside
+     * the bounding boxes of the primitives are read or written.
+     */
+    template <typename T>
+    void renderPrimitivesCpu(
+        T* framePtr, const int width, const int height, const std::vector<RenderPrimitiveCpu<T>>& primitives);
+}
+
+#endif // OPENPOSE_PRIVATE_UTILITIES_RENDER_CPU_HPP
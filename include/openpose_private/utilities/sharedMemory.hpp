@@ -0,0 +1,48 @@
+#ifndef OPENPOSE_PRIVATE_UTILITIES_SHARED_MEMORY_HPP
+#define OPENPOSE_PRIVATE_UTILITIES_SHARED_MEMORY_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Named shared memory block, visible by the other processes of the same host (POSIX shm_open or a Windows file
+     * mapping), e.g., to stream the keypoints to a game engine with no sockets nor copies between them.
+     */
+    class SharedMemory
+    {
+    public:
+        /**
+         * It creates (or resizes, if it already exists) the shared memory block name with size bytes and maps it
+         * read-write. It is zero-filled if it did not exist, and removed by the destructor.
+         */
+        SharedMemory(const std::string& name, const unsigned long long size);
+
+        /**
+         * It maps the existing shared memory block name, read-only unless writable is true (e.g., to report back to
+         * its owner which data was already consumed). It is not removed by the destructor.
+         */
+        explicit SharedMemory(const std::string& name, const bool writable = false);
+
+        virtual ~SharedMemory();
+
+        unsigned char* getData() const;
+
+        unsigned long long getSize() const;
+
+    private:
+        const std::string mName;
+        const bool mOwner;
+        unsigned char* pData;
+        unsigned long long mSize;
+        #ifdef _WIN32
+            void* pMappingHandle;
+        #endif
+
+        void release();
+
+        DELETE_COPY(SharedMemory);
+    };
+}
+
+#endif // OPENPOSE_PRIVATE_UTILITIES_SHARED_MEMORY_HPP
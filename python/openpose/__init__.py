@@ -1 +1,4 @@
 from . import pyopenpose as pyopenpose
+import sys
+if sys.version_info >= (3, 6):
+    from .streaming import stream_async
@@ -10,7 +10,10 @@
 #include <pybind11/stl_bind.h>
 #include <pybind11/numpy.h>
 #include <opencv2/core/core.hpp>
+#include <condition_variable>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
 
 PYBIND11_MAKE_OPAQUE(std::vector<std::shared_ptr<op::Datum>>);
 
@@ -78,6 +81,178 @@ namespace op
         }
     }
 
+    // Iterator over the processed frames of an iterable of frames (see WrapperPython::stream()). A native thread feeds
+    // OpenPose while fewer than maxInFlight frames are being processed, and the results are returned in order. The GIL
+    // is only held to get the next frame from the iterable and to return each result, not while waiting for OpenPose.
+    class DatumStream{
+    public:
+        DatumStream(Wrapper& wrapper, const py::iterable& frames, const unsigned long long maxInFlight) :
+            rWrapper(wrapper),
+            mIterator{py::iter(frames)},
+            mMaxInFlight{std::max(1ull, maxInFlight)},
+            mInFlight{0ull},
+            mFeederFinished{false},
+            mClosed{false}
+        {
+            // It only acquires the GIL to get each frame from the iterable
+            mFeederThread = std::thread{&DatumStream::feed, this};
+        }
+
+        ~DatumStream()
+        {
+            try
+            {
+                close();
+            }
+            catch (const std::exception& e)
+            {
+                errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        // Next processed frame (a Datum), in the same order as frames. It raises the exception of the iterable (if
+        // any) once the frames before it have been returned
+        py::object next()
+        {
+            std::string errorMessage;
+            std::shared_ptr<std::vector<std::shared_ptr<Datum>>> datumsPtr;
+            {
+                py::gil_scoped_release release;
+                std::unique_lock<std::mutex> lock{mMutex};
+                mConditionVariable.wait(lock, [this]{ return mInFlight > 0 || mFeederFinished; });
+                if (mInFlight > 0)
+                {
+                    lock.unlock();
+                    const auto popped = rWrapper.waitAndPop(datumsPtr);
+                    lock.lock();
+                    if (popped)
+                        mInFlight--;
+                    else
+                    {
+                        // OpenPose was stopped, no more results will arrive
+                        mInFlight = 0ull;
+                        mClosed = true;
+                        mErrorMessage = "OpenPose was stopped while streaming.";
+                    }
+                    mConditionVariable.notify_all();
+                }
+                if (datumsPtr == nullptr)
+                    std::swap(errorMessage, mErrorMessage);
+            }
+            if (datumsPtr != nullptr && !datumsPtr->empty())
+                return py::cast(datumsPtr->at(0));
+            if (!errorMessage.empty())
+                throw std::runtime_error{errorMessage};
+            throw py::stop_iteration();
+        }
+
+        // It stops feeding frames, and it discards the ones still being processed
+        void close()
+        {
+            {
+                py::gil_scoped_release release;
+                std::unique_lock<std::mutex> lock{mMutex};
+                mClosed = true;
+                mConditionVariable.notify_all();
+                while (mInFlight > 0 || !mFeederFinished)
+                {
+                    if (mInFlight > 0)
+                    {
+                        lock.unlock();
+                        std::shared_ptr<std::vector<std::shared_ptr<Datum>>> datumsPtr;
+                        const auto popped = rWrapper.waitAndPop(datumsPtr);
+                        // Released without the lock (its numpy arrays acquire the GIL)
+                        datumsPtr.reset();
+                        lock.lock();
+                        mInFlight = (popped ? mInFlight - 1 : 0ull);
+                        mConditionVariable.notify_all();
+                    }
+                    else
+                        mConditionVariable.wait(lock);
+                }
+                lock.unlock();
+                if (mFeederThread.joinable())
+                    mFeederThread.join();
+            }
+            mIterator = py::none();
+        }
+
+    private:
+        Wrapper& rWrapper;
+        // Only accessed with the GIL held
+        py::object mIterator;
+        const unsigned long long mMaxInFlight;
+        std::mutex mMutex;
+        std::condition_variable mConditionVariable;
+        unsigned long long mInFlight;
+        bool mFeederFinished;
+        bool mClosed;
+        std::string mErrorMessage;
+        std::thread mFeederThread;
+
+        // Function of mFeederThread
+        void feed()
+        {
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock{mMutex};
+                    mConditionVariable.wait(lock, [this]{ return mClosed || mInFlight < mMaxInFlight; });
+                    if (mClosed)
+                        break;
+                }
+                // Next frame: a numpy image (zero-copy if C-contiguous) or an op.Datum
+                std::shared_ptr<std::vector<std::shared_ptr<Datum>>> datumsPtr;
+                {
+                    py::gil_scoped_acquire gil;
+                    try
+                    {
+                        auto* const item = PyIter_Next(mIterator.ptr());
+                        if (item == nullptr)
+                        {
+                            if (PyErr_Occurred())
+                                throw py::error_already_set();
+                            break;
+                        }
+                        const auto frame = py::reinterpret_steal<py::object>(item);
+                        std::shared_ptr<Datum> datumPtr;
+                        if (py::isinstance<Datum>(frame))
+                            datumPtr = frame.cast<std::shared_ptr<Datum>>();
+                        else
+                        {
+                            datumPtr = std::make_shared<Datum>();
+                            py::cast(datumPtr).attr("cvInputData") = frame;
+                        }
+                        datumsPtr = std::make_shared<std::vector<std::shared_ptr<Datum>>>(1, datumPtr);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        const std::lock_guard<std::mutex> lock{mMutex};
+                        mErrorMessage = e.what();
+                        break;
+                    }
+                }
+                {
+                    const std::lock_guard<std::mutex> lock{mMutex};
+                    mInFlight++;
+                }
+                mConditionVariable.notify_all();
+                if (!rWrapper.waitAndEmplace(datumsPtr))
+                {
+                    const std::lock_guard<std::mutex> lock{mMutex};
+                    mInFlight--;
+                    mErrorMessage = "OpenPose was stopped while streaming.";
+                    break;
+                }
+            }
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                mFeederFinished = true;
+            }
+            mConditionVariable.notify_all();
+        }
+    };
+
     class WrapperPython{
     public:
         std::unique_ptr<Wrapper> opWrapper;
@@ -97,6 +272,19 @@ namespace op
             );
         }
 
+        ~WrapperPython()
+        {
+            // Stopping OpenPose releases the Datums in its queues, whose numpy arrays require the GIL (see
+            // getNumpyOwner()), so it must not be held while waiting for the OpenPose threads
+            if (PyGILState_Check())
+            {
+                py::gil_scoped_release release;
+                opWrapper.reset();
+            }
+            else
+                opWrapper.reset();
+        }
+
         void configure(py::dict params = py::dict())
         {
             try
@@ -109,6 +297,7 @@ namespace op
                     0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
                     __LINE__, __FUNCTION__, __FILE__);
                 ConfigureLog::setPriorityThreshold((Priority)FLAGS_logging_level);
+                ConfigureLog::setAsynchronous(FLAGS_logging_async);
                 Profiler::setDefaultX(FLAGS_profile_speed);
 
                 // Applying user defined configuration - GFlags to program variables
@@ -116,8 +305,13 @@ namespace op
                 const auto outputSize = flagsToPoint(op::String(FLAGS_output_resolution), "-1x-1");
                 // netInputSize
                 const auto netInputSize = flagsToPoint(op::String(FLAGS_net_resolution), "-1x368");
+                const auto netInputSizeMin = flagsToPoint(op::String(FLAGS_net_resolution_min), "-1x256");
+                const auto tiledInputSize = flagsToPoint(op::String(FLAGS_tiled_resolution), "-1x2160");
                 // faceNetInputSize
                 const auto faceNetInputSize = flagsToPoint(op::String(FLAGS_face_net_resolution), "368x368 (multiples of 16)");
+                // faceDetectorNetInputSize
+                const auto faceDetectorNetInputSize = flagsToPoint(
+                    op::String(FLAGS_face_detector_net_resolution), "-1x256 (multiples of 32)");
                 // handNetInputSize
                 const auto handNetInputSize = flagsToPoint(op::String(FLAGS_hand_net_resolution), "368x368 (multiples of 16)");
                 // poseMode
@@ -150,23 +344,47 @@ namespace op
                     (float)FLAGS_alpha_pose, (float)FLAGS_alpha_heatmap, FLAGS_part_to_show, op::String(FLAGS_model_folder),
                     heatMapTypes, heatMapScaleMode, FLAGS_part_candidates, (float)FLAGS_render_threshold,
                     FLAGS_number_people_max, FLAGS_maximize_positives, FLAGS_fps_max, op::String(FLAGS_prototxt_path),
-                    op::String(FLAGS_caffemodel_path), (float)FLAGS_upsampling_ratio, enableGoogleLogging};
+                    op::String(FLAGS_caffemodel_path), (float)FLAGS_upsampling_ratio, enableGoogleLogging,
+                    FLAGS_batch_size, FLAGS_batch_max_wait, FLAGS_tensorrt_precision,
+                    FLAGS_heatmaps_fp16, FLAGS_latency_target, netInputSizeMin, FLAGS_roi_tracking_interval,
+                    FLAGS_scale_batch, FLAGS_motion_gate, FLAGS_motion_gate_pixel_threshold,
+                    FLAGS_motion_gate_max_skip, FLAGS_cuda_graphs, FLAGS_pose_pipelined,
+                    FLAGS_paf_low_resolution, FLAGS_heatmaps_lazy, op::String(FLAGS_net_output_cache),
+                    FLAGS_gpu_memory_budget, FLAGS_warm_up, op::String(FLAGS_warm_up_cache),
+                    FLAGS_net_memory_sharing, tiledInputSize, (float)FLAGS_tile_overlap, FLAGS_net_stages,
+                    (float)FLAGS_scale_adaptive, FLAGS_pose_shared_pool, op::String(FLAGS_cuda_autotune_cache),
+                    (float)FLAGS_heatmaps_sparse_threshold};
                 opWrapper->configure(wrapperStructPose);
                 // Face configuration (use WrapperStructFace{} to disable it)
                 const WrapperStructFace wrapperStructFace{
                     FLAGS_face, faceDetector, faceNetInputSize,
                     flagsToRenderMode(FLAGS_face_render, multipleView, FLAGS_render_pose),
-                    (float)FLAGS_face_alpha_pose, (float)FLAGS_face_alpha_heatmap, (float)FLAGS_face_render_threshold};
+                    (float)FLAGS_face_alpha_pose, (float)FLAGS_face_alpha_heatmap, (float)FLAGS_face_render_threshold,
+                    faceDetectorNetInputSize, FLAGS_face_detector_scale_number, FLAGS_face_hand_roi_cache,
+                    FLAGS_face_hand_adaptive_crop, (float)FLAGS_face_hand_from_body, true,
+                    FLAGS_face_hand_lazy_idle_s};
                 opWrapper->configure(wrapperStructFace);
                 // Hand configuration (use WrapperStructHand{} to disable it)
                 const WrapperStructHand wrapperStructHand{
                     FLAGS_hand, handDetector, handNetInputSize, FLAGS_hand_scale_number, (float)FLAGS_hand_scale_range,
                     flagsToRenderMode(FLAGS_hand_render, multipleView, FLAGS_render_pose), (float)FLAGS_hand_alpha_pose,
-                    (float)FLAGS_hand_alpha_heatmap, (float)FLAGS_hand_render_threshold};
+                    (float)FLAGS_hand_alpha_heatmap, (float)FLAGS_hand_render_threshold,
+                    FLAGS_face_hand_concurrent, FLAGS_face_hand_roi_cache, FLAGS_face_hand_adaptive_crop,
+                    (float)FLAGS_face_hand_from_body, true, FLAGS_face_hand_lazy_idle_s};
                 opWrapper->configure(wrapperStructHand);
                 // Extra functionality configuration (use WrapperStructExtra{} to disable it)
+                const auto gpuThreadPriority = flagsToThreadPriority(FLAGS_gpu_thread_priority);
+                // Person crops (disabled if empty)
+                const auto personCropSize = (FLAGS_person_crops.empty()
+                    ? Point<int>{0,0} : flagsToPoint(String(FLAGS_person_crops), "192x256"));
                 const WrapperStructExtra wrapperStructExtra{
-                    FLAGS_3d, FLAGS_3d_min_views, FLAGS_identification, FLAGS_tracking, FLAGS_ik_threads};
+                    FLAGS_3d, FLAGS_3d_min_views, FLAGS_identification, FLAGS_tracking, FLAGS_ik_threads,
+                    FLAGS_thread_pool, FLAGS_gpu_numa_affinity, gpuThreadPriority, FLAGS_cpu_worker_threads,
+                    FLAGS_gpu_dispatch, FLAGS_reorder_window_ms, FLAGS_tracking_extrapolation,
+                    FLAGS_3d_multi_person, FLAGS_auto_configure, personCropSize, (float)FLAGS_person_crops_scale,
+                    FLAGS_person_crops_align, FLAGS_person_crops_download, FLAGS_face_hand_gpu, FLAGS_spillover_workers,
+                    op::String(FLAGS_spillover_model), FLAGS_spillover_queue, FLAGS_3d_temporal, FLAGS_3d_gpu_affinity,
+                    flagsToQueueType(FLAGS_queue_type)};
                 opWrapper->configure(wrapperStructExtra);
                 // Output (comment or use default argument to disable any output)
                 const WrapperStructOutput wrapperStructOutput{
@@ -176,7 +394,16 @@ namespace op
                     op::String(FLAGS_write_video), FLAGS_write_video_fps, FLAGS_write_video_with_audio,
                     op::String(FLAGS_write_heatmaps), op::String(FLAGS_write_heatmaps_format), op::String(FLAGS_write_video_3d),
                     op::String(FLAGS_write_video_adam), op::String(FLAGS_write_bvh), op::String(FLAGS_udp_host),
-                    op::String(FLAGS_udp_port)};
+                    op::String(FLAGS_udp_port), FLAGS_metrics_port, op::String(FLAGS_trace_file),
+                    op::String(FLAGS_write_binary), FLAGS_write_threads,
+                    op::String(FLAGS_write_video_encoder), op::String(FLAGS_stream_keypoints_udp),
+                    op::String(FLAGS_stream_keypoints_shm), op::String(FLAGS_write_coco_json_eval),
+                    FLAGS_write_jpg_gpu, op::String(FLAGS_stream_video),
+                    op::String(FLAGS_stream_video_encoder), (float)FLAGS_stream_keypoints_precision,
+                    (float)FLAGS_stream_keypoints_precision_3d, FLAGS_stream_keypoints_keyframe,
+                    FLAGS_allocation_metrics, false, op::String(FLAGS_datum_send),
+                    op::flagsToDatumWireFields(op::String(FLAGS_datum_send_fields)), FLAGS_datum_send_jpeg_quality,
+                    FLAGS_datum_timing};
                 opWrapper->configure(wrapperStructOutput);
                 if (synchronousIn) {
                     // SynchronousIn => We need a producer
@@ -187,11 +414,20 @@ namespace op
                     op::String producerString;
                     std::tie(producerType, producerString) = flagsToProducer(
                         op::String(FLAGS_image_dir), op::String(FLAGS_video), op::String(FLAGS_ip_camera), FLAGS_camera,
-                        FLAGS_flir_camera, FLAGS_flir_camera_index);
+                        FLAGS_flir_camera, FLAGS_flir_camera_index, op::String(FLAGS_input_replay),
+                        op::String(FLAGS_shm_input));
                     const WrapperStructInput wrapperStructInput{
                         producerType, producerString, FLAGS_frame_first, FLAGS_frame_step, FLAGS_frame_last,
                         FLAGS_process_real_time, FLAGS_frame_flip, FLAGS_frame_rotate, FLAGS_frames_repeat,
-                        cameraSize, op::String(FLAGS_camera_parameter_path), FLAGS_frame_undistort, FLAGS_3d_views};
+                        cameraSize, op::String(FLAGS_camera_parameter_path), FLAGS_frame_undistort, FLAGS_3d_views,
+                        FLAGS_video_nvdec, FLAGS_image_dir_threads, FLAGS_datum_pool_size,
+                        FLAGS_flir_camera_bayer_gpu, FLAGS_flir_camera_sync_ms,
+                        FLAGS_frame_undistort_keypoints, op::String(FLAGS_input_record),
+                        op::String(FLAGS_input_record_format), FLAGS_video_decoders,
+                        FLAGS_video_segment_frames, FLAGS_image_dir_stream, op::String(FLAGS_input_roi),
+                        op::String(FLAGS_source_priority), op::String(FLAGS_source_max_latency_ms),
+                        FLAGS_decode_ahead, FLAGS_camera_v4l2, FLAGS_camera_v4l2_fps,
+                        op::String(FLAGS_datum_receive), FLAGS_datum_receive_window};
                     opWrapper->configure(wrapperStructInput);
                 }
                 // No GUI. Equivalent to: opWrapper.configure(WrapperStructGui{});
@@ -205,6 +441,18 @@ namespace op
             }
         }
 
+        void warmUp(const std::vector<Point<int>>& inputSizes)
+        {
+            try
+            {
+                opWrapper->warmUp(inputSizes);
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
         void start()
         {
             try
@@ -229,13 +477,29 @@ namespace op
             }
         }
 
+        void reconfigure(
+            const Point<int>& netInputSize, const int face, const int hand, const int blendOriginalFrame,
+            const float alphaKeypoint, const float alphaHeatMap, const int elementToRender)
+        {
+            try
+            {
+                opWrapper->reconfigure(WrapperStructRuntime{
+                    netInputSize, face, hand, blendOriginalFrame, alphaKeypoint, alphaHeatMap, elementToRender});
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
         void exec()
         {
             try
             {
                 // GUI (comment or use default argument to disable any visual output)
                 const WrapperStructGui wrapperStructGui{
-                    flagsToDisplayMode(FLAGS_display, FLAGS_3d), !FLAGS_no_gui_verbose, FLAGS_fullscreen};
+                    flagsToDisplayMode(FLAGS_display, FLAGS_3d), !FLAGS_no_gui_verbose, FLAGS_fullscreen,
+                    FLAGS_display_vsync, FLAGS_display_skip_stale, FLAGS_display_overlay};
                 opWrapper->configure(wrapperStructGui);
                 opWrapper->exec();
             }
@@ -270,7 +534,8 @@ namespace op
         {
             try
             {
-                std::shared_ptr<std::vector<std::shared_ptr<Datum>>> datumsPtr(&l);
+                // The Python list keeps its own Datums, only the shared pointers are copied (not their data)
+                auto datumsPtr = std::make_shared<std::vector<std::shared_ptr<Datum>>>(l);
                 return opWrapper->waitAndEmplace(datumsPtr);
             }
             catch (const std::exception& e)
@@ -297,6 +562,93 @@ namespace op
                 return false;
             }
         }
+
+        // Each Datum of l is an independent frame, processed in place (the GIL is not released, but it returns
+        // immediately). callback(datum) is called on an OpenPose thread once each frame is processed.
+        void emplaceBatch(const std::vector<std::shared_ptr<Datum>>& l, const py::object& callback)
+        {
+            try
+            {
+                // The callback is called and released on an OpenPose thread, so both acquire the GIL
+                const std::shared_ptr<py::object> callbackPtr{
+                    new py::object{callback},
+                    [](py::object* object)
+                    {
+                        py::gil_scoped_acquire gil;
+                        delete object;
+                    }};
+                std::function<void(const std::shared_ptr<std::vector<std::shared_ptr<Datum>>>&)> datumsCallback;
+                if (!callback.is_none())
+                    datumsCallback = [callbackPtr](const std::shared_ptr<std::vector<std::shared_ptr<Datum>>>& datums)
+                    {
+                        py::gil_scoped_acquire gil;
+                        try
+                        {
+                            (*callbackPtr)(datums->at(0));
+                        }
+                        catch (const py::error_already_set& e)
+                        {
+                            opLog("Exception in the emplaceBatch callback: " + std::string{e.what()},
+                                  Priority::High, __LINE__, __FUNCTION__, __FILE__);
+                        }
+                    };
+                opWrapper->emplaceBatch(toDatumsBatch(l), datumsCallback);
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        // Each Datum of l is an independent frame, processed in place. It waits for all of them
+        bool emplaceAndPopBatch(const std::vector<std::shared_ptr<Datum>>& l)
+        {
+            try
+            {
+                auto datumsBatch = toDatumsBatch(l);
+                return opWrapper->emplaceAndPopBatch(datumsBatch);
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return false;
+            }
+        }
+
+        // Streaming API: It returns an iterator over the processed frames (op.Datum, in order) of frames (an iterable of
+        // numpy images or op.Datum), which are fed from a native thread. maxInFlight = 0 uses 2 x GPUs x batch size
+        DatumStream* stream(const py::iterable& frames, const int maxInFlight)
+        {
+            try
+            {
+                if (synchronousIn)
+                    error("The streaming API requires `op.WrapperPython(op.ThreadManagerMode.Asynchronous)`.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                auto finalMaxInFlight = maxInFlight;
+                if (finalMaxInFlight <= 0)
+                {
+                    const auto numberGpus = (FLAGS_num_gpu < 0 ? getGpuNumber() : FLAGS_num_gpu);
+                    finalMaxInFlight = 2 * std::max(1, numberGpus) * std::max(1, FLAGS_batch_size);
+                }
+                return new DatumStream{*opWrapper, frames, (unsigned long long)finalMaxInFlight};
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return nullptr;
+            }
+        }
+
+    private:
+        static std::vector<std::shared_ptr<std::vector<std::shared_ptr<Datum>>>> toDatumsBatch(
+            const std::vector<std::shared_ptr<Datum>>& l)
+        {
+            std::vector<std::shared_ptr<std::vector<std::shared_ptr<Datum>>>> datumsBatch;
+            datumsBatch.reserve(l.size());
+            for (const auto& datum : l)
+                datumsBatch.emplace_back(std::make_shared<std::vector<std::shared_ptr<Datum>>>(1, datum));
+            return datumsBatch;
+        }
     };
 
     std::vector<std::string> getImagesFromDirectory(const std::string& directoryPath)
@@ -340,12 +692,36 @@ namespace op
             .def(py::init<>())
             .def(py::init<ThreadManagerMode>())
             .def("configure", &WrapperPython::configure)
-            .def("start", &WrapperPython::start)
-            .def("stop", &WrapperPython::stop)
-            .def("execute", &WrapperPython::exec)
-            .def("emplaceAndPop", &WrapperPython::emplaceAndPop)
-            .def("waitAndEmplace", &WrapperPython::waitAndEmplace)
-            .def("waitAndPop", &WrapperPython::waitAndPop)
+            // The GIL is released while OpenPose runs, so other Python threads can run (e.g., to feed the
+            // asynchronous wrapper from several threads in parallel)
+            .def("warmUp", &WrapperPython::warmUp, py::arg("inputSizes") = std::vector<Point<int>>{})
+            .def("start", &WrapperPython::start, py::call_guard<py::gil_scoped_release>())
+            .def("stop", &WrapperPython::stop, py::call_guard<py::gil_scoped_release>())
+            .def("reconfigure", &WrapperPython::reconfigure, py::arg("netInputSize") = Point<int>{0, 0},
+                 py::arg("face") = -1, py::arg("hand") = -1, py::arg("blendOriginalFrame") = -1,
+                 py::arg("alphaKeypoint") = -1.f, py::arg("alphaHeatMap") = -1.f, py::arg("elementToRender") = -1)
+            .def("execute", &WrapperPython::exec, py::call_guard<py::gil_scoped_release>())
+            .def("emplaceAndPop", &WrapperPython::emplaceAndPop, py::call_guard<py::gil_scoped_release>())
+            .def("waitAndEmplace", &WrapperPython::waitAndEmplace, py::call_guard<py::gil_scoped_release>())
+            .def("waitAndPop", &WrapperPython::waitAndPop, py::call_guard<py::gil_scoped_release>())
+            .def("emplaceBatch", &WrapperPython::emplaceBatch, py::arg("datums"), py::arg("callback") = py::none())
+            .def("emplaceAndPopBatch", &WrapperPython::emplaceAndPopBatch,
+                 py::call_guard<py::gil_scoped_release>())
+            // The stream keeps the WrapperPython alive
+            .def("stream", &WrapperPython::stream, py::arg("frames"), py::arg("maxInFlight") = 0,
+                 py::return_value_policy::take_ownership, py::keep_alive<0, 1>())
+            ;
+
+        // DatumStream (iterator of WrapperPython.stream())
+        py::class_<DatumStream>(m, "DatumStream")
+            .def("__iter__", [](DatumStream& datumStream) -> DatumStream& { return datumStream; },
+                 py::return_value_policy::reference_internal)
+            .def("__next__", &DatumStream::next)
+            .def("next", &DatumStream::next)
+            .def("close", &DatumStream::close)
+            .def("__enter__", [](DatumStream& datumStream) -> DatumStream& { return datumStream; },
+                 py::return_value_policy::reference_internal)
+            .def("__exit__", [](DatumStream& datumStream, py::args) { datumStream.close(); })
             ;
 
         // ThreadManagerMode
@@ -356,6 +732,21 @@ namespace op
             .value("Synchronous", ThreadManagerMode::Synchronous)
             ;
 
+        // DatumField (bit mask of Datum.fields)
+        py::enum_<DatumField>(m, "DatumField", py::arithmetic())
+            .value("None", DatumField::None)
+            .value("PoseHeatMaps", DatumField::PoseHeatMaps)
+            .value("PoseCandidates", DatumField::PoseCandidates)
+            .value("Face", DatumField::Face)
+            .value("FaceHeatMaps", DatumField::FaceHeatMaps)
+            .value("Hand", DatumField::Hand)
+            .value("HandHeatMaps", DatumField::HandHeatMaps)
+            .value("Keypoints3D", DatumField::Keypoints3D)
+            .value("CameraParameters", DatumField::CameraParameters)
+            .value("Adam", DatumField::Adam)
+            .value("All", DatumField::All)
+            ;
+
         // Datum Object
         py::class_<Datum, std::shared_ptr<Datum>>(m, "Datum")
             .def(py::init<>())
@@ -364,6 +755,17 @@ namespace op
             .def_readwrite("subIdMax", &Datum::subIdMax)
             .def_readwrite("name", &Datum::name)
             .def_readwrite("frameNumber", &Datum::frameNumber)
+            .def_readwrite("sourceId", &Datum::sourceId)
+            .def_readwrite("sourceIdMax", &Datum::sourceIdMax)
+            .def_readwrite("priority", &Datum::priority)
+            // Per-stage timing record (`--datum_timing`), as (stage, begin_ns, end_ns) tuples
+            .def_property_readonly(
+                "timing", [](const Datum& datum) {
+                    std::vector<std::tuple<std::string, long long, long long>> timing;
+                    if (datum.timing != nullptr)
+                        for (const auto& timingEvent : datum.timing->getEvents())
+                            timing.emplace_back(timingEvent.name, timingEvent.beginNs, timingEvent.endNs);
+                    return timing; })
             .def_readwrite("cvInputData", &Datum::cvInputData)
             .def_readwrite("inputNetData", &Datum::inputNetData)
             .def_readwrite("outputData", &Datum::outputData)
@@ -372,8 +774,28 @@ namespace op
             .def_readwrite("poseKeypoints", &Datum::poseKeypoints)
             .def_readwrite("poseIds", &Datum::poseIds)
             .def_readwrite("poseScores", &Datum::poseScores)
-            .def_readwrite("poseHeatMaps", &Datum::poseHeatMaps)
-            .def_readwrite("poseCandidates", &Datum::poseCandidates)
+            .def_readwrite("poseKeypointsReused", &Datum::poseKeypointsReused)
+            // Pending heat maps (`--heatmaps_lazy`) are downloaded when read
+            .def_property(
+                "poseHeatMaps", [](Datum& datum) { return datum.getPoseHeatMaps(); },
+                [](Datum& datum, const Array<float>& poseHeatMaps) {
+                    datum.poseHeatMaps = poseHeatMaps;
+                    datum.poseHeatMapsDownload = nullptr; })
+            // Sparse heat maps (`--heatmaps_sparse_threshold`), as (size, offsets, indices, values, threshold)
+            .def_property_readonly(
+                "poseHeatMapsSparse", [](const Datum& datum) {
+                    const auto& sparse = datum.poseHeatMapsSparse;
+                    return std::make_tuple(
+                        sparse.size, sparse.offsets, sparse.indices, sparse.values, sparse.threshold); })
+            // Nested candidates, built on demand from the flat ones (OpenPose only fills the flat ones)
+            .def_property(
+                "poseCandidates", [](Datum& datum) { return datum.getPoseCandidates(); },
+                [](Datum& datum, const std::vector<std::vector<std::array<float,3>>>& poseCandidates) {
+                    datum.poseCandidates = poseCandidates;
+                    datum.poseCandidatesArray.reset();
+                    datum.poseCandidatesOffsets.clear(); })
+            .def_readwrite("poseCandidatesArray", &Datum::poseCandidatesArray)
+            .def_readwrite("poseCandidatesOffsets", &Datum::poseCandidatesOffsets)
             .def_readwrite("faceRectangles", &Datum::faceRectangles)
             .def_readwrite("faceKeypoints", &Datum::faceKeypoints)
             .def_readwrite("faceHeatMaps", &Datum::faceHeatMaps)
@@ -386,6 +808,10 @@ namespace op
             .def_readwrite("cameraMatrix", &Datum::cameraMatrix)
             .def_readwrite("cameraExtrinsics", &Datum::cameraExtrinsics)
             .def_readwrite("cameraIntrinsics", &Datum::cameraIntrinsics)
+            .def_readwrite("cameraDistortion", &Datum::cameraDistortion)
+            .def_readwrite("inputRoi", &Datum::inputRoi)
+            .def_readwrite("personCrops", &Datum::personCrops)
+            .def_readwrite("personCropMatrices", &Datum::personCropMatrices)
             .def_readwrite("poseNetOutput", &Datum::poseNetOutput)
             .def_readwrite("scaleInputToNetInputs", &Datum::scaleInputToNetInputs)
             .def_readwrite("netInputSizes", &Datum::netInputSizes)
@@ -393,6 +819,9 @@ namespace op
             .def_readwrite("netOutputSize", &Datum::netOutputSize)
             .def_readwrite("scaleNetToOutput", &Datum::scaleNetToOutput)
             .def_readwrite("elementRendered", &Datum::elementRendered)
+            // Field manifest of the pipeline: the disabled fields are always empty
+            .def_readwrite("fields", &Datum::fields)
+            .def("hasField", &Datum::hasField)
             ;
 
         py::bind_vector<std::vector<std::shared_ptr<Datum>>>(m, "VectorDatum");
@@ -417,6 +846,51 @@ namespace op
             .def_readwrite("y", &Point<int>::y)
             ;
 
+        // Binary keypoint file reader (`--write_binary`)
+        py::class_<KeypointBinaryReader>(m, "KeypointBinaryReader")
+            .def(py::init<const std::string&>())
+            .def("getNumberFrames", &KeypointBinaryReader::getNumberFrames)
+            .def("getFrameIndex", &KeypointBinaryReader::getFrameIndex,
+                 py::arg("frameId"), py::arg("sourceId") = 0ull)
+            .def("readFrame", [](const KeypointBinaryReader& keypointBinaryReader,
+                                 const unsigned long long frameIndex)
+                {
+                    auto datumPtr = std::make_shared<Datum>();
+                    keypointBinaryReader.readFrame(*datumPtr, frameIndex);
+                    return datumPtr;
+                })
+            ;
+
+        // Keypoint streaming (`--stream_keypoints_udp`, `--stream_keypoints_shm`)
+        py::class_<KeypointStreamReader>(m, "KeypointStreamReader")
+            .def(py::init<const std::string&>())
+            .def("readLatest", [](KeypointStreamReader& keypointStreamReader) -> py::object
+                {
+                    auto datumPtr = std::make_shared<Datum>();
+                    if (!keypointStreamReader.readLatest(*datumPtr))
+                        return py::none();
+                    return py::cast(datumPtr);
+                })
+            ;
+        py::class_<KeypointPacketDecoder>(m, "KeypointPacketDecoder")
+            .def(py::init<>())
+            .def("decode", [](KeypointPacketDecoder& keypointPacketDecoder, const py::bytes& packet)
+                {
+                    // The compressed keypoints referring to a lost packet are empty until the next keyframe
+                    const std::string packetString = packet;
+                    auto datumPtr = std::make_shared<Datum>();
+                    keypointPacketDecoder.decode(*datumPtr, packetString.data(), packetString.size());
+                    return datumPtr;
+                })
+            ;
+        m.def("keypointPacketToDatum", [](const py::bytes& packet)
+            {
+                const std::string packetString = packet;
+                auto datumPtr = std::make_shared<Datum>();
+                keypointPacketToDatum(*datumPtr, packetString.data(), packetString.size());
+                return datumPtr;
+            });
+
         #ifdef VERSION_INFO
             m.attr("__version__") = VERSION_INFO;
         #else
@@ -425,6 +899,50 @@ namespace op
     }
 }
 
+// Numpy - OpenPose zero-copy helpers
+namespace pybind11 { namespace detail {
+
+// It keeps a reference to the numpy array until the last op::Array or op::Matrix wrapping its memory is released.
+// That might happen in an OpenPose thread, so the GIL is acquired to release it.
+inline std::shared_ptr<void> getNumpyOwner(const array& numpyArray)
+{
+    return std::shared_ptr<void>(
+        numpyArray.inc_ref().ptr(),
+        [](void* pyObject)
+        {
+            if (Py_IsInitialized())
+            {
+                gil_scoped_acquire gil;
+                Py_DECREF((PyObject*)pyObject);
+            }
+        });
+}
+
+// Numpy view (no copy) of the memory of an op::Array or op::Matrix. The numpy array keeps a (shallow) copy of it, so
+// its memory remains valid while the numpy array exists.
+template <typename TScalar, typename TOwner>
+handle getNumpyView(
+    const TOwner& owner, const void* const dataPtr, const std::vector<size_t>& shape,
+    const std::vector<size_t>& strides)
+{
+    auto* const ownerCopy = new TOwner(owner);
+    const capsule base(ownerCopy, [](void* ownerPtr) { delete (TOwner*)ownerPtr; });
+    return array(dtype::of<TScalar>(), shape, strides, dataPtr, base).release();
+}
+
+template <typename T>
+handle getNumpyView(const op::Array<T>& opArray)
+{
+    if (opArray.getSize().size() == 0)
+        return none().release();
+    const auto sizes = opArray.getSize();
+    const auto stridesInt = opArray.getStride();
+    const std::vector<size_t> shape(sizes.begin(), sizes.end());
+    const std::vector<size_t> strides(stridesInt.begin(), stridesInt.end());
+    return getNumpyView<T>(opArray, opArray.getPseudoConstPtr(), shape, strides);
+}
+}} // namespace pybind11::detail
+
 // Numpy - op::Array<float> interop
 namespace pybind11 { namespace detail {
 
@@ -439,21 +957,19 @@ template <> struct type_caster<op::Array<float>> {
             try
             {
                 UNUSED(imp);
-                // array b(src, true);
-                array b = reinterpret_borrow<array>(src);
+                // C-contiguous numpy arrays are not copied (others are copied into a contiguous one)
+                array b = array::ensure(src, array::c_style);
+                if (!b)
+                    return false;
                 buffer_info info = b.request();
 
                 if (info.format != format_descriptor<float>::format())
                     op::error("op::Array only supports float32 now", __LINE__, __FUNCTION__, __FILE__);
 
-                //std::vector<int> a(info.shape);
                 std::vector<int> shape(std::begin(info.shape), std::end(info.shape));
 
-                // No copy
-                value = op::Array<float>(shape, (float*)info.ptr);
-                // Copy
-                //value = op::Array<float>(shape);
-                //memcpy(value.getPtr(), info.ptr, value.getVolume()*sizeof(float));
+                // No copy, and the numpy array is kept alive while value (or any copy of it) exists
+                value.reset(shape, (float*)info.ptr, getNumpyOwner(b));
 
                 return true;
             }
@@ -464,22 +980,11 @@ template <> struct type_caster<op::Array<float>> {
             }
         }
 
-        // Cast op::Array<float> to numpy
+        // Cast op::Array<float> to numpy (view sharing its memory, use numpy.copy() to keep a snapshot)
         static handle cast(const op::Array<float> &m, return_value_policy, handle defval)
         {
             UNUSED(defval);
-            if (m.getSize().size() == 0) {
-                return none();
-            }
-            std::string format = format_descriptor<float>::format();
-            return array(buffer_info(
-                m.getPseudoConstPtr(),/* Pointer to buffer */
-                sizeof(float),        /* Size of one scalar */
-                format,               /* Python struct-style format descriptor */
-                m.getSize().size(),   /* Number of dimensions */
-                m.getSize(),          /* Buffer dimensions */
-                m.getStride()         /* Strides (in bytes) for each index */
-                )).release();
+            return getNumpyView(m);
         }
 
     };
@@ -500,22 +1005,11 @@ template <> struct type_caster<op::Array<long long>> {
             return false;
         }
 
-        // Cast op::Array<long long> to numpy
+        // Cast op::Array<long long> to numpy (view sharing its memory, use numpy.copy() to keep a snapshot)
         static handle cast(const op::Array<long long> &m, return_value_policy, handle defval)
         {
             UNUSED(defval);
-            if (m.getSize().size() == 0) {
-                return none();
-            }
-            std::string format = format_descriptor<long long>::format();
-            return array(buffer_info(
-                m.getPseudoConstPtr(),/* Pointer to buffer */
-                sizeof(long long),    /* Size of one scalar */
-                format,               /* Python struct-style format descriptor */
-                m.getSize().size(),   /* Number of dimensions */
-                m.getSize(),          /* Buffer dimensions */
-                m.getStride()         /* Strides (in bytes) for each index */
-                )).release();
+            return getNumpyView(m);
         }
 
     };
@@ -532,101 +1026,60 @@ template <> struct type_caster<op::Matrix> {
         // Cast numpy to op::Matrix
         bool load(handle src, bool)
         {
-            /* Try a default converting into a Python */
-            //array b(src, true);
-            array b = reinterpret_borrow<array>(src);
+            // C-contiguous numpy arrays are not copied (others are copied into a contiguous one)
+            array b = array::ensure(src, array::c_style);
+            if (!b)
+                return false;
             buffer_info info = b.request();
 
             const int ndims = (int)info.ndim;
+            if (ndims != 2 && ndims != 3)
+                throw std::logic_error("Only 2-D (rows x cols) or 3-D (rows x cols x channels) arrays are supported");
 
-            decltype(CV_32F) dtype;
-            size_t elemsize;
+            int depth;
             if (info.format == format_descriptor<float>::format())
-            {
-                if (ndims == 3)
-                    dtype = CV_32FC3;
-                else
-                    dtype = CV_32FC1;
-                elemsize = sizeof(float);
-            }
+                depth = CV_32F;
             else if (info.format == format_descriptor<double>::format())
-            {
-                if (ndims == 3)
-                    dtype = CV_64FC3;
-                else
-                    dtype = CV_64FC1;
-                elemsize = sizeof(double);
-            }
+                depth = CV_64F;
             else if (info.format == format_descriptor<unsigned char>::format())
-            {
-                if (ndims == 3)
-                    dtype = CV_8UC3;
-                else
-                    dtype = CV_8UC1;
-                elemsize = sizeof(unsigned char);
-            }
+                depth = CV_8U;
             else
             {
                 throw std::logic_error("Unsupported type");
                 return false;
             }
+            const auto channels = (ndims == 3 ? (int)info.shape[2] : 1);
 
-            std::vector<int> shape = {(int)info.shape[0], (int)info.shape[1]};
-
-            value = op::Matrix(shape[0], shape[1], dtype, info.ptr);
-            // value = cv::Mat(cv::Size(shape[1], shape[0]), dtype, info.ptr, cv::Mat::AUTO_STEP);
+            // No copy, and the numpy array is kept alive while value (or any copy of it) exists
+            value = op::Matrix(
+                (int)info.shape[0], (int)info.shape[1], CV_MAKETYPE(depth, channels), info.ptr, getNumpyOwner(b));
             return true;
         }
 
-        // Cast op::Matrix to numpy
+        // Cast op::Matrix to numpy (view sharing its memory, use numpy.copy() to keep a snapshot)
         static handle cast(const op::Matrix &matrix, return_value_policy, handle defval)
         {
             UNUSED(defval);
-            std::string format = format_descriptor<unsigned char>::format();
-            size_t elemsize = sizeof(unsigned char);
-            int dim;
-            switch(matrix.type()) {
+            const auto elemSize1 = matrix.elemSize1();
+            const auto channels = (size_t)matrix.channels();
+            // Rows might be padded (e.g., a ROI of a larger image), so step1() is used rather than cols
+            std::vector<size_t> shape{(size_t)matrix.rows(), (size_t)matrix.cols()};
+            std::vector<size_t> strides{matrix.step1(0) * elemSize1, channels * elemSize1};
+            if (channels > 1)
+            {
+                shape.emplace_back(channels);
+                strides.emplace_back(elemSize1);
+            }
+            switch(matrix.depth()) {
                 case CV_8U:
-                    format = format_descriptor<unsigned char>::format();
-                    elemsize = sizeof(unsigned char);
-                    dim = 2;
-                    break;
-                case CV_8UC3:
-                    format = format_descriptor<unsigned char>::format();
-                    elemsize = sizeof(unsigned char);
-                    dim = 3;
-                    break;
+                    return getNumpyView<unsigned char>(matrix, matrix.dataPseudoConst(), shape, strides);
                 case CV_32F:
-                    format = format_descriptor<float>::format();
-                    elemsize = sizeof(float);
-                    dim = 2;
-                    break;
+                    return getNumpyView<float>(matrix, matrix.dataPseudoConst(), shape, strides);
                 case CV_64F:
-                    format = format_descriptor<double>::format();
-                    elemsize = sizeof(double);
-                    dim = 2;
-                    break;
+                    return getNumpyView<double>(matrix, matrix.dataPseudoConst(), shape, strides);
                 default:
                     throw std::logic_error("Unsupported type");
             }
-
-            std::vector<size_t> bufferdim;
-            std::vector<size_t> strides;
-            if (dim == 2) {
-                bufferdim = {(size_t) matrix.rows(), (size_t) matrix.cols()};
-                strides = {elemsize * (size_t) matrix.cols(), elemsize};
-            } else if (dim == 3) {
-                bufferdim = {(size_t) matrix.rows(), (size_t) matrix.cols(), (size_t) 3};
-                strides = {(size_t) elemsize * matrix.cols() * 3, (size_t) elemsize * 3, (size_t) elemsize};
-            }
-            return array(buffer_info(
-                matrix.dataPseudoConst(),   /* Pointer to buffer */
-                elemsize,                   /* Size of one scalar */
-                format,                     /* Python struct-style format descriptor */
-                dim,                        /* Number of dimensions */
-                bufferdim,                  /* Buffer dimensions */
-                strides                     /* Strides (in bytes) for each index */
-                )).release();
         }
 
     };
@@ -0,0 +1,27 @@
+import asyncio
+
+
+async def stream_async(opWrapper, frames, maxInFlight=0):
+    """Asynchronous generator version of opWrapper.stream(frames, maxInFlight).
+
+    Each result is awaited in the default executor of the running event loop, so the loop keeps running while
+    OpenPose processes the frames (the wrapper releases the GIL while it waits).
+    """
+    loop = asyncio.get_event_loop()
+    stream = opWrapper.stream(frames, maxInFlight)
+    try:
+        while True:
+            datum = await loop.run_in_executor(None, _next_or_none, stream)
+            if datum is None:
+                return
+            yield datum
+    finally:
+        await loop.run_in_executor(None, stream.close)
+
+
+def _next_or_none(stream):
+    # StopIteration cannot be raised through a Future
+    try:
+        return next(stream)
+    except StopIteration:
+        return None
@@ -4,6 +4,11 @@
     #include <opencv2/calib3d.hpp> // cv::initUndistortRectifyMap in OpenCV 4
 #endif
 #include <opencv2/imgproc/imgproc.hpp> // cv::initUndistortRectifyMap (OpenCV <= 3), cv::undistort
+#include <mutex>
+#ifdef USE_CUDA
+    #include <cuda_runtime.h>
+    #include <openpose/gpu/cuda.hpp>
+#endif
 #include <openpose/filestream/fileStream.hpp>
 #include <openpose/utilities/fileSystem.hpp>
 
@@ -17,16 +22,36 @@ namespace op
         std::vector<Matrix> mCameraIntrinsics;
         std::vector<Matrix> mCameraExtrinsics;
         std::vector<Matrix> mCameraExtrinsicsInitial;
+        // Static regions of interest (optional, empty for the whole image)
+        std::vector<std::vector<Point<int>>> mInputRois;
 
         // Undistortion (optional)
         bool mUndistortImage;
         std::vector<cv::Mat> mRemoveDistortionMaps1;
         std::vector<cv::Mat> mRemoveDistortionMaps2;
+        std::vector<cv::Size> mRemoveDistortionMapSizes;
+        // GPU remap tables (see getUndistortMapGpu())
+        std::mutex mUndistortMapGpuMutex;
+        std::vector<std::shared_ptr<float>> mUndistortMapsGpu;
+        std::vector<cv::Size> mUndistortMapGpuSizes;
+        std::vector<int> mUndistortMapGpuIds;
 
         ImplCameraParameterReader(const bool undistortImage) :
             mUndistortImage{undistortImage}
         {
         }
+
+        // 1 (lazily filled) set of remap tables per camera
+        void resizeUndistortionMaps(const unsigned long long numberCameras)
+        {
+            mRemoveDistortionMaps1.resize(numberCameras);
+            mRemoveDistortionMaps2.resize(numberCameras);
+            mRemoveDistortionMapSizes.resize(numberCameras);
+            const std::lock_guard<std::mutex> lock{mUndistortMapGpuMutex};
+            mUndistortMapsGpu.resize(numberCameras);
+            mUndistortMapGpuSizes.resize(numberCameras);
+            mUndistortMapGpuIds.resize(numberCameras, -1);
+        }
     };
 
     CameraParameterReader::CameraParameterReader() :
@@ -69,12 +94,12 @@ namespace op
             // Otherwise, add cv::eye
             else
                 spImpl->mCameraExtrinsicsInitial.emplace_back(Matrix::eye(3, 4, cameraIntrinsics.type()));;
+            spImpl->mInputRois.emplace_back();
             const cv::Mat cvCameraMatrices = OP_OP2CVCONSTMAT(spImpl->mCameraIntrinsics.back()) * OP_OP2CVCONSTMAT(spImpl->mCameraExtrinsics.back());
             const Matrix opCameraMatrices = OP_CV2OPCONSTMAT(cvCameraMatrices);
             spImpl->mCameraMatrices.emplace_back(opCameraMatrices);
             // Undistortion Mats
-            spImpl->mRemoveDistortionMaps1.resize(getNumberCameras());
-            spImpl->mRemoveDistortionMaps2.resize(getNumberCameras());
+            spImpl->resizeUndistortionMaps(getNumberCameras());
         }
         catch (const std::exception& e)
         {
@@ -109,11 +134,14 @@ namespace op
             spImpl->mCameraIntrinsics.clear();
             spImpl->mCameraExtrinsics.clear();
             spImpl->mCameraExtrinsicsInitial.clear();
+            spImpl->mInputRois.clear();
             // opLog("Camera matrices:");
             for (auto i = 0ull ; i < spImpl->mSerialNumbers.size() ; i++)
             {
                 const auto parameterPath = cameraParameterPath + spImpl->mSerialNumbers.at(i);
-                const auto opCameraParameters = loadData(cvMatNames, parameterPath, dataFormat);
+                auto cvMatNamesAndRoi = cvMatNames;
+                cvMatNamesAndRoi.emplace_back("InputRoi");
+                const auto opCameraParameters = loadData(cvMatNamesAndRoi, parameterPath, dataFormat);
                 OP_OP2CVVECTORMAT(cameraParameters, opCameraParameters)
                 // Error if empty element
                 if (cameraParameters.empty() || cameraParameters.at(0).empty()
@@ -145,14 +173,30 @@ namespace op
                 spImpl->mCameraIntrinsics.emplace_back(opCameraParameters.at(1));
                 spImpl->mCameraDistortions.emplace_back(opCameraParameters.at(2));
                 spImpl->mCameraExtrinsicsInitial.emplace_back(opCameraParameters.at(3));
+                // Optional static region of interest: #points x 2 (x,y) matrix
+                spImpl->mInputRois.emplace_back();
+                const cv::Mat cvInputRoi = OP_OP2CVCONSTMAT(opCameraParameters.at(4));
+                if (!cvInputRoi.empty())
+                {
+                    cv::Mat cvInputRoiDouble;
+                    cvInputRoi.convertTo(cvInputRoiDouble, CV_64F);
+                    if (cvInputRoiDouble.cols != 2 || cvInputRoiDouble.rows < 2)
+                        error("The InputRoi of the camera with serial number `" + spImpl->mSerialNumbers[i]
+                              + "` (file: " + parameterPath + "." + dataFormatToString(dataFormat) + ") must be a"
+                              " #points x 2 (x,y) matrix with at least 2 points (rectangle corners).",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    for (auto row = 0 ; row < cvInputRoiDouble.rows ; row++)
+                        spImpl->mInputRois.back().emplace_back(Point<int>{
+                            cvRound(cvInputRoiDouble.at<double>(row, 0)),
+                            cvRound(cvInputRoiDouble.at<double>(row, 1))});
+                }
                 const cv::Mat cvCameraMatrices = OP_OP2CVCONSTMAT(spImpl->mCameraIntrinsics.back()) * OP_OP2CVCONSTMAT(spImpl->mCameraExtrinsics.back());
                 const Matrix opCameraMatrices = OP_CV2OPCONSTMAT(cvCameraMatrices);
                 spImpl->mCameraMatrices.emplace_back(opCameraMatrices);
                 // opLog(cameraParameters.at(0));
             }
             // Undistortion Mats
-            spImpl->mRemoveDistortionMaps1.resize(getNumberCameras());
-            spImpl->mRemoveDistortionMaps2.resize(getNumberCameras());
+            spImpl->resizeUndistortionMaps(getNumberCameras());
             // // spImpl->mCameraMatrices
             // opLog("\nFull camera matrices:");
             // for (const auto& cvMat : spImpl->mCameraMatrices)
@@ -309,6 +353,19 @@ namespace op
         }
     }
 
+    const std::vector<std::vector<Point<int>>>& CameraParameterReader::getInputRois() const
+    {
+        try
+        {
+            return spImpl->mInputRois;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return spImpl->mInputRois;
+        }
+    }
+
     bool CameraParameterReader::getUndistortImage() const
     {
         try
@@ -347,15 +404,15 @@ namespace op
                     error("Variable cameraIndex is out of bounds, it should be smaller than spImpl->mRemoveDistortionMapsX.",
                           __LINE__, __FUNCTION__, __FILE__);
                 }
-                // Only first time
+                // Only first time (or if the resolution of the frames of this camera changed)
+                cv::Size imageSize;
+                OP_CONST_MAT_RETURN_FUNCTION(imageSize, frame, size()); // = frame.size();
                 if (spImpl->mRemoveDistortionMaps1[cameraIndex].empty()
-                    || spImpl->mRemoveDistortionMaps2[cameraIndex].empty())
+                    || spImpl->mRemoveDistortionMaps2[cameraIndex].empty()
+                    || spImpl->mRemoveDistortionMapSizes[cameraIndex] != imageSize)
                 {
-                    const auto cvCameraIntrinsics = OP_OP2CVCONSTMAT(spImpl->mCameraIntrinsics.at(0));
-                    const auto cvCameraDistorsions = OP_OP2CVCONSTMAT(spImpl->mCameraDistortions.at(0));
-                    //const auto imageSize = OP_OP2CVMAT(frame).size();
-                    cv::Size imageSize;
-                    OP_CONST_MAT_RETURN_FUNCTION(imageSize, frame, size()); // = frame.size();
+                    const auto cvCameraIntrinsics = OP_OP2CVCONSTMAT(spImpl->mCameraIntrinsics.at(cameraIndex));
+                    const auto cvCameraDistorsions = OP_OP2CVCONSTMAT(spImpl->mCameraDistortions.at(cameraIndex));
                     // // Option a - 80 ms / 3 images
                     // // http://docs.opencv.org/2.4/modules/imgproc/doc/geometric_transformations.html#undistort
                     // cv::undistort(cvMatDistorted, mCvMats[i], cvCameraIntrinsics, cvCameraDistorsions);
@@ -379,6 +436,7 @@ namespace op
                         // CV_32FC1, // More accurate
                         spImpl->mRemoveDistortionMaps1[cameraIndex],
                         spImpl->mRemoveDistortionMaps2[cameraIndex]);
+                    spImpl->mRemoveDistortionMapSizes[cameraIndex] = imageSize;
                 }
                 cv::Mat undistortedCvMat;
                 const cv::Mat cvFrame = OP_OP2CVCONSTMAT(frame);
@@ -397,4 +455,71 @@ namespace op
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
         }
     }
+
+    std::shared_ptr<float> CameraParameterReader::getUndistortMapGpu(
+        const unsigned int cameraIndex, const int width, const int height, const int gpuId)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                const std::lock_guard<std::mutex> lock{spImpl->mUndistortMapGpuMutex};
+                // Sanity check
+                if (spImpl->mUndistortMapsGpu.size() <= cameraIndex)
+                    error("Variable cameraIndex is out of bounds, it should be smaller than the number of cameras.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                // Only first time (or if the resolution or GPU changed)
+                const cv::Size imageSize{width, height};
+                if (spImpl->mUndistortMapsGpu[cameraIndex] == nullptr
+                    || spImpl->mUndistortMapGpuSizes[cameraIndex] != imageSize
+                    || spImpl->mUndistortMapGpuIds[cameraIndex] != gpuId)
+                {
+                    // Same map than undistort(), but as absolute floating (x, y) source coordinates, so the GPU
+                    // kernels can interpolate it at any (i.e., resized) target pixel
+                    const auto cvCameraIntrinsics = OP_OP2CVCONSTMAT(spImpl->mCameraIntrinsics.at(cameraIndex));
+                    const auto cvCameraDistorsions = OP_OP2CVCONSTMAT(spImpl->mCameraDistortions.at(cameraIndex));
+                    cv::Mat undistortMap;
+                    cv::Mat undistortMapEmpty;
+                    cv::initUndistortRectifyMap(
+                        cvCameraIntrinsics, cvCameraDistorsions, cv::Mat(), cvCameraIntrinsics, imageSize, CV_32FC2,
+                        undistortMap, undistortMapEmpty);
+                    // Upload it
+                    int currentGpuId;
+                    cudaGetDevice(&currentGpuId);
+                    cudaSetDevice(gpuId);
+                    const auto mapBytes = sizeof(float) * 2ull * width * height;
+                    float* undistortMapGpuPtr;
+                    cudaMalloc((void**)&undistortMapGpuPtr, mapBytes);
+                    cudaMemcpy(undistortMapGpuPtr, undistortMap.ptr<float>(), mapBytes, cudaMemcpyHostToDevice);
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    cudaSetDevice(currentGpuId);
+                    // Released (in its GPU) once the last FrameGpu using it is destroyed
+                    spImpl->mUndistortMapsGpu[cameraIndex] = std::shared_ptr<float>{
+                        undistortMapGpuPtr,
+                        [gpuId](float* gpuPtr)
+                        {
+                            int currentGpuId;
+                            cudaGetDevice(&currentGpuId);
+                            cudaSetDevice(gpuId);
+                            cudaFree(gpuPtr);
+                            cudaSetDevice(currentGpuId);
+                        }};
+                    spImpl->mUndistortMapGpuSizes[cameraIndex] = imageSize;
+                    spImpl->mUndistortMapGpuIds[cameraIndex] = gpuId;
+                }
+                return spImpl->mUndistortMapsGpu[cameraIndex];
+            #else
+                UNUSED(cameraIndex);
+                UNUSED(width);
+                UNUSED(height);
+                UNUSED(gpuId);
+                error("GPU undistortion requires the CUDA version of OpenPose.", __LINE__, __FUNCTION__, __FILE__);
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
 }
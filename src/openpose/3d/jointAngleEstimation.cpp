@@ -1,5 +1,6 @@
 #ifdef USE_3D_ADAM_MODEL
 #include <openpose/3d/jointAngleEstimation.hpp>
+#include <mutex>
 #ifdef USE_3D_ADAM_MODEL
     #include <adam/FitToBody.h>
     #include <adam/totalmodel.h>
@@ -15,6 +16,23 @@ namespace op
         const int NUMBER_FOOT_KEYPOINTS = 3;
         // targetJoints: Only for Body, LHand, RHand. No Face, no Foot
         const int NUMBER_KEYPOINTS = 3*(NUMBER_BODY_KEYPOINTS + 2*NUMBER_HAND_KEYPOINTS);
+        // A mid-hip further than this (in cm) from the warm start (e.g., a different person) is fully re-initialized
+        const double ADAM_WARM_START_MAX_DISTANCE_CM = 30.;
+        // Warm-started frames between 2 full initializations, so the fitting does not drift into a local minimum
+        const auto ADAM_WARM_START_MAX_FRAMES = 100u;
+
+        // Warm start shared by all the IK threads (`ik_threads`), i.e., the latest fitted frame of any of them. With
+        // a single per-thread state, each thread would start from a frame `ik_threads` frames older
+        struct AdamWarmStart
+        {
+            std::mutex mutex;
+            bool valid = false;
+            unsigned int frames = 0u;
+            smpl::SMPLParams frameParams;
+            Eigen::Matrix<double, Eigen::Dynamic, 1> vtVec;
+            Eigen::Matrix<double, Eigen::Dynamic, 1> j0Vec;
+        };
+        AdamWarmStart sAdamWarmStart;
 
         const std::shared_ptr<const TotalModel> loadTotalModel(const std::string& mObjectPath,
                                                                const std::string& mGTotalModelPath,
@@ -75,7 +93,6 @@ namespace op
 
             // Processing
             const bool mReturnJacobian;
-            bool mInitialized;
 
             Eigen::MatrixXd mBodyJoints;
             Eigen::MatrixXd mFaceJoints;
@@ -84,12 +101,7 @@ namespace op
             Eigen::MatrixXd mLFootJoints;
             Eigen::MatrixXd mRFootJoints;
 
-            // Other parameters
-            smpl::SMPLParams mFrameParams;
-
             // Shared parameters
-            Eigen::Matrix<double, Eigen::Dynamic, 1> mVtVec;
-            Eigen::Matrix<double, Eigen::Dynamic, 1> mJ0Vec;
             const std::shared_ptr<const TotalModel> spTotalModel;
 
             ImplJointAngleEstimation(const bool returnJacobian) :
@@ -98,7 +110,6 @@ namespace op
                 mObjectPath{"./model/mesh_nofeet.obj"},
                 mCorrespondencePath{"./model/correspondences_nofeet.txt"},
                 mReturnJacobian{returnJacobian},
-                mInitialized{false},
                 mBodyJoints(5, NUMBER_BODY_KEYPOINTS),
                 mFaceJoints(5, NUMBER_FACE_KEYPOINTS),// (3, landmarks_face.size());
                 mLHandJoints(5, NUMBER_HAND_KEYPOINTS),// (3, HandModel::NUM_JOINTS);
@@ -203,7 +214,7 @@ namespace op
         }
     }
 
-    void JointAngleEstimation::~JointAngleEstimation()
+    JointAngleEstimation::~JointAngleEstimation()
     {
     }
 
@@ -227,8 +238,6 @@ namespace op
                 error("Only working for BODY_19 or BODY_25 (#parts = "
                       + std::to_string(poseKeypoints3D.getSize(2)) + ").",
                       __LINE__, __FUNCTION__, __FILE__);
-            // Shorter naming
-            auto& frameParams = spImpl->mFrameParams;
             // If keypoints detected
             if (!poseKeypoints3D.empty())
             {
@@ -307,26 +316,43 @@ namespace op
                 spImpl->mLFootJoints *= 1e2;
                 spImpl->mRFootJoints *= 1e2;
 
-                // Initialization (e.g., first frame)
-                const bool fastVersion = false;
                 const bool freezeMissing = true;
                 const bool ceresDisplayReport = false;
-                // Fill Datum
-                if (!spImpl->mInitialized || !fastVersion)
+                // Warm start from the latest fitted frame, unless there is none (e.g., first frame or the person was
+                // lost), the person moved too far away from it (e.g., a different person), or it has been used for
+                // too many consecutive frames
+                smpl::SMPLParams frameParams;
+                auto warmStart = false;
                 {
-                    if (!spImpl->mInitialized)
+                    const std::lock_guard<std::mutex> lock{sAdamWarmStart.mutex};
+                    if (sAdamWarmStart.valid)
                     {
-                        frameParams.m_adam_t(0) = spImpl->mBodyJoints(0, 2);
-                        frameParams.m_adam_t(1) = spImpl->mBodyJoints(1, 2);
-                        frameParams.m_adam_t(2) = spImpl->mBodyJoints(2, 2);
-                        frameParams.m_adam_pose(0, 0) = 3.14159265358979323846264338327950288419716939937510582097494459;
-                        spImpl->mInitialized = true;
+                        frameParams = sAdamWarmStart.frameParams;
+                        const Eigen::Vector3d midHip{
+                            spImpl->mBodyJoints(0, 2), spImpl->mBodyJoints(1, 2), spImpl->mBodyJoints(2, 2)};
+                        warmStart = sAdamWarmStart.frames < ADAM_WARM_START_MAX_FRAMES
+                            && (frameParams.m_adam_t - midHip).norm() < ADAM_WARM_START_MAX_DISTANCE_CM
+                            && (!spImpl->mReturnJacobian || sAdamWarmStart.vtVec.size() > 0);
+                        if (warmStart && spImpl->mReturnJacobian)
+                        {
+                            vtVec = sAdamWarmStart.vtVec;
+                            j0Vec = sAdamWarmStart.j0Vec;
+                        }
                     }
+                }
+                // Initialization (e.g., first frame)
+                if (!warmStart)
+                {
                     // We make T-pose start with:
                     // 1. Root translation similar to current 3-d location of the mid-hip
                     // 2. x-orientation = 180, i.e., person standing up & looking to the camera
                     // 3. Because otherwise, if we call Adam_FastFit_Initialize twice (e.g., if a new person appears),
                     // it would use the latest ones from the last Adam_FastFit
+                    frameParams = smpl::SMPLParams{};
+                    frameParams.m_adam_t(0) = spImpl->mBodyJoints(0, 2);
+                    frameParams.m_adam_t(1) = spImpl->mBodyJoints(1, 2);
+                    frameParams.m_adam_t(2) = spImpl->mBodyJoints(2, 2);
+                    frameParams.m_adam_pose(0, 0) = 3.14159265358979323846264338327950288419716939937510582097494459;
                     // Fit initialization
                     // Adam_FastFit_Initialize only changes frameParams
                     const auto multistageFitting = true;
@@ -338,30 +364,33 @@ namespace op
                                             spImpl->mLFootJoints, spImpl->mRHandJoints, spImpl->mLHandJoints,
                                             spImpl->mFaceJoints, freezeMissing, ceresDisplayReport,
                                             multistageFitting, handEnabled, fitFaceExponents, fastSolver);
-                    // The following 2 operations takes ~12 msec
+                    // The following 2 operations takes ~12 msec, so they are only computed on initialization (the
+                    // shape coefficients are not changed by Adam_FastFit)
                     if (spImpl->mReturnJacobian)
                     {
                         vtVec = spImpl->spTotalModel->m_meanshape
                               + spImpl->spTotalModel->m_shapespace_u * frameParams.m_adam_coeffs;
                         j0Vec = spImpl->spTotalModel->J_mu_ + spImpl->spTotalModel->dJdc_ * frameParams.m_adam_coeffs;
-                        if (fastVersion)
-                        {
-                            spImpl->mVtVec = vtVec;
-                            spImpl->mJ0Vec = j0Vec;
-                        }
                     }
                 }
-                // Other frames if fastVersion
-                else // if (spImpl->mInitialized && fastVersion)
+                // Other frames: single-stage fitting from the warm start, which converges in a few iterations
+                else
                 {
                     // Adam_FastFit only changes frameParams
                     Adam_FastFit(*spImpl->spTotalModel, frameParams, spImpl->mBodyJoints, spImpl->mRFootJoints,
                                  spImpl->mLFootJoints, spImpl->mRHandJoints, spImpl->mLHandJoints,
                                  spImpl->mFaceJoints, ceresDisplayReport);
-                    if (spImpl->mReturnJacobian)
+                }
+                // Update warm start
+                {
+                    const std::lock_guard<std::mutex> lock{sAdamWarmStart.mutex};
+                    sAdamWarmStart.valid = true;
+                    sAdamWarmStart.frames = (warmStart ? sAdamWarmStart.frames + 1u : 0u);
+                    sAdamWarmStart.frameParams = frameParams;
+                    if (!warmStart && spImpl->mReturnJacobian)
                     {
-                        vtVec = spImpl->mVtVec;
-                        j0Vec = spImpl->mJ0Vec;
+                        sAdamWarmStart.vtVec = vtVec;
+                        sAdamWarmStart.j0Vec = j0Vec;
                     }
                 }
                 adamPose = frameParams.m_adam_pose;
@@ -370,8 +399,12 @@ namespace op
                 // // Not used anymore
                 // frameParams.mouth_open, frameParams.reye_open, frameParams.leye_open, frameParams.dist_root_foot
             }
+            // Person lost, the next one is fully initialized
             else
-                spImpl->mInitialized = false;
+            {
+                const std::lock_guard<std::mutex> lock{sAdamWarmStart.mutex};
+                sAdamWarmStart.valid = false;
+            }
         }
         catch (const std::exception& e)
         {
@@ -0,0 +1,309 @@
+#include <openpose/3d/poseAssociation.hpp>
+#include <algorithm> // std::count_if, std::sort, std::stable_sort, std::upper_bound
+#include <limits>
+#include <opencv2/core/core.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose_private/3d/poseTriangulationPrivate.hpp>
+#include <openpose_private/utilities/parallelFor.hpp>
+
+namespace op
+{
+    namespace
+    {
+        cv::Mat getFundamentalMatrixCv(const cv::Mat& cameraMatrix0, const cv::Mat& cameraMatrix1)
+        {
+            try
+            {
+                // Sanity check
+                if (cameraMatrix0.rows != 3 || cameraMatrix0.cols != 4
+                    || cameraMatrix1.rows != 3 || cameraMatrix1.cols != 4)
+                    error("The camera matrices must be 3x4.", __LINE__, __FUNCTION__, __FILE__);
+                cv::Mat cameraMatrix0Double;
+                cv::Mat cameraMatrix1Double;
+                cameraMatrix0.convertTo(cameraMatrix0Double, CV_64F);
+                cameraMatrix1.convertTo(cameraMatrix1Double, CV_64F);
+                // Camera center of view 0 (null space of its camera matrix)
+                cv::Mat center0;
+                cv::SVD::solveZ(cameraMatrix0Double, center0);
+                // Epipole of view 0 on view 1, as a cross product matrix
+                const cv::Mat epipole1 = cameraMatrix1Double * center0;
+                const auto* const epipole1Ptr = epipole1.ptr<double>();
+                cv::Mat epipole1Cross = cv::Mat::zeros(3, 3, CV_64F);
+                epipole1Cross.at<double>(0, 1) = -epipole1Ptr[2];
+                epipole1Cross.at<double>(0, 2) = epipole1Ptr[1];
+                epipole1Cross.at<double>(1, 0) = epipole1Ptr[2];
+                epipole1Cross.at<double>(1, 2) = -epipole1Ptr[0];
+                epipole1Cross.at<double>(2, 0) = -epipole1Ptr[1];
+                epipole1Cross.at<double>(2, 1) = epipole1Ptr[0];
+                // F = [e1]x * P1 * pinv(P0) (its scale does not change the epipolar distances)
+                cv::Mat fundamentalMatrix = epipole1Cross * cameraMatrix1Double
+                                          * cameraMatrix0Double.inv(cv::DECOMP_SVD);
+                const auto norm = cv::norm(fundamentalMatrix);
+                if (norm > 0.)
+                    fundamentalMatrix /= norm;
+                return fundamentalMatrix;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return cv::Mat{};
+            }
+        }
+
+        // Average of the distances of x0 to the epipolar line of x1 on view 0 and of x1 to the one of x0 on view 1
+        inline double getEpipolarDistance(const double* const F, const float* const x0, const float* const x1)
+        {
+            // Epipolar line of x0 on view 1 (F * x0) and of x1 on view 0 (F^T * x1)
+            const auto line1X = F[0]*x0[0] + F[1]*x0[1] + F[2];
+            const auto line1Y = F[3]*x0[0] + F[4]*x0[1] + F[5];
+            const auto line1Z = F[6]*x0[0] + F[7]*x0[1] + F[8];
+            const auto line0X = F[0]*x1[0] + F[3]*x1[1] + F[6];
+            const auto line0Y = F[1]*x1[0] + F[4]*x1[1] + F[7];
+            // x1^T * F * x0
+            const auto residual = std::abs(line1X*x1[0] + line1Y*x1[1] + line1Z);
+            return 0.5 * residual * (1. / std::sqrt(line1X*line1X + line1Y*line1Y)
+                                     + 1. / std::sqrt(line0X*line0X + line0Y*line0Y));
+        }
+    }
+
+    Matrix getFundamentalMatrix(const Matrix& cameraMatrix0, const Matrix& cameraMatrix1)
+    {
+        try
+        {
+            const cv::Mat cvFundamentalMatrix = getFundamentalMatrixCv(
+                OP_OP2CVCONSTMAT(cameraMatrix0), OP_OP2CVCONSTMAT(cameraMatrix1));
+            return OP_CV2OPCONSTMAT(cvFundamentalMatrix);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Matrix{};
+        }
+    }
+
+    PoseAssociation::PoseAssociation(const double maxEpipolarDistance, const int minCommonParts) :
+        mMaxEpipolarDistance{maxEpipolarDistance},
+        mMinCommonParts{minCommonParts}
+    {
+        try
+        {
+            // Sanity check
+            if (mMinCommonParts < 1)
+                error("minCommonParts must be at least 1.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    PoseAssociation::~PoseAssociation()
+    {
+    }
+
+    std::vector<std::vector<int>> PoseAssociation::associate(
+        const std::vector<Array<float>>& poseKeypointsVector, const std::vector<Matrix>& cameraMatrices,
+        const std::vector<Point<int>>& imageSizes) const
+    {
+        try
+        {
+            const auto numberViews = (int)poseKeypointsVector.size();
+            // Sanity checks
+            if (cameraMatrices.size() != poseKeypointsVector.size() || imageSizes.size() != poseKeypointsVector.size())
+                error("The number of camera matrices, image sizes and views must be the same ("
+                      + std::to_string(cameraMatrices.size()) + ", " + std::to_string(imageSizes.size()) + " and "
+                      + std::to_string(numberViews) + ").", __LINE__, __FUNCTION__, __FILE__);
+            // Each person of each view is a node of the clustering (nodes of the view v from nodeOffsets[v])
+            std::vector<int> nodeOffsets(numberViews+1, 0);
+            for (auto view = 0 ; view < numberViews ; view++)
+                nodeOffsets[view+1] = nodeOffsets[view] + fastMax(0, poseKeypointsVector[view].getSize(0));
+            const auto numberNodes = nodeOffsets.back();
+            if (numberNodes == 0)
+                return {};
+            // Valid keypoints of each node (as the ones triangulated by PoseTriangulation)
+            std::vector<std::vector<char>> validities(numberNodes);
+            for (auto view = 0 ; view < numberViews ; view++)
+            {
+                const auto& poseKeypoints = poseKeypointsVector[view];
+                const auto numberParts = poseKeypoints.getSize(1);
+                const auto numberChannels = poseKeypoints.getSize(2);
+                for (auto node = nodeOffsets[view] ; node < nodeOffsets[view+1] ; node++)
+                {
+                    const auto person = node - nodeOffsets[view];
+                    validities[node].resize(numberParts);
+                    for (auto part = 0 ; part < numberParts ; part++)
+                        validities[node][part] = isValidKeypoint(
+                            &poseKeypoints[(person*numberParts + part)*numberChannels], imageSizes[view]);
+                }
+            }
+            // Distance matrix of each pair of views (in parallel), infinite if not comparable
+            const auto infinity = std::numeric_limits<double>::infinity();
+            std::vector<std::pair<int, int>> viewPairs;
+            std::vector<int> viewPairIndexes(numberViews*numberViews, -1);
+            for (auto view0 = 0 ; view0 < numberViews ; view0++)
+            {
+                for (auto view1 = view0+1 ; view1 < numberViews ; view1++)
+                {
+                    viewPairIndexes[view0*numberViews + view1] = (int)viewPairs.size();
+                    viewPairs.emplace_back(std::make_pair(view0, view1));
+                }
+            }
+            std::vector<std::vector<double>> distances(viewPairs.size());
+            parallelFor(0, (int)viewPairs.size(), [&](const int i)
+            {
+                const auto view0 = viewPairs[i].first;
+                const auto view1 = viewPairs[i].second;
+                const auto numberPeople0 = nodeOffsets[view0+1] - nodeOffsets[view0];
+                const auto numberPeople1 = nodeOffsets[view1+1] - nodeOffsets[view1];
+                distances[i].assign(numberPeople0*numberPeople1, infinity);
+                if (numberPeople0 == 0 || numberPeople1 == 0)
+                    return;
+                const cv::Mat fundamentalMatrix = getFundamentalMatrixCv(
+                    OP_OP2CVCONSTMAT(cameraMatrices[view0]), OP_OP2CVCONSTMAT(cameraMatrices[view1]));
+                const auto* const fundamentalMatrixPtr = fundamentalMatrix.ptr<double>();
+                const auto& poseKeypoints0 = poseKeypointsVector[view0];
+                const auto& poseKeypoints1 = poseKeypointsVector[view1];
+                const auto numberChannels0 = poseKeypoints0.getSize(2);
+                const auto numberChannels1 = poseKeypoints1.getSize(2);
+                const auto numberParts = fastMin(poseKeypoints0.getSize(1), poseKeypoints1.getSize(1));
+                for (auto person0 = 0 ; person0 < numberPeople0 ; person0++)
+                {
+                    const auto& validities0 = validities[nodeOffsets[view0] + person0];
+                    const auto* const keypoints0Ptr = &poseKeypoints0[
+                        person0*poseKeypoints0.getSize(1)*numberChannels0];
+                    for (auto person1 = 0 ; person1 < numberPeople1 ; person1++)
+                    {
+                        const auto& validities1 = validities[nodeOffsets[view1] + person1];
+                        const auto* const keypoints1Ptr = &poseKeypoints1[
+                            person1*poseKeypoints1.getSize(1)*numberChannels1];
+                        auto distanceSum = 0.;
+                        auto numberCommonParts = 0;
+                        for (auto part = 0 ; part < numberParts ; part++)
+                        {
+                            if (validities0[part] && validities1[part])
+                            {
+                                distanceSum += getEpipolarDistance(
+                                    fundamentalMatrixPtr, &keypoints0Ptr[part*numberChannels0],
+                                    &keypoints1Ptr[part*numberChannels1]);
+                                numberCommonParts++;
+                            }
+                        }
+                        if (numberCommonParts >= mMinCommonParts)
+                            distances[i][person0*numberPeople1 + person1] = distanceSum / numberCommonParts;
+                    }
+                }
+            });
+            const auto getNodeView = [&](const int node)
+            {
+                return (int)(std::upper_bound(nodeOffsets.begin(), nodeOffsets.end(), node) - nodeOffsets.begin())
+                    - 1;
+            };
+            const auto getDistance = [&](const int node0, const int node1)
+            {
+                auto view0 = getNodeView(node0);
+                auto view1 = getNodeView(node1);
+                auto person0 = node0 - nodeOffsets[view0];
+                auto person1 = node1 - nodeOffsets[view1];
+                if (view0 > view1)
+                {
+                    std::swap(view0, view1);
+                    std::swap(person0, person1);
+                }
+                const auto numberPeople1 = nodeOffsets[view1+1] - nodeOffsets[view1];
+                return distances[viewPairIndexes[view0*numberViews + view1]][person0*numberPeople1 + person1];
+            };
+            // Maximum distance (as the maximum reprojection error of PoseTriangulation)
+            const auto maxDistance = (mMaxEpipolarDistance > 0. ? mMaxEpipolarDistance
+                : 25. * std::sqrt(imageSizes[0].x * imageSizes[0].y / 1310720.));
+            // Candidate pairs of nodes, from the closest to the furthest
+            struct NodePair
+            {
+                double distance;
+                int node0;
+                int node1;
+            };
+            std::vector<NodePair> nodePairs;
+            for (auto i = 0u ; i < viewPairs.size() ; i++)
+            {
+                const auto view0 = viewPairs[i].first;
+                const auto view1 = viewPairs[i].second;
+                const auto numberPeople1 = nodeOffsets[view1+1] - nodeOffsets[view1];
+                for (auto index = 0u ; index < distances[i].size() ; index++)
+                    if (distances[i][index] < maxDistance)
+                        nodePairs.emplace_back(NodePair{
+                            distances[i][index], nodeOffsets[view0] + (int)index / numberPeople1,
+                            nodeOffsets[view1] + (int)index % numberPeople1});
+            }
+            std::sort(nodePairs.begin(), nodePairs.end(),
+                      [](const NodePair& a, const NodePair& b) { return a.distance < b.distance; });
+            // Greedy clustering (each cluster has at most 1 person per view)
+            std::vector<int> clusterIndexes(numberNodes);
+            std::vector<std::vector<int>> clusterNodes(numberNodes);
+            std::vector<std::vector<int>> clusterPeople(numberNodes, std::vector<int>(numberViews, -1));
+            for (auto node = 0 ; node < numberNodes ; node++)
+            {
+                clusterIndexes[node] = node;
+                clusterNodes[node] = {node};
+                clusterPeople[node][getNodeView(node)] = node - nodeOffsets[getNodeView(node)];
+            }
+            for (const auto& nodePair : nodePairs)
+            {
+                auto cluster0 = clusterIndexes[nodePair.node0];
+                auto cluster1 = clusterIndexes[nodePair.node1];
+                if (cluster0 == cluster1)
+                    continue;
+                // At most 1 person per view
+                auto sharedView = false;
+                for (auto view = 0 ; view < numberViews && !sharedView ; view++)
+                    sharedView = (clusterPeople[cluster0][view] >= 0 && clusterPeople[cluster1][view] >= 0);
+                if (sharedView)
+                    continue;
+                // Average linkage (so 2 people are not merged through a chain of close pairs only)
+                auto distanceSum = 0.;
+                auto numberDistances = 0;
+                for (const auto node0 : clusterNodes[cluster0])
+                {
+                    for (const auto node1 : clusterNodes[cluster1])
+                    {
+                        const auto distance = getDistance(node0, node1);
+                        if (distance < infinity)
+                        {
+                            distanceSum += distance;
+                            numberDistances++;
+                        }
+                    }
+                }
+                if (numberDistances == 0 || distanceSum / numberDistances >= maxDistance)
+                    continue;
+                // Merge the smallest cluster into the largest one
+                if (clusterNodes[cluster0].size() < clusterNodes[cluster1].size())
+                    std::swap(cluster0, cluster1);
+                for (const auto node1 : clusterNodes[cluster1])
+                    clusterIndexes[node1] = cluster0;
+                clusterNodes[cluster0].insert(
+                    clusterNodes[cluster0].end(), clusterNodes[cluster1].begin(), clusterNodes[cluster1].end());
+                clusterNodes[cluster1].clear();
+                for (auto view = 0 ; view < numberViews ; view++)
+                    if (clusterPeople[cluster1][view] >= 0)
+                        clusterPeople[cluster0][view] = clusterPeople[cluster1][view];
+            }
+            // 3-D people (clusters with at least 2 views), the most visible ones first
+            std::vector<std::vector<int>> people;
+            for (auto cluster = 0 ; cluster < numberNodes ; cluster++)
+                if (clusterNodes[cluster].size() > 1)
+                    people.emplace_back(std::move(clusterPeople[cluster]));
+            std::stable_sort(people.begin(), people.end(),
+                [](const std::vector<int>& a, const std::vector<int>& b)
+                {
+                    return std::count_if(a.begin(), a.end(), [](const int person) { return person >= 0; })
+                        > std::count_if(b.begin(), b.end(), [](const int person) { return person >= 0; });
+                });
+            return people;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+}
@@ -1,11 +1,22 @@
 #include <openpose/3d/poseTriangulation.hpp>
+#include <algorithm> // std::copy, std::find, std::find_if
+#include <limits> // std::numeric_limits
+#include <map>
+#include <mutex>
 #include <numeric> // std::accumulate
+#include <opencv2/imgproc/imgproc.hpp> // cv::undistortPoints (OpenCV <= 3)
+#include <openpose_private/utilities/openCvMultiversionHeaders.hpp> // OPEN_CV_IS_4_OR_HIGHER
+#ifdef OPEN_CV_IS_4_OR_HIGHER
+    #include <opencv2/calib3d.hpp> // cv::undistortPoints in OpenCV 4
+#endif
+#include <openpose/3d/poseAssociation.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose_private/3d/poseTriangulationPrivate.hpp>
+#include <openpose_private/utilities/parallelFor.hpp>
 
 namespace op
 {
-    inline bool isValidKeypoint(const float* const keypointPtr, const Point<int>& imageSize)
+    bool isValidKeypoint(const float* const keypointPtr, const Point<int>& imageSize)
     {
         try
         {
@@ -25,32 +36,75 @@ namespace op
         }
     }
 
+    // Temporal mode: a warm-started keypoint is triangulated from scratch if its reprojection error is higher than
+    // TEMPORAL_ERROR_JUMP times its previous one (and than TEMPORAL_MIN_ERROR pixels for 1280x1024 images). Only
+    // the reconstruction of a frame at most TEMPORAL_MAX_FRAME_GAP frames away is used as initial estimate
+    const auto TEMPORAL_ERROR_JUMP = 2.;
+    const auto TEMPORAL_MIN_ERROR = 3.;
+    const auto TEMPORAL_MAX_FRAME_GAP = 3ull;
+
+    // Last reconstruction of each person, for the temporal mode
+    struct PoseTriangulation::TemporalState
+    {
+        // (first view that sees the person, its poseIds in that view), or (-1, 0) if single-person
+        typedef std::pair<int, long long> PersonKey;
+        struct Person
+        {
+            // 1 per element (e.g., body, face and hands)
+            std::vector<Array<float>> keypoints3D;
+            // Reprojection error of each keypoint (negative if it was not reconstructed)
+            std::vector<std::vector<double>> reprojectionErrors;
+        };
+
+        std::mutex mutex;
+        bool empty = true;
+        unsigned long long frameId = 0ull;
+        std::map<PersonKey, Person> people;
+    };
+
+    // It reconstructs the person personIndexes[i] of each view i (-1 if that view does not see it)
+    // previousKeypoints3D and previousReprojectionErrors: Reconstruction of that person on a recent frame (temporal
+    // mode), or empty. reprojectionErrorsPtr (optional): Reprojection error of each keypoint, or -1 if it is not
+    // reconstructed.
     bool reconstructArrayThread(
-        Array<float>* keypoints3DPtr, const std::vector<Array<float>>& keypointsVector,
-        const std::vector<cv::Mat>& cameraMatrices, const std::vector<Point<int>>& imageSizes, const int minViews3d)
+        Array<float>* keypoints3DPtr, std::vector<double>* reprojectionErrorsPtr,
+        const std::vector<Array<float>>& keypointsVector, const std::vector<int>& personIndexes,
+        const std::vector<cv::Mat>& cameraMatrices, const std::vector<Point<int>>& imageSizes, const int minViews3d,
+        const Array<float>& previousKeypoints3D, const std::vector<double>& previousReprojectionErrors)
     {
         try
         {
             auto& keypoints3D = *keypoints3DPtr;
+            if (reprojectionErrorsPtr != nullptr)
+                reprojectionErrorsPtr->clear();
 
             // Sanity check
             if (cameraMatrices.size() < 2)
                 error("Only 1 camera detected. The 3-D reconstruction module can only be used with > 1 cameras"
                       " simultaneously. E.g., using FLIR stereo cameras (`--flir_camera`).",
                       __LINE__, __FUNCTION__, __FILE__);
+            // Keypoints of the person on each view (nullptr if it is not visible on that view)
+            std::vector<const float*> keypointPtrs(keypointsVector.size(), nullptr);
+            for (auto i = 0u ; i < keypointsVector.size() ; i++)
+            {
+                const auto& keypoints = keypointsVector[i];
+                const auto person = (i < personIndexes.size() ? personIndexes[i] : -1);
+                if (!keypoints.empty() && 0 <= person && person < keypoints.getSize(0))
+                    keypointPtrs[i] = &keypoints[person * keypoints.getSize(1) * keypoints.getSize(2)];
+            }
             // Get number body parts and whether at least 2 cameras have keypoints
             auto detectionMissed = 0;
             auto numberBodyParts = 0;
             auto channel0Length = 0;
-            for (const auto& keypoints : keypointsVector)
+            for (auto i = 0u ; i < keypointsVector.size() ; i++)
             {
-                if (!keypoints.empty())
+                if (keypointPtrs[i] != nullptr)
                 {
                     ++detectionMissed;
                     if (detectionMissed > 1)
                     {
-                        numberBodyParts = keypoints.getSize(1);
-                        channel0Length = keypoints.getSize(2);
+                        numberBodyParts = keypointsVector[i].getSize(1);
+                        channel0Length = keypointsVector[i].getSize(2);
                         break;
                     }
                 }
@@ -58,62 +112,128 @@ namespace op
             // If at least 2 set of keypoints not empty
             if (numberBodyParts > 0)
             {
-                // Create x-y vector from high score results
+                // Keypoints visible for at least minViews3dValue views
+                const auto numberCameras = (unsigned int)keypointsVector.size();
+                const auto minViews3dValue = (minViews3d > 0 ? (unsigned int)minViews3d
+                    : fastMax(2u, fastMin(4u, (unsigned int)cameraMatrices.size()-1u)));
                 std::vector<int> indexesUsed;
-                std::vector<std::vector<cv::Point2d>> xyPoints;
-                std::vector<std::vector<cv::Mat>> cameraMatricesPerPoint;
+                std::vector<char> partVisibilities(numberCameras);
+                std::vector<char> visibilitiesUsed;
                 for (auto part = 0; part < numberBodyParts; ++part)
                 {
-                    // Create vector of points
-                    // auto missedPoint = false;
-                    std::vector<cv::Point2d> xyPointsElement;
-                    std::vector<cv::Mat> cameraMatricesElement;
                     const auto baseIndex = part * channel0Length;
-                    // for (auto& keypoints : keypointsVector)
-                    for (auto i = 0u ; i < keypointsVector.size() ; i++)
+                    auto numberViews = 0u;
+                    for (auto i = 0u ; i < numberCameras ; i++)
                     {
-                        const auto& keypoints = keypointsVector[i];
-                        if (!keypoints.empty() && isValidKeypoint(&keypoints[baseIndex], imageSizes[i]))
-                        {
-                            xyPointsElement.emplace_back(
-                                cv::Point2d{keypoints[baseIndex], keypoints[baseIndex+1]});
-                            cameraMatricesElement.emplace_back(cameraMatrices[i]);
-                        }
+                        partVisibilities[i] = (keypointPtrs[i] != nullptr
+                                               && isValidKeypoint(&keypointPtrs[i][baseIndex], imageSizes[i]));
+                        numberViews += partVisibilities[i];
                     }
-                    const auto minViews3dValue = (minViews3d > 0 ? minViews3d
-                        : fastMax(2u, fastMin(4u, (unsigned int)cameraMatrices.size()-1u)));
-                    // If visible for at least minViews3dValue views
-                    if (minViews3dValue <= xyPointsElement.size())
                     // Old code
                     // // If visible from all views (minViews3d < 0) or if visible for at least minViews3d views
                     // if ((minViews3d < 0 && cameraMatricesElement.size() == cameraMatrices.size())
                     //     || (minViews3d > 1 && minViews3d <= (int)xyPointsElement.size()))
+                    if (minViews3dValue <= numberViews)
                     {
                         indexesUsed.emplace_back(part);
-                        xyPoints.emplace_back(xyPointsElement);
-                        cameraMatricesPerPoint.emplace_back(cameraMatricesElement);
+                        visibilitiesUsed.insert(
+                            visibilitiesUsed.end(), partVisibilities.begin(), partVisibilities.end());
                     }
                 }
                 // 3D reconstruction
                 const auto imageRatio = std::sqrt(imageSizes[0].x * imageSizes[0].y / 1310720.);
                 const auto reprojectionMaxAcceptable = 25 * imageRatio;
-                std::vector<double> reprojectionErrors(xyPoints.size());
-                if (!xyPoints.empty())
+                std::vector<double> reprojectionErrors;
+                if (!indexesUsed.empty())
                 {
                     keypoints3D.reset({ 1, numberBodyParts, 4 }, 0.f);
+                    // x-y of each keypoint used, in the structure-of-arrays layout of triangulateBatch()
+                    const auto numberPoints = (int)indexesUsed.size();
+                    std::vector<double> xs(numberCameras*numberPoints, 0.);
+                    std::vector<double> ys(numberCameras*numberPoints, 0.);
+                    std::vector<double> visibilities(numberCameras*numberPoints, 0.);
+                    for (auto index = 0 ; index < numberPoints ; index++)
+                    {
+                        const auto baseIndex = indexesUsed[index] * channel0Length;
+                        for (auto i = 0u ; i < numberCameras ; i++)
+                        {
+                            if (visibilitiesUsed[index*numberCameras + i])
+                            {
+                                const auto soaIndex = i*numberPoints + index;
+                                xs[soaIndex] = keypointPtrs[i][baseIndex];
+                                ys[soaIndex] = keypointPtrs[i][baseIndex+1];
+                                visibilities[soaIndex] = 1.;
+                            }
+                        }
+                    }
                     // Do 3D reconstruction
-                    std::vector<cv::Point3f> xyzPoints(xyPoints.size());
-                    for (auto i = 0u; i < xyPoints.size(); i++)
+                    std::vector<double> xyzPoints;
+                    // Temporal mode: each keypoint reconstructed on the previous frame starts from it (a single
+                    // Gauss-Newton step), and only the ones whose reprojection error jumps (or new ones) are
+                    // triangulated from scratch
+                    const auto warmStart = (previousKeypoints3D.getSize(1) == numberBodyParts
+                                            && (int)previousReprojectionErrors.size() == numberBodyParts);
+                    if (warmStart)
                     {
-                        cv::Mat reconstructedPoint;
-                        reprojectionErrors[i] = triangulateWithOptimization(
-                            reconstructedPoint, cameraMatricesPerPoint[i], xyPoints[i], reprojectionMaxAcceptable);
-                        xyzPoints[i] = cv::Point3d{
-                            reconstructedPoint.at<double>(0), reconstructedPoint.at<double>(1),
-                            reconstructedPoint.at<double>(2)};
+                        xyzPoints.resize(3*numberPoints);
+                        const auto previousChannels = previousKeypoints3D.getSize(2);
+                        for (auto index = 0 ; index < numberPoints ; index++)
+                        {
+                            const auto* const previousPtr = &previousKeypoints3D[indexesUsed[index]*previousChannels];
+                            for (auto coordinate = 0 ; coordinate < 3 ; coordinate++)
+                                xyzPoints[3*index+coordinate] = (previousPtr[3] > 0.f
+                                    ? (double)previousPtr[coordinate] : std::numeric_limits<double>::quiet_NaN());
+                        }
+                        refineTriangulationBatch(
+                            xyzPoints, reprojectionErrors, cameraMatrices, xs, ys, visibilities, numberPoints);
+                        std::vector<int> coldIndexes;
+                        for (auto index = 0 ; index < numberPoints ; index++)
+                        {
+                            const auto previousError = previousReprojectionErrors[indexesUsed[index]];
+                            const auto maxError = fastMin(
+                                reprojectionMaxAcceptable,
+                                fastMax(TEMPORAL_ERROR_JUMP * previousError, TEMPORAL_MIN_ERROR * imageRatio));
+                            // Also if not finite (NaN comparisons are false)
+                            if (previousError < 0. || !(reprojectionErrors[index] <= maxError))
+                                coldIndexes.emplace_back(index);
+                        }
+                        // Full triangulation of the rest
+                        if (!coldIndexes.empty())
+                        {
+                            const auto numberColdPoints = (int)coldIndexes.size();
+                            std::vector<double> coldXs(numberCameras*numberColdPoints);
+                            std::vector<double> coldYs(numberCameras*numberColdPoints);
+                            std::vector<double> coldVisibilities(numberCameras*numberColdPoints);
+                            for (auto i = 0u ; i < numberCameras ; i++)
+                            {
+                                for (auto coldIndex = 0 ; coldIndex < numberColdPoints ; coldIndex++)
+                                {
+                                    const auto soaIndex = i*numberPoints + coldIndexes[coldIndex];
+                                    coldXs[i*numberColdPoints + coldIndex] = xs[soaIndex];
+                                    coldYs[i*numberColdPoints + coldIndex] = ys[soaIndex];
+                                    coldVisibilities[i*numberColdPoints + coldIndex] = visibilities[soaIndex];
+                                }
+                            }
+                            std::vector<double> coldXyzPoints;
+                            std::vector<double> coldReprojectionErrors;
+                            triangulateWithOptimizationBatch(
+                                coldXyzPoints, coldReprojectionErrors, cameraMatrices, coldXs, coldYs,
+                                coldVisibilities, numberColdPoints, reprojectionMaxAcceptable);
+                            for (auto coldIndex = 0 ; coldIndex < numberColdPoints ; coldIndex++)
+                            {
+                                const auto index = coldIndexes[coldIndex];
+                                std::copy(&coldXyzPoints[3*coldIndex], &coldXyzPoints[3*coldIndex] + 3,
+                                          &xyzPoints[3*index]);
+                                reprojectionErrors[index] = coldReprojectionErrors[coldIndex];
+                            }
+                        }
                     }
+                    else
+                        triangulateWithOptimizationBatch(
+                            xyzPoints, reprojectionErrors, cameraMatrices, xs, ys, visibilities, numberPoints,
+                            reprojectionMaxAcceptable);
                     const auto reprojectionErrorTotal = std::accumulate(
-                        reprojectionErrors.begin(), reprojectionErrors.end(), 0.0) / xyPoints.size();
+                        reprojectionErrors.begin(), reprojectionErrors.end(), 0.0) / numberPoints;
 
                     // 3D points to pose
                     // OpenCV alternative:
@@ -124,20 +244,24 @@ namespace op
                     // 20 pixels for 1280x1024 image
                     bool atLeastOnePointProjected = false;
                     const auto lastChannelLength = keypoints3D.getSize(2);
+                    if (reprojectionErrorsPtr != nullptr)
+                        reprojectionErrorsPtr->assign(numberBodyParts, -1.);
                     for (auto index = 0u; index < indexesUsed.size(); ++index)
                     {
-                        if (std::isfinite(xyzPoints[index].x) && std::isfinite(xyzPoints[index].y)
-                            && std::isfinite(xyzPoints[index].z)
+                        const auto* const xyzPoint = &xyzPoints[3*index];
+                        if (std::isfinite(xyzPoint[0]) && std::isfinite(xyzPoint[1]) && std::isfinite(xyzPoint[2])
                             // Remove outliers
                             && (reprojectionErrors[index] < 5 * reprojectionErrorTotal
                                 && reprojectionErrors[index] < reprojectionMaxAcceptable))
                         {
                             const auto baseIndex = indexesUsed[index] * lastChannelLength;
-                            keypoints3D[baseIndex] = xyzPoints[index].x;
-                            keypoints3D[baseIndex + 1] = xyzPoints[index].y;
-                            keypoints3D[baseIndex + 2] = xyzPoints[index].z;
+                            keypoints3D[baseIndex] = (float)xyzPoint[0];
+                            keypoints3D[baseIndex + 1] = (float)xyzPoint[1];
+                            keypoints3D[baseIndex + 2] = (float)xyzPoint[2];
                             keypoints3D[baseIndex + 3] = 1.f;
                             atLeastOnePointProjected = true;
+                            if (reprojectionErrorsPtr != nullptr)
+                                (*reprojectionErrorsPtr)[indexesUsed[index]] = reprojectionErrors[index];
                         }
                     }
                     // Warning
@@ -165,8 +289,10 @@ namespace op
         }
     }
 
-    PoseTriangulation::PoseTriangulation(const int minViews3d) :
-        mMinViews3d{minViews3d}
+    PoseTriangulation::PoseTriangulation(const int minViews3d, const bool multiPerson, const bool temporal) :
+        mMinViews3d{minViews3d},
+        spPoseAssociation{multiPerson ? std::make_shared<PoseAssociation>() : nullptr},
+        spTemporalState{temporal ? std::make_shared<TemporalState>() : nullptr}
     {
         try
         {
@@ -189,14 +315,62 @@ namespace op
     {
     }
 
+    Array<float> getUndistortedKeypoints(
+        const Array<float>& keypoints, const cv::Mat& cameraIntrinsics, const cv::Mat& cameraDistortion)
+    {
+        try
+        {
+            if (keypoints.empty())
+                return keypoints;
+            // Only the detected keypoints (score > 0), so the missing ones remain 0
+            const auto numberChannels = (int)keypoints.getSize((int)keypoints.getNumberDimensions()-1);
+            const auto numberKeypoints = (int)keypoints.getVolume() / numberChannels;
+            std::vector<cv::Point2f> points;
+            std::vector<int> pointIndexes;
+            for (auto keypoint = 0 ; keypoint < numberKeypoints ; keypoint++)
+            {
+                const auto* const keypointPtr = &keypoints[keypoint*numberChannels];
+                if (keypointPtr[2] > 0)
+                {
+                    points.emplace_back(cv::Point2f{keypointPtr[0], keypointPtr[1]});
+                    pointIndexes.emplace_back(keypoint);
+                }
+            }
+            // Copy (the input keypoints might be shared with Datum, whose 2-D keypoints remain distorted)
+            auto undistortedKeypoints = keypoints.clone();
+            if (!points.empty())
+            {
+                // cameraIntrinsics as the new camera matrix, so the result is in pixels and matches the
+                // cv::initUndistortRectifyMap of CameraParameterReader::undistort()
+                std::vector<cv::Point2f> undistortedPoints;
+                cv::undistortPoints(
+                    points, undistortedPoints, cameraIntrinsics, cameraDistortion, cv::noArray(), cameraIntrinsics);
+                for (auto i = 0u ; i < pointIndexes.size() ; i++)
+                {
+                    auto* const keypointPtr = &undistortedKeypoints[pointIndexes[i]*numberChannels];
+                    keypointPtr[0] = undistortedPoints[i].x;
+                    keypointPtr[1] = undistortedPoints[i].y;
+                }
+            }
+            return undistortedKeypoints;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<float>{};
+        }
+    }
+
     Array<float> PoseTriangulation::reconstructArray(
         const std::vector<Array<float>>& keypointsVector, const std::vector<Matrix>& cameraMatrices,
-        const std::vector<Point<int>>& imageSizes) const
+        const std::vector<Point<int>>& imageSizes, const std::vector<Matrix>& cameraIntrinsics,
+        const std::vector<Matrix>& cameraDistortions) const
     {
         try
         {
             return reconstructArray(
-                std::vector<std::vector<Array<float>>>{keypointsVector}, cameraMatrices, imageSizes).at(0);
+                std::vector<std::vector<Array<float>>>{keypointsVector}, cameraMatrices, imageSizes,
+                cameraIntrinsics, cameraDistortions).at(0);
         }
         catch (const std::exception& e)
         {
@@ -207,15 +381,22 @@ namespace op
 
     const std::string sFlirErrorMessage{
         " If you are simultaneously using FLIR cameras (`--flir_camera`) and the 3-D reconstruction module"
-        " (`--3d), you should also enable `--frame_undistort` so their camera parameters are read."};
+        " (`--3d), you should also enable `--frame_undistort` (or `--frame_undistort_keypoints`) so their camera parameters are"
+        " read."};
     std::vector<Array<float>> PoseTriangulation::reconstructArray(
         const std::vector<std::vector<Array<float>>>& keypointsVectors,
         const std::vector<Matrix>& cameraMatrices,
-        const std::vector<Point<int>>& imageSizes) const
+        const std::vector<Point<int>>& imageSizes,
+        const std::vector<Matrix>& cameraIntrinsics,
+        const std::vector<Matrix>& cameraDistortions,
+        const std::vector<Array<long long>>& poseIds,
+        const unsigned long long frameId) const
     {
         try
         {
             OP_OP2CVVECTORMAT(cvCameraMatrices, cameraMatrices);
+            OP_OP2CVVECTORMAT(cvCameraIntrinsics, cameraIntrinsics);
+            OP_OP2CVVECTORMAT(cvCameraDistortions, cameraDistortions);
             // Sanity checks
             if (cvCameraMatrices.size() < 2)
                 error("3-D reconstruction (`--3d`) requires at least 2 camera views, only found "
@@ -229,27 +410,156 @@ namespace op
                 error("The camera parameters and number of images must be the same ("
                     + std::to_string(cvCameraMatrices.size()) + " vs. " + std::to_string(imageSizes.size()) + ").",
                     __LINE__, __FUNCTION__, __FILE__);
+            const auto undistortKeypoints = std::find_if(
+                cvCameraDistortions.begin(), cvCameraDistortions.end(),
+                [](const cv::Mat& cameraDistortion) { return !cameraDistortion.empty(); })
+                != cvCameraDistortions.end();
+            if (undistortKeypoints && cvCameraIntrinsics.size() < cvCameraDistortions.size())
+                error("The camera intrinsics are required to undistort the keypoints ("
+                    + std::to_string(cvCameraIntrinsics.size()) + " vs. "
+                    + std::to_string(cvCameraDistortions.size()) + " distortions).",
+                    __LINE__, __FUNCTION__, __FILE__);
+            // Keypoint-only undistortion (tens of points per person rather than the whole frames)
+            std::vector<std::vector<Array<float>>> undistortedKeypointsVectors;
+            if (undistortKeypoints)
+            {
+                undistortedKeypointsVectors = keypointsVectors;
+                parallelFor(0, (int)undistortedKeypointsVectors.size(), [&](const int i)
+                {
+                    auto& undistortedKeypointsVector = undistortedKeypointsVectors[i];
+                    for (auto view = 0u ; view < undistortedKeypointsVector.size() ; view++)
+                        if (view < cvCameraDistortions.size() && !cvCameraDistortions[view].empty())
+                            undistortedKeypointsVector[view] = getUndistortedKeypoints(
+                                undistortedKeypointsVector[view], cvCameraIntrinsics[view],
+                                cvCameraDistortions[view]);
+                });
+            }
+            const auto& keypointsVectorsUsed = (undistortKeypoints ? undistortedKeypointsVectors : keypointsVectors);
+            // Person of each view of each 3-D person (from the body keypoints, the face and hands of each person
+            // have its same index), or the first one of each view if single-person
+            const auto personIndexesPerPerson = (spPoseAssociation != nullptr && !keypointsVectorsUsed.empty()
+                ? spPoseAssociation->associate(keypointsVectorsUsed[0], cameraMatrices, imageSizes)
+                : std::vector<std::vector<int>>{std::vector<int>(cvCameraMatrices.size(), 0)});
+            const auto numberPeople = (int)personIndexesPerPerson.size();
+            const auto numberElements = (int)keypointsVectors.size();
+            // Temporal mode: previous reconstruction of each person (if recent enough)
+            std::vector<TemporalState::PersonKey> personKeys;
+            std::vector<TemporalState::Person> previousPeople(numberPeople);
+            if (spTemporalState != nullptr)
+            {
+                // Key of each person (-2 if it cannot be matched, e.g., multi-person without poseIds)
+                personKeys.assign(numberPeople, TemporalState::PersonKey{-2, 0ll});
+                for (auto person = 0 ; person < numberPeople ; person++)
+                {
+                    if (spPoseAssociation == nullptr)
+                        personKeys[person] = TemporalState::PersonKey{-1, 0ll};
+                    else
+                    {
+                        const auto& personIndexes = personIndexesPerPerson[person];
+                        for (auto view = 0u ; view < personIndexes.size() && view < poseIds.size() ; view++)
+                        {
+                            const auto index = personIndexes[view];
+                            if (index >= 0 && index < (int)poseIds[view].getVolume())
+                            {
+                                if (poseIds[view][index] >= 0)
+                                    personKeys[person] = TemporalState::PersonKey{(int)view, poseIds[view][index]};
+                                break;
+                            }
+                        }
+                    }
+                }
+                const std::lock_guard<std::mutex> lock{spTemporalState->mutex};
+                const auto frameGap = (frameId > spTemporalState->frameId
+                    ? frameId - spTemporalState->frameId : spTemporalState->frameId - frameId);
+                if (!spTemporalState->empty && frameGap <= TEMPORAL_MAX_FRAME_GAP)
+                {
+                    for (auto person = 0 ; person < numberPeople ; person++)
+                    {
+                        const auto previousPerson = spTemporalState->people.find(personKeys[person]);
+                        if (previousPerson != spTemporalState->people.end()
+                            && (int)previousPerson->second.keypoints3D.size() == numberElements)
+                            previousPeople[person] = previousPerson->second;
+                    }
+                }
+            }
             // Run 3-D reconstruction
-            bool keypointsReconstructed = false;
-            std::vector<Array<float>> keypoints3Ds(keypointsVectors.size());
-            // std::vector<std::thread> threads(keypointsVectors.size()-1);
-            for (auto i = 0u; i < keypointsVectors.size()-1; i++)
+            // Each element (e.g., body, face and hands) and person on a different thread. Before, this was ~15%
+            // slower than the single-thread option because Ceres is super slow if run concurrently in different
+            // threads, but now Ceres only refines the few keypoints with a high reprojection error (see
+            // isLmaRequired)
+            std::vector<Array<float>> keypoints3DsPerPerson(numberElements*numberPeople);
+            std::vector<std::vector<double>> reprojectionErrorsPerPerson(numberElements*numberPeople);
+            std::vector<char> keypointsReconstructedPerElement(numberElements*numberPeople);
+            const Array<float> noKeypoints3D;
+            const std::vector<double> noReprojectionErrors;
+            parallelFor(0, numberElements*numberPeople, [&](const int i)
+            {
+                const auto element = i / numberPeople;
+                const auto person = i % numberPeople;
+                const auto& previousPerson = previousPeople[person];
+                const auto hasPrevious = !previousPerson.keypoints3D.empty();
+                keypointsReconstructedPerElement[i] = reconstructArrayThread(
+                    &keypoints3DsPerPerson[i], (spTemporalState != nullptr ? &reprojectionErrorsPerPerson[i] : nullptr),
+                    keypointsVectorsUsed[element], personIndexesPerPerson[person], cvCameraMatrices, imageSizes,
+                    mMinViews3d, (hasPrevious ? previousPerson.keypoints3D[element] : noKeypoints3D),
+                    (hasPrevious ? previousPerson.reprojectionErrors[element] : noReprojectionErrors));
+            });
+            // Temporal mode: this reconstruction is the initial estimate of the next frames (unless a more recent
+            // frame was already reconstructed by another thread)
+            if (spTemporalState != nullptr)
+            {
+                std::map<TemporalState::PersonKey, TemporalState::Person> people;
+                for (auto person = 0 ; person < numberPeople ; person++)
+                {
+                    if (personKeys[person].first < -1)
+                        continue;
+                    auto& newPerson = people[personKeys[person]];
+                    for (auto element = 0 ; element < numberElements ; element++)
+                    {
+                        newPerson.keypoints3D.emplace_back(
+                            keypoints3DsPerPerson[element*numberPeople + person].clone());
+                        newPerson.reprojectionErrors.emplace_back(
+                            reprojectionErrorsPerPerson[element*numberPeople + person]);
+                    }
+                }
+                const std::lock_guard<std::mutex> lock{spTemporalState->mutex};
+                if (spTemporalState->empty || frameId >= spTemporalState->frameId)
+                {
+                    spTemporalState->empty = false;
+                    spTemporalState->frameId = frameId;
+                    spTemporalState->people.swap(people);
+                }
+            }
+            // People of each element into a single Array (the ones not reconstructed are 0)
+            std::vector<Array<float>> keypoints3Ds(numberElements);
+            for (auto element = 0 ; element < numberElements ; element++)
             {
-                // // Multi-thread option - ~15% slower
-                // // Ceres seems to be super slow if run concurrently in different threads
-                // threads.at(i) = std::thread{&reconstructArrayThread,
-                //                             &keypoints3Ds[i], keypointsVectors[i], cvCameraMatrices,
-                //                             imageSizes, mMinViews3d};
-                // Single-thread option
-                keypointsReconstructed |= reconstructArrayThread(
-                    &keypoints3Ds[i], keypointsVectors[i], cvCameraMatrices, imageSizes, mMinViews3d);
+                if (numberPeople == 1)
+                    keypoints3Ds[element] = keypoints3DsPerPerson[element];
+                else
+                {
+                    const auto peopleBegin = keypoints3DsPerPerson.begin() + element*numberPeople;
+                    const auto firstKeypoints3D = std::find_if(
+                        peopleBegin, peopleBegin + numberPeople,
+                        [](const Array<float>& keypoints3D) { return !keypoints3D.empty(); });
+                    if (firstKeypoints3D == peopleBegin + numberPeople)
+                        continue;
+                    const auto personVolume = firstKeypoints3D->getVolume();
+                    keypoints3Ds[element].reset(
+                        {numberPeople, firstKeypoints3D->getSize(1), firstKeypoints3D->getSize(2)}, 0.f);
+                    for (auto person = 0 ; person < numberPeople ; person++)
+                    {
+                        const auto& keypoints3D = *(peopleBegin + person);
+                        if (!keypoints3D.empty())
+                            std::copy(keypoints3D.getConstPtr(), keypoints3D.getConstPtr() + personVolume,
+                                      keypoints3Ds[element].getPtr() + person*personVolume);
+                    }
+                }
             }
-            keypointsReconstructed |= reconstructArrayThread(
-                &keypoints3Ds.back(), keypointsVectors.back(), cvCameraMatrices, imageSizes, mMinViews3d);
-            // // Close threads
-            // for (auto& thread : threads)
-            //     if (thread.joinable())
-            //         thread.join();
+            // No people found on at least 2 views is not a 3-D problem (e.g., a scene without people)
+            const auto keypointsReconstructed = (numberPeople == 0 || std::find(
+                keypointsReconstructedPerElement.begin(), keypointsReconstructedPerElement.end(), 1)
+                != keypointsReconstructedPerElement.end());
             // Warning
             if (!keypointsReconstructed)
                 opLog("No keypoints were reconstructed on this frame. It might be simply a challenging frame."
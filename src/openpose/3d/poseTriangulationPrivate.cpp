@@ -3,11 +3,38 @@
     #include <ceres/ceres.h>
     #include <ceres/rotation.h>
 #endif
+#include <cmath> // std::isfinite, std::sqrt
 #include <opencv2/calib3d/calib3d.hpp>
 #include <openpose/utilities/fastMath.hpp>
+#include <openpose_private/utilities/avx.hpp>
 
 namespace op
 {
+    // Basic RANSAC of triangulateWithOptimization() (for >= 4 cameras if the reprojection error is higher than usual)
+    inline bool isRansacRequired(
+        const unsigned int numberCameras, const double projectionError, const double reprojectionMaxAcceptable)
+    {
+        return numberCameras >= 4 && projectionError > 0.5 * reprojectionMaxAcceptable
+            /*&& projectionError < 1.5 * reprojectionMaxAcceptable*/;
+    }
+
+    // LMA refinement of triangulateWithOptimization()
+    // Empirically detected that reprojection error (for 4 cameras) only minimizes the error if initial
+    // project error > ~2.5, and that it improves more the higher that error actually is
+    // Therefore, we disable it for already accurate samples in order to get both:
+    //     - Speed
+    //     - Accuracy for already accurate samples
+    inline bool isLmaRequired(const double projectionError, const double reprojectionMaxAcceptable)
+    {
+        #ifdef USE_CERES
+            return projectionError > 3.0 && projectionError < 1.5*reprojectionMaxAcceptable;
+        #else
+            UNUSED(projectionError);
+            UNUSED(reprojectionMaxAcceptable);
+            return false;
+        #endif
+    }
+
     double calcReprojectionError(const cv::Mat& reconstructedPoint, const std::vector<cv::Mat>& cameraMatrices,
                                  const std::vector<cv::Point2d>& pointsOnEachCamera)
     {
@@ -184,9 +211,7 @@ namespace op
             // Set initial values
             auto cameraMatricesFinal = cameraMatrices;
             auto pointsOnEachCameraFinal = pointsOnEachCamera;
-            if (cameraMatrices.size() >= 4
-                && projectionError > 0.5 * reprojectionMaxAcceptable
-                /*&& projectionError < 1.5 * reprojectionMaxAcceptable*/)
+            if (isRansacRequired((unsigned int)cameraMatrices.size(), projectionError, reprojectionMaxAcceptable))
             {
                 // Find best projection
                 auto bestReprojection = projectionError;
@@ -226,13 +251,8 @@ namespace op
             }
 
             #ifdef USE_CERES
-                // Empirically detected that reprojection error (for 4 cameras) only minimizes the error if initial
-                // project error > ~2.5, and that it improves more the higher that error actually is
-                // Therefore, we disable it for already accurate samples in order to get both:
-                //     - Speed
-                //     - Accuracy for already accurate samples
-                if (projectionError > 3.0
-                    && projectionError < 1.5*reprojectionMaxAcceptable)
+                // LMA refinement (see isLmaRequired)
+                if (isLmaRequired(projectionError, reprojectionMaxAcceptable))
                 {
                     // Slow equivalent: double paramX[3]; paramX[i] = reconstructedPoint.at<double>(i);
                     double* paramX = (double*)reconstructedPoint.data;
@@ -286,8 +306,6 @@ namespace op
                     // const auto reprojectionErrorDecrease = std::sqrt((summary.initial_cost - summary.final_cost)
                     //                                      / double(cameraMatricesFinal.size()));
                 }
-            #else
-                UNUSED(reprojectionMaxAcceptable);
             #endif
             // // This value is always 1
             // assert(reconstructedPoint.at<double>(3) == 1.);
@@ -314,4 +332,352 @@ namespace op
             return -1.;
         }
     }
+
+    namespace
+    {
+        // Closed-form solution of the 3x3 normal equations M*X = b (M symmetric) by its adjugate. det = 0 (e.g.,
+        // < 2 views) results in non-finite values, which the callers reject
+        template <typename T>
+        inline void solveSymmetric3x3(
+            T& x, T& y, T& z, const T m00, const T m01, const T m02, const T m11, const T m12, const T m22,
+            const T b0, const T b1, const T b2)
+        {
+            const auto c00 = m11*m22 - m12*m12;
+            const auto c01 = m02*m12 - m01*m22;
+            const auto c02 = m01*m12 - m02*m11;
+            const auto c11 = m00*m22 - m02*m02;
+            const auto c12 = m01*m02 - m00*m12;
+            const auto c22 = m00*m11 - m01*m01;
+            const auto oneOverDet = T(1) / (m00*c00 + m01*c01 + m02*c02);
+            x = (c00*b0 + c01*b1 + c02*b2) * oneOverDet;
+            y = (c01*b0 + c11*b1 + c12*b2) * oneOverDet;
+            z = (c02*b0 + c12*b1 + c22*b2) * oneOverDet;
+        }
+
+        // Camera matrices (3x4) as contiguous doubles
+        std::vector<double> getCameraParams(const std::vector<cv::Mat>& cameraMatrices)
+        {
+            std::vector<double> cameraParams(12*cameraMatrices.size());
+            for (auto camera = 0u ; camera < cameraMatrices.size() ; camera++)
+            {
+                const auto& cameraMatrix = cameraMatrices[camera];
+                if (cameraMatrix.rows != 3 || cameraMatrix.cols != 4 || cameraMatrix.type() != CV_64FC1)
+                    error("The camera matrices must be 3x4 CV_64FC1 matrices.", __LINE__, __FUNCTION__, __FILE__);
+                for (auto row = 0 ; row < 3 ; row++)
+                    for (auto col = 0 ; col < 4 ; col++)
+                        cameraParams[12*camera + 4*row + col] = cameraMatrix.at<double>(row, col);
+            }
+            return cameraParams;
+        }
+
+        // Same reprojection error than calcReprojectionError
+        inline double getReprojectionErrorScalar(
+            const double* const cameraParams, const int numberCameras, const double* const xs,
+            const double* const ys, const double* const visibilities, const int numberPoints, const int point,
+            const double x, const double y, const double z)
+        {
+            auto errorSum = 0.;
+            auto numberViews = 0.;
+            for (auto camera = 0 ; camera < numberCameras ; camera++)
+            {
+                const auto index = camera*numberPoints + point;
+                if (visibilities[index] == 0.)
+                    continue;
+                const auto* const P = &cameraParams[12*camera];
+                const auto oneOverW = 1. / (P[8]*x + P[9]*y + P[10]*z + P[11]);
+                const auto dx = (P[0]*x + P[1]*y + P[2]*z + P[3]) * oneOverW - xs[index];
+                const auto dy = (P[4]*x + P[5]*y + P[6]*z + P[7]) * oneOverW - ys[index];
+                errorSum += std::sqrt(dx*dx + dy*dy);
+                numberViews++;
+            }
+            return errorSum / numberViews;
+        }
+
+        // Each camera adds the DLT rows a = x*P.row(2) - P.row(0) and a = y*P.row(2) - P.row(1). With the 4th
+        // coordinate fixed to 1, the least squares solution of A*[X;1] = 0 is
+        // sum(a[0:3]*a[0:3]^T) * X = -sum(a[3]*a[0:3])
+        void triangulateBatchScalar(
+            double* reconstructedPoints, double* reprojectionErrors, const double* const cameraParams,
+            const int numberCameras, const double* const xs, const double* const ys,
+            const double* const visibilities, const int numberPoints, const int firstPoint)
+        {
+            for (auto point = firstPoint ; point < numberPoints ; point++)
+            {
+                auto m00 = 0., m01 = 0., m02 = 0., m11 = 0., m12 = 0., m22 = 0., b0 = 0., b1 = 0., b2 = 0.;
+                for (auto camera = 0 ; camera < numberCameras ; camera++)
+                {
+                    const auto index = camera*numberPoints + point;
+                    if (visibilities[index] == 0.)
+                        continue;
+                    const auto* const P = &cameraParams[12*camera];
+                    for (auto row = 0 ; row < 2 ; row++)
+                    {
+                        const auto u = (row == 0 ? xs[index] : ys[index]);
+                        const auto a0 = u*P[8] - P[4*row];
+                        const auto a1 = u*P[9] - P[4*row+1];
+                        const auto a2 = u*P[10] - P[4*row+2];
+                        const auto a3 = u*P[11] - P[4*row+3];
+                        m00 += a0*a0; m01 += a0*a1; m02 += a0*a2;
+                        m11 += a1*a1; m12 += a1*a2; m22 += a2*a2;
+                        b0 -= a0*a3; b1 -= a1*a3; b2 -= a2*a3;
+                    }
+                }
+                double x, y, z;
+                solveSymmetric3x3(x, y, z, m00, m01, m02, m11, m12, m22, b0, b1, b2);
+                reconstructedPoints[3*point] = x;
+                reconstructedPoints[3*point+1] = y;
+                reconstructedPoints[3*point+2] = z;
+                reprojectionErrors[point] = getReprojectionErrorScalar(
+                    cameraParams, numberCameras, xs, ys, visibilities, numberPoints, point, x, y, z);
+            }
+        }
+
+        #ifdef WITH_AVX
+            // a*b + c, a*b - c and c - a*b (AVX2 does not imply FMA)
+            OP_TARGET_AVX2 inline __m256d mulAddAvx2(const __m256d a, const __m256d b, const __m256d c)
+            {
+                return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+            }
+            OP_TARGET_AVX2 inline __m256d mulSubAvx2(const __m256d a, const __m256d b, const __m256d c)
+            {
+                return _mm256_sub_pd(_mm256_mul_pd(a, b), c);
+            }
+            OP_TARGET_AVX2 inline __m256d negMulAddAvx2(const __m256d a, const __m256d b, const __m256d c)
+            {
+                return _mm256_sub_pd(c, _mm256_mul_pd(a, b));
+            }
+
+            // Row `row` of P*[x;y;z;1]
+            OP_TARGET_AVX2 inline __m256d projectAvx2(
+                const double* const P, const int row, const __m256d x, const __m256d y, const __m256d z)
+            {
+                return mulAddAvx2(_mm256_set1_pd(P[4*row]), x, mulAddAvx2(_mm256_set1_pd(P[4*row+1]), y, mulAddAvx2(
+                    _mm256_set1_pd(P[4*row+2]), z, _mm256_set1_pd(P[4*row+3]))));
+            }
+
+            // Same than triangulateBatchScalar for 4 points at once (one per AVX lane). It returns the first point
+            // not processed (numberPoints rounded down to a multiple of 4)
+            OP_TARGET_AVX2 int triangulateBatchAvx2(
+                double* reconstructedPoints, double* reprojectionErrors, const double* const cameraParams,
+                const int numberCameras, const double* const xs, const double* const ys,
+                const double* const visibilities, const int numberPoints)
+            {
+                const auto zeroAvx = _mm256_setzero_pd();
+                auto point = 0;
+                for ( ; point + 4 <= numberPoints ; point += 4)
+                {
+                    auto m00 = zeroAvx, m01 = zeroAvx, m02 = zeroAvx, m11 = zeroAvx, m12 = zeroAvx, m22 = zeroAvx;
+                    auto b0 = zeroAvx, b1 = zeroAvx, b2 = zeroAvx;
+                    for (auto camera = 0 ; camera < numberCameras ; camera++)
+                    {
+                        const auto index = camera*numberPoints + point;
+                        // Non-visible points add 0-rows
+                        const auto visibility = _mm256_loadu_pd(&visibilities[index]);
+                        const auto* const P = &cameraParams[12*camera];
+                        for (auto row = 0 ; row < 2 ; row++)
+                        {
+                            const auto u = _mm256_loadu_pd(row == 0 ? &xs[index] : &ys[index]);
+                            const auto a0 = _mm256_mul_pd(visibility, mulSubAvx2(
+                                u, _mm256_set1_pd(P[8]), _mm256_set1_pd(P[4*row])));
+                            const auto a1 = _mm256_mul_pd(visibility, mulSubAvx2(
+                                u, _mm256_set1_pd(P[9]), _mm256_set1_pd(P[4*row+1])));
+                            const auto a2 = _mm256_mul_pd(visibility, mulSubAvx2(
+                                u, _mm256_set1_pd(P[10]), _mm256_set1_pd(P[4*row+2])));
+                            const auto a3 = _mm256_mul_pd(visibility, mulSubAvx2(
+                                u, _mm256_set1_pd(P[11]), _mm256_set1_pd(P[4*row+3])));
+                            m00 = mulAddAvx2(a0, a0, m00);
+                            m01 = mulAddAvx2(a0, a1, m01);
+                            m02 = mulAddAvx2(a0, a2, m02);
+                            m11 = mulAddAvx2(a1, a1, m11);
+                            m12 = mulAddAvx2(a1, a2, m12);
+                            m22 = mulAddAvx2(a2, a2, m22);
+                            b0 = negMulAddAvx2(a0, a3, b0);
+                            b1 = negMulAddAvx2(a1, a3, b1);
+                            b2 = negMulAddAvx2(a2, a3, b2);
+                        }
+                    }
+                    // Closed-form solution (see solveSymmetric3x3)
+                    const auto c00 = mulSubAvx2(m11, m22, _mm256_mul_pd(m12, m12));
+                    const auto c01 = mulSubAvx2(m02, m12, _mm256_mul_pd(m01, m22));
+                    const auto c02 = mulSubAvx2(m01, m12, _mm256_mul_pd(m02, m11));
+                    const auto c11 = mulSubAvx2(m00, m22, _mm256_mul_pd(m02, m02));
+                    const auto c12 = mulSubAvx2(m01, m02, _mm256_mul_pd(m00, m12));
+                    const auto c22 = mulSubAvx2(m00, m11, _mm256_mul_pd(m01, m01));
+                    const auto oneOverDet = _mm256_div_pd(_mm256_set1_pd(1.), mulAddAvx2(
+                        m00, c00, mulAddAvx2(m01, c01, _mm256_mul_pd(m02, c02))));
+                    const auto x = _mm256_mul_pd(oneOverDet, mulAddAvx2(
+                        c00, b0, mulAddAvx2(c01, b1, _mm256_mul_pd(c02, b2))));
+                    const auto y = _mm256_mul_pd(oneOverDet, mulAddAvx2(
+                        c01, b0, mulAddAvx2(c11, b1, _mm256_mul_pd(c12, b2))));
+                    const auto z = _mm256_mul_pd(oneOverDet, mulAddAvx2(
+                        c02, b0, mulAddAvx2(c12, b1, _mm256_mul_pd(c22, b2))));
+                    alignas(32) double xyz[3][4];
+                    _mm256_store_pd(xyz[0], x);
+                    _mm256_store_pd(xyz[1], y);
+                    _mm256_store_pd(xyz[2], z);
+                    for (auto lane = 0 ; lane < 4 ; lane++)
+                        for (auto coordinate = 0 ; coordinate < 3 ; coordinate++)
+                            reconstructedPoints[3*(point+lane)+coordinate] = xyz[coordinate][lane];
+                    // Reprojection error (non-visible points are masked out, their projection might be inf/NaN)
+                    auto errorSum = zeroAvx;
+                    auto numberViews = zeroAvx;
+                    for (auto camera = 0 ; camera < numberCameras ; camera++)
+                    {
+                        const auto index = camera*numberPoints + point;
+                        const auto visibility = _mm256_loadu_pd(&visibilities[index]);
+                        const auto visibleMask = _mm256_cmp_pd(visibility, zeroAvx, _CMP_NEQ_OQ);
+                        const auto* const P = &cameraParams[12*camera];
+                        const auto oneOverW = _mm256_div_pd(_mm256_set1_pd(1.), projectAvx2(P, 2, x, y, z));
+                        const auto dx = mulSubAvx2(projectAvx2(P, 0, x, y, z), oneOverW, _mm256_loadu_pd(&xs[index]));
+                        const auto dy = mulSubAvx2(projectAvx2(P, 1, x, y, z), oneOverW, _mm256_loadu_pd(&ys[index]));
+                        const auto error = _mm256_sqrt_pd(mulAddAvx2(dx, dx, _mm256_mul_pd(dy, dy)));
+                        errorSum = _mm256_add_pd(errorSum, _mm256_and_pd(visibleMask, error));
+                        numberViews = _mm256_add_pd(numberViews, visibility);
+                    }
+                    _mm256_storeu_pd(&reprojectionErrors[point], _mm256_div_pd(errorSum, numberViews));
+                }
+                return point;
+            }
+        #endif
+    }
+
+    void triangulateBatch(
+        std::vector<double>& reconstructedPoints, std::vector<double>& reprojectionErrors,
+        const std::vector<cv::Mat>& cameraMatrices, const std::vector<double>& xs, const std::vector<double>& ys,
+        const std::vector<double>& visibilities, const int numberPoints)
+    {
+        try
+        {
+            const auto numberCameras = (int)cameraMatrices.size();
+            // Sanity checks
+            const auto numberElements = (unsigned long long)numberCameras*numberPoints;
+            if (xs.size() != numberElements || ys.size() != numberElements || visibilities.size() != numberElements)
+                error("xs, ys and visibilities must have numberCameras*numberPoints elements.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            const auto cameraParams = getCameraParams(cameraMatrices);
+            reconstructedPoints.resize(3*numberPoints);
+            reprojectionErrors.resize(numberPoints);
+            auto firstPoint = 0;
+            #ifdef WITH_AVX
+                static const auto sCpuSupportsAvx2 = cpuSupportsAvx2();
+                if (sCpuSupportsAvx2)
+                    firstPoint = triangulateBatchAvx2(
+                        reconstructedPoints.data(), reprojectionErrors.data(), cameraParams.data(), numberCameras,
+                        xs.data(), ys.data(), visibilities.data(), numberPoints);
+            #endif
+            triangulateBatchScalar(
+                reconstructedPoints.data(), reprojectionErrors.data(), cameraParams.data(), numberCameras, xs.data(),
+                ys.data(), visibilities.data(), numberPoints, firstPoint);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void refineTriangulationBatch(
+        std::vector<double>& reconstructedPoints, std::vector<double>& reprojectionErrors,
+        const std::vector<cv::Mat>& cameraMatrices, const std::vector<double>& xs, const std::vector<double>& ys,
+        const std::vector<double>& visibilities, const int numberPoints)
+    {
+        try
+        {
+            const auto numberCameras = (int)cameraMatrices.size();
+            // Sanity checks
+            const auto numberElements = (unsigned long long)numberCameras*numberPoints;
+            if (xs.size() != numberElements || ys.size() != numberElements || visibilities.size() != numberElements
+                || reconstructedPoints.size() != 3ull*numberPoints)
+                error("xs, ys and visibilities must have numberCameras*numberPoints elements, and"
+                      " reconstructedPoints 3*numberPoints.", __LINE__, __FUNCTION__, __FILE__);
+            const auto cameraParams = getCameraParams(cameraMatrices);
+            reprojectionErrors.resize(numberPoints);
+            for (auto point = 0 ; point < numberPoints ; point++)
+            {
+                auto* const xyz = &reconstructedPoints[3*point];
+                // Normal equations J^T*J * delta = -J^T*r of the reprojection residuals r, where each camera adds
+                // the rows d(u)/dX = (P.row(0)[0:3] - u*P.row(2)[0:3]) / w (analogously for v and P.row(1))
+                auto m00 = 0., m01 = 0., m02 = 0., m11 = 0., m12 = 0., m22 = 0., b0 = 0., b1 = 0., b2 = 0.;
+                for (auto camera = 0 ; camera < numberCameras ; camera++)
+                {
+                    const auto index = camera*numberPoints + point;
+                    if (visibilities[index] == 0.)
+                        continue;
+                    const auto* const P = &cameraParams[12*camera];
+                    const auto oneOverW = 1. / (P[8]*xyz[0] + P[9]*xyz[1] + P[10]*xyz[2] + P[11]);
+                    for (auto row = 0 ; row < 2 ; row++)
+                    {
+                        const auto u = (P[4*row]*xyz[0] + P[4*row+1]*xyz[1] + P[4*row+2]*xyz[2] + P[4*row+3])
+                                     * oneOverW;
+                        const auto residual = u - (row == 0 ? xs[index] : ys[index]);
+                        const auto j0 = (P[4*row] - u*P[8]) * oneOverW;
+                        const auto j1 = (P[4*row+1] - u*P[9]) * oneOverW;
+                        const auto j2 = (P[4*row+2] - u*P[10]) * oneOverW;
+                        m00 += j0*j0; m01 += j0*j1; m02 += j0*j2;
+                        m11 += j1*j1; m12 += j1*j2; m22 += j2*j2;
+                        b0 -= j0*residual; b1 -= j1*residual; b2 -= j2*residual;
+                    }
+                }
+                double dx, dy, dz;
+                solveSymmetric3x3(dx, dy, dz, m00, m01, m02, m11, m12, m22, b0, b1, b2);
+                xyz[0] += dx;
+                xyz[1] += dy;
+                xyz[2] += dz;
+                reprojectionErrors[point] = getReprojectionErrorScalar(
+                    cameraParams.data(), numberCameras, xs.data(), ys.data(), visibilities.data(), numberPoints,
+                    point, xyz[0], xyz[1], xyz[2]);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void triangulateWithOptimizationBatch(
+        std::vector<double>& reconstructedPoints, std::vector<double>& reprojectionErrors,
+        const std::vector<cv::Mat>& cameraMatrices, const std::vector<double>& xs, const std::vector<double>& ys,
+        const std::vector<double>& visibilities, const int numberPoints, const double reprojectionMaxAcceptable)
+    {
+        try
+        {
+            triangulateBatch(
+                reconstructedPoints, reprojectionErrors, cameraMatrices, xs, ys, visibilities, numberPoints);
+            // Accurate (slower) fallback
+            std::vector<cv::Mat> cameraMatricesPoint;
+            std::vector<cv::Point2d> pointsOnEachCamera;
+            for (auto point = 0 ; point < numberPoints ; point++)
+            {
+                auto numberViews = 0u;
+                for (auto camera = 0u ; camera < cameraMatrices.size() ; camera++)
+                    numberViews += (visibilities[camera*numberPoints + point] != 0.);
+                const auto projectionError = reprojectionErrors[point];
+                if (!std::isfinite(reconstructedPoints[3*point]) || !std::isfinite(reconstructedPoints[3*point+1])
+                    || !std::isfinite(reconstructedPoints[3*point+2]) || !std::isfinite(projectionError)
+                    || isRansacRequired(numberViews, projectionError, reprojectionMaxAcceptable)
+                    || isLmaRequired(projectionError, reprojectionMaxAcceptable))
+                {
+                    cameraMatricesPoint.clear();
+                    pointsOnEachCamera.clear();
+                    for (auto camera = 0u ; camera < cameraMatrices.size() ; camera++)
+                    {
+                        const auto index = camera*numberPoints + point;
+                        if (visibilities[index] != 0.)
+                        {
+                            cameraMatricesPoint.emplace_back(cameraMatrices[camera]);
+                            pointsOnEachCamera.emplace_back(cv::Point2d{xs[index], ys[index]});
+                        }
+                    }
+                    cv::Mat reconstructedPoint;
+                    reprojectionErrors[point] = triangulateWithOptimization(
+                        reconstructedPoint, cameraMatricesPoint, pointsOnEachCamera, reprojectionMaxAcceptable);
+                    for (auto coordinate = 0 ; coordinate < 3 ; coordinate++)
+                        reconstructedPoints[3*point+coordinate] = reconstructedPoint.at<double>(coordinate);
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 }
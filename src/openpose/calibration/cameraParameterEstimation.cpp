@@ -1,6 +1,7 @@
 #include <openpose/calibration/cameraParameterEstimation.hpp>
 #include <fstream>
 #include <numeric> // std::accumulate
+#include <thread>
 #ifdef USE_CERES
     #include <ceres/ceres.h>
     #include <ceres/rotation.h>
@@ -16,10 +17,14 @@
 #include <openpose_private/3d/poseTriangulationPrivate.hpp>
 #include <openpose_private/calibration/gridPatternFunctions.hpp>
 #include <openpose_private/utilities/openCvMultiversionHeaders.hpp>
+#include <openpose_private/utilities/parallelFor.hpp>
 
 namespace op
 {
     // Private variables
+    // Bundle adjustment: With more cameras than this, the reduced camera system of the Schur complement is solved
+    // as a sparse matrix (if Ceres was compiled with a sparse linear algebra library)
+    const auto BUNDLE_ADJUSTMENT_DENSE_MAX_CAMERAS = 32;
     const long double PI = 3.141592653589793238462643383279502884197169399375105820974944592307816406286208998628034825342117067982148086513282306647093844;
 
     // Private functions
@@ -109,6 +114,49 @@ namespace op
         }
     }
 
+    std::string getCornerCacheFolder(const std::string& imageFolder, const bool useCornerCache)
+    {
+        try
+        {
+            if (!useCornerCache)
+                return "";
+            const auto cornerCacheFolder = imageFolder + "corners_cache/";
+            makeDirectory(cornerCacheFolder);
+            return cornerCacheFolder;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    // Reordered grid corners of each image. The images (of all the cameras) are processed in parallel, and
+    // cornerCacheFolder (if not empty) keeps the detections for the next runs
+    std::vector<std::pair<bool, std::vector<cv::Point2f>>> findGridCornersOfImages(
+        const std::vector<std::pair<cv::Mat, std::string>>& imageAndPaths, const cv::Size& gridInnerCornersCvSize,
+        const std::string& cornerCacheFolder, const bool showReorderWarning)
+    {
+        try
+        {
+            std::vector<std::pair<bool, std::vector<cv::Point2f>>> gridCorners(imageAndPaths.size());
+            parallelFor(0, (int)imageAndPaths.size(), [&](const int i)
+            {
+                const auto& image = imageAndPaths[i].first;
+                gridCorners[i] = findAccurateGridCornersCached(
+                    image, gridInnerCornersCvSize, imageAndPaths[i].second, cornerCacheFolder);
+                if (gridCorners[i].first)
+                    reorderPoints(gridCorners[i].second, gridInnerCornersCvSize, image, showReorderWarning);
+            });
+            return gridCorners;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
     std::pair<double, std::vector<double>> calcReprojectionErrors(
         const std::vector<std::vector<cv::Point3f>>& objects3DVectors,
         const std::vector<std::vector<cv::Point2f>>& points2DVectors, const std::vector<cv::Mat>& rVecs,
@@ -483,14 +531,16 @@ namespace op
 
         std::tuple<cv::Mat, cv::Mat, std::vector<cv::Point2f>, std::vector<cv::Point3f>> calcExtrinsicParametersOpenCV(
             const cv::Mat& image, const cv::Mat& cameraMatrix, const cv::Mat& distortionCoefficients,
-            const cv::Size& gridInnerCorners, const float gridSquareSizeMm)
+            const cv::Size& gridInnerCorners, const float gridSquareSizeMm, const std::string& imagePath,
+            const std::string& cornerCacheFolder)
         {
             try
             {
                 // Finding accurate chessboard corner positions
                 bool found{false};
                 std::vector<cv::Point2f> points2DVector;
-                std::tie(found, points2DVector) = findAccurateGridCorners(image, gridInnerCorners);
+                std::tie(found, points2DVector) = findAccurateGridCornersCached(
+                    image, gridInnerCorners, imagePath, cornerCacheFolder);
                 if (!found)
                     return std::make_tuple(cv::Mat(), cv::Mat(), std::vector<cv::Point2f>(),
                                            std::vector<cv::Point3f>());
@@ -521,7 +571,9 @@ namespace op
                                                              const cv::Size& gridInnerCorners,
                                                              const float gridSquareSizeMm,
                                                              const cv::Mat& cameraMatrix,
-                                                             const cv::Mat& distortionCoefficients)
+                                                             const cv::Mat& distortionCoefficients,
+                                                             const std::string& imagePath,
+                                                             const std::string& cornerCacheFolder)
         {
             try
             {
@@ -531,7 +583,8 @@ namespace op
                 cv::Mat tMmOpenCV;
                 std::tie(rVecOpenCV, tMmOpenCV, extrinsics.points2DVector, extrinsics.objects3DVector)
                         = calcExtrinsicParametersOpenCV(
-                            image, cameraMatrix, distortionCoefficients, gridInnerCorners, gridSquareSizeMm);
+                            image, cameraMatrix, distortionCoefficients, gridInnerCorners, gridSquareSizeMm,
+                            imagePath, cornerCacheFolder);
                 if (rVecOpenCV.empty())
                     return std::make_tuple(false, Extrinsics{});
 
@@ -550,7 +603,8 @@ namespace op
 
         std::tuple<bool, Eigen::Matrix3d, Eigen::Vector3d, Eigen::Matrix3d, Eigen::Vector3d> getExtrinsicParameters(
             const std::vector<std::string>& cameraPaths, const cv::Size& gridInnerCorners, const float gridSquareSizeMm,
-            const bool coutAndPlotGridCorners, const std::vector<cv::Mat>& intrinsics, const std::vector<cv::Mat>& distortions)
+            const bool coutAndPlotGridCorners, const std::vector<cv::Mat>& intrinsics, const std::vector<cv::Mat>& distortions,
+            const std::string& cornerCacheFolder)
         {
             try
             {
@@ -571,7 +625,8 @@ namespace op
                               __LINE__, __FUNCTION__, __FILE__);
                     bool valid;
                     std::tie(valid, extrinsicss[i]) = calcExtrinsicParameters(
-                        image, gridInnerCorners, gridSquareSizeMm, intrinsics.at(i), distortions.at(i));
+                        image, gridInnerCorners, gridSquareSizeMm, intrinsics.at(i), distortions.at(i), cameraPaths[i],
+                        cornerCacheFolder);
                     if (!valid)
                         return std::make_tuple(false, Eigen::Matrix3d{}, Eigen::Vector3d{}, Eigen::Matrix3d{},
                                                Eigen::Vector3d{});
@@ -740,7 +795,7 @@ namespace op
         const int cameraIndex, const int numberCameras, const int numberCorners, const unsigned int numberViews,
         const bool saveImagesWithCorners, const std::string& imageFolder, const cv::Size& gridInnerCornersCvSize,
         const cv::Size& imageSize, const std::vector<std::pair<cv::Mat, std::string>>& imageAndPaths,
-        const bool saveSIFTFile)
+        const bool saveSIFTFile, const std::vector<std::pair<bool, std::vector<cv::Point2f>>>& gridCorners)
     {
         try
         {
@@ -758,7 +813,8 @@ namespace op
             for (auto viewIndex = 0u ; viewIndex < numberViews ; viewIndex++)
             {
                 // Get right image
-                const auto& imageAndPath = imageAndPaths.at(viewIndex * numberCameras + cameraIndex);
+                const auto imageIndex = viewIndex * numberCameras + cameraIndex;
+                const auto& imageAndPath = imageAndPaths.at(imageIndex);
                 const auto& image = imageAndPath.first;
 
                 if (viewIndex % std::max(1, int(numberViews/4)) == 0)
@@ -771,15 +827,13 @@ namespace op
                     error("Detected images with different sizes in `" + imageFolder + "` All images"
                           " must have the same resolution.", __LINE__, __FUNCTION__, __FILE__);
 
-                // Find grid corners
-                bool found;
-                std::vector<cv::Point2f> points2DVector;
-                std::tie(found, points2DVector) = findAccurateGridCorners(image, gridInnerCornersCvSize);
+                // Grid corners (already found and reordered)
+                const auto found = gridCorners.at(imageIndex).first;
+                auto points2DVector = gridCorners.at(imageIndex).second;
 
-                // Reorder & save 2D pixels points
+                // Save 2D pixels points
                 if (found)
                 {
-                    reorderPoints(points2DVector, gridInnerCornersCvSize, image);
                     for (auto i = 0 ; i < numberCorners ; i++)
                         matchIndexesCamera.emplace_back(viewIndex * numberCorners + i);
                 }
@@ -858,7 +912,7 @@ namespace op
     void estimateAndSaveIntrinsics(
         const Point<int>& gridInnerCorners, const float gridSquareSizeMm, const int flags,
         const std::string& outputParameterFolder, const std::string& imageFolder, const std::string& serialNumber,
-        const bool saveImagesWithCorners)
+        const bool saveImagesWithCorners, const bool useCornerCache)
     {
         try
         {
@@ -875,29 +929,28 @@ namespace op
             std::vector<std::vector<cv::Point2f>> points2DVectors;
             std::vector<cv::Mat> imagesWithCorners;
             const auto imageSize = imageAndPaths.at(0).first.size();
+            // Sanity check
+            for (const auto& imageAndPath : imageAndPaths)
+                if (imageSize.width != imageAndPath.first.cols || imageSize.height != imageAndPath.first.rows)
+                    error("Detected images with different sizes in `" + imageFolder + "` All images"
+                          " must have the same resolution.", __LINE__, __FUNCTION__, __FILE__);
+            // Find grid corners (in parallel)
+            opLog("Finding grid corners in " + std::to_string(imageAndPaths.size()) + " images...",
+                Priority::High);
+            // For intrinsics order is irrelevant, so I do not care if it fails
+            const auto showWarning = false;
+            const auto gridCorners = findGridCornersOfImages(
+                imageAndPaths, gridInnerCornersCvSize, getCornerCacheFolder(imageFolder, useCornerCache),
+                showWarning);
             for (auto i = 0u ; i < imageAndPaths.size() ; i++)
             {
-                opLog("\nImage " + std::to_string(i+1) + "/" + std::to_string(imageAndPaths.size()), Priority::High);
                 const auto& image = imageAndPaths.at(i).first;
+                const auto found = gridCorners[i].first;
+                const auto& points2DVector = gridCorners[i].second;
 
-                // Sanity check
-                if (imageSize.width != image.cols || imageSize.height != image.rows)
-                    error("Detected images with different sizes in `" + imageFolder + "` All images"
-                          " must have the same resolution.", __LINE__, __FUNCTION__, __FILE__);
-
-                // Find grid corners
-                bool found;
-                std::vector<cv::Point2f> points2DVector;
-                std::tie(found, points2DVector) = findAccurateGridCorners(image, gridInnerCornersCvSize);
-
-                // Reorder & save 2D pixels points
+                // Save 2D pixels points
                 if (found)
-                {
-                    // For intrinsics order is irrelevant, so I do not care if it fails
-                    const auto showWarning = false;
-                    reorderPoints(points2DVector, gridInnerCornersCvSize, image, showWarning);
                     points2DVectors.emplace_back(points2DVector);
-                }
                 else
                     opLog("Chessboard not found in image " + imageAndPaths.at(i).second + ".", Priority::High);
 
@@ -967,7 +1020,7 @@ namespace op
     void estimateAndSaveExtrinsics(
         const std::string& parameterFolder, const std::string& imageFolder, const Point<int>& gridInnerCorners,
         const float gridSquareSizeMm, const int index0, const int index1, const bool imagesAreUndistorted,
-        const bool combineCam0Extrinsics)
+        const bool combineCam0Extrinsics, const bool useCornerCache)
     {
         try
         {
@@ -1032,6 +1085,18 @@ namespace op
                 const auto numberViews = imagePaths.size() / numberCameras;
                 auto counterValidImages = 0u;
                 std::vector<Eigen::Matrix4d> MCam1ToCam0s;
+                // Extrinsic parameters extractor of each view (in parallel)
+                const auto cornerCacheFolder = getCornerCacheFolder(imageFolder, useCornerCache);
+                std::vector<std::tuple<bool, Eigen::Matrix3d, Eigen::Vector3d, Eigen::Matrix3d, Eigen::Vector3d>>
+                    viewExtrinsics(numberViews);
+                parallelFor(0, (int)numberViews, [&](const int view)
+                {
+                    viewExtrinsics[view] = getExtrinsicParameters(
+                        {imagePaths[view*numberCameras+index0], imagePaths[view*numberCameras+index1]},
+                        gridInnerCornersCvSize, gridSquareSizeMm, false,
+                        // coutAndImshowVerbose, // It'd display all images with grid
+                        cameraIntrinsicsSubset, cameraDistortionsSubset, cornerCacheFolder);
+                });
                 for (auto i = 0u ; i < imagePaths.size() ; i+=numberCameras)
                 {
                     opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
@@ -1049,10 +1114,7 @@ namespace op
                     Eigen::Vector3d tGridToMainCam1;
                     bool valid = true;
                     std::tie(valid, RGridToMainCam0, tGridToMainCam0, RGridToMainCam1, tGridToMainCam1)
-                        = getExtrinsicParameters({pathCam0, pathCam1}, gridInnerCornersCvSize, gridSquareSizeMm,
-                                                 false,
-                                                 // coutAndImshowVerbose, // It'd display all images with grid
-                                                 cameraIntrinsicsSubset, cameraDistortionsSubset);
+                        = viewExtrinsics[i/numberCameras];
                     if (valid)
                     {
                         counterValidImages++;
@@ -1204,6 +1266,7 @@ namespace op
                 UNUSED(index1);
                 UNUSED(imagesAreUndistorted);
                 UNUSED(combineCam0Extrinsics);
+                UNUSED(useCornerCache);
                 error("CMake flag `USE_EIGEN` required when compiling OpenPose`.", __LINE__, __FUNCTION__, __FILE__);
             #endif
         }
@@ -1855,10 +1918,16 @@ namespace op
                 ceres::Solver::Options options;
                 // options.linear_solver_type = ceres::SPARSE_NORMAL_CHOLESKY;
                 // options.linear_solver_type = ceres::DENSE_QR;
-                options.linear_solver_type = ceres::DENSE_SCHUR;
+                // The points are eliminated with the Schur complement, so the reduced system is only 6 x cameras.
+                // Dense is faster for most camera rigs, sparse for very large ones
+                options.linear_solver_type = (
+                    numberCameras > BUNDLE_ADJUSTMENT_DENSE_MAX_CAMERAS
+                    && options.sparse_linear_algebra_library_type != ceres::NO_SPARSE
+                        ? ceres::SPARSE_SCHUR : ceres::DENSE_SCHUR);
                 options.use_nonmonotonic_steps = true;
                 options.minimizer_progress_to_stdout = true;
-                options.num_threads = 1;
+                // Multi-threaded evaluation of the residuals and Jacobians (and of the Schur complement)
+                options.num_threads = fastMax(1, (int)std::thread::hardware_concurrency());
                 // // Option 1/3) Computing things together
                 // const int numResiduals = 2 * BAValid.sum();  // x and y
                 // BundleAdjustmentCost* ptr_BA = new BundleAdjustmentCost(
@@ -2105,7 +2174,7 @@ namespace op
     void refineAndSaveExtrinsics(
         const std::string& parameterFolder, const std::string& imageFolder, const Point<int>& gridInnerCorners,
         const float gridSquareSizeMm, const int numberCameras, const bool imagesAreUndistorted,
-        const bool saveImagesWithCorners)
+        const bool saveImagesWithCorners, const bool useCornerCache)
     {
         try
         {
@@ -2173,6 +2242,9 @@ namespace op
                 const auto imageSize = imageAndPaths.at(0).first.size();
                 const auto numberViews = (unsigned int)(imageAndPaths.size() / numberCameras);
                 opLog("Processing cameras...", Priority::High);
+                // Grid corners of all the images of all the cameras (in parallel)
+                const auto gridCorners = findGridCornersOfImages(
+                    imageAndPaths, gridInnerCornersCvSize, getCornerCacheFolder(imageFolder, useCornerCache), true);
                 std::vector<std::thread> threads;
                 for (auto cameraIndex = 0 ; cameraIndex < numberCameras ; cameraIndex++)
                 {
@@ -2182,12 +2254,13 @@ namespace op
                     threads.emplace_back(estimateAndSaveSiftFileSubThread, points2DExtrinsic,
                                          matchIndexesCamera, cameraIndex, numberCameras,
                                          numberCorners, numberViews, saveImagesWithCorners, imageFolder,
-                                         gridInnerCornersCvSize, imageSize, imageAndPaths, saveVisualSFMFiles);
+                                         gridInnerCornersCvSize, imageSize, std::cref(imageAndPaths),
+                                         saveVisualSFMFiles, std::cref(gridCorners));
                     // // Non-threaded version
                     // estimateAndSaveSiftFileSubThread(points2DExtrinsic, matchIndexesCamera, cameraIndex, numberCameras,
                     //                                  numberCorners, numberViews, saveImagesWithCorners, imageFolder,
                     //                                  gridInnerCornersCvSize, imageSize, imageAndPaths,
-                    //                                  saveVisualSFMFiles);
+                    //                                  saveVisualSFMFiles, gridCorners);
                 }
                 // Threaded version
                 for (auto& thread : threads)
@@ -2327,6 +2400,7 @@ namespace op
                 UNUSED(numberCameras);
                 UNUSED(imagesAreUndistorted);
                 UNUSED(saveImagesWithCorners);
+                UNUSED(useCornerCache);
                 error("CMake flags `USE_CERES` and `USE_EIGEN` required when compiling OpenPose`.",
                       __LINE__, __FUNCTION__, __FILE__);
             #endif
@@ -2338,7 +2412,8 @@ namespace op
     }
 
     void estimateAndSaveSiftFile(const Point<int>& gridInnerCorners, const std::string& imageFolder,
-                                 const int numberCameras, const bool saveImagesWithCorners)
+                                 const int numberCameras, const bool saveImagesWithCorners,
+                                 const bool useCornerCache)
     {
         try
         {
@@ -2361,6 +2436,9 @@ namespace op
             const auto imageSize = imageAndPaths.at(0).first.size();
             const auto numberViews = (unsigned int)(imageAndPaths.size() / numberCameras);
             opLog("Processing cameras...", Priority::High);
+            // Grid corners of all the images of all the cameras (in parallel)
+            const auto gridCorners = findGridCornersOfImages(
+                imageAndPaths, gridInnerCornersCvSize, getCornerCacheFolder(imageFolder, useCornerCache), true);
             std::vector<std::thread> threads;
             for (auto cameraIndex = 0 ; cameraIndex < numberCameras ; cameraIndex++)
             {
@@ -2371,11 +2449,13 @@ namespace op
                 threads.emplace_back(estimateAndSaveSiftFileSubThread, points2DExtrinsic,
                                      matchIndexesCamera, cameraIndex, numberCameras,
                                      numberCorners, numberViews, saveImagesWithCorners, imageFolder,
-                                     gridInnerCornersCvSize, imageSize, imageAndPaths, saveSIFTFile);
+                                     gridInnerCornersCvSize, imageSize, std::cref(imageAndPaths), saveSIFTFile,
+                                     std::cref(gridCorners));
                 // // Non-threaded version
                 // estimateAndSaveSiftFileSubThread(points2DExtrinsic, matchIndexesCamera, cameraIndex, numberCameras,
                 //                                  numberCorners, numberViews, saveImagesWithCorners, imageFolder,
-                //                                  gridInnerCornersCvSize, imageSize, imageAndPaths, saveSIFTFile);
+                //                                  gridInnerCornersCvSize, imageSize, imageAndPaths, saveSIFTFile,
+                //                                  gridCorners);
             }
             // Threaded version
             for (auto& thread : threads)
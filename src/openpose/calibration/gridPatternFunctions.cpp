@@ -1,4 +1,6 @@
 #include <openpose_private/calibration/gridPatternFunctions.hpp>
+#include <cmath> // std::ceil
+#include <fstream>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/fileSystem.hpp>
 #include <openpose_private/utilities/openCvMultiversionHeaders.hpp>
@@ -207,8 +209,7 @@ namespace op
 
 
 
-    // Public functions
-    std::pair<bool, std::vector<cv::Point2f>> findAccurateGridCorners(
+    std::pair<bool, std::vector<cv::Point2f>> findAccurateGridCornersAtFullResolution(
         const cv::Mat& image, const cv::Size& gridInnerCorners)
     {
         try
@@ -234,6 +235,122 @@ namespace op
         }
     }
 
+    // Images whose longest side is larger than this (in pixels) are searched coarse-to-fine
+    const auto COARSE_GRID_MAX_SIDE = 1280;
+
+
+
+    // Public functions
+    std::pair<bool, std::vector<cv::Point2f>> findAccurateGridCorners(
+        const cv::Mat& image, const cv::Size& gridInnerCorners)
+    {
+        try
+        {
+            const auto downscale = std::max(image.cols, image.rows) / (double)COARSE_GRID_MAX_SIDE;
+            if (downscale <= 1.)
+                return findAccurateGridCornersAtFullResolution(image, gridInnerCorners);
+
+            // Coarse: the chessboard is located on a downscaled image (e.g., 12 MP -> ~1 MP), where
+            // cv::findChessboardCorners is an order of magnitude faster
+            cv::Mat imageCoarse;
+            cv::resize(image, imageCoarse, cv::Size{}, 1./downscale, 1./downscale, cv::INTER_AREA);
+            cv::cvtColor(imageCoarse, imageCoarse, CV_BGR2GRAY);
+            // Images without chessboard are discarded right away (rather than after all the retries of
+            // heavilyTryToFindGridCorners)
+            if (!cv::checkChessboard(imageCoarse, gridInnerCorners))
+                return std::make_pair(false, std::vector<cv::Point2f>());
+            auto foundGridCornersAndLocations = heavilyTryToFindGridCorners(imageCoarse, gridInnerCorners);
+            // Chessboard likely there but too small or blurry when downscaled
+            if (!foundGridCornersAndLocations.first)
+                return findAccurateGridCornersAtFullResolution(image, gridInnerCorners);
+            auto& points2DVector = foundGridCornersAndLocations.second;
+            improveCornersPositionsAtSubPixelLevel(points2DVector, imageCoarse);
+
+            // Fine: corners rescaled (pixel centers) and refined at full resolution, only converting the chessboard
+            // region (plus 1 square of margin for the cv::cornerSubPix windows) to grayscale
+            const auto scaleX = image.cols / (float)imageCoarse.cols;
+            const auto scaleY = image.rows / (float)imageCoarse.rows;
+            for (auto& point : points2DVector)
+                point = cv::Point2f{(point.x + 0.5f) * scaleX - 0.5f, (point.y + 0.5f) * scaleY - 0.5f};
+            const auto margin = (int)std::ceil(
+                cv::norm(cv::Mat(points2DVector.at(0) - points2DVector.at(1)), cv::NORM_INF)) + 1;
+            const auto boundingBox = cv::boundingRect(points2DVector);
+            const auto roi = cv::Rect{
+                boundingBox.x - margin, boundingBox.y - margin,
+                boundingBox.width + 2*margin, boundingBox.height + 2*margin} & cv::Rect{0, 0, image.cols, image.rows};
+            cv::Mat roiGray;
+            cv::cvtColor(image(roi), roiGray, CV_BGR2GRAY);
+            const auto roiOrigin = cv::Point2f{(float)roi.x, (float)roi.y};
+            for (auto& point : points2DVector)
+                point -= roiOrigin;
+            improveCornersPositionsAtSubPixelLevel(points2DVector, roiGray);
+            for (auto& point : points2DVector)
+                point += roiOrigin;
+
+            // return final result
+            return foundGridCornersAndLocations;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::make_pair(false, std::vector<cv::Point2f>());
+        }
+    }
+
+    std::pair<bool, std::vector<cv::Point2f>> findAccurateGridCornersCached(
+        const cv::Mat& image, const cv::Size& gridInnerCorners, const std::string& imagePath,
+        const std::string& cacheFolder)
+    {
+        try
+        {
+            if (cacheFolder.empty() || imagePath.empty())
+                return findAccurateGridCorners(image, gridInnerCorners);
+            // 1 file per image and grid size
+            const auto cachePath = cacheFolder + getFileNameAndExtension(imagePath) + "_"
+                + std::to_string(gridInnerCorners.width) + "x" + std::to_string(gridInnerCorners.height) + ".yml";
+            std::ifstream imageFile{imagePath, std::ios::binary | std::ios::ate};
+            const auto imageFileSize = (imageFile.is_open() ? (double)imageFile.tellg() : -1.);
+            // Cached corners
+            if (existFile(cachePath))
+            {
+                cv::FileStorage fileStorage{cachePath, cv::FileStorage::READ};
+                if (fileStorage.isOpened())
+                {
+                    int width = -1, height = -1, found = 0;
+                    double fileSize = -2.;
+                    fileStorage["ImageWidth"] >> width;
+                    fileStorage["ImageHeight"] >> height;
+                    fileStorage["ImageFileSize"] >> fileSize;
+                    fileStorage["Found"] >> found;
+                    std::vector<cv::Point2f> points2DVector;
+                    fileStorage["Corners"] >> points2DVector;
+                    if (width == image.cols && height == image.rows && fileSize == imageFileSize
+                        && (found == 0 || points2DVector.size() == (size_t)gridInnerCorners.area()))
+                        return std::make_pair(found != 0, points2DVector);
+                }
+            }
+            // Detect and cache them
+            const auto foundGridCornersAndLocations = findAccurateGridCorners(image, gridInnerCorners);
+            cv::FileStorage fileStorage{cachePath, cv::FileStorage::WRITE};
+            if (fileStorage.isOpened())
+            {
+                fileStorage << "ImageWidth" << image.cols;
+                fileStorage << "ImageHeight" << image.rows;
+                fileStorage << "ImageFileSize" << imageFileSize;
+                fileStorage << "Found" << int(foundGridCornersAndLocations.first);
+                fileStorage << "Corners" << foundGridCornersAndLocations.second;
+            }
+            else
+                opLog("Grid corners could not be cached in `" + cachePath + "`.", Priority::High);
+            return foundGridCornersAndLocations;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::make_pair(false, std::vector<cv::Point2f>());
+        }
+    }
+
     std::vector<cv::Point3f> getObjects3DVector(
         const cv::Size& gridInnerCorners, const float gridSquareSizeMm)
     {
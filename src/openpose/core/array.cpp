@@ -1,7 +1,10 @@
 #include <openpose/core/array.hpp>
+#include <algorithm> // std::copy, std::fill
 #include <typeinfo> // typeid
 #include <numeric> // std::accumulate
 #include <opencv2/core/core.hpp> // cv::Mat
+#include <openpose/core/pinnedMemory.hpp>
+#include <openpose/utilities/allocationTracker.hpp>
 #include <openpose_private/utilities/avx.hpp>
 
 // Note: std::shared_ptr not (fully) supported for array pointers:
@@ -18,16 +21,20 @@
 namespace op
 {
     /**
-     * Private auxiliar function that sets the cv::Mat wrapper and makes it point to the same data than
+     * Private auxiliar function that creates the cv::Mat wrapper and makes it point to the same data than
      * std::shared_ptr points to.
+     * @return Whether T is supported by OpenCV (cvMatData is empty otherwise).
      */
     template<typename T>
-    void setCvMatFromPtr(std::pair<bool, Matrix>& cvMatData, T* const dataPtr, const std::vector<int>& sizes)
+    bool setCvMatFromPtr(std::shared_ptr<Matrix>& cvMatData, T* const dataPtr, const std::vector<int>& sizes)
     {
         try
         {
-            cvMatData.first = true;
-            cvMatData.second = Matrix();
+            auto supported = true;
+            cvMatData = std::make_shared<Matrix>();
+            // Empty Array: Matrix available but empty
+            if (sizes.empty())
+                return true;
             // BGR image
             if (sizes.size() == 3 && sizes[2] == 3)
             {
@@ -44,12 +51,12 @@ namespace op
                 else if (typeid(T) == typeid(int))
                     cvFormat = CV_32SC3;
                 else
-                    cvMatData.first = false;
+                    supported = false;
 
-                if (cvMatData.first)
+                if (supported)
                 {
                     cv::Mat cvMat(sizes[0], sizes[1], cvFormat, dataPtr);
-                    cvMatData.second = OP_CV2OPMAT(cvMat);
+                    *cvMatData = OP_CV2OPMAT(cvMat);
                 }
             }
             // Any other type
@@ -68,23 +75,26 @@ namespace op
                 else if (typeid(T) == typeid(int))
                     cvFormat = CV_32SC1;
                 else
-                    cvMatData.first = false;
+                    supported = false;
 
-                if (cvMatData.first)
+                if (supported)
                 {
                     cv::Mat cvMat((int)sizes.size(), sizes.data(), cvFormat, dataPtr);
-                    cvMatData.second = OP_CV2OPMAT(cvMat);
+                    *cvMatData = OP_CV2OPMAT(cvMat);
                 }
             }
+            return supported;
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
         }
     }
 
     template<typename T>
-    Array<T>::Array(const int size)
+    Array<T>::Array(const int size) :
+        mCapacity{0}
     {
         try
         {
@@ -97,7 +107,8 @@ namespace op
     }
 
     template<typename T>
-    Array<T>::Array(const std::vector<int>& sizes)
+    Array<T>::Array(const std::vector<int>& sizes) :
+        mCapacity{0}
     {
         try
         {
@@ -110,7 +121,8 @@ namespace op
     }
 
     template<typename T>
-    Array<T>::Array(const int size, const T value)
+    Array<T>::Array(const int size, const T value) :
+        mCapacity{0}
     {
         try
         {
@@ -123,7 +135,8 @@ namespace op
     }
 
     template<typename T>
-    Array<T>::Array(const std::vector<int>& sizes, const T value)
+    Array<T>::Array(const std::vector<int>& sizes, const T value) :
+        mCapacity{0}
     {
         try
         {
@@ -136,7 +149,8 @@ namespace op
     }
 
     template<typename T>
-    Array<T>::Array(const int size, T* const dataPtr)
+    Array<T>::Array(const int size, T* const dataPtr) :
+        mCapacity{0}
     {
         try
         {
@@ -149,7 +163,8 @@ namespace op
     }
 
     template<typename T>
-    Array<T>::Array(const std::vector<int>& sizes, T* const dataPtr)
+    Array<T>::Array(const std::vector<int>& sizes, T* const dataPtr) :
+        mCapacity{0}
     {
         try
         {
@@ -162,7 +177,8 @@ namespace op
     }
 
     template<typename T>
-    Array<T>::Array(const Array<T>& array, const int index, const bool noCopy)
+    Array<T>::Array(const Array<T>& array, const int index, const bool noCopy) :
+        mCapacity{0}
     {
         try
         {
@@ -184,6 +200,7 @@ namespace op
                 const auto arrayArea = (int)array.getVolume(1);
                 const auto keypointsIndex = index*arrayArea;
                 std::copy(&array[keypointsIndex], &array[keypointsIndex]+arrayArea, pData);
+                AllocationTracker::recordCopy(arrayArea * sizeof(T), MemoryCopy::HostToHost);
             }
         }
         catch (const std::exception& e)
@@ -198,7 +215,8 @@ namespace op
         mVolume{array.mVolume},
         spData{array.spData},
         pData{array.pData},
-        mCvMatData{array.mCvMatData}
+        mCapacity{array.mCapacity},
+        spCvMatData{array.spCvMatData}
     {
     }
 
@@ -211,7 +229,8 @@ namespace op
             mVolume = array.mVolume;
             spData = array.spData;
             pData = array.pData;
-            mCvMatData = array.mCvMatData;
+            mCapacity = array.mCapacity;
+            spCvMatData = array.spCvMatData;
             // Return
             return *this;
         }
@@ -225,13 +244,15 @@ namespace op
     template<typename T>
     Array<T>::Array(Array<T>&& array) :
         mSize{array.mSize},
-        mVolume{array.mVolume}
+        mVolume{array.mVolume},
+        mCapacity{0}
     {
         try
         {
             std::swap(spData, array.spData);
             std::swap(pData, array.pData);
-            std::swap(mCvMatData, array.mCvMatData);
+            std::swap(mCapacity, array.mCapacity);
+            std::swap(spCvMatData, array.spCvMatData);
         }
         catch (const std::exception& e)
         {
@@ -248,7 +269,8 @@ namespace op
             mVolume = array.mVolume;
             std::swap(spData, array.spData);
             std::swap(pData, array.pData);
-            std::swap(mCvMatData, array.mCvMatData);
+            std::swap(mCapacity, array.mCapacity);
+            std::swap(spCvMatData, array.spCvMatData);
             // Return
             return *this;
         }
@@ -269,6 +291,7 @@ namespace op
             // Clone data
             // Equivalent: std::copy(spData.get(), spData.get() + mVolume, array.spData.get());
             std::copy(pData, pData + mVolume, array.pData);
+            AllocationTracker::recordCopy(mVolume * sizeof(T), MemoryCopy::HostToHost);
             // Return
             return array;
         }
@@ -279,6 +302,34 @@ namespace op
         }
     }
 
+    template<typename T>
+    bool Array<T>::isShared() const
+    {
+        try
+        {
+            return (pData != nullptr && (spData == nullptr || spData.use_count() > 1));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    template<typename T>
+    void Array<T>::makeUnique()
+    {
+        try
+        {
+            if (isShared())
+                *this = clone();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template<typename T>
     void Array<T>::reset(const int size)
     {
@@ -368,6 +419,49 @@ namespace op
         }
     }
 
+    template<typename T>
+    void Array<T>::reset(const std::vector<int>& sizes, T* const dataPtr, const std::shared_ptr<void>& owner)
+    {
+        try
+        {
+            reset(sizes, dataPtr);
+            // spData shares the ownership of the owner of dataPtr
+            if (owner != nullptr)
+                spData = std::shared_ptr<T>{owner, dataPtr};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename T>
+    void Array<T>::resetPinned(const std::vector<int>& sizes)
+    {
+        try
+        {
+            const auto volume = (sizes.empty()
+                ? 0ull : std::accumulate(sizes.begin(), sizes.end(), 1ull, std::multiplies<unsigned long long>()));
+            const auto spPinnedMemory = (volume > 0 ? getPinnedMemory(volume * sizeof(T)) : nullptr);
+            // Pinned memory not available: Regular memory
+            if (spPinnedMemory == nullptr)
+                reset(sizes);
+            // Pinned memory: spData shares the ownership of the pinned block
+            else
+            {
+                T* const dataPtr = (T*)spPinnedMemory.get();
+                resetAuxiliary(sizes, dataPtr);
+                spData = std::shared_ptr<T>{spPinnedMemory, dataPtr};
+                mCapacity = mVolume;
+                AllocationTracker::recordHostAllocation(volume * sizeof(T));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template<typename T>
     void Array<T>::setFrom(const Matrix& cvMat)
     {
@@ -382,10 +476,11 @@ namespace op
                 // Reset data & volume
                 reset(newSize);
                 // Integrity checks
-                if (!mCvMatData.first || mCvMatData.second.type() != cvMat.type())
+                auto& cvMatData = getCvMat();
+                if (cvMatData.type() != cvMat.type())
                     error("Array<T>: T type and cvMat type are different.", __LINE__, __FUNCTION__, __FILE__);
                 // Fill data
-                cvMat.copyTo(mCvMatData.second);
+                cvMat.copyTo(cvMatData);
             }
             else
                 reset();
@@ -401,14 +496,32 @@ namespace op
     {
         try
         {
+            // Vectorized by the compiler, and it does not need the Matrix wrapper
             if (mVolume > 0)
+                std::fill(pData, pData + mVolume, value);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename T>
+    void Array<T>::shrinkFirstDimension(const int size0)
+    {
+        try
+        {
+            // Sanity check
+            if (size0 < 0 || size0 > getSize(0))
+                error("size0 (" + std::to_string(size0) + ") must be in the range [0, " + std::to_string(getSize(0))
+                      + "].", __LINE__, __FUNCTION__, __FILE__);
+            if (size0 == 0)
+                reset();
+            else if (size0 < mSize[0])
             {
-                // OpenCV is efficient on copying (AVX, SSE, etc.)
-                if (mCvMatData.first)
-                    mCvMatData.second.setTo((double)value);
-                else
-                    for (auto i = 0u ; i < mVolume ; i++)
-                        operator[](i) = value;
+                mVolume = mVolume / mSize[0] * size0;
+                mSize[0] = size0;
+                spCvMatData.reset();
             }
         }
         catch (const std::exception& e)
@@ -539,15 +652,12 @@ namespace op
     {
         try
         {
-            if (!mCvMatData.first)
-                error("Array<T>: Matrix functions only valid for T types defined by OpenCV: unsigned char,"
-                      " signed char, int, float & double", __LINE__, __FUNCTION__, __FILE__);
-            return mCvMatData.second;
+            return commonCvMat();
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return mCvMatData.second;
+            return *spCvMatData;
         }
     }
 
@@ -556,15 +666,12 @@ namespace op
     {
         try
         {
-            if (!mCvMatData.first)
-                error("Array<T>: Matrix functions only valid for T types defined by OpenCV: unsigned char,"
-                      " signed char, int, float & double", __LINE__, __FUNCTION__, __FILE__);
-            return mCvMatData.second;
+            return commonCvMat();
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return mCvMatData.second;
+            return *spCvMatData;
         }
     }
 
@@ -657,11 +764,40 @@ namespace op
         }
     }
 
+    template<typename T>
+    Matrix& Array<T>::commonCvMat() const
+    {
+        try
+        {
+            // Lazy Matrix wrapper
+            const auto supported = (spCvMatData == nullptr
+                ? setCvMatFromPtr(spCvMatData, pData, mSize) // spData.get()
+                : true);
+            if (!supported)
+            {
+                // Not cached, so every call raises the error (rather than returning an empty Matrix)
+                spCvMatData.reset();
+                error("Array<T>: Matrix functions only valid for T types defined by OpenCV: unsigned char,"
+                      " signed char, int, float & double", __LINE__, __FUNCTION__, __FILE__);
+            }
+            return *spCvMatData;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return *spCvMatData;
+        }
+    }
+
     template<typename T>
     void Array<T>::resetAuxiliary(const std::vector<int>& sizes, T* const dataPtr)
     {
         try
         {
+            // The Matrix wrapper is re-created on demand (see commonCvMat())
+            spCvMatData.reset();
+            // Memory allocated by this Array<T> and not shared with any other one (so it can be reused)
+            const auto ownsMemory = (spData != nullptr && mCapacity > 0 && spData.use_count() == 1);
             if (!sizes.empty())
             {
                 // New size & volume
@@ -670,32 +806,43 @@ namespace op
                 // Prepare shared_ptr
                 if (dataPtr == nullptr)
                 {
-                    #ifdef WITH_AVX
-                        spData = aligned_shared_ptr<T>(mVolume);
-                    #else
-                        spData.reset(new T[mVolume], std::default_delete<T[]>());
-                    #endif
-                    pData = spData.get();
-                    // Sanity check
-                    if (pData == nullptr)
-                        error("Shared pointer could not be allocated for Array data storage.",
-                              __LINE__, __FUNCTION__, __FILE__);
+                    // Reuse the current memory if it fits
+                    if (ownsMemory && mVolume <= mCapacity)
+                        pData = spData.get();
+                    else
+                    {
+                        #ifdef WITH_AVX
+                            spData = aligned_shared_ptr<T>(mVolume);
+                        #else
+                            spData.reset(new T[mVolume], std::default_delete<T[]>());
+                        #endif
+                        pData = spData.get();
+                        mCapacity = mVolume;
+                        // Sanity check
+                        if (pData == nullptr)
+                            error("Shared pointer could not be allocated for Array data storage.",
+                                  __LINE__, __FUNCTION__, __FILE__);
+                        AllocationTracker::recordHostAllocation(mVolume * sizeof(T));
+                    }
                 }
                 else
                 {
                     spData.reset();
                     pData = dataPtr;
+                    mCapacity = 0;
                 }
-                setCvMatFromPtr(mCvMatData, pData, mSize); // spData.get()
             }
             else
             {
                 mSize = {};
                 mVolume = 0ul;
-                spData.reset();
+                // It keeps its own memory for the next reset()
+                if (!ownsMemory)
+                {
+                    spData.reset();
+                    mCapacity = 0;
+                }
                 pData = nullptr;
-                // Matrix available but empty
-                mCvMatData = std::make_pair(true, Matrix());
             }
         }
         catch (const std::exception& e)
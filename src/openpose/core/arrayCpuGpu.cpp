@@ -2,6 +2,11 @@
 #ifdef USE_CAFFE
     #include <caffe/blob.hpp>
 #endif
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+#endif
+#include <openpose/gpu/cudaMemoryPool.hpp>
+#include <openpose/utilities/allocationTracker.hpp>
 #include <openpose/utilities/errorAndLog.hpp>
 
 namespace op
@@ -17,6 +22,60 @@ namespace op
                 std::unique_ptr<caffe::Blob<T>> upCaffeBlobT;
                 caffe::Blob<T>* pCaffeBlobT;
             #endif
+            // Same as the Caffe blob capacity (it re-allocates its memory when it is reshaped into a larger count)
+            int mCapacity;
+            // Device memory attributed to a CudaMemoryOwner (the one of its 1st allocation)
+            const char* pOwner;
+            int mOwnerGpuId;
+            long long mOwnerBytes;
+
+            ImplArrayCpuGpu() :
+                mCapacity{0},
+                pOwner{nullptr},
+                mOwnerGpuId{-1},
+                mOwnerBytes{0}
+            {
+            }
+
+            ~ImplArrayCpuGpu()
+            {
+                try
+                {
+                    if (mOwnerBytes > 0)
+                        addCudaMemoryOwnerBytes(pOwner, mOwnerGpuId, -mOwnerBytes);
+                }
+                catch (const std::exception& e)
+                {
+                    errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            // The Caffe memory is lazily allocated on its first access, so it is attributed to the device that
+            // OpenPose mostly uses it on
+            void recordAllocation()
+            {
+                if (pCaffeBlobT->count() > mCapacity)
+                {
+                    mCapacity = pCaffeBlobT->count();
+                    #ifdef USE_CUDA
+                        AllocationTracker::recordGpuAllocation(mCapacity * sizeof(T));
+                        // Wrapped blobs (e.g., the NetCaffe ones) are attributed by their owner
+                        if (upCaffeBlobT != nullptr)
+                        {
+                            if (mOwnerGpuId < 0)
+                            {
+                                pOwner = CudaMemoryOwner::getCurrentOwner();
+                                cudaGetDevice(&mOwnerGpuId);
+                            }
+                            const auto ownerBytes = (long long)(mCapacity * sizeof(T));
+                            addCudaMemoryOwnerBytes(pOwner, mOwnerGpuId, ownerBytes - mOwnerBytes);
+                            mOwnerBytes = ownerBytes;
+                        }
+                    #else
+                        AllocationTracker::recordHostAllocation(mCapacity * sizeof(T));
+                    #endif
+                }
+            }
         #endif
     };
 
@@ -59,6 +118,8 @@ namespace op
                 #else
                     spImpl->pCaffeBlobT = (caffe::Blob<T>*)caffeBlobTPtr;
                 #endif
+                // Memory owned (and, if any, already allocated) by the wrapped blob
+                spImpl->mCapacity = spImpl->pCaffeBlobT->count();
             #else
                 UNUSED(caffeBlobTPtr);
                 error(constructorErrorMessage, __LINE__, __FUNCTION__, __FILE__);
@@ -93,12 +154,15 @@ namespace op
                     spImpl->upCaffeBlobT.reset(new caffe::Blob<T>{arraySize});
                 #endif
                 spImpl->pCaffeBlobT = spImpl->upCaffeBlobT.get();
+                spImpl->mCapacity = spImpl->pCaffeBlobT->count();
                 // Copy data
                 // CPU copy
                 if (!copyFromGpu)
                 {
                     const auto* const arrayPtr = array.getConstPtr();
                     std::copy(arrayPtr, arrayPtr + array.getVolume(), spImpl->pCaffeBlobT->mutable_cpu_data());
+                    AllocationTracker::recordHostAllocation(spImpl->mCapacity * sizeof(T));
+                    AllocationTracker::recordCopy(array.getVolume() * sizeof(T), MemoryCopy::HostToHost);
                 }
                 // GPU copy
                 else
@@ -130,6 +194,7 @@ namespace op
                     spImpl->upCaffeBlobT.reset(new caffe::Blob<T>{num, channels, height, width});
                 #endif
                 spImpl->pCaffeBlobT = spImpl->upCaffeBlobT.get();
+                spImpl->recordAllocation();
             #else
                 UNUSED(num);
                 UNUSED(channels);
@@ -170,6 +235,7 @@ namespace op
         {
             #ifdef USE_CAFFE
                 spImpl->pCaffeBlobT->Reshape(num, channels, height, width);
+                spImpl->recordAllocation();
             #else
                 UNUSED(num);
                 UNUSED(channels);
@@ -190,6 +256,7 @@ namespace op
         {
             #ifdef USE_CAFFE
                 spImpl->pCaffeBlobT->Reshape(shape);
+                spImpl->recordAllocation();
             #else
                 UNUSED(shape);
             #endif
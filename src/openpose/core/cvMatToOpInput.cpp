@@ -1,9 +1,11 @@
 #include <openpose/core/cvMatToOpInput.hpp>
 #ifdef USE_CUDA
     #include <openpose/gpu/cuda.hpp>
+    #include <openpose/gpu/cudaMemoryPool.hpp>
     #include <openpose/net/resizeAndMergeBase.hpp>
     #include <openpose_private/gpu/cuda.hu>
 #endif
+#include <openpose/utilities/allocationTracker.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/openCv.hpp>
 #include <openpose_private/utilities/openCvPrivate.hpp>
@@ -37,17 +39,17 @@ namespace op
                     cudaCheck(__LINE__, __FUNCTION__, __FILE__);
                     if (pInputImageCuda != nullptr)
                     {
-                        cudaFree(pInputImageCuda);
+                        cudaPoolFree(pInputImageCuda);
                         pInputImageCuda = nullptr;
                     }
                     if (pOutputImageCuda != nullptr)
                     {
-                        cudaFree(pOutputImageCuda);
+                        cudaPoolFree(pOutputImageCuda);
                         pOutputImageCuda = nullptr;
                     }
                     if (pInputImageReorderedCuda != nullptr)
                     {
-                        cudaFree(pInputImageReorderedCuda);
+                        cudaPoolFree(pInputImageReorderedCuda);
                         pInputImageReorderedCuda = nullptr;
                     }
                     cudaCheck(__LINE__, __FUNCTION__, __FILE__);
@@ -60,45 +62,143 @@ namespace op
         }
     }
 
+    Matrix getInputDataRoi(
+        const Matrix& inputData, const std::vector<Point<int>>& inputRoi, const Rectangle<int>& inputRoiRectangle)
+    {
+        try
+        {
+            // Bounding box (no copy)
+            const cv::Mat cvInputData = OP_OP2CVCONSTMAT(inputData);
+            const cv::Rect cvInputRoiRectangle{
+                inputRoiRectangle.x, inputRoiRectangle.y, inputRoiRectangle.width, inputRoiRectangle.height};
+            cv::Mat cvInputDataRoi = cvInputData(cvInputRoiRectangle & cv::Rect{0, 0, cvInputData.cols,
+                                                                                cvInputData.rows});
+            // Polygon: area outside it masked out
+            if (inputRoi.size() > 2)
+            {
+                std::vector<std::vector<cv::Point>> cvPolygon(1);
+                for (const auto& point : inputRoi)
+                    cvPolygon[0].emplace_back(point.x - inputRoiRectangle.x, point.y - inputRoiRectangle.y);
+                cv::Mat cvMask = cv::Mat::zeros(cvInputDataRoi.size(), CV_8UC1);
+                cv::fillPoly(cvMask, cvPolygon, cv::Scalar{255});
+                cv::Mat cvInputDataMasked = cv::Mat::zeros(cvInputDataRoi.size(), cvInputDataRoi.type());
+                cvInputDataRoi.copyTo(cvInputDataMasked, cvMask);
+                cvInputDataRoi = cvInputDataMasked;
+            }
+            return OP_CV2OPMAT(cvInputDataRoi);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Matrix{};
+        }
+    }
+
     std::vector<Array<float>> CvMatToOpInput::createArray(
-        const Matrix& inputData, const std::vector<double>& scaleInputToNetInputs,
-        const std::vector<Point<int>>& netInputSizes)
+        const Matrix& inputDataFull, const std::vector<double>& scaleInputToNetInputs,
+        const std::vector<Point<int>>& netInputSizes, const FrameGpu& inputDataGpu,
+        const std::vector<Point<int>>& inputRoi, const Rectangle<int>& inputRoiRectangle)
     {
         try
         {
+            // Static region of interest: Only its bounding box is resized into the network input
+            if (!inputRoi.empty() && !inputDataGpu.empty())
+                error("The input region of interest (Datum::inputRoi) requires the input frames in CPU memory (e.g.,"
+                      " it is not compatible with `--nv_decode` nor `--flir_bayer_gpu` unless the frames are also"
+                      " downloaded).", __LINE__, __FUNCTION__, __FILE__);
+            const auto inputData = (inputRoi.empty() || inputDataFull.empty()
+                ? inputDataFull : getInputDataRoi(inputDataFull, inputRoi, inputRoiRectangle));
             // Sanity checks
-            if (inputData.empty())
-                error("Wrong input element (empty inputData).", __LINE__, __FUNCTION__, __FILE__);
-            if (inputData.channels() != 3)
-                error("Input images must be 3-channel BGR.", __LINE__, __FUNCTION__, __FILE__);
+            const auto frameGpu = !inputDataGpu.empty();
+            if (frameGpu)
+            {
+                if (!mGpuResize)
+                    error("GPU input frames (inputDataGpu) require CvMatToOpInput with gpuResize = true.",
+                        __LINE__, __FUNCTION__, __FILE__);
+            }
+            else
+            {
+                if (inputData.empty())
+                    error("Wrong input element (empty inputData).", __LINE__, __FUNCTION__, __FILE__);
+                if (inputData.channels() != 3)
+                    error("Input images must be 3-channel BGR.", __LINE__, __FUNCTION__, __FILE__);
+            }
             if (scaleInputToNetInputs.size() != netInputSizes.size())
                 error("scaleInputToNetInputs.size() != netInputSizes.size().", __LINE__, __FUNCTION__, __FILE__);
             // inputNetData - Reescale keeping aspect ratio and transform to float the input deep net image
             const auto numberScales = (int)scaleInputToNetInputs.size();
             std::vector<Array<float>> inputNetData(numberScales);
-            cv::Mat cvInputData = OP_OP2CVCONSTMAT(inputData);
-            for (auto i = 0u ; i < inputNetData.size() ; i++)
+            // CPU version (faster if #Gpus <= 3 and relatively small images): all the scales are resized, padded and
+            // normalized in a single (parallel) pass over inputData, with no intermediate images
+            if (!frameGpu && !mGpuResize)
             {
-                // CPU version (faster if #Gpus <= 3 and relatively small images)
-                if (!mGpuResize)
+                std::vector<float*> inputNetDataPtrs(numberScales);
+                for (auto i = 0 ; i < numberScales ; i++)
                 {
-                    cv::Mat frameWithNetSize;
-                    resizeFixedAspectRatio(frameWithNetSize, cvInputData, scaleInputToNetInputs[i], netInputSizes[i]);
-                    // Fill inputNetData[i]
-                    inputNetData[i].reset({1, 3, netInputSizes.at(i).y, netInputSizes.at(i).x});
-                    uCharCvMatToFloatPtr(
-                        inputNetData[i].getPtr(), OP_CV2OPMAT(frameWithNetSize),
-                        (mPoseModel == PoseModel::BODY_19N ? 2 : 1));
+                    inputNetData[i].resetPinned({1, 3, netInputSizes.at(i).y, netInputSizes.at(i).x});
+                    inputNetDataPtrs[i] = inputNetData[i].getPtr();
+                }
+                resizeAndPadUCharCvMatToFloatPtrs(
+                    inputNetDataPtrs, inputData, scaleInputToNetInputs, netInputSizes,
+                    (mPoseModel == PoseModel::BODY_19N ? 2 : 1));
 
-                    // // OpenCV equivalent
-                    // const auto scale = 1/255.;
-                    // const cv::Scalar mean{128,128,128};
-                    // const cv::Size outputSize{netInputSizes[i].x, netInputSizes[i].y};
-                    // // cv::Mat cvMat;
-                    // cv::dnn::blobFromImage(
-                    //     // frameWithNetSize, cvMat, scale, outputSize, mean);
-                    //     frameWithNetSize, inputNetData[i].getCvMat(), scale, outputSize, mean);
-                    // // opLog(cv::norm(cvMat - inputNetData[i].getCvMat())); // ~0.25
+                return inputNetData;
+            }
+            for (auto i = 0u ; i < inputNetData.size() ; i++)
+            {
+                // NV12, Bayer or BGR frame already in GPU memory (e.g., NVDEC or FLIR raw Bayer): no host image nor
+                // host-to-device copy
+                if (frameGpu)
+                {
+                    #ifdef USE_CUDA
+                        // The frame lives in the GPU of its decoder (or of its upload)
+                        cudaSetDevice(inputDataGpu.gpuId);
+                        // (Re)Allocate temporary memory
+                        const unsigned int outputImageSize = 3 * netInputSizes[i].x * netInputSizes[i].y;
+                        if (pOutputMaxSize < outputImageSize)
+                        {
+                            pOutputMaxSize = outputImageSize;
+                            // Free temporary memory
+                            cudaPoolFree(pOutputImageCuda);
+                            // Re-allocate memory
+                            pOutputImageCuda = (float*)cudaPoolMalloc(sizeof(float) * outputImageSize);
+                        }
+                        // Resize, color conversion (or demosaicing), rotation/flip, undistortion (if any) and
+                        // normalization on GPU
+                        // Frames written asynchronously by their producer
+                        if (inputDataGpu.cudaStream != nullptr)
+                            cudaStreamSynchronize(inputDataGpu.cudaStream);
+                        if (inputDataGpu.format == FrameGpuFormat::Nv12)
+                            resizeAndPadNv12Gpu(
+                                pOutputImageCuda, inputDataGpu.dataPtr.get(), inputDataGpu.width,
+                                inputDataGpu.height, inputDataGpu.pitch, inputDataGpu.bt709, inputDataGpu.fullRange,
+                                netInputSizes[i].x, netInputSizes[i].y, (float)scaleInputToNetInputs[i],
+                                (mPoseModel == PoseModel::BODY_19N ? 2 : 1), nullptr,
+                                inputDataGpu.undistortMapPtr.get(), inputDataGpu.rotation, inputDataGpu.flip);
+                        else if (inputDataGpu.format == FrameGpuFormat::Bgr)
+                            resizeAndPadBgrFrameGpu(
+                                pOutputImageCuda, inputDataGpu.dataPtr.get(), inputDataGpu.width,
+                                inputDataGpu.height, inputDataGpu.pitch, netInputSizes[i].x, netInputSizes[i].y,
+                                (float)scaleInputToNetInputs[i], (mPoseModel == PoseModel::BODY_19N ? 2 : 1), nullptr,
+                                inputDataGpu.undistortMapPtr.get(), inputDataGpu.rotation, inputDataGpu.flip);
+                        else
+                            resizeAndPadBayerGpu(
+                                pOutputImageCuda, inputDataGpu.dataPtr.get(), inputDataGpu.width,
+                                inputDataGpu.height, inputDataGpu.pitch, inputDataGpu.format, netInputSizes[i].x,
+                                netInputSizes[i].y, (float)scaleInputToNetInputs[i],
+                                (mPoseModel == PoseModel::BODY_19N ? 2 : 1), nullptr,
+                                inputDataGpu.undistortMapPtr.get(), inputDataGpu.rotation, inputDataGpu.flip);
+                        // Copy back to CPU (only the network input, already resized)
+                        inputNetData[i].resetPinned({1, 3, netInputSizes.at(i).y, netInputSizes.at(i).x});
+                        cudaMemcpy(
+                            inputNetData[i].getPtr(), pOutputImageCuda, sizeof(float) * outputImageSize,
+                            cudaMemcpyDeviceToHost);
+                        AllocationTracker::recordCopy(sizeof(float) * outputImageSize, MemoryCopy::DeviceToHost);
+                        cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    #else
+                        error("You need to compile OpenPose with CUDA support in order to use GPU resize.",
+                            __LINE__, __FUNCTION__, __FILE__);
+                    #endif
                 }
                 // CUDA version (if #Gpus > n)
                 else
@@ -107,6 +207,7 @@ namespace op
                     error("This version reduces the global accuracy about 0.1%, so it is disabled for now.",
                         __LINE__, __FUNCTION__, __FILE__);
                     #ifdef USE_CUDA
+                        const cv::Mat cvInputData = OP_OP2CVCONSTMAT(inputData);
                         // (Re)Allocate temporary memory
                         const unsigned int inputImageSize = 3 * cvInputData.rows * cvInputData.cols;
                         const unsigned int outputImageSize = 3 * netInputSizes[i].x * netInputSizes[i].y;
@@ -114,19 +215,19 @@ namespace op
                         {
                             pInputMaxSize = inputImageSize;
                             // Free temporary memory
-                            cudaFree(pInputImageCuda);
-                            cudaFree(pInputImageReorderedCuda);
+                            cudaPoolFree(pInputImageCuda);
+                            cudaPoolFree(pInputImageReorderedCuda);
                             // Re-allocate memory
-                            cudaMalloc((void**)&pInputImageCuda, sizeof(unsigned char) * inputImageSize);
-                            cudaMalloc((void**)&pInputImageReorderedCuda, sizeof(float) * inputImageSize);
+                            pInputImageCuda = (unsigned char*)cudaPoolMalloc(sizeof(unsigned char) * inputImageSize);
+                            pInputImageReorderedCuda = (float*)cudaPoolMalloc(sizeof(float) * inputImageSize);
                         }
                         if (pOutputMaxSize < outputImageSize)
                         {
                             pOutputMaxSize = outputImageSize;
                             // Free temporary memory
-                            cudaFree(pOutputImageCuda);
+                            cudaPoolFree(pOutputImageCuda);
                             // Re-allocate memory
-                            cudaMalloc((void**)&pOutputImageCuda, sizeof(float) * outputImageSize);
+                            pOutputImageCuda = (float*)cudaPoolMalloc(sizeof(float) * outputImageSize);
                         }
                         // Copy image to GPU
                         cudaMemcpy(
@@ -139,7 +240,7 @@ namespace op
                             pOutputImageCuda, pInputImageReorderedCuda, cvInputData.cols, cvInputData.rows,
                             netInputSizes[i].x, netInputSizes[i].y, (float)scaleInputToNetInputs[i]);
                         // Copy back to CPU
-                        inputNetData[i].reset({1, 3, netInputSizes.at(i).y, netInputSizes.at(i).x});
+                        inputNetData[i].resetPinned({1, 3, netInputSizes.at(i).y, netInputSizes.at(i).x});
                         cudaMemcpy(
                             inputNetData[i].getPtr(), pOutputImageCuda, sizeof(float) * outputImageSize,
                             cudaMemcpyDeviceToHost);
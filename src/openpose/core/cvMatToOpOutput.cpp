@@ -1,9 +1,11 @@
 #include <openpose/core/cvMatToOpOutput.hpp>
 #ifdef USE_CUDA
     #include <openpose/gpu/cuda.hpp>
+    #include <openpose/gpu/cudaMemoryPool.hpp>
     #include <openpose/net/resizeAndMergeBase.hpp>
     #include <openpose_private/gpu/cuda.hu>
 #endif
+#include <openpose/utilities/allocationTracker.hpp>
 #include <openpose_private/utilities/openCvPrivate.hpp>
 
 namespace op
@@ -41,12 +43,12 @@ namespace op
                     cudaCheck(__LINE__, __FUNCTION__, __FILE__);
                     if (pInputImageCuda != nullptr)
                     {
-                        cudaFree(pInputImageCuda);
+                        cudaPoolFree(pInputImageCuda);
                         pInputImageCuda = nullptr;
                     }
                     if (*spOutputImageCuda != nullptr)
                     {
-                        cudaFree(*spOutputImageCuda);
+                        cudaPoolFree(*spOutputImageCuda);
                         *spOutputImageCuda = nullptr;
                     }
                     cudaCheck(__LINE__, __FUNCTION__, __FILE__);
@@ -75,6 +77,36 @@ namespace op
 
     Array<float> CvMatToOpOutput::createArray(
          const Matrix& inputData, const double scaleInputToOutput, const Point<int>& outputResolution)
+    {
+        try
+        {
+            return createArray(inputData, scaleInputToOutput, outputResolution, nullptr);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<float>{};
+        }
+    }
+
+    Array<float> CvMatToOpOutput::createArray(
+        const Matrix& inputData, const double scaleInputToOutput, const Point<int>& outputResolution,
+        RenderTargetGpu& outputDataGpu)
+    {
+        try
+        {
+            return createArray(inputData, scaleInputToOutput, outputResolution, &outputDataGpu);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<float>{};
+        }
+    }
+
+    Array<float> CvMatToOpOutput::createArray(
+        const Matrix& inputData, const double scaleInputToOutput, const Point<int>& outputResolution,
+        RenderTargetGpu* const outputDataGpu)
     {
         try
         {
@@ -94,7 +126,12 @@ namespace op
             if (!mGpuResize)
             {
                 cv::Mat frameWithOutputSize;
-                resizeFixedAspectRatio(frameWithOutputSize, cvInputData, scaleInputToOutput, outputResolution);
+                if (scaleInputToOutput != 1.
+                    || outputResolution.x != cvInputData.cols || outputResolution.y != cvInputData.rows)
+                    resizeFixedAspectRatio(frameWithOutputSize, cvInputData, scaleInputToOutput, outputResolution);
+                // No resize required: cvInputData is only read, so it is shared rather than copied
+                else
+                    frameWithOutputSize = cvInputData;
                 // Equivalent: frameWithOutputSize.convertTo(outputData.getCvMat(), CV_32FC3);
                 cv::Mat cvOutputData = OP_OP2CVMAT(outputData.getCvMat());
                 frameWithOutputSize.convertTo(cvOutputData, CV_32FC3);
@@ -110,30 +147,46 @@ namespace op
                     if (pInputMaxSize < inputImageSize)
                     {
                         pInputMaxSize = inputImageSize;
-                        cudaFree(pInputImageCuda);
-                        cudaMalloc((void**)&pInputImageCuda, sizeof(unsigned char) * inputImageSize);
+                        cudaPoolFree(pInputImageCuda);
+                        pInputImageCuda = (unsigned char*)cudaPoolMalloc(sizeof(unsigned char) * inputImageSize);
                     }
-                    // (Free and re-)Allocate temporary memory
-                    const unsigned int outputImageSize = 3 * outputResolution.x * outputResolution.y;
-                    if (*spOutputMaxSize < outputImageSize)
+                    // Output image: render target of the Datum or memory shared with the following GPU renderers
+                    float* outputImageCuda;
+                    if (outputDataGpu != nullptr)
+                    {
+                        outputDataGpu->allocate(outputResolution.x, outputResolution.y);
+                        outputImageCuda = outputDataGpu->dataPtr.get();
+                    }
+                    else
                     {
-                        *spOutputMaxSize = outputImageSize;
-                        cudaFree(*spOutputImageCuda);
-                        cudaMalloc((void**)spOutputImageCuda.get(), sizeof(float) * outputImageSize);
+                        // (Free and re-)Allocate temporary memory
+                        const unsigned int outputImageSize = 3 * outputResolution.x * outputResolution.y;
+                        if (*spOutputMaxSize < outputImageSize)
+                        {
+                            *spOutputMaxSize = outputImageSize;
+                            cudaPoolFree(*spOutputImageCuda);
+                            *spOutputImageCuda = (float*)cudaPoolMalloc(sizeof(float) * outputImageSize);
+                        }
+                        outputImageCuda = *spOutputImageCuda;
                     }
                     // Copy original image to GPU
                     cudaMemcpy(
                         pInputImageCuda, cvInputData.data, sizeof(unsigned char) * inputImageSize, cudaMemcpyHostToDevice);
-                    // Resize output image on GPU
-                    resizeAndPadRbgGpu(
-                        *spOutputImageCuda, pInputImageCuda, cvInputData.cols, cvInputData.rows, outputResolution.x,
+                    AllocationTracker::recordCopy(sizeof(unsigned char) * inputImageSize, MemoryCopy::HostToDevice);
+                    // Resize output image on GPU (interleaved BGR, as the GPU renderers and OpOutputToCvMat)
+                    resizeAndPadBgrGpu(
+                        outputImageCuda, pInputImageCuda, cvInputData.cols, cvInputData.rows, outputResolution.x,
                         outputResolution.y, (float)scaleInputToOutput);
-                    *spGpuMemoryAllocated = true;
+                    if (outputDataGpu != nullptr)
+                        outputDataGpu->upToDate = true;
+                    else
+                        *spGpuMemoryAllocated = true;
                     // // No need to copy output image back to CPU
                     // cudaMemcpy(
                     //     outputData.getPtr(), *spOutputImageCuda, sizeof(float) * outputImageSize,
                     //     cudaMemcpyDeviceToHost);
                 #else
+                    UNUSED(outputDataGpu);
                     error("You need to compile OpenPose with CUDA support in order to use GPU resize.",
                         __LINE__, __FUNCTION__, __FILE__);
                 #endif
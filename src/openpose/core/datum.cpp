@@ -1,5 +1,6 @@
 #include <openpose/core/datum.hpp>
 #include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/utilities/fastMath.hpp>
 
 namespace op
 {
@@ -7,7 +8,12 @@ namespace op
         id{std::numeric_limits<unsigned long long>::max()},
         subId{0},
         subIdMax{0},
-        poseIds{-1}
+        sourceId{0},
+        sourceIdMax{0},
+        priority{0},
+        poseIds{-1},
+        poseKeypointsReused{false},
+        fields{DatumField::All}
     {
     }
 
@@ -19,17 +25,31 @@ namespace op
         subIdMax{datum.subIdMax},
         name{datum.name},
         frameNumber{datum.frameNumber},
+        sourceId{datum.sourceId},
+        sourceIdMax{datum.sourceIdMax},
+        priority{datum.priority},
+        deadline{datum.deadline},
+        timing{datum.timing},
         // Input image and rendered version
         cvInputData{datum.cvInputData},
+        inputDataGpu{datum.inputDataGpu},
+        inputDataLease{datum.inputDataLease},
+        frameCredit{datum.frameCredit},
         inputNetData{datum.inputNetData},
         outputData{datum.outputData},
+        outputDataGpu{datum.outputDataGpu},
         cvOutputData{datum.cvOutputData},
         // Resulting Array<float> data parameters
         poseKeypoints{datum.poseKeypoints},
         poseIds{datum.poseIds},
         poseScores{datum.poseScores},
+        poseKeypointsReused{datum.poseKeypointsReused},
         poseHeatMaps{datum.poseHeatMaps},
+        poseHeatMapsDownload{datum.poseHeatMapsDownload},
+        poseHeatMapsSparse{datum.poseHeatMapsSparse},
         poseCandidates{datum.poseCandidates},
+        poseCandidatesArray{datum.poseCandidatesArray},
+        poseCandidatesOffsets{datum.poseCandidatesOffsets},
         faceRectangles{datum.faceRectangles},
         faceKeypoints{datum.faceKeypoints},
         faceHeatMaps{datum.faceHeatMaps},
@@ -41,12 +61,21 @@ namespace op
         faceKeypoints3D{datum.faceKeypoints3D},
         handKeypoints3D(datum.handKeypoints3D), // Parentheses instead of braces to avoid error in GCC 4.8
         cameraMatrix{datum.cameraMatrix},
+        cameraExtrinsics{datum.cameraExtrinsics},
+        cameraIntrinsics{datum.cameraIntrinsics},
+        cameraDistortion{datum.cameraDistortion},
+        inputRoi{datum.inputRoi},
+        // Person crops
+        personCropsGpu{datum.personCropsGpu},
+        personCrops{datum.personCrops},
+        personCropMatrices{datum.personCropMatrices},
         // Other parameters
         scaleInputToNetInputs{datum.scaleInputToNetInputs},
         netInputSizes{datum.netInputSizes},
         scaleInputToOutput{datum.scaleInputToOutput},
         scaleNetToOutput{datum.scaleNetToOutput},
-        elementRendered{datum.elementRendered}
+        elementRendered{datum.elementRendered},
+        fields{datum.fields}
         // 3D/Adam parameters
         #ifdef USE_3D_ADAM_MODEL
             ,
@@ -86,17 +115,31 @@ namespace op
             subIdMax = datum.subIdMax;
             name = datum.name;
             frameNumber = datum.frameNumber;
+            sourceId = datum.sourceId;
+            sourceIdMax = datum.sourceIdMax;
+            priority = datum.priority;
+            deadline = datum.deadline;
+            timing = datum.timing;
             // Input image and rendered version
             cvInputData = datum.cvInputData;
+            inputDataGpu = datum.inputDataGpu;
+            inputDataLease = datum.inputDataLease;
+            frameCredit = datum.frameCredit;
             inputNetData = datum.inputNetData;
             outputData = datum.outputData;
+            outputDataGpu = datum.outputDataGpu;
             cvOutputData = datum.cvOutputData;
             // Resulting Array<float> data parameters
             poseKeypoints = datum.poseKeypoints;
             poseIds = datum.poseIds,
             poseScores = datum.poseScores,
+            poseKeypointsReused = datum.poseKeypointsReused;
             poseHeatMaps = datum.poseHeatMaps,
+            poseHeatMapsDownload = datum.poseHeatMapsDownload,
+            poseHeatMapsSparse = datum.poseHeatMapsSparse,
             poseCandidates = datum.poseCandidates,
+            poseCandidatesArray = datum.poseCandidatesArray,
+            poseCandidatesOffsets = datum.poseCandidatesOffsets,
             faceRectangles = datum.faceRectangles,
             faceKeypoints = datum.faceKeypoints,
             faceHeatMaps = datum.faceHeatMaps,
@@ -108,12 +151,21 @@ namespace op
             faceKeypoints3D = datum.faceKeypoints3D,
             handKeypoints3D = datum.handKeypoints3D,
             cameraMatrix = datum.cameraMatrix;
+            cameraExtrinsics = datum.cameraExtrinsics;
+            cameraIntrinsics = datum.cameraIntrinsics;
+            cameraDistortion = datum.cameraDistortion;
+            inputRoi = datum.inputRoi;
+            // Person crops
+            personCropsGpu = datum.personCropsGpu;
+            personCrops = datum.personCrops;
+            personCropMatrices = datum.personCropMatrices;
             // Other parameters
             scaleInputToNetInputs = datum.scaleInputToNetInputs;
             netInputSizes = datum.netInputSizes;
             scaleInputToOutput = datum.scaleInputToOutput;
             scaleNetToOutput = datum.scaleNetToOutput;
             elementRendered = datum.elementRendered;
+            fields = datum.fields;
             // 3D/Adam parameters
             #ifdef USE_3D_ADAM_MODEL
                 // Adam/Unity params
@@ -154,25 +206,42 @@ namespace op
         subId{datum.subId},
         subIdMax{datum.subIdMax},
         frameNumber{datum.frameNumber},
+        sourceId{datum.sourceId},
+        sourceIdMax{datum.sourceIdMax},
+        priority{datum.priority},
+        deadline{datum.deadline},
+        // Resulting Array<float> data parameters
+        poseKeypointsReused{datum.poseKeypointsReused},
         // Other parameters
         scaleInputToOutput{datum.scaleInputToOutput},
-        scaleNetToOutput{datum.scaleNetToOutput}
+        scaleNetToOutput{datum.scaleNetToOutput},
+        fields{datum.fields}
     {
         try
         {
             // ID
             std::swap(name, datum.name);
+            std::swap(timing, datum.timing);
             // Input image and rendered version
             std::swap(cvInputData, datum.cvInputData);
+            std::swap(inputDataGpu, datum.inputDataGpu);
+            std::swap(inputDataLease, datum.inputDataLease);
+            std::swap(frameCredit, datum.frameCredit);
             std::swap(inputNetData, datum.inputNetData);
             std::swap(outputData, datum.outputData);
+            std::swap(outputDataGpu, datum.outputDataGpu);
             std::swap(cvOutputData, datum.cvOutputData);
             // Resulting Array<float> data parameters
             std::swap(poseKeypoints, datum.poseKeypoints);
             std::swap(poseIds, datum.poseIds);
             std::swap(poseScores, datum.poseScores);
+            std::swap(poseKeypointsReused, datum.poseKeypointsReused);
             std::swap(poseHeatMaps, datum.poseHeatMaps);
+            std::swap(poseHeatMapsDownload, datum.poseHeatMapsDownload);
+            std::swap(poseHeatMapsSparse, datum.poseHeatMapsSparse);
             std::swap(poseCandidates, datum.poseCandidates);
+            std::swap(poseCandidatesArray, datum.poseCandidatesArray);
+            std::swap(poseCandidatesOffsets, datum.poseCandidatesOffsets);
             std::swap(faceRectangles, datum.faceRectangles);
             std::swap(faceKeypoints, datum.faceKeypoints);
             std::swap(faceHeatMaps, datum.faceHeatMaps);
@@ -184,6 +253,14 @@ namespace op
             std::swap(faceKeypoints3D, datum.faceKeypoints3D);
             std::swap(handKeypoints3D, datum.handKeypoints3D);
             std::swap(cameraMatrix, datum.cameraMatrix);
+            std::swap(cameraExtrinsics, datum.cameraExtrinsics);
+            std::swap(cameraIntrinsics, datum.cameraIntrinsics);
+            std::swap(cameraDistortion, datum.cameraDistortion);
+            std::swap(inputRoi, datum.inputRoi);
+            // Person crops
+            std::swap(personCropsGpu, datum.personCropsGpu);
+            std::swap(personCrops, datum.personCrops);
+            std::swap(personCropMatrices, datum.personCropMatrices);
             // Other parameters
             std::swap(scaleInputToNetInputs, datum.scaleInputToNetInputs);
             std::swap(netInputSizes, datum.netInputSizes);
@@ -229,17 +306,31 @@ namespace op
             subIdMax = datum.subIdMax;
             std::swap(name, datum.name);
             frameNumber = datum.frameNumber;
+            sourceId = datum.sourceId;
+            sourceIdMax = datum.sourceIdMax;
+            priority = datum.priority;
+            deadline = datum.deadline;
+            std::swap(timing, datum.timing);
             // Input image and rendered version
             std::swap(cvInputData, datum.cvInputData);
+            std::swap(inputDataGpu, datum.inputDataGpu);
+            std::swap(inputDataLease, datum.inputDataLease);
+            std::swap(frameCredit, datum.frameCredit);
             std::swap(inputNetData, datum.inputNetData);
             std::swap(outputData, datum.outputData);
+            std::swap(outputDataGpu, datum.outputDataGpu);
             std::swap(cvOutputData, datum.cvOutputData);
             // Resulting Array<float> data parameters
             std::swap(poseKeypoints, datum.poseKeypoints);
             std::swap(poseIds, datum.poseIds);
             std::swap(poseScores, datum.poseScores);
+            std::swap(poseKeypointsReused, datum.poseKeypointsReused);
             std::swap(poseHeatMaps, datum.poseHeatMaps);
+            std::swap(poseHeatMapsDownload, datum.poseHeatMapsDownload);
+            std::swap(poseHeatMapsSparse, datum.poseHeatMapsSparse);
             std::swap(poseCandidates, datum.poseCandidates);
+            std::swap(poseCandidatesArray, datum.poseCandidatesArray);
+            std::swap(poseCandidatesOffsets, datum.poseCandidatesOffsets);
             std::swap(faceRectangles, datum.faceRectangles);
             std::swap(faceKeypoints, datum.faceKeypoints);
             std::swap(faceHeatMaps, datum.faceHeatMaps);
@@ -251,10 +342,19 @@ namespace op
             std::swap(faceKeypoints3D, datum.faceKeypoints3D);
             std::swap(handKeypoints3D, datum.handKeypoints3D);
             std::swap(cameraMatrix, datum.cameraMatrix);
+            std::swap(cameraExtrinsics, datum.cameraExtrinsics);
+            std::swap(cameraIntrinsics, datum.cameraIntrinsics);
+            std::swap(cameraDistortion, datum.cameraDistortion);
+            std::swap(inputRoi, datum.inputRoi);
+            // Person crops
+            std::swap(personCropsGpu, datum.personCropsGpu);
+            std::swap(personCrops, datum.personCrops);
+            std::swap(personCropMatrices, datum.personCropMatrices);
             // Other parameters
             std::swap(scaleInputToNetInputs, datum.scaleInputToNetInputs);
             std::swap(netInputSizes, datum.netInputSizes);
             std::swap(elementRendered, datum.elementRendered);
+            std::swap(fields, datum.fields);
             // 3D/Adam parameters
             #ifdef USE_3D_ADAM_MODEL
                 // Adam/Unity params
@@ -293,6 +393,19 @@ namespace op
     }
 
     Datum Datum::clone() const
+    {
+        try
+        {
+            return clone(false);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Datum{};
+        }
+    }
+
+    Datum Datum::clone(const bool shareInputData) const
     {
         try
         {
@@ -304,33 +417,85 @@ namespace op
             datum.subIdMax = subIdMax;
             datum.name = name;
             datum.frameNumber = frameNumber;
+            datum.sourceId = sourceId;
+            datum.sourceIdMax = sourceIdMax;
+            datum.priority = priority;
+            datum.deadline = deadline;
+            if (timing != nullptr)
+                datum.timing = std::make_shared<DatumTiming>(timing->getEvents());
             // Input image and rendered version
-            datum.cvInputData = cvInputData.clone();
+            datum.cvInputData = (shareInputData ? cvInputData : cvInputData.clone());
+            // Read-only GPU frame, so it is shared rather than copied
+            datum.inputDataGpu = inputDataGpu;
+            // Only needed while cvInputData wraps the producer memory
+            if (shareInputData)
+                datum.inputDataLease = inputDataLease;
             datum.inputNetData.resize(inputNetData.size());
             for (auto i = 0u ; i < datum.inputNetData.size() ; i++)
-                datum.inputNetData[i] = inputNetData[i].clone();
+                datum.inputNetData[i] = (shareInputData ? inputNetData[i] : inputNetData[i].clone());
             datum.outputData = outputData.clone();
-            datum.cvOutputData = cvOutputData.clone();
+            // Only the CPU images are deep copied (the GPU one is temporary, see OpOutputToCvMat)
+            datum.outputDataGpu = RenderTargetGpu{};
+            // Not rendered yet (cvOutputData = cvInputData, see DatumProducer): keep sharing the same buffer
+            if (shareInputData && cvOutputData.getConstCvMat() == cvInputData.getConstCvMat())
+                datum.cvOutputData = datum.cvInputData;
+            else
+                datum.cvOutputData = cvOutputData.clone();
             // Resulting Array<float> data parameters
             datum.poseKeypoints = poseKeypoints.clone();
             datum.poseIds = poseIds.clone();
             datum.poseScores = poseScores.clone();
-            datum.poseHeatMaps = poseHeatMaps.clone();
-            datum.poseCandidates = poseCandidates;
-            datum.faceRectangles = faceRectangles;
-            datum.faceKeypoints = faceKeypoints.clone();
-            datum.faceHeatMaps = faceHeatMaps.clone();
-            datum.handRectangles = handRectangles;
-            for (auto i = 0u ; i < datum.handKeypoints.size() ; i++)
-                datum.handKeypoints[i] = handKeypoints[i].clone();
-            for (auto i = 0u ; i < datum.handKeypoints.size() ; i++)
-                datum.handHeatMaps[i] = handHeatMaps[i].clone();
+            datum.poseKeypointsReused = poseKeypointsReused;
+            // The fields disabled in this pipeline (see fields) are empty, so they are not even visited
+            datum.fields = fields;
+            // Pending heat maps: Downloaded now (otherwise both Datums would share the downloaded data)
+            if (hasField(DatumField::PoseHeatMaps))
+            {
+                datum.poseHeatMaps = (poseHeatMapsDownload ? poseHeatMapsDownload() : poseHeatMaps).clone();
+                datum.poseHeatMapsSparse = poseHeatMapsSparse;
+            }
+            if (hasField(DatumField::PoseCandidates))
+            {
+                datum.poseCandidates = poseCandidates;
+                datum.poseCandidatesArray = poseCandidatesArray.clone();
+                datum.poseCandidatesOffsets = poseCandidatesOffsets;
+            }
+            if (hasField(DatumField::Face))
+            {
+                datum.faceRectangles = faceRectangles;
+                datum.faceKeypoints = faceKeypoints.clone();
+                if (hasField(DatumField::FaceHeatMaps))
+                    datum.faceHeatMaps = faceHeatMaps.clone();
+            }
+            if (hasField(DatumField::Hand))
+            {
+                datum.handRectangles = handRectangles;
+                for (auto i = 0u ; i < datum.handKeypoints.size() ; i++)
+                    datum.handKeypoints[i] = handKeypoints[i].clone();
+                if (hasField(DatumField::HandHeatMaps))
+                    for (auto i = 0u ; i < datum.handKeypoints.size() ; i++)
+                        datum.handHeatMaps[i] = handHeatMaps[i].clone();
+            }
             // 3-D Reconstruction parameters
-            datum.poseKeypoints3D = poseKeypoints3D.clone();
-            datum.faceKeypoints3D = faceKeypoints3D.clone();
-            for (auto i = 0u ; i < datum.handKeypoints.size() ; i++)
-                datum.handKeypoints3D[i] = handKeypoints3D[i].clone();
-            datum.cameraMatrix = cameraMatrix.clone();
+            if (hasField(DatumField::Keypoints3D))
+            {
+                datum.poseKeypoints3D = poseKeypoints3D.clone();
+                datum.faceKeypoints3D = faceKeypoints3D.clone();
+                for (auto i = 0u ; i < datum.handKeypoints.size() ; i++)
+                    datum.handKeypoints3D[i] = handKeypoints3D[i].clone();
+            }
+            if (hasField(DatumField::CameraParameters))
+            {
+                datum.cameraMatrix = cameraMatrix.clone();
+                datum.cameraExtrinsics = cameraExtrinsics.clone();
+                datum.cameraIntrinsics = cameraIntrinsics.clone();
+                datum.cameraDistortion = cameraDistortion.clone();
+            }
+            datum.inputRoi = inputRoi;
+            // Person crops (read-only GPU crops, so they are shared rather than copied)
+            datum.personCropsGpu = personCropsGpu;
+            datum.personCrops = personCrops.clone();
+            datum.personCropMatrices = personCropMatrices;
             // Other parameters
             datum.scaleInputToNetInputs = scaleInputToNetInputs;
             datum.netInputSizes = netInputSizes;
@@ -339,26 +504,29 @@ namespace op
             datum.elementRendered = elementRendered;
             // 3D/Adam parameters
             #ifdef USE_3D_ADAM_MODEL
-                // Adam/Unity params
-                datum.adamPosePtr = adamPosePtr;
-                datum.adamPoseRows = adamPoseRows;
-                datum.adamTranslationPtr = adamTranslationPtr;
-                // Adam params (Jacobians)
-                datum.vtVecPtr = vtVecPtr;
-                datum.vtVecRows = vtVecRows;
-                datum.j0VecPtr = j0VecPtr;
-                datum.j0VecRows = j0VecRows;
-                datum.adamFaceCoeffsExpPtr = adamFaceCoeffsExpPtr;
-                datum.adamFaceCoeffsExpRows = adamFaceCoeffsExpRows;
-                #ifdef USE_EIGEN
+                if (hasField(DatumField::Adam))
+                {
                     // Adam/Unity params
-                    datum.adamPose = adamPose;
-                    datum.adamTranslation = adamTranslation;
+                    datum.adamPosePtr = adamPosePtr;
+                    datum.adamPoseRows = adamPoseRows;
+                    datum.adamTranslationPtr = adamTranslationPtr;
                     // Adam params (Jacobians)
-                    datum.vtVec = vtVec;
-                    datum.j0Vec = j0Vec;
-                    datum.adamFaceCoeffsExp = adamFaceCoeffsExp;
-                #endif
+                    datum.vtVecPtr = vtVecPtr;
+                    datum.vtVecRows = vtVecRows;
+                    datum.j0VecPtr = j0VecPtr;
+                    datum.j0VecRows = j0VecRows;
+                    datum.adamFaceCoeffsExpPtr = adamFaceCoeffsExpPtr;
+                    datum.adamFaceCoeffsExpRows = adamFaceCoeffsExpRows;
+                    #ifdef USE_EIGEN
+                        // Adam/Unity params
+                        datum.adamPose = adamPose;
+                        datum.adamTranslation = adamTranslation;
+                        // Adam params (Jacobians)
+                        datum.vtVec = vtVec;
+                        datum.j0Vec = j0Vec;
+                        datum.adamFaceCoeffsExp = adamFaceCoeffsExp;
+                    #endif
+                }
             #endif
             // Return
             return datum;
@@ -369,4 +537,121 @@ namespace op
             return Datum{};
         }
     }
+
+    const Matrix& Datum::getCvInputData()
+    {
+        try
+        {
+            if (cvInputData.empty() && !inputDataGpu.empty())
+            {
+                inputDataGpu.download(cvInputData);
+                if (cvOutputData.empty())
+                    cvOutputData = cvInputData;
+            }
+            return cvInputData;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cvInputData;
+        }
+    }
+
+    const Array<float>& Datum::getPoseHeatMaps()
+    {
+        try
+        {
+            if (poseHeatMapsDownload)
+            {
+                poseHeatMaps = poseHeatMapsDownload();
+                poseHeatMapsDownload = nullptr;
+            }
+            return poseHeatMaps;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return poseHeatMaps;
+        }
+    }
+
+    const std::vector<std::vector<std::array<float,3>>>& Datum::getPoseCandidates()
+    {
+        try
+        {
+            if (poseCandidates.empty() && !poseCandidatesOffsets.empty())
+            {
+                const auto numberBodyParts = poseCandidatesOffsets.size() - 1;
+                poseCandidates.resize(numberBodyParts);
+                const auto* const candidatesPtr = poseCandidatesArray.getConstPtr();
+                for (auto part = 0u ; part < numberBodyParts ; part++)
+                {
+                    auto& partCandidates = poseCandidates[part];
+                    partCandidates.resize(poseCandidatesOffsets[part+1] - poseCandidatesOffsets[part]);
+                    const auto* const partCandidatesPtr = candidatesPtr + 3*poseCandidatesOffsets[part];
+                    for (auto candidate = 0u ; candidate < partCandidates.size() ; candidate++)
+                        partCandidates[candidate] = {
+                            partCandidatesPtr[3*candidate], partCandidatesPtr[3*candidate+1],
+                            partCandidatesPtr[3*candidate+2]};
+                }
+            }
+            return poseCandidates;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return poseCandidates;
+        }
+    }
+
+    Point<int> Datum::getInputSize() const
+    {
+        try
+        {
+            if (!cvInputData.empty())
+                return Point<int>{cvInputData.cols(), cvInputData.rows()};
+            else if (!inputDataGpu.empty())
+                return Point<int>{inputDataGpu.getOrientedWidth(), inputDataGpu.getOrientedHeight()};
+            return Point<int>{0, 0};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Point<int>{0, 0};
+        }
+    }
+
+    Rectangle<int> Datum::getInputRoiRectangle() const
+    {
+        try
+        {
+            const auto inputSize = getInputSize();
+            if (inputRoi.empty())
+                return Rectangle<int>{0, 0, inputSize.x, inputSize.y};
+            auto minX = inputRoi[0].x;
+            auto minY = inputRoi[0].y;
+            auto maxX = inputRoi[0].x;
+            auto maxY = inputRoi[0].y;
+            for (const auto& point : inputRoi)
+            {
+                minX = fastMin(minX, point.x);
+                minY = fastMin(minY, point.y);
+                maxX = fastMax(maxX, point.x);
+                maxY = fastMax(maxY, point.y);
+            }
+            // Clipped to the image
+            minX = fastMax(minX, 0);
+            minY = fastMax(minY, 0);
+            maxX = fastMin(maxX, inputSize.x);
+            maxY = fastMin(maxY, inputSize.y);
+            if (maxX <= minX || maxY <= minY)
+                return Rectangle<int>{0, 0, inputSize.x, inputSize.y};
+            return Rectangle<int>{minX, minY, maxX - minX, maxY - minY};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Rectangle<int>{};
+        }
+    }
 }
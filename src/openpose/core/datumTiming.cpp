@@ -0,0 +1,94 @@
+#include <openpose/core/datumTiming.hpp>
+#include <chrono>
+#include <openpose/utilities/errorAndLog.hpp>
+
+namespace op
+{
+    std::atomic<bool> DatumTiming::sEnabled{false};
+
+    void DatumTiming::setEnabled(const bool enabled)
+    {
+        sEnabled = enabled;
+    }
+
+    bool DatumTiming::isEnabled()
+    {
+        return sEnabled.load(std::memory_order_relaxed);
+    }
+
+    long long DatumTiming::now()
+    {
+        return (long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    DatumTiming& DatumTiming::get(std::shared_ptr<DatumTiming>& datumTiming)
+    {
+        if (datumTiming == nullptr)
+            datumTiming = std::make_shared<DatumTiming>();
+        return *datumTiming;
+    }
+
+    DatumTiming::DatumTiming(const std::vector<DatumTimingEvent>& events) :
+        mEvents(events),
+        mQueueBeginNs{-1ll}
+    {
+    }
+
+    void DatumTiming::record(const char* const name, const long long beginNs, const long long endNs)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mEvents.emplace_back(DatumTimingEvent{name, beginNs, endNs});
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void DatumTiming::openQueue(const long long beginNs)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mQueueBeginNs = beginNs;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void DatumTiming::closeQueue(const char* const name, const long long endNs)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            if (mQueueBeginNs >= 0ll)
+            {
+                mEvents.emplace_back(DatumTimingEvent{name, mQueueBeginNs, endNs});
+                mQueueBeginNs = -1ll;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<DatumTimingEvent> DatumTiming::getEvents() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            return mEvents;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#include <openpose/core/frameGpu.hpp>
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+    #include <opencv2/core/core.hpp>
+    #include <openpose/gpu/cuda.hpp>
+    #include <openpose/gpu/cudaMemoryPool.hpp>
+    #include <openpose/utilities/allocationTracker.hpp>
+#endif
+#include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/utilities/openCv.hpp>
+
+namespace op
+{
+    FrameGpu::FrameGpu() :
+        width{0},
+        height{0},
+        pitch{0},
+        gpuId{0},
+        bt709{false},
+        fullRange{false},
+        format{FrameGpuFormat::Nv12},
+        timestamp{0ull},
+        rotation{0},
+        flip{false},
+        cudaStream{nullptr}
+    {
+    }
+
+    void FrameGpu::download(Matrix& frame) const
+    {
+        try
+        {
+            if (empty())
+                error("Empty FrameGpu.", __LINE__, __FUNCTION__, __FILE__);
+            #ifdef USE_CUDA
+                int previousGpuId;
+                cudaGetDevice(&previousGpuId);
+                cudaSetDevice(gpuId);
+                cv::Mat cvFrame(height, width, CV_8UC3);
+                const auto bgrPitch = 3ull * width;
+                const auto bgrSize = bgrPitch * height;
+                // BGR: A single (pitched) copy
+                if (format == FrameGpuFormat::Bgr)
+                    cudaMemcpy2DAsync(
+                        cvFrame.data, bgrPitch, dataPtr.get(), pitch, bgrPitch, height, cudaMemcpyDeviceToHost,
+                        cudaStream);
+                // NV12 and Bayer: Converted into BGR on the GPU first
+                else
+                {
+                    auto* bgrCuda = (unsigned char*)cudaPoolMalloc(bgrSize, cudaStream);
+                    if (format == FrameGpuFormat::Nv12)
+                        nv12ToBgr(bgrCuda, dataPtr.get(), width, height, pitch, bt709, fullRange, cudaStream);
+                    else
+                        bayerToBgr(bgrCuda, dataPtr.get(), width, height, pitch, format, cudaStream);
+                    cudaMemcpyAsync(cvFrame.data, bgrCuda, bgrSize, cudaMemcpyDeviceToHost, cudaStream);
+                    cudaPoolFree(bgrCuda, cudaStream);
+                }
+                cudaStreamSynchronize(cudaStream);
+                AllocationTracker::recordCopy(bgrSize, MemoryCopy::DeviceToHost);
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                cudaSetDevice(previousGpuId);
+                frame = OP_CV2OPMAT(cvFrame);
+                // Same orientation than the producer frames
+                if (rotation != 0 || flip)
+                    rotateAndFlipFrame(frame, rotation, flip);
+            #else
+                UNUSED(frame);
+                error("OpenPose must be compiled with CUDA support to download GPU frames.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
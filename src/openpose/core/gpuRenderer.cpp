@@ -2,7 +2,9 @@
 #ifdef USE_CUDA
     #include <cuda.h>
     #include <cuda_runtime_api.h>
+    #include <openpose/gpu/cudaMemoryPool.hpp>
 #endif
+#include <openpose/utilities/allocationTracker.hpp>
 
 namespace op
 {
@@ -16,8 +18,10 @@ namespace op
                 if (*currentVolumePtr < memoryVolume)
                 {
                     *currentVolumePtr = memoryVolume;
-                    cudaFree(*gpuMemoryPtr);
-                    cudaMalloc((void**)gpuMemoryPtr.get(), *currentVolumePtr * sizeof(float));
+                    cudaPoolFree(*gpuMemoryPtr);
+                    // Shared by all the GPU renderers of the same thread (pose, face and hand)
+                    const CudaMemoryOwner cudaMemoryOwner{"Renderers"};
+                    *gpuMemoryPtr = (float*)cudaPoolMalloc(*currentVolumePtr * sizeof(float));
                 }
             }
             catch (const std::exception& e)
@@ -36,7 +40,8 @@ namespace op
         spVolume{std::make_shared<unsigned long long>(0)},
         mIsFirstRenderer{true},
         mIsLastRenderer{true},
-        spGpuMemoryAllocated{std::make_shared<bool>(false)}
+        spGpuMemoryAllocated{std::make_shared<bool>(false)},
+        pRenderTargetGpu{nullptr}
     {
     }
 
@@ -47,7 +52,7 @@ namespace op
             #ifdef USE_CUDA
                 if (mIsLastRenderer && spGpuMemory != nullptr)
                 {
-                    cudaFree(*spGpuMemory);
+                    cudaPoolFree(*spGpuMemory);
                     *spGpuMemory = nullptr;
                 }
             #endif
@@ -113,15 +118,60 @@ namespace op
         }
     }
 
+    void GpuRenderer::setRenderTargetGpu(RenderTargetGpu* const renderTargetGpu)
+    {
+        try
+        {
+            pRenderTargetGpu = renderTargetGpu;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    float* GpuRenderer::getGpuMemory() const
+    {
+        try
+        {
+            return (usesRenderTargetGpu() ? pRenderTargetGpu->dataPtr.get() : *spGpuMemory);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    bool GpuRenderer::usesRenderTargetGpu() const
+    {
+        return pRenderTargetGpu != nullptr && !pRenderTargetGpu->empty();
+    }
+
     void GpuRenderer::cpuToGpuMemoryIfNotCopiedYet(const float* const cpuMemory, const unsigned long long memoryVolume)
     {
         try
         {
             #ifdef USE_CUDA
-                if (!*spGpuMemoryAllocated)
+                // Render target of the Datum (usually already filled on the GPU by CvMatToOpOutput)
+                if (usesRenderTargetGpu())
+                {
+                    if (!pRenderTargetGpu->upToDate)
+                    {
+                        if (pRenderTargetGpu->getVolume() != memoryVolume)
+                            error("The GPU render target and outputData have different sizes.",
+                                  __LINE__, __FUNCTION__, __FILE__);
+                        cudaMemcpy(pRenderTargetGpu->dataPtr.get(), cpuMemory, memoryVolume * sizeof(float),
+                                   cudaMemcpyHostToDevice);
+                        AllocationTracker::recordCopy(memoryVolume * sizeof(float), MemoryCopy::HostToDevice);
+                        pRenderTargetGpu->upToDate = true;
+                    }
+                }
+                else if (!*spGpuMemoryAllocated)
                 {
                     checkAndIncreaseGpuMemory(spGpuMemory, spVolume, memoryVolume);
                     cudaMemcpy(*spGpuMemory, cpuMemory, memoryVolume * sizeof(float), cudaMemcpyHostToDevice);
+                    AllocationTracker::recordCopy(memoryVolume * sizeof(float), MemoryCopy::HostToDevice);
                     *spGpuMemoryAllocated = true;
                 }
             #else
@@ -142,12 +192,27 @@ namespace op
         try
         {
             #ifdef USE_CUDA
-                if (*spGpuMemoryAllocated && mIsLastRenderer)
+                // Render target of the Datum (usually downloaded later by OpOutputToCvMat)
+                if (usesRenderTargetGpu())
+                {
+                    if (pRenderTargetGpu->upToDate && mIsLastRenderer)
+                    {
+                        if (pRenderTargetGpu->getVolume() < memoryVolume)
+                            error("CPU is asking for more memory than it was copied into GPU.",
+                                  __LINE__, __FUNCTION__, __FILE__);
+                        cudaMemcpy(cpuMemory, pRenderTargetGpu->dataPtr.get(), memoryVolume * sizeof(float),
+                                   cudaMemcpyDeviceToHost);
+                        AllocationTracker::recordCopy(memoryVolume * sizeof(float), MemoryCopy::DeviceToHost);
+                        pRenderTargetGpu->upToDate = false;
+                    }
+                }
+                else if (*spGpuMemoryAllocated && mIsLastRenderer)
                 {
                     if (*spVolume < memoryVolume)
                         error("CPU is asking for more memory than it was copied into GPU.",
                               __LINE__, __FUNCTION__, __FILE__);
                     cudaMemcpy(cpuMemory, *spGpuMemory, memoryVolume * sizeof(float), cudaMemcpyDeviceToHost);
+                    AllocationTracker::recordCopy(memoryVolume * sizeof(float), MemoryCopy::DeviceToHost);
                     *spGpuMemoryAllocated = false;
                 }
             #else
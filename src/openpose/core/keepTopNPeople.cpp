@@ -1,7 +1,7 @@
 #include <openpose/core/keepTopNPeople.hpp>
-#include <algorithm> // std::sort
+#include <algorithm> // std::nth_element, std::sort
 #include <cmath> // std::sqrt
-#include <openpose/utilities/keypoint.hpp>
+#include <openpose/utilities/keypointSoa.hpp>
 
 namespace op
 {
@@ -21,63 +21,16 @@ namespace op
             // Remove people if #people > mNumberPeopleMax
             if (peopleArray.getSize(0) > mNumberPeopleMax && mNumberPeopleMax > 0)
             {
-                // Sanity checks
-                if (poseScores.getVolume() != (unsigned int) poseScores.getSize(0))
-                    error("The poseFinalScores variable should be a Nx1 vector, not a multidimensional array.",
-                          __LINE__, __FUNCTION__, __FILE__);
-                if (peopleArray.getNumberDimensions() != 3)
-                    error("The peopleArray variable should be a 3 dimensional array.",
-                          __LINE__, __FUNCTION__, __FILE__);
-
-                // Get poseFinalScores
-                auto poseFinalScores = poseScores.clone();
-                for (auto person = 0 ; person < (int)poseFinalScores.getVolume() ; person ++)
-                    poseFinalScores[person] *= std::sqrt(getKeypointsArea(peopleArray, person, 0.05f));
-
-                // Get threshold
-                auto poseScoresSorted = poseFinalScores.clone();
-                std::sort(poseScoresSorted.getPtr(), poseScoresSorted.getPtr() + poseScoresSorted.getSize(0),
-                          std::greater<float>());
-                const auto threshold = poseScoresSorted[mNumberPeopleMax-1];
-
-                // Get number people above threshold
-                auto numberPeopleAboveThreshold = 0;
-                for (auto person = 0 ; person < (int)poseFinalScores.getVolume() ; person ++)
-                    if (poseFinalScores[person] > threshold)
-                        numberPeopleAboveThreshold++;
-
-                // Remove extra people - Fille topPeopleArray
-                // assignedPeopleOnThreshold avoids that people with repeated threshold remove higher elements.
-                // In our case, it will keep the first N people with score = threshold, while keeping all the
-                // people with higher scores.
-                // E.g., poseFinalScores = [0, 0.5, 0.5, 0.5, 1.0]; mNumberPeopleMax = 2
-                // Naively, we could accidentally keep the first 2x 0.5 and remove the 1.0 threshold.
-                // Our method keeps the first 0.5 and 1.0.
+                const auto topPeopleIndexes = getTopPeopleIndexes(peopleArray, poseScores);
+                // Fill topPeopleArray
                 Array<float> topPeopleArray({mNumberPeopleMax, peopleArray.getSize(1), peopleArray.getSize(2)});
                 const auto personArea = (int)peopleArray.getVolume(1, 2);
-                auto assignedPeopleOnThreshold = 0;
-                auto nextPersonIndex = 0;
-                const auto numberPeopleOnThresholdToBeAdded = mNumberPeopleMax - numberPeopleAboveThreshold;
-                for (auto person = 0 ; person < (int)poseFinalScores.getVolume() ; person++)
+                for (auto topPerson = 0u ; topPerson < topPeopleIndexes.size() ; topPerson++)
                 {
-                    if (poseFinalScores[person] >= threshold)
-                    {
-                        // Check we don't copy 2 values in the threshold
-                        if (poseFinalScores[person] == threshold)
-                            assignedPeopleOnThreshold++;
-
-                        // Copy person into people array
-                        if (poseFinalScores[person] > threshold
-                            || assignedPeopleOnThreshold <= numberPeopleOnThresholdToBeAdded)
-                        {
-                            const auto peopleArrayIndex = personArea*person;
-                            const auto topArrayIndex = personArea*nextPersonIndex++;
-                            std::copy(&peopleArray[peopleArrayIndex], &peopleArray[peopleArrayIndex]+personArea,
-                                      &topPeopleArray[topArrayIndex]);
-                        }
-                    }
+                    const auto peopleArrayIndex = personArea*topPeopleIndexes[topPerson];
+                    std::copy(&peopleArray[peopleArrayIndex], &peopleArray[peopleArrayIndex]+personArea,
+                              &topPeopleArray[personArea*topPerson]);
                 }
-
                 return topPeopleArray;
             }
             // If no changes required
@@ -90,4 +43,82 @@ namespace op
             return Array<float>{};
         }
     }
+
+    void KeepTopNPeople::keepTopPeopleInPlace(Array<float>& peopleArray, Array<float>& poseScores) const
+    {
+        try
+        {
+            // Remove people if #people > mNumberPeopleMax
+            if (peopleArray.getSize(0) > mNumberPeopleMax && mNumberPeopleMax > 0)
+            {
+                const auto topPeopleIndexes = getTopPeopleIndexes(peopleArray, poseScores);
+                // Move the top people (sorted by index) to the beginning of the arrays
+                const auto personArea = (int)peopleArray.getVolume(1, 2);
+                for (auto topPerson = 0u ; topPerson < topPeopleIndexes.size() ; topPerson++)
+                {
+                    const auto person = topPeopleIndexes[topPerson];
+                    if (person != (int)topPerson)
+                    {
+                        std::copy(&peopleArray[personArea*person], &peopleArray[personArea*person]+personArea,
+                                  &peopleArray[personArea*topPerson]);
+                        poseScores[topPerson] = poseScores[person];
+                    }
+                }
+                peopleArray.shrinkFirstDimension(mNumberPeopleMax);
+                poseScores.shrinkFirstDimension(mNumberPeopleMax);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<int> KeepTopNPeople::getTopPeopleIndexes(
+        const Array<float>& peopleArray, const Array<float>& poseScores) const
+    {
+        try
+        {
+            // Sanity checks
+            if (poseScores.getVolume() != (unsigned int) poseScores.getSize(0))
+                error("The poseFinalScores variable should be a Nx1 vector, not a multidimensional array.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (peopleArray.getNumberDimensions() != 3)
+                error("The peopleArray variable should be a 3 dimensional array.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (poseScores.getSize(0) != peopleArray.getSize(0))
+                error("The poseScores and peopleArray variables should have the same number of people.",
+                      __LINE__, __FUNCTION__, __FILE__);
+
+            // Get poseFinalScores
+            const auto numberPeople = poseScores.getSize(0);
+            const KeypointSoa peopleSoa{peopleArray};
+            std::vector<std::pair<float, int>> poseFinalScores(numberPeople);
+            for (auto person = 0 ; person < numberPeople ; person++)
+                poseFinalScores[person] = std::make_pair(
+                    poseScores[person] * std::sqrt(peopleSoa.getArea(person, 0.05f)), person);
+
+            // Partial selection of the top mNumberPeopleMax people (O(#people) rather than a full sort)
+            // People with the same score are sorted by index, so on ties the first N people are kept (e.g., for
+            // poseFinalScores = [0, 0.5, 0.5, 0.5, 1.0] and mNumberPeopleMax = 2, it keeps the first 0.5 and 1.0).
+            std::nth_element(
+                poseFinalScores.begin(), poseFinalScores.begin() + (mNumberPeopleMax - 1), poseFinalScores.end(),
+                [](const std::pair<float, int>& a, const std::pair<float, int>& b)
+                {
+                    return a.first > b.first || (a.first == b.first && a.second < b.second);
+                });
+
+            // Kept in their original order
+            std::vector<int> topPeopleIndexes(mNumberPeopleMax);
+            for (auto topPerson = 0 ; topPerson < mNumberPeopleMax ; topPerson++)
+                topPeopleIndexes[topPerson] = poseFinalScores[topPerson].second;
+            std::sort(topPeopleIndexes.begin(), topPeopleIndexes.end());
+            return topPeopleIndexes;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
 }
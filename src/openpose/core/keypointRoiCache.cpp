@@ -0,0 +1,263 @@
+#include <openpose/core/keypointRoiCache.hpp>
+#include <cmath> // std::abs
+#include <map>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/keypoint.hpp>
+
+namespace op
+{
+    struct CachedRoi
+    {
+        // Rectangle from which the keypoints were computed
+        Rectangle<float> rectangle;
+        std::vector<float> keypoints;
+        float averageScore;
+        int skippedFrames;
+    };
+
+    struct KeypointRoiCacheSlot
+    {
+        std::map<long long, CachedRoi> people;
+        // Whether each person of the last select() reuses the cached keypoints
+        std::vector<char> reused;
+    };
+
+    struct KeypointRoiCache::ImplKeypointRoiCache
+    {
+        const int mMaxSkippedFrames;
+        const float mMinAverageScore;
+        const float mMaxMotion;
+        std::vector<KeypointRoiCacheSlot> mSlots;
+        unsigned long long mChecked;
+        unsigned long long mReused;
+
+        ImplKeypointRoiCache(const int maxSkippedFrames, const float minAverageScore, const float maxMotion) :
+            mMaxSkippedFrames{maxSkippedFrames},
+            mMinAverageScore{minAverageScore},
+            mMaxMotion{maxMotion},
+            mChecked{0ull},
+            mReused{0ull}
+        {
+        }
+
+        KeypointRoiCacheSlot& getSlot(const unsigned long long slot)
+        {
+            if (mSlots.size() <= slot)
+                mSlots.resize(slot+1);
+            return mSlots[slot];
+        }
+
+        bool barelyMoved(const Rectangle<float>& cachedRectangle, const Rectangle<float>& rectangle) const
+        {
+            const auto side = fastMax(cachedRectangle.width, cachedRectangle.height);
+            if (side <= 0.f)
+                return false;
+            const auto cachedCenter = cachedRectangle.center();
+            const auto center = rectangle.center();
+            const auto maxDisplacement = mMaxMotion * side;
+            return std::abs(center.x - cachedCenter.x) <= maxDisplacement
+                && std::abs(center.y - cachedCenter.y) <= maxDisplacement
+                && std::abs(fastMax(rectangle.width, rectangle.height) - side) <= maxDisplacement;
+        }
+    };
+
+    bool hasPoseId(const Array<long long>& poseIds, const int person, const int numberPeople)
+    {
+        return ((int)poseIds.getVolume() == numberPeople && poseIds[person] > -1);
+    }
+
+    KeypointRoiCache::KeypointRoiCache(const int maxSkippedFrames, const float minAverageScore, const float maxMotion) :
+        upImpl{new ImplKeypointRoiCache{maxSkippedFrames, minAverageScore, maxMotion}}
+    {
+        try
+        {
+            // Sanity check
+            if (maxSkippedFrames < 0 || maxMotion < 0.f)
+                error("The maximum number of skipped frames and the maximum motion cannot be negative.",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    KeypointRoiCache::~KeypointRoiCache()
+    {
+    }
+
+    std::vector<Rectangle<float>> KeypointRoiCache::select(
+        const std::vector<Rectangle<float>>& rectangles, const Array<long long>& poseIds,
+        const unsigned long long slot)
+    {
+        try
+        {
+            auto& cacheSlot = upImpl->getSlot(slot);
+            const auto numberPeople = (int)rectangles.size();
+            cacheSlot.reused.assign(numberPeople, 0);
+            auto selectedRectangles = rectangles;
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                const auto& rectangle = rectangles[person];
+                if (rectangle.area() <= 0.f)
+                    continue;
+                upImpl->mChecked++;
+                if (!hasPoseId(poseIds, person, numberPeople))
+                    continue;
+                const auto cachedRoi = cacheSlot.people.find(poseIds[person]);
+                if (cachedRoi != cacheSlot.people.end()
+                    && cachedRoi->second.skippedFrames < upImpl->mMaxSkippedFrames
+                    && cachedRoi->second.averageScore >= upImpl->mMinAverageScore
+                    && upImpl->barelyMoved(cachedRoi->second.rectangle, rectangle))
+                {
+                    cacheSlot.reused[person] = 1;
+                    selectedRectangles[person] = Rectangle<float>{};
+                    upImpl->mReused++;
+                }
+            }
+            return selectedRectangles;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void KeypointRoiCache::update(
+        Array<float>& keypoints, const std::vector<Rectangle<float>>& rectangles, const Array<long long>& poseIds,
+        const unsigned long long slot)
+    {
+        try
+        {
+            auto& cacheSlot = upImpl->getSlot(slot);
+            const auto numberPeople = (int)rectangles.size();
+            // Sanity check
+            if (cacheSlot.reused.size() != rectangles.size())
+                error("KeypointRoiCache::select() must be called with the same rectangles before update().",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // The people not found in this frame are removed
+            std::map<long long, CachedRoi> people;
+            const auto validKeypoints = (keypoints.getNumberDimensions() == 3 && keypoints.getSize(0) == numberPeople);
+            const auto personArea = (validKeypoints ? keypoints.getSize(1) * keypoints.getSize(2) : 0);
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                if (!validKeypoints || !hasPoseId(poseIds, person, numberPeople))
+                    continue;
+                const auto poseId = poseIds[person];
+                auto* keypointsPtr = keypoints.getPtr() + person * personArea;
+                // Reused: cached keypoints moved and scaled from the cached rectangle to the current one
+                if (cacheSlot.reused[person])
+                {
+                    auto cachedRoi = cacheSlot.people.at(poseId);
+                    const auto& cachedRectangle = cachedRoi.rectangle;
+                    const auto& rectangle = rectangles[person];
+                    const auto cachedCenter = cachedRectangle.center();
+                    const auto center = rectangle.center();
+                    const auto scale = fastMax(rectangle.width, rectangle.height)
+                                     / fastMax(cachedRectangle.width, cachedRectangle.height);
+                    const auto numberParts = (int)cachedRoi.keypoints.size() / 3;
+                    for (auto part = 0 ; part < fastMin(numberParts, keypoints.getSize(1)) ; part++)
+                    {
+                        const auto* const cachedPtr = &cachedRoi.keypoints[3*part];
+                        auto* const partPtr = keypointsPtr + part * keypoints.getSize(2);
+                        if (cachedPtr[2] > 0.f)
+                        {
+                            partPtr[0] = center.x + (cachedPtr[0] - cachedCenter.x) * scale;
+                            partPtr[1] = center.y + (cachedPtr[1] - cachedCenter.y) * scale;
+                        }
+                        partPtr[2] = cachedPtr[2];
+                    }
+                    cachedRoi.skippedFrames++;
+                    people.emplace(poseId, std::move(cachedRoi));
+                }
+                // Computed: cached
+                else if (rectangles[person].area() > 0.f)
+                    people.emplace(poseId, CachedRoi{
+                        rectangles[person], std::vector<float>(keypointsPtr, keypointsPtr + personArea),
+                        getAverageScore(keypoints, person), 0});
+            }
+            cacheSlot.people = std::move(people);
+            cacheSlot.reused.clear();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<std::array<Rectangle<float>, 2>> KeypointRoiCache::select(
+        const std::vector<std::array<Rectangle<float>, 2>>& handRectangles, const Array<long long>& poseIds,
+        const unsigned long long slot)
+    {
+        try
+        {
+            auto selectedRectangles = handRectangles;
+            for (auto hand = 0 ; hand < 2 ; hand++)
+            {
+                std::vector<Rectangle<float>> rectangles(handRectangles.size());
+                for (auto person = 0u ; person < handRectangles.size() ; person++)
+                    rectangles[person] = handRectangles[person][hand];
+                rectangles = select(rectangles, poseIds, 2*slot + hand);
+                for (auto person = 0u ; person < handRectangles.size() ; person++)
+                    selectedRectangles[person][hand] = rectangles[person];
+            }
+            return selectedRectangles;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void KeypointRoiCache::update(
+        std::array<Array<float>, 2>& handKeypoints,
+        const std::vector<std::array<Rectangle<float>, 2>>& handRectangles, const Array<long long>& poseIds,
+        const unsigned long long slot)
+    {
+        try
+        {
+            for (auto hand = 0 ; hand < 2 ; hand++)
+            {
+                std::vector<Rectangle<float>> rectangles(handRectangles.size());
+                for (auto person = 0u ; person < handRectangles.size() ; person++)
+                    rectangles[person] = handRectangles[person][hand];
+                update(handKeypoints[hand], rectangles, poseIds, 2*slot + hand);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::pair<unsigned long long, unsigned long long> KeypointRoiCache::getStats() const
+    {
+        try
+        {
+            return std::make_pair(upImpl->mChecked, upImpl->mReused);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::make_pair(0ull, 0ull);
+        }
+    }
+
+    int getRoiCropSide(const float roiSide, const int netInputSide)
+    {
+        try
+        {
+            for (const auto cropSide : {128, 256})
+                if (cropSide < netInputSide && roiSide <= cropSide)
+                    return cropSide;
+            return netInputSide;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return netInputSide;
+        }
+    }
+}
@@ -1,6 +1,5 @@
 #include <openpose/core/keypointScaler.hpp>
 #include <openpose/utilities/fastMath.hpp>
-#include <openpose/utilities/keypoint.hpp>
 
 namespace op
 {
@@ -79,21 +78,8 @@ namespace op
     {
         try
         {
-            if (mScaleMode != ScaleMode::InputResolution)
-            {
-                // Get scale and offset
-                const auto scaleAndOffset = getScaleAndOffset(mScaleMode, scaleInputToOutput, scaleNetToOutput,
-                                                              producerSize);
-                // Only scaling
-                if (scaleAndOffset.x == 0 && scaleAndOffset.y == 0)
-                    for (auto& arrayToScale : arrayToScalesToScale)
-                        scaleKeypoints2d(arrayToScale, scaleAndOffset.width, scaleAndOffset.height);
-                // Scaling + offset
-                else
-                    for (auto& arrayToScale : arrayToScalesToScale)
-                        scaleKeypoints2d(arrayToScale, scaleAndOffset.width, scaleAndOffset.height,
-                                         scaleAndOffset.x, scaleAndOffset.y);
-            }
+            std::vector<std::vector<std::array<float,3>>> poseCandidates;
+            scale(arrayToScalesToScale, poseCandidates, scaleInputToOutput, scaleNetToOutput, producerSize);
         }
         catch (const std::exception& e)
         {
@@ -104,36 +90,63 @@ namespace op
     void KeypointScaler::scale(std::vector<std::vector<std::array<float,3>>>& poseCandidates,
                                const double scaleInputToOutput, const double scaleNetToOutput,
                                const Point<int>& producerSize) const
+    {
+        try
+        {
+            std::vector<Array<float>> arraysToScale;
+            scale(arraysToScale, poseCandidates, scaleInputToOutput, scaleNetToOutput, producerSize);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void KeypointScaler::scale(std::vector<Array<float>>& arraysToScale,
+                               std::vector<std::vector<std::array<float,3>>>& poseCandidates,
+                               const double scaleInputToOutput, const double scaleNetToOutput,
+                               const Point<int>& producerSize) const
     {
         try
         {
             if (mScaleMode != ScaleMode::InputResolution)
             {
-                // Get scale and offset
+                // Get scale and offset (once for all the arrays)
                 const auto scaleAndOffset = getScaleAndOffset(mScaleMode, scaleInputToOutput, scaleNetToOutput,
                                                               producerSize);
-                // Only scaling
-                if (scaleAndOffset.x == 0 && scaleAndOffset.y == 0)
+                const auto scaleX = scaleAndOffset.width;
+                const auto scaleY = scaleAndOffset.height;
+                const auto offsetX = scaleAndOffset.x;
+                const auto offsetY = scaleAndOffset.y;
+                if (scaleX == 1.f && scaleY == 1.f && offsetX == 0.f && offsetY == 0.f)
+                    return;
+                // Keypoints: Each array is a contiguous sequence of (x, y, score) triplets
+                for (auto& arrayToScale : arraysToScale)
                 {
-                    for (auto& partCandidates : poseCandidates)
+                    if (!arrayToScale.empty())
                     {
-                        for (auto& candidate : partCandidates)
+                        // 3 dimensions for keypoints, 2 for the flat part candidates (Datum::poseCandidatesArray)
+                        const auto numberDimensions = arrayToScale.getNumberDimensions();
+                        if ((numberDimensions != 2 && numberDimensions != 3)
+                            || arrayToScale.getSize(numberDimensions-1) != 3)
+                            error("Keypoint arrays must have 2 or 3 dimensions, the last one being (x, y, score).",
+                                  __LINE__, __FUNCTION__, __FILE__);
+                        auto* keypointPtr = arrayToScale.getPtr();
+                        const auto* const keypointPtrEnd = keypointPtr + arrayToScale.getVolume();
+                        for ( ; keypointPtr < keypointPtrEnd ; keypointPtr += 3)
                         {
-                            candidate[0] *= scaleAndOffset.width;
-                            candidate[1] *= scaleAndOffset.height;
+                            keypointPtr[0] = keypointPtr[0]*scaleX + offsetX;
+                            keypointPtr[1] = keypointPtr[1]*scaleY + offsetY;
                         }
                     }
                 }
-                // Scaling + offset
-                else
+                // Part candidates
+                for (auto& partCandidates : poseCandidates)
                 {
-                    for (auto& partCandidates : poseCandidates)
+                    for (auto& candidate : partCandidates)
                     {
-                        for (auto& candidate : partCandidates)
-                        {
-                            candidate[0] = candidate[0]*scaleAndOffset.width + scaleAndOffset.x;
-                            candidate[1] = candidate[1]*scaleAndOffset.height + scaleAndOffset.y;
-                        }
+                        candidate[0] = candidate[0]*scaleX + offsetX;
+                        candidate[1] = candidate[1]*scaleY + offsetY;
                     }
                 }
             }
@@ -1,12 +1,25 @@
 #include <openpose/core/matrix.hpp>
 #include <opencv2/core/core.hpp> // cv::Mat
+#include <openpose/utilities/allocationTracker.hpp>
 #include <openpose/utilities/errorAndLog.hpp>
 
 namespace op
 {
+    namespace
+    {
+        void recordCvMatClone(const cv::Mat& cvMat)
+        {
+            const auto bytes = (unsigned long long)(cvMat.total() * cvMat.elemSize());
+            AllocationTracker::recordHostAllocation(bytes);
+            AllocationTracker::recordCopy(bytes, MemoryCopy::HostToHost);
+        }
+    }
+
     struct Matrix::ImplMatrix
     {
         cv::Mat mCvMat;
+        // Owner of the borrowed memory of mCvMat (if any)
+        std::shared_ptr<void> spOwner;
     };
 
     void Matrix::splitCvMatIntoVectorMatrix(std::vector<Matrix>& matrixesResized, const void* const cvMatPtr)
@@ -60,6 +73,7 @@ namespace op
         try
         {
             spImpl->mCvMat = cv::Mat(rows, cols, type);
+            AllocationTracker::recordHostAllocation(spImpl->mCvMat.total() * spImpl->mCvMat.elemSize());
         }
         catch (const std::exception& e)
         {
@@ -80,12 +94,28 @@ namespace op
         }
     }
 
+    Matrix::Matrix(
+        const int rows, const int cols, const int type, void* cvMatPtr, const std::shared_ptr<void>& owner) :
+        spImpl{std::make_shared<ImplMatrix>()}
+    {
+        try
+        {
+            spImpl->mCvMat = cv::Mat(rows, cols, type, cvMatPtr);
+            spImpl->spOwner = owner;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     Matrix Matrix::clone() const
     {
         try
         {
             Matrix matrix;
             matrix.spImpl->mCvMat = spImpl->mCvMat.clone();
+            recordCvMatClone(matrix.spImpl->mCvMat);
             return matrix;
         }
         catch (const std::exception& e)
@@ -95,6 +125,50 @@ namespace op
         }
     }
 
+    bool Matrix::isShared() const
+    {
+        try
+        {
+            const auto& cvMat = spImpl->mCvMat;
+            // Empty matrix, nothing to share
+            if (cvMat.empty())
+                return false;
+            // Same cv::Mat referenced by several Matrix (Matrix copies share spImpl) or sub-matrix of a larger one
+            if (spImpl.use_count() > 1 || cvMat.isSubmatrix())
+                return true;
+            // cv::Mat copies (or external memory, which has no reference counter)
+            #if CV_MAJOR_VERSION < 3
+                return (cvMat.refcount == nullptr || *cvMat.refcount > 1);
+            #else
+                return (cvMat.u == nullptr || cvMat.u->refcount > 1);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    void Matrix::makeUnique()
+    {
+        try
+        {
+            if (isShared())
+            {
+                // New ImplMatrix, so other Matrix objects sharing spImpl keep the original data
+                auto spImplUnique = std::make_shared<ImplMatrix>();
+                spImplUnique->mCvMat = spImpl->mCvMat.clone();
+                recordCvMatClone(spImplUnique->mCvMat);
+                spImpl = spImplUnique;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     void* Matrix::getCvMat()
     {
         try
@@ -386,7 +460,14 @@ namespace op
     {
         try
         {
+            // cv::Mat::copyTo() only re-allocates the destination if its size or type differ
+            const auto* const outputDataBefore = outputMat.spImpl->mCvMat.data;
             spImpl->mCvMat.copyTo(outputMat.spImpl->mCvMat);
+            const auto& outputCvMat = outputMat.spImpl->mCvMat;
+            const auto bytes = (unsigned long long)(outputCvMat.total() * outputCvMat.elemSize());
+            if (outputCvMat.data != outputDataBefore)
+                AllocationTracker::recordHostAllocation(bytes);
+            AllocationTracker::recordCopy(bytes, MemoryCopy::HostToHost);
         }
         catch (const std::exception& e)
         {
@@ -0,0 +1,254 @@
+#include <openpose/core/motionGate.hpp>
+#include <opencv2/imgproc/imgproc.hpp> // cv::resize, cv::cvtColor
+#ifdef USE_CUDA
+    #include <cuda_runtime.h>
+    #include <openpose/gpu/cuda.hpp>
+#endif
+#include <openpose/utilities/fastMath.hpp>
+
+namespace op
+{
+    struct MotionGateView
+    {
+        cv::Mat thumbnail;
+        bool hasResults;
+        int skippedFrames;
+        Array<float> poseKeypoints;
+        Array<float> poseScores;
+        double scaleNetToOutput;
+
+        MotionGateView() :
+            hasResults{false},
+            skippedFrames{0},
+            scaleNetToOutput{0.}
+        {
+        }
+    };
+
+    struct MotionGate::ImplMotionGate
+    {
+        const double mChangedRatioThreshold;
+        const int mPixelThreshold;
+        const int mMaxSkippedFrames;
+        const int mThumbnailWidth;
+        std::vector<MotionGateView> mViews;
+        unsigned long long mFrames;
+        unsigned long long mStaticFrames;
+
+        ImplMotionGate(
+            const double changedRatioThreshold, const int pixelThreshold, const int maxSkippedFrames,
+            const int thumbnailWidth) :
+            mChangedRatioThreshold{changedRatioThreshold},
+            mPixelThreshold{pixelThreshold},
+            mMaxSkippedFrames{maxSkippedFrames},
+            mThumbnailWidth{fastMax(1, thumbnailWidth)},
+            mFrames{0ull},
+            mStaticFrames{0ull}
+        {
+        }
+    };
+
+    cv::Mat getThumbnailCpu(const cv::Mat& cvInputData, const int thumbnailWidth)
+    {
+        try
+        {
+            // Resized before the grayscale conversion (much fewer pixels), area averaging filters the sensor noise
+            const auto thumbnailHeight = fastMax(
+                1, positiveIntRound(cvInputData.rows * thumbnailWidth / (double)cvInputData.cols));
+            cv::Mat thumbnail;
+            cv::resize(cvInputData, thumbnail, cv::Size{thumbnailWidth, thumbnailHeight}, 0, 0, cv::INTER_AREA);
+            if (thumbnail.channels() == 3)
+                cv::cvtColor(thumbnail, thumbnail, cv::COLOR_BGR2GRAY);
+            else if (thumbnail.channels() == 4)
+                cv::cvtColor(thumbnail, thumbnail, cv::COLOR_BGRA2GRAY);
+            return thumbnail;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cv::Mat();
+        }
+    }
+
+    cv::Mat getThumbnailGpu(const FrameGpu& frameGpu, const int thumbnailWidth)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                // Only 1 row every `step` rows of the luma (NV12), raw (Bayer) or BGR plane is downloaded. An even
+                // step keeps the same Bayer color rows in all the thumbnails
+                const auto bytesPerPixel = (frameGpu.format == FrameGpuFormat::Bgr ? 3 : 1);
+                auto step = fastMax(1, frameGpu.width / thumbnailWidth);
+                if (step > 1 && step % 2 == 1)
+                    step++;
+                const auto rows = fastMax(1, frameGpu.height / step);
+                const auto cols = fastMax(1, frameGpu.width / step);
+                cv::Mat downloadedRows(rows, bytesPerPixel * frameGpu.width, CV_8UC1);
+                int currentGpuId;
+                cudaGetDevice(&currentGpuId);
+                cudaSetDevice(frameGpu.gpuId);
+                cudaMemcpy2D(
+                    downloadedRows.data, downloadedRows.step, frameGpu.dataPtr.get(), (size_t)step * frameGpu.pitch,
+                    bytesPerPixel * frameGpu.width, rows, cudaMemcpyDeviceToHost);
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                cudaSetDevice(currentGpuId);
+                // Columns averaged in blocks of `step` pixels (and of their 3 colors for BGR)
+                cv::Mat thumbnail(rows, cols, CV_8UC1);
+                for (auto y = 0 ; y < rows ; y++)
+                {
+                    const auto* const rowPtr = downloadedRows.ptr<unsigned char>(y);
+                    auto* const thumbnailPtr = thumbnail.ptr<unsigned char>(y);
+                    for (auto x = 0 ; x < cols ; x++)
+                    {
+                        auto sum = 0;
+                        for (auto i = x*step*bytesPerPixel ; i < (x+1)*step*bytesPerPixel ; i++)
+                            sum += rowPtr[i];
+                        thumbnailPtr[x] = (unsigned char)(sum / (step*bytesPerPixel));
+                    }
+                }
+                return thumbnail;
+            #else
+                UNUSED(frameGpu);
+                UNUSED(thumbnailWidth);
+                error("GPU frames require the CUDA version of OpenPose.", __LINE__, __FUNCTION__, __FILE__);
+                return cv::Mat();
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cv::Mat();
+        }
+    }
+
+    MotionGate::MotionGate(
+        const double changedRatioThreshold, const int pixelThreshold, const int maxSkippedFrames,
+        const int thumbnailWidth) :
+        upImpl{new ImplMotionGate{changedRatioThreshold, pixelThreshold, maxSkippedFrames, thumbnailWidth}}
+    {
+        try
+        {
+            if (changedRatioThreshold < 0. || changedRatioThreshold > 1.)
+                error("The ratio of changed pixels must be in the range [0, 1].", __LINE__, __FUNCTION__, __FILE__);
+            if (pixelThreshold < 0)
+                error("The pixel threshold must be 0 or positive.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    MotionGate::~MotionGate()
+    {
+        try
+        {
+            if (upImpl->mFrames > 0ull)
+                opLog("Motion gate: " + std::to_string(upImpl->mStaticFrames) + " of "
+                      + std::to_string(upImpl->mFrames) + " frames reused the keypoints of a previous frame.",
+                      Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool MotionGate::isStatic(const Matrix& cvInputData, const FrameGpu& frameGpu, const unsigned long long viewIndex)
+    {
+        try
+        {
+            if (upImpl->mViews.size() <= viewIndex)
+                upImpl->mViews.resize(viewIndex+1);
+            auto& view = upImpl->mViews[viewIndex];
+            upImpl->mFrames++;
+            // Thumbnail
+            cv::Mat thumbnail;
+            if (!cvInputData.empty())
+                thumbnail = getThumbnailCpu(OP_OP2CVCONSTMAT(cvInputData), upImpl->mThumbnailWidth);
+            else if (!frameGpu.empty())
+                thumbnail = getThumbnailGpu(frameGpu, upImpl->mThumbnailWidth);
+            // No image to compare (or different image type or resolution) --> new keyframe
+            auto isStatic = false;
+            if (!thumbnail.empty() && view.hasResults && view.skippedFrames < upImpl->mMaxSkippedFrames
+                && thumbnail.size() == view.thumbnail.size() && thumbnail.type() == view.thumbnail.type())
+            {
+                cv::Mat difference;
+                cv::absdiff(thumbnail, view.thumbnail, difference);
+                const auto changedPixels = cv::countNonZero(difference > upImpl->mPixelThreshold);
+                isStatic = (changedPixels <= upImpl->mChangedRatioThreshold * difference.total());
+            }
+            if (isStatic)
+            {
+                view.skippedFrames++;
+                upImpl->mStaticFrames++;
+            }
+            else
+            {
+                // Compared against the keyframe (rather than the previous frame), so slow changes accumulate
+                view.thumbnail = thumbnail;
+                view.hasResults = false;
+                view.skippedFrames = 0;
+            }
+            return isStatic;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void MotionGate::setKeyframeResults(
+        const unsigned long long viewIndex, const Array<float>& poseKeypoints, const Array<float>& poseScores,
+        const double scaleNetToOutput)
+    {
+        try
+        {
+            if (upImpl->mViews.size() <= viewIndex)
+                upImpl->mViews.resize(viewIndex+1);
+            auto& view = upImpl->mViews[viewIndex];
+            // Deep copies, the Datum ones are modified in place later on (e.g., KeypointScaler)
+            view.poseKeypoints = poseKeypoints.clone();
+            view.poseScores = poseScores.clone();
+            view.scaleNetToOutput = scaleNetToOutput;
+            view.hasResults = !view.thumbnail.empty();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void MotionGate::getKeyframeResults(
+        const unsigned long long viewIndex, Array<float>& poseKeypoints, Array<float>& poseScores,
+        double& scaleNetToOutput) const
+    {
+        try
+        {
+            const auto& view = upImpl->mViews.at(viewIndex);
+            if (!view.hasResults)
+                error("There are no keyframe results for this view.", __LINE__, __FUNCTION__, __FILE__);
+            poseKeypoints = view.poseKeypoints.clone();
+            poseScores = view.poseScores.clone();
+            scaleNetToOutput = view.scaleNetToOutput;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::pair<unsigned long long, unsigned long long> MotionGate::getStats() const
+    {
+        try
+        {
+            return std::make_pair(upImpl->mFrames, upImpl->mStaticFrames);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::make_pair(0ull, 0ull);
+        }
+    }
+}
@@ -0,0 +1,198 @@
+#include <openpose/core/netResolutionController.hpp>
+#include <openpose/utilities/fastMath.hpp>
+
+namespace op
+{
+    // Weight of the last frame in the latency exponential moving average
+    const auto LATENCY_AVERAGE_WEIGHT = 0.2;
+    // Maximum number of frames started but not finished (e.g., dropped ones) that are kept
+    const auto MAX_PENDING_FRAMES = 256u;
+
+    std::vector<Point<int>> getNetInputResolutionLevels(
+        const Point<int>& minNetInputResolution, const Point<int>& maxNetInputResolution,
+        const unsigned int maxNumberLevels)
+    {
+        try
+        {
+            // Sanity checks
+            if (maxNumberLevels < 1)
+                error("There must be at least 1 network resolution.", __LINE__, __FUNCTION__, __FILE__);
+            const auto minPoint = std::vector<int>{minNetInputResolution.x, minNetInputResolution.y};
+            const auto maxPoint = std::vector<int>{maxNetInputResolution.x, maxNetInputResolution.y};
+            auto maxSteps = 0;
+            for (auto i = 0 ; i < 2 ; i++)
+            {
+                if ((minPoint[i] <= 0) != (maxPoint[i] <= 0))
+                    error("The minimum and maximum network resolutions must have their `-1` in the same dimension.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (minPoint[i] > 0 && (minPoint[i] % 16 != 0 || maxPoint[i] % 16 != 0))
+                    error("Net input resolution must be multiples of 16.", __LINE__, __FUNCTION__, __FILE__);
+                if (minPoint[i] > maxPoint[i])
+                    error("The minimum network resolution cannot be greater than the maximum one.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                maxSteps = fastMax(maxSteps, (maxPoint[i] - minPoint[i]) / 16);
+            }
+            if (minPoint[0] <= 0 && minPoint[1] <= 0)
+                error("Only 1 of the dimensions of net input resolution can be <= 0.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Evenly spaced levels (in multiples of 16) from the minimum to the maximum resolution
+            const auto numberLevels = fastMin((unsigned int)maxSteps + 1u, maxNumberLevels);
+            std::vector<Point<int>> netInputResolutions(numberLevels, minNetInputResolution);
+            for (auto level = 1u ; level < numberLevels ; level++)
+            {
+                const auto ratio = level / (double)(numberLevels - 1);
+                auto& netInputResolution = netInputResolutions[level];
+                if (netInputResolution.x > 0)
+                    netInputResolution.x += 16 * positiveIntRound(ratio * (maxPoint[0] - minPoint[0]) / 16.);
+                if (netInputResolution.y > 0)
+                    netInputResolution.y += 16 * positiveIntRound(ratio * (maxPoint[1] - minPoint[1]) / 16.);
+            }
+            return netInputResolutions;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    NetResolutionController::NetResolutionController(
+        const Point<int>& minNetInputResolution, const Point<int>& maxNetInputResolution,
+        const double targetLatencyMs, const unsigned int maxNumberLevels, const double hysteresis,
+        const unsigned int framesBetweenChanges) :
+        mNetInputResolutions{getNetInputResolutionLevels(
+            minNetInputResolution, maxNetInputResolution, maxNumberLevels)},
+        mTargetLatencyMs{targetLatencyMs},
+        mHysteresis{hysteresis},
+        mFramesBetweenChanges{framesBetweenChanges},
+        mLevel{mNetInputResolutions.empty() ? 0 : mNetInputResolutions.size() - 1},
+        mLatencyMs{-1.},
+        mFramesSinceChange{0u},
+        mNumberPeopleAtStepDown{-1}
+    {
+        try
+        {
+            // Sanity checks
+            if (targetLatencyMs <= 0.)
+                error("The target latency must be strictly positive.", __LINE__, __FUNCTION__, __FILE__);
+            if (hysteresis < 0. || hysteresis >= 1.)
+                error("The hysteresis must be in the range [0, 1).", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    NetResolutionController::~NetResolutionController()
+    {
+    }
+
+    Point<int> NetResolutionController::getNetInputResolution() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            return mNetInputResolutions.at(mLevel);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Point<int>{};
+        }
+    }
+
+    const std::vector<Point<int>>& NetResolutionController::getNetInputResolutions() const
+    {
+        return mNetInputResolutions;
+    }
+
+    void NetResolutionController::frameStarted(const unsigned long long frameId)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mFrameBegins[frameId] = std::chrono::high_resolution_clock::now();
+            // Frames that never finish (e.g., dropped ones) are forgotten
+            if (mFrameBegins.size() > MAX_PENDING_FRAMES)
+                mFrameBegins.erase(mFrameBegins.begin());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void NetResolutionController::frameFinished(const unsigned long long frameId, const int numberPeople)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            const auto frameBegin = mFrameBegins.find(frameId);
+            if (frameBegin == mFrameBegins.end())
+                return;
+            const auto latencyMs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::high_resolution_clock::now() - frameBegin->second).count() * 1e-6;
+            mFrameBegins.erase(frameBegin);
+            mLatencyMs = (mLatencyMs < 0.
+                ? latencyMs : LATENCY_AVERAGE_WEIGHT * latencyMs + (1. - LATENCY_AVERAGE_WEIGHT) * mLatencyMs);
+            // Latency of the current resolution not measured long enough yet
+            if (++mFramesSinceChange < mFramesBetweenChanges)
+                return;
+            auto newLevel = mLevel;
+            // Too slow: Step down
+            if (mLatencyMs > mTargetLatencyMs * (1. + mHysteresis) && mLevel > 0)
+            {
+                newLevel--;
+                mNumberPeopleAtStepDown = numberPeople;
+            }
+            // Fast enough: Step up (unless there are more people than when it stepped down)
+            else if (mLatencyMs < mTargetLatencyMs * (1. - mHysteresis) && mLevel + 1 < mNetInputResolutions.size()
+                     && (mNumberPeopleAtStepDown < 0 || numberPeople <= mNumberPeopleAtStepDown))
+                newLevel++;
+            if (newLevel != mLevel)
+            {
+                mLevel = newLevel;
+                // Frames in flight (started with the old resolution) are ignored for the new one
+                mLatencyMs = -1.;
+                mFramesSinceChange = 0u;
+                mFrameBegins.clear();
+                const auto& netInputResolution = mNetInputResolutions[mLevel];
+                opLog("Network resolution changed to " + std::to_string(netInputResolution.x) + "x"
+                      + std::to_string(netInputResolution.y) + " (latency target of "
+                      + std::to_string(mTargetLatencyMs) + " ms).", Priority::Normal);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void NetResolutionController::setNetInputSizes(const std::vector<std::vector<Point<int>>>& netInputSizes)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mNetInputSizes = netInputSizes;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<std::vector<Point<int>>> NetResolutionController::getNetInputSizes() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            return mNetInputSizes;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+}
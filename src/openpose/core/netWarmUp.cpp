@@ -0,0 +1,254 @@
+#include <openpose/core/netWarmUp.hpp>
+#include <algorithm> // std::find
+#include <cstdio> // std::rename
+#include <cstdlib> // std::atoi
+#include <fstream>
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+#endif
+#include <openpose/utilities/string.hpp>
+
+namespace op
+{
+    // Cache file: "key<TAB>width x height of each scale (space-separated)" per line, e.g.,
+    // "GeForce RTX 2080 (7.5) | CUDA 11000/10020 | 0 | models/ | <TAB>656x368 496x272"
+    const std::string NET_WARM_UP_CACHE_HEADER = "# OpenPose network warm-up cache";
+
+    std::string netInputSizesToString(const std::vector<Point<int>>& netInputSizes)
+    {
+        std::string netInputSizesString;
+        for (const auto& netInputSize : netInputSizes)
+            netInputSizesString += (netInputSizesString.empty() ? "" : " ")
+                + std::to_string(netInputSize.x) + "x" + std::to_string(netInputSize.y);
+        return netInputSizesString;
+    }
+
+    std::vector<Point<int>> stringToNetInputSizes(const std::string& netInputSizesString)
+    {
+        std::vector<Point<int>> netInputSizes;
+        for (const auto& sizeString : splitString(netInputSizesString, " "))
+        {
+            const auto xPosition = sizeString.find('x');
+            if (xPosition == std::string::npos)
+                return {};
+            const auto netInputSize = Point<int>{
+                std::atoi(sizeString.substr(0, xPosition).c_str()), std::atoi(sizeString.substr(xPosition+1).c_str())};
+            // Corrupted line
+            if (netInputSize.x <= 0 || netInputSize.y <= 0)
+                return {};
+            netInputSizes.emplace_back(netInputSize);
+        }
+        return netInputSizes;
+    }
+
+    void addIfNew(std::vector<std::vector<Point<int>>>& netInputSizesSet, const std::vector<Point<int>>& netInputSizes)
+    {
+        if (std::find(netInputSizesSet.begin(), netInputSizesSet.end(), netInputSizes) == netInputSizesSet.end())
+            netInputSizesSet.emplace_back(netInputSizes);
+    }
+
+    NetWarmUp::NetWarmUp(const std::vector<Point<int>>& inputSizes, const std::string& cacheFile) :
+        mInputSizes{inputSizes},
+        mCacheFile{cacheFile},
+        mPendingWorkers{0u}
+    {
+        try
+        {
+            // Load the cache file (it might not exist yet)
+            if (!mCacheFile.empty())
+            {
+                std::ifstream cacheStream{mCacheFile};
+                std::string line;
+                while (std::getline(cacheStream, line))
+                {
+                    const auto tabPosition = line.rfind('\t');
+                    if (line.empty() || line[0] == '#' || tabPosition == std::string::npos)
+                        continue;
+                    const auto netInputSizes = stringToNetInputSizes(line.substr(tabPosition+1));
+                    if (!netInputSizes.empty())
+                        addIfNew(mCachedNetInputSizes[line.substr(0, tabPosition)], netInputSizes);
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    NetWarmUp::~NetWarmUp()
+    {
+    }
+
+    const std::vector<Point<int>>& NetWarmUp::getInputSizes() const
+    {
+        return mInputSizes;
+    }
+
+    void NetWarmUp::addNetInputSizes(const std::vector<Point<int>>& netInputSizes)
+    {
+        try
+        {
+            if (!netInputSizes.empty())
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                addIfNew(mNetInputSizes, netInputSizes);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<std::vector<Point<int>>> NetWarmUp::getNetInputSizes(const std::string& key) const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            auto netInputSizesSet = mNetInputSizes;
+            const auto cachedIterator = mCachedNetInputSizes.find(key);
+            if (cachedIterator != mCachedNetInputSizes.end())
+                for (const auto& netInputSizes : cachedIterator->second)
+                    addIfNew(netInputSizesSet, netInputSizes);
+            return netInputSizesSet;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void NetWarmUp::addCachedNetInputSizes(const std::string& key, const std::vector<Point<int>>& netInputSizes)
+    {
+        try
+        {
+            if (!mCacheFile.empty() && !netInputSizes.empty())
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                auto& cachedNetInputSizes = mCachedNetInputSizes[key];
+                const auto numberCached = cachedNetInputSizes.size();
+                addIfNew(cachedNetInputSizes, netInputSizes);
+                if (cachedNetInputSizes.size() != numberCached)
+                {
+                    opLog("New network input size (" + netInputSizesToString(netInputSizes) + ") added to the"
+                          " warm-up cache `" + mCacheFile + "`.", Priority::High);
+                    saveCacheFile();
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::string NetWarmUp::getKey(const int gpuId, const std::string& modelKey)
+    {
+        try
+        {
+            std::string key;
+            #ifdef USE_CUDA
+                cudaDeviceProp cudaDeviceProperties;
+                int driverVersion = 0;
+                int runtimeVersion = 0;
+                if (cudaGetDeviceProperties(&cudaDeviceProperties, gpuId) == cudaSuccess)
+                    key += std::string{cudaDeviceProperties.name} + " (" + std::to_string(cudaDeviceProperties.major)
+                        + "." + std::to_string(cudaDeviceProperties.minor) + ") | ";
+                else
+                    cudaGetLastError(); // Reset the error
+                cudaDriverGetVersion(&driverVersion);
+                cudaRuntimeGetVersion(&runtimeVersion);
+                key += "CUDA " + std::to_string(driverVersion) + "/" + std::to_string(runtimeVersion) + " | ";
+            #else
+                UNUSED(gpuId);
+            #endif
+            key += modelKey;
+            // The tab separates the key from the sizes in the cache file
+            for (auto& character : key)
+                if (character == '\t' || character == '\n' || character == '\r')
+                    character = ' ';
+            return key;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    void NetWarmUp::addWorker()
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mPendingWorkers++;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void NetWarmUp::setWarmedUp()
+    {
+        try
+        {
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                if (mPendingWorkers > 0u)
+                    mPendingWorkers--;
+            }
+            mConditionVariable.notify_all();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool NetWarmUp::waitUntilWarmedUp(const std::chrono::milliseconds& timeout)
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{mMutex};
+            return mConditionVariable.wait_for(lock, timeout, [this] { return mPendingWorkers == 0u; });
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void NetWarmUp::saveCacheFile() const
+    {
+        try
+        {
+            // Written into a temporary file first, so an interrupted run does not leave a truncated cache
+            const auto temporaryFile = mCacheFile + ".tmp";
+            {
+                std::ofstream cacheStream{temporaryFile};
+                if (!cacheStream.is_open())
+                {
+                    opLog("The warm-up cache `" + mCacheFile + "` could not be written.", Priority::High);
+                    return;
+                }
+                cacheStream << NET_WARM_UP_CACHE_HEADER << "\n";
+                for (const auto& keyAndNetInputSizes : mCachedNetInputSizes)
+                    for (const auto& netInputSizes : keyAndNetInputSizes.second)
+                        cacheStream << keyAndNetInputSizes.first << "\t" << netInputSizesToString(netInputSizes)
+                                    << "\n";
+            }
+            // std::rename does not replace an existing file on Windows
+            std::remove(mCacheFile.c_str());
+            if (std::rename(temporaryFile.c_str(), mCacheFile.c_str()) != 0)
+                opLog("The warm-up cache `" + mCacheFile + "` could not be written.", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
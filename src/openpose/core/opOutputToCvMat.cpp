@@ -2,14 +2,17 @@
 #include <opencv2/core/core.hpp> // cv::Mat
 #ifdef USE_CUDA
     #include <openpose/gpu/cuda.hpp>
+    #include <openpose/gpu/cudaMemoryPool.hpp>
     #include <openpose_private/gpu/cuda.hu>
 #endif
+#include <openpose/utilities/allocationTracker.hpp>
 #include <openpose/utilities/openCv.hpp>
 
 namespace op
 {
-    OpOutputToCvMat::OpOutputToCvMat(const bool gpuResize) :
+    OpOutputToCvMat::OpOutputToCvMat(const bool gpuResize, const bool keepRenderTargetGpu) :
         mGpuResize{gpuResize},
+        mKeepRenderTargetGpu{keepRenderTargetGpu},
         spOutputImageFloatCuda{std::make_shared<float*>()},
         spOutputMaxSize{std::make_shared<unsigned long long>(0ull)},
         spGpuMemoryAllocated{std::make_shared<bool>(false)},
@@ -41,12 +44,12 @@ namespace op
                     cudaCheck(__LINE__, __FUNCTION__, __FILE__);
                     if (*spOutputImageFloatCuda != nullptr)
                     {
-                        cudaFree(*spOutputImageFloatCuda);
+                        cudaPoolFree(*spOutputImageFloatCuda);
                         *spOutputImageFloatCuda = nullptr;
                     }
                     if (pOutputImageUCharCuda != nullptr)
                     {
-                        cudaFree(pOutputImageUCharCuda);
+                        cudaPoolFree(pOutputImageUCharCuda);
                         pOutputImageUCharCuda = nullptr;
                     }
                     cudaCheck(__LINE__, __FUNCTION__, __FILE__);
@@ -75,6 +78,32 @@ namespace op
     }
 
     Matrix OpOutputToCvMat::formatToCvMat(const Array<float>& outputData)
+    {
+        try
+        {
+            return formatToCvMat(outputData, nullptr);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Matrix();
+        }
+    }
+
+    Matrix OpOutputToCvMat::formatToCvMat(const Array<float>& outputData, RenderTargetGpu& outputDataGpu)
+    {
+        try
+        {
+            return formatToCvMat(outputData, &outputDataGpu);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Matrix();
+        }
+    }
+
+    Matrix OpOutputToCvMat::formatToCvMat(const Array<float>& outputData, RenderTargetGpu* const outputDataGpu)
     {
         try
         {
@@ -95,25 +124,44 @@ namespace op
             else
             {
                 #ifdef USE_CUDA
+                    // Rendered image: render target of the Datum or memory shared with the previous GPU renderers
+                    const auto useRenderTarget = (outputDataGpu != nullptr && !outputDataGpu->empty()
+                                                  && outputDataGpu->upToDate);
+                    const auto volume = (int)outputData.getVolume();
+                    if (useRenderTarget && outputDataGpu->getVolume() != (unsigned long long)volume)
+                        error("The GPU render target and outputData have different sizes.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    const auto* const outputImageFloatCuda = (useRenderTarget
+                        ? outputDataGpu->dataPtr.get() : *spOutputImageFloatCuda);
                     // (Free and re-)Allocate temporary memory
-                    if (mOutputMaxSizeUChar < *spOutputMaxSize)
+                    const auto outputMaxSize = (useRenderTarget
+                        ? outputDataGpu->getVolume() : *spOutputMaxSize);
+                    if (mOutputMaxSizeUChar < outputMaxSize)
                     {
-                        mOutputMaxSizeUChar = *spOutputMaxSize;
-                        cudaFree(pOutputImageUCharCuda);
-                        cudaMalloc((void**)&pOutputImageUCharCuda, sizeof(unsigned char) * mOutputMaxSizeUChar);
+                        mOutputMaxSizeUChar = outputMaxSize;
+                        cudaPoolFree(pOutputImageUCharCuda);
+                        pOutputImageUCharCuda = (unsigned char*)cudaPoolMalloc(
+                            sizeof(unsigned char) * mOutputMaxSizeUChar);
                     }
                     // Float ptr --> unsigned char ptr
-                    const auto volume = (int)outputData.getVolume();
-                    uCharImageCast(pOutputImageUCharCuda, *spOutputImageFloatCuda, volume);
+                    uCharImageCast(pOutputImageUCharCuda, outputImageFloatCuda, volume);
                     // Allocate cvMat
                     cvMat = cv::Mat(outputData.getSize(0), outputData.getSize(1), CV_8UC3);
                     // CUDA --> CPU: Copy output image back to CPU
                     cudaMemcpy(
                         cvMat.data, pOutputImageUCharCuda, sizeof(unsigned char) * volume,
                         cudaMemcpyDeviceToHost);
-                    // Indicate memory was copied out
-                    *spGpuMemoryAllocated = false;
+                    AllocationTracker::recordCopy(sizeof(unsigned char) * volume, MemoryCopy::DeviceToHost);
+                    // Indicate memory was copied out (and release the GPU memory of the Datum)
+                    if (useRenderTarget)
+                    {
+                        if (!mKeepRenderTargetGpu)
+                            *outputDataGpu = RenderTargetGpu{};
+                    }
+                    else
+                        *spGpuMemoryAllocated = false;
                 #else
+                    UNUSED(outputDataGpu);
                     error("You need to compile OpenPose with CUDA support in order to use GPU resize.",
                         __LINE__, __FUNCTION__, __FILE__);
                 #endif
@@ -0,0 +1,56 @@
+#include <openpose/core/personCropsGpu.hpp>
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+    #include <openpose/gpu/cudaMemoryPool.hpp>
+#endif
+#include <openpose/utilities/errorAndLog.hpp>
+
+namespace op
+{
+    PersonCropsGpu::PersonCropsGpu() :
+        numberCrops{0},
+        width{0},
+        height{0},
+        gpuId{0}
+    {
+    }
+
+    void PersonCropsGpu::allocate(const int newNumberCrops, const int newWidth, const int newHeight)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                int currentGpuId;
+                cudaGetDevice(&currentGpuId);
+                numberCrops = newNumberCrops;
+                width = newWidth;
+                height = newHeight;
+                gpuId = currentGpuId;
+                // Always a new block (other copies of the previous one might still be read), the pool makes it cheap
+                dataPtr.reset();
+                dataPtr = std::shared_ptr<float>{
+                    (float*)cudaPoolMalloc(getVolume() * sizeof(float)),
+                    [currentGpuId](float* gpuPtr)
+                    {
+                        // The crops of a Datum are read by the later workers, so the last copy might be
+                        // destroyed in another thread (and current device) than the one of the pose extractor
+                        int releasingGpuId;
+                        cudaGetDevice(&releasingGpuId);
+                        cudaSetDevice(currentGpuId);
+                        cudaPoolFree(gpuPtr);
+                        cudaSetDevice(releasingGpuId);
+                    }};
+            #else
+                UNUSED(newNumberCrops);
+                UNUSED(newWidth);
+                UNUSED(newHeight);
+                error("OpenPose must be compiled with the `USE_CUDA` macro definitions in order to run this"
+                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
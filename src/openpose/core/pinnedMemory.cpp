@@ -0,0 +1,241 @@
+#include <openpose/core/pinnedMemory.hpp>
+#include <map>
+#include <mutex>
+#include <set>
+#include <vector>
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+#endif
+#include <openpose/utilities/errorAndLog.hpp>
+
+namespace op
+{
+    // Above this amount of cached (free) memory, released blocks are freed rather than kept in the pool
+    const auto PINNED_MEMORY_MAX_CACHED_BYTES = 512ull << 20; // 512 MB
+
+    struct PinnedMemoryPool
+    {
+        std::mutex mMutex;
+        std::map<unsigned long long, std::vector<unsigned char*>> mFreeBlocks; // Bucket bytes --> free blocks
+        std::set<const void*> mUsedBlocks;
+        unsigned long long mUsedBytes;
+        unsigned long long mCachedBytes;
+        bool mDisabled;
+
+        PinnedMemoryPool() :
+            mUsedBytes{0ull},
+            mCachedBytes{0ull},
+            mDisabled{false}
+        {
+        }
+    };
+
+    PinnedMemoryPool& getPinnedMemoryPool()
+    {
+        // Never destroyed, so Arrays released during the static de-initialization can still return their memory
+        static auto* pinnedMemoryPool = new PinnedMemoryPool{};
+        return *pinnedMemoryPool;
+    }
+
+    unsigned long long getPinnedMemoryBucketBytes(const unsigned long long bytes)
+    {
+        // 8 buckets per power of 2 (i.e., at most 25% of extra memory), with a minimum of 1 page (4 KB)
+        auto powerOf2 = 4096ull;
+        while (powerOf2 < bytes)
+            powerOf2 <<= 1;
+        const auto step = (powerOf2 > 32768ull ? powerOf2 / 8 : 4096ull);
+        return ((bytes + step - 1) / step) * step;
+    }
+
+    void freePinnedBlock(unsigned char* const blockPtr)
+    {
+        #ifdef USE_CUDA
+            cudaFreeHost(blockPtr);
+        #else
+            UNUSED(blockPtr);
+        #endif
+    }
+
+    void releasePinnedBlock(unsigned char* const blockPtr, const unsigned long long bucketBytes)
+    {
+        try
+        {
+            auto& pool = getPinnedMemoryPool();
+            {
+                const std::lock_guard<std::mutex> lock{pool.mMutex};
+                pool.mUsedBlocks.erase(blockPtr);
+                pool.mUsedBytes -= bucketBytes;
+                if (pool.mCachedBytes + bucketBytes <= PINNED_MEMORY_MAX_CACHED_BYTES)
+                {
+                    pool.mFreeBlocks[bucketBytes].emplace_back(blockPtr);
+                    pool.mCachedBytes += bucketBytes;
+                    return;
+                }
+            }
+            freePinnedBlock(blockPtr);
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::shared_ptr<unsigned char> getPinnedMemory(const unsigned long long bytes)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                if (bytes == 0ull)
+                    return std::shared_ptr<unsigned char>{};
+                auto& pool = getPinnedMemoryPool();
+                const auto bucketBytes = getPinnedMemoryBucketBytes(bytes);
+                unsigned char* blockPtr = nullptr;
+                // Re-use a cached block of the same bucket
+                {
+                    const std::lock_guard<std::mutex> lock{pool.mMutex};
+                    if (pool.mDisabled)
+                        return std::shared_ptr<unsigned char>{};
+                    auto freeBlocks = pool.mFreeBlocks.find(bucketBytes);
+                    if (freeBlocks != pool.mFreeBlocks.end() && !freeBlocks->second.empty())
+                    {
+                        blockPtr = freeBlocks->second.back();
+                        freeBlocks->second.pop_back();
+                        pool.mCachedBytes -= bucketBytes;
+                    }
+                }
+                // Or allocate a new one
+                if (blockPtr == nullptr)
+                {
+                    // Portable: Pinned for all the CUDA contexts (i.e., for all the GPUs)
+                    // Mapped: Also addressable from the GPU, so integrated GPUs can read it with no copy (see
+                    // getPinnedMemoryDevicePtr())
+                    void* newBlockPtr = nullptr;
+                    if (cudaHostAlloc(&newBlockPtr, bucketBytes, cudaHostAllocPortable | cudaHostAllocMapped)
+                        != cudaSuccess)
+                    {
+                        // Clear the CUDA error and stop trying (e.g., no GPU found)
+                        cudaGetLastError();
+                        const std::lock_guard<std::mutex> lock{pool.mMutex};
+                        if (!pool.mDisabled)
+                        {
+                            pool.mDisabled = true;
+                            opLog("Pinned memory could not be allocated, using regular memory instead.",
+                                  Priority::High);
+                        }
+                        return std::shared_ptr<unsigned char>{};
+                    }
+                    blockPtr = (unsigned char*)newBlockPtr;
+                }
+                // Mark as used
+                {
+                    const std::lock_guard<std::mutex> lock{pool.mMutex};
+                    pool.mUsedBlocks.emplace(blockPtr);
+                    pool.mUsedBytes += bucketBytes;
+                }
+                return std::shared_ptr<unsigned char>{
+                    blockPtr, [bucketBytes](unsigned char* const ptr) { releasePinnedBlock(ptr, bucketBytes); }};
+            #else
+                UNUSED(bytes);
+                return std::shared_ptr<unsigned char>{};
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::shared_ptr<unsigned char>{};
+        }
+    }
+
+    bool isPinnedMemory(const void* const ptr)
+    {
+        try
+        {
+            auto& pool = getPinnedMemoryPool();
+            const std::lock_guard<std::mutex> lock{pool.mMutex};
+            return pool.mUsedBlocks.count(ptr) > 0;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void* getPinnedMemoryDevicePtr(const void* const ptr)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                if (!isPinnedMemory(ptr))
+                    return nullptr;
+                void* devicePtr = nullptr;
+                if (cudaHostGetDevicePointer(&devicePtr, const_cast<void*>(ptr), 0) != cudaSuccess)
+                {
+                    // Clear the CUDA error (e.g., device without host memory mapping)
+                    cudaGetLastError();
+                    return nullptr;
+                }
+                return devicePtr;
+            #else
+                UNUSED(ptr);
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    void releasePinnedMemoryCache()
+    {
+        try
+        {
+            std::map<unsigned long long, std::vector<unsigned char*>> freeBlocks;
+            {
+                auto& pool = getPinnedMemoryPool();
+                const std::lock_guard<std::mutex> lock{pool.mMutex};
+                std::swap(freeBlocks, pool.mFreeBlocks);
+                pool.mCachedBytes = 0ull;
+            }
+            for (auto& bucket : freeBlocks)
+                for (auto* blockPtr : bucket.second)
+                    freePinnedBlock(blockPtr);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned long long getPinnedMemoryUsedBytes()
+    {
+        try
+        {
+            auto& pool = getPinnedMemoryPool();
+            const std::lock_guard<std::mutex> lock{pool.mMutex};
+            return pool.mUsedBytes;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    unsigned long long getPinnedMemoryCachedBytes()
+    {
+        try
+        {
+            auto& pool = getPinnedMemoryPool();
+            const std::lock_guard<std::mutex> lock{pool.mMutex};
+            return pool.mCachedBytes;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+}
@@ -0,0 +1,58 @@
+#include <openpose/core/renderTargetGpu.hpp>
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+    #include <openpose/gpu/cudaMemoryPool.hpp>
+#endif
+#include <openpose/utilities/errorAndLog.hpp>
+
+namespace op
+{
+    RenderTargetGpu::RenderTargetGpu() :
+        width{0},
+        height{0},
+        gpuId{0},
+        upToDate{false}
+    {
+    }
+
+    void RenderTargetGpu::allocate(const int newWidth, const int newHeight)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                int currentGpuId;
+                cudaGetDevice(&currentGpuId);
+                if (dataPtr == nullptr || width != newWidth || height != newHeight || gpuId != currentGpuId)
+                {
+                    width = newWidth;
+                    height = newHeight;
+                    gpuId = currentGpuId;
+                    upToDate = false;
+                    dataPtr.reset();
+                    dataPtr = std::shared_ptr<float>{
+                        (float*)cudaPoolMalloc(getVolume() * sizeof(float)),
+                        [currentGpuId](float* gpuPtr)
+                        {
+                            // The last copy usually goes away with its Datum in the output or GUI thread, whose
+                            // current device might not be currentGpuId (and cudaPoolFree() records the release on
+                            // the default stream of the current device)
+                            int releasingGpuId;
+                            cudaGetDevice(&releasingGpuId);
+                            cudaSetDevice(currentGpuId);
+                            cudaPoolFree(gpuPtr);
+                            cudaSetDevice(releasingGpuId);
+                        }};
+                }
+            #else
+                UNUSED(newWidth);
+                UNUSED(newHeight);
+                error("OpenPose must be compiled with the `USE_CUDA` macro definitions in order to run this"
+                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
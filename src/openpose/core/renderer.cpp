@@ -59,6 +59,10 @@ namespace op
     {
         try
         {
+            // Sanity check
+            if (*spNumberElementsToRender == 0)
+                error("Number elements to render cannot be 0 for this function.",
+                      __LINE__, __FUNCTION__, __FILE__);
             *spElementToRender = elementToRender % *spNumberElementsToRender;
         }
         catch (const std::exception& e)
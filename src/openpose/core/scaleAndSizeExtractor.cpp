@@ -6,19 +6,18 @@ namespace op
 {
     ScaleAndSizeExtractor::ScaleAndSizeExtractor(const Point<int>& netInputResolution,
         const float netInputResolutionDynamicBehavior, const Point<int>& outputResolution, const int scaleNumber,
-        const double scaleGap) :
+        const double scaleGap, const bool smallestScaleOnly) :
         mNetInputResolution{netInputResolution},
         mNetInputResolutionDynamicBehavior{netInputResolutionDynamicBehavior},
         mOutputSize{outputResolution},
         mScaleNumber{scaleNumber},
-        mScaleGap{scaleGap}
+        mScaleGap{scaleGap},
+        mSmallestScaleOnly{smallestScaleOnly}
     {
         try
         {
             // Sanity checks
-            if ((netInputResolution.x > 0 && netInputResolution.x % 16 != 0)
-                || (netInputResolution.y > 0 && netInputResolution.y % 16 != 0))
-                error("Net input resolution must be multiples of 16.", __LINE__, __FUNCTION__, __FILE__);
+            setNetInputResolution(netInputResolution);
             if (scaleNumber < 1)
                 error("There must be at least 1 scale.", __LINE__, __FUNCTION__, __FILE__);
             if (scaleGap <= 0.)
@@ -34,6 +33,22 @@ namespace op
     {
     }
 
+    void ScaleAndSizeExtractor::setNetInputResolution(const Point<int>& netInputResolution)
+    {
+        try
+        {
+            // Sanity check
+            if ((netInputResolution.x > 0 && netInputResolution.x % 16 != 0)
+                || (netInputResolution.y > 0 && netInputResolution.y % 16 != 0))
+                error("Net input resolution must be multiples of 16.", __LINE__, __FUNCTION__, __FILE__);
+            mNetInputResolution = netInputResolution;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     std::tuple<std::vector<double>, std::vector<Point<int>>, double, Point<int>> ScaleAndSizeExtractor::extract(
         const Point<int>& inputResolution) const
     {
@@ -69,9 +84,10 @@ namespace op
                 }
             }
             // scaleInputToNetInputs & netInputSizes - Reescale keeping aspect ratio
-            std::vector<double> scaleInputToNetInputs(mScaleNumber, 1.f);
-            std::vector<Point<int>> netInputSizes(mScaleNumber);
-            for (auto i = 0; i < mScaleNumber; i++)
+            const auto firstScale = (mSmallestScaleOnly ? mScaleNumber-1 : 0);
+            std::vector<double> scaleInputToNetInputs(mScaleNumber - firstScale, 1.f);
+            std::vector<Point<int>> netInputSizes(mScaleNumber - firstScale);
+            for (auto i = firstScale; i < mScaleNumber; i++)
             {
                 const auto currentScale = 1. - i*mScaleGap;
                 if (currentScale < 0. || 1. < currentScale)
@@ -83,8 +99,8 @@ namespace op
                 const auto targetHeight = fastTruncate(
                     positiveIntRound(poseNetInputSize.y * currentScale) / 16 * 16, 1, poseNetInputSize.y);
                 const Point<int> targetSize{targetWidth, targetHeight};
-                scaleInputToNetInputs[i] = resizeGetScaleFactor(inputResolution, targetSize);
-                netInputSizes[i] = targetSize;
+                scaleInputToNetInputs[i - firstScale] = resizeGetScaleFactor(inputResolution, targetSize);
+                netInputSizes[i - firstScale] = targetSize;
             }
             // scaleInputToOutput - Scale between input and desired output size
             Point<int> outputResolution;
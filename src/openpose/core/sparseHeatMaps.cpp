@@ -0,0 +1,90 @@
+#include <openpose/core/sparseHeatMaps.hpp>
+#include <cmath> // std::abs
+
+namespace op
+{
+    SparseHeatMaps::SparseHeatMaps() :
+        threshold{0.f}
+    {
+    }
+
+    SparseHeatMaps::SparseHeatMaps(const Array<float>& heatMaps, const float threshold_) :
+        threshold{threshold_}
+    {
+        try
+        {
+            if (!heatMaps.empty())
+            {
+                if (heatMaps.getNumberDimensions() != 3)
+                    error("Only heat maps of size [#channels x height x width] can be sparsified.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                size = heatMaps.getSize();
+                const auto numberChannels = size[0];
+                const auto channelArea = size[1] * size[2];
+                offsets.resize(numberChannels + 1);
+                for (auto channel = 0 ; channel < numberChannels ; channel++)
+                {
+                    offsets[channel] = (int)values.size();
+                    const auto* const channelPtr = heatMaps.getConstPtr() + channel * channelArea;
+                    for (auto index = 0 ; index < channelArea ; index++)
+                    {
+                        if (std::abs(channelPtr[index]) > threshold)
+                        {
+                            indices.emplace_back(index);
+                            values.emplace_back(channelPtr[index]);
+                        }
+                    }
+                }
+                offsets[numberChannels] = (int)values.size();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool SparseHeatMaps::empty() const
+    {
+        return size.empty();
+    }
+
+    int SparseHeatMaps::getNumberValues() const
+    {
+        return (int)values.size();
+    }
+
+    void SparseHeatMaps::clear()
+    {
+        size.clear();
+        offsets.clear();
+        indices.clear();
+        values.clear();
+        threshold = 0.f;
+    }
+
+    Array<float> SparseHeatMaps::toDense() const
+    {
+        try
+        {
+            Array<float> heatMaps;
+            if (!empty())
+            {
+                heatMaps.reset(size, 0.f);
+                const auto channelArea = size[1] * size[2];
+                for (auto channel = 0 ; channel + 1 < (int)offsets.size() ; channel++)
+                {
+                    auto* const channelPtr = heatMaps.getPtr() + channel * channelArea;
+                    for (auto i = offsets[channel] ; i < offsets[channel+1] ; i++)
+                        channelPtr[indices[i]] = values[i];
+                }
+            }
+            return heatMaps;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<float>{};
+        }
+    }
+}
@@ -2,8 +2,10 @@
 
 namespace op
 {
+    DEFINE_TEMPLATE_DATUM(WFaceAndHandExtractorNet);
     DEFINE_TEMPLATE_DATUM(WFaceDetector);
     DEFINE_TEMPLATE_DATUM(WFaceExtractorNet);
     DEFINE_TEMPLATE_DATUM(WFaceRenderer);
     DEFINE_TEMPLATE_DATUM(WFaceDetectorOpenCV);
+    DEFINE_TEMPLATE_DATUM(WFaceDetectorNet);
 }
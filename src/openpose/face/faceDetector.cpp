@@ -6,7 +6,7 @@
 namespace op
 {
     FaceDetector::FaceDetector(const PoseModel poseModel) :
-        mNeck{poseBodyPartMapStringToKey(poseModel, "Neck")},
+        mNeck{poseBodyPartMapStringToKey(poseModel, std::vector<std::string>{"Neck", "UpperNeck"})},
         mNose{poseBodyPartMapStringToKey(poseModel, std::vector<std::string>{"Nose", "Head"})},
         mLEar{poseBodyPartMapStringToKey(poseModel, std::vector<std::string>{"LEar", "Head"})},
         mREar{poseBodyPartMapStringToKey(poseModel, std::vector<std::string>{"REar", "Head"})},
@@ -0,0 +1,246 @@
+#include <openpose/face/faceDetectorNet.hpp>
+#include <algorithm> // std::copy, std::sort
+#include <cmath> // std::exp, std::pow
+#include <openpose/core/cvMatToOpInput.hpp>
+#include <openpose/face/faceParameters.hpp>
+#include <openpose/net/netCaffe.hpp>
+#include <openpose/net/netOpenVino.hpp>
+#include <openpose/net/netTensorRt.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/fileSystem.hpp>
+
+namespace op
+{
+    // Minimum IoU between 2 detected faces to only keep the one with the highest score
+    const auto FACE_DETECTOR_NMS_IOU = 0.3f;
+    // Network downsampling of its input (multiple of it)
+    const auto FACE_DETECTOR_STRIDE_MULTIPLE = 32;
+
+    struct ScoredFace
+    {
+        Rectangle<float> rectangle;
+        float score;
+    };
+
+    float getIntersectionOverUnion(const Rectangle<float>& a, const Rectangle<float>& b)
+    {
+        const auto width = fastMin(a.x + a.width, b.x + b.width) - fastMax(a.x, b.x);
+        const auto height = fastMin(a.y + a.height, b.y + b.height) - fastMax(a.y, b.y);
+        if (width <= 0.f || height <= 0.f)
+            return 0.f;
+        const auto intersection = width * height;
+        return intersection / (a.area() + b.area() - intersection);
+    }
+
+    struct FaceDetectorNet::ImplFaceDetectorNet
+    {
+        const std::string mModelFolder;
+        const int mGpuId;
+        const Point<int> mNetInputSizeDesired;
+        const int mNumberScales;
+        const float mScaleGap;
+        const float mScoreThreshold;
+        const int mPrecision;
+        const bool mEnableGoogleLogging;
+        // The network input follows the body networks (BODY_25-like normalization, black padding)
+        CvMatToOpInput mCvMatToOpInput;
+        // Init with thread
+        std::shared_ptr<Net> spNet;
+        std::shared_ptr<ArrayCpuGpu<float>> spNetOutputBlob;
+        Array<float> mBatchInputNetData;
+
+        ImplFaceDetectorNet(
+            const std::string& modelFolder, const int gpuId, const Point<int>& netInputSize, const int numberScales,
+            const float scaleGap, const float scoreThreshold, const int precision, const bool enableGoogleLogging) :
+            mModelFolder{modelFolder},
+            mGpuId{gpuId},
+            mNetInputSizeDesired{netInputSize},
+            mNumberScales{numberScales},
+            mScaleGap{scaleGap},
+            mScoreThreshold{scoreThreshold},
+            mPrecision{precision},
+            mEnableGoogleLogging{enableGoogleLogging},
+            mCvMatToOpInput{PoseModel::BODY_25}
+        {
+        }
+    };
+
+    FaceDetectorNet::FaceDetectorNet(
+        const std::string& modelFolder, const int gpuId, const Point<int>& netInputSize, const int numberScales,
+        const float scaleGap, const float scoreThreshold, const int precision, const bool enableGoogleLogging) :
+        upImpl{new ImplFaceDetectorNet{modelFolder, gpuId, netInputSize, numberScales, scaleGap, scoreThreshold,
+                                       precision, enableGoogleLogging}}
+    {
+        try
+        {
+            // Sanity checks
+            if (numberScales < 1 || scaleGap <= 0.f || scaleGap > 1.f)
+                error("The face detector needs at least 1 scale and a scale gap in the range (0, 1].",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if ((netInputSize.x <= 0 && netInputSize.y <= 0)
+                || (netInputSize.x > 0 && netInputSize.x % FACE_DETECTOR_STRIDE_MULTIPLE != 0)
+                || (netInputSize.y > 0 && netInputSize.y % FACE_DETECTOR_STRIDE_MULTIPLE != 0))
+                error("The face detector net resolution must be a multiple of "
+                      + std::to_string(FACE_DETECTOR_STRIDE_MULTIPLE) + " (at most 1 dimension can be -1).",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    FaceDetectorNet::~FaceDetectorNet()
+    {
+    }
+
+    void FaceDetectorNet::initializationOnThread()
+    {
+        try
+        {
+            // ONNX model: TensorRT (or OpenVINO if TensorRT is not available)
+            const auto onnxModel = upImpl->mModelFolder + FACE_DETECTOR_ONNX_MODEL;
+            if (existFile(onnxModel))
+            {
+                #if defined(USE_OPENVINO) && !defined(USE_TENSORRT)
+                    upImpl->spNet = std::make_shared<NetOpenVino>(onnxModel, upImpl->mPrecision);
+                #else
+                    upImpl->spNet = std::make_shared<NetTensorRt>(onnxModel, upImpl->mGpuId, upImpl->mPrecision);
+                #endif
+            }
+            // Caffe model
+            else
+                upImpl->spNet = std::make_shared<NetCaffe>(
+                    upImpl->mModelFolder + FACE_DETECTOR_PROTOTXT, upImpl->mModelFolder + FACE_DETECTOR_TRAINED_MODEL,
+                    upImpl->mGpuId, upImpl->mEnableGoogleLogging);
+            upImpl->spNet->initializationOnThread();
+            upImpl->spNetOutputBlob = upImpl->spNet->getOutputBlobArray();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<Rectangle<float>> FaceDetectorNet::detectFaces(const Matrix& inputData)
+    {
+        try
+        {
+            if (inputData.empty())
+                return {};
+            if (upImpl->spNet == nullptr)
+                error("FaceDetectorNet::initializationOnThread() must be called before detectFaces().",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Network input size (-1 dimension from the frame aspect ratio)
+            auto netInputSize = upImpl->mNetInputSizeDesired;
+            if (netInputSize.x <= 0)
+                netInputSize.x = fastMax(1, positiveIntRound(netInputSize.y * inputData.cols()
+                    / (float)(inputData.rows() * FACE_DETECTOR_STRIDE_MULTIPLE))) * FACE_DETECTOR_STRIDE_MULTIPLE;
+            else if (netInputSize.y <= 0)
+                netInputSize.y = fastMax(1, positiveIntRound(netInputSize.x * inputData.rows()
+                    / (float)(inputData.cols() * FACE_DETECTOR_STRIDE_MULTIPLE))) * FACE_DETECTOR_STRIDE_MULTIPLE;
+            // All the scales padded into the same net input size, resized and normalized in a single pass
+            const auto scaleFullFrame = fastMin(netInputSize.x / (double)inputData.cols(),
+                                                netInputSize.y / (double)inputData.rows());
+            std::vector<double> scaleInputToNetInputs(upImpl->mNumberScales);
+            for (auto i = 0 ; i < upImpl->mNumberScales ; i++)
+                scaleInputToNetInputs[i] = scaleFullFrame * std::pow(upImpl->mScaleGap, i);
+            const std::vector<Point<int>> netInputSizes(upImpl->mNumberScales, netInputSize);
+            const auto inputNetData = upImpl->mCvMatToOpInput.createArray(
+                inputData, scaleInputToNetInputs, netInputSizes);
+            // Batch of scales, a single forward pass
+            if (upImpl->mNumberScales == 1)
+                upImpl->spNet->forwardPass(inputNetData[0]);
+            else
+            {
+                const std::vector<int> batchSize4D{upImpl->mNumberScales, 3, netInputSize.y, netInputSize.x};
+                if (upImpl->mBatchInputNetData.getSize() != batchSize4D)
+                    upImpl->mBatchInputNetData.resetPinned(batchSize4D);
+                const auto scaleVolume = inputNetData[0].getVolume();
+                for (auto i = 0 ; i < upImpl->mNumberScales ; i++)
+                    std::copy(inputNetData[i].getConstPtr(), inputNetData[i].getConstPtr() + scaleVolume,
+                              upImpl->mBatchInputNetData.getPtr() + i * scaleVolume);
+                upImpl->spNet->forwardPass(upImpl->mBatchInputNetData);
+            }
+            // Decode the face centers (3x3 local maxima of the score) on the small output grid
+            const auto& outputBlob = *upImpl->spNetOutputBlob;
+            if (outputBlob.num_axes() != 4 || outputBlob.shape(0) != upImpl->mNumberScales
+                || outputBlob.shape(1) != 5)
+                error("The face detector network output must be {#scales, 5, height, width}, while it is "
+                      + outputBlob.shape_string() + ".", __LINE__, __FUNCTION__, __FILE__);
+            const auto outputHeight = outputBlob.shape(2);
+            const auto outputWidth = outputBlob.shape(3);
+            const auto outputArea = outputHeight * outputWidth;
+            const auto stride = netInputSize.y / (float)outputHeight;
+            const auto* const outputPtr = outputBlob.cpu_data();
+            std::vector<ScoredFace> scoredFaces;
+            for (auto scale = 0 ; scale < upImpl->mNumberScales ; scale++)
+            {
+                const auto* const scorePtr = outputPtr + 5 * scale * outputArea;
+                const auto* const logHeightPtr = scorePtr + outputArea;
+                const auto* const logWidthPtr = scorePtr + 2 * outputArea;
+                const auto* const offsetYPtr = scorePtr + 3 * outputArea;
+                const auto* const offsetXPtr = scorePtr + 4 * outputArea;
+                // Only the cells of the frame (not of its padding)
+                const auto scaleNetToInput = (float)(1. / scaleInputToNetInputs[scale]);
+                const auto validWidth = fastMin(
+                    outputWidth, positiveIntRound(inputData.cols() / (scaleNetToInput * stride)) + 1);
+                const auto validHeight = fastMin(
+                    outputHeight, positiveIntRound(inputData.rows() / (scaleNetToInput * stride)) + 1);
+                for (auto y = 0 ; y < validHeight ; y++)
+                {
+                    for (auto x = 0 ; x < validWidth ; x++)
+                    {
+                        const auto index = y * outputWidth + x;
+                        const auto score = scorePtr[index];
+                        if (score < upImpl->mScoreThreshold)
+                            continue;
+                        auto isMaximum = true;
+                        for (auto dy = -1 ; dy < 2 && isMaximum ; dy++)
+                            for (auto dx = -1 ; dx < 2 && isMaximum ; dx++)
+                                if ((dx != 0 || dy != 0) && 0 <= x+dx && x+dx < outputWidth && 0 <= y+dy
+                                    && y+dy < outputHeight && scorePtr[index + dy*outputWidth + dx] > score)
+                                    isMaximum = false;
+                        if (!isMaximum)
+                            continue;
+                        const auto height = std::exp(logHeightPtr[index]) * stride;
+                        const auto width = std::exp(logWidthPtr[index]) * stride;
+                        const auto centerY = (y + offsetYPtr[index] + 0.5f) * stride;
+                        const auto centerX = (x + offsetXPtr[index] + 0.5f) * stride;
+                        scoredFaces.emplace_back(ScoredFace{
+                            Rectangle<float>{centerX - width/2.f, centerY - height/2.f, width, height}
+                                * scaleNetToInput, score});
+                    }
+                }
+            }
+            // Non-maximum suppression (across all the scales)
+            std::sort(scoredFaces.begin(), scoredFaces.end(),
+                      [](const ScoredFace& a, const ScoredFace& b) { return a.score > b.score; });
+            std::vector<Rectangle<float>> faceRectangles;
+            for (const auto& scoredFace : scoredFaces)
+            {
+                auto isMaximum = true;
+                for (const auto& previousFace : faceRectangles)
+                    if (getIntersectionOverUnion(scoredFace.rectangle, previousFace) > FACE_DETECTOR_NMS_IOU)
+                        isMaximum = false;
+                if (isMaximum)
+                    faceRectangles.emplace_back(scoredFace.rectangle);
+                if (faceRectangles.size() >= (unsigned int)FACE_MAX_FACES)
+                    break;
+            }
+            // Square rectangle 1.5x larger than the detection (as FaceDetectorOpenCV), so it covers the whole face
+            for (auto& faceRectangle : faceRectangles)
+            {
+                const auto center = faceRectangle.center();
+                const auto side = 1.5f * fastMax(faceRectangle.width, faceRectangle.height);
+                faceRectangle = Rectangle<float>{center.x - side/2.f, center.y - side/2.f, side, side};
+            }
+            return faceRectangles;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+}
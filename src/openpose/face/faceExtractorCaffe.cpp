@@ -2,22 +2,37 @@
 #ifdef USE_CAFFE
     #include <caffe/blob.hpp>
 #endif
+#include <algorithm> // std::any_of, std::stable_sort
+#include <openpose/core/keypointRoiCache.hpp>
 #include <openpose/face/faceParameters.hpp>
 #include <openpose/gpu/cuda.hpp>
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+    #include <openpose/gpu/cudaMemoryPool.hpp>
+#endif
 #include <openpose/net/maximumCaffe.hpp>
 #include <openpose/net/netCaffe.hpp>
+#include <openpose/net/resizeAndMergeBase.hpp>
 #include <openpose/net/resizeAndMergeCaffe.hpp>
+#include <openpose/utilities/allocationTracker.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/openCv.hpp>
 #include <openpose_private/utilities/openCvMultiversionHeaders.hpp>
+#include <openpose_private/utilities/parallelFor.hpp>
 
 namespace op
 {
     struct FaceExtractorCaffe::ImplFaceExtractorCaffe
     {
         #ifdef USE_CAFFE
-            bool netInitialized;
+            int mReshapedBatchSize;
+            int mReshapedCropSide;
             const int mGpuId;
+            const bool mAdaptiveCropSize;
+            // Network parameters (to create it again after netReleaseOnThread())
+            const std::string mModelFolder;
+            const bool mEnableGoogleLogging;
+            const std::shared_ptr<NetMemoryArena> spNetMemoryArena;
             std::shared_ptr<NetCaffe> spNetCaffe;
             std::shared_ptr<ResizeAndMergeCaffe<float>> spResizeAndMergeCaffe;
             std::shared_ptr<MaximumCaffe<float>> spMaximumCaffe;
@@ -25,16 +40,45 @@ namespace op
             std::shared_ptr<ArrayCpuGpu<float>> spCaffeNetOutputBlob;
             std::shared_ptr<ArrayCpuGpu<float>> spHeatMapsBlob;
             std::shared_ptr<ArrayCpuGpu<float>> spPeaksBlob;
+            #ifdef USE_CUDA
+                // Input frame in GPU memory (the face crops are warped from it)
+                unsigned char* pFrameGpuPtr;
+                unsigned long long mFrameGpuBytes;
+            #endif
 
-            ImplFaceExtractorCaffe(const std::string& modelFolder, const int gpuId, const bool enableGoogleLogging) :
-                netInitialized{false},
+            ImplFaceExtractorCaffe(const std::string& modelFolder, const int gpuId, const bool enableGoogleLogging,
+                                   const bool adaptiveCropSize,
+                                   const std::shared_ptr<NetMemoryArena>& netMemoryArena) :
+                mReshapedBatchSize{0},
+                mReshapedCropSide{0},
                 mGpuId{gpuId},
-                spNetCaffe{std::make_shared<NetCaffe>(modelFolder + FACE_PROTOTXT, modelFolder + FACE_TRAINED_MODEL,
-                                                      gpuId, enableGoogleLogging)},
+                mAdaptiveCropSize{adaptiveCropSize},
+                mModelFolder{modelFolder},
+                mEnableGoogleLogging{enableGoogleLogging},
+                spNetMemoryArena{netMemoryArena},
+                spNetCaffe{createNetCaffe()},
                 spResizeAndMergeCaffe{std::make_shared<ResizeAndMergeCaffe<float>>()},
                 spMaximumCaffe{std::make_shared<MaximumCaffe<float>>()}
+                #ifdef USE_CUDA
+                    , pFrameGpuPtr{nullptr},
+                    mFrameGpuBytes{0ull}
+                #endif
             {
             }
+
+            ~ImplFaceExtractorCaffe()
+            {
+                #ifdef USE_CUDA
+                    cudaPoolFree(pFrameGpuPtr);
+                #endif
+            }
+
+            std::shared_ptr<NetCaffe> createNetCaffe() const
+            {
+                return std::make_shared<NetCaffe>(
+                    mModelFolder + FACE_PROTOTXT, mModelFolder + FACE_TRAINED_MODEL, mGpuId, mEnableGoogleLogging,
+                    "net_output", spNetMemoryArena);
+            }
         #endif
     };
 
@@ -52,6 +96,7 @@ namespace op
                 // Copy face parts
                 #ifdef USE_CUDA
                     cudaMemcpy(heatMapsPtr, heatMapsGpuPtr, volumeBodyParts * sizeof(float), cudaMemcpyDeviceToHost);
+                    AllocationTracker::recordCopy(volumeBodyParts * sizeof(float), MemoryCopy::DeviceToHost);
                 #else
                     //std::memcpy(heatMapsPtr, heatMapsGpuPtr, volumeBodyParts * sizeof(float));
                     std::copy(heatMapsGpuPtr, heatMapsGpuPtr + volumeBodyParts, heatMapsPtr);
@@ -87,7 +132,8 @@ namespace op
             try
             {
                 // HeatMaps extractor blob and layer
-                const bool mergeFirstDimension = true;
+                // Each face of the batch is resized independently
+                const bool mergeFirstDimension = false;
                 resizeAndMergeCaffe->Reshape(
                     std::vector<ArrayCpuGpu<float>*>{caffeNetOutputBlob.get()},
                     std::vector<ArrayCpuGpu<float>*>{heatMapsBlob.get()},
@@ -109,10 +155,13 @@ namespace op
     FaceExtractorCaffe::FaceExtractorCaffe(const Point<int>& netInputSize, const Point<int>& netOutputSize,
                                            const std::string& modelFolder, const int gpuId,
                                            const std::vector<HeatMapType>& heatMapTypes,
-                                           const ScaleMode heatMapScaleMode, const bool enableGoogleLogging) :
+                                           const ScaleMode heatMapScaleMode, const bool enableGoogleLogging,
+                                           const bool adaptiveCropSize,
+                                           const std::shared_ptr<NetMemoryArena>& netMemoryArena) :
         FaceExtractorNet{netInputSize, netOutputSize, heatMapTypes, heatMapScaleMode}
         #ifdef USE_CAFFE
-        , upImpl{new ImplFaceExtractorCaffe{modelFolder, gpuId, enableGoogleLogging}}
+        , upImpl{new ImplFaceExtractorCaffe{modelFolder, gpuId, enableGoogleLogging,
+                                            adaptiveCropSize && heatMapTypes.empty(), netMemoryArena}}
         #endif
     {
         try
@@ -125,6 +174,8 @@ namespace op
                 UNUSED(heatMapTypes);
                 UNUSED(heatMapScaleMode);
                 UNUSED(enableGoogleLogging);
+                UNUSED(adaptiveCropSize);
+                UNUSED(netMemoryArena);
                 error("OpenPose must be compiled with the `USE_CAFFE` & `USE_CUDA` macro definitions in order to run"
                       " this functionality.", __LINE__, __FUNCTION__, __FILE__);
             #endif
@@ -172,13 +223,45 @@ namespace op
         }
     }
 
+    void FaceExtractorCaffe::netReleaseOnThread()
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                // Blobs and layers (a new network, not loaded until netInitializationOnThread())
+                upImpl->spCaffeNetOutputBlob.reset();
+                upImpl->spHeatMapsBlob.reset();
+                upImpl->spPeaksBlob.reset();
+                upImpl->spResizeAndMergeCaffe = std::make_shared<ResizeAndMergeCaffe<float>>();
+                upImpl->spMaximumCaffe = std::make_shared<MaximumCaffe<float>>();
+                upImpl->spNetCaffe = upImpl->createNetCaffe();
+                upImpl->mReshapedBatchSize = 0;
+                upImpl->mReshapedCropSide = 0;
+                #ifdef USE_CUDA
+                    cudaPoolFree(upImpl->pFrameGpuPtr);
+                    upImpl->pFrameGpuPtr = nullptr;
+                    upImpl->mFrameGpuBytes = 0ull;
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                #endif
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     void FaceExtractorCaffe::forwardPass(
         const std::vector<Rectangle<float>>& faceRectangles, const Matrix& inputData)
     {
         try
         {
             #ifdef USE_CAFFE
-                if (mEnabled && !faceRectangles.empty())
+                // Lazy loading: The network is only needed if any face was found
+                const auto netNeeded = std::any_of(
+                    faceRectangles.begin(), faceRectangles.end(),
+                    [](const Rectangle<float>& faceRectangle) { return faceRectangle.area() > 0; });
+                if (isNetReady(netNeeded) && !faceRectangles.empty())
                 {
                     const cv::Mat cvInputData = OP_OP2CVCONSTMAT(inputData);
 
@@ -195,11 +278,18 @@ namespace op
 
                     // HeatMaps: define size
                     if (!mHeatMapTypes.empty())
-                        mHeatMaps.reset({numberPeople, (int)FACE_NUMBER_PARTS, mNetOutputSize.y, mNetOutputSize.x});
+                        mHeatMaps.resetPinned(
+                            {numberPeople, (int)FACE_NUMBER_PARTS, mNetOutputSize.y, mNetOutputSize.x});
 
-                    // // Debugging
-                    // cv::Mat cvInputDataCopy = cvInputData.clone();
-                    // Extract face keypoints for each person
+                    // Faces with a minimum pixel area (and their crop transformation)
+                    struct FaceCrop
+                    {
+                        int person;
+                        int cropSide;
+                        cv::Mat Mscaling;
+                    };
+                    std::vector<FaceCrop> faceCrops;
+                    faceCrops.reserve(numberPeople);
                     for (auto person = 0 ; person < numberPeople ; person++)
                     {
                         const auto& faceRectangle = faceRectangles.at(person);
@@ -210,73 +300,128 @@ namespace op
                                   + std::to_string(faceRectangle.height) + ").", __LINE__, __FUNCTION__, __FILE__);
                         // Only consider faces with a minimum pixel area
                         const auto minFaceSize = fastMin(faceRectangle.width, faceRectangle.height);
-                        // // Debugging -> red rectangle
-                        // opLog(std::to_string(cvInputData.cols) + " " + std::to_string(cvInputData.rows));
-                        // cv::rectangle(cvInputDataCopy,
-                        //               cv::Point{(int)faceRectangle.x, (int)faceRectangle.y},
-                        //               cv::Point{(int)faceRectangle.bottomRight().x,
-                        //                         (int)faceRectangle.bottomRight().y},
-                        //               cv::Scalar{0,0,255}, 2);
-                        // Get parts
                         if (minFaceSize > 40)
                         {
-                            // // Debugging -> green rectangle overwriting red one
-                            // opLog(std::to_string(cvInputData.cols) + " " + std::to_string(cvInputData.rows));
-                            // cv::rectangle(cvInputDataCopy,
-                            //               cv::Point{(int)faceRectangle.x, (int)faceRectangle.y},
-                            //               cv::Point{(int)faceRectangle.bottomRight().x,
-                            //                         (int)faceRectangle.bottomRight().y},
-                            //               cv::Scalar{0,255,0}, 2);
                             // Resize and shift image to face rectangle positions
                             const auto faceSize = fastMax(faceRectangle.width, faceRectangle.height);
-                            const double scaleFace = faceSize / (double)netInputSide;
+                            const auto cropSide = (upImpl->mAdaptiveCropSize
+                                ? getRoiCropSide(faceSize, netInputSide) : netInputSide);
+                            const double scaleFace = faceSize / (double)cropSide;
                             cv::Mat Mscaling = cv::Mat::eye(2, 3, CV_64F);
                             Mscaling.at<double>(0,0) = scaleFace;
                             Mscaling.at<double>(1,1) = scaleFace;
                             Mscaling.at<double>(0,2) = faceRectangle.x;
                             Mscaling.at<double>(1,2) = faceRectangle.y;
+                            faceCrops.emplace_back(FaceCrop{person, cropSide, Mscaling});
+                        }
+                    }
+                    // Adaptive crop size: Sorted by crop side, so each batch has a single one
+                    if (upImpl->mAdaptiveCropSize)
+                        std::stable_sort(faceCrops.begin(), faceCrops.end(),
+                                         [](const FaceCrop& a, const FaceCrop& b) { return a.cropSide < b.cropSide; });
 
-                            cv::Mat faceImage;
-                            cv::warpAffine(cvInputData, faceImage, Mscaling,
-                                           cv::Size{mNetOutputSize.x, mNetOutputSize.y},
-                                           CV_INTER_LINEAR | CV_WARP_INVERSE_MAP,
-                                           cv::BORDER_CONSTANT, cv::Scalar(0,0,0));
-
-                            // cv::Mat -> float*
-                            uCharCvMatToFloatPtr(mFaceImageCrop.getPtr(), OP_CV2OPMAT(faceImage), true);
-
-                            // // Debugging
-                            // if (person < 5)
-                            // cv::imshow("faceImage" + std::to_string(person), faceImage);
-
-                            // 1. Caffe deep network
-                            upImpl->spNetCaffe->forwardPass(mFaceImageCrop);
-
-                            // Reshape blobs
-                            if (!upImpl->netInitialized)
+                    // Extract face keypoints, FACE_MAX_BATCH_SIZE faces per network forward pass
+                    const auto numberFaces = (int)faceCrops.size();
+                    // CUDA: The frame is uploaded once, and all the crops are warped from it on the GPU
+                    #ifdef USE_CUDA
+                        const auto useGpuCrops = (numberFaces > 0 && cvInputData.type() == CV_8UC3);
+                        if (useGpuCrops)
+                        {
+                            const auto frameBytes = 3ull * cvInputData.cols * cvInputData.rows;
+                            if (upImpl->mFrameGpuBytes < frameBytes)
                             {
-                                upImpl->netInitialized = true;
-                                reshapeFaceExtractorCaffe(
-                                    upImpl->spResizeAndMergeCaffe, upImpl->spMaximumCaffe,
-                                    upImpl->spCaffeNetOutputBlob, upImpl->spHeatMapsBlob,
-                                    upImpl->spPeaksBlob, upImpl->mGpuId);
+                                cudaPoolFree(upImpl->pFrameGpuPtr);
+                                upImpl->pFrameGpuPtr = (unsigned char*)cudaPoolMalloc(frameBytes);
+                                upImpl->mFrameGpuBytes = frameBytes;
                             }
+                            cudaMemcpy2D(upImpl->pFrameGpuPtr, 3 * cvInputData.cols, cvInputData.data,
+                                         cvInputData.step, 3 * cvInputData.cols, cvInputData.rows,
+                                         cudaMemcpyHostToDevice);
+                            AllocationTracker::recordCopy(frameBytes, MemoryCopy::HostToDevice);
+                        }
+                    #else
+                        const auto useGpuCrops = false;
+                    #endif
+                    auto batchSize = 0;
+                    for (auto batchBegin = 0 ; batchBegin < numberFaces ; batchBegin += batchSize)
+                    {
+                        const auto cropSide = faceCrops[batchBegin].cropSide;
+                        batchSize = 1;
+                        while (batchSize < FACE_MAX_BATCH_SIZE && batchBegin + batchSize < numberFaces
+                               && faceCrops[batchBegin + batchSize].cropSide == cropSide)
+                            batchSize++;
+                        // 1. Face crops + Caffe deep network
+                        // GPU: Warped from the uploaded frame straight into the network input
+                        if (useGpuCrops)
+                        {
+                            #ifdef USE_CUDA
+                                std::vector<std::array<float, 6>> affineMatrices(batchSize);
+                                for (auto face = 0 ; face < batchSize ; face++)
+                                {
+                                    const auto& Mscaling = faceCrops[batchBegin+face].Mscaling;
+                                    for (auto i = 0 ; i < 6 ; i++)
+                                        affineMatrices[face][i] = float(Mscaling.at<double>(i/3, i%3));
+                                }
+                                auto* netInputGpuPtr = upImpl->spNetCaffe->getInputGpuPtr(
+                                    {batchSize, 3, cropSide, cropSide});
+                                warpAffineCropsGpu(
+                                    netInputGpuPtr, upImpl->pFrameGpuPtr, cvInputData.cols, cvInputData.rows,
+                                    affineMatrices, cropSide, cropSide, 1);
+                                upImpl->spNetCaffe->forwardPassOnGpuInput();
+                            #endif
+                        }
+                        // CPU: cv::Mat -> float*, each crop in its own element of the batch
+                        else
+                        {
+                            if (mFaceImageCrop.getSize(0) != batchSize || mFaceImageCrop.getSize(2) != cropSide)
+                                mFaceImageCrop.reset({batchSize, 3, cropSide, cropSide});
+                            const auto cropVolume = mFaceImageCrop.getVolume(1, 3);
+                            parallelFor(0, batchSize, [&](const int face)
+                            {
+                                cv::Mat faceImage;
+                                cv::warpAffine(cvInputData, faceImage, faceCrops[batchBegin+face].Mscaling,
+                                               cv::Size{cropSide, cropSide},
+                                               CV_INTER_LINEAR | CV_WARP_INVERSE_MAP,
+                                               cv::BORDER_CONSTANT, cv::Scalar(0,0,0));
+                                uCharCvMatToFloatPtr(
+                                    mFaceImageCrop.getPtr() + face*cropVolume, OP_CV2OPMAT(faceImage), true);
+                            });
+                            upImpl->spNetCaffe->forwardPass(mFaceImageCrop);
+                        }
 
-                            // 2. Resize heat maps + merge different scales
-                            upImpl->spResizeAndMergeCaffe->Forward(
-                                {upImpl->spCaffeNetOutputBlob.get()}, {upImpl->spHeatMapsBlob.get()});
+                        // Reshape blobs (whenever the batch size or the crop side changes)
+                        if (upImpl->mReshapedBatchSize != batchSize || upImpl->mReshapedCropSide != cropSide)
+                        {
+                            upImpl->mReshapedBatchSize = batchSize;
+                            upImpl->mReshapedCropSide = cropSide;
+                            reshapeFaceExtractorCaffe(
+                                upImpl->spResizeAndMergeCaffe, upImpl->spMaximumCaffe,
+                                upImpl->spCaffeNetOutputBlob, upImpl->spHeatMapsBlob,
+                                upImpl->spPeaksBlob, upImpl->mGpuId);
+                        }
 
-                            // 3. Get peaks by Non-Maximum Suppression
-                            upImpl->spMaximumCaffe->Forward(
-                                {upImpl->spHeatMapsBlob.get()}, {upImpl->spPeaksBlob.get()});
+                        // 2. Resize heat maps (each face independently)
+                        upImpl->spResizeAndMergeCaffe->Forward(
+                            {upImpl->spCaffeNetOutputBlob.get()}, {upImpl->spHeatMapsBlob.get()});
 
-                            const auto* facePeaksPtr = upImpl->spPeaksBlob->mutable_cpu_data();
+                        // 3. Get peaks by Non-Maximum Suppression
+                        upImpl->spMaximumCaffe->Forward(
+                            {upImpl->spHeatMapsBlob.get()}, {upImpl->spPeaksBlob.get()});
+
+                        const auto* facePeaksPtr = upImpl->spPeaksBlob->mutable_cpu_data();
+                        const auto peaksVolume = upImpl->spPeaksBlob->count(1);
+                        const auto heatMapsVolume = upImpl->spHeatMapsBlob->count(1);
+                        for (auto face = 0 ; face < batchSize ; face++)
+                        {
+                            const auto person = faceCrops[batchBegin+face].person;
+                            const auto& Mscaling = faceCrops[batchBegin+face].Mscaling;
+                            const auto* personPeaksPtr = facePeaksPtr + face*peaksVolume;
                             for (auto part = 0 ; part < mFaceKeypoints.getSize(1) ; part++)
                             {
                                 const auto xyIndex = part * mFaceKeypoints.getSize(2);
-                                const auto x = facePeaksPtr[xyIndex];
-                                const auto y = facePeaksPtr[xyIndex + 1];
-                                const auto score = facePeaksPtr[xyIndex + 2];
+                                const auto x = personPeaksPtr[xyIndex];
+                                const auto y = personPeaksPtr[xyIndex + 1];
+                                const auto score = personPeaksPtr[xyIndex + 2];
                                 const auto baseIndex = mFaceKeypoints.getSize(2)
                                                      * (part + person * mFaceKeypoints.getSize(1));
                                 mFaceKeypoints[baseIndex] = float(
@@ -293,16 +438,14 @@ namespace op
                                 updateFaceHeatMapsForPerson(
                                     mHeatMaps, person, mHeatMapScaleMode,
                                     #ifdef USE_CUDA
-                                        upImpl->spHeatMapsBlob->gpu_data()
+                                        upImpl->spHeatMapsBlob->gpu_data() + face*heatMapsVolume
                                     #else
-                                        upImpl->spHeatMapsBlob->cpu_data()
+                                        upImpl->spHeatMapsBlob->cpu_data() + face*heatMapsVolume
                                     #endif
                                 );
                             }
                         }
                     }
-                    // // Debugging
-                    // cv::imshow("AcvInputDataCopy", cvInputDataCopy);
                 }
                 else
                     mFaceKeypoints.reset();
@@ -313,7 +456,7 @@ namespace op
                 #endif
             #else
                 UNUSED(faceRectangles);
-                UNUSED(cvInputData);
+                UNUSED(inputData);
             #endif
         }
         catch (const std::exception& e)
@@ -321,4 +464,25 @@ namespace op
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
         }
     }
+
+    GpuMemoryFootprint FaceExtractorCaffe::getGpuMemoryFootprint(
+        const Point<int>& netInputSize, const std::string& modelFolder, const Point<int>& inputSize)
+    {
+        try
+        {
+            // Network blobs per network input pixel (approximated from the channels and strides of its layers),
+            // network input (3 float channels) and heat maps
+            const auto bytesPerPixel = 1400ull + 4ull * (3ull + FACE_NUMBER_PARTS + 1ull);
+            const auto netBytes = FACE_MAX_BATCH_SIZE * bytesPerPixel * (unsigned long long)netInputSize.area();
+            // Weights (as they are in the caffemodel), cuDNN workspaces and input frame (BGR)
+            const auto weightBytes = getModelFileBytes(modelFolder + FACE_TRAINED_MODEL, 150ull << 20);
+            return GpuMemoryFootprint{
+                "FaceExtractorCaffe", weightBytes + (50ull << 20) + netBytes + 3ull * inputSize.area(), 0ull};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return GpuMemoryFootprint{};
+        }
+    }
 }
@@ -0,0 +1,108 @@
+#include <openpose_private/filestream/asyncFileWriter.hpp>
+#include <fstream> // std::ofstream
+#include <openpose/utilities/fastMath.hpp>
+
+namespace op
+{
+    AsyncFileWriter::AsyncFileWriter(const unsigned long long maxQueueSize) :
+        mMaxQueueSize{fastMax(1ull, maxQueueSize)},
+        mStop{false},
+        mThread{&AsyncFileWriter::threadFunction, this}
+    {
+    }
+
+    AsyncFileWriter::~AsyncFileWriter()
+    {
+        try
+        {
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                mStop = true;
+            }
+            mConditionVariable.notify_all();
+            if (mThread.joinable())
+                mThread.join();
+            if (!mErrorMessage.empty())
+                error(mErrorMessage, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::string AsyncFileWriter::getBuffer()
+    {
+        try
+        {
+            std::string buffer;
+            const std::lock_guard<std::mutex> lock{mMutex};
+            if (!mFreeBuffers.empty())
+            {
+                std::swap(buffer, mFreeBuffers.back());
+                mFreeBuffers.pop_back();
+                buffer.clear();
+            }
+            return buffer;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    void AsyncFileWriter::write(const std::string& filePath, std::string&& content)
+    {
+        try
+        {
+            {
+                std::unique_lock<std::mutex> lock{mMutex};
+                mConditionVariable.wait(lock, [this]{ return mQueue.size() < mMaxQueueSize; });
+                if (!mErrorMessage.empty())
+                {
+                    const auto errorMessage = mErrorMessage;
+                    mErrorMessage.clear();
+                    error(errorMessage, __LINE__, __FUNCTION__, __FILE__);
+                }
+                mQueue.emplace_back(filePath, std::move(content));
+            }
+            mConditionVariable.notify_all();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void AsyncFileWriter::threadFunction()
+    {
+        while (true)
+        {
+            std::pair<std::string, std::string> file;
+            {
+                std::unique_lock<std::mutex> lock{mMutex};
+                mConditionVariable.wait(lock, [this]{ return mStop || !mQueue.empty(); });
+                // The pending files are written before stopping
+                if (mQueue.empty())
+                    return;
+                file = std::move(mQueue.front());
+                mQueue.pop_front();
+            }
+            mConditionVariable.notify_all();
+            // Write file
+            std::ofstream ofstream{file.first, std::ios::out | std::ios::binary};
+            if (ofstream.is_open())
+                ofstream.write(file.second.data(), file.second.size());
+            const auto failed = (!ofstream.is_open() || !ofstream.good());
+            // Recycle the content memory
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                if (failed && mErrorMessage.empty())
+                    mErrorMessage = "File " + file.first + " could not be written.";
+                if (mFreeBuffers.size() < mMaxQueueSize)
+                    mFreeBuffers.emplace_back(std::move(file.second));
+            }
+        }
+    }
+}
@@ -1,40 +1,76 @@
 #ifdef USE_3D_ADAM_MODEL
 #include <openpose/filestream/bvhSaver.hpp>
 #ifdef USE_3D_ADAM_MODEL
+    #include <condition_variable>
+    #include <cstdio> // std::remove
+    #include <deque>
+    #include <fstream>
+    #include <mutex>
+    #include <sstream>
+    #include <thread>
     #include <adam/BVHWriter.h>
+    #include <openpose/utilities/fastMath.hpp>
 #endif
 
 namespace op
 {
+    #ifdef USE_3D_ADAM_MODEL
+        // Width of the frame count, so it can be overwritten in place after each chunk
+        const auto BVH_FRAMES_WIDTH = 12u;
+        // Chunks waiting to be written (once full, updateBvh() waits for the writing thread)
+        const auto BVH_MAX_PENDING_CHUNKS = 2u;
+
+        struct BvhChunk
+        {
+            std::vector<Eigen::Matrix<double, 3, 1>> translations;
+            std::vector<Eigen::Matrix<double, TotalModel::NUM_JOINTS, 3, Eigen::RowMajor>> poses;
+        };
+    #endif
+
     struct BvhSaver::ImplBvhSaver
     {
         #ifdef USE_3D_ADAM_MODEL
             // Write BVH file
             const std::string mBvhFilePath;
             const double mFps;
-            std::unique_ptr<BVHWriter> spBvhWriter;
-            // Record the translation across frames
-            std::vector<Eigen::Matrix<double, 3, 1>> mTranslations;
-            // Record the pose change
-            std::vector<Eigen::Matrix<double, TotalModel::NUM_JOINTS, 3, Eigen::RowMajor>> mPoses;
+            const unsigned long long mChunkFrames;
+            // Frames of the current chunk (translation and pose change)
+            BvhChunk mChunk;
             Eigen::Matrix<double, Eigen::Dynamic, 1> mJ0VecFrame0;
             bool mInitialized;
 
             // Shared parameters
             const std::shared_ptr<const TotalModel> spTotalModel;
 
+            // Writing thread
+            std::mutex mMutex;
+            std::condition_variable mConditionVariable;
+            std::deque<BvhChunk> mPendingChunks;
+            std::string mErrorMessage;
+            bool mStop;
+            std::thread mThread;
+            // Only used by the writing thread
+            std::ofstream mOfstream;
+            std::streampos mFramesPosition;
+            unsigned long long mFramesWritten;
+
             ImplBvhSaver(const std::string bvhFilePath, const std::shared_ptr<const TotalModel>& totalModel,
-                         const double fps) :
+                         const double fps, const int chunkFrames) :
                 mBvhFilePath{bvhFilePath},
                 mFps{fps},
+                mChunkFrames{(unsigned long long)fastMax(1, chunkFrames)},
                 mInitialized{false},
-                spTotalModel{totalModel}
+                spTotalModel{totalModel},
+                mStop{false},
+                mFramesWritten{0ull}
             {
                 try
                 {
                     // Sanity check
                     if (!mBvhFilePath.empty() && spTotalModel == nullptr)
                         error("Given totalModel is a nullptr.", __LINE__, __FUNCTION__, __FILE__);
+                    if (!mBvhFilePath.empty())
+                        mThread = std::thread{&ImplBvhSaver::threadFunction, this};
                 }
                 catch (const std::exception& e)
                 {
@@ -42,17 +78,56 @@ namespace op
                 }
             }
 
-            void writeBvhOnDisk()
+            // It queues the current chunk for the writing thread
+            void sendChunk()
             {
                 try
                 {
-                    if (!mBvhFilePath.empty())
+                    if (mChunk.poses.empty())
+                        return;
+                    {
+                        std::unique_lock<std::mutex> lock{mMutex};
+                        mConditionVariable.wait(
+                            lock, [this]{ return mPendingChunks.size() < BVH_MAX_PENDING_CHUNKS
+                                                 || !mErrorMessage.empty(); });
+                        if (!mErrorMessage.empty())
+                            error(mErrorMessage, __LINE__, __FUNCTION__, __FILE__);
+                        mPendingChunks.emplace_back(std::move(mChunk));
+                    }
+                    mConditionVariable.notify_all();
+                    mChunk = BvhChunk{};
+                    mChunk.translations.reserve(mChunkFrames);
+                    mChunk.poses.reserve(mChunkFrames);
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            // It writes the pending chunks and waits for them
+            void close()
+            {
+                try
+                {
+                    if (mThread.joinable())
                     {
-                        const auto secondsPerFrame = 1./mFps;
-                        const bool unityCompatible = true;
-                        spBvhWriter.reset(new BVHWriter{spTotalModel->m_parent, unityCompatible});
-                        spBvhWriter->parseInput(mJ0VecFrame0, mTranslations, mPoses);
-                        spBvhWriter->writeBVH(mBvhFilePath, secondsPerFrame);
+                        // If it fails, mErrorMessage is reported after joining the thread
+                        try
+                        {
+                            sendChunk();
+                        }
+                        catch (const std::exception&)
+                        {
+                        }
+                        {
+                            const std::lock_guard<std::mutex> lock{mMutex};
+                            mStop = true;
+                        }
+                        mConditionVariable.notify_all();
+                        mThread.join();
+                        if (!mErrorMessage.empty())
+                            error(mErrorMessage, __LINE__, __FUNCTION__, __FILE__);
                     }
                 }
                 catch (const std::exception& e)
@@ -60,12 +135,114 @@ namespace op
                     error(e.what(), __LINE__, __FUNCTION__, __FILE__);
                 }
             }
+
+            void threadFunction()
+            {
+                while (true)
+                {
+                    BvhChunk chunk;
+                    {
+                        std::unique_lock<std::mutex> lock{mMutex};
+                        mConditionVariable.wait(lock, [this]{ return mStop || !mPendingChunks.empty(); });
+                        // The pending chunks are written before stopping
+                        if (mPendingChunks.empty())
+                            return;
+                        chunk = std::move(mPendingChunks.front());
+                        mPendingChunks.pop_front();
+                    }
+                    mConditionVariable.notify_all();
+                    try
+                    {
+                        writeChunk(chunk);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        {
+                            const std::lock_guard<std::mutex> lock{mMutex};
+                            mErrorMessage = e.what();
+                            mPendingChunks.clear();
+                        }
+                        mConditionVariable.notify_all();
+                        return;
+                    }
+                }
+            }
+
+            std::string getFramesLine() const
+            {
+                auto framesLine = "Frames: " + std::to_string(mFramesWritten);
+                framesLine.resize(8 + BVH_FRAMES_WIDTH, ' ');
+                return framesLine;
+            }
+
+            // The BVHWriter of the chunk alone (with the rest joints of frame 0, so it has the same hierarchy) is
+            // written into a temporary file, and only its motion lines are appended to the BVH file. The first chunk
+            // also writes the hierarchy, and the frame count is updated after each chunk, so the file is valid (up to
+            // the last chunk written) even if OpenPose does not finish properly.
+            void writeChunk(BvhChunk& chunk)
+            {
+                // BVH of the chunk
+                const auto chunkFilePath = mBvhFilePath + ".chunk";
+                const auto secondsPerFrame = 1./mFps;
+                const bool unityCompatible = true;
+                {
+                    BVHWriter bvhWriter{spTotalModel->m_parent, unityCompatible};
+                    bvhWriter.parseInput(mJ0VecFrame0, chunk.translations, chunk.poses);
+                    bvhWriter.writeBVH(chunkFilePath, secondsPerFrame);
+                }
+                std::string chunkBvh;
+                {
+                    std::ifstream chunkIfstream{chunkFilePath, std::ios::in | std::ios::binary};
+                    if (!chunkIfstream.is_open())
+                        error("File " + chunkFilePath + " could not be read.", __LINE__, __FUNCTION__, __FILE__);
+                    std::stringstream chunkStream;
+                    chunkStream << chunkIfstream.rdbuf();
+                    chunkBvh = chunkStream.str();
+                }
+                std::remove(chunkFilePath.c_str());
+                // "MOTION", "Frames: N" and "Frame Time: T" lines, followed by the N motion lines
+                const auto motionBegin = chunkBvh.find("MOTION");
+                const auto framesBegin = (motionBegin != std::string::npos
+                    ? chunkBvh.find('\n', motionBegin) : std::string::npos);
+                const auto frameTimeBegin = (framesBegin != std::string::npos
+                    ? chunkBvh.find('\n', framesBegin + 1) : std::string::npos);
+                const auto motionLinesBegin = (frameTimeBegin != std::string::npos
+                    ? chunkBvh.find('\n', frameTimeBegin + 1) : std::string::npos);
+                if (motionLinesBegin == std::string::npos)
+                    error("Unexpected BVH format on " + chunkFilePath + ".", __LINE__, __FUNCTION__, __FILE__);
+                // Hierarchy (only once)
+                if (!mOfstream.is_open())
+                {
+                    mOfstream.open(mBvhFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+                    if (!mOfstream.is_open())
+                        error("File " + mBvhFilePath + " could not be opened.", __LINE__, __FUNCTION__, __FILE__);
+                    mOfstream.write(chunkBvh.data(), framesBegin + 1);
+                    mFramesPosition = mOfstream.tellp();
+                    const auto framesLine = getFramesLine();
+                    mOfstream.write(framesLine.data(), framesLine.size());
+                    mOfstream.write(&chunkBvh[frameTimeBegin], motionLinesBegin + 1 - frameTimeBegin);
+                }
+                // Motion lines
+                mOfstream.write(&chunkBvh[motionLinesBegin + 1], chunkBvh.size() - motionLinesBegin - 1);
+                if (chunkBvh.back() != '\n')
+                    mOfstream.put('\n');
+                mFramesWritten += chunk.poses.size();
+                // Frame count
+                const auto endPosition = mOfstream.tellp();
+                mOfstream.seekp(mFramesPosition);
+                const auto framesLine = getFramesLine();
+                mOfstream.write(framesLine.data(), framesLine.size());
+                mOfstream.seekp(endPosition);
+                mOfstream.flush();
+                if (!mOfstream.good())
+                    error("Frames could not be written into " + mBvhFilePath + ".", __LINE__, __FUNCTION__, __FILE__);
+            }
         #endif
     };
 
     BvhSaver::BvhSaver(const std::string bvhFilePath, const std::shared_ptr<const TotalModel>& totalModel,
-                       const double fps) :
-        spImpl{std::make_shared<ImplBvhSaver>(bvhFilePath, totalModel, fps)}
+                       const double fps, const int chunkFrames) :
+        spImpl{std::make_shared<ImplBvhSaver>(bvhFilePath, totalModel, fps, chunkFrames)}
     {
         try
         {
@@ -73,6 +250,7 @@ namespace op
                 UNUSED(bvhFilePath);
                 UNUSED(totalModel);
                 UNUSED(fps);
+                UNUSED(chunkFrames);
                 error("OpenPose CMake must be compiled with the `USE_3D_ADAM_MODEL` flag in order to use the"
                       " Adam visualization renderer. Alternatively, set 2-D/3-D rendering with `--display 2`"
                       " or `--display 3`.", __LINE__, __FUNCTION__, __FILE__);
@@ -89,7 +267,7 @@ namespace op
         try
         {
             #ifdef USE_3D_ADAM_MODEL
-                spImpl->writeBvhOnDisk();
+                spImpl->close();
             #endif
         }
         catch (const std::exception& e)
@@ -110,12 +288,18 @@ namespace op
         {
             #ifdef USE_3D_ADAM_MODEL
                 // BVH-Unity generation
-                spImpl->mPoses.push_back(adamPose);
-                spImpl->mTranslations.push_back(adamTranslation);
-                if (!spImpl->mInitialized)
+                if (!spImpl->mBvhFilePath.empty())
                 {
-                    spImpl->mJ0VecFrame0 = j0Vec;
-                    spImpl->mInitialized = true;
+                    spImpl->mChunk.poses.push_back(adamPose);
+                    spImpl->mChunk.translations.push_back(adamTranslation);
+                    if (!spImpl->mInitialized)
+                    {
+                        spImpl->mJ0VecFrame0 = j0Vec;
+                        spImpl->mInitialized = true;
+                    }
+                    // Full chunk to the writing thread
+                    if (spImpl->mChunk.poses.size() >= spImpl->mChunkFrames)
+                        spImpl->sendChunk();
                 }
             #else
                 UNUSED(adamPose);
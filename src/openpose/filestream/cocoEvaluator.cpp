@@ -0,0 +1,520 @@
+#include <openpose/filestream/cocoEvaluator.hpp>
+#include <algorithm> // std::stable_sort
+#include <cmath> // std::exp
+#include <cstdio> // std::snprintf
+#include <map>
+#include <mutex>
+#include <numeric> // std::iota
+#include <set>
+#include <opencv2/core/core.hpp> // cv::FileStorage
+#include <openpose/utilities/fastMath.hpp>
+
+namespace op
+{
+    const auto COCO_NUMBER_KEYPOINTS = 17;
+    const auto COCO_MAX_DETECTIONS = 20u;
+    const auto COCO_NUMBER_OKS_THRESHOLDS = 10;
+    const auto COCO_NUMBER_RECALL_THRESHOLDS = 101;
+    // Same sigmas than COCOeval (`kpt_oks_sigmas`)
+    const std::array<double, COCO_NUMBER_KEYPOINTS> COCO_SIGMAS{
+        .26, .25, .25, .35, .35, .79, .79, .72, .72, .62, .62, 1.07, 1.07, .87, .87, .89, .89};
+    // All, medium, and large
+    const std::array<std::pair<double, double>, 3> COCO_AREA_RANGES{
+        std::make_pair(0., 1e10), std::make_pair(32.*32., 96.*96.), std::make_pair(96.*96., 1e10)};
+    // np.spacing(1)
+    const auto COCO_EPSILON = 2.220446049250313e-16;
+
+    struct CocoGroundTruth
+    {
+        std::array<float, 3*COCO_NUMBER_KEYPOINTS> keypoints;
+        std::array<float, 4> bbox;
+        double area;
+        bool isCrowd;
+        // iscrowd or num_keypoints == 0
+        bool ignore;
+    };
+
+    struct CocoDetection
+    {
+        std::array<float, 3*COCO_NUMBER_KEYPOINTS> keypoints;
+        float score;
+        // Area of the keypoint bounding box (the -1 of the missing keypoints included, as COCO.loadRes)
+        double area;
+    };
+
+    // Result of COCOeval.evaluateImg() for 1 image and area range
+    struct CocoImageEvaluation
+    {
+        std::vector<float> scores;
+        // [threshold][detection]
+        std::vector<std::vector<char>> matched;
+        std::vector<std::vector<char>> ignored;
+        std::vector<char> groundTruthIgnored;
+    };
+
+    double computeOks(const CocoGroundTruth& groundTruth, const CocoDetection& detection)
+    {
+        const auto& gt = groundTruth.keypoints;
+        const auto& dt = detection.keypoints;
+        auto numberVisible = 0;
+        for (auto part = 0 ; part < COCO_NUMBER_KEYPOINTS ; part++)
+            if (gt[3*part+2] > 0)
+                numberVisible++;
+        // Bounding box (doubled) for the ground truth without visible keypoints
+        const auto& bbox = groundTruth.bbox;
+        const auto x0 = bbox[0] - bbox[2];
+        const auto x1 = bbox[0] + 2*bbox[2];
+        const auto y0 = bbox[1] - bbox[3];
+        const auto y1 = bbox[1] + 2*bbox[3];
+        auto oksSum = 0.;
+        auto numberTerms = 0;
+        for (auto part = 0 ; part < COCO_NUMBER_KEYPOINTS ; part++)
+        {
+            double dx, dy;
+            if (numberVisible > 0)
+            {
+                if (gt[3*part+2] <= 0)
+                    continue;
+                dx = dt[3*part] - gt[3*part];
+                dy = dt[3*part+1] - gt[3*part+1];
+            }
+            else
+            {
+                dx = fastMax(0.f, x0 - dt[3*part]) + fastMax(0.f, dt[3*part] - x1);
+                dy = fastMax(0.f, y0 - dt[3*part+1]) + fastMax(0.f, dt[3*part+1] - y1);
+            }
+            const auto variance = 4. * COCO_SIGMAS[part] * COCO_SIGMAS[part] / 100.;
+            oksSum += std::exp(-(dx*dx + dy*dy) / variance / (groundTruth.area + COCO_EPSILON) / 2.);
+            numberTerms++;
+        }
+        return oksSum / numberTerms;
+    }
+
+    // COCOeval.evaluateImg(), detections already sorted by score and limited to COCO_MAX_DETECTIONS
+    CocoImageEvaluation evaluateImage(
+        const std::vector<CocoGroundTruth>& groundTruths, const std::vector<CocoDetection>& detections,
+        const std::vector<std::vector<double>>& oks, const std::pair<double, double>& areaRange)
+    {
+        CocoImageEvaluation evaluation;
+        // Ground truth sorted with the ignored ones last
+        std::vector<char> groundTruthIgnored(groundTruths.size());
+        for (auto gind = 0u ; gind < groundTruths.size() ; gind++)
+            groundTruthIgnored[gind] = (groundTruths[gind].ignore || groundTruths[gind].area < areaRange.first
+                                        || groundTruths[gind].area > areaRange.second);
+        std::vector<unsigned int> order(groundTruths.size());
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(), [&](const unsigned int a, const unsigned int b)
+                         { return groundTruthIgnored[a] < groundTruthIgnored[b]; });
+        evaluation.groundTruthIgnored.resize(order.size());
+        for (auto gind = 0u ; gind < order.size() ; gind++)
+            evaluation.groundTruthIgnored[gind] = groundTruthIgnored[order[gind]];
+        // Greedy matching for each OKS threshold
+        const auto numberDetections = detections.size();
+        evaluation.scores.resize(numberDetections);
+        for (auto dind = 0u ; dind < numberDetections ; dind++)
+            evaluation.scores[dind] = detections[dind].score;
+        evaluation.matched.assign(COCO_NUMBER_OKS_THRESHOLDS, std::vector<char>(numberDetections, 0));
+        evaluation.ignored.assign(COCO_NUMBER_OKS_THRESHOLDS, std::vector<char>(numberDetections, 0));
+        for (auto tind = 0 ; tind < COCO_NUMBER_OKS_THRESHOLDS ; tind++)
+        {
+            const auto threshold = 0.5 + 0.05 * tind;
+            std::vector<char> groundTruthMatched(order.size(), 0);
+            for (auto dind = 0u ; dind < numberDetections ; dind++)
+            {
+                auto bestOks = fastMin(threshold, 1. - 1e-10);
+                auto match = -1;
+                for (auto gind = 0u ; gind < order.size() ; gind++)
+                {
+                    const auto& groundTruth = groundTruths[order[gind]];
+                    // Already matched (and not crowd)
+                    if (groundTruthMatched[gind] && !groundTruth.isCrowd)
+                        continue;
+                    // Already matched to a non-ignored one, and the rest are ignored
+                    if (match > -1 && !evaluation.groundTruthIgnored[match] && evaluation.groundTruthIgnored[gind])
+                        break;
+                    const auto currentOks = oks[dind][order[gind]];
+                    if (currentOks < bestOks)
+                        continue;
+                    bestOks = currentOks;
+                    match = (int)gind;
+                }
+                if (match == -1)
+                    continue;
+                evaluation.ignored[tind][dind] = evaluation.groundTruthIgnored[match];
+                evaluation.matched[tind][dind] = 1;
+                groundTruthMatched[match] = 1;
+            }
+            // Unmatched detections out of the area range are ignored
+            for (auto dind = 0u ; dind < numberDetections ; dind++)
+                if (!evaluation.matched[tind][dind]
+                    && (detections[dind].area < areaRange.first || detections[dind].area > areaRange.second))
+                    evaluation.ignored[tind][dind] = 1;
+        }
+        return evaluation;
+    }
+
+    std::vector<int> getCocoBodyIndexes(const PoseModel poseModel, const int numberBodyParts)
+    {
+        try
+        {
+            if (numberBodyParts == 23)
+                return std::vector<int>{
+                    0, 14,13,16,15,    4,1,5,2,6,    3,10,7,11, 8,    12, 9};
+            else if (numberBodyParts == 18)
+                return std::vector<int>{
+                    0, 15,14,17,16,    5,2,6,3,7,    4,11,8,12, 9,    13,10};
+            else if (poseModel == PoseModel::BODY_25B || poseModel == PoseModel::BODY_135)
+            {
+                std::vector<int> indexesInCocoOrder(COCO_NUMBER_KEYPOINTS);
+                std::iota(indexesInCocoOrder.begin(), indexesInCocoOrder.end(), 0);
+                return indexesInCocoOrder;
+            }
+            else if (numberBodyParts == 19 || numberBodyParts == 25 || numberBodyParts == 59)
+                return std::vector<int>{
+                    0, 16,15,18,17,    5,2,6,3,7,    4,12,9,13,10,    14,11};
+            // else if (numberBodyParts == 23)
+            //     return std::vector<int>{
+            //         18,21,19,22,20,    4,1,5,2,6,    3,13,8,14, 9,    15,10};
+            return {};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    struct CocoEvaluator::ImplCocoEvaluator
+    {
+        std::map<unsigned long long, std::vector<CocoGroundTruth>> mGroundTruths;
+        std::set<unsigned long long> mImageIds;
+        std::map<unsigned long long, std::vector<CocoDetection>> mDetections;
+        std::mutex mMutex;
+    };
+
+    CocoEvaluator::CocoEvaluator(const std::string& annotationsFilePath) :
+        upImpl{new ImplCocoEvaluator{}}
+    {
+        try
+        {
+            cv::FileStorage fileStorage(annotationsFilePath, cv::FileStorage::READ | cv::FileStorage::FORMAT_JSON);
+            if (!fileStorage.isOpened())
+                error("COCO annotations file " + annotationsFilePath + " could not be opened.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            const auto annotations = fileStorage["annotations"];
+            if (annotations.type() != cv::FileNode::SEQ)
+                error("COCO annotations file " + annotationsFilePath + " has no \"annotations\" array.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            auto numberAnnotations = 0ull;
+            for (auto iterator = annotations.begin() ; iterator != annotations.end() ; ++iterator)
+            {
+                const auto annotation = *iterator;
+                // Only people
+                if ((int)annotation["category_id"] != 1)
+                    continue;
+                const auto keypoints = annotation["keypoints"];
+                const auto bbox = annotation["bbox"];
+                if (keypoints.size() != 3*COCO_NUMBER_KEYPOINTS || bbox.size() != 4)
+                    continue;
+                CocoGroundTruth groundTruth;
+                for (auto i = 0 ; i < 3*COCO_NUMBER_KEYPOINTS ; i++)
+                    groundTruth.keypoints[i] = (float)keypoints[i];
+                for (auto i = 0 ; i < 4 ; i++)
+                    groundTruth.bbox[i] = (float)bbox[i];
+                groundTruth.area = (double)annotation["area"];
+                groundTruth.isCrowd = ((int)annotation["iscrowd"] != 0);
+                groundTruth.ignore = (groundTruth.isCrowd || (int)annotation["num_keypoints"] == 0);
+                const auto imageId = (unsigned long long)(double)annotation["image_id"];
+                upImpl->mGroundTruths[imageId].emplace_back(groundTruth);
+                numberAnnotations++;
+            }
+            opLog("COCO evaluation: " + std::to_string(numberAnnotations) + " person annotations loaded from "
+                  + annotationsFilePath + ".", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    CocoEvaluator::~CocoEvaluator()
+    {
+    }
+
+    void CocoEvaluator::addImage(const unsigned long long imageId)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->mImageIds.emplace(imageId);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void CocoEvaluator::addResult(
+        const unsigned long long imageId, const std::vector<float>& keypoints, const float score)
+    {
+        try
+        {
+            // Sanity check
+            if (keypoints.size() != 3*COCO_NUMBER_KEYPOINTS)
+                error("COCO results must have 17 (x,y,visibility) keypoints.", __LINE__, __FUNCTION__, __FILE__);
+            CocoDetection detection;
+            std::copy(keypoints.begin(), keypoints.end(), detection.keypoints.begin());
+            detection.score = score;
+            auto xMin = keypoints[0];
+            auto xMax = keypoints[0];
+            auto yMin = keypoints[1];
+            auto yMax = keypoints[1];
+            for (auto part = 1 ; part < COCO_NUMBER_KEYPOINTS ; part++)
+            {
+                xMin = fastMin(xMin, keypoints[3*part]);
+                xMax = fastMax(xMax, keypoints[3*part]);
+                yMin = fastMin(yMin, keypoints[3*part+1]);
+                yMax = fastMax(yMax, keypoints[3*part+1]);
+            }
+            detection.area = double(xMax - xMin) * double(yMax - yMin);
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->mImageIds.emplace(imageId);
+            upImpl->mDetections[imageId].emplace_back(detection);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void CocoEvaluator::addResults(
+        const unsigned long long imageId, const Array<float>& poseKeypoints, const Array<float>& poseScores,
+        const PoseModel poseModel)
+    {
+        try
+        {
+            addImage(imageId);
+            const auto numberPeople = (poseKeypoints.empty() ? 0 : poseKeypoints.getSize(0));
+            if (numberPeople == 0)
+                return;
+            // Sanity check
+            if ((size_t)numberPeople != poseScores.getVolume())
+                error("Dimension mismatch between poseKeypoints and poseScores.", __LINE__, __FUNCTION__, __FILE__);
+            const auto numberBodyParts = poseKeypoints.getSize(1);
+            const auto indexesInCocoOrder = getCocoBodyIndexes(poseModel, numberBodyParts);
+            if (indexesInCocoOrder.empty())
+                error("Invalid number of body parts (" + std::to_string(numberBodyParts) + ").",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Same keypoints than CocoJsonSaver (the people without any valid keypoint are not saved)
+            std::vector<float> cocoKeypoints(3*COCO_NUMBER_KEYPOINTS);
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                auto foundAtLeast1Keypoint = false;
+                for (auto part = 0 ; part < COCO_NUMBER_KEYPOINTS ; part++)
+                {
+                    const auto finalIndex = 3*(person*numberBodyParts + indexesInCocoOrder[part]);
+                    const auto validPoint = (poseKeypoints[finalIndex+2] > 0.f);
+                    cocoKeypoints[3*part] = (validPoint ? poseKeypoints[finalIndex] : -1.f);
+                    cocoKeypoints[3*part+1] = (validPoint ? poseKeypoints[finalIndex+1] : -1.f);
+                    cocoKeypoints[3*part+2] = (validPoint ? 1.f : 0.f);
+                    foundAtLeast1Keypoint |= validPoint;
+                }
+                if (foundAtLeast1Keypoint)
+                    addResult(imageId, cocoKeypoints, poseScores[person]);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void CocoEvaluator::clear()
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->mImageIds.clear();
+            upImpl->mDetections.clear();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::array<double, 10> CocoEvaluator::evaluate() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            const std::vector<CocoGroundTruth> noGroundTruths;
+            const std::vector<CocoDetection> noDetections;
+            // precision[area][threshold][recall threshold] and recall[area][threshold] (-1 = no ground truth)
+            std::vector<std::vector<std::vector<double>>> precision(
+                COCO_AREA_RANGES.size(), std::vector<std::vector<double>>(
+                    COCO_NUMBER_OKS_THRESHOLDS, std::vector<double>(COCO_NUMBER_RECALL_THRESHOLDS, -1.)));
+            std::vector<std::vector<double>> recall(
+                COCO_AREA_RANGES.size(), std::vector<double>(COCO_NUMBER_OKS_THRESHOLDS, -1.));
+            // COCOeval.evaluate(): OKS of each image (detections sorted by score)
+            std::vector<const std::vector<CocoGroundTruth>*> imageGroundTruths;
+            std::vector<std::vector<CocoDetection>> imageDetections;
+            std::vector<std::vector<std::vector<double>>> imageOks;
+            for (const auto imageId : upImpl->mImageIds)
+            {
+                const auto groundTruthIterator = upImpl->mGroundTruths.find(imageId);
+                const auto detectionIterator = upImpl->mDetections.find(imageId);
+                const auto& groundTruths = (groundTruthIterator != upImpl->mGroundTruths.end()
+                    ? groundTruthIterator->second : noGroundTruths);
+                auto detections = (detectionIterator != upImpl->mDetections.end()
+                    ? detectionIterator->second : noDetections);
+                if (groundTruths.empty() && detections.empty())
+                    continue;
+                std::stable_sort(detections.begin(), detections.end(),
+                                 [](const CocoDetection& a, const CocoDetection& b) { return a.score > b.score; });
+                if (detections.size() > COCO_MAX_DETECTIONS)
+                    detections.resize(COCO_MAX_DETECTIONS);
+                std::vector<std::vector<double>> oks(detections.size(), std::vector<double>(groundTruths.size()));
+                for (auto dind = 0u ; dind < detections.size() ; dind++)
+                    for (auto gind = 0u ; gind < groundTruths.size() ; gind++)
+                        oks[dind][gind] = computeOks(groundTruths[gind], detections[dind]);
+                imageGroundTruths.emplace_back(&groundTruths);
+                imageDetections.emplace_back(std::move(detections));
+                imageOks.emplace_back(std::move(oks));
+            }
+            // COCOeval.accumulate()
+            for (auto area = 0u ; area < COCO_AREA_RANGES.size() ; area++)
+            {
+                std::vector<CocoImageEvaluation> evaluations;
+                for (auto image = 0u ; image < imageDetections.size() ; image++)
+                    evaluations.emplace_back(evaluateImage(
+                        *imageGroundTruths[image], imageDetections[image], imageOks[image], COCO_AREA_RANGES[area]));
+                // All the detections, sorted by score
+                std::vector<std::pair<unsigned int, unsigned int>> detections;
+                std::vector<float> scores;
+                auto numberGroundTruths = 0ull;
+                for (auto image = 0u ; image < evaluations.size() ; image++)
+                {
+                    for (auto dind = 0u ; dind < evaluations[image].scores.size() ; dind++)
+                    {
+                        detections.emplace_back(std::make_pair(image, dind));
+                        scores.emplace_back(evaluations[image].scores[dind]);
+                    }
+                    for (const auto ignored : evaluations[image].groundTruthIgnored)
+                        if (!ignored)
+                            numberGroundTruths++;
+                }
+                if (numberGroundTruths == 0)
+                    continue;
+                std::vector<unsigned int> order(detections.size());
+                std::iota(order.begin(), order.end(), 0u);
+                std::stable_sort(order.begin(), order.end(), [&](const unsigned int a, const unsigned int b)
+                                 { return scores[a] > scores[b]; });
+                for (auto tind = 0 ; tind < COCO_NUMBER_OKS_THRESHOLDS ; tind++)
+                {
+                    // Cumulative true and false positives
+                    std::vector<double> recalls(order.size());
+                    std::vector<double> precisions(order.size());
+                    auto truePositives = 0.;
+                    auto falsePositives = 0.;
+                    for (auto i = 0u ; i < order.size() ; i++)
+                    {
+                        const auto& detection = detections[order[i]];
+                        const auto& evaluation = evaluations[detection.first];
+                        if (!evaluation.ignored[tind][detection.second])
+                        {
+                            if (evaluation.matched[tind][detection.second])
+                                truePositives++;
+                            else
+                                falsePositives++;
+                        }
+                        recalls[i] = truePositives / numberGroundTruths;
+                        precisions[i] = truePositives / (falsePositives + truePositives + COCO_EPSILON);
+                    }
+                    recall[area][tind] = (order.empty() ? 0. : recalls.back());
+                    // Monotonically decreasing precision
+                    for (auto i = (int)precisions.size() - 1 ; i > 0 ; i--)
+                        if (precisions[i] > precisions[i-1])
+                            precisions[i-1] = precisions[i];
+                    // Precision at each recall threshold (np.searchsorted(side='left'))
+                    for (auto rind = 0 ; rind < COCO_NUMBER_RECALL_THRESHOLDS ; rind++)
+                    {
+                        const auto recallThreshold = rind / 100.;
+                        const auto index = std::lower_bound(recalls.begin(), recalls.end(), recallThreshold)
+                                         - recalls.begin();
+                        precision[area][tind][rind] = (index < (long)precisions.size() ? precisions[index] : 0.);
+                    }
+                }
+            }
+            // COCOeval.summarize()
+            const auto meanValid = [](const std::vector<double>& values)
+            {
+                auto sum = 0.;
+                auto count = 0;
+                for (const auto value : values)
+                {
+                    if (value > -1)
+                    {
+                        sum += value;
+                        count++;
+                    }
+                }
+                return (count > 0 ? sum / count : -1.);
+            };
+            // OKS threshold index: -1 = all
+            const auto averagePrecision = [&](const unsigned int area, const int threshold)
+            {
+                std::vector<double> values;
+                for (auto tind = 0 ; tind < COCO_NUMBER_OKS_THRESHOLDS ; tind++)
+                    if (threshold < 0 || tind == threshold)
+                        values.insert(values.end(), precision[area][tind].begin(), precision[area][tind].end());
+                return meanValid(values);
+            };
+            const auto averageRecall = [&](const unsigned int area, const int threshold)
+            {
+                std::vector<double> values;
+                for (auto tind = 0 ; tind < COCO_NUMBER_OKS_THRESHOLDS ; tind++)
+                    if (threshold < 0 || tind == threshold)
+                        values.emplace_back(recall[area][tind]);
+                return meanValid(values);
+            };
+            return std::array<double, 10>{
+                averagePrecision(0, -1), averagePrecision(0, 0), averagePrecision(0, 5), averagePrecision(1, -1),
+                averagePrecision(2, -1), averageRecall(0, -1), averageRecall(0, 0), averageRecall(0, 5),
+                averageRecall(1, -1), averageRecall(2, -1)};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::array<double, 10>{};
+        }
+    }
+
+    std::string cocoStatsToString(const std::array<double, 10>& stats)
+    {
+        try
+        {
+            const std::array<const char*, 10> ious{
+                "0.50:0.95", "0.50", "0.75", "0.50:0.95", "0.50:0.95",
+                "0.50:0.95", "0.50", "0.75", "0.50:0.95", "0.50:0.95"};
+            const std::array<const char*, 10> areas{
+                "all", "all", "all", "medium", "large", "all", "all", "all", "medium", "large"};
+            std::string text;
+            for (auto i = 0u ; i < stats.size() ; i++)
+            {
+                char line[128];
+                std::snprintf(
+                    line, sizeof(line), " %-18s %s @[ IoU=%-9s | area=%6s | maxDets=%3u ] = %0.3f\n",
+                    (i < 5 ? "Average Precision" : "Average Recall"), (i < 5 ? "(AP)" : "(AR)"), ious[i],
+                    areas[i], COCO_MAX_DETECTIONS, stats[i]);
+                text += line;
+            }
+            return text;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+}
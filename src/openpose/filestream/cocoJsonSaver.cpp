@@ -1,6 +1,9 @@
 #include <openpose/filestream/cocoJsonSaver.hpp>
+#include <cstdio> // std::remove
+#include <fstream>
 #include <numeric> // std::iota
 #include <openpose/pose/poseParametersRender.hpp>
+#include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/fileSystem.hpp>
 #include <openpose/utilities/string.hpp>
 
@@ -25,11 +28,64 @@ namespace op
         }
     }
 
+    struct CocoJsonSaver::CocoJsonShard
+    {
+        // Empty for the final files
+        std::string suffix;
+        std::vector<std::tuple<JsonOfstream, CocoJsonFormat, bool>> jsonOfstreams;
+    };
+
+    // Size of the chunks appended from the shard files into the final ones
+    const auto COCO_JSON_MERGE_CHUNK_SIZE = 4ull << 20;
+
+    void appendShardFile(
+        JsonOfstream& jsonOfstream, bool& firstElementAdded, const std::string& shardFilePath,
+        const bool humanReadable)
+    {
+        try
+        {
+            std::ifstream shardFile{shardFilePath, std::ios::binary | std::ios::ate};
+            if (!shardFile.is_open())
+                error("Shard file " + shardFilePath + " could not be opened.", __LINE__, __FUNCTION__, __FILE__);
+            // The shard is a JSON array ("[" + enter, elements, enter + "]" + enter). Only the elements are copied
+            const auto bracketSize = (humanReadable ? 3ll : 1ll);
+            const auto fileSize = (long long)shardFile.tellg();
+            auto remainingSize = fileSize - 2*bracketSize;
+            if (remainingSize <= 0)
+                return;
+            shardFile.seekg(bracketSize);
+            if (firstElementAdded)
+            {
+                jsonOfstream.comma();
+                jsonOfstream.enter();
+            }
+            else
+                firstElementAdded = true;
+            std::string chunk;
+            while (remainingSize > 0)
+            {
+                chunk.resize((size_t)fastMin(remainingSize, (long long)COCO_JSON_MERGE_CHUNK_SIZE));
+                shardFile.read(&chunk[0], chunk.size());
+                if (!shardFile)
+                    error("Shard file " + shardFilePath + " could not be read.", __LINE__, __FUNCTION__, __FILE__);
+                jsonOfstream.plainText(chunk);
+                remainingSize -= (long long)chunk.size();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     CocoJsonSaver::CocoJsonSaver(const std::string& filePathToSave, const PoseModel poseModel,
                                  const bool humanReadable, const int cocoJsonVariants,
-                                 const CocoJsonFormat cocoJsonFormat, const int cocoJsonVariant) :
+                                 const CocoJsonFormat cocoJsonFormat, const int cocoJsonVariant,
+                                 const std::shared_ptr<CocoEvaluator>& cocoEvaluator) :
         mPoseModel{poseModel},
-        mCocoJsonVariant{cocoJsonVariant}
+        mCocoJsonVariant{cocoJsonVariant},
+        mHumanReadable{humanReadable},
+        spCocoEvaluator{cocoEvaluator}
     {
         try
         {
@@ -40,35 +96,32 @@ namespace op
             if (cocoJsonVariants >= 32)
                 error("Unkown value for cocoJsonFormat (flag `--write_coco_json_variants`).",
                       __LINE__, __FUNCTION__, __FILE__);
-            // Open mJsonOfstreams
+            // File paths
             const auto filePath = getFullFilePathNoExtension(filePathToSave);
             const auto extension = getFileExtension(filePathToSave);
             // Body/cars
             if (cocoJsonVariants % 2 == 1 || cocoJsonVariants < 1)
-                mJsonOfstreams.emplace_back(
-                    std::make_tuple(JsonOfstream{filePathToSave, humanReadable}, cocoJsonFormat, false));
+                mFiles.emplace_back(std::make_pair(filePathToSave, cocoJsonFormat));
             // Foot
             if ((cocoJsonVariants/2) % 2 == 1 || cocoJsonVariants < 1)
-                mJsonOfstreams.emplace_back(
-                    std::make_tuple(JsonOfstream{filePath+"_foot."+extension, humanReadable}, CocoJsonFormat::Foot,
-                        false));
+                mFiles.emplace_back(std::make_pair(filePath+"_foot."+extension, CocoJsonFormat::Foot));
             // Face
             if ((cocoJsonVariants/4) % 2 == 1 || cocoJsonVariants < 1)
-                mJsonOfstreams.emplace_back(
-                    std::make_tuple(JsonOfstream{filePath+"_face."+extension, humanReadable}, CocoJsonFormat::Face,
-                        false));
+                mFiles.emplace_back(std::make_pair(filePath+"_face."+extension, CocoJsonFormat::Face));
             // Hand21
             if ((cocoJsonVariants/8) % 2 == 1 || cocoJsonVariants < 1)
-                mJsonOfstreams.emplace_back(
-                    std::make_tuple(JsonOfstream{filePath+"_hand21."+extension, humanReadable}, CocoJsonFormat::Hand21,
-                        false));
+                mFiles.emplace_back(std::make_pair(filePath+"_hand21."+extension, CocoJsonFormat::Hand21));
             // Hand42
             if ((cocoJsonVariants/16) % 2 == 1 || cocoJsonVariants < 1)
-                mJsonOfstreams.emplace_back(
-                    std::make_tuple(JsonOfstream{filePath+"_hand42."+extension, humanReadable}, CocoJsonFormat::Hand42,
-                        false));
+                mFiles.emplace_back(std::make_pair(filePath+"_hand42."+extension, CocoJsonFormat::Hand42));
+            // Open the final files (shard 0, assigned to the first thread calling record())
+            mShards.emplace_back(
+                std::make_pair(std::thread::id{}, std::unique_ptr<CocoJsonShard>{new CocoJsonShard{}}));
+            for (const auto& file : mFiles)
+                mShards[0].second->jsonOfstreams.emplace_back(
+                    std::make_tuple(JsonOfstream{file.first, humanReadable}, file.second, false));
             // Open array
-            for (auto& jsonOfstream : mJsonOfstreams)
+            for (auto& jsonOfstream : mShards[0].second->jsonOfstreams)
                 std::get<0>(jsonOfstream).arrayOpen();
         }
         catch (const std::exception& e)
@@ -81,8 +134,30 @@ namespace op
     {
         try
         {
-            for (auto& jsonOfstream : mJsonOfstreams)
+            auto& finalJsonOfstreams = mShards[0].second->jsonOfstreams;
+            // Merge the shards into the final files
+            for (auto shard = 1u ; shard < mShards.size() ; shard++)
+            {
+                auto& cocoJsonShard = *mShards[shard].second;
+                // Close them (i.e., write them on disk)
+                for (auto& jsonOfstream : cocoJsonShard.jsonOfstreams)
+                    std::get<0>(jsonOfstream).arrayClose();
+                cocoJsonShard.jsonOfstreams.clear();
+                for (auto file = 0u ; file < mFiles.size() ; file++)
+                {
+                    const auto shardFilePath = mFiles[file].first + cocoJsonShard.suffix;
+                    appendShardFile(
+                        std::get<0>(finalJsonOfstreams[file]), std::get<2>(finalJsonOfstreams[file]), shardFilePath,
+                        mHumanReadable);
+                    if (std::remove(shardFilePath.c_str()) != 0)
+                        opLog("Shard file " + shardFilePath + " could not be removed.", Priority::High);
+                }
+            }
+            for (auto& jsonOfstream : finalJsonOfstreams)
                 std::get<0>(jsonOfstream).arrayClose();
+            // COCO accuracy
+            if (spCocoEvaluator != nullptr)
+                opLog("COCO keypoint evaluation:\n" + cocoStatsToString(spCocoEvaluator->evaluate()), Priority::High);
         }
         catch (const std::exception& e)
         {
@@ -90,6 +165,40 @@ namespace op
         }
     }
 
+    CocoJsonSaver::CocoJsonShard& CocoJsonSaver::getShard()
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mShardsMutex};
+            const auto threadId = std::this_thread::get_id();
+            for (auto& shard : mShards)
+                if (shard.first == threadId)
+                    return *shard.second;
+            // First thread: final files
+            if (mShards[0].first == std::thread::id{})
+            {
+                mShards[0].first = threadId;
+                return *mShards[0].second;
+            }
+            // Other threads: new shard files
+            std::unique_ptr<CocoJsonShard> cocoJsonShard{new CocoJsonShard{}};
+            cocoJsonShard->suffix = ".shard" + std::to_string(mShards.size()) + ".tmp";
+            for (const auto& file : mFiles)
+            {
+                cocoJsonShard->jsonOfstreams.emplace_back(std::make_tuple(
+                    JsonOfstream{file.first + cocoJsonShard->suffix, mHumanReadable}, file.second, false));
+                std::get<0>(cocoJsonShard->jsonOfstreams.back()).arrayOpen();
+            }
+            mShards.emplace_back(std::make_pair(threadId, std::move(cocoJsonShard)));
+            return *mShards.back().second;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return *mShards[0].second;
+        }
+    }
+
     void CocoJsonSaver::record(
         const Array<float>& poseKeypoints, const Array<float>& poseScores, const std::string& imageName,
         const unsigned long long frameNumber)
@@ -101,11 +210,17 @@ namespace op
                 error("Dimension mismatch between poseKeypoints and poseScores.", __LINE__, __FUNCTION__, __FILE__);
             // Fixed variables
             const auto numberPeople = poseKeypoints.getSize(0);
+            // Images without people also count for the COCO accuracy
+            const auto evaluateBody = (spCocoEvaluator != nullptr && !mFiles.empty()
+                                       && mFiles[0].second == CocoJsonFormat::Body);
+            if (evaluateBody)
+                spCocoEvaluator->addImage(getLastNumberWithErrorMessage(imageName, CocoJsonFormat::Body));
             if (numberPeople > 0)
             {
                 const auto numberBodyParts = poseKeypoints.getSize(1);
+                auto& cocoJsonShard = getShard();
                 // Iterate over all JsonOfstreams
-                for (auto& jsonOfstreamAndFormat : mJsonOfstreams)
+                for (auto& jsonOfstreamAndFormat : cocoJsonShard.jsonOfstreams)
                 {
                     auto& jsonOfstream = std::get<0>(jsonOfstreamAndFormat);
                     const auto cocoJsonFormat = std::get<1>(jsonOfstreamAndFormat);
@@ -118,23 +233,7 @@ namespace op
                     {
                         imageId = getLastNumberWithErrorMessage(imageName, CocoJsonFormat::Body);
                         // Body
-                        if (numberBodyParts == 23)
-                            indexesInCocoOrder = std::vector<int>{
-                                0, 14,13,16,15,    4,1,5,2,6,    3,10,7,11, 8,    12, 9};
-                        else if (numberBodyParts == 18)
-                            indexesInCocoOrder = std::vector<int>{
-                                0, 15,14,17,16,    5,2,6,3,7,    4,11,8,12, 9,    13,10};
-                        else if (mPoseModel == PoseModel::BODY_25B || mPoseModel == PoseModel::BODY_135)
-                        {
-                            indexesInCocoOrder = std::vector<int>(17);
-                            std::iota(indexesInCocoOrder.begin(), indexesInCocoOrder.end(), 0);
-                        }
-                        else if (numberBodyParts == 19 || numberBodyParts == 25 || numberBodyParts == 59)
-                            indexesInCocoOrder = std::vector<int>{
-                                0, 16,15,18,17,    5,2,6,3,7,    4,12,9,13,10,    14,11};
-                        // else if (numberBodyParts == 23)
-                        //     indexesInCocoOrder = std::vector<int>{
-                        //         18,21,19,22,20,    4,1,5,2,6,    3,13,8,14, 9,    15,10};
+                        indexesInCocoOrder = getCocoBodyIndexes(mPoseModel, numberBodyParts);
                     }
                     // Foot
                     else if (cocoJsonFormat == CocoJsonFormat::Foot)
@@ -246,13 +345,17 @@ namespace op
                             // keypoints - i.e., poseKeypoints
                             jsonOfstream.key("keypoints");
                             jsonOfstream.arrayOpen();
+                            std::vector<float> cocoKeypoints(3*indexesInCocoOrder.size());
                             for (auto bodyPart = 0u ; bodyPart < indexesInCocoOrder.size() ; bodyPart++)
                             {
                                 const auto finalIndex = 3*(person*numberBodyParts + indexesInCocoOrder.at(bodyPart));
                                 const auto validPoint = (poseKeypoints[finalIndex+2] > 0.f);
-                                jsonOfstream.plainText(validPoint ? poseKeypoints[finalIndex] : -1.f);
+                                cocoKeypoints[3*bodyPart] = (validPoint ? poseKeypoints[finalIndex] : -1.f);
+                                cocoKeypoints[3*bodyPart+1] = (validPoint ? poseKeypoints[finalIndex+1] : -1.f);
+                                cocoKeypoints[3*bodyPart+2] = (validPoint ? 1.f : 0.f);
+                                jsonOfstream.plainText(cocoKeypoints[3*bodyPart]);
                                 jsonOfstream.comma();
-                                jsonOfstream.plainText(validPoint ? poseKeypoints[finalIndex+1] : -1.f);
+                                jsonOfstream.plainText(cocoKeypoints[3*bodyPart+1]);
                                 jsonOfstream.comma();
                                 jsonOfstream.plainText(validPoint ? 1 : 0);
                                 // jsonOfstream.plainText(poseKeypoints[finalIndex+2]); // For debugging
@@ -267,6 +370,10 @@ namespace op
                             jsonOfstream.plainText(poseScores[person]);
 
                             jsonOfstream.objectClose();
+
+                            // COCO accuracy
+                            if (evaluateBody && cocoJsonFormat == CocoJsonFormat::Body)
+                                spCocoEvaluator->addResult(imageId, cocoKeypoints, poseScores[person]);
                         }
                     }
                 }
@@ -0,0 +1,221 @@
+#include <openpose/filestream/datumReceiver.hpp>
+#ifdef _WIN32
+    #include <ws2tcpip.h>
+#else
+    #include <arpa/inet.h> // inet_pton
+    #include <netinet/in.h> // sockaddr_in
+    #include <sys/socket.h>
+#endif
+#include <atomic>
+#include <mutex>
+#include <openpose_private/filestream/datumSocket.hpp>
+
+namespace op
+{
+    // Maximum size of a received frame set (larger ones are considered a corrupted stream)
+    const auto DATUM_RECEIVER_MAX_PAYLOAD_BYTES = 1ull << 32;
+
+    struct DatumReceiver::ImplDatumReceiver
+    {
+        const unsigned int mWindow;
+        std::string mHost;
+        int mPort;
+        // It protects the sockets (the credits are granted from any thread)
+        std::mutex mMutex;
+        DatumSocketType mListenSocket;
+        DatumSocketType mClientSocket;
+        std::atomic<bool> mFinished;
+
+        explicit ImplDatumReceiver(const unsigned int window) :
+            mWindow{window},
+            mPort{0},
+            mListenSocket{INVALID_DATUM_SOCKET},
+            mClientSocket{INVALID_DATUM_SOCKET},
+            mFinished{false}
+        {
+        }
+
+        // Called by the credit lease deleters, so it never throws
+        void grant(const unsigned int numberCredits)
+        {
+            try
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                // A lost connection is noticed by the receiving thread
+                if (mClientSocket != INVALID_DATUM_SOCKET && !mFinished)
+                    sendDatumWireMessage(mClientSocket, DatumWireMessage::Credits, numberCredits);
+            }
+            catch (const std::exception& e)
+            {
+                errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        void finish(const std::string& message)
+        {
+            if (!mFinished.exchange(true))
+                opLog(message, Priority::High);
+        }
+    };
+
+    DatumReceiver::DatumReceiver(const std::string& address, const unsigned int window) :
+        spImpl{std::make_shared<ImplDatumReceiver>(window)}
+    {
+        try
+        {
+            if (window == 0u)
+                error("The DatumReceiver window must be at least 1.", __LINE__, __FUNCTION__, __FILE__);
+            // `[host:]port`
+            const auto colonIndex = address.rfind(':');
+            spImpl->mHost = (colonIndex == std::string::npos ? "0.0.0.0" : address.substr(0, colonIndex));
+            const auto port = (colonIndex == std::string::npos ? address : address.substr(colonIndex + 1));
+            try
+            {
+                spImpl->mPort = std::stoi(port);
+            }
+            catch (const std::exception&)
+            {
+                spImpl->mPort = -1;
+            }
+            if (spImpl->mPort <= 0 || spImpl->mPort > 65535)
+                error("The DatumReceiver address must be `[host:]port` (e.g., `9000` or `127.0.0.1:9000`), not `"
+                      + address + "`.", __LINE__, __FUNCTION__, __FILE__);
+            startDatumSockets();
+            // Bind and listen
+            sockaddr_in socketAddress{};
+            socketAddress.sin_family = AF_INET;
+            socketAddress.sin_port = htons((unsigned short)spImpl->mPort);
+            if (inet_pton(AF_INET, spImpl->mHost.c_str(), &socketAddress.sin_addr) != 1)
+                error("Invalid DatumReceiver host IP address (`" + spImpl->mHost + "`).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            spImpl->mListenSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+            if (spImpl->mListenSocket == INVALID_DATUM_SOCKET)
+                error("DatumReceiver socket could not be created.", __LINE__, __FUNCTION__, __FILE__);
+            const int reuseAddress = 1;
+            setsockopt(spImpl->mListenSocket, SOL_SOCKET, SO_REUSEADDR, (const char*)&reuseAddress,
+                       (int)sizeof(reuseAddress));
+            if (bind(spImpl->mListenSocket, (const sockaddr*)&socketAddress, (int)sizeof(socketAddress)) != 0
+                || listen(spImpl->mListenSocket, 1) != 0)
+            {
+                closeDatumSocket(spImpl->mListenSocket);
+                spImpl->mListenSocket = INVALID_DATUM_SOCKET;
+                error("DatumReceiver could not listen on " + spImpl->mHost + ":" + std::to_string(spImpl->mPort)
+                      + " (is the port already in use?).", __LINE__, __FUNCTION__, __FILE__);
+            }
+            opLog("Waiting for a DatumSender on " + spImpl->mHost + ":" + std::to_string(spImpl->mPort) + "...",
+                  Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    DatumReceiver::~DatumReceiver()
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{spImpl->mMutex};
+            spImpl->mFinished = true;
+            if (spImpl->mClientSocket != INVALID_DATUM_SOCKET)
+                closeDatumSocket(spImpl->mClientSocket);
+            if (spImpl->mListenSocket != INVALID_DATUM_SOCKET)
+                closeDatumSocket(spImpl->mListenSocket);
+            spImpl->mClientSocket = INVALID_DATUM_SOCKET;
+            spImpl->mListenSocket = INVALID_DATUM_SOCKET;
+            stopDatumSockets();
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool DatumReceiver::receive(std::vector<char>& payload, unsigned int& numberDatums, const int timeoutMs)
+    {
+        try
+        {
+            if (spImpl->mFinished)
+                return false;
+            // Sender connection
+            if (spImpl->mClientSocket == INVALID_DATUM_SOCKET)
+            {
+                if (!waitForDatumSocket(spImpl->mListenSocket, timeoutMs))
+                    return false;
+                const auto clientSocket = accept(spImpl->mListenSocket, nullptr, nullptr);
+                if (clientSocket == INVALID_DATUM_SOCKET)
+                    return false;
+                setDatumSocketNoDelay(clientSocket);
+                {
+                    const std::lock_guard<std::mutex> lock{spImpl->mMutex};
+                    spImpl->mClientSocket = clientSocket;
+                }
+                opLog("DatumSender connected to " + spImpl->mHost + ":" + std::to_string(spImpl->mPort) + ".",
+                      Priority::High);
+                // Whole window
+                spImpl->grant(spImpl->mWindow);
+            }
+            // Next message
+            if (!waitForDatumSocket(spImpl->mClientSocket, timeoutMs))
+                return false;
+            DatumWireMessageHeader header;
+            if (!receiveDatumWireMessageHeader(spImpl->mClientSocket, header))
+            {
+                spImpl->finish("The DatumSender closed the connection.");
+                return false;
+            }
+            if (header.message == (uint32_t)DatumWireMessage::End)
+            {
+                spImpl->finish("The DatumSender finished.");
+                return false;
+            }
+            if (header.payloadBytes > DATUM_RECEIVER_MAX_PAYLOAD_BYTES)
+                error("Corrupted Datum stream (a message of " + std::to_string(header.payloadBytes)
+                      + " bytes was received).", __LINE__, __FUNCTION__, __FILE__);
+            payload.resize(header.payloadBytes);
+            if (!payload.empty() && !receiveDatumSocket(spImpl->mClientSocket, payload.data(), payload.size()))
+            {
+                spImpl->finish("The DatumSender closed the connection.");
+                return false;
+            }
+            // Unknown messages are skipped
+            if (header.message != (uint32_t)DatumWireMessage::Datums)
+                return false;
+            numberDatums = header.value;
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    bool DatumReceiver::isFinished() const
+    {
+        try
+        {
+            return spImpl->mFinished;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    std::shared_ptr<void> DatumReceiver::takeCredit()
+    {
+        try
+        {
+            // The lease owns no memory (it points to the shared state), its deleter only grants the credit back
+            const auto spImplCopy = spImpl;
+            return std::shared_ptr<void>{(void*)spImplCopy.get(), [spImplCopy](void*) { spImplCopy->grant(1u); }};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+}
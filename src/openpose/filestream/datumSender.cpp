@@ -0,0 +1,237 @@
+#include <openpose/filestream/datumSender.hpp>
+#ifdef _WIN32
+    #include <ws2tcpip.h>
+#else
+    #include <netdb.h> // getaddrinfo
+    #include <sys/socket.h>
+#endif
+#include <chrono>
+#include <cstring> // std::memset
+#include <thread>
+#include <openpose/filestream/datumSerializer.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose_private/filestream/datumSocket.hpp>
+
+namespace op
+{
+    // Time between connection attempts
+    const auto DATUM_SENDER_RETRY_MS = 250;
+
+    struct DatumSender::ImplDatumSender
+    {
+        const std::string mAddress;
+        std::string mHost;
+        std::string mPort;
+        const double mConnectionTimeoutSeconds;
+        const DatumWireField mDatumWireFields;
+        DatumSerializer mDatumSerializer;
+        DatumSocketType mSocket;
+        bool mFirstAttempt;
+        bool mEnded;
+        std::chrono::steady_clock::time_point mFirstAttemptTime;
+        unsigned long long mCredits;
+        std::vector<char> mPayload;
+
+        ImplDatumSender(
+            const std::string& address, const DatumWireField datumWireFields, const int jpegQuality,
+            const double connectionTimeoutSeconds) :
+            mAddress{address},
+            mConnectionTimeoutSeconds{connectionTimeoutSeconds},
+            mDatumWireFields{datumWireFields},
+            mDatumSerializer{datumWireFields, jpegQuality},
+            mSocket{INVALID_DATUM_SOCKET},
+            mFirstAttempt{true},
+            mEnded{false},
+            mCredits{0ull}
+        {
+        }
+
+        // It returns whether it is connected (otherwise, it waited up to timeoutMs before the next attempt)
+        bool connect(const int timeoutMs)
+        {
+            try
+            {
+                if (mFirstAttempt)
+                {
+                    mFirstAttempt = false;
+                    mFirstAttemptTime = std::chrono::steady_clock::now();
+                    opLog("Connecting to the DatumReceiver at " + mAddress + "...", Priority::High);
+                }
+                addrinfo hints;
+                std::memset(&hints, 0, sizeof(hints));
+                hints.ai_family = AF_UNSPEC;
+                hints.ai_socktype = SOCK_STREAM;
+                hints.ai_protocol = IPPROTO_TCP;
+                addrinfo* addresses = nullptr;
+                if (getaddrinfo(mHost.c_str(), mPort.c_str(), &hints, &addresses) == 0 && addresses != nullptr)
+                {
+                    mSocket = socket(addresses->ai_family, addresses->ai_socktype, addresses->ai_protocol);
+                    if (mSocket != INVALID_DATUM_SOCKET
+                        && ::connect(mSocket, addresses->ai_addr, (int)addresses->ai_addrlen) != 0)
+                    {
+                        closeDatumSocket(mSocket);
+                        mSocket = INVALID_DATUM_SOCKET;
+                    }
+                    freeaddrinfo(addresses);
+                }
+                if (mSocket != INVALID_DATUM_SOCKET)
+                {
+                    setDatumSocketNoDelay(mSocket);
+                    opLog("Connected to the DatumReceiver at " + mAddress + ".", Priority::High);
+                    return true;
+                }
+                // Retry later (the receiver might not be listening yet)
+                const auto secondsWaiting = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - mFirstAttemptTime).count();
+                if (secondsWaiting > mConnectionTimeoutSeconds)
+                    error("Could not connect to the DatumReceiver at " + mAddress + " in "
+                          + std::to_string(mConnectionTimeoutSeconds) + " seconds.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                std::this_thread::sleep_for(std::chrono::milliseconds{fastMin(timeoutMs, DATUM_SENDER_RETRY_MS)});
+                return false;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return false;
+            }
+        }
+
+        // It reads the credits granted by the receiver (if any)
+        void receiveCredits(const int timeoutMs)
+        {
+            try
+            {
+                auto waitMs = timeoutMs;
+                while (waitForDatumSocket(mSocket, waitMs))
+                {
+                    DatumWireMessageHeader header;
+                    if (!receiveDatumWireMessageHeader(mSocket, header))
+                        error("The DatumReceiver at " + mAddress + " closed the connection.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    if (header.message == (uint32_t)DatumWireMessage::Credits)
+                        mCredits += header.value;
+                    // Payloads of unknown messages are skipped
+                    std::vector<char> payload(header.payloadBytes);
+                    if (!payload.empty() && !receiveDatumSocket(mSocket, payload.data(), payload.size()))
+                        error("The DatumReceiver at " + mAddress + " closed the connection.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    // Any other message already received is read without waiting
+                    waitMs = 0;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+    };
+
+    DatumSender::DatumSender(
+        const std::string& address, const DatumWireField datumWireFields, const int jpegQuality,
+        const double connectionTimeoutSeconds) :
+        upImpl{new ImplDatumSender{address, datumWireFields, jpegQuality, connectionTimeoutSeconds}}
+    {
+        try
+        {
+            const auto colonIndex = address.rfind(':');
+            if (colonIndex == std::string::npos || colonIndex == 0 || colonIndex + 1 == address.size())
+                error("The DatumReceiver address must be `host:port` (e.g., `192.168.1.10:9000`), not `" + address
+                      + "`.", __LINE__, __FUNCTION__, __FILE__);
+            upImpl->mHost = address.substr(0, colonIndex);
+            upImpl->mPort = address.substr(colonIndex + 1);
+            startDatumSockets();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    DatumSender::~DatumSender()
+    {
+        try
+        {
+            end();
+            stopDatumSockets();
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool DatumSender::waitForCredit(const int timeoutMs)
+    {
+        try
+        {
+            if (upImpl->mEnded)
+                error("The connection to the DatumReceiver was already ended.", __LINE__, __FUNCTION__, __FILE__);
+            if (upImpl->mSocket == INVALID_DATUM_SOCKET && !upImpl->connect(timeoutMs))
+                return false;
+            // Credits already granted are read right away, so the receiver is not blocked by a full TCP buffer
+            upImpl->receiveCredits(upImpl->mCredits > 0 ? 0 : timeoutMs);
+            return upImpl->mCredits > 0;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void DatumSender::send(const std::vector<const Datum*>& datums)
+    {
+        try
+        {
+            if (upImpl->mCredits == 0)
+                error("No credit left (call waitForCredit() first).", __LINE__, __FUNCTION__, __FILE__);
+            upImpl->mPayload.clear();
+            for (const auto* const datum : datums)
+                upImpl->mDatumSerializer.serialize(upImpl->mPayload, *datum);
+            if (!sendDatumWireMessage(upImpl->mSocket, DatumWireMessage::Datums, (uint32_t)datums.size(),
+                                      upImpl->mPayload))
+                error("The DatumReceiver at " + upImpl->mAddress + " closed the connection.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            upImpl->mCredits--;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void DatumSender::end()
+    {
+        try
+        {
+            if (!upImpl->mEnded)
+            {
+                upImpl->mEnded = true;
+                if (upImpl->mSocket != INVALID_DATUM_SOCKET)
+                {
+                    sendDatumWireMessage(upImpl->mSocket, DatumWireMessage::End, 0u);
+                    closeDatumSocket(upImpl->mSocket);
+                    upImpl->mSocket = INVALID_DATUM_SOCKET;
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    DatumWireField DatumSender::getDatumWireFields() const
+    {
+        try
+        {
+            return upImpl->mDatumWireFields;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return DatumWireField::None;
+        }
+    }
+}
@@ -0,0 +1,431 @@
+#include <openpose/filestream/datumSerializer.hpp>
+#include <cstring> // std::memcpy
+#include <openpose/filestream/datumWireFormat.hpp>
+#include <openpose_private/utilities/openCvMultiversionHeaders.hpp> // cv::imencode, cv::imdecode
+
+namespace op
+{
+    namespace
+    {
+        uint64_t getElementBytes(const DatumWireElement element)
+        {
+            if (element == DatumWireElement::UInt8)
+                return 1u;
+            else if (element == DatumWireElement::Int32 || element == DatumWireElement::Float32)
+                return 4u;
+            else if (element == DatumWireElement::Int64 || element == DatumWireElement::Float64)
+                return 8u;
+            error("Unknown DatumWireElement " + std::to_string((unsigned int)element) + ".",
+                  __LINE__, __FUNCTION__, __FILE__);
+            return 0u;
+        }
+
+        void appendBytes(std::vector<char>& buffer, const void* const dataPtr, const uint64_t bytes)
+        {
+            const auto offset = buffer.size();
+            buffer.resize(offset + datumWirePaddedBytes(bytes), '\0');
+            if (bytes > 0u)
+                std::memcpy(&buffer[offset], dataPtr, bytes);
+        }
+
+        void appendBlock(
+            std::vector<char>& buffer, uint32_t& numberBlocks, const DatumWireBlock block,
+            const DatumWireElement element, const std::vector<int>& sizes, const void* const dataPtr,
+            const uint64_t dataBytes, const uint32_t index = 0u)
+        {
+            if (sizes.size() > DATUM_WIRE_MAX_DIMENSIONS)
+                error("Blocks cannot have more than " + std::to_string(DATUM_WIRE_MAX_DIMENSIONS) + " dimensions ("
+                      + std::to_string(sizes.size()) + " given).", __LINE__, __FUNCTION__, __FILE__);
+            DatumWireBlockHeader blockHeader{};
+            blockHeader.block = (uint32_t)block;
+            blockHeader.element = (uint32_t)element;
+            blockHeader.index = index;
+            blockHeader.numberDimensions = (uint32_t)sizes.size();
+            for (auto dimension = 0u ; dimension < sizes.size() ; dimension++)
+                blockHeader.sizes[dimension] = sizes[dimension];
+            blockHeader.dataBytes = dataBytes;
+            appendBytes(buffer, &blockHeader, sizeof(blockHeader));
+            appendBytes(buffer, dataPtr, dataBytes);
+            numberBlocks++;
+        }
+
+        template<typename T>
+        void appendArray(
+            std::vector<char>& buffer, uint32_t& numberBlocks, const DatumWireBlock block,
+            const DatumWireElement element, const Array<T>& array, const uint32_t index = 0u)
+        {
+            if (!array.empty())
+                appendBlock(buffer, numberBlocks, block, element, array.getSize(), array.getConstPtr(),
+                            array.getVolume() * sizeof(T), index);
+        }
+
+        void appendMatrix(
+            std::vector<char>& buffer, uint32_t& numberBlocks, const DatumWireBlock block, const Matrix& matrix)
+        {
+            if (!matrix.empty())
+            {
+                const cv::Mat cvMat = (matrix.isContinuous()
+                    ? OP_OP2CVCONSTMAT(matrix) : OP_OP2CVCONSTMAT(matrix).clone());
+                DatumWireElement element;
+                if (cvMat.depth() == CV_8U)
+                    element = DatumWireElement::UInt8;
+                else if (cvMat.depth() == CV_32S)
+                    element = DatumWireElement::Int32;
+                else if (cvMat.depth() == CV_32F)
+                    element = DatumWireElement::Float32;
+                else if (cvMat.depth() == CV_64F)
+                    element = DatumWireElement::Float64;
+                else
+                    error("Only 8-bit unsigned, 32-bit integer, float and double matrices can be sent (cv::Mat depth "
+                          + std::to_string(cvMat.depth()) + " given).", __LINE__, __FUNCTION__, __FILE__);
+                appendBlock(buffer, numberBlocks, block, element, {cvMat.rows, cvMat.cols, cvMat.channels()},
+                            cvMat.data, cvMat.total() * cvMat.elemSize());
+            }
+        }
+
+        // It checks that the block has the expected element type and size, and it returns its sizes
+        std::vector<int> getBlockSizes(const DatumWireBlockHeader& blockHeader, const DatumWireElement element)
+        {
+            if (blockHeader.element != (uint32_t)element)
+                error("Block " + std::to_string(blockHeader.block) + " has element type "
+                      + std::to_string(blockHeader.element) + " rather than " + std::to_string((uint32_t)element)
+                      + ".", __LINE__, __FUNCTION__, __FILE__);
+            std::vector<int> sizes(blockHeader.numberDimensions);
+            auto volume = (blockHeader.numberDimensions > 0u ? 1ull : 0ull);
+            for (auto dimension = 0u ; dimension < sizes.size() ; dimension++)
+            {
+                sizes[dimension] = blockHeader.sizes[dimension];
+                if (sizes[dimension] < 0)
+                    error("Negative block size.", __LINE__, __FUNCTION__, __FILE__);
+                volume *= (unsigned long long)sizes[dimension];
+            }
+            if (volume * getElementBytes(element) != blockHeader.dataBytes)
+                error("Block " + std::to_string(blockHeader.block) + " has " + std::to_string(blockHeader.dataBytes)
+                      + " bytes, but its sizes require " + std::to_string(volume * getElementBytes(element)) + ".",
+                      __LINE__, __FUNCTION__, __FILE__);
+            return sizes;
+        }
+
+        template<typename T>
+        void readArray(
+            Array<T>& array, const DatumWireBlockHeader& blockHeader, const char* const blockData,
+            const DatumWireElement element)
+        {
+            array.reset(getBlockSizes(blockHeader, element));
+            if (!array.empty())
+                std::memcpy(array.getPtr(), blockData, blockHeader.dataBytes);
+        }
+
+        void readMatrix(Matrix& matrix, const DatumWireBlockHeader& blockHeader, const char* const blockData)
+        {
+            int depth = CV_8U;
+            if (blockHeader.element == (uint32_t)DatumWireElement::Int32)
+                depth = CV_32S;
+            else if (blockHeader.element == (uint32_t)DatumWireElement::Float32)
+                depth = CV_32F;
+            else if (blockHeader.element == (uint32_t)DatumWireElement::Float64)
+                depth = CV_64F;
+            const auto sizes = getBlockSizes(blockHeader, DatumWireElement(blockHeader.element));
+            if (sizes.size() != 3u)
+                error("Matrix blocks must have 3 dimensions (rows, columns and channels).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            cv::Mat cvMat(sizes[0], sizes[1], CV_MAKETYPE(depth, sizes[2]));
+            if (!cvMat.empty())
+                std::memcpy(cvMat.data, blockData, blockHeader.dataBytes);
+            matrix = OP_CV2OPMAT(cvMat);
+        }
+
+        void readJpeg(Matrix& matrix, const DatumWireBlockHeader& blockHeader, const char* const blockData)
+        {
+            getBlockSizes(blockHeader, DatumWireElement::UInt8);
+            const cv::Mat jpegFile(1, (int)blockHeader.dataBytes, CV_8UC1, (void*)blockData);
+            const cv::Mat cvMat = cv::imdecode(jpegFile, cv::IMREAD_UNCHANGED);
+            if (cvMat.empty())
+                error("A JPEG frame could not be decoded.", __LINE__, __FUNCTION__, __FILE__);
+            matrix = OP_CV2OPMAT(cvMat);
+        }
+    }
+
+    DatumSerializer::DatumSerializer(const DatumWireField datumWireFields, const int jpegQuality) :
+        mDatumWireFields{datumWireFields},
+        mJpegQuality{jpegQuality}
+    {
+        try
+        {
+            if (jpegQuality < 0 || jpegQuality > 100)
+                error("The JPEG quality must be in the range [0, 100] (0 for raw frames), not "
+                      + std::to_string(jpegQuality) + ".", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    DatumSerializer::~DatumSerializer()
+    {
+    }
+
+    void DatumSerializer::serialize(std::vector<char>& buffer, const Datum& datum)
+    {
+        try
+        {
+            // Header (its number of blocks is filled at the end)
+            const auto headerOffset = buffer.size();
+            DatumWireDatumHeader datumHeader{};
+            datumHeader.id = datum.id;
+            datumHeader.subId = datum.subId;
+            datumHeader.subIdMax = datum.subIdMax;
+            datumHeader.frameNumber = datum.frameNumber;
+            datumHeader.sourceId = datum.sourceId;
+            datumHeader.sourceIdMax = datum.sourceIdMax;
+            datumHeader.priority = datum.priority;
+            datumHeader.fields = (uint32_t)mDatumWireFields;
+            datumHeader.nameBytes = (uint32_t)datum.name.size();
+            appendBytes(buffer, &datumHeader, sizeof(datumHeader));
+            appendBytes(buffer, datum.name.data(), datum.name.size());
+            auto& numberBlocks = datumHeader.numberBlocks;
+            // Frames: JPEG (8-bit BGR or grayscale ones, if enabled) or raw
+            const auto appendFrame = [&](const DatumWireBlock rawBlock, const DatumWireBlock jpegBlock,
+                                         const Matrix& frame)
+            {
+                if (mJpegQuality > 0 && !frame.empty() && frame.depth() == CV_8U
+                    && (frame.channels() == 3 || frame.channels() == 1))
+                {
+                    if (!cv::imencode(".jpg", OP_OP2CVCONSTMAT(frame), mJpegBuffer,
+                                      {cv::IMWRITE_JPEG_QUALITY, mJpegQuality}))
+                        error("Frame " + std::to_string(datum.frameNumber) + " could not be JPEG-encoded.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    appendBlock(buffer, numberBlocks, jpegBlock, DatumWireElement::UInt8,
+                                {(int)mJpegBuffer.size()}, mJpegBuffer.data(), mJpegBuffer.size());
+                }
+                else
+                    appendMatrix(buffer, numberBlocks, rawBlock, frame);
+            };
+            if ((mDatumWireFields & DatumWireField::Frame) != DatumWireField::None)
+            {
+                appendFrame(DatumWireBlock::CvInputData, DatumWireBlock::CvInputDataJpeg, datum.cvInputData);
+                appendMatrix(buffer, numberBlocks, DatumWireBlock::CameraMatrix, datum.cameraMatrix);
+                appendMatrix(buffer, numberBlocks, DatumWireBlock::CameraExtrinsics, datum.cameraExtrinsics);
+                appendMatrix(buffer, numberBlocks, DatumWireBlock::CameraIntrinsics, datum.cameraIntrinsics);
+                appendMatrix(buffer, numberBlocks, DatumWireBlock::CameraDistortion, datum.cameraDistortion);
+            }
+            if ((mDatumWireFields & DatumWireField::NetInput) != DatumWireField::None)
+            {
+                for (auto scale = 0u ; scale < datum.inputNetData.size() ; scale++)
+                    appendArray(buffer, numberBlocks, DatumWireBlock::InputNetData, DatumWireElement::Float32,
+                                datum.inputNetData[scale], scale);
+                if (!datum.scaleInputToNetInputs.empty())
+                    appendBlock(buffer, numberBlocks, DatumWireBlock::ScaleInputToNetInputs,
+                                DatumWireElement::Float64, {(int)datum.scaleInputToNetInputs.size()},
+                                datum.scaleInputToNetInputs.data(),
+                                datum.scaleInputToNetInputs.size() * sizeof(double));
+                if (!datum.netInputSizes.empty())
+                {
+                    std::vector<int32_t> netInputSizes;
+                    for (const auto& netInputSize : datum.netInputSizes)
+                    {
+                        netInputSizes.emplace_back(netInputSize.x);
+                        netInputSizes.emplace_back(netInputSize.y);
+                    }
+                    appendBlock(buffer, numberBlocks, DatumWireBlock::NetInputSizes, DatumWireElement::Int32,
+                                {(int)datum.netInputSizes.size(), 2}, netInputSizes.data(),
+                                netInputSizes.size() * sizeof(int32_t));
+                }
+                const double netScales[4]{datum.scaleInputToOutput, datum.scaleNetToOutput,
+                                          (double)datum.netOutputSize.x, (double)datum.netOutputSize.y};
+                appendBlock(buffer, numberBlocks, DatumWireBlock::NetScales, DatumWireElement::Float64, {4},
+                            netScales, sizeof(netScales));
+            }
+            if ((mDatumWireFields & DatumWireField::Keypoints) != DatumWireField::None)
+            {
+                appendArray(buffer, numberBlocks, DatumWireBlock::PoseKeypoints, DatumWireElement::Float32,
+                            datum.poseKeypoints);
+                appendArray(buffer, numberBlocks, DatumWireBlock::PoseIds, DatumWireElement::Int64, datum.poseIds);
+                appendArray(buffer, numberBlocks, DatumWireBlock::PoseScores, DatumWireElement::Float32,
+                            datum.poseScores);
+                if (!datum.faceRectangles.empty())
+                {
+                    std::vector<float> faceRectangles;
+                    for (const auto& rectangle : datum.faceRectangles)
+                        faceRectangles.insert(faceRectangles.end(),
+                                              {rectangle.x, rectangle.y, rectangle.width, rectangle.height});
+                    appendBlock(buffer, numberBlocks, DatumWireBlock::FaceRectangles, DatumWireElement::Float32,
+                                {(int)datum.faceRectangles.size(), 4}, faceRectangles.data(),
+                                faceRectangles.size() * sizeof(float));
+                }
+                appendArray(buffer, numberBlocks, DatumWireBlock::FaceKeypoints, DatumWireElement::Float32,
+                            datum.faceKeypoints);
+                if (!datum.handRectangles.empty())
+                {
+                    std::vector<float> handRectangles;
+                    for (const auto& rectangles : datum.handRectangles)
+                        for (const auto& rectangle : rectangles)
+                            handRectangles.insert(handRectangles.end(),
+                                                  {rectangle.x, rectangle.y, rectangle.width, rectangle.height});
+                    appendBlock(buffer, numberBlocks, DatumWireBlock::HandRectangles, DatumWireElement::Float32,
+                                {(int)datum.handRectangles.size(), 2, 4}, handRectangles.data(),
+                                handRectangles.size() * sizeof(float));
+                }
+                for (auto hand = 0u ; hand < datum.handKeypoints.size() ; hand++)
+                    appendArray(buffer, numberBlocks, DatumWireBlock::HandKeypoints, DatumWireElement::Float32,
+                                datum.handKeypoints[hand], hand);
+            }
+            if ((mDatumWireFields & DatumWireField::Keypoints3D) != DatumWireField::None)
+            {
+                appendArray(buffer, numberBlocks, DatumWireBlock::PoseKeypoints3D, DatumWireElement::Float32,
+                            datum.poseKeypoints3D);
+                appendArray(buffer, numberBlocks, DatumWireBlock::FaceKeypoints3D, DatumWireElement::Float32,
+                            datum.faceKeypoints3D);
+                for (auto hand = 0u ; hand < datum.handKeypoints3D.size() ; hand++)
+                    appendArray(buffer, numberBlocks, DatumWireBlock::HandKeypoints3D, DatumWireElement::Float32,
+                                datum.handKeypoints3D[hand], hand);
+            }
+            if ((mDatumWireFields & DatumWireField::OutputFrame) != DatumWireField::None)
+                appendFrame(DatumWireBlock::CvOutputData, DatumWireBlock::CvOutputDataJpeg, datum.cvOutputData);
+            std::memcpy(&buffer[headerOffset], &datumHeader, sizeof(datumHeader));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned long long DatumSerializer::deserialize(
+        Datum& datum, const char* const data, const unsigned long long maxBytes)
+    {
+        try
+        {
+            // Header and name
+            DatumWireDatumHeader datumHeader;
+            if (maxBytes < sizeof(datumHeader))
+                error("Truncated Datum header.", __LINE__, __FUNCTION__, __FILE__);
+            std::memcpy(&datumHeader, data, sizeof(datumHeader));
+            auto offset = (unsigned long long)sizeof(datumHeader);
+            if (maxBytes - offset < datumWirePaddedBytes(datumHeader.nameBytes))
+                error("Truncated Datum name.", __LINE__, __FUNCTION__, __FILE__);
+            datum.id = datumHeader.id;
+            datum.subId = datumHeader.subId;
+            datum.subIdMax = datumHeader.subIdMax;
+            datum.frameNumber = datumHeader.frameNumber;
+            datum.sourceId = datumHeader.sourceId;
+            datum.sourceIdMax = datumHeader.sourceIdMax;
+            datum.priority = datumHeader.priority;
+            datum.name.assign(data + offset, datumHeader.nameBytes);
+            offset += datumWirePaddedBytes(datumHeader.nameBytes);
+            // Blocks
+            for (auto blockIndex = 0u ; blockIndex < datumHeader.numberBlocks ; blockIndex++)
+            {
+                DatumWireBlockHeader blockHeader;
+                if (maxBytes - offset < sizeof(blockHeader))
+                    error("Truncated block header.", __LINE__, __FUNCTION__, __FILE__);
+                std::memcpy(&blockHeader, data + offset, sizeof(blockHeader));
+                offset += sizeof(blockHeader);
+                if (blockHeader.numberDimensions > DATUM_WIRE_MAX_DIMENSIONS
+                    || maxBytes - offset < datumWirePaddedBytes(blockHeader.dataBytes))
+                    error("Truncated or invalid block " + std::to_string(blockHeader.block) + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+                const auto* const blockData = data + offset;
+                offset += datumWirePaddedBytes(blockHeader.dataBytes);
+                const auto block = DatumWireBlock(blockHeader.block);
+                if (block == DatumWireBlock::CvInputData)
+                    readMatrix(datum.cvInputData, blockHeader, blockData);
+                else if (block == DatumWireBlock::CvInputDataJpeg)
+                    readJpeg(datum.cvInputData, blockHeader, blockData);
+                else if (block == DatumWireBlock::CameraMatrix)
+                    readMatrix(datum.cameraMatrix, blockHeader, blockData);
+                else if (block == DatumWireBlock::CameraExtrinsics)
+                    readMatrix(datum.cameraExtrinsics, blockHeader, blockData);
+                else if (block == DatumWireBlock::CameraIntrinsics)
+                    readMatrix(datum.cameraIntrinsics, blockHeader, blockData);
+                else if (block == DatumWireBlock::CameraDistortion)
+                    readMatrix(datum.cameraDistortion, blockHeader, blockData);
+                else if (block == DatumWireBlock::InputNetData)
+                {
+                    if (datum.inputNetData.size() <= blockHeader.index)
+                        datum.inputNetData.resize(blockHeader.index + 1u);
+                    readArray(datum.inputNetData[blockHeader.index], blockHeader, blockData,
+                              DatumWireElement::Float32);
+                }
+                else if (block == DatumWireBlock::ScaleInputToNetInputs)
+                {
+                    getBlockSizes(blockHeader, DatumWireElement::Float64);
+                    datum.scaleInputToNetInputs.resize(blockHeader.dataBytes / sizeof(double));
+                    std::memcpy(datum.scaleInputToNetInputs.data(), blockData, blockHeader.dataBytes);
+                }
+                else if (block == DatumWireBlock::NetInputSizes)
+                {
+                    getBlockSizes(blockHeader, DatumWireElement::Int32);
+                    std::vector<int32_t> netInputSizes(blockHeader.dataBytes / sizeof(int32_t));
+                    std::memcpy(netInputSizes.data(), blockData, blockHeader.dataBytes);
+                    datum.netInputSizes.clear();
+                    for (auto i = 0u ; i + 1u < netInputSizes.size() ; i += 2u)
+                        datum.netInputSizes.emplace_back(Point<int>{netInputSizes[i], netInputSizes[i+1]});
+                }
+                else if (block == DatumWireBlock::NetScales)
+                {
+                    getBlockSizes(blockHeader, DatumWireElement::Float64);
+                    if (blockHeader.dataBytes != 4u * sizeof(double))
+                        error("Invalid NetScales block.", __LINE__, __FUNCTION__, __FILE__);
+                    double netScales[4];
+                    std::memcpy(netScales, blockData, sizeof(netScales));
+                    datum.scaleInputToOutput = netScales[0];
+                    datum.scaleNetToOutput = netScales[1];
+                    datum.netOutputSize = Point<int>{(int)netScales[2], (int)netScales[3]};
+                }
+                else if (block == DatumWireBlock::PoseKeypoints)
+                    readArray(datum.poseKeypoints, blockHeader, blockData, DatumWireElement::Float32);
+                else if (block == DatumWireBlock::PoseIds)
+                    readArray(datum.poseIds, blockHeader, blockData, DatumWireElement::Int64);
+                else if (block == DatumWireBlock::PoseScores)
+                    readArray(datum.poseScores, blockHeader, blockData, DatumWireElement::Float32);
+                else if (block == DatumWireBlock::FaceRectangles)
+                {
+                    getBlockSizes(blockHeader, DatumWireElement::Float32);
+                    std::vector<float> faceRectangles(blockHeader.dataBytes / sizeof(float));
+                    std::memcpy(faceRectangles.data(), blockData, blockHeader.dataBytes);
+                    datum.faceRectangles.clear();
+                    for (auto i = 0u ; i + 3u < faceRectangles.size() ; i += 4u)
+                        datum.faceRectangles.emplace_back(Rectangle<float>{
+                            faceRectangles[i], faceRectangles[i+1], faceRectangles[i+2], faceRectangles[i+3]});
+                }
+                else if (block == DatumWireBlock::FaceKeypoints)
+                    readArray(datum.faceKeypoints, blockHeader, blockData, DatumWireElement::Float32);
+                else if (block == DatumWireBlock::HandRectangles)
+                {
+                    getBlockSizes(blockHeader, DatumWireElement::Float32);
+                    std::vector<float> handRectangles(blockHeader.dataBytes / sizeof(float));
+                    std::memcpy(handRectangles.data(), blockData, blockHeader.dataBytes);
+                    datum.handRectangles.clear();
+                    for (auto i = 0u ; i + 7u < handRectangles.size() ; i += 8u)
+                        datum.handRectangles.emplace_back(std::array<Rectangle<float>, 2>{
+                            Rectangle<float>{handRectangles[i], handRectangles[i+1], handRectangles[i+2],
+                                             handRectangles[i+3]},
+                            Rectangle<float>{handRectangles[i+4], handRectangles[i+5], handRectangles[i+6],
+                                             handRectangles[i+7]}});
+                }
+                else if (block == DatumWireBlock::HandKeypoints && blockHeader.index < 2u)
+                    readArray(datum.handKeypoints[blockHeader.index], blockHeader, blockData,
+                              DatumWireElement::Float32);
+                else if (block == DatumWireBlock::PoseKeypoints3D)
+                    readArray(datum.poseKeypoints3D, blockHeader, blockData, DatumWireElement::Float32);
+                else if (block == DatumWireBlock::FaceKeypoints3D)
+                    readArray(datum.faceKeypoints3D, blockHeader, blockData, DatumWireElement::Float32);
+                else if (block == DatumWireBlock::HandKeypoints3D && blockHeader.index < 2u)
+                    readArray(datum.handKeypoints3D[blockHeader.index], blockHeader, blockData,
+                              DatumWireElement::Float32);
+                else if (block == DatumWireBlock::CvOutputData)
+                    readMatrix(datum.cvOutputData, blockHeader, blockData);
+                else if (block == DatumWireBlock::CvOutputDataJpeg)
+                    readJpeg(datum.cvOutputData, blockHeader, blockData);
+                // Unknown blocks (e.g., from a newer sender) are skipped
+            }
+            return offset;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+}
@@ -0,0 +1,129 @@
+#include <openpose_private/filestream/datumSocket.hpp>
+#ifdef _WIN32
+    #include <ws2tcpip.h>
+    #pragma comment(lib, "Ws2_32.lib")
+#else
+    #include <netinet/in.h> // IPPROTO_TCP
+    #include <netinet/tcp.h> // TCP_NODELAY
+    #include <sys/select.h> // select
+    #include <sys/socket.h>
+    #include <unistd.h> // close
+#endif
+#include <algorithm> // std::min
+
+namespace op
+{
+    void startDatumSockets()
+    {
+        #ifdef _WIN32
+            WSADATA wsaData;
+            if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+                error("WSAStartup failed.", __LINE__, __FUNCTION__, __FILE__);
+        #endif
+    }
+
+    void stopDatumSockets()
+    {
+        #ifdef _WIN32
+            WSACleanup();
+        #endif
+    }
+
+    void closeDatumSocket(const DatumSocketType socketDescriptor)
+    {
+        #ifdef _WIN32
+            closesocket(socketDescriptor);
+        #else
+            close(socketDescriptor);
+        #endif
+    }
+
+    void setDatumSocketNoDelay(const DatumSocketType socketDescriptor)
+    {
+        const int noDelay = 1;
+        setsockopt(socketDescriptor, IPPROTO_TCP, TCP_NODELAY, (const char*)&noDelay, (int)sizeof(noDelay));
+    }
+
+    bool waitForDatumSocket(const DatumSocketType socketDescriptor, const int timeoutMs)
+    {
+        fd_set readSockets;
+        FD_ZERO(&readSockets);
+        FD_SET(socketDescriptor, &readSockets);
+        timeval timeout{timeoutMs / 1000, (timeoutMs % 1000) * 1000};
+        return select((int)socketDescriptor + 1, &readSockets, nullptr, nullptr, &timeout) > 0;
+    }
+
+    bool sendDatumSocket(const DatumSocketType socketDescriptor, const void* const dataPtr, const uint64_t bytes)
+    {
+        #ifdef MSG_NOSIGNAL
+            // Avoid SIGPIPE if the other side closed the connection
+            const auto flags = MSG_NOSIGNAL;
+        #else
+            const auto flags = 0;
+        #endif
+        auto bytesSent = 0ull;
+        while (bytesSent < bytes)
+        {
+            // At most 1 GB per call (send() takes an int on Windows)
+            const auto bytesToSend = (int)std::min((unsigned long long)(bytes - bytesSent), 1ull << 30);
+            const auto result = send(socketDescriptor, (const char*)dataPtr + bytesSent, bytesToSend, flags);
+            if (result <= 0)
+                return false;
+            bytesSent += (unsigned long long)result;
+        }
+        return true;
+    }
+
+    bool receiveDatumSocket(const DatumSocketType socketDescriptor, void* const dataPtr, const uint64_t bytes)
+    {
+        auto bytesReceived = 0ull;
+        while (bytesReceived < bytes)
+        {
+            const auto bytesToReceive = (int)std::min((unsigned long long)(bytes - bytesReceived), 1ull << 30);
+            const auto result = recv(socketDescriptor, (char*)dataPtr + bytesReceived, bytesToReceive, 0);
+            if (result <= 0)
+                return false;
+            bytesReceived += (unsigned long long)result;
+        }
+        return true;
+    }
+
+    bool receiveDatumWireMessageHeader(const DatumSocketType socketDescriptor, DatumWireMessageHeader& header)
+    {
+        try
+        {
+            if (!receiveDatumSocket(socketDescriptor, &header, sizeof(header)))
+                return false;
+            if (header.magic != DATUM_WIRE_MAGIC)
+                error("The connected peer does not speak the OpenPose Datum wire format.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (header.version != DATUM_WIRE_VERSION)
+                error("Datum wire format version " + std::to_string(header.version) + " received, but only version "
+                      + std::to_string(DATUM_WIRE_VERSION) + " is supported.", __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    bool sendDatumWireMessage(
+        const DatumSocketType socketDescriptor, const DatumWireMessage message, const uint32_t value,
+        const std::vector<char>& payload)
+    {
+        try
+        {
+            const DatumWireMessageHeader header{
+                DATUM_WIRE_MAGIC, DATUM_WIRE_VERSION, (uint32_t)message, value, (uint64_t)payload.size()};
+            return sendDatumSocket(socketDescriptor, &header, sizeof(header))
+                && (payload.empty() || sendDatumSocket(socketDescriptor, payload.data(), payload.size()));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+}
@@ -6,13 +6,18 @@ namespace op
     DEFINE_TEMPLATE_DATUM(WBvhSaver);
 #endif
     DEFINE_TEMPLATE_DATUM(WCocoJsonSaver);
+    DEFINE_TEMPLATE_DATUM(WDatumSender);
     DEFINE_TEMPLATE_DATUM(WFaceSaver);
     DEFINE_TEMPLATE_DATUM(WHandSaver);
     DEFINE_TEMPLATE_DATUM(WHeatMapSaver);
     DEFINE_TEMPLATE_DATUM(WImageSaver);
+    DEFINE_TEMPLATE_DATUM(WKeypointBinarySaver);
+    DEFINE_TEMPLATE_DATUM(WKeypointStreamer);
     DEFINE_TEMPLATE_DATUM(WPeopleJsonSaver);
     DEFINE_TEMPLATE_DATUM(WPoseSaver);
     DEFINE_TEMPLATE_DATUM(WUdpSender);
     DEFINE_TEMPLATE_DATUM(WVideoSaver);
     DEFINE_TEMPLATE_DATUM(WVideoSaver3D);
+    DEFINE_TEMPLATE_DATUM(WVideoStreamer);
+    template class OP_API WDatumReceiver<BASE_DATUM>;
 }
@@ -77,38 +77,59 @@ namespace op
         }
     }
 
+    void addPartCandidatesToJson(
+        JsonOfstream& jsonOfstream, const unsigned int part, const float* const partCandidatesPtr,
+        const int numberPartCandidates)
+    {
+        try
+        {
+            // Open array
+            jsonOfstream.key(std::to_string(part));
+            jsonOfstream.arrayOpen();
+            // Body part candidates, as contiguous (x,y,score) triplets
+            for (auto bodyPart = 0 ; bodyPart < numberPartCandidates ; bodyPart++)
+            {
+                const auto* const candidate = &partCandidatesPtr[3*bodyPart];
+                jsonOfstream.plainText(candidate[0]);
+                jsonOfstream.comma();
+                jsonOfstream.plainText(candidate[1]);
+                jsonOfstream.comma();
+                jsonOfstream.plainText(candidate[2]);
+                if (bodyPart < numberPartCandidates-1)
+                    jsonOfstream.comma();
+            }
+            jsonOfstream.arrayClose();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     void addCandidatesToJson(
-        JsonOfstream& jsonOfstream, const std::vector<std::vector<std::array<float,3>>>& candidates)
+        JsonOfstream& jsonOfstream, const std::vector<std::vector<std::array<float,3>>>& candidates,
+        const Array<float>& candidatesArray, const std::vector<int>& candidateOffsets)
     {
         try
         {
             // Add body part candidates
             jsonOfstream.key("part_candidates");
             jsonOfstream.arrayOpen();
-            // Ger max numberParts
-            const auto numberParts = candidates.size();
+            // Flat candidates (if any), or nested ones otherwise
+            const auto flat = !candidateOffsets.empty();
+            const auto numberParts = (flat ? candidateOffsets.size() - 1 : candidates.size());
             jsonOfstream.objectOpen();
             for (auto part = 0u ; part < numberParts ; part++)
             {
-                // Open array
-                jsonOfstream.key(std::to_string(part));
-                jsonOfstream.arrayOpen();
                 // Iterate over part candidates
-                const auto& partCandidates = candidates[part];
-                const auto numberPartCandidates = partCandidates.size();
-                // Body part candidates
-                for (auto bodyPart = 0u ; bodyPart < numberPartCandidates ; bodyPart++)
-                {
-                    const auto& candidate = partCandidates[bodyPart];
-                    jsonOfstream.plainText(candidate[0]);
-                    jsonOfstream.comma();
-                    jsonOfstream.plainText(candidate[1]);
-                    jsonOfstream.comma();
-                    jsonOfstream.plainText(candidate[2]);
-                    if (bodyPart < numberPartCandidates-1)
-                        jsonOfstream.comma();
-                }
-                jsonOfstream.arrayClose();
+                if (flat)
+                    addPartCandidatesToJson(
+                        jsonOfstream, part, candidatesArray.getConstPtr() + 3*candidateOffsets[part],
+                        candidateOffsets[part+1] - candidateOffsets[part]);
+                else
+                    addPartCandidatesToJson(
+                        jsonOfstream, part, (candidates[part].empty() ? nullptr : candidates[part][0].data()),
+                        (int)candidates[part].size());
                 if (part < numberParts-1)
                     jsonOfstream.comma();
             }
@@ -122,11 +143,37 @@ namespace op
         }
     }
 
+    void addTimingToJson(JsonOfstream& jsonOfstream, const std::vector<DatumTimingEvent>& timingEvents)
+    {
+        try
+        {
+            // Add the stages of the frame (see DatumTiming)
+            jsonOfstream.key("timing");
+            jsonOfstream.arrayOpen();
+            for (auto i = 0u ; i < timingEvents.size() ; i++)
+            {
+                const auto& timingEvent = timingEvents[i];
+                jsonOfstream.objectOpen();
+                jsonOfstream.key("stage");
+                jsonOfstream.plainText("\"" + std::string{timingEvent.name} + "\"");
+                jsonOfstream.comma();
+                jsonOfstream.key("begin_ns");
+                jsonOfstream.plainText(timingEvent.beginNs);
+                jsonOfstream.comma();
+                jsonOfstream.key("end_ns");
+                jsonOfstream.plainText(timingEvent.endNs);
+                jsonOfstream.objectClose();
+                if (i < timingEvents.size()-1)
+                    jsonOfstream.comma();
+            }
+            jsonOfstream.arrayClose();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 
-
-
-
-    // Public classes (on *.hpp)
     std::string dataFormatToString(const DataFormat dataFormat)
     {
         try
@@ -303,10 +350,10 @@ namespace op
         }
     }
 
-    void savePeopleJson(
-        const std::vector<std::pair<Array<float>, std::string>>& keypointVector,
-        const std::vector<std::vector<std::array<float,3>>>& candidates, const std::string& fileName,
-        const bool humanReadable)
+    void addPeopleToJson(
+        JsonOfstream& jsonOfstream, const std::vector<std::pair<Array<float>, std::string>>& keypointVector,
+        const std::vector<std::vector<std::array<float,3>>>& candidates, const Array<float>& candidatesArray,
+        const std::vector<int>& candidateOffsets, const std::vector<DatumTimingEvent>& timingEvents)
     {
         try
         {
@@ -315,8 +362,6 @@ namespace op
                 if (!keypointPair.first.empty() && keypointPair.first.getNumberDimensions() != 3
                     && keypointPair.first.getNumberDimensions() != 1)
                     error("keypointVector.getNumberDimensions() != 1 && != 3.", __LINE__, __FUNCTION__, __FILE__);
-            // Record frame on desired path
-            JsonOfstream jsonOfstream{fileName, humanReadable};
             jsonOfstream.objectOpen();
             // Add version
             // Version 0.1: Body keypoints (2-D)
@@ -324,15 +369,22 @@ namespace op
             // Version 1.1: Added candidates
             // Version 1.2: Added body, face, and hands (3-D)
             // Version 1.3: Added person ID (for temporal consistency)
-            jsonOfstream.version("1.3");
+            // Version 1.4: Added timing (per-stage timing record of the frame)
+            jsonOfstream.version(timingEvents.empty() ? "1.3" : "1.4");
             jsonOfstream.comma();
             // Add people keypoints
             addKeypointsToJson(jsonOfstream, keypointVector);
             // Add body part candidates
-            if (!candidates.empty())
+            if (!candidates.empty() || !candidateOffsets.empty())
             {
                 jsonOfstream.comma();
-                addCandidatesToJson(jsonOfstream, candidates);
+                addCandidatesToJson(jsonOfstream, candidates, candidatesArray, candidateOffsets);
+            }
+            // Add timing record
+            if (!timingEvents.empty())
+            {
+                jsonOfstream.comma();
+                addTimingToJson(jsonOfstream, timingEvents);
             }
             // Close object
             jsonOfstream.objectClose();
@@ -343,6 +395,72 @@ namespace op
         }
     }
 
+    void savePeopleJson(
+        const std::vector<std::pair<Array<float>, std::string>>& keypointVector,
+        const std::vector<std::vector<std::array<float,3>>>& candidates, const std::string& fileName,
+        const bool humanReadable, const std::vector<DatumTimingEvent>& timingEvents)
+    {
+        try
+        {
+            // Record frame on desired path
+            JsonOfstream jsonOfstream{fileName, humanReadable};
+            addPeopleToJson(jsonOfstream, keypointVector, candidates, Array<float>{}, {}, timingEvents);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void savePeopleJson(
+        const std::vector<std::pair<Array<float>, std::string>>& keypointVector, const Array<float>& candidates,
+        const std::vector<int>& candidateOffsets, const std::string& fileName, const bool humanReadable,
+        const std::vector<DatumTimingEvent>& timingEvents)
+    {
+        try
+        {
+            // Record frame on desired path
+            JsonOfstream jsonOfstream{fileName, humanReadable};
+            addPeopleToJson(jsonOfstream, keypointVector, {}, candidates, candidateOffsets, timingEvents);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void peopleJsonToString(
+        std::string& jsonString, const std::vector<std::pair<Array<float>, std::string>>& keypointVector,
+        const std::vector<std::vector<std::array<float,3>>>& candidates, const bool humanReadable,
+        const std::vector<DatumTimingEvent>& timingEvents)
+    {
+        try
+        {
+            JsonOfstream jsonOfstream{&jsonString, humanReadable};
+            addPeopleToJson(jsonOfstream, keypointVector, candidates, Array<float>{}, {}, timingEvents);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void peopleJsonToString(
+        std::string& jsonString, const std::vector<std::pair<Array<float>, std::string>>& keypointVector,
+        const Array<float>& candidates, const std::vector<int>& candidateOffsets, const bool humanReadable,
+        const std::vector<DatumTimingEvent>& timingEvents)
+    {
+        try
+        {
+            JsonOfstream jsonOfstream{&jsonString, humanReadable};
+            addPeopleToJson(jsonOfstream, keypointVector, {}, candidates, candidateOffsets, timingEvents);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     void saveImage(const Matrix& matrix, const std::string& fullFilePath,
                    const std::vector<int>& openCvCompressionParams)
     {
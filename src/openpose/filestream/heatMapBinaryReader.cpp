@@ -0,0 +1,353 @@
+#include <openpose/filestream/heatMapBinaryReader.hpp>
+#include <cstring> // std::memcmp, std::memcpy
+#ifdef USE_ZSTD
+    #include <zstd.h>
+#endif
+#include <openpose/filestream/enumClasses.hpp>
+#include <openpose_private/filestream/heatMapBinaryFormat.hpp>
+#include <openpose_private/utilities/memoryMappedFile.hpp>
+#include <openpose_private/utilities/parallelFor.hpp>
+
+namespace op
+{
+    struct HeatMapBinaryReader::ImplHeatMapBinaryReader
+    {
+        std::unique_ptr<MemoryMappedFile> upMemoryMappedFile;
+        std::vector<uint64_t> mFrameOffsets;
+        uint32_t mVersion;
+
+        explicit ImplHeatMapBinaryReader(const std::string& filePath) :
+            upMemoryMappedFile{new MemoryMappedFile{filePath}},
+            mVersion{HEAT_MAP_BINARY_VERSION}
+        {
+        }
+
+        // Exactly one of heatMaps and sparseHeatMaps is filled, the other one is nullptr
+        void readFrame(
+            std::vector<Array<float>>* const heatMaps, std::vector<SparseHeatMaps>* const sparseHeatMaps,
+            const unsigned long long frameIndex) const;
+    };
+
+    namespace
+    {
+        template<typename T>
+        void unshuffleBytes(T* const values, const char* const shuffled, const std::size_t numberValues)
+        {
+            auto* const bytes = (char*)values;
+            for (auto byte = 0u ; byte < sizeof(T) ; byte++)
+            {
+                const auto* const plane = shuffled + byte * numberValues;
+                for (auto i = 0u ; i < numberValues ; i++)
+                    bytes[i * sizeof(T) + byte] = plane[i];
+            }
+        }
+
+        // Dense channels if indices is nullptr. Otherwise, it also fills the indices of the sparse values
+        void decodeChannel(
+            float* const values, int* const indices, const std::size_t numberValues,
+            const HeatMapBinaryChannelHeader& channelHeader, const unsigned char* const dataPtr,
+            const HeatMapPrecision heatMapPrecision)
+        {
+            try
+            {
+                const auto elementBytes = (heatMapPrecision == HeatMapPrecision::Float32 ? sizeof(float)
+                    : (heatMapPrecision == HeatMapPrecision::Float16 ? sizeof(uint16_t) : sizeof(unsigned char)));
+                const auto indicesBytes = (indices == nullptr ? 0u : numberValues * sizeof(uint32_t));
+                const auto rawBytes = indicesBytes + numberValues * elementBytes;
+                // Decompress
+                const char* rawPtr = (const char*)dataPtr;
+                std::vector<char> rawBuffer;
+                if (channelHeader.compression == (uint32_t)HeatMapBinaryCompression::Zstd)
+                {
+                    #ifdef USE_ZSTD
+                        rawBuffer.resize(rawBytes);
+                        const auto decompressedBytes = ZSTD_decompress(
+                            rawBuffer.data(), rawBuffer.size(), dataPtr, channelHeader.dataBytes);
+                        if (ZSTD_isError(decompressedBytes))
+                            error("Zstandard error: " + std::string{ZSTD_getErrorName(decompressedBytes)},
+                                  __LINE__, __FUNCTION__, __FILE__);
+                        if (decompressedBytes != rawBytes)
+                            error("Corrupted heat map channel.", __LINE__, __FUNCTION__, __FILE__);
+                        rawPtr = rawBuffer.data();
+                    #else
+                        error("This heat map file is compressed with Zstandard, so OpenPose must be compiled with"
+                              " `WITH_ZSTD` to read it.", __LINE__, __FUNCTION__, __FILE__);
+                    #endif
+                }
+                else if (channelHeader.compression != (uint32_t)HeatMapBinaryCompression::None)
+                    error("Unknown heat map compression " + std::to_string(channelHeader.compression) + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+                else if (channelHeader.dataBytes != rawBytes)
+                    error("Corrupted heat map channel.", __LINE__, __FUNCTION__, __FILE__);
+                // Sparse indices (differences with the previous one)
+                if (indices != nullptr)
+                {
+                    std::vector<uint32_t> deltas(numberValues);
+                    unshuffleBytes(deltas.data(), rawPtr, numberValues);
+                    auto index = 0u;
+                    for (auto i = 0u ; i < numberValues ; i++)
+                    {
+                        index += deltas[i];
+                        indices[i] = (int)index;
+                    }
+                    rawPtr += indicesBytes;
+                }
+                // Decode
+                if (heatMapPrecision == HeatMapPrecision::Float32)
+                    unshuffleBytes(values, rawPtr, numberValues);
+                else if (heatMapPrecision == HeatMapPrecision::Float16)
+                {
+                    std::vector<uint16_t> halfs(numberValues);
+                    unshuffleBytes(halfs.data(), rawPtr, numberValues);
+                    for (auto i = 0u ; i < numberValues ; i++)
+                        values[i] = halfToFloat(halfs[i]);
+                }
+                else
+                {
+                    const auto* const quantized = (const unsigned char*)rawPtr;
+                    for (auto i = 0u ; i < numberValues ; i++)
+                        values[i] = channelHeader.offset + channelHeader.scale * quantized[i];
+                }
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+    }
+
+    void HeatMapBinaryReader::ImplHeatMapBinaryReader::readFrame(
+        std::vector<Array<float>>* const heatMaps, std::vector<SparseHeatMaps>* const sparseHeatMaps,
+        const unsigned long long frameIndex) const
+    {
+        try
+        {
+            if (frameIndex >= mFrameOffsets.size())
+                error("Frame " + std::to_string(frameIndex) + " out of bounds (the file contains "
+                      + std::to_string(mFrameOffsets.size()) + " frames).", __LINE__, __FUNCTION__, __FILE__);
+            const auto* const framePtr = upMemoryMappedFile->getData() + mFrameOffsets[frameIndex];
+            HeatMapBinaryFrameHeader frameHeader;
+            std::memcpy(&frameHeader, framePtr, sizeof(HeatMapBinaryFrameHeader));
+            const auto corruptedMessage = "Frame " + std::to_string(frameIndex) + " is corrupted.";
+            auto offset = (uint64_t)(sizeof(HeatMapBinaryFrameHeader)
+                                     + heatMapBinaryPaddedBytes(frameHeader.nameBytes));
+            const auto arrayHeaderBytes = (std::size_t)(
+                mVersion == 1u ? HEAT_MAP_BINARY_ARRAY_HEADER_BYTES_V1 : sizeof(HeatMapBinaryArrayHeader));
+            if (heatMaps != nullptr)
+                heatMaps->resize(frameHeader.numberArrays);
+            else
+                sparseHeatMaps->resize(frameHeader.numberArrays);
+            for (auto array = 0u ; array < frameHeader.numberArrays ; array++)
+            {
+                // Array header
+                HeatMapBinaryArrayHeader arrayHeader;
+                arrayHeader.layout = (uint32_t)HeatMapBinaryLayout::Dense;
+                arrayHeader.threshold = 0.f;
+                if (offset + arrayHeaderBytes > frameHeader.frameBytes)
+                    error(corruptedMessage, __LINE__, __FUNCTION__, __FILE__);
+                std::memcpy(&arrayHeader, framePtr + offset, arrayHeaderBytes);
+                offset += heatMapBinaryPaddedBytes(arrayHeaderBytes);
+                const auto heatMapPrecision = HeatMapPrecision(arrayHeader.precision);
+                if (heatMapPrecision >= HeatMapPrecision::Size)
+                    error("Unknown heat map precision " + std::to_string(arrayHeader.precision) + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+                const auto sparse = (arrayHeader.layout == (uint32_t)HeatMapBinaryLayout::Sparse);
+                if (!sparse && arrayHeader.layout != (uint32_t)HeatMapBinaryLayout::Dense)
+                    error("Unknown heat map layout " + std::to_string(arrayHeader.layout) + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+                // Channel headers
+                const auto numberChannels = (int)arrayHeader.numberChannels;
+                std::vector<HeatMapBinaryChannelHeader> channelHeaders(numberChannels);
+                const auto channelHeadersBytes = channelHeaders.size() * sizeof(HeatMapBinaryChannelHeader);
+                if (offset + channelHeadersBytes > frameHeader.frameBytes)
+                    error(corruptedMessage, __LINE__, __FUNCTION__, __FILE__);
+                if (numberChannels > 0)
+                    std::memcpy(channelHeaders.data(), framePtr + offset, channelHeadersBytes);
+                offset += heatMapBinaryPaddedBytes(channelHeadersBytes);
+                // Offset of each channel data
+                std::vector<uint64_t> channelOffsets(numberChannels);
+                for (auto channel = 0 ; channel < numberChannels ; channel++)
+                {
+                    channelOffsets[channel] = offset;
+                    offset += heatMapBinaryPaddedBytes(channelHeaders[channel].dataBytes);
+                    if (offset > frameHeader.frameBytes)
+                        error(corruptedMessage, __LINE__, __FUNCTION__, __FILE__);
+                }
+                // Decode each channel in parallel
+                const std::vector<int> size{numberChannels, (int)arrayHeader.height, (int)arrayHeader.width};
+                const auto channelVolume = (std::size_t)arrayHeader.height * arrayHeader.width;
+                if (sparse)
+                {
+                    SparseHeatMaps sparseHeatMapsTemp;
+                    auto& sparseHeatMap = (sparseHeatMaps != nullptr
+                        ? sparseHeatMaps->at(array) : sparseHeatMapsTemp);
+                    sparseHeatMap.clear();
+                    if (numberChannels > 0)
+                    {
+                        sparseHeatMap.size = size;
+                        sparseHeatMap.threshold = arrayHeader.threshold;
+                        sparseHeatMap.offsets.resize(numberChannels + 1);
+                        sparseHeatMap.offsets[0] = 0;
+                        for (auto channel = 0 ; channel < numberChannels ; channel++)
+                        {
+                            if (channelHeaders[channel].numberValues > channelVolume)
+                                error(corruptedMessage, __LINE__, __FUNCTION__, __FILE__);
+                            sparseHeatMap.offsets[channel+1] = sparseHeatMap.offsets[channel]
+                                                             + (int)channelHeaders[channel].numberValues;
+                        }
+                        sparseHeatMap.indices.resize(sparseHeatMap.offsets.back());
+                        sparseHeatMap.values.resize(sparseHeatMap.offsets.back());
+                        parallelFor(
+                            0, numberChannels,
+                            [&](const int channel)
+                            {
+                                const auto begin = sparseHeatMap.offsets[channel];
+                                decodeChannel(
+                                    sparseHeatMap.values.data() + begin, sparseHeatMap.indices.data() + begin,
+                                    channelHeaders[channel].numberValues, channelHeaders[channel],
+                                    framePtr + channelOffsets[channel], heatMapPrecision);
+                            });
+                    }
+                    if (heatMaps != nullptr)
+                        heatMaps->at(array) = sparseHeatMap.toDense();
+                }
+                else
+                {
+                    Array<float> heatMapTemp;
+                    auto& heatMap = (heatMaps != nullptr ? heatMaps->at(array) : heatMapTemp);
+                    if (numberChannels == 0)
+                        heatMap.reset();
+                    else
+                    {
+                        heatMap.reset(size);
+                        parallelFor(
+                            0, numberChannels,
+                            [&](const int channel)
+                            {
+                                decodeChannel(
+                                    heatMap.getPtr() + channel * channelVolume, nullptr, channelVolume,
+                                    channelHeaders[channel], framePtr + channelOffsets[channel], heatMapPrecision);
+                            });
+                    }
+                    // Lossless (all the non-zero values)
+                    if (sparseHeatMaps != nullptr)
+                        sparseHeatMaps->at(array) = SparseHeatMaps{heatMap, 0.f};
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    HeatMapBinaryReader::HeatMapBinaryReader(const std::string& filePath) :
+        upImpl{new ImplHeatMapBinaryReader{filePath}}
+    {
+        try
+        {
+            const auto* const filePtr = upImpl->upMemoryMappedFile->getData();
+            const auto fileSize = upImpl->upMemoryMappedFile->getSize();
+            // File header
+            HeatMapBinaryFileHeader fileHeader;
+            if (fileSize < sizeof(HeatMapBinaryFileHeader))
+                error("File " + filePath + " is not an OpenPose heat map binary file.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            std::memcpy(&fileHeader, filePtr, sizeof(HeatMapBinaryFileHeader));
+            if (std::memcmp(fileHeader.magic, HEAT_MAP_BINARY_MAGIC, sizeof(fileHeader.magic)) != 0)
+                error("File " + filePath + " is not an OpenPose heat map binary file.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (fileHeader.version < 1u || fileHeader.version > HEAT_MAP_BINARY_VERSION)
+                error("Version " + std::to_string(fileHeader.version) + " of file " + filePath
+                      + " is not supported (only up to " + std::to_string(HEAT_MAP_BINARY_VERSION) + ").",
+                      __LINE__, __FUNCTION__, __FILE__);
+            upImpl->mVersion = fileHeader.version;
+            // Index of frames (only their headers are read)
+            auto offset = (uint64_t)sizeof(HeatMapBinaryFileHeader);
+            while (offset < fileSize)
+            {
+                HeatMapBinaryFrameHeader frameHeader;
+                if (fileSize - offset < sizeof(HeatMapBinaryFrameHeader))
+                    break;
+                std::memcpy(&frameHeader, filePtr + offset, sizeof(HeatMapBinaryFrameHeader));
+                if (frameHeader.magic != HEAT_MAP_BINARY_FRAME_MAGIC
+                    || frameHeader.frameBytes < sizeof(HeatMapBinaryFrameHeader)
+                        + heatMapBinaryPaddedBytes(frameHeader.nameBytes)
+                    || frameHeader.frameBytes > fileSize - offset)
+                    break;
+                upImpl->mFrameOffsets.emplace_back(offset);
+                offset += frameHeader.frameBytes;
+            }
+            if (offset < fileSize)
+                opLog("The last " + std::to_string(fileSize - offset) + " bytes of " + filePath + " are not a"
+                      " complete frame (e.g., the program was stopped while saving it), so they are ignored.",
+                      Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    HeatMapBinaryReader::~HeatMapBinaryReader()
+    {
+    }
+
+    unsigned long long HeatMapBinaryReader::getNumberFrames() const
+    {
+        try
+        {
+            return upImpl->mFrameOffsets.size();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    std::string HeatMapBinaryReader::getFrameName(const unsigned long long frameIndex) const
+    {
+        try
+        {
+            if (frameIndex >= upImpl->mFrameOffsets.size())
+                error("Frame " + std::to_string(frameIndex) + " out of bounds (the file contains "
+                      + std::to_string(upImpl->mFrameOffsets.size()) + " frames).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            const auto* const framePtr = upImpl->upMemoryMappedFile->getData() + upImpl->mFrameOffsets[frameIndex];
+            HeatMapBinaryFrameHeader frameHeader;
+            std::memcpy(&frameHeader, framePtr, sizeof(HeatMapBinaryFrameHeader));
+            return std::string{(const char*)framePtr + sizeof(HeatMapBinaryFrameHeader), frameHeader.nameBytes};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    void HeatMapBinaryReader::readFrame(std::vector<Array<float>>& heatMaps, const unsigned long long frameIndex) const
+    {
+        try
+        {
+            upImpl->readFrame(&heatMaps, nullptr, frameIndex);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void HeatMapBinaryReader::readFrame(
+        std::vector<SparseHeatMaps>& heatMaps, const unsigned long long frameIndex) const
+    {
+        try
+        {
+            upImpl->readFrame(nullptr, &heatMaps, frameIndex);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
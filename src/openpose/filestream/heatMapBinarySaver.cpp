@@ -0,0 +1,309 @@
+#include <openpose/filestream/heatMapBinarySaver.hpp>
+#include <cstring> // std::memcpy
+#ifdef USE_ZSTD
+    #include <zstd.h>
+#endif
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose_private/filestream/heatMapBinaryFormat.hpp>
+#include <openpose_private/utilities/parallelFor.hpp>
+
+namespace op
+{
+    namespace
+    {
+        // Byte planes: all the 1st bytes of the values, then all the 2nd ones, etc. The exponents and high mantissa
+        // bits of close values are then equal bytes next to each other, which compress much better
+        template<typename T>
+        void shuffleBytes(char* const shuffled, const T* const values, const std::size_t numberValues)
+        {
+            const auto* const bytes = (const char*)values;
+            for (auto byte = 0u ; byte < sizeof(T) ; byte++)
+            {
+                auto* const plane = shuffled + byte * numberValues;
+                for (auto i = 0u ; i < numberValues ; i++)
+                    plane[i] = bytes[i * sizeof(T) + byte];
+            }
+        }
+
+        // Dense channels if indices is nullptr. Otherwise, the (sorted) indices of the values are saved first
+        void encodeChannel(
+            std::vector<char>& rawBuffer, HeatMapBinaryChannelHeader& channelHeader, const float* const values,
+            const int* const indices, const std::size_t numberValues, const HeatMapPrecision heatMapPrecision)
+        {
+            try
+            {
+                channelHeader.offset = 0.f;
+                channelHeader.scale = 1.f;
+                channelHeader.compression = (uint32_t)HeatMapBinaryCompression::None;
+                channelHeader.numberValues = (uint32_t)(indices == nullptr ? 0u : numberValues);
+                // Sparse indices: differences with the previous one (small and similar numbers)
+                const auto indicesBytes = (indices == nullptr ? 0u : numberValues * sizeof(uint32_t));
+                if (indices != nullptr)
+                {
+                    std::vector<uint32_t> deltas(numberValues);
+                    for (auto i = 0u ; i < numberValues ; i++)
+                        deltas[i] = (uint32_t)(indices[i] - (i > 0 ? indices[i-1] : 0));
+                    rawBuffer.resize(indicesBytes);
+                    shuffleBytes(rawBuffer.data(), deltas.data(), numberValues);
+                }
+                // Values
+                if (heatMapPrecision == HeatMapPrecision::Float32)
+                {
+                    rawBuffer.resize(indicesBytes + numberValues * sizeof(float));
+                    shuffleBytes(rawBuffer.data() + indicesBytes, values, numberValues);
+                }
+                else if (heatMapPrecision == HeatMapPrecision::Float16)
+                {
+                    std::vector<uint16_t> halfs(numberValues);
+                    for (auto i = 0u ; i < numberValues ; i++)
+                        halfs[i] = floatToHalf(values[i]);
+                    rawBuffer.resize(indicesBytes + numberValues * sizeof(uint16_t));
+                    shuffleBytes(rawBuffer.data() + indicesBytes, halfs.data(), numberValues);
+                }
+                else if (heatMapPrecision == HeatMapPrecision::UInt8)
+                {
+                    // Value = offset + scale x [0, 255]
+                    auto minValue = (numberValues > 0 ? values[0] : 0.f);
+                    auto maxValue = minValue;
+                    for (auto i = 1u ; i < numberValues ; i++)
+                    {
+                        minValue = fastMin(minValue, values[i]);
+                        maxValue = fastMax(maxValue, values[i]);
+                    }
+                    channelHeader.offset = minValue;
+                    channelHeader.scale = (maxValue - minValue) / 255.f;
+                    const auto inverseScale = (channelHeader.scale > 0.f ? 1.f / channelHeader.scale : 0.f);
+                    rawBuffer.resize(indicesBytes + numberValues);
+                    auto* const quantized = (unsigned char*)rawBuffer.data() + indicesBytes;
+                    for (auto i = 0u ; i < numberValues ; i++)
+                        quantized[i] = (unsigned char)fastTruncate(
+                            positiveIntRound((values[i] - minValue) * inverseScale), 0, 255);
+                }
+                else
+                    error("Unknown HeatMapPrecision.", __LINE__, __FUNCTION__, __FILE__);
+                channelHeader.dataBytes = rawBuffer.size();
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        // It returns the buffer to save: compressedBuffer, or rawBuffer if it could not be compressed
+        const std::vector<char>& compressChannel(
+            std::vector<char>& compressedBuffer, HeatMapBinaryChannelHeader& channelHeader,
+            const std::vector<char>& rawBuffer, const int compressionLevel)
+        {
+            try
+            {
+                #ifdef USE_ZSTD
+                    compressedBuffer.resize(ZSTD_compressBound(rawBuffer.size()));
+                    const auto compressedBytes = ZSTD_compress(
+                        compressedBuffer.data(), compressedBuffer.size(), rawBuffer.data(), rawBuffer.size(),
+                        compressionLevel);
+                    if (ZSTD_isError(compressedBytes))
+                        error("Zstandard error: " + std::string{ZSTD_getErrorName(compressedBytes)},
+                              __LINE__, __FUNCTION__, __FILE__);
+                    // Random-like data would be bigger when compressed
+                    if (compressedBytes < rawBuffer.size())
+                    {
+                        compressedBuffer.resize(compressedBytes);
+                        channelHeader.compression = (uint32_t)HeatMapBinaryCompression::Zstd;
+                        channelHeader.dataBytes = compressedBytes;
+                        return compressedBuffer;
+                    }
+                #else
+                    UNUSED(compressedBuffer);
+                    UNUSED(channelHeader);
+                    UNUSED(compressionLevel);
+                #endif
+                return rawBuffer;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return rawBuffer;
+            }
+        }
+
+        template<typename T>
+        void appendBytes(std::vector<char>& frameBuffer, const T* const data, const std::size_t bytes)
+        {
+            const auto offset = frameBuffer.size();
+            frameBuffer.resize(offset + heatMapBinaryPaddedBytes(bytes), 0);
+            if (bytes > 0)
+                std::memcpy(&frameBuffer[offset], data, bytes);
+        }
+    }
+
+    HeatMapBinarySaver::HeatMapBinarySaver(
+        const std::string& filePath, const HeatMapPrecision heatMapPrecision, const int compressionLevel) :
+        mFilePath{filePath},
+        mHeatMapPrecision{heatMapPrecision},
+        mCompressionLevel{compressionLevel},
+        mOfstream{filePath, std::ios::out | std::ios::binary | std::ios::trunc},
+        mFrameNameBytes{0u}
+    {
+        try
+        {
+            if (mHeatMapPrecision >= HeatMapPrecision::Size)
+                error("Unknown HeatMapPrecision.", __LINE__, __FUNCTION__, __FILE__);
+            if (!mOfstream.is_open())
+                error("File " + filePath + " could not be opened.", __LINE__, __FUNCTION__, __FILE__);
+            HeatMapBinaryFileHeader fileHeader;
+            std::memcpy(fileHeader.magic, HEAT_MAP_BINARY_MAGIC, sizeof(fileHeader.magic));
+            fileHeader.version = HEAT_MAP_BINARY_VERSION;
+            fileHeader.reserved = 0u;
+            mOfstream.write((const char*)&fileHeader, sizeof(HeatMapBinaryFileHeader));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    HeatMapBinarySaver::~HeatMapBinarySaver()
+    {
+    }
+
+    void HeatMapBinarySaver::save(const std::vector<Array<float>>& heatMaps, const std::string& name)
+    {
+        try
+        {
+            beginFrame(name);
+            for (const auto& heatMap : heatMaps)
+            {
+                const auto numberChannels = (heatMap.empty() ? 0 : heatMap.getSize(0));
+                const auto height = (heatMap.getNumberDimensions() > 1 ? heatMap.getSize(1) : 1);
+                const auto width = (heatMap.getNumberDimensions() > 2 ? heatMap.getSize(2) : 1);
+                if ((std::size_t)numberChannels * height * width != heatMap.getVolume())
+                    error("Only heat maps of up to 3 dimensions (channels x height x width) can be saved.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                appendArray(numberChannels, height, width, heatMap.getConstPtr(), nullptr);
+            }
+            endFrame(heatMaps.size());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void HeatMapBinarySaver::save(const std::vector<SparseHeatMaps>& heatMaps, const std::string& name)
+    {
+        try
+        {
+            beginFrame(name);
+            for (const auto& heatMap : heatMaps)
+            {
+                if (heatMap.empty())
+                    appendArray(0, 1, 1, nullptr, nullptr);
+                else
+                {
+                    if (heatMap.size.size() != 3u || (int)heatMap.offsets.size() != heatMap.size[0] + 1)
+                        error("Only sparse heat maps of size [#channels x height x width] can be saved.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    appendArray(heatMap.size[0], heatMap.size[1], heatMap.size[2], nullptr, &heatMap);
+                }
+            }
+            endFrame(heatMaps.size());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void HeatMapBinarySaver::beginFrame(const std::string& name)
+    {
+        try
+        {
+            // Frame header (filled by endFrame()) + name
+            mFrameBuffer.assign(sizeof(HeatMapBinaryFrameHeader), 0);
+            appendBytes(mFrameBuffer, name.data(), name.size());
+            mFrameNameBytes = name.size();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void HeatMapBinarySaver::appendArray(
+        const int numberChannels, const int height, const int width, const float* const denseValues,
+        const SparseHeatMaps* const sparseHeatMaps)
+    {
+        try
+        {
+            // Array header
+            HeatMapBinaryArrayHeader arrayHeader;
+            arrayHeader.precision = (uint32_t)mHeatMapPrecision;
+            arrayHeader.numberChannels = (uint32_t)numberChannels;
+            arrayHeader.height = (uint32_t)height;
+            arrayHeader.width = (uint32_t)width;
+            arrayHeader.layout = (uint32_t)(sparseHeatMaps == nullptr
+                ? HeatMapBinaryLayout::Dense : HeatMapBinaryLayout::Sparse);
+            arrayHeader.threshold = (sparseHeatMaps == nullptr ? 0.f : sparseHeatMaps->threshold);
+            appendBytes(mFrameBuffer, &arrayHeader, sizeof(HeatMapBinaryArrayHeader));
+            // Encode and compress each channel in parallel
+            const auto channelVolume = (std::size_t)height * width;
+            std::vector<HeatMapBinaryChannelHeader> channelHeaders(numberChannels);
+            std::vector<const std::vector<char>*> channelBuffers(numberChannels);
+            if (mRawBuffers.size() < channelHeaders.size())
+            {
+                mRawBuffers.resize(channelHeaders.size());
+                mCompressedBuffers.resize(channelHeaders.size());
+            }
+            parallelFor(
+                0, numberChannels,
+                [&](const int channel)
+                {
+                    if (sparseHeatMaps == nullptr)
+                        encodeChannel(
+                            mRawBuffers[channel], channelHeaders[channel], denseValues + channel * channelVolume,
+                            nullptr, channelVolume, mHeatMapPrecision);
+                    else
+                    {
+                        const auto begin = sparseHeatMaps->offsets[channel];
+                        encodeChannel(
+                            mRawBuffers[channel], channelHeaders[channel], sparseHeatMaps->values.data() + begin,
+                            sparseHeatMaps->indices.data() + begin,
+                            (std::size_t)(sparseHeatMaps->offsets[channel+1] - begin), mHeatMapPrecision);
+                    }
+                    channelBuffers[channel] = &compressChannel(
+                        mCompressedBuffers[channel], channelHeaders[channel], mRawBuffers[channel],
+                        mCompressionLevel);
+                });
+            // Channel headers + channel data
+            appendBytes(
+                mFrameBuffer, channelHeaders.data(), channelHeaders.size() * sizeof(HeatMapBinaryChannelHeader));
+            for (auto channel = 0 ; channel < numberChannels ; channel++)
+                appendBytes(mFrameBuffer, channelBuffers[channel]->data(), channelBuffers[channel]->size());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void HeatMapBinarySaver::endFrame(const std::size_t numberArrays)
+    {
+        try
+        {
+            HeatMapBinaryFrameHeader frameHeader;
+            frameHeader.magic = HEAT_MAP_BINARY_FRAME_MAGIC;
+            frameHeader.numberArrays = (uint32_t)numberArrays;
+            frameHeader.frameBytes = mFrameBuffer.size();
+            frameHeader.nameBytes = mFrameNameBytes;
+            std::memcpy(mFrameBuffer.data(), &frameHeader, sizeof(HeatMapBinaryFrameHeader));
+            // Write the whole frame at once
+            mOfstream.write(mFrameBuffer.data(), mFrameBuffer.size());
+            if (!mOfstream.good())
+                error("Frame could not be written into " + mFilePath + ".", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -1,17 +1,91 @@
 #include <openpose/filestream/heatMapSaver.hpp>
 #include <openpose/utilities/openCv.hpp>
 #include <openpose/filestream/fileStream.hpp>
+#include <openpose/filestream/heatMapBinarySaver.hpp>
+#include <openpose_private/filestream/asyncFileWriter.hpp>
+#include <openpose_private/filestream/jpegEncoderGpu.hpp>
+#include <openpose_private/utilities/asyncJobQueue.hpp>
 
 namespace op
 {
-    HeatMapSaver::HeatMapSaver(const std::string& directoryPath, const std::string& imageFormat) :
+    namespace
+    {
+        // Formats of HeatMapBinarySaver
+        bool getHeatMapBinaryPrecision(HeatMapPrecision& heatMapPrecision, const std::string& imageFormat)
+        {
+            try
+            {
+                if (imageFormat == "opheat")
+                    heatMapPrecision = HeatMapPrecision::Float32;
+                else if (imageFormat == "opheat_fp16")
+                    heatMapPrecision = HeatMapPrecision::Float16;
+                else if (imageFormat == "opheat_uint8")
+                    heatMapPrecision = HeatMapPrecision::UInt8;
+                else
+                    return false;
+                return true;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return false;
+            }
+        }
+
+        bool isHeatMapBinaryFormat(const std::string& imageFormat)
+        {
+            HeatMapPrecision heatMapPrecision;
+            return getHeatMapBinaryPrecision(heatMapPrecision, imageFormat);
+        }
+
+        void saveHeatMap(const Array<float>& heatMap, const std::string& fileName, const std::string& imageFormat)
+        {
+            try
+            {
+                // Saving on custom floating type "float". Format it:
+                // First, the number of dimensions of the array.
+                // Next elements: the size of each dimension.
+                // Next: all the elements.
+                if (imageFormat == "float")
+                    saveFloatArray(heatMap, fileName);
+                // Saving on integer type (jpg, png, etc.)
+                else
+                {
+                    // heatMap -> cvOutputData
+                    Matrix cvOutputData;
+                    unrollArrayToUCharCvMat(cvOutputData, heatMap);
+                    saveImage(cvOutputData, fileName);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+    }
+
+    HeatMapSaver::HeatMapSaver(const std::string& directoryPath, const std::string& imageFormat,
+                               const int numberThreads, const bool gpuEncoding) :
         FileSaver{directoryPath},
-        mImageFormat{imageFormat}
+        mImageFormat{imageFormat},
+        // 1 thread for HeatMapBinarySaver, so the frames are saved in order (it compresses the channels in parallel)
+        spAsyncJobQueue{gpuEncoding && isJpegFormat(imageFormat) ? nullptr : createEncoderJobQueue(
+            isHeatMapBinaryFormat(imageFormat) && numberThreads != 0 ? 1 : numberThreads)},
+        spJpegEncoderGpu{gpuEncoding && isJpegFormat(imageFormat) ? std::make_shared<JpegEncoderGpu>() : nullptr},
+        spAsyncFileWriter{spJpegEncoderGpu != nullptr ? std::make_shared<AsyncFileWriter>() : nullptr}
     {
         try
         {
             if (mImageFormat.empty())
                 error("The string imageFormat should not be empty.", __LINE__, __FUNCTION__, __FILE__);
+            if (gpuEncoding && spJpegEncoderGpu == nullptr)
+                opLog("Warning: Only the JPEG heat maps (`jpg` or `jpeg`) can be encoded on the GPU, so the `"
+                      + mImageFormat + "` ones are saved on the CPU.", Priority::High);
+            // All the frames into a single file
+            HeatMapPrecision heatMapPrecision;
+            if (getHeatMapBinaryPrecision(heatMapPrecision, mImageFormat))
+                spHeatMapBinarySaver = std::make_shared<HeatMapBinarySaver>(
+                    getNextFileName("heatmaps") + ".opheat", heatMapPrecision);
         }
         catch (const std::exception& e)
         {
@@ -28,7 +102,26 @@ namespace op
         try
         {
             // Record cv::mat
-            if (!heatMaps.empty())
+            if (!heatMaps.empty() && spHeatMapBinarySaver != nullptr)
+            {
+                // Background thread (the heat maps are copied since the caller might modify them afterwards)
+                if (spAsyncJobQueue != nullptr)
+                {
+                    std::vector<Array<float>> heatMapsCopy(heatMaps.size());
+                    for (auto i = 0u; i < heatMaps.size(); i++)
+                        heatMapsCopy[i] = heatMaps[i].clone();
+                    const auto heatMapBinarySaver = spHeatMapBinarySaver;
+                    spAsyncJobQueue->push(
+                        [heatMapBinarySaver, heatMapsCopy, fileName]
+                        {
+                            heatMapBinarySaver->save(heatMapsCopy, fileName);
+                        });
+                }
+                // Calling thread
+                else
+                    spHeatMapBinarySaver->save(heatMaps, fileName);
+            }
+            else if (!heatMaps.empty())
             {
                 // File path (no extension)
                 const auto fileNameNoExtension = getNextFileName(fileName);
@@ -38,27 +131,37 @@ namespace op
                 for (auto i = 0u; i < fileNames.size(); i++)
                     fileNames[i] = {fileNameNoExtension + (i != 0 ? "_" + std::to_string(i) : "") + "." + mImageFormat};
 
-                // Saving on custom floating type "float". Format it:
-                // First, the number of dimensions of the array.
-                // Next elements: the size of each dimension.
-                // Next: all the elements.
-                if (mImageFormat == "float")
+                if (mImageFormat == "float" && heatMaps.size() > 1)
+                    error("Float only implemented for heatMaps.size() == 1.", __LINE__, __FUNCTION__, __FILE__);
+
+                // GPU encoding (all the heat maps at once) and background writing
+                if (spJpegEncoderGpu != nullptr)
                 {
-                    if (heatMaps.size() > 1)
-                        error("Float only implemented for heatMaps.size() == 1.", __LINE__, __FUNCTION__, __FILE__);
+                    std::vector<Matrix> cvOutputDatas(heatMaps.size());
                     for (auto i = 0u; i < heatMaps.size(); i++)
-                        saveFloatArray(heatMaps[i], fileNames[i]);
+                        unrollArrayToUCharCvMat(cvOutputDatas[i], heatMaps[i]);
+                    std::vector<std::string> jpegs;
+                    spJpegEncoderGpu->encode(jpegs, cvOutputDatas);
+                    for (auto i = 0u; i < jpegs.size(); i++)
+                        spAsyncFileWriter->write(fileNames[i], std::move(jpegs[i]));
+                    return;
                 }
-                // Saving on integer type (jpg, png, etc.)
-                else
+
+                // Save each heatMap
+                for (auto i = 0u; i < heatMaps.size(); i++)
                 {
-                    // heatMaps -> cvOutputDatas
-                    std::vector<Matrix> cvOutputDatas(heatMaps.size());
-                    for (auto i = 0u; i < cvOutputDatas.size(); i++)
-                        unrollArrayToUCharCvMat(cvOutputDatas[i], heatMaps[i]);
-                    // Save each heatMap
-                    for (auto i = 0u; i < cvOutputDatas.size(); i++)
-                        saveImage(cvOutputDatas[i], fileNames[i]);
+                    // Background threads (the heat map is copied since the caller might modify it afterwards)
+                    if (spAsyncJobQueue != nullptr)
+                    {
+                        const auto heatMap = heatMaps[i].clone();
+                        const auto& fileNameI = fileNames[i];
+                        const auto& imageFormat = mImageFormat;
+                        spAsyncJobQueue->push(
+                            [heatMap, fileNameI, imageFormat]{ saveHeatMap(heatMap, fileNameI, imageFormat); });
+                    }
+                    // Calling thread
+                    else
+                        saveHeatMap(heatMaps[i], fileNames[i], mImageFormat);
                 }
             }
         }
@@ -67,4 +170,39 @@ namespace op
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
         }
     }
+
+    void HeatMapSaver::saveHeatMaps(const std::vector<SparseHeatMaps>& heatMaps, const std::string& fileName) const
+    {
+        try
+        {
+            if (!heatMaps.empty() && spHeatMapBinarySaver != nullptr)
+            {
+                // Background thread (the heat maps are copied since the caller might modify them afterwards)
+                if (spAsyncJobQueue != nullptr)
+                {
+                    const auto heatMapBinarySaver = spHeatMapBinarySaver;
+                    spAsyncJobQueue->push(
+                        [heatMapBinarySaver, heatMaps, fileName]
+                        {
+                            heatMapBinarySaver->save(heatMaps, fileName);
+                        });
+                }
+                // Calling thread
+                else
+                    spHeatMapBinarySaver->save(heatMaps, fileName);
+            }
+            // Other formats: dense version
+            else if (!heatMaps.empty())
+            {
+                std::vector<Array<float>> heatMapsDense(heatMaps.size());
+                for (auto i = 0u; i < heatMaps.size(); i++)
+                    heatMapsDense[i] = heatMaps[i].toDense();
+                saveHeatMaps(heatMapsDense, fileName);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 }
@@ -1,16 +1,26 @@
 #include <openpose/filestream/imageSaver.hpp>
 #include <openpose/filestream/fileStream.hpp>
+#include <openpose_private/filestream/asyncFileWriter.hpp>
+#include <openpose_private/filestream/jpegEncoderGpu.hpp>
+#include <openpose_private/utilities/asyncJobQueue.hpp>
 
 namespace op
 {
-    ImageSaver::ImageSaver(const std::string& directoryPath, const std::string& imageFormat) :
+    ImageSaver::ImageSaver(const std::string& directoryPath, const std::string& imageFormat, const int numberThreads,
+                           const bool gpuEncoding) :
         FileSaver{directoryPath},
-        mImageFormat{imageFormat}
+        mImageFormat{imageFormat},
+        spAsyncJobQueue{gpuEncoding && isJpegFormat(imageFormat) ? nullptr : createEncoderJobQueue(numberThreads)},
+        spJpegEncoderGpu{gpuEncoding && isJpegFormat(imageFormat) ? std::make_shared<JpegEncoderGpu>() : nullptr},
+        spAsyncFileWriter{spJpegEncoderGpu != nullptr ? std::make_shared<AsyncFileWriter>() : nullptr}
     {
         try
         {
             if (mImageFormat.empty())
                 error("The string imageFormat should not be empty.", __LINE__, __FUNCTION__, __FILE__);
+            if (gpuEncoding && spJpegEncoderGpu == nullptr)
+                opLog("Warning: Only the JPEG images (`jpg` or `jpeg`) can be encoded on the GPU, so the `"
+                      + mImageFormat + "` ones are encoded on the CPU.", Priority::High);
         }
         catch (const std::exception& e)
         {
@@ -34,7 +44,8 @@ namespace op
         }
     }
 
-    void ImageSaver::saveImages(const std::vector<Matrix>& matOutputDatas, const std::string& fileName) const
+    void ImageSaver::saveImages(const std::vector<Matrix>& matOutputDatas, const std::string& fileName,
+                                const std::vector<RenderTargetGpu>& renderTargets) const
     {
         try
         {
@@ -49,9 +60,30 @@ namespace op
                 for (auto i = 0u; i < fileNames.size(); i++)
                     fileNames[i] = {fileNameNoExtension + (i != 0 ? "_" + std::to_string(i) : "") + "." + mImageFormat};
 
+                // GPU encoding (all the images at once) and background writing
+                if (spJpegEncoderGpu != nullptr)
+                {
+                    std::vector<std::string> jpegs;
+                    spJpegEncoderGpu->encode(jpegs, matOutputDatas, renderTargets);
+                    for (auto i = 0u; i < jpegs.size(); i++)
+                        spAsyncFileWriter->write(fileNames[i], std::move(jpegs[i]));
+                    return;
+                }
+
                 // Save each image
                 for (auto i = 0u; i < matOutputDatas.size(); i++)
-                    saveImage(matOutputDatas[i], fileNames[i]);
+                {
+                    // Background threads (the image is copied since the caller might modify it afterwards)
+                    if (spAsyncJobQueue != nullptr)
+                    {
+                        const auto matOutputData = matOutputDatas[i].clone();
+                        const auto& fileNameI = fileNames[i];
+                        spAsyncJobQueue->push([matOutputData, fileNameI]{ saveImage(matOutputData, fileNameI); });
+                    }
+                    // Calling thread
+                    else
+                        saveImage(matOutputDatas[i], fileNames[i]);
+                }
             }
         }
         catch (const std::exception& e)
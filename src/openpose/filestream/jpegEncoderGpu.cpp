@@ -0,0 +1,233 @@
+#include <openpose_private/filestream/jpegEncoderGpu.hpp>
+#include <opencv2/core/core.hpp> // cv::Mat
+#ifdef USE_NVJPEG
+    #include <cuda_runtime_api.h>
+    #include <nvjpeg.h>
+    #include <openpose/gpu/cuda.hpp>
+    #include <openpose/gpu/cudaMemoryPool.hpp>
+#endif
+#include <openpose/utilities/allocationTracker.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/string.hpp>
+
+namespace op
+{
+    #ifdef USE_NVJPEG
+        namespace
+        {
+            void nvjpegCheck(const nvjpegStatus_t status, const int line, const std::string& function,
+                             const std::string& file)
+            {
+                if (status != NVJPEG_STATUS_SUCCESS)
+                    error("nvJPEG error (nvjpegStatus_t " + std::to_string(int(status)) + ").", line, function, file);
+            }
+        }
+    #endif
+
+    bool isJpegFormat(const std::string& imageFormat)
+    {
+        try
+        {
+            const auto imageFormatLower = toLower(imageFormat);
+            return imageFormatLower == "jpg" || imageFormatLower == "jpeg";
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    struct JpegEncoderGpu::ImplJpegEncoderGpu
+    {
+        #ifdef USE_NVJPEG
+            const int mQuality;
+            bool mInitialized;
+            int mGpuId;
+            nvjpegHandle_t mHandle;
+            // 1 set of parameters for the BGR images (4:2:0 chroma subsampling, as cv::imwrite) and 1 for the
+            // grayscale ones
+            nvjpegEncoderParams_t mParamsBgr;
+            nvjpegEncoderParams_t mParamsGray;
+            // 1 state per image of the batch (each one keeps its bitstream until it is retrieved)
+            std::vector<nvjpegEncoderState_t> mStates;
+
+            ImplJpegEncoderGpu(const int quality) :
+                mQuality{fastTruncate(quality, 1, 100)},
+                mInitialized{false},
+                mGpuId{0}
+            {
+            }
+
+            ~ImplJpegEncoderGpu()
+            {
+                if (mInitialized)
+                {
+                    int currentGpuId;
+                    cudaGetDevice(&currentGpuId);
+                    cudaSetDevice(mGpuId);
+                    for (auto& state : mStates)
+                        nvjpegEncoderStateDestroy(state);
+                    nvjpegEncoderParamsDestroy(mParamsGray);
+                    nvjpegEncoderParamsDestroy(mParamsBgr);
+                    nvjpegDestroy(mHandle);
+                    cudaSetDevice(currentGpuId);
+                }
+            }
+
+            // It is initialized on the device of the first encode() call (i.e., on the thread using it)
+            void initialize()
+            {
+                try
+                {
+                    if (!mInitialized)
+                    {
+                        cudaGetDevice(&mGpuId);
+                        nvjpegCheck(nvjpegCreateSimple(&mHandle), __LINE__, __FUNCTION__, __FILE__);
+                        nvjpegCheck(nvjpegEncoderParamsCreate(mHandle, &mParamsBgr, nullptr),
+                                    __LINE__, __FUNCTION__, __FILE__);
+                        nvjpegCheck(nvjpegEncoderParamsCreate(mHandle, &mParamsGray, nullptr),
+                                    __LINE__, __FUNCTION__, __FILE__);
+                        mInitialized = true;
+                        for (auto* params : {&mParamsBgr, &mParamsGray})
+                            nvjpegCheck(nvjpegEncoderParamsSetQuality(*params, mQuality, nullptr),
+                                        __LINE__, __FUNCTION__, __FILE__);
+                        nvjpegCheck(nvjpegEncoderParamsSetSamplingFactors(mParamsBgr, NVJPEG_CSS_420, nullptr),
+                                    __LINE__, __FUNCTION__, __FILE__);
+                        nvjpegCheck(nvjpegEncoderParamsSetSamplingFactors(mParamsGray, NVJPEG_CSS_GRAY, nullptr),
+                                    __LINE__, __FUNCTION__, __FILE__);
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+        #endif
+    };
+
+    JpegEncoderGpu::JpegEncoderGpu(const int quality)
+    {
+        try
+        {
+            #ifdef USE_NVJPEG
+                upImpl.reset(new ImplJpegEncoderGpu{quality});
+            #else
+                UNUSED(quality);
+                error("OpenPose must be compiled with the `WITH_NVJPEG` CMake flag in order to encode the JPEG"
+                      " images on the GPU (`--write_jpg_gpu`).", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    JpegEncoderGpu::~JpegEncoderGpu()
+    {
+    }
+
+    void JpegEncoderGpu::encode(
+        std::vector<std::string>& jpegs, const std::vector<Matrix>& images,
+        const std::vector<RenderTargetGpu>& renderTargets)
+    {
+        try
+        {
+            #ifdef USE_NVJPEG
+                jpegs.resize(images.size());
+                if (images.empty())
+                    return;
+                upImpl->initialize();
+                int currentGpuId;
+                cudaGetDevice(&currentGpuId);
+                cudaSetDevice(upImpl->mGpuId);
+                while (upImpl->mStates.size() < images.size())
+                {
+                    upImpl->mStates.emplace_back();
+                    nvjpegCheck(nvjpegEncoderStateCreate(upImpl->mHandle, &upImpl->mStates.back(), nullptr),
+                                __LINE__, __FUNCTION__, __FILE__);
+                }
+                // GPU images (from the pool, so they are not re-allocated on every frame)
+                std::vector<unsigned char*> gpuImages(images.size(), nullptr);
+                std::string errorMessage;
+                try
+                {
+                    // Upload or cast and encode each image (asynchronously)
+                    for (auto i = 0u ; i < images.size() ; i++)
+                    {
+                        const cv::Mat cvMat = OP_OP2CVCONSTMAT(images[i]);
+                        if (cvMat.empty() || cvMat.depth() != CV_8U
+                            || (cvMat.channels() != 3 && cvMat.channels() != 1))
+                            error("Only non-empty CV_8UC3 and CV_8UC1 images can be encoded.",
+                                  __LINE__, __FUNCTION__, __FILE__);
+                        const auto channels = cvMat.channels();
+                        const auto volume = (unsigned long long)channels * cvMat.cols * cvMat.rows;
+                        gpuImages[i] = (unsigned char*)cudaPoolMalloc(volume);
+                        // Render target (float BGR, on this GPU) --> unsigned char
+                        const auto useRenderTarget = (
+                            i < renderTargets.size() && !renderTargets[i].empty() && renderTargets[i].upToDate
+                            && renderTargets[i].gpuId == upImpl->mGpuId && channels == 3
+                            && renderTargets[i].width == cvMat.cols && renderTargets[i].height == cvMat.rows);
+                        if (useRenderTarget)
+                            uCharImageCast(gpuImages[i], renderTargets[i].dataPtr.get(), (int)volume);
+                        // CPU image --> GPU
+                        else
+                        {
+                            cudaMemcpy2D(
+                                gpuImages[i], channels * cvMat.cols, cvMat.data, cvMat.step[0],
+                                channels * cvMat.cols, cvMat.rows, cudaMemcpyHostToDevice);
+                            AllocationTracker::recordCopy(volume, MemoryCopy::HostToDevice);
+                        }
+                        nvjpegImage_t nvjpegImage{};
+                        nvjpegImage.channel[0] = gpuImages[i];
+                        nvjpegImage.pitch[0] = (size_t)(channels * cvMat.cols);
+                        if (channels == 3)
+                            nvjpegCheck(nvjpegEncodeImage(
+                                upImpl->mHandle, upImpl->mStates[i], upImpl->mParamsBgr, &nvjpegImage,
+                                NVJPEG_INPUT_BGRI, cvMat.cols, cvMat.rows, nullptr), __LINE__, __FUNCTION__, __FILE__);
+                        else
+                            nvjpegCheck(nvjpegEncodeYUV(
+                                upImpl->mHandle, upImpl->mStates[i], upImpl->mParamsGray, &nvjpegImage,
+                                NVJPEG_CSS_GRAY, cvMat.cols, cvMat.rows, nullptr), __LINE__, __FUNCTION__, __FILE__);
+                    }
+                    // Single synchronization for the whole batch
+                    cudaStreamSynchronize(nullptr);
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    // Compressed bytes --> CPU
+                    for (auto i = 0u ; i < images.size() ; i++)
+                    {
+                        size_t length;
+                        nvjpegCheck(nvjpegEncodeRetrieveBitstream(
+                            upImpl->mHandle, upImpl->mStates[i], nullptr, &length, nullptr),
+                            __LINE__, __FUNCTION__, __FILE__);
+                        jpegs[i].resize(length);
+                        nvjpegCheck(nvjpegEncodeRetrieveBitstream(
+                            upImpl->mHandle, upImpl->mStates[i], (unsigned char*)&jpegs[i][0], &length, nullptr),
+                            __LINE__, __FUNCTION__, __FILE__);
+                        jpegs[i].resize(length);
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    errorMessage = e.what();
+                }
+                for (auto* gpuImage : gpuImages)
+                    cudaPoolFree(gpuImage);
+                cudaSetDevice(currentGpuId);
+                if (!errorMessage.empty())
+                    error(errorMessage, __LINE__, __FUNCTION__, __FILE__);
+            #else
+                UNUSED(jpegs);
+                UNUSED(images);
+                UNUSED(renderTargets);
+                error("OpenPose must be compiled with the `WITH_NVJPEG` CMake flag in order to encode the JPEG"
+                      " images on the GPU (`--write_jpg_gpu`).", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
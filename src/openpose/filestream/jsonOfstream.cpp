@@ -1,17 +1,145 @@
 #include <openpose/filestream/jsonOfstream.hpp>
+#include <algorithm> // std::reverse
+#include <array>
+#include <cmath> // std::frexp, std::isfinite, std::isnan, std::llround, std::signbit
+#include <cstdio> // std::snprintf
+#include <cstdlib> // std::strtod
 
 namespace op
 {
-    void enterAndTab(std::ofstream& ofstream, const bool humanReadable, const long long bracesCounter,
+    // Size of the buffer of the file JsonOfstreams before writing it (e.g., for the COCO JSON files with many frames)
+    const auto JSON_FILE_BUFFER_SIZE = 4ull << 20;
+
+    // 10^exponent for exponent in [-60, 60] (the ones out of [0, 22] are not exact, but their relative error is
+    // ~1e-16, far below the float precision)
+    double getPow10(const int exponent)
+    {
+        static const auto sPow10 = []
+        {
+            std::array<double, 121> pow10;
+            pow10[60] = 1.;
+            for (auto i = 1 ; i <= 60 ; i++)
+            {
+                pow10[60+i] = pow10[60+i-1] * 10.;
+                pow10[60-i] = 1. / pow10[60+i];
+            }
+            return pow10;
+        }();
+        return sPow10[60+exponent];
+    }
+
+    // Shortest decimal representation of value that reads back to the same float (equivalent to std::to_chars),
+    // in fixed notation if its exponent is in [-5, 20] (e.g., "0", "12.5", "0.000123") or in scientific notation
+    // otherwise (e.g., "1.5e-07"). The digits are found in double precision (~1e-16 relative error), which is far
+    // below the float precision (~6e-8), so the output always round-trips.
+    void appendShortestFloat(std::string& text, const float value)
+    {
+        if (!std::isfinite(value))
+        {
+            // Same output than std::ofstream
+            text.append(std::isnan(value) ? "nan" : (value < 0.f ? "-inf" : "inf"));
+            return;
+        }
+        if (std::signbit(value))
+            text.push_back('-');
+        const auto absValue = std::abs(value);
+        if (absValue == 0.f)
+        {
+            text.push_back('0');
+            return;
+        }
+        // Decimal exponent of the first digit
+        const auto absValueDouble = (double)absValue;
+        auto binaryExponent = 0;
+        std::frexp(absValueDouble, &binaryExponent);
+        // log10(absValue) is in [(binaryExponent-1)*log10(2), binaryExponent*log10(2))
+        auto firstExponent = (int)std::floor((binaryExponent - 1) * 0.30102999566398120);
+        if (absValueDouble >= getPow10(firstExponent + 1))
+            firstExponent++;
+        // Fewest digits (up to 9, which are enough for any float) that read back to the same value. If p digits do,
+        // p+1 digits also do (the p-digit one is 1 of them), so it is a binary search
+        const auto roundToDigits = [&](const int numberDigits, unsigned long long& digits, int& lastExponent)
+        {
+            lastExponent = firstExponent - numberDigits + 1;
+            digits = (unsigned long long)std::llround(absValueDouble * getPow10(-lastExponent));
+            const auto candidate = digits * getPow10(lastExponent);
+            return (float)candidate == absValue;
+        };
+        auto digits = 0ull;
+        auto lastExponent = 0;
+        auto minDigits = 1;
+        auto maxDigits = 9;
+        while (minDigits < maxDigits)
+        {
+            const auto numberDigits = (minDigits + maxDigits) / 2;
+            if (roundToDigits(numberDigits, digits, lastExponent))
+                maxDigits = numberDigits;
+            else
+                minDigits = numberDigits + 1;
+        }
+        roundToDigits(maxDigits, digits, lastExponent);
+        // Digits to text (the rounding might add 1 digit, e.g., 9.99 to 10)
+        char digitsText[24];
+        auto numberDigits = 0;
+        for (auto remainingDigits = digits ; remainingDigits > 0 || numberDigits == 0 ; remainingDigits /= 10)
+            digitsText[numberDigits++] = char('0' + remainingDigits % 10);
+        std::reverse(digitsText, digitsText + numberDigits);
+        while (numberDigits > 1 && digitsText[numberDigits-1] == '0')
+        {
+            numberDigits--;
+            lastExponent++;
+        }
+        firstExponent = lastExponent + numberDigits - 1;
+        // Fixed notation
+        if (firstExponent >= -5 && firstExponent <= 20)
+        {
+            // Integer
+            if (lastExponent >= 0)
+            {
+                text.append(digitsText, numberDigits);
+                text.append(lastExponent, '0');
+            }
+            // 0.xxx
+            else if (firstExponent < 0)
+            {
+                text.append("0.");
+                text.append(-firstExponent - 1, '0');
+                text.append(digitsText, numberDigits);
+            }
+            // x.xxx
+            else
+            {
+                text.append(digitsText, firstExponent + 1);
+                text.push_back('.');
+                text.append(digitsText + firstExponent + 1, numberDigits - firstExponent - 1);
+            }
+        }
+        // Scientific notation
+        else
+        {
+            text.push_back(digitsText[0]);
+            if (numberDigits > 1)
+            {
+                text.push_back('.');
+                text.append(digitsText + 1, numberDigits - 1);
+            }
+            char exponentText[8];
+            const auto exponentLength = std::snprintf(
+                exponentText, sizeof(exponentText), "e%c%02d", (firstExponent < 0 ? '-' : '+'),
+                std::abs(firstExponent));
+            text.append(exponentText, exponentLength);
+        }
+    }
+
+    void enterAndTab(std::string& jsonString, const bool humanReadable, const long long bracesCounter,
                      const long long bracketsCounter)
     {
         try
         {
             if (humanReadable)
             {
-                ofstream << "\n";
-                for (auto i = 0ll ; i < bracesCounter + bracketsCounter ; i++)
-                    ofstream << "\t";
+                jsonString.push_back('\n');
+                jsonString.append((std::size_t)(bracesCounter + bracketsCounter), '\t');
             }
         }
         catch (const std::exception& e)
@@ -24,7 +152,9 @@ namespace op
         mHumanReadable{humanReadable},
         mBracesCounter{0},
         mBracketsCounter{0},
-        upOfstream{new std::ofstream{filePath}}
+        upOfstream{new std::ofstream{filePath}},
+        upFileString{new std::string{}},
+        pJsonString{upFileString.get()}
     {
         try
         {
@@ -37,6 +167,23 @@ namespace op
         }
     }
 
+    JsonOfstream::JsonOfstream(std::string* const jsonString, const bool humanReadable) :
+        mHumanReadable{humanReadable},
+        mBracesCounter{0},
+        mBracketsCounter{0},
+        pJsonString{jsonString}
+    {
+        try
+        {
+            if (pJsonString == nullptr)
+                error("The JSON string cannot be a nullptr.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     JsonOfstream::JsonOfstream(JsonOfstream&& jsonOfstream) :
         mHumanReadable{jsonOfstream.mHumanReadable},
         mBracesCounter{jsonOfstream.mBracesCounter},
@@ -45,6 +192,9 @@ namespace op
         try
         {
             upOfstream = std::move(jsonOfstream.upOfstream);
+            upFileString = std::move(jsonOfstream.upFileString);
+            pJsonString = jsonOfstream.pJsonString;
+            jsonOfstream.pJsonString = nullptr;
             // std::swap(upOfstream, jsonOfstream.upOfstream);
         }
         catch (const std::exception& e)
@@ -61,6 +211,9 @@ namespace op
             mBracesCounter = jsonOfstream.mBracesCounter;
             mBracketsCounter = jsonOfstream.mBracketsCounter;
             upOfstream = std::move(jsonOfstream.upOfstream);
+            upFileString = std::move(jsonOfstream.upFileString);
+            pJsonString = jsonOfstream.pJsonString;
+            jsonOfstream.pJsonString = nullptr;
             // std::swap(upOfstream, jsonOfstream.upOfstream);
             // Return
             return *this;
@@ -77,9 +230,15 @@ namespace op
         try
         {
             // Moved(std::unique_ptr) will be a nullptr in the old one
-            if (upOfstream != nullptr)
+            if (pJsonString != nullptr)
             {
-                enterAndTab(*upOfstream, mHumanReadable, mBracesCounter, mBracketsCounter);
+                enterAndTab(*pJsonString, mHumanReadable, mBracesCounter, mBracketsCounter);
+                // Write the rest of the buffer (file version)
+                if (upOfstream != nullptr)
+                {
+                    upOfstream->write(pJsonString->data(), pJsonString->size());
+                    pJsonString->clear();
+                }
 
                 if (mBracesCounter != 0 || mBracketsCounter != 0)
                 {
@@ -105,7 +264,7 @@ namespace op
         try
         {
             mBracesCounter++;
-            *upOfstream << "{";
+            pJsonString->push_back('{');
         }
         catch (const std::exception& e)
         {
@@ -118,8 +277,9 @@ namespace op
         try
         {
             mBracesCounter--;
-            enterAndTab(*upOfstream, mHumanReadable, mBracesCounter, mBracketsCounter);
-            *upOfstream << "}";
+            enterAndTab(*pJsonString, mHumanReadable, mBracesCounter, mBracketsCounter);
+            pJsonString->push_back('}');
+            flushIfFull();
         }
         catch (const std::exception& e)
         {
@@ -132,8 +292,8 @@ namespace op
         try
         {
             mBracketsCounter++;
-            *upOfstream << "[";
-            enterAndTab(*upOfstream, mHumanReadable, mBracesCounter, mBracketsCounter);
+            pJsonString->push_back('[');
+            enterAndTab(*pJsonString, mHumanReadable, mBracesCounter, mBracketsCounter);
         }
         catch (const std::exception& e)
         {
@@ -146,8 +306,9 @@ namespace op
         try
         {
             mBracketsCounter--;
-            enterAndTab(*upOfstream, mHumanReadable, mBracesCounter, mBracketsCounter);
-            *upOfstream << "]";
+            enterAndTab(*pJsonString, mHumanReadable, mBracesCounter, mBracketsCounter);
+            pJsonString->push_back(']');
+            flushIfFull();
         }
         catch (const std::exception& e)
         {
@@ -172,8 +333,10 @@ namespace op
     {
         try
         {
-            enterAndTab(*upOfstream, mHumanReadable, mBracesCounter, mBracketsCounter);
-            *upOfstream << "\"" + string + "\":";
+            enterAndTab(*pJsonString, mHumanReadable, mBracesCounter, mBracketsCounter);
+            pJsonString->push_back('"');
+            pJsonString->append(string);
+            pJsonString->append("\":");
         }
         catch (const std::exception& e)
         {
@@ -185,7 +348,87 @@ namespace op
     {
         try
         {
-            enterAndTab(*upOfstream, mHumanReadable, mBracesCounter, mBracketsCounter);
+            enterAndTab(*pJsonString, mHumanReadable, mBracesCounter, mBracketsCounter);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void JsonOfstream::plainText(const std::string& text)
+    {
+        try
+        {
+            pJsonString->append(text);
+            // E.g., big chunks of text when merging COCO JSON shards
+            flushIfFull();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void JsonOfstream::plainText(const char* const text)
+    {
+        try
+        {
+            pJsonString->append(text);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void JsonOfstream::plainText(const float value)
+    {
+        try
+        {
+            appendShortestFloat(*pJsonString, value);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void JsonOfstream::plainText(const double value)
+    {
+        try
+        {
+            if (!std::isfinite(value))
+                pJsonString->append(std::isnan(value) ? "nan" : (value < 0. ? "-inf" : "inf"));
+            else
+            {
+                // Shortest of 15-17 significant digits that reads back to the same double
+                char text[32];
+                auto length = 0;
+                for (auto precision = 15 ; precision <= 17 ; precision++)
+                {
+                    length = std::snprintf(text, sizeof(text), "%.*g", precision, value);
+                    if (std::strtod(text, nullptr) == value)
+                        break;
+                }
+                pJsonString->append(text, length);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void JsonOfstream::flushIfFull()
+    {
+        try
+        {
+            if (upOfstream != nullptr && pJsonString->size() > JSON_FILE_BUFFER_SIZE)
+            {
+                upOfstream->write(pJsonString->data(), pJsonString->size());
+                pJsonString->clear();
+            }
         }
         catch (const std::exception& e)
         {
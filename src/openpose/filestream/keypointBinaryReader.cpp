@@ -0,0 +1,196 @@
+#include <openpose/filestream/keypointBinaryReader.hpp>
+#include <cstring> // std::memcmp, std::memcpy
+#include <map>
+#include <openpose_private/filestream/keypointBinaryFormat.hpp>
+#include <openpose_private/utilities/memoryMappedFile.hpp>
+
+namespace op
+{
+    struct KeypointBinaryReader::ImplKeypointBinaryReader
+    {
+        std::unique_ptr<MemoryMappedFile> upMemoryMappedFile;
+        std::vector<uint64_t> mFrameOffsets;
+        // (sourceId, frameId) to frame index
+        std::map<std::pair<uint64_t, uint64_t>, unsigned long long> mFrameIndexes;
+
+        explicit ImplKeypointBinaryReader(const std::string& filePath) :
+            upMemoryMappedFile{new MemoryMappedFile{filePath}}
+        {
+        }
+    };
+
+    namespace
+    {
+        template<typename T>
+        void readColumn(
+            Array<T>& keypoints, const unsigned char* const dataPtr, const KeypointBinaryColumnHeader& columnHeader,
+            const bool isPersonIds)
+        {
+            try
+            {
+                if (isPersonIds)
+                    keypoints.reset((int)columnHeader.numberPeople);
+                else
+                    keypoints.reset({(int)columnHeader.numberPeople, (int)columnHeader.numberParts,
+                                     (int)columnHeader.numberChannels});
+                std::memcpy(keypoints.getPtr(), dataPtr, keypoints.getVolume() * sizeof(T));
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+    }
+
+    KeypointBinaryReader::KeypointBinaryReader(const std::string& filePath) :
+        upImpl{new ImplKeypointBinaryReader{filePath}}
+    {
+        try
+        {
+            const auto* const filePtr = upImpl->upMemoryMappedFile->getData();
+            const auto fileSize = upImpl->upMemoryMappedFile->getSize();
+            // File header
+            KeypointBinaryFileHeader fileHeader;
+            if (fileSize < sizeof(KeypointBinaryFileHeader))
+                error("File " + filePath + " is not an OpenPose keypoint binary file.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            std::memcpy(&fileHeader, filePtr, sizeof(KeypointBinaryFileHeader));
+            if (std::memcmp(fileHeader.magic, KEYPOINT_BINARY_MAGIC, sizeof(fileHeader.magic)) != 0)
+                error("File " + filePath + " is not an OpenPose keypoint binary file.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (fileHeader.version != KEYPOINT_BINARY_VERSION)
+                error("Version " + std::to_string(fileHeader.version) + " of file " + filePath
+                      + " is not supported (only " + std::to_string(KEYPOINT_BINARY_VERSION) + ").",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Index of frames (only their headers are read)
+            auto offset = (uint64_t)sizeof(KeypointBinaryFileHeader);
+            while (offset < fileSize)
+            {
+                KeypointBinaryFrameHeader frameHeader;
+                if (fileSize - offset < sizeof(KeypointBinaryFrameHeader))
+                    break;
+                std::memcpy(&frameHeader, filePtr + offset, sizeof(KeypointBinaryFrameHeader));
+                if (frameHeader.magic != KEYPOINT_BINARY_FRAME_MAGIC
+                    || frameHeader.frameBytes < sizeof(KeypointBinaryFrameHeader)
+                        + frameHeader.numberColumns * sizeof(KeypointBinaryColumnHeader)
+                    || frameHeader.frameBytes > fileSize - offset)
+                    break;
+                upImpl->mFrameIndexes.emplace(
+                    std::make_pair(frameHeader.sourceId, frameHeader.frameId), upImpl->mFrameOffsets.size());
+                upImpl->mFrameOffsets.emplace_back(offset);
+                offset += frameHeader.frameBytes;
+            }
+            if (offset < fileSize)
+                opLog("The last " + std::to_string(fileSize - offset) + " bytes of " + filePath + " are not a"
+                      " complete frame (e.g., the program was stopped while saving it), so they are ignored.",
+                      Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    KeypointBinaryReader::~KeypointBinaryReader()
+    {
+    }
+
+    unsigned long long KeypointBinaryReader::getNumberFrames() const
+    {
+        try
+        {
+            return upImpl->mFrameOffsets.size();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    long long KeypointBinaryReader::getFrameIndex(
+        const unsigned long long frameId, const unsigned long long sourceId) const
+    {
+        try
+        {
+            const auto frameIndex = upImpl->mFrameIndexes.find(std::make_pair(sourceId, frameId));
+            return (frameIndex != upImpl->mFrameIndexes.end() ? (long long)frameIndex->second : -1ll);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1ll;
+        }
+    }
+
+    void KeypointBinaryReader::readFrame(Datum& datum, const unsigned long long frameIndex) const
+    {
+        try
+        {
+            if (frameIndex >= upImpl->mFrameOffsets.size())
+                error("Frame " + std::to_string(frameIndex) + " out of bounds (the file contains "
+                      + std::to_string(upImpl->mFrameOffsets.size()) + " frames).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            const auto* const framePtr = upImpl->upMemoryMappedFile->getData() + upImpl->mFrameOffsets[frameIndex];
+            KeypointBinaryFrameHeader frameHeader;
+            std::memcpy(&frameHeader, framePtr, sizeof(KeypointBinaryFrameHeader));
+            datum.id = frameHeader.frameId;
+            datum.frameNumber = frameHeader.frameNumber;
+            datum.sourceId = frameHeader.sourceId;
+            datum.subId = frameHeader.subId;
+            // Columns not saved are empty
+            datum.poseIds.reset();
+            datum.poseKeypoints.reset();
+            datum.faceKeypoints.reset();
+            datum.handKeypoints[0].reset();
+            datum.handKeypoints[1].reset();
+            datum.poseKeypoints3D.reset();
+            datum.faceKeypoints3D.reset();
+            datum.handKeypoints3D[0].reset();
+            datum.handKeypoints3D[1].reset();
+            auto dataOffset = (uint64_t)(sizeof(KeypointBinaryFrameHeader)
+                                         + frameHeader.numberColumns * sizeof(KeypointBinaryColumnHeader));
+            for (auto columnIndex = 0u ; columnIndex < frameHeader.numberColumns ; columnIndex++)
+            {
+                KeypointBinaryColumnHeader columnHeader;
+                std::memcpy(
+                    &columnHeader,
+                    framePtr + sizeof(KeypointBinaryFrameHeader) + columnIndex * sizeof(KeypointBinaryColumnHeader),
+                    sizeof(KeypointBinaryColumnHeader));
+                const auto column = KeypointBinaryColumn(columnHeader.column);
+                const auto elementBytes = (column == KeypointBinaryColumn::PersonIds
+                                           ? sizeof(long long) : sizeof(float));
+                const auto dataBytes = keypointBinaryPaddedBytes(
+                    (uint64_t)columnHeader.numberPeople * columnHeader.numberParts * columnHeader.numberChannels
+                    * elementBytes);
+                if (dataOffset + dataBytes > frameHeader.frameBytes)
+                    error("Frame " + std::to_string(frameIndex) + " is corrupted.", __LINE__, __FUNCTION__, __FILE__);
+                const auto* const dataPtr = framePtr + dataOffset;
+                if (column == KeypointBinaryColumn::PersonIds)
+                    readColumn(datum.poseIds, dataPtr, columnHeader, true);
+                else if (column == KeypointBinaryColumn::PoseKeypoints)
+                    readColumn(datum.poseKeypoints, dataPtr, columnHeader, false);
+                else if (column == KeypointBinaryColumn::FaceKeypoints)
+                    readColumn(datum.faceKeypoints, dataPtr, columnHeader, false);
+                else if (column == KeypointBinaryColumn::HandLeftKeypoints)
+                    readColumn(datum.handKeypoints[0], dataPtr, columnHeader, false);
+                else if (column == KeypointBinaryColumn::HandRightKeypoints)
+                    readColumn(datum.handKeypoints[1], dataPtr, columnHeader, false);
+                else if (column == KeypointBinaryColumn::PoseKeypoints3D)
+                    readColumn(datum.poseKeypoints3D, dataPtr, columnHeader, false);
+                else if (column == KeypointBinaryColumn::FaceKeypoints3D)
+                    readColumn(datum.faceKeypoints3D, dataPtr, columnHeader, false);
+                else if (column == KeypointBinaryColumn::HandLeftKeypoints3D)
+                    readColumn(datum.handKeypoints3D[0], dataPtr, columnHeader, false);
+                else if (column == KeypointBinaryColumn::HandRightKeypoints3D)
+                    readColumn(datum.handKeypoints3D[1], dataPtr, columnHeader, false);
+                // Unknown columns (e.g., from newer versions) are skipped
+                dataOffset += dataBytes;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
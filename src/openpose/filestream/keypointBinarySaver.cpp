@@ -0,0 +1,130 @@
+#include <openpose/filestream/keypointBinarySaver.hpp>
+#include <cstring> // std::memcpy
+#include <openpose_private/filestream/keypointBinaryFormat.hpp>
+
+namespace op
+{
+    namespace
+    {
+        template<typename T>
+        void appendColumn(
+            std::vector<char>& frameBuffer, KeypointBinaryFrameHeader& frameHeader, const std::size_t columnOffset,
+            const KeypointBinaryColumn column, const Array<T>& keypoints)
+        {
+            try
+            {
+                if (!keypoints.empty())
+                {
+                    // Column header
+                    KeypointBinaryColumnHeader columnHeader;
+                    columnHeader.column = (uint32_t)column;
+                    columnHeader.numberPeople = (uint32_t)keypoints.getSize(0);
+                    columnHeader.numberParts = (uint32_t)(keypoints.getNumberDimensions() > 1
+                        ? keypoints.getSize(1) : 1);
+                    columnHeader.numberChannels = (uint32_t)(keypoints.getNumberDimensions() > 2
+                        ? keypoints.getSize(2) : 1);
+                    if ((std::size_t)columnHeader.numberPeople * columnHeader.numberParts * columnHeader.numberChannels
+                        != keypoints.getVolume())
+                        error("Only arrays of up to 3 dimensions (people x parts x channels) can be saved.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    std::memcpy(
+                        &frameBuffer[columnOffset + frameHeader.numberColumns * sizeof(KeypointBinaryColumnHeader)],
+                        &columnHeader, sizeof(KeypointBinaryColumnHeader));
+                    frameHeader.numberColumns++;
+                    // Column data (padded to 8 bytes)
+                    const auto dataBytes = keypoints.getVolume() * sizeof(T);
+                    const auto dataOffset = frameBuffer.size();
+                    frameBuffer.resize(dataOffset + keypointBinaryPaddedBytes(dataBytes), 0);
+                    std::memcpy(&frameBuffer[dataOffset], keypoints.getConstPtr(), dataBytes);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+    }
+
+    KeypointBinarySaver::KeypointBinarySaver(const std::string& filePath) :
+        mFilePath{filePath},
+        mOfstream{filePath, std::ios::out | std::ios::binary | std::ios::trunc}
+    {
+        try
+        {
+            if (!mOfstream.is_open())
+                error("File " + filePath + " could not be opened.", __LINE__, __FUNCTION__, __FILE__);
+            KeypointBinaryFileHeader fileHeader;
+            std::memcpy(fileHeader.magic, KEYPOINT_BINARY_MAGIC, sizeof(fileHeader.magic));
+            fileHeader.version = KEYPOINT_BINARY_VERSION;
+            fileHeader.reserved = 0u;
+            mOfstream.write((const char*)&fileHeader, sizeof(KeypointBinaryFileHeader));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    KeypointBinarySaver::~KeypointBinarySaver()
+    {
+    }
+
+    void KeypointBinarySaver::save(const Datum& datum)
+    {
+        try
+        {
+            // Frame header
+            KeypointBinaryFrameHeader frameHeader;
+            frameHeader.magic = KEYPOINT_BINARY_FRAME_MAGIC;
+            frameHeader.numberColumns = 0u;
+            frameHeader.frameId = datum.id;
+            frameHeader.frameNumber = datum.frameNumber;
+            frameHeader.sourceId = datum.sourceId;
+            frameHeader.subId = datum.subId;
+            // Room for the headers of all the columns (the empty ones are removed later)
+            const auto columnOffset = sizeof(KeypointBinaryFrameHeader);
+            const auto maxNumberColumns = (std::size_t)KeypointBinaryColumn::Size;
+            mFrameBuffer.assign(columnOffset + maxNumberColumns * sizeof(KeypointBinaryColumnHeader), 0);
+            // Columns
+            appendColumn(mFrameBuffer, frameHeader, columnOffset, KeypointBinaryColumn::PersonIds, datum.poseIds);
+            appendColumn(
+                mFrameBuffer, frameHeader, columnOffset, KeypointBinaryColumn::PoseKeypoints, datum.poseKeypoints);
+            appendColumn(
+                mFrameBuffer, frameHeader, columnOffset, KeypointBinaryColumn::FaceKeypoints, datum.faceKeypoints);
+            appendColumn(
+                mFrameBuffer, frameHeader, columnOffset, KeypointBinaryColumn::HandLeftKeypoints,
+                datum.handKeypoints[0]);
+            appendColumn(
+                mFrameBuffer, frameHeader, columnOffset, KeypointBinaryColumn::HandRightKeypoints,
+                datum.handKeypoints[1]);
+            appendColumn(
+                mFrameBuffer, frameHeader, columnOffset, KeypointBinaryColumn::PoseKeypoints3D,
+                datum.poseKeypoints3D);
+            appendColumn(
+                mFrameBuffer, frameHeader, columnOffset, KeypointBinaryColumn::FaceKeypoints3D,
+                datum.faceKeypoints3D);
+            appendColumn(
+                mFrameBuffer, frameHeader, columnOffset, KeypointBinaryColumn::HandLeftKeypoints3D,
+                datum.handKeypoints3D[0]);
+            appendColumn(
+                mFrameBuffer, frameHeader, columnOffset, KeypointBinaryColumn::HandRightKeypoints3D,
+                datum.handKeypoints3D[1]);
+            // Remove the room of the unused column headers
+            const auto unusedBytes = (maxNumberColumns - frameHeader.numberColumns)
+                                   * sizeof(KeypointBinaryColumnHeader);
+            const auto dataOffset = columnOffset + maxNumberColumns * sizeof(KeypointBinaryColumnHeader);
+            mFrameBuffer.erase(
+                mFrameBuffer.begin() + (dataOffset - unusedBytes), mFrameBuffer.begin() + dataOffset);
+            frameHeader.frameBytes = mFrameBuffer.size();
+            std::memcpy(mFrameBuffer.data(), &frameHeader, sizeof(KeypointBinaryFrameHeader));
+            // Write the whole frame at once
+            mOfstream.write(mFrameBuffer.data(), mFrameBuffer.size());
+            if (!mOfstream.good())
+                error("Frame could not be written into " + mFilePath + ".", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -0,0 +1,410 @@
+#include <openpose_private/filestream/keypointCompression.hpp>
+#include <array>
+#include <cmath> // std::round
+#include <cstring> // std::memcpy
+
+namespace op
+{
+    namespace
+    {
+        // Quantized values are clamped to +-2^29, so their residuals fit into int32_t
+        const auto KEYPOINT_MAX_QUANTIZED = 536870912.f;
+        const auto KEYPOINT_RICE_CONTEXTS = 4u;
+
+        struct RiceContext
+        {
+            uint64_t sum;
+            uint32_t count;
+        };
+
+        typedef std::array<RiceContext, KEYPOINT_RICE_CONTEXTS> RiceContexts;
+
+        RiceContexts getInitialRiceContexts()
+        {
+            RiceContexts riceContexts;
+            for (auto& riceContext : riceContexts)
+                riceContext = RiceContext{16u, 1u};
+            return riceContexts;
+        }
+
+        // 0 = absolute coordinate, 1 = absolute score, 2 = residual coordinate, 3 = residual score
+        unsigned int getRiceContextIndex(const bool isResidual, const bool isScore)
+        {
+            return (isResidual ? 2u : 0u) + (isScore ? 1u : 0u);
+        }
+
+        unsigned int getRiceParameter(const RiceContext& riceContext)
+        {
+            auto k = 0u;
+            while (((uint64_t)riceContext.count << k) < riceContext.sum && k < 31u)
+                k++;
+            return k;
+        }
+
+        void updateRiceContext(RiceContext& riceContext, const uint32_t value)
+        {
+            riceContext.sum += value;
+            riceContext.count++;
+            if (riceContext.count >= KEYPOINT_RICE_RESET)
+            {
+                riceContext.sum >>= 1;
+                riceContext.count >>= 1;
+            }
+        }
+
+        uint32_t zigZag(const int32_t value)
+        {
+            return (value >= 0 ? 2u * (uint32_t)value : 2u * (uint32_t)(-(int64_t)value) - 1u);
+        }
+
+        int32_t unZigZag(const uint32_t value)
+        {
+            return ((value & 1u) == 0u ? (int32_t)(value >> 1) : -(int32_t)(value >> 1) - 1);
+        }
+
+        int32_t quantize(const float value, const float scale)
+        {
+            const auto scaledValue = value * scale;
+            // NaN
+            if (scaledValue != scaledValue)
+                return 0;
+            return (int32_t)std::round(
+                scaledValue < -KEYPOINT_MAX_QUANTIZED ? -KEYPOINT_MAX_QUANTIZED
+                    : (scaledValue > KEYPOINT_MAX_QUANTIZED ? KEYPOINT_MAX_QUANTIZED : scaledValue));
+        }
+
+        class BitWriter
+        {
+        public:
+            BitWriter() :
+                mNumberBits{0u}
+            {
+            }
+
+            void writeBits(const uint64_t value, const unsigned int numberBits)
+            {
+                for (auto bit = (int)numberBits - 1 ; bit >= 0 ; bit--)
+                    writeBit(((value >> bit) & 1u) != 0u);
+            }
+
+            void writeBit(const bool bit)
+            {
+                if ((mNumberBits & 7u) == 0u)
+                    mBytes.emplace_back(0u);
+                if (bit)
+                    mBytes.back() |= (unsigned char)(0x80u >> (mNumberBits & 7u));
+                mNumberBits++;
+            }
+
+            void writeExpGolomb(const uint64_t value)
+            {
+                const auto codedValue = value + 1u;
+                auto numberBits = 1u;
+                while (numberBits < 64u && (codedValue >> numberBits) != 0u)
+                    numberBits++;
+                writeBits(0u, numberBits - 1u);
+                writeBits(codedValue, numberBits);
+            }
+
+            void writeRice(const uint32_t value, RiceContext& riceContext)
+            {
+                const auto k = getRiceParameter(riceContext);
+                const auto quotient = value >> k;
+                if (quotient < KEYPOINT_RICE_ESCAPE)
+                {
+                    for (auto i = 0u ; i < quotient ; i++)
+                        writeBit(true);
+                    writeBit(false);
+                    writeBits(value, k);
+                }
+                else
+                {
+                    for (auto i = 0u ; i < KEYPOINT_RICE_ESCAPE ; i++)
+                        writeBit(true);
+                    writeBits(value, 32u);
+                }
+                updateRiceContext(riceContext, value);
+            }
+
+            uint64_t getNumberBits() const
+            {
+                return mNumberBits;
+            }
+
+            // It removes the bits written after the first numberBits ones
+            void truncate(const uint64_t numberBits)
+            {
+                mBytes.resize((numberBits + 7u) / 8u);
+                if ((numberBits & 7u) != 0u)
+                    mBytes.back() &= (unsigned char)(0xFF00u >> (numberBits & 7u));
+                mNumberBits = numberBits;
+            }
+
+            const std::vector<unsigned char>& getBytes() const
+            {
+                return mBytes;
+            }
+
+        private:
+            std::vector<unsigned char> mBytes;
+            uint64_t mNumberBits;
+        };
+
+        class BitReader
+        {
+        public:
+            BitReader(const unsigned char* const bytes, const uint64_t numberBytes) :
+                pBytes{bytes},
+                mNumberBits{8u * numberBytes},
+                mBitIndex{0u}
+            {
+            }
+
+            bool readBit()
+            {
+                if (mBitIndex >= mNumberBits)
+                    error("Corrupted keypoint packet (truncated compressed block).", __LINE__, __FUNCTION__, __FILE__);
+                const auto bit = ((pBytes[mBitIndex >> 3] >> (7u - (mBitIndex & 7u))) & 1u) != 0u;
+                mBitIndex++;
+                return bit;
+            }
+
+            uint64_t readBits(const unsigned int numberBits)
+            {
+                auto value = (uint64_t)0u;
+                for (auto i = 0u ; i < numberBits ; i++)
+                    value = (value << 1) | (readBit() ? 1u : 0u);
+                return value;
+            }
+
+            uint64_t readExpGolomb()
+            {
+                auto numberZeros = 0u;
+                while (!readBit())
+                    if (++numberZeros >= 64u)
+                        error("Corrupted keypoint packet (invalid poseId).", __LINE__, __FUNCTION__, __FILE__);
+                return (((uint64_t)1u << numberZeros) | readBits(numberZeros)) - 1u;
+            }
+
+            uint32_t readRice(RiceContext& riceContext)
+            {
+                const auto k = getRiceParameter(riceContext);
+                auto quotient = 0u;
+                while (quotient < KEYPOINT_RICE_ESCAPE && readBit())
+                    quotient++;
+                const auto value = (uint32_t)(quotient < KEYPOINT_RICE_ESCAPE
+                    ? ((uint64_t)quotient << k) | readBits(k) : readBits(32u));
+                updateRiceContext(riceContext, value);
+                return value;
+            }
+
+        private:
+            const unsigned char* const pBytes;
+            const uint64_t mNumberBits;
+            uint64_t mBitIndex;
+        };
+    }
+
+    KeypointCompressionState::KeypointCompressionState()
+    {
+        reset();
+    }
+
+    void KeypointCompressionState::reset()
+    {
+        valid = false;
+        sequence = 0u;
+        numberParts = 0u;
+        numberChannels = 0u;
+        people.clear();
+    }
+
+    unsigned int compressKeypoints(
+        std::vector<char>& packet, KeypointCompressionState& state, const Array<float>& keypoints,
+        const Array<long long>& poseIds, const float precision, const bool keyframe, const uint64_t sequence,
+        const unsigned int maxNumberPeople, const uint64_t maxBytes)
+    {
+        try
+        {
+            // Sanity checks
+            if (precision <= 0.f)
+                error("The precision must be positive.", __LINE__, __FUNCTION__, __FILE__);
+            if (keypoints.getNumberDimensions() != 3)
+                error("Only people x parts x channels keypoints can be compressed.", __LINE__, __FUNCTION__, __FILE__);
+            const auto numberPeople = (unsigned int)keypoints.getSize(0);
+            const auto numberParts = (uint32_t)keypoints.getSize(1);
+            const auto numberChannels = (uint32_t)keypoints.getSize(2);
+            const auto personVolume = numberParts * numberChannels;
+            const auto useIds = (poseIds.getVolume() == numberPeople);
+            const auto canRefer = (!keyframe && state.valid && state.numberParts == numberParts
+                                   && state.numberChannels == numberChannels);
+            const auto coordinateScale = 1.f / precision;
+            // Bitstream
+            BitWriter bitWriter;
+            auto riceContexts = getInitialRiceContexts();
+            std::map<long long, std::vector<int32_t>> people;
+            std::vector<int32_t> quantizedPerson(personVolume);
+            auto hasReference = false;
+            auto numberPeopleCompressed = 0u;
+            for (auto person = 0u ; person < numberPeople && person < maxNumberPeople ; person++)
+            {
+                // If this person does not fit, it is removed from the bitstream
+                const auto numberBitsBefore = bitWriter.getNumberBits();
+                const auto riceContextsBefore = riceContexts;
+                const auto poseId = (useIds && poseIds[person] >= 0 ? poseIds[person] : -1ll);
+                const auto* const keypointsPtr = keypoints.getConstPtr() + person * personVolume;
+                for (auto i = 0u ; i < personVolume ; i++)
+                    quantizedPerson[i] = quantize(
+                        keypointsPtr[i],
+                        (i % numberChannels == numberChannels - 1u ? KEYPOINT_SCORE_SCALE : coordinateScale));
+                std::map<long long, std::vector<int32_t>>::const_iterator reference = state.people.end();
+                if (canRefer && poseId >= 0)
+                    reference = state.people.find(poseId);
+                const auto isResidual = (reference != state.people.end());
+                bitWriter.writeBit(isResidual);
+                bitWriter.writeExpGolomb((uint64_t)(poseId + 1));
+                for (auto i = 0u ; i < personVolume ; i++)
+                {
+                    const auto isScore = (i % numberChannels == numberChannels - 1u);
+                    const auto value = quantizedPerson[i] - (isResidual ? reference->second[i] : 0);
+                    bitWriter.writeRice(zigZag(value), riceContexts[getRiceContextIndex(isResidual, isScore)]);
+                }
+                if (sizeof(KeypointCompressedBlockHeader) + (bitWriter.getNumberBits() + 7u) / 8u > maxBytes)
+                {
+                    bitWriter.truncate(numberBitsBefore);
+                    riceContexts = riceContextsBefore;
+                    break;
+                }
+                hasReference |= isResidual;
+                if (poseId >= 0)
+                    people[poseId] = quantizedPerson;
+                numberPeopleCompressed++;
+            }
+            // Block header + bitstream (padded to 8 bytes)
+            KeypointCompressedBlockHeader compressedBlockHeader;
+            compressedBlockHeader.referenceSequence = (hasReference ? state.sequence : 0u);
+            compressedBlockHeader.precision = precision;
+            compressedBlockHeader.flags = (hasReference ? KEYPOINT_COMPRESSED_REFERENCE : 0u);
+            compressedBlockHeader.dataBytes = (uint32_t)bitWriter.getBytes().size();
+            compressedBlockHeader.reserved = 0u;
+            const auto dataOffset = packet.size();
+            const auto dataBytes = sizeof(KeypointCompressedBlockHeader) + bitWriter.getBytes().size();
+            packet.resize(dataOffset + ((dataBytes + 7u) & ~(uint64_t)7u), 0);
+            std::memcpy(&packet[dataOffset], &compressedBlockHeader, sizeof(KeypointCompressedBlockHeader));
+            if (!bitWriter.getBytes().empty())
+                std::memcpy(&packet[dataOffset + sizeof(KeypointCompressedBlockHeader)], bitWriter.getBytes().data(),
+                            bitWriter.getBytes().size());
+            // Reference of the next packet
+            state.valid = true;
+            state.sequence = sequence;
+            state.numberParts = numberParts;
+            state.numberChannels = numberChannels;
+            std::swap(state.people, people);
+            return numberPeopleCompressed;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0u;
+        }
+    }
+
+    bool decompressKeypoints(
+        Array<float>& keypoints, Array<long long>& poseIds, KeypointCompressionState& state,
+        const KeypointPacketBlockHeader& blockHeader, const char* const data, const uint64_t dataBytes,
+        const uint64_t sequence)
+    {
+        try
+        {
+            keypoints.reset();
+            poseIds.reset();
+            const auto blockBytes = getCompressedBlockBytes(data, dataBytes);
+            if (blockBytes == 0u || blockBytes > dataBytes)
+                error("Corrupted keypoint packet.", __LINE__, __FUNCTION__, __FILE__);
+            KeypointCompressedBlockHeader compressedBlockHeader;
+            std::memcpy(&compressedBlockHeader, data, sizeof(KeypointCompressedBlockHeader));
+            if (!(compressedBlockHeader.precision > 0.f))
+                error("Corrupted keypoint packet (invalid precision).", __LINE__, __FUNCTION__, __FILE__);
+            const auto numberParts = blockHeader.numberParts;
+            const auto numberChannels = blockHeader.numberChannels;
+            // Its reference was not decoded (e.g., a lost UDP datagram)
+            if ((compressedBlockHeader.flags & KEYPOINT_COMPRESSED_REFERENCE) != 0u
+                && (!state.valid || state.sequence != compressedBlockHeader.referenceSequence
+                    || state.numberParts != numberParts || state.numberChannels != numberChannels))
+            {
+                state.reset();
+                return false;
+            }
+            // Bitstream
+            const auto personVolume = numberParts * numberChannels;
+            if (blockHeader.numberPeople > 0u && (numberChannels == 0u || personVolume == 0u))
+                error("Corrupted keypoint packet.", __LINE__, __FUNCTION__, __FILE__);
+            const auto precision = compressedBlockHeader.precision;
+            BitReader bitReader{
+                (const unsigned char*)data + sizeof(KeypointCompressedBlockHeader), compressedBlockHeader.dataBytes};
+            auto riceContexts = getInitialRiceContexts();
+            std::map<long long, std::vector<int32_t>> people;
+            std::vector<int32_t> quantizedPerson(personVolume);
+            if (blockHeader.numberPeople > 0u)
+            {
+                keypoints.reset({(int)blockHeader.numberPeople, (int)numberParts, (int)numberChannels});
+                poseIds.reset((int)blockHeader.numberPeople);
+            }
+            for (auto person = 0u ; person < blockHeader.numberPeople ; person++)
+            {
+                const auto isResidual = bitReader.readBit();
+                const auto poseId = (long long)bitReader.readExpGolomb() - 1ll;
+                std::map<long long, std::vector<int32_t>>::const_iterator reference = state.people.end();
+                if (isResidual)
+                {
+                    reference = state.people.find(poseId);
+                    if (reference == state.people.end())
+                        error("Corrupted keypoint packet (unknown poseId).", __LINE__, __FUNCTION__, __FILE__);
+                }
+                auto* const keypointsPtr = keypoints.getPtr() + person * personVolume;
+                for (auto i = 0u ; i < personVolume ; i++)
+                {
+                    const auto isScore = (i % numberChannels == numberChannels - 1u);
+                    quantizedPerson[i] = unZigZag(
+                        bitReader.readRice(riceContexts[getRiceContextIndex(isResidual, isScore)]))
+                        + (isResidual ? reference->second[i] : 0);
+                    keypointsPtr[i] = (isScore
+                        ? quantizedPerson[i] / KEYPOINT_SCORE_SCALE : quantizedPerson[i] * precision);
+                }
+                poseIds[person] = poseId;
+                if (poseId >= 0)
+                    people[poseId] = quantizedPerson;
+            }
+            // Reference of the next packet
+            state.valid = true;
+            state.sequence = sequence;
+            state.numberParts = numberParts;
+            state.numberChannels = numberChannels;
+            std::swap(state.people, people);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            state.reset();
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    uint64_t getCompressedBlockBytes(const char* const data, const uint64_t dataBytes)
+    {
+        try
+        {
+            if (dataBytes < sizeof(KeypointCompressedBlockHeader))
+                return 0u;
+            KeypointCompressedBlockHeader compressedBlockHeader;
+            std::memcpy(&compressedBlockHeader, data, sizeof(KeypointCompressedBlockHeader));
+            return sizeof(KeypointCompressedBlockHeader) + compressedBlockHeader.dataBytes;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0u;
+        }
+    }
+}
@@ -0,0 +1,248 @@
+#include <openpose/filestream/keypointStreamReader.hpp>
+#include <cstring> // std::memcpy
+#include <thread>
+#include <openpose_private/filestream/keypointCompression.hpp>
+#include <openpose_private/utilities/sharedMemory.hpp>
+
+namespace op
+{
+    struct KeypointStreamReader::ImplKeypointStreamReader
+    {
+        std::unique_ptr<SharedMemory> upSharedMemory;
+        uint32_t mNumberSlots;
+        uint32_t mSlotBytes;
+        uint64_t mNextSequence;
+        std::vector<char> mPacket;
+        KeypointPacketHeader mLastPacketHeader;
+
+        explicit ImplKeypointStreamReader(const std::string& sharedMemoryName) :
+            upSharedMemory{new SharedMemory{sharedMemoryName}},
+            mNumberSlots{0u},
+            mSlotBytes{0u},
+            mNextSequence{0u}
+        {
+            std::memset(&mLastPacketHeader, 0, sizeof(mLastPacketHeader));
+        }
+
+        const KeypointRingHeader& getRingHeader() const
+        {
+            return *(const KeypointRingHeader*)upSharedMemory->getData();
+        }
+    };
+
+    struct KeypointPacketDecoder::ImplKeypointPacketDecoder
+    {
+        // References of the compressed blocks
+        KeypointCompressionState mState;
+        KeypointCompressionState mState3D;
+        KeypointPacketHeader mLastPacketHeader;
+
+        ImplKeypointPacketDecoder()
+        {
+            std::memset(&mLastPacketHeader, 0, sizeof(mLastPacketHeader));
+        }
+    };
+
+    KeypointPacketDecoder::KeypointPacketDecoder() :
+        upImpl{new ImplKeypointPacketDecoder{}}
+    {
+    }
+
+    KeypointPacketDecoder::~KeypointPacketDecoder()
+    {
+    }
+
+    bool KeypointPacketDecoder::decode(Datum& datum, const void* const packet, const unsigned long long packetBytes)
+    {
+        try
+        {
+            const auto* const packetPtr = (const char*)packet;
+            KeypointPacketHeader packetHeader;
+            if (packetBytes < sizeof(KeypointPacketHeader))
+                error("Keypoint packet too small.", __LINE__, __FUNCTION__, __FILE__);
+            std::memcpy(&packetHeader, packetPtr, sizeof(KeypointPacketHeader));
+            if (packetHeader.magic != KEYPOINT_PACKET_MAGIC)
+                error("This is not an OpenPose keypoint packet.", __LINE__, __FUNCTION__, __FILE__);
+            if (packetHeader.version != KEYPOINT_PACKET_VERSION)
+                error("Version " + std::to_string(packetHeader.version) + " of the keypoint packet is not supported"
+                      " (only " + std::to_string(KEYPOINT_PACKET_VERSION) + ").", __LINE__, __FUNCTION__, __FILE__);
+            if (packetHeader.packetBytes > packetBytes
+                || packetHeader.packetBytes < sizeof(KeypointPacketHeader)
+                    + packetHeader.numberBlocks * sizeof(KeypointPacketBlockHeader))
+                error("Corrupted keypoint packet.", __LINE__, __FUNCTION__, __FILE__);
+            upImpl->mLastPacketHeader = packetHeader;
+            datum.id = packetHeader.frameId;
+            datum.sourceId = packetHeader.sourceId;
+            datum.poseKeypoints.reset();
+            datum.poseKeypoints3D.reset();
+            datum.poseIds.reset();
+            auto decoded = true;
+            auto hasCompressedBlock = false;
+            auto hasCompressedBlock3D = false;
+            auto dataOffset = (uint64_t)(sizeof(KeypointPacketHeader)
+                                         + packetHeader.numberBlocks * sizeof(KeypointPacketBlockHeader));
+            for (auto blockIndex = 0u ; blockIndex < packetHeader.numberBlocks ; blockIndex++)
+            {
+                KeypointPacketBlockHeader blockHeader;
+                std::memcpy(
+                    &blockHeader,
+                    packetPtr + sizeof(KeypointPacketHeader) + blockIndex * sizeof(KeypointPacketBlockHeader),
+                    sizeof(KeypointPacketBlockHeader));
+                const auto isCompressed = (blockHeader.block == (uint32_t)KeypointPacketBlock::PoseKeypointsCompressed
+                    || blockHeader.block == (uint32_t)KeypointPacketBlock::PoseKeypoints3DCompressed);
+                const auto dataBytes = (isCompressed
+                    ? getCompressedBlockBytes(packetPtr + dataOffset, packetHeader.packetBytes - dataOffset)
+                    : (uint64_t)blockHeader.numberPeople * blockHeader.numberParts * blockHeader.numberChannels
+                        * sizeof(float));
+                if ((isCompressed && dataBytes == 0u) || dataOffset + dataBytes > packetHeader.packetBytes)
+                    error("Corrupted keypoint packet.", __LINE__, __FUNCTION__, __FILE__);
+                // Compressed
+                if (blockHeader.block == (uint32_t)KeypointPacketBlock::PoseKeypointsCompressed)
+                {
+                    decoded &= decompressKeypoints(
+                        datum.poseKeypoints, datum.poseIds, upImpl->mState, blockHeader, packetPtr + dataOffset,
+                        dataBytes, packetHeader.sequence);
+                    hasCompressedBlock = true;
+                }
+                else if (blockHeader.block == (uint32_t)KeypointPacketBlock::PoseKeypoints3DCompressed)
+                {
+                    Array<long long> poseIds3D;
+                    decoded &= decompressKeypoints(
+                        datum.poseKeypoints3D, poseIds3D, upImpl->mState3D, blockHeader, packetPtr + dataOffset,
+                        dataBytes, packetHeader.sequence);
+                    hasCompressedBlock3D = true;
+                }
+                // Raw
+                else
+                {
+                    Array<float>* keypoints = nullptr;
+                    if (blockHeader.block == (uint32_t)KeypointPacketBlock::PoseKeypoints)
+                        keypoints = &datum.poseKeypoints;
+                    else if (blockHeader.block == (uint32_t)KeypointPacketBlock::PoseKeypoints3D)
+                        keypoints = &datum.poseKeypoints3D;
+                    // Unknown blocks (e.g., from newer versions) are skipped
+                    if (keypoints != nullptr && blockHeader.numberPeople > 0u)
+                    {
+                        keypoints->reset({(int)blockHeader.numberPeople, (int)blockHeader.numberParts,
+                                          (int)blockHeader.numberChannels});
+                        std::memcpy(keypoints->getPtr(), packetPtr + dataOffset, dataBytes);
+                    }
+                }
+                dataOffset += (dataBytes + 7u) & ~(uint64_t)7u;
+            }
+            // Blocks not sent, so the next compressed ones cannot refer to them
+            if (!hasCompressedBlock)
+                upImpl->mState.reset();
+            if (!hasCompressedBlock3D)
+                upImpl->mState3D.reset();
+            return decoded;
+        }
+        catch (const std::exception& e)
+        {
+            upImpl->mState.reset();
+            upImpl->mState3D.reset();
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    const KeypointPacketHeader& KeypointPacketDecoder::getLastPacketHeader() const
+    {
+        return upImpl->mLastPacketHeader;
+    }
+
+    KeypointPacketHeader keypointPacketToDatum(
+        Datum& datum, const void* const packet, const unsigned long long packetBytes)
+    {
+        try
+        {
+            // The compressed blocks with residuals are left empty (they require the previous packets)
+            KeypointPacketDecoder keypointPacketDecoder;
+            keypointPacketDecoder.decode(datum, packet, packetBytes);
+            return keypointPacketDecoder.getLastPacketHeader();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return KeypointPacketHeader{};
+        }
+    }
+
+    KeypointStreamReader::KeypointStreamReader(const std::string& sharedMemoryName) :
+        upImpl{new ImplKeypointStreamReader{sharedMemoryName}}
+    {
+        try
+        {
+            if (upImpl->upSharedMemory->getSize() < sizeof(KeypointRingHeader))
+                error("Shared memory " + sharedMemoryName + " is not a keypoint ring buffer.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            const auto& ringHeader = upImpl->getRingHeader();
+            if (ringHeader.magic != KEYPOINT_RING_MAGIC || ringHeader.version != KEYPOINT_PACKET_VERSION)
+                error("Shared memory " + sharedMemoryName + " is not a keypoint ring buffer (or its version is not"
+                      " supported).", __LINE__, __FUNCTION__, __FILE__);
+            upImpl->mNumberSlots = ringHeader.numberSlots;
+            upImpl->mSlotBytes = ringHeader.slotBytes;
+            if (upImpl->mNumberSlots == 0u
+                || getKeypointRingSlotOffset(upImpl->mNumberSlots, upImpl->mSlotBytes)
+                    > upImpl->upSharedMemory->getSize())
+                error("Shared memory " + sharedMemoryName + " is corrupted.", __LINE__, __FUNCTION__, __FILE__);
+            upImpl->mPacket.resize(upImpl->mSlotBytes);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    KeypointStreamReader::~KeypointStreamReader()
+    {
+    }
+
+    bool KeypointStreamReader::readLatest(Datum& datum)
+    {
+        try
+        {
+            const auto& ringHeader = upImpl->getRingHeader();
+            // The writer might overwrite the slot while it is copied (sequence lock), so it retries a few times
+            for (auto attempt = 0 ; attempt < 100 ; attempt++)
+            {
+                const auto writeSequence = ringHeader.writeSequence.load(std::memory_order_acquire);
+                // No new packet (a smaller writeSequence means the writer was restarted)
+                if (writeSequence == 0u || writeSequence == upImpl->mNextSequence)
+                    return false;
+                const auto sequence = writeSequence - 1u;
+                const auto* const slot = upImpl->upSharedMemory->getData()
+                    + getKeypointRingSlotOffset((uint32_t)(sequence % upImpl->mNumberSlots), upImpl->mSlotBytes);
+                const auto& slotHeader = *(const KeypointRingSlotHeader*)slot;
+                const auto slotSequenceBefore = slotHeader.sequence.load(std::memory_order_acquire);
+                if (slotSequenceBefore == 2u * sequence + 2u)
+                {
+                    const auto packetBytes = slotHeader.packetBytes;
+                    if (packetBytes <= upImpl->mSlotBytes)
+                        std::memcpy(upImpl->mPacket.data(), slot + sizeof(KeypointRingSlotHeader), packetBytes);
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    const auto slotSequenceAfter = slotHeader.sequence.load(std::memory_order_relaxed);
+                    // Not overwritten while copying it
+                    if (slotSequenceAfter == slotSequenceBefore && packetBytes <= upImpl->mSlotBytes)
+                    {
+                        upImpl->mLastPacketHeader = keypointPacketToDatum(datum, upImpl->mPacket.data(), packetBytes);
+                        upImpl->mNextSequence = writeSequence;
+                        return true;
+                    }
+                }
+                std::this_thread::yield();
+            }
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    const KeypointPacketHeader& KeypointStreamReader::getLastPacketHeader() const
+    {
+        return upImpl->mLastPacketHeader;
+    }
+}
@@ -0,0 +1,378 @@
+#include <openpose/filestream/keypointStreamer.hpp>
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    #pragma comment(lib, "Ws2_32.lib")
+#else
+    #include <netdb.h> // getaddrinfo
+    #include <sys/socket.h>
+    #include <unistd.h> // close
+#endif
+#include <chrono>
+#include <cstring> // std::memcpy
+#include <new> // placement new
+#include <openpose/filestream/keypointStreamFormat.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose_private/filestream/keypointCompression.hpp>
+#include <openpose_private/utilities/sharedMemory.hpp>
+
+namespace op
+{
+    namespace
+    {
+        #ifdef _WIN32
+            typedef SOCKET UdpSocketType;
+            const UdpSocketType INVALID_UDP_SOCKET = INVALID_SOCKET;
+            void closeUdpSocket(const UdpSocketType socketDescriptor)
+            {
+                closesocket(socketDescriptor);
+            }
+        #else
+            typedef int UdpSocketType;
+            const UdpSocketType INVALID_UDP_SOCKET = -1;
+            void closeUdpSocket(const UdpSocketType socketDescriptor)
+            {
+                close(socketDescriptor);
+            }
+        #endif
+
+        uint64_t paddedBytes(const uint64_t bytes)
+        {
+            return (bytes + 7u) & ~(uint64_t)7u;
+        }
+
+        // Bytes of each person of keypoints (or 0 if not sent)
+        uint64_t getPersonBytes(const Array<float>& keypoints)
+        {
+            return (keypoints.getNumberDimensions() == 3 && !keypoints.empty()
+                ? (uint64_t)keypoints.getSize(1) * keypoints.getSize(2) * sizeof(float) : 0u);
+        }
+
+        // It appends keypoints as a raw (if precision = 0) or compressed block, and it returns its number of people
+        unsigned int appendBlock(
+            std::vector<char>& packet, KeypointPacketHeader& packetHeader, const KeypointPacketBlock block,
+            const Array<float>& keypoints, const unsigned int maxNumberPeople, const float precision,
+            const Array<long long>& poseIds, KeypointCompressionState& state, const bool keyframe,
+            const uint64_t maxBytes)
+        {
+            const auto personBytes = getPersonBytes(keypoints);
+            // Not sent, so the next compressed block cannot refer to it
+            if (personBytes == 0u)
+            {
+                state.reset();
+                return 0u;
+            }
+            KeypointPacketBlockHeader blockHeader;
+            blockHeader.block = (uint32_t)block;
+            blockHeader.numberParts = (uint32_t)keypoints.getSize(1);
+            blockHeader.numberChannels = (uint32_t)keypoints.getSize(2);
+            // Compressed
+            if (precision > 0.f)
+            {
+                blockHeader.block = (uint32_t)(block == KeypointPacketBlock::PoseKeypoints
+                    ? KeypointPacketBlock::PoseKeypointsCompressed : KeypointPacketBlock::PoseKeypoints3DCompressed);
+                // The padding is at most 7 bytes
+                blockHeader.numberPeople = compressKeypoints(
+                    packet, state, keypoints, poseIds, precision, keyframe, packetHeader.sequence, maxNumberPeople,
+                    maxBytes - 7u);
+            }
+            // Raw
+            else
+            {
+                blockHeader.numberPeople = (uint32_t)fastMin(keypoints.getSize(0), (int)maxNumberPeople);
+                const auto dataBytes = blockHeader.numberPeople * personBytes;
+                const auto dataOffset = packet.size();
+                packet.resize(dataOffset + paddedBytes(dataBytes), 0);
+                if (dataBytes > 0u)
+                    std::memcpy(&packet[dataOffset], keypoints.getConstPtr(), dataBytes);
+            }
+            const auto blockHeaderOffset = sizeof(KeypointPacketHeader)
+                                         + packetHeader.numberBlocks * sizeof(KeypointPacketBlockHeader);
+            std::memcpy(&packet[blockHeaderOffset], &blockHeader, sizeof(KeypointPacketBlockHeader));
+            packetHeader.numberBlocks++;
+            return blockHeader.numberPeople;
+        }
+    }
+
+    struct KeypointPacketEncoder::ImplKeypointPacketEncoder
+    {
+        const float mPrecision;
+        const float mPrecision3D;
+        const unsigned int mKeyframeInterval;
+        // References of the compressed blocks
+        KeypointCompressionState mState;
+        KeypointCompressionState mState3D;
+
+        ImplKeypointPacketEncoder(const float precision, const float precision3D, const unsigned int keyframeInterval) :
+            mPrecision{fastMax(0.f, precision)},
+            mPrecision3D{fastMax(0.f, precision3D)},
+            mKeyframeInterval{fastMax(1u, keyframeInterval)}
+        {
+        }
+    };
+
+    KeypointPacketEncoder::KeypointPacketEncoder(
+        const float precision, const float precision3D, const unsigned int keyframeInterval) :
+        upImpl{new ImplKeypointPacketEncoder{precision, precision3D, keyframeInterval}}
+    {
+    }
+
+    KeypointPacketEncoder::~KeypointPacketEncoder()
+    {
+    }
+
+    bool KeypointPacketEncoder::encode(std::vector<char>& packet, const Datum& datum, const unsigned long long sequence)
+    {
+        try
+        {
+            // Packet header (numberBlocks and packetBytes filled at the end)
+            KeypointPacketHeader packetHeader;
+            packetHeader.magic = KEYPOINT_PACKET_MAGIC;
+            packetHeader.version = KEYPOINT_PACKET_VERSION;
+            packetHeader.sequence = sequence;
+            packetHeader.timestampUs = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            packetHeader.frameId = datum.id;
+            packetHeader.sourceId = datum.sourceId;
+            packetHeader.numberBlocks = 0u;
+            // People that fit into KEYPOINT_PACKET_MAX_BYTES as raw floats (the compressed blocks are also limited
+            // by their actual size)
+            const auto personBytes = getPersonBytes(datum.poseKeypoints);
+            const auto personBytes3D = getPersonBytes(datum.poseKeypoints3D);
+            const auto isCompressed = (personBytes > 0u && upImpl->mPrecision > 0.f);
+            const auto isCompressed3D = (personBytes3D > 0u && upImpl->mPrecision3D > 0.f);
+            const auto numberBlocks = (personBytes > 0u ? 1u : 0u) + (personBytes3D > 0u ? 1u : 0u);
+            const auto headerBytes = sizeof(KeypointPacketHeader) + numberBlocks * sizeof(KeypointPacketBlockHeader);
+            const auto compressedHeaderBytes = ((isCompressed ? 1u : 0u) + (isCompressed3D ? 1u : 0u))
+                                             * sizeof(KeypointCompressedBlockHeader);
+            const auto allPersonBytes = personBytes + personBytes3D;
+            // The padding of each raw block is at most 4 bytes
+            const auto maxNumberPeople = (unsigned int)(allPersonBytes > 0u
+                ? (KEYPOINT_PACKET_MAX_BYTES - headerBytes - compressedHeaderBytes - 4u * numberBlocks)
+                    / allPersonBytes : 0u);
+            // Bytes kept for the 3-D block while appending the 2-D one
+            const auto bytes3D = (isCompressed3D
+                ? sizeof(KeypointCompressedBlockHeader)
+                : paddedBytes(fastMin((unsigned int)datum.poseKeypoints3D.getSize(0), maxNumberPeople)
+                              * personBytes3D));
+            // Keyframes (all the people are absolute)
+            const auto keyframe = (sequence % upImpl->mKeyframeInterval == 0u);
+            // Blocks
+            packet.assign(headerBytes, 0);
+            const auto numberPeople = appendBlock(
+                packet, packetHeader, KeypointPacketBlock::PoseKeypoints, datum.poseKeypoints, maxNumberPeople,
+                upImpl->mPrecision, datum.poseIds, upImpl->mState, keyframe,
+                KEYPOINT_PACKET_MAX_BYTES - packet.size() - bytes3D);
+            const auto numberPeople3D = appendBlock(
+                packet, packetHeader, KeypointPacketBlock::PoseKeypoints3D, datum.poseKeypoints3D, maxNumberPeople,
+                upImpl->mPrecision3D, datum.poseIds, upImpl->mState3D, keyframe,
+                KEYPOINT_PACKET_MAX_BYTES - packet.size());
+            packetHeader.packetBytes = (uint32_t)packet.size();
+            std::memcpy(packet.data(), &packetHeader, sizeof(KeypointPacketHeader));
+            return numberPeople == (unsigned int)fastMax(0, datum.poseKeypoints.getSize(0))
+                && numberPeople3D == (unsigned int)fastMax(0, datum.poseKeypoints3D.getSize(0));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    bool datumToKeypointPacket(std::vector<char>& packet, const Datum& datum, const unsigned long long sequence)
+    {
+        try
+        {
+            KeypointPacketEncoder keypointPacketEncoder;
+            return keypointPacketEncoder.encode(packet, datum, sequence);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    struct KeypointStreamer::ImplKeypointStreamer
+    {
+        uint64_t mSequence;
+        // UDP packets (compressed if a precision was set) and shared memory ones (always raw floats, since its
+        // readers might skip packets)
+        KeypointPacketEncoder mUdpPacketEncoder;
+        KeypointPacketEncoder mRawPacketEncoder;
+        const bool mIsCompressed;
+        std::vector<char> mPacket;
+        std::vector<char> mRawPacket;
+        bool mTruncationLogged;
+        bool mSendErrorLogged;
+        // UDP
+        UdpSocketType mUdpSocket;
+        std::vector<char> mUdpAddress;
+        int mUdpAddressBytes;
+        // Shared memory ring buffer
+        std::unique_ptr<SharedMemory> upSharedMemory;
+        unsigned int mNumberSlots;
+
+        ImplKeypointStreamer(const float precision, const float precision3D, const unsigned int keyframeInterval) :
+            mSequence{0u},
+            mUdpPacketEncoder{precision, precision3D, keyframeInterval},
+            mIsCompressed{precision > 0.f || precision3D > 0.f},
+            mTruncationLogged{false},
+            mSendErrorLogged{false},
+            mUdpSocket{INVALID_UDP_SOCKET},
+            mUdpAddressBytes{0},
+            mNumberSlots{0u}
+        {
+        }
+
+        KeypointRingHeader& getRingHeader() const
+        {
+            return *(KeypointRingHeader*)upSharedMemory->getData();
+        }
+
+        unsigned char* getSlot(const unsigned int slotIndex) const
+        {
+            return upSharedMemory->getData() + getKeypointRingSlotOffset(slotIndex, KEYPOINT_RING_SLOT_BYTES);
+        }
+    };
+
+    KeypointStreamer::KeypointStreamer(
+        const std::string& udpAddress, const std::string& sharedMemoryName, const unsigned int numberSlots,
+        const float precision, const float precision3D, const unsigned int keyframeInterval) :
+        upImpl{new ImplKeypointStreamer{precision, precision3D, keyframeInterval}}
+    {
+        try
+        {
+            if (udpAddress.empty() && sharedMemoryName.empty())
+                error("Either the UDP address or the shared memory name must be set.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // UDP socket
+            if (!udpAddress.empty())
+            {
+                const auto colonIndex = udpAddress.rfind(':');
+                if (colonIndex == std::string::npos || colonIndex == 0 || colonIndex + 1 == udpAddress.size())
+                    error("The UDP address must be `host:port` (e.g., `127.0.0.1:8052`), not `" + udpAddress + "`.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                const auto host = udpAddress.substr(0, colonIndex);
+                const auto port = udpAddress.substr(colonIndex + 1);
+                #ifdef _WIN32
+                    WSADATA wsaData;
+                    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+                        error("WSAStartup failed.", __LINE__, __FUNCTION__, __FILE__);
+                #endif
+                addrinfo hints;
+                std::memset(&hints, 0, sizeof(hints));
+                hints.ai_family = AF_UNSPEC;
+                hints.ai_socktype = SOCK_DGRAM;
+                hints.ai_protocol = IPPROTO_UDP;
+                addrinfo* addresses = nullptr;
+                if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0 || addresses == nullptr)
+                    error("UDP address " + udpAddress + " could not be resolved.", __LINE__, __FUNCTION__, __FILE__);
+                upImpl->mUdpSocket = socket(addresses->ai_family, addresses->ai_socktype, addresses->ai_protocol);
+                upImpl->mUdpAddress.assign(
+                    (const char*)addresses->ai_addr, (const char*)addresses->ai_addr + addresses->ai_addrlen);
+                upImpl->mUdpAddressBytes = (int)addresses->ai_addrlen;
+                freeaddrinfo(addresses);
+                if (upImpl->mUdpSocket == INVALID_UDP_SOCKET)
+                    error("UDP socket could not be created.", __LINE__, __FUNCTION__, __FILE__);
+            }
+            // Shared memory ring buffer
+            if (!sharedMemoryName.empty())
+            {
+                if (numberSlots == 0u)
+                    error("The number of slots of the ring buffer must be positive.", __LINE__, __FUNCTION__, __FILE__);
+                upImpl->mNumberSlots = numberSlots;
+                const auto sharedMemoryBytes = (unsigned long long)getKeypointRingSlotOffset(
+                    numberSlots, KEYPOINT_RING_SLOT_BYTES);
+                upImpl->upSharedMemory.reset(new SharedMemory{sharedMemoryName, sharedMemoryBytes});
+                // Empty slots (it might be an old ring buffer of a killed process)
+                for (auto slotIndex = 0u ; slotIndex < numberSlots ; slotIndex++)
+                {
+                    auto* slotHeader = new (upImpl->getSlot(slotIndex)) KeypointRingSlotHeader;
+                    slotHeader->sequence.store(0u, std::memory_order_relaxed);
+                    slotHeader->packetBytes = 0u;
+                }
+                auto* ringHeader = new (upImpl->upSharedMemory->getData()) KeypointRingHeader;
+                ringHeader->magic = KEYPOINT_RING_MAGIC;
+                ringHeader->version = KEYPOINT_PACKET_VERSION;
+                ringHeader->numberSlots = numberSlots;
+                ringHeader->slotBytes = KEYPOINT_RING_SLOT_BYTES;
+                ringHeader->writeSequence.store(0u, std::memory_order_release);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    KeypointStreamer::~KeypointStreamer()
+    {
+        try
+        {
+            if (upImpl->mUdpSocket != INVALID_UDP_SOCKET)
+            {
+                closeUdpSocket(upImpl->mUdpSocket);
+                #ifdef _WIN32
+                    WSACleanup();
+                #endif
+            }
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void KeypointStreamer::send(const Datum& datum)
+    {
+        try
+        {
+            const auto sendsUdp = (upImpl->mUdpSocket != INVALID_UDP_SOCKET);
+            auto allPeopleFit = true;
+            if (sendsUdp)
+                allPeopleFit &= upImpl->mUdpPacketEncoder.encode(upImpl->mPacket, datum, upImpl->mSequence);
+            // Same packet for both, unless the UDP one is compressed
+            if (upImpl->upSharedMemory != nullptr && (upImpl->mIsCompressed || !sendsUdp))
+                allPeopleFit &= upImpl->mRawPacketEncoder.encode(upImpl->mRawPacket, datum, upImpl->mSequence);
+            if (!allPeopleFit && !upImpl->mTruncationLogged)
+            {
+                opLog("Not all the people fit into each keypoint packet (the rest of them are not streamed). Set"
+                      " `--number_people_max` to avoid it.", Priority::High);
+                upImpl->mTruncationLogged = true;
+            }
+            const auto sequence = upImpl->mSequence++;
+            // UDP (lost datagrams are not resent, the next frame replaces them anyway)
+            if (sendsUdp)
+            {
+                const auto& packet = upImpl->mPacket;
+                const auto bytesSent = sendto(
+                    upImpl->mUdpSocket, packet.data(), (int)packet.size(), 0,
+                    (const sockaddr*)upImpl->mUdpAddress.data(), upImpl->mUdpAddressBytes);
+                if ((long long)bytesSent != (long long)packet.size() && !upImpl->mSendErrorLogged)
+                {
+                    opLog("Keypoint packets could not be sent by UDP (e.g., the network is unreachable).",
+                          Priority::High);
+                    upImpl->mSendErrorLogged = true;
+                }
+            }
+            // Shared memory ring buffer (sequence lock of the slot)
+            if (upImpl->upSharedMemory != nullptr)
+            {
+                const auto& packet = (upImpl->mIsCompressed || !sendsUdp ? upImpl->mRawPacket : upImpl->mPacket);
+                auto* const slot = upImpl->getSlot((unsigned int)(sequence % upImpl->mNumberSlots));
+                auto& slotHeader = *(KeypointRingSlotHeader*)slot;
+                slotHeader.sequence.store(2u * sequence + 1u, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                slotHeader.packetBytes = packet.size();
+                std::memcpy(slot + sizeof(KeypointRingSlotHeader), packet.data(), packet.size());
+                slotHeader.sequence.store(2u * sequence + 2u, std::memory_order_release);
+                upImpl->getRingHeader().writeSequence.store(sequence + 1u, std::memory_order_release);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
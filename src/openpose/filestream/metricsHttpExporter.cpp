@@ -0,0 +1,250 @@
+#include <openpose/filestream/metricsHttpExporter.hpp>
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    #pragma comment(lib, "Ws2_32.lib")
+#else
+    #include <arpa/inet.h> // inet_pton
+    #include <netinet/in.h> // sockaddr_in
+    #include <sys/select.h> // select
+    #include <sys/socket.h>
+    #include <unistd.h> // close
+#endif
+#include <atomic>
+#include <thread>
+#include <openpose/utilities/metrics.hpp>
+
+namespace op
+{
+    #ifdef _WIN32
+        typedef SOCKET SocketType;
+        const SocketType INVALID_SOCKET_TYPE = INVALID_SOCKET;
+        void closeSocket(const SocketType socketDescriptor)
+        {
+            closesocket(socketDescriptor);
+        }
+    #else
+        typedef int SocketType;
+        const SocketType INVALID_SOCKET_TYPE = -1;
+        void closeSocket(const SocketType socketDescriptor)
+        {
+            close(socketDescriptor);
+        }
+    #endif
+
+    // Maximum request size read (only the request line is used)
+    const auto METRICS_HTTP_MAX_REQUEST_SIZE = 8192u;
+    // Period (in msec) to check whether the server must stop, and timeout to receive a request
+    const auto METRICS_HTTP_TIMEOUT_MS = 200;
+
+    bool waitForSocket(const SocketType socketDescriptor, const int timeoutMs)
+    {
+        fd_set readSockets;
+        FD_ZERO(&readSockets);
+        FD_SET(socketDescriptor, &readSockets);
+        timeval timeout{timeoutMs / 1000, (timeoutMs % 1000) * 1000};
+        return select((int)socketDescriptor + 1, &readSockets, nullptr, nullptr, &timeout) > 0;
+    }
+
+    void sendAll(const SocketType socketDescriptor, const std::string& message)
+    {
+        #ifdef MSG_NOSIGNAL
+            // Avoid SIGPIPE if the client closed the connection
+            const auto flags = MSG_NOSIGNAL;
+        #else
+            const auto flags = 0;
+        #endif
+        auto bytesSent = 0ull;
+        while (bytesSent < message.size())
+        {
+            const auto result = send(
+                socketDescriptor, message.data() + bytesSent, (int)(message.size() - bytesSent), flags);
+            if (result <= 0)
+                break;
+            bytesSent += (unsigned long long)result;
+        }
+    }
+
+    std::string getHttpResponse(const std::string& status, const std::string& contentType, const std::string& body)
+    {
+        return "HTTP/1.1 " + status + "\r\n"
+            + "Content-Type: " + contentType + "\r\n"
+            + "Content-Length: " + std::to_string(body.size()) + "\r\n"
+            + "Connection: close\r\n\r\n"
+            + body;
+    }
+
+    struct MetricsHttpExporter::ImplMetricsHttpExporter
+    {
+        const int mPort;
+        const std::string mHost;
+        std::atomic<bool> mIsRunning;
+        SocketType mListenSocket;
+        std::thread mThread;
+
+        ImplMetricsHttpExporter(const int port, const std::string& host) :
+            mPort{port},
+            mHost{host},
+            mIsRunning{false},
+            mListenSocket{INVALID_SOCKET_TYPE}
+        {
+        }
+
+        void serveClient(const SocketType clientSocket)
+        {
+            // Read request (only its first line is used), e.g., `GET /metrics HTTP/1.1`
+            std::string request;
+            char buffer[1024];
+            while (request.find("\r\n") == std::string::npos && request.size() < METRICS_HTTP_MAX_REQUEST_SIZE
+                   && waitForSocket(clientSocket, METRICS_HTTP_TIMEOUT_MS))
+            {
+                const auto bytesReceived = recv(clientSocket, buffer, (int)sizeof(buffer), 0);
+                if (bytesReceived <= 0)
+                    break;
+                request.append(buffer, (size_t)bytesReceived);
+            }
+            const auto requestLine = request.substr(0, request.find("\r\n"));
+            const auto methodEnd = requestLine.find(' ');
+            const auto pathEnd = requestLine.find(' ', methodEnd + 1);
+            const auto method = requestLine.substr(0, methodEnd);
+            const auto path = (methodEnd == std::string::npos
+                ? "" : requestLine.substr(methodEnd + 1, pathEnd - methodEnd - 1));
+            // Response
+            std::string response;
+            if (method != "GET")
+                response = getHttpResponse("405 Method Not Allowed", "text/plain", "Only GET is supported.\n");
+            else if (path == "/metrics" || path.find("/metrics?") == 0)
+                response = getHttpResponse(
+                    "200 OK", "application/openmetrics-text; version=1.0.0; charset=utf-8", Metrics::toOpenMetrics());
+            else
+                response = getHttpResponse("404 Not Found", "text/plain", "OpenPose metrics are on /metrics.\n");
+            sendAll(clientSocket, response);
+        }
+
+        void serve()
+        {
+            while (mIsRunning)
+            {
+                try
+                {
+                    if (waitForSocket(mListenSocket, METRICS_HTTP_TIMEOUT_MS))
+                    {
+                        const auto clientSocket = accept(mListenSocket, nullptr, nullptr);
+                        if (clientSocket != INVALID_SOCKET_TYPE)
+                        {
+                            serveClient(clientSocket);
+                            closeSocket(clientSocket);
+                        }
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    // Metrics must not stop OpenPose, so errors are only logged
+                    opLog("MetricsHttpExporter: " + std::string{e.what()}, Priority::High,
+                          __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+        }
+    };
+
+    MetricsHttpExporter::MetricsHttpExporter(const int port, const std::string& host) :
+        upImpl{new ImplMetricsHttpExporter{port, host}}
+    {
+        try
+        {
+            // Sanity check
+            if (port < 0 || port > 65535)
+                error("Invalid metrics port (" + std::to_string(port) + "), it must be in the range [0, 65535].",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    MetricsHttpExporter::~MetricsHttpExporter()
+    {
+        try
+        {
+            stop();
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void MetricsHttpExporter::start()
+    {
+        try
+        {
+            if (!upImpl->mIsRunning)
+            {
+                #ifdef _WIN32
+                    WSADATA wsaData;
+                    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+                        error("WSAStartup failed.", __LINE__, __FUNCTION__, __FILE__);
+                #endif
+                // Bind and listen
+                sockaddr_in address{};
+                address.sin_family = AF_INET;
+                address.sin_port = htons((unsigned short)upImpl->mPort);
+                if (inet_pton(AF_INET, upImpl->mHost.c_str(), &address.sin_addr) != 1)
+                    error("Invalid metrics host IP address (`" + upImpl->mHost + "`).",
+                          __LINE__, __FUNCTION__, __FILE__);
+                upImpl->mListenSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+                if (upImpl->mListenSocket == INVALID_SOCKET_TYPE)
+                    error("Metrics HTTP socket could not be created.", __LINE__, __FUNCTION__, __FILE__);
+                const int reuseAddress = 1;
+                setsockopt(upImpl->mListenSocket, SOL_SOCKET, SO_REUSEADDR, (const char*)&reuseAddress,
+                           (int)sizeof(reuseAddress));
+                if (bind(upImpl->mListenSocket, (const sockaddr*)&address, (int)sizeof(address)) != 0
+                    || listen(upImpl->mListenSocket, 8) != 0)
+                {
+                    closeSocket(upImpl->mListenSocket);
+                    upImpl->mListenSocket = INVALID_SOCKET_TYPE;
+                    error("Metrics HTTP server could not listen on " + upImpl->mHost + ":"
+                          + std::to_string(upImpl->mPort) + " (is the port already in use?).",
+                          __LINE__, __FUNCTION__, __FILE__);
+                }
+                // Serve on a new thread
+                upImpl->mIsRunning = true;
+                upImpl->mThread = std::thread{&ImplMetricsHttpExporter::serve, upImpl.get()};
+                opLog("Metrics available on http://" + upImpl->mHost + ":" + std::to_string(upImpl->mPort)
+                      + "/metrics", Priority::High);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void MetricsHttpExporter::stop()
+    {
+        try
+        {
+            if (upImpl->mIsRunning)
+            {
+                upImpl->mIsRunning = false;
+                if (upImpl->mThread.joinable())
+                    upImpl->mThread.join();
+                closeSocket(upImpl->mListenSocket);
+                upImpl->mListenSocket = INVALID_SOCKET_TYPE;
+                #ifdef _WIN32
+                    WSACleanup();
+                #endif
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool MetricsHttpExporter::isRunning() const
+    {
+        return upImpl->mIsRunning;
+    }
+}
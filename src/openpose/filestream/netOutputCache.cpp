@@ -0,0 +1,237 @@
+#include <openpose/filestream/netOutputCache.hpp>
+#include <atomic>
+#include <cstdint>
+#include <cstdio> // std::snprintf
+#include <cstring> // std::memcpy
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <openpose/filestream/heatMapBinaryReader.hpp>
+#include <openpose/filestream/heatMapBinarySaver.hpp>
+#include <openpose/utilities/fileSystem.hpp>
+
+namespace op
+{
+    namespace
+    {
+        // 2 independent 64-bit lanes (128-bit key), reading 8 bytes at a time, so hashing the network input is
+        // negligible compared with the network itself
+        struct KeyHasher
+        {
+            uint64_t mHash1;
+            uint64_t mHash2;
+
+            KeyHasher() :
+                mHash1{0x243f6a8885a308d3ull},
+                mHash2{0x13198a2e03707344ull}
+            {
+            }
+
+            inline void addWord(const uint64_t word)
+            {
+                mHash1 = (mHash1 ^ word) * 0x9e3779b97f4a7c15ull;
+                mHash1 ^= mHash1 >> 32;
+                mHash2 = (mHash2 + word) * 0xc2b2ae3d27d4eb4full;
+                mHash2 = (mHash2 << 31) | (mHash2 >> 33);
+            }
+
+            void addBytes(const void* const data, const std::size_t bytes)
+            {
+                const auto* const bytesPtr = (const unsigned char*)data;
+                auto i = 0ull;
+                for ( ; i + sizeof(uint64_t) <= bytes ; i += sizeof(uint64_t))
+                {
+                    uint64_t word;
+                    std::memcpy(&word, bytesPtr + i, sizeof(uint64_t));
+                    addWord(word);
+                }
+                uint64_t lastWord = bytes; // So "a" + "" != "" + "a"
+                for (auto byte = 0u ; i < bytes ; i++, byte++)
+                    lastWord ^= (uint64_t)bytesPtr[i] << (8u * byte);
+                addWord(lastWord);
+            }
+
+            static uint64_t finalize(uint64_t hash)
+            {
+                hash ^= hash >> 33;
+                hash *= 0xff51afd7ed558ccdull;
+                hash ^= hash >> 33;
+                hash *= 0xc4ceb9fe1a85ec53ull;
+                hash ^= hash >> 33;
+                return hash;
+            }
+        };
+
+        // Numeric value of the first 64 bits of a key (its first 16 hexadecimal digits)
+        uint64_t getKeyPrefix(const std::string& key)
+        {
+            return (uint64_t)std::stoull(key.substr(0, 16), nullptr, 16);
+        }
+
+        std::string getCacheFilePath(const std::string& cacheDirectory, const unsigned int fileIndex)
+        {
+            return cacheDirectory + "cache_" + std::to_string(fileIndex) + ".opheat";
+        }
+    }
+
+    struct NetOutputCache::ImplNetOutputCache
+    {
+        const std::string mCacheDirectory;
+        const int mCompressionLevel;
+        // Existing files (read-only) and their entries: key prefix -> (file, frame)
+        std::vector<std::unique_ptr<HeatMapBinaryReader>> upReaders;
+        std::unordered_map<uint64_t, std::pair<unsigned int, unsigned long long>> mEntries;
+        // New entries (appended into a new file, opened with the first entry)
+        std::mutex mSaverMutex;
+        std::unique_ptr<HeatMapBinarySaver> upSaver;
+        std::unordered_set<uint64_t> mNewEntries;
+        std::atomic<unsigned long long> mNumberHits;
+        std::atomic<unsigned long long> mNumberMisses;
+
+        ImplNetOutputCache(const std::string& cacheDirectory, const int compressionLevel) :
+            mCacheDirectory{formatAsDirectory(cacheDirectory)},
+            mCompressionLevel{compressionLevel},
+            mNumberHits{0ull},
+            mNumberMisses{0ull}
+        {
+        }
+    };
+
+    NetOutputCache::NetOutputCache(const std::string& cacheDirectory, const int compressionLevel) :
+        upImpl{new ImplNetOutputCache{cacheDirectory, compressionLevel}}
+    {
+        try
+        {
+            makeDirectory(upImpl->mCacheDirectory);
+            // Memory-map the existing files (only their frame headers are read)
+            for (auto fileIndex = 0u ; existFile(getCacheFilePath(upImpl->mCacheDirectory, fileIndex)) ; fileIndex++)
+            {
+                upImpl->upReaders.emplace_back(
+                    new HeatMapBinaryReader{getCacheFilePath(upImpl->mCacheDirectory, fileIndex)});
+                const auto& reader = *upImpl->upReaders.back();
+                for (auto frame = 0ull ; frame < reader.getNumberFrames() ; frame++)
+                    upImpl->mEntries.emplace(
+                        getKeyPrefix(reader.getFrameName(frame)), std::make_pair(fileIndex, frame));
+            }
+            opLog("Network output cache " + upImpl->mCacheDirectory + " opened with "
+                  + std::to_string(upImpl->mEntries.size()) + " entries.", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    NetOutputCache::~NetOutputCache()
+    {
+        try
+        {
+            opLog("Network output cache " + upImpl->mCacheDirectory + ": " + std::to_string(upImpl->mNumberHits)
+                  + " hits, " + std::to_string(upImpl->mNumberMisses) + " misses.", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::string NetOutputCache::getKey(const std::vector<Array<float>>& inputNetData, const std::string& modelKey) const
+    {
+        try
+        {
+            KeyHasher keyHasher;
+            keyHasher.addBytes(modelKey.data(), modelKey.size());
+            for (const auto& inputNetDataI : inputNetData)
+            {
+                const auto& sizes = inputNetDataI.getSize();
+                keyHasher.addBytes(sizes.data(), sizes.size() * sizeof(int));
+                keyHasher.addBytes(inputNetDataI.getConstPtr(), inputNetDataI.getVolume() * sizeof(float));
+            }
+            char key[33];
+            std::snprintf(key, sizeof(key), "%016llx%016llx",
+                          (unsigned long long)KeyHasher::finalize(keyHasher.mHash1),
+                          (unsigned long long)KeyHasher::finalize(keyHasher.mHash2));
+            return std::string{key};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    bool NetOutputCache::get(std::vector<Array<float>>& netOutputs, const std::string& key)
+    {
+        try
+        {
+            // The existing entries are read-only, so they are read without locking
+            const auto entry = upImpl->mEntries.find(getKeyPrefix(key));
+            if (entry != upImpl->mEntries.end())
+            {
+                const auto& reader = *upImpl->upReaders.at(entry->second.first);
+                // Whole key check (the index only uses its first 64 bits)
+                if (reader.getFrameName(entry->second.second) == key)
+                {
+                    reader.readFrame(netOutputs, entry->second.second);
+                    upImpl->mNumberHits++;
+                    return true;
+                }
+            }
+            upImpl->mNumberMisses++;
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void NetOutputCache::add(const std::vector<Array<float>>& netOutputs, const std::string& key)
+    {
+        try
+        {
+            const auto keyPrefix = getKeyPrefix(key);
+            if (upImpl->mEntries.find(keyPrefix) != upImpl->mEntries.end())
+                return;
+            const std::lock_guard<std::mutex> lock{upImpl->mSaverMutex};
+            if (!upImpl->mNewEntries.emplace(keyPrefix).second)
+                return;
+            if (upImpl->upSaver == nullptr)
+                upImpl->upSaver.reset(new HeatMapBinarySaver{
+                    getCacheFilePath(upImpl->mCacheDirectory, (unsigned int)upImpl->upReaders.size()),
+                    HeatMapPrecision::Float16, upImpl->mCompressionLevel});
+            upImpl->upSaver->save(netOutputs, key);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned long long NetOutputCache::getNumberHits() const
+    {
+        try
+        {
+            return upImpl->mNumberHits;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    unsigned long long NetOutputCache::getNumberMisses() const
+    {
+        try
+        {
+            return upImpl->mNumberMisses;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+}
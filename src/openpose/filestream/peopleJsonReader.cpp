@@ -0,0 +1,668 @@
+#include <openpose/filestream/peopleJsonReader.hpp>
+#include <algorithm> // std::find
+#include <array>
+#include <cstdlib> // std::strtof
+#include <cstring> // std::memcmp, std::memcpy
+#include <limits>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/fileSystem.hpp>
+#include <openpose_private/utilities/avx.hpp>
+#include <openpose_private/utilities/memoryMappedFile.hpp>
+#include <openpose_private/utilities/neon.hpp>
+#include <openpose_private/utilities/parallelFor.hpp>
+
+namespace op
+{
+    namespace
+    {
+        // Keys of PeopleJsonSaver, and number of channels of each one (the 2-D keypoints are (x, y, score), and the
+        // 3-D ones (x, y, z, score))
+        const auto PEOPLE_JSON_NUMBER_KEYS = 9;
+        const std::array<std::string, PEOPLE_JSON_NUMBER_KEYS> PEOPLE_JSON_KEYS{{
+            "person_id",
+            "pose_keypoints_2d", "face_keypoints_2d", "hand_left_keypoints_2d", "hand_right_keypoints_2d",
+            "pose_keypoints_3d", "face_keypoints_3d", "hand_left_keypoints_3d", "hand_right_keypoints_3d"}};
+        const std::array<int, PEOPLE_JSON_NUMBER_KEYS> PEOPLE_JSON_CHANNELS{{1, 3, 3, 3, 3, 4, 4, 4, 4}};
+        const std::string PEOPLE_JSON_SUFFIX{"_keypoints.json"};
+
+        // Exact powers of 10 (for the fast path of parseFloat())
+        const float POW10_FLOAT[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+        const double POW10_DOUBLE[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13,
+                                       1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+        inline bool isJsonWhitespace(const char character)
+        {
+            return character == ' ' || character == '\n' || character == '\t' || character == '\r';
+        }
+
+        // Characters that change the nesting of a JSON value (the escape one only inside strings)
+        inline bool isJsonSpecial(const char character)
+        {
+            return character == '"' || character == '\\' || character == '[' || character == ']'
+                || character == '{' || character == '}';
+        }
+
+        // It returns the first character in [ptr, endPtr) that is not a whitespace (or endPtr)
+        using JsonScanFunction = const char* (*)(const char* ptr, const char* const endPtr);
+
+        const char* skipWhitespaceScalar(const char* ptr, const char* const endPtr)
+        {
+            while (ptr < endPtr && isJsonWhitespace(*ptr))
+                ptr++;
+            return ptr;
+        }
+
+        const char* findSpecialScalar(const char* ptr, const char* const endPtr)
+        {
+            while (ptr < endPtr && !isJsonSpecial(*ptr))
+                ptr++;
+            return ptr;
+        }
+
+        #ifdef WITH_AVX
+            inline int countTrailingZeros(const unsigned int mask)
+            {
+                #ifdef _MSC_VER
+                    unsigned long index;
+                    _BitScanForward(&index, mask);
+                    return (int)index;
+                #else
+                    return __builtin_ctz(mask);
+                #endif
+            }
+
+            OP_TARGET_AVX2 const char* skipWhitespaceAvx2(const char* ptr, const char* const endPtr)
+            {
+                const auto space = _mm256_set1_epi8(' ');
+                const auto newLine = _mm256_set1_epi8('\n');
+                const auto tab = _mm256_set1_epi8('\t');
+                const auto carriageReturn = _mm256_set1_epi8('\r');
+                // 32 characters at a time
+                for ( ; ptr + 32 <= endPtr ; ptr += 32)
+                {
+                    const auto characters = _mm256_loadu_si256((const __m256i*)ptr);
+                    const auto isWhitespace = _mm256_or_si256(
+                        _mm256_or_si256(_mm256_cmpeq_epi8(characters, space), _mm256_cmpeq_epi8(characters, newLine)),
+                        _mm256_or_si256(_mm256_cmpeq_epi8(characters, tab),
+                                        _mm256_cmpeq_epi8(characters, carriageReturn)));
+                    const auto notWhitespaceMask = ~(unsigned int)_mm256_movemask_epi8(isWhitespace);
+                    if (notWhitespaceMask != 0u)
+                        return ptr + countTrailingZeros(notWhitespaceMask);
+                }
+                return skipWhitespaceScalar(ptr, endPtr);
+            }
+
+            OP_TARGET_AVX2 const char* findSpecialAvx2(const char* ptr, const char* const endPtr)
+            {
+                const auto quote = _mm256_set1_epi8('"');
+                const auto backslash = _mm256_set1_epi8('\\');
+                const auto bracketOpen = _mm256_set1_epi8('[');
+                const auto bracketClose = _mm256_set1_epi8(']');
+                const auto braceOpen = _mm256_set1_epi8('{');
+                const auto braceClose = _mm256_set1_epi8('}');
+                // 32 characters at a time
+                for ( ; ptr + 32 <= endPtr ; ptr += 32)
+                {
+                    const auto characters = _mm256_loadu_si256((const __m256i*)ptr);
+                    const auto isSpecial = _mm256_or_si256(
+                        _mm256_or_si256(_mm256_cmpeq_epi8(characters, quote), _mm256_cmpeq_epi8(characters, backslash)),
+                        _mm256_or_si256(
+                            _mm256_or_si256(_mm256_cmpeq_epi8(characters, bracketOpen),
+                                            _mm256_cmpeq_epi8(characters, bracketClose)),
+                            _mm256_or_si256(_mm256_cmpeq_epi8(characters, braceOpen),
+                                            _mm256_cmpeq_epi8(characters, braceClose))));
+                    const auto specialMask = (unsigned int)_mm256_movemask_epi8(isSpecial);
+                    if (specialMask != 0u)
+                        return ptr + countTrailingZeros(specialMask);
+                }
+                return findSpecialScalar(ptr, endPtr);
+            }
+        #endif
+
+        #ifdef WITH_NEON
+            // Bit mask of a byte comparison (4 bits per byte, NEON has no movemask)
+            inline uint64_t getMaskNeon(const uint8x16_t comparison)
+            {
+                return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(comparison), 4)), 0);
+            }
+
+            inline int countTrailingZeros64(const uint64_t mask)
+            {
+                #ifdef _MSC_VER
+                    unsigned long index;
+                    _BitScanForward64(&index, mask);
+                    return (int)index;
+                #else
+                    return __builtin_ctzll(mask);
+                #endif
+            }
+
+            const char* skipWhitespaceNeon(const char* ptr, const char* const endPtr)
+            {
+                const auto space = vdupq_n_u8(' ');
+                const auto newLine = vdupq_n_u8('\n');
+                const auto tab = vdupq_n_u8('\t');
+                const auto carriageReturn = vdupq_n_u8('\r');
+                // 16 characters at a time
+                for ( ; ptr + 16 <= endPtr ; ptr += 16)
+                {
+                    const auto characters = vld1q_u8((const uint8_t*)ptr);
+                    const auto isWhitespace = vorrq_u8(
+                        vorrq_u8(vceqq_u8(characters, space), vceqq_u8(characters, newLine)),
+                        vorrq_u8(vceqq_u8(characters, tab), vceqq_u8(characters, carriageReturn)));
+                    const auto notWhitespaceMask = ~getMaskNeon(isWhitespace);
+                    if (notWhitespaceMask != 0u)
+                        return ptr + countTrailingZeros64(notWhitespaceMask) / 4;
+                }
+                return skipWhitespaceScalar(ptr, endPtr);
+            }
+
+            const char* findSpecialNeon(const char* ptr, const char* const endPtr)
+            {
+                const auto quote = vdupq_n_u8('"');
+                const auto backslash = vdupq_n_u8('\\');
+                const auto bracketOpen = vdupq_n_u8('[');
+                const auto bracketClose = vdupq_n_u8(']');
+                const auto braceOpen = vdupq_n_u8('{');
+                const auto braceClose = vdupq_n_u8('}');
+                // 16 characters at a time
+                for ( ; ptr + 16 <= endPtr ; ptr += 16)
+                {
+                    const auto characters = vld1q_u8((const uint8_t*)ptr);
+                    const auto isSpecial = vorrq_u8(
+                        vorrq_u8(vceqq_u8(characters, quote), vceqq_u8(characters, backslash)),
+                        vorrq_u8(vorrq_u8(vceqq_u8(characters, bracketOpen), vceqq_u8(characters, bracketClose)),
+                                 vorrq_u8(vceqq_u8(characters, braceOpen), vceqq_u8(characters, braceClose))));
+                    const auto specialMask = getMaskNeon(isSpecial);
+                    if (specialMask != 0u)
+                        return ptr + countTrailingZeros64(specialMask) / 4;
+                }
+                return findSpecialScalar(ptr, endPtr);
+            }
+        #endif
+
+        // SIMD versions selected at runtime (the scalar ones if none)
+        struct JsonScanFunctions
+        {
+            JsonScanFunction skipWhitespace;
+            JsonScanFunction findSpecial;
+        };
+
+        const JsonScanFunctions& getJsonScanFunctions()
+        {
+            #if defined WITH_AVX
+                static const JsonScanFunctions sJsonScanFunctions = (cpuSupportsAvx2()
+                    ? JsonScanFunctions{&skipWhitespaceAvx2, &findSpecialAvx2}
+                    : JsonScanFunctions{&skipWhitespaceScalar, &findSpecialScalar});
+            #elif defined WITH_NEON
+                static const JsonScanFunctions sJsonScanFunctions = (cpuSupportsNeon()
+                    ? JsonScanFunctions{&skipWhitespaceNeon, &findSpecialNeon}
+                    : JsonScanFunctions{&skipWhitespaceScalar, &findSpecialScalar});
+            #else
+                static const JsonScanFunctions sJsonScanFunctions{&skipWhitespaceScalar, &findSpecialScalar};
+            #endif
+            return sJsonScanFunctions;
+        }
+
+        // Streaming parser of the people JSON: It reads the characters once, and the keypoints are appended to its
+        // buffers (which keep their capacity between frames) as they are read
+        class PeopleJsonParser
+        {
+        public:
+            PeopleJsonParser() :
+                mJsonScanFunctions(getJsonScanFunctions())
+            {
+            }
+
+            void parse(Datum& datum, const char* const jsonPtr, const unsigned long long jsonSize,
+                       const std::string& sourceName)
+            {
+                pBegin = jsonPtr;
+                pPtr = jsonPtr;
+                pEnd = jsonPtr + jsonSize;
+                pSourceName = &sourceName;
+                mValues.clear();
+                mPeopleRanges.clear();
+                // Root object (only "people" is read, e.g., "version" and "part_candidates" are skipped)
+                expect('{');
+                if (!consumeIf('}'))
+                {
+                    do
+                    {
+                        if (parseKey() == "people")
+                            parsePeople();
+                        else
+                            skipValue();
+                    } while (consumeIf(','));
+                    expect('}');
+                }
+                // Keypoints to datum
+                fillPoseIds(datum.poseIds);
+                Array<float>* const keypointArrays[PEOPLE_JSON_NUMBER_KEYS-1]{
+                    &datum.poseKeypoints, &datum.faceKeypoints, &datum.handKeypoints[0], &datum.handKeypoints[1],
+                    &datum.poseKeypoints3D, &datum.faceKeypoints3D, &datum.handKeypoints3D[0],
+                    &datum.handKeypoints3D[1]};
+                for (auto key = 1 ; key < PEOPLE_JSON_NUMBER_KEYS ; key++)
+                    fillKeypoints(*keypointArrays[key-1], key);
+            }
+
+        private:
+            const JsonScanFunctions& mJsonScanFunctions;
+            const char* pBegin;
+            const char* pPtr;
+            const char* pEnd;
+            const std::string* pSourceName;
+            // Values of all the arrays of the keys of PEOPLE_JSON_KEYS, and (first value, number values) of each
+            // person and key ({0, 0} if the person does not have it)
+            std::vector<float> mValues;
+            std::vector<std::array<std::pair<size_t, size_t>, PEOPLE_JSON_NUMBER_KEYS>> mPeopleRanges;
+
+            void errorOnPosition(const std::string& message) const
+            {
+                error("Invalid people JSON " + *pSourceName + " (byte " + std::to_string(pPtr - pBegin) + "): "
+                      + message, __LINE__, __FUNCTION__, __FILE__);
+            }
+
+            inline void skipWhitespace()
+            {
+                // Most tokens are not preceded by whitespace (unless humanReadable)
+                if (pPtr < pEnd && isJsonWhitespace(*pPtr))
+                    pPtr = mJsonScanFunctions.skipWhitespace(pPtr, pEnd);
+            }
+
+            inline bool consumeIf(const char character)
+            {
+                skipWhitespace();
+                if (pPtr < pEnd && *pPtr == character)
+                {
+                    pPtr++;
+                    return true;
+                }
+                return false;
+            }
+
+            inline void expect(const char character)
+            {
+                if (!consumeIf(character))
+                    errorOnPosition(std::string{"'"} + character + "' expected.");
+            }
+
+            // It moves pPtr after the closing quote of the string whose opening quote was already read
+            void skipStringBody()
+            {
+                while (true)
+                {
+                    pPtr = mJsonScanFunctions.findSpecial(pPtr, pEnd);
+                    if (pPtr >= pEnd)
+                        errorOnPosition("Unterminated string.");
+                    else if (*pPtr == '"')
+                    {
+                        pPtr++;
+                        return;
+                    }
+                    else if (*pPtr == '\\')
+                        pPtr += 2;
+                    else
+                        pPtr++;
+                }
+            }
+
+            // It returns the key (without quotes nor unescaping, enough for the keys of PEOPLE_JSON_KEYS) and
+            // consumes its ':'
+            std::string parseKey()
+            {
+                expect('"');
+                const auto* const keyBegin = pPtr;
+                skipStringBody();
+                std::string key{keyBegin, (size_t)(pPtr - 1 - keyBegin)};
+                expect(':');
+                return key;
+            }
+
+            void skipValue()
+            {
+                skipWhitespace();
+                if (pPtr >= pEnd)
+                    errorOnPosition("Value expected.");
+                // String
+                if (*pPtr == '"')
+                {
+                    pPtr++;
+                    skipStringBody();
+                }
+                // Array or object (only its special characters are visited)
+                else if (*pPtr == '[' || *pPtr == '{')
+                {
+                    auto depth = 0;
+                    do
+                    {
+                        pPtr = mJsonScanFunctions.findSpecial(pPtr, pEnd);
+                        if (pPtr >= pEnd)
+                            errorOnPosition("Unterminated array or object.");
+                        const auto character = *pPtr++;
+                        if (character == '"')
+                            skipStringBody();
+                        else if (character == '[' || character == '{')
+                            depth++;
+                        else if (character == ']' || character == '}')
+                            depth--;
+                    } while (depth > 0);
+                }
+                // Number, true, false or null
+                else
+                {
+                    const auto* const valueBegin = pPtr;
+                    while (pPtr < pEnd && *pPtr != ',' && *pPtr != '}' && *pPtr != ']' && !isJsonWhitespace(*pPtr))
+                        pPtr++;
+                    if (pPtr == valueBegin)
+                        errorOnPosition("Value expected.");
+                }
+            }
+
+            void parsePeople()
+            {
+                expect('[');
+                if (consumeIf(']'))
+                    return;
+                do
+                {
+                    expect('{');
+                    mPeopleRanges.emplace_back();
+                    mPeopleRanges.back().fill(std::make_pair(size_t(0), size_t(0)));
+                    if (!consumeIf('}'))
+                    {
+                        do
+                        {
+                            const auto key = parseKey();
+                            const auto keyIndex = std::find(PEOPLE_JSON_KEYS.begin(), PEOPLE_JSON_KEYS.end(), key)
+                                                - PEOPLE_JSON_KEYS.begin();
+                            if (keyIndex < PEOPLE_JSON_NUMBER_KEYS)
+                                mPeopleRanges.back()[keyIndex] = parseFloatArray();
+                            else
+                                skipValue();
+                        } while (consumeIf(','));
+                        expect('}');
+                    }
+                } while (consumeIf(','));
+                expect(']');
+            }
+
+            std::pair<size_t, size_t> parseFloatArray()
+            {
+                expect('[');
+                const auto firstValue = mValues.size();
+                if (!consumeIf(']'))
+                {
+                    do
+                    {
+                        skipWhitespace();
+                        mValues.emplace_back(parseFloat());
+                    } while (consumeIf(','));
+                    expect(']');
+                }
+                return std::make_pair(firstValue, mValues.size() - firstValue);
+            }
+
+            // It parses the number on pPtr (including the nan and inf of JsonOfstream)
+            float parseFloat()
+            {
+                const auto* const numberBegin = pPtr;
+                const auto negative = (pPtr < pEnd && *pPtr == '-');
+                if (negative)
+                    pPtr++;
+                // nan, inf
+                if (pEnd - pPtr >= 3 && (std::memcmp(pPtr, "nan", 3) == 0 || std::memcmp(pPtr, "inf", 3) == 0))
+                {
+                    const auto isNan = (*pPtr == 'n');
+                    pPtr += 3;
+                    if (isNan)
+                        return std::numeric_limits<float>::quiet_NaN();
+                    return (negative ? -std::numeric_limits<float>::infinity()
+                            : std::numeric_limits<float>::infinity());
+                }
+                // Up to 19 significant digits (the most that fit in 64 bits)
+                auto mantissa = 0ull;
+                auto numberDigits = 0;
+                auto numberSignificantDigits = 0;
+                auto exponent = 0;
+                const auto addDigit = [&](const int digit, const bool isFraction)
+                {
+                    numberDigits++;
+                    if (numberSignificantDigits < 19)
+                    {
+                        mantissa = 10*mantissa + digit;
+                        if (mantissa > 0)
+                            numberSignificantDigits++;
+                        if (isFraction)
+                            exponent--;
+                    }
+                    // Digits that do not fit (strtof() below)
+                    else
+                    {
+                        numberSignificantDigits++;
+                        if (!isFraction)
+                            exponent++;
+                    }
+                };
+                for ( ; pPtr < pEnd && *pPtr >= '0' && *pPtr <= '9' ; pPtr++)
+                    addDigit(*pPtr - '0', false);
+                if (pPtr < pEnd && *pPtr == '.')
+                    for (pPtr++ ; pPtr < pEnd && *pPtr >= '0' && *pPtr <= '9' ; pPtr++)
+                        addDigit(*pPtr - '0', true);
+                if (numberDigits == 0)
+                    errorOnPosition("Number expected.");
+                if (pPtr < pEnd && (*pPtr == 'e' || *pPtr == 'E'))
+                {
+                    pPtr++;
+                    const auto negativeExponent = (pPtr < pEnd && *pPtr == '-');
+                    if (pPtr < pEnd && (*pPtr == '-' || *pPtr == '+'))
+                        pPtr++;
+                    if (pPtr >= pEnd || *pPtr < '0' || *pPtr > '9')
+                        errorOnPosition("Exponent expected.");
+                    auto exponentValue = 0;
+                    for ( ; pPtr < pEnd && *pPtr >= '0' && *pPtr <= '9' ; pPtr++)
+                        exponentValue = fastMin(10*exponentValue + (*pPtr - '0'), 100000);
+                    exponent += (negativeExponent ? -exponentValue : exponentValue);
+                }
+                // Fast paths (Clinger): The mantissa and the power of 10 are exact, so the result of the IEEE
+                // multiplication or division is correctly rounded. The float one covers most of the coordinates
+                // (e.g., "1234.5678"), and the double one most of the scores (e.g., "0.912345678")
+                if (mantissa == 0ull)
+                    return (negative ? -0.f : 0.f);
+                if (numberSignificantDigits <= 19)
+                {
+                    if (mantissa <= (1ull << 24) && exponent >= -10 && exponent <= 10)
+                    {
+                        const auto value = (exponent < 0 ? (float)mantissa / POW10_FLOAT[-exponent]
+                                            : (float)mantissa * POW10_FLOAT[exponent]);
+                        return (negative ? -value : value);
+                    }
+                    if (mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22)
+                    {
+                        const auto value = (exponent < 0 ? (double)mantissa / POW10_DOUBLE[-exponent]
+                                            : (double)mantissa * POW10_DOUBLE[exponent]);
+                        return (float)(negative ? -value : value);
+                    }
+                }
+                // Slow path (e.g., more than 19 digits or very large exponents)
+                const std::string numberString{numberBegin, (size_t)(pPtr - numberBegin)};
+                return std::strtof(numberString.c_str(), nullptr);
+            }
+
+            void fillPoseIds(Array<long long>& poseIds) const
+            {
+                const auto numberPeople = (int)mPeopleRanges.size();
+                auto anyPoseId = false;
+                for (const auto& personRanges : mPeopleRanges)
+                    anyPoseId |= (personRanges[0].second > 0);
+                if (!anyPoseId)
+                {
+                    poseIds.reset();
+                    return;
+                }
+                poseIds.reset(numberPeople, -1ll);
+                for (auto person = 0 ; person < numberPeople ; person++)
+                    if (mPeopleRanges[person][0].second > 0)
+                        poseIds[person] = (long long)mValues[mPeopleRanges[person][0].first];
+            }
+
+            void fillKeypoints(Array<float>& keypoints, const int key) const
+            {
+                // The people without this key (or with an empty array) are 0
+                const auto numberPeople = (int)mPeopleRanges.size();
+                const auto numberChannels = PEOPLE_JSON_CHANNELS[key];
+                auto numberValues = size_t(0);
+                for (const auto& personRanges : mPeopleRanges)
+                {
+                    if (personRanges[key].second % numberChannels != 0)
+                        error("Invalid people JSON " + *pSourceName + ": The size of " + PEOPLE_JSON_KEYS[key]
+                              + " is not a multiple of " + std::to_string(numberChannels) + ".",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    numberValues = fastMax(numberValues, personRanges[key].second);
+                }
+                if (numberValues == 0)
+                {
+                    keypoints.reset();
+                    return;
+                }
+                keypoints.reset({numberPeople, (int)numberValues / numberChannels, numberChannels}, 0.f);
+                for (auto person = 0 ; person < numberPeople ; person++)
+                {
+                    const auto& range = mPeopleRanges[person][key];
+                    if (range.second > 0)
+                        std::memcpy(keypoints.getPtr() + person*numberValues, &mValues[range.first],
+                                    range.second * sizeof(float));
+                }
+            }
+        };
+
+        void parsePeopleJsonAuxiliary(
+            Datum& datum, const char* const jsonPtr, const unsigned long long jsonSize, const std::string& sourceName)
+        {
+            try
+            {
+                // 1 parser per thread, so its buffers are only allocated for the first frames
+                thread_local PeopleJsonParser tPeopleJsonParser;
+                tPeopleJsonParser.parse(datum, jsonPtr, jsonSize, sourceName);
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+    }
+
+    struct PeopleJsonReader::ImplPeopleJsonReader
+    {
+        std::vector<std::string> mFilePaths;
+    };
+
+    PeopleJsonReader::PeopleJsonReader(const std::string& path) :
+        upImpl{new ImplPeopleJsonReader{}}
+    {
+        try
+        {
+            if (existDirectory(path))
+                upImpl->mFilePaths = getFilesOnDirectory(path, ".json");
+            else if (existFile(path))
+                upImpl->mFilePaths.emplace_back(path);
+            else
+                error("Path " + path + " does not exist.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    PeopleJsonReader::~PeopleJsonReader()
+    {
+    }
+
+    unsigned long long PeopleJsonReader::getNumberFrames() const
+    {
+        try
+        {
+            return upImpl->mFilePaths.size();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    const std::string& PeopleJsonReader::getFilePath(const unsigned long long frameIndex) const
+    {
+        try
+        {
+            if (frameIndex >= upImpl->mFilePaths.size())
+                error("Frame " + std::to_string(frameIndex) + " out of bounds (there are "
+                      + std::to_string(upImpl->mFilePaths.size()) + " JSON files).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            return upImpl->mFilePaths[frameIndex];
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return upImpl->mFilePaths.at(0);
+        }
+    }
+
+    void PeopleJsonReader::readFrame(Datum& datum, const unsigned long long frameIndex) const
+    {
+        try
+        {
+            const auto& filePath = getFilePath(frameIndex);
+            const MemoryMappedFile memoryMappedFile{filePath};
+            parsePeopleJsonAuxiliary(
+                datum, (const char*)memoryMappedFile.getData(), memoryMappedFile.getSize(), filePath);
+            // Name (as in WPeopleJsonSaver)
+            auto name = getFileNameAndExtension(filePath);
+            if (name.size() > PEOPLE_JSON_SUFFIX.size()
+                && name.compare(name.size() - PEOPLE_JSON_SUFFIX.size(), PEOPLE_JSON_SUFFIX.size(),
+                                PEOPLE_JSON_SUFFIX) == 0)
+                name.resize(name.size() - PEOPLE_JSON_SUFFIX.size());
+            else
+                name = getFileNameNoExtension(filePath);
+            datum.name = name;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PeopleJsonReader::readFrames(
+        std::vector<Datum>& datums, const unsigned long long firstFrame, const unsigned long long numberFrames) const
+    {
+        try
+        {
+            const auto totalFrames = getNumberFrames();
+            const auto lastFrame = (firstFrame < totalFrames
+                ? firstFrame + fastMin(numberFrames, totalFrames - firstFrame) : firstFrame);
+            datums.resize(lastFrame - firstFrame);
+            // 1 file per job (each one is memory-mapped and parsed independently)
+            parallelFor(0, (int)datums.size(), [&](const int i)
+            {
+                readFrame(datums[i], firstFrame + i);
+            });
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void parsePeopleJson(Datum& datum, const char* const jsonPtr, const unsigned long long jsonSize)
+    {
+        try
+        {
+            parsePeopleJsonAuxiliary(datum, jsonPtr, jsonSize, "string");
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -1,10 +1,12 @@
 #include <openpose/filestream/peopleJsonSaver.hpp>
 #include <openpose/filestream/fileStream.hpp>
+#include <openpose_private/filestream/asyncFileWriter.hpp>
 
 namespace op
 {
-    PeopleJsonSaver::PeopleJsonSaver(const std::string& directoryPath) :
-        FileSaver{directoryPath}
+    PeopleJsonSaver::PeopleJsonSaver(const std::string& directoryPath, const bool asynchronous) :
+        FileSaver{directoryPath},
+        spAsyncFileWriter{asynchronous ? std::make_shared<AsyncFileWriter>() : nullptr}
     {
     }
 
@@ -15,13 +17,46 @@ namespace op
     void PeopleJsonSaver::save(
         const std::vector<std::pair<Array<float>, std::string>>& keypointVector,
         const std::vector<std::vector<std::array<float,3>>>& candidates, const std::string& fileName,
-        const bool humanReadable) const
+        const bool humanReadable, const std::vector<DatumTimingEvent>& timingEvents) const
     {
         try
         {
             // Record json
             const auto finalFileName = getNextFileName(fileName) + ".json";
-            savePeopleJson(keypointVector, candidates, finalFileName, humanReadable);
+            if (spAsyncFileWriter != nullptr)
+            {
+                auto jsonString = spAsyncFileWriter->getBuffer();
+                peopleJsonToString(jsonString, keypointVector, candidates, humanReadable, timingEvents);
+                spAsyncFileWriter->write(finalFileName, std::move(jsonString));
+            }
+            else
+                savePeopleJson(keypointVector, candidates, finalFileName, humanReadable, timingEvents);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PeopleJsonSaver::save(
+        const std::vector<std::pair<Array<float>, std::string>>& keypointVector, const Array<float>& candidates,
+        const std::vector<int>& candidateOffsets, const std::string& fileName, const bool humanReadable,
+        const std::vector<DatumTimingEvent>& timingEvents) const
+    {
+        try
+        {
+            // Record json
+            const auto finalFileName = getNextFileName(fileName) + ".json";
+            if (spAsyncFileWriter != nullptr)
+            {
+                auto jsonString = spAsyncFileWriter->getBuffer();
+                peopleJsonToString(
+                    jsonString, keypointVector, candidates, candidateOffsets, humanReadable, timingEvents);
+                spAsyncFileWriter->write(finalFileName, std::move(jsonString));
+            }
+            else
+                savePeopleJson(
+                    keypointVector, candidates, candidateOffsets, finalFileName, humanReadable, timingEvents);
         }
         catch (const std::exception& e)
         {
@@ -3,6 +3,7 @@
 #include <openpose/filestream/imageSaver.hpp>
 #include <openpose/utilities/fileSystem.hpp>
 #include <openpose/utilities/string.hpp>
+#include <openpose_private/utilities/asyncJobQueue.hpp>
 
 namespace op
 {
@@ -14,22 +15,31 @@ namespace op
         const int mCvFourcc;
         const double mFps;
         const std::string mAddAudioFromThisVideo;
+        const int mNumberThreads;
+        const std::string mFfmpegEncoder;
         const bool mUseFfmpeg;
         Point<int> mCvSize;
         bool mVideoStarted;
+        bool mVideoWriterOpened;
         unsigned long long mImageSaverCounter;
         cv::VideoWriter mVideoWriter;
         std::unique_ptr<ImageSaver> upImageSaver;
         std::string mTempImageFolder;
+        // Background thread of mVideoWriter (destroyed before it)
+        std::unique_ptr<AsyncJobQueue> upAsyncJobQueue;
 
         ImplVideoSaver(const std::string& videoSaverPath, const int cvFourcc, const double fps,
-                       const std::string& addAudioFromThisVideo) :
+                       const std::string& addAudioFromThisVideo, const int numberThreads,
+                       const std::string& ffmpegEncoder) :
             mVideoSaverPath{videoSaverPath},
             mCvFourcc{cvFourcc},
             mFps{fps},
             mAddAudioFromThisVideo{addAudioFromThisVideo},
+            mNumberThreads{numberThreads},
+            mFfmpegEncoder{ffmpegEncoder},
             mUseFfmpeg{toLower(getFileExtension(videoSaverPath)) == "mp4"},
             mVideoStarted{false},
+            mVideoWriterOpened{false},
             mImageSaverCounter{0ull}
         {
             try
@@ -74,8 +84,10 @@ namespace op
     }
 
     VideoSaver::VideoSaver(const std::string& videoSaverPath, const int cvFourcc, const double fps,
-                           const std::string& addAudioFromThisVideo) :
-        upImpl{new ImplVideoSaver{videoSaverPath, cvFourcc, fps, addAudioFromThisVideo}}
+                           const std::string& addAudioFromThisVideo, const int numberThreads,
+                           const std::string& ffmpegEncoder) :
+        upImpl{new ImplVideoSaver{
+            videoSaverPath, cvFourcc, fps, addAudioFromThisVideo, numberThreads, ffmpegEncoder}}
     {
         try
         {
@@ -91,6 +103,8 @@ namespace op
                       " Please, use an `avi` output format (e.g., `--write_video output.avi`) or install FFmpeg"
                       " by running `sudo apt-get install ffmpeg` (Ubuntu) or an analogous command.",
                       __LINE__, __FUNCTION__, __FILE__);
+            if (upImpl->mFfmpegEncoder.empty())
+                error("The FFmpeg encoder cannot be empty (e.g., `libx264`).", __LINE__, __FUNCTION__, __FILE__);
             if (!upImpl->mAddAudioFromThisVideo.empty() && !upImpl->mUseFfmpeg)
                 error("In order to save the video with audio, it must be in MP4 format. So either 1) do not set"
                       " `--write_video_audio` or 2) make sure `--write_video` finishes in `.mp4`.",
@@ -106,8 +120,11 @@ namespace op
     {
         try
         {
+            // Write the frames still in the background threads
+            upImpl->upAsyncJobQueue.reset();
+            upImpl->upImageSaver.reset();
             // Images --> Video
-            if (upImpl->mUseFfmpeg)
+            if (upImpl->mUseFfmpeg && upImpl->mVideoStarted)
             {
                 opLog("JPG images temporarily generated in " + upImpl->mTempImageFolder + ".", op::Priority::High);
                 // FFmpeg command: Save video from images (override if video with same name exists)
@@ -117,7 +134,7 @@ namespace op
                 // or do a weird resample (`-framerate`)
                 const std::string imageToVideoCommand = "ffmpeg -y -framerate " + std::to_string(upImpl->mFps)
                     + " -i '" + upImpl->mTempImageFolder + "/%12d_rendered.jpg'"
-                    + " -c:v libx264 -pix_fmt yuv420p '"
+                    + " -c:v " + upImpl->mFfmpegEncoder + " -pix_fmt yuv420p '"
                     + upImpl->mVideoSaverPath + "'";
                 opLog("Creating MP4 video out of JPG images by running:\n" + imageToVideoCommand + "\n",
                     op::Priority::High);
@@ -165,9 +182,9 @@ namespace op
             // FFmpeg video
             if (upImpl->mUseFfmpeg)
                 return (upImpl->upImageSaver != nullptr);
-            // OpenCV video
+            // OpenCV video (not mVideoWriter.isOpened(), which might be writing on the background thread)
             else
-                return upImpl->mVideoWriter.isOpened();
+                return upImpl->mVideoWriterOpened;
         }
         catch (const std::exception& e)
         {
@@ -212,12 +229,19 @@ namespace op
                 {
                     opLog("Temporarily saving video frames as JPG images in: " + upImpl->mTempImageFolder,
                         op::Priority::High);
-                    upImpl->upImageSaver.reset(new ImageSaver{upImpl->mTempImageFolder, "jpg"});
+                    upImpl->upImageSaver.reset(
+                        new ImageSaver{upImpl->mTempImageFolder, "jpg", upImpl->mNumberThreads});
                 }
                 // OpenCV video
                 else
+                {
                     upImpl->mVideoWriter = openVideo(
                         upImpl->mVideoSaverPath, upImpl->mCvFourcc, upImpl->mFps, upImpl->mCvSize);
+                    upImpl->mVideoWriterOpened = upImpl->mVideoWriter.isOpened();
+                    // 1 thread so the frames are written in order
+                    if (upImpl->mNumberThreads != 0)
+                        upImpl->upAsyncJobQueue.reset(new AsyncJobQueue{1u, 8ull});
+                }
             }
             // Sanity check
             if (!isOpened())
@@ -243,7 +267,19 @@ namespace op
             }
             // OpenCV video
             else
-                upImpl->mVideoWriter.write(cvOutputData);
+            {
+                // Background thread (the frame is copied since the caller might modify it afterwards)
+                if (upImpl->upAsyncJobQueue != nullptr)
+                {
+                    const cv::Mat cvOutputDataCopy = (cvMats.size() > 1 ? cvOutputData : cvOutputData.clone());
+                    auto* videoWriterPtr = &upImpl->mVideoWriter;
+                    upImpl->upAsyncJobQueue->push(
+                        [videoWriterPtr, cvOutputDataCopy]{ videoWriterPtr->write(cvOutputDataCopy); });
+                }
+                // Calling thread
+                else
+                    upImpl->mVideoWriter.write(cvOutputData);
+            }
         }
         catch (const std::exception& e)
         {
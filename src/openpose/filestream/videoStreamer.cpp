@@ -0,0 +1,262 @@
+#include <openpose/filestream/videoStreamer.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio> // popen
+#include <cstdlib> // system
+#include <mutex>
+#include <thread>
+#ifndef _WIN32
+    #include <signal.h> // pthread_sigmask
+#endif
+#include <opencv2/core/core.hpp> // cv::hconcat
+#include <opencv2/imgproc/imgproc.hpp> // cv::resize
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/string.hpp>
+
+namespace op
+{
+    namespace
+    {
+        bool startsWith(const std::string& string, const std::string& prefix)
+        {
+            return string.compare(0, prefix.size(), prefix) == 0;
+        }
+
+        std::string getFfmpegStreamCommand(
+            const std::string& url, const double fps, const std::string& ffmpegEncoder, const Point<int>& size)
+        {
+            try
+            {
+                const auto urlLower = toLower(url);
+                const auto encoderLower = toLower(ffmpegEncoder);
+                const auto fpsString = std::to_string(fps);
+                const auto isVaapi = (encoderLower.find("vaapi") != std::string::npos);
+                // Raw BGR frames from the pipe, with the time they arrive as timestamps
+                std::string command = "ffmpeg -hide_banner -loglevel error"
+                    + std::string(isVaapi ? " -vaapi_device /dev/dri/renderD128" : "")
+                    + " -fflags nobuffer -use_wallclock_as_timestamps 1 -f rawvideo -pix_fmt bgr24 -s "
+                    + std::to_string(size.x) + "x" + std::to_string(size.y) + " -framerate " + fpsString + " -i -";
+                // Encoder (low-latency settings, no B-frames, and 1 key frame per second so clients join quickly)
+                if (isVaapi)
+                    command += " -vf format=nv12,hwupload -c:v " + ffmpegEncoder;
+                else
+                    command += " -pix_fmt yuv420p -c:v " + ffmpegEncoder;
+                if (encoderLower.find("nvenc") != std::string::npos)
+                    command += " -preset llhp -zerolatency 1 -delay 0";
+                else if (encoderLower == "libx264" || encoderLower == "libx265")
+                    command += " -preset ultrafast -tune zerolatency";
+                command += " -bf 0 -g " + std::to_string(fastMax(1, positiveIntRound(fps)));
+                // Container
+                if (startsWith(urlLower, "rtsp://"))
+                    command += " -f rtsp -rtsp_transport tcp";
+                else if (startsWith(urlLower, "rtmp://"))
+                    command += " -f flv";
+                else if (startsWith(urlLower, "srt://") || startsWith(urlLower, "udp://")
+                         || startsWith(urlLower, "tcp://"))
+                    command += " -f mpegts -flush_packets 1";
+                else
+                    error("Unknown protocol of the video stream URL `" + url + "` (it must start with `rtsp://`,"
+                          " `rtmp://`, `srt://`, `udp://` or `tcp://`).", __LINE__, __FUNCTION__, __FILE__);
+                return command + " '" + url + "'";
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return "";
+            }
+        }
+    }
+
+    struct VideoStreamer::ImplVideoStreamer
+    {
+        const std::string mUrl;
+        const double mFps;
+        const std::string mFfmpegEncoder;
+        // Latest frame not sent yet (1 slot, so a slow stream drops frames rather than delaying them)
+        std::mutex mMutex;
+        std::condition_variable mConditionVariable;
+        cv::Mat mPendingFrame;
+        bool mHasPendingFrame;
+        std::string mErrorMessage;
+        bool mStop;
+        std::atomic<unsigned long long> mFramesSent;
+        std::atomic<unsigned long long> mFramesDropped;
+        std::thread mThread;
+
+        ImplVideoStreamer(const std::string& url, const double fps, const std::string& ffmpegEncoder) :
+            mUrl{url},
+            mFps{fps > 0. ? fps : 30.},
+            mFfmpegEncoder{ffmpegEncoder},
+            mHasPendingFrame{false},
+            mStop{false},
+            mFramesSent{0ull},
+            mFramesDropped{0ull}
+        {
+        }
+
+        // The FFmpeg process is started with the first frame (i.e., once the resolution is known)
+        void threadFunction()
+        {
+            #ifndef _WIN32
+                // If FFmpeg exits, writing into its pipe fails with EPIPE rather than killing OpenPose with SIGPIPE
+                sigset_t sigset;
+                sigemptyset(&sigset);
+                sigaddset(&sigset, SIGPIPE);
+                pthread_sigmask(SIG_BLOCK, &sigset, nullptr);
+            #endif
+            FILE* ffmpegPipe = nullptr;
+            cv::Mat frame;
+            cv::Mat resizedFrame;
+            Point<int> size;
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock{mMutex};
+                    mConditionVariable.wait(lock, [this]{ return mStop || mHasPendingFrame; });
+                    if (mStop)
+                        break;
+                    std::swap(frame, mPendingFrame);
+                    mHasPendingFrame = false;
+                }
+                try
+                {
+                    // Start FFmpeg
+                    if (ffmpegPipe == nullptr)
+                    {
+                        // Even resolution (required by the 4:2:0 encoders)
+                        size = Point<int>{frame.cols & ~1, frame.rows & ~1};
+                        const auto command = getFfmpegStreamCommand(mUrl, mFps, mFfmpegEncoder, size);
+                        opLog("Streaming the video with: " + command, Priority::High);
+                        #ifdef _WIN32
+                            ffmpegPipe = _popen(command.c_str(), "wb");
+                        #else
+                            ffmpegPipe = popen(command.c_str(), "w");
+                        #endif
+                        if (ffmpegPipe == nullptr)
+                            error("FFmpeg could not be started to stream the video into " + mUrl + ".",
+                                  __LINE__, __FUNCTION__, __FILE__);
+                    }
+                    // Same resolution than the first frame
+                    const cv::Mat* framePtr = &frame;
+                    if (frame.cols != size.x || frame.rows != size.y || !frame.isContinuous())
+                    {
+                        cv::resize(frame, resizedFrame, cv::Size{size.x, size.y});
+                        framePtr = &resizedFrame;
+                    }
+                    // Write frame into FFmpeg
+                    const auto bytes = framePtr->total() * framePtr->elemSize();
+                    if (std::fwrite(framePtr->data, 1, bytes, ffmpegPipe) != bytes || std::fflush(ffmpegPipe) != 0)
+                        error("The video stream into " + mUrl + " stopped (FFmpeg exited). Check its error above,"
+                              " e.g., whether the URL is reachable and whether FFmpeg supports the encoder `"
+                              + mFfmpegEncoder + "`.", __LINE__, __FUNCTION__, __FILE__);
+                    mFramesSent++;
+                }
+                catch (const std::exception& e)
+                {
+                    const std::lock_guard<std::mutex> lock{mMutex};
+                    mErrorMessage = e.what();
+                    break;
+                }
+            }
+            // Stop FFmpeg (closing its input makes it finish the stream)
+            if (ffmpegPipe != nullptr)
+            {
+                #ifdef _WIN32
+                    _pclose(ffmpegPipe);
+                #else
+                    pclose(ffmpegPipe);
+                #endif
+            }
+        }
+    };
+
+    VideoStreamer::VideoStreamer(const std::string& url, const double fps, const std::string& ffmpegEncoder) :
+        upImpl{new ImplVideoStreamer{url, fps, ffmpegEncoder}}
+    {
+        try
+        {
+            // Sanity checks
+            if (url.empty())
+                error("The video stream URL cannot be empty.", __LINE__, __FUNCTION__, __FILE__);
+            if (ffmpegEncoder.empty())
+                error("The FFmpeg encoder cannot be empty (e.g., `h264_nvenc`).", __LINE__, __FUNCTION__, __FILE__);
+            // It checks the URL protocol
+            getFfmpegStreamCommand(url, upImpl->mFps, ffmpegEncoder, Point<int>{2, 2});
+            if (system("ffmpeg -version") != 0)
+                error("In order to stream the video, FFmpeg must be installed on your system (e.g., by running"
+                      " `sudo apt-get install ffmpeg` on Ubuntu).", __LINE__, __FUNCTION__, __FILE__);
+            upImpl->mThread = std::thread{&ImplVideoStreamer::threadFunction, upImpl.get()};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    VideoStreamer::~VideoStreamer()
+    {
+        try
+        {
+            if (upImpl->mThread.joinable())
+            {
+                {
+                    const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+                    upImpl->mStop = true;
+                }
+                upImpl->mConditionVariable.notify_all();
+                upImpl->mThread.join();
+                opLog("Video stream into " + upImpl->mUrl + ": " + std::to_string(getNumberFramesSent())
+                      + " frames sent, " + std::to_string(getNumberFramesDropped()) + " frames dropped.",
+                      Priority::High);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void VideoStreamer::write(const std::vector<Matrix>& matsToSend)
+    {
+        try
+        {
+            OP_OP2CVVECTORMAT(cvMats, matsToSend);
+            // Sanity check
+            if (cvMats.empty())
+                error("The image(s) to be streamed cannot be empty.", __LINE__, __FUNCTION__, __FILE__);
+            for (const auto& cvMat : cvMats)
+                if (cvMat.empty() || cvMat.type() != CV_8UC3)
+                    error("The image(s) to be streamed must be non-empty CV_8UC3 images.",
+                          __LINE__, __FUNCTION__, __FILE__);
+            // Replace the pending frame (if any, it is dropped)
+            {
+                const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+                if (!upImpl->mErrorMessage.empty())
+                    error(upImpl->mErrorMessage, __LINE__, __FUNCTION__, __FILE__);
+                if (upImpl->mHasPendingFrame)
+                    upImpl->mFramesDropped++;
+                // Same memory than the previous pending frame or the one already sent (if same size)
+                if (cvMats.size() > 1)
+                    cv::hconcat(cvMats.data(), cvMats.size(), upImpl->mPendingFrame);
+                else
+                    cvMats[0].copyTo(upImpl->mPendingFrame);
+                upImpl->mHasPendingFrame = true;
+            }
+            upImpl->mConditionVariable.notify_all();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned long long VideoStreamer::getNumberFramesSent() const
+    {
+        return upImpl->mFramesSent;
+    }
+
+    unsigned long long VideoStreamer::getNumberFramesDropped() const
+    {
+        return upImpl->mFramesDropped;
+    }
+}
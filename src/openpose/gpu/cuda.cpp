@@ -60,6 +60,31 @@ namespace op
         }
     }
 
+    bool isIntegratedGpu(const int gpuId)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                int integrated = 0;
+                if (cudaDeviceGetAttribute(&integrated, cudaDevAttrIntegrated, gpuId) != cudaSuccess)
+                {
+                    // Clear the CUDA error (e.g., invalid gpuId), it is simply not considered integrated
+                    cudaGetLastError();
+                    return false;
+                }
+                return integrated != 0;
+            #else
+                UNUSED(gpuId);
+                return false;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
     void getNumberCudaThreadsAndBlocks(dim3& numberCudaThreads, dim3& numberCudaBlocks, const Point<unsigned int>& frameSize)
     {
         try
@@ -104,4 +129,64 @@ namespace op
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
         }
     }
+
+    void getBayerRedPixel(int& redX, int& redY, const FrameGpuFormat bayerFormat)
+    {
+        try
+        {
+            if (bayerFormat == FrameGpuFormat::BayerRggb)
+            {
+                redX = 0;
+                redY = 0;
+            }
+            else if (bayerFormat == FrameGpuFormat::BayerBggr)
+            {
+                redX = 1;
+                redY = 1;
+            }
+            else if (bayerFormat == FrameGpuFormat::BayerGrbg)
+            {
+                redX = 1;
+                redY = 0;
+            }
+            else if (bayerFormat == FrameGpuFormat::BayerGbrg)
+            {
+                redX = 0;
+                redY = 1;
+            }
+            else
+                error("FrameGpuFormat " + std::to_string((int)bayerFormat) + " is not a Bayer format.",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    int getOrientationMask(const int rotation, const bool flip)
+    {
+        try
+        {
+            // Bits: 1 = transposed, 2 = mirrored horizontally, 4 = mirrored vertically (in this order), i.e., the
+            // inverse of the cv::transpose + cv::flip of rotateAndFlipFrame()
+            const auto rotationPositive = ((rotation % 360) + 360) % 360;
+            if (rotationPositive == 0)
+                return (flip ? 2 : 0);
+            else if (rotationPositive == 90)
+                return (flip ? 1 : 1 | 2);
+            else if (rotationPositive == 180)
+                return (flip ? 4 : 2 | 4);
+            else if (rotationPositive == 270)
+                return (flip ? 1 | 2 | 4 : 1 | 4);
+            error("Rotation angle = " + std::to_string(rotation) + " != {0, 90, 180, 270} degrees.",
+                  __LINE__, __FUNCTION__, __FILE__);
+            return 0;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0;
+        }
+    }
 }
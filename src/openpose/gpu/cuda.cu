@@ -2,11 +2,20 @@
 #ifdef USE_CUDA
     #include <cuda.h>
     #include <cuda_runtime.h>
+    #include <thrust/device_ptr.h>
+    #include <thrust/execution_policy.h>
+    #include <thrust/scan.h>
+    #include <openpose/gpu/cudaMemoryPool.hpp>
+    #include <openpose/utilities/allocationTracker.hpp>
     #include <openpose_private/gpu/cuda.hu>
 #endif
 
 namespace op
 {
+    // sparsifyChannels(): Threads per block (i.e., values of each tile of a channel)
+    const auto SPARSIFY_THREADS = 256u;
+    const auto SPARSIFY_WARPS = SPARSIFY_THREADS / 32u;
+
     template <typename T>
     __global__ void reorderAndNormalizeKernel(
         T* targetPtr, const unsigned char* const srcPtr, const int width, const int height, const int channels)
@@ -33,6 +42,175 @@ namespace op
             targetPtr[x] =  (unsigned char)(fastTruncateCuda(srcPtr[x], T(0), T(255)));
     }
 
+    template <typename T>
+    __global__ void halfCastKernel(T* targetPtr, const __half* const srcPtr, const int volume)
+    {
+        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
+        if (x < volume)
+            targetPtr[x] = loadCuda<T>(srcPtr[x]);
+    }
+
+    template <typename T>
+    inline __device__ T castScaledValue(const float value)
+    {
+        return T(value);
+    }
+
+    // Rounded and saturated into [0, 255]
+    template <>
+    inline __device__ unsigned char castScaledValue(const float value)
+    {
+        return (unsigned char)fastTruncateCuda(value + 0.5f, 0.f, 255.f);
+    }
+
+    template <typename T>
+    __global__ void gatherScaledChannelsKernel(
+        T* targetPtr, const float* const sourcePtr, const unsigned long long volume, const float minValue,
+        const float maxValue, const float scale, const float shift, const bool round)
+    {
+        const auto x = (unsigned long long)blockIdx.x * blockDim.x + threadIdx.x;
+        if (x < volume)
+        {
+            const auto value = fastTruncateCuda(sourcePtr[x], minValue, maxValue) * scale + shift;
+            targetPtr[x] = castScaledValue<T>(round ? fastTruncateCuda(floorf(value + 0.5f), 0.f, 255.f) : value);
+        }
+    }
+
+    // Number of kept values of each tile (SPARSIFY_THREADS consecutive values of a channel)
+    __global__ void sparsifyCountKernel(
+        int* tileCountsPtr, const float* const sourcePtr, const int channelArea, const float threshold)
+    {
+        __shared__ int warpCounts[SPARSIFY_WARPS];
+        const auto tile = blockIdx.x;
+        const auto channel = blockIdx.y;
+        const auto index = (int)(tile * SPARSIFY_THREADS + threadIdx.x);
+        const auto kept = (index < channelArea && fabsf(sourcePtr[channel * channelArea + index]) > threshold);
+        const auto ballot = __ballot_sync(0xffffffffu, kept);
+        if (threadIdx.x % 32u == 0u)
+            warpCounts[threadIdx.x / 32u] = __popc(ballot);
+        __syncthreads();
+        if (threadIdx.x == 0u)
+        {
+            auto tileCount = 0;
+            for (auto warp = 0u ; warp < SPARSIFY_WARPS ; warp++)
+                tileCount += warpCounts[warp];
+            tileCountsPtr[channel * gridDim.x + tile] = tileCount;
+        }
+    }
+
+    // First element of each channel, and the total number of kept values as last element
+    __global__ void sparsifyOffsetsKernel(
+        int* offsetsPtr, const int* const tileOffsetsPtr, const int* const tileCountsPtr, const int numberChannels,
+        const int tilesPerChannel)
+    {
+        const auto channel = (int)((blockIdx.x * blockDim.x) + threadIdx.x);
+        if (channel < numberChannels)
+            offsetsPtr[channel] = tileOffsetsPtr[channel * tilesPerChannel];
+        else if (channel == numberChannels)
+        {
+            const auto lastTile = numberChannels * tilesPerChannel - 1;
+            offsetsPtr[channel] = tileOffsetsPtr[lastTile] + tileCountsPtr[lastTile];
+        }
+    }
+
+    // Same tiles than sparsifyCountKernel. Each kept value goes after the ones of the previous tiles, warps and lanes,
+    // so they are sorted
+    __global__ void sparsifyCompactKernel(
+        int* indicesPtr, float* valuesPtr, const int* const tileOffsetsPtr, const float* const sourcePtr,
+        const int channelArea, const float threshold)
+    {
+        __shared__ int warpCounts[SPARSIFY_WARPS];
+        const auto tile = blockIdx.x;
+        const auto channel = blockIdx.y;
+        const auto index = (int)(tile * SPARSIFY_THREADS + threadIdx.x);
+        const auto value = (index < channelArea ? sourcePtr[channel * channelArea + index] : 0.f);
+        const auto kept = (index < channelArea && fabsf(value) > threshold);
+        const auto ballot = __ballot_sync(0xffffffffu, kept);
+        const auto warp = threadIdx.x / 32u;
+        const auto lane = threadIdx.x % 32u;
+        if (lane == 0u)
+            warpCounts[warp] = __popc(ballot);
+        __syncthreads();
+        if (kept)
+        {
+            auto position = tileOffsetsPtr[channel * gridDim.x + tile] + __popc(ballot & ((1u << lane) - 1u));
+            for (auto previousWarp = 0u ; previousWarp < warp ; previousWarp++)
+                position += warpCounts[previousWarp];
+            indicesPtr[position] = index;
+            valuesPtr[position] = value;
+        }
+    }
+
+    __global__ void nv12ToBgrKernel(
+        unsigned char* targetPtr, const unsigned char* const nv12Ptr, const int width, const int height,
+        const int pitch, const bool bt709, const bool fullRange)
+    {
+        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
+        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
+        if (x < width && y < height)
+        {
+            // Chroma plane (interleaved U and V) after the luma one, at half the resolution in both dimensions
+            const auto* const uvPtr = nv12Ptr + height * pitch + (y/2) * pitch + (x/2) * 2;
+            float b, g, r;
+            yuvToBgrCuda(b, g, r, float(nv12Ptr[y * pitch + x]), float(uvPtr[0]), float(uvPtr[1]), bt709, fullRange);
+            auto* const bgrPtr = targetPtr + 3 * (y * width + x);
+            bgrPtr[0] = uCharRoundCuda(b);
+            bgrPtr[1] = uCharRoundCuda(g);
+            bgrPtr[2] = uCharRoundCuda(r);
+        }
+    }
+
+    __global__ void bayerToBgrKernel(
+        unsigned char* targetPtr, const unsigned char* const bayerPtr, const int width, const int height,
+        const int pitch, const int redX, const int redY)
+    {
+        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
+        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
+        if (x < width && y < height)
+        {
+            float b, g, r;
+            bayerToBgrCuda(b, g, r, bayerPtr, float(x), float(y), width, height, pitch, redX, redY);
+            auto* const bgrPtr = targetPtr + 3 * (y * width + x);
+            bgrPtr[0] = uCharRoundCuda(b);
+            bgrPtr[1] = uCharRoundCuda(g);
+            bgrPtr[2] = uCharRoundCuda(r);
+        }
+    }
+
+    __global__ void bgrFloatToRgbaSurfaceKernel(
+        const cudaSurfaceObject_t surfaceObject, const int targetWidth, const int targetHeight,
+        const float* const bgrPtr, const int sourceWidth, const int sourceHeight, const bool flipVertically)
+    {
+        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
+        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
+        if (x < targetWidth && y < targetHeight)
+        {
+            // Bilinear (pixel centers aligned), a plain copy if both sizes match
+            const auto xSource = (x + 0.5f) * sourceWidth / float(targetWidth) - 0.5f;
+            const auto ySource = ((flipVertically ? targetHeight - 1 - y : y) + 0.5f) * sourceHeight
+                               / float(targetHeight) - 0.5f;
+            const auto xLeft = fastTruncateCuda(int(floor(xSource)), 0, sourceWidth - 1);
+            const auto xRight = fastMinCuda(sourceWidth - 1, xLeft + 1);
+            const auto yTop = fastTruncateCuda(int(floor(ySource)), 0, sourceHeight - 1);
+            const auto yBottom = fastMinCuda(sourceHeight - 1, yTop + 1);
+            const auto dx = fastTruncateCuda(xSource - xLeft, 0.f, 1.f);
+            const auto dy = fastTruncateCuda(ySource - yTop, 0.f, 1.f);
+            const auto* const topLeftPtr = bgrPtr + 3 * (yTop * sourceWidth + xLeft);
+            const auto* const topRightPtr = bgrPtr + 3 * (yTop * sourceWidth + xRight);
+            const auto* const bottomLeftPtr = bgrPtr + 3 * (yBottom * sourceWidth + xLeft);
+            const auto* const bottomRightPtr = bgrPtr + 3 * (yBottom * sourceWidth + xRight);
+            unsigned char bgr[3];
+            for (auto c = 0 ; c < 3 ; c++)
+            {
+                const auto top = (1 - dx) * topLeftPtr[c] + dx * topRightPtr[c];
+                const auto bottom = (1 - dx) * bottomLeftPtr[c] + dx * bottomRightPtr[c];
+                bgr[c] = uCharRoundCuda(fastTruncateCuda((1 - dy) * top + dy * bottom, 0.f, 255.f));
+            }
+            // RGBA (opaque), x in bytes for surf2Dwrite
+            surf2Dwrite(make_uchar4(bgr[2], bgr[1], bgr[0], 255), surfaceObject, x * 4, y);
+        }
+    }
+
     template <typename T>
     void reorderAndNormalize(
         T* targetPtr, const unsigned char* const srcPtr, const int width, const int height, const int channels)
@@ -68,6 +246,172 @@ namespace op
         }
     }
 
+    template <typename T>
+    void halfCast(T* targetPtr, const __half* const srcPtr, const int volume, CUstream_st* const cudaStream)
+    {
+        try
+        {
+            const dim3 threadsPerBlock{CUDA_NUM_THREADS, 1, 1};
+            const dim3 numBlocks{
+                getNumberCudaBlocks(volume, threadsPerBlock.x)};
+            halfCastKernel<<<numBlocks, threadsPerBlock, 0, cudaStream>>>(targetPtr, srcPtr, volume);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void gatherScaledChannels(
+        T* targetPtr, const float* const sourcePtr, const std::vector<GpuChannelRange>& channelRanges,
+        CUstream_st* const cudaStream)
+    {
+        try
+        {
+            for (const auto& channelRange : channelRanges)
+            {
+                if (channelRange.volume > 0)
+                {
+                    const dim3 threadsPerBlock{CUDA_NUM_THREADS, 1, 1};
+                    const dim3 numBlocks{getNumberCudaBlocks((unsigned int)channelRange.volume, threadsPerBlock.x)};
+                    gatherScaledChannelsKernel<<<numBlocks, threadsPerBlock, 0, cudaStream>>>(
+                        targetPtr, sourcePtr + channelRange.sourceOffset, channelRange.volume, channelRange.minValue,
+                        channelRange.maxValue, channelRange.scale, channelRange.shift, channelRange.round);
+                    targetPtr += channelRange.volume;
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void sparsifyChannels(
+        std::vector<int>& offsets, std::vector<int>& indices, std::vector<float>& values,
+        const float* const sourcePtr, const int numberChannels, const int channelArea, const float threshold,
+        CUstream_st* const cudaStream)
+    {
+        try
+        {
+            if (numberChannels > 0 && channelArea > 0)
+            {
+                // 1. Kept values per tile, and their exclusive scan (first element of each tile)
+                const auto tilesPerChannel = (int)getNumberCudaBlocks(channelArea, SPARSIFY_THREADS);
+                const auto numberTiles = numberChannels * tilesPerChannel;
+                auto* tileCountsPtr = (int*)cudaPoolMalloc(
+                    sizeof(int) * (2 * numberTiles + numberChannels + 1), cudaStream);
+                auto* tileOffsetsPtr = tileCountsPtr + numberTiles;
+                auto* channelOffsetsPtr = tileOffsetsPtr + numberTiles;
+                const dim3 threadsPerBlock{SPARSIFY_THREADS, 1, 1};
+                const dim3 numBlocks{(unsigned int)tilesPerChannel, (unsigned int)numberChannels, 1};
+                sparsifyCountKernel<<<numBlocks, threadsPerBlock, 0, cudaStream>>>(
+                    tileCountsPtr, sourcePtr, channelArea, threshold);
+                const auto tileCountsThrustPtr = thrust::device_pointer_cast(tileCountsPtr);
+                thrust::exclusive_scan(
+                    thrust::cuda::par.on(cudaStream), tileCountsThrustPtr, tileCountsThrustPtr + numberTiles,
+                    thrust::device_pointer_cast(tileOffsetsPtr));
+                // 2. First element of each channel (only these numberChannels + 1 values are downloaded first)
+                sparsifyOffsetsKernel<<<getNumberCudaBlocks(numberChannels + 1), CUDA_NUM_THREADS, 0, cudaStream>>>(
+                    channelOffsetsPtr, tileOffsetsPtr, tileCountsPtr, numberChannels, tilesPerChannel);
+                std::vector<int> channelOffsets(numberChannels + 1);
+                cudaMemcpyAsync(channelOffsets.data(), channelOffsetsPtr, channelOffsets.size() * sizeof(int),
+                                cudaMemcpyDeviceToHost, cudaStream);
+                cudaStreamSynchronize(cudaStream);
+                AllocationTracker::recordCopy(channelOffsets.size() * sizeof(int), MemoryCopy::DeviceToHost);
+                const auto previousValues = (int)values.size();
+                for (auto channel = 0 ; channel < numberChannels ; channel++)
+                    offsets.emplace_back(previousValues + channelOffsets[channel]);
+                // 3. Compaction and download of the kept values
+                const auto numberValues = channelOffsets.back();
+                if (numberValues > 0)
+                {
+                    auto* indicesPtr = (int*)cudaPoolMalloc(sizeof(int) * numberValues, cudaStream);
+                    auto* valuesPtr = (float*)cudaPoolMalloc(sizeof(float) * numberValues, cudaStream);
+                    sparsifyCompactKernel<<<numBlocks, threadsPerBlock, 0, cudaStream>>>(
+                        indicesPtr, valuesPtr, tileOffsetsPtr, sourcePtr, channelArea, threshold);
+                    indices.resize(previousValues + numberValues);
+                    values.resize(previousValues + numberValues);
+                    cudaMemcpyAsync(&indices[previousValues], indicesPtr, sizeof(int) * numberValues,
+                                    cudaMemcpyDeviceToHost, cudaStream);
+                    cudaMemcpyAsync(&values[previousValues], valuesPtr, sizeof(float) * numberValues,
+                                    cudaMemcpyDeviceToHost, cudaStream);
+                    cudaStreamSynchronize(cudaStream);
+                    AllocationTracker::recordCopy(
+                        (sizeof(int) + sizeof(float)) * numberValues, MemoryCopy::DeviceToHost);
+                    cudaPoolFree(indicesPtr, cudaStream);
+                    cudaPoolFree(valuesPtr, cudaStream);
+                }
+                cudaPoolFree(tileCountsPtr, cudaStream);
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void nv12ToBgr(
+        unsigned char* targetPtr, const unsigned char* const nv12Ptr, const int width, const int height,
+        const int pitch, const bool bt709, const bool fullRange, CUstream_st* const cudaStream)
+    {
+        try
+        {
+            const dim3 threadsPerBlock{32, 8, 1};
+            const dim3 numBlocks{
+                getNumberCudaBlocks(width, threadsPerBlock.x), getNumberCudaBlocks(height, threadsPerBlock.y), 1};
+            nv12ToBgrKernel<<<numBlocks, threadsPerBlock, 0, cudaStream>>>(
+                targetPtr, nv12Ptr, width, height, pitch, bt709, fullRange);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void bayerToBgr(
+        unsigned char* targetPtr, const unsigned char* const bayerPtr, const int width, const int height,
+        const int pitch, const FrameGpuFormat bayerFormat, CUstream_st* const cudaStream)
+    {
+        try
+        {
+            int redX, redY;
+            getBayerRedPixel(redX, redY, bayerFormat);
+            const dim3 threadsPerBlock{32, 8, 1};
+            const dim3 numBlocks{
+                getNumberCudaBlocks(width, threadsPerBlock.x), getNumberCudaBlocks(height, threadsPerBlock.y), 1};
+            bayerToBgrKernel<<<numBlocks, threadsPerBlock, 0, cudaStream>>>(
+                targetPtr, bayerPtr, width, height, pitch, redX, redY);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void bgrFloatToRgbaSurface(
+        const unsigned long long surfaceObject, const int targetWidth, const int targetHeight,
+        const float* const bgrPtr, const int sourceWidth, const int sourceHeight, const bool flipVertically,
+        CUstream_st* const cudaStream)
+    {
+        try
+        {
+            const dim3 threadsPerBlock{32, 8, 1};
+            const dim3 numBlocks{
+                getNumberCudaBlocks(targetWidth, threadsPerBlock.x),
+                getNumberCudaBlocks(targetHeight, threadsPerBlock.y), 1};
+            bgrFloatToRgbaSurfaceKernel<<<numBlocks, threadsPerBlock, 0, cudaStream>>>(
+                (cudaSurfaceObject_t)surfaceObject, targetWidth, targetHeight, bgrPtr, sourceWidth, sourceHeight,
+                flipVertically);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template void reorderAndNormalize(
         float* targetPtr, const unsigned char* const srcPtr, const int width, const int height, const int channels);
     template void reorderAndNormalize(
@@ -77,4 +421,16 @@ namespace op
         unsigned char* targetPtr, const float* const srcPtr, const int volume);
     template void uCharImageCast(
         unsigned char* targetPtr, const double* const srcPtr, const int volume);
+
+    template void halfCast(
+        float* targetPtr, const __half* const srcPtr, const int volume, CUstream_st* const cudaStream);
+    template void halfCast(
+        double* targetPtr, const __half* const srcPtr, const int volume, CUstream_st* const cudaStream);
+
+    template void gatherScaledChannels(
+        float* targetPtr, const float* const sourcePtr, const std::vector<GpuChannelRange>& channelRanges,
+        CUstream_st* const cudaStream);
+    template void gatherScaledChannels(
+        unsigned char* targetPtr, const float* const sourcePtr, const std::vector<GpuChannelRange>& channelRanges,
+        CUstream_st* const cudaStream);
 }
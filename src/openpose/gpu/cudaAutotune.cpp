@@ -0,0 +1,370 @@
+#include <openpose/gpu/cudaAutotune.hpp>
+#include <cstdio> // std::remove, std::rename
+#include <cstdlib> // std::atoi
+#include <fstream>
+#include <map>
+#include <mutex>
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+#endif
+#include <openpose/gpu/cuda.hpp>
+#include <openpose/gpu/cudaMemoryPool.hpp>
+#include <openpose/utilities/string.hpp>
+
+namespace op
+{
+    // Cache file: "key<TAB>block shape (x y z)" per line, e.g.,
+    // "GeForce RTX 2080 (7.5) | resizeAndNmsRegisterKernel | 1x25x46x82<TAB>32 4 1"
+    const std::string CUDA_AUTOTUNE_CACHE_HEADER = "# OpenPose CUDA launch configuration cache";
+    // Timed launches of each candidate (after 1 warm-up launch)
+    const auto CUDA_AUTOTUNE_REPETITIONS = 5;
+
+    #ifdef USE_CUDA
+        struct CudaAutotuneDevice
+        {
+            std::string key; // GPU model, e.g., "GeForce RTX 2080 (7.5)"
+            int maxThreadsPerBlock;
+            int maxThreadsDim[3];
+        };
+
+        struct CudaAutotuneCache
+        {
+            std::mutex mMutex;
+            std::string mCacheFile;
+            // Key --> tuned block
+            std::map<std::string, dim3> mTunedBlocks;
+            // GPU ID --> device (cudaGetDeviceProperties is too slow to be called on every launch)
+            std::map<int, CudaAutotuneDevice> mDevices;
+        };
+
+        CudaAutotuneCache& getCudaAutotuneCache()
+        {
+            // Never destroyed, so kernels launched during the static de-initialization do not access a destroyed cache
+            static auto* cudaAutotuneCache = new CudaAutotuneCache{};
+            return *cudaAutotuneCache;
+        }
+
+        bool sameCudaBlock(const dim3& a, const dim3& b)
+        {
+            return a.x == b.x && a.y == b.y && a.z == b.z;
+        }
+
+        std::string cudaBlockToString(const dim3& block)
+        {
+            return std::to_string(block.x) + " " + std::to_string(block.y) + " " + std::to_string(block.z);
+        }
+
+        // It must be called with mMutex locked
+        void saveCudaAutotuneCache(const CudaAutotuneCache& cudaAutotuneCache)
+        {
+            // Written into a temporary file first, so an interrupted run does not leave a truncated cache
+            const auto& cacheFile = cudaAutotuneCache.mCacheFile;
+            const auto temporaryFile = cacheFile + ".tmp";
+            {
+                std::ofstream cacheStream{temporaryFile};
+                if (!cacheStream.is_open())
+                {
+                    opLog("The CUDA autotuning cache `" + cacheFile + "` could not be written.", Priority::High);
+                    return;
+                }
+                cacheStream << CUDA_AUTOTUNE_CACHE_HEADER << "\n";
+                for (const auto& keyAndBlock : cudaAutotuneCache.mTunedBlocks)
+                    cacheStream << keyAndBlock.first << "\t" << cudaBlockToString(keyAndBlock.second) << "\n";
+            }
+            // std::rename does not replace an existing file on Windows
+            std::remove(cacheFile.c_str());
+            if (std::rename(temporaryFile.c_str(), cacheFile.c_str()) != 0)
+                opLog("The CUDA autotuning cache `" + cacheFile + "` could not be written.", Priority::High);
+        }
+
+        // It must be called with mMutex locked
+        const CudaAutotuneDevice& getCudaAutotuneDevice(CudaAutotuneCache& cudaAutotuneCache, const int gpuId)
+        {
+            auto deviceIterator = cudaAutotuneCache.mDevices.find(gpuId);
+            if (deviceIterator == cudaAutotuneCache.mDevices.end())
+            {
+                CudaAutotuneDevice device{"Unknown GPU", 0, {0, 0, 0}};
+                cudaDeviceProp cudaDeviceProperties;
+                if (cudaGetDeviceProperties(&cudaDeviceProperties, gpuId) == cudaSuccess)
+                {
+                    device.key = std::string{cudaDeviceProperties.name} + " ("
+                        + std::to_string(cudaDeviceProperties.major) + "."
+                        + std::to_string(cudaDeviceProperties.minor) + ")";
+                    device.maxThreadsPerBlock = cudaDeviceProperties.maxThreadsPerBlock;
+                    for (auto i = 0 ; i < 3 ; i++)
+                        device.maxThreadsDim[i] = cudaDeviceProperties.maxThreadsDim[i];
+                }
+                else
+                    cudaGetLastError(); // Reset the error
+                // The tab separates the key from the block in the cache file
+                for (auto& character : device.key)
+                    if (character == '\t' || character == '\n' || character == '\r')
+                        character = ' ';
+                deviceIterator = cudaAutotuneCache.mDevices.emplace(gpuId, device).first;
+            }
+            return deviceIterator->second;
+        }
+
+        bool isValidCudaBlock(const dim3& block, const CudaAutotuneDevice& device)
+        {
+            return block.x > 0 && block.y > 0 && block.z > 0
+                && (int)block.x <= device.maxThreadsDim[0] && (int)block.y <= device.maxThreadsDim[1]
+                && (int)block.z <= device.maxThreadsDim[2]
+                && (long long)block.x * block.y * block.z <= device.maxThreadsPerBlock;
+        }
+
+        // Average time (in ms) of each launch, or a negative value if it cannot be launched
+        float benchmarkCudaBlock(
+            const dim3& block, const std::function<void(const dim3&)>& benchmarkLaunch,
+            const cudaStream_t cudaStream, const cudaEvent_t startEvent, const cudaEvent_t stopEvent)
+        {
+            // Warm-up launch, which also checks that it can be launched (e.g., not too many registers per block)
+            benchmarkLaunch(block);
+            if (cudaGetLastError() != cudaSuccess || cudaStreamSynchronize(cudaStream) != cudaSuccess)
+            {
+                cudaGetLastError(); // Reset the error
+                return -1.f;
+            }
+            // Timed launches
+            cudaEventRecord(startEvent, cudaStream);
+            for (auto repetition = 0 ; repetition < CUDA_AUTOTUNE_REPETITIONS ; repetition++)
+                benchmarkLaunch(block);
+            cudaEventRecord(stopEvent, cudaStream);
+            auto milliseconds = -1.f;
+            if (cudaEventSynchronize(stopEvent) != cudaSuccess
+                || cudaEventElapsedTime(&milliseconds, startEvent, stopEvent) != cudaSuccess)
+            {
+                cudaGetLastError(); // Reset the error
+                return -1.f;
+            }
+            return milliseconds / CUDA_AUTOTUNE_REPETITIONS;
+        }
+
+        // Candidates of getAutotunedCudaThreadsAndBlocks() (at least 256 threads)
+        const std::vector<dim3> CUDA_AUTOTUNE_RENDER_BLOCKS{
+            dim3{16, 16, 1}, dim3{32, 8, 1}, dim3{64, 4, 1}, dim3{128, 2, 1}, dim3{256, 1, 1}, dim3{32, 16, 1},
+            dim3{64, 8, 1}, dim3{128, 4, 1}, dim3{32, 32, 1}};
+    #endif
+
+    void setCudaAutotuneCacheFile(const std::string& cacheFile)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                auto& cudaAutotuneCache = getCudaAutotuneCache();
+                const std::lock_guard<std::mutex> lock{cudaAutotuneCache.mMutex};
+                if (cudaAutotuneCache.mCacheFile == cacheFile)
+                    return;
+                cudaAutotuneCache.mCacheFile = cacheFile;
+                cudaAutotuneCache.mTunedBlocks.clear();
+                // Load the cache file (it might not exist yet)
+                if (!cacheFile.empty())
+                {
+                    std::ifstream cacheStream{cacheFile};
+                    std::string line;
+                    while (std::getline(cacheStream, line))
+                    {
+                        const auto tabPosition = line.rfind('\t');
+                        if (line.empty() || line[0] == '#' || tabPosition == std::string::npos)
+                            continue;
+                        const auto blockStrings = splitString(line.substr(tabPosition+1), " ");
+                        if (blockStrings.size() != 3)
+                            continue;
+                        const auto x = std::atoi(blockStrings[0].c_str());
+                        const auto y = std::atoi(blockStrings[1].c_str());
+                        const auto z = std::atoi(blockStrings[2].c_str());
+                        // Corrupted line
+                        if (x <= 0 || y <= 0 || z <= 0)
+                            continue;
+                        cudaAutotuneCache.mTunedBlocks[line.substr(0, tabPosition)] = dim3{
+                            (unsigned int)x, (unsigned int)y, (unsigned int)z};
+                    }
+                }
+            #else
+                if (!cacheFile.empty())
+                    error("OpenPose must be compiled with the `USE_CUDA` macro definition in order to use this"
+                          " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool isCudaAutotuneEnabled()
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                auto& cudaAutotuneCache = getCudaAutotuneCache();
+                const std::lock_guard<std::mutex> lock{cudaAutotuneCache.mMutex};
+                return !cudaAutotuneCache.mCacheFile.empty();
+            #else
+                return false;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void getCudaAutotunedBlock(
+        dim3& block, const std::string& kernelName, const std::string& shapeKey,
+        const std::vector<dim3>& candidateBlocks, const std::function<void(const dim3&)>& benchmarkLaunch,
+        CUstream_st* const cudaStream)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                auto& cudaAutotuneCache = getCudaAutotuneCache();
+                int gpuId = 0;
+                cudaGetDevice(&gpuId);
+                std::string key;
+                CudaAutotuneDevice device;
+                // Already tuned
+                {
+                    const std::lock_guard<std::mutex> lock{cudaAutotuneCache.mMutex};
+                    if (cudaAutotuneCache.mCacheFile.empty())
+                        return;
+                    device = getCudaAutotuneDevice(cudaAutotuneCache, gpuId);
+                    key = device.key + " | " + kernelName + " | " + shapeKey;
+                    const auto blockIterator = cudaAutotuneCache.mTunedBlocks.find(key);
+                    if (blockIterator != cudaAutotuneCache.mTunedBlocks.end())
+                    {
+                        // E.g., a cache file copied from another machine with different limits
+                        if (isValidCudaBlock(blockIterator->second, device))
+                            block = blockIterator->second;
+                        return;
+                    }
+                }
+                // Nothing can be synchronized while the stream is being captured into a CUDA Graph
+                #if CUDART_VERSION >= 10000
+                    auto captureStatus = cudaStreamCaptureStatusNone;
+                    if (cudaStreamIsCapturing(cudaStream, &captureStatus) != cudaSuccess)
+                    {
+                        cudaGetLastError(); // Reset the error
+                        return;
+                    }
+                    if (captureStatus != cudaStreamCaptureStatusNone)
+                        return;
+                #endif
+                // Benchmark the default block and the candidates (the default one first, it wins the ties)
+                std::vector<dim3> blocks{block};
+                for (const auto& candidateBlock : candidateBlocks)
+                {
+                    auto isNew = true;
+                    for (const auto& existingBlock : blocks)
+                        isNew &= !sameCudaBlock(candidateBlock, existingBlock);
+                    if (isNew)
+                        blocks.emplace_back(candidateBlock);
+                }
+                cudaEvent_t startEvent;
+                cudaEvent_t stopEvent;
+                cudaEventCreate(&startEvent);
+                cudaEventCreate(&stopEvent);
+                auto bestBlock = block;
+                auto bestMilliseconds = -1.f;
+                auto defaultMilliseconds = -1.f;
+                for (auto i = 0u ; i < blocks.size() ; i++)
+                {
+                    if (!isValidCudaBlock(blocks[i], device))
+                        continue;
+                    const auto milliseconds = benchmarkCudaBlock(
+                        blocks[i], benchmarkLaunch, cudaStream, startEvent, stopEvent);
+                    if (i == 0u)
+                        defaultMilliseconds = milliseconds;
+                    if (milliseconds >= 0.f && (bestMilliseconds < 0.f || milliseconds < bestMilliseconds))
+                    {
+                        bestBlock = blocks[i];
+                        bestMilliseconds = milliseconds;
+                    }
+                }
+                cudaEventDestroy(startEvent);
+                cudaEventDestroy(stopEvent);
+                // None of them could be launched: The default one is kept (and its error is reported by the caller)
+                if (bestMilliseconds < 0.f)
+                    return;
+                block = bestBlock;
+                const std::lock_guard<std::mutex> lock{cudaAutotuneCache.mMutex};
+                // setCudaAutotuneCacheFile() might have disabled it meanwhile
+                if (!cudaAutotuneCache.mCacheFile.empty())
+                {
+                    cudaAutotuneCache.mTunedBlocks[key] = bestBlock;
+                    opLog("CUDA autotuning: `" + key + "` tuned to a block of " + cudaBlockToString(bestBlock)
+                          + " threads (" + std::to_string(bestMilliseconds) + " ms vs. "
+                          + (defaultMilliseconds < 0.f ? "invalid" : std::to_string(defaultMilliseconds))
+                          + " ms of the default one).", Priority::High);
+                    saveCudaAutotuneCache(cudaAutotuneCache);
+                }
+            #else
+                UNUSED(block);
+                UNUSED(kernelName);
+                UNUSED(shapeKey);
+                UNUSED(candidateBlocks);
+                UNUSED(benchmarkLaunch);
+                UNUSED(cudaStream);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void getAutotunedCudaThreadsAndBlocks(
+        dim3& numberCudaThreads, dim3& numberCudaBlocks, const Point<unsigned int>& frameSize,
+        const std::string& kernelName, const float* const framePtr, const unsigned long long frameBytes,
+        const std::function<void(const dim3&, const dim3&, float*)>& benchmarkLaunch)
+    {
+        try
+        {
+            getNumberCudaThreadsAndBlocks(numberCudaThreads, numberCudaBlocks, frameSize);
+            #ifdef USE_CUDA
+                if (isCudaAutotuneEnabled())
+                {
+                    // Grid of each block shape
+                    const auto getGrid = [&frameSize](const dim3& block)
+                    {
+                        return dim3{getNumberCudaBlocks(frameSize.x, block.x),
+                                    getNumberCudaBlocks(frameSize.y, block.y), 1};
+                    };
+                    // Scratch copy of the frame, allocated on the first benchmark launch (i.e., not if already tuned)
+                    float* benchmarkFramePtr = nullptr;
+                    auto block = numberCudaBlocks;
+                    getCudaAutotunedBlock(
+                        block, kernelName, std::to_string(frameSize.x) + "x" + std::to_string(frameSize.y),
+                        CUDA_AUTOTUNE_RENDER_BLOCKS,
+                        [&](const dim3& candidateBlock)
+                        {
+                            if (benchmarkFramePtr == nullptr)
+                            {
+                                benchmarkFramePtr = (float*)cudaPoolMalloc(frameBytes);
+                                cudaMemcpy(benchmarkFramePtr, framePtr, frameBytes, cudaMemcpyDeviceToDevice);
+                                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                            }
+                            benchmarkLaunch(getGrid(candidateBlock), candidateBlock, benchmarkFramePtr);
+                        });
+                    if (benchmarkFramePtr != nullptr)
+                        cudaPoolFree(benchmarkFramePtr);
+                    if (!sameCudaBlock(block, numberCudaBlocks))
+                    {
+                        numberCudaThreads = getGrid(block);
+                        numberCudaBlocks = block;
+                    }
+                }
+            #else
+                UNUSED(kernelName);
+                UNUSED(framePtr);
+                UNUSED(frameBytes);
+                UNUSED(benchmarkLaunch);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -0,0 +1,220 @@
+#include <openpose/gpu/cudaGraph.hpp>
+#include <algorithm>
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+    // CUDA Graphs (with stream capture and the capture modes) are used from CUDA 11
+    #if CUDART_VERSION >= 11000
+        #define OPENPOSE_CUDA_GRAPHS
+    #endif
+#endif
+
+namespace op
+{
+    #ifdef OPENPOSE_CUDA_GRAPHS
+        enum class CudaGraphState : unsigned char
+        {
+            Seen,       // Run once directly, it will be captured the next time
+            Captured,   // Replayed from its graph
+            Failed,     // The capture failed, it is always run directly
+        };
+
+        struct CudaGraphEntry
+        {
+            std::vector<unsigned long long> key;
+            CudaGraphState state;
+            cudaGraphExec_t graphExec;
+            unsigned long long lastUse;
+        };
+
+        void destroyCudaGraphEntry(CudaGraphEntry& cudaGraphEntry)
+        {
+            if (cudaGraphEntry.graphExec != nullptr)
+            {
+                cudaGraphExecDestroy(cudaGraphEntry.graphExec);
+                cudaGraphEntry.graphExec = nullptr;
+            }
+        }
+
+        // It returns nullptr if the capture failed (the kernels were not run then)
+        cudaGraphExec_t captureCudaGraph(const cudaStream_t cudaStream, const std::function<void()>& kernelLaunches)
+        {
+            // Thread local: Unsafe calls (e.g., a synchronization) of other threads do not invalidate the capture
+            if (cudaStreamBeginCapture(cudaStream, cudaStreamCaptureModeThreadLocal) != cudaSuccess)
+            {
+                cudaGetLastError();
+                return nullptr;
+            }
+            auto launched = true;
+            try
+            {
+                kernelLaunches();
+            }
+            catch (const std::exception&)
+            {
+                // E.g., a cudaCheck() after an operation not allowed during the capture
+                launched = false;
+            }
+            cudaGraph_t cudaGraph = nullptr;
+            const auto endStatus = cudaStreamEndCapture(cudaStream, &cudaGraph);
+            cudaGraphExec_t graphExec = nullptr;
+            if (launched && endStatus == cudaSuccess && cudaGraph != nullptr)
+            {
+                #if CUDART_VERSION >= 12000
+                    const auto instantiateStatus = cudaGraphInstantiate(&graphExec, cudaGraph, 0);
+                #else
+                    const auto instantiateStatus = cudaGraphInstantiate(&graphExec, cudaGraph, nullptr, nullptr, 0);
+                #endif
+                if (instantiateStatus != cudaSuccess)
+                    graphExec = nullptr;
+            }
+            if (cudaGraph != nullptr)
+                cudaGraphDestroy(cudaGraph);
+            // Reset the (non-sticky) error of a failed capture
+            if (graphExec == nullptr)
+                cudaGetLastError();
+            return graphExec;
+        }
+    #endif
+
+    struct CudaGraphCache::ImplCudaGraphCache
+    {
+        const unsigned int mMaxGraphs;
+        #ifdef OPENPOSE_CUDA_GRAPHS
+            std::vector<CudaGraphEntry> mEntries;
+            unsigned long long mCounter;
+            bool mFailureLogged;
+        #endif
+
+        ImplCudaGraphCache(const unsigned int maxGraphs) :
+            mMaxGraphs{std::max(1u, maxGraphs)}
+            #ifdef OPENPOSE_CUDA_GRAPHS
+                , mCounter{0ull},
+                mFailureLogged{false}
+            #endif
+        {
+        }
+    };
+
+    CudaGraphCache::CudaGraphCache(const unsigned int maxGraphs) :
+        upImpl{new ImplCudaGraphCache{maxGraphs}}
+    {
+    }
+
+    CudaGraphCache::~CudaGraphCache()
+    {
+        try
+        {
+            clear();
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void CudaGraphCache::run(
+        const std::vector<unsigned long long>& key, CUstream_st* const cudaStream,
+        const std::function<void()>& kernelLaunches)
+    {
+        try
+        {
+            #ifdef OPENPOSE_CUDA_GRAPHS
+                // Capturing the legacy default stream is not allowed
+                if (cudaStream == nullptr)
+                {
+                    kernelLaunches();
+                    return;
+                }
+                upImpl->mCounter++;
+                auto& entries = upImpl->mEntries;
+                auto entry = std::find_if(
+                    entries.begin(), entries.end(),
+                    [&key](const CudaGraphEntry& cudaGraphEntry) { return cudaGraphEntry.key == key; });
+                // New key: Run directly (replacing the least recently used entry if the cache is full)
+                if (entry == entries.end())
+                {
+                    if (entries.size() >= upImpl->mMaxGraphs)
+                    {
+                        const auto leastRecentlyUsed = std::min_element(
+                            entries.begin(), entries.end(),
+                            [](const CudaGraphEntry& a, const CudaGraphEntry& b) { return a.lastUse < b.lastUse; });
+                        destroyCudaGraphEntry(*leastRecentlyUsed);
+                        entries.erase(leastRecentlyUsed);
+                    }
+                    entries.emplace_back(CudaGraphEntry{key, CudaGraphState::Seen, nullptr, upImpl->mCounter});
+                    kernelLaunches();
+                    return;
+                }
+                entry->lastUse = upImpl->mCounter;
+                // Second time: Capture it
+                if (entry->state == CudaGraphState::Seen)
+                {
+                    entry->graphExec = captureCudaGraph(cudaStream, kernelLaunches);
+                    if (entry->graphExec == nullptr)
+                    {
+                        entry->state = CudaGraphState::Failed;
+                        if (!upImpl->mFailureLogged)
+                        {
+                            upImpl->mFailureLogged = true;
+                            opLog("The CUDA Graph capture failed, those kernels are launched directly instead.",
+                                  Priority::High);
+                        }
+                    }
+                    else
+                        entry->state = CudaGraphState::Captured;
+                }
+                // Replay
+                if (entry->state == CudaGraphState::Captured)
+                {
+                    if (cudaGraphLaunch(entry->graphExec, cudaStream) != cudaSuccess)
+                        error("The CUDA Graph could not be launched.", __LINE__, __FUNCTION__, __FILE__);
+                }
+                else
+                    kernelLaunches();
+            #else
+                UNUSED(key);
+                UNUSED(cudaStream);
+                kernelLaunches();
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void CudaGraphCache::clear()
+    {
+        try
+        {
+            #ifdef OPENPOSE_CUDA_GRAPHS
+                for (auto& entry : upImpl->mEntries)
+                    destroyCudaGraphEntry(entry);
+                upImpl->mEntries.clear();
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned int CudaGraphCache::size() const
+    {
+        try
+        {
+            #ifdef OPENPOSE_CUDA_GRAPHS
+                return (unsigned int)std::count_if(
+                    upImpl->mEntries.begin(), upImpl->mEntries.end(),
+                    [](const CudaGraphEntry& entry) { return entry.state == CudaGraphState::Captured; });
+            #else
+                return 0u;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0u;
+        }
+    }
+}
@@ -0,0 +1,360 @@
+#include <openpose/gpu/cudaMemoryPool.hpp>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+#endif
+#include <openpose/utilities/allocationTracker.hpp>
+#include <openpose/utilities/fastMath.hpp>
+
+namespace op
+{
+    #ifdef USE_CUDA
+        struct CudaMemoryBlock
+        {
+            void* gpuPtr;
+            unsigned long long bytes;
+            unsigned long long requestedBytes;
+            int gpuId;
+            cudaStream_t cudaStream; // Last stream where the block was used
+            cudaEvent_t freeEvent; // Recorded on cudaStream when the block was freed
+            const char* owner; // CudaMemoryOwner when it was allocated
+        };
+
+        struct CudaMemoryPool
+        {
+            std::mutex mMutex;
+            // GPU ID --> bucket bytes --> free blocks
+            std::map<int, std::map<unsigned long long, std::vector<CudaMemoryBlock>>> mFreeBlocks;
+            std::unordered_map<void*, CudaMemoryBlock> mUsedBlocks;
+            std::map<int, CudaMemoryPoolStats> mStats;
+            // GPU ID --> owner --> stats
+            std::map<int, std::map<std::string, CudaMemoryOwnerStats>> mOwnerStats;
+        };
+
+        CudaMemoryPool& getCudaMemoryPool()
+        {
+            // Never destroyed, so memory released during the static de-initialization does not access a destroyed pool
+            static auto* cudaMemoryPool = new CudaMemoryPool{};
+            return *cudaMemoryPool;
+        }
+
+        unsigned long long getCudaMemoryBucketBytes(const unsigned long long bytes)
+        {
+            // 8 buckets per power of 2 (i.e., at most 25% of extra memory), with a minimum of 512 bytes
+            auto powerOf2 = 512ull;
+            while (powerOf2 < bytes)
+                powerOf2 <<= 1;
+            const auto step = (powerOf2 > 4096ull ? powerOf2 / 8 : 512ull);
+            return ((bytes + step - 1) / step) * step;
+        }
+
+        void freeCudaMemoryBlock(CudaMemoryBlock& block)
+        {
+            if (block.freeEvent != nullptr)
+            {
+                cudaEventSynchronize(block.freeEvent);
+                cudaEventDestroy(block.freeEvent);
+            }
+            cudaFree(block.gpuPtr);
+        }
+
+        // It must be called with the pool mutex locked. Returns nullptr if no cached block can be used
+        void* reuseCudaMemoryBlock(
+            CudaMemoryPool& pool, const int gpuId, const unsigned long long bucketBytes,
+            const unsigned long long requestedBytes, const cudaStream_t cudaStream)
+        {
+            auto& freeBlocks = pool.mFreeBlocks[gpuId][bucketBytes];
+            auto selected = freeBlocks.end();
+            // 1st option: Block freed on the same stream (no synchronization required)
+            for (auto iterator = freeBlocks.begin() ; iterator != freeBlocks.end() ; iterator++)
+            {
+                if (iterator->cudaStream == cudaStream)
+                {
+                    selected = iterator;
+                    break;
+                }
+            }
+            // 2nd option: Block whose previous work (on another stream) has already finished
+            if (selected == freeBlocks.end())
+            {
+                for (auto iterator = freeBlocks.begin() ; iterator != freeBlocks.end() ; iterator++)
+                {
+                    if (iterator->freeEvent == nullptr || cudaEventQuery(iterator->freeEvent) == cudaSuccess)
+                    {
+                        selected = iterator;
+                        break;
+                    }
+                }
+                // cudaEventQuery sets cudaErrorNotReady for the events still pending
+                cudaGetLastError();
+            }
+            if (selected == freeBlocks.end())
+                return nullptr;
+            // Move to used blocks
+            auto block = *selected;
+            freeBlocks.erase(selected);
+            block.requestedBytes = requestedBytes;
+            block.cudaStream = cudaStream;
+            pool.mUsedBlocks[block.gpuPtr] = block;
+            auto& stats = pool.mStats[gpuId];
+            stats.cachedBytes -= bucketBytes;
+            stats.cacheHits++;
+            return block.gpuPtr;
+        }
+
+        // It must be called with the pool mutex locked
+        void releaseCudaMemoryCache(CudaMemoryPool& pool, const int gpuId)
+        {
+            auto& buckets = pool.mFreeBlocks[gpuId];
+            for (auto& bucket : buckets)
+                for (auto& block : bucket.second)
+                    freeCudaMemoryBlock(block);
+            buckets.clear();
+            pool.mStats[gpuId].cachedBytes = 0ull;
+        }
+
+        void updateFragmentedBytes(CudaMemoryPoolStats& stats)
+        {
+            stats.fragmentedBytes = stats.usedBytes - stats.requestedBytes + stats.cachedBytes;
+        }
+
+        // It must be called with the pool mutex locked
+        void addOwnerBytes(CudaMemoryPool& pool, const int gpuId, const char* const owner, const long long bytes)
+        {
+            auto& ownerStats = pool.mOwnerStats[gpuId][owner == nullptr ? "Other" : owner];
+            // Released memory never makes it negative (e.g., if it was allocated before a resetCudaMemoryPeaks())
+            ownerStats.usedBytes = (bytes < 0 && ownerStats.usedBytes < (unsigned long long)(-bytes)
+                ? 0ull : ownerStats.usedBytes + bytes);
+            ownerStats.peakUsedBytes = fastMax(ownerStats.peakUsedBytes, ownerStats.usedBytes);
+        }
+    #endif
+
+    // Innermost CudaMemoryOwner of each thread
+    thread_local const char* tCudaMemoryOwner = nullptr;
+
+    CudaMemoryOwner::CudaMemoryOwner(const char* const owner) :
+        pPreviousOwner{tCudaMemoryOwner}
+    {
+        tCudaMemoryOwner = owner;
+    }
+
+    CudaMemoryOwner::~CudaMemoryOwner()
+    {
+        tCudaMemoryOwner = pPreviousOwner;
+    }
+
+    const char* CudaMemoryOwner::getCurrentOwner()
+    {
+        return tCudaMemoryOwner;
+    }
+
+    void* cudaPoolMalloc(const unsigned long long bytes, CUstream_st* const cudaStream)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                if (bytes == 0ull)
+                    return nullptr;
+                int gpuId;
+                cudaGetDevice(&gpuId);
+                const auto bucketBytes = getCudaMemoryBucketBytes(bytes);
+                auto& pool = getCudaMemoryPool();
+                const std::lock_guard<std::mutex> lock{pool.mMutex};
+                auto& stats = pool.mStats[gpuId];
+                // Re-use cached block
+                void* gpuPtr = reuseCudaMemoryBlock(pool, gpuId, bucketBytes, bytes, cudaStream);
+                // Or allocate a new one
+                if (gpuPtr == nullptr)
+                {
+                    // Out of memory: Free the cached blocks of this GPU and try again
+                    if (cudaMalloc(&gpuPtr, bucketBytes) != cudaSuccess)
+                    {
+                        cudaGetLastError();
+                        releaseCudaMemoryCache(pool, gpuId);
+                        if (cudaMalloc(&gpuPtr, bucketBytes) != cudaSuccess)
+                            error("Out of GPU memory while allocating " + std::to_string(bucketBytes) + " bytes on GPU "
+                                  + std::to_string(gpuId) + ".", __LINE__, __FUNCTION__, __FILE__);
+                    }
+                    pool.mUsedBlocks[gpuPtr] = CudaMemoryBlock{
+                        gpuPtr, bucketBytes, bytes, gpuId, cudaStream, nullptr, nullptr};
+                    stats.cudaMallocs++;
+                }
+                // Update stats
+                stats.usedBytes += bucketBytes;
+                stats.requestedBytes += bytes;
+                stats.peakUsedBytes = fastMax(stats.peakUsedBytes, stats.usedBytes);
+                updateFragmentedBytes(stats);
+                pool.mUsedBlocks[gpuPtr].owner = tCudaMemoryOwner;
+                addOwnerBytes(pool, gpuId, tCudaMemoryOwner, (long long)bucketBytes);
+                // Requested bytes (even if the block was cached), i.e., the memory the current Worker asked for
+                AllocationTracker::recordGpuAllocation(bytes);
+                return gpuPtr;
+            #else
+                UNUSED(bytes);
+                UNUSED(cudaStream);
+                error("OpenPose must be compiled with the `USE_CUDA` macro definition in order to use this"
+                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    void cudaPoolFree(void* const gpuPtr, CUstream_st* const cudaStream)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                if (gpuPtr == nullptr)
+                    return;
+                auto& pool = getCudaMemoryPool();
+                const std::lock_guard<std::mutex> lock{pool.mMutex};
+                auto usedBlock = pool.mUsedBlocks.find(gpuPtr);
+                if (usedBlock == pool.mUsedBlocks.end())
+                    error("The pointer was not allocated with cudaPoolMalloc.", __LINE__, __FUNCTION__, __FILE__);
+                auto block = usedBlock->second;
+                pool.mUsedBlocks.erase(usedBlock);
+                // Mark the point after which the block is no longer used
+                block.cudaStream = cudaStream;
+                if (block.freeEvent == nullptr)
+                    cudaEventCreateWithFlags(&block.freeEvent, cudaEventDisableTiming);
+                cudaEventRecord(block.freeEvent, cudaStream);
+                // Cache it
+                auto& stats = pool.mStats[block.gpuId];
+                stats.usedBytes -= block.bytes;
+                stats.requestedBytes -= block.requestedBytes;
+                stats.cachedBytes += block.bytes;
+                updateFragmentedBytes(stats);
+                addOwnerBytes(pool, block.gpuId, block.owner, -(long long)block.bytes);
+                pool.mFreeBlocks[block.gpuId][block.bytes].emplace_back(block);
+            #else
+                UNUSED(gpuPtr);
+                UNUSED(cudaStream);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void cudaPoolReleaseCache()
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                auto& pool = getCudaMemoryPool();
+                const std::lock_guard<std::mutex> lock{pool.mMutex};
+                int currentGpuId;
+                cudaGetDevice(&currentGpuId);
+                for (auto& gpuBuckets : pool.mFreeBlocks)
+                {
+                    cudaSetDevice(gpuBuckets.first);
+                    releaseCudaMemoryCache(pool, gpuBuckets.first);
+                }
+                cudaSetDevice(currentGpuId);
+                for (auto& stats : pool.mStats)
+                    updateFragmentedBytes(stats.second);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    CudaMemoryPoolStats getCudaMemoryPoolStats(const int gpuId)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                auto finalGpuId = gpuId;
+                if (finalGpuId < 0)
+                    cudaGetDevice(&finalGpuId);
+                auto& pool = getCudaMemoryPool();
+                const std::lock_guard<std::mutex> lock{pool.mMutex};
+                return pool.mStats[finalGpuId];
+            #else
+                UNUSED(gpuId);
+                return CudaMemoryPoolStats{};
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return CudaMemoryPoolStats{};
+        }
+    }
+
+    void addCudaMemoryOwnerBytes(const char* const owner, const int gpuId, const long long bytes)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                if (bytes == 0)
+                    return;
+                auto& pool = getCudaMemoryPool();
+                const std::lock_guard<std::mutex> lock{pool.mMutex};
+                addOwnerBytes(pool, gpuId, owner, bytes);
+            #else
+                UNUSED(owner);
+                UNUSED(gpuId);
+                UNUSED(bytes);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::map<std::string, CudaMemoryOwnerStats> getCudaMemoryOwnerStats(const int gpuId)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                auto finalGpuId = gpuId;
+                if (finalGpuId < 0)
+                    cudaGetDevice(&finalGpuId);
+                auto& pool = getCudaMemoryPool();
+                const std::lock_guard<std::mutex> lock{pool.mMutex};
+                return pool.mOwnerStats[finalGpuId];
+            #else
+                UNUSED(gpuId);
+                return {};
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void resetCudaMemoryPeaks()
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                auto& pool = getCudaMemoryPool();
+                const std::lock_guard<std::mutex> lock{pool.mMutex};
+                for (auto& stats : pool.mStats)
+                    stats.second.peakUsedBytes = stats.second.usedBytes;
+                for (auto& gpuOwners : pool.mOwnerStats)
+                    for (auto& ownerStats : gpuOwners.second)
+                        ownerStats.second.peakUsedBytes = ownerStats.second.usedBytes;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
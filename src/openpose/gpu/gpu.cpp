@@ -1,5 +1,8 @@
 #include <openpose/gpu/gpu.hpp>
+#include <algorithm> // std::transform
+#include <fstream>
 #ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
     #include <openpose/gpu/cuda.hpp>
 #endif
 #ifdef USE_OPENCL
@@ -47,4 +50,101 @@ namespace op
             return GpuMode::NoGpu;
         }
     }
+
+    int getGpuNumaNode(const int gpuId)
+    {
+        try
+        {
+            #if defined USE_CUDA && defined __linux__
+                // PCI bus id, e.g., `0000:3B:00.0`, while sysfs uses `0000:3b:00.0`
+                char pciBusId[32];
+                if (cudaDeviceGetPCIBusId(pciBusId, (int)sizeof(pciBusId), gpuId) != cudaSuccess)
+                {
+                    cudaGetLastError(); // Reset the error
+                    return -1;
+                }
+                std::string pciBusIdString{pciBusId};
+                std::transform(pciBusIdString.begin(), pciBusIdString.end(), pciBusIdString.begin(), ::tolower);
+                // 8-digit PCI domains (e.g., `00000000:3b:00.0`) are listed with 4 digits
+                const auto domainEnd = pciBusIdString.find(':');
+                if (domainEnd > 4 && domainEnd != std::string::npos)
+                    pciBusIdString = pciBusIdString.substr(domainEnd - 4);
+                std::ifstream numaNodeFile{"/sys/bus/pci/devices/" + pciBusIdString + "/numa_node"};
+                auto numaNode = -1;
+                if (!(numaNodeFile >> numaNode))
+                    return -1;
+                // Sysfs returns -1 if the platform does not report NUMA information
+                return numaNode;
+            #else
+                UNUSED(gpuId);
+                return -1;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1;
+        }
+    }
+
+    std::string getGpuName(const int gpuId)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                cudaDeviceProp cudaDeviceProperties;
+                if (cudaGetDeviceProperties(&cudaDeviceProperties, gpuId) != cudaSuccess)
+                {
+                    cudaGetLastError(); // Reset the error
+                    return "";
+                }
+                return std::string{cudaDeviceProperties.name};
+            #else
+                UNUSED(gpuId);
+                return "";
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    bool getGpuMemory(unsigned long long& freeBytes, unsigned long long& totalBytes, const int gpuId)
+    {
+        try
+        {
+            freeBytes = 0ull;
+            totalBytes = 0ull;
+            #ifdef USE_CUDA
+                int currentGpuId;
+                if (cudaGetDevice(&currentGpuId) != cudaSuccess || cudaSetDevice(gpuId) != cudaSuccess)
+                {
+                    cudaGetLastError(); // Reset the error
+                    return false;
+                }
+                size_t freeMemory;
+                size_t totalMemory;
+                const auto success = (cudaMemGetInfo(&freeMemory, &totalMemory) == cudaSuccess);
+                if (success)
+                {
+                    freeBytes = freeMemory;
+                    totalBytes = totalMemory;
+                }
+                else
+                    cudaGetLastError(); // Reset the error
+                cudaSetDevice(currentGpuId);
+                return success;
+            #else
+                UNUSED(gpuId);
+                return false;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
 }
@@ -0,0 +1,114 @@
+#include <openpose/gpu/gpuMemoryBudget.hpp>
+#include <algorithm> // std::min
+#include <fstream>
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+#endif
+
+namespace op
+{
+    // Typical size of the CUDA context (runtime, cuBLAS and cuDNN kernels), which is allocated before any buffer
+    const auto CUDA_CONTEXT_BYTES = 350ull << 20;
+
+    std::string bytesToMegabytes(const unsigned long long bytes)
+    {
+        return std::to_string((bytes + (1ull << 19)) >> 20) + " MB";
+    }
+
+    GpuMemoryFootprint getCudaContextFootprint()
+    {
+        return GpuMemoryFootprint{"CUDA context", CUDA_CONTEXT_BYTES, 0ull};
+    }
+
+    unsigned long long getGpuFreeMemory(const int gpuId)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                int previousGpuId;
+                cudaGetDevice(&previousGpuId);
+                cudaSetDevice(gpuId);
+                size_t freeBytes = 0;
+                size_t totalBytes = 0;
+                const auto cudaStatus = cudaMemGetInfo(&freeBytes, &totalBytes);
+                cudaSetDevice(previousGpuId);
+                if (cudaStatus != cudaSuccess)
+                {
+                    cudaGetLastError(); // Reset the error
+                    return 0ull;
+                }
+                return (unsigned long long)freeBytes;
+            #else
+                UNUSED(gpuId);
+                return 0ull;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    unsigned long long getModelFileBytes(const std::string& modelPath, const unsigned long long defaultBytes)
+    {
+        try
+        {
+            std::ifstream modelFile{modelPath, std::ios::binary | std::ios::ate};
+            if (!modelFile.is_open())
+                return defaultBytes;
+            const auto bytes = (long long)modelFile.tellg();
+            return (bytes > 0 ? (unsigned long long)bytes : defaultBytes);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return defaultBytes;
+        }
+    }
+
+    GpuMemoryPlan fitGpuMemoryBudget(
+        const unsigned long long budgetBytes, const std::vector<GpuMemoryFootprint>& footprints,
+        const int batchSize)
+    {
+        try
+        {
+            // Totals
+            auto fixedBytes = 0ull;
+            auto perFrameBytes = 0ull;
+            for (const auto& footprint : footprints)
+            {
+                fixedBytes += footprint.fixedBytes;
+                perFrameBytes += footprint.perFrameBytes;
+            }
+            // Maximum batch size that fits
+            auto fittedBatchSize = 0;
+            if (fixedBytes + perFrameBytes <= budgetBytes)
+            {
+                fittedBatchSize = (batchSize > 1 ? batchSize : 1);
+                if (perFrameBytes > 0)
+                    fittedBatchSize = (int)std::min(
+                        (unsigned long long)fittedBatchSize, (budgetBytes - fixedBytes) / perFrameBytes);
+            }
+            const auto projectedBytes = fixedBytes + (fittedBatchSize > 1 ? fittedBatchSize : 1) * perFrameBytes;
+            // Report
+            std::string report = "GPU memory budget of " + bytesToMegabytes(budgetBytes) + ":";
+            for (const auto& footprint : footprints)
+            {
+                report += "\n    - " + footprint.component + ": " + bytesToMegabytes(footprint.fixedBytes);
+                if (footprint.perFrameBytes > 0)
+                    report += " + " + bytesToMegabytes(footprint.perFrameBytes) + " per batch frame";
+            }
+            report += "\n    Projected total: " + bytesToMegabytes(projectedBytes) + " with a batch size of "
+                   + std::to_string(fittedBatchSize > 1 ? fittedBatchSize : 1)
+                   + (fittedBatchSize > 0 ? "." : " (it does NOT fit).");
+            return GpuMemoryPlan{
+                fittedBatchSize, projectedBytes, (fittedBatchSize > 0 ? budgetBytes - projectedBytes : 0ull), report};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return GpuMemoryPlan{};
+        }
+    }
+}
@@ -1,6 +1,13 @@
 #include <openpose_private/gpu/opencl.hcl> // Must be before below includes
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
 #include <map>
 #include <mutex>
+#include <sstream>
+#include <openpose/utilities/fileSystem.hpp>
 #ifdef USE_OPENCL
     #include <openpose_private/gpu/cl2.hpp>
     #include <viennacl/backend/opencl.hpp>
@@ -35,8 +42,141 @@ namespace op
             return type;
         }
 
+        // Program binary cache (so the kernels are only compiled the first time OpenPose runs on each device)
+        std::string getProgramCacheDirectory()
+        {
+            try
+            {
+                // `OPENPOSE_OPENCL_CACHE_DIR` overrides the default directory, and an empty one disables the cache
+                const auto* const cacheDirectoryEnv = std::getenv("OPENPOSE_OPENCL_CACHE_DIR");
+                if (cacheDirectoryEnv != nullptr)
+                {
+                    const std::string cacheDirectory{cacheDirectoryEnv};
+                    if (!cacheDirectory.empty())
+                        makeDirectory(cacheDirectory);
+                    return (cacheDirectory.empty() ? "" : formatAsDirectory(cacheDirectory));
+                }
+                #ifdef _WIN32
+                    const auto* const baseDirectoryEnv = std::getenv("LOCALAPPDATA");
+                    const std::vector<std::string> subDirectories{"openpose", "opencl"};
+                #else
+                    const auto* const baseDirectoryEnv = std::getenv("HOME");
+                    const std::vector<std::string> subDirectories{".cache", "openpose", "opencl"};
+                #endif
+                if (baseDirectoryEnv == nullptr)
+                    return "";
+                auto cacheDirectory = formatAsDirectory(baseDirectoryEnv);
+                for (const auto& subDirectory : subDirectories)
+                {
+                    cacheDirectory += subDirectory + "/";
+                    makeDirectory(cacheDirectory);
+                }
+                return cacheDirectory;
+            }
+            catch (const std::exception& e)
+            {
+                opLog("OpenCL program cache disabled: " + std::string(e.what()), Priority::High);
+                return "";
+            }
+        }
+
+        std::string getProgramCacheFilePath(const cl::Device& device, const std::string& src)
+        {
+            static const auto cacheDirectory = getProgramCacheDirectory();
+            if (cacheDirectory.empty())
+                return "";
+            // FNV-1a hash of the device, driver and (already type-replaced) source
+            const auto key = device.getInfo<CL_DEVICE_NAME>() + "\n" + device.getInfo<CL_DEVICE_VERSION>()
+                           + "\n" + device.getInfo<CL_DRIVER_VERSION>() + "\n" + src;
+            auto hash = 14695981039346656037ull;
+            for (const auto character : key)
+            {
+                hash ^= (unsigned char)character;
+                hash *= 1099511628211ull;
+            }
+            std::stringstream fileName;
+            fileName << std::hex << std::setw(16) << std::setfill('0') << hash << ".bin";
+            return cacheDirectory + fileName.str();
+        }
+
+        bool loadProgramBinary(cl::Program& program, cl::Context& context, const cl::Device& device,
+                               const std::string& filePath)
+        {
+            try
+            {
+                std::ifstream binaryFile{filePath, std::ios::binary};
+                if (!binaryFile.is_open())
+                    return false;
+                const std::vector<unsigned char> binary{
+                    std::istreambuf_iterator<char>(binaryFile), std::istreambuf_iterator<char>()};
+                if (binary.empty())
+                    return false;
+                const std::vector<cl::Device> devices{device};
+                program = cl::Program(context, devices, cl::Program::Binaries{binary});
+                program.build(devices);
+                return true;
+            }
+            #if defined(USE_OPENCL) && defined(CL_HPP_ENABLE_EXCEPTIONS)
+            catch (const cl::Error& e)
+            {
+                // E.g., outdated or corrupted binary: It is rebuilt from source (and overwritten)
+                opLog("Cached OpenCL program " + filePath + " could not be loaded (" + std::string(e.what())
+                      + "), building it from source.", Priority::High);
+            }
+            #endif
+            catch (const std::exception& e)
+            {
+                opLog("Cached OpenCL program " + filePath + " could not be loaded (" + std::string(e.what())
+                      + "), building it from source.", Priority::High);
+            }
+            return false;
+        }
+
+        void saveProgramBinary(const cl::Program& program, const cl::Device& device, const std::string& filePath)
+        {
+            try
+            {
+                const auto devices = program.getInfo<CL_PROGRAM_DEVICES>();
+                const auto binaries = program.getInfo<CL_PROGRAM_BINARIES>();
+                for (auto i = 0u ; i < devices.size() && i < binaries.size() ; i++)
+                {
+                    if (devices[i]() == device() && !binaries[i].empty())
+                    {
+                        // Written into a temporary file first, so other processes never read a partial binary
+                        const auto temporaryFilePath = filePath + ".tmp" + std::to_string(
+                            std::chrono::high_resolution_clock::now().time_since_epoch().count());
+                        {
+                            std::ofstream binaryFile{temporaryFilePath, std::ios::binary};
+                            binaryFile.write((const char*)binaries[i].data(), binaries[i].size());
+                            if (!binaryFile.good())
+                                throw std::runtime_error("Could not write " + temporaryFilePath + ".");
+                        }
+                        if (std::rename(temporaryFilePath.c_str(), filePath.c_str()) != 0)
+                        {
+                            std::remove(temporaryFilePath.c_str());
+                            throw std::runtime_error("Could not rename " + temporaryFilePath + ".");
+                        }
+                        break;
+                    }
+                }
+            }
+            #if defined(USE_OPENCL) && defined(CL_HPP_ENABLE_EXCEPTIONS)
+            catch (const cl::Error& e)
+            {
+                opLog("OpenCL program " + filePath + " could not be cached: " + std::string(e.what()),
+                      Priority::High);
+            }
+            #endif
+            catch (const std::exception& e)
+            {
+                opLog("OpenCL program " + filePath + " could not be cached: " + std::string(e.what()),
+                      Priority::High);
+            }
+        }
+
         template <typename T>
-        bool buildProgramFromSource(cl::Program& program, cl::Context& context, std::string src, bool isFile = false)
+        bool buildProgramFromSource(cl::Program& program, cl::Context& context, const cl::Device& device,
+                                    std::string src, bool isFile = false)
         {
             #ifdef USE_OPENCL
                 try
@@ -51,7 +191,13 @@ namespace op
                     }
                     //src = std::regex_replace(src, std::regex("Type"), std::string(type));
                     replaceAll(src, "Type", type);
+                    // Cached binary (same device, driver and source), otherwise built and cached
+                    const auto cacheFilePath = getProgramCacheFilePath(device, src);
+                    if (!cacheFilePath.empty() && loadProgramBinary(program, context, device, cacheFilePath))
+                        return true;
                     program = cl::Program(context, src, true);
+                    if (!cacheFilePath.empty())
+                        saveProgramBinary(program, device, cacheFilePath);
                 }
                 #if defined(USE_OPENCL) && defined(CL_HPP_ENABLE_EXCEPTIONS)
                 catch (cl::BuildError e)
@@ -71,6 +217,7 @@ namespace op
                 return true;
             #else
                 UNUSED(program);
+                UNUSED(device);
                 UNUSED(src);
                 UNUSED(isFile);
                 error("OpenPose must be compiled with the `USE_OPENCL` macro definition in order to use this"
@@ -104,10 +251,15 @@ namespace op
             int mId;
             cl::Device mDevice;
             cl::CommandQueue mQueue;
+            cl::CommandQueue mPostProcessingQueue;
             cl::Context mContext;
+            int mUnifiedMemory; // -1 if not queried yet
         #endif
 
         ImplCLManager()
+            #ifdef USE_OPENCL
+                : mUnifiedMemory{-1}
+            #endif
         {
         }
     };
@@ -248,6 +400,23 @@ namespace op
                     error(e.what(), __LINE__, __FUNCTION__, __FILE__);
                 }
             }
+            // Post-processing queue (in-order, so the kernels of each post-processing step can depend on the
+            // previous ones), independent from the network one
+            try
+            {
+                if (upImpl->mContext() != nullptr)
+                    upImpl->mPostProcessingQueue = cl::CommandQueue(upImpl->mContext, upImpl->mDevice);
+            }
+            #if defined(USE_OPENCL) && defined(CL_HPP_ENABLE_EXCEPTIONS)
+            catch (const cl::Error& e)
+            {
+                opLog("Error: " + std::string(e.what()));
+            }
+            #endif
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
         #else
             UNUSED(deviceId);
             UNUSED(deviceType);
@@ -272,6 +441,62 @@ namespace op
         #endif
     }
 
+    cl::CommandQueue& OpenCL::getPostProcessingQueue()
+    {
+        #ifdef USE_OPENCL
+            // Network queue if it could not be created
+            return (upImpl->mPostProcessingQueue() != nullptr ? upImpl->mPostProcessingQueue : upImpl->mQueue);
+        #else
+            error("OpenPose must be compiled with the `USE_OPENCL` macro definition in order to use this"
+                  " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            throw std::runtime_error("");
+        #endif
+    }
+
+    cl::CommandQueue& OpenCL::getPostProcessingQueueAfterNetwork()
+    {
+        #ifdef USE_OPENCL
+            auto& postProcessingQueue = getPostProcessingQueue();
+            enqueueWait(postProcessingQueue, upImpl->mQueue);
+            return postProcessingQueue;
+        #else
+            error("OpenPose must be compiled with the `USE_OPENCL` macro definition in order to use this"
+                  " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            throw std::runtime_error("");
+        #endif
+    }
+
+    void OpenCL::enqueueWait(cl::CommandQueue& waitingQueue, cl::CommandQueue& queue)
+    {
+        #ifdef USE_OPENCL
+            try
+            {
+                if (waitingQueue() == queue())
+                    return;
+                cl::Event event;
+                queue.enqueueMarkerWithWaitList(nullptr, &event);
+                const std::vector<cl::Event> events{event};
+                waitingQueue.enqueueBarrierWithWaitList(&events);
+            }
+            #if defined(USE_OPENCL) && defined(CL_HPP_ENABLE_EXCEPTIONS)
+            catch (const cl::Error& e)
+            {
+                error("OpenCL error: " + std::string(e.what()) + " (" + clErrorToString(e.err()) + ").",
+                      __LINE__, __FUNCTION__, __FILE__);
+            }
+            #endif
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        #else
+            UNUSED(waitingQueue);
+            UNUSED(queue);
+            error("OpenPose must be compiled with the `USE_OPENCL` macro definition in order to use this"
+                  " functionality.", __LINE__, __FUNCTION__, __FILE__);
+        #endif
+    }
+
     cl::Device& OpenCL::getDevice()
     {
         #ifdef USE_OPENCL
@@ -306,7 +531,7 @@ namespace op
             if (!(upImpl->mClPrograms.find(key) != upImpl->mClPrograms.end()))
             {
                 cl::Program program;
-                buildProgramFromSource<T>(program, upImpl->mContext, src, isFile);
+                buildProgramFromSource<T>(program, upImpl->mContext, upImpl->mDevice, src, isFile);
                 upImpl->mClPrograms[key] = program;
             }
 
@@ -519,6 +744,34 @@ namespace op
         #endif
     }
 
+    bool OpenCL::hasUnifiedMemory()
+    {
+        #ifdef USE_OPENCL
+            try
+            {
+                // Queried once, it is constant for the device
+                if (upImpl->mUnifiedMemory < 0)
+                {
+                    cl_bool unifiedMemory = CL_FALSE;
+                    if (clGetDeviceInfo(getDevice().get(), CL_DEVICE_HOST_UNIFIED_MEMORY, sizeof(unifiedMemory),
+                                        &unifiedMemory, nullptr) != CL_SUCCESS)
+                        unifiedMemory = CL_FALSE;
+                    upImpl->mUnifiedMemory = (unifiedMemory == CL_TRUE ? 1 : 0);
+                }
+                return upImpl->mUnifiedMemory == 1;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return false;
+            }
+        #else
+            error("OpenPose must be compiled with the `USE_OPENCL` macro definition in order to use this"
+                  " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        #endif
+    }
+
     template void OpenCL::getBufferRegion<float>(cl_buffer_region& region, const int origin, const int size);
     template void OpenCL::getBufferRegion<double>(cl_buffer_region& region, const int origin, const int size);
     template cl::Kernel&  OpenCL::getKernelFromManager<float>(const std::string& kernelName, const std::string& src, bool isFile);
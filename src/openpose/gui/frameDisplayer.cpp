@@ -1,13 +1,157 @@
 #include <openpose/gui/frameDisplayer.hpp>
  #include <openpose_private/utilities/openCvMultiversionHeaders.hpp>
+#ifdef USE_OPENCV_WITH_OPENGL
+    #include <opencv2/core/opengl.hpp>
+    // Last, its macros (e.g., X11 `None` or `Status`) must not affect the other headers
+    #ifdef _WIN32
+        #include <windows.h>
+        #include <GL/gl.h>
+    #elif defined(__APPLE__)
+        #include <OpenGL/gl.h>
+    #else
+        #include <GL/gl.h>
+        #include <GL/glx.h>
+    #endif
+#endif
 
 namespace op
 {
+    struct FrameDisplayer::ImplFrameDisplayer
+    {
+        const bool mVSync;
+        // Overlay (BGRA)
+        Matrix mOverlay;
+        bool mOverlayChanged;
+        cv::Rect mOverlayRectangle; // Non-transparent region
+        #ifdef USE_OPENCV_WITH_OPENGL
+            // Double buffered: each frame is uploaded into the one not used by the previous frame
+            cv::ogl::Buffer mPixelBuffers[2];
+            cv::ogl::Texture2D mTextures[2];
+            int mTextureIndex;
+            cv::ogl::Texture2D mOverlayTexture;
+            // Displayed frame (for drawFrameAndOverlay)
+            const cv::ogl::Texture2D* pFrameTexture;
+            cv::Rect_<double> mOverlayWindowRectangle;
+        #endif
+
+        explicit ImplFrameDisplayer(const bool vSync) :
+            mVSync{vSync},
+            mOverlayChanged{false}
+            #ifdef USE_OPENCV_WITH_OPENGL
+                , mTextureIndex{0},
+                pFrameTexture{nullptr}
+            #endif
+        {
+        }
+
+        #ifdef USE_OPENCV_WITH_OPENGL
+            // OpenGL draw callback of the window: the frame and, over it, the alpha blended overlay
+            static void drawFrameAndOverlay(void* userData)
+            {
+                try
+                {
+                    const auto& implFrameDisplayer = *(const ImplFrameDisplayer*)userData;
+                    if (implFrameDisplayer.pFrameTexture == nullptr)
+                        return;
+                    cv::ogl::render(*implFrameDisplayer.pFrameTexture);
+                    glEnable(GL_BLEND);
+                    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                    cv::ogl::render(implFrameDisplayer.mOverlayTexture, implFrameDisplayer.mOverlayWindowRectangle);
+                    glDisable(GL_BLEND);
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+        #endif
+    };
+
+    // Alpha blending of the region of overlay (CV_8UC4) inside overlayRectangle into cvMat (CV_8UC3)
+    void blendOverlay(cv::Mat& cvMat, const cv::Mat& overlay, const cv::Rect& overlayRectangle)
+    {
+        try
+        {
+            const auto rectangle = overlayRectangle & cv::Rect{0, 0, cvMat.cols, cvMat.rows};
+            for (auto y = rectangle.y ; y < rectangle.y + rectangle.height ; y++)
+            {
+                auto* cvMatPtr = cvMat.ptr<unsigned char>(y) + 3*rectangle.x;
+                const auto* overlayPtr = overlay.ptr<unsigned char>(y) + 4*rectangle.x;
+                for (auto x = 0 ; x < rectangle.width ; x++, cvMatPtr += 3, overlayPtr += 4)
+                {
+                    const auto alpha = (unsigned int)overlayPtr[3];
+                    if (alpha == 255u)
+                    {
+                        cvMatPtr[0] = overlayPtr[0];
+                        cvMatPtr[1] = overlayPtr[1];
+                        cvMatPtr[2] = overlayPtr[2];
+                    }
+                    else if (alpha > 0u)
+                        for (auto channel = 0 ; channel < 3 ; channel++)
+                            cvMatPtr[channel] = (unsigned char)(
+                                (overlayPtr[channel]*alpha + cvMatPtr[channel]*(255u-alpha) + 127u) / 255u);
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    #ifdef USE_OPENCV_WITH_OPENGL
+        // It must be called with the OpenGL context of the window current (cv::setOpenGlContext)
+        inline bool setSwapInterval(const int swapInterval)
+        {
+            try
+            {
+                #ifdef _WIN32
+                    typedef BOOL (WINAPI* WglSwapIntervalExt)(int);
+                    const auto wglSwapIntervalExt = (WglSwapIntervalExt)wglGetProcAddress("wglSwapIntervalEXT");
+                    return (wglSwapIntervalExt != nullptr && wglSwapIntervalExt(swapInterval) == TRUE);
+                #elif defined(__APPLE__)
+                    UNUSED(swapInterval);
+                    return false;
+                #else
+                    typedef void (*GlxSwapIntervalExt)(Display*, GLXDrawable, int);
+                    typedef int (*GlxSwapIntervalMesa)(unsigned int);
+                    typedef int (*GlxSwapIntervalSgi)(int);
+                    auto* const display = glXGetCurrentDisplay();
+                    const auto drawable = glXGetCurrentDrawable();
+                    if (display == nullptr || drawable == 0)
+                        return false;
+                    const auto glxSwapIntervalExt = (GlxSwapIntervalExt)glXGetProcAddressARB(
+                        (const GLubyte*)"glXSwapIntervalEXT");
+                    if (glxSwapIntervalExt != nullptr)
+                    {
+                        glxSwapIntervalExt(display, drawable, swapInterval);
+                        return true;
+                    }
+                    const auto glxSwapIntervalMesa = (GlxSwapIntervalMesa)glXGetProcAddressARB(
+                        (const GLubyte*)"glXSwapIntervalMESA");
+                    if (glxSwapIntervalMesa != nullptr)
+                        return glxSwapIntervalMesa((unsigned int)swapInterval) == 0;
+                    // SGI cannot disable it (0 is not a valid interval)
+                    const auto glxSwapIntervalSgi = (GlxSwapIntervalSgi)glXGetProcAddressARB(
+                        (const GLubyte*)"glXSwapIntervalSGI");
+                    return (glxSwapIntervalSgi != nullptr && swapInterval > 0
+                            && glxSwapIntervalSgi(swapInterval) == 0);
+                #endif
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return false;
+            }
+        }
+    #endif
+
     FrameDisplayer::FrameDisplayer(const std::string& windowedName, const Point<int>& initialWindowedSize,
-                                   const bool fullScreen) :
+                                   const bool fullScreen, const bool vSync) :
         mWindowName{windowedName},
         mWindowedSize{initialWindowedSize},
-        mFullScreenMode{(fullScreen ? FullScreenMode::FullScreen : FullScreenMode::Windowed)}
+        mFullScreenMode{(fullScreen ? FullScreenMode::FullScreen : FullScreenMode::Windowed)},
+        upImpl{new ImplFrameDisplayer{vSync}}
     {
         try
         {
@@ -31,6 +175,18 @@ namespace op
         {
             setFullScreenMode(mFullScreenMode);
 
+            // VSync (otherwise each display might block the GUI thread until the next monitor refresh)
+            #ifdef USE_OPENCV_WITH_OPENGL
+                cv::setOpenGlContext(mWindowName);
+                if (!setSwapInterval(upImpl->mVSync ? 1 : 0))
+                    opLog("VSync could not be " + std::string(upImpl->mVSync ? "enabled" : "disabled")
+                          + " (not supported by this OpenGL driver).", Priority::High);
+            #else
+                if (upImpl->mVSync)
+                    opLog("VSync requires OpenPose compiled with WITH_OPENCV_WITH_OPENGL, it will be ignored.",
+                          Priority::High);
+            #endif
+
             const cv::Mat cvBlackFrame(mWindowedSize.y, mWindowedSize.x, CV_32FC3, {0,0,0});
             const Matrix blackFrame = OP_CV2OPCONSTMAT(cvBlackFrame);
             FrameDisplayer::displayFrame(blackFrame);
@@ -109,7 +265,56 @@ namespace op
                 // in 1 msec)
                 cv::waitKey(1);
             }
-            cv::imshow(mWindowName, cvFrame);
+            const auto overlayEnabled = (!upImpl->mOverlay.empty() && cvFrame.type() == CV_8UC3);
+            #ifdef USE_OPENCV_WITH_OPENGL
+                cv::setOpenGlContext(mWindowName);
+                // Asynchronous upload: host -> pixel buffer, and pixel buffer -> texture on the GPU side
+                auto& pixelBuffer = upImpl->mPixelBuffers[upImpl->mTextureIndex];
+                pixelBuffer.copyFrom(
+                    (cvFrame.isContinuous() ? cvFrame : cvFrame.clone()), cv::ogl::Buffer::PIXEL_UNPACK_BUFFER);
+                auto& texture = upImpl->mTextures[upImpl->mTextureIndex];
+                texture.copyFrom(pixelBuffer);
+                // Overlay blended on the GPU (only uploaded again if it changed)
+                if (overlayEnabled)
+                {
+                    const cv::Mat cvOverlay = OP_OP2CVCONSTMAT(upImpl->mOverlay);
+                    if (upImpl->mOverlayChanged)
+                    {
+                        upImpl->mOverlayTexture.copyFrom(cvOverlay);
+                        upImpl->mOverlayChanged = false;
+                    }
+                    upImpl->pFrameTexture = &texture;
+                    upImpl->mOverlayWindowRectangle = cv::Rect_<double>{
+                        0., 0., std::min(1., cvOverlay.cols / (double)cvFrame.cols),
+                        std::min(1., cvOverlay.rows / (double)cvFrame.rows)};
+                    cv::setOpenGlDrawCallback(mWindowName, ImplFrameDisplayer::drawFrameAndOverlay, upImpl.get());
+                    cv::updateWindow(mWindowName);
+                }
+                else
+                    cv::imshow(mWindowName, texture);
+                upImpl->mTextureIndex = 1 - upImpl->mTextureIndex;
+            #else
+                // Overlay blended into a copy of the frame
+                if (overlayEnabled)
+                {
+                    const cv::Mat cvOverlay = OP_OP2CVCONSTMAT(upImpl->mOverlay);
+                    if (upImpl->mOverlayChanged)
+                    {
+                        cv::Mat alpha;
+                        cv::extractChannel(cvOverlay, alpha, 3);
+                        std::vector<cv::Point> nonZeroPoints;
+                        cv::findNonZero(alpha, nonZeroPoints);
+                        upImpl->mOverlayRectangle = (nonZeroPoints.empty()
+                                                     ? cv::Rect{} : cv::boundingRect(nonZeroPoints));
+                        upImpl->mOverlayChanged = false;
+                    }
+                    cv::Mat cvFrameWithOverlay = cvFrame.clone();
+                    blendOverlay(cvFrameWithOverlay, cvOverlay, upImpl->mOverlayRectangle);
+                    cv::imshow(mWindowName, cvFrameWithOverlay);
+                }
+                else
+                    cv::imshow(mWindowName, cvFrame);
+            #endif
             if (waitKeyValue != -1)
                 cv::waitKey(waitKeyValue);
         }
@@ -119,6 +324,22 @@ namespace op
         }
     }
 
+    void FrameDisplayer::setOverlay(const Matrix& overlay)
+    {
+        try
+        {
+            // Sanity check
+            if (!overlay.empty() && overlay.type() != CV_8UC4)
+                error("The overlay must be a BGRA image (CV_8UC4).", __LINE__, __FUNCTION__, __FILE__);
+            upImpl->mOverlay = overlay;
+            upImpl->mOverlayChanged = true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     void FrameDisplayer::displayFrame(const std::vector<Matrix>& frames, const int waitKeyValue)
     {
         try
@@ -134,15 +355,17 @@ namespace op
             {
                 // Prepare final cvMat
                 // Concat (0)
-                Matrix opMat = frames[0].clone();
-                cv::Mat cvMat = OP_OP2CVMAT(opMat);
+                // No clone() needed: cv::hconcat allocates a new output, so frames[0] is only read
+                cv::Mat cvMat = OP_OP2CVCONSTMAT(frames[0]);
                 // Concat (1,size()-1)
                 for (auto i = 1u; i < frames.size(); i++)
                 {
                     const cv::Mat framesI = OP_OP2CVCONSTMAT(frames[i]);
-                    cv::hconcat(cvMat, framesI, cvMat);
+                    cv::Mat cvMatConcatenated;
+                    cv::hconcat(cvMat, framesI, cvMatConcatenated);
+                    cvMat = cvMatConcatenated;
                 }
-                opMat = OP_CV2OPMAT(cvMat);
+                const Matrix opMat = OP_CV2OPMAT(cvMat);
                 // Display it
                 displayFrame(opMat, waitKeyValue);
             }
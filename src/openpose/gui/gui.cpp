@@ -225,16 +225,18 @@ namespace op
              const std::vector<std::shared_ptr<FaceExtractorNet>>& faceExtractorNets,
              const std::vector<std::shared_ptr<HandExtractorNet>>& handExtractorNets,
              const std::vector<std::shared_ptr<Renderer>>& renderers,
-             const DisplayMode displayMode) :
+             const DisplayMode displayMode, const bool vSync, const bool skipStaleFrames) :
         spIsRunning{isRunningSharedPtr},
         mDisplayMode{displayMode},
         mDisplayModeOriginal{displayMode},
-        mFrameDisplayer{OPEN_POSE_NAME_AND_VERSION, outputSize, fullScreen},
+        mFrameDisplayer{OPEN_POSE_NAME_AND_VERSION, outputSize, fullScreen, vSync},
         mPoseExtractorNets{poseExtractorNets},
         mFaceExtractorNets{faceExtractorNets},
         mHandExtractorNets{handExtractorNets},
         mRenderers{renderers},
-        spVideoSeek{videoSeekSharedPtr}
+        spVideoSeek{videoSeekSharedPtr},
+        mSkipStaleFrames{skipStaleFrames},
+        mLastFrameDisplayed{std::chrono::high_resolution_clock::now()}
     {
     }
 
@@ -276,7 +278,22 @@ namespace op
 
             // Display
             if (returnedIsValidFrame)
+            {
                 mFrameDisplayer.displayFrame(cvMatOutputs, -1);
+                mLastFrameDisplayed = std::chrono::high_resolution_clock::now();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void Gui::setOverlay(const Matrix& overlay)
+    {
+        try
+        {
+            mFrameDisplayer.setOverlay(overlay);
         }
         catch (const std::exception& e)
         {
@@ -297,4 +314,21 @@ namespace op
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
         }
     }
+
+    bool Gui::isStaleFrame(const unsigned long long queueInBacklog)
+    {
+        try
+        {
+            if (!mSkipStaleFrames || queueInBacklog == 0ull)
+                return false;
+            const auto msSinceLastFrame = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::high_resolution_clock::now() - mLastFrameDisplayed).count();
+            return msSinceLastFrame < 100;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
 }
@@ -1,34 +1,110 @@
 ﻿#include <openpose/gui/gui3D.hpp>
 #include <atomic>
+#include <chrono>
+#include <cstddef> // std::ptrdiff_t
+#include <cstring> // std::memcpy
 #include <mutex>
 #include <stdio.h>
+#include <thread>
 #ifdef USE_3D_RENDERER
     #include <GL/glut.h>
-    #include <GL/freeglut_ext.h> // glutLeaveMainLoop
+    #include <GL/freeglut_ext.h> // glutGetProcAddress, glutCloseFunc, glutMainLoopEvent
     #include <GL/freeglut_std.h>
 #endif
 #include <opencv2/opencv.hpp>
+#include <openpose/core/arrayView.hpp>
 #include <openpose/face/faceParameters.hpp>
 #include <openpose/hand/handParameters.hpp>
 #include <openpose/pose/poseParameters.hpp>
+#include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/keypoint.hpp>
 
+#ifdef USE_3D_RENDERER
+    // OpenGL > 1.1 constants (Windows only ships OpenGL 1.1 headers)
+    #ifndef APIENTRY
+        #define APIENTRY
+    #endif
+    #ifndef GL_ARRAY_BUFFER
+        #define GL_ARRAY_BUFFER 0x8892
+    #endif
+    #ifndef GL_STREAM_DRAW
+        #define GL_STREAM_DRAW 0x88E0
+    #endif
+    #ifndef GL_STATIC_DRAW
+        #define GL_STATIC_DRAW 0x88E4
+    #endif
+    #ifndef GL_FRAGMENT_SHADER
+        #define GL_FRAGMENT_SHADER 0x8B30
+    #endif
+    #ifndef GL_VERTEX_SHADER
+        #define GL_VERTEX_SHADER 0x8B31
+    #endif
+    #ifndef GL_COMPILE_STATUS
+        #define GL_COMPILE_STATUS 0x8B81
+    #endif
+    #ifndef GL_LINK_STATUS
+        #define GL_LINK_STATUS 0x8B82
+    #endif
+    #ifndef GL_MAP_WRITE_BIT
+        #define GL_MAP_WRITE_BIT 0x0002
+    #endif
+    #ifndef GL_MAP_PERSISTENT_BIT
+        #define GL_MAP_PERSISTENT_BIT 0x0040
+    #endif
+    #ifndef GL_MAP_COHERENT_BIT
+        #define GL_MAP_COHERENT_BIT 0x0080
+    #endif
+    #ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+        #define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+    #endif
+    #ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+        #define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+    #endif
+    #ifndef GL_WAIT_FAILED
+        #define GL_WAIT_FAILED 0x911D
+    #endif
+#endif
+
 namespace op
 {
     #ifdef USE_3D_RENDERER
         const bool LOG_VERBOSE_3D_RENDERER = false;
         const auto WINDOW_WIDTH = 1280;
         const auto WINDOW_HEIGHT = 720;
+        // Upper bound of the 3-D display FPS if the driver does not synchronize the buffer swaps with the monitor
+        const auto MAX_RENDER_FPS = 120ll;
         std::atomic<bool> sConstructorSet{false};
 
-        struct Keypoints3D
+        // Each sphere (keypoint) and limb (cone) is an instance of 12 floats: center or limb start (x,y,z) and radius,
+        // limb end (x,y,z) (unused for spheres) and padding, and color (r,g,b,a)
+        const auto INSTANCE_FLOATS = 12;
+        const auto INSTANCE_BYTES = INSTANCE_FLOATS * (int)sizeof(float);
+        // Interleaved position (x,y,z) and normal (x,y,z) of the unit sphere and cone meshes
+        const auto MESH_FLOATS = 6;
+        // Conversion from the 3-D keypoints (in mm) into the rendering coordinates
+        const auto X_OFFSET = -3000.f;
+        const auto Y_OFFSET = 1000.f;
+        const auto Z_OFFSET = 1000.f;
+        const auto X_SCALE = 43.f;
+        const auto Y_SCALE = 24.f;
+        const auto Z_SCALE = 24.f;
+
+        struct Instances3D
         {
-            Array<float> poseKeypoints;
-            Array<float> faceKeypoints;
-            Array<float> leftHandKeypoints;
-            Array<float> rightHandKeypoints;
-            bool validKeypoints;
-            std::mutex mutex;
+            std::vector<float> spheres;
+            std::vector<float> limbs;
+        };
+
+        // Lock-free triple buffer between setKeypoints() (producer, pipeline thread) and the render thread
+        // (consumer): the producer fills `back` and swaps it with `middle`, while the consumer swaps `front` with
+        // `middle` only if it has new data. None of them ever waits for the other one.
+        const auto TRIPLE_BUFFER_NEW_DATA = 4;
+        struct InstancesTripleBuffer
+        {
+            Instances3D buffers[3];
+            int back = 0;
+            int front = 1;
+            std::atomic<int> middle{2};
         };
 
         enum class CameraMode {
@@ -38,9 +114,22 @@ namespace op
             CAM_PAN_Z
         };
 
-        Keypoints3D gKeypoints3D;
+        InstancesTripleBuffer gInstances;
         PoseModel sPoseModel = PoseModel::BODY_25;
-        int sLastKeyPressed = -1;
+        std::atomic<int> sLastKeyPressed{-1};
+
+        // Render thread, which owns the GLUT window and the OpenGL context
+        std::thread gRenderThread;
+        std::atomic<bool> gRenderThreadStop{false};
+        std::atomic<bool> gWindowClosed{false};
+        std::atomic<bool> gRenderThreadFailed{false};
+        std::string gRenderThreadError;
+        std::mutex gRenderThreadErrorMutex;
+        int gWindowId = 0;
+        // Last rendered frame (if copyGlToCvMat), the mutex only guards the cv::Mat header swap
+        bool gCopyGlToCvMat = false;
+        cv::Mat gGlImage;
+        std::mutex gGlImageMutex;
 
         CameraMode gCameraMode = CameraMode::CAM_DEFAULT;
 
@@ -62,6 +151,117 @@ namespace op
         auto gMouseZPan = 0.f;
         auto gScaleForMouseMotion = 0.1f;
 
+        // OpenGL 3.3 (and 4.4 for persistent mapping) functions, loaded at runtime so no extra dependency (e.g.,
+        // GLEW) is required. If they are not available, the fixed-function pipeline is used instead.
+        typedef struct __GLsync* OpGlSync;
+        struct GlFunctions
+        {
+            void (APIENTRY* genBuffers)(GLsizei, GLuint*);
+            void (APIENTRY* deleteBuffers)(GLsizei, const GLuint*);
+            void (APIENTRY* bindBuffer)(GLenum, GLuint);
+            void (APIENTRY* bufferData)(GLenum, std::ptrdiff_t, const void*, GLenum);
+            void (APIENTRY* bufferSubData)(GLenum, std::ptrdiff_t, std::ptrdiff_t, const void*);
+            void (APIENTRY* bufferStorage)(GLenum, std::ptrdiff_t, const void*, GLbitfield);
+            void* (APIENTRY* mapBufferRange)(GLenum, std::ptrdiff_t, std::ptrdiff_t, GLbitfield);
+            OpGlSync (APIENTRY* fenceSync)(GLenum, GLbitfield);
+            GLenum (APIENTRY* clientWaitSync)(OpGlSync, GLbitfield, unsigned long long);
+            void (APIENTRY* deleteSync)(OpGlSync);
+            GLuint (APIENTRY* createShader)(GLenum);
+            void (APIENTRY* shaderSource)(GLuint, GLsizei, const char* const*, const GLint*);
+            void (APIENTRY* compileShader)(GLuint);
+            void (APIENTRY* getShaderiv)(GLuint, GLenum, GLint*);
+            void (APIENTRY* getShaderInfoLog)(GLuint, GLsizei, GLsizei*, char*);
+            void (APIENTRY* deleteShader)(GLuint);
+            GLuint (APIENTRY* createProgram)();
+            void (APIENTRY* attachShader)(GLuint, GLuint);
+            void (APIENTRY* bindAttribLocation)(GLuint, GLuint, const char*);
+            void (APIENTRY* linkProgram)(GLuint);
+            void (APIENTRY* getProgramiv)(GLuint, GLenum, GLint*);
+            void (APIENTRY* getProgramInfoLog)(GLuint, GLsizei, GLsizei*, char*);
+            void (APIENTRY* useProgram)(GLuint);
+            void (APIENTRY* deleteProgram)(GLuint);
+            GLint (APIENTRY* getUniformLocation)(GLuint, const char*);
+            void (APIENTRY* uniform1f)(GLint, GLfloat);
+            void (APIENTRY* enableVertexAttribArray)(GLuint);
+            void (APIENTRY* disableVertexAttribArray)(GLuint);
+            void (APIENTRY* vertexAttribPointer)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*);
+            void (APIENTRY* vertexAttribDivisor)(GLuint, GLuint);
+            void (APIENTRY* drawArraysInstanced)(GLenum, GLint, GLsizei, GLsizei);
+        };
+
+        // Instances are streamed into a ring of 3 segments of the instance VBO: while the GPU draws from one, the
+        // next one is written. With persistent mapping (OpenGL 4.4), the VBO is mapped once and each segment is
+        // protected by a fence. Otherwise, the VBO is orphaned and refilled with glBufferSubData every new frame.
+        const auto RING_SEGMENTS = 3;
+        struct InstancedRenderer
+        {
+            bool enabled = false;
+            bool persistent = false;
+            GlFunctions gl;
+            GLuint program = 0;
+            GLint limbLocation = -1;
+            GLuint meshBuffer = 0;
+            int sphereVertices = 0;
+            int coneVertices = 0;
+            GLuint instanceBuffer = 0;
+            unsigned long long segmentCapacity = 0; // In instances
+            float* mappedPtr = nullptr;
+            OpGlSync fences[RING_SEGMENTS] = {nullptr, nullptr, nullptr};
+            int segment = 0;
+            int numberSpheres = 0;
+            int numberLimbs = 0;
+        };
+        InstancedRenderer gRenderer;
+
+        // Sphere and limb attributes: aInstanceA = center or limb start (xyz) and radius (w), aInstanceB = limb end.
+        // The unit cone (base radius 1 at z = 0, apex at z = 1) is oriented along the limb, as glutSolidCone
+        // in drawConeByTwoPts. The light matches initGraphics (white infinite light at (1,1,1), eye coordinates).
+        const char* const VERTEX_SHADER_SOURCE =
+            "#version 130\n"
+            "in vec3 aPosition;\n"
+            "in vec3 aNormal;\n"
+            "in vec4 aInstanceA;\n"
+            "in vec3 aInstanceB;\n"
+            "in vec4 aInstanceColor;\n"
+            "uniform float uLimb;\n"
+            "out vec3 vColor;\n"
+            "void main()\n"
+            "{\n"
+            "    vec3 position = aInstanceA.xyz + aInstanceA.w * aPosition;\n"
+            "    vec3 normal = aNormal;\n"
+            "    if (uLimb > 0.5)\n"
+            "    {\n"
+            "        vec3 axis = aInstanceB - aInstanceA.xyz;\n"
+            "        float height = length(axis);\n"
+            "        vec3 w = axis / height;\n"
+            "        vec3 helper = (abs(w.x) < 0.9 ? vec3(1.0, 0.0, 0.0) : vec3(0.0, 1.0, 0.0));\n"
+            "        vec3 u = normalize(cross(helper, w));\n"
+            "        vec3 v = cross(w, u);\n"
+            "        position = aInstanceA.xyz + aInstanceA.w * (aPosition.x * u + aPosition.y * v)\n"
+            "                 + height * aPosition.z * w;\n"
+            "        normal = (aNormal.x * u + aNormal.y * v) / aInstanceA.w + aNormal.z / height * w;\n"
+            "    }\n"
+            "    gl_Position = gl_ModelViewProjectionMatrix * vec4(position, 1.0);\n"
+            "    vec3 eyeNormal = normalize(gl_NormalMatrix * normal);\n"
+            "    float diffuse = max(dot(eyeNormal, normalize(vec3(1.0, 1.0, 1.0))), 0.0);\n"
+            "    vColor = min(1.2 * aInstanceColor.rgb + vec3(0.5 * diffuse), vec3(1.0));\n"
+            "}\n";
+        const char* const FRAGMENT_SHADER_SOURCE =
+            "#version 130\n"
+            "in vec3 vColor;\n"
+            "void main()\n"
+            "{\n"
+            "    gl_FragColor = vec4(vColor, 1.0);\n"
+            "}\n";
+        enum InstancedAttribute : GLuint
+        {
+            ATTRIBUTE_POSITION = 0,
+            ATTRIBUTE_NORMAL,
+            ATTRIBUTE_INSTANCE_A,
+            ATTRIBUTE_INSTANCE_B,
+            ATTRIBUTE_INSTANCE_COLOR,
+        };
+
         void drawConeByTwoPts(const cv::Point3f& pt1, const cv::Point3f& pt2, const float ptSize)
         {
             const GLdouble x1 = pt1.x;
@@ -94,86 +294,477 @@ namespace op
             glPopMatrix();
         }
 
-        void renderHumanBody(const Array<float>& keypoints, const std::vector<unsigned int>& pairs,
-                             const std::vector<float> colors, const float ratio)
+        void addInstance(std::vector<float>& instances, const float* const keypointA, const float* const keypointB,
+                         const float radius, const std::vector<float>& colors, const unsigned int colorIndex)
         {
-            const auto person = 0;
-            const auto numberPeople = keypoints.getSize(0);
-            const auto numberBodyParts = keypoints.getSize(1);
             const auto numberColors = colors.size();
-            const auto xOffset = -3000.f; // 640.f;
-            const auto yOffset = 1000.f; // 360.f;
-            const auto zOffset = 1000.f; // 360.f;
-            const auto xScale = 43.f;
-            const auto yScale = 24.f;
-            const auto zScale = 24.f;
-
-            if (numberPeople > person)
-            //for(int person=0;person<numberPeople;++person)
-            {
-                // Circle for each keypoint
-                for (auto part = 0; part < numberBodyParts; part++)
+            // From m to mm, and into the rendering coordinates
+            const auto xA = -(1e3f * keypointA[0] - X_OFFSET) / X_SCALE;
+            const auto yA = -(1e3f * keypointA[1] - Y_OFFSET) / Y_SCALE;
+            const auto zA = (1e3f * keypointA[2] - Z_OFFSET) / Z_SCALE;
+            const auto xB = -(1e3f * keypointB[0] - X_OFFSET) / X_SCALE;
+            const auto yB = -(1e3f * keypointB[1] - Y_OFFSET) / Y_SCALE;
+            const auto zB = (1e3f * keypointB[2] - Z_OFFSET) / Z_SCALE;
+            // Zero-length limbs have no orientation (and are hidden by the spheres)
+            if (keypointA != keypointB && xA == xB && yA == yB && zA == zB)
+                return;
+            instances.insert(instances.end(), {
+                xA, yA, zA, radius, xB, yB, zB, 0.f,
+                colors[colorIndex % numberColors] / 255.f,
+                colors[(colorIndex + 1) % numberColors] / 255.f,
+                colors[(colorIndex + 2) % numberColors] / 255.f,
+                1.f
+            });
+        }
+
+        void addHumanBodyInstances(Instances3D& instances, const Array<float>& keypoints,
+                                   const std::vector<unsigned int>& pairs, const std::vector<float>& colors,
+                                   const float ratio)
+        {
+            if (keypoints.empty())
+                return;
+            // Keypoints 3-D: #people x #parts x 4 (x,y,z,score)
+            const ArrayView3<const float> keypointsView{keypoints};
+            const auto numberPeople = keypointsView.getSize(0);
+            const auto numberBodyParts = keypointsView.getSize(1);
+            const auto radius = 0.5f * ratio;
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                // Sphere for each keypoint
+                for (auto part = 0 ; part < numberBodyParts ; part++)
                 {
-                    // Set color
-                    const auto colorIndex = part * 3;
-                    const std::vector<float> keypointColor{
-                        colors[colorIndex % numberColors] / 255.f,
-                        colors[(colorIndex + 1) % numberColors] / 255.f,
-                        colors[(colorIndex + 2) % numberColors] / 255.f,
-                        1.f
-                    };
-                    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, COLOR_DIFFUSE.data());
-                    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, keypointColor.data());
-                    // Draw circle
-                    const auto baseIndex = 4 * part + person*numberBodyParts;
-                    if (keypoints[baseIndex + 3] > 0)
-                    {
-                        cv::Point3f keypoint{
-                            -(keypoints[baseIndex] - xOffset) / xScale,
-                            -(keypoints[baseIndex + 1] - yOffset) / yScale,
-                            (keypoints[baseIndex + 2] - zOffset) / zScale
-                        };
-                        // Create and add new sphere
-                        glPushMatrix();
-                        glTranslatef(keypoint.x, keypoint.y, keypoint.z);
-                        // Draw sphere
-                        glutSolidSphere(0.5 * ratio, 20, 20);
-                        glPopMatrix();
-                    }
+                    const auto* const keypoint = keypointsView.getPtr(person, part);
+                    if (keypoint[3] > 0)
+                        addInstance(instances.spheres, keypoint, keypoint, radius, colors, 3*part);
+                }
+                // Limbs connecting each keypoint pair
+                for (auto pair = 0u ; pair < pairs.size() ; pair += 2)
+                {
+                    const auto* const keypointA = keypointsView.getPtr(person, pairs[pair]);
+                    const auto* const keypointB = keypointsView.getPtr(person, pairs[pair+1]);
+                    if (keypointA[3] > 0 && keypointB[3] > 0)
+                        addInstance(instances.limbs, keypointA, keypointB, radius, colors, 3*pairs[pair+1]);
                 }
+            }
+        }
 
-                // Lines connecting each keypoint pair
-                for (auto pair = 0u; pair < pairs.size(); pair += 2)
+        bool acquireInstances()
+        {
+            if (!(gInstances.middle.load() & TRIPLE_BUFFER_NEW_DATA))
+                return false;
+            gInstances.front = gInstances.middle.exchange(gInstances.front) & 3;
+            return true;
+        }
+
+        void publishInstances()
+        {
+            gInstances.back = gInstances.middle.exchange(gInstances.back | TRIPLE_BUFFER_NEW_DATA) & 3;
+        }
+
+        void addMeshVertex(std::vector<float>& mesh, const float x, const float y, const float z,
+                           const float normalX, const float normalY, const float normalZ)
+        {
+            mesh.insert(mesh.end(), {x, y, z, normalX, normalY, normalZ});
+        }
+
+        std::vector<float> createSphereAndConeMeshes(int& sphereVertices, int& coneVertices)
+        {
+            const auto pi = 3.14159265358979f;
+            std::vector<float> mesh;
+            // Unit sphere (radius 1 centered at the origin), its normals are its positions
+            const auto stacks = 12;
+            const auto slices = 16;
+            for (auto stack = 0 ; stack < stacks ; stack++)
+            {
+                const auto theta0 = pi * stack / stacks;
+                const auto theta1 = pi * (stack+1) / stacks;
+                for (auto slice = 0 ; slice < slices ; slice++)
                 {
-                    // Set color
-                    const auto colorIndex = pairs[pair+1] * 3;
-                    const std::vector<float> keypointColor{
-                        colors[colorIndex % numberColors] / 255.f,
-                        colors[(colorIndex + 1) % numberColors] / 255.f,
-                        colors[(colorIndex + 2) % numberColors] / 255.f,
-                        1.f
-                    };
-                    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, COLOR_DIFFUSE.data());
-                    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, keypointColor.data());
-                    // Draw line
-                    const auto baseIndexPairA = 4 * pairs[pair] + person*numberBodyParts;
-                    const auto baseIndexPairB = 4 * pairs[pair + 1] + person*numberBodyParts;
-                    if (keypoints[baseIndexPairA + 3] > 0 && keypoints[baseIndexPairB + 3] > 0)
-                    {
-                        cv::Point3f pairKeypointA{
-                            -(keypoints[baseIndexPairA] - xOffset) / xScale,
-                            -(keypoints[baseIndexPairA + 1] - yOffset) / yScale,
-                            (keypoints[baseIndexPairA + 2] - zOffset) / zScale
-                        };
-                        cv::Point3f pairKeypointB{
-                            -(keypoints[baseIndexPairB] - xOffset) / xScale,
-                            -(keypoints[baseIndexPairB + 1] - yOffset) / yScale,
-                            (keypoints[baseIndexPairB + 2] - zOffset) / zScale
-                        };
-                        drawConeByTwoPts(pairKeypointA, pairKeypointB, 0.5f * ratio);
-                    }
+                    const auto phi0 = 2.f * pi * slice / slices;
+                    const auto phi1 = 2.f * pi * (slice+1) / slices;
+                    const cv::Point3f p00{std::sin(theta0)*std::cos(phi0), std::sin(theta0)*std::sin(phi0),
+                                          std::cos(theta0)};
+                    const cv::Point3f p01{std::sin(theta0)*std::cos(phi1), std::sin(theta0)*std::sin(phi1),
+                                          std::cos(theta0)};
+                    const cv::Point3f p10{std::sin(theta1)*std::cos(phi0), std::sin(theta1)*std::sin(phi0),
+                                          std::cos(theta1)};
+                    const cv::Point3f p11{std::sin(theta1)*std::cos(phi1), std::sin(theta1)*std::sin(phi1),
+                                          std::cos(theta1)};
+                    for (const auto& point : {p00, p10, p11, p00, p11, p01})
+                        addMeshVertex(mesh, point.x, point.y, point.z, point.x, point.y, point.z);
                 }
             }
+            sphereVertices = (int)mesh.size() / MESH_FLOATS;
+            // Unit cone (base radius 1 at z = 0, apex at z = 1), as glutSolidCone
+            const auto coneSlices = 10;
+            const auto normalScale = 1.f / std::sqrt(2.f);
+            for (auto slice = 0 ; slice < coneSlices ; slice++)
+            {
+                const auto phi0 = 2.f * pi * slice / coneSlices;
+                const auto phi1 = 2.f * pi * (slice+1) / coneSlices;
+                const auto phiApex = 0.5f * (phi0 + phi1);
+                // Side
+                addMeshVertex(mesh, std::cos(phi0), std::sin(phi0), 0.f,
+                              normalScale*std::cos(phi0), normalScale*std::sin(phi0), normalScale);
+                addMeshVertex(mesh, std::cos(phi1), std::sin(phi1), 0.f,
+                              normalScale*std::cos(phi1), normalScale*std::sin(phi1), normalScale);
+                addMeshVertex(mesh, 0.f, 0.f, 1.f,
+                              normalScale*std::cos(phiApex), normalScale*std::sin(phiApex), normalScale);
+                // Base
+                addMeshVertex(mesh, 0.f, 0.f, 0.f, 0.f, 0.f, -1.f);
+                addMeshVertex(mesh, std::cos(phi1), std::sin(phi1), 0.f, 0.f, 0.f, -1.f);
+                addMeshVertex(mesh, std::cos(phi0), std::sin(phi0), 0.f, 0.f, 0.f, -1.f);
+            }
+            coneVertices = (int)mesh.size() / MESH_FLOATS - sphereVertices;
+            return mesh;
+        }
+
+        template<typename T>
+        bool loadGlFunction(T& function, const char* const name)
+        {
+            function = reinterpret_cast<T>(glutGetProcAddress(name));
+            return (function != nullptr);
+        }
+
+        bool loadGlFunctions(GlFunctions& gl)
+        {
+            return loadGlFunction(gl.genBuffers, "glGenBuffers")
+                && loadGlFunction(gl.deleteBuffers, "glDeleteBuffers")
+                && loadGlFunction(gl.bindBuffer, "glBindBuffer")
+                && loadGlFunction(gl.bufferData, "glBufferData")
+                && loadGlFunction(gl.bufferSubData, "glBufferSubData")
+                && loadGlFunction(gl.createShader, "glCreateShader")
+                && loadGlFunction(gl.shaderSource, "glShaderSource")
+                && loadGlFunction(gl.compileShader, "glCompileShader")
+                && loadGlFunction(gl.getShaderiv, "glGetShaderiv")
+                && loadGlFunction(gl.getShaderInfoLog, "glGetShaderInfoLog")
+                && loadGlFunction(gl.deleteShader, "glDeleteShader")
+                && loadGlFunction(gl.createProgram, "glCreateProgram")
+                && loadGlFunction(gl.attachShader, "glAttachShader")
+                && loadGlFunction(gl.bindAttribLocation, "glBindAttribLocation")
+                && loadGlFunction(gl.linkProgram, "glLinkProgram")
+                && loadGlFunction(gl.getProgramiv, "glGetProgramiv")
+                && loadGlFunction(gl.getProgramInfoLog, "glGetProgramInfoLog")
+                && loadGlFunction(gl.useProgram, "glUseProgram")
+                && loadGlFunction(gl.deleteProgram, "glDeleteProgram")
+                && loadGlFunction(gl.getUniformLocation, "glGetUniformLocation")
+                && loadGlFunction(gl.uniform1f, "glUniform1f")
+                && loadGlFunction(gl.enableVertexAttribArray, "glEnableVertexAttribArray")
+                && loadGlFunction(gl.disableVertexAttribArray, "glDisableVertexAttribArray")
+                && loadGlFunction(gl.vertexAttribPointer, "glVertexAttribPointer")
+                && loadGlFunction(gl.vertexAttribDivisor, "glVertexAttribDivisor")
+                && loadGlFunction(gl.drawArraysInstanced, "glDrawArraysInstanced");
+        }
+
+        bool loadGlPersistentFunctions(GlFunctions& gl)
+        {
+            return loadGlFunction(gl.bufferStorage, "glBufferStorage")
+                && loadGlFunction(gl.mapBufferRange, "glMapBufferRange")
+                && loadGlFunction(gl.fenceSync, "glFenceSync")
+                && loadGlFunction(gl.clientWaitSync, "glClientWaitSync")
+                && loadGlFunction(gl.deleteSync, "glDeleteSync");
+        }
+
+        GLuint compileShader(const GlFunctions& gl, const GLenum type, const char* const source)
+        {
+            const auto shader = gl.createShader(type);
+            gl.shaderSource(shader, 1, &source, nullptr);
+            gl.compileShader(shader);
+            GLint compiled = 0;
+            gl.getShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+            if (!compiled)
+            {
+                std::vector<char> log(1024, '\0');
+                gl.getShaderInfoLog(shader, (GLsizei)log.size(), nullptr, log.data());
+                opLog("3-D renderer shader compilation failed: " + std::string{log.data()}, Priority::High);
+                gl.deleteShader(shader);
+                return 0;
+            }
+            return shader;
+        }
+
+        bool createInstancedProgram(InstancedRenderer& renderer)
+        {
+            const auto& gl = renderer.gl;
+            const auto vertexShader = compileShader(gl, GL_VERTEX_SHADER, VERTEX_SHADER_SOURCE);
+            const auto fragmentShader = compileShader(gl, GL_FRAGMENT_SHADER, FRAGMENT_SHADER_SOURCE);
+            if (vertexShader == 0 || fragmentShader == 0)
+            {
+                if (vertexShader != 0)
+                    gl.deleteShader(vertexShader);
+                if (fragmentShader != 0)
+                    gl.deleteShader(fragmentShader);
+                return false;
+            }
+            renderer.program = gl.createProgram();
+            gl.attachShader(renderer.program, vertexShader);
+            gl.attachShader(renderer.program, fragmentShader);
+            gl.bindAttribLocation(renderer.program, ATTRIBUTE_POSITION, "aPosition");
+            gl.bindAttribLocation(renderer.program, ATTRIBUTE_NORMAL, "aNormal");
+            gl.bindAttribLocation(renderer.program, ATTRIBUTE_INSTANCE_A, "aInstanceA");
+            gl.bindAttribLocation(renderer.program, ATTRIBUTE_INSTANCE_B, "aInstanceB");
+            gl.bindAttribLocation(renderer.program, ATTRIBUTE_INSTANCE_COLOR, "aInstanceColor");
+            gl.linkProgram(renderer.program);
+            // Flagged for deletion, released together with the program
+            gl.deleteShader(vertexShader);
+            gl.deleteShader(fragmentShader);
+            GLint linked = 0;
+            gl.getProgramiv(renderer.program, GL_LINK_STATUS, &linked);
+            if (!linked)
+            {
+                std::vector<char> log(1024, '\0');
+                gl.getProgramInfoLog(renderer.program, (GLsizei)log.size(), nullptr, log.data());
+                opLog("3-D renderer shader linking failed: " + std::string{log.data()}, Priority::High);
+                gl.deleteProgram(renderer.program);
+                renderer.program = 0;
+                return false;
+            }
+            renderer.limbLocation = gl.getUniformLocation(renderer.program, "uLimb");
+            return true;
+        }
+
+        void releaseInstanceBuffer(InstancedRenderer& renderer)
+        {
+            for (auto& fence : renderer.fences)
+            {
+                if (fence != nullptr)
+                    renderer.gl.deleteSync(fence);
+                fence = nullptr;
+            }
+            // Deleting a mapped buffer also unmaps it
+            if (renderer.instanceBuffer != 0)
+                renderer.gl.deleteBuffers(1, &renderer.instanceBuffer);
+            renderer.instanceBuffer = 0;
+            renderer.mappedPtr = nullptr;
+            renderer.segmentCapacity = 0;
+        }
+
+        bool createInstanceBuffer(InstancedRenderer& renderer, const unsigned long long segmentCapacity)
+        {
+            const auto& gl = renderer.gl;
+            gl.genBuffers(1, &renderer.instanceBuffer);
+            gl.bindBuffer(GL_ARRAY_BUFFER, renderer.instanceBuffer);
+            renderer.segmentCapacity = segmentCapacity;
+            if (renderer.persistent)
+            {
+                const auto flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+                const auto bytes = (std::ptrdiff_t)(RING_SEGMENTS * segmentCapacity * INSTANCE_BYTES);
+                gl.bufferStorage(GL_ARRAY_BUFFER, bytes, nullptr, flags);
+                renderer.mappedPtr = (float*)gl.mapBufferRange(GL_ARRAY_BUFFER, 0, bytes, flags);
+                if (renderer.mappedPtr == nullptr)
+                {
+                    releaseInstanceBuffer(renderer);
+                    return false;
+                }
+            }
+            else
+                gl.bufferData(GL_ARRAY_BUFFER, (std::ptrdiff_t)(segmentCapacity * INSTANCE_BYTES), nullptr,
+                              GL_STREAM_DRAW);
+            gl.bindBuffer(GL_ARRAY_BUFFER, 0);
+            return true;
+        }
+
+        void initializeInstancedRenderer()
+        {
+            try
+            {
+                auto& renderer = gRenderer;
+                // OpenGL version (e.g., "4.6 (Compatibility Profile) Mesa 20.0.8")
+                const auto* const versionString = (const char*)glGetString(GL_VERSION);
+                auto major = 0;
+                auto minor = 0;
+                if (versionString == nullptr || sscanf(versionString, "%d.%d", &major, &minor) != 2
+                    || major * 10 + minor < 33 || !loadGlFunctions(renderer.gl))
+                {
+                    opLog("OpenGL 3.3 is not available, the 3-D renderer falls back to the (slower) fixed-function"
+                          " pipeline.", Priority::High);
+                    return;
+                }
+                renderer.persistent = ((major * 10 + minor >= 44 || glutExtensionSupported("GL_ARB_buffer_storage"))
+                                       && loadGlPersistentFunctions(renderer.gl));
+                if (!createInstancedProgram(renderer))
+                {
+                    opLog("The 3-D renderer falls back to the (slower) fixed-function pipeline.", Priority::High);
+                    return;
+                }
+                // Static meshes
+                const auto mesh = createSphereAndConeMeshes(renderer.sphereVertices, renderer.coneVertices);
+                renderer.gl.genBuffers(1, &renderer.meshBuffer);
+                renderer.gl.bindBuffer(GL_ARRAY_BUFFER, renderer.meshBuffer);
+                renderer.gl.bufferData(GL_ARRAY_BUFFER, (std::ptrdiff_t)(mesh.size() * sizeof(float)), mesh.data(),
+                                       GL_STATIC_DRAW);
+                renderer.gl.bindBuffer(GL_ARRAY_BUFFER, 0);
+                // Instance ring (it grows if needed)
+                if (!createInstanceBuffer(renderer, 4096ull))
+                {
+                    renderer.persistent = false;
+                    createInstanceBuffer(renderer, 4096ull);
+                }
+                renderer.enabled = true;
+                opLog("3-D renderer: instanced drawing with " + std::string{renderer.persistent
+                      ? "a persistent mapped" : "an orphaned"} + " instance buffer.", Priority::Low);
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        void releaseInstancedRenderer()
+        {
+            try
+            {
+                auto& renderer = gRenderer;
+                if (renderer.enabled)
+                {
+                    releaseInstanceBuffer(renderer);
+                    renderer.gl.deleteBuffers(1, &renderer.meshBuffer);
+                    renderer.gl.deleteProgram(renderer.program);
+                    renderer.enabled = false;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        // Copy the latest instances (if new ones) into the next segment of the instance ring
+        void uploadInstances(const Instances3D& instances)
+        {
+            auto& renderer = gRenderer;
+            const auto& gl = renderer.gl;
+            const auto sphereFloats = instances.spheres.size();
+            const auto limbFloats = instances.limbs.size();
+            const auto numberInstances = (sphereFloats + limbFloats) / INSTANCE_FLOATS;
+            // Grow the ring (the GPU must be done with every segment before releasing it)
+            if (numberInstances > renderer.segmentCapacity)
+            {
+                glFinish();
+                const auto segmentCapacity = fastMax(2 * renderer.segmentCapacity, (unsigned long long)numberInstances);
+                releaseInstanceBuffer(renderer);
+                if (!createInstanceBuffer(renderer, segmentCapacity))
+                    error("The 3-D renderer instance buffer could not be allocated.", __LINE__, __FUNCTION__, __FILE__);
+            }
+            renderer.numberSpheres = (int)(sphereFloats / INSTANCE_FLOATS);
+            renderer.numberLimbs = (int)(limbFloats / INSTANCE_FLOATS);
+            if (renderer.persistent)
+            {
+                renderer.segment = (renderer.segment + 1) % RING_SEGMENTS;
+                // Wait until the GPU is done with this segment (drawn 2 frames ago, so usually no wait)
+                auto& fence = renderer.fences[renderer.segment];
+                if (fence != nullptr)
+                {
+                    if (gl.clientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull) == GL_WAIT_FAILED)
+                        glFinish();
+                    gl.deleteSync(fence);
+                    fence = nullptr;
+                }
+                auto* const segmentPtr = renderer.mappedPtr + renderer.segment * renderer.segmentCapacity
+                                       * INSTANCE_FLOATS;
+                if (sphereFloats > 0)
+                    std::memcpy(segmentPtr, instances.spheres.data(), sphereFloats * sizeof(float));
+                if (limbFloats > 0)
+                    std::memcpy(segmentPtr + sphereFloats, instances.limbs.data(), limbFloats * sizeof(float));
+            }
+            else
+            {
+                gl.bindBuffer(GL_ARRAY_BUFFER, renderer.instanceBuffer);
+                // Orphan the previous storage, so the driver does not wait for the GPU to finish reading it
+                gl.bufferData(GL_ARRAY_BUFFER, (std::ptrdiff_t)(renderer.segmentCapacity * INSTANCE_BYTES), nullptr,
+                              GL_STREAM_DRAW);
+                if (sphereFloats > 0)
+                    gl.bufferSubData(GL_ARRAY_BUFFER, 0, (std::ptrdiff_t)(sphereFloats * sizeof(float)),
+                                     instances.spheres.data());
+                if (limbFloats > 0)
+                    gl.bufferSubData(GL_ARRAY_BUFFER, (std::ptrdiff_t)(sphereFloats * sizeof(float)),
+                                     (std::ptrdiff_t)(limbFloats * sizeof(float)), instances.limbs.data());
+                gl.bindBuffer(GL_ARRAY_BUFFER, 0);
+            }
+        }
+
+        void drawInstances(const int firstVertex, const int numberVertices, const int numberInstances,
+                           const std::size_t instanceOffset, const bool limb)
+        {
+            if (numberInstances < 1)
+                return;
+            const auto& renderer = gRenderer;
+            const auto& gl = renderer.gl;
+            gl.uniform1f(renderer.limbLocation, (limb ? 1.f : 0.f));
+            gl.bindBuffer(GL_ARRAY_BUFFER, renderer.instanceBuffer);
+            const auto* const basePtr = (const char*)nullptr + instanceOffset;
+            gl.vertexAttribPointer(ATTRIBUTE_INSTANCE_A, 4, GL_FLOAT, GL_FALSE, INSTANCE_BYTES, basePtr);
+            gl.vertexAttribPointer(ATTRIBUTE_INSTANCE_B, 3, GL_FLOAT, GL_FALSE, INSTANCE_BYTES,
+                                   basePtr + 4*sizeof(float));
+            gl.vertexAttribPointer(ATTRIBUTE_INSTANCE_COLOR, 4, GL_FLOAT, GL_FALSE, INSTANCE_BYTES,
+                                   basePtr + 8*sizeof(float));
+            gl.drawArraysInstanced(GL_TRIANGLES, firstVertex, numberVertices, numberInstances);
+        }
+
+        void renderInstanced()
+        {
+            auto& renderer = gRenderer;
+            const auto& gl = renderer.gl;
+            gl.useProgram(renderer.program);
+            // Meshes
+            gl.bindBuffer(GL_ARRAY_BUFFER, renderer.meshBuffer);
+            gl.enableVertexAttribArray(ATTRIBUTE_POSITION);
+            gl.enableVertexAttribArray(ATTRIBUTE_NORMAL);
+            gl.vertexAttribPointer(ATTRIBUTE_POSITION, 3, GL_FLOAT, GL_FALSE, MESH_FLOATS * sizeof(float), nullptr);
+            gl.vertexAttribPointer(ATTRIBUTE_NORMAL, 3, GL_FLOAT, GL_FALSE, MESH_FLOATS * sizeof(float),
+                                   (const char*)nullptr + 3*sizeof(float));
+            // Instances
+            for (const auto attribute : {ATTRIBUTE_INSTANCE_A, ATTRIBUTE_INSTANCE_B, ATTRIBUTE_INSTANCE_COLOR})
+            {
+                gl.enableVertexAttribArray(attribute);
+                gl.vertexAttribDivisor(attribute, 1);
+            }
+            const auto segmentOffset = (renderer.persistent
+                ? (std::size_t)(renderer.segment * renderer.segmentCapacity * INSTANCE_BYTES) : 0u);
+            drawInstances(0, renderer.sphereVertices, renderer.numberSpheres, segmentOffset, false);
+            drawInstances(renderer.sphereVertices, renderer.coneVertices, renderer.numberLimbs,
+                          segmentOffset + renderer.numberSpheres * INSTANCE_BYTES, true);
+            // Protect this segment until the GPU has drawn it
+            if (renderer.persistent)
+            {
+                auto& fence = renderer.fences[renderer.segment];
+                if (fence != nullptr)
+                    gl.deleteSync(fence);
+                fence = gl.fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            }
+            // Restore the state for the fixed-function pipeline
+            for (const auto attribute : {ATTRIBUTE_INSTANCE_A, ATTRIBUTE_INSTANCE_B, ATTRIBUTE_INSTANCE_COLOR})
+            {
+                gl.vertexAttribDivisor(attribute, 0);
+                gl.disableVertexAttribArray(attribute);
+            }
+            gl.disableVertexAttribArray(ATTRIBUTE_POSITION);
+            gl.disableVertexAttribArray(ATTRIBUTE_NORMAL);
+            gl.bindBuffer(GL_ARRAY_BUFFER, 0);
+            gl.useProgram(0);
+        }
+
+        // Fixed-function fallback (OpenGL < 3.3)
+        void renderFixedFunction(const Instances3D& instances)
+        {
+            for (auto i = 0u ; i < instances.spheres.size() ; i += INSTANCE_FLOATS)
+            {
+                const auto* const sphere = &instances.spheres[i];
+                glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, COLOR_DIFFUSE.data());
+                glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, sphere + 8);
+                glPushMatrix();
+                glTranslatef(sphere[0], sphere[1], sphere[2]);
+                glutSolidSphere(sphere[3], 20, 20);
+                glPopMatrix();
+            }
+            for (auto i = 0u ; i < instances.limbs.size() ; i += INSTANCE_FLOATS)
+            {
+                const auto* const limb = &instances.limbs[i];
+                glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, COLOR_DIFFUSE.data());
+                glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, limb + 8);
+                drawConeByTwoPts(cv::Point3f{limb[0], limb[1], limb[2]}, cv::Point3f{limb[4], limb[5], limb[6]},
+                                 limb[3]);
+            }
         }
 
         void initGraphics()
@@ -209,13 +800,6 @@ namespace op
             glEnable(GL_COLOR_MATERIAL);
         }
 
-        // this is the actual idle function
-        void idleFunction()
-        {
-            glutPostRedisplay();
-            glutSwapBuffers();
-        }
-
         void renderFloor()
         {
             glDisable(GL_LIGHTING);
@@ -279,16 +863,31 @@ namespace op
             glTranslatef(-gMouseXPan, gMouseYPan, -gMouseZPan);
 
             // renderFloor(); // Disabled, how to know where the floor is?
-            std::unique_lock<std::mutex> lock{gKeypoints3D.mutex};
-            if (gKeypoints3D.validKeypoints)
+            // Latest keypoints (if new ones), without waiting for the producer
+            const auto newInstances = acquireInstances();
+            const auto& instances = gInstances.buffers[gInstances.front];
+            if (gRenderer.enabled)
             {
-                renderHumanBody(gKeypoints3D.poseKeypoints, getPoseBodyPartPairsRender(sPoseModel),
-                                getPoseColors(sPoseModel), 1.f);
-                renderHumanBody(gKeypoints3D.faceKeypoints, FACE_PAIRS_RENDER, FACE_COLORS_RENDER, 0.5f);
-                renderHumanBody(gKeypoints3D.leftHandKeypoints, HAND_PAIRS_RENDER, HAND_COLORS_RENDER, 0.5f);
-                renderHumanBody(gKeypoints3D.rightHandKeypoints, HAND_PAIRS_RENDER, HAND_COLORS_RENDER, 0.5f);
+                if (newInstances)
+                    uploadInstances(instances);
+                renderInstanced();
+            }
+            else
+                renderFixedFunction(instances);
+
+            // Save 3D display for the OpenCV window (before swapping, the back buffer is undefined afterwards)
+            if (gCopyGlToCvMat)
+            {
+                cv::Mat glImage(WINDOW_HEIGHT, WINDOW_WIDTH, CV_8UC3);
+                #ifdef _WIN32
+                    glReadPixels(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT, GL_BGR_EXT, GL_UNSIGNED_BYTE, glImage.data);
+                #else
+                    glReadPixels(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT, GL_BGR, GL_UNSIGNED_BYTE, glImage.data);
+                #endif
+                cv::flip(glImage, glImage, 0);
+                const std::lock_guard<std::mutex> lock{gGlImageMutex};
+                gGlImage = glImage;
             }
-            lock.unlock();
 
             glutSwapBuffers();
         }
@@ -369,7 +968,6 @@ namespace op
             {
                 UNUSED(x);
                 UNUSED(y);
-                const std::lock_guard<std::mutex> lock{gKeypoints3D.mutex};
                 sLastKeyPressed = key;
             }
             catch (const std::exception& e)
@@ -378,6 +976,11 @@ namespace op
             }
         }
 
+        void closeWindow()
+        {
+            gWindowClosed = true;
+        }
+
         void initializeVisualization()
         {
             try
@@ -389,20 +992,17 @@ namespace op
                 glutInitWindowSize(WINDOW_WIDTH, WINDOW_HEIGHT);
                 glutInitWindowPosition(200, 0);
                 // glutSetOption(GLUT_MULTISAMPLE,8);
-                // Ideally adding also GLUT_BORDERLESS | GLUT_CAPTIONLESS should fix the problem of disabling the `x`
-                // button, but it does not work (tested in Ubuntu)
-                // https://stackoverflow.com/questions/3799803/is-it-possible-to-make-a-window-withouth-a-top-in-glut
+                // Closing the window (`x` button) stops the program as Esc does, rather than exiting the process
+                glutSetOption(GLUT_ACTION_ON_WINDOW_CLOSE, GLUT_ACTION_GLUTMAINLOOP_RETURNS);
                 glutInitDisplayMode(GLUT_RGBA | GLUT_DOUBLE | GLUT_DEPTH | GLUT_MULTISAMPLE);
                 // Create and set up a window
-                glutCreateWindow(std::string{OPEN_POSE_NAME_AND_VERSION + " - 3-D Display"}.c_str());
+                gWindowId = glutCreateWindow(std::string{OPEN_POSE_NAME_AND_VERSION + " - 3-D Display"}.c_str());
                 initGraphics();
+                initializeInstancedRenderer();
                 glutDisplayFunc(renderMain);
                 glutMouseFunc(mouseButton);
                 glutMotionFunc(mouseMotion);
-                // Only required if glutMainLoop() called
-                // glutIdleFunc(idleFunction);
-                // Full screen would fix the problem of disabling `x` button
-                // glutFullScreen();
+                glutCloseFunc(closeWindow);
                 // Key presses
                 glutKeyboardFunc(keyPressed);
             }
@@ -411,6 +1011,41 @@ namespace op
                 error(e.what(), __LINE__, __FUNCTION__, __FILE__);
             }
         }
+
+        // The GLUT loop runs on its own thread, paced by the buffer swaps (monitor refresh if vertical sync) or by
+        // MAX_RENDER_FPS, so the 3-D display never blocks the WGui3D (pipeline) thread and vice versa
+        void renderThreadFunction()
+        {
+            try
+            {
+                initializeVisualization();
+                const std::chrono::nanoseconds framePeriod{1000000000ll / MAX_RENDER_FPS};
+                auto nextFrame = std::chrono::steady_clock::now();
+                while (!gRenderThreadStop && !gWindowClosed)
+                {
+                    glutPostRedisplay();
+                    glutMainLoopEvent();
+                    nextFrame += framePeriod;
+                    const auto now = std::chrono::steady_clock::now();
+                    if (nextFrame > now)
+                        std::this_thread::sleep_until(nextFrame);
+                    else
+                        nextFrame = now;
+                }
+                // The window (and its context) is already destroyed if closed by the user
+                if (!gWindowClosed)
+                {
+                    releaseInstancedRenderer();
+                    glutDestroyWindow(gWindowId);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                const std::lock_guard<std::mutex> lock{gRenderThreadErrorMutex};
+                gRenderThreadError = e.what();
+                gRenderThreadFailed = true;
+            }
+        }
     #else
         const std::string USE_3D_RENDERER_ERROR{"OpenPose CMake must be compiled with the `USE_3D_RENDERER` flag in"
             " order to use the 3-D visualization renderer. Alternatively, set 2-D rendering with `--display 2`."};
@@ -433,6 +1068,7 @@ namespace op
             #ifdef USE_3D_RENDERER
                 // Update sPoseModel
                 sPoseModel = poseModel;
+                gCopyGlToCvMat = copyGlToCvMat;
                 if (!sConstructorSet)
                     sConstructorSet = true;
                 else
@@ -454,7 +1090,9 @@ namespace op
         #ifdef USE_3D_RENDERER
             try
             {
-                glutLeaveMainLoop();
+                gRenderThreadStop = true;
+                if (gRenderThread.joinable())
+                    gRenderThread.join();
             }
             catch (const std::exception& e)
             {
@@ -470,8 +1108,10 @@ namespace op
             // Init parent class
             Gui::initializationOnThread();
             #ifdef USE_3D_RENDERER
-                // OpenGL - Initialization
-                initializeVisualization();
+                // OpenGL - Initialization (on the render thread, which owns the OpenGL context)
+                if ((mDisplayMode == DisplayMode::DisplayAll || mDisplayMode == DisplayMode::Display3D)
+                    && !gRenderThread.joinable())
+                    gRenderThread = std::thread{renderThreadFunction};
             #endif
         }
         catch (const std::exception& e)
@@ -492,21 +1132,19 @@ namespace op
                     if (!poseKeypoints3D.empty() || !faceKeypoints3D.empty()
                         || !leftHandKeypoints3D.empty() || !rightHandKeypoints3D.empty())
                     {
-                        // OpenGL Rendering
-                        // Copy new keypoints
-                        std::unique_lock<std::mutex> lock{gKeypoints3D.mutex};
-                        gKeypoints3D.poseKeypoints = poseKeypoints3D;
-                        gKeypoints3D.faceKeypoints = faceKeypoints3D;
-                        gKeypoints3D.leftHandKeypoints = leftHandKeypoints3D;
-                        gKeypoints3D.rightHandKeypoints = rightHandKeypoints3D;
-                        gKeypoints3D.validKeypoints = true;
-                        // From m to mm
-                        scaleKeypoints(gKeypoints3D.poseKeypoints, 1e3f);
-                        scaleKeypoints(gKeypoints3D.faceKeypoints, 1e3f);
-                        scaleKeypoints(gKeypoints3D.leftHandKeypoints, 1e3f);
-                        scaleKeypoints(gKeypoints3D.rightHandKeypoints, 1e3f);
-                        // Unlock mutex
-                        lock.unlock();
+                        // Spheres and limbs of all people, written into the back buffer (owned by this thread)
+                        auto& instances = gInstances.buffers[gInstances.back];
+                        instances.spheres.clear();
+                        instances.limbs.clear();
+                        addHumanBodyInstances(instances, poseKeypoints3D, getPoseBodyPartPairsRender(sPoseModel),
+                                              getPoseColors(sPoseModel), 1.f);
+                        addHumanBodyInstances(instances, faceKeypoints3D, FACE_PAIRS_RENDER, FACE_COLORS_RENDER,
+                                              0.5f);
+                        addHumanBodyInstances(instances, leftHandKeypoints3D, HAND_PAIRS_RENDER, HAND_COLORS_RENDER,
+                                              0.5f);
+                        addHumanBodyInstances(instances, rightHandKeypoints3D, HAND_PAIRS_RENDER, HAND_COLORS_RENDER,
+                                              0.5f);
+                        publishInstances();
                     }
                 }
             #else
@@ -534,19 +1172,16 @@ namespace op
             #ifdef USE_3D_RENDERER
                 if (mDisplayMode == DisplayMode::DisplayAll || mDisplayMode == DisplayMode::Display3D)
                 {
-                    // OpenGL Rendering
-                    std::unique_lock<std::mutex> lock{gKeypoints3D.mutex};
-                    // Esc pressed -> Close program
-                    if (sLastKeyPressed == 27)
+                    // Rendered on its own thread, only its errors and key presses are checked here
+                    if (gRenderThreadFailed)
+                    {
+                        const std::lock_guard<std::mutex> lock{gRenderThreadErrorMutex};
+                        error(gRenderThreadError, __LINE__, __FUNCTION__, __FILE__);
+                    }
+                    // Esc pressed or window closed -> Close program
+                    if (sLastKeyPressed == 27 || gWindowClosed)
                         if (spIsRunning != nullptr)
                             *spIsRunning = false;
-                    lock.unlock();
-                    // OpenCL - Run main loop event
-                    // It is run outside loop, or it would get visually stuck if loop to slow
-                    idleFunction();
-                    glutMainLoopEvent();
-                    // This alternative can only be called once, and it will block the thread until program exit
-                    // glutMainLoop();
                 }
             #endif
         }
@@ -566,15 +1201,11 @@ namespace op
                 if (mDisplayMode == DisplayMode::DisplayAll || mDisplayMode == DisplayMode::Display3D)
                 {
                     // Save/display 3D display in OpenCV window
+                    // Latest frame rendered by the render thread (each one is a new cv::Mat, so sharing it is safe)
                     if (mCopyGlToCvMat)
                     {
-                        cvImage = cv::Mat(WINDOW_HEIGHT, WINDOW_WIDTH, CV_8UC3);
-                        #ifdef _WIN32
-                            glReadPixels(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT, GL_BGR_EXT, GL_UNSIGNED_BYTE, cvImage.data);
-                        #else
-                            glReadPixels(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT, GL_BGR, GL_UNSIGNED_BYTE, cvImage.data);
-                        #endif
-                        cv::flip(cvImage, cvImage, 0);
+                        const std::lock_guard<std::mutex> lock{gGlImageMutex};
+                        cvImage = gGlImage;
                     }
                 }
             #endif
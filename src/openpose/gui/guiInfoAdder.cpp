@@ -1,6 +1,7 @@
 #include <openpose/gui/guiInfoAdder.hpp>
 #include <cstdio> // std::snprintf
 #include <limits> // std::numeric_limits
+#include <map>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose_private/utilities/openCvPrivate.hpp>
 
@@ -51,9 +52,93 @@ namespace op
         }
     }
 
+    // Each text drawn by GuiInfoAdder, rasterized once (with its shadow) and reused while it does not change
+    struct TextLabel
+    {
+        std::string text;
+        Point<int> position;
+        bool normalizeWidth;
+        int imageWidth;
+        bool used;
+        cv::Rect rectangle; // In frame coordinates
+        cv::Mat bgr;
+        cv::Mat mask; // 255 for the pixels drawn
+        cv::Mat bgra; // bgr with mask as alpha, for the overlay
+    };
+
+    // By (type, index), so they are drawn in the same order as by putTextOnCvMat() directly (fps, people IDs,
+    // OpenPose name, frame number and number of people)
+    typedef std::map<std::pair<int, int>, TextLabel> TextLabels;
+
+    struct GuiInfoAdder::ImplGuiInfoAdder
+    {
+        TextLabels mTextLabels;
+        // Union of the old and new rectangles of the texts changed since the last overlay update
+        std::vector<cv::Rect> mDirtyRectangles;
+        cv::Mat mOverlay; // BGRA
+    };
+
+    void setTextLabel(
+        TextLabels& textLabels, std::vector<cv::Rect>& dirtyRectangles, const std::pair<int, int>& key,
+        const std::string& text, const Point<int>& position, const bool normalizeWidth, const int imageWidth)
+    {
+        try
+        {
+            auto& textLabel = textLabels[key];
+            textLabel.used = true;
+            if (textLabel.bgr.empty() || textLabel.text != text || textLabel.position != position
+                || textLabel.normalizeWidth != normalizeWidth || textLabel.imageWidth != imageWidth)
+            {
+                if (!textLabel.bgr.empty())
+                    dirtyRectangles.emplace_back(textLabel.rectangle);
+                textLabel.text = text;
+                textLabel.position = position;
+                textLabel.normalizeWidth = normalizeWidth;
+                textLabel.imageWidth = imageWidth;
+                textLabel.rectangle = getTextOnCvMatRectangle(text, position, normalizeWidth, imageWidth);
+                textLabel.bgr = cv::Mat(textLabel.rectangle.size(), CV_8UC3, cv::Scalar{0,0,0});
+                textLabel.mask = cv::Mat(textLabel.rectangle.size(), CV_8UC1, cv::Scalar{0});
+                putTextOnCvMat(
+                    textLabel.bgr, text, {position.x - textLabel.rectangle.x, position.y - textLabel.rectangle.y},
+                    WHITE_SCALAR, normalizeWidth, imageWidth, &textLabel.mask);
+                std::vector<cv::Mat> bgraChannels;
+                cv::split(textLabel.bgr, bgraChannels);
+                bgraChannels.emplace_back(textLabel.mask);
+                cv::merge(bgraChannels, textLabel.bgra);
+                dirtyRectangles.emplace_back(textLabel.rectangle);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    // It only draws the pixels of textLabel inside clipRectangle
+    void drawTextLabel(cv::Mat& cvMat, const TextLabel& textLabel, const cv::Rect& clipRectangle)
+    {
+        try
+        {
+            const auto rectangle = textLabel.rectangle & clipRectangle & cv::Rect{0, 0, cvMat.cols, cvMat.rows};
+            if (rectangle.area() > 0)
+            {
+                const cv::Rect labelRectangle{
+                    rectangle.x - textLabel.rectangle.x, rectangle.y - textLabel.rectangle.y,
+                    rectangle.width, rectangle.height};
+                auto cvMatRoi = cvMat(rectangle);
+                const auto& labelMat = (cvMat.channels() == 4 ? textLabel.bgra : textLabel.bgr);
+                labelMat(labelRectangle).copyTo(cvMatRoi, textLabel.mask(labelRectangle));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     void addPeopleIds(
-        cv::Mat& cvOutputData, const Array<long long>& poseIds, const Array<float>& poseKeypoints,
-        const int borderMargin)
+        TextLabels& textLabels, std::vector<cv::Rect>& dirtyRectangles, const Array<long long>& poseIds,
+        const Array<float>& poseKeypoints, const int borderMargin, const int imageWidth)
     {
         try
         {
@@ -92,7 +177,8 @@ namespace op
                                 x = xB + positiveIntRound(0.25f*borderMargin);
                                 y = yB - positiveIntRound(0.5f*borderMargin);
                             }
-                            putTextOnCvMat(cvOutputData, std::to_string(poseIds[i]), {x, y}, WHITE_SCALAR, false, cvOutputData.cols);
+                            setTextLabel(textLabels, dirtyRectangles, {1, (int)i}, std::to_string(poseIds[i]),
+                                         {x, y}, false, imageWidth);
                         }
                     }
                 }
@@ -109,7 +195,8 @@ namespace op
         mGuiEnabled{guiEnabled},
         mFpsCounter{0u},
         mLastElementRenderedCounter{std::numeric_limits<int>::max()},
-        mLastId{std::numeric_limits<unsigned long long>::max()}
+        mLastId{std::numeric_limits<unsigned long long>::max()},
+        spImpl{std::make_shared<ImplGuiInfoAdder>()}
     {
     }
 
@@ -123,12 +210,87 @@ namespace op
     {
         try
         {
+            // Copy-on-write: If not rendered, outputData still shares memory with the (read-only) input frame
+            outputData.makeUnique();
             cv::Mat cvOutputData = OP_OP2CVMAT(outputData);
             // Sanity check
             if (cvOutputData.empty())
                 error("Wrong input element (empty outputData).", __LINE__, __FUNCTION__, __FILE__);
+            // Update texts (only the ones that changed are rasterized again)
+            updateTexts({cvOutputData.cols, cvOutputData.rows}, numberPeople, id, elementRenderedName, frameNumber,
+                        poseIds, poseKeypoints);
+            spImpl->mDirtyRectangles.clear();
+            // Draw them
+            const cv::Rect frameRectangle{0, 0, cvOutputData.cols, cvOutputData.rows};
+            for (const auto& textLabel : spImpl->mTextLabels)
+            {
+                if (cvOutputData.type() == CV_8UC3)
+                    drawTextLabel(cvOutputData, textLabel.second, frameRectangle);
+                else
+                    putTextOnCvMat(cvOutputData, textLabel.second.text, textLabel.second.position, WHITE_SCALAR,
+                                   textLabel.second.normalizeWidth, textLabel.second.imageWidth);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool GuiInfoAdder::updateOverlay(Matrix& overlay, const Point<int>& frameSize, const int numberPeople,
+                                     const unsigned long long id, const std::string& elementRenderedName,
+                                     const unsigned long long frameNumber, const Array<long long>& poseIds,
+                                     const Array<float>& poseKeypoints)
+    {
+        try
+        {
+            // Sanity check
+            if (frameSize.x < 1 || frameSize.y < 1)
+                error("Wrong frame size.", __LINE__, __FUNCTION__, __FILE__);
+            auto& cvOverlay = spImpl->mOverlay;
+            // New size: everything is transparent and must be drawn again
+            if (cvOverlay.cols != frameSize.x || cvOverlay.rows != frameSize.y)
+            {
+                cvOverlay = cv::Mat(frameSize.y, frameSize.x, CV_8UC4, cv::Scalar{0,0,0,0});
+                spImpl->mDirtyRectangles.assign(1, cv::Rect{0, 0, frameSize.x, frameSize.y});
+            }
+            // Update texts (only the ones that changed are rasterized again)
+            updateTexts(frameSize, numberPeople, id, elementRenderedName, frameNumber, poseIds, poseKeypoints);
+            const auto overlayChanged = !spImpl->mDirtyRectangles.empty();
+            // Redraw the changed regions (all the texts overlapping them, in order)
+            for (const auto& dirtyRectangle : spImpl->mDirtyRectangles)
+            {
+                const auto rectangle = dirtyRectangle & cv::Rect{0, 0, frameSize.x, frameSize.y};
+                if (rectangle.area() > 0)
+                {
+                    cvOverlay(rectangle).setTo(cv::Scalar{0,0,0,0});
+                    for (const auto& textLabel : spImpl->mTextLabels)
+                        drawTextLabel(cvOverlay, textLabel.second, rectangle);
+                }
+            }
+            spImpl->mDirtyRectangles.clear();
+            overlay = OP_CV2OPMAT(cvOverlay);
+            return overlayChanged;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void GuiInfoAdder::updateTexts(const Point<int>& frameSize, const int numberPeople, const unsigned long long id,
+                                   const std::string& elementRenderedName, const unsigned long long frameNumber,
+                                   const Array<long long>& poseIds, const Array<float>& poseKeypoints)
+    {
+        try
+        {
+            auto& textLabels = spImpl->mTextLabels;
+            auto& dirtyRectangles = spImpl->mDirtyRectangles;
+            for (auto& textLabel : textLabels)
+                textLabel.second.used = false;
             // Size
-            const auto borderMargin = positiveIntRound(fastMax(cvOutputData.cols, cvOutputData.rows) * 0.025);
+            const auto borderMargin = positiveIntRound(fastMax(frameSize.x, frameSize.y) * 0.025);
             // Update fps
             updateFps(mLastId, mFps, mFpsCounter, mFpsQueue, id, mNumberGpus);
             // Fps or s/gpu
@@ -136,9 +298,8 @@ namespace op
             std::snprintf(charArrayAux, 15, "%4.1f fps", mFps);
             // Recording inverse: sec/gpu
             // std::snprintf(charArrayAux, 15, "%4.2f s/gpu", (mFps != 0. ? mNumberGpus/mFps : 0.));
-            putTextOnCvMat(
-                cvOutputData, charArrayAux, {positiveIntRound(cvOutputData.cols - borderMargin), borderMargin},
-                WHITE_SCALAR, true, cvOutputData.cols);
+            setTextLabel(textLabels, dirtyRectangles, {0, 0}, charArrayAux,
+                         {positiveIntRound(frameSize.x - borderMargin), borderMargin}, true, frameSize.x);
             // Part to show
             // Allowing some buffer when changing the part to show (if >= 2 GPUs)
             // I.e. one GPU might return a previous part after the other GPU returns the new desired part, it looks
@@ -153,19 +314,29 @@ namespace op
             mLastElementRenderedCounter = fastMin(mLastElementRenderedCounter, std::numeric_limits<int>::max() - 5);
             mLastElementRenderedCounter++;
             // Add each person ID
-            addPeopleIds(cvOutputData, poseIds, poseKeypoints, borderMargin);
+            addPeopleIds(textLabels, dirtyRectangles, poseIds, poseKeypoints, borderMargin, frameSize.x);
             // OpenPose name as well as help or part to show
-            putTextOnCvMat(cvOutputData, "OpenPose - " +
-                           (!mLastElementRenderedName.empty() ?
-                                mLastElementRenderedName : (mGuiEnabled ? "'h' for help" : "")),
-                           {borderMargin, borderMargin}, WHITE_SCALAR, false, cvOutputData.cols);
+            setTextLabel(textLabels, dirtyRectangles, {2, 0}, "OpenPose - " +
+                         (!mLastElementRenderedName.empty() ?
+                             mLastElementRenderedName : (mGuiEnabled ? "'h' for help" : "")),
+                         {borderMargin, borderMargin}, false, frameSize.x);
             // Frame number
-            putTextOnCvMat(cvOutputData, "Frame: " + std::to_string(frameNumber),
-                           {borderMargin, (int)(cvOutputData.rows - borderMargin)}, WHITE_SCALAR, false, cvOutputData.cols);
+            setTextLabel(textLabels, dirtyRectangles, {3, 0}, "Frame: " + std::to_string(frameNumber),
+                         {borderMargin, (int)(frameSize.y - borderMargin)}, false, frameSize.x);
             // Number people
-            putTextOnCvMat(cvOutputData, "People: " + std::to_string(numberPeople),
-                           {(int)(cvOutputData.cols - borderMargin), (int)(cvOutputData.rows - borderMargin)},
-                           WHITE_SCALAR, true, cvOutputData.cols);
+            setTextLabel(textLabels, dirtyRectangles, {4, 0}, "People: " + std::to_string(numberPeople),
+                         {(int)(frameSize.x - borderMargin), (int)(frameSize.y - borderMargin)}, true, frameSize.x);
+            // Texts not drawn anymore (e.g., people that left)
+            for (auto textLabel = textLabels.begin() ; textLabel != textLabels.end() ; )
+            {
+                if (!textLabel->second.used)
+                {
+                    dirtyRectangles.emplace_back(textLabel->second.rectangle);
+                    textLabel = textLabels.erase(textLabel);
+                }
+                else
+                    ++textLabel;
+            }
         }
         catch (const std::exception& e)
         {
@@ -3,6 +3,7 @@
 namespace op
 {
     DEFINE_TEMPLATE_DATUM(WHandDetector);
+    DEFINE_TEMPLATE_DATUM(WHandDetectorFromBinary);
     DEFINE_TEMPLATE_DATUM(WHandDetectorFromTxt);
     DEFINE_TEMPLATE_DATUM(WHandDetectorTracking);
     DEFINE_TEMPLATE_DATUM(WHandDetectorUpdate);
@@ -3,6 +3,7 @@
 #include <openpose/utilities/check.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/keypoint.hpp>
+#include <openpose/utilities/keypointSoa.hpp>
 
 namespace op
 {
@@ -198,6 +199,8 @@ namespace op
                 const auto numberPeople = handKeypoints.at(0).getSize(0);
                 const auto thresholdRectangle = 0.25f;
                 // Update pose keypoints and hand rectangles
+                const KeypointSoa handLeftSoa{handKeypoints[0]};
+                const KeypointSoa handRightSoa{handKeypoints[1]};
                 mPoseTrack.resize(numberPeople);
                 mHandLeftPrevious.clear();
                 mHandRightPrevious.clear();
@@ -205,16 +208,16 @@ namespace op
                 {
                     const auto scoreThreshold = 0.66667f;
                     // Left hand
-                    if (getAverageScore(handKeypoints[0], person) > scoreThreshold)
+                    if (handLeftSoa.getAverageScore(person) > scoreThreshold)
                     {
-                        const auto handLeftRectangle = getKeypointsRectangle(handKeypoints[0], person, thresholdRectangle);
+                        const auto handLeftRectangle = handLeftSoa.getRectangle(person, thresholdRectangle);
                         if (handLeftRectangle.area() > 0)
                             mHandLeftPrevious.emplace_back(handLeftRectangle);
                     }
                     // Right hand
-                    if (getAverageScore(handKeypoints[1], person) > scoreThreshold)
+                    if (handRightSoa.getAverageScore(person) > scoreThreshold)
                     {
-                        const auto handRightRectangle = getKeypointsRectangle(handKeypoints[1], person, thresholdRectangle);
+                        const auto handRightRectangle = handRightSoa.getRectangle(person, thresholdRectangle);
                         if (handRightRectangle.area() > 0)
                             mHandRightPrevious.emplace_back(handRightRectangle);
                     }
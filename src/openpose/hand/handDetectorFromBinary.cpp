@@ -0,0 +1,184 @@
+#include <openpose/hand/handDetectorFromBinary.hpp>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <openpose/filestream/keypointBinaryReader.hpp>
+#include <openpose/hand/handDetector.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/keypoint.hpp>
+
+namespace op
+{
+    // Hand rectangles if the file only contains the hand keypoints: The square around them, 1.5 times its side
+    const auto HAND_KEYPOINTS_THRESHOLD = 0.05f;
+    const auto HAND_KEYPOINTS_RECTANGLE_SCALE = 1.5f;
+
+    struct HandDetectorFromBinary::ImplHandDetectorFromBinary
+    {
+        const KeypointBinaryReader mKeypointBinaryReader;
+        const HandDetector mHandDetector;
+        const unsigned long long mPrefetchFrames;
+        std::mutex mMutex;
+        std::condition_variable mConditionVariable;
+        // Frames computed ahead (the first one is mNextFrame)
+        std::deque<std::vector<std::array<Rectangle<float>, 2>>> mPrefetched;
+        unsigned long long mNextFrame;
+        bool mStop;
+        std::string mErrorMessage;
+        std::thread mThread;
+
+        ImplHandDetectorFromBinary(const std::string& filePath, const PoseModel poseModel,
+                                   const unsigned long long prefetchFrames) :
+            mKeypointBinaryReader{filePath},
+            mHandDetector{poseModel},
+            mPrefetchFrames{prefetchFrames},
+            mNextFrame{0ull},
+            mStop{false}
+        {
+        }
+
+        std::vector<std::array<Rectangle<float>, 2>> computeFrame(const unsigned long long frameIndex) const
+        {
+            Datum datum;
+            mKeypointBinaryReader.readFrame(datum, frameIndex);
+            // Body keypoints: Same rectangles than HandDetector
+            if (!datum.poseKeypoints.empty())
+                return mHandDetector.detectHands(datum.poseKeypoints);
+            // Hand keypoints only
+            const auto numberPeople = fastMax(
+                datum.handKeypoints[0].getSize(0), datum.handKeypoints[1].getSize(0));
+            std::vector<std::array<Rectangle<float>, 2>> handRectangles(numberPeople);
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                for (auto hand = 0 ; hand < 2 ; hand++)
+                {
+                    const auto& handKeypoints = datum.handKeypoints[hand];
+                    if (person < handKeypoints.getSize(0))
+                    {
+                        const auto rectangle = getKeypointsRectangle(
+                            handKeypoints, person, HAND_KEYPOINTS_THRESHOLD);
+                        if (rectangle.area() > 0)
+                        {
+                            const auto side = HAND_KEYPOINTS_RECTANGLE_SCALE
+                                            * fastMax(rectangle.width, rectangle.height);
+                            handRectangles[person][hand] = recenter(rectangle, side, side);
+                        }
+                    }
+                }
+            }
+            return handRectangles;
+        }
+
+        void threadFunction()
+        {
+            try
+            {
+                const auto numberFrames = mKeypointBinaryReader.getNumberFrames();
+                auto frameIndex = 0ull;
+                while (frameIndex < numberFrames)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock{mMutex};
+                        mConditionVariable.wait(lock, [this]{ return mStop || mPrefetched.size() < mPrefetchFrames; });
+                        if (mStop)
+                            return;
+                    }
+                    auto handRectangles = computeFrame(frameIndex++);
+                    {
+                        const std::lock_guard<std::mutex> lock{mMutex};
+                        mPrefetched.emplace_back(std::move(handRectangles));
+                    }
+                    mConditionVariable.notify_all();
+                }
+            }
+            catch (const std::exception& e)
+            {
+                {
+                    const std::lock_guard<std::mutex> lock{mMutex};
+                    mErrorMessage = e.what();
+                }
+                mConditionVariable.notify_all();
+            }
+        }
+    };
+
+    HandDetectorFromBinary::HandDetectorFromBinary(
+        const std::string& filePath, const PoseModel poseModel, const int prefetchFrames) :
+        upImpl{new ImplHandDetectorFromBinary{filePath, poseModel, (unsigned long long)fastMax(0, prefetchFrames)}}
+    {
+        try
+        {
+            if (upImpl->mKeypointBinaryReader.getNumberFrames() == 0ull)
+                error("No frames were found on " + filePath, __LINE__, __FUNCTION__, __FILE__);
+            if (upImpl->mPrefetchFrames > 0ull)
+                upImpl->mThread = std::thread{&ImplHandDetectorFromBinary::threadFunction, upImpl.get()};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    HandDetectorFromBinary::~HandDetectorFromBinary()
+    {
+        try
+        {
+            {
+                const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+                upImpl->mStop = true;
+            }
+            upImpl->mConditionVariable.notify_all();
+            if (upImpl->mThread.joinable())
+                upImpl->mThread.join();
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned long long HandDetectorFromBinary::getNumberFrames() const
+    {
+        try
+        {
+            return upImpl->mKeypointBinaryReader.getNumberFrames();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    std::vector<std::array<Rectangle<float>, 2>> HandDetectorFromBinary::detectHands()
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{upImpl->mMutex};
+            const auto frameIndex = upImpl->mNextFrame++;
+            if (frameIndex >= upImpl->mKeypointBinaryReader.getNumberFrames())
+                error("Frame " + std::to_string(frameIndex) + " out of bounds (the file contains "
+                      + std::to_string(upImpl->mKeypointBinaryReader.getNumberFrames()) + " frames).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // No prefetching
+            if (upImpl->mPrefetchFrames == 0ull)
+                return upImpl->computeFrame(frameIndex);
+            // Prefetched frame (frames are popped in order, so the front one is frameIndex)
+            upImpl->mConditionVariable.wait(
+                lock, [this]{ return !upImpl->mPrefetched.empty() || !upImpl->mErrorMessage.empty(); });
+            if (upImpl->mPrefetched.empty())
+                error(upImpl->mErrorMessage, __LINE__, __FUNCTION__, __FILE__);
+            auto handRectangles = std::move(upImpl->mPrefetched.front());
+            upImpl->mPrefetched.pop_front();
+            lock.unlock();
+            upImpl->mConditionVariable.notify_all();
+            return handRectangles;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::vector<std::array<Rectangle<float>, 2>>{};
+        }
+    }
+}
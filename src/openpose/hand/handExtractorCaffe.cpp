@@ -2,23 +2,38 @@
 #ifdef USE_CAFFE
     #include <caffe/blob.hpp>
 #endif
+#include <algorithm> // std::any_of, std::stable_sort
+#include <openpose/core/keypointRoiCache.hpp>
 #include <openpose/gpu/cuda.hpp>
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+    #include <openpose/gpu/cudaMemoryPool.hpp>
+#endif
 #include <openpose/hand/handParameters.hpp>
 #include <openpose/net/maximumCaffe.hpp>
 #include <openpose/net/netCaffe.hpp>
+#include <openpose/net/resizeAndMergeBase.hpp>
 #include <openpose/net/resizeAndMergeCaffe.hpp>
+#include <openpose/utilities/allocationTracker.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/keypoint.hpp>
 #include <openpose/utilities/openCv.hpp>
 #include <openpose_private/utilities/openCvMultiversionHeaders.hpp>
+#include <openpose_private/utilities/parallelFor.hpp>
 
 namespace op
 {
     struct HandExtractorCaffe::ImplHandExtractorCaffe
     {
         #ifdef USE_CAFFE
-            bool mNetInitialized;
+            int mReshapedBatchSize;
+            int mReshapedCropSide;
             const int mGpuId;
+            const bool mAdaptiveCropSize;
+            // Network parameters (to create it again after netReleaseOnThread())
+            const std::string mModelFolder;
+            const bool mEnableGoogleLogging;
+            const std::shared_ptr<NetMemoryArena> spNetMemoryArena;
             std::shared_ptr<NetCaffe> spNetCaffe;
             std::shared_ptr<ResizeAndMergeCaffe<float>> spResizeAndMergeCaffe;
             std::shared_ptr<MaximumCaffe<float>> spMaximumCaffe;
@@ -26,24 +41,51 @@ namespace op
             std::shared_ptr<ArrayCpuGpu<float>> spCaffeNetOutputBlob;
             std::shared_ptr<ArrayCpuGpu<float>> spHeatMapsBlob;
             std::shared_ptr<ArrayCpuGpu<float>> spPeaksBlob;
+            #ifdef USE_CUDA
+                // Input frame in GPU memory (the hand crops are warped from it)
+                unsigned char* pFrameGpuPtr;
+                unsigned long long mFrameGpuBytes;
+            #endif
 
             ImplHandExtractorCaffe(const std::string& modelFolder, const int gpuId,
-                                   const bool enableGoogleLogging) :
-                mNetInitialized{false},
+                                   const bool enableGoogleLogging, const bool adaptiveCropSize,
+                                   const std::shared_ptr<NetMemoryArena>& netMemoryArena) :
+                mReshapedBatchSize{0},
+                mReshapedCropSide{0},
                 mGpuId{gpuId},
-                spNetCaffe{std::make_shared<NetCaffe>(modelFolder + HAND_PROTOTXT, modelFolder + HAND_TRAINED_MODEL,
-                                                      gpuId, enableGoogleLogging)},
+                mAdaptiveCropSize{adaptiveCropSize},
+                mModelFolder{modelFolder},
+                mEnableGoogleLogging{enableGoogleLogging},
+                spNetMemoryArena{netMemoryArena},
+                spNetCaffe{createNetCaffe()},
                 spResizeAndMergeCaffe{std::make_shared<ResizeAndMergeCaffe<float>>()},
                 spMaximumCaffe{std::make_shared<MaximumCaffe<float>>()}
+                #ifdef USE_CUDA
+                    , pFrameGpuPtr{nullptr},
+                    mFrameGpuBytes{0ull}
+                #endif
+            {
+            }
+
+            ~ImplHandExtractorCaffe()
+            {
+                #ifdef USE_CUDA
+                    cudaPoolFree(pFrameGpuPtr);
+                #endif
+            }
+
+            std::shared_ptr<NetCaffe> createNetCaffe() const
             {
+                return std::make_shared<NetCaffe>(
+                    mModelFolder + HAND_PROTOTXT, mModelFolder + HAND_TRAINED_MODEL, mGpuId, mEnableGoogleLogging,
+                    "net_output", spNetMemoryArena);
             }
         #endif
     };
 
     #ifdef USE_CAFFE
-        void cropFrame(Array<float>& handImageCrop, cv::Mat& affineMatrix, const cv::Mat& cvInputData,
-                       const Rectangle<float>& handRectangle, const int netInputSide,
-                       const Point<int>& netOutputSize, const bool mirrorImage)
+        void getHandAffineMatrix(cv::Mat& affineMatrix, const Rectangle<float>& handRectangle,
+                                 const int netInputSide, const bool mirrorImage)
         {
             try
             {
@@ -60,12 +102,24 @@ namespace op
                 else
                     affineMatrix.at<double>(0,2) = handRectangle.x;
                 affineMatrix.at<double>(1,2) = handRectangle.y;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        void cropFrame(float* handImageCropPtr, const cv::Mat& affineMatrix, const cv::Mat& cvInputData,
+                       const Point<int>& netOutputSize)
+        {
+            try
+            {
                 cv::Mat handImage;
                 cv::warpAffine(cvInputData, handImage, affineMatrix, cv::Size{netOutputSize.x, netOutputSize.y},
                                CV_INTER_LINEAR | CV_WARP_INVERSE_MAP, cv::BORDER_CONSTANT, cv::Scalar{0,0,0});
                                // CV_INTER_CUBIC | CV_WARP_INVERSE_MAP, cv::BORDER_CONSTANT, cv::Scalar{0,0,0});
                 // cv::Mat -> float*
-                uCharCvMatToFloatPtr(handImageCrop.getPtr(), OP_CV2OPMAT(handImage), true);
+                uCharCvMatToFloatPtr(handImageCropPtr, OP_CV2OPMAT(handImage), true);
             }
             catch (const std::exception& e)
             {
@@ -136,6 +190,7 @@ namespace op
                 // Copy hand parts
                 #ifdef USE_CUDA
                     cudaMemcpy(heatMapsPtr, heatMapsGpuPtr, volumeBodyParts * sizeof(float), cudaMemcpyDeviceToHost);
+                    AllocationTracker::recordCopy(volumeBodyParts * sizeof(float), MemoryCopy::DeviceToHost);
                 #else
                     //std::memcpy(heatMapsPtr, heatMapsGpuPtr, volumeBodyParts * sizeof(float));
                     std::copy(heatMapsGpuPtr, heatMapsGpuPtr + volumeBodyParts, heatMapsPtr);
@@ -170,8 +225,8 @@ namespace op
         {
             try
             {
-                // HeatMaps extractor blob and layer
-                const bool mergeFirstDimension = true;
+                // HeatMaps extractor blob and layer (each crop of the batch is resized independently)
+                const bool mergeFirstDimension = false;
                 resizeAndMergeCaffe->Reshape(
                     std::vector<ArrayCpuGpu<float>*>{caffeNetOutputBlob.get()},
                     std::vector<ArrayCpuGpu<float>*>{heatMapsBlob.get()},
@@ -190,43 +245,39 @@ namespace op
         }
 
         void detectHandKeypoints(
-            Array<float>& handCurrent, std::shared_ptr<NetCaffe>& netCaffe, std::shared_ptr<ResizeAndMergeCaffe<float>>& resizeAndMergeCaffe,
+            std::shared_ptr<NetCaffe>& netCaffe, std::shared_ptr<ResizeAndMergeCaffe<float>>& resizeAndMergeCaffe,
             std::shared_ptr<MaximumCaffe<float>>& maximumCaffe, std::shared_ptr<ArrayCpuGpu<float>>& caffeNetOutputBlob,
-            std::shared_ptr<ArrayCpuGpu<float>>& heatMapsBlob, std::shared_ptr<ArrayCpuGpu<float>>& peaksBlob, bool& netInitialized,
-            Array<float>& handImageCrop, const int person, const cv::Mat& affineMatrix, const int gpuId)
+            std::shared_ptr<ArrayCpuGpu<float>>& heatMapsBlob, std::shared_ptr<ArrayCpuGpu<float>>& peaksBlob,
+            int& reshapedBatchSize, int& reshapedCropSide, const Array<float>* const handImageCrop,
+            const int batchSize, const int cropSide, const int gpuId)
         {
             try
             {
-                #ifdef USE_CAFFE
-                    // 1. Deep net
-                    netCaffe->forwardPass(handImageCrop);
-
-                    // Reshape blobs
-                    if (!netInitialized)
-                    {
-                        netInitialized = true;
-                        reshapeHandExtractorCaffe(
-                            resizeAndMergeCaffe, maximumCaffe, caffeNetOutputBlob, heatMapsBlob, peaksBlob, gpuId);
-                    }
+                // 1. Deep net (all the crops of the batch at once), from the CPU crops or from the ones already
+                // written into the GPU network input
+                if (handImageCrop != nullptr)
+                    netCaffe->forwardPass(*handImageCrop);
+                else
+                    netCaffe->forwardPassOnGpuInput();
 
-                    // 2. Resize heat maps + merge different scales
-                    resizeAndMergeCaffe->Forward({caffeNetOutputBlob.get()}, {heatMapsBlob.get()});
+                // Reshape blobs (whenever the batch size or the crop side changes)
+                if (reshapedBatchSize != batchSize || reshapedCropSide != cropSide)
+                {
+                    reshapedBatchSize = batchSize;
+                    reshapedCropSide = cropSide;
+                    reshapeHandExtractorCaffe(
+                        resizeAndMergeCaffe, maximumCaffe, caffeNetOutputBlob, heatMapsBlob, peaksBlob, gpuId);
+                }
 
-                    // 3. Get peaks by Non-Maximum Suppression
-                    maximumCaffe->Forward({heatMapsBlob.get()}, {peaksBlob.get()});
+                // 2. Resize heat maps (each crop independently)
+                resizeAndMergeCaffe->Forward({caffeNetOutputBlob.get()}, {heatMapsBlob.get()});
 
-                    // Estimate keypoint locations
-                    connectKeypoints(
-                        handCurrent, person, affineMatrix, peaksBlob->mutable_cpu_data());
+                // 3. Get peaks by Non-Maximum Suppression
+                maximumCaffe->Forward({heatMapsBlob.get()}, {peaksBlob.get()});
 
-                    // 5. CUDA sanity check
-                    #ifdef USE_CUDA
-                        cudaCheck(__LINE__, __FUNCTION__, __FILE__);
-                    #endif
-                #else
-                    UNUSED(handCurrent);
-                    UNUSED(person);
-                    UNUSED(affineMatrix);
+                // 5. CUDA sanity check
+                #ifdef USE_CUDA
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
                 #endif
             }
             catch (const std::exception& e)
@@ -241,10 +292,12 @@ namespace op
                                            const int numberScales,
                                            const float rangeScales, const std::vector<HeatMapType>& heatMapTypes,
                                            const ScaleMode heatMapScaleMode,
-                                           const bool enableGoogleLogging) :
+                                           const bool enableGoogleLogging, const bool adaptiveCropSize,
+                                           const std::shared_ptr<NetMemoryArena>& netMemoryArena) :
         HandExtractorNet{netInputSize, netOutputSize, numberScales, rangeScales, heatMapTypes, heatMapScaleMode}
         #ifdef USE_CAFFE
-        , upImpl{new ImplHandExtractorCaffe{modelFolder, gpuId, enableGoogleLogging}}
+        , upImpl{new ImplHandExtractorCaffe{modelFolder, gpuId, enableGoogleLogging,
+                                            adaptiveCropSize && heatMapTypes.empty(), netMemoryArena}}
         #endif
     {
         try
@@ -259,6 +312,8 @@ namespace op
                 UNUSED(heatMapTypes);
                 UNUSED(heatMapScaleMode);
                 UNUSED(enableGoogleLogging);
+                UNUSED(adaptiveCropSize);
+                UNUSED(netMemoryArena);
                 error("OpenPose must be compiled with the `USE_CAFFE` & `USE_CUDA` macro definitions in order to run"
                       " this functionality.", __LINE__, __FUNCTION__, __FILE__);
             #endif
@@ -302,13 +357,46 @@ namespace op
         }
     }
 
+    void HandExtractorCaffe::netReleaseOnThread()
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                // Blobs and layers (a new network, not loaded until netInitializationOnThread())
+                upImpl->spCaffeNetOutputBlob.reset();
+                upImpl->spHeatMapsBlob.reset();
+                upImpl->spPeaksBlob.reset();
+                upImpl->spResizeAndMergeCaffe = std::make_shared<ResizeAndMergeCaffe<float>>();
+                upImpl->spMaximumCaffe = std::make_shared<MaximumCaffe<float>>();
+                upImpl->spNetCaffe = upImpl->createNetCaffe();
+                upImpl->mReshapedBatchSize = 0;
+                upImpl->mReshapedCropSide = 0;
+                #ifdef USE_CUDA
+                    cudaPoolFree(upImpl->pFrameGpuPtr);
+                    upImpl->pFrameGpuPtr = nullptr;
+                    upImpl->mFrameGpuBytes = 0ull;
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                #endif
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     void HandExtractorCaffe::forwardPass(
         const std::vector<std::array<Rectangle<float>, 2>> handRectangles, const Matrix& inputData)
     {
         try
         {
             #ifdef USE_CAFFE
-                if (mEnabled && !handRectangles.empty())
+                // Lazy loading: The network is only needed if any hand was found
+                const auto netNeeded = std::any_of(
+                    handRectangles.begin(), handRectangles.end(),
+                    [](const std::array<Rectangle<float>, 2>& handRectangle)
+                    { return handRectangle[0].area() > 0 || handRectangle[1].area() > 0; });
+                if (isNetReady(netNeeded) && !handRectangles.empty())
                 {
                     const cv::Mat cvInputData = OP_OP2CVCONSTMAT(inputData);
 
@@ -327,18 +415,29 @@ namespace op
                     // HeatMaps: define size
                     if (!mHeatMapTypes.empty())
                     {
-                        mHeatMaps[0].reset({numberPeople, (int)HAND_NUMBER_PARTS, mNetOutputSize.y, mNetOutputSize.x});
-                        mHeatMaps[1].reset({numberPeople, (int)HAND_NUMBER_PARTS, mNetOutputSize.y, mNetOutputSize.x});
+                        mHeatMaps[0].resetPinned(
+                            {numberPeople, (int)HAND_NUMBER_PARTS, mNetOutputSize.y, mNetOutputSize.x});
+                        mHeatMaps[1].resetPinned(mHeatMaps[0].getSize());
                     }
 
                     // // Debugging
                     // cv::Mat cvInputDataCopied = cvInputData.clone();
-                    // Extract hand keypoints for each person
+                    // Hand crops of both hands, all people and all scales
+                    struct HandCrop
+                    {
+                        int hand;
+                        int person;
+                        int scaleIndex;
+                        int cropSide;
+                        Rectangle<float> rectangle;
+                        cv::Mat affineMatrix;
+                    };
+                    std::vector<HandCrop> handCrops;
+                    const auto numberScales = mMultiScaleNumberAndRange.first;
+                    const auto initScale = 1.f - mMultiScaleNumberAndRange.second / 2.f;
+                    handCrops.reserve(2 * numberPeople * numberScales);
                     for (auto hand = 0 ; hand < 2 ; hand++)
                     {
-                        // Parameters
-                        auto& handCurrent = mHandKeypoints[hand];
-                        const bool mirrorImage = (hand == 0);
                         for (auto person = 0 ; person < numberPeople ; person++)
                         {
                             const auto& handRectangle = handRectangles.at(person).at(hand);
@@ -362,85 +461,145 @@ namespace op
                             if (minHandSize > 1 && handRectangle.area() > 10)
                             {
                                 // Single-scale detection
-                                if (mMultiScaleNumberAndRange.first == 1)
-                                {
-                                    // // Debugging -> green rectangle overwriting red one
-                                    // if (handRectangle.width > 0)
-                                    //     cv::rectangle(
-                                    //         cvInputDataCopied,
-                                    //         cv::Point{positiveIntRound(handRectangle.x),
-                                    //                   positiveIntRound(handRectangle.y)},
-                                    //         cv::Point{positiveIntRound(handRectangle.x + handRectangle.width),
-                                    //                   positiveIntRound(handRectangle.y + handRectangle.height)},
-                                    //         cv::Scalar{(hand * 255.f),255.f,0.f}, 2);
-                                    // Parameters
-                                    cv::Mat affineMatrix;
-                                    // Resize image to hands positions + cv::Mat -> float*
-                                    cropFrame(mHandImageCrop, affineMatrix, cvInputData, handRectangle, netInputSide,
-                                              mNetOutputSize, mirrorImage);
-                                    // Deep net + Estimate keypoint locations
-                                    detectHandKeypoints(
-                                        handCurrent, upImpl->spNetCaffe, upImpl->spResizeAndMergeCaffe,
-                                        upImpl->spMaximumCaffe, upImpl->spCaffeNetOutputBlob,
-                                        upImpl->spHeatMapsBlob, upImpl->spPeaksBlob, upImpl->mNetInitialized,
-                                        mHandImageCrop, person, affineMatrix, upImpl->mGpuId);
-                                }
+                                if (numberScales == 1)
+                                    handCrops.emplace_back(
+                                        HandCrop{hand, person, 0, netInputSide, handRectangle, cv::Mat{}});
                                 // Multi-scale detection
                                 else
                                 {
-                                    const auto handPtrArea = handCurrent.getSize(1) * handCurrent.getSize(2);
-                                    auto* handCurrentPtr = handCurrent.getPtr() + person * handPtrArea;
-                                    const auto numberScales = mMultiScaleNumberAndRange.first;
-                                    const auto initScale = 1.f - mMultiScaleNumberAndRange.second / 2.f;
                                     for (auto i = 0 ; i < numberScales ; i++)
                                     {
                                         // Get current scale
                                         const auto scale = initScale
                                                          + mMultiScaleNumberAndRange.second * i / (numberScales-1.f);
-                                        // Process hand
-                                        Array<float> handEstimated(
-                                            {1, handCurrent.getSize(1), handCurrent.getSize(2)}, 0.f);
                                         const auto handRectangleScale = recenter(
                                             handRectangle,
                                             (float)(positiveIntRound(handRectangle.width * scale) / 2 * 2),
                                             (float)(positiveIntRound(handRectangle.height * scale) / 2 * 2)
                                         );
-                                        // // Debugging -> blue rectangle
-                                        // cv::rectangle(cvInputDataCopied,
-                                        //               cv::Point{positiveIntRound(handRectangleScale.x),
-                                        //                         positiveIntRound(handRectangleScale.y)},
-                                        //               cv::Point{positiveIntRound(handRectangleScale.x
-                                        //                                  + handRectangleScale.width),
-                                        //                         positiveIntRound(handRectangleScale.y
-                                        //                                  + handRectangleScale.height)},
-                                        //               cv::Scalar{255,0,0}, 2);
-                                        // Parameters
-                                        cv::Mat affineMatrix;
-                                        // Resize image to hands positions + cv::Mat -> float*
-                                        cropFrame(mHandImageCrop, affineMatrix, cvInputData, handRectangleScale,
-                                                  netInputSide, mNetOutputSize, mirrorImage);
-                                        // Deep net + Estimate keypoint locations
-                                        detectHandKeypoints(
-                                            handEstimated, upImpl->spNetCaffe, upImpl->spResizeAndMergeCaffe,
-                                            upImpl->spMaximumCaffe, upImpl->spCaffeNetOutputBlob,
-                                            upImpl->spHeatMapsBlob, upImpl->spPeaksBlob, upImpl->mNetInitialized,
-                                            mHandImageCrop, 0, affineMatrix, upImpl->mGpuId);
-                                        if (i == 0
-                                            || getAverageScore(handEstimated,0) > getAverageScore(handCurrent,person))
-                                            std::copy(handEstimated.getConstPtr(),
-                                                      handEstimated.getConstPtr() + handPtrArea, handCurrentPtr);
+                                        handCrops.emplace_back(
+                                            HandCrop{hand, person, i, netInputSide, handRectangleScale, cv::Mat{}});
                                     }
                                 }
-                                // HeatMaps: storing
-                                if (!mHeatMapTypes.empty()){
-                                    #ifdef USE_CUDA
-                                        updateHandHeatMapsForPerson(mHeatMaps[hand], person, mHeatMapScaleMode,
-                                                                    upImpl->spHeatMapsBlob->gpu_data());
-                                    #else
-                                        updateHandHeatMapsForPerson(mHeatMaps[hand], person, mHeatMapScaleMode,
-                                                                    upImpl->spHeatMapsBlob->cpu_data());
-                                    #endif
+                            }
+                        }
+                    }
+
+                    // Crop transformations (left hands are mirrored)
+                    for (auto& handCrop : handCrops)
+                    {
+                        if (upImpl->mAdaptiveCropSize)
+                            handCrop.cropSide = getRoiCropSide(handCrop.rectangle.width, netInputSide);
+                        getHandAffineMatrix(
+                            handCrop.affineMatrix, handCrop.rectangle, handCrop.cropSide, handCrop.hand == 0);
+                    }
+                    // Adaptive crop size: Sorted by crop side, so each batch has a single one
+                    if (upImpl->mAdaptiveCropSize)
+                        std::stable_sort(handCrops.begin(), handCrops.end(),
+                                         [](const HandCrop& a, const HandCrop& b) { return a.cropSide < b.cropSide; });
+
+                    // Extract hand keypoints, HAND_MAX_BATCH_SIZE crops per network forward pass
+                    const auto numberCrops = (int)handCrops.size();
+                    // CUDA: The frame is uploaded once, and all the crops are warped from it on the GPU
+                    #ifdef USE_CUDA
+                        const auto useGpuCrops = (numberCrops > 0 && cvInputData.type() == CV_8UC3);
+                        if (useGpuCrops)
+                        {
+                            const auto frameBytes = 3ull * cvInputData.cols * cvInputData.rows;
+                            if (upImpl->mFrameGpuBytes < frameBytes)
+                            {
+                                cudaPoolFree(upImpl->pFrameGpuPtr);
+                                upImpl->pFrameGpuPtr = (unsigned char*)cudaPoolMalloc(frameBytes);
+                                upImpl->mFrameGpuBytes = frameBytes;
+                            }
+                            cudaMemcpy2D(upImpl->pFrameGpuPtr, 3 * cvInputData.cols, cvInputData.data,
+                                         cvInputData.step, 3 * cvInputData.cols, cvInputData.rows,
+                                         cudaMemcpyHostToDevice);
+                            AllocationTracker::recordCopy(frameBytes, MemoryCopy::HostToDevice);
+                        }
+                    #else
+                        const auto useGpuCrops = false;
+                    #endif
+                    Array<float> handEstimated({1, (int)HAND_NUMBER_PARTS, 3}, 0.f);
+                    // Whether each hand already has the keypoints of one of its scales
+                    std::vector<char> handEstimatedOnce(2 * numberPeople, 0);
+                    auto batchSize = 0;
+                    for (auto batchBegin = 0 ; batchBegin < numberCrops ; batchBegin += batchSize)
+                    {
+                        const auto cropSide = handCrops[batchBegin].cropSide;
+                        batchSize = 1;
+                        while (batchSize < HAND_MAX_BATCH_SIZE && batchBegin + batchSize < numberCrops
+                               && handCrops[batchBegin + batchSize].cropSide == cropSide)
+                            batchSize++;
+                        // Crops + deep net + heat maps + peaks
+                        // GPU: Warped from the uploaded frame straight into the network input
+                        if (useGpuCrops)
+                        {
+                            #ifdef USE_CUDA
+                                std::vector<std::array<float, 6>> affineMatrices(batchSize);
+                                for (auto crop = 0 ; crop < batchSize ; crop++)
+                                {
+                                    const auto& affineMatrix = handCrops[batchBegin+crop].affineMatrix;
+                                    for (auto i = 0 ; i < 6 ; i++)
+                                        affineMatrices[crop][i] = float(affineMatrix.at<double>(i/3, i%3));
                                 }
+                                auto* netInputGpuPtr = upImpl->spNetCaffe->getInputGpuPtr(
+                                    {batchSize, 3, cropSide, cropSide});
+                                warpAffineCropsGpu(
+                                    netInputGpuPtr, upImpl->pFrameGpuPtr, cvInputData.cols, cvInputData.rows,
+                                    affineMatrices, cropSide, cropSide, 1);
+                            #endif
+                        }
+                        // CPU: Resize image to hands positions + cv::Mat -> float* (each crop in its own element)
+                        else
+                        {
+                            if (mHandImageCrop.getSize(0) != batchSize || mHandImageCrop.getSize(2) != cropSide)
+                                mHandImageCrop.reset({batchSize, 3, cropSide, cropSide});
+                            const auto cropVolume = mHandImageCrop.getVolume(1, 3);
+                            parallelFor(0, batchSize, [&](const int crop)
+                            {
+                                cropFrame(mHandImageCrop.getPtr() + crop*cropVolume,
+                                          handCrops[batchBegin+crop].affineMatrix, cvInputData,
+                                          Point<int>{cropSide, cropSide});
+                            });
+                        }
+                        detectHandKeypoints(
+                            upImpl->spNetCaffe, upImpl->spResizeAndMergeCaffe, upImpl->spMaximumCaffe,
+                            upImpl->spCaffeNetOutputBlob, upImpl->spHeatMapsBlob, upImpl->spPeaksBlob,
+                            upImpl->mReshapedBatchSize, upImpl->mReshapedCropSide,
+                            (useGpuCrops ? nullptr : &mHandImageCrop), batchSize, cropSide, upImpl->mGpuId);
+                        // Estimate keypoint locations (the scales of each hand are compared sequentially)
+                        const auto* handPeaksPtr = upImpl->spPeaksBlob->mutable_cpu_data();
+                        const auto peaksVolume = upImpl->spPeaksBlob->count(1);
+                        const auto heatMapsVolume = upImpl->spHeatMapsBlob->count(1);
+                        for (auto crop = 0 ; crop < batchSize ; crop++)
+                        {
+                            const auto& handCrop = handCrops[batchBegin+crop];
+                            auto& handCurrent = mHandKeypoints[handCrop.hand];
+                            connectKeypoints(
+                                handEstimated, 0, handCrop.affineMatrix, handPeaksPtr + crop*peaksVolume);
+                            // The scale with the highest average score is kept
+                            auto& estimatedOnce = handEstimatedOnce[handCrop.hand * numberPeople + handCrop.person];
+                            if (!estimatedOnce
+                                || getAverageScore(handEstimated,0) > getAverageScore(handCurrent,handCrop.person))
+                            {
+                                estimatedOnce = 1;
+                                const auto handPtrArea = handCurrent.getSize(1) * handCurrent.getSize(2);
+                                std::copy(handEstimated.getConstPtr(), handEstimated.getConstPtr() + handPtrArea,
+                                          handCurrent.getPtr() + handCrop.person * handPtrArea);
+                            }
+                            // HeatMaps: storing (the ones of the last scale)
+                            if (!mHeatMapTypes.empty() && handCrop.scaleIndex == numberScales-1)
+                            {
+                                #ifdef USE_CUDA
+                                    updateHandHeatMapsForPerson(
+                                        mHeatMaps[handCrop.hand], handCrop.person, mHeatMapScaleMode,
+                                        upImpl->spHeatMapsBlob->gpu_data() + crop*heatMapsVolume);
+                                #else
+                                    updateHandHeatMapsForPerson(
+                                        mHeatMaps[handCrop.hand], handCrop.person, mHeatMapScaleMode,
+                                        upImpl->spHeatMapsBlob->cpu_data() + crop*heatMapsVolume);
+                                #endif
                             }
                         }
                     }
@@ -454,7 +613,7 @@ namespace op
                 }
             #else
                 UNUSED(handRectangles);
-                UNUSED(cvInputData);
+                UNUSED(inputData);
             #endif
         }
         catch (const std::exception& e)
@@ -462,4 +621,25 @@ namespace op
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
         }
     }
+
+    GpuMemoryFootprint HandExtractorCaffe::getGpuMemoryFootprint(
+        const Point<int>& netInputSize, const std::string& modelFolder, const Point<int>& inputSize)
+    {
+        try
+        {
+            // Network blobs per network input pixel (approximated from the channels and strides of its layers),
+            // network input (3 float channels) and heat maps
+            const auto bytesPerPixel = 1400ull + 4ull * (3ull + HAND_NUMBER_PARTS + 1ull);
+            const auto netBytes = HAND_MAX_BATCH_SIZE * bytesPerPixel * (unsigned long long)netInputSize.area();
+            // Weights (as they are in the caffemodel), cuDNN workspaces and input frame (BGR)
+            const auto weightBytes = getModelFileBytes(modelFolder + HAND_TRAINED_MODEL, 150ull << 20);
+            return GpuMemoryFootprint{
+                "HandExtractorCaffe", weightBytes + (50ull << 20) + netBytes + 3ull * inputSize.area(), 0ull};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return GpuMemoryFootprint{};
+        }
+    }
 }
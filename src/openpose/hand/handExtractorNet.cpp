@@ -12,7 +12,9 @@ namespace op
         mHandImageCrop{{1, 3, mNetOutputSize.y, mNetOutputSize.x}},
         mHeatMapScaleMode{heatMapScaleMode},
         mHeatMapTypes{heatMapTypes},
-        mEnabled{true}
+        mEnabled{true},
+        mNetInitialized{false},
+        mLazyIdleSeconds{-1.}
     {
         try
         {
@@ -53,8 +55,12 @@ namespace op
         {
             // Get thread id
             mThreadId = {std::this_thread::get_id()};
-            // Deep net initialization
-            netInitializationOnThread();
+            // Deep net initialization (if disabled or lazy, it is delayed until it is needed)
+            if (mEnabled && mLazyIdleSeconds < 0.)
+            {
+                netInitializationOnThread();
+                mNetInitialized = true;
+            }
         }
         catch (const std::exception& e)
         {
@@ -103,6 +109,46 @@ namespace op
         }
     }
 
+    void HandExtractorNet::netReleaseOnThread()
+    {
+    }
+
+    bool HandExtractorNet::isNetReady(const bool netNeeded)
+    {
+        try
+        {
+            const auto now = std::chrono::steady_clock::now();
+            if (mEnabled && netNeeded)
+            {
+                if (!mNetInitialized)
+                {
+                    checkThread();
+                    opLog("Loading the hand network (first frame that needs it)...", Priority::High);
+                    netInitializationOnThread();
+                    mNetInitialized = true;
+                }
+                mLastNetUse = now;
+                return true;
+            }
+            // Idle release
+            if (mNetInitialized && mLazyIdleSeconds > 0.
+                && std::chrono::duration<double>(now - mLastNetUse).count() > mLazyIdleSeconds)
+            {
+                checkThread();
+                opLog("Releasing the hand network (idle for more than " + std::to_string(mLazyIdleSeconds)
+                      + " seconds)...", Priority::High);
+                netReleaseOnThread();
+                mNetInitialized = false;
+            }
+            return (mEnabled && mNetInitialized);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
     void HandExtractorNet::setEnabled(const bool enabled)
     {
         try
@@ -115,6 +161,18 @@ namespace op
         }
     }
 
+    void HandExtractorNet::setLazyLoading(const double idleSeconds)
+    {
+        try
+        {
+            mLazyIdleSeconds = idleSeconds;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     void HandExtractorNet::checkThread() const
     {
         try
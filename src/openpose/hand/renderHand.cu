@@ -1,5 +1,6 @@
 #include <openpose/hand/renderHand.hpp>
 #include <openpose/gpu/cuda.hpp>
+#include <openpose/gpu/cudaAutotune.hpp>
 #include <openpose/hand/handParameters.hpp>
 #include <openpose_private/gpu/cuda.hu>
 #include <openpose_private/utilities/render.hu>
@@ -9,6 +10,7 @@ namespace op
     __constant__ const unsigned int PART_PAIRS_GPU[] = {HAND_PAIRS_RENDER_GPU};
     __constant__ const float SCALES[] = {HAND_SCALES_RENDER_GPU};
     __constant__ const float COLORS[] = {HAND_COLORS_RENDER_GPU};
+    DEFINE_KEYPOINT_RENDER_TABLES(HandRenderTables, HAND_NUMBER_PARTS, PART_PAIRS_GPU, COLORS, SCALES, -1, -1);
 
     __global__ void getBoundingBoxPerPersonHand(
         float* maxPtr, float* minPtr, float* scalePtr,const int targetWidth, const int targetHeight,
@@ -32,17 +34,13 @@ namespace op
         __shared__ float sharedScaleF[HAND_MAX_HANDS];
 
         // Other parameters
-        const auto numberPartPairs = sizeof(PART_PAIRS_GPU) / (2*sizeof(PART_PAIRS_GPU[0]));
-        const auto numberScales = sizeof(SCALES) / sizeof(SCALES[0]);
-        const auto numberColors = sizeof(COLORS) / (3*sizeof(COLORS[0]));
         const auto radius = fastMinCuda(targetWidth, targetHeight) / 100.f;
         const auto lineWidth = fastMinCuda(targetWidth, targetHeight) / 80.f;
 
         // Render key points
-        renderKeypoints(
+        renderKeypoints<HandRenderTables>(
             targetPtr, sharedMaxs, sharedMins, sharedScaleF, maxPtr, minPtr, scalePtr, globalIdx, x, y, targetWidth,
-            targetHeight, handsPtr, PART_PAIRS_GPU, numberHands, HAND_NUMBER_PARTS, numberPartPairs, COLORS,
-            numberColors, radius, lineWidth, SCALES, numberScales, threshold, alphaColorToAdd);
+            targetHeight, handsPtr, numberHands, radius, lineWidth, threshold, alphaColorToAdd);
     }
 
     void renderHandKeypointsGpu(
@@ -60,12 +58,18 @@ namespace op
                     maxPtr, minPtr, scalePtr, frameSize.x, frameSize.y, handsPtr, numberHands,
                     HAND_NUMBER_PARTS, renderThreshold);
                 // Draw hands
+                const auto renderParts = [&](const dim3& threadsPerBlock, const dim3& numBlocks, float* targetPtr)
+                {
+                    renderHandsParts<<<threadsPerBlock, numBlocks>>>(
+                        targetPtr, minPtr, maxPtr, scalePtr, frameSize.x, frameSize.y, handsPtr, numberHands,
+                        renderThreshold, alphaColorToAdd);
+                };
                 dim3 threadsPerBlock;
                 dim3 numBlocks;
-                getNumberCudaThreadsAndBlocks(threadsPerBlock, numBlocks, frameSize);
-                renderHandsParts<<<threadsPerBlock, numBlocks>>>(
-                    framePtr, minPtr, maxPtr, scalePtr, frameSize.x, frameSize.y, handsPtr, numberHands,
-                    renderThreshold, alphaColorToAdd);
+                getAutotunedCudaThreadsAndBlocks(
+                    threadsPerBlock, numBlocks, frameSize, "renderHandKeypoints", framePtr,
+                    sizeof(float) * 3 * frameSize.area(), renderParts);
+                renderParts(threadsPerBlock, numBlocks, framePtr);
                 cudaCheck(__LINE__, __FUNCTION__, __FILE__);
             }
         }
@@ -1,14 +1,92 @@
 #include <openpose/net/bodyPartConnectorBase.hpp>
-#include <algorithm> // std::sort
+#include <algorithm> // std::equal, std::nth_element, std::sort
+#include <array>
 #include <cmath> // std::sqrt
-#include <set>
+#include <limits> // std::numeric_limits
+#include <type_traits> // std::conditional
 #include <openpose/utilities/check.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/keypoint.hpp>
 #include <openpose/pose/poseParameters.hpp>
+#include <openpose/pose/poseParametersRender.hpp>
+#include <openpose_private/utilities/parallelFor.hpp>
 
 namespace op
 {
+    // Maximum number of points of the line integral of getScoreAB()
+    const auto MAX_POINTS_IN_LINE = 25;
+    // Minimum number of candidate pairs (A, B) of a frame before the PAF scores are computed in parallel
+    const auto MIN_PAIRS_PARALLEL = 256;
+
+    // Body part pairs and PAF map indexes of the models supported by the CPU body part connector (same values than
+    // getPosePartPairs() and getPoseMapIndex()). Being compile-time constants, the compiler can unroll the body part
+    // pair loops and remove their bounds checks. It falls back into ConnectorTableDynamic otherwise
+    template <PoseModel TPoseModel>
+    struct ConnectorTable;
+
+    template <>
+    struct ConnectorTable<PoseModel::BODY_25>
+    {
+        static constexpr unsigned int numberBodyParts = 25u;
+        static constexpr unsigned int numberBodyPartPairs = 26u;
+        static constexpr unsigned int bodyPartPairs[2*numberBodyPartPairs] = {
+            1,8,   1,2,   1,5,   2,3,   3,4,   5,6,   6,7,   8,9,   9,10,  10,11, 8,12,  12,13, 13,14,  1,0,   0,15,
+            15,17,  0,16, 16,18,   2,17,  5,18,   14,19,19,20,14,21, 11,22,22,23,11,24};
+        static constexpr unsigned int mapIdx[2*numberBodyPartPairs] = {
+            0,1, 14,15, 22,23, 16,17, 18,19, 24,25, 26,27, 6,7, 2,3, 4,5, 8,9, 10,11, 12,13, 30,31, 32,33, 36,37,
+            34,35, 38,39, 20,21, 28,29, 40,41,42,43,44,45, 46,47,48,49,50,51};
+    };
+    constexpr unsigned int ConnectorTable<PoseModel::BODY_25>::bodyPartPairs[];
+    constexpr unsigned int ConnectorTable<PoseModel::BODY_25>::mapIdx[];
+
+    template <>
+    struct ConnectorTable<PoseModel::COCO_18>
+    {
+        static constexpr unsigned int numberBodyParts = 18u;
+        static constexpr unsigned int numberBodyPartPairs = 19u;
+        static constexpr unsigned int bodyPartPairs[2*numberBodyPartPairs] = {
+            1,2,   1,5,   2,3,   3,4,   5,6,   6,7,   1,8,   8,9,   9,10,  1,11,  11,12, 12,13,  1,0,   0,14, 14,16,
+            0,15, 15,17,  2,16,  5,17};
+        static constexpr unsigned int mapIdx[2*numberBodyPartPairs] = {
+            12,13, 20,21, 14,15, 16,17, 22,23, 24,25, 0,1, 2,3, 4,5, 6,7, 8,9, 10,11, 28,29, 30,31, 34,35, 32,33,
+            36,37, 18,19, 26,27};
+    };
+    constexpr unsigned int ConnectorTable<PoseModel::COCO_18>::bodyPartPairs[];
+    constexpr unsigned int ConnectorTable<PoseModel::COCO_18>::mapIdx[];
+
+    template <>
+    struct ConnectorTable<PoseModel::MPI_15>
+    {
+        static constexpr unsigned int numberBodyParts = 15u;
+        static constexpr unsigned int numberBodyPartPairs = 14u;
+        static constexpr unsigned int bodyPartPairs[2*numberBodyPartPairs] = {POSE_MPI_PAIRS_RENDER_GPU};
+        static constexpr unsigned int mapIdx[2*numberBodyPartPairs] = {
+            0,1, 2,3, 4,5, 6,7, 8,9, 10,11, 12,13, 14,15, 16,17, 18,19, 20,21, 22,23, 24,25, 26,27};
+    };
+    constexpr unsigned int ConnectorTable<PoseModel::MPI_15>::bodyPartPairs[];
+    constexpr unsigned int ConnectorTable<PoseModel::MPI_15>::mapIdx[];
+
+    // Any other PoseModel (or body part pairs different than the ones of the model)
+    struct ConnectorTableDynamic
+    {
+        const unsigned int numberBodyParts;
+        const unsigned int numberBodyPartPairs;
+        const std::vector<unsigned int>& bodyPartPairs;
+        const std::vector<unsigned int>& mapIdx;
+    };
+
+    template <typename TTable>
+    bool tableMatches(
+        const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyParts,
+        const std::vector<unsigned int>& mapIdx)
+    {
+        return numberBodyParts == TTable::numberBodyParts
+            && bodyPartPairs.size() == 2*TTable::numberBodyPartPairs
+            && mapIdx.size() == 2*TTable::numberBodyPartPairs
+            && std::equal(bodyPartPairs.begin(), bodyPartPairs.end(), TTable::bodyPartPairs)
+            && std::equal(mapIdx.begin(), mapIdx.end(), TTable::mapIdx);
+    }
+
     template <typename T>
     inline T getScoreAB(
         const int i, const int j, const T* const candidateAPtr, const T* const candidateBPtr, const T* const mapX,
@@ -21,7 +99,7 @@ namespace op
             const auto vectorAToBY = candidateBPtr[3*j+1] - candidateAPtr[3*i+1];
             const auto vectorAToBMax = fastMax(std::abs(vectorAToBX), std::abs(vectorAToBY));
             const auto numberPointsInLine = fastMax(
-                5, fastMin(25, positiveIntRound(std::sqrt(5*vectorAToBMax))));
+                5, fastMin(MAX_POINTS_IN_LINE, positiveIntRound(std::sqrt(5*vectorAToBMax))));
             const auto vectorNorm = T(std::sqrt( vectorAToBX*vectorAToBX + vectorAToBY*vectorAToBY ));
             // If the peaksPtr are coincident. Don't connect them.
             if (vectorNorm > 1e-6)
@@ -31,21 +109,29 @@ namespace op
                 const auto vectorAToBNormX = vectorAToBX/vectorNorm;
                 const auto vectorAToBNormY = vectorAToBY/vectorNorm;
 
-                auto sum = T(0);
-                auto count = 0u;
+                // Sampled PAF scores. Split into branch-free loops (vectorizable by the compiler), while the sum keeps
+                // the sequential order (so the result is exactly the same)
                 const auto vectorAToBXInLine = vectorAToBX/numberPointsInLine;
                 const auto vectorAToBYInLine = vectorAToBY/numberPointsInLine;
+                int indexes[MAX_POINTS_IN_LINE];
                 for (auto lm = 0; lm < numberPointsInLine; lm++)
                 {
                     const auto mX = fastMax(
                         0, fastMin(heatMapSize.x-1, positiveIntRound(sX + lm*vectorAToBXInLine)));
                     const auto mY = fastMax(
                         0, fastMin(heatMapSize.y-1, positiveIntRound(sY + lm*vectorAToBYInLine)));
-                    const auto idx = mY * heatMapSize.x + mX;
-                    const auto score = (vectorAToBNormX*mapX[idx] + vectorAToBNormY*mapY[idx]);
-                    if (score > interThreshold)
+                    indexes[lm] = mY * heatMapSize.x + mX;
+                }
+                T scores[MAX_POINTS_IN_LINE];
+                for (auto lm = 0; lm < numberPointsInLine; lm++)
+                    scores[lm] = vectorAToBNormX*mapX[indexes[lm]] + vectorAToBNormY*mapY[indexes[lm]];
+                auto sum = T(0);
+                auto count = 0u;
+                for (auto lm = 0; lm < numberPointsInLine; lm++)
+                {
+                    if (scores[lm] > interThreshold)
                     {
-                        sum += score;
+                        sum += scores[lm];
                         count++;
                     }
                 }
@@ -153,33 +239,135 @@ namespace op
         }
     }
 
+    // (score, indexA, indexB) of each valid candidate pair of each body part pair, in the same (indexA, indexB) order
+    // than the serial loop. The PAF scores of each body part pair are independent, so they are computed in parallel
+    // when there are enough candidates (e.g., crowded scenes), while the greedy assembly remains serial
+    // Temporary buffers of the people assembly. They are kept across frames (one per thread, i.e., per connector
+    // worker) and only cleared, so their memory is allocated once (and re-allocated only if a frame needs more)
     template <typename T>
-    std::vector<std::pair<std::vector<int>, T>> createPeopleVector(
-        const T* const heatMapPtr, const T* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize,
-        const int maxPeaks, const T interThreshold, const T interMinAboveThreshold,
-        const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyParts,
-        const unsigned int numberBodyPartPairs, const T defaultNmsThreshold, const Array<T>& pairScores)
+    struct PeopleAssemblyBuffers
+    {
+        // createPeopleVector(): PAF candidates, selected connections and used peaks of each body part pair
+        std::vector<std::vector<std::tuple<double, int, int>>> allABConnectionsPerPair;
+        std::vector<std::tuple<int, int, double>> abConnections;
+        std::vector<int> occurA;
+        std::vector<int> occurB;
+        // pafPtrIntoVector(): PAF candidates of each body part pair
+        std::vector<std::vector<std::tuple<T, T, int, int, int>>> pairConnectionsPerPair;
+        // pafVectorIntoPeopleVector(): person of each peak and merged (removed) people
+        std::vector<int> personAssigned;
+        std::vector<int> indexesToRemove;
+        // removePeopleBelowThresholdsAndFillFaces()
+        std::vector<int> faceValidSubsetIndexes;
+        std::vector<int> faceInvalidSubsetIndexes;
+        // keepTopPeopleIndexes(): (score * sqrt(area), person) of each valid person
+        std::vector<std::pair<T, int>> topPeopleScores;
+    };
+
+    template <typename T>
+    PeopleAssemblyBuffers<T>& getPeopleAssemblyBuffers()
+    {
+        thread_local PeopleAssemblyBuffers<T> tPeopleAssemblyBuffers;
+        return tPeopleAssemblyBuffers;
+    }
+
+    // It clears each element (keeping its memory) and resizes it to `size` elements
+    template <typename TVector>
+    void clearPerPairBuffers(std::vector<TVector>& perPairBuffers, const unsigned int size)
+    {
+        if (perPairBuffers.size() < size)
+            perPairBuffers.resize(size);
+        for (auto& perPairBuffer : perPairBuffers)
+            perPairBuffer.clear();
+    }
+
+    template <typename T, typename TTable>
+    void getAllABConnections(
+        std::vector<std::vector<std::tuple<double, int, int>>>& allABConnectionsPerPair,
+        const T* const heatMapPtr, const T* const peaksPtr, const Point<int>& heatMapSize, const int maxPeaks,
+        const T interThreshold, const T interMinAboveThreshold, const TTable& table,
+        const unsigned int numberBodyPartsAndBkg, const T defaultNmsThreshold)
     {
         try
         {
-            if (poseModel != PoseModel::BODY_25 && poseModel != PoseModel::COCO_18
-                && poseModel != PoseModel::MPI_15 && poseModel != PoseModel::MPI_15_4)
-                error("Model not implemented for CPU body connector.", __LINE__, __FUNCTION__, __FILE__);
+            const auto peaksOffset = 3*(maxPeaks+1);
+            const auto heatMapOffset = heatMapSize.area();
+            const auto getPairConnections = [&](const int pairIndex)
+            {
+                const auto* candidateAPtr = peaksPtr + table.bodyPartPairs[2*pairIndex]*peaksOffset;
+                const auto* candidateBPtr = peaksPtr + table.bodyPartPairs[2*pairIndex+1]*peaksOffset;
+                const auto numberPeaksA = positiveIntRound(candidateAPtr[0]);
+                const auto numberPeaksB = positiveIntRound(candidateBPtr[0]);
+                const auto* mapX = heatMapPtr + (numberBodyPartsAndBkg + table.mapIdx[2*pairIndex]) * heatMapOffset;
+                const auto* mapY = heatMapPtr + (numberBodyPartsAndBkg + table.mapIdx[2*pairIndex+1]) * heatMapOffset;
+                auto& allABConnections = allABConnectionsPerPair[pairIndex];
+                // E.g., neck-nose connection. For each neck
+                for (auto i = 1; i <= numberPeaksA; i++)
+                {
+                    // E.g., neck-nose connection. For each nose
+                    for (auto j = 1; j <= numberPeaksB; j++)
+                    {
+                        // Initial PAF
+                        const auto scoreAB = getScoreAB(
+                            i, j, candidateAPtr, candidateBPtr, mapX, mapY, heatMapSize, interThreshold,
+                            interMinAboveThreshold, defaultNmsThreshold);
+                        // E.g., neck-nose connection. If possible PAF between neck i, nose j --> add
+                        // parts score + connection score
+                        if (scoreAB > 1e-6)
+                            allABConnections.emplace_back(std::make_tuple(scoreAB, i, j));
+                    }
+                }
+            };
+            // Number of candidate pairs
+            auto numberPairs = 0;
+            for (auto pairIndex = 0u; pairIndex < table.numberBodyPartPairs; pairIndex++)
+                numberPairs += positiveIntRound(peaksPtr[table.bodyPartPairs[2*pairIndex]*peaksOffset])
+                             * positiveIntRound(peaksPtr[table.bodyPartPairs[2*pairIndex+1]*peaksOffset]);
+            // Parallel (crowded frames) or serial
+            if (numberPairs >= MIN_PAIRS_PARALLEL)
+                parallelFor(0, (int)table.numberBodyPartPairs, getPairConnections);
+            else
+                for (auto pairIndex = 0u; pairIndex < table.numberBodyPartPairs; pairIndex++)
+                    getPairConnections((int)pairIndex);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 
+    template <typename T, typename TTable>
+    std::vector<std::pair<std::vector<int>, T>> createPeopleVectorFromTable(
+        const T* const heatMapPtr, const T* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize,
+        const int maxPeaks, const T interThreshold, const T interMinAboveThreshold, const TTable& table,
+        const T defaultNmsThreshold, const Array<T>& pairScores)
+    {
+        try
+        {
             // std::vector<std::pair<std::vector<int>, double>> refers to:
             //     - std::vector<int>: [body parts locations, #body parts found]
             //     - double: person subset score
             std::vector<std::pair<std::vector<int>, T>> peopleVector;
-            const auto& mapIdx = getPoseMapIndex(poseModel);
-            const auto numberBodyPartsAndBkg = numberBodyParts + (addBkgChannel(poseModel) ? 1 : 0);
-            const auto vectorSize = numberBodyParts+1;
+            const auto numberBodyPartsAndBkg = table.numberBodyParts + (addBkgChannel(poseModel) ? 1 : 0);
+            const auto vectorSize = table.numberBodyParts+1;
             const auto peaksOffset = 3*(maxPeaks+1);
-            const auto heatMapOffset = heatMapSize.area();
+            // Reused buffers
+            auto& peopleAssemblyBuffers = getPeopleAssemblyBuffers<T>();
+            auto& allABConnectionsPerPair = peopleAssemblyBuffers.allABConnectionsPerPair;
+            auto& abConnections = peopleAssemblyBuffers.abConnections; // (x, y, score)
+            auto& occurA = peopleAssemblyBuffers.occurA;
+            auto& occurB = peopleAssemblyBuffers.occurB;
+            clearPerPairBuffers(allABConnectionsPerPair, table.numberBodyPartPairs);
+            // PAF scores of all the candidate pairs
+            if (heatMapPtr != nullptr)
+                getAllABConnections(
+                    allABConnectionsPerPair, heatMapPtr, peaksPtr, heatMapSize, maxPeaks, interThreshold,
+                    interMinAboveThreshold, table, numberBodyPartsAndBkg, defaultNmsThreshold);
             // Iterate over it PAF connection, e.g., neck-nose, neck-Lshoulder, etc.
-            for (auto pairIndex = 0u; pairIndex < numberBodyPartPairs; pairIndex++)
+            for (auto pairIndex = 0u; pairIndex < table.numberBodyPartPairs; pairIndex++)
             {
-                const auto bodyPartA = bodyPartPairs[2*pairIndex];
-                const auto bodyPartB = bodyPartPairs[2*pairIndex+1];
+                const auto bodyPartA = table.bodyPartPairs[2*pairIndex];
+                const auto bodyPartB = table.bodyPartPairs[2*pairIndex+1];
                 const auto* candidateAPtr = peaksPtr + bodyPartA*peaksOffset;
                 const auto* candidateBPtr = peaksPtr + bodyPartB*peaksOffset;
                 const auto numberPeaksA = positiveIntRound(candidateAPtr[0]);
@@ -194,7 +382,7 @@ namespace op
                     if (numberPeaksA == 0) // numberPeaksB == 0 or not
                     {
                         // Non-MPI
-                        if (numberBodyParts != 15)
+                        if (table.numberBodyParts != 15)
                         {
                             for (auto i = 1; i <= numberPeaksB; i++)
                             {
@@ -242,7 +430,7 @@ namespace op
                     else // if (numberPeaksA != 0 && numberPeaksB == 0)
                     {
                         // Non-MPI
-                        if (numberBodyParts != 15)
+                        if (table.numberBodyParts != 15)
                         {
                             for (auto i = 1; i <= numberPeaksA; i++)
                             {
@@ -291,34 +479,11 @@ namespace op
                 else // if (numberPeaksA != 0 && numberPeaksB != 0)
                 {
                     // (score, indexA, indexB). Inverted order for easy std::sort
-                    std::vector<std::tuple<double, int, int>> allABConnections;
+                    auto& allABConnections = allABConnectionsPerPair[pairIndex];
                     // Note: Problem of this function, if no right PAF between A and B, both elements are
                     // discarded. However, they should be added indepently, not discarded
-                    if (heatMapPtr != nullptr)
-                    {
-                        const auto* mapX = heatMapPtr
-                                         + (numberBodyPartsAndBkg + mapIdx[2*pairIndex]) * heatMapOffset;
-                        const auto* mapY = heatMapPtr
-                                         + (numberBodyPartsAndBkg + mapIdx[2*pairIndex+1]) * heatMapOffset;
-                        // E.g., neck-nose connection. For each neck
-                        for (auto i = 1; i <= numberPeaksA; i++)
-                        {
-                            // E.g., neck-nose connection. For each nose
-                            for (auto j = 1; j <= numberPeaksB; j++)
-                            {
-                                // Initial PAF
-                                auto scoreAB = getScoreAB(
-                                    i, j, candidateAPtr, candidateBPtr, mapX, mapY, heatMapSize, interThreshold,
-                                    interMinAboveThreshold, defaultNmsThreshold);
-
-                                // E.g., neck-nose connection. If possible PAF between neck i, nose j --> add
-                                // parts score + connection score
-                                if (scoreAB > 1e-6)
-                                    allABConnections.emplace_back(std::make_tuple(scoreAB, i, j));
-                            }
-                        }
-                    }
-                    else if (!pairScores.empty())
+                    // If heatMapPtr != nullptr, they were already computed by getAllABConnections()
+                    if (heatMapPtr == nullptr && !pairScores.empty())
                     {
                         const auto firstIndex = (int)pairIndex*pairScores.getSize(1)*pairScores.getSize(2);
                         // E.g., neck-nose connection. For each neck
@@ -338,7 +503,7 @@ namespace op
                             }
                         }
                     }
-                    else
+                    else if (heatMapPtr == nullptr)
                         error("Error. Should not reach here.", __LINE__, __FUNCTION__, __FILE__);
 
                     // select the top minAB connection, assuming that each part occur only once
@@ -347,11 +512,11 @@ namespace op
                         std::sort(allABConnections.begin(), allABConnections.end(),
                                   std::greater<std::tuple<double, int, int>>());
 
-                    std::vector<std::tuple<int, int, double>> abConnections; // (x, y, score)
+                    abConnections.clear();
                     {
                         const auto minAB = fastMin(numberPeaksA, numberPeaksB);
-                        std::vector<int> occurA(numberPeaksA, 0);
-                        std::vector<int> occurB(numberPeaksB, 0);
+                        occurA.assign(numberPeaksA, 0);
+                        occurB.assign(numberPeaksB, 0);
                         auto counter = 0;
                         for (const auto& aBConnection : allABConnections)
                         {
@@ -379,12 +544,12 @@ namespace op
                         {
                             for (const auto& abConnection : abConnections)
                             {
-                                std::vector<int> rowVector(numberBodyParts+3, 0);
+                                std::vector<int> rowVector(table.numberBodyParts+3, 0);
                                 const auto indexA = std::get<0>(abConnection);
                                 const auto indexB = std::get<1>(abConnection);
                                 const auto score = std::get<2>(abConnection);
-                                rowVector[bodyPartPairs[0]] = indexA;
-                                rowVector[bodyPartPairs[1]] = indexB;
+                                rowVector[table.bodyPartPairs[0]] = indexA;
+                                rowVector[table.bodyPartPairs[1]] = indexB;
                                 rowVector.back() = 2;
                                 // add the score of parts and the connection
                                 const auto personScore = T(peaksPtr[indexA] + peaksPtr[indexB] + score);
@@ -397,9 +562,9 @@ namespace op
                         //     - Assuming I have nose,eye,ear as 1 person subset, and whole arm as another one, it
                         //       will not merge them both
                         else if (
-                            (numberBodyParts == 18 && (pairIndex==17 || pairIndex==18))
-                            || ((numberBodyParts == 19 || (numberBodyParts == 25)
-                                 || numberBodyParts == 59 || numberBodyParts == 65)
+                            (table.numberBodyParts == 18 && (pairIndex==17 || pairIndex==18))
+                            || ((table.numberBodyParts == 19 || (table.numberBodyParts == 25)
+                                 || table.numberBodyParts == 59 || table.numberBodyParts == 65)
                                 && (pairIndex==18 || pairIndex==19))
                             )
                         {
@@ -471,6 +636,50 @@ namespace op
         }
     }
 
+    template <typename T>
+    std::vector<std::pair<std::vector<int>, T>> createPeopleVector(
+        const T* const heatMapPtr, const T* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize,
+        const int maxPeaks, const T interThreshold, const T interMinAboveThreshold,
+        const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyParts,
+        const unsigned int numberBodyPartPairs, const T defaultNmsThreshold, const Array<T>& pairScores)
+    {
+        try
+        {
+            if (poseModel != PoseModel::BODY_25 && poseModel != PoseModel::COCO_18
+                && poseModel != PoseModel::MPI_15 && poseModel != PoseModel::MPI_15_4)
+                error("Model not implemented for CPU body connector.", __LINE__, __FUNCTION__, __FILE__);
+
+            // Compile-time tables (if bodyPartPairs are the default ones of the model)
+            const auto& mapIdx = getPoseMapIndex(poseModel);
+            if (poseModel == PoseModel::BODY_25
+                && tableMatches<ConnectorTable<PoseModel::BODY_25>>(bodyPartPairs, numberBodyParts, mapIdx))
+                return createPeopleVectorFromTable(
+                    heatMapPtr, peaksPtr, poseModel, heatMapSize, maxPeaks, interThreshold, interMinAboveThreshold,
+                    ConnectorTable<PoseModel::BODY_25>{}, defaultNmsThreshold, pairScores);
+            else if (poseModel == PoseModel::COCO_18
+                && tableMatches<ConnectorTable<PoseModel::COCO_18>>(bodyPartPairs, numberBodyParts, mapIdx))
+                return createPeopleVectorFromTable(
+                    heatMapPtr, peaksPtr, poseModel, heatMapSize, maxPeaks, interThreshold, interMinAboveThreshold,
+                    ConnectorTable<PoseModel::COCO_18>{}, defaultNmsThreshold, pairScores);
+            else if ((poseModel == PoseModel::MPI_15 || poseModel == PoseModel::MPI_15_4)
+                && tableMatches<ConnectorTable<PoseModel::MPI_15>>(bodyPartPairs, numberBodyParts, mapIdx))
+                return createPeopleVectorFromTable(
+                    heatMapPtr, peaksPtr, poseModel, heatMapSize, maxPeaks, interThreshold, interMinAboveThreshold,
+                    ConnectorTable<PoseModel::MPI_15>{}, defaultNmsThreshold, pairScores);
+            // Runtime table
+            else
+                return createPeopleVectorFromTable(
+                    heatMapPtr, peaksPtr, poseModel, heatMapSize, maxPeaks, interThreshold, interMinAboveThreshold,
+                    ConnectorTableDynamic{numberBodyParts, numberBodyPartPairs, bodyPartPairs, mapIdx},
+                    defaultNmsThreshold, pairScores);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
     template <typename T>
     std::vector<std::tuple<T, T, int, int, int>> pafPtrIntoVector(
         const Array<T>& pairScores, const T* const peaksPtr, const int maxPeaks,
@@ -481,11 +690,11 @@ namespace op
             // Result is a std::vector<std::tuple<double, double, int, int, int>> with:
             // (totalScore, PAFscore, pairIndex, indexA, indexB)
             // totalScore is first to simplify later sorting
-            std::vector<std::tuple<T, T, int, int, int>> pairConnections;
-
-            // Get all PAF pairs in a single std::vector
+            // Get all PAF pairs of each body part pair (independent ones, so computed in parallel for crowded frames)
             const auto peaksOffset = 3*(maxPeaks+1);
-            for (auto pairIndex = 0u; pairIndex < numberBodyPartPairs; pairIndex++)
+            auto& pairConnectionsPerPair = getPeopleAssemblyBuffers<T>().pairConnectionsPerPair;
+            clearPerPairBuffers(pairConnectionsPerPair, numberBodyPartPairs);
+            const auto getPairConnections = [&](const int pairIndex)
             {
                 const auto bodyPartA = bodyPartPairs[2*pairIndex];
                 const auto bodyPartB = bodyPartPairs[2*pairIndex+1];
@@ -493,7 +702,8 @@ namespace op
                 const auto* candidateBPtr = peaksPtr + bodyPartB*peaksOffset;
                 const auto numberPeaksA = positiveIntRound(candidateAPtr[0]);
                 const auto numberPeaksB = positiveIntRound(candidateBPtr[0]);
-                const auto firstIndex = (int)pairIndex*pairScores.getSize(1)*pairScores.getSize(2);
+                const auto firstIndex = pairIndex*pairScores.getSize(1)*pairScores.getSize(2);
+                auto& currentPairConnections = pairConnectionsPerPair[pairIndex];
                 // E.g., neck-nose connection. For each neck
                 for (auto indexA = 0; indexA < numberPeaksA; indexA++)
                 {
@@ -519,12 +729,30 @@ namespace op
                                                   + T(0.1)*peaksPtr[indexScoreA]
                                                   + T(0.1)*peaksPtr[indexScoreB];
                             // +1 because peaksPtr starts with counter
-                            pairConnections.emplace_back(
+                            currentPairConnections.emplace_back(
                                 std::make_tuple(totalScore, scoreAB, pairIndex, indexA+1, indexB+1));
                         }
                     }
                 }
-            }
+            };
+            auto numberPairs = 0;
+            for (auto pairIndex = 0u; pairIndex < numberBodyPartPairs; pairIndex++)
+                numberPairs += positiveIntRound(peaksPtr[bodyPartPairs[2*pairIndex]*peaksOffset])
+                             * positiveIntRound(peaksPtr[bodyPartPairs[2*pairIndex+1]*peaksOffset]);
+            if (numberPairs >= MIN_PAIRS_PARALLEL)
+                parallelFor(0, (int)numberBodyPartPairs, getPairConnections);
+            else
+                for (auto pairIndex = 0u; pairIndex < numberBodyPartPairs; pairIndex++)
+                    getPairConnections((int)pairIndex);
+            // Single std::vector (same order than the serial loop)
+            std::vector<std::tuple<T, T, int, int, int>> pairConnections;
+            auto numberPairConnections = 0ull;
+            for (const auto& currentPairConnections : pairConnectionsPerPair)
+                numberPairConnections += currentPairConnections.size();
+            pairConnections.reserve(numberPairConnections);
+            for (const auto& currentPairConnections : pairConnectionsPerPair)
+                pairConnections.insert(
+                    pairConnections.end(), currentPairConnections.begin(), currentPairConnections.end());
 
             // Sort rows in descending order based on its first element (`totalScore`)
             if (!pairConnections.empty())
@@ -541,22 +769,71 @@ namespace op
         }
     }
 
+    // Person rows of pafVectorIntoPeopleVectorFixed(): std::array if the number of body parts is known at compile time
+    // (TNumberBodyParts > 0), so no heap allocation is needed for each new (or merged) person
+    template <unsigned int TNumberBodyParts>
+    using PersonRow = typename std::conditional<
+        TNumberBodyParts == 0u, std::vector<int>, std::array<int, TNumberBodyParts+1>>::type;
+
+    inline void initializePersonRow(std::vector<int>& personRow, const unsigned int vectorSize)
+    {
+        personRow.assign(vectorSize, 0);
+    }
+
+    template <std::size_t TSize>
+    inline void initializePersonRow(std::array<int, TSize>& personRow, const unsigned int vectorSize)
+    {
+        UNUSED(vectorSize);
+        personRow.fill(0);
+    }
+
+    inline std::vector<int> toPersonVector(std::vector<int>& personRow)
+    {
+        return std::move(personRow);
+    }
+
+    template <std::size_t TSize>
+    inline std::vector<int> toPersonVector(const std::array<int, TSize>& personRow)
+    {
+        return std::vector<int>(personRow.begin(), personRow.end());
+    }
+
+    // Whether a (partially assembled) person already satisfies minSubsetCnt and minSubsetScore
     template <typename T>
-    std::vector<std::pair<std::vector<int>, T>> pafVectorIntoPeopleVector(
+    inline bool isValidPartialPerson(
+        const int personCounter, const T personScore, const int minSubsetCnt, const T minSubsetScore)
+    {
+        return personCounter > 0 && personCounter >= minSubsetCnt && personScore >= minSubsetScore*personCounter;
+    }
+
+    template <typename T, unsigned int TNumberBodyParts>
+    std::vector<std::pair<std::vector<int>, T>> pafVectorIntoPeopleVectorFixed(
         const std::vector<std::tuple<T, T, int, int, int>>& pairConnections, const T* const peaksPtr,
-        const int maxPeaks, const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyParts)
+        const int maxPeaks, const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyPartsRuntime,
+        const int numberPeopleMax, const int minSubsetCnt, const T minSubsetScore)
     {
         try
         {
-            // std::vector<std::pair<std::vector<int>, double>> refers to:
-            //     - std::vector<int>: [body parts locations, #body parts found]
+            // Compile-time constant if TNumberBodyParts > 0
+            const auto numberBodyParts = (TNumberBodyParts > 0u ? TNumberBodyParts : numberBodyPartsRuntime);
+            // std::vector<std::pair<PersonRow, double>> refers to:
+            //     - PersonRow: [body parts locations, #body parts found]
             //     - double: person subset score
-            std::vector<std::pair<std::vector<int>, T>> peopleVector;
+            // Kept across frames (one per thread and number of body parts), so the person rows are not re-allocated
+            thread_local std::vector<std::pair<PersonRow<TNumberBodyParts>, T>> tPeopleVector;
+            auto& peopleVector = tPeopleVector;
+            peopleVector.clear();
             const auto vectorSize = numberBodyParts+1;
             const auto peaksOffset = (maxPeaks+1);
             // Save which body parts have been already assigned
-            std::vector<int> personAssigned(numberBodyParts*maxPeaks, -1);
-            std::set<int, std::greater<int>> indexesToRemoveSortedSet;
+            auto& peopleAssemblyBuffers = getPeopleAssemblyBuffers<T>();
+            auto& personAssigned = peopleAssemblyBuffers.personAssigned;
+            personAssigned.assign(numberBodyParts*maxPeaks, -1);
+            auto& indexesToRemove = peopleAssemblyBuffers.indexesToRemove;
+            indexesToRemove.clear();
+            // Early termination (see CONNECTOR_PEOPLE_MAX_FACTOR): No new people once enough of them are valid
+            const auto numberValidPeopleMax = (numberPeopleMax > 0 ? CONNECTOR_PEOPLE_MAX_FACTOR*numberPeopleMax : -1);
+            auto numberValidPeople = 0;
             // Iterate over each PAF pair connection detected
             // E.g., neck1-nose2, neck5-Lshoulder0, etc.
             for (const auto& pairConnection : pairConnections)
@@ -598,8 +875,11 @@ namespace op
                 // 1. A & B not assigned yet: Create new person
                 if (aAssigned < 0 && bAssigned < 0)
                 {
+                    if (numberValidPeopleMax > 0 && numberValidPeople >= numberValidPeopleMax)
+                        continue;
                     // Keypoint indexes
-                    std::vector<int> rowVector(vectorSize, 0);
+                    PersonRow<TNumberBodyParts> rowVector;
+                    initializePersonRow(rowVector, vectorSize);
                     rowVector[bodyPartA] = indexScoreA;
                     rowVector[bodyPartB] = indexScoreB;
                     // Number keypoints
@@ -610,7 +890,8 @@ namespace op
                     aAssigned = (int)peopleVector.size();
                     bAssigned = aAssigned;
                     // Create new personVector
-                    peopleVector.emplace_back(std::make_pair(rowVector, personScore));
+                    numberValidPeople += isValidPartialPerson(2, personScore, minSubsetCnt, minSubsetScore);
+                    peopleVector.emplace_back(std::make_pair(std::move(rowVector), personScore));
                 }
                 // 2. A assigned but not B: Add B to person with A (if no another B there)
                 // or
@@ -640,6 +921,8 @@ namespace op
                     // If person with 1 does not have a 2 yet
                     if (personVector.first[bodyPart2] == 0)
                     {
+                        numberValidPeople -= isValidPartialPerson(
+                            personVector.first.back(), personVector.second, minSubsetCnt, minSubsetScore);
                         // Update keypoint indexes
                         personVector.first[bodyPart2] = indexScore2;
                         // Update number keypoints
@@ -648,12 +931,21 @@ namespace op
                         personVector.second += peaksPtr[indexScore2] + pafScore;
                         // Set associated personAssigned as assigned
                         assigned2 = assigned1;
+                        numberValidPeople += isValidPartialPerson(
+                            personVector.first.back(), personVector.second, minSubsetCnt, minSubsetScore);
                     }
                     // Otherwise, ignore this B because the previous one came from a higher PAF-confident score
                 }
                 // 4. A & B already assigned to same person (circular/redundant PAF): Update person score
                 else if (aAssigned >=0 && bAssigned >=0 && aAssigned == bAssigned)
-                    peopleVector[aAssigned].second += pafScore;
+                {
+                    auto& personVector = peopleVector[aAssigned];
+                    numberValidPeople -= isValidPartialPerson(
+                        personVector.first.back(), personVector.second, minSubsetCnt, minSubsetScore);
+                    personVector.second += pafScore;
+                    numberValidPeople += isValidPartialPerson(
+                        personVector.first.back(), personVector.second, minSubsetCnt, minSubsetScore);
+                }
                 // 5. A & B already assigned to different people: Merge people if keypoint intersection is null
                 // I.e., that the keypoints in person A and B do not overlap
                 else if (aAssigned >=0 && bAssigned >=0 && aAssigned != bAssigned)
@@ -681,6 +973,10 @@ namespace op
                     // If complementary, merge both people into 1
                     if (complementary)
                     {
+                        numberValidPeople -= isValidPartialPerson(
+                            person1.back(), peopleVector[assigned1].second, minSubsetCnt, minSubsetScore)
+                            + isValidPartialPerson(
+                                person2.back(), peopleVector[assigned2].second, minSubsetCnt, minSubsetScore);
                         // Update keypoint indexes
                         for (auto part = 0u ; part < numberBodyParts ; part++)
                             if (person1[part] == 0)
@@ -689,9 +985,12 @@ namespace op
                         person1.back() += person2.back();
                         // Update score
                         peopleVector[assigned1].second += peopleVector[assigned2].second + pafScore;
+                        numberValidPeople += isValidPartialPerson(
+                            person1.back(), peopleVector[assigned1].second, minSubsetCnt, minSubsetScore);
                         // Erase the non-merged person
                         // peopleVector.erase(peopleVector.begin()+assigned2); // x2 slower when removing on-the-fly
-                        indexesToRemoveSortedSet.emplace(assigned2); // Add into set so we can remove them all at once
+                        // Each person is merged (removed) at most once, so no duplicates
+                        indexesToRemove.emplace_back(assigned2); // Add into list so we can remove them all at once
                         // Update associated personAssigned (person indexes have changed)
                         for (auto& element : personAssigned)
                         {
@@ -705,10 +1004,49 @@ namespace op
                 }
             }
             // Remove unused people
-            for (const auto& index : indexesToRemoveSortedSet)
+            std::sort(indexesToRemove.begin(), indexesToRemove.end(), std::greater<int>());
+            for (const auto& index : indexesToRemove)
                 peopleVector.erase(peopleVector.begin()+index);
             // Return result
-            return peopleVector;
+            std::vector<std::pair<std::vector<int>, T>> peopleVectorResult;
+            peopleVectorResult.reserve(peopleVector.size());
+            for (auto& personVector : peopleVector)
+                peopleVectorResult.emplace_back(
+                    std::make_pair(toPersonVector(personVector.first), personVector.second));
+            return peopleVectorResult;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    template <typename T>
+    std::vector<std::pair<std::vector<int>, T>> pafVectorIntoPeopleVector(
+        const std::vector<std::tuple<T, T, int, int, int>>& pairConnections, const T* const peaksPtr,
+        const int maxPeaks, const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyParts,
+        const int numberPeopleMax, const int minSubsetCnt, const T minSubsetScore)
+    {
+        try
+        {
+            // Fixed-size person rows for the number of body parts of BODY_25, COCO_18 and MPI_15
+            if (numberBodyParts == ConnectorTable<PoseModel::BODY_25>::numberBodyParts)
+                return pafVectorIntoPeopleVectorFixed<T, ConnectorTable<PoseModel::BODY_25>::numberBodyParts>(
+                    pairConnections, peaksPtr, maxPeaks, bodyPartPairs, numberBodyParts, numberPeopleMax,
+                    minSubsetCnt, minSubsetScore);
+            else if (numberBodyParts == ConnectorTable<PoseModel::COCO_18>::numberBodyParts)
+                return pafVectorIntoPeopleVectorFixed<T, ConnectorTable<PoseModel::COCO_18>::numberBodyParts>(
+                    pairConnections, peaksPtr, maxPeaks, bodyPartPairs, numberBodyParts, numberPeopleMax,
+                    minSubsetCnt, minSubsetScore);
+            else if (numberBodyParts == ConnectorTable<PoseModel::MPI_15>::numberBodyParts)
+                return pafVectorIntoPeopleVectorFixed<T, ConnectorTable<PoseModel::MPI_15>::numberBodyParts>(
+                    pairConnections, peaksPtr, maxPeaks, bodyPartPairs, numberBodyParts, numberPeopleMax,
+                    minSubsetCnt, minSubsetScore);
+            else
+                return pafVectorIntoPeopleVectorFixed<T, 0u>(
+                    pairConnections, peaksPtr, maxPeaks, bodyPartPairs, numberBodyParts, numberPeopleMax,
+                    minSubsetCnt, minSubsetScore);
         }
         catch (const std::exception& e)
         {
@@ -735,10 +1073,13 @@ namespace op
             // validSubsetIndexes.reserve(fastMin((size_t)maxPeaks, peopleVector.size())); // maxPeaks is not required
             validSubsetIndexes.reserve(peopleVector.size());
             // Face valid sets
-            std::vector<int> faceValidSubsetIndexes;
+            auto& peopleAssemblyBuffers = getPeopleAssemblyBuffers<T>();
+            auto& faceValidSubsetIndexes = peopleAssemblyBuffers.faceValidSubsetIndexes;
+            faceValidSubsetIndexes.clear();
             faceValidSubsetIndexes.reserve(peopleVector.size());
             // Face invalid sets
-            std::vector<int> faceInvalidSubsetIndexes;
+            auto& faceInvalidSubsetIndexes = peopleAssemblyBuffers.faceInvalidSubsetIndexes;
+            faceInvalidSubsetIndexes.clear();
             if (numberBodyParts >= 135)
                 faceInvalidSubsetIndexes.reserve(peopleVector.size());
             // For each person candidate
@@ -883,6 +1224,65 @@ namespace op
         }
     }
 
+    template <typename T>
+    void keepTopPeopleIndexes(
+        std::vector<int>& validSubsetIndexes, int& numberPeople,
+        const std::vector<std::pair<std::vector<int>, T>>& peopleVector, const unsigned int numberBodyParts,
+        const T* const peaksPtr, const int numberPeopleMax)
+    {
+        try
+        {
+            if (numberPeopleMax > 0 && numberPeople > numberPeopleMax)
+            {
+                // Same criterion than KeepTopNPeople (score * sqrt(area of the keypoints with score > 0.05)), so it
+                // keeps the same people. Its normalizations (1/#body parts and PAFs, scaleFactor) do not change the
+                // order, so they are not applied
+                auto& topPeopleScores = getPeopleAssemblyBuffers<T>().topPeopleScores;
+                topPeopleScores.clear();
+                for (const auto person : validSubsetIndexes)
+                {
+                    const auto& personVector = peopleVector[person].first;
+                    T minX = std::numeric_limits<T>::max();
+                    T maxX = std::numeric_limits<T>::lowest();
+                    T minY = minX;
+                    T maxY = maxX;
+                    for (auto part = 0u ; part < numberBodyParts ; part++)
+                    {
+                        const auto bodyPartIndex = personVector[part];
+                        if (bodyPartIndex > 0 && peaksPtr[bodyPartIndex] > T(0.05))
+                        {
+                            const auto x = peaksPtr[bodyPartIndex-2];
+                            const auto y = peaksPtr[bodyPartIndex-1];
+                            minX = fastMin(minX, x);
+                            maxX = fastMax(maxX, x);
+                            minY = fastMin(minY, y);
+                            maxY = fastMax(maxY, y);
+                        }
+                    }
+                    const auto area = (maxX >= minX ? (maxX-minX)*(maxY-minY) : T(0));
+                    topPeopleScores.emplace_back(peopleVector[person].second * std::sqrt(area), person);
+                }
+                // validSubsetIndexes is sorted, so ties are also solved by index like in KeepTopNPeople
+                std::nth_element(
+                    topPeopleScores.begin(), topPeopleScores.begin() + (numberPeopleMax - 1), topPeopleScores.end(),
+                    [](const std::pair<T, int>& a, const std::pair<T, int>& b)
+                    {
+                        return a.first > b.first || (a.first == b.first && a.second < b.second);
+                    });
+                // Kept in their original order
+                validSubsetIndexes.resize(numberPeopleMax);
+                for (auto topPerson = 0 ; topPerson < numberPeopleMax ; topPerson++)
+                    validSubsetIndexes[topPerson] = topPeopleScores[topPerson].second;
+                std::sort(validSubsetIndexes.begin(), validSubsetIndexes.end());
+                numberPeople = numberPeopleMax;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template <typename T>
     void peopleVectorToPeopleArray(
         Array<T>& poseKeypoints, Array<T>& poseScores, const T scaleFactor,
@@ -1329,7 +1729,7 @@ namespace op
         Array<T>& poseKeypoints, Array<T>& poseScores, const T* const heatMapPtr, const T* const peaksPtr,
         const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks, const T interMinAboveThreshold,
         const T interThreshold, const int minSubsetCnt, const T minSubsetScore, const T defaultNmsThreshold,
-        const T scaleFactor, const bool maximizePositives)
+        const T scaleFactor, const bool maximizePositives, const int numberPeopleMax)
     {
         try
         {
@@ -1358,6 +1758,9 @@ namespace op
             removePeopleBelowThresholdsAndFillFaces(
                 validSubsetIndexes, numberPeople, peopleVector, numberBodyParts, minSubsetCnt, minSubsetScore,
                 maximizePositives, peaksPtr);
+            // Keep only the top numberPeopleMax people
+            keepTopPeopleIndexes(
+                validSubsetIndexes, numberPeople, peopleVector, numberBodyParts, peaksPtr, numberPeopleMax);
             // Fill and return poseKeypoints
             peopleVectorToPeopleArray(
                 poseKeypoints, poseScores, scaleFactor, peopleVector, validSubsetIndexes, peaksPtr, numberPeople,
@@ -1381,13 +1784,13 @@ namespace op
         const float* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks,
         const float interMinAboveThreshold, const float interThreshold, const int minSubsetCnt,
         const float minSubsetScore, const float defaultNmsThreshold, const float scaleFactor,
-        const bool maximizePositives);
+        const bool maximizePositives, const int numberPeopleMax);
     template OP_API void connectBodyPartsCpu(
         Array<double>& poseKeypoints, Array<double>& poseScores, const double* const heatMapPtr,
         const double* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks,
         const double interMinAboveThreshold, const double interThreshold, const int minSubsetCnt,
         const double minSubsetScore, const double defaultNmsThreshold, const double scaleFactor,
-        const bool maximizePositives);
+        const bool maximizePositives, const int numberPeopleMax);
 
     template OP_API std::vector<std::pair<std::vector<int>, float>> createPeopleVector(
         const float* const heatMapPtr, const float* const peaksPtr, const PoseModel poseModel,
@@ -1413,6 +1816,15 @@ namespace op
         const unsigned int numberBodyParts, const int minSubsetCnt, const double minSubsetScore,
         const bool maximizePositives, const double* const peaksPtr);
 
+    template OP_API void keepTopPeopleIndexes(
+        std::vector<int>& validSubsetIndexes, int& numberPeople,
+        const std::vector<std::pair<std::vector<int>, float>>& peopleVector, const unsigned int numberBodyParts,
+        const float* const peaksPtr, const int numberPeopleMax);
+    template OP_API void keepTopPeopleIndexes(
+        std::vector<int>& validSubsetIndexes, int& numberPeople,
+        const std::vector<std::pair<std::vector<int>, double>>& peopleVector, const unsigned int numberBodyParts,
+        const double* const peaksPtr, const int numberPeopleMax);
+
     template OP_API void peopleVectorToPeopleArray(
         Array<float>& poseKeypoints, Array<float>& poseScores, const float scaleFactor,
         const std::vector<std::pair<std::vector<int>, float>>& peopleVector,
@@ -1436,9 +1848,11 @@ namespace op
     template OP_API std::vector<std::pair<std::vector<int>, float>> pafVectorIntoPeopleVector(
         const std::vector<std::tuple<float, float, int, int, int>>& pairConnections,
         const float* const peaksPtr, const int maxPeaks, const std::vector<unsigned int>& bodyPartPairs,
-        const unsigned int numberBodyParts);
+        const unsigned int numberBodyParts, const int numberPeopleMax, const int minSubsetCnt,
+        const float minSubsetScore);
     template OP_API std::vector<std::pair<std::vector<int>, double>> pafVectorIntoPeopleVector(
         const std::vector<std::tuple<double, double, int, int, int>>& pairConnections,
         const double* const peaksPtr, const int maxPeaks, const std::vector<unsigned int>& bodyPartPairs,
-        const unsigned int numberBodyParts);
+        const unsigned int numberBodyParts, const int numberPeopleMax, const int minSubsetCnt,
+        const double minSubsetScore);
 }
@@ -1,7 +1,15 @@
 #include <openpose/net/bodyPartConnectorBase.hpp>
+#include <limits>
+#include <thrust/copy.h>
+#include <thrust/device_ptr.h>
+#include <thrust/execution_policy.h>
+#include <thrust/functional.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/sort.h>
 #include <openpose/gpu/cuda.hpp>
 #include <openpose/pose/poseParameters.hpp>
 #include <openpose/utilities/fastMath.hpp>
+#include <openpose_private/gpu/cuda.hu>
 
 namespace op
 {
@@ -11,10 +19,35 @@ namespace op
         return int(a+T(0.5));
     }
 
-    template <typename T>
+    // Bilinear interpolation of a network resolution PAF channel at the source coordinates (xSource, ySource)
+    // pixelStep: Distance between 2 consecutive pixels of the channel (see getPixelStepCuda)
+    template <typename T, typename TPaf>
+    inline __device__ T pafBilinearInterpolate(
+        const TPaf* const mapPtr, const T xSource, const T ySource, const int width, const int height,
+        const int pixelStep)
+    {
+        const auto xLeft = min(width-1, max(0, int(floor(xSource))));
+        const auto xRight = min(width-1, xLeft+1);
+        const auto yTop = min(height-1, max(0, int(floor(ySource))));
+        const auto yBottom = min(height-1, yTop+1);
+        const T dx = min(T(1), max(T(0), xSource - xLeft));
+        const T dy = min(T(1), max(T(0), ySource - yTop));
+        const T top = (1-dx) * loadCuda<T>(mapPtr[(yTop*width + xLeft)*pixelStep])
+                    + dx * loadCuda<T>(mapPtr[(yTop*width + xRight)*pixelStep]);
+        const T bottom = (1-dx) * loadCuda<T>(mapPtr[(yBottom*width + xLeft)*pixelStep])
+                       + dx * loadCuda<T>(mapPtr[(yBottom*width + xRight)*pixelStep]);
+        return (1-dy) * top + dy * bottom;
+    }
+
+    // If pafWidth > 0, mapX and mapY are at network resolution (pafWidth x pafHeight) and they are sampled with
+    // bilinear interpolation (with the same mapping than the upsampling of ResizeAndMergeCaffe). Otherwise, they have
+    // the heat map size and they are sampled at the nearest pixel. pafPixelStep is the distance between 2 consecutive
+    // pixels of mapX and mapY at network resolution (see getPixelStepCuda).
+    template <typename T, typename THeatMap>
     inline __device__  T process(
-        const T* bodyPartA, const T* bodyPartB, const T* mapX, const T* mapY, const int heatmapWidth,
-        const int heatmapHeight, const T interThreshold, const T interMinAboveThreshold, const T defaultNmsThreshold)
+        const T* bodyPartA, const T* bodyPartB, const THeatMap* mapX, const THeatMap* mapY, const int heatmapWidth,
+        const int heatmapHeight, const T interThreshold, const T interMinAboveThreshold, const T defaultNmsThreshold,
+        const int pafWidth, const int pafHeight, const int pafPixelStep)
     {
         const auto vectorAToBX = bodyPartB[0] - bodyPartA[0];
         const auto vectorAToBY = bodyPartB[1] - bodyPartA[1];
@@ -34,12 +67,27 @@ namespace op
             auto count = 0;
             const auto vectorAToBXInLine = vectorAToBX/numberPointsInLine;
             const auto vectorAToBYInLine = vectorAToBY/numberPointsInLine;
+            const auto pafScaleX = T(pafWidth) / heatmapWidth;
+            const auto pafScaleY = T(pafHeight) / heatmapHeight;
             for (auto lm = 0; lm < numberPointsInLine; lm++)
             {
-                const auto mX = min(heatmapWidth-1, intRoundGPU(sX + lm*vectorAToBXInLine));
-                const auto mY = min(heatmapHeight-1, intRoundGPU(sY + lm*vectorAToBYInLine));
-                const auto idx = mY * heatmapWidth + mX;
-                const auto score = (vectorAToBNormX*mapX[idx] + vectorAToBNormY*mapY[idx]);
+                T score;
+                if (pafWidth > 0)
+                {
+                    const auto xSource = (sX + lm*vectorAToBXInLine + T(0.5)) * pafScaleX - T(0.5);
+                    const auto ySource = (sY + lm*vectorAToBYInLine + T(0.5)) * pafScaleY - T(0.5);
+                    score = vectorAToBNormX*pafBilinearInterpolate(
+                                mapX, xSource, ySource, pafWidth, pafHeight, pafPixelStep)
+                          + vectorAToBNormY*pafBilinearInterpolate(
+                                mapY, xSource, ySource, pafWidth, pafHeight, pafPixelStep);
+                }
+                else
+                {
+                    const auto mX = min(heatmapWidth-1, intRoundGPU(sX + lm*vectorAToBXInLine));
+                    const auto mY = min(heatmapHeight-1, intRoundGPU(sY + lm*vectorAToBYInLine));
+                    const auto idx = mY * heatmapWidth + mX;
+                    score = (vectorAToBNormX*loadCuda<T>(mapX[idx]) + vectorAToBNormY*loadCuda<T>(mapY[idx]));
+                }
                 if (score > interThreshold)
                 {
                     sum += score;
@@ -104,19 +152,23 @@ namespace op
     //     }
     // }
 
-    template <typename T>
+    // TLayout and pafChannels: Memory layout and channels of heatMapPtr if it is at network resolution (pafWidth > 0,
+    // see getChannelOffsetCuda), the full resolution heat maps are always NCHW
+    template <BlobLayout TLayout, typename T, typename THeatMap>
     __global__ void pafScoreKernel(
-        T* pairScoresPtr, const T* const heatMapPtr, const T* const peaksPtr, const unsigned int* const bodyPartPairsPtr,
-        const unsigned int* const mapIdxPtr, const unsigned int maxPeaks, const int numberBodyPartPairs,
-        const int heatmapWidth, const int heatmapHeight, const T interThreshold, const T interMinAboveThreshold,
-        const T defaultNmsThreshold)
+        T* pairScoresPtr, const THeatMap* const heatMapPtr, const T* const peaksPtr,
+        const unsigned int* const bodyPartPairsPtr,
+        const unsigned int* const mapIdxPtr, const unsigned int maxPeaks, const unsigned int numberPeaks,
+        const int numberBodyPartPairs, const int heatmapWidth, const int heatmapHeight, const T interThreshold,
+        const T interMinAboveThreshold, const T defaultNmsThreshold, const int pafWidth, const int pafHeight,
+        const int pafChannels)
     {
         const auto peakB = (blockIdx.x * blockDim.x) + threadIdx.x;
         const auto peakA = (blockIdx.y * blockDim.y) + threadIdx.y;
         const auto pairIndex = (blockIdx.z * blockDim.z) + threadIdx.z;
 
-        if (peakA < maxPeaks && peakB < maxPeaks)
-        // if (pairIndex < numberBodyPartPairs && peakA < maxPeaks && peakB < maxPeaks)
+        if (peakA < numberPeaks && peakB < numberPeaks)
+        // if (pairIndex < numberBodyPartPairs && peakA < numberPeaks && peakB < numberPeaks)
         {
             const auto baseIndex = 2*pairIndex;
             const auto partA = bodyPartPairsPtr[baseIndex];
@@ -125,7 +177,7 @@ namespace op
             const T numberPeaksA = peaksPtr[3*partA*(maxPeaks+1)];
             const T numberPeaksB = peaksPtr[3*partB*(maxPeaks+1)];
 
-            const auto outputIndex = (pairIndex*maxPeaks+peakA)*maxPeaks + peakB;
+            const auto outputIndex = (pairIndex*numberPeaks+peakA)*numberPeaks + peakB;
             if (peakA < numberPeaksA && peakB < numberPeaksB)
             {
                 const auto mapIdxX = mapIdxPtr[baseIndex];
@@ -133,25 +185,683 @@ namespace op
 
                 const T* const bodyPartA = peaksPtr + (3*(partA*(maxPeaks+1) + peakA+1));
                 const T* const bodyPartB = peaksPtr + (3*(partB*(maxPeaks+1) + peakB+1));
-                const T* const mapX = heatMapPtr + mapIdxX*heatmapWidth*heatmapHeight;
-                const T* const mapY = heatMapPtr + mapIdxY*heatmapWidth*heatmapHeight;
+                const auto mapArea = (pafWidth > 0 ? pafWidth*pafHeight : heatmapWidth*heatmapHeight);
+                const THeatMap* const mapX = heatMapPtr + getChannelOffsetCuda<TLayout>(
+                    0, mapIdxX, pafChannels, mapArea);
+                const THeatMap* const mapY = heatMapPtr + getChannelOffsetCuda<TLayout>(
+                    0, mapIdxY, pafChannels, mapArea);
                 pairScoresPtr[outputIndex] = process(
                     bodyPartA, bodyPartB, mapX, mapY, heatmapWidth, heatmapHeight, interThreshold,
-                    interMinAboveThreshold, defaultNmsThreshold);
+                    interMinAboveThreshold, defaultNmsThreshold, pafWidth, pafHeight,
+                    getPixelStepCuda<TLayout>(pafChannels));
             }
             else
                 pairScoresPtr[outputIndex] = -1;
         }
     }
 
+    // Candidate pruning of the sparse PAF scoring. It sets all the pair scores to -1, and registers the index (in
+    // pairScoresPtr) of each pair of existing peaks that is geometrically plausible (squared distance up to
+    // maxLimbLengthSquared) and whose 2 peaks score at least minPeakScore. pafCandidatesPtr[0] (0 before the kernel)
+    // counts the candidates, whose indexes follow it in any order (each one writes its own pair score, so the results
+    // do not depend on that order).
     template <typename T>
-    void connectBodyPartsGpu(
-        Array<T>& poseKeypoints, Array<T>& poseScores, const T* const heatMapGpuPtr, const T* const peaksPtr,
+    __global__ void pafCandidatesKernel(
+        int* pafCandidatesPtr, T* pairScoresPtr, const T* const peaksPtr, const unsigned int* const bodyPartPairsPtr,
+        const unsigned int maxPeaks, const unsigned int numberPeaks, const T maxLimbLengthSquared,
+        const T minPeakScore)
+    {
+        const auto peakB = (blockIdx.x * blockDim.x) + threadIdx.x;
+        const auto peakA = (blockIdx.y * blockDim.y) + threadIdx.y;
+        const auto pairIndex = (blockIdx.z * blockDim.z) + threadIdx.z;
+
+        if (peakA < numberPeaks && peakB < numberPeaks)
+        {
+            const auto baseIndex = 2*pairIndex;
+            const auto partA = bodyPartPairsPtr[baseIndex];
+            const auto partB = bodyPartPairsPtr[baseIndex + 1];
+
+            const T numberPeaksA = peaksPtr[3*partA*(maxPeaks+1)];
+            const T numberPeaksB = peaksPtr[3*partB*(maxPeaks+1)];
+
+            const auto outputIndex = (pairIndex*numberPeaks+peakA)*numberPeaks + peakB;
+            pairScoresPtr[outputIndex] = -1;
+            if (peakA < numberPeaksA && peakB < numberPeaksB)
+            {
+                const T* const bodyPartA = peaksPtr + (3*(partA*(maxPeaks+1) + peakA+1));
+                const T* const bodyPartB = peaksPtr + (3*(partB*(maxPeaks+1) + peakB+1));
+                const auto vectorAToBX = bodyPartB[0] - bodyPartA[0];
+                const auto vectorAToBY = bodyPartB[1] - bodyPartA[1];
+                if (vectorAToBX*vectorAToBX + vectorAToBY*vectorAToBY <= maxLimbLengthSquared
+                    && bodyPartA[2] >= minPeakScore && bodyPartB[2] >= minPeakScore)
+                    pafCandidatesPtr[1 + atomicAdd(pafCandidatesPtr, 1)] = (int)outputIndex;
+            }
+        }
+    }
+
+    // Same as pafScoreKernel, but only for the candidates of pafCandidatesKernel (grid-stride loop, so the number of
+    // candidates is never read back by the host)
+    template <BlobLayout TLayout, typename T, typename THeatMap>
+    __global__ void pafScoreSparseKernel(
+        T* pairScoresPtr, const int* const pafCandidatesPtr, const THeatMap* const heatMapPtr,
+        const T* const peaksPtr, const unsigned int* const bodyPartPairsPtr, const unsigned int* const mapIdxPtr,
+        const unsigned int maxPeaks, const unsigned int numberPeaks, const int heatmapWidth, const int heatmapHeight,
+        const T interThreshold, const T interMinAboveThreshold, const T defaultNmsThreshold, const int pafWidth,
+        const int pafHeight, const int pafChannels)
+    {
+        const auto numberCandidates = pafCandidatesPtr[0];
+        for (auto candidate = (int)((blockIdx.x * blockDim.x) + threadIdx.x) ; candidate < numberCandidates ;
+             candidate += (int)(gridDim.x * blockDim.x))
+        {
+            const auto outputIndex = (unsigned int)pafCandidatesPtr[1 + candidate];
+            const auto peakB = outputIndex % numberPeaks;
+            const auto peakA = (outputIndex / numberPeaks) % numberPeaks;
+            const auto pairIndex = outputIndex / (numberPeaks*numberPeaks);
+
+            const auto baseIndex = 2*pairIndex;
+            const auto partA = bodyPartPairsPtr[baseIndex];
+            const auto partB = bodyPartPairsPtr[baseIndex + 1];
+            const auto mapIdxX = mapIdxPtr[baseIndex];
+            const auto mapIdxY = mapIdxPtr[baseIndex + 1];
+
+            const T* const bodyPartA = peaksPtr + (3*(partA*(maxPeaks+1) + peakA+1));
+            const T* const bodyPartB = peaksPtr + (3*(partB*(maxPeaks+1) + peakB+1));
+            const auto mapArea = (pafWidth > 0 ? pafWidth*pafHeight : heatmapWidth*heatmapHeight);
+            const THeatMap* const mapX = heatMapPtr + getChannelOffsetCuda<TLayout>(0, mapIdxX, pafChannels, mapArea);
+            const THeatMap* const mapY = heatMapPtr + getChannelOffsetCuda<TLayout>(0, mapIdxY, pafChannels, mapArea);
+            pairScoresPtr[outputIndex] = process(
+                bodyPartA, bodyPartB, mapX, mapY, heatmapWidth, heatmapHeight, interThreshold,
+                interMinAboveThreshold, defaultNmsThreshold, pafWidth, pafHeight,
+                getPixelStepCuda<TLayout>(pafChannels));
+        }
+    }
+
+    // Sparse PAF scoring: Maximum blocks of pafScoreSparseKernel (each thread loops over the candidates)
+    const auto PAF_SPARSE_MAX_BLOCKS = 256u;
+
+    // GPU people assembly (equivalent to pafPtrIntoVector + pafVectorIntoPeopleVector +
+    // removePeopleBelowThresholdsAndFillFaces + peopleVectorToPeopleArray for models without face keypoints)
+    const auto ASSEMBLY_THREADS = 256u;
+
+    // Pointers to each section of the assembly workspace
+    template <typename T>
+    struct AssemblyWorkspace
+    {
+        T* candidateScores;     // [numberPairScores] Total score of each candidate connection (sorting key)
+        int* candidateIndexes;  // [numberPairScores] Index of each candidate connection in pairScores
+        int* personAssigned;    // [numberBodyParts*maxPeaks] Person of each peak (-1 if none)
+        int* peopleParts;       // [maxPeople*(numberBodyParts+1)] Peak index of each body part + #body parts
+        T* peopleScores;        // [maxPeople]
+        int* peopleRemoved;     // [maxPeople] 1 if merged into another person
+        int* peopleValid;       // [maxPeople] 1 if above thresholds
+        int* validIndexes;      // [maxPeople]
+        T* keypoints;           // [maxPeople*numberBodyParts*3]
+        T* scores;              // [maxPeople]
+        int* numberPeople;      // [1]
+        int* numberPeaks;       // [1] Maximum number of peaks of any body part (see numberPeaksKernel)
+        unsigned long long bytes;
+    };
+
+    inline unsigned long long alignWorkspaceBytes(const unsigned long long bytes)
+    {
+        return (bytes + 255ull) & ~255ull;
+    }
+
+    inline int getMaxAssembledPeople(const int numberBodyParts, const int maxPeaks)
+    {
+        // Each new person uses 2 non-assigned peaks, and peaks are never unassigned
+        return numberBodyParts*maxPeaks/2 + 1;
+    }
+
+    template <typename T>
+    AssemblyWorkspace<T> getAssemblyWorkspace(
+        void* const workspacePtr, const int numberBodyParts, const int numberBodyPartPairs, const int maxPeaks)
+    {
+        const auto numberPairScores = (unsigned long long)numberBodyPartPairs*maxPeaks*maxPeaks;
+        const auto maxPeople = (unsigned long long)getMaxAssembledPeople(numberBodyParts, maxPeaks);
+        auto* const basePtr = (unsigned char*)workspacePtr;
+        AssemblyWorkspace<T> workspace;
+        auto offset = 0ull;
+        // if basePtr == nullptr, it only computes the total size
+        const auto section = [&](const unsigned long long sectionBytes) {
+            auto* const sectionPtr = (basePtr == nullptr ? nullptr : basePtr + offset);
+            offset += alignWorkspaceBytes(sectionBytes);
+            return (void*)sectionPtr;
+        };
+        workspace.candidateScores = (T*)section(numberPairScores * sizeof(T));
+        workspace.candidateIndexes = (int*)section(numberPairScores * sizeof(int));
+        workspace.personAssigned = (int*)section(numberBodyParts*maxPeaks * sizeof(int));
+        workspace.peopleParts = (int*)section(maxPeople*(numberBodyParts+1) * sizeof(int));
+        workspace.peopleScores = (T*)section(maxPeople * sizeof(T));
+        workspace.peopleRemoved = (int*)section(maxPeople * sizeof(int));
+        workspace.peopleValid = (int*)section(maxPeople * sizeof(int));
+        workspace.validIndexes = (int*)section(maxPeople * sizeof(int));
+        workspace.keypoints = (T*)section(maxPeople*numberBodyParts*3 * sizeof(T));
+        workspace.scores = (T*)section(maxPeople * sizeof(T));
+        workspace.numberPeople = (int*)section(sizeof(int));
+        workspace.numberPeaks = (int*)section(sizeof(int));
+        workspace.bytes = offset;
+        return workspace;
+    }
+
+    // It reduces the peak counter of each body part (the first element of each channel of the NMS output) into
+    // numberPeaksPtr[0], i.e., the maximum number of peaks of any body part. By design, it runs in a single block
+    template <typename T>
+    __global__ void numberPeaksKernel(
+        int* numberPeaksPtr, const T* const peaksPtr, const int numberBodyParts, const int maxPeaks)
+    {
+        __shared__ int sNumberPeaks;
+        if (threadIdx.x == 0)
+            sNumberPeaks = 0;
+        __syncthreads();
+        for (auto part = (int)threadIdx.x ; part < numberBodyParts ; part += blockDim.x)
+            atomicMax(&sNumberPeaks, min(maxPeaks, intRoundGPU(peaksPtr[3*part*(maxPeaks+1)])));
+        __syncthreads();
+        if (threadIdx.x == 0)
+            numberPeaksPtr[0] = sNumberPeaks;
+    }
+
+    // Selects the valid pair scores, iterating indexes in reverse order so that, after the stable sort, ties keep the
+    // same order than the std::greater sort of pafPtrIntoVector
+    template <typename T>
+    struct IsValidPairScoreReversed
+    {
+        const T* pairScoresPtr;
+        int numberPairScores;
+
+        __device__ bool operator()(const int index) const
+        {
+            return pairScoresPtr[numberPairScores-1-index] > T(1e-6);
+        }
+    };
+
+    template <typename T>
+    __global__ void candidateScoresKernel(
+        T* candidateScoresPtr, int* candidateIndexesPtr, const int numberCandidates, const T* const pairScoresPtr,
+        const T* const peaksPtr, const unsigned int* const bodyPartPairsPtr, const int maxPeaks,
+        const int numberPeaks, const int numberPairScores)
+    {
+        const auto candidate = (int)((blockIdx.x * blockDim.x) + threadIdx.x);
+        if (candidate < numberCandidates)
+        {
+            const auto pairScoreIndex = numberPairScores-1-candidateIndexesPtr[candidate];
+            const auto indexB = pairScoreIndex % numberPeaks;
+            const auto indexA = (pairScoreIndex / numberPeaks) % numberPeaks;
+            const auto pairIndex = pairScoreIndex / (numberPeaks*numberPeaks);
+            const auto peaksOffset = 3*(maxPeaks+1);
+            const auto bodyPartA = bodyPartPairsPtr[2*pairIndex];
+            const auto bodyPartB = bodyPartPairsPtr[2*pairIndex+1];
+            // Same totalScore than pafPtrIntoVector
+            candidateScoresPtr[candidate] = pairScoresPtr[pairScoreIndex]
+                                          + T(0.1)*peaksPtr[bodyPartA*peaksOffset + (indexA+1)*3 + 2]
+                                          + T(0.1)*peaksPtr[bodyPartB*peaksOffset + (indexB+1)*3 + 2];
+            candidateIndexesPtr[candidate] = pairScoreIndex;
+        }
+    }
+
+    // Whether a (partially assembled) person already satisfies minSubsetCnt and minSubsetScore
+    template <typename T>
+    inline __device__ int isValidPartialPerson(
+        const int personCounter, const T personScore, const int minSubsetCnt, const T minSubsetScore)
+    {
+        return personCounter > 0 && personCounter >= minSubsetCnt && personScore >= minSubsetScore*personCounter;
+    }
+
+    // Greedy assembly of pafVectorIntoPeopleVector. The candidate order matters, so a single block processes them
+    // sequentially, while the per-candidate O(#body parts) and O(#peaks) steps (person merging) run in parallel
+    // If numberValidPeopleMax > 0, no new people are created once numberValidPeopleMax of them are valid (see
+    // CONNECTOR_PEOPLE_MAX_FACTOR)
+    template <typename T>
+    __global__ void assemblePeopleKernel(
+        int* peoplePartsPtr, T* peopleScoresPtr, int* peopleRemovedPtr, int* numberPeoplePtr, int* personAssignedPtr,
+        const int* const candidateIndexesPtr, const int numberCandidates, const T* const pairScoresPtr,
+        const T* const peaksPtr, const unsigned int* const bodyPartPairsPtr, const int maxPeaks,
+        const int numberPeaks, const int numberBodyParts, const int maxPeople, const int numberValidPeopleMax,
+        const int minSubsetCnt, const T minSubsetScore)
+    {
+        __shared__ int sNumberPeople;
+        __shared__ int sMerge;
+        __shared__ int sComplementary;
+        __shared__ int sAssigned1;
+        __shared__ int sAssigned2;
+        __shared__ T sPafScore;
+
+        const auto vectorSize = numberBodyParts+1;
+        const auto peaksOffset = maxPeaks+1;
+        // Initialize people and assignments
+        for (auto i = (int)threadIdx.x ; i < numberBodyParts*numberPeaks ; i += blockDim.x)
+            personAssignedPtr[i] = -1;
+        for (auto i = (int)threadIdx.x ; i < maxPeople*vectorSize ; i += blockDim.x)
+            peoplePartsPtr[i] = 0;
+        for (auto i = (int)threadIdx.x ; i < maxPeople ; i += blockDim.x)
+        {
+            peopleScoresPtr[i] = T(0);
+            peopleRemovedPtr[i] = 0;
+        }
+        if (threadIdx.x == 0)
+            sNumberPeople = 0;
+        // Only used by thread 0
+        auto numberValidPeople = 0;
+        __syncthreads();
+
+        // Iterate over each PAF pair connection detected (sorted by total score)
+        for (auto candidate = 0 ; candidate < numberCandidates ; candidate++)
+        {
+            if (threadIdx.x == 0)
+            {
+                sMerge = 0;
+                const auto pairScoreIndex = candidateIndexesPtr[candidate];
+                const auto pafScore = pairScoresPtr[pairScoreIndex];
+                // 1-based indexes (like pafPtrIntoVector, because peaksPtr starts with counter)
+                const auto indexB = pairScoreIndex % numberPeaks + 1;
+                const auto indexA = (pairScoreIndex / numberPeaks) % numberPeaks + 1;
+                const auto pairIndex = pairScoreIndex / (numberPeaks*numberPeaks);
+                const int bodyPartA = bodyPartPairsPtr[2*pairIndex];
+                const int bodyPartB = bodyPartPairsPtr[2*pairIndex+1];
+                const auto indexScoreA = (bodyPartA*peaksOffset + indexA)*3 + 2;
+                const auto indexScoreB = (bodyPartB*peaksOffset + indexB)*3 + 2;
+                auto& aAssigned = personAssignedPtr[bodyPartA*numberPeaks+indexA-1];
+                auto& bAssigned = personAssignedPtr[bodyPartB*numberPeaks+indexB-1];
+                // 1. A & B not assigned yet: Create new person
+                if (aAssigned < 0 && bAssigned < 0)
+                {
+                    if (sNumberPeople < maxPeople
+                        && (numberValidPeopleMax <= 0 || numberValidPeople < numberValidPeopleMax))
+                    {
+                        auto* personPartsPtr = peoplePartsPtr + sNumberPeople*vectorSize;
+                        personPartsPtr[bodyPartA] = indexScoreA;
+                        personPartsPtr[bodyPartB] = indexScoreB;
+                        personPartsPtr[numberBodyParts] = 2;
+                        peopleScoresPtr[sNumberPeople] = peaksPtr[indexScoreA] + peaksPtr[indexScoreB] + pafScore;
+                        numberValidPeople += isValidPartialPerson(
+                            2, peopleScoresPtr[sNumberPeople], minSubsetCnt, minSubsetScore);
+                        aAssigned = sNumberPeople;
+                        bAssigned = sNumberPeople;
+                        sNumberPeople++;
+                    }
+                }
+                // 2. A assigned but not B: Add B to person with A (if no another B there)
+                // or
+                // 3. B assigned but not A: Add A to person with B (if no another A there)
+                else if ((aAssigned >= 0 && bAssigned < 0) || (aAssigned < 0 && bAssigned >= 0))
+                {
+                    const auto assigned1 = (aAssigned >= 0 ? aAssigned : bAssigned);
+                    auto& assigned2 = (aAssigned >= 0 ? bAssigned : aAssigned);
+                    const auto bodyPart2 = (aAssigned >= 0 ? bodyPartB : bodyPartA);
+                    const auto indexScore2 = (aAssigned >= 0 ? indexScoreB : indexScoreA);
+                    auto* personPartsPtr = peoplePartsPtr + assigned1*vectorSize;
+                    if (personPartsPtr[bodyPart2] == 0)
+                    {
+                        numberValidPeople -= isValidPartialPerson(
+                            personPartsPtr[numberBodyParts], peopleScoresPtr[assigned1], minSubsetCnt, minSubsetScore);
+                        personPartsPtr[bodyPart2] = indexScore2;
+                        personPartsPtr[numberBodyParts]++;
+                        peopleScoresPtr[assigned1] += peaksPtr[indexScore2] + pafScore;
+                        assigned2 = assigned1;
+                        numberValidPeople += isValidPartialPerson(
+                            personPartsPtr[numberBodyParts], peopleScoresPtr[assigned1], minSubsetCnt, minSubsetScore);
+                    }
+                }
+                // 4. A & B already assigned to same person (circular/redundant PAF): Update person score
+                else if (aAssigned == bAssigned)
+                {
+                    const auto personCounter = peoplePartsPtr[aAssigned*vectorSize + numberBodyParts];
+                    numberValidPeople -= isValidPartialPerson(
+                        personCounter, peopleScoresPtr[aAssigned], minSubsetCnt, minSubsetScore);
+                    peopleScoresPtr[aAssigned] += pafScore;
+                    numberValidPeople += isValidPartialPerson(
+                        personCounter, peopleScoresPtr[aAssigned], minSubsetCnt, minSubsetScore);
+                }
+                // 5. A & B already assigned to different people: Merge people if keypoint intersection is null
+                else
+                {
+                    sMerge = 1;
+                    sComplementary = 1;
+                    sAssigned1 = min(aAssigned, bAssigned);
+                    sAssigned2 = max(aAssigned, bAssigned);
+                    sPafScore = pafScore;
+                }
+            }
+            __syncthreads();
+            // 5. (continuation) Parallel merge (sMerge is shared, so all threads take the same branch)
+            if (sMerge)
+            {
+                auto* person1Ptr = peoplePartsPtr + sAssigned1*vectorSize;
+                const auto* const person2Ptr = peoplePartsPtr + sAssigned2*vectorSize;
+                // Check if complementary
+                for (auto part = (int)threadIdx.x ; part < numberBodyParts ; part += blockDim.x)
+                    if (person1Ptr[part] > 0 && person2Ptr[part] > 0)
+                        sComplementary = 0;
+                __syncthreads();
+                // If complementary, merge both people into 1
+                if (sComplementary)
+                {
+                    for (auto part = (int)threadIdx.x ; part < numberBodyParts ; part += blockDim.x)
+                        if (person1Ptr[part] == 0)
+                            person1Ptr[part] = person2Ptr[part];
+                    for (auto i = (int)threadIdx.x ; i < numberBodyParts*numberPeaks ; i += blockDim.x)
+                        if (personAssignedPtr[i] == sAssigned2)
+                            personAssignedPtr[i] = sAssigned1;
+                    if (threadIdx.x == 0)
+                    {
+                        numberValidPeople -= isValidPartialPerson(
+                            person1Ptr[numberBodyParts], peopleScoresPtr[sAssigned1], minSubsetCnt, minSubsetScore)
+                            + isValidPartialPerson(
+                                person2Ptr[numberBodyParts], peopleScoresPtr[sAssigned2], minSubsetCnt,
+                                minSubsetScore);
+                        person1Ptr[numberBodyParts] += person2Ptr[numberBodyParts];
+                        peopleScoresPtr[sAssigned1] += peopleScoresPtr[sAssigned2] + sPafScore;
+                        peopleRemovedPtr[sAssigned2] = 1;
+                        numberValidPeople += isValidPartialPerson(
+                            person1Ptr[numberBodyParts], peopleScoresPtr[sAssigned1], minSubsetCnt, minSubsetScore);
+                    }
+                }
+                __syncthreads();
+            }
+        }
+        if (threadIdx.x == 0)
+            numberPeoplePtr[0] = sNumberPeople;
+    }
+
+    // Same thresholds than removePeopleBelowThresholdsAndFillFaces (models without face keypoints)
+    template <typename T>
+    __global__ void removePeopleBelowThresholdsKernel(
+        int* peopleValidPtr, const int* const peoplePartsPtr, const T* const peopleScoresPtr,
+        const int* const peopleRemovedPtr, const int numberPeople, const int numberBodyParts, const int minSubsetCnt,
+        const T minSubsetScore, const bool maximizePositives)
+    {
+        const auto person = (int)((blockIdx.x * blockDim.x) + threadIdx.x);
+        if (person < numberPeople)
+        {
+            const auto* const personPartsPtr = peoplePartsPtr + person*(numberBodyParts+1);
+            auto personCounter = personPartsPtr[numberBodyParts];
+            auto valid = (peopleRemovedPtr[person] == 0);
+            // Foot keypoints do not affect personCounter
+            if (valid && !maximizePositives && (numberBodyParts == 25 || numberBodyParts > 70))
+            {
+                auto footCounter = 0;
+                for (auto part = 19 ; part < 25 ; part++)
+                    footCounter += (personPartsPtr[part] > 0);
+                personCounter -= footCounter;
+                // Remove legs that are duplicated and that do not have upper torso
+                if (footCounter > 0 && personCounter <= 4)
+                    valid = false;
+            }
+            peopleValidPtr[person] = (valid && personCounter >= minSubsetCnt
+                                      && (peopleScoresPtr[person]/personCounter) >= minSubsetScore);
+        }
+    }
+
+    struct IsValidPerson
+    {
+        const int* peopleValidPtr;
+
+        __device__ bool operator()(const int person) const
+        {
+            return peopleValidPtr[person] != 0;
+        }
+    };
+
+    // Same criterion than keepTopPeopleIndexes: score * sqrt(area of the keypoints with score > 0.05)
+    template <typename T>
+    __global__ void topPeopleScoresKernel(
+        T* topPeopleScoresPtr, const int* const validIndexesPtr, const int* const peoplePartsPtr,
+        const T* const peopleScoresPtr, const T* const peaksPtr, const int numberPeople, const int numberBodyParts)
+    {
+        const auto person = (int)((blockIdx.x * blockDim.x) + threadIdx.x);
+        if (person < numberPeople)
+        {
+            const auto personIndex = validIndexesPtr[person];
+            const auto* const personPartsPtr = peoplePartsPtr + personIndex*(numberBodyParts+1);
+            auto found = false;
+            T minX, maxX, minY, maxY;
+            for (auto part = 0 ; part < numberBodyParts ; part++)
+            {
+                const auto bodyPartIndex = personPartsPtr[part];
+                if (bodyPartIndex > 0 && peaksPtr[bodyPartIndex] > T(0.05))
+                {
+                    const auto x = peaksPtr[bodyPartIndex-2];
+                    const auto y = peaksPtr[bodyPartIndex-1];
+                    minX = (found ? min(minX, x) : x);
+                    maxX = (found ? max(maxX, x) : x);
+                    minY = (found ? min(minY, y) : y);
+                    maxY = (found ? max(maxY, y) : y);
+                    found = true;
+                }
+            }
+            const auto area = (found ? (maxX-minX)*(maxY-minY) : T(0));
+            topPeopleScoresPtr[person] = peopleScoresPtr[personIndex] * sqrt(area);
+        }
+    }
+
+    template <typename T>
+    __global__ void peopleToKeypointsKernel(
+        T* keypointsPtr, T* scoresPtr, const int* const validIndexesPtr, const int* const peoplePartsPtr,
+        const T* const peopleScoresPtr, const T* const peaksPtr, const int numberPeople,
+        const int numberBodyParts, const T scaleFactor, const T oneOverNumberBodyPartsAndPAFs)
+    {
+        const auto index = (int)((blockIdx.x * blockDim.x) + threadIdx.x);
+        if (index < numberPeople*numberBodyParts)
+        {
+            const auto person = index / numberBodyParts;
+            const auto bodyPart = index % numberBodyParts;
+            const auto personIndex = validIndexesPtr[person];
+            const auto bodyPartIndex = peoplePartsPtr[personIndex*(numberBodyParts+1) + bodyPart];
+            const auto baseOffset = 3*index;
+            if (bodyPartIndex > 0)
+            {
+                keypointsPtr[baseOffset] = peaksPtr[bodyPartIndex-2] * scaleFactor;
+                keypointsPtr[baseOffset+1] = peaksPtr[bodyPartIndex-1] * scaleFactor;
+                keypointsPtr[baseOffset+2] = peaksPtr[bodyPartIndex];
+            }
+            else
+            {
+                keypointsPtr[baseOffset] = T(0);
+                keypointsPtr[baseOffset+1] = T(0);
+                keypointsPtr[baseOffset+2] = T(0);
+            }
+            if (bodyPart == 0)
+                scoresPtr[person] = peopleScoresPtr[personIndex] * oneOverNumberBodyPartsAndPAFs;
+        }
+    }
+
+    template <typename T>
+    void connectBodyPartsGpuAssembly(
+        Array<T>& poseKeypoints, Array<T>& poseScores, const PoseModel poseModel, const int maxPeaks,
+        const int numberPeaks, const int minSubsetCnt, const T minSubsetScore, const T scaleFactor,
+        const bool maximizePositives, const T* const pairScoresGpuPtr, const unsigned int* const bodyPartPairsGpuPtr,
+        const T* const peaksGpuPtr, void* const assemblyWorkspaceGpuPtr, CUstream_st* const cudaStream,
+        const int numberPeopleMax)
+    {
+        try
+        {
+            const auto numberBodyParts = (int)getPoseNumberBodyParts(poseModel);
+            const auto numberBodyPartPairs = (int)(getPosePartPairs(poseModel).size() / 2);
+            const auto numberPairScores = numberBodyPartPairs*numberPeaks*numberPeaks;
+            // The workspace is sized for maxPeaks, but at most numberPeaks peaks are assigned to people
+            const auto maxPeople = getMaxAssembledPeople(numberBodyParts, numberPeaks);
+            const auto workspace = getAssemblyWorkspace<T>(
+                assemblyWorkspaceGpuPtr, numberBodyParts, numberBodyPartPairs, maxPeaks);
+            // 1. Select valid connection candidates (equivalent to pafPtrIntoVector)
+            const auto candidateIndexesThrustPtr = thrust::device_pointer_cast(workspace.candidateIndexes);
+            const auto numberCandidates = (int)(thrust::copy_if(
+                thrust::cuda::par.on(cudaStream),
+                thrust::counting_iterator<int>(0), thrust::counting_iterator<int>(numberPairScores),
+                candidateIndexesThrustPtr, IsValidPairScoreReversed<T>{pairScoresGpuPtr, numberPairScores})
+                - candidateIndexesThrustPtr);
+            // 2. Sort them by total score (descending)
+            if (numberCandidates > 0)
+            {
+                candidateScoresKernel<<<getNumberCudaBlocks(numberCandidates), CUDA_NUM_THREADS, 0, cudaStream>>>(
+                    workspace.candidateScores, workspace.candidateIndexes, numberCandidates, pairScoresGpuPtr,
+                    peaksGpuPtr, bodyPartPairsGpuPtr, maxPeaks, numberPeaks, numberPairScores);
+                const auto candidateScoresThrustPtr = thrust::device_pointer_cast(workspace.candidateScores);
+                thrust::stable_sort_by_key(
+                    thrust::cuda::par.on(cudaStream), candidateScoresThrustPtr,
+                    candidateScoresThrustPtr + numberCandidates,
+                    candidateIndexesThrustPtr, thrust::greater<T>());
+            }
+            // 3. Greedy people assembly (equivalent to pafVectorIntoPeopleVector)
+            assemblePeopleKernel<<<1, ASSEMBLY_THREADS, 0, cudaStream>>>(
+                workspace.peopleParts, workspace.peopleScores, workspace.peopleRemoved, workspace.numberPeople,
+                workspace.personAssigned, workspace.candidateIndexes, numberCandidates, pairScoresGpuPtr,
+                peaksGpuPtr, bodyPartPairsGpuPtr, maxPeaks, numberPeaks, numberBodyParts, maxPeople,
+                (numberPeopleMax > 0 ? CONNECTOR_PEOPLE_MAX_FACTOR*numberPeopleMax : -1), minSubsetCnt,
+                minSubsetScore);
+            int numberPeopleCandidates;
+            cudaMemcpyAsync(
+                &numberPeopleCandidates, workspace.numberPeople, sizeof(int), cudaMemcpyDeviceToHost, cudaStream);
+            cudaStreamSynchronize(cudaStream);
+            // 4. Delete people below thresholds (equivalent to removePeopleBelowThresholdsAndFillFaces)
+            const auto validIndexesThrustPtr = thrust::device_pointer_cast(workspace.validIndexes);
+            auto numberPeople = 0;
+            for (const auto maximizePositivesIteration : {maximizePositives, true})
+            {
+                if (numberPeopleCandidates > 0)
+                {
+                    removePeopleBelowThresholdsKernel<<<
+                        getNumberCudaBlocks(numberPeopleCandidates), CUDA_NUM_THREADS, 0, cudaStream>>>(
+                        workspace.peopleValid, workspace.peopleParts, workspace.peopleScores,
+                        workspace.peopleRemoved, numberPeopleCandidates, numberBodyParts, minSubsetCnt,
+                        minSubsetScore, maximizePositivesIteration);
+                    numberPeople = (int)(thrust::copy_if(
+                        thrust::cuda::par.on(cudaStream),
+                        thrust::counting_iterator<int>(0), thrust::counting_iterator<int>(numberPeopleCandidates),
+                        validIndexesThrustPtr, IsValidPerson{workspace.peopleValid}) - validIndexesThrustPtr);
+                }
+                // If no people found --> Repeat with maximizePositives = true
+                if (numberPeople > 0 || maximizePositivesIteration)
+                    break;
+            }
+            // Keep only the top numberPeopleMax people (equivalent to keepTopPeopleIndexes)
+            if (numberPeopleMax > 0 && numberPeople > numberPeopleMax)
+            {
+                // workspace.scores is only filled later (in step 5), so it can hold the sorting keys
+                topPeopleScoresKernel<<<getNumberCudaBlocks(numberPeople), CUDA_NUM_THREADS, 0, cudaStream>>>(
+                    workspace.scores, workspace.validIndexes, workspace.peopleParts, workspace.peopleScores,
+                    peaksGpuPtr, numberPeople, numberBodyParts);
+                // Stable, so ties keep the lowest indexes (validIndexes is sorted)
+                const auto scoresThrustPtr = thrust::device_pointer_cast(workspace.scores);
+                thrust::stable_sort_by_key(
+                    thrust::cuda::par.on(cudaStream), scoresThrustPtr, scoresThrustPtr + numberPeople,
+                    validIndexesThrustPtr, thrust::greater<T>());
+                // Kept in their original order
+                numberPeople = numberPeopleMax;
+                thrust::sort(
+                    thrust::cuda::par.on(cudaStream), validIndexesThrustPtr, validIndexesThrustPtr + numberPeople);
+            }
+            // 5. Fill and download poseKeypoints and poseScores (equivalent to peopleVectorToPeopleArray)
+            if (numberPeople > 0)
+            {
+                poseKeypoints.resetPinned({numberPeople, numberBodyParts, 3});
+                poseScores.resetPinned({numberPeople});
+                peopleToKeypointsKernel<<<
+                    getNumberCudaBlocks(numberPeople*numberBodyParts), CUDA_NUM_THREADS, 0, cudaStream>>>(
+                    workspace.keypoints, workspace.scores, workspace.validIndexes, workspace.peopleParts,
+                    workspace.peopleScores, peaksGpuPtr, numberPeople, numberBodyParts, scaleFactor,
+                    1/T(numberBodyParts + numberBodyPartPairs));
+                cudaMemcpyAsync(poseKeypoints.getPtr(), workspace.keypoints, poseKeypoints.getVolume() * sizeof(T),
+                                cudaMemcpyDeviceToHost, cudaStream);
+                cudaMemcpyAsync(poseScores.getPtr(), workspace.scores, poseScores.getVolume() * sizeof(T),
+                                cudaMemcpyDeviceToHost, cudaStream);
+                cudaStreamSynchronize(cudaStream);
+            }
+            else
+            {
+                poseKeypoints.reset();
+                poseScores.reset();
+            }
+            // Sanity check
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    unsigned long long getConnectBodyPartsGpuWorkspaceBytes(const PoseModel poseModel, const int maxPeaks)
+    {
+        try
+        {
+            // Face keypoints require the CPU face merging of removePeopleBelowThresholdsAndFillFaces
+            const auto numberBodyParts = (int)getPoseNumberBodyParts(poseModel);
+            if (numberBodyParts >= 135)
+                return 0ull;
+            const auto numberBodyPartPairs = (int)(getPosePartPairs(poseModel).size() / 2);
+            return getAssemblyWorkspace<T>(nullptr, numberBodyParts, numberBodyPartPairs, maxPeaks).bytes;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    // It queues the PAF scoring of all the pairs of peaks into pairScoresGpuPtr. TPaf = T or __half
+    // The pair scores are stored as [numberBodyPartPairs x numberPeaks x numberPeaks], where numberPeaks (<= maxPeaks)
+    // is the maximum number of peaks of any body part of the current frame, while peaksGpuPtr keeps its maxPeaks
+    // layout. So the launched threads (and the later download and assembly) scale with the actual detections rather
+    // than with the worst case (POSE_MAX_PEOPLE)
+    template <BlobLayout TLayout, typename T, typename TPaf>
+    void pafScoreGpu(
+        T* pairScoresGpuPtr, const TPaf* const pafGpuPtr, const Point<int>& heatMapSize, const Point<int>& pafSize,
+        const T* const peaksGpuPtr, const unsigned int* const bodyPartPairsGpuPtr,
+        const unsigned int* const mapIdxGpuPtr, const int maxPeaks, const int numberPeaks,
+        const unsigned int numberBodyPartPairs, const unsigned int totalComputations, const T interMinAboveThreshold,
+        const T interThreshold, const T defaultNmsThreshold, CUstream_st* const cudaStream,
+        int* const pafCandidatesGpuPtr, const T maxLimbLength, const T minPeakScore, const int pafChannels)
+    {
+        try
+        {
+            const dim3 THREADS_PER_BLOCK{128, 1, 1};
+            const dim3 numBlocks{
+                getNumberCudaBlocks(numberPeaks, THREADS_PER_BLOCK.x),
+                getNumberCudaBlocks(numberPeaks, THREADS_PER_BLOCK.y),
+                getNumberCudaBlocks(numberBodyPartPairs, THREADS_PER_BLOCK.z)};
+            // Sparse code: The line integral only runs over the compacted list of plausible candidates, rather than
+            // over 1 thread per (pair, peak A, peak B), most of them without peaks or too far apart
+            if (pafCandidatesGpuPtr != nullptr)
+            {
+                // maxLimbLength is relative to the heat map diagonal, no peaks are further apart than 1 diagonal
+                const auto heatMapDiagonal = std::sqrt(T(heatMapSize.x*heatMapSize.x + heatMapSize.y*heatMapSize.y));
+                const auto maxLimbLengthSquared = (maxLimbLength < 1
+                    ? maxLimbLength*maxLimbLength*heatMapDiagonal*heatMapDiagonal : std::numeric_limits<T>::max());
+                cudaMemsetAsync(pafCandidatesGpuPtr, 0, sizeof(int), cudaStream);
+                pafCandidatesKernel<<<numBlocks, THREADS_PER_BLOCK, 0, cudaStream>>>(
+                    pafCandidatesGpuPtr, pairScoresGpuPtr, peaksGpuPtr, bodyPartPairsGpuPtr, maxPeaks, numberPeaks,
+                    maxLimbLengthSquared, minPeakScore);
+                const auto numBlocksSparse = std::min(
+                    getNumberCudaBlocks(totalComputations, THREADS_PER_BLOCK.x), PAF_SPARSE_MAX_BLOCKS);
+                pafScoreSparseKernel<TLayout><<<numBlocksSparse, THREADS_PER_BLOCK.x, 0, cudaStream>>>(
+                    pairScoresGpuPtr, pafCandidatesGpuPtr, pafGpuPtr, peaksGpuPtr, bodyPartPairsGpuPtr,
+                    mapIdxGpuPtr, maxPeaks, numberPeaks, heatMapSize.x, heatMapSize.y, interThreshold,
+                    interMinAboveThreshold, defaultNmsThreshold, pafSize.x, pafSize.y, pafChannels);
+            }
+            else
+                pafScoreKernel<TLayout><<<numBlocks, THREADS_PER_BLOCK, 0, cudaStream>>>(
+                    pairScoresGpuPtr, pafGpuPtr, peaksGpuPtr, bodyPartPairsGpuPtr, mapIdxGpuPtr,
+                    maxPeaks, numberPeaks, (int)numberBodyPartPairs, heatMapSize.x, heatMapSize.y, interThreshold,
+                    interMinAboveThreshold, defaultNmsThreshold, pafSize.x, pafSize.y, pafChannels);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    // THeatMap = T or __half. The PAF scores and the people assembly are computed in T
+    template <typename T, typename THeatMap>
+    void connectBodyPartsGpuTemplate(
+        Array<T>& poseKeypoints, Array<T>& poseScores, const THeatMap* const heatMapGpuPtr, const T* const peaksPtr,
         const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks, const T interMinAboveThreshold,
         const T interThreshold, const int minSubsetCnt, const T minSubsetScore, const T defaultNmsThreshold,
-        const T scaleFactor, const bool maximizePositives, Array<T> pairScoresCpu, T* pairScoresGpuPtr,
+        const T scaleFactor, const bool maximizePositives, Array<T>& pairScoresCpu, T* pairScoresGpuPtr,
         const unsigned int* const bodyPartPairsGpuPtr, const unsigned int* const mapIdxGpuPtr,
-        const T* const peaksGpuPtr)
+        const T* const peaksGpuPtr, void* const assemblyWorkspaceGpuPtr, CUstream_st* const cudaStream,
+        const int numberPeopleMax, int* const pafCandidatesGpuPtr, const T maxLimbLength, const T minPeakScore,
+        const T* const pafGpuPtr, const Point<int>& pafSize, const BlobLayout pafLayout, const int pafChannels)
     {
         try
         {
@@ -159,7 +869,6 @@ namespace op
             const auto& bodyPartPairs = getPosePartPairs(poseModel);
             const auto numberBodyParts = getPoseNumberBodyParts(poseModel);
             const auto numberBodyPartPairs = (unsigned int)(bodyPartPairs.size() / 2);
-            const auto totalComputations = pairScoresCpu.getVolume();
 
             if (numberBodyParts == 0)
                 error("Invalid value of numberBodyParts, it must be positive, not " + std::to_string(numberBodyParts),
@@ -168,6 +877,35 @@ namespace op
                 error("The pointers bodyPartPairsGpuPtr and mapIdxGpuPtr cannot be nullptr.",
                       __LINE__, __FUNCTION__, __FILE__);
 
+            // Effective number of peaks (pairScoresCpu and pairScoresGpuPtr keep the maxPeaks capacity)
+            auto numberPeaks = 0;
+            if (peaksPtr != nullptr)
+            {
+                const auto peaksOffset = 3*(maxPeaks+1);
+                for (auto part = 0u ; part < numberBodyParts ; part++)
+                    numberPeaks = fastMax(numberPeaks, positiveIntRound(peaksPtr[part*peaksOffset]));
+            }
+            // GPU people assembly: The peaks are only on GPU, so only their maximum counter is downloaded
+            else
+            {
+                const auto workspace = getAssemblyWorkspace<T>(
+                    assemblyWorkspaceGpuPtr, (int)numberBodyParts, (int)numberBodyPartPairs, maxPeaks);
+                numberPeaksKernel<<<1, CUDA_NUM_THREADS, 0, cudaStream>>>(
+                    workspace.numberPeaks, peaksGpuPtr, (int)numberBodyParts, maxPeaks);
+                cudaMemcpyAsync(
+                    &numberPeaks, workspace.numberPeaks, sizeof(int), cudaMemcpyDeviceToHost, cudaStream);
+                cudaStreamSynchronize(cudaStream);
+            }
+            numberPeaks = fastMin(numberPeaks, maxPeaks);
+            // No peaks --> No people
+            if (numberPeaks == 0)
+            {
+                poseKeypoints.reset();
+                poseScores.reset();
+                return;
+            }
+            const auto totalComputations = numberBodyPartPairs*numberPeaks*numberPeaks;
+
             // const auto REPS = 1000;
             // double timeNormalize0 = 0.;
             // double timeNormalize1 = 0.;
@@ -193,25 +931,54 @@ namespace op
             // Efficient code
             // OP_CUDA_PROFILE_INIT(REPS);
             // Run Kernel - pairScoresGpu
-            const dim3 THREADS_PER_BLOCK{128, 1, 1};
-            const dim3 numBlocks{
-                getNumberCudaBlocks(maxPeaks, THREADS_PER_BLOCK.x),
-                getNumberCudaBlocks(maxPeaks, THREADS_PER_BLOCK.y),
-                getNumberCudaBlocks(numberBodyPartPairs, THREADS_PER_BLOCK.z)};
-            pafScoreKernel<<<numBlocks, THREADS_PER_BLOCK>>>(
-                pairScoresGpuPtr, heatMapGpuPtr, peaksGpuPtr, bodyPartPairsGpuPtr, mapIdxGpuPtr,
-                maxPeaks, (int)numberBodyPartPairs, heatMapSize.x, heatMapSize.y, interThreshold,
-                interMinAboveThreshold, defaultNmsThreshold);
-            // pairScoresCpu <-- pairScoresGpu
-            cudaMemcpy(pairScoresCpu.getPtr(), pairScoresGpuPtr, totalComputations * sizeof(T),
-                       cudaMemcpyDeviceToHost);
+            // Network resolution PAFs: They are read from pafGpuPtr (FP32) with bilinear interpolation, in its own
+            // memory layout (e.g., the channel-last output of the network)
+            if (pafGpuPtr != nullptr && pafLayout == BlobLayout::Nhwc)
+                pafScoreGpu<BlobLayout::Nhwc>(
+                    pairScoresGpuPtr, pafGpuPtr, heatMapSize, pafSize, peaksGpuPtr, bodyPartPairsGpuPtr,
+                    mapIdxGpuPtr, maxPeaks, numberPeaks, numberBodyPartPairs, (unsigned int)totalComputations,
+                    interMinAboveThreshold, interThreshold, defaultNmsThreshold, cudaStream, pafCandidatesGpuPtr,
+                    maxLimbLength, minPeakScore, pafChannels);
+            else if (pafGpuPtr != nullptr)
+                pafScoreGpu<BlobLayout::Nchw>(
+                    pairScoresGpuPtr, pafGpuPtr, heatMapSize, pafSize, peaksGpuPtr, bodyPartPairsGpuPtr,
+                    mapIdxGpuPtr, maxPeaks, numberPeaks, numberBodyPartPairs, (unsigned int)totalComputations,
+                    interMinAboveThreshold, interThreshold, defaultNmsThreshold, cudaStream, pafCandidatesGpuPtr,
+                    maxLimbLength, minPeakScore, pafChannels);
+            else
+                pafScoreGpu<BlobLayout::Nchw>(
+                    pairScoresGpuPtr, heatMapGpuPtr, heatMapSize, Point<int>{0, 0}, peaksGpuPtr, bodyPartPairsGpuPtr,
+                    mapIdxGpuPtr, maxPeaks, numberPeaks, numberBodyPartPairs, (unsigned int)totalComputations,
+                    interMinAboveThreshold, interThreshold, defaultNmsThreshold, cudaStream, pafCandidatesGpuPtr,
+                    maxLimbLength, minPeakScore, 0);
             // OP_PROFILE_END(timeNormalize2, 1e3, REPS);
 
+            // GPU people assembly: Only poseKeypoints and poseScores are downloaded
+            if (assemblyWorkspaceGpuPtr != nullptr)
+            {
+                connectBodyPartsGpuAssembly(
+                    poseKeypoints, poseScores, poseModel, maxPeaks, numberPeaks, minSubsetCnt, minSubsetScore,
+                    scaleFactor, maximizePositives, pairScoresGpuPtr, bodyPartPairsGpuPtr, peaksGpuPtr,
+                    assemblyWorkspaceGpuPtr, cudaStream, numberPeopleMax);
+                return;
+            }
+
+            // pairScoresCpu <-- pairScoresGpu (only the numberPeaks x numberPeaks scores of each pair)
+            // Integrated GPU (zero-copy): pairScoresGpuPtr is the mapped pairScoresCpu itself, so the kernels only
+            // have to finish
+            if (pairScoresGpuPtr != pairScoresCpu.getPtr())
+                cudaMemcpyAsync(pairScoresCpu.getPtr(), pairScoresGpuPtr, totalComputations * sizeof(T),
+                                cudaMemcpyDeviceToHost, cudaStream);
+            cudaStreamSynchronize(cudaStream);
+            const Array<T> pairScoresUsedCpu{
+                {(int)numberBodyPartPairs, numberPeaks, numberPeaks}, pairScoresCpu.getPtr()};
+
             // Get pair connections and their scores
             const auto pairConnections = pafPtrIntoVector(
-                pairScoresCpu, peaksPtr, maxPeaks, bodyPartPairs, numberBodyPartPairs);
+                pairScoresUsedCpu, peaksPtr, maxPeaks, bodyPartPairs, numberBodyPartPairs);
             auto peopleVector = pafVectorIntoPeopleVector(
-                pairConnections, peaksPtr, maxPeaks, bodyPartPairs, numberBodyParts);
+                pairConnections, peaksPtr, maxPeaks, bodyPartPairs, numberBodyParts, numberPeopleMax, minSubsetCnt,
+                minSubsetScore);
             // // Old code: Get pair connections and their scores
             // // std::vector<std::pair<std::vector<int>, double>> refers to:
             // //     - std::vector<int>: [body parts locations, #body parts found]
@@ -231,6 +998,9 @@ namespace op
             removePeopleBelowThresholdsAndFillFaces(
                 validSubsetIndexes, numberPeople, peopleVector, numberBodyParts, minSubsetCnt, minSubsetScore,
                 maximizePositives, peaksPtr);
+            // Keep only the top numberPeopleMax people
+            keepTopPeopleIndexes(
+                validSubsetIndexes, numberPeople, peopleVector, numberBodyParts, peaksPtr, numberPeopleMax);
             // Fill and return poseKeypoints
             peopleVectorToPeopleArray(
                 poseKeypoints, poseScores, scaleFactor, peopleVector, validSubsetIndexes, peaksPtr, numberPeople,
@@ -249,6 +1019,58 @@ namespace op
         }
     }
 
+    template <typename T>
+    void connectBodyPartsGpu(
+        Array<T>& poseKeypoints, Array<T>& poseScores, const T* const heatMapGpuPtr, const T* const peaksPtr,
+        const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks, const T interMinAboveThreshold,
+        const T interThreshold, const int minSubsetCnt, const T minSubsetScore, const T defaultNmsThreshold,
+        const T scaleFactor, const bool maximizePositives, Array<T> pairScoresCpu, T* pairScoresGpuPtr,
+        const unsigned int* const bodyPartPairsGpuPtr, const unsigned int* const mapIdxGpuPtr,
+        const T* const peaksGpuPtr, void* const assemblyWorkspaceGpuPtr, CUstream_st* const cudaStream,
+        const int numberPeopleMax, int* const pafCandidatesGpuPtr, const T maxLimbLength, const T minPeakScore,
+        const T* const pafGpuPtr, const Point<int>& pafSize, const BlobLayout pafLayout, const int pafChannels)
+    {
+        try
+        {
+            connectBodyPartsGpuTemplate(
+                poseKeypoints, poseScores, heatMapGpuPtr, peaksPtr, poseModel, heatMapSize, maxPeaks,
+                interMinAboveThreshold, interThreshold, minSubsetCnt, minSubsetScore, defaultNmsThreshold, scaleFactor,
+                maximizePositives, pairScoresCpu, pairScoresGpuPtr, bodyPartPairsGpuPtr, mapIdxGpuPtr, peaksGpuPtr,
+                assemblyWorkspaceGpuPtr, cudaStream, numberPeopleMax, pafCandidatesGpuPtr, maxLimbLength, minPeakScore,
+                pafGpuPtr, pafSize, pafLayout, pafChannels);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void connectBodyPartsGpu(
+        Array<T>& poseKeypoints, Array<T>& poseScores, const __half* const heatMapGpuPtr, const T* const peaksPtr,
+        const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks, const T interMinAboveThreshold,
+        const T interThreshold, const int minSubsetCnt, const T minSubsetScore, const T defaultNmsThreshold,
+        const T scaleFactor, const bool maximizePositives, Array<T> pairScoresCpu, T* pairScoresGpuPtr,
+        const unsigned int* const bodyPartPairsGpuPtr, const unsigned int* const mapIdxGpuPtr,
+        const T* const peaksGpuPtr, void* const assemblyWorkspaceGpuPtr, CUstream_st* const cudaStream,
+        const int numberPeopleMax, int* const pafCandidatesGpuPtr, const T maxLimbLength, const T minPeakScore,
+        const T* const pafGpuPtr, const Point<int>& pafSize, const BlobLayout pafLayout, const int pafChannels)
+    {
+        try
+        {
+            connectBodyPartsGpuTemplate(
+                poseKeypoints, poseScores, heatMapGpuPtr, peaksPtr, poseModel, heatMapSize, maxPeaks,
+                interMinAboveThreshold, interThreshold, minSubsetCnt, minSubsetScore, defaultNmsThreshold, scaleFactor,
+                maximizePositives, pairScoresCpu, pairScoresGpuPtr, bodyPartPairsGpuPtr, mapIdxGpuPtr, peaksGpuPtr,
+                assemblyWorkspaceGpuPtr, cudaStream, numberPeopleMax, pafCandidatesGpuPtr, maxLimbLength, minPeakScore,
+                pafGpuPtr, pafSize, pafLayout, pafChannels);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template void connectBodyPartsGpu(
         Array<float>& poseKeypoints, Array<float>& poseScores, const float* const heatMapGpuPtr,
         const float* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks,
@@ -256,7 +1078,10 @@ namespace op
         const float minSubsetScore, const float scaleFactor, const float defaultNmsThreshold,
         const bool maximizePositives, Array<float> pairScoresCpu, float* pairScoresGpuPtr,
         const unsigned int* const bodyPartPairsGpuPtr, const unsigned int* const mapIdxGpuPtr,
-        const float* const peaksGpuPtr);
+        const float* const peaksGpuPtr, void* const assemblyWorkspaceGpuPtr, CUstream_st* const cudaStream,
+        const int numberPeopleMax, int* const pafCandidatesGpuPtr, const float maxLimbLength,
+        const float minPeakScore, const float* const pafGpuPtr, const Point<int>& pafSize,
+        const BlobLayout pafLayout, const int pafChannels);
     template void connectBodyPartsGpu(
         Array<double>& poseKeypoints, Array<double>& poseScores, const double* const heatMapGpuPtr,
         const double* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks,
@@ -264,5 +1089,34 @@ namespace op
         const double minSubsetScore, const double scaleFactor, const double defaultNmsThreshold,
         const bool maximizePositives, Array<double> pairScoresCpu, double* pairScoresGpuPtr,
         const unsigned int* const bodyPartPairsGpuPtr, const unsigned int* const mapIdxGpuPtr,
-        const double* const peaksGpuPtr);
+        const double* const peaksGpuPtr, void* const assemblyWorkspaceGpuPtr, CUstream_st* const cudaStream,
+        const int numberPeopleMax, int* const pafCandidatesGpuPtr, const double maxLimbLength,
+        const double minPeakScore, const double* const pafGpuPtr, const Point<int>& pafSize,
+        const BlobLayout pafLayout, const int pafChannels);
+    template void connectBodyPartsGpu(
+        Array<float>& poseKeypoints, Array<float>& poseScores, const __half* const heatMapGpuPtr,
+        const float* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks,
+        const float interMinAboveThreshold, const float interThreshold, const int minSubsetCnt,
+        const float minSubsetScore, const float scaleFactor, const float defaultNmsThreshold,
+        const bool maximizePositives, Array<float> pairScoresCpu, float* pairScoresGpuPtr,
+        const unsigned int* const bodyPartPairsGpuPtr, const unsigned int* const mapIdxGpuPtr,
+        const float* const peaksGpuPtr, void* const assemblyWorkspaceGpuPtr, CUstream_st* const cudaStream,
+        const int numberPeopleMax, int* const pafCandidatesGpuPtr, const float maxLimbLength,
+        const float minPeakScore, const float* const pafGpuPtr, const Point<int>& pafSize,
+        const BlobLayout pafLayout, const int pafChannels);
+    template void connectBodyPartsGpu(
+        Array<double>& poseKeypoints, Array<double>& poseScores, const __half* const heatMapGpuPtr,
+        const double* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks,
+        const double interMinAboveThreshold, const double interThreshold, const int minSubsetCnt,
+        const double minSubsetScore, const double scaleFactor, const double defaultNmsThreshold,
+        const bool maximizePositives, Array<double> pairScoresCpu, double* pairScoresGpuPtr,
+        const unsigned int* const bodyPartPairsGpuPtr, const unsigned int* const mapIdxGpuPtr,
+        const double* const peaksGpuPtr, void* const assemblyWorkspaceGpuPtr, CUstream_st* const cudaStream,
+        const int numberPeopleMax, int* const pafCandidatesGpuPtr, const double maxLimbLength,
+        const double minPeakScore, const double* const pafGpuPtr, const Point<int>& pafSize,
+        const BlobLayout pafLayout, const int pafChannels);
+    template unsigned long long getConnectBodyPartsGpuWorkspaceBytes<float>(
+        const PoseModel poseModel, const int maxPeaks);
+    template unsigned long long getConnectBodyPartsGpuWorkspaceBytes<double>(
+        const PoseModel poseModel, const int maxPeaks);
 }
@@ -125,7 +125,7 @@ namespace op
         const T interThreshold, const int minSubsetCnt, const T minSubsetScore, const T defaultNmsThreshold,
         const T scaleFactor, const bool maximizePositives, Array<T> pairScoresCpu, T* pairScoresGpuPtr,
         const unsigned int* const bodyPartPairsGpuPtr, const unsigned int* const mapIdxGpuPtr,
-        const T* const peaksGpuPtr, const int gpuID)
+        const T* const peaksGpuPtr, const int gpuID, const int numberPeopleMax)
     {
         try
         {
@@ -153,21 +153,28 @@ namespace op
                 cl::Buffer bodyPartPairsGpuPtrBuffer = cl::Buffer((cl_mem)(bodyPartPairsGpuPtr), true);
                 cl::Buffer mapIdxGpuPtrBuffer = cl::Buffer((cl_mem)(mapIdxGpuPtr), true);
 
+                auto& queue = OpenCL::getInstance(gpuID)->getPostProcessingQueueAfterNetwork();
+
                 // PAF Kernel Runtime
                 pafScoreKernel(
-                    cl::EnqueueArgs(OpenCL::getInstance(gpuID)->getQueue(), cl::NDRange(numberBodyPartPairs,maxPeaks,maxPeaks)),
+                    cl::EnqueueArgs(queue, cl::NDRange(numberBodyPartPairs,maxPeaks,maxPeaks)),
                     pairScoresGpuPtrBuffer, heatMapGpuPtrBuffer, peaksGpuPtrBuffer, bodyPartPairsGpuPtrBuffer, mapIdxGpuPtrBuffer,
                     maxPeaks, (int)numberBodyPartPairs, heatMapSize.x, heatMapSize.y, interThreshold,
                     interMinAboveThreshold, defaultNmsThreshold);
-                OpenCL::getInstance(gpuID)->getQueue().enqueueReadBuffer(
-                    pairScoresGpuPtrBuffer, CL_TRUE, 0, totalComputations * sizeof(T), pairScoresCpu.getPtr());
+                // The pair scores are read in place, mapping is zero-copy with unified memory (see
+                // bodyPartConnectorCaffe.cpp) and a single download otherwise
+                auto* const pairScoresMappedPtr = (T*)queue.enqueueMapBuffer(
+                    pairScoresGpuPtrBuffer, CL_TRUE, CL_MAP_READ, 0, totalComputations * sizeof(T));
+                const Array<T> pairScoresMappedCpu{pairScoresCpu.getSize(), pairScoresMappedPtr};
 
                 // New code
                 // Get pair connections and their scores
                 const auto pairConnections = pafPtrIntoVector(
-                    pairScoresCpu, peaksPtr, maxPeaks, bodyPartPairs, numberBodyPartPairs);
+                    pairScoresMappedCpu, peaksPtr, maxPeaks, bodyPartPairs, numberBodyPartPairs);
+                queue.enqueueUnmapMemObject(pairScoresGpuPtrBuffer, pairScoresMappedPtr);
                 auto peopleVector = pafVectorIntoPeopleVector(
-                    pairConnections, peaksPtr, maxPeaks, bodyPartPairs, numberBodyParts);
+                    pairConnections, peaksPtr, maxPeaks, bodyPartPairs, numberBodyParts, numberPeopleMax,
+                    minSubsetCnt, minSubsetScore);
                 // // Old code
                 // // Get pair connections and their scores
                 // // std::vector<std::pair<std::vector<int>, double>> refers to:
@@ -187,6 +194,9 @@ namespace op
                 removePeopleBelowThresholdsAndFillFaces(
                     validSubsetIndexes, numberPeople, peopleVector, numberBodyParts, minSubsetCnt, minSubsetScore,
                     maximizePositives, peaksPtr);
+                // Keep only the top numberPeopleMax people
+                keepTopPeopleIndexes(
+                    validSubsetIndexes, numberPeople, peopleVector, numberBodyParts, peaksPtr, numberPeopleMax);
                 // Fill and return poseKeypoints
                 peopleVectorToPeopleArray(
                     poseKeypoints, poseScores, scaleFactor, peopleVector, validSubsetIndexes, peaksPtr, numberPeople,
@@ -212,6 +222,7 @@ namespace op
                 UNUSED(mapIdxGpuPtr);
                 UNUSED(peaksGpuPtr);
                 UNUSED(gpuID);
+                UNUSED(numberPeopleMax);
             #endif
         }
         catch (const std::exception& e)
@@ -227,7 +238,7 @@ namespace op
         const float defaultNmsThreshold, const float minSubsetScore, const float scaleFactor,
         const bool maximizePositives, Array<float> pairScoresCpu, float* pairScoresGpuPtr,
         const unsigned int* const bodyPartPairsGpuPtr, const unsigned int* const mapIdxGpuPtr,
-        const float* const peaksGpuPtr, const int gpuID);
+        const float* const peaksGpuPtr, const int gpuID, const int numberPeopleMax);
     template void connectBodyPartsOcl(
         Array<double>& poseKeypoints, Array<double>& poseScores, const double* const heatMapGpuPtr,
         const double* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks,
@@ -235,5 +246,5 @@ namespace op
         const double defaultNmsThreshold, const double minSubsetScore, const double scaleFactor,
         const bool maximizePositives, Array<double> pairScoresCpu, double* pairScoresGpuPtr,
         const unsigned int* const bodyPartPairsGpuPtr, const unsigned int* const mapIdxGpuPtr,
-        const double* const peaksGpuPtr, const int gpuID);
+        const double* const peaksGpuPtr, const int gpuID, const int numberPeopleMax);
 }
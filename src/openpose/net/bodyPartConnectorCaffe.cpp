@@ -3,11 +3,14 @@
     #include <caffe/blob.hpp>
 #endif
 #ifdef USE_CUDA
+    #include <openpose/core/pinnedMemory.hpp>
     #include <openpose/gpu/cuda.hpp>
     #include <openpose_private/gpu/cuda.hu>
 #endif
+#include <openpose/gpu/cudaMemoryPool.hpp>
 #include <openpose/net/bodyPartConnectorBase.hpp>
 #include <openpose/pose/poseParameters.hpp>
+#include <openpose/utilities/tracer.hpp>
 #ifdef USE_OPENCL
     #include <openpose_private/gpu/opencl.hcl>
     #include <openpose_private/gpu/cl2.hpp>
@@ -19,9 +22,19 @@ namespace op
     BodyPartConnectorCaffe<T>::BodyPartConnectorCaffe() :
         mPoseModel{PoseModel::Size},
         mMaximizePositives{false},
+        mMaxLimbLength{1},
+        mMinPeakScore{0},
+        mNumberPeopleMax{-1},
         pBodyPartPairsGpuPtr{nullptr},
         pMapIdxGpuPtr{nullptr},
-        pFinalOutputGpuPtr{nullptr}
+        pFinalOutputGpuPtr{nullptr},
+        mFinalOutputZeroCopy{false},
+        pAssemblyWorkspaceGpuPtr{nullptr},
+        pPafCandidatesGpuPtr{nullptr},
+        pCudaStream{nullptr},
+        pHeatMapsHalfGpuPtr{nullptr},
+        pLowResolutionPafs{nullptr},
+        mLowResolutionLayout{BlobLayout::Nchw}
     {
         try
         {
@@ -45,19 +58,30 @@ namespace op
                 cudaCheck(__LINE__, __FUNCTION__, __FILE__);
                 if (pBodyPartPairsGpuPtr != nullptr)
                 {
-                    cudaFree(pBodyPartPairsGpuPtr);
+                    cudaPoolFree(pBodyPartPairsGpuPtr);
                     pBodyPartPairsGpuPtr = nullptr;
                 }
                 if (pMapIdxGpuPtr != nullptr)
                 {
-                    cudaFree(pMapIdxGpuPtr);
+                    cudaPoolFree(pMapIdxGpuPtr);
                     pMapIdxGpuPtr = nullptr;
                 }
-                if (pFinalOutputGpuPtr != nullptr)
+                // Zero-copy: It is mFinalOutputCpu itself
+                if (pFinalOutputGpuPtr != nullptr && !mFinalOutputZeroCopy)
                 {
-                    cudaFree(pFinalOutputGpuPtr);
+                    cudaPoolFree(pFinalOutputGpuPtr);
                     pFinalOutputGpuPtr = nullptr;
                 }
+                if (pAssemblyWorkspaceGpuPtr != nullptr)
+                {
+                    cudaPoolFree(pAssemblyWorkspaceGpuPtr);
+                    pAssemblyWorkspaceGpuPtr = nullptr;
+                }
+                if (pPafCandidatesGpuPtr != nullptr)
+                {
+                    cudaPoolFree(pPafCandidatesGpuPtr);
+                    pPafCandidatesGpuPtr = nullptr;
+                }
                 cudaCheck(__LINE__, __FUNCTION__, __FILE__);
             #endif
         }
@@ -72,6 +96,7 @@ namespace op
     {
         try
         {
+            const CudaMemoryOwner cudaMemoryOwner{"BodyPartConnectorCaffe"};
             #ifdef USE_CAFFE
                 auto heatMapsBlob = bottom.at(0);
                 auto peaksBlob = bottom.at(1);
@@ -188,6 +213,45 @@ namespace op
         }
     }
 
+    template <typename T>
+    void BodyPartConnectorCaffe<T>::setMaxLimbLength(const T maxLimbLength)
+    {
+        try
+        {
+            mMaxLimbLength = {maxLimbLength};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void BodyPartConnectorCaffe<T>::setMinPeakScore(const T minPeakScore)
+    {
+        try
+        {
+            mMinPeakScore = {minPeakScore};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void BodyPartConnectorCaffe<T>::setNumberPeopleMax(const int numberPeopleMax)
+    {
+        try
+        {
+            mNumberPeopleMax = {numberPeopleMax};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template <typename T>
     void BodyPartConnectorCaffe<T>::setScaleNetToOutput(const T scaleNetToOutput)
     {
@@ -201,12 +265,54 @@ namespace op
         }
     }
 
+    template <typename T>
+    void BodyPartConnectorCaffe<T>::setCudaStream(CUstream_st* cudaStream)
+    {
+        try
+        {
+            pCudaStream = cudaStream;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void BodyPartConnectorCaffe<T>::setLowResolutionPafs(
+        ArrayCpuGpu<T>* lowResolutionPafs, const BlobLayout lowResolutionLayout)
+    {
+        try
+        {
+            pLowResolutionPafs = lowResolutionPafs;
+            mLowResolutionLayout = lowResolutionLayout;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void BodyPartConnectorCaffe<T>::setHalfPrecisionHeatMaps(const __half* heatMapsHalfGpuPtr)
+    {
+        try
+        {
+            pHeatMapsHalfGpuPtr = heatMapsHalfGpuPtr;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template <typename T>
     void BodyPartConnectorCaffe<T>::Forward(const std::vector<ArrayCpuGpu<T>*>& bottom, Array<T>& poseKeypoints,
                                             Array<T>& poseScores)
     {
         try
         {
+            const CudaMemoryOwner cudaMemoryOwner{"BodyPartConnectorCaffe"};
             // CUDA
             #ifdef USE_CUDA
                 Forward_gpu(bottom, poseKeypoints, poseScores);
@@ -239,7 +345,7 @@ namespace op
                     poseKeypoints, poseScores, heatMapsPtr, peaksPtr, mPoseModel,
                     Point<int>{heatMapsBlob->shape(3), heatMapsBlob->shape(2)}, maxPeaks, mInterMinAboveThreshold,
                     mInterThreshold, mMinSubsetCnt, mMinSubsetScore, mDefaultNmsThreshold, mScaleNetToOutput,
-                    mMaximizePositives);
+                    mMaximizePositives, mNumberPeopleMax);
             #else
                 UNUSED(bottom);
                 UNUSED(poseKeypoints);
@@ -301,9 +407,12 @@ namespace op
                     // Allocate memory
                     mFinalOutputCpu.reset({(int)numberBodyPartPairs, maxPeaks, maxPeaks});
                     const auto totalComputations = mFinalOutputCpu.getVolume();
+                    // Mapped by the host on each frame, so it is host memory with unified memory
+                    const auto openCl = OpenCL::getInstance(mGpuID);
                     if (pFinalOutputGpuPtr == nullptr)
                         pFinalOutputGpuPtr = (T*)clCreateBuffer(
-                            OpenCL::getInstance(mGpuID)->getContext().operator()(), CL_MEM_READ_WRITE,
+                            openCl->getContext().operator()(),
+                            CL_MEM_READ_WRITE | (openCl->hasUnifiedMemory() ? CL_MEM_ALLOC_HOST_PTR : 0),
                             totalComputations * sizeof(T), NULL, NULL);
                 }
 
@@ -313,7 +422,7 @@ namespace op
                     Point<int>{heatMapsBlob->shape(3), heatMapsBlob->shape(2)}, maxPeaks, mInterMinAboveThreshold,
                     mInterThreshold, mMinSubsetCnt, mMinSubsetScore, mDefaultNmsThreshold, mScaleNetToOutput,
                     mMaximizePositives, mFinalOutputCpu, pFinalOutputGpuPtr, pBodyPartPairsGpuPtr, pMapIdxGpuPtr,
-                    peaksGpuPtr, mGpuID);
+                    peaksGpuPtr, mGpuID, mNumberPeopleMax);
             #else
                 UNUSED(bottom);
                 UNUSED(poseKeypoints);
@@ -337,8 +446,15 @@ namespace op
             #if defined USE_CAFFE && defined USE_CUDA
                 // Global data
                 const auto heatMapsBlob = bottom.at(0);
-                const auto* const heatMapsGpuPtr = heatMapsBlob->gpu_data();
-                const auto* const peaksPtr = bottom.at(1)->cpu_data();
+                // Note: heatMapsBlob->gpu_data() is not called in half precision mode nor with network resolution
+                // PAFs, so Caffe does not allocate it
+                const auto* const heatMapsGpuPtr = (pHeatMapsHalfGpuPtr == nullptr && pLowResolutionPafs == nullptr
+                    ? heatMapsBlob->gpu_data() : nullptr);
+                const auto* const pafsGpuPtr = (
+                    pLowResolutionPafs != nullptr ? pLowResolutionPafs->gpu_data() : nullptr);
+                const auto pafsSize = (pLowResolutionPafs != nullptr
+                    ? Point<int>{pLowResolutionPafs->shape(3), pLowResolutionPafs->shape(2)} : Point<int>{0, 0});
+                const auto pafsChannels = (pLowResolutionPafs != nullptr ? pLowResolutionPafs->shape(1) : 0);
                 const auto maxPeaks = mTopSize[1];
                 const auto* const peaksGpuPtr = bottom.at(1)->gpu_data();
 
@@ -346,8 +462,8 @@ namespace op
                 if (pBodyPartPairsGpuPtr == nullptr || pMapIdxGpuPtr == nullptr)
                 {
                     // Free previous memory
-                    cudaFree(pBodyPartPairsGpuPtr);
-                    cudaFree(pMapIdxGpuPtr);
+                    cudaPoolFree(pBodyPartPairsGpuPtr, pCudaStream);
+                    cudaPoolFree(pMapIdxGpuPtr, pCudaStream);
                     // Data
                     const auto& bodyPartPairs = getPosePartPairs(mPoseModel);
                     const auto numberBodyParts = getPoseNumberBodyParts(mPoseModel);
@@ -358,10 +474,11 @@ namespace op
                     for (auto& i : mapIdx)
                         i += (numberBodyParts+offset);
                     // Re-allocate memory
-                    cudaMalloc((void **)&pBodyPartPairsGpuPtr, bodyPartPairs.size() * sizeof(unsigned int));
+                    pBodyPartPairsGpuPtr = (unsigned int*)cudaPoolMalloc(
+                        bodyPartPairs.size() * sizeof(unsigned int), pCudaStream);
                     cudaMemcpy(pBodyPartPairsGpuPtr, &bodyPartPairs[0], bodyPartPairs.size() * sizeof(unsigned int),
                                cudaMemcpyHostToDevice);
-                    cudaMalloc((void **)&pMapIdxGpuPtr, mapIdx.size() * sizeof(unsigned int));
+                    pMapIdxGpuPtr = (unsigned int*)cudaPoolMalloc(mapIdx.size() * sizeof(unsigned int), pCudaStream);
                     cudaMemcpy(pMapIdxGpuPtr, &mapIdx[0], mapIdx.size() * sizeof(unsigned int),
                                cudaMemcpyHostToDevice);
                     // Sanity check
@@ -374,21 +491,57 @@ namespace op
                     const auto& bodyPartPairs = getPosePartPairs(mPoseModel);
                     const auto numberBodyPartPairs = bodyPartPairs.size() / 2;
                     // Allocate memory
-                    mFinalOutputCpu.reset({(int)numberBodyPartPairs, maxPeaks, maxPeaks});
+                    mFinalOutputCpu.resetPinned({(int)numberBodyPartPairs, maxPeaks, maxPeaks});
                     const auto totalComputations = mFinalOutputCpu.getVolume();
+                    const auto assemblyWorkspaceBytes = getConnectBodyPartsGpuWorkspaceBytes<T>(mPoseModel, maxPeaks);
                     if (pFinalOutputGpuPtr == nullptr)
-                        cudaMalloc((void **)&pFinalOutputGpuPtr, totalComputations * sizeof(float));
+                    {
+                        // Integrated GPU (e.g., Jetson) + CPU people assembly: The PAF scoring kernels write into the
+                        // mapped mFinalOutputCpu, so its download is skipped. With the GPU assembly, the scores are
+                        // never downloaded and they are re-read by the assembly kernels, so they stay in device
+                        // memory
+                        const auto* const mappedPtr = (assemblyWorkspaceBytes == 0 && isIntegratedGpu(mGpuID)
+                            ? getPinnedMemoryDevicePtr(mFinalOutputCpu.getConstPtr()) : nullptr);
+                        // Only with unified virtual addressing, where both pointers are the same one
+                        mFinalOutputZeroCopy = (mappedPtr != nullptr && mappedPtr == mFinalOutputCpu.getConstPtr());
+                        pFinalOutputGpuPtr = (mFinalOutputZeroCopy
+                            ? mFinalOutputCpu.getPtr()
+                            : (T*)cudaPoolMalloc(totalComputations * sizeof(float), pCudaStream));
+                    }
+                    // Candidate list of the sparse PAF scoring (its size + 1 index per pair score)
+                    if (pPafCandidatesGpuPtr == nullptr)
+                        pPafCandidatesGpuPtr = (int*)cudaPoolMalloc(
+                            (totalComputations + 1) * sizeof(int), pCudaStream);
+                    // GPU people assembly workspace (if supported by the model)
+                    if (pAssemblyWorkspaceGpuPtr == nullptr && assemblyWorkspaceBytes > 0)
+                        pAssemblyWorkspaceGpuPtr = cudaPoolMalloc(assemblyWorkspaceBytes, pCudaStream);
                     // Sanity check
                     cudaCheck(__LINE__, __FUNCTION__, __FILE__);
                 }
+                // Peaks only required on CPU if the people assembly runs on CPU. Caffe downloads them on the default
+                // stream, so the NMS kernels queued in pCudaStream must have finished first
+                if (pAssemblyWorkspaceGpuPtr == nullptr && pCudaStream != nullptr)
+                    cudaStreamSynchronize(pCudaStream);
+                const auto* const peaksPtr = (pAssemblyWorkspaceGpuPtr == nullptr ? bottom.at(1)->cpu_data() : nullptr);
 
                 // Run body part connector
-                connectBodyPartsGpu(
-                    poseKeypoints, poseScores, heatMapsGpuPtr, peaksPtr, mPoseModel,
-                    Point<int>{heatMapsBlob->shape(3), heatMapsBlob->shape(2)}, maxPeaks, mInterMinAboveThreshold,
-                    mInterThreshold, mMinSubsetCnt, mMinSubsetScore, mDefaultNmsThreshold, mScaleNetToOutput,
-                    mMaximizePositives, mFinalOutputCpu, pFinalOutputGpuPtr, pBodyPartPairsGpuPtr, pMapIdxGpuPtr,
-                    peaksGpuPtr);
+                const TraceRange traceRange{"connectBodyPartsGpu"};
+                if (pHeatMapsHalfGpuPtr != nullptr)
+                    connectBodyPartsGpu(
+                        poseKeypoints, poseScores, pHeatMapsHalfGpuPtr, peaksPtr, mPoseModel,
+                        Point<int>{heatMapsBlob->shape(3), heatMapsBlob->shape(2)}, maxPeaks, mInterMinAboveThreshold,
+                        mInterThreshold, mMinSubsetCnt, mMinSubsetScore, mDefaultNmsThreshold, mScaleNetToOutput,
+                        mMaximizePositives, mFinalOutputCpu, pFinalOutputGpuPtr, pBodyPartPairsGpuPtr, pMapIdxGpuPtr,
+                        peaksGpuPtr, pAssemblyWorkspaceGpuPtr, pCudaStream, mNumberPeopleMax, pPafCandidatesGpuPtr,
+                        mMaxLimbLength, mMinPeakScore, pafsGpuPtr, pafsSize, mLowResolutionLayout, pafsChannels);
+                else
+                    connectBodyPartsGpu(
+                        poseKeypoints, poseScores, heatMapsGpuPtr, peaksPtr, mPoseModel,
+                        Point<int>{heatMapsBlob->shape(3), heatMapsBlob->shape(2)}, maxPeaks, mInterMinAboveThreshold,
+                        mInterThreshold, mMinSubsetCnt, mMinSubsetScore, mDefaultNmsThreshold, mScaleNetToOutput,
+                        mMaximizePositives, mFinalOutputCpu, pFinalOutputGpuPtr, pBodyPartPairsGpuPtr, pMapIdxGpuPtr,
+                        peaksGpuPtr, pAssemblyWorkspaceGpuPtr, pCudaStream, mNumberPeopleMax, pPafCandidatesGpuPtr,
+                        mMaxLimbLength, mMinPeakScore, pafsGpuPtr, pafsSize, mLowResolutionLayout, pafsChannels);
             #else
                 UNUSED(bottom);
                 UNUSED(poseKeypoints);
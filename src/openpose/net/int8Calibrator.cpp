@@ -0,0 +1,271 @@
+#include <openpose/net/int8Calibrator.hpp>
+#include <cmath> // std::abs, std::log
+#include <cstdint> // std::uint32_t
+#include <cstdio> // std::snprintf
+#include <cstring> // std::memcpy
+#include <fstream>
+#include <limits> // std::numeric_limits
+#ifdef USE_TENSORRT
+    #include <NvInferVersion.h> // NV_TENSORRT_VERSION
+#endif
+#include <openpose/utilities/fastMath.hpp>
+
+namespace op
+{
+    // TensorRT entropy calibration: #bins of the quantized (INT8, non-negative half) distribution
+    const auto INT8_QUANTIZED_BINS = 128;
+    // TensorRT cache header. It must match the version of the TensorRT that reads it
+    #ifdef USE_TENSORRT
+        const std::string INT8_CALIBRATION_CACHE_HEADER{
+            "TRT-" + std::to_string(NV_TENSORRT_VERSION) + "-EntropyCalibration2"};
+    #else
+        const std::string INT8_CALIBRATION_CACHE_HEADER{"TRT-8601-EntropyCalibration2"};
+    #endif
+
+    struct TensorHistogram
+    {
+        // Histogram of the absolute values over [0, binWidth x #bins)
+        double binWidth;
+        std::vector<unsigned long long> bins;
+        // Zeros added before the first non-zero value (i.e., before binWidth is known)
+        unsigned long long pendingZeros;
+    };
+
+    struct Int8Calibrator::ImplInt8Calibrator
+    {
+        const int mNumberBins;
+        std::map<std::string, TensorHistogram> mHistograms;
+
+        ImplInt8Calibrator(const int numberBins) :
+            mNumberBins{numberBins}
+        {
+        }
+
+        float getThreshold(const TensorHistogram& histogram) const
+        {
+            try
+            {
+                if (histogram.bins.empty())
+                    return 0.f;
+                // Suffix sums, so the outliers of each candidate threshold are clipped into its last bin
+                std::vector<double> outliers(mNumberBins + 1, 0.);
+                for (auto bin = mNumberBins - 1 ; bin >= 0 ; bin--)
+                    outliers[bin] = outliers[bin+1] + double(histogram.bins[bin]);
+                auto bestDivergence = std::numeric_limits<double>::max();
+                auto bestNumberBins = mNumberBins;
+                std::vector<double> reference(mNumberBins);
+                std::vector<double> quantized(mNumberBins);
+                for (auto numberBins = INT8_QUANTIZED_BINS ; numberBins <= mNumberBins ; numberBins++)
+                {
+                    // Reference distribution P: The first numberBins bins, with the outliers in the last one
+                    for (auto bin = 0 ; bin < numberBins ; bin++)
+                        reference[bin] = double(histogram.bins[bin]);
+                    reference[numberBins-1] += outliers[numberBins];
+                    // Quantized distribution Q: The same bins merged into INT8_QUANTIZED_BINS, and expanded back
+                    // over the non-empty bins of P
+                    for (auto quantizedBin = 0 ; quantizedBin < INT8_QUANTIZED_BINS ; quantizedBin++)
+                    {
+                        const auto binBegin = quantizedBin * numberBins / INT8_QUANTIZED_BINS;
+                        const auto binEnd = (quantizedBin + 1) * numberBins / INT8_QUANTIZED_BINS;
+                        auto sum = 0.;
+                        auto nonEmptyBins = 0;
+                        for (auto bin = binBegin ; bin < binEnd ; bin++)
+                        {
+                            sum += double(histogram.bins[bin]);
+                            if (reference[bin] > 0.)
+                                nonEmptyBins++;
+                        }
+                        for (auto bin = binBegin ; bin < binEnd ; bin++)
+                            quantized[bin] = (reference[bin] > 0. && nonEmptyBins > 0 ? sum / nonEmptyBins : 0.);
+                    }
+                    // KL divergence (the empty bins of Q are smoothed so it is finite)
+                    auto referenceSum = 0.;
+                    auto quantizedSum = 0.;
+                    for (auto bin = 0 ; bin < numberBins ; bin++)
+                    {
+                        referenceSum += reference[bin];
+                        quantizedSum += quantized[bin];
+                    }
+                    if (referenceSum <= 0. || quantizedSum <= 0.)
+                        continue;
+                    auto divergence = 0.;
+                    for (auto bin = 0 ; bin < numberBins ; bin++)
+                    {
+                        if (reference[bin] > 0.)
+                        {
+                            const auto p = reference[bin] / referenceSum;
+                            const auto q = fastMax(quantized[bin] / quantizedSum, 1e-10);
+                            divergence += p * std::log(p / q);
+                        }
+                    }
+                    if (divergence < bestDivergence)
+                    {
+                        bestDivergence = divergence;
+                        bestNumberBins = numberBins;
+                    }
+                }
+                return float((bestNumberBins + 0.5) * histogram.binWidth);
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return 0.f;
+            }
+        }
+    };
+
+    Int8Calibrator::Int8Calibrator(const int numberBins) :
+        upImpl{new ImplInt8Calibrator{numberBins}}
+    {
+        try
+        {
+            if (numberBins < INT8_QUANTIZED_BINS)
+                error("The number of histogram bins must be at least " + std::to_string(INT8_QUANTIZED_BINS)
+                      + ".", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    Int8Calibrator::~Int8Calibrator()
+    {
+    }
+
+    void Int8Calibrator::addTensor(const std::string& tensorName, const float* const dataPtr, const long long count)
+    {
+        try
+        {
+            if (dataPtr == nullptr || count < 1)
+                return;
+            auto& histogram = upImpl->mHistograms[tensorName];
+            const auto numberBins = upImpl->mNumberBins;
+            auto maxAbs = 0.f;
+            for (auto i = 0ll ; i < count ; i++)
+                maxAbs = fastMax(maxAbs, std::abs(dataPtr[i]));
+            // All zeros so far
+            if (maxAbs == 0.f && histogram.bins.empty())
+            {
+                histogram.pendingZeros += (unsigned long long)count;
+                return;
+            }
+            // First non-zero data: The range is [0, maxAbs]
+            if (histogram.bins.empty())
+            {
+                histogram.binWidth = double(maxAbs) / numberBins;
+                histogram.bins.assign(numberBins, 0ull);
+                histogram.bins[0] = histogram.pendingZeros;
+            }
+            // Larger values: The range is doubled as many times as required, merging the bins in groups
+            else if (maxAbs > histogram.binWidth * numberBins)
+            {
+                auto mergedBins = 1;
+                while (maxAbs > histogram.binWidth * mergedBins * numberBins)
+                    mergedBins *= 2;
+                std::vector<unsigned long long> bins(numberBins, 0ull);
+                for (auto bin = 0 ; bin < numberBins ; bin++)
+                    bins[bin / mergedBins] += histogram.bins[bin];
+                histogram.bins.swap(bins);
+                histogram.binWidth *= mergedBins;
+            }
+            const auto binsPerUnit = 1. / histogram.binWidth;
+            for (auto i = 0ll ; i < count ; i++)
+                histogram.bins[fastMin(numberBins - 1, int(std::abs(dataPtr[i]) * binsPerUnit))]++;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void Int8Calibrator::addNet(const NetCaffe& netCaffe)
+    {
+        try
+        {
+            for (const auto& blobName : netCaffe.getBlobNames())
+            {
+                const auto spBlob = netCaffe.getBlobArray(blobName);
+                if (spBlob != nullptr)
+                    addTensor(blobName, spBlob->cpu_data(), spBlob->count());
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::map<std::string, float> Int8Calibrator::getThresholds() const
+    {
+        try
+        {
+            std::map<std::string, float> thresholds;
+            for (const auto& histogram : upImpl->mHistograms)
+                thresholds[histogram.first] = upImpl->getThreshold(histogram.second);
+            return thresholds;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void Int8Calibrator::writeCalibrationCache(const std::string& calibrationCachePath) const
+    {
+        try
+        {
+            std::ofstream calibrationCacheFile{calibrationCachePath};
+            if (!calibrationCacheFile.is_open())
+                error("The calibration cache could not be written in " + calibrationCachePath + ".",
+                      __LINE__, __FUNCTION__, __FILE__);
+            calibrationCacheFile << INT8_CALIBRATION_CACHE_HEADER << "\n";
+            for (const auto& threshold : getThresholds())
+            {
+                // Tensors that were always 0 still need a (positive) scale
+                const auto scale = fastMax(threshold.second / 127.f, 1e-8f);
+                std::uint32_t scaleBits;
+                std::memcpy(&scaleBits, &scale, sizeof(scale));
+                char scaleHex[9];
+                std::snprintf(scaleHex, sizeof(scaleHex), "%08x", scaleBits);
+                calibrationCacheFile << threshold.first << ": " << scaleHex << "\n";
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::map<std::string, float> readInt8CalibrationCache(const std::string& calibrationCachePath)
+    {
+        try
+        {
+            std::ifstream calibrationCacheFile{calibrationCachePath};
+            if (!calibrationCacheFile.is_open())
+                error("The calibration cache could not be read from " + calibrationCachePath + ".",
+                      __LINE__, __FUNCTION__, __FILE__);
+            std::map<std::string, float> thresholds;
+            std::string line;
+            // The first line is the header (`TRT-{version}-{calibrator}`)
+            std::getline(calibrationCacheFile, line);
+            while (std::getline(calibrationCacheFile, line))
+            {
+                const auto separator = line.rfind(": ");
+                if (separator == std::string::npos)
+                    continue;
+                const auto scaleBits = (std::uint32_t)std::stoul(line.substr(separator + 2), nullptr, 16);
+                float scale;
+                std::memcpy(&scale, &scaleBits, sizeof(scale));
+                thresholds[line.substr(0, separator)] = 127.f * scale;
+            }
+            return thresholds;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+}
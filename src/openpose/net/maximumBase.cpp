@@ -1,16 +1,170 @@
 #include <openpose/net/maximumBase.hpp>
 // #include <thrust/extrema.h>
-#include <opencv2/core/core.hpp> // cv::Mat
+#include <openpose_private/utilities/avx.hpp>
+#include <openpose_private/utilities/neon.hpp>
+#include <openpose_private/utilities/parallelFor.hpp>
 
 namespace op
 {
+    // Maximum of the size values of sourcePtr (the first one if repeated, as cv::minMaxLoc and maximumGpu), and it
+    // returns its index
+    template <typename T>
+    int maximumIndexScalar(T& maxValue, const T* const sourcePtr, const int size)
+    {
+        auto maxIndex = 0;
+        maxValue = sourcePtr[0];
+        for (auto index = 1 ; index < size ; index++)
+        {
+            if (sourcePtr[index] > maxValue)
+            {
+                maxValue = sourcePtr[index];
+                maxIndex = index;
+            }
+        }
+        return maxIndex;
+    }
+
+    // The same with SIMD instructions, each lane tracking the maximum (and its first index) of its own pixels
+    template <typename T>
+    using MaximumIndex = int (*)(T& maxValue, const T* const sourcePtr, const int size);
+
+    #if defined WITH_AVX || defined WITH_NEON
+        // Maximum of the lanes (the lowest index if repeated) and of the remaining pixels from indexBegin on
+        int maximumIndexLanes(
+            float& maxValue, const float* const laneValues, const int32_t* const laneIndexes, const int numberLanes,
+            const float* const sourcePtr, const int indexBegin, const int size)
+        {
+            auto maxIndex = laneIndexes[0];
+            maxValue = laneValues[0];
+            for (auto lane = 1 ; lane < numberLanes ; lane++)
+            {
+                if (laneValues[lane] > maxValue || (laneValues[lane] == maxValue && laneIndexes[lane] < maxIndex))
+                {
+                    maxValue = laneValues[lane];
+                    maxIndex = laneIndexes[lane];
+                }
+            }
+            for (auto index = indexBegin ; index < size ; index++)
+            {
+                if (sourcePtr[index] > maxValue)
+                {
+                    maxValue = sourcePtr[index];
+                    maxIndex = index;
+                }
+            }
+            return maxIndex;
+        }
+    #endif
+
+    #ifdef WITH_AVX
+        OP_TARGET_AVX2 int maximumIndexAvx2(float& maxValue, const float* const sourcePtr, const int size)
+        {
+            if (size < 8)
+                return maximumIndexScalar(maxValue, sourcePtr, size);
+            auto maxValues = _mm256_loadu_ps(sourcePtr);
+            auto indexes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+            auto maxIndexes = indexes;
+            const auto eight = _mm256_set1_epi32(8);
+            auto index = 8;
+            // 8 pixels at a time
+            for ( ; index + 8 <= size ; index += 8)
+            {
+                const auto values = _mm256_loadu_ps(&sourcePtr[index]);
+                indexes = _mm256_add_epi32(indexes, eight);
+                const auto isGreater = _mm256_cmp_ps(values, maxValues, _CMP_GT_OQ);
+                maxValues = _mm256_blendv_ps(maxValues, values, isGreater);
+                maxIndexes = _mm256_blendv_epi8(maxIndexes, indexes, _mm256_castps_si256(isGreater));
+            }
+            ALIGN32(float laneValues[8]);
+            ALIGN32(int32_t laneIndexes[8]);
+            _mm256_store_ps(laneValues, maxValues);
+            _mm256_store_si256((__m256i*)laneIndexes, maxIndexes);
+            return maximumIndexLanes(maxValue, laneValues, laneIndexes, 8, sourcePtr, index, size);
+        }
+
+        OP_TARGET_AVX512 int maximumIndexAvx512(float& maxValue, const float* const sourcePtr, const int size)
+        {
+            if (size < 16)
+                return maximumIndexAvx2(maxValue, sourcePtr, size);
+            auto maxValues = _mm512_loadu_ps(sourcePtr);
+            auto indexes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+            auto maxIndexes = indexes;
+            const auto sixteen = _mm512_set1_epi32(16);
+            auto index = 16;
+            // 16 pixels at a time
+            for ( ; index + 16 <= size ; index += 16)
+            {
+                const auto values = _mm512_loadu_ps(&sourcePtr[index]);
+                indexes = _mm512_add_epi32(indexes, sixteen);
+                const auto isGreater = _mm512_cmp_ps_mask(values, maxValues, _CMP_GT_OQ);
+                maxValues = _mm512_mask_mov_ps(maxValues, isGreater, values);
+                maxIndexes = _mm512_mask_mov_epi32(maxIndexes, isGreater, indexes);
+            }
+            float laneValues[16];
+            int32_t laneIndexes[16];
+            _mm512_storeu_ps(laneValues, maxValues);
+            _mm512_storeu_si512(laneIndexes, maxIndexes);
+            return maximumIndexLanes(maxValue, laneValues, laneIndexes, 16, sourcePtr, index, size);
+        }
+    #endif
+
+    #ifdef WITH_NEON
+        int maximumIndexNeon(float& maxValue, const float* const sourcePtr, const int size)
+        {
+            if (size < 4)
+                return maximumIndexScalar(maxValue, sourcePtr, size);
+            auto maxValues = vld1q_f32(sourcePtr);
+            const uint32_t firstIndexes[4] = {0u, 1u, 2u, 3u};
+            auto indexes = vld1q_u32(firstIndexes);
+            auto maxIndexes = indexes;
+            const auto four = vdupq_n_u32(4u);
+            auto index = 4;
+            // 4 pixels at a time
+            for ( ; index + 4 <= size ; index += 4)
+            {
+                const auto values = vld1q_f32(&sourcePtr[index]);
+                indexes = vaddq_u32(indexes, four);
+                const auto isGreater = vcgtq_f32(values, maxValues);
+                maxValues = vbslq_f32(isGreater, values, maxValues);
+                maxIndexes = vbslq_u32(isGreater, indexes, maxIndexes);
+            }
+            float laneValues[4];
+            int32_t laneIndexes[4];
+            vst1q_f32(laneValues, maxValues);
+            vst1q_s32(laneIndexes, vreinterpretq_s32_u32(maxIndexes));
+            return maximumIndexLanes(maxValue, laneValues, laneIndexes, 4, sourcePtr, index, size);
+        }
+    #endif
+
+    // SIMD version selected at runtime (or the scalar one if none)
+    template <typename T>
+    MaximumIndex<T> getMaximumIndex()
+    {
+        return &maximumIndexScalar<T>;
+    }
+
+    template <>
+    MaximumIndex<float> getMaximumIndex<float>()
+    {
+        #if defined WITH_AVX
+            static const auto sMaximumIndex = (cpuSupportsAvx512()
+                ? &maximumIndexAvx512
+                : (cpuSupportsAvx2() ? &maximumIndexAvx2 : &maximumIndexScalar<float>));
+            return sMaximumIndex;
+        #elif defined WITH_NEON
+            static const auto sMaximumIndex = (cpuSupportsNeon() ? &maximumIndexNeon : &maximumIndexScalar<float>);
+            return sMaximumIndex;
+        #else
+            return &maximumIndexScalar<float>;
+        #endif
+    }
+
     template <typename T>
     void maximumCpu(T* targetPtr, const T* const sourcePtr, const std::array<int, 4>& targetSize,
                     const std::array<int, 4>& sourceSize)
     {
         try
         {
-            // // TODO: ideally done, try, debug & compare to *.cu
             const auto height = sourceSize[2];
             const auto width = sourceSize[3];
             const auto imageOffset = height * width;
@@ -19,36 +173,35 @@ namespace op
             const auto numberParts = targetSize[2];
             const auto numberSubparts = targetSize[3];
 
-            // opLog("sourceSize[0]: " + std::to_string(sourceSize[0])); // = 1
+            // opLog("sourceSize[0]: " + std::to_string(sourceSize[0])); // = 1 or #faces (batched)
             // opLog("sourceSize[1]: " + std::to_string(sourceSize[1])); // = #body_parts+bck=22(hands) or 71(face)
             // opLog("sourceSize[2]: " + std::to_string(sourceSize[2])); // = 368 = height
             // opLog("sourceSize[3]: " + std::to_string(sourceSize[3])); // = 368 = width
-            // opLog("targetSize[0]: " + std::to_string(targetSize[0])); // = 1
+            // opLog("targetSize[0]: " + std::to_string(targetSize[0])); // = 1 or #faces (batched)
             // opLog("targetSize[1]: " + std::to_string(targetSize[1])); // = 1
             // opLog("targetSize[2]: " + std::to_string(targetSize[2])); // = 21(hands) or 70 (face)
             // opLog("targetSize[3]: " + std::to_string(targetSize[3])); // = 3 = [x, y, score]
             // opLog(" ");
 
-            for (auto n = 0; n < num; n++)
+            // Sanity check
+            if (channels != 1)
+                error("The target must have 1 channel.", __LINE__, __FUNCTION__, __FILE__);
+            if (imageOffset <= 0)
+                return;
+            const auto maximumIndex = getMaximumIndex<T>();
+            // All the batch elements (e.g., each face crop) and parts in 1 call, distributed among the threads
+            parallelFor(0, num * numberParts, [&](const int index)
             {
-                for (auto c = 0; c < channels; c++)
-                {
-                    // Parameters
-                    const auto offsetChannel = (n * channels + c);
-                    for (auto part = 0; part < numberParts; part++)
-                    {
-                        auto* targetPtrOffsetted = targetPtr + (offsetChannel + part) * numberSubparts;
-                        const auto* const sourcePtrOffsetted = sourcePtr + (offsetChannel + part) * imageOffset;
-                        cv::Mat source(cv::Size(width, height), CV_32FC1, const_cast<T*>(sourcePtrOffsetted));
-                        double minVal, maxVal;
-                        cv::Point minLoc, maxLoc;
-                        cv::minMaxLoc(source, &minVal, &maxVal, &minLoc, &maxLoc);
-                        targetPtrOffsetted[0] = T(maxLoc.x);
-                        targetPtrOffsetted[1] = T(maxLoc.y);
-                        targetPtrOffsetted[2] = T(maxVal);
-                    }
-                }
-            }
+                const auto n = index / numberParts;
+                const auto part = index % numberParts;
+                auto* targetPtrOffsetted = targetPtr + (n * numberParts + part) * numberSubparts;
+                const auto* const sourcePtrOffsetted = sourcePtr + (n * sourceSize[1] + part) * imageOffset;
+                T maxValue;
+                const auto maxIndex = maximumIndex(maxValue, sourcePtrOffsetted, imageOffset);
+                targetPtrOffsetted[0] = T(maxIndex % width);
+                targetPtrOffsetted[1] = T(maxIndex / width);
+                targetPtrOffsetted[2] = maxValue;
+            });
         }
         catch (const std::exception& e)
         {
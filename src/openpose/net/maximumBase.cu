@@ -1,20 +1,8 @@
 #include <openpose/net/maximumBase.hpp>
-#include <thrust/device_ptr.h>
-#include <thrust/extrema.h>
-#include <openpose/gpu/cuda.hpp>
 #include <openpose/gpu/cuda.hpp>
 
 namespace op
 {
-    template <typename T>
-    __global__ void fillTargetPtrPart(T* targetPtrOffsetted, const T* sourcePtrOffsetted, const int sourceIndex,
-                                      const int x, const int y)
-    {
-        targetPtrOffsetted[0] = x;
-        targetPtrOffsetted[1] = y;
-        targetPtrOffsetted[2] = sourcePtrOffsetted[sourceIndex];
-    }
-
     // template <typename T>
     // __global__ void fillTargetPtrChannel(T* targetPtrOffsetted, const T* sourcePtrOffsetted, const int width,
     //                                      const int imageOffset)
@@ -59,6 +47,61 @@ namespace op
     //     }
     // }
 
+    const auto THREADS_PER_BLOCK = 256;
+
+    template <typename T>
+    __global__ void maximumKernel(T* targetPtr, const T* const sourcePtr, const int numberParts,
+                                  const int sourceChannels, const int width, const int imageOffset,
+                                  const int numberSubparts)
+    {
+        // 1 block per batch element and part
+        const auto n = blockIdx.x / numberParts;
+        const auto part = blockIdx.x % numberParts;
+        const auto* const sourcePtrOffsetted = sourcePtr + (n * sourceChannels + part) * imageOffset;
+        __shared__ T sharedValues[THREADS_PER_BLOCK];
+        __shared__ int sharedIndexes[THREADS_PER_BLOCK];
+        // Maximum of each thread (the first one if repeated, as thrust::max_element)
+        auto maxIndex = -1;
+        T maxValue = 0;
+        for (auto index = (int)threadIdx.x ; index < imageOffset ; index += blockDim.x)
+        {
+            const auto value = sourcePtrOffsetted[index];
+            if (maxIndex < 0 || value > maxValue)
+            {
+                maxValue = value;
+                maxIndex = index;
+            }
+        }
+        sharedValues[threadIdx.x] = maxValue;
+        sharedIndexes[threadIdx.x] = maxIndex;
+        __syncthreads();
+        // Maximum of the block
+        for (auto stride = blockDim.x / 2 ; stride > 0 ; stride >>= 1)
+        {
+            if (threadIdx.x < stride)
+            {
+                const auto otherIndex = sharedIndexes[threadIdx.x + stride];
+                const auto otherValue = sharedValues[threadIdx.x + stride];
+                const auto currentIndex = sharedIndexes[threadIdx.x];
+                const auto currentValue = sharedValues[threadIdx.x];
+                if (otherIndex >= 0 && (currentIndex < 0 || otherValue > currentValue
+                                        || (otherValue == currentValue && otherIndex < currentIndex)))
+                {
+                    sharedValues[threadIdx.x] = otherValue;
+                    sharedIndexes[threadIdx.x] = otherIndex;
+                }
+            }
+            __syncthreads();
+        }
+        if (threadIdx.x == 0)
+        {
+            auto* targetPtrOffsetted = targetPtr + (n * numberParts + part) * numberSubparts;
+            targetPtrOffsetted[0] = sharedIndexes[0] % width;
+            targetPtrOffsetted[1] = sharedIndexes[0] / width;
+            targetPtrOffsetted[2] = sharedValues[0];
+        }
+    }
+
     template <typename T>
     void maximumGpu(T* targetPtr, const T* const sourcePtr, const std::array<int, 4>& targetSize,
                     const std::array<int, 4>& sourceSize)
@@ -73,44 +116,22 @@ namespace op
             const auto numberParts = targetSize[2];
             const auto numberSubparts = targetSize[3];
 
-            // opLog("sourceSize[0]: " + std::to_string(sourceSize[0]));  // = 1
+            // opLog("sourceSize[0]: " + std::to_string(sourceSize[0]));  // = 1 or #faces (batched)
             // opLog("sourceSize[1]: " + std::to_string(sourceSize[1]));  // = #BodyParts + bkg = 22 (hands) or 71 (face)
             // opLog("sourceSize[2]: " + std::to_string(sourceSize[2]));  // = 368 = height
             // opLog("sourceSize[3]: " + std::to_string(sourceSize[3]));  // = 368 = width
-            // opLog("targetSize[0]: " + std::to_string(targetSize[0]));  // = 1
+            // opLog("targetSize[0]: " + std::to_string(targetSize[0]));  // = 1 or #faces (batched)
             // opLog("targetSize[1]: " + std::to_string(targetSize[1]));  // = 1
             // opLog("targetSize[2]: " + std::to_string(targetSize[2]));  // = 21(hands) or 70 (face)
             // opLog("targetSize[3]: " + std::to_string(targetSize[3]));  // = 3 = [x, y, score]
             // opLog(" ");
-            for (auto n = 0; n < num; n++)
-            {
-                for (auto c = 0; c < channels; c++)
-                {
-                    // // Parameters
-                    const auto offsetChannel = (n * channels + c);
-                    for (auto part = 0; part < numberParts; part++)
-                    {
-                        auto* targetPtrOffsetted = targetPtr + (offsetChannel + part) * numberSubparts;
-                        const auto* const sourcePtrOffsetted = sourcePtr + (offsetChannel + part) * imageOffset;
-                        // Option a - 6.3 fps
-                        const auto sourceThrustPtr = thrust::device_pointer_cast(sourcePtrOffsetted);
-                        // Ideal option (not working for CUDA < 8)
-                        // const auto sourceIndexIterator = thrust::max_element(
-                        //     thrust::device, sourceThrustPtr, sourceThrustPtr + imageOffset);
-                        // Workaround to make it work for CUDA 7.5
-                        const auto sourceIndexIterator = thrust::max_element(
-                            sourceThrustPtr, sourceThrustPtr + imageOffset);
-                        const auto sourceIndex = (int)(sourceIndexIterator - sourceThrustPtr);
-                        fillTargetPtrPart<<<1, 1>>>(targetPtrOffsetted, sourcePtrOffsetted, sourceIndex,
-                                                    sourceIndex % width, sourceIndex / width);
-                        // // Option b - <1 fps
-                        // fillTargetPtrChannel<<<1, 1>>>(targetPtrOffsetted, sourcePtrOffsetted, width, imageOffset);
-                    }
-                    // Option c - 4.9 fps
-                    // fillTargetPtr<<<1, numberParts>>>(targetPtr, sourcePtr, width, imageOffset, numberSubparts,
-                    //                                   offsetChannel);
-                }
-            }
+            // Sanity check
+            if (channels != 1)
+                error("The target must have 1 channel.", __LINE__, __FUNCTION__, __FILE__);
+            // All the batch elements and parts at once (rather than 1 thrust::max_element + kernel per part)
+            if (num > 0 && numberParts > 0)
+                maximumKernel<<<num * numberParts, THREADS_PER_BLOCK>>>(
+                    targetPtr, sourcePtr, numberParts, sourceSize[1], width, imageOffset, numberSubparts);
             cudaCheck(__LINE__, __FUNCTION__, __FILE__);
         }
         catch (const std::exception& e)
@@ -2,15 +2,30 @@
 #include <numeric> // std::accumulate
 #ifdef USE_CAFFE
     #include <atomic>
+    #include <cctype> // std::isdigit
+    #include <climits> // INT_MAX
+    #include <iterator> // std::advance
+    #include <map>
     #include <mutex>
+    #include <set>
     #include <caffe/net.hpp>
+    #include <caffe/util/upgrade_proto.hpp> // caffe::UpgradeNetAsNeeded
     #include <glog/logging.h> // google::InitGoogleLogging
+    #include <google/protobuf/io/coded_stream.h>
+    #include <google/protobuf/io/zero_copy_stream_impl_lite.h> // google::protobuf::io::ArrayInputStream
+    #include <openpose/utilities/fastMath.hpp>
+    #include <openpose_private/utilities/memoryMappedFile.hpp>
 #endif
 #ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+    #include <openpose/core/pinnedMemory.hpp>
     #include <openpose/gpu/cuda.hpp>
+    #include <openpose/gpu/cudaMemoryPool.hpp>
 #endif
 #include <openpose/utilities/fileSystem.hpp>
 #include <openpose/utilities/standard.hpp>
+#include <openpose/utilities/string.hpp>
+#include <openpose/utilities/tracer.hpp>
 #ifdef USE_OPENCL
     #include <openpose_private/gpu/opencl.hcl>
     #include <openpose_private/gpu/cl2.hpp>
@@ -20,6 +35,8 @@ namespace op
 {
     std::mutex sMutexNetCaffe;
     std::atomic<bool> sGoogleLoggingInitialized{false};
+    // Alignment of each blob inside the NetMemoryArena (as cudaMalloc)
+    const auto NET_MEMORY_ARENA_ALIGNMENT = 256ull;
     #ifdef USE_OPENCL
         std::atomic<bool> sOpenCLInitialized{false};
     #endif
@@ -32,7 +49,12 @@ namespace op
             const std::string mCaffeProto;
             const std::string mCaffeTrainedModel;
             const std::string mLastBlobName;
+            const std::shared_ptr<NetMemoryArena> spNetMemoryArena;
+            const int mNetStages;
             std::vector<int> mNetInputSize4D;
+            // Network input size and arena generation when the blobs were last placed into spNetMemoryArena
+            std::vector<int> mNetMemoryArenaInputSize4D;
+            unsigned long long mNetMemoryArenaGeneration;
             // Init with thread
             #ifdef NV_CAFFE
                 std::unique_ptr<caffe::Net> upCaffeNet;
@@ -41,13 +63,49 @@ namespace op
                 std::unique_ptr<caffe::Net<float>> upCaffeNet;
                 boost::shared_ptr<caffe::Blob<float>> spOutputBlob;
             #endif
+            // Kept until the first forward pass, so the other nets loading at the same time (e.g., other GPUs)
+            // share it
+            std::shared_ptr<const caffe::NetParameter> spTrainedModel;
+            #ifdef USE_CUDA
+                // Asynchronous input upload: Pinned staging memory + dedicated stream
+                cudaStream_t mUploadStream;
+                cudaEvent_t mUploadEvent;
+                float* pPinnedInputPtr;
+                unsigned long long mPinnedInputVolume;
+                // Keeps the (pinned) input memory alive until its upload finishes
+                Array<float> mUploadingInput;
+                // Integrated GPU (e.g., Jetson): The input blob points to the mapped pinned input (zero-copy) rather
+                // than to its own device memory (pInputGpuPtr, only allocated if that input blob is written later)
+                bool mIntegratedGpu;
+                bool mInputAliased;
+                float* pInputGpuPtr;
+                unsigned long long mInputGpuVolume;
+                // Device memory attributed to `NetCaffe` (see updateOwnerBytes)
+                long long mOwnerBytes;
+            #endif
 
             ImplNetCaffe(const std::string& caffeProto, const std::string& caffeTrainedModel, const int gpuId,
-                         const bool enableGoogleLogging, const std::string& lastBlobName) :
+                         const bool enableGoogleLogging, const std::string& lastBlobName,
+                         const std::shared_ptr<NetMemoryArena>& netMemoryArena, const int netStages) :
                 mGpuId{gpuId},
                 mCaffeProto{caffeProto},
                 mCaffeTrainedModel{caffeTrainedModel},
-                mLastBlobName{lastBlobName}
+                mLastBlobName{lastBlobName},
+                spNetMemoryArena{netMemoryArena},
+                mNetStages{netStages},
+                mNetMemoryArenaGeneration{0ull}
+                #ifdef USE_CUDA
+                    ,
+                    mUploadStream{nullptr},
+                    mUploadEvent{nullptr},
+                    pPinnedInputPtr{nullptr},
+                    mPinnedInputVolume{0ull},
+                    mIntegratedGpu{false},
+                    mInputAliased{false},
+                    pInputGpuPtr{nullptr},
+                    mInputGpuVolume{0ull},
+                    mOwnerBytes{0}
+                #endif
             {
                 try
                 {
@@ -97,6 +155,135 @@ namespace op
                     error(e.what(), __LINE__, __FUNCTION__, __FILE__);
                 }
             }
+
+            ~ImplNetCaffe()
+            {
+                #ifdef USE_CUDA
+                    try
+                    {
+                        if (mUploadEvent != nullptr)
+                        {
+                            cudaEventSynchronize(mUploadEvent);
+                            cudaEventDestroy(mUploadEvent);
+                        }
+                        if (mUploadStream != nullptr)
+                            cudaStreamDestroy(mUploadStream);
+                        if (pPinnedInputPtr != nullptr)
+                            cudaFreeHost(pPinnedInputPtr);
+                        if (pInputGpuPtr != nullptr)
+                            cudaFree(pInputGpuPtr);
+                        if (mOwnerBytes > 0)
+                            addCudaMemoryOwnerBytes("NetCaffe", mGpuId, -mOwnerBytes);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                    }
+                #endif
+            }
+
+            #if defined USE_CUDA && !defined NV_CAFFE
+                // The input blob might still point to the input of the last zero-copy forward pass, so it is pointed
+                // back to device memory before being written
+                float* getOwnInputGpuPtr()
+                {
+                    try
+                    {
+                        auto* const inputBlob = upCaffeNet->blobs().at(0).get();
+                        if (mInputAliased)
+                        {
+                            const auto volume = (unsigned long long)inputBlob->count();
+                            if (mInputGpuVolume < volume)
+                            {
+                                if (pInputGpuPtr != nullptr)
+                                    cudaFree(pInputGpuPtr);
+                                cudaMalloc((void**)&pInputGpuPtr, volume * sizeof(float));
+                                mInputGpuVolume = volume;
+                            }
+                            inputBlob->set_gpu_data(pInputGpuPtr);
+                            mInputAliased = false;
+                        }
+                        return inputBlob->mutable_gpu_data();
+                    }
+                    catch (const std::exception& e)
+                    {
+                        error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                        return nullptr;
+                    }
+                }
+
+                // Caffe allocates its memory outside the CUDA memory pool, so the device memory of the net (its blobs
+                // and parameters) is attributed to `NetCaffe` in getCudaMemoryOwnerStats() after each reshape. With
+                // a NetMemoryArena, the intermediate blobs are attributed to `NetMemoryArena` instead
+                void updateOwnerBytes()
+                {
+                    try
+                    {
+                        const auto& blobs = upCaffeNet->blobs();
+                        std::set<const caffe::SyncedMemory*> countedMemories;
+                        auto bytes = 0ll;
+                        for (auto i = 0u ; i < blobs.size() ; i++)
+                        {
+                            const auto ownMemory = (spNetMemoryArena == nullptr || i == 0
+                                                    || blobs[i] == spOutputBlob);
+                            if (ownMemory && countedMemories.insert(blobs[i]->data().get()).second)
+                                bytes += (long long)blobs[i]->count() * sizeof(float);
+                        }
+                        for (const auto& param : upCaffeNet->params())
+                            if (countedMemories.insert(param->data().get()).second)
+                                bytes += (long long)param->count() * sizeof(float);
+                        addCudaMemoryOwnerBytes("NetCaffe", mGpuId, bytes - mOwnerBytes);
+                        mOwnerBytes = bytes;
+                    }
+                    catch (const std::exception& e)
+                    {
+                        error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                    }
+                }
+
+                void placeBlobsIntoNetMemoryArena()
+                {
+                    try
+                    {
+                        // Only once per network input size and arena block
+                        if (mNetMemoryArenaGeneration == spNetMemoryArena->getGeneration()
+                            && vectorsAreEqual(mNetMemoryArenaInputSize4D, mNetInputSize4D))
+                            return;
+                        // The input (uploaded before the forward pass) and output (read after it) blobs keep their
+                        // own memory. Blobs sharing their memory (e.g., the outputs of Caffe split layers) are placed
+                        // once
+                        const auto& blobs = upCaffeNet->blobs();
+                        const std::set<const caffe::SyncedMemory*> ownMemories{
+                            blobs.at(0)->data().get(), spOutputBlob->data().get()};
+                        std::set<const caffe::SyncedMemory*> placedMemories;
+                        std::vector<std::pair<caffe::Blob<float>*, unsigned long long>> blobsAndOffsets;
+                        auto totalBytes = 0ull;
+                        for (const auto& blob : blobs)
+                        {
+                            const auto* const syncedMemory = blob->data().get();
+                            if (blob->count() > 0 && ownMemories.count(syncedMemory) == 0
+                                && placedMemories.insert(syncedMemory).second)
+                            {
+                                blobsAndOffsets.emplace_back(blob.get(), totalBytes);
+                                const auto blobBytes = (unsigned long long)blob->count() * sizeof(float);
+                                totalBytes += (blobBytes + NET_MEMORY_ARENA_ALIGNMENT - 1)
+                                            / NET_MEMORY_ARENA_ALIGNMENT * NET_MEMORY_ARENA_ALIGNMENT;
+                            }
+                        }
+                        // Caffe frees the memory of each blob once it points to the arena
+                        auto* const arenaPtr = (unsigned char*)spNetMemoryArena->reserve(totalBytes);
+                        for (const auto& blobAndOffset : blobsAndOffsets)
+                            blobAndOffset.first->set_gpu_data((float*)(arenaPtr + blobAndOffset.second));
+                        mNetMemoryArenaGeneration = spNetMemoryArena->getGeneration();
+                        mNetMemoryArenaInputSize4D = mNetInputSize4D;
+                        cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                    }
+                }
+            #endif
         #endif
     };
 
@@ -122,21 +309,250 @@ namespace op
         }
     #endif
 
+    #ifdef USE_CAFFE
+        std::shared_ptr<const caffe::NetParameter> parseTrainedModel(const std::string& caffeTrainedModel)
+        {
+            try
+            {
+                // Same as caffe::ReadNetParamsFromBinaryFileOrDie(), but parsed directly from the OS page cache
+                // (rather than copied through a file stream buffer)
+                const auto memoryMappedFile = getMemoryMappedFile(caffeTrainedModel);
+                if (memoryMappedFile->getSize() > (unsigned long long)INT_MAX)
+                    error("Caffe trained model file too big (> 2 GB): " + caffeTrainedModel + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+                google::protobuf::io::ArrayInputStream arrayInputStream{
+                    memoryMappedFile->getData(), (int)memoryMappedFile->getSize()};
+                google::protobuf::io::CodedInputStream codedInputStream{&arrayInputStream};
+                #if GOOGLE_PROTOBUF_VERSION >= 3006000
+                    codedInputStream.SetTotalBytesLimit(INT_MAX);
+                #else
+                    codedInputStream.SetTotalBytesLimit(INT_MAX, 536870912);
+                #endif
+                auto netParameter = std::make_shared<caffe::NetParameter>();
+                if (!netParameter->ParseFromCodedStream(&codedInputStream))
+                    error("Caffe trained model file could not be parsed: " + caffeTrainedModel + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+                caffe::UpgradeNetAsNeeded(caffeTrainedModel, netParameter.get());
+                return netParameter;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return nullptr;
+            }
+        }
+
+        struct SharedTrainedModel
+        {
+            std::mutex mutex;
+            std::weak_ptr<const caffe::NetParameter> wpNetParameter;
+        };
+
+        // Process-wide registry of the parsed (read-only) trained models, so the nets loading the same one (e.g.,
+        // one per GPU and scale) parse it only once, and the host memory does not grow with the number of GPUs
+        std::shared_ptr<const caffe::NetParameter> getSharedTrainedModel(const std::string& caffeTrainedModel)
+        {
+            try
+            {
+                static std::mutex sMutex;
+                static std::map<std::string, std::shared_ptr<SharedTrainedModel>> sSharedTrainedModels;
+                std::shared_ptr<SharedTrainedModel> sharedTrainedModel;
+                {
+                    const std::lock_guard<std::mutex> lock{sMutex};
+                    auto& sharedTrainedModelInMap = sSharedTrainedModels[caffeTrainedModel];
+                    if (sharedTrainedModelInMap == nullptr)
+                        sharedTrainedModelInMap = std::make_shared<SharedTrainedModel>();
+                    sharedTrainedModel = sharedTrainedModelInMap;
+                }
+                // Only 1 thread parses it, the others wait for it (rather than parsing their own copy)
+                const std::lock_guard<std::mutex> lock{sharedTrainedModel->mutex};
+                auto netParameter = sharedTrainedModel->wpNetParameter.lock();
+                if (netParameter == nullptr)
+                {
+                    netParameter = parseTrainedModel(caffeTrainedModel);
+                    sharedTrainedModel->wpNetParameter = netParameter;
+                }
+                return netParameter;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return nullptr;
+            }
+        }
+
+        #ifdef NV_CAFFE
+        std::shared_ptr<const caffe::NetParameter> copyTrainedLayers(
+            caffe::Net* caffeNet, const std::string& caffeTrainedModel)
+        #else
+        std::shared_ptr<const caffe::NetParameter> copyTrainedLayers(
+            caffe::Net<float>* caffeNet, const std::string& caffeTrainedModel)
+        #endif
+        {
+            try
+            {
+                // HDF5 models are read by Caffe
+                if (toLower(getFileExtension(caffeTrainedModel)) == "h5")
+                {
+                    caffeNet->CopyTrainedLayersFrom(caffeTrainedModel);
+                    return nullptr;
+                }
+                const auto netParameter = getSharedTrainedModel(caffeTrainedModel);
+                caffeNet->CopyTrainedLayersFrom(*netParameter);
+                return netParameter;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return nullptr;
+            }
+        }
+
+        // Stage index of a stage output blob, i.e., "Mconv7_stage<N><branch>" (or "conv5_5_CPM<branch>", the first
+        // stage of the COCO and MPI models), or INT_MAX if blobName is not a stage output
+        int getStageOutputIndex(const std::string& blobName, std::string& branch)
+        {
+            const std::string firstStagePrefix{"conv5_5_CPM"};
+            const std::string stagePrefix{"Mconv7_stage"};
+            if (blobName.compare(0, firstStagePrefix.size(), firstStagePrefix) == 0)
+            {
+                branch = blobName.substr(firstStagePrefix.size());
+                return -1;
+            }
+            if (blobName.compare(0, stagePrefix.size(), stagePrefix) != 0)
+                return INT_MAX;
+            auto stageEnd = stagePrefix.size();
+            while (stageEnd < blobName.size() && std::isdigit((unsigned char)blobName[stageEnd]))
+                stageEnd++;
+            if (stageEnd == stagePrefix.size())
+                return INT_MAX;
+            branch = blobName.substr(stageEnd);
+            return std::stoi(blobName.substr(stagePrefix.size(), stageEnd - stagePrefix.size()));
+        }
+
+        // It keeps only the layers the output layer (the one whose top is lastBlobName) depends on
+        std::vector<bool> getRequiredLayers(const caffe::NetParameter& netParameter, const int outputLayer)
+        {
+            std::vector<bool> requiredLayers(netParameter.layer_size(), false);
+            requiredLayers[outputLayer] = true;
+            std::set<std::string> requiredBlobs;
+            for (const auto& bottom : netParameter.layer(outputLayer).bottom())
+                requiredBlobs.emplace(bottom);
+            for (auto layerIndex = outputLayer - 1 ; layerIndex >= 0 ; layerIndex--)
+            {
+                const auto& layer = netParameter.layer(layerIndex);
+                for (const auto& top : layer.top())
+                    if (requiredBlobs.count(top) > 0)
+                        requiredLayers[layerIndex] = true;
+                if (requiredLayers[layerIndex])
+                    for (const auto& bottom : layer.bottom())
+                        requiredBlobs.emplace(bottom);
+            }
+            return requiredLayers;
+        }
+
+        // Multi-stage networks (e.g., the body ones): It reads caffeProto and truncates it to its first netStages
+        // stages of each branch (heat maps and PAFs), i.e., the output layer concatenates the outputs of those stages
+        // and the layers of the later stages are removed. If a branch depends on all the stages of another one (e.g.,
+        // the heat map stages of BODY_25 depend on the last PAF stage), the latter still uses its last stage.
+        caffe::NetParameter getStageTruncatedNetParameter(
+            const std::string& caffeProto, const int netStages, const std::string& lastBlobName)
+        {
+            try
+            {
+                caffe::NetParameter netParameter;
+                caffe::ReadNetParamsFromTextFileOrDie(caffeProto, &netParameter);
+                netParameter.mutable_state()->set_phase(caffe::TEST);
+                // Output layer and the last layer writing each stage output
+                auto outputLayer = -1;
+                std::map<std::string, std::map<int, std::string>> stageOutputs;
+                std::map<std::string, int> stageOutputLayers;
+                for (auto layerIndex = 0 ; layerIndex < netParameter.layer_size() ; layerIndex++)
+                {
+                    for (const auto& top : netParameter.layer(layerIndex).top())
+                    {
+                        if (top == lastBlobName)
+                            outputLayer = layerIndex;
+                        std::string branch;
+                        const auto stage = getStageOutputIndex(top, branch);
+                        if (stage != INT_MAX)
+                        {
+                            stageOutputs[branch][stage] = top;
+                            stageOutputLayers[top] = layerIndex;
+                        }
+                    }
+                }
+                if (outputLayer < 0)
+                    error("The output blob (" + lastBlobName + ") was not found in " + caffeProto + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+                // The output stages of each branch
+                auto& outputLayerParameter = *netParameter.mutable_layer(outputLayer);
+                std::vector<std::string> branches;
+                for (auto bottomIndex = 0 ; bottomIndex < outputLayerParameter.bottom_size() ; bottomIndex++)
+                {
+                    std::string branch;
+                    if (getStageOutputIndex(outputLayerParameter.bottom(bottomIndex), branch) == INT_MAX)
+                        error("The network of " + caffeProto + " cannot be truncated by stages, the input `"
+                              + outputLayerParameter.bottom(bottomIndex) + "` of its output layer is not the output of"
+                              " a stage (`Mconv7_stage<N>...`).", __LINE__, __FUNCTION__, __FILE__);
+                    const auto& branchStages = stageOutputs.at(branch);
+                    auto stageIterator = branchStages.begin();
+                    std::advance(stageIterator, fastMin(netStages, (int)branchStages.size()) - 1);
+                    outputLayerParameter.set_bottom(bottomIndex, stageIterator->second);
+                    branches.emplace_back(branch);
+                }
+                // Branches computed anyway (required by another branch) use their last computed stage
+                const auto requiredLayers = getRequiredLayers(netParameter, outputLayer);
+                for (auto bottomIndex = 0 ; bottomIndex < outputLayerParameter.bottom_size() ; bottomIndex++)
+                    for (const auto& stageAndOutput : stageOutputs.at(branches[bottomIndex]))
+                        if (requiredLayers[stageOutputLayers.at(stageAndOutput.second)])
+                            outputLayerParameter.set_bottom(bottomIndex, stageAndOutput.second);
+                // Truncated network
+                caffe::NetParameter truncatedNetParameter{netParameter};
+                truncatedNetParameter.clear_layer();
+                std::string outputBlobs;
+                for (const auto& bottom : outputLayerParameter.bottom())
+                    outputBlobs += (outputBlobs.empty() ? "" : ", ") + bottom;
+                auto numberLayers = 0;
+                for (auto layerIndex = 0 ; layerIndex <= outputLayer ; layerIndex++)
+                {
+                    if (requiredLayers[layerIndex])
+                    {
+                        *truncatedNetParameter.add_layer() = netParameter.layer(layerIndex);
+                        numberLayers++;
+                    }
+                }
+                opLog("Network truncated to its first " + std::to_string(netStages) + " stage(s): " + lastBlobName
+                      + " = {" + outputBlobs + "}, " + std::to_string(numberLayers) + " of "
+                      + std::to_string(netParameter.layer_size()) + " layers.", Priority::High);
+                return truncatedNetParameter;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return caffe::NetParameter{};
+            }
+        }
+    #endif
+
     NetCaffe::NetCaffe(const std::string& caffeProto, const std::string& caffeTrainedModel, const int gpuId,
-                       const bool enableGoogleLogging, const std::string& lastBlobName)
+                       const bool enableGoogleLogging, const std::string& lastBlobName,
+                       const std::shared_ptr<NetMemoryArena>& netMemoryArena, const int netStages)
         #ifdef USE_CAFFE
             : upImpl{new ImplNetCaffe{caffeProto, caffeTrainedModel, gpuId, enableGoogleLogging,
-                                      lastBlobName}}
+                                      lastBlobName, netMemoryArena, netStages}}
         #endif
     {
         try
         {
             #ifndef USE_CAFFE
+                UNUSED(netStages);
                 UNUSED(caffeProto);
                 UNUSED(caffeTrainedModel);
                 UNUSED(gpuId);
                 UNUSED(enableGoogleLogging);
                 UNUSED(lastBlobName);
+                UNUSED(netMemoryArena);
                 error("OpenPose must be compiled with the `USE_CAFFE` macro definition in order to use this"
                       " functionality.", __LINE__, __FUNCTION__, __FILE__);
             #endif
@@ -156,34 +572,70 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
+                // Network truncated to its first mNetStages stages (if any)
+                const auto truncated = (upImpl->mNetStages > 0);
+                const auto netParameter = (truncated
+                    ? getStageTruncatedNetParameter(upImpl->mCaffeProto, upImpl->mNetStages, upImpl->mLastBlobName)
+                    : caffe::NetParameter{});
                 // Initialize net
                 #ifdef USE_OPENCL
                     caffe::Caffe::set_mode(caffe::Caffe::GPU);
                     caffe::Caffe::SelectDevice(upImpl->mGpuId, true);
-                    upImpl->upCaffeNet.reset(new caffe::Net<float>{upImpl->mCaffeProto, caffe::TEST,
-                                             caffe::Caffe::GetDefaultDevice()});
-                    upImpl->upCaffeNet->CopyTrainedLayersFrom(upImpl->mCaffeTrainedModel);
+                    if (truncated)
+                        upImpl->upCaffeNet.reset(new caffe::Net<float>{
+                            netParameter, caffe::Caffe::GetDefaultDevice()});
+                    else
+                        upImpl->upCaffeNet.reset(new caffe::Net<float>{upImpl->mCaffeProto, caffe::TEST,
+                                                 caffe::Caffe::GetDefaultDevice()});
+                    upImpl->spTrainedModel = copyTrainedLayers(
+                        upImpl->upCaffeNet.get(), upImpl->mCaffeTrainedModel);
                     OpenCL::getInstance(upImpl->mGpuId, CL_DEVICE_TYPE_GPU, true);
                 #else
                     #ifdef USE_CUDA
                         caffe::Caffe::set_mode(caffe::Caffe::GPU);
                         caffe::Caffe::SetDevice(upImpl->mGpuId);
                         #ifdef NV_CAFFE
-                            upImpl->upCaffeNet.reset(new caffe::Net{upImpl->mCaffeProto, caffe::TEST});
+                            if (truncated)
+                                upImpl->upCaffeNet.reset(new caffe::Net{netParameter});
+                            else
+                                upImpl->upCaffeNet.reset(new caffe::Net{upImpl->mCaffeProto, caffe::TEST});
                         #else
-                            upImpl->upCaffeNet.reset(new caffe::Net<float>{upImpl->mCaffeProto, caffe::TEST});
+                            if (truncated)
+                                upImpl->upCaffeNet.reset(new caffe::Net<float>{netParameter});
+                            else
+                                upImpl->upCaffeNet.reset(new caffe::Net<float>{upImpl->mCaffeProto, caffe::TEST});
                         #endif
                     #else
                         caffe::Caffe::set_mode(caffe::Caffe::CPU);
                         #ifdef _WIN32
-                            upImpl->upCaffeNet.reset(new caffe::Net<float>{upImpl->mCaffeProto, caffe::TEST,
-                                                                           caffe::Caffe::GetCPUDevice()});
+                            if (truncated)
+                                upImpl->upCaffeNet.reset(new caffe::Net<float>{
+                                    netParameter, caffe::Caffe::GetCPUDevice()});
+                            else
+                                upImpl->upCaffeNet.reset(new caffe::Net<float>{
+                                    upImpl->mCaffeProto, caffe::TEST, caffe::Caffe::GetCPUDevice()});
                         #else
-                            upImpl->upCaffeNet.reset(new caffe::Net<float>{upImpl->mCaffeProto, caffe::TEST});
+                            if (truncated)
+                                upImpl->upCaffeNet.reset(new caffe::Net<float>{netParameter});
+                            else
+                                upImpl->upCaffeNet.reset(new caffe::Net<float>{upImpl->mCaffeProto, caffe::TEST});
                         #endif
                     #endif
-                    upImpl->upCaffeNet->CopyTrainedLayersFrom(upImpl->mCaffeTrainedModel);
+                    upImpl->spTrainedModel = copyTrainedLayers(
+                        upImpl->upCaffeNet.get(), upImpl->mCaffeTrainedModel);
                     #ifdef USE_CUDA
+                        // Upload stream. It is a blocking stream, so the upload is still ordered with respect to the
+                        // Caffe forward passes (which run on the default stream)
+                        if (upImpl->mUploadStream == nullptr)
+                            cudaStreamCreate(&upImpl->mUploadStream);
+                        if (upImpl->mUploadEvent == nullptr)
+                            cudaEventCreateWithFlags(&upImpl->mUploadEvent, cudaEventDisableTiming);
+                        #ifndef NV_CAFFE
+                            upImpl->mIntegratedGpu = isIntegratedGpu(upImpl->mGpuId);
+                            if (upImpl->mIntegratedGpu)
+                                opLog("Integrated GPU " + std::to_string(upImpl->mGpuId) + " found, the network"
+                                      " input is read in place from pinned memory (zero-copy).", Priority::High);
+                        #endif
                         cudaCheck(__LINE__, __FUNCTION__, __FILE__);
                     #endif
                 #endif
@@ -199,6 +651,9 @@ namespace op
                     error("The output blob is a nullptr. Did you use the same name than the prototxt? (Used: "
                           + upImpl->mLastBlobName + ").", __LINE__, __FUNCTION__, __FILE__);
                 #ifdef USE_CUDA
+                    #ifndef NV_CAFFE
+                        upImpl->updateOwnerBytes();
+                    #endif
                     cudaCheck(__LINE__, __FUNCTION__, __FILE__);
                 #endif
             #endif
@@ -214,6 +669,7 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
+                const TraceRange traceRange{"NetCaffe::forwardPass"};
                 // Sanity checks
                 if (inputData.empty())
                     error("The Array inputData cannot be empty.", __LINE__, __FUNCTION__, __FILE__);
@@ -225,16 +681,66 @@ namespace op
                 {
                     upImpl->mNetInputSize4D = inputData.getSize();
                     reshapeNetCaffe(upImpl->upCaffeNet.get(), inputData.getSize());
+                    #if defined USE_CUDA && !defined NV_CAFFE
+                        upImpl->updateOwnerBytes();
+                    #endif
                 }
                 // Copy frame data to GPU memory
                 #ifdef USE_CUDA
-                    #ifdef NV_CAFFE
-                        auto* gpuImagePtr = upImpl->upCaffeNet->blobs().at(0)->mutable_gpu_data<float>();
-                    #else
-                        auto* gpuImagePtr = upImpl->upCaffeNet->blobs().at(0)->mutable_gpu_data();
+                    // The previous upload must have finished before its staging memory is overwritten
+                    const auto volume = (unsigned long long)inputData.getVolume();
+                    cudaEventSynchronize(upImpl->mUploadEvent);
+                    upImpl->mUploadingInput.reset();
+                    // Already pinned input (e.g., from CvMatToOpInput): Uploaded directly
+                    const float* pinnedInputPtr = inputData.getConstPtr();
+                    if (isPinnedMemory(pinnedInputPtr))
+                        upImpl->mUploadingInput = inputData;
+                    // Otherwise: Staged into pinned memory
+                    else
+                    {
+                        if (upImpl->mPinnedInputVolume < volume)
+                        {
+                            if (upImpl->pPinnedInputPtr != nullptr)
+                                cudaFreeHost(upImpl->pPinnedInputPtr);
+                            cudaHostAlloc(
+                                (void**)&upImpl->pPinnedInputPtr, volume * sizeof(float), cudaHostAllocMapped);
+                            upImpl->mPinnedInputVolume = volume;
+                        }
+                        std::copy(inputData.getConstPtr(), inputData.getConstPtr() + volume, upImpl->pPinnedInputPtr);
+                        pinnedInputPtr = upImpl->pPinnedInputPtr;
+                    }
+                    // Integrated GPU: The GPU shares the physical memory, so the network reads the pinned memory in
+                    // place (zero-copy) rather than copying it into device memory first
+                    float* mappedInputPtr = nullptr;
+                    #ifndef NV_CAFFE
+                        if (upImpl->mIntegratedGpu)
+                        {
+                            void* devicePtr = nullptr;
+                            if (cudaHostGetDevicePointer(&devicePtr, (void*)pinnedInputPtr, 0) == cudaSuccess)
+                                mappedInputPtr = (float*)devicePtr;
+                            else
+                                cudaGetLastError();
+                        }
                     #endif
-                    cudaMemcpy(gpuImagePtr, inputData.getConstPtr(), inputData.getVolume() * sizeof(float),
-                               cudaMemcpyHostToDevice);
+                    if (mappedInputPtr != nullptr)
+                    {
+                        #ifndef NV_CAFFE
+                            upImpl->upCaffeNet->blobs().at(0)->set_gpu_data(mappedInputPtr);
+                            upImpl->mInputAliased = true;
+                        #endif
+                    }
+                    // Asynchronous (DMA) copy from pinned memory, ForwardFrom() is queued right after it
+                    else
+                    {
+                        #ifdef NV_CAFFE
+                            auto* gpuImagePtr = upImpl->upCaffeNet->blobs().at(0)->mutable_gpu_data<float>();
+                        #else
+                            auto* gpuImagePtr = upImpl->getOwnInputGpuPtr();
+                        #endif
+                        cudaMemcpyAsync(gpuImagePtr, pinnedInputPtr, volume * sizeof(float),
+                                        cudaMemcpyHostToDevice, upImpl->mUploadStream);
+                        cudaEventRecord(upImpl->mUploadEvent, upImpl->mUploadStream);
+                    }
                 #elif defined USE_OPENCL
                     auto* gpuImagePtr = upImpl->upCaffeNet->blobs().at(0)->mutable_gpu_data();
                     cl::Buffer imageBuffer = cl::Buffer((cl_mem)gpuImagePtr, true);
@@ -244,8 +750,21 @@ namespace op
                     auto* cpuImagePtr = upImpl->upCaffeNet->blobs().at(0)->mutable_cpu_data();
                     std::copy(inputData.getConstPtr(), inputData.getConstPtr() + inputData.getVolume(), cpuImagePtr);
                 #endif
+                // Intermediate activations into the shared network memory
+                #if defined USE_CUDA && !defined NV_CAFFE
+                    if (upImpl->spNetMemoryArena != nullptr)
+                        upImpl->placeBlobsIntoNetMemoryArena();
+                #endif
                 // Perform deep network forward pass
                 upImpl->upCaffeNet->ForwardFrom(0);
+                // Zero-copy: The pinned input is read by the forward pass itself, so it must not be overwritten (or
+                // released) until the forward pass finishes
+                #if defined USE_CUDA && !defined NV_CAFFE
+                    if (upImpl->mInputAliased)
+                        cudaEventRecord(upImpl->mUploadEvent, nullptr);
+                #endif
+                // Loading finished: The parsed trained model is released once no other net is loading it
+                upImpl->spTrainedModel.reset();
                 // Cuda checks
                 #ifdef USE_CUDA
                     cudaCheck(__LINE__, __FUNCTION__, __FILE__);
@@ -260,6 +779,110 @@ namespace op
         }
     }
 
+    float* NetCaffe::getInputGpuPtr(const std::vector<int>& inputSize4D)
+    {
+        try
+        {
+            #if defined USE_CAFFE && defined USE_CUDA
+                // Sanity check
+                if (inputSize4D.size() != 4 || inputSize4D[1] != 3)
+                    error("The input size must have 4 dimensions: [batch size, 3 (RGB), height, width].",
+                          __LINE__, __FUNCTION__, __FILE__);
+                // Reshape Caffe net if required
+                if (!vectorsAreEqual(upImpl->mNetInputSize4D, inputSize4D))
+                {
+                    upImpl->mNetInputSize4D = inputSize4D;
+                    reshapeNetCaffe(upImpl->upCaffeNet.get(), inputSize4D);
+                    #ifndef NV_CAFFE
+                        upImpl->updateOwnerBytes();
+                    #endif
+                }
+                // The previous upload of forwardPass() (if any) must not overwrite it
+                if (upImpl->mUploadEvent != nullptr)
+                    cudaEventSynchronize(upImpl->mUploadEvent);
+                #ifdef NV_CAFFE
+                    return upImpl->upCaffeNet->blobs().at(0)->mutable_gpu_data<float>();
+                #else
+                    return upImpl->getOwnInputGpuPtr();
+                #endif
+            #else
+                UNUSED(inputSize4D);
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    void NetCaffe::forwardPassOnGpuInput() const
+    {
+        try
+        {
+            #if defined USE_CAFFE && defined USE_CUDA
+                const TraceRange traceRange{"NetCaffe::forwardPassOnGpuInput"};
+                // Intermediate activations into the shared network memory
+                #if defined USE_CUDA && !defined NV_CAFFE
+                    if (upImpl->spNetMemoryArena != nullptr)
+                        upImpl->placeBlobsIntoNetMemoryArena();
+                #endif
+                // Perform deep network forward pass
+                upImpl->upCaffeNet->ForwardFrom(0);
+                // Loading finished: The parsed trained model is released once no other net is loading it
+                upImpl->spTrainedModel.reset();
+                // Cuda checks
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            #else
+                error("OpenPose must be compiled with the `USE_CAFFE` & `USE_CUDA` macro definitions in order to run"
+                      " this functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void NetCaffe::reserveInputSizes(const std::vector<std::vector<int>>& inputSizes4D)
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                // Caffe blobs (and the cuDNN workspace) only reallocate when they grow, so reshaping the net for the
+                // largest size leaves it allocated for all of them
+                auto maxVolume = 0ll;
+                for (const auto& inputSize4D : inputSizes4D)
+                {
+                    if (inputSize4D.size() != 4 || inputSize4D[1] != 3)
+                        error("The input sizes must have 4 dimensions: [batch size, 3 (RGB), height, width].",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    const auto volume = std::accumulate(
+                        inputSize4D.begin(), inputSize4D.end(), 1ll, std::multiplies<long long>());
+                    if (maxVolume < volume)
+                    {
+                        maxVolume = volume;
+                        upImpl->mNetInputSize4D = inputSize4D;
+                    }
+                }
+                if (maxVolume > 0)
+                {
+                    reshapeNetCaffe(upImpl->upCaffeNet.get(), upImpl->mNetInputSize4D);
+                    #if defined USE_CUDA && !defined NV_CAFFE
+                        upImpl->updateOwnerBytes();
+                    #endif
+                }
+            #else
+                UNUSED(inputSizes4D);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     std::shared_ptr<ArrayCpuGpu<float>> NetCaffe::getOutputBlobArray() const
     {
         try
@@ -276,4 +899,50 @@ namespace op
             return nullptr;
         }
     }
+
+    std::vector<std::string> NetCaffe::getBlobNames() const
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                if (upImpl->upCaffeNet == nullptr)
+                    error("The network must be initialized (initializationOnThread()) first.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                return upImpl->upCaffeNet->blob_names();
+            #else
+                return {};
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::shared_ptr<ArrayCpuGpu<float>> NetCaffe::getBlobArray(const std::string& blobName) const
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                if (upImpl->upCaffeNet == nullptr || !upImpl->upCaffeNet->has_blob(blobName))
+                    return nullptr;
+                #ifdef NV_CAFFE
+                    const auto spBlob = boost::static_pointer_cast<caffe::TBlob<float>>(
+                        upImpl->upCaffeNet->blob_by_name(blobName));
+                #else
+                    const auto spBlob = upImpl->upCaffeNet->blob_by_name(blobName);
+                #endif
+                return std::make_shared<ArrayCpuGpu<float>>(spBlob.get());
+            #else
+                UNUSED(blobName);
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
 }
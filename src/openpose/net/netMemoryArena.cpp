@@ -0,0 +1,90 @@
+#include <openpose/net/netMemoryArena.hpp>
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+    #include <openpose/gpu/cudaMemoryPool.hpp>
+#endif
+
+namespace op
+{
+    NetMemoryArena::NetMemoryArena(const int gpuId) :
+        mGpuId{gpuId},
+        pGpuPtr{nullptr},
+        mBytes{0ull},
+        mGeneration{0ull}
+    {
+    }
+
+    NetMemoryArena::~NetMemoryArena()
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                if (pGpuPtr != nullptr)
+                {
+                    cudaFree(pGpuPtr);
+                    addCudaMemoryOwnerBytes("NetMemoryArena", mGpuId, -(long long)mBytes);
+                }
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void* NetMemoryArena::reserve(const unsigned long long bytes)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                if (mBytes < bytes)
+                {
+                    // cudaFree waits for the kernels that might still be using the previous block
+                    if (pGpuPtr != nullptr)
+                    {
+                        cudaFree(pGpuPtr);
+                        addCudaMemoryOwnerBytes("NetMemoryArena", mGpuId, -(long long)mBytes);
+                    }
+                    pGpuPtr = nullptr;
+                    mBytes = 0ull;
+                    if (cudaMalloc(&pGpuPtr, bytes) != cudaSuccess)
+                    {
+                        pGpuPtr = nullptr;
+                        cudaGetLastError(); // Reset the error
+                        error("The shared network memory (" + std::to_string(bytes >> 20) + " MB) could not be"
+                              " allocated on GPU " + std::to_string(mGpuId) + ".", __LINE__, __FUNCTION__, __FILE__);
+                    }
+                    mBytes = bytes;
+                    mGeneration++;
+                    addCudaMemoryOwnerBytes("NetMemoryArena", mGpuId, (long long)mBytes);
+                    opLog("Shared network memory of GPU " + std::to_string(mGpuId) + ": "
+                          + std::to_string(mBytes >> 20) + " MB.", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                }
+                return pGpuPtr;
+            #else
+                UNUSED(bytes);
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    unsigned long long NetMemoryArena::getBytes() const
+    {
+        return mBytes;
+    }
+
+    unsigned long long NetMemoryArena::getGeneration() const
+    {
+        return mGeneration;
+    }
+
+    int NetMemoryArena::getGpuId() const
+    {
+        return mGpuId;
+    }
+}
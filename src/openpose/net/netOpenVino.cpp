@@ -0,0 +1,461 @@
+#include <openpose/net/netOpenVino.hpp>
+#ifdef USE_OPENVINO
+    #if defined(USE_CAFFE) && defined(USE_CPU_ONLY)
+        #include <algorithm> // std::find
+        #include <cmath> // std::abs
+        #include <map>
+        #include <mutex>
+        #include <numeric> // std::accumulate
+        #include <tuple>
+        #include <openvino/openvino.hpp>
+        #include <openvino/opsets/opset8.hpp>
+        #include <openpose/net/int8Calibrator.hpp>
+        #include <openpose/utilities/fastMath.hpp>
+    #else
+        #error In order to enable the OpenVINO backend in OpenPose, the CMake flags of Caffe and CPU_ONLY must be \
+               enabled (the output blob and the CPU post-processing Caffe layers are still required).
+    #endif
+#endif
+#include <openpose/utilities/fileSystem.hpp>
+#include <openpose/utilities/standard.hpp>
+
+namespace op
+{
+    #ifdef USE_OPENVINO
+        struct OpenVinoModel
+        {
+            std::shared_ptr<ov::Model> spModel;
+            // Whether it has quantization (FakeQuantize) layers, which the CPU plugin runs in INT8
+            bool quantized;
+        };
+
+        // Model compiled for a given input size (with batch size 1)
+        struct OpenVinoCompiledModel
+        {
+            ov::CompiledModel compiledModel;
+            ov::Shape inputShape;
+            ov::Shape outputShape;
+            std::size_t outputIndex;
+            unsigned int optimalNumberRequests;
+        };
+
+        // Instance-specific infer requests of a given input size
+        struct OpenVinoEngine
+        {
+            std::shared_ptr<OpenVinoCompiledModel> spCompiledModel;
+            std::vector<ov::InferRequest> inferRequests;
+            std::vector<int> outputSize;
+        };
+
+        // Shared by all the NetOpenVino instances (e.g., one per CPU worker), so each model is only read and
+        // compiled once, and all of them use the same OpenVINO CPU streams
+        std::mutex sMutexNetOpenVino;
+        std::map<std::pair<std::string, bool>, OpenVinoModel> sOpenVinoModels;
+        std::map<std::tuple<std::string, int, std::vector<int>>, std::shared_ptr<OpenVinoCompiledModel>>
+            sOpenVinoCompiledModels;
+
+        ov::Core& getOpenVinoCore()
+        {
+            static ov::Core sOpenVinoCore;
+            return sOpenVinoCore;
+        }
+
+        std::string getSizeString(const std::vector<int>& size)
+        {
+            std::string sizeString;
+            for (const auto value : size)
+                sizeString += (sizeString.empty() ? "" : "x") + std::to_string(value);
+            return sizeString;
+        }
+
+        long long getVolume(const std::vector<int>& size)
+        {
+            return std::accumulate(size.begin(), size.end(), 1ll, std::multiplies<long long>());
+        }
+
+        std::shared_ptr<ov::Node> makeFakeQuantize(
+            const ov::Output<ov::Node>& input, const ov::Shape& rangeShape, const std::vector<float>& lows,
+            const std::vector<float>& highs)
+        {
+            const auto inputLow = ov::opset8::Constant::create(ov::element::f32, rangeShape, lows);
+            const auto inputHigh = ov::opset8::Constant::create(ov::element::f32, rangeShape, highs);
+            const auto outputLow = ov::opset8::Constant::create(ov::element::f32, rangeShape, lows);
+            const auto outputHigh = ov::opset8::Constant::create(ov::element::f32, rangeShape, highs);
+            // 255 levels: Symmetric INT8 range [-127, 127], as the TensorRT scales
+            return std::make_shared<ov::opset8::FakeQuantize>(
+                input, inputLow, inputHigh, outputLow, outputHigh, 255);
+        }
+
+        // It adds the INT8 quantization (FakeQuantize layers) of the activations (per-tensor, from the calibration
+        // thresholds) and weights (per-output-channel) of each convolution whose input has a threshold, so the CPU
+        // plugin runs them in INT8. It returns the number of quantized convolutions.
+        int addFakeQuantize(const std::shared_ptr<ov::Model>& spModel, const std::map<std::string, float>& thresholds)
+        {
+            try
+            {
+                auto numberQuantized = 0;
+                for (const auto& node : spModel->get_ordered_ops())
+                {
+                    if (!ov::is_type<ov::opset8::Convolution>(node))
+                        continue;
+                    // Activation threshold, matched by tensor name
+                    const auto activation = node->input_value(0);
+                    auto threshold = 0.f;
+                    for (const auto& tensorName : activation.get_names())
+                    {
+                        const auto thresholdIterator = thresholds.find(tensorName);
+                        if (thresholdIterator != thresholds.end())
+                            threshold = thresholdIterator->second;
+                    }
+                    const auto spWeights = std::dynamic_pointer_cast<ov::opset8::Constant>(
+                        node->get_input_node_shared_ptr(1));
+                    if (threshold <= 0.f || spWeights == nullptr)
+                        continue;
+                    // Weight ranges: Maximum absolute value of each output channel
+                    const auto weights = spWeights->cast_vector<float>();
+                    const auto numberChannels = spWeights->get_shape().at(0);
+                    const auto channelVolume = weights.size() / numberChannels;
+                    std::vector<float> weightHighs(numberChannels, 0.f);
+                    for (auto channel = 0u ; channel < numberChannels ; channel++)
+                    {
+                        for (auto i = channel * channelVolume ; i < (channel + 1) * channelVolume ; i++)
+                            weightHighs[channel] = fastMax(weightHighs[channel], std::abs(weights[i]));
+                        weightHighs[channel] = fastMax(weightHighs[channel], 1e-8f);
+                    }
+                    std::vector<float> weightLows(numberChannels);
+                    for (auto channel = 0u ; channel < numberChannels ; channel++)
+                        weightLows[channel] = -weightHighs[channel];
+                    node->input(0).replace_source_output(
+                        makeFakeQuantize(activation, ov::Shape{}, {-threshold}, {threshold}));
+                    node->input(1).replace_source_output(
+                        makeFakeQuantize(node->input_value(1), ov::Shape{numberChannels, 1, 1, 1}, weightLows,
+                                         weightHighs));
+                    numberQuantized++;
+                }
+                spModel->validate_nodes_and_infer_types();
+                return numberQuantized;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return 0;
+            }
+        }
+    #endif
+
+    struct NetOpenVino::ImplNetOpenVino
+    {
+        #ifdef USE_OPENVINO
+            // Init with constructor
+            const std::string mModel;
+            const int mPrecision;
+            const int mNumberRequests;
+            const std::string mLastBlobName;
+            // Init with thread
+            std::map<std::vector<int>, OpenVinoEngine> mEngines;
+            OpenVinoEngine* pEngine;
+            std::vector<int> mNetInputSize4D;
+            std::shared_ptr<ArrayCpuGpu<float>> spOutputBlob;
+
+            ImplNetOpenVino(const std::string& model, const int precision, const int numberRequests,
+                            const std::string& lastBlobName) :
+                mModel{model},
+                mPrecision{precision},
+                mNumberRequests{numberRequests},
+                mLastBlobName{lastBlobName},
+                pEngine{nullptr}
+            {
+                try
+                {
+                    if (!existFile(mModel))
+                        error("OpenVINO model file not found: " + mModel + ". Did you convert the OpenPose model"
+                              " to OpenVINO IR (or ONNX) and set its path with `--caffemodel_path`?",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    if (mPrecision != 32 && mPrecision != 16 && mPrecision != 8)
+                        error("The OpenVINO precision must be 32, 16 or 8 (used: " + std::to_string(mPrecision)
+                              + ").", __LINE__, __FUNCTION__, __FILE__);
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            std::shared_ptr<OpenVinoCompiledModel> getCompiledModel(const std::vector<int>& inputSize)
+            {
+                try
+                {
+                    const std::lock_guard<std::mutex> lock{sMutexNetOpenVino};
+                    // Batch size 1: The images of a batch are run by different (parallel) infer requests
+                    const std::vector<int> imageSize{1, inputSize[1], inputSize[2], inputSize[3]};
+                    auto& spCompiledModel = sOpenVinoCompiledModels[std::make_tuple(mModel, mPrecision, imageSize)];
+                    if (spCompiledModel == nullptr)
+                    {
+                        auto& core = getOpenVinoCore();
+                        // Read model (once for all the input sizes). INT8 uses its own copy, as the quantization
+                        // from the calibration cache is added into it
+                        const auto int8 = (mPrecision == 8);
+                        auto& model = sOpenVinoModels[std::make_pair(mModel, int8)];
+                        if (model.spModel == nullptr)
+                        {
+                            model.spModel = core.read_model(mModel);
+                            if (model.spModel->inputs().size() != 1)
+                                error("The OpenVINO model must have a single input (the image).",
+                                      __LINE__, __FUNCTION__, __FILE__);
+                            // Channel-last (e.g., "NHWC") outputs: The CPU post-processing only reads NCHW blobs, so
+                            // OpenVINO transposes them itself as part of the compiled model
+                            ov::preprocess::PrePostProcessor prePostProcessor{model.spModel};
+                            for (auto i = 0u ; i < model.spModel->outputs().size() ; i++)
+                            {
+                                const auto layout = ov::layout::get_layout(model.spModel->output(i));
+                                if (ov::layout::has_channels(layout) && ov::layout::channels_idx(layout) != 1)
+                                    prePostProcessor.output(i).tensor().set_layout("NCHW");
+                            }
+                            model.spModel = prePostProcessor.build();
+                            model.quantized = false;
+                            for (const auto& node : model.spModel->get_ops())
+                            {
+                                if (std::string{node->get_type_name()} == "FakeQuantize")
+                                {
+                                    model.quantized = true;
+                                    break;
+                                }
+                            }
+                            if (int8 && !model.quantized)
+                            {
+                                const auto calibrationCachePath = mModel + ".int8.calib";
+                                if (!existFile(calibrationCachePath))
+                                    error("The OpenVINO INT8 precision requires a quantized model, or the INT8"
+                                          " calibration cache " + calibrationCachePath + " (e.g., generated with"
+                                          " openpose_calibrate_int8).", __LINE__, __FUNCTION__, __FILE__);
+                                const auto numberQuantized = addFakeQuantize(
+                                    model.spModel, readInt8CalibrationCache(calibrationCachePath));
+                                if (numberQuantized == 0)
+                                    error("No convolution input of the OpenVINO model matches the tensor names of "
+                                          + calibrationCachePath + ".", __LINE__, __FUNCTION__, __FILE__);
+                                opLog("INT8 quantization added to " + std::to_string(numberQuantized)
+                                      + " convolutions of the OpenVINO model.", Priority::High);
+                                model.quantized = true;
+                            }
+                        }
+                        if (!int8 && model.quantized)
+                            opLog("The OpenVINO model is quantized, so its quantized layers run in INT8 regardless"
+                                  " of the selected precision.", Priority::High);
+                        // Fixed input size, so the CPU plugin picks the fastest kernels (and memory layout) for it
+                        model.spModel->reshape(
+                            ov::PartialShape{imageSize[0], imageSize[1], imageSize[2], imageSize[3]});
+                        // Throughput mode: Several CPU streams, each one running a different infer request
+                        ov::AnyMap configuration;
+                        configuration.insert(ov::hint::performance_mode(ov::hint::PerformanceMode::THROUGHPUT));
+                        if (mPrecision == 16)
+                        {
+                            const auto capabilities = core.get_property("CPU", ov::device::capabilities);
+                            if (std::find(capabilities.begin(), capabilities.end(), ov::device::capability::BF16)
+                                != capabilities.end())
+                                configuration.insert(ov::hint::inference_precision(ov::element::bf16));
+                            else
+                            {
+                                opLog("This CPU does not have native BF16 support, so OpenVINO runs in FP32.",
+                                      Priority::High);
+                                configuration.insert(ov::hint::inference_precision(ov::element::f32));
+                            }
+                        }
+                        else
+                            configuration.insert(ov::hint::inference_precision(ov::element::f32));
+                        opLog("Compiling the OpenVINO model for the network input size " + getSizeString(imageSize)
+                              + ".", Priority::High);
+                        spCompiledModel = std::make_shared<OpenVinoCompiledModel>();
+                        spCompiledModel->compiledModel = core.compile_model(model.spModel, "CPU", configuration);
+                        spCompiledModel->inputShape = spCompiledModel->compiledModel.input().get_shape();
+                        // If no output has the name mLastBlobName, the last one is used
+                        const auto outputs = spCompiledModel->compiledModel.outputs();
+                        spCompiledModel->outputIndex = outputs.size() - 1;
+                        for (auto i = 0u ; i < outputs.size() ; i++)
+                            if (outputs[i].get_names().count(mLastBlobName) > 0)
+                                spCompiledModel->outputIndex = i;
+                        spCompiledModel->outputShape = outputs.at(spCompiledModel->outputIndex).get_shape();
+                        if (spCompiledModel->outputShape.size() != 4)
+                            error("The network output must have 4 dimensions.", __LINE__, __FUNCTION__, __FILE__);
+                        spCompiledModel->optimalNumberRequests = fastMax(
+                            1u, (unsigned int)spCompiledModel->compiledModel.get_property(
+                                ov::optimal_number_of_infer_requests));
+                    }
+                    return spCompiledModel;
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                    return nullptr;
+                }
+            }
+
+            OpenVinoEngine* getEngine(const std::vector<int>& inputSize)
+            {
+                try
+                {
+                    auto& engine = mEngines[inputSize];
+                    if (engine.spCompiledModel == nullptr)
+                    {
+                        engine.spCompiledModel = getCompiledModel(inputSize);
+                        // No more requests than images per batch
+                        const auto numberRequests = fastMin(
+                            inputSize[0], (mNumberRequests > 0
+                                ? mNumberRequests : (int)engine.spCompiledModel->optimalNumberRequests));
+                        for (auto i = 0 ; i < numberRequests ; i++)
+                            engine.inferRequests.emplace_back(
+                                engine.spCompiledModel->compiledModel.create_infer_request());
+                        const auto& outputShape = engine.spCompiledModel->outputShape;
+                        engine.outputSize = {
+                            inputSize[0], (int)outputShape[1], (int)outputShape[2], (int)outputShape[3]};
+                    }
+                    return &engine;
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                    return nullptr;
+                }
+            }
+        #endif
+    };
+
+    NetOpenVino::NetOpenVino(const std::string& model, const int precision, const int numberRequests,
+                             const std::string& lastBlobName)
+        #ifdef USE_OPENVINO
+            : upImpl{new ImplNetOpenVino{model, precision, numberRequests, lastBlobName}}
+        #endif
+    {
+        try
+        {
+            #ifndef USE_OPENVINO
+                UNUSED(model);
+                UNUSED(precision);
+                UNUSED(numberRequests);
+                UNUSED(lastBlobName);
+                error("OpenPose must be compiled with the `USE_OPENVINO` macro definition (CMake flag"
+                      " `WITH_OPENVINO`) in order to use this functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    NetOpenVino::~NetOpenVino()
+    {
+    }
+
+    void NetOpenVino::initializationOnThread()
+    {
+        try
+        {
+            #ifdef USE_OPENVINO
+                upImpl->spOutputBlob = std::make_shared<ArrayCpuGpu<float>>(1,1,1,1);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void NetOpenVino::forwardPass(const Array<float>& inputData) const
+    {
+        try
+        {
+            #ifdef USE_OPENVINO
+                // Sanity checks
+                if (inputData.empty())
+                    error("The Array inputData cannot be empty.", __LINE__, __FUNCTION__, __FILE__);
+                if (inputData.getNumberDimensions() != 4 || inputData.getSize(1) != 3)
+                    error("The Array inputData must have 4 dimensions: [batch size, 3 (RGB), height, width].",
+                          __LINE__, __FUNCTION__, __FILE__);
+                // Select (and compile if required) the model of this input size
+                if (!vectorsAreEqual(upImpl->mNetInputSize4D, inputData.getSize()))
+                {
+                    upImpl->mNetInputSize4D = inputData.getSize();
+                    upImpl->pEngine = upImpl->getEngine(upImpl->mNetInputSize4D);
+                    upImpl->spOutputBlob->Reshape(upImpl->pEngine->outputSize);
+                }
+                // Each image of the batch is run by a different asynchronous infer request, reading from inputData
+                // and writing into the output blob directly (OpenVINO does not modify the input memory)
+                const auto& compiledModel = *upImpl->pEngine->spCompiledModel;
+                auto& inferRequests = upImpl->pEngine->inferRequests;
+                const auto batchSize = upImpl->mNetInputSize4D[0];
+                const auto inputVolume = inputData.getVolume() / batchSize;
+                const auto outputVolume = getVolume(upImpl->pEngine->outputSize) / batchSize;
+                auto* inputPtr = const_cast<float*>(inputData.getConstPtr());
+                auto* outputPtr = upImpl->spOutputBlob->mutable_cpu_data();
+                const auto numberRequests = (int)inferRequests.size();
+                for (auto firstImage = 0 ; firstImage < batchSize ; firstImage += numberRequests)
+                {
+                    const auto lastImage = fastMin(batchSize, firstImage + numberRequests);
+                    for (auto image = firstImage ; image < lastImage ; image++)
+                    {
+                        auto& inferRequest = inferRequests[image - firstImage];
+                        inferRequest.set_input_tensor(
+                            ov::Tensor{ov::element::f32, compiledModel.inputShape, inputPtr + image*inputVolume});
+                        inferRequest.set_output_tensor(
+                            compiledModel.outputIndex,
+                            ov::Tensor{ov::element::f32, compiledModel.outputShape, outputPtr + image*outputVolume});
+                        inferRequest.start_async();
+                    }
+                    for (auto image = firstImage ; image < lastImage ; image++)
+                        inferRequests[image - firstImage].wait();
+                }
+            #else
+                UNUSED(inputData);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void NetOpenVino::reserveInputSizes(const std::vector<std::vector<int>>& inputSizes4D)
+    {
+        try
+        {
+            #ifdef USE_OPENVINO
+                // Compile the model of each input size and allocate the output blob for the largest one (it only
+                // reallocates when it grows)
+                for (const auto& inputSize4D : inputSizes4D)
+                {
+                    if (inputSize4D.size() != 4 || inputSize4D[1] != 3)
+                        error("The input sizes must have 4 dimensions: [batch size, 3 (RGB), height, width].",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    const auto* const engine = upImpl->getEngine(inputSize4D);
+                    if (getVolume(engine->outputSize) > upImpl->spOutputBlob->count())
+                        upImpl->spOutputBlob->Reshape(engine->outputSize);
+                }
+                // The next forwardPass() selects its engine and reshapes the blob (without reallocating it)
+                upImpl->mNetInputSize4D.clear();
+            #else
+                UNUSED(inputSizes4D);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::shared_ptr<ArrayCpuGpu<float>> NetOpenVino::getOutputBlobArray() const
+    {
+        try
+        {
+            #ifdef USE_OPENVINO
+                return upImpl->spOutputBlob;
+            #else
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+}
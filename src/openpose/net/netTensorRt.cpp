@@ -0,0 +1,494 @@
+#include <openpose/net/netTensorRt.hpp>
+#ifdef USE_TENSORRT
+    #if defined(USE_CAFFE) && defined(USE_CUDA)
+        #include <fstream>
+        #include <map>
+        #include <numeric> // std::accumulate
+        #include <iterator> // std::istreambuf_iterator
+        #include <cuda_runtime_api.h>
+        #include <NvInfer.h>
+        #include <NvOnnxParser.h>
+        #include <openpose/core/pinnedMemory.hpp>
+        #include <openpose/gpu/cuda.hpp>
+    #else
+        #error In order to enable the TensorRT backend in OpenPose, the CMake flags of Caffe and CUDA must be \
+               enabled (the output blob and the post-processing Caffe layers are still required).
+    #endif
+#endif
+#include <openpose/utilities/fileSystem.hpp>
+#include <openpose/utilities/standard.hpp>
+
+namespace op
+{
+    #ifdef USE_TENSORRT
+        class TensorRtLogger : public nvinfer1::ILogger
+        {
+        public:
+            void log(const Severity severity, const char* message) noexcept override
+            {
+                // Verbose and info messages are only shown with the lowest logging priorities
+                if (severity == Severity::kINTERNAL_ERROR || severity == Severity::kERROR)
+                    opLog("TensorRT error: " + std::string{message}, Priority::Max);
+                else if (severity == Severity::kWARNING)
+                    opLog("TensorRT warning: " + std::string{message}, Priority::High);
+                else if (severity == Severity::kINFO)
+                    opLog("TensorRT: " + std::string{message}, Priority::Low);
+            }
+        };
+
+        // INT8 calibrator that only reads an existing calibration cache (i.e., no calibration images are required
+        // at runtime)
+        class TensorRtCacheCalibrator : public nvinfer1::IInt8EntropyCalibrator2
+        {
+        public:
+            explicit TensorRtCacheCalibrator(const std::string& calibrationCachePath) :
+                mCalibrationCachePath{calibrationCachePath}
+            {
+            }
+
+            int getBatchSize() const noexcept override
+            {
+                return 1;
+            }
+
+            bool getBatch(void**, const char**, int) noexcept override
+            {
+                return false;
+            }
+
+            const void* readCalibrationCache(std::size_t& length) noexcept override
+            {
+                std::ifstream calibrationFile{mCalibrationCachePath, std::ios::binary};
+                mCalibrationCache.assign(
+                    std::istreambuf_iterator<char>{calibrationFile}, std::istreambuf_iterator<char>{});
+                length = mCalibrationCache.size();
+                return (length > 0 ? mCalibrationCache.data() : nullptr);
+            }
+
+            void writeCalibrationCache(const void*, std::size_t) noexcept override
+            {
+            }
+
+        private:
+            const std::string mCalibrationCachePath;
+            std::vector<char> mCalibrationCache;
+        };
+
+        std::string sizeToString(const std::vector<int>& size)
+        {
+            std::string sizeString;
+            for (const auto value : size)
+                sizeString += (sizeString.empty() ? "" : "x") + std::to_string(value);
+            return sizeString;
+        }
+
+        struct TensorRtEngine
+        {
+            std::unique_ptr<nvinfer1::ICudaEngine> upEngine;
+            std::unique_ptr<nvinfer1::IExecutionContext> upContext;
+            int mInputIndex;
+            int mOutputIndex;
+            std::vector<int> mOutputSize;
+            BlobLayout mOutputLayout;
+        };
+    #endif
+
+    struct NetTensorRt::ImplNetTensorRt
+    {
+        #ifdef USE_TENSORRT
+            // Init with constructor
+            const int mGpuId;
+            const std::string mOnnxModel;
+            const int mPrecision;
+            const std::string mLastBlobName;
+            TensorRtLogger mLogger; // It must outlive all the TensorRT objects
+            // Init with thread
+            std::unique_ptr<nvinfer1::IRuntime> upRuntime;
+            std::string mGpuArchitecture;
+            cudaStream_t mCudaStream;
+            cudaEvent_t mUploadEvent;
+            // Keeps the (pinned) input memory alive until its asynchronous upload finishes
+            Array<float> mUploadingInput;
+            // One engine per network input size
+            std::map<std::vector<int>, TensorRtEngine> mEngines;
+            TensorRtEngine* pEngine;
+            std::vector<int> mNetInputSize4D;
+            std::shared_ptr<ArrayCpuGpu<float>> spInputBlob;
+            std::shared_ptr<ArrayCpuGpu<float>> spOutputBlob;
+
+            ImplNetTensorRt(const std::string& onnxModel, const int gpuId, const int precision,
+                            const std::string& lastBlobName) :
+                mGpuId{gpuId},
+                mOnnxModel{onnxModel},
+                mPrecision{precision},
+                mLastBlobName{lastBlobName},
+                mCudaStream{nullptr},
+                mUploadEvent{nullptr},
+                pEngine{nullptr}
+            {
+                try
+                {
+                    if (!existFile(mOnnxModel))
+                        error("ONNX model file not found: " + mOnnxModel + ". Did you export the OpenPose model to"
+                              " ONNX and set its path with `--caffemodel_path`?", __LINE__, __FUNCTION__, __FILE__);
+                    if (mPrecision != 32 && mPrecision != 16 && mPrecision != 8)
+                        error("The TensorRT precision must be 32, 16 or 8 (used: " + std::to_string(mPrecision)
+                              + ").", __LINE__, __FUNCTION__, __FILE__);
+                    if (mPrecision == 8 && !existFile(mOnnxModel + ".int8.calib"))
+                        error("The TensorRT INT8 precision requires the calibration cache file "
+                              + mOnnxModel + ".int8.calib.", __LINE__, __FUNCTION__, __FILE__);
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            ~ImplNetTensorRt()
+            {
+                try
+                {
+                    if (mCudaStream != nullptr)
+                    {
+                        cudaStreamSynchronize(mCudaStream);
+                        cudaStreamDestroy(mCudaStream);
+                    }
+                    if (mUploadEvent != nullptr)
+                        cudaEventDestroy(mUploadEvent);
+                    // Contexts must be released before their engines, and engines before the runtime
+                    for (auto& engine : mEngines)
+                        engine.second.upContext.reset();
+                    mEngines.clear();
+                    upRuntime.reset();
+                }
+                catch (const std::exception& e)
+                {
+                    errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            std::string getEngineCachePath(const std::vector<int>& inputSize) const
+            {
+                const auto precisionString = (mPrecision == 8 ? "int8" : "fp" + std::to_string(mPrecision));
+                return mOnnxModel + "." + sizeToString(inputSize) + "." + precisionString + "." + mGpuArchitecture
+                    + ".trt" + std::to_string(NV_TENSORRT_MAJOR) + "." + std::to_string(NV_TENSORRT_MINOR)
+                    + ".engine";
+            }
+
+            std::vector<char> buildSerializedEngine(const std::vector<int>& inputSize)
+            {
+                try
+                {
+                    opLog("Building the TensorRT engine for the network input size " + sizeToString(inputSize)
+                          + ". It might take a few minutes, but it is only done once (it is cached on disk).",
+                          Priority::High);
+                    std::unique_ptr<nvinfer1::IBuilder> upBuilder{nvinfer1::createInferBuilder(mLogger)};
+                    const auto explicitBatch = 1u << static_cast<uint32_t>(
+                        nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH);
+                    std::unique_ptr<nvinfer1::INetworkDefinition> upNetwork{upBuilder->createNetworkV2(explicitBatch)};
+                    std::unique_ptr<nvonnxparser::IParser> upParser{nvonnxparser::createParser(*upNetwork, mLogger)};
+                    if (!upParser->parseFromFile(
+                        mOnnxModel.c_str(), static_cast<int>(nvinfer1::ILogger::Severity::kWARNING)))
+                        error("The ONNX model could not be parsed: " + mOnnxModel + ".",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    if (upNetwork->getNbInputs() != 1)
+                        error("The ONNX model must have a single input (the image).", __LINE__, __FUNCTION__, __FILE__);
+                    std::unique_ptr<nvinfer1::IBuilderConfig> upConfig{upBuilder->createBuilderConfig()};
+                    upConfig->setMaxWorkspaceSize(1ull << 30);
+                    // Precision
+                    std::unique_ptr<TensorRtCacheCalibrator> upCalibrator;
+                    if (mPrecision <= 16)
+                    {
+                        if (!upBuilder->platformHasFastFp16())
+                            opLog("This GPU does not have fast FP16 support, the TensorRT engine might be slow.",
+                                  Priority::High);
+                        upConfig->setFlag(nvinfer1::BuilderFlag::kFP16);
+                        // The reduced precision (tensor core) kernels are channel-last, so TensorRT can also keep the
+                        // output in HWC rather than transposing it (the post-processing reads both, see
+                        // getOutputLayout())
+                        for (auto i = 0 ; i < upNetwork->getNbOutputs() ; i++)
+                            upNetwork->getOutput(i)->setAllowedFormats(
+                                (1u << static_cast<uint32_t>(nvinfer1::TensorFormat::kLINEAR))
+                                | (1u << static_cast<uint32_t>(nvinfer1::TensorFormat::kHWC)));
+                    }
+                    if (mPrecision == 8)
+                    {
+                        if (!upBuilder->platformHasFastInt8())
+                            opLog("This GPU does not have fast INT8 support, the TensorRT engine might be slow.",
+                                  Priority::High);
+                        upConfig->setFlag(nvinfer1::BuilderFlag::kINT8);
+                        upCalibrator.reset(new TensorRtCacheCalibrator{mOnnxModel + ".int8.calib"});
+                        upConfig->setInt8Calibrator(upCalibrator.get());
+                    }
+                    // Fixed input size (min = opt = max), so TensorRT picks the fastest kernels for it
+                    const nvinfer1::Dims4 inputDims{inputSize[0], inputSize[1], inputSize[2], inputSize[3]};
+                    auto* optimizationProfile = upBuilder->createOptimizationProfile();
+                    const auto* const inputName = upNetwork->getInput(0)->getName();
+                    optimizationProfile->setDimensions(inputName, nvinfer1::OptProfileSelector::kMIN, inputDims);
+                    optimizationProfile->setDimensions(inputName, nvinfer1::OptProfileSelector::kOPT, inputDims);
+                    optimizationProfile->setDimensions(inputName, nvinfer1::OptProfileSelector::kMAX, inputDims);
+                    upConfig->addOptimizationProfile(optimizationProfile);
+                    // Build
+                    std::unique_ptr<nvinfer1::IHostMemory> upSerializedEngine{
+                        upBuilder->buildSerializedNetwork(*upNetwork, *upConfig)};
+                    if (upSerializedEngine == nullptr)
+                        error("The TensorRT engine could not be built.", __LINE__, __FUNCTION__, __FILE__);
+                    const auto* const serializedEnginePtr = (const char*)upSerializedEngine->data();
+                    return std::vector<char>(serializedEnginePtr, serializedEnginePtr + upSerializedEngine->size());
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                    return {};
+                }
+            }
+
+            TensorRtEngine* getEngine(const std::vector<int>& inputSize)
+            {
+                try
+                {
+                    auto& engine = mEngines[inputSize];
+                    if (engine.upContext == nullptr)
+                    {
+                        // Load cached engine, or build and cache it
+                        const auto engineCachePath = getEngineCachePath(inputSize);
+                        std::vector<char> serializedEngine;
+                        if (existFile(engineCachePath))
+                        {
+                            std::ifstream engineFile{engineCachePath, std::ios::binary};
+                            serializedEngine.assign(
+                                std::istreambuf_iterator<char>{engineFile}, std::istreambuf_iterator<char>{});
+                        }
+                        else
+                        {
+                            serializedEngine = buildSerializedEngine(inputSize);
+                            std::ofstream engineFile{engineCachePath, std::ios::binary};
+                            if (engineFile.is_open())
+                                engineFile.write(serializedEngine.data(), serializedEngine.size());
+                            else
+                                opLog("The TensorRT engine could not be cached in " + engineCachePath + ".",
+                                      Priority::High);
+                        }
+                        // Deserialize it
+                        engine.upEngine.reset(
+                            upRuntime->deserializeCudaEngine(serializedEngine.data(), serializedEngine.size()));
+                        if (engine.upEngine == nullptr)
+                            error("The TensorRT engine could not be loaded. Remove " + engineCachePath + " so it is"
+                                  " built again.", __LINE__, __FUNCTION__, __FILE__);
+                        engine.upContext.reset(engine.upEngine->createExecutionContext());
+                        // Input and output bindings
+                        engine.mInputIndex = -1;
+                        engine.mOutputIndex = engine.upEngine->getBindingIndex(mLastBlobName.c_str());
+                        for (auto i = 0 ; i < engine.upEngine->getNbBindings() ; i++)
+                        {
+                            if (engine.upEngine->bindingIsInput(i))
+                                engine.mInputIndex = i;
+                            // If no output has that name, the last one is used
+                            else if (engine.mOutputIndex < 0 || engine.upEngine->bindingIsInput(engine.mOutputIndex))
+                                engine.mOutputIndex = i;
+                        }
+                        if (engine.mInputIndex < 0 || engine.mOutputIndex < 0)
+                            error("The TensorRT engine must have 1 input and at least 1 output.",
+                                  __LINE__, __FUNCTION__, __FILE__);
+                        engine.upContext->setBindingDimensions(
+                            engine.mInputIndex,
+                            nvinfer1::Dims4{inputSize[0], inputSize[1], inputSize[2], inputSize[3]});
+                        const auto outputDims = engine.upContext->getBindingDimensions(engine.mOutputIndex);
+                        engine.mOutputSize.assign(outputDims.d, outputDims.d + outputDims.nbDims);
+                        if (engine.mOutputSize.size() != 4)
+                            error("The network output must have 4 dimensions (used: "
+                                  + sizeToString(engine.mOutputSize) + ").", __LINE__, __FUNCTION__, __FILE__);
+                        // Output memory layout (the binding dimensions are the NCHW ones regardless of it)
+                        const auto outputFormat = engine.upEngine->getBindingFormat(engine.mOutputIndex);
+                        if (outputFormat == nvinfer1::TensorFormat::kLINEAR)
+                            engine.mOutputLayout = BlobLayout::Nchw;
+                        else if (outputFormat == nvinfer1::TensorFormat::kHWC)
+                            engine.mOutputLayout = BlobLayout::Nhwc;
+                        else
+                            error("The TensorRT engine output must be in linear (NCHW) or HWC format (used: "
+                                  + std::string{engine.upEngine->getBindingFormatDesc(engine.mOutputIndex)} + ").",
+                                  __LINE__, __FUNCTION__, __FILE__);
+                    }
+                    return &engine;
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                    return nullptr;
+                }
+            }
+        #endif
+    };
+
+    NetTensorRt::NetTensorRt(const std::string& onnxModel, const int gpuId, const int precision,
+                             const std::string& lastBlobName)
+        #ifdef USE_TENSORRT
+            : upImpl{new ImplNetTensorRt{onnxModel, gpuId, precision, lastBlobName}}
+        #endif
+    {
+        try
+        {
+            #ifndef USE_TENSORRT
+                UNUSED(onnxModel);
+                UNUSED(gpuId);
+                UNUSED(precision);
+                UNUSED(lastBlobName);
+                error("OpenPose must be compiled with the `USE_TENSORRT` macro definition (CMake flag"
+                      " `WITH_TENSORRT`) in order to use this functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    NetTensorRt::~NetTensorRt()
+    {
+    }
+
+    void NetTensorRt::initializationOnThread()
+    {
+        try
+        {
+            #ifdef USE_TENSORRT
+                cudaSetDevice(upImpl->mGpuId);
+                upImpl->upRuntime.reset(nvinfer1::createInferRuntime(upImpl->mLogger));
+                if (upImpl->upRuntime == nullptr)
+                    error("The TensorRT runtime could not be created.", __LINE__, __FUNCTION__, __FILE__);
+                // Engines are GPU architecture specific
+                cudaDeviceProp cudaDeviceProperties;
+                cudaGetDeviceProperties(&cudaDeviceProperties, upImpl->mGpuId);
+                upImpl->mGpuArchitecture = "sm" + std::to_string(cudaDeviceProperties.major)
+                                         + std::to_string(cudaDeviceProperties.minor);
+                // Blocking stream, so the inference is still ordered with respect to the default stream (where the
+                // post-processing waits for the network output)
+                if (upImpl->mCudaStream == nullptr)
+                    cudaStreamCreate(&upImpl->mCudaStream);
+                if (upImpl->mUploadEvent == nullptr)
+                    cudaEventCreateWithFlags(&upImpl->mUploadEvent, cudaEventDisableTiming);
+                upImpl->spInputBlob = std::make_shared<ArrayCpuGpu<float>>(1,1,1,1);
+                upImpl->spOutputBlob = std::make_shared<ArrayCpuGpu<float>>(1,1,1,1);
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void NetTensorRt::forwardPass(const Array<float>& inputData) const
+    {
+        try
+        {
+            #ifdef USE_TENSORRT
+                // Sanity checks
+                if (inputData.empty())
+                    error("The Array inputData cannot be empty.", __LINE__, __FUNCTION__, __FILE__);
+                if (inputData.getNumberDimensions() != 4 || inputData.getSize(1) != 3)
+                    error("The Array inputData must have 4 dimensions: [batch size, 3 (RGB), height, width].",
+                          __LINE__, __FUNCTION__, __FILE__);
+                // Select (and build or load if required) the engine of this input size
+                if (!vectorsAreEqual(upImpl->mNetInputSize4D, inputData.getSize()))
+                {
+                    upImpl->mNetInputSize4D = inputData.getSize();
+                    upImpl->pEngine = upImpl->getEngine(upImpl->mNetInputSize4D);
+                    upImpl->spInputBlob->Reshape(upImpl->mNetInputSize4D);
+                    upImpl->spOutputBlob->Reshape(upImpl->pEngine->mOutputSize);
+                }
+                // Copy frame data to GPU memory (asynchronous if it is already pinned, e.g., from CvMatToOpInput)
+                cudaEventSynchronize(upImpl->mUploadEvent);
+                upImpl->mUploadingInput.reset();
+                if (isPinnedMemory(inputData.getConstPtr()))
+                    upImpl->mUploadingInput = inputData;
+                auto* gpuImagePtr = upImpl->spInputBlob->mutable_gpu_data();
+                cudaMemcpyAsync(gpuImagePtr, inputData.getConstPtr(), inputData.getVolume() * sizeof(float),
+                                cudaMemcpyHostToDevice, upImpl->mCudaStream);
+                cudaEventRecord(upImpl->mUploadEvent, upImpl->mCudaStream);
+                // Perform deep network forward pass. TensorRT writes directly into the output blob
+                void* bindings[2];
+                bindings[upImpl->pEngine->mInputIndex] = gpuImagePtr;
+                bindings[upImpl->pEngine->mOutputIndex] = upImpl->spOutputBlob->mutable_gpu_data();
+                if (!upImpl->pEngine->upContext->enqueueV2(bindings, upImpl->mCudaStream, nullptr))
+                    error("TensorRT inference failed.", __LINE__, __FUNCTION__, __FILE__);
+                // Cuda checks
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            #else
+                UNUSED(inputData);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void NetTensorRt::reserveInputSizes(const std::vector<std::vector<int>>& inputSizes4D)
+    {
+        try
+        {
+            #ifdef USE_TENSORRT
+                // Build or load the engine of each input size, and allocate the blobs for the largest one (they
+                // only reallocate when they grow)
+                const auto getVolume = [](const std::vector<int>& size4D)
+                {
+                    return std::accumulate(size4D.begin(), size4D.end(), 1ll, std::multiplies<long long>());
+                };
+                for (const auto& inputSize4D : inputSizes4D)
+                {
+                    if (inputSize4D.size() != 4 || inputSize4D[1] != 3)
+                        error("The input sizes must have 4 dimensions: [batch size, 3 (RGB), height, width].",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    const auto* const engine = upImpl->getEngine(inputSize4D);
+                    if (getVolume(inputSize4D) > upImpl->spInputBlob->count())
+                        upImpl->spInputBlob->Reshape(inputSize4D);
+                    if (getVolume(engine->mOutputSize) > upImpl->spOutputBlob->count())
+                        upImpl->spOutputBlob->Reshape(engine->mOutputSize);
+                }
+                // The next forwardPass() selects its engine and reshapes the blobs (without reallocating them)
+                upImpl->mNetInputSize4D.clear();
+            #else
+                UNUSED(inputSizes4D);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::shared_ptr<ArrayCpuGpu<float>> NetTensorRt::getOutputBlobArray() const
+    {
+        try
+        {
+            #ifdef USE_TENSORRT
+                return upImpl->spOutputBlob;
+            #else
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    BlobLayout NetTensorRt::getOutputLayout() const
+    {
+        try
+        {
+            #ifdef USE_TENSORRT
+                return (upImpl->pEngine != nullptr ? upImpl->pEngine->mOutputLayout : BlobLayout::Nchw);
+            #else
+                return BlobLayout::Nchw;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return BlobLayout::Nchw;
+        }
+    }
+}
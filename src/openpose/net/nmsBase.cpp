@@ -1,5 +1,8 @@
 #include <openpose/net/nmsBase.hpp>
 #include <opencv2/opencv.hpp>
+#include <openpose_private/utilities/avx.hpp>
+#include <openpose_private/utilities/neon.hpp>
+#include <openpose_private/utilities/parallelFor.hpp>
 
 namespace op
 {
@@ -67,6 +70,106 @@ namespace op
             kernelPtr[index] = 0;
     }
 
+    // It fills the kernel of the inner pixels (xBegin <= x < w-2, with 1 < xBegin) of the row y (with 1 < y < h-2)
+    // with SIMD instructions (as nmsRegisterKernelCPU), and it returns the first x that has not been filled
+    template <typename T>
+    using NmsRegisterKernelRow = int (*)(int* kernelPtr, const T* const sourcePtr, const int w, const T threshold,
+                                         const int y, const int xBegin);
+
+    #ifdef WITH_AVX
+        OP_TARGET_AVX2 int nmsRegisterKernelRowAvx2(
+            int* kernelPtr, const float* const sourcePtr, const int w, const float threshold, const int y,
+            const int xBegin)
+        {
+            const int neighborOffsets[8] = {-w-1, -w, -w+1, -1, 1, w-1, w, w+1};
+            const auto thresholdAvx = _mm256_set1_ps(threshold);
+            const auto oneAvx = _mm256_set1_epi32(1);
+            auto x = xBegin;
+            // 8 pixels at a time
+            for ( ; x + 8 <= w-2 ; x += 8)
+            {
+                const auto index = y*w + x;
+                const auto value = _mm256_loadu_ps(&sourcePtr[index]);
+                auto isPeak = _mm256_cmp_ps(value, thresholdAvx, _CMP_GT_OQ);
+                for (const auto neighborOffset : neighborOffsets)
+                    isPeak = _mm256_and_ps(
+                        isPeak, _mm256_cmp_ps(value, _mm256_loadu_ps(&sourcePtr[index + neighborOffset]), _CMP_GT_OQ));
+                _mm256_storeu_si256(
+                    (__m256i*)&kernelPtr[index], _mm256_and_si256(_mm256_castps_si256(isPeak), oneAvx));
+            }
+            return x;
+        }
+
+        OP_TARGET_AVX512 int nmsRegisterKernelRowAvx512(
+            int* kernelPtr, const float* const sourcePtr, const int w, const float threshold, const int y,
+            const int xBegin)
+        {
+            const int neighborOffsets[8] = {-w-1, -w, -w+1, -1, 1, w-1, w, w+1};
+            const auto thresholdAvx = _mm512_set1_ps(threshold);
+            auto x = xBegin;
+            // 16 pixels at a time
+            for ( ; x + 16 <= w-2 ; x += 16)
+            {
+                const auto index = y*w + x;
+                const auto value = _mm512_loadu_ps(&sourcePtr[index]);
+                auto isPeak = _mm512_cmp_ps_mask(value, thresholdAvx, _CMP_GT_OQ);
+                for (const auto neighborOffset : neighborOffsets)
+                    isPeak = _mm512_mask_cmp_ps_mask(
+                        isPeak, value, _mm512_loadu_ps(&sourcePtr[index + neighborOffset]), _CMP_GT_OQ);
+                _mm512_storeu_si512(&kernelPtr[index], _mm512_maskz_set1_epi32(isPeak, 1));
+            }
+            // Remaining ones 8 at a time
+            return nmsRegisterKernelRowAvx2(kernelPtr, sourcePtr, w, threshold, y, x);
+        }
+    #endif
+
+    #ifdef WITH_NEON
+        int nmsRegisterKernelRowNeon(
+            int* kernelPtr, const float* const sourcePtr, const int w, const float threshold, const int y,
+            const int xBegin)
+        {
+            const int neighborOffsets[8] = {-w-1, -w, -w+1, -1, 1, w-1, w, w+1};
+            const auto thresholdNeon = vdupq_n_f32(threshold);
+            const auto oneNeon = vdupq_n_u32(1u);
+            auto x = xBegin;
+            // 4 pixels at a time
+            for ( ; x + 4 <= w-2 ; x += 4)
+            {
+                const auto index = y*w + x;
+                const auto value = vld1q_f32(&sourcePtr[index]);
+                auto isPeak = vcgtq_f32(value, thresholdNeon);
+                for (const auto neighborOffset : neighborOffsets)
+                    isPeak = vandq_u32(isPeak, vcgtq_f32(value, vld1q_f32(&sourcePtr[index + neighborOffset])));
+                vst1q_s32(&kernelPtr[index], vreinterpretq_s32_u32(vandq_u32(isPeak, oneNeon)));
+            }
+            return x;
+        }
+    #endif
+
+    // SIMD version selected at runtime (nullptr if none)
+    template <typename T>
+    NmsRegisterKernelRow<T> getNmsRegisterKernelRow()
+    {
+        return nullptr;
+    }
+
+    template <>
+    NmsRegisterKernelRow<float> getNmsRegisterKernelRow<float>()
+    {
+        #if defined WITH_AVX
+            static const auto sNmsRegisterKernelRow = (cpuSupportsAvx512()
+                ? &nmsRegisterKernelRowAvx512
+                : (cpuSupportsAvx2() ? &nmsRegisterKernelRowAvx2 : NmsRegisterKernelRow<float>{nullptr}));
+            return sNmsRegisterKernelRow;
+        #elif defined WITH_NEON
+            static const auto sNmsRegisterKernelRow = (cpuSupportsNeon()
+                ? &nmsRegisterKernelRowNeon : NmsRegisterKernelRow<float>{nullptr});
+            return sNmsRegisterKernelRow;
+        #else
+            return nullptr;
+        #endif
+    }
+
     template <typename T>
     void nmsAccuratePeakPosition(T* output, const T* const sourcePtr, const int& peakLocX, const int& peakLocY,
                                  const int& width, const int& height, const Point<T>& offset)
@@ -130,38 +233,44 @@ namespace op
             const auto sourceChannelOffset = sourceWidth * sourceHeight;
             const auto targetChannelOffset = targetPeaks * targetPeakVec;
 
-            // Per channel operation
-            for (auto c = 0 ; c < channels ; c++)
+            // Per channel operation (channels processed in parallel)
+            const auto nmsRegisterKernelRow = getNmsRegisterKernelRow<T>();
+            parallelFor(0, channels, [&](const int c)
             {
                 auto* currKernelPtr = &kernelPtr[c*sourceChannelOffset];
                 const T* currSourcePtr = &sourcePtr[c*sourceChannelOffset];
 
                 for (auto y = 0; y < sourceHeight; y++)
-                    for (auto x = 0; x < sourceWidth; x++)
+                {
+                    auto x = 0;
+                    // SIMD version for the inner pixels
+                    if (nmsRegisterKernelRow != nullptr && 1 < y && y < (sourceHeight-2) && sourceWidth > 3)
+                    {
+                        for ( ; x < 2; x++)
+                            nmsRegisterKernelCPU(
+                                currKernelPtr, currSourcePtr, sourceWidth, sourceHeight, threshold, x, y);
+                        x = nmsRegisterKernelRow(currKernelPtr, currSourcePtr, sourceWidth, threshold, y, x);
+                    }
+                    for ( ; x < sourceWidth; x++)
                         nmsRegisterKernelCPU(currKernelPtr, currSourcePtr, sourceWidth, sourceHeight, threshold, x, y);
+                }
 
                 auto currentPeakCount = 1;
                 auto* currTargetPtr = &targetPtr[c*targetChannelOffset];
-                for (auto y = 0; y < sourceHeight; y++)
+                for (auto index = 0; index < sourceChannelOffset && currentPeakCount < targetPeaks; index++)
                 {
-                    for (auto x = 0; x < sourceWidth; x++)
+                    // Find high intensity points
+                    if (currKernelPtr[index] == 1)
                     {
-                        const auto index = y*sourceWidth + x;
-                        // Find high intensity points
-                        if (currentPeakCount < targetPeaks)
-                        {
-                            if (currKernelPtr[index] == 1)
-                            {
-                                // Accurate Peak Position
-                                nmsAccuratePeakPosition(&currTargetPtr[currentPeakCount*3], currSourcePtr, x, y,
-                                                        sourceWidth, sourceHeight, offset);
-                                currentPeakCount++;
-                            }
-                        }
+                        // Accurate Peak Position
+                        nmsAccuratePeakPosition(
+                            &currTargetPtr[currentPeakCount*3], currSourcePtr, index % sourceWidth,
+                            index / sourceWidth, sourceWidth, sourceHeight, offset);
+                        currentPeakCount++;
                     }
                 }
                 currTargetPtr[0] = T(currentPeakCount-1);
-            }
+            });
         }
         catch (const std::exception& e)
         {
@@ -1,13 +1,66 @@
 #include <openpose/net/nmsBase.hpp>
 #include <thrust/device_ptr.h>
+#include <thrust/execution_policy.h>
 #include <thrust/scan.h>
+#if CUDART_VERSION >= 11000
+    #include <cub/device/device_scan.cuh>
+#endif
 #include <openpose/gpu/cuda.hpp>
+#include <openpose/gpu/cudaAutotune.hpp>
+#include <openpose/gpu/cudaMemoryPool.hpp>
 #include <openpose_private/gpu/cuda.hu>
 
 namespace op
 {
+    // Default 2-D block (resizeAndNmsRegisterKernel is autotuned, see gpu/cudaAutotune.hpp)
     const auto THREADS_PER_BLOCK_1D = 16u;
+    // Not autotuned: The shared memory of the scan kernels is sized with it
     const auto THREADS_PER_BLOCK = 512u;
+    // Tiled NMS (nmsStripKernel): Threads (i.e., pixels of each row segment) per block, and maximum strips per channel
+    const auto NMS_STRIP_THREADS = 256;
+    const auto NMS_STRIP_WARPS = NMS_STRIP_THREADS / 32;
+    const auto NMS_STRIPS_MAX = 32;
+    // Alignment of each buffer inside the scratch memory
+    const auto SCRATCH_ALIGNMENT = 256ull;
+
+    unsigned long long getScanStorageBytes(const int volume)
+    {
+        #if CUDART_VERSION >= 11000
+            size_t scanStorageBytes = 0;
+            cub::DeviceScan::ExclusiveSum(nullptr, scanStorageBytes, (int*)nullptr, (int*)nullptr, volume);
+            return scanStorageBytes;
+        #else
+            UNUSED(volume);
+            error("The NMS scratch memory requires CUDA 11 or higher.", __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        #endif
+    }
+
+    unsigned long long getPeakIndexBytes(const int volume)
+    {
+        return ((sizeof(int) * volume + SCRATCH_ALIGNMENT - 1) / SCRATCH_ALIGNMENT) * SCRATCH_ALIGNMENT;
+    }
+
+    // In-place exclusive scan of kernelPtr. If scanStoragePtr is not nullptr, it does not allocate nor synchronize
+    void exclusiveScanGpu(int* kernelPtr, const int volume, void* const scanStoragePtr, CUstream_st* const cudaStream)
+    {
+        if (scanStoragePtr == nullptr)
+        {
+            auto kernelThrustPtr = thrust::device_pointer_cast(kernelPtr);
+            thrust::exclusive_scan(
+                thrust::cuda::par.on(cudaStream), kernelThrustPtr, kernelThrustPtr + volume, kernelThrustPtr);
+        }
+        else
+        {
+            #if CUDART_VERSION >= 11000
+                size_t scanStorageBytes = getScanStorageBytes(volume);
+                cub::DeviceScan::ExclusiveSum(
+                    scanStoragePtr, scanStorageBytes, kernelPtr, kernelPtr, volume, cudaStream);
+            #else
+                error("The NMS scratch memory requires CUDA 11 or higher.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+    }
 
     // template <typename T>
     // __global__ void nmsRegisterKernelOld(
@@ -47,9 +100,9 @@ namespace op
     // }
 
     // Note: Shared memory made this function slower, from 1.2 ms to about 2 ms.
-    template <typename T>
+    template <typename T, typename TSource>
     __global__ void nmsRegisterKernel(
-        int* kernelPtr, const T* const sourcePtr, const int w, const int h, const T threshold)
+        int* kernelPtr, const TSource* const sourcePtr, const int w, const int h, const T threshold)
     {
         // get pixel location (x,y)
         const auto x = blockIdx.x * blockDim.x + threadIdx.x;
@@ -59,21 +112,21 @@ namespace op
         const auto index = y*w + x;
 
         auto* kernelPtrOffset = &kernelPtr[channelOffset];
-        const T* const sourcePtrOffset = &sourcePtr[channelOffset];
+        const TSource* const sourcePtrOffset = &sourcePtr[channelOffset];
 
         if (0 < x && x < (w-1) && 0 < y && y < (h-1))
         {
-            const auto value = sourcePtrOffset[index];
+            const auto value = loadCuda<T>(sourcePtrOffset[index]);
             if (value > threshold)
             {
-                const auto topLeft     = sourcePtrOffset[(y-1)*w + x-1];
-                const auto top         = sourcePtrOffset[(y-1)*w + x];
-                const auto topRight    = sourcePtrOffset[(y-1)*w + x+1];
-                const auto left        = sourcePtrOffset[    y*w + x-1];
-                const auto right       = sourcePtrOffset[    y*w + x+1];
-                const auto bottomLeft  = sourcePtrOffset[(y+1)*w + x-1];
-                const auto bottom      = sourcePtrOffset[(y+1)*w + x];
-                const auto bottomRight = sourcePtrOffset[(y+1)*w + x+1];
+                const auto topLeft     = loadCuda<T>(sourcePtrOffset[(y-1)*w + x-1]);
+                const auto top         = loadCuda<T>(sourcePtrOffset[(y-1)*w + x]);
+                const auto topRight    = loadCuda<T>(sourcePtrOffset[(y-1)*w + x+1]);
+                const auto left        = loadCuda<T>(sourcePtrOffset[    y*w + x-1]);
+                const auto right       = loadCuda<T>(sourcePtrOffset[    y*w + x+1]);
+                const auto bottomLeft  = loadCuda<T>(sourcePtrOffset[(y+1)*w + x-1]);
+                const auto bottom      = loadCuda<T>(sourcePtrOffset[(y+1)*w + x]);
+                const auto bottomRight = loadCuda<T>(sourcePtrOffset[(y+1)*w + x+1]);
 
                 if (value > topLeft && value > top && value > topRight
                     && value > left && value > right
@@ -161,9 +214,9 @@ namespace op
     //     }
     // }
 
-    template <typename T>
+    template <typename T, typename TSource>
     __global__ void writeResultKernel(
-        T* output, const int length, const int* const kernelPtr, const T* const sourcePtr, const int width,
+        T* output, const int length, const int* const kernelPtr, const TSource* const sourcePtr, const int width,
         const int height, const int maxPeaks, const T offsetX, const T offsetY, const int offsetTarget)
     {
         __shared__ int local[THREADS_PER_BLOCK+1]; // one more
@@ -217,7 +270,7 @@ namespace op
                                     const auto x = peakLocX + dx;
                                     if (0 <= x && x < width) // Default width = 656
                                     {
-                                        const auto score = sourcePtrOffset[y * width + x];
+                                        const auto score = loadCuda<T>(sourcePtrOffset[y * width + x]);
                                         if (score > 0)
                                         {
                                             xAcc += x*score;
@@ -235,7 +288,7 @@ namespace op
                         const auto outputIndex = (peakIndex + 1) * 3;
                         outputOffset[outputIndex] = xAcc / scoreAcc + offsetX;
                         outputOffset[outputIndex + 1] = yAcc / scoreAcc + offsetY;
-                        outputOffset[outputIndex + 2] = sourcePtrOffset[peakLocY*width + peakLocX];
+                        outputOffset[outputIndex + 2] = loadCuda<T>(sourcePtrOffset[peakLocY*width + peakLocX]);
                     }
                 }
             }
@@ -245,9 +298,327 @@ namespace op
         }
     }
 
+    // Peaks of 1 strip of rows (blockIdx.x) of 1 channel (blockIdx.y), as in nmsRegisterKernel + writeResultKernel
+    // but compacted in a single pass. Each row is processed in segments of NMS_STRIP_THREADS pixels, whose
+    // 3 x (NMS_STRIP_THREADS + 2) neighborhood (i.e., with a 1-pixel halo) is first loaded into shared memory. The
+    // peaks are compacted with warp ballots plus a prefix over the warps of the block, so they keep the raster order
+    // of the scan (and the output is deterministic). Each strip stops after maxPeaks peaks, given that the following
+    // ones could never be kept (their index in the channel would be at least maxPeaks).
+    template <typename T, typename TSource>
+    __global__ void nmsStripKernel(
+        T* stripPeaksPtr, int* stripCountsPtr, const TSource* const sourcePtr, const int width, const int height,
+        const int rowsPerStrip, const int maxPeaks, const T threshold, const T offsetX, const T offsetY)
+    {
+        __shared__ T tile[3][NMS_STRIP_THREADS+2];
+        __shared__ int warpCounts[NMS_STRIP_WARPS];
+        __shared__ int stripCount;
+        const auto strip = (int)blockIdx.x;
+        const auto channel = (int)blockIdx.y;
+        const auto numberStrips = (int)gridDim.x;
+        const auto lane = (int)(threadIdx.x & 31u);
+        const auto warp = (int)(threadIdx.x >> 5);
+        const TSource* const sourcePtrOffset = &sourcePtr[channel * width*height];
+        auto* stripPeaksOffset = &stripPeaksPtr[(channel * numberStrips + strip) * maxPeaks * 3];
+        if (threadIdx.x == 0)
+            stripCount = 0;
+        __syncthreads();
+
+        const auto yEnd = fastMinCuda(height, (strip+1) * rowsPerStrip);
+        for (auto y = strip * rowsPerStrip ; y < yEnd && stripCount < maxPeaks ; y++)
+        {
+            for (auto xBlock = 0 ; xBlock < width && stripCount < maxPeaks ; xBlock += NMS_STRIP_THREADS)
+            {
+                // Tile with the halo (the pixels outside of the image are never compared, see isPeak)
+                for (auto i = (int)threadIdx.x ; i < 3*(NMS_STRIP_THREADS+2) ; i += NMS_STRIP_THREADS)
+                {
+                    const auto row = i / (NMS_STRIP_THREADS+2);
+                    const auto col = i - row*(NMS_STRIP_THREADS+2);
+                    const auto yTile = y - 1 + row;
+                    const auto xTile = xBlock - 1 + col;
+                    tile[row][col] = (0 <= yTile && yTile < height && 0 <= xTile && xTile < width
+                        ? loadCuda<T>(sourcePtrOffset[yTile*width + xTile]) : T(0));
+                }
+                __syncthreads();
+
+                // Same comparisons than nmsRegisterKernel
+                const auto x = xBlock + (int)threadIdx.x;
+                const auto col = threadIdx.x + 1;
+                auto isPeak = false;
+                if (0 < x && x < (width-1) && 0 < y && y < (height-1))
+                {
+                    const auto value = tile[1][col];
+                    isPeak = (value > threshold
+                        && value > tile[0][col-1] && value > tile[0][col] && value > tile[0][col+1]
+                        && value > tile[1][col-1] && value > tile[1][col+1]
+                        && value > tile[2][col-1] && value > tile[2][col] && value > tile[2][col+1]);
+                }
+                const auto ballot = __ballot_sync(0xffffffffu, isPeak);
+                if (lane == 0)
+                    warpCounts[warp] = __popc(ballot);
+                __syncthreads();
+
+                // Index of the peak in the strip: previous segments + previous warps + previous lanes
+                if (isPeak)
+                {
+                    auto peakIndex = stripCount + __popc(ballot & ((1u << lane) - 1u));
+                    for (auto previousWarp = 0 ; previousWarp < warp ; previousWarp++)
+                        peakIndex += warpCounts[previousWarp];
+                    // Accurate peak location: considered neighboors (same as writeResultKernel)
+                    if (peakIndex < maxPeaks)
+                    {
+                        T xAcc = 0.f;
+                        T yAcc = 0.f;
+                        T scoreAcc = 0.f;
+                        const auto dWidth = 3;
+                        const auto dHeight = 3;
+                        for (auto dy = -dHeight ; dy <= dHeight ; dy++)
+                        {
+                            const auto yNeighbor = y + dy;
+                            if (0 <= yNeighbor && yNeighbor < height)
+                            {
+                                for (auto dx = -dWidth ; dx <= dWidth ; dx++)
+                                {
+                                    const auto xNeighbor = x + dx;
+                                    if (0 <= xNeighbor && xNeighbor < width)
+                                    {
+                                        const auto score = loadCuda<T>(
+                                            sourcePtrOffset[yNeighbor * width + xNeighbor]);
+                                        if (score > 0)
+                                        {
+                                            xAcc += xNeighbor*score;
+                                            yAcc += yNeighbor*score;
+                                            scoreAcc += score;
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                        const auto outputIndex = peakIndex * 3;
+                        stripPeaksOffset[outputIndex] = xAcc / scoreAcc + offsetX;
+                        stripPeaksOffset[outputIndex + 1] = yAcc / scoreAcc + offsetY;
+                        stripPeaksOffset[outputIndex + 2] = tile[1][col];
+                    }
+                }
+                // All threads read stripCount & warpCounts (and the tile) before they are updated
+                __syncthreads();
+                if (threadIdx.x == 0)
+                {
+                    auto segmentCount = 0;
+                    for (auto i = 0 ; i < NMS_STRIP_WARPS ; i++)
+                        segmentCount += warpCounts[i];
+                    stripCount = fastMinCuda(maxPeaks, stripCount + segmentCount);
+                }
+                __syncthreads();
+            }
+        }
+        if (threadIdx.x == 0)
+            stripCountsPtr[channel * numberStrips + strip] = stripCount;
+    }
+
+    // It concatenates the peaks of the strips of each channel (blockIdx.x) in order, truncated to maxPeaks, with the
+    // format of writeResultKernel
     template <typename T>
-    void nmsGpu(T* targetPtr, int* kernelPtr, const T* const sourcePtr, const T threshold,
-                const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize, const Point<T>& offset)
+    __global__ void nmsGatherKernel(
+        T* output, const T* const stripPeaksPtr, const int* const stripCountsPtr, const int numberStrips,
+        const int maxPeaks, const int offsetTarget)
+    {
+        __shared__ int stripOffsets[NMS_STRIPS_MAX+1];
+        const auto channel = (int)blockIdx.x;
+        if (threadIdx.x == 0)
+        {
+            stripOffsets[0] = 0;
+            for (auto strip = 0 ; strip < numberStrips ; strip++)
+                stripOffsets[strip+1] = stripOffsets[strip] + stripCountsPtr[channel * numberStrips + strip];
+        }
+        __syncthreads();
+
+        auto* outputOffset = &output[channel * offsetTarget];
+        const auto numberPeaks = fastMinCuda(maxPeaks, stripOffsets[numberStrips]);
+        for (auto strip = 0 ; strip < numberStrips ; strip++)
+        {
+            const auto peakBegin = stripOffsets[strip];
+            const auto stripValues = 3 * (fastMinCuda(numberPeaks, stripOffsets[strip+1]) - peakBegin);
+            const auto* const stripPeaksOffset = &stripPeaksPtr[(channel * numberStrips + strip) * maxPeaks * 3];
+            for (auto i = (int)threadIdx.x ; i < stripValues ; i += (int)blockDim.x)
+                outputOffset[(peakBegin + 1) * 3 + i] = stripPeaksOffset[i];
+        }
+        if (threadIdx.x == 0)
+            outputOffset[0] = numberPeaks;
+    }
+
+    // Value of the upsampled heat map at the target pixel (x,y), same mapping than resizeAndMergeGpu
+    // pixelStep: Distance between 2 consecutive source pixels (see getPixelStepCuda)
+    template <typename T>
+    inline __device__ T upsampledValue(
+        const T* const sourcePtr, const int x, const int y, const int widthSource, const int heightSource,
+        const T scale, const int pixelStep)
+    {
+        const T xSource = (x + T(0.5f)) / scale - T(0.5f);
+        const T ySource = (y + T(0.5f)) / scale - T(0.5f);
+        return bicubicInterpolate(
+            sourcePtr, xSource, ySource, widthSource, heightSource, widthSource * pixelStep, pixelStep);
+    }
+
+    // Ties: a pixel must be strictly higher than the neighbors before it in raster order and at least as high as the
+    // ones after it, so exactly one pixel (the first one) of a flat plateau is kept
+    template <typename T>
+    __device__ inline bool isTieBrokenPeak(const int dx, const int dy, const T value, const T neighbor)
+    {
+        return (dy < 0 || (dy == 0 && dx < 0) ? value > neighbor : value >= neighbor);
+    }
+
+    // For each low resolution local maximum, it finds the maximum of the upsampled heat map around it and registers
+    // it (peakIndexPtr = target pixel index, or -1) if it is also a full resolution peak (i.e., above threshold and
+    // higher than its 8 neighbors, with ties broken as in isTieBrokenPeak)
+    template <BlobLayout TLayout, typename T>
+    __global__ void resizeAndNmsRegisterKernel(
+        int* kernelPtr, int* peakIndexPtr, const T* const sourcePtr, const int sourceChannels, const int channels,
+        const int widthSource, const int heightSource, const int widthTarget, const int heightTarget, const T scale,
+        const T threshold)
+    {
+        const auto x = (int)(blockIdx.x * blockDim.x + threadIdx.x);
+        const auto y = (int)(blockIdx.y * blockDim.y + threadIdx.y);
+        const auto channel = blockIdx.z * blockDim.z + threadIdx.z;
+        if (x < widthSource && y < heightSource)
+        {
+            const auto sourceArea = widthSource * heightSource;
+            const auto index = channel * sourceArea + y*widthSource + x;
+            // Only the first `channels` channels of each source image are processed
+            const T* const sourcePtrChannel = sourcePtr + getChannelOffsetCuda<TLayout>(
+                channel / channels, channel % channels, sourceChannels, sourceArea);
+            const auto pixelStep = getPixelStepCuda<TLayout>(sourceChannels);
+            kernelPtr[index] = 0;
+            peakIndexPtr[index] = -1;
+            // 1. Low resolution local maximum
+            const auto value = sourcePtrChannel[(y*widthSource + x) * pixelStep];
+            for (auto dy = -1 ; dy <= 1 ; dy++)
+            {
+                const auto yNeighbor = y + dy;
+                if (0 <= yNeighbor && yNeighbor < heightSource)
+                {
+                    for (auto dx = -1 ; dx <= 1 ; dx++)
+                    {
+                        const auto xNeighbor = x + dx;
+                        if ((dx != 0 || dy != 0) && 0 <= xNeighbor && xNeighbor < widthSource
+                            && !isTieBrokenPeak(
+                                dx, dy, value, sourcePtrChannel[(yNeighbor*widthSource + xNeighbor) * pixelStep]))
+                            return;
+                    }
+                }
+            }
+            // 2. Upsampled maximum within +-1 low resolution pixel (borders excluded, as in nmsRegisterKernel)
+            const auto searchRadius = (int)ceil(scale);
+            const auto xCenter = (int)floor((x + T(0.5f)) * scale);
+            const auto yCenter = (int)floor((y + T(0.5f)) * scale);
+            const auto xMin = fastMaxCuda(1, xCenter - searchRadius);
+            const auto xMax = fastMinCuda(widthTarget - 2, xCenter + searchRadius);
+            const auto yMin = fastMaxCuda(1, yCenter - searchRadius);
+            const auto yMax = fastMinCuda(heightTarget - 2, yCenter + searchRadius);
+            auto xBest = -1;
+            auto yBest = -1;
+            T best = threshold;
+            for (auto yTarget = yMin ; yTarget <= yMax ; yTarget++)
+            {
+                for (auto xTarget = xMin ; xTarget <= xMax ; xTarget++)
+                {
+                    const auto upsampled = upsampledValue(
+                        sourcePtrChannel, xTarget, yTarget, widthSource, heightSource, scale, pixelStep);
+                    if (upsampled > best)
+                    {
+                        best = upsampled;
+                        xBest = xTarget;
+                        yBest = yTarget;
+                    }
+                }
+            }
+            // 3. Full resolution NMS
+            if (xBest < 0)
+                return;
+            for (auto dy = -1 ; dy <= 1 ; dy++)
+                for (auto dx = -1 ; dx <= 1 ; dx++)
+                    if ((dx != 0 || dy != 0)
+                        && !isTieBrokenPeak(
+                            dx, dy, best, upsampledValue(
+                                sourcePtrChannel, xBest+dx, yBest+dy, widthSource, heightSource, scale, pixelStep)))
+                        return;
+            kernelPtr[index] = 1;
+            peakIndexPtr[index] = yBest*widthTarget + xBest;
+        }
+    }
+
+    template <BlobLayout TLayout, typename T>
+    __global__ void resizeAndNmsWriteResultKernel(
+        T* output, const int* const kernelPtr, const int* const peakIndexPtr, const T* const sourcePtr,
+        const int sourceChannels, const int channels, const int widthSource, const int heightSource,
+        const int widthTarget, const int heightTarget, const T scale, const int maxPeaks, const T offsetX,
+        const T offsetY, const int offsetTarget)
+    {
+        const auto globalIdx = blockIdx.x * blockDim.x + threadIdx.x;
+        const auto channel = blockIdx.y * blockDim.y + threadIdx.y;
+        const auto sourceArea = widthSource * heightSource;
+        if (globalIdx < sourceArea)
+        {
+            const auto channelOffset = channel * sourceArea;
+            const T* const sourcePtrChannel = sourcePtr + getChannelOffsetCuda<TLayout>(
+                channel / channels, channel % channels, sourceChannels, sourceArea);
+            const auto pixelStep = getPixelStepCuda<TLayout>(sourceChannels);
+            auto* outputOffset = &output[channel * offsetTarget];
+            // kernelPtr was scanned for all the channels at once, so the peaks of the previous channels are removed
+            const auto peakIndex = kernelPtr[channelOffset + globalIdx] - kernelPtr[channelOffset];
+            const auto peakLocation = peakIndexPtr[channelOffset + globalIdx];
+            // Accurate peak location: considered neighboors (same as writeResultKernel)
+            if (peakLocation >= 0 && peakIndex < maxPeaks)
+            {
+                const auto peakLocX = peakLocation % widthTarget;
+                const auto peakLocY = peakLocation / widthTarget;
+                T xAcc = 0.f;
+                T yAcc = 0.f;
+                T scoreAcc = 0.f;
+                const auto dWidth = 3;
+                const auto dHeight = 3;
+                for (auto dy = -dHeight ; dy <= dHeight ; dy++)
+                {
+                    const auto y = peakLocY + dy;
+                    if (0 <= y && y < heightTarget)
+                    {
+                        for (auto dx = -dWidth ; dx <= dWidth ; dx++)
+                        {
+                            const auto x = peakLocX + dx;
+                            if (0 <= x && x < widthTarget)
+                            {
+                                const auto score = upsampledValue(
+                                    sourcePtrChannel, x, y, widthSource, heightSource, scale, pixelStep);
+                                if (score > 0)
+                                {
+                                    xAcc += x*score;
+                                    yAcc += y*score;
+                                    scoreAcc += score;
+                                }
+                            }
+                        }
+                    }
+                }
+                const auto outputIndex = (peakIndex + 1) * 3;
+                outputOffset[outputIndex] = xAcc / scoreAcc + offsetX;
+                outputOffset[outputIndex + 1] = yAcc / scoreAcc + offsetY;
+                outputOffset[outputIndex + 2] = upsampledValue(
+                    sourcePtrChannel, peakLocX, peakLocY, widthSource, heightSource, scale, pixelStep);
+            }
+            // Last pixel --> Assign number of peaks (truncated to the maximum possible number of peaks)
+            if (globalIdx == sourceArea - 1)
+            {
+                const auto numberPeaks = peakIndex + (peakLocation >= 0 ? 1 : 0);
+                outputOffset[0] = (numberPeaks < maxPeaks ? numberPeaks : maxPeaks);
+            }
+        }
+    }
+
+    // TSource = T or __half. The peaks (targetPtr) and all the computations are in T
+    template <typename T, typename TSource>
+    void nmsGpuTemplate(
+        T* targetPtr, int* kernelPtr, const TSource* const sourcePtr, const T threshold,
+        const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize, const Point<T>& offset,
+        CUstream_st* const cudaStream, void* const scratchGpuPtr)
     {
         try
         {
@@ -310,31 +681,52 @@ namespace op
             // OP_CUDA_PROFILE_END(timeNormalize1, 1e3, REPS);
             // OP_CUDA_PROFILE_INIT(REPS);
 
-            // Optimized code: Running 3 kernels in total
-            // This returns kernelPtr, a binary array with 0s & 1s. 1s in the local maximum
-            // positions (size = size(sourcePtrOffsetted))
-            // Example result: [0,0,0,0,1,0,0,0,0,1,0,0,0,0]
-            // time = 1.24 ms
-            const dim3 threadsPerBlockRegister{THREADS_PER_BLOCK_1D, THREADS_PER_BLOCK_1D, 1};
-            const dim3 numBlocksRegister{getNumberCudaBlocks(width, threadsPerBlockRegister.x),
-                                         getNumberCudaBlocks(height, threadsPerBlockRegister.y),
-                                         getNumberCudaBlocks(num * channels, threadsPerBlockRegister.z)};
-            nmsRegisterKernel<<<numBlocksRegister, threadsPerBlockRegister>>>(
-                kernelPtr, sourcePtr, width, height, threshold);
-            // This modifies kernelPtrOffsetted, now it indicates the local maximum indexes
-            // Format: 0,0,0,1,1,1,1,2,2,2,... First maximum at index 2, second at 6, etc...
-            // Example result: [0,0,0,0,0,1,1,1,1,1,2,2,2,2]
-            // time = 2.71 ms
-            auto kernelThrustPtr = thrust::device_pointer_cast(kernelPtr);
-            thrust::exclusive_scan(kernelThrustPtr, kernelThrustPtr + num*channels*imageOffset, kernelThrustPtr);
-            // This returns targetPtrOffsetted, with the NMS applied over it
-            // time = 1.10 ms
-            const dim3 threadsPerBlockWrite{THREADS_PER_BLOCK, 1};
-            const dim3 numBlocksWrite{getNumberCudaBlocks(imageOffset, threadsPerBlockWrite.x),
-                                      getNumberCudaBlocks(num * channels, threadsPerBlockWrite.z)};
-            writeResultKernel<<<numBlocksWrite, threadsPerBlockWrite>>>(
-                targetPtr, imageOffset, kernelPtr, sourcePtr, width, height,
-                maxPeaks, offset.x, offset.y, offsetTarget);
+            // Tiled code: Running 2 kernels in total (and no scan). Each channel is split into strips of rows, whose
+            // peak lists (at most maxPeaks each) are saved into kernelPtr and then concatenated in order
+            const auto numberChannels = num * channels;
+            const auto peakListInts = maxPeaks * 3 * (int)(sizeof(T) / sizeof(int));
+            const auto numberStrips = std::min(
+                std::min(NMS_STRIPS_MAX, height), imageOffset / (peakListInts + 1));
+            if (numberStrips > 0)
+            {
+                const auto rowsPerStrip = (height + numberStrips - 1) / numberStrips;
+                auto* stripPeaksPtr = (T*)kernelPtr;
+                auto* stripCountsPtr = kernelPtr + numberChannels * numberStrips * peakListInts;
+                const dim3 numBlocksStrip{(unsigned int)numberStrips, (unsigned int)numberChannels};
+                nmsStripKernel<<<numBlocksStrip, NMS_STRIP_THREADS, 0, cudaStream>>>(
+                    stripPeaksPtr, stripCountsPtr, sourcePtr, width, height, rowsPerStrip, maxPeaks, threshold,
+                    offset.x, offset.y);
+                nmsGatherKernel<<<numberChannels, NMS_STRIP_THREADS, 0, cudaStream>>>(
+                    targetPtr, stripPeaksPtr, stripCountsPtr, numberStrips, maxPeaks, offsetTarget);
+            }
+            // Optimized code: Running 3 kernels in total (only if kernelPtr cannot fit the peak list of 1 strip,
+            // i.e., for very small heat maps)
+            else
+            {
+                // This returns kernelPtr, a binary array with 0s & 1s. 1s in the local maximum
+                // positions (size = size(sourcePtrOffsetted))
+                // Example result: [0,0,0,0,1,0,0,0,0,1,0,0,0,0]
+                // time = 1.24 ms
+                const dim3 threadsPerBlockRegister{THREADS_PER_BLOCK_1D, THREADS_PER_BLOCK_1D, 1};
+                const dim3 numBlocksRegister{getNumberCudaBlocks(width, threadsPerBlockRegister.x),
+                                             getNumberCudaBlocks(height, threadsPerBlockRegister.y),
+                                             getNumberCudaBlocks(num * channels, threadsPerBlockRegister.z)};
+                nmsRegisterKernel<<<numBlocksRegister, threadsPerBlockRegister, 0, cudaStream>>>(
+                    kernelPtr, sourcePtr, width, height, threshold);
+                // This modifies kernelPtrOffsetted, now it indicates the local maximum indexes
+                // Format: 0,0,0,1,1,1,1,2,2,2,... First maximum at index 2, second at 6, etc...
+                // Example result: [0,0,0,0,0,1,1,1,1,1,2,2,2,2]
+                // time = 2.71 ms
+                exclusiveScanGpu(kernelPtr, num*channels*imageOffset, scratchGpuPtr, cudaStream);
+                // This returns targetPtrOffsetted, with the NMS applied over it
+                // time = 1.10 ms
+                const dim3 threadsPerBlockWrite{THREADS_PER_BLOCK, 1};
+                const dim3 numBlocksWrite{getNumberCudaBlocks(imageOffset, threadsPerBlockWrite.x),
+                                          getNumberCudaBlocks(num * channels, threadsPerBlockWrite.z)};
+                writeResultKernel<<<numBlocksWrite, threadsPerBlockWrite, 0, cudaStream>>>(
+                    targetPtr, imageOffset, kernelPtr, sourcePtr, width, height,
+                    maxPeaks, offset.x, offset.y, offsetTarget);
+            }
 
             // // Profiling code
             // OP_CUDA_PROFILE_END(timeNormalize2, 1e3, REPS);
@@ -350,10 +742,169 @@ namespace op
         }
     }
 
+    template <typename T>
+    void nmsGpu(T* targetPtr, int* kernelPtr, const T* const sourcePtr, const T threshold,
+                const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize, const Point<T>& offset,
+                CUstream_st* const cudaStream, void* const scratchGpuPtr)
+    {
+        try
+        {
+            nmsGpuTemplate(
+                targetPtr, kernelPtr, sourcePtr, threshold, targetSize, sourceSize, offset, cudaStream, scratchGpuPtr);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void nmsGpu(T* targetPtr, int* kernelPtr, const __half* const sourcePtr, const T threshold,
+                const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize, const Point<T>& offset,
+                CUstream_st* const cudaStream, void* const scratchGpuPtr)
+    {
+        try
+        {
+            nmsGpuTemplate(
+                targetPtr, kernelPtr, sourcePtr, threshold, targetSize, sourceSize, offset, cudaStream, scratchGpuPtr);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <BlobLayout TLayout, typename T>
+    void resizeAndNmsGpuTemplate(
+        T* targetPtr, int* kernelPtr, const T* const sourcePtr, const T threshold,
+        const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize, const Point<int>& resizedSize,
+        const Point<T>& offset, CUstream_st* const cudaStream, void* const scratchGpuPtr)
+    {
+        try
+        {
+            const auto num = sourceSize[0];
+            const auto sourceChannels = sourceSize[1];
+            const auto heightSource = sourceSize[2];
+            const auto widthSource = sourceSize[3];
+            const auto channels = targetSize[1];
+            const auto maxPeaks = targetSize[2]-1;
+            const auto sourceArea = heightSource * widthSource;
+            const auto offsetTarget = (maxPeaks+1)*targetSize[3];
+            // Sanity check
+            if (channels > sourceChannels)
+                error("The number of peak channels cannot be greater than the number of heat map channels.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Same scale than resizeAndMergeGpu
+            const auto scale = (resizedSize.x / widthSource == 1 && resizedSize.y / heightSource == 1
+                ? T(1) : T(std::ceil(resizedSize.y / (float)(heightSource))));
+            // Target pixel of each peak (or -1), one per low resolution pixel
+            const auto volume = num * channels * sourceArea;
+            auto* peakIndexPtr = (scratchGpuPtr == nullptr
+                ? (int*)cudaPoolMalloc(sizeof(int) * volume, cudaStream) : (int*)scratchGpuPtr);
+            // This returns kernelPtr (1s in the low resolution pixels with a full resolution peak) & peakIndexPtr
+            const auto resizeAndNmsRegister = [&](const dim3& threadsPerBlockRegister)
+            {
+                const dim3 numBlocksRegister{getNumberCudaBlocks(widthSource, threadsPerBlockRegister.x),
+                                             getNumberCudaBlocks(heightSource, threadsPerBlockRegister.y),
+                                             getNumberCudaBlocks(num * channels, threadsPerBlockRegister.z)};
+                resizeAndNmsRegisterKernel<TLayout><<<numBlocksRegister, threadsPerBlockRegister, 0, cudaStream>>>(
+                    kernelPtr, peakIndexPtr, sourcePtr, sourceChannels, channels, widthSource, heightSource,
+                    resizedSize.x, resizedSize.y, scale, threshold);
+            };
+            dim3 threadsPerBlockRegister{THREADS_PER_BLOCK_1D, THREADS_PER_BLOCK_1D, 1};
+            getCudaAutotunedBlock(
+                threadsPerBlockRegister,
+                std::string{"resizeAndNmsRegisterKernel"} + (TLayout == BlobLayout::Nhwc ? " NHWC" : ""),
+                std::to_string(num * channels) + "x" + std::to_string(heightSource) + "x"
+                    + std::to_string(widthSource) + "x" + std::to_string(resizedSize.y),
+                CUDA_AUTOTUNE_BLOCKS_2D, resizeAndNmsRegister, cudaStream);
+            resizeAndNmsRegister(threadsPerBlockRegister);
+            // This modifies kernelPtr, now it indicates the peak indexes
+            exclusiveScanGpu(
+                kernelPtr, volume,
+                (scratchGpuPtr == nullptr ? nullptr : (char*)scratchGpuPtr + getPeakIndexBytes(volume)), cudaStream);
+            // This returns targetPtr, with the upsampled neighborhood of each peak refined as in nmsGpu
+            const dim3 threadsPerBlockWrite{THREADS_PER_BLOCK, 1};
+            const dim3 numBlocksWrite{getNumberCudaBlocks(sourceArea, threadsPerBlockWrite.x),
+                                      getNumberCudaBlocks(num * channels, threadsPerBlockWrite.y)};
+            resizeAndNmsWriteResultKernel<TLayout><<<numBlocksWrite, threadsPerBlockWrite, 0, cudaStream>>>(
+                targetPtr, kernelPtr, peakIndexPtr, sourcePtr, sourceChannels, channels, widthSource, heightSource,
+                resizedSize.x, resizedSize.y, scale, maxPeaks, offset.x, offset.y, offsetTarget);
+            // Free memory (no need to wait for the kernels, the pool only re-uses it once they have finished)
+            if (scratchGpuPtr == nullptr)
+                cudaPoolFree(peakIndexPtr, cudaStream);
+            // Sanity check
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void resizeAndNmsGpu(
+        T* targetPtr, int* kernelPtr, const T* const sourcePtr, const T threshold,
+        const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize, const Point<int>& resizedSize,
+        const Point<T>& offset, CUstream_st* const cudaStream, void* const scratchGpuPtr,
+        const BlobLayout sourceLayout)
+    {
+        try
+        {
+            if (sourceLayout == BlobLayout::Nhwc)
+                resizeAndNmsGpuTemplate<BlobLayout::Nhwc>(
+                    targetPtr, kernelPtr, sourcePtr, threshold, targetSize, sourceSize, resizedSize, offset,
+                    cudaStream, scratchGpuPtr);
+            else
+                resizeAndNmsGpuTemplate<BlobLayout::Nchw>(
+                    targetPtr, kernelPtr, sourcePtr, threshold, targetSize, sourceSize, resizedSize, offset,
+                    cudaStream, scratchGpuPtr);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned long long getNmsGpuScratchBytes(
+        const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize, const bool resizeAndNms)
+    {
+        try
+        {
+            const auto volume = sourceSize[0] * targetSize[1] * sourceSize[2] * sourceSize[3];
+            return (resizeAndNms ? getPeakIndexBytes(volume) : 0ull) + getScanStorageBytes(volume);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
     template void nmsGpu(
         float* targetPtr, int* kernelPtr, const float* const sourcePtr, const float threshold,
-        const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize, const Point<float>& offset);
+        const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize, const Point<float>& offset,
+        CUstream_st* const cudaStream, void* const scratchGpuPtr);
+    template void nmsGpu(
+        double* targetPtr, int* kernelPtr, const double* const sourcePtr, const double threshold,
+        const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize, const Point<double>& offset,
+        CUstream_st* const cudaStream, void* const scratchGpuPtr);
+    template void nmsGpu(
+        float* targetPtr, int* kernelPtr, const __half* const sourcePtr, const float threshold,
+        const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize, const Point<float>& offset,
+        CUstream_st* const cudaStream, void* const scratchGpuPtr);
     template void nmsGpu(
+        double* targetPtr, int* kernelPtr, const __half* const sourcePtr, const double threshold,
+        const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize, const Point<double>& offset,
+        CUstream_st* const cudaStream, void* const scratchGpuPtr);
+    template void resizeAndNmsGpu(
+        float* targetPtr, int* kernelPtr, const float* const sourcePtr, const float threshold,
+        const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize, const Point<int>& resizedSize,
+        const Point<float>& offset, CUstream_st* const cudaStream, void* const scratchGpuPtr,
+        const BlobLayout sourceLayout);
+    template void resizeAndNmsGpu(
         double* targetPtr, int* kernelPtr, const double* const sourcePtr, const double threshold,
-        const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize, const Point<double>& offset);
+        const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize, const Point<int>& resizedSize,
+        const Point<double>& offset, CUstream_st* const cudaStream, void* const scratchGpuPtr,
+        const BlobLayout sourceLayout);
 }
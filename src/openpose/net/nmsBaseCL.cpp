@@ -258,7 +258,7 @@ namespace op
     #endif
 
     template <typename T>
-    void nmsOcl(T* targetPtr, uint8_t* kernelGpuPtr, uint8_t* kernelCpuPtr, const T* const sourcePtr, const T threshold,
+    void nmsOcl(T* targetPtr, uint8_t* kernelGpuPtr, const T* const sourcePtr, const T threshold,
                 const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize, const Point<T>& offset,
                 const int gpuID)
     {
@@ -306,27 +306,32 @@ namespace op
                         <NMSFullWriteKernelFunctor, T>(
                          "nmsFullWriteKernel", op::nmsOclCommonFunctions + op::nmsFullWriteKernel);
 
+                auto& queue = OpenCL::getInstance(gpuID)->getPostProcessingQueueAfterNetwork();
+
                 // Temp DS
                 for (auto n = 0; n < num; n++)
                 {
-                    nmsFullRegisterKernel(cl::EnqueueArgs(OpenCL::getInstance(gpuID)->getQueue(), cl::NDRange((int)channels, (int)width, (int)height)),
+                    nmsFullRegisterKernel(cl::EnqueueArgs(queue, cl::NDRange((int)channels, (int)width, (int)height)),
                                       kernelPtrBuffer, sourcePtrBuffer, width, height, (float)threshold, false);
-                    OpenCL::getInstance(gpuID)->getQueue().enqueueReadBuffer(kernelPtrBuffer, CL_TRUE, 0,
-                                                                                 sizeof(uint8_t) * channels * imageOffset, &kernelCpuPtr[0]);
+                    // Partial sum on the host, in place. Mapping is zero-copy with unified memory (see nmsCaffe.cpp),
+                    // and a single download + upload otherwise
+                    auto* const kernelCpuPtr = (uint8_t*)queue.enqueueMapBuffer(
+                        kernelPtrBuffer, CL_TRUE, CL_MAP_READ | CL_MAP_WRITE, 0,
+                        sizeof(uint8_t) * channels * imageOffset);
                     for(int c=0; c<channels; c++){
                         uint8_t* currPtr = kernelCpuPtr + c*imageOffset;
                         std::partial_sum(currPtr,currPtr + imageOffset,currPtr);
                     }
-                    OpenCL::getInstance(gpuID)->getQueue().enqueueWriteBuffer(kernelPtrBuffer, CL_TRUE, 0,
-                                                                                  sizeof(uint8_t) * channels * imageOffset, &kernelCpuPtr[0]);
-                    nmsFullWriteKernel(cl::EnqueueArgs(OpenCL::getInstance(gpuID)->getQueue(), cl::NDRange(channels, width, height)),
+                    queue.enqueueUnmapMemObject(kernelPtrBuffer, kernelCpuPtr);
+                    nmsFullWriteKernel(cl::EnqueueArgs(queue, cl::NDRange(channels, width, height)),
                                       targetPtrBuffer, kernelPtrBuffer, sourcePtrBuffer, width, height, targetPeaks-1, false,
                                       offset.x, offset.y);
                 }
+                // The peaks are read with the network queue (e.g., Caffe cpu_data())
+                OpenCL::enqueueWait(OpenCL::getInstance(gpuID)->getQueue(), queue);
             #else
                 UNUSED(targetPtr);
                 UNUSED(kernelGpuPtr);
-                UNUSED(kernelCpuPtr);
                 UNUSED(sourcePtr);
                 UNUSED(threshold);
                 UNUSED(targetSize);
@@ -351,11 +356,11 @@ namespace op
     }
 
     template void nmsOcl(
-        float* targetPtr, uint8_t* kernelGpuPtr, uint8_t* kernelCpuPtr, const float* const sourcePtr, const float threshold,
+        float* targetPtr, uint8_t* kernelGpuPtr, const float* const sourcePtr, const float threshold,
         const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize, const Point<float>& offset,
         const int gpuID);
     template void nmsOcl(
-        double* targetPtr, uint8_t* kernelGpuPtr, uint8_t* kernelCpuPtr, const double* const sourcePtr, const double threshold,
+        double* targetPtr, uint8_t* kernelGpuPtr, const double* const sourcePtr, const double threshold,
         const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize, const Point<double>& offset,
         const int gpuID);
 }
@@ -2,7 +2,10 @@
 #ifdef USE_CAFFE
     #include <caffe/blob.hpp>
 #endif
+#include <openpose/gpu/cudaGraph.hpp>
+#include <openpose/gpu/cudaMemoryPool.hpp>
 #include <openpose/net/nmsBase.hpp>
+#include <openpose/utilities/tracer.hpp>
 #ifdef USE_OPENCL
     #include <openpose_private/gpu/opencl.hcl>
     #include <openpose_private/gpu/cl2.hpp>
@@ -17,21 +20,29 @@ namespace op
             ArrayCpuGpu<int> mKernelBlob;
             std::array<int, 4> mBottomSize;
             std::array<int, 4> mTopSize;
+            // CUDA Graphs and their (persistent) temporary memory
+            std::unique_ptr<CudaGraphCache> upCudaGraphCache;
+            void* pScratchGpuPtr;
+            unsigned long long mScratchBytes;
+            CUstream_st* pScratchCudaStream;
             // Special Kernel for OpenCL NMS
             #if defined USE_CAFFE && defined USE_OPENCL
                 //std::shared_ptr<ArrayCpuGpu<uint8_t>> mKernelBlobT;
                 uint8_t* mKernelGpuPtr;
-                uint8_t* mKernelCpuPtr;
             #endif
         #endif
 
         ImplNmsCaffe()
         {
-            #if defined USE_CAFFE && defined USE_OPENCL
+            #ifdef USE_CAFFE
                 try
                 {
-                    mKernelGpuPtr = nullptr;
-                    mKernelCpuPtr = nullptr;
+                    pScratchGpuPtr = nullptr;
+                    mScratchBytes = 0ull;
+                    pScratchCudaStream = nullptr;
+                    #ifdef USE_OPENCL
+                        mKernelGpuPtr = nullptr;
+                    #endif
                 }
                 catch (const std::exception& e)
                 {
@@ -42,13 +53,23 @@ namespace op
 
         ~ImplNmsCaffe()
         {
+            #if defined USE_CAFFE && defined USE_CUDA
+                try
+                {
+                    // Graphs first, they might still use the scratch memory
+                    upCudaGraphCache.reset();
+                    cudaPoolFree(pScratchGpuPtr, pScratchCudaStream);
+                }
+                catch (const std::exception& e)
+                {
+                    errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            #endif
             #if defined USE_CAFFE && defined USE_OPENCL
                 try
                 {
                     if (mKernelGpuPtr != nullptr)
                         clReleaseMemObject((cl_mem)mKernelGpuPtr);
-                    if (mKernelCpuPtr != nullptr)
-                        delete mKernelCpuPtr;
                 }
                 catch (const std::exception& e)
                 {
@@ -60,6 +81,10 @@ namespace op
 
     template <typename T>
     NmsCaffe<T>::NmsCaffe() :
+        pCudaStream{nullptr},
+        pBottomHalfGpuPtr{nullptr},
+        pLowResolutionBottom{nullptr},
+        mLowResolutionLayout{BlobLayout::Nchw},
         upImpl{new ImplNmsCaffe{}}
     {
         try
@@ -107,6 +132,7 @@ namespace op
     {
         try
         {
+            const CudaMemoryOwner cudaMemoryOwner{"NmsCaffe"};
             #ifdef USE_CAFFE
                 auto bottomBlob = bottom.at(0);
                 auto topBlob = top.at(0);
@@ -125,10 +151,14 @@ namespace op
                 // Special Kernel for OpenCL NMS
                 #if defined USE_CAFFE && defined USE_OPENCL
                     int bottomShapeVolume = bottomShape[0] * bottomShape[1] * bottomShape[2] * bottomShape[3];
+                    if (upImpl->mKernelGpuPtr != nullptr)
+                        clReleaseMemObject((cl_mem)upImpl->mKernelGpuPtr);
+                    // Mapped by the host on each frame (partial sum), so it is host memory with unified memory
+                    const auto openCl = OpenCL::getInstance(gpuID);
                     upImpl->mKernelGpuPtr = (uint8_t*)clCreateBuffer(
-                        OpenCL::getInstance(gpuID)->getContext().operator()(), CL_MEM_READ_WRITE,
+                        openCl->getContext().operator()(),
+                        CL_MEM_READ_WRITE | (openCl->hasUnifiedMemory() ? CL_MEM_ALLOC_HOST_PTR : 0),
                         sizeof(uint8_t) * bottomShapeVolume, NULL, NULL);
-                    upImpl->mKernelCpuPtr = new uint8_t[bottomShapeVolume];
                     // GPU ID
                     mGpuID = gpuID;
                 #else
@@ -179,11 +209,73 @@ namespace op
         }
     }
 
+    template <typename T>
+    void NmsCaffe<T>::setCudaStream(CUstream_st* cudaStream)
+    {
+        try
+        {
+            pCudaStream = cudaStream;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void NmsCaffe<T>::setHalfPrecisionBottom(const __half* bottomHalfGpuPtr)
+    {
+        try
+        {
+            pBottomHalfGpuPtr = bottomHalfGpuPtr;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void NmsCaffe<T>::setLowResolutionBottom(
+        ArrayCpuGpu<T>* lowResolutionBottom, const BlobLayout lowResolutionLayout)
+    {
+        try
+        {
+            pLowResolutionBottom = lowResolutionBottom;
+            mLowResolutionLayout = lowResolutionLayout;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void NmsCaffe<T>::setCudaGraphs(const bool cudaGraphs)
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                if (!cudaGraphs)
+                    upImpl->upCudaGraphCache.reset();
+                else if (upImpl->upCudaGraphCache == nullptr)
+                    upImpl->upCudaGraphCache.reset(new CudaGraphCache{});
+            #else
+                UNUSED(cudaGraphs);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template <typename T>
     void NmsCaffe<T>::Forward(const std::vector<ArrayCpuGpu<T>*>& bottom, const std::vector<ArrayCpuGpu<T>*>& top)
     {
         try
         {
+            const CudaMemoryOwner cudaMemoryOwner{"NmsCaffe"};
             // CUDA
             #ifdef USE_CUDA
                 Forward_gpu(bottom, top);
@@ -226,8 +318,71 @@ namespace op
         try
         {
             #if defined USE_CAFFE && defined USE_CUDA
-                nmsGpu(top.at(0)->mutable_gpu_data(), upImpl->mKernelBlob.mutable_gpu_data(),
-                       bottom.at(0)->gpu_data(), mThreshold, upImpl->mTopSize, upImpl->mBottomSize, mOffset);
+                // Note: bottom.at(0)->gpu_data() is not called in the fused or half precision modes, so Caffe does not
+                // allocate it
+                const TraceRange traceRange{"nmsGpu"};
+                // Blob pointers retrieved before any CUDA Graph capture (Caffe might allocate or copy them)
+                auto* const targetPtr = top.at(0)->mutable_gpu_data();
+                auto* const kernelPtr = upImpl->mKernelBlob.mutable_gpu_data();
+                const T* const sourcePtr = (pLowResolutionBottom != nullptr
+                    ? pLowResolutionBottom->gpu_data()
+                    : (pBottomHalfGpuPtr != nullptr ? nullptr : bottom.at(0)->gpu_data()));
+                const auto sourceSize = (pLowResolutionBottom != nullptr
+                    ? std::array<int, 4>{
+                        pLowResolutionBottom->shape(0), pLowResolutionBottom->shape(1),
+                        pLowResolutionBottom->shape(2), pLowResolutionBottom->shape(3)}
+                    : upImpl->mBottomSize);
+                // CUDA Graphs: Persistent temporary memory, so the captured kernels do not depend on the pool
+                void* scratchGpuPtr = nullptr;
+                if (upImpl->upCudaGraphCache != nullptr && pCudaStream != nullptr)
+                {
+                    const auto scratchBytes = getNmsGpuScratchBytes(
+                        upImpl->mTopSize, sourceSize, pLowResolutionBottom != nullptr);
+                    if (upImpl->mScratchBytes < scratchBytes)
+                    {
+                        upImpl->upCudaGraphCache->clear();
+                        cudaPoolFree(upImpl->pScratchGpuPtr, upImpl->pScratchCudaStream);
+                        upImpl->pScratchGpuPtr = cudaPoolMalloc(scratchBytes, pCudaStream);
+                        upImpl->mScratchBytes = scratchBytes;
+                        upImpl->pScratchCudaStream = pCudaStream;
+                    }
+                    scratchGpuPtr = upImpl->pScratchGpuPtr;
+                }
+                const auto nms = [&]()
+                {
+                    if (pLowResolutionBottom != nullptr)
+                        resizeAndNmsGpu(
+                            targetPtr, kernelPtr, sourcePtr, mThreshold, upImpl->mTopSize, sourceSize,
+                            Point<int>{upImpl->mBottomSize[3], upImpl->mBottomSize[2]}, mOffset, pCudaStream,
+                            scratchGpuPtr, mLowResolutionLayout);
+                    else if (pBottomHalfGpuPtr != nullptr)
+                        nmsGpu(targetPtr, kernelPtr, pBottomHalfGpuPtr, mThreshold, upImpl->mTopSize,
+                               upImpl->mBottomSize, mOffset, pCudaStream, scratchGpuPtr);
+                    else
+                        nmsGpu(targetPtr, kernelPtr, sourcePtr, mThreshold, upImpl->mTopSize, upImpl->mBottomSize,
+                               mOffset, pCudaStream, scratchGpuPtr);
+                };
+                if (scratchGpuPtr != nullptr)
+                {
+                    std::vector<unsigned long long> key;
+                    for (const auto* const pointer : {(const void*)targetPtr, (const void*)kernelPtr,
+                                                      (const void*)sourcePtr, (const void*)pBottomHalfGpuPtr,
+                                                      (const void*)scratchGpuPtr})
+                        cudaGraphKeyAppend(key, pointer);
+                    for (auto i = 0u ; i < 4u ; i++)
+                    {
+                        cudaGraphKeyAppend(key, upImpl->mTopSize[i]);
+                        cudaGraphKeyAppend(key, upImpl->mBottomSize[i]);
+                        cudaGraphKeyAppend(key, sourceSize[i]);
+                    }
+                    cudaGraphKeyAppend(key, mThreshold);
+                    cudaGraphKeyAppend(key, mOffset.x);
+                    cudaGraphKeyAppend(key, mOffset.y);
+                    cudaGraphKeyAppend(key, (int)mLowResolutionLayout);
+                    upImpl->upCudaGraphCache->run(key, pCudaStream, nms);
+                }
+                else
+                    nms();
             #else
                 UNUSED(bottom);
                 UNUSED(top);
@@ -247,9 +402,8 @@ namespace op
         try
         {
             #if defined USE_CAFFE && defined USE_OPENCL
-                nmsOcl(top.at(0)->mutable_gpu_data(), upImpl->mKernelGpuPtr, upImpl->mKernelCpuPtr,
-                       bottom.at(0)->gpu_data(), mThreshold, upImpl->mTopSize, upImpl->mBottomSize, mOffset,
-                       mGpuID);
+                nmsOcl(top.at(0)->mutable_gpu_data(), upImpl->mKernelGpuPtr, bottom.at(0)->gpu_data(), mThreshold,
+                       upImpl->mTopSize, upImpl->mBottomSize, mOffset, mGpuID);
             #else
                 UNUSED(bottom);
                 UNUSED(top);
@@ -1,10 +1,232 @@
 #include <openpose/net/resizeAndMergeBase.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/openCv.hpp>
+#include <openpose_private/utilities/avx.hpp>
+#include <openpose_private/utilities/neon.hpp>
 #include <openpose_private/utilities/openCvMultiversionHeaders.hpp>
+#include <openpose_private/utilities/parallelFor.hpp>
 
 namespace op
 {
+    // Target rows processed together (per channel) by each parallelFor() element
+    const auto RESIZE_CPU_ROWS_PER_TILE = 32;
+
+    // Bicubic interpolation taps of each target pixel along 1 dimension. Same as OpenCV INTER_CUBIC (A = -0.75,
+    // pixel centers aligned and replicated borders), but with the weights in float
+    struct CubicTaps
+    {
+        std::vector<int> indexes;
+        std::vector<float> weights;
+    };
+
+    CubicTaps getCubicTaps(const int sourceLength, const int targetLength, const float weightScale)
+    {
+        const auto A = -0.75f;
+        const auto scale = sourceLength / (double)targetLength;
+        CubicTaps cubicTaps;
+        cubicTaps.indexes.resize(4*targetLength);
+        cubicTaps.weights.resize(4*targetLength);
+        for (auto t = 0 ; t < targetLength ; t++)
+        {
+            const auto sourceCoordinate = (float)((t + 0.5) * scale - 0.5);
+            const auto s = (int)std::floor(sourceCoordinate);
+            const auto f = sourceCoordinate - s;
+            const auto w0 = ((A*(f + 1) - 5*A)*(f + 1) + 8*A)*(f + 1) - 4*A;
+            const auto w1 = ((A + 2)*f - (A + 3))*f*f + 1;
+            const auto w2 = ((A + 2)*(1 - f) - (A + 3))*(1 - f)*(1 - f) + 1;
+            const float weights[4] = {w0, w1, w2, 1.f - w0 - w1 - w2};
+            for (auto k = 0 ; k < 4 ; k++)
+            {
+                cubicTaps.indexes[4*t+k] = fastTruncate(s - 1 + k, 0, sourceLength - 1);
+                cubicTaps.weights[4*t+k] = weightScale * weights[k];
+            }
+        }
+        return cubicTaps;
+    }
+
+    // targetRow (+)= weights[0]*rows[0] + ... + weights[3]*rows[3]
+    using ResizeCubicVertical = void (*)(
+        float* targetRow, const float* const* const rows, const float* const weights, const int width,
+        const bool accumulate);
+
+    void resizeCubicVertical(
+        float* targetRow, const float* const* const rows, const float* const weights, const int width,
+        const bool accumulate)
+    {
+        for (auto x = 0 ; x < width ; x++)
+        {
+            const auto value = weights[0]*rows[0][x] + weights[1]*rows[1][x] + weights[2]*rows[2][x]
+                             + weights[3]*rows[3][x];
+            targetRow[x] = (accumulate ? targetRow[x] + value : value);
+        }
+    }
+
+    #ifdef WITH_AVX
+        OP_TARGET_AVX2 void resizeCubicVerticalAvx2(
+            float* targetRow, const float* const* const rows, const float* const weights, const int width,
+            const bool accumulate)
+        {
+            const __m256 weightsAvx[4] = {
+                _mm256_set1_ps(weights[0]), _mm256_set1_ps(weights[1]), _mm256_set1_ps(weights[2]),
+                _mm256_set1_ps(weights[3])};
+            auto x = 0;
+            // 8 pixels at a time
+            for ( ; x + 8 <= width ; x += 8)
+            {
+                auto value = _mm256_mul_ps(weightsAvx[0], _mm256_loadu_ps(&rows[0][x]));
+                for (auto k = 1 ; k < 4 ; k++)
+                    value = _mm256_add_ps(value, _mm256_mul_ps(weightsAvx[k], _mm256_loadu_ps(&rows[k][x])));
+                if (accumulate)
+                    value = _mm256_add_ps(value, _mm256_loadu_ps(&targetRow[x]));
+                _mm256_storeu_ps(&targetRow[x], value);
+            }
+            // Remaining ones
+            const float* const remainingRows[4] = {rows[0] + x, rows[1] + x, rows[2] + x, rows[3] + x};
+            resizeCubicVertical(targetRow + x, remainingRows, weights, width - x, accumulate);
+        }
+    #endif
+
+    #ifdef WITH_NEON
+        void resizeCubicVerticalNeon(
+            float* targetRow, const float* const* const rows, const float* const weights, const int width,
+            const bool accumulate)
+        {
+            const float32x4_t weightsNeon[4] = {
+                vdupq_n_f32(weights[0]), vdupq_n_f32(weights[1]), vdupq_n_f32(weights[2]), vdupq_n_f32(weights[3])};
+            auto x = 0;
+            // 4 pixels at a time (multiply and add rather than fused multiply-add, so it matches the scalar code)
+            for ( ; x + 4 <= width ; x += 4)
+            {
+                auto value = vmulq_f32(weightsNeon[0], vld1q_f32(&rows[0][x]));
+                for (auto k = 1 ; k < 4 ; k++)
+                    value = vaddq_f32(value, vmulq_f32(weightsNeon[k], vld1q_f32(&rows[k][x])));
+                if (accumulate)
+                    value = vaddq_f32(vld1q_f32(&targetRow[x]), value);
+                vst1q_f32(&targetRow[x], value);
+            }
+            // Remaining ones
+            const float* const remainingRows[4] = {rows[0] + x, rows[1] + x, rows[2] + x, rows[3] + x};
+            resizeCubicVertical(targetRow + x, remainingRows, weights, width - x, accumulate);
+        }
+    #endif
+
+    // SIMD version selected at runtime
+    ResizeCubicVertical getResizeCubicVertical()
+    {
+        #if defined WITH_AVX
+            static const auto sResizeCubicVertical = (cpuSupportsAvx2()
+                ? &resizeCubicVerticalAvx2 : &resizeCubicVertical);
+            return sResizeCubicVertical;
+        #elif defined WITH_NEON
+            static const auto sResizeCubicVertical = (cpuSupportsNeon()
+                ? &resizeCubicVerticalNeon : &resizeCubicVertical);
+            return sResizeCubicVertical;
+        #else
+            return &resizeCubicVertical;
+        #endif
+    }
+
+    // Separable bicubic resize of every channel of every scale into the target size, averaging the scales in the
+    // same pass (so no per-scale temporary heat maps are required). Channels are split into tiles of rows, which are
+    // processed in parallel
+    void resizeAndMergeCubicFloatCpu(
+        float* targetPtr, const std::vector<const float*>& sourcePtrs, const std::array<int, 4>& targetSize,
+        const std::vector<std::array<int, 4>>& sourceSizes)
+    {
+        try
+        {
+            const auto nums = (int)sourceSizes.size();
+            const auto channels = targetSize[1];
+            const auto targetHeight = targetSize[2];
+            const auto targetWidth = targetSize[3];
+            const auto targetChannelOffset = targetWidth * targetHeight;
+            for (const auto& sourceSize : sourceSizes)
+                if (sourceSize[0] != 1)
+                    error("It should never reache this point. Notify us otherwise.",
+                          __LINE__, __FUNCTION__, __FILE__);
+            // Interpolation taps of each scale (the vertical weights include the 1/nums of the average)
+            std::vector<CubicTaps> horizontalTaps;
+            std::vector<CubicTaps> verticalTaps;
+            for (const auto& sourceSize : sourceSizes)
+            {
+                horizontalTaps.emplace_back(getCubicTaps(sourceSize[3], targetWidth, 1.f));
+                verticalTaps.emplace_back(getCubicTaps(sourceSize[2], targetHeight, 1.f/nums));
+            }
+            const auto resizeCubicVerticalRow = getResizeCubicVertical();
+            const auto tilesPerChannel = (targetHeight + RESIZE_CPU_ROWS_PER_TILE - 1) / RESIZE_CPU_ROWS_PER_TILE;
+            parallelFor(0, channels * tilesPerChannel, [&](const int tile)
+            {
+                const auto c = tile / tilesPerChannel;
+                const auto yBegin = (tile % tilesPerChannel) * RESIZE_CPU_ROWS_PER_TILE;
+                const auto yEnd = fastMin(yBegin + RESIZE_CPU_ROWS_PER_TILE, targetHeight);
+                auto* currTargetPtr = &targetPtr[c*targetChannelOffset];
+                // Horizontally resized source rows of the tile
+                thread_local std::vector<float> tHorizontalRows;
+                for (auto n = 0 ; n < nums ; n++)
+                {
+                    const auto sourceHeight = sourceSizes[n][2];
+                    const auto sourceWidth = sourceSizes[n][3];
+                    const auto* const currSourcePtr = &sourcePtrs[n][c*sourceHeight*sourceWidth];
+                    const auto& currHorizontalTaps = horizontalTaps[n];
+                    const auto& currVerticalTaps = verticalTaps[n];
+                    // Horizontal pass (only the source rows used by the tile, indexes are non-decreasing)
+                    const auto sourceYBegin = currVerticalTaps.indexes[4*yBegin];
+                    const auto sourceYEnd = currVerticalTaps.indexes[4*(yEnd-1)+3] + 1;
+                    tHorizontalRows.resize((sourceYEnd - sourceYBegin) * targetWidth);
+                    for (auto sourceY = sourceYBegin ; sourceY < sourceYEnd ; sourceY++)
+                    {
+                        const auto* const sourceRow = &currSourcePtr[sourceY*sourceWidth];
+                        auto* horizontalRow = &tHorizontalRows[(sourceY - sourceYBegin) * targetWidth];
+                        for (auto x = 0 ; x < targetWidth ; x++)
+                        {
+                            const auto* const indexes = &currHorizontalTaps.indexes[4*x];
+                            const auto* const weights = &currHorizontalTaps.weights[4*x];
+                            horizontalRow[x] = weights[0]*sourceRow[indexes[0]] + weights[1]*sourceRow[indexes[1]]
+                                             + weights[2]*sourceRow[indexes[2]] + weights[3]*sourceRow[indexes[3]];
+                        }
+                    }
+                    // Vertical pass (and scale average)
+                    for (auto y = yBegin ; y < yEnd ; y++)
+                    {
+                        const auto* const indexes = &currVerticalTaps.indexes[4*y];
+                        const float* const rows[4] = {
+                            &tHorizontalRows[(indexes[0] - sourceYBegin) * targetWidth],
+                            &tHorizontalRows[(indexes[1] - sourceYBegin) * targetWidth],
+                            &tHorizontalRows[(indexes[2] - sourceYBegin) * targetWidth],
+                            &tHorizontalRows[(indexes[3] - sourceYBegin) * targetWidth]};
+                        resizeCubicVerticalRow(
+                            &currTargetPtr[y*targetWidth], rows, &currVerticalTaps.weights[4*y], targetWidth, n > 0);
+                    }
+                }
+            });
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    // Only float is specialized
+    template <typename T>
+    bool resizeAndMergeCubicCpu(
+        T* targetPtr, const std::vector<const T*>& sourcePtrs, const std::array<int, 4>& targetSize,
+        const std::vector<std::array<int, 4>>& sourceSizes)
+    {
+        UNUSED(targetPtr);
+        UNUSED(sourcePtrs);
+        UNUSED(targetSize);
+        UNUSED(sourceSizes);
+        return false;
+    }
+
+    template <>
+    bool resizeAndMergeCubicCpu(
+        float* targetPtr, const std::vector<const float*>& sourcePtrs, const std::array<int, 4>& targetSize,
+        const std::vector<std::array<int, 4>>& sourceSizes)
+    {
+        resizeAndMergeCubicFloatCpu(targetPtr, sourcePtrs, targetSize, sourceSizes);
+        return true;
+    }
     template <typename T>
     void resizeAndMergeCpu(T* targetPtr, const std::vector<const T*>& sourcePtrs,
                            const std::array<int, 4>& targetSize,
@@ -28,8 +250,21 @@ namespace op
             const auto targetWidth = targetSize[3]; // 496
             const auto targetChannelOffset = targetWidth * targetHeight;
 
+            // Batch without merging (e.g., several faces): Its elements are resized as consecutive channels
+            if (sourceSizes.size() == 1 && sourceSizes[0][0] > 1 && targetSize[0] == sourceSizes[0][0])
+            {
+                const auto& sourceSize = sourceSizes[0];
+                resizeAndMergeCpu(
+                    targetPtr, sourcePtrs, std::array<int, 4>{1, targetSize[0]*channels, targetHeight, targetWidth},
+                    std::vector<std::array<int, 4>>{{1, sourceSize[0]*sourceSize[1], sourceSize[2], sourceSize[3]}},
+                    scaleInputToNetInputs);
+                return;
+            }
+            // Fused resize and multi-scale average (float)
+            if (resizeAndMergeCubicCpu(targetPtr, sourcePtrs, targetSize, sourceSizes))
+                return;
             // No multi-scale merging or no merging required
-            if (sourceSizes.size() == 1)
+            else if (sourceSizes.size() == 1)
             {
                 // Params
                 const auto& sourceSize = sourceSizes[0];
@@ -1,19 +1,43 @@
 #include <openpose/net/resizeAndMergeBase.hpp>
 #include <openpose/gpu/cuda.hpp>
+#include <openpose/gpu/cudaAutotune.hpp>
+#include <openpose/gpu/cudaMemoryPool.hpp>
 #include <openpose_private/gpu/cuda.hu>
 
 namespace op
 {
+    // Default block shapes (see gpu/cudaAutotune.hpp for the autotuned ones)
     const auto THREADS_PER_BLOCK = 256u;
     const auto THREADS_PER_BLOCK_1D = 16u;
 
-    template <typename T>
+    // Autotuning kernel name of the kernels templated on the source layout and on the target type
+    template <BlobLayout TLayout, typename TTarget>
+    std::string getAutotuneKernelName(const std::string& kernelName)
+    {
+        return kernelName + (TLayout == BlobLayout::Nhwc ? " NHWC" : "")
+            + (sizeof(TTarget) == 2 ? " FP16" : sizeof(TTarget) == 8 ? " FP64" : "");
+    }
+
+    // The target is always NCHW, so a channel-last source is transposed while copied
+    template <BlobLayout TLayout, typename TTarget, typename T>
     __global__ void fillKernel(
-        T* targetPtr, const T* const sourcePtr, const int N)
+        TTarget* targetPtr, const T* const sourcePtr, const int N, const int channels, const int sourceChannels,
+        const int area)
     {
-        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
+        const auto x = (int)((blockIdx.x * blockDim.x) + threadIdx.x);
         if (x < N)
-            targetPtr[x] = sourcePtr[x];
+        {
+            if (TLayout == BlobLayout::Nchw)
+                storeCuda(targetPtr[x], sourcePtr[x]);
+            else
+            {
+                const auto channel = x / area;
+                const auto sourceOffset = getChannelOffsetCuda<TLayout>(
+                    channel / channels, channel % channels, sourceChannels, area);
+                const auto pixelStep = getPixelStepCuda<TLayout>(sourceChannels);
+                storeCuda(targetPtr[x], sourcePtr[sourceOffset + (x % area) * pixelStep]);
+            }
+        }
     }
 
     // template <typename T>
@@ -103,9 +127,264 @@ namespace op
     }
 
     template <typename T>
+    __global__ void resizeAndPadBgrKernel(
+        T* targetPtr, const unsigned char* const sourcePtr, const int widthSource, const int heightSource,
+        const int widthTarget, const int heightTarget, const T rescaleFactor)
+    {
+        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
+        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
+        if (x < widthTarget && y < heightTarget)
+        {
+            auto* const targetPixelPtr = targetPtr + 3*(y*widthTarget+x);
+            if (x < widthSource * rescaleFactor && y < heightSource * rescaleFactor)
+            {
+                // Same mapping than the cv::warpAffine of resizeFixedAspectRatio: bicubic when upsampling, bilinear
+                // otherwise
+                const T xSource = x / rescaleFactor;
+                const T ySource = y / rescaleFactor;
+                for (auto channel = 0 ; channel < 3 ; channel++)
+                    targetPixelPtr[channel] = (rescaleFactor > T(1)
+                        ? fastTruncateCuda(
+                            bicubicInterpolate(sourcePtr + channel, xSource, ySource, widthSource, heightSource,
+                                               3*widthSource, 3), T(0), T(255))
+                        : bilinearInterpolate(sourcePtr + channel, xSource, ySource, widthSource, heightSource,
+                                              3*widthSource, 3));
+            }
+            else
+                for (auto channel = 0 ; channel < 3 ; channel++)
+                    targetPixelPtr[channel] = 0;
+        }
+    }
+
+    template <typename T>
+    inline __device__ T normalizeBgrCuda(const T value, const int channel, const int normalize)
+    {
+        // Same normalization than uCharCvMatToFloatPtr
+        if (normalize == 1)
+            return value * T(1/256.f) - T(0.5f);
+        else if (normalize == 2)
+            return T(0.017f) * (value - (channel == 0 ? T(103.94f) : (channel == 1 ? T(116.78f) : T(123.68f))));
+        else
+            return value;
+    }
+
+    template <typename T>
+    __global__ void resizeAndPadNv12Kernel(
+        T* targetPtr, const unsigned char* const nv12Ptr, const int widthSource, const int heightSource,
+        const int pitch, const bool bt709, const bool fullRange, const float* const undistortMapPtr,
+        const int orientation, const int widthTarget, const int heightTarget, const T rescaleFactor,
+        const int normalize)
+    {
+        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
+        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
+        if (x < widthTarget && y < heightTarget)
+        {
+            const auto targetArea = widthTarget * heightTarget;
+            T bgr[3] = {0, 0, 0};
+            const auto widthOriented = ((orientation & 1) ? heightSource : widthSource);
+            const auto heightOriented = ((orientation & 1) ? widthSource : heightSource);
+            if (x < widthOriented * rescaleFactor && y < heightOriented * rescaleFactor)
+            {
+                // Same mapping than the cv::warpAffine of resizeFixedAspectRatio: bicubic when upsampling, bilinear
+                // otherwise
+                T xSource = x / rescaleFactor;
+                T ySource = y / rescaleFactor;
+                // Rotation/flip and undistortion folded into the same gather (no intermediate rotated nor
+                // undistorted image)
+                orientCoordinatesCuda(xSource, ySource, orientation, widthSource, heightSource);
+                if (undistortMapPtr == nullptr
+                    || undistortCoordinatesCuda(xSource, ySource, undistortMapPtr, widthSource, heightSource))
+                {
+                    const T luma = (rescaleFactor > T(1)
+                        ? fastTruncateCuda(
+                            bicubicInterpolate(nv12Ptr, xSource, ySource, widthSource, heightSource, pitch),
+                            T(0), T(255))
+                        : bilinearInterpolate(nv12Ptr, xSource, ySource, widthSource, heightSource, pitch));
+                    // Chroma (interleaved U and V at half resolution, MPEG-2/H.264 default chroma siting)
+                    const auto* const uvPtr = nv12Ptr + heightSource * pitch;
+                    const auto widthChroma = (widthSource + 1) / 2;
+                    const auto heightChroma = (heightSource + 1) / 2;
+                    const T xChroma = xSource / 2;
+                    const T yChroma = (ySource + T(0.5f)) / 2 - T(0.5f);
+                    const T u = bilinearInterpolate(uvPtr, xChroma, yChroma, widthChroma, heightChroma, pitch, 2);
+                    const T v = bilinearInterpolate(uvPtr+1, xChroma, yChroma, widthChroma, heightChroma, pitch, 2);
+                    yuvToBgrCuda(bgr[0], bgr[1], bgr[2], luma, u, v, bt709, fullRange);
+                }
+            }
+            // Padding is black (0), so it is also normalized
+            for (auto channel = 0 ; channel < 3 ; channel++)
+                targetPtr[channel * targetArea + y*widthTarget+x] = normalizeBgrCuda(bgr[channel], channel, normalize);
+        }
+    }
+
+    template <typename T>
+    __global__ void resizeAndPadBayerKernel(
+        T* targetPtr, const unsigned char* const bayerPtr, const int widthSource, const int heightSource,
+        const int pitch, const int redX, const int redY, const float* const undistortMapPtr, const int orientation,
+        const int widthTarget, const int heightTarget, const T rescaleFactor, const int normalize)
+    {
+        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
+        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
+        if (x < widthTarget && y < heightTarget)
+        {
+            const auto targetArea = widthTarget * heightTarget;
+            T bgr[3] = {0, 0, 0};
+            // Demosaicing, rotation/flip, undistortion (if any) and resizing in a single bilinear interpolation per
+            // color (no intermediate BGR, rotated nor undistorted image)
+            const auto widthOriented = ((orientation & 1) ? heightSource : widthSource);
+            const auto heightOriented = ((orientation & 1) ? widthSource : heightSource);
+            if (x < widthOriented * rescaleFactor && y < heightOriented * rescaleFactor)
+            {
+                T xSource = x / rescaleFactor;
+                T ySource = y / rescaleFactor;
+                orientCoordinatesCuda(xSource, ySource, orientation, widthSource, heightSource);
+                if (undistortMapPtr == nullptr
+                    || undistortCoordinatesCuda(xSource, ySource, undistortMapPtr, widthSource, heightSource))
+                    bayerToBgrCuda(
+                        bgr[0], bgr[1], bgr[2], bayerPtr, xSource, ySource, widthSource, heightSource, pitch, redX,
+                        redY);
+            }
+            // Padding is black (0), so it is also normalized
+            for (auto channel = 0 ; channel < 3 ; channel++)
+                targetPtr[channel * targetArea + y*widthTarget+x] = normalizeBgrCuda(bgr[channel], channel, normalize);
+        }
+    }
+
+    template <typename T>
+    __global__ void resizeAndPadBgrFrameKernel(
+        T* targetPtr, const unsigned char* const bgrPtr, const int widthSource, const int heightSource,
+        const int pitch, const float* const undistortMapPtr, const int orientation, const int widthTarget,
+        const int heightTarget, const T rescaleFactor, const int normalize)
+    {
+        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
+        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
+        if (x < widthTarget && y < heightTarget)
+        {
+            const auto targetArea = widthTarget * heightTarget;
+            T bgr[3] = {0, 0, 0};
+            const auto widthOriented = ((orientation & 1) ? heightSource : widthSource);
+            const auto heightOriented = ((orientation & 1) ? widthSource : heightSource);
+            if (x < widthOriented * rescaleFactor && y < heightOriented * rescaleFactor)
+            {
+                // Same mapping than resizeAndPadNv12Kernel
+                T xSource = x / rescaleFactor;
+                T ySource = y / rescaleFactor;
+                orientCoordinatesCuda(xSource, ySource, orientation, widthSource, heightSource);
+                if (undistortMapPtr == nullptr
+                    || undistortCoordinatesCuda(xSource, ySource, undistortMapPtr, widthSource, heightSource))
+                {
+                    for (auto channel = 0 ; channel < 3 ; channel++)
+                        bgr[channel] = (rescaleFactor > T(1)
+                            ? fastTruncateCuda(
+                                bicubicInterpolate(
+                                    bgrPtr + channel, xSource, ySource, widthSource, heightSource, pitch, 3),
+                                T(0), T(255))
+                            : bilinearInterpolate(
+                                bgrPtr + channel, xSource, ySource, widthSource, heightSource, pitch, 3));
+                }
+            }
+            // Padding is black (0), so it is also normalized
+            for (auto channel = 0 ; channel < 3 ; channel++)
+                targetPtr[channel * targetArea + y*widthTarget+x] = normalizeBgrCuda(bgr[channel], channel, normalize);
+        }
+    }
+
+    template <typename T>
+    __global__ void warpAffineCropsKernel(
+        T* targetPtr, const unsigned char* const sourcePtr, const int widthSource, const int heightSource,
+        const T* const affineMatrices, const int widthTarget, const int heightTarget, const int normalize)
+    {
+        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
+        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
+        const auto crop = blockIdx.z;
+        if (x < widthTarget && y < heightTarget)
+        {
+            // Inverse map: target (crop) pixel -> source pixel
+            const T* const affineMatrix = affineMatrices + 6*crop;
+            const T xSource = affineMatrix[0] * x + affineMatrix[1] * y + affineMatrix[2];
+            const T ySource = affineMatrix[3] * x + affineMatrix[4] * y + affineMatrix[5];
+            // Bilinear interpolation, pixels outside the image are black (as cv::BORDER_CONSTANT)
+            const auto xLeft = int(floor(xSource));
+            const auto yTop = int(floor(ySource));
+            const T dx = xSource - xLeft;
+            const T dy = ySource - yTop;
+            T bgr[3] = {0, 0, 0};
+            for (auto j = 0 ; j < 2 ; j++)
+            {
+                const auto ySourceJ = yTop + j;
+                if (ySourceJ < 0 || ySourceJ >= heightSource)
+                    continue;
+                for (auto i = 0 ; i < 2 ; i++)
+                {
+                    const auto xSourceI = xLeft + i;
+                    if (xSourceI < 0 || xSourceI >= widthSource)
+                        continue;
+                    const T weight = (i == 0 ? 1 - dx : dx) * (j == 0 ? 1 - dy : dy);
+                    const auto* const pixelPtr = sourcePtr + 3 * (ySourceJ * widthSource + xSourceI);
+                    for (auto channel = 0 ; channel < 3 ; channel++)
+                        bgr[channel] += weight * T(pixelPtr[channel]);
+                }
+            }
+            // Rounded as the 8-bit cv::warpAffine output, then normalized
+            const auto targetArea = widthTarget * heightTarget;
+            T* const cropPtr = targetPtr + 3 * crop * targetArea;
+            for (auto channel = 0 ; channel < 3 ; channel++)
+                cropPtr[channel * targetArea + y*widthTarget+x] = normalizeBgrCuda(
+                    T(floor(bgr[channel] + T(0.5f))), channel, normalize);
+        }
+    }
+
+    template <typename T>
+    __global__ void warpAffineCropsPlanarKernel(
+        T* targetPtr, const T* const sourcePtr, const int widthSource, const int heightSource,
+        const T* const affineMatrices, const int widthTarget, const int heightTarget, const T borderValue0,
+        const T borderValue1, const T borderValue2)
+    {
+        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
+        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
+        const auto crop = blockIdx.z;
+        if (x < widthTarget && y < heightTarget)
+        {
+            // Inverse map: target (crop) pixel -> source pixel
+            const T* const affineMatrix = affineMatrices + 6*crop;
+            const T xSource = affineMatrix[0] * x + affineMatrix[1] * y + affineMatrix[2];
+            const T ySource = affineMatrix[3] * x + affineMatrix[4] * y + affineMatrix[5];
+            // Bilinear interpolation, pixels outside the image take the border value of their channel
+            const auto xLeft = int(floor(xSource));
+            const auto yTop = int(floor(ySource));
+            const T dx = xSource - xLeft;
+            const T dy = ySource - yTop;
+            const T borderValues[3] = {borderValue0, borderValue1, borderValue2};
+            const auto sourceArea = widthSource * heightSource;
+            const auto targetArea = widthTarget * heightTarget;
+            T* const cropPtr = targetPtr + 3 * crop * targetArea;
+            for (auto channel = 0 ; channel < 3 ; channel++)
+            {
+                const auto* const channelPtr = sourcePtr + channel * sourceArea;
+                T value = 0;
+                for (auto j = 0 ; j < 2 ; j++)
+                {
+                    const auto ySourceJ = yTop + j;
+                    for (auto i = 0 ; i < 2 ; i++)
+                    {
+                        const auto xSourceI = xLeft + i;
+                        const T weight = (i == 0 ? 1 - dx : dx) * (j == 0 ? 1 - dy : dy);
+                        value += weight * (xSourceI < 0 || xSourceI >= widthSource
+                                           || ySourceJ < 0 || ySourceJ >= heightSource
+                            ? borderValues[channel] : channelPtr[ySourceJ * widthSource + xSourceI]);
+                    }
+                }
+                cropPtr[channel * targetArea + y*widthTarget+x] = value;
+            }
+        }
+    }
+
+    // sourceChannels: Channels of each source image in memory (see getChannelOffsetCuda)
+    template <BlobLayout TLayout, typename TTarget, typename T>
     __global__ void resize8TimesKernel(
-        T* targetPtr, const T* const sourcePtr, const int widthSource, const int heightSource, const int widthTarget,
-        const int heightTarget, const unsigned int rescaleFactor)
+        TTarget* targetPtr, const T* const sourcePtr, const int widthSource, const int heightSource,
+        const int widthTarget, const int heightTarget, const unsigned int rescaleFactor, const int channels,
+        const int sourceChannels)
     {
         const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
         const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
@@ -113,19 +392,24 @@ namespace op
 
         if (x < widthTarget && y < heightTarget)
         {
+            const auto sourceArea = widthSource * heightSource;
+            const auto pixelStep = getPixelStepCuda<TLayout>(sourceChannels);
+            const T* const sourcePtrChannel = sourcePtr + getChannelOffsetCuda<TLayout>(
+                channel / channels, channel % channels, sourceChannels, sourceArea);
             // Normal resize
             // Note: The first blockIdx of each dimension behaves differently, so applying old version in those
             if (blockIdx.x < 1 || blockIdx.y < 1)
             // Actually it is only required for the first 4, but then I would have not loaded the shared memory
             // if ((blockIdx.x < 1 || blockIdx.y < 1) && (threadIdx.x < 4 || threadIdx.y < 4))
             {
-                const auto sourceArea = widthSource * heightSource;
                 const auto targetArea = widthTarget * heightTarget;
                 const T xSource = (x + T(0.5f)) / T(rescaleFactor) - T(0.5f);
                 const T ySource = (y + T(0.5f)) / T(rescaleFactor) - T(0.5f);
-                const T* const sourcePtrChannel = sourcePtr + channel * sourceArea;
-                targetPtr[channel * targetArea + y*widthTarget+x] = bicubicInterpolate(
-                    sourcePtrChannel, xSource, ySource, widthSource, heightSource, widthSource);
+                storeCuda(
+                    targetPtr[channel * targetArea + y*widthTarget+x],
+                    bicubicInterpolate(
+                        sourcePtrChannel, xSource, ySource, widthSource, heightSource, widthSource * pixelStep,
+                        pixelStep));
                 return;
             }
 
@@ -147,8 +431,7 @@ namespace op
                 const auto xClean = fastTruncateCuda(minSourceXInt+int(sharedLoadId%5), 0, widthSource - 1);
                 const auto yClean = fastTruncateCuda(minSourceYInt+int(sharedLoadId/5), 0, heightSource - 1);
                 // Load into shared memory
-                const auto sourceIndex = (channel * heightSource + yClean) * widthSource + xClean;
-                sourcePtrShared[sharedLoadId] = sourcePtr[sourceIndex];
+                sourcePtrShared[sharedLoadId] = sourcePtrChannel[(yClean * widthSource + xClean) * pixelStep];
             }
             __syncthreads();
 
@@ -156,17 +439,20 @@ namespace op
             const auto targetArea = widthTarget * heightTarget;
             const T xSource = (x + T(0.5f)) / T(rescaleFactor) - T(0.5f);
             const T ySource = (y + T(0.5f)) / T(rescaleFactor) - T(0.5f);
-            targetPtr[channel * targetArea + y*widthTarget+x] = bicubicInterpolate8Times(
-                sourcePtrShared, xSource, ySource, widthSource, heightSource, threadIdx.x, threadIdx.y);
+            storeCuda(
+                targetPtr[channel * targetArea + y*widthTarget+x],
+                bicubicInterpolate8Times(
+                    sourcePtrShared, xSource, ySource, widthSource, heightSource, threadIdx.x, threadIdx.y));
         }
     }
 
-    template <typename T>
+    template <BlobLayout TLayout, typename TTarget, typename T>
     __global__ void resizeAndAddAndAverageKernel(
-        T* targetPtr, const int counter, const T* const scaleWidths, const T* const scaleHeights,
+        TTarget* targetPtr, const int counter, const T* const scaleWidths, const T* const scaleHeights,
         const int* const widthSources, const int* const heightSources, const int widthTarget, const int heightTarget,
-        const T* const sourcePtr0, const T* const sourcePtr1, const T* const sourcePtr2, const T* const sourcePtr3,
-        const T* const sourcePtr4, const T* const sourcePtr5, const T* const sourcePtr6, const T* const sourcePtr7)
+        const int sourceChannels, const T* const sourcePtr0, const T* const sourcePtr1, const T* const sourcePtr2,
+        const T* const sourcePtr3, const T* const sourcePtr4, const T* const sourcePtr5, const T* const sourcePtr6,
+        const T* const sourcePtr7)
     {
         const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
         const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
@@ -185,13 +471,16 @@ namespace op
                 const T* const sourcePtr = (
                     i == 0 ? sourcePtr0 : i == 1 ? sourcePtr1 : i == 2 ? sourcePtr2 : i == 3 ? sourcePtr3
                         : i == 4 ? sourcePtr4 : i == 5 ? sourcePtr5 : i == 6 ? sourcePtr6 : sourcePtr7);
-                const T* const sourcePtrChannel = sourcePtr + channel * sourceArea;
+                const T* const sourcePtrChannel = sourcePtr + getChannelOffsetCuda<TLayout>(
+                    0, channel, sourceChannels, sourceArea);
+                const auto pixelStep = getPixelStepCuda<TLayout>(sourceChannels);
                 interpolated += bicubicInterpolate(
-                    sourcePtrChannel, xSource, ySource, widthSources[i], heightSources[i], widthSources[i]);
+                    sourcePtrChannel, xSource, ySource, widthSources[i], heightSources[i],
+                    widthSources[i] * pixelStep, pixelStep);
             }
             // Save into memory
             const auto targetArea = widthTarget * heightTarget;
-            targetPtr[channel * targetArea + y*widthTarget+x] = interpolated / T(counter);
+            storeCuda(targetPtr[channel * targetArea + y*widthTarget+x], interpolated / T(counter));
         }
     }
 
@@ -271,10 +560,13 @@ namespace op
     //     }
     // }
 
-    template <typename T>
-    void resizeAndMergeGpu(
-        T* targetPtr, const std::vector<const T*>& sourcePtrs, const std::array<int, 4>& targetSize,
-        const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<T>& scaleInputToNetInputs)
+    // TTarget = T or __half. The source (network output) and all the computations are in T
+    // TLayout = Memory layout of the source, the target is always NCHW
+    template <BlobLayout TLayout, typename TTarget, typename T>
+    void resizeAndMergeGpuTemplate(
+        TTarget* targetPtr, const std::vector<const T*>& sourcePtrs, const std::array<int, 4>& targetSize,
+        const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<T>& scaleInputToNetInputs,
+        CUstream_st* const cudaStream, const int sourceChannelsInput)
     {
         try
         {
@@ -297,6 +589,12 @@ namespace op
             const auto& sourceSize = sourceSizes[0];
             const auto heightSource = sourceSize[2];
             const auto widthSource = sourceSize[3];
+            // NCHW sources are contiguous [num*channels x height x width] blobs
+            const auto sourceChannels = (TLayout == BlobLayout::Nchw || sourceChannelsInput <= 0
+                ? channels : sourceChannelsInput);
+            if (sourceChannels < channels)
+                error("The number of source channels cannot be smaller than the number of target channels.",
+                      __LINE__, __FUNCTION__, __FILE__);
 
             // No multi-scale merging or no merging required
             if (sourceSizes.size() == 1)
@@ -342,10 +640,17 @@ namespace op
                     if (widthTarget / widthSource == 1 && heightTarget / heightSource == 1)
                     {
                         const auto N = widthTarget * heightTarget * num * channels;
-                        const dim3 threadsPerBlock{THREADS_PER_BLOCK};
-                        const dim3 numBlocks{getNumberCudaBlocks(N, threadsPerBlock.x)};
-                        fillKernel<<<numBlocks, threadsPerBlock>>>(
-                            targetPtr, sourcePtrs.at(0), N);
+                        const auto fill = [&](const dim3& threadsPerBlock)
+                        {
+                            const dim3 numBlocks{getNumberCudaBlocks(N, threadsPerBlock.x)};
+                            fillKernel<TLayout><<<numBlocks, threadsPerBlock, 0, cudaStream>>>(
+                                targetPtr, sourcePtrs.at(0), N, channels, sourceChannels, widthTarget * heightTarget);
+                        };
+                        dim3 threadsPerBlock{THREADS_PER_BLOCK};
+                        getCudaAutotunedBlock(
+                            threadsPerBlock, getAutotuneKernelName<TLayout, TTarget>("fillKernel"),
+                            std::to_string(N), CUDA_AUTOTUNE_BLOCKS_1D, fill, cudaStream);
+                        fill(threadsPerBlock);
                     }
                     else
                     {
@@ -358,9 +663,9 @@ namespace op
                             getNumberCudaBlocks(widthTarget, threadsPerBlock.x),
                             getNumberCudaBlocks(heightTarget, threadsPerBlock.y),
                             getNumberCudaBlocks(num * channels, threadsPerBlock.z)};
-                        resize8TimesKernel<<<numBlocks, threadsPerBlock>>>(
+                        resize8TimesKernel<TLayout><<<numBlocks, threadsPerBlock, 0, cudaStream>>>(
                             targetPtr, sourcePtrs.at(0), widthSource, heightSource, widthTarget, heightTarget,
-                            rescaleFactor);
+                            rescaleFactor, channels, sourceChannels);
                     }
                     // OP_CUDA_PROFILE_END(timeNormalize3, 1e3, REPS);
 
@@ -457,11 +762,6 @@ namespace op
                 if (sourcePtrs.size() > 8)
                     error("More than 8 scales are not implemented (yet). Notify us to implement it.",
                         __LINE__, __FUNCTION__, __FILE__);
-                const dim3 threadsPerBlock{THREADS_PER_BLOCK_1D, THREADS_PER_BLOCK_1D, 1};
-                const dim3 numBlocks{
-                    getNumberCudaBlocks(widthTarget, threadsPerBlock.x),
-                    getNumberCudaBlocks(heightTarget, threadsPerBlock.y),
-                    getNumberCudaBlocks(channels, threadsPerBlock.z)};
                 // Fill auxiliary params
                 std::vector<int> widthSourcesCpu(sourceSizes.size());
                 std::vector<int> heightSourcesCpu(sourceSizes.size());
@@ -477,40 +777,46 @@ namespace op
                     scaleHeightsCpu[i] = scaleToMainScaleHeight / scaleInputToNet;
                 }
                 // GPU params
-                int* widthSources;
-                cudaMalloc((void**)&widthSources, sizeof(int) * sourceSizes.size());
-                cudaMemcpy(
+                auto* widthSources = (int*)cudaPoolMalloc(sizeof(int) * sourceSizes.size(), cudaStream);
+                cudaMemcpyAsync(
                     widthSources, widthSourcesCpu.data(), sizeof(int) * sourceSizes.size(),
-                    cudaMemcpyHostToDevice);
-                int* heightSources;
-                cudaMalloc((void**)&heightSources, sizeof(int) * sourceSizes.size());
-                cudaMemcpy(
+                    cudaMemcpyHostToDevice, cudaStream);
+                auto* heightSources = (int*)cudaPoolMalloc(sizeof(int) * sourceSizes.size(), cudaStream);
+                cudaMemcpyAsync(
                     heightSources, heightSourcesCpu.data(), sizeof(int) * sourceSizes.size(),
-                    cudaMemcpyHostToDevice);
-                T* scaleWidths;
-                cudaMalloc((void**)&scaleWidths, sizeof(T) * sourceSizes.size());
-                cudaMemcpy(
+                    cudaMemcpyHostToDevice, cudaStream);
+                auto* scaleWidths = (T*)cudaPoolMalloc(sizeof(T) * sourceSizes.size(), cudaStream);
+                cudaMemcpyAsync(
                     scaleWidths, scaleWidthsCpu.data(), sizeof(T) * sourceSizes.size(),
-                    cudaMemcpyHostToDevice);
-                T* scaleHeights;
-                cudaMalloc((void**)&scaleHeights, sizeof(T) * sourceSizes.size());
-                cudaMemcpy(
+                    cudaMemcpyHostToDevice, cudaStream);
+                auto* scaleHeights = (T*)cudaPoolMalloc(sizeof(T) * sourceSizes.size(), cudaStream);
+                cudaMemcpyAsync(
                     scaleHeights, scaleHeightsCpu.data(), sizeof(T) * sourceSizes.size(),
-                    cudaMemcpyHostToDevice);
+                    cudaMemcpyHostToDevice, cudaStream);
                 // Resize each channel, add all, and get average
-                resizeAndAddAndAverageKernel<<<numBlocks, threadsPerBlock>>>(
-                    targetPtr, (int)sourceSizes.size(), scaleWidths, scaleHeights, widthSources, heightSources,
-                    widthTarget, heightTarget, sourcePtrs[0], sourcePtrs[1], sourcePtrs[2], sourcePtrs[3],
-                    sourcePtrs[4], sourcePtrs[5], sourcePtrs[6], sourcePtrs[7]);
-                // Free memory
-                if (widthSources != nullptr)
-                    cudaFree(widthSources);
-                if (heightSources != nullptr)
-                    cudaFree(heightSources);
-                if (scaleWidths != nullptr)
-                    cudaFree(scaleWidths);
-                if (scaleHeights != nullptr)
-                    cudaFree(scaleHeights);
+                const auto resizeAndAddAndAverage = [&](const dim3& threadsPerBlock)
+                {
+                    const dim3 numBlocks{
+                        getNumberCudaBlocks(widthTarget, threadsPerBlock.x),
+                        getNumberCudaBlocks(heightTarget, threadsPerBlock.y),
+                        getNumberCudaBlocks(channels, threadsPerBlock.z)};
+                    resizeAndAddAndAverageKernel<TLayout><<<numBlocks, threadsPerBlock, 0, cudaStream>>>(
+                        targetPtr, (int)sourceSizes.size(), scaleWidths, scaleHeights, widthSources, heightSources,
+                        widthTarget, heightTarget, sourceChannels, sourcePtrs[0], sourcePtrs[1], sourcePtrs[2],
+                        sourcePtrs[3], sourcePtrs[4], sourcePtrs[5], sourcePtrs[6], sourcePtrs[7]);
+                };
+                dim3 threadsPerBlock{THREADS_PER_BLOCK_1D, THREADS_PER_BLOCK_1D, 1};
+                getCudaAutotunedBlock(
+                    threadsPerBlock, getAutotuneKernelName<TLayout, TTarget>("resizeAndAddAndAverageKernel"),
+                    std::to_string(sourceSizes.size()) + "x" + std::to_string(channels) + "x"
+                        + std::to_string(heightTarget) + "x" + std::to_string(widthTarget),
+                    CUDA_AUTOTUNE_BLOCKS_2D, resizeAndAddAndAverage, cudaStream);
+                resizeAndAddAndAverage(threadsPerBlock);
+                // Free memory (no need to wait for the kernel, the pool only re-uses it once it has finished)
+                cudaPoolFree(widthSources, cudaStream);
+                cudaPoolFree(heightSources, cudaStream);
+                cudaPoolFree(scaleWidths, cudaStream);
+                cudaPoolFree(scaleHeights, cudaStream);
                 // OP_CUDA_PROFILE_END(timeNormalize3, 1e3, REPS);
 
                 // // Profiling code
@@ -527,6 +833,52 @@ namespace op
         }
     }
 
+    template <typename T>
+    void resizeAndMergeGpu(
+        T* targetPtr, const std::vector<const T*>& sourcePtrs, const std::array<int, 4>& targetSize,
+        const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<T>& scaleInputToNetInputs,
+        CUstream_st* const cudaStream, const BlobLayout sourceLayout, const int sourceChannels)
+    {
+        try
+        {
+            if (sourceLayout == BlobLayout::Nhwc)
+                resizeAndMergeGpuTemplate<BlobLayout::Nhwc>(
+                    targetPtr, sourcePtrs, targetSize, sourceSizes, scaleInputToNetInputs, cudaStream,
+                    sourceChannels);
+            else
+                resizeAndMergeGpuTemplate<BlobLayout::Nchw>(
+                    targetPtr, sourcePtrs, targetSize, sourceSizes, scaleInputToNetInputs, cudaStream,
+                    sourceChannels);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void resizeAndMergeGpu(
+        __half* targetPtr, const std::vector<const T*>& sourcePtrs, const std::array<int, 4>& targetSize,
+        const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<T>& scaleInputToNetInputs,
+        CUstream_st* const cudaStream, const BlobLayout sourceLayout, const int sourceChannels)
+    {
+        try
+        {
+            if (sourceLayout == BlobLayout::Nhwc)
+                resizeAndMergeGpuTemplate<BlobLayout::Nhwc>(
+                    targetPtr, sourcePtrs, targetSize, sourceSizes, scaleInputToNetInputs, cudaStream,
+                    sourceChannels);
+            else
+                resizeAndMergeGpuTemplate<BlobLayout::Nchw>(
+                    targetPtr, sourcePtrs, targetSize, sourceSizes, scaleInputToNetInputs, cudaStream,
+                    sourceChannels);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template <typename T>
     void resizeAndPadRbgGpu(
         T* targetPtr, const T* const srcPtr, const int widthSource, const int heightSource,
@@ -572,12 +924,196 @@ namespace op
         }
     }
 
+    template <typename T>
+    void resizeAndPadBgrGpu(
+        T* targetPtr, const unsigned char* const srcPtr, const int widthSource, const int heightSource,
+        const int widthTarget, const int heightTarget, const T scaleFactor, CUstream_st* const cudaStream)
+    {
+        try
+        {
+            const dim3 threadsPerBlock{THREADS_PER_BLOCK_1D, THREADS_PER_BLOCK_1D, 1};
+            const dim3 numBlocks{
+                getNumberCudaBlocks(widthTarget, threadsPerBlock.x),
+                getNumberCudaBlocks(heightTarget, threadsPerBlock.y), 1};
+            resizeAndPadBgrKernel<<<numBlocks, threadsPerBlock, 0, cudaStream>>>(
+                targetPtr, srcPtr, widthSource, heightSource, widthTarget, heightTarget, scaleFactor);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void resizeAndPadNv12Gpu(
+        T* targetPtr, const unsigned char* const nv12Ptr, const int widthSource, const int heightSource,
+        const int sourcePitch, const bool bt709, const bool fullRange, const int widthTarget, const int heightTarget,
+        const T scaleFactor, const int normalize, CUstream_st* const cudaStream, const float* const undistortMapPtr,
+        const int rotation, const bool flip)
+    {
+        try
+        {
+            // Sanity check
+            if (normalize < 0 || normalize > 2)
+                error("Unknown normalization value (" + std::to_string(normalize) + ").",
+                      __LINE__, __FUNCTION__, __FILE__);
+            const auto orientation = getOrientationMask(rotation, flip);
+            const dim3 threadsPerBlock{THREADS_PER_BLOCK_1D, THREADS_PER_BLOCK_1D, 1};
+            const dim3 numBlocks{
+                getNumberCudaBlocks(widthTarget, threadsPerBlock.x),
+                getNumberCudaBlocks(heightTarget, threadsPerBlock.y), 1};
+            resizeAndPadNv12Kernel<<<numBlocks, threadsPerBlock, 0, cudaStream>>>(
+                targetPtr, nv12Ptr, widthSource, heightSource, sourcePitch, bt709, fullRange, undistortMapPtr,
+                orientation, widthTarget, heightTarget, scaleFactor, normalize);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void resizeAndPadBayerGpu(
+        T* targetPtr, const unsigned char* const bayerPtr, const int widthSource, const int heightSource,
+        const int sourcePitch, const FrameGpuFormat bayerFormat, const int widthTarget, const int heightTarget,
+        const T scaleFactor, const int normalize, CUstream_st* const cudaStream, const float* const undistortMapPtr,
+        const int rotation, const bool flip)
+    {
+        try
+        {
+            // Sanity check
+            if (normalize < 0 || normalize > 2)
+                error("Unknown normalization value (" + std::to_string(normalize) + ").",
+                      __LINE__, __FUNCTION__, __FILE__);
+            const auto orientation = getOrientationMask(rotation, flip);
+            int redX, redY;
+            getBayerRedPixel(redX, redY, bayerFormat);
+            const dim3 threadsPerBlock{THREADS_PER_BLOCK_1D, THREADS_PER_BLOCK_1D, 1};
+            const dim3 numBlocks{
+                getNumberCudaBlocks(widthTarget, threadsPerBlock.x),
+                getNumberCudaBlocks(heightTarget, threadsPerBlock.y), 1};
+            resizeAndPadBayerKernel<<<numBlocks, threadsPerBlock, 0, cudaStream>>>(
+                targetPtr, bayerPtr, widthSource, heightSource, sourcePitch, redX, redY, undistortMapPtr, orientation,
+                widthTarget, heightTarget, scaleFactor, normalize);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void resizeAndPadBgrFrameGpu(
+        T* targetPtr, const unsigned char* const bgrPtr, const int widthSource, const int heightSource,
+        const int sourcePitch, const int widthTarget, const int heightTarget, const T scaleFactor,
+        const int normalize, CUstream_st* const cudaStream, const float* const undistortMapPtr, const int rotation,
+        const bool flip)
+    {
+        try
+        {
+            // Sanity check
+            if (normalize < 0 || normalize > 2)
+                error("Unknown normalization value (" + std::to_string(normalize) + ").",
+                      __LINE__, __FUNCTION__, __FILE__);
+            const auto orientation = getOrientationMask(rotation, flip);
+            const dim3 threadsPerBlock{THREADS_PER_BLOCK_1D, THREADS_PER_BLOCK_1D, 1};
+            const dim3 numBlocks{
+                getNumberCudaBlocks(widthTarget, threadsPerBlock.x),
+                getNumberCudaBlocks(heightTarget, threadsPerBlock.y), 1};
+            resizeAndPadBgrFrameKernel<<<numBlocks, threadsPerBlock, 0, cudaStream>>>(
+                targetPtr, bgrPtr, widthSource, heightSource, sourcePitch, undistortMapPtr, orientation,
+                widthTarget, heightTarget, scaleFactor, normalize);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void warpAffineCropsGpu(
+        T* targetPtr, const unsigned char* const srcPtr, const int widthSource, const int heightSource,
+        const std::vector<std::array<T, 6>>& affineMatrices, const int widthTarget, const int heightTarget,
+        const int normalize, CUstream_st* const cudaStream)
+    {
+        try
+        {
+            // Sanity check
+            if (normalize < 0 || normalize > 2)
+                error("Unknown normalization value (" + std::to_string(normalize) + ").",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (affineMatrices.empty())
+                return;
+            // Affine matrices to GPU (the pool keeps them valid until the kernel finishes)
+            const auto matricesBytes = affineMatrices.size() * 6 * sizeof(T);
+            auto* affineMatricesGpuPtr = (T*)cudaPoolMalloc(matricesBytes, cudaStream);
+            cudaMemcpyAsync(affineMatricesGpuPtr, affineMatrices.data(), matricesBytes, cudaMemcpyHostToDevice,
+                            cudaStream);
+            // One grid slice per crop
+            const dim3 threadsPerBlock{THREADS_PER_BLOCK_1D, THREADS_PER_BLOCK_1D, 1};
+            const dim3 numBlocks{
+                getNumberCudaBlocks(widthTarget, threadsPerBlock.x),
+                getNumberCudaBlocks(heightTarget, threadsPerBlock.y),
+                (unsigned int)affineMatrices.size()};
+            warpAffineCropsKernel<<<numBlocks, threadsPerBlock, 0, cudaStream>>>(
+                targetPtr, srcPtr, widthSource, heightSource, affineMatricesGpuPtr, widthTarget, heightTarget,
+                normalize);
+            cudaPoolFree(affineMatricesGpuPtr, cudaStream);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void warpAffineCropsGpu(
+        T* targetPtr, const T* const srcPtr, const int widthSource, const int heightSource,
+        const std::vector<std::array<T, 6>>& affineMatrices, const int widthTarget, const int heightTarget,
+        const std::array<T, 3>& borderValues, CUstream_st* const cudaStream)
+    {
+        try
+        {
+            if (affineMatrices.empty())
+                return;
+            // Affine matrices to GPU (the pool keeps them valid until the kernel finishes)
+            const auto matricesBytes = affineMatrices.size() * 6 * sizeof(T);
+            auto* affineMatricesGpuPtr = (T*)cudaPoolMalloc(matricesBytes, cudaStream);
+            cudaMemcpyAsync(affineMatricesGpuPtr, affineMatrices.data(), matricesBytes, cudaMemcpyHostToDevice,
+                            cudaStream);
+            // One grid slice per crop
+            const dim3 threadsPerBlock{THREADS_PER_BLOCK_1D, THREADS_PER_BLOCK_1D, 1};
+            const dim3 numBlocks{
+                getNumberCudaBlocks(widthTarget, threadsPerBlock.x),
+                getNumberCudaBlocks(heightTarget, threadsPerBlock.y),
+                (unsigned int)affineMatrices.size()};
+            warpAffineCropsPlanarKernel<<<numBlocks, threadsPerBlock, 0, cudaStream>>>(
+                targetPtr, srcPtr, widthSource, heightSource, affineMatricesGpuPtr, widthTarget, heightTarget,
+                borderValues[0], borderValues[1], borderValues[2]);
+            cudaPoolFree(affineMatricesGpuPtr, cudaStream);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template void resizeAndMergeGpu(
         float* targetPtr, const std::vector<const float*>& sourcePtrs, const std::array<int, 4>& targetSize,
-        const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<float>& scaleInputToNetInputs);
+        const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<float>& scaleInputToNetInputs,
+        CUstream_st* const cudaStream, const BlobLayout sourceLayout, const int sourceChannels);
     template void resizeAndMergeGpu(
         double* targetPtr, const std::vector<const double*>& sourcePtrs, const std::array<int, 4>& targetSize,
-        const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<double>& scaleInputToNetInputs);
+        const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<double>& scaleInputToNetInputs,
+        CUstream_st* const cudaStream, const BlobLayout sourceLayout, const int sourceChannels);
+    template void resizeAndMergeGpu(
+        __half* targetPtr, const std::vector<const float*>& sourcePtrs, const std::array<int, 4>& targetSize,
+        const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<float>& scaleInputToNetInputs,
+        CUstream_st* const cudaStream, const BlobLayout sourceLayout, const int sourceChannels);
+    template void resizeAndMergeGpu(
+        __half* targetPtr, const std::vector<const double*>& sourcePtrs, const std::array<int, 4>& targetSize,
+        const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<double>& scaleInputToNetInputs,
+        CUstream_st* const cudaStream, const BlobLayout sourceLayout, const int sourceChannels);
 
     template void resizeAndPadRbgGpu(
         float* targetPtr, const float* const srcPtr, const int widthSource, const int heightSource,
@@ -592,4 +1128,62 @@ namespace op
     template void resizeAndPadRbgGpu(
         double* targetPtr, const unsigned char* const srcPtr, const int widthSource, const int heightSource,
         const int widthTarget, const int heightTarget, const double scaleFactor);
+
+    template void resizeAndPadBgrGpu(
+        float* targetPtr, const unsigned char* const srcPtr, const int widthSource, const int heightSource,
+        const int widthTarget, const int heightTarget, const float scaleFactor, CUstream_st* const cudaStream);
+    template void resizeAndPadBgrGpu(
+        double* targetPtr, const unsigned char* const srcPtr, const int widthSource, const int heightSource,
+        const int widthTarget, const int heightTarget, const double scaleFactor, CUstream_st* const cudaStream);
+
+    template void resizeAndPadNv12Gpu(
+        float* targetPtr, const unsigned char* const nv12Ptr, const int widthSource, const int heightSource,
+        const int sourcePitch, const bool bt709, const bool fullRange, const int widthTarget, const int heightTarget,
+        const float scaleFactor, const int normalize, CUstream_st* const cudaStream,
+        const float* const undistortMapPtr, const int rotation, const bool flip);
+    template void resizeAndPadNv12Gpu(
+        double* targetPtr, const unsigned char* const nv12Ptr, const int widthSource, const int heightSource,
+        const int sourcePitch, const bool bt709, const bool fullRange, const int widthTarget, const int heightTarget,
+        const double scaleFactor, const int normalize, CUstream_st* const cudaStream,
+        const float* const undistortMapPtr, const int rotation, const bool flip);
+
+    template void resizeAndPadBayerGpu(
+        float* targetPtr, const unsigned char* const bayerPtr, const int widthSource, const int heightSource,
+        const int sourcePitch, const FrameGpuFormat bayerFormat, const int widthTarget, const int heightTarget,
+        const float scaleFactor, const int normalize, CUstream_st* const cudaStream,
+        const float* const undistortMapPtr, const int rotation, const bool flip);
+    template void resizeAndPadBayerGpu(
+        double* targetPtr, const unsigned char* const bayerPtr, const int widthSource, const int heightSource,
+        const int sourcePitch, const FrameGpuFormat bayerFormat, const int widthTarget, const int heightTarget,
+        const double scaleFactor, const int normalize, CUstream_st* const cudaStream,
+        const float* const undistortMapPtr, const int rotation, const bool flip);
+
+    template void resizeAndPadBgrFrameGpu(
+        float* targetPtr, const unsigned char* const bgrPtr, const int widthSource, const int heightSource,
+        const int sourcePitch, const int widthTarget, const int heightTarget, const float scaleFactor,
+        const int normalize, CUstream_st* const cudaStream, const float* const undistortMapPtr, const int rotation,
+        const bool flip);
+    template void resizeAndPadBgrFrameGpu(
+        double* targetPtr, const unsigned char* const bgrPtr, const int widthSource, const int heightSource,
+        const int sourcePitch, const int widthTarget, const int heightTarget, const double scaleFactor,
+        const int normalize, CUstream_st* const cudaStream, const float* const undistortMapPtr, const int rotation,
+        const bool flip);
+
+    template void warpAffineCropsGpu(
+        float* targetPtr, const unsigned char* const srcPtr, const int widthSource, const int heightSource,
+        const std::vector<std::array<float, 6>>& affineMatrices, const int widthTarget, const int heightTarget,
+        const int normalize, CUstream_st* const cudaStream);
+    template void warpAffineCropsGpu(
+        double* targetPtr, const unsigned char* const srcPtr, const int widthSource, const int heightSource,
+        const std::vector<std::array<double, 6>>& affineMatrices, const int widthTarget, const int heightTarget,
+        const int normalize, CUstream_st* const cudaStream);
+
+    template void warpAffineCropsGpu(
+        float* targetPtr, const float* const srcPtr, const int widthSource, const int heightSource,
+        const std::vector<std::array<float, 6>>& affineMatrices, const int widthTarget, const int heightTarget,
+        const std::array<float, 3>& borderValues, CUstream_st* const cudaStream);
+    template void warpAffineCropsGpu(
+        double* targetPtr, const double* const srcPtr, const int widthSource, const int heightSource,
+        const std::vector<std::array<double, 6>>& affineMatrices, const int widthTarget, const int heightTarget,
+        const std::array<double, 3>& borderValues, CUstream_st* const cudaStream);
 }
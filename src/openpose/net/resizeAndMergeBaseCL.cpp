@@ -99,15 +99,21 @@ namespace op
             }
         );
 
-        typedef cl::KernelFunctor<cl::Buffer, cl::Buffer, int, int, int, int, int, int> ResizeAndMergeFunctor;
+        // All the channels in a single enqueue (z = channel), targetOffset being the first element of channel 0
+        typedef cl::KernelFunctor<cl::Buffer, cl::Buffer, int, int, int, int, int, int, int> ResizeAndMergeFunctor;
         const std::string resizeAndMergeKernel = MULTI_LINE_STRING(
-            __kernel void resizeAndMergeKernel(__global Type* targetPtr, __global const Type* sourcePtr,
+            __kernel void resizeAndMergeKernel(__global Type* targetFullPtr, __global const Type* sourceFullPtr,
                                                const int sourceWidth, const int sourceHeight,
                                                const int targetWidth, const int targetHeight,
-                                               const int widthPadding, const int heightPadding)
+                                               const int widthPadding, const int heightPadding,
+                                               const int targetOffset)
             {
                 int x = get_global_id(0);
                 int y = get_global_id(1);
+                int c = get_global_id(2);
+
+                __global Type* targetPtr = &targetFullPtr[targetOffset + c*targetWidth*targetHeight];
+                __global const Type* sourcePtr = &sourceFullPtr[c*sourceWidth*sourceHeight];
 
                 if (x < targetWidth && y < targetHeight)
                 {
@@ -119,9 +125,10 @@ namespace op
             }
         );
 
+        // All the channels in a single enqueue (z = channel)
         typedef cl::KernelFunctor<cl::Buffer, cl::Buffer, float, float, int, int, int, int, int, int> ResizeAndAddFunctor;
         const std::string resizeAndAddKernel = MULTI_LINE_STRING(
-            __kernel void resizeAndAddKernel(__global Type* targetPtr, __global const Type* sourcePtr,
+            __kernel void resizeAndAddKernel(__global Type* targetFullPtr, __global const Type* sourceFullPtr,
                                                const Type scaleWidth, const Type scaleHeight,
                                                const int sourceWidth, const int sourceHeight,
                                                const int targetWidth, const int targetHeight,
@@ -129,6 +136,10 @@ namespace op
             {
                 int x = get_global_id(0);
                 int y = get_global_id(1);
+                int c = get_global_id(2);
+
+                __global Type* targetPtr = &targetFullPtr[c*targetWidth*targetHeight];
+                __global const Type* sourcePtr = &sourceFullPtr[c*sourceWidth*sourceHeight];
 
                 if (x < targetWidth && y < targetHeight)
                 {
@@ -140,9 +151,10 @@ namespace op
             }
         );
 
+        // All the channels in a single enqueue (z = channel)
         typedef cl::KernelFunctor<cl::Buffer, cl::Buffer, float, float, int, int, int, int, int, int, int> ResizeAndAverageFunctor;
         const std::string resizeAndAverageKernel = MULTI_LINE_STRING(
-            __kernel void resizeAndAverageKernel(__global Type* targetPtr, __global const Type* sourcePtr,
+            __kernel void resizeAndAverageKernel(__global Type* targetFullPtr, __global const Type* sourceFullPtr,
                                                const Type scaleWidth, const Type scaleHeight,
                                                const int sourceWidth, const int sourceHeight,
                                                const int targetWidth, const int targetHeight,
@@ -151,6 +163,10 @@ namespace op
             {
                 int x = get_global_id(0);
                 int y = get_global_id(1);
+                int c = get_global_id(2);
+
+                __global Type* targetPtr = &targetFullPtr[c*targetWidth*targetHeight];
+                __global const Type* sourcePtr = &sourceFullPtr[c*sourceWidth*sourceHeight];
 
                 if (x < targetWidth && y < targetHeight)
                 {
@@ -176,18 +192,20 @@ namespace op
             }
         );
 
-        typedef cl::KernelFunctor<cl::Buffer, cl::Buffer, int, int, int, int> CopyBufferFunctor;
+        // sourceOffset: First element of channel 0 (e.g., of the n-th image of the batch)
+        typedef cl::KernelFunctor<cl::Buffer, cl::Buffer, int, int, int, int, int> CopyBufferFunctor;
         const std::string copyBufferKernel = MULTI_LINE_STRING(
             __kernel void copyBufferKernel(__global Type* targetPtr, __global const Type* sourcePtr,
                                            const int sourceWidth, const int sourceHeight,
-                                           const int targetWidth, const int targetHeight)
+                                           const int targetWidth, const int targetHeight,
+                                           const int sourceOffset)
             {
                 int x = get_global_id(0);
                 int y = get_global_id(1);
                 int c = get_global_id(2);
 
                 __global Type* targetPtrC = &targetPtr[c*targetWidth*targetHeight];
-                __global const Type* sourcePtrC = &sourcePtr[c*sourceWidth*sourceHeight];
+                __global const Type* sourcePtrC = &sourcePtr[sourceOffset + c*sourceWidth*sourceHeight];
 
                 if(x < sourceWidth && y < sourceHeight)
                     targetPtrC[y*targetWidth+x] = sourcePtrC[y*sourceWidth+x];
@@ -250,6 +268,8 @@ namespace op
                         <op::CopyBufferFunctor, T>(
                             "copyBufferKernel",op::copyBufferKernel);
 
+                auto& queue = OpenCL::getInstance(gpuID)->getPostProcessingQueueAfterNetwork();
+
                 // Parameters
                 const auto channels = targetSize[1];
                 const auto targetHeight = targetSize[2];
@@ -269,7 +289,6 @@ namespace op
                         const auto sourceChannelOffset = sourceHeight * sourceWidth;
                         const auto sourceWidthIdeal = roundUps(sourceWidth, 16);
                         const auto sourceHeightIdeal = roundUps(sourceHeight, 16);
-                        const auto sourceChannelOffsetIdeal = sourceHeightIdeal * sourceWidthIdeal;
                         const auto targetChannelOffset = targetWidth * targetHeight;
                         for (auto n = 0; n < num; n++)
                         {
@@ -283,30 +302,20 @@ namespace op
                             cl::Buffer sourcePtrBufferIdeal = cl::Buffer((cl_mem)(sourceTempPtrs[0]), true);
 
                             // Copy to Buffer
-                            copyBufferKernel(cl::EnqueueArgs(op::OpenCL::getInstance(gpuID)->getQueue(),
+                            const auto offsetBase = n*channels;
+                            copyBufferKernel(cl::EnqueueArgs(queue,
                                                  cl::NDRange(sourceWidthIdeal, sourceHeightIdeal, channels)),
                                                  sourcePtrBufferIdeal, sourcePtrBuffer,
-                                                 sourceWidth, sourceHeight, sourceWidthIdeal, sourceHeightIdeal);
-
-                            const auto offsetBase = n*channels;
-                            for (auto c = 0 ; c < channels ; c++)
-                            {
-                                const auto offset = offsetBase + c;
-                                cl_buffer_region targerRegion, sourceRegion;
-                                OpenCL::getBufferRegion<T>(
-                                    targerRegion, offset * targetChannelOffset, targetChannelOffset);
-                                cl::Buffer targetBuffer = targetPtrBuffer.createSubBuffer(
-                                    CL_MEM_READ_WRITE, CL_BUFFER_CREATE_TYPE_REGION, &targerRegion);
-                                op::OpenCL::getBufferRegion<T>(
-                                    sourceRegion, offset * sourceChannelOffsetIdeal, sourceChannelOffsetIdeal);
-                                cl::Buffer sourceBuffer = sourcePtrBufferIdeal.createSubBuffer(
-                                    CL_MEM_READ_ONLY, CL_BUFFER_CREATE_TYPE_REGION, &sourceRegion);
-                                resizeAndMergeKernel(cl::EnqueueArgs(op::OpenCL::getInstance(gpuID)->getQueue(),
-                                                     cl::NDRange(targetWidth, targetHeight)),
-                                                     targetBuffer, sourceBuffer,
-                                                     sourceWidthIdeal, sourceHeightIdeal, targetWidth, targetHeight,
-                                                     (sourceWidthIdeal-sourceWidth), (sourceHeightIdeal-sourceHeight));
-                            }
+                                                 sourceWidth, sourceHeight, sourceWidthIdeal, sourceHeightIdeal,
+                                                 offsetBase * sourceChannelOffset);
+
+                            // All the channels at once (rather than 1 sub-buffer pair and kernel per channel)
+                            resizeAndMergeKernel(cl::EnqueueArgs(queue,
+                                                 cl::NDRange(targetWidth, targetHeight, channels)),
+                                                 targetPtrBuffer, sourcePtrBufferIdeal,
+                                                 sourceWidthIdeal, sourceHeightIdeal, targetWidth, targetHeight,
+                                                 (sourceWidthIdeal-sourceWidth), (sourceHeightIdeal-sourceHeight),
+                                                 offsetBase * targetChannelOffset);
                         }
                     }
                     // Old inefficient multi-scale merging
@@ -317,9 +326,8 @@ namespace op
                 // Multi-scaling merging
                 else
                 {
-                    const auto targetChannelOffset = targetWidth * targetHeight;
                     //cudaMemset(targetPtr, 0.f, channels*targetChannelOffset * sizeof(T));
-                    zeroBufferKernel(cl::EnqueueArgs(OpenCL::getInstance(gpuID)->getQueue(),
+                    zeroBufferKernel(cl::EnqueueArgs(queue,
                                                      cl::NDRange(targetWidth, targetHeight, channels)),
                                                      targetPtrBuffer, targetWidth, targetHeight);
                     const auto scaleToMainScaleWidth = targetWidth / T(sourceWidth);
@@ -330,7 +338,6 @@ namespace op
                         const auto& currentSize = sourceSizes.at(i);
                         const auto currentHeight = currentSize[2];
                         const auto currentWidth = currentSize[3];
-                        const auto sourceChannelOffset = currentHeight * currentWidth;
                         const auto scaleInputToNet = scaleInputToNetInputs[i] / scaleInputToNetInputs[0];
                         const auto scaleWidth = scaleToMainScaleWidth / scaleInputToNet;
                         const auto scaleHeight = scaleToMainScaleHeight / scaleInputToNet;
@@ -338,7 +345,6 @@ namespace op
 
                         const auto currentHeightIdeal = roundUps(currentHeight, 16);
                         const auto currentWidthIdeal = roundUps(currentWidth, 16);
-                        const auto sourceChannelOffsetIdeal = currentHeightIdeal * currentWidthIdeal;
 
                         // Allocate memory on GPU once
                         if(sourceTempPtrs[i] == nullptr){
@@ -350,55 +356,30 @@ namespace op
                         cl::Buffer sourcePtrBufferIdeal = cl::Buffer((cl_mem)(sourceTempPtrs[i]), true);
 
                         // Copy to Buffer
-                        copyBufferKernel(cl::EnqueueArgs(op::OpenCL::getInstance(gpuID)->getQueue(),
+                        copyBufferKernel(cl::EnqueueArgs(queue,
                                              cl::NDRange(currentWidthIdeal, currentHeightIdeal, channels)),
                                              sourcePtrBufferIdeal, sourcePtrBuffer,
-                                             currentWidth, currentHeight, currentWidthIdeal, currentHeightIdeal);
+                                             currentWidth, currentHeight, currentWidthIdeal, currentHeightIdeal, 0);
 
+                        // All the channels at once (rather than 1 sub-buffer pair and kernel per channel)
                         // All but last image --> add
                         if (i < sourceSizes.size() - 1)
-                        {
-                            for (auto c = 0 ; c < channels ; c++)
-                            {
-                                cl_buffer_region targerRegion, sourceRegion;
-                                op::OpenCL::getBufferRegion<T>(
-                                    targerRegion, c * targetChannelOffset, targetChannelOffset);
-                                op::OpenCL::getBufferRegion<T>(
-                                    sourceRegion, c * sourceChannelOffsetIdeal, sourceChannelOffsetIdeal);
-                                cl::Buffer targetBuffer = targetPtrBuffer.createSubBuffer(
-                                    CL_MEM_READ_WRITE, CL_BUFFER_CREATE_TYPE_REGION, &targerRegion);
-                                cl::Buffer sourceBuffer = sourcePtrBufferIdeal.createSubBuffer(
-                                    CL_MEM_READ_WRITE, CL_BUFFER_CREATE_TYPE_REGION, &sourceRegion);
-                                resizeAndAddKernel(cl::EnqueueArgs(
-                                    OpenCL::getInstance(gpuID)->getQueue(), cl::NDRange(targetWidth, targetHeight)),
-                                    targetBuffer, sourceBuffer, scaleWidth, scaleHeight, currentWidthIdeal,
-                                    currentHeightIdeal, targetWidth, targetHeight, (currentWidthIdeal-currentWidth),
-                                    (currentHeightIdeal-currentHeight));
-                            }
-                        }
+                            resizeAndAddKernel(cl::EnqueueArgs(
+                                queue, cl::NDRange(targetWidth, targetHeight, channels)),
+                                targetPtrBuffer, sourcePtrBufferIdeal, scaleWidth, scaleHeight, currentWidthIdeal,
+                                currentHeightIdeal, targetWidth, targetHeight, (currentWidthIdeal-currentWidth),
+                                (currentHeightIdeal-currentHeight));
                         // Last image --> average all
                         else
-                        {
-                            for (auto c = 0 ; c < channels ; c++)
-                            {
-                                cl_buffer_region targerRegion, sourceRegion;
-                                op::OpenCL::getBufferRegion<T>(
-                                    targerRegion, c * targetChannelOffset, targetChannelOffset);
-                                op::OpenCL::getBufferRegion<T>(
-                                    sourceRegion, c * sourceChannelOffsetIdeal, sourceChannelOffsetIdeal);
-                                cl::Buffer targetBuffer = targetPtrBuffer.createSubBuffer(
-                                    CL_MEM_READ_WRITE, CL_BUFFER_CREATE_TYPE_REGION, &targerRegion);
-                                cl::Buffer sourceBuffer = sourcePtrBufferIdeal.createSubBuffer(
-                                    CL_MEM_READ_WRITE, CL_BUFFER_CREATE_TYPE_REGION, &sourceRegion);
-                                resizeAndAverageKernel(cl::EnqueueArgs(
-                                    OpenCL::getInstance(gpuID)->getQueue(), cl::NDRange(targetWidth, targetHeight)),
-                                    targetBuffer, sourceBuffer, scaleWidth, scaleHeight, currentWidthIdeal,
-                                    currentHeightIdeal, targetWidth, targetHeight, (currentWidthIdeal-currentWidth),
-                                    (currentHeightIdeal-currentHeight), (int)sourceSizes.size());
-                            }
-                        }
+                            resizeAndAverageKernel(cl::EnqueueArgs(
+                                queue, cl::NDRange(targetWidth, targetHeight, channels)),
+                                targetPtrBuffer, sourcePtrBufferIdeal, scaleWidth, scaleHeight, currentWidthIdeal,
+                                currentHeightIdeal, targetWidth, targetHeight, (currentWidthIdeal-currentWidth),
+                                (currentHeightIdeal-currentHeight), (int)sourceSizes.size());
                     }
                 }
+                // The network queue (e.g., next frame) cannot overwrite the source until it is resized
+                OpenCL::enqueueWait(OpenCL::getInstance(gpuID)->getQueue(), queue);
             #else
                 UNUSED(targetPtr);
                 UNUSED(sourcePtrs);
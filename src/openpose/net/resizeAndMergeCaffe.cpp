@@ -2,7 +2,13 @@
 #ifdef USE_CAFFE
     #include <caffe/blob.hpp>
 #endif
+#ifdef USE_CUDA
+    #include <cuda_fp16.h>
+#endif
+#include <openpose/gpu/cudaGraph.hpp>
+#include <openpose/gpu/cudaMemoryPool.hpp>
 #include <openpose/net/resizeAndMergeBase.hpp>
+#include <openpose/utilities/tracer.hpp>
 #ifdef USE_OPENCL
     #include <openpose_private/gpu/opencl.hcl>
     #include <openpose_private/gpu/cl2.hpp>
@@ -12,7 +18,12 @@ namespace op
 {
     template <typename T>
     ResizeAndMergeCaffe<T>::ResizeAndMergeCaffe() :
-        mScaleRatios{T(1)}
+        mScaleRatios{T(1)},
+        pCudaStream{nullptr},
+        pTargetHalfGpuPtr{nullptr},
+        mFirstChannel{0},
+        mNumberChannels{-1},
+        mBottomLayout{BlobLayout::Nchw}
     {
         try
         {
@@ -61,6 +72,7 @@ namespace op
     {
         try
         {
+            const CudaMemoryOwner cudaMemoryOwner{"ResizeAndMergeCaffe"};
             #ifdef USE_CAFFE
                 // Sanity checks
                 if (top.size() != 1)
@@ -122,12 +134,82 @@ namespace op
         }
     }
 
+    template <typename T>
+    void ResizeAndMergeCaffe<T>::setCudaStream(CUstream_st* cudaStream)
+    {
+        try
+        {
+            pCudaStream = cudaStream;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void ResizeAndMergeCaffe<T>::setHalfPrecisionTarget(__half* targetHalfGpuPtr)
+    {
+        try
+        {
+            pTargetHalfGpuPtr = targetHalfGpuPtr;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void ResizeAndMergeCaffe<T>::setChannelRange(const int firstChannel, const int numberChannels)
+    {
+        try
+        {
+            mFirstChannel = firstChannel;
+            mNumberChannels = numberChannels;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void ResizeAndMergeCaffe<T>::setBottomLayout(const BlobLayout bottomLayout)
+    {
+        try
+        {
+            mBottomLayout = bottomLayout;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void ResizeAndMergeCaffe<T>::setCudaGraphs(const bool cudaGraphs)
+    {
+        try
+        {
+            if (!cudaGraphs)
+                spCudaGraphCache.reset();
+            else if (spCudaGraphCache == nullptr)
+                spCudaGraphCache = std::make_shared<CudaGraphCache>();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template <typename T>
     void ResizeAndMergeCaffe<T>::Forward(const std::vector<ArrayCpuGpu<T>*>& bottom,
                                          const std::vector<ArrayCpuGpu<T>*>& top)
     {
         try
         {
+            const CudaMemoryOwner cudaMemoryOwner{"ResizeAndMergeCaffe"};
             // CUDA
             #ifdef USE_CUDA
                 Forward_gpu(bottom, top);
@@ -152,6 +234,8 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
+                if (mBottomLayout != BlobLayout::Nchw)
+                    error("The CPU resize only supports NCHW bottoms.", __LINE__, __FUNCTION__, __FILE__);
                 std::vector<const T*> sourcePtrs(bottom.size());
                 for (auto i = 0u ; i < sourcePtrs.size() ; i++)
                     sourcePtrs[i] = bottom[i]->cpu_data();
@@ -175,11 +259,64 @@ namespace op
         try
         {
             #if defined USE_CAFFE && defined USE_CUDA
+                // Channel range
+                auto topSize = mTopSize;
+                auto bottomSizes = mBottomSizes;
+                topSize[1] = (mNumberChannels < 0 ? mTopSize[1] - mFirstChannel : mNumberChannels);
+                if (mFirstChannel < 0 || mFirstChannel + topSize[1] > mTopSize[1])
+                    error("Invalid channel range.", __LINE__, __FUNCTION__, __FILE__);
+                if (topSize[1] != mTopSize[1])
+                {
+                    if (mTopSize[0] != 1)
+                        error("Channel ranges are only implemented for a single image.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    for (auto& bottomSize : bottomSizes)
+                    {
+                        if (bottomSize[0] != 1)
+                            error("Channel ranges are only implemented for a single image.",
+                                  __LINE__, __FUNCTION__, __FILE__);
+                        bottomSize[1] = topSize[1];
+                    }
+                }
+                // Channel-last bottoms: The channel range starts at the first channel of the first pixel, and the
+                // pixels keep all the bottom channels
                 std::vector<const T*> sourcePtrs(bottom.size());
                 for (auto i = 0u ; i < sourcePtrs.size() ; i++)
-                    sourcePtrs[i] = bottom[i]->gpu_data();
-                resizeAndMergeGpu(top.at(0)->mutable_gpu_data(), sourcePtrs, mTopSize, mBottomSizes,
-                                  mScaleRatios);
+                    sourcePtrs[i] = bottom[i]->gpu_data() + mFirstChannel
+                        * (mBottomLayout == BlobLayout::Nhwc ? 1 : mBottomSizes[i][2] * mBottomSizes[i][3]);
+                const auto sourceChannels = mBottomSizes[0][1];
+                const auto targetOffset = mFirstChannel * mTopSize[2] * mTopSize[3];
+                const TraceRange traceRange{"resizeAndMergeGpu"};
+                // Blob pointers retrieved before any CUDA Graph capture (Caffe might allocate or copy them)
+                auto* const targetPtr = (pTargetHalfGpuPtr != nullptr
+                    ? nullptr : top.at(0)->mutable_gpu_data() + targetOffset);
+                const auto resizeAndMerge = [&]()
+                {
+                    if (pTargetHalfGpuPtr != nullptr)
+                        resizeAndMergeGpu(pTargetHalfGpuPtr + targetOffset, sourcePtrs, topSize, bottomSizes,
+                                          mScaleRatios, pCudaStream, mBottomLayout, sourceChannels);
+                    else
+                        resizeAndMergeGpu(targetPtr, sourcePtrs, topSize, bottomSizes, mScaleRatios, pCudaStream,
+                                          mBottomLayout, sourceChannels);
+                };
+                // Multi-scale merging uploads its parameters from host memory, so it is not captured
+                if (spCudaGraphCache != nullptr && sourcePtrs.size() == 1)
+                {
+                    std::vector<unsigned long long> key;
+                    cudaGraphKeyAppend(key, sourcePtrs[0]);
+                    cudaGraphKeyAppend(key, targetPtr);
+                    cudaGraphKeyAppend(
+                        key, (pTargetHalfGpuPtr != nullptr ? pTargetHalfGpuPtr + targetOffset : nullptr));
+                    for (auto i = 0u ; i < 4u ; i++)
+                    {
+                        cudaGraphKeyAppend(key, topSize[i]);
+                        cudaGraphKeyAppend(key, bottomSizes[0][i]);
+                    }
+                    cudaGraphKeyAppend(key, (int)mBottomLayout);
+                    spCudaGraphCache->run(key, pCudaStream, resizeAndMerge);
+                }
+                else
+                    resizeAndMerge();
             #else
                 UNUSED(bottom);
                 UNUSED(top);
@@ -200,6 +337,8 @@ namespace op
         try
         {
             #if defined USE_CAFFE && defined USE_OPENCL
+                if (mBottomLayout != BlobLayout::Nchw)
+                    error("The OpenCL resize only supports NCHW bottoms.", __LINE__, __FUNCTION__, __FILE__);
                 std::vector<const T*> sourcePtrs(bottom.size());
                 for (auto i = 0u ; i < sourcePtrs.size() ; i++)
                     sourcePtrs[i] = bottom[i]->gpu_data();
@@ -0,0 +1,112 @@
+#include <openpose/net/tileStitchBase.hpp>
+#include <openpose/gpu/cuda.hpp>
+
+namespace op
+{
+    const auto THREADS_PER_BLOCK_1D = 16u;
+
+    template <typename T>
+    inline __device__ T getTileWeight(
+        const int position, const int tile, const int* const origins, const int numberTiles, const int tileSize)
+    {
+        const auto localPosition = position - origins[tile];
+        if (localPosition < 0 || localPosition >= tileSize)
+            return T(0);
+        auto weight = T(1);
+        // Linear ramp over the overlap with the previous and following tiles (their weights add up to 1)
+        if (tile > 0)
+        {
+            const auto overlap = origins[tile-1] + tileSize - origins[tile];
+            if (localPosition < overlap)
+                weight *= (localPosition + T(0.5)) / overlap;
+        }
+        if (tile < numberTiles-1)
+        {
+            const auto overlap = origins[tile] + tileSize - origins[tile+1];
+            if (tileSize - localPosition <= overlap)
+                weight *= (tileSize - localPosition - T(0.5)) / overlap;
+        }
+        return weight;
+    }
+
+    template <typename T>
+    __global__ void tileStitchKernel(
+        T* targetPtr, const T* const sourcePtr, const TileGrid tileGrid, const int targetWidth,
+        const int targetHeight)
+    {
+        // 1 thread per pixel, 1 z-block per channel
+        const auto x = (int)((blockIdx.x * blockDim.x) + threadIdx.x);
+        const auto y = (int)((blockIdx.y * blockDim.y) + threadIdx.y);
+        const auto c = (int)blockIdx.z;
+        const auto channels = (int)gridDim.z;
+        if (x < targetWidth && y < targetHeight)
+        {
+            auto value = T(0);
+            auto weightSum = T(0);
+            for (auto tileY = 0 ; tileY < tileGrid.numberY ; tileY++)
+            {
+                const auto weightY = getTileWeight<T>(
+                    y, tileY, tileGrid.originsY, tileGrid.numberY, tileGrid.tileHeight);
+                if (weightY > 0)
+                {
+                    for (auto tileX = 0 ; tileX < tileGrid.numberX ; tileX++)
+                    {
+                        const auto weight = weightY * getTileWeight<T>(
+                            x, tileX, tileGrid.originsX, tileGrid.numberX, tileGrid.tileWidth);
+                        if (weight > 0)
+                        {
+                            const auto tile = tileY * tileGrid.numberX + tileX;
+                            value += weight * sourcePtr[
+                                ((tile * channels + c) * tileGrid.tileHeight + y - tileGrid.originsY[tileY])
+                                * tileGrid.tileWidth + x - tileGrid.originsX[tileX]];
+                            weightSum += weight;
+                        }
+                    }
+                }
+            }
+            targetPtr[(c * targetHeight + y) * targetWidth + x] = (weightSum > 0 ? value / weightSum : T(0));
+        }
+    }
+
+    template <typename T>
+    void tileStitchGpu(
+        T* targetPtr, const T* const sourcePtr, const std::array<int, 4>& targetSize,
+        const std::array<int, 4>& sourceSize, const TileGrid& tileGrid)
+    {
+        try
+        {
+            const auto channels = targetSize[1];
+            const auto targetHeight = targetSize[2];
+            const auto targetWidth = targetSize[3];
+            // Sanity checks
+            if (sourceSize[0] != tileGrid.numberX * tileGrid.numberY || sourceSize[1] != channels
+                || sourceSize[2] != tileGrid.tileHeight || sourceSize[3] != tileGrid.tileWidth)
+                error("The source size does not match the tile grid.", __LINE__, __FUNCTION__, __FILE__);
+            if (targetSize[0] != 1)
+                error("The target must have a single image.", __LINE__, __FUNCTION__, __FILE__);
+            // All the channels with a single kernel (the grid is passed by value as a kernel parameter)
+            if (channels > 0 && targetWidth > 0 && targetHeight > 0)
+            {
+                const dim3 threadsPerBlock{THREADS_PER_BLOCK_1D, THREADS_PER_BLOCK_1D, 1};
+                const dim3 numBlocks{
+                    getNumberCudaBlocks(targetWidth, threadsPerBlock.x),
+                    getNumberCudaBlocks(targetHeight, threadsPerBlock.y),
+                    (unsigned int)channels};
+                tileStitchKernel<<<numBlocks, threadsPerBlock>>>(
+                    targetPtr, sourcePtr, tileGrid, targetWidth, targetHeight);
+            }
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template void tileStitchGpu(
+        float* targetPtr, const float* const sourcePtr, const std::array<int, 4>& targetSize,
+        const std::array<int, 4>& sourceSize, const TileGrid& tileGrid);
+    template void tileStitchGpu(
+        double* targetPtr, const double* const sourcePtr, const std::array<int, 4>& targetSize,
+        const std::array<int, 4>& sourceSize, const TileGrid& tileGrid);
+}
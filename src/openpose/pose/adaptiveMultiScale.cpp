@@ -0,0 +1,269 @@
+#include <openpose/pose/adaptiveMultiScale.hpp>
+#include <algorithm> // std::copy
+#include <cmath> // std::ceil
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/keypoint.hpp>
+#include <openpose/utilities/openCv.hpp> // resizeGetScaleFactor
+
+namespace op
+{
+    // Each crop is a square of CROP_PERSON_SCALE times the largest side of the person that triggered it
+    const auto CROP_PERSON_SCALE = 2.f;
+    // Net input sides are multiples of CROP_NET_SIDE_STEP, so consecutive frames rarely reshape the network
+    const auto CROP_NET_SIDE_STEP = 64;
+    // Minimum intersection over union to consider that a person of a crop is a person of the smallest scale
+    const auto CROP_MIN_IOU = 0.3f;
+
+    float getIoU(const Rectangle<float>& rectangleA, const Rectangle<float>& rectangleB)
+    {
+        const auto intersectionWidth = fastMin(rectangleA.x + rectangleA.width, rectangleB.x + rectangleB.width)
+                                     - fastMax(rectangleA.x, rectangleB.x);
+        const auto intersectionHeight = fastMin(rectangleA.y + rectangleA.height, rectangleB.y + rectangleB.height)
+                                      - fastMax(rectangleA.y, rectangleB.y);
+        if (intersectionWidth <= 0.f || intersectionHeight <= 0.f)
+            return 0.f;
+        const auto intersection = intersectionWidth * intersectionHeight;
+        return intersection / (rectangleA.area() + rectangleB.area() - intersection);
+    }
+
+    bool intersect(const Rectangle<int>& rectangleA, const Rectangle<int>& rectangleB)
+    {
+        return rectangleA.x < rectangleB.x + rectangleB.width && rectangleB.x < rectangleA.x + rectangleA.width
+            && rectangleA.y < rectangleB.y + rectangleB.height && rectangleB.y < rectangleA.y + rectangleA.height;
+    }
+
+    Rectangle<int> getSquareCrop(const Point<float>& center, const float side, const Rectangle<int>& bounds)
+    {
+        const auto left = fastMax(bounds.x, positiveIntRound(fastMax(0.f, center.x - side / 2.f)));
+        const auto top = fastMax(bounds.y, positiveIntRound(fastMax(0.f, center.y - side / 2.f)));
+        const auto right = fastMin(bounds.x + bounds.width, positiveIntRound(center.x + side / 2.f));
+        const auto bottom = fastMin(bounds.y + bounds.height, positiveIntRound(center.y + side / 2.f));
+        return Rectangle<int>{left, top, fastMax(0, right - left), fastMax(0, bottom - top)};
+    }
+
+    // Average score of the detected keypoints (score > 0) of the person
+    float getDetectedAverageScore(const Array<float>& poseKeypoints, const int person)
+    {
+        const auto numberParts = poseKeypoints.getSize(1);
+        const auto* const personPtr = poseKeypoints.getConstPtr() + person * numberParts * poseKeypoints.getSize(2);
+        auto score = 0.f;
+        auto detected = 0;
+        for (auto part = 0 ; part < numberParts ; part++)
+        {
+            const auto partScore = personPtr[part * poseKeypoints.getSize(2) + 2];
+            if (partScore > 0.f)
+            {
+                score += partScore;
+                detected++;
+            }
+        }
+        return (detected > 0 ? score / detected : 0.f);
+    }
+
+    AdaptiveMultiScale::AdaptiveMultiScale(
+        const PoseModel poseModel, const int scaleNumber, const double scaleGap, const float maxPersonHeight,
+        const float minAverageScore) :
+        mSmallestScale{1. - (scaleNumber - 1) * scaleGap},
+        mMaxPersonHeight{maxPersonHeight},
+        mMinAverageScore{minAverageScore},
+        mCvMatToOpInput{poseModel},
+        mFrames{0ull},
+        mCrops{0ull}
+    {
+        try
+        {
+            // Sanity checks
+            if (scaleNumber < 2)
+                error("The adaptive multi-scale mode requires at least 2 scales (`--scale_number`).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (mSmallestScale <= 0. || 1. < mSmallestScale)
+                error("All scales must be in the range (0, 1], i.e., 0 < 1-(scale_number-1)*scale_gap <= 1.",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    AdaptiveMultiScale::~AdaptiveMultiScale()
+    {
+    }
+
+    void AdaptiveMultiScale::refine(
+        PoseExtractor& poseExtractor, Array<float>& poseKeypoints, Array<float>& poseScores,
+        const Matrix& inputData, const std::vector<double>& scaleInputToNetInputs,
+        const std::vector<Point<int>>& inputRoi, const Rectangle<int>& inputRoiRectangle, const long long frameId)
+    {
+        try
+        {
+            if (poseKeypoints.empty() || scaleInputToNetInputs.empty())
+                return;
+            // Scale of the network resolution (largest scale), from the smallest one
+            const auto scaleInputToNetInput = scaleInputToNetInputs[0] / mSmallestScale;
+            std::vector<char> selected;
+            const auto crops = getCrops(poseKeypoints, inputRoiRectangle, selected);
+            if (crops.empty())
+                return;
+            mFrames++;
+            // People of the smallest scale
+            const auto numberPeople = poseKeypoints.getSize(0);
+            const auto personArea = poseKeypoints.getSize(1) * poseKeypoints.getSize(2);
+            std::vector<std::vector<float>> people(numberPeople);
+            std::vector<float> scores(numberPeople);
+            std::vector<Rectangle<float>> rectangles(numberPeople);
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                const auto* const personPtr = poseKeypoints.getConstPtr() + person * personArea;
+                people[person].assign(personPtr, personPtr + personArea);
+                scores[person] = (person < (int)poseScores.getVolume() ? poseScores[person] : 0.f);
+                rectangles[person] = getKeypointsRectangle(poseKeypoints, person, 0.f);
+            }
+            // Score of the crop person that replaced each selected person (-1 if none)
+            std::vector<float> replacedScores(numberPeople, -1.f);
+            for (const auto& crop : crops)
+            {
+                mCrops++;
+                // Network forward pass on the crop at the largest scale
+                const auto netSide = CROP_NET_SIDE_STEP * fastMax(1, (int)std::ceil(
+                    fastMax(crop.width, crop.height) * scaleInputToNetInput / CROP_NET_SIDE_STEP));
+                const std::vector<Point<int>> netInputSizes{Point<int>{netSide, netSide}};
+                const std::vector<double> scaleCropToNetInputs{
+                    resizeGetScaleFactor(Point<int>{crop.width, crop.height}, netInputSizes[0])};
+                const auto cropRoi = (inputRoi.size() > 2
+                    ? inputRoi : std::vector<Point<int>>{crop.topLeft(), crop.bottomRight()});
+                const auto inputNetData = mCvMatToOpInput.createArray(
+                    inputData, scaleCropToNetInputs, netInputSizes, FrameGpu{}, cropRoi, crop);
+                poseExtractor.forwardPass(
+                    inputNetData, Point<int>{crop.width, crop.height}, scaleCropToNetInputs, Array<float>{}, frameId);
+                auto cropKeypoints = poseExtractor.getPoseKeypoints().clone();
+                const auto cropScores = poseExtractor.getPoseScores();
+                if (cropKeypoints.empty())
+                    continue;
+                offsetKeypoints2d(cropKeypoints, (float)crop.x, (float)crop.y);
+                // Merge its people
+                for (auto cropPerson = 0 ; cropPerson < cropKeypoints.getSize(0) ; cropPerson++)
+                {
+                    const auto rectangle = getKeypointsRectangle(cropKeypoints, cropPerson, 0.f);
+                    const auto center = rectangle.center();
+                    if (rectangle.area() <= 0.f || center.x < crop.x || crop.x + crop.width <= center.x
+                        || center.y < crop.y || crop.y + crop.height <= center.y)
+                        continue;
+                    const auto* const cropPersonPtr = cropKeypoints.getConstPtr() + cropPerson * personArea;
+                    const auto cropScore = (cropPerson < (int)cropScores.getVolume() ? cropScores[cropPerson] : 0.f);
+                    // Same person as one of the smallest scale
+                    auto bestPerson = -1;
+                    auto bestIoU = CROP_MIN_IOU;
+                    for (auto person = 0 ; person < numberPeople ; person++)
+                    {
+                        const auto iou = getIoU(rectangle, rectangles[person]);
+                        if (iou >= bestIoU)
+                        {
+                            bestIoU = iou;
+                            bestPerson = person;
+                        }
+                    }
+                    if (bestPerson > -1)
+                    {
+                        // Only the small or not confident people are replaced (the rest are already good)
+                        if (selected[bestPerson] && replacedScores[bestPerson] < cropScore)
+                        {
+                            people[bestPerson].assign(cropPersonPtr, cropPersonPtr + personArea);
+                            scores[bestPerson] = cropScore;
+                            replacedScores[bestPerson] = cropScore;
+                        }
+                    }
+                    // New person (missed by the smallest scale), unless truncated by the crop
+                    else
+                    {
+                        const auto truncated =
+                            (crop.x > inputRoiRectangle.x && rectangle.x <= crop.x + 1.f)
+                            || (crop.y > inputRoiRectangle.y && rectangle.y <= crop.y + 1.f)
+                            || (crop.x + crop.width < inputRoiRectangle.x + inputRoiRectangle.width
+                                && rectangle.x + rectangle.width >= crop.x + crop.width - 1.f)
+                            || (crop.y + crop.height < inputRoiRectangle.y + inputRoiRectangle.height
+                                && rectangle.y + rectangle.height >= crop.y + crop.height - 1.f);
+                        if (!truncated)
+                        {
+                            people.emplace_back(cropPersonPtr, cropPersonPtr + personArea);
+                            scores.emplace_back(cropScore);
+                        }
+                    }
+                }
+            }
+            // Final people
+            const auto finalNumberPeople = (int)people.size();
+            poseKeypoints.reset({finalNumberPeople, poseKeypoints.getSize(1), poseKeypoints.getSize(2)});
+            poseScores.reset(finalNumberPeople);
+            for (auto person = 0 ; person < finalNumberPeople ; person++)
+            {
+                std::copy(people[person].begin(), people[person].end(), poseKeypoints.getPtr() + person * personArea);
+                poseScores[person] = scores[person];
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::pair<unsigned long long, unsigned long long> AdaptiveMultiScale::getStats() const
+    {
+        return std::make_pair(mFrames, mCrops);
+    }
+
+    std::vector<Rectangle<int>> AdaptiveMultiScale::getCrops(
+        const Array<float>& poseKeypoints, const Rectangle<int>& inputRoiRectangle, std::vector<char>& selected) const
+    {
+        try
+        {
+            const auto numberPeople = poseKeypoints.getSize(0);
+            selected.assign(numberPeople, 0);
+            std::vector<Rectangle<int>> crops;
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                const auto rectangle = getKeypointsRectangle(poseKeypoints, person, 0.f);
+                if (rectangle.area() <= 0.f)
+                    continue;
+                // Small or not confident people
+                if (rectangle.height >= mMaxPersonHeight * inputRoiRectangle.height
+                    && getDetectedAverageScore(poseKeypoints, person) >= mMinAverageScore)
+                    continue;
+                selected[person] = 1;
+                const auto crop = getSquareCrop(
+                    rectangle.center(), CROP_PERSON_SCALE * fastMax(rectangle.width, rectangle.height),
+                    inputRoiRectangle);
+                if (crop.area() > 0)
+                    crops.emplace_back(crop);
+            }
+            // Overlapping crops are merged into their bounding box
+            auto merged = true;
+            while (merged)
+            {
+                merged = false;
+                for (auto i = 0u ; i < crops.size() && !merged ; i++)
+                {
+                    for (auto j = i+1 ; j < crops.size() && !merged ; j++)
+                    {
+                        if (intersect(crops[i], crops[j]))
+                        {
+                            const auto left = fastMin(crops[i].x, crops[j].x);
+                            const auto top = fastMin(crops[i].y, crops[j].y);
+                            const auto right = fastMax(crops[i].x + crops[i].width, crops[j].x + crops[j].width);
+                            const auto bottom = fastMax(crops[i].y + crops[i].height, crops[j].y + crops[j].height);
+                            crops[i] = Rectangle<int>{left, top, right - left, bottom - top};
+                            crops.erase(crops.begin() + j);
+                            merged = true;
+                        }
+                    }
+                }
+            }
+            return crops;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+}
@@ -0,0 +1,201 @@
+#include <openpose/pose/body135FaceHand.hpp>
+#include <openpose/face/faceParameters.hpp>
+#include <openpose/hand/handParameters.hpp>
+#include <openpose/pose/poseParameters.hpp>
+
+namespace op
+{
+    std::vector<unsigned int> getConsecutiveParts(
+        const PoseModel poseModel, const std::string& firstPart, const unsigned int numberParts)
+    {
+        try
+        {
+            const auto firstIndex = poseBodyPartMapStringToKey(poseModel, firstPart);
+            std::vector<unsigned int> parts(numberParts);
+            for (auto part = 0u ; part < numberParts ; part++)
+                parts[part] = firstIndex + part;
+            return parts;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::vector<unsigned int> getHandParts(
+        const PoseModel poseModel, const std::string& wrist, const std::string& firstFingerPart)
+    {
+        try
+        {
+            // Hand keypoint 0 is the wrist, followed by the 4 keypoints of each finger
+            auto parts = getConsecutiveParts(poseModel, firstFingerPart, HAND_NUMBER_PARTS-1);
+            parts.insert(parts.begin(), poseBodyPartMapStringToKey(poseModel, wrist));
+            return parts;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    Body135FaceHand::Body135FaceHand(
+        const PoseModel poseModel, const float faceMinAverageScore, const float handMinAverageScore) :
+        mFaceMinAverageScore{faceMinAverageScore},
+        mHandMinAverageScore{handMinAverageScore}
+    {
+        try
+        {
+            // Sanity check
+            if (poseModel != PoseModel::BODY_135)
+                error("The face and hand keypoints can only be filled from the body keypoints with the BODY_135"
+                      " model (`--model_pose BODY_135`).", __LINE__, __FUNCTION__, __FILE__);
+            mFaceParts = getConsecutiveParts(poseModel, "FaceContour0", FACE_NUMBER_PARTS);
+            mHandParts[0] = getHandParts(poseModel, "LWrist", "LThumb1CMC");
+            mHandParts[1] = getHandParts(poseModel, "RWrist", "RThumb1CMC");
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    Body135FaceHand::~Body135FaceHand()
+    {
+    }
+
+    std::vector<Rectangle<float>> Body135FaceHand::select(
+        const std::vector<Rectangle<float>>& faceRectangles, const Array<float>& poseKeypoints) const
+    {
+        try
+        {
+            auto selectedRectangles = faceRectangles;
+            if (mFaceMinAverageScore < 0.f)
+                return selectedRectangles;
+            for (auto person = 0u ; person < faceRectangles.size() ; person++)
+                if (isConfident(poseKeypoints, person, mFaceParts, mFaceMinAverageScore))
+                    selectedRectangles[person] = Rectangle<float>{};
+            return selectedRectangles;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void Body135FaceHand::update(
+        Array<float>& faceKeypoints, const std::vector<Rectangle<float>>& faceRectangles,
+        const Array<float>& poseKeypoints) const
+    {
+        try
+        {
+            if (mFaceMinAverageScore >= 0.f)
+                fill(faceKeypoints, faceRectangles, poseKeypoints, mFaceParts, mFaceMinAverageScore);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<std::array<Rectangle<float>, 2>> Body135FaceHand::select(
+        const std::vector<std::array<Rectangle<float>, 2>>& handRectangles, const Array<float>& poseKeypoints) const
+    {
+        try
+        {
+            auto selectedRectangles = handRectangles;
+            if (mHandMinAverageScore < 0.f)
+                return selectedRectangles;
+            for (auto person = 0u ; person < handRectangles.size() ; person++)
+                for (auto hand = 0 ; hand < 2 ; hand++)
+                    if (isConfident(poseKeypoints, person, mHandParts[hand], mHandMinAverageScore))
+                        selectedRectangles[person][hand] = Rectangle<float>{};
+            return selectedRectangles;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void Body135FaceHand::update(
+        std::array<Array<float>, 2>& handKeypoints, const std::vector<std::array<Rectangle<float>, 2>>& handRectangles,
+        const Array<float>& poseKeypoints) const
+    {
+        try
+        {
+            if (mHandMinAverageScore < 0.f)
+                return;
+            for (auto hand = 0 ; hand < 2 ; hand++)
+            {
+                std::vector<Rectangle<float>> rectangles(handRectangles.size());
+                for (auto person = 0u ; person < handRectangles.size() ; person++)
+                    rectangles[person] = handRectangles[person][hand];
+                fill(handKeypoints[hand], rectangles, poseKeypoints, mHandParts[hand], mHandMinAverageScore);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool Body135FaceHand::isConfident(
+        const Array<float>& poseKeypoints, const int person, const std::vector<unsigned int>& parts,
+        const float minAverageScore) const
+    {
+        try
+        {
+            if (poseKeypoints.getNumberDimensions() != 3 || person >= poseKeypoints.getSize(0))
+                return false;
+            const auto* const personPtr = poseKeypoints.getConstPtr()
+                                        + person * poseKeypoints.getSize(1) * poseKeypoints.getSize(2);
+            auto score = 0.f;
+            for (const auto part : parts)
+                score += personPtr[part * poseKeypoints.getSize(2) + 2];
+            return score >= minAverageScore * parts.size();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void Body135FaceHand::fill(
+        Array<float>& keypoints, const std::vector<Rectangle<float>>& rectangles,
+        const Array<float>& poseKeypoints, const std::vector<unsigned int>& parts,
+        const float minAverageScore) const
+    {
+        try
+        {
+            const auto numberPeople = (poseKeypoints.getNumberDimensions() == 3 ? poseKeypoints.getSize(0) : 0);
+            if (numberPeople == 0 || (int)rectangles.size() != numberPeople)
+                return;
+            // E.g., if the network was not run for any person
+            if (keypoints.getNumberDimensions() != 3 || keypoints.getSize(0) != numberPeople
+                || keypoints.getSize(1) != (int)parts.size())
+                keypoints.reset({numberPeople, (int)parts.size(), 3}, 0.f);
+            const auto poseChannels = poseKeypoints.getSize(2);
+            const auto keypointChannels = keypoints.getSize(2);
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                if (rectangles[person].area() > 0.f && !isConfident(poseKeypoints, person, parts, minAverageScore))
+                    continue;
+                const auto* const posePtr = poseKeypoints.getConstPtr()
+                                          + person * poseKeypoints.getSize(1) * poseChannels;
+                auto* const keypointsPtr = keypoints.getPtr() + person * keypoints.getSize(1) * keypointChannels;
+                for (auto part = 0u ; part < parts.size() ; part++)
+                    for (auto channel = 0 ; channel < 3 ; channel++)
+                        keypointsPtr[part * keypointChannels + channel] = posePtr[parts[part] * poseChannels + channel];
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
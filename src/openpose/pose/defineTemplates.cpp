@@ -2,6 +2,7 @@
 
 namespace op
 {
+    DEFINE_TEMPLATE_DATUM(WPersonCropExtractor);
     DEFINE_TEMPLATE_DATUM(WPoseExtractor);
     DEFINE_TEMPLATE_DATUM(WPoseExtractorNet);
     DEFINE_TEMPLATE_DATUM(WPoseRenderer);
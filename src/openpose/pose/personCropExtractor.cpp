@@ -0,0 +1,264 @@
+#include <openpose/pose/personCropExtractor.hpp>
+#include <cmath> // std::sqrt
+#include <limits> // std::numeric_limits
+#include <opencv2/core/core.hpp>
+#include <openpose/gpu/cuda.hpp>
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+    #include <openpose/gpu/cudaMemoryPool.hpp>
+    #include <openpose/net/resizeAndMergeBase.hpp>
+#endif
+#include <openpose/pose/poseParameters.hpp>
+#include <openpose/utilities/allocationTracker.hpp>
+#include <openpose/utilities/fastMath.hpp>
+
+namespace op
+{
+    int getBodyPartIndex(const PoseModel poseModel, const std::string& bodyPartName)
+    {
+        try
+        {
+            for (const auto& bodyPart : getPoseBodyPartMapping(poseModel))
+                if (bodyPart.second == bodyPartName)
+                    return (int)bodyPart.first;
+            return -1;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1;
+        }
+    }
+
+    PersonCropExtractor::PersonCropExtractor(
+        const PoseModel poseModel, const Point<int>& cropSize, const float scale, const bool align,
+        const float threshold, const bool download, const int gpuId) :
+        mCropSize{cropSize},
+        mScale{scale},
+        mThreshold{threshold},
+        mDownload{download},
+        mGpuId{gpuId},
+        mNeckIndex{-1},
+        mMidHipIndex{-1},
+        mRHipIndex{-1},
+        mLHipIndex{-1},
+        pFrameGpuPtr{nullptr},
+        mFrameGpuBytes{0ull}
+    {
+        try
+        {
+            #ifndef USE_CUDA
+                error("OpenPose must be compiled with the `USE_CUDA` macro definitions in order to run this"
+                      " functionality (`--person_crops`).", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+            if (cropSize.x < 1 || cropSize.y < 1)
+                error("The crop resolution must be positive.", __LINE__, __FUNCTION__, __FILE__);
+            if (scale <= 0.f)
+                error("The crop scale must be positive.", __LINE__, __FUNCTION__, __FILE__);
+            if (align)
+            {
+                mNeckIndex = getBodyPartIndex(poseModel, "Neck");
+                mMidHipIndex = getBodyPartIndex(poseModel, "MidHip");
+                mRHipIndex = getBodyPartIndex(poseModel, "RHip");
+                mLHipIndex = getBodyPartIndex(poseModel, "LHip");
+                if (mNeckIndex < 0 || (mMidHipIndex < 0 && (mRHipIndex < 0 || mLHipIndex < 0)))
+                {
+                    mNeckIndex = -1;
+                    opLog("The person crops are not aligned since this body pose model has no neck and hips.",
+                          Priority::High);
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    PersonCropExtractor::~PersonCropExtractor()
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                cudaPoolFree(pFrameGpuPtr);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PersonCropExtractor::initializationOnThread()
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                cudaSetDevice(mGpuId);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PersonCropExtractor::extract(
+        PersonCropsGpu& personCropsGpu, Array<float>& personCrops,
+        std::vector<std::array<float, 6>>& personCropMatrices, const Matrix& inputData,
+        const Array<float>& poseKeypoints)
+    {
+        try
+        {
+            personCropMatrices = getCropMatrices(poseKeypoints);
+            const auto numberCrops = (int)personCropMatrices.size();
+            if (numberCrops == 0 || inputData.empty())
+            {
+                personCropsGpu = PersonCropsGpu{};
+                personCrops.reset();
+                personCropMatrices.clear();
+                return;
+            }
+            #ifdef USE_CUDA
+                const cv::Mat& cvInputData = OP_OP2CVCONSTMAT(inputData);
+                if (cvInputData.type() != CV_8UC3)
+                    error("The person crops require a BGR (8-bit) input image.", __LINE__, __FUNCTION__, __FILE__);
+                // The frame is uploaded once, and all the crops are warped from it in a single call
+                const auto frameBytes = 3ull * cvInputData.cols * cvInputData.rows;
+                if (mFrameGpuBytes < frameBytes)
+                {
+                    cudaPoolFree(pFrameGpuPtr);
+                    pFrameGpuPtr = (unsigned char*)cudaPoolMalloc(frameBytes);
+                    mFrameGpuBytes = frameBytes;
+                }
+                cudaMemcpy2D(pFrameGpuPtr, 3 * cvInputData.cols, cvInputData.data, cvInputData.step,
+                             3 * cvInputData.cols, cvInputData.rows, cudaMemcpyHostToDevice);
+                AllocationTracker::recordCopy(frameBytes, MemoryCopy::HostToDevice);
+                // A new block per frame, since the previous Datum might still be reading the previous one
+                personCropsGpu.allocate(numberCrops, mCropSize.x, mCropSize.y);
+                warpAffineCropsGpu(
+                    personCropsGpu.dataPtr.get(), pFrameGpuPtr, cvInputData.cols, cvInputData.rows,
+                    personCropMatrices, mCropSize.x, mCropSize.y, 1);
+                // Pinned host copy
+                if (mDownload)
+                {
+                    personCrops.resetPinned({numberCrops, 3, mCropSize.y, mCropSize.x});
+                    cudaMemcpy(personCrops.getPtr(), personCropsGpu.dataPtr.get(),
+                               personCropsGpu.getVolume() * sizeof(float), cudaMemcpyDeviceToHost);
+                    AllocationTracker::recordCopy(
+                        personCropsGpu.getVolume() * sizeof(float), MemoryCopy::DeviceToHost);
+                }
+                else
+                    cudaDeviceSynchronize();
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            #else
+                error("OpenPose must be compiled with the `USE_CUDA` macro definitions in order to run this"
+                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<std::array<float, 6>> PersonCropExtractor::getCropMatrices(const Array<float>& poseKeypoints) const
+    {
+        try
+        {
+            std::vector<std::array<float, 6>> cropMatrices;
+            if (poseKeypoints.empty())
+                return cropMatrices;
+            const auto numberPeople = poseKeypoints.getSize(0);
+            const auto numberBodyParts = poseKeypoints.getSize(1);
+            const auto targetAspectRatio = mCropSize.x / (float)mCropSize.y;
+            cropMatrices.resize(numberPeople);
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                const auto* const keypointsPtr = poseKeypoints.getConstPtr() + person*numberBodyParts*3;
+                const auto isValid = [&](const int part)
+                {
+                    return part >= 0 && part < numberBodyParts && keypointsPtr[3*part+2] > mThreshold;
+                };
+                // Up direction of the crop: the image one, or mid-hip to neck if aligned
+                auto upX = 0.f;
+                auto upY = -1.f;
+                if (mNeckIndex >= 0 && isValid(mNeckIndex)
+                    && (isValid(mMidHipIndex) || (isValid(mRHipIndex) && isValid(mLHipIndex))))
+                {
+                    const auto hipX = (isValid(mMidHipIndex) ? keypointsPtr[3*mMidHipIndex]
+                                       : 0.5f * (keypointsPtr[3*mRHipIndex] + keypointsPtr[3*mLHipIndex]));
+                    const auto hipY = (isValid(mMidHipIndex) ? keypointsPtr[3*mMidHipIndex+1]
+                                       : 0.5f * (keypointsPtr[3*mRHipIndex+1] + keypointsPtr[3*mLHipIndex+1]));
+                    const auto torsoX = keypointsPtr[3*mNeckIndex] - hipX;
+                    const auto torsoY = keypointsPtr[3*mNeckIndex+1] - hipY;
+                    const auto torsoLength = std::sqrt(torsoX*torsoX + torsoY*torsoY);
+                    if (torsoLength > 0.f)
+                    {
+                        upX = torsoX / torsoLength;
+                        upY = torsoY / torsoLength;
+                    }
+                }
+                // Crop axes (orthonormal): right = up rotated 90 degrees clockwise, down = -up
+                const auto rightX = -upY;
+                const auto rightY = upX;
+                const auto downX = -upX;
+                const auto downY = -upY;
+                // Bounding box of the keypoints in the crop axes
+                auto minRight = std::numeric_limits<float>::max();
+                auto maxRight = std::numeric_limits<float>::lowest();
+                auto minDown = std::numeric_limits<float>::max();
+                auto maxDown = std::numeric_limits<float>::lowest();
+                for (auto part = 0 ; part < numberBodyParts ; part++)
+                {
+                    if (isValid(part))
+                    {
+                        const auto x = keypointsPtr[3*part];
+                        const auto y = keypointsPtr[3*part+1];
+                        const auto right = x*rightX + y*rightY;
+                        const auto down = x*downX + y*downY;
+                        minRight = fastMin(minRight, right);
+                        maxRight = fastMax(maxRight, right);
+                        minDown = fastMin(minDown, down);
+                        maxDown = fastMax(maxDown, down);
+                    }
+                }
+                auto& cropMatrix = cropMatrices[person];
+                // No keypoint: Every crop pixel maps outside the image (i.e., a black crop)
+                if (minRight > maxRight)
+                {
+                    cropMatrix = std::array<float, 6>{0.f, 0.f, -1.f, 0.f, 0.f, -1.f};
+                    continue;
+                }
+                // Enlarged and padded to the crop aspect ratio
+                auto width = fastMax(1.f, mScale * (maxRight - minRight));
+                auto height = fastMax(1.f, mScale * (maxDown - minDown));
+                if (width < height * targetAspectRatio)
+                    width = height * targetAspectRatio;
+                else
+                    height = width / targetAspectRatio;
+                const auto centerRight = 0.5f * (minRight + maxRight);
+                const auto centerDown = 0.5f * (minDown + maxDown);
+                const auto centerX = centerRight*rightX + centerDown*downX;
+                const auto centerY = centerRight*rightY + centerDown*downY;
+                // Crop pixel (x, y) -> center + (x - cropCenterX)*scaleX*right + (y - cropCenterY)*scaleY*down
+                const auto scaleX = width / mCropSize.x;
+                const auto scaleY = height / mCropSize.y;
+                const auto cropCenterX = 0.5f * (mCropSize.x - 1);
+                const auto cropCenterY = 0.5f * (mCropSize.y - 1);
+                cropMatrix[0] = rightX * scaleX;
+                cropMatrix[1] = downX * scaleY;
+                cropMatrix[2] = centerX - cropMatrix[0]*cropCenterX - cropMatrix[1]*cropCenterY;
+                cropMatrix[3] = rightY * scaleX;
+                cropMatrix[4] = downY * scaleY;
+                cropMatrix[5] = centerY - cropMatrix[3]*cropCenterX - cropMatrix[4]*cropCenterY;
+            }
+            return cropMatrices;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+}
@@ -1,4 +1,5 @@
 #include <openpose/pose/poseExtractor.hpp>
+#include <mutex>
 
 namespace op
 {
@@ -9,13 +10,16 @@ namespace op
                                  const std::shared_ptr<KeepTopNPeople>& keepTopNPeople,
                                  const std::shared_ptr<PersonIdExtractor>& personIdExtractor,
                                  const std::shared_ptr<std::vector<std::shared_ptr<PersonTracker>>>& personTrackers,
-                                 const int numberPeopleMax, const int tracking) :
+                                 const int numberPeopleMax, const int tracking,
+                                 const std::shared_ptr<std::vector<std::shared_ptr<KeypointExtrapolator>>>&
+                                     keypointExtrapolators) :
         mNumberPeopleMax{numberPeopleMax},
         mTracking{tracking},
         spPoseExtractorNet{poseExtractorNet},
         spKeepTopNPeople{keepTopNPeople},
         spPersonIdExtractor{personIdExtractor},
-        spPersonTrackers{personTrackers}
+        spPersonTrackers{personTrackers},
+        spKeypointExtrapolators{keypointExtrapolators}
     {
     }
 
@@ -43,7 +47,7 @@ namespace op
     {
         try
         {
-            if (mTracking < 1 || frameId % (mTracking+1) == 0)
+            if (isKeyframe(frameId))
                 spPoseExtractorNet->forwardPass(inputNetData, inputDataSize, scaleInputToNetInputs, poseNetOutput);
             else
                 spPoseExtractorNet->clear();
@@ -54,6 +58,89 @@ namespace op
         }
     }
 
+    void PoseExtractor::forwardPassBatch(const std::vector<std::vector<Array<float>>>& inputNetDatas)
+    {
+        try
+        {
+            if (mTracking > 0)
+                error("The batched forward pass is not compatible with `--tracking` > 0.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            spPoseExtractorNet->forwardPassBatch(inputNetDatas);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractor::reserveNetInputSizes(const std::vector<std::vector<Point<int>>>& netInputSizes)
+    {
+        try
+        {
+            spPoseExtractorNet->reserveNetInputSizes(netInputSizes);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractor::warmUp(const std::vector<std::vector<Point<int>>>& netInputSizes, const int batchSize)
+    {
+        try
+        {
+            spPoseExtractorNet->warmUp(netInputSizes, batchSize);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractor::postProcessBatchElement(const int batchIndex, const std::vector<Array<float>>& inputNetData,
+                                                const Point<int>& inputDataSize,
+                                                const std::vector<double>& scaleInputToNetInputs)
+    {
+        try
+        {
+            spPoseExtractorNet->postProcessBatchElement(
+                batchIndex, inputNetData, inputDataSize, scaleInputToNetInputs);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractor::forwardPassPipelined(const std::vector<Array<float>>& inputNetData)
+    {
+        try
+        {
+            if (mTracking > 0)
+                error("The pipelined forward pass is not compatible with `--tracking` > 0.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            spPoseExtractorNet->forwardPassPipelined(inputNetData);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractor::postProcessPipelined(const std::vector<Array<float>>& inputNetData,
+                                             const Point<int>& inputDataSize,
+                                             const std::vector<double>& scaleInputToNetInputs)
+    {
+        try
+        {
+            spPoseExtractorNet->postProcessPipelined(inputNetData, inputDataSize, scaleInputToNetInputs);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     Array<float> PoseExtractor::getHeatMapsCopy() const
     {
         try
@@ -67,6 +154,31 @@ namespace op
         }
     }
 
+    std::function<Array<float>()> PoseExtractor::getHeatMapsDownload() const
+    {
+        try
+        {
+            return spPoseExtractorNet->getHeatMapsDownload();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    void PoseExtractor::getHeatMapsSparse(SparseHeatMaps& heatMapsSparse, const float threshold) const
+    {
+        try
+        {
+            spPoseExtractorNet->getHeatMapsSparse(heatMapsSparse, threshold);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     std::vector<std::vector<std::array<float, 3>>> PoseExtractor::getCandidatesCopy() const
     {
         try
@@ -80,6 +192,18 @@ namespace op
         }
     }
 
+    void PoseExtractor::getCandidates(Array<float>& candidates, std::vector<int>& offsets) const
+    {
+        try
+        {
+            spPoseExtractorNet->getCandidates(candidates, offsets);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     Array<float> PoseExtractor::getPoseKeypoints() const
     {
         try
@@ -119,13 +243,26 @@ namespace op
         }
     }
 
-    void PoseExtractor::keepTopPeople(Array<float>& poseKeypoints, const Array<float>& poseScores) const
+    std::vector<DatumTimingEvent> PoseExtractor::takeGpuTimingEvents()
+    {
+        try
+        {
+            return spPoseExtractorNet->takeGpuTimingEvents();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void PoseExtractor::keepTopPeople(Array<float>& poseKeypoints, Array<float>& poseScores) const
     {
         try
         {
             // Keep only top N people
             if (spKeepTopNPeople)
-                poseKeypoints = spKeepTopNPeople->keepTopPeople(poseKeypoints, poseScores);
+                spKeepTopNPeople->keepTopPeopleInPlace(poseKeypoints, poseScores);
         }
         catch (const std::exception& e)
         {
@@ -193,6 +330,9 @@ namespace op
                 // Run person tracker
                 (*spPersonTrackers)[imageViewIndex]->track(poseKeypoints, poseIds, cvMatInput);
             }
+            // Keypoint extrapolation (it does not know the frame ID, so every frame is considered a keyframe)
+            else if (spKeypointExtrapolators != nullptr)
+                getKeypointExtrapolator(imageViewIndex)->track(poseKeypoints, poseIds, true);
         }
         catch (const std::exception& e)
         {
@@ -223,10 +363,47 @@ namespace op
                     (*spPersonTrackers)[imageViewIndex]->trackLockThread(
                         poseKeypoints, poseIds, cvMatInput, frameId);
             }
+            // Keypoint extrapolation
+            else if (spKeypointExtrapolators != nullptr && mTracking > 0)
+                getKeypointExtrapolator(imageViewIndex)->trackLockThread(
+                    poseKeypoints, poseIds, isKeyframe(frameId), frameId);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool PoseExtractor::isKeyframe(const long long frameId) const
+    {
+        try
+        {
+            return (mTracking < 1 || frameId % (mTracking+1) == 0);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    std::shared_ptr<KeypointExtrapolator> PoseExtractor::getKeypointExtrapolator(
+        const unsigned long long imageViewIndex)
+    {
+        try
+        {
+            // Shared among all the PoseExtractor, so it is resized under a lock (the KeypointExtrapolator
+            // themselves are thread-safe)
+            static std::mutex sKeypointExtrapolatorsMutex;
+            const std::lock_guard<std::mutex> lock{sKeypointExtrapolatorsMutex};
+            while (spKeypointExtrapolators->size() <= imageViewIndex)
+                spKeypointExtrapolators->emplace_back(std::make_shared<KeypointExtrapolator>());
+            return (*spKeypointExtrapolators)[imageViewIndex];
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
         }
     }
 }
@@ -1,19 +1,93 @@
 #include <openpose/pose/poseExtractorCaffe.hpp>
+#include <array>
 #include <limits> // std::numeric_limits
+#ifdef USE_CUDA
+    #include <cuda_fp16.h>
+    #include <cuda_runtime.h>
+    #include <cuda_runtime_api.h>
+#endif
 #include <openpose/gpu/cuda.hpp>
+#include <openpose/gpu/cudaMemoryPool.hpp>
+#include <openpose/net/resizeAndMergeBase.hpp>
+#include <openpose/net/tileStitchBase.hpp>
 #include <openpose/pose/poseParameters.hpp>
+#include <openpose/utilities/allocationTracker.hpp>
 #include <openpose/utilities/check.hpp>
 #include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/fileSystem.hpp>
 #include <openpose/utilities/keypoint.hpp>
 #include <openpose/utilities/openCv.hpp>
 #include <openpose/utilities/standard.hpp>
+#include <openpose/utilities/string.hpp>
 #include <openpose_private/utilities/openCvPrivate.hpp>
 
 namespace op
 {
     const bool TOP_DOWN_REFINEMENT = false; // Note: +5% acc 1 scale, -2% max acc setting
+    // Maximum number of people crops per forward pass of the top-down refinement and the ROI tracking mode
+    const auto TOP_DOWN_MAX_BATCH_SIZE = 4u;
 
     #ifdef USE_CAFFE
+        // Normalized value of a black pixel for each channel, i.e., the padding of the network input (see
+        // resizeAndPadUCharCvMatToFloatPtrs and CvMatToOpInput)
+        std::array<float,3> getNetInputPaddingValues(const PoseModel poseModel)
+        {
+            if (poseModel == PoseModel::BODY_19N)
+                return {-0.017f*103.94f, -0.017f*116.78f, -0.017f*123.68f};
+            return {-0.5f, -0.5f, -0.5f};
+        }
+
+        // Tiles of the tiled inference along 1 axis: Evenly distributed between 0 and size-tileSize, with origins
+        // aligned to the network stride (so they map to exact network output pixels), neighbouring tiles overlapping
+        // by about overlap x tileSize, and a single tile if size <= tileSize
+        std::vector<int> getTileOrigins(const int size, const int tileSize, const float overlap, const int alignment)
+        {
+            try
+            {
+                if (size <= tileSize)
+                    return {0};
+                const auto stride = fastMax(alignment, int(tileSize * (1.f - overlap)) / alignment * alignment);
+                const auto numberTiles = 1 + (size - tileSize + stride - 1) / stride;
+                if (numberTiles > TILE_GRID_MAX_TILES)
+                    error("Too many tiles (" + std::to_string(numberTiles) + " along one axis, maximum "
+                          + std::to_string(TILE_GRID_MAX_TILES) + "). Increase the tile size (`--net_resolution`)"
+                          " or reduce `--tiled_resolution`.", __LINE__, __FUNCTION__, __FILE__);
+                std::vector<int> origins(numberTiles);
+                for (auto i = 0 ; i < numberTiles ; i++)
+                    origins[i] = ((int)((long long)i * (size - tileSize) / (numberTiles - 1)) + alignment - 1)
+                               / alignment * alignment;
+                return origins;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return {};
+            }
+        }
+
+        TileGrid getTileGrid(
+            const Point<int>& inputSize, const Point<int>& tileSize, const float overlap, const int alignment)
+        {
+            try
+            {
+                TileGrid tileGrid{};
+                tileGrid.tileWidth = tileSize.x;
+                tileGrid.tileHeight = tileSize.y;
+                const auto originsX = getTileOrigins(inputSize.x, tileSize.x, overlap, alignment);
+                const auto originsY = getTileOrigins(inputSize.y, tileSize.y, overlap, alignment);
+                tileGrid.numberX = (int)originsX.size();
+                tileGrid.numberY = (int)originsY.size();
+                std::copy(originsX.begin(), originsX.end(), tileGrid.originsX);
+                std::copy(originsY.begin(), originsY.end(), tileGrid.originsY);
+                return tileGrid;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return TileGrid{};
+            }
+        }
+
         std::vector<ArrayCpuGpu<float>*> arraySharedToPtr(
             const std::vector<std::shared_ptr<ArrayCpuGpu<float>>>& caffeNetOutputBlob)
         {
@@ -37,7 +111,7 @@ namespace op
             std::shared_ptr<NmsCaffe<float>>& nmsCaffe,
             std::shared_ptr<BodyPartConnectorCaffe<float>>& bodyPartConnectorCaffe,
             std::shared_ptr<MaximumCaffe<float>>& maximumCaffe,
-            std::vector<std::shared_ptr<ArrayCpuGpu<float>>>& caffeNetOutputBlobsShared,
+            const std::vector<std::shared_ptr<ArrayCpuGpu<float>>>& caffeNetOutputBlobsShared,
             std::shared_ptr<ArrayCpuGpu<float>>& heatMapsBlob, std::shared_ptr<ArrayCpuGpu<float>>& peaksBlob,
             std::shared_ptr<ArrayCpuGpu<float>>& maximumPeaksBlob, const float scaleInputToNetInput,
             const PoseModel poseModel, const int gpuId, const float upsamplingRatio)
@@ -74,16 +148,31 @@ namespace op
             std::vector<std::shared_ptr<Net>>& net,
             std::vector<std::shared_ptr<ArrayCpuGpu<float>>>& caffeNetOutputBlob,
             const PoseModel poseModel, const int gpuId, const std::string& modelFolder,
-            const std::string& protoTxtPath, const std::string& caffeModelPath, const bool enableGoogleLogging)
+            const std::string& protoTxtPath, const std::string& caffeModelPath, const bool enableGoogleLogging,
+            const int tensorRtPrecision, const std::shared_ptr<NetMemoryArena>& netMemoryArena, const int netStages)
         {
             try
             {
+                const auto modelExtension = toLower(getFileExtension(caffeModelPath));
+                // Add OpenVINO Net (OpenVINO IR model, or ONNX model if TensorRT is not available)
+                #if defined(USE_OPENVINO) && !defined(USE_TENSORRT)
+                    const auto isOpenVinoModel = (modelExtension == "xml" || modelExtension == "onnx");
+                #else
+                    const auto isOpenVinoModel = (modelExtension == "xml");
+                #endif
+                if (isOpenVinoModel)
+                    net.emplace_back(std::make_shared<NetOpenVino>(modelFolder + caffeModelPath, tensorRtPrecision));
+                // Add TensorRT Net (ONNX model)
+                else if (modelExtension == "onnx")
+                    net.emplace_back(
+                        std::make_shared<NetTensorRt>(modelFolder + caffeModelPath, gpuId, tensorRtPrecision));
                 // Add Caffe Net
-                net.emplace_back(
-                    std::make_shared<NetCaffe>(
-                        modelFolder + (protoTxtPath.empty() ? getPoseProtoTxt(poseModel) : protoTxtPath),
-                        modelFolder + (caffeModelPath.empty() ? getPoseTrainedModel(poseModel) : caffeModelPath),
-                        gpuId, enableGoogleLogging));
+                else
+                    net.emplace_back(
+                        std::make_shared<NetCaffe>(
+                            modelFolder + (protoTxtPath.empty() ? getPoseProtoTxt(poseModel) : protoTxtPath),
+                            modelFolder + (caffeModelPath.empty() ? getPoseTrainedModel(poseModel) : caffeModelPath),
+                            gpuId, enableGoogleLogging, "net_output", netMemoryArena, netStages));
                 // net.emplace_back(
                 //     std::make_shared<NetOpenCv>(
                 //         modelFolder + (protoTxtPath.empty() ? getPoseProtoTxt(poseModel) : protoTxtPath),
@@ -112,7 +201,11 @@ namespace op
         const PoseModel poseModel, const std::string& modelFolder, const int gpuId,
         const std::vector<HeatMapType>& heatMapTypes, const ScaleMode heatMapScaleMode, const bool addPartCandidates,
         const bool maximizePositives, const std::string& protoTxtPath, const std::string& caffeModelPath,
-        const float upsamplingRatio, const bool enableNet, const bool enableGoogleLogging) :
+        const float upsamplingRatio, const bool enableNet, const bool enableGoogleLogging,
+        const int tensorRtPrecision, const bool heatMapsFp16, const int roiTrackingInterval,
+        const int numberPeopleMax, const bool scaleBatch, const bool cudaGraphs, const bool pafLowResolution,
+        const std::shared_ptr<NetOutputCache>& netOutputCache, const std::shared_ptr<NetMemoryArena>& netMemoryArena,
+        const Point<int>& netTileSize, const float netTileOverlap, const int netStages) :
         PoseExtractorNet{poseModel, heatMapTypes, heatMapScaleMode, addPartCandidates, maximizePositives},
         mPoseModel{poseModel},
         mGpuId{gpuId},
@@ -121,14 +214,45 @@ namespace op
         mCaffeModelPath{caffeModelPath},
         mUpsamplingRatio{upsamplingRatio},
         mEnableNet{enableNet},
-        mEnableGoogleLogging{enableGoogleLogging}
+        mEnableGoogleLogging{enableGoogleLogging},
+        mTensorRtPrecision{tensorRtPrecision},
+        #ifdef USE_CUDA
+            mHeatMapsFp16{heatMapsFp16},
+            // If the heat maps are an output, they are upsampled anyway
+            mFusedNmsEnabled{heatMapTypes.empty()},
+            mPafLowResolutionEnabled{pafLowResolution && heatMapTypes.empty()},
+        #else
+            mHeatMapsFp16{false},
+            mFusedNmsEnabled{false},
+            mPafLowResolutionEnabled{false},
+        #endif
+        mRoiTrackingInterval{roiTrackingInterval},
+        mFramesSinceFullDetection{0},
         #ifdef USE_CAFFE
-            ,
             spResizeAndMergeCaffe{std::make_shared<ResizeAndMergeCaffe<float>>()},
             spNmsCaffe{std::make_shared<NmsCaffe<float>>()},
             spBodyPartConnectorCaffe{std::make_shared<BodyPartConnectorCaffe<float>>()},
-            spMaximumCaffe{(TOP_DOWN_REFINEMENT ? std::make_shared<MaximumCaffe<float>>() : nullptr)}
+            spMaximumCaffe{(TOP_DOWN_REFINEMENT ? std::make_shared<MaximumCaffe<float>>() : nullptr)},
         #endif
+        mScaleBatch{scaleBatch},
+        mNetTileSize{netTileSize},
+        mNetTileOverlap{netTileOverlap},
+        mBatchSize{0},
+        pCudaStream{nullptr},
+        pNetOutputEvent{nullptr},
+        pStagedNetOutputEvent{nullptr},
+        mCudaGraphs{cudaGraphs},
+        pHeatMapsHalfGpuPtr{nullptr},
+        mFusedNms{false},
+        mPafLowResolution{false},
+        mHeatMapsBlobUpdated{true},
+        pSingleScaleNetOutputBlob{nullptr},
+        spNetOutputCache{netOutputCache},
+        mNetOutputCacheModelKey{std::to_string(int(poseModel)) + "|" + protoTxtPath + "|" + caffeModelPath + "|"
+                                + std::to_string(tensorRtPrecision)
+                                + (netStages > 0 ? "|stages " + std::to_string(netStages) : "")},
+        spNetMemoryArena{netMemoryArena},
+        mNetStages{netStages}
     {
         try
         {
@@ -136,6 +260,14 @@ namespace op
                 // Layers parameters
                 spBodyPartConnectorCaffe->setPoseModel(mPoseModel);
                 spBodyPartConnectorCaffe->setMaximizePositives(maximizePositives);
+                spBodyPartConnectorCaffe->setNumberPeopleMax(numberPeopleMax);
+                // Sanity check
+                if (mRoiTrackingInterval > 1 && (!heatMapTypes.empty() || addPartCandidates || mHeatMapsFp16))
+                    error("The ROI tracking mode (roiTrackingInterval > 1) is not compatible with the heat maps, the"
+                          " part candidates nor the FP16 heat maps.", __LINE__, __FUNCTION__, __FILE__);
+                if (mNetTileSize.x > 0 && (mNetTileSize.y <= 0 || mNetTileOverlap < 0.f || mNetTileOverlap >= 0.5f))
+                    error("The tile size (netTileSize) must be positive and its overlap (netTileOverlap) in [0, 0.5).",
+                          __LINE__, __FUNCTION__, __FILE__);
             #else
                 UNUSED(poseModel);
                 UNUSED(modelFolder);
@@ -147,6 +279,18 @@ namespace op
                 UNUSED(protoTxtPath);
                 UNUSED(caffeModelPath);
                 UNUSED(enableGoogleLogging);
+                UNUSED(tensorRtPrecision);
+                UNUSED(heatMapsFp16);
+                UNUSED(roiTrackingInterval);
+                UNUSED(numberPeopleMax);
+                UNUSED(scaleBatch);
+                UNUSED(cudaGraphs);
+                UNUSED(pafLowResolution);
+                UNUSED(netOutputCache);
+                UNUSED(netMemoryArena);
+                UNUSED(netTileSize);
+                UNUSED(netTileOverlap);
+                UNUSED(netStages);
                 error("OpenPose must be compiled with the `USE_CAFFE` macro definition in order to use this"
                       " functionality.", __LINE__, __FUNCTION__, __FILE__);
             #endif
@@ -159,6 +303,28 @@ namespace op
 
     PoseExtractorCaffe::~PoseExtractorCaffe()
     {
+        #if defined USE_CAFFE && defined USE_CUDA
+            try
+            {
+                // The pool must get the FP16 heat maps before the stream is destroyed
+                cudaPoolFree(pHeatMapsHalfGpuPtr, pCudaStream);
+                if (pCudaStream != nullptr)
+                {
+                    cudaStreamSynchronize(pCudaStream);
+                    cudaStreamDestroy(pCudaStream);
+                }
+                if (pNetOutputEvent != nullptr)
+                    cudaEventDestroy(pNetOutputEvent);
+                for (auto* pipelinedEvent : pPipelinedEvents)
+                    cudaEventDestroy(pipelinedEvent);
+                for (auto* gpuTimingEvent : pGpuTimingEvents)
+                    cudaEventDestroy(gpuTimingEvent);
+            }
+            catch (const std::exception& e)
+            {
+                errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        #endif
     }
 
     void PoseExtractorCaffe::netInitializationOnThread()
@@ -174,7 +340,7 @@ namespace op
                     addCaffeNetOnThread(
                         spNets, spCaffeNetOutputBlobs, mPoseModel, mGpuId,
                         mModelFolder, mProtoTxtPath, mCaffeModelPath,
-                        mEnableGoogleLogging);
+                        mEnableGoogleLogging, mTensorRtPrecision, spNetMemoryArena, mNetStages);
                     #ifdef USE_CUDA
                         cudaCheck(__LINE__, __FUNCTION__, __FILE__);
                     #endif
@@ -185,6 +351,25 @@ namespace op
                 if (TOP_DOWN_REFINEMENT)
                     spMaximumPeaksBlob = {std::make_shared<ArrayCpuGpu<float>>(1,1,1,1)};
                 #ifdef USE_CUDA
+                    // Non-blocking post-processing stream, so it does not serialize with other GPU workers
+                    if (pCudaStream == nullptr)
+                    {
+                        cudaStream_t cudaStream;
+                        cudaStreamCreateWithFlags(&cudaStream, cudaStreamNonBlocking);
+                        pCudaStream = cudaStream;
+                    }
+                    if (pNetOutputEvent == nullptr)
+                    {
+                        cudaEvent_t cudaEvent;
+                        cudaEventCreateWithFlags(&cudaEvent, cudaEventDisableTiming);
+                        pNetOutputEvent = cudaEvent;
+                    }
+                    spResizeAndMergeCaffe->setCudaStream(pCudaStream);
+                    spNmsCaffe->setCudaStream(pCudaStream);
+                    spBodyPartConnectorCaffe->setCudaStream(pCudaStream);
+                    // The body part connector is not captured, it reads the number of peaks back into the CPU
+                    spResizeAndMergeCaffe->setCudaGraphs(mCudaGraphs);
+                    spNmsCaffe->setCudaGraphs(mCudaGraphs);
                     cudaCheck(__LINE__, __FUNCTION__, __FILE__);
                 #endif
                 // Logging
@@ -233,18 +418,61 @@ namespace op
 
                 // Resize std::vectors if required
                 const auto numberScales = inputNetData.size();
-                mNetInput4DSizes.resize(numberScales);
 
-                // Process each image - Caffe deep network
-                if (mEnableNet)
+                // ROI tracking: Between full-frame detections, the network only runs on a crop around each person
+                // of the previous frame
+                if (mRoiTrackingInterval > 1 && mEnableNet && !mPoseKeypoints.empty()
+                    && mFramesSinceFullDetection + 1 < mRoiTrackingInterval
+                    && mRoiTrackingInputDataSize == inputDataSize)
+                {
+                    const auto numberPeople = mPoseKeypoints.getSize(0);
+                    const auto roiEnlargement = 1.6f;
+                    const auto numberPeopleTracked = refinePeopleOnRois(
+                        inputNetData, scaleInputToNetInputs, roiEnlargement, true);
+                    mFramesSinceFullDetection++;
+                    // Any person lost: Full-frame detection on the next frame
+                    if (numberPeopleTracked < numberPeople)
+                        mFramesSinceFullDetection = mRoiTrackingInterval;
+                    #ifdef USE_CUDA
+                        if (pCudaStream != nullptr)
+                            cudaStreamSynchronize(pCudaStream);
+                        cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    #endif
+                    return;
+                }
+                mFramesSinceFullDetection = 0;
+                mRoiTrackingInputDataSize = inputDataSize;
+
+                // Per-Datum timing: GPU time of the network forward pass and of the post-processing
+                const auto recordGpuTiming = (DatumTiming::isEnabled() && !mWarmingUp);
+                if (recordGpuTiming)
+                    recordGpuTimingEvent(0u, nullptr);
+
+                // Process each image - Caffe deep network (the cached outputs are the ones of each scale)
+                const auto tiled = (mNetTileSize.x > 0 && mEnableNet && numberScales == 1
+                    && (inputNetData[0].getSize(3) > mNetTileSize.x || inputNetData[0].getSize(2) > mNetTileSize.y));
+                const auto scaleBatch = (mScaleBatch && mEnableNet && numberScales > 1 && spNetOutputCache == nullptr);
+                if (tiled)
+                    forwardPassTiled(inputNetData[0]);
+                else if (scaleBatch)
+                    forwardPassScaleBatch(inputNetData);
+                else if (mEnableNet)
                 {
                     while (spNets.size() < numberScales)
                         addCaffeNetOnThread(
                             spNets, spCaffeNetOutputBlobs, mPoseModel, mGpuId,
-                            mModelFolder, mProtoTxtPath, mCaffeModelPath, false);
-
-                    for (auto i = 0u ; i < inputNetData.size(); i++)
-                        spNets.at(i)->forwardPass(inputNetData[i]);
+                            mModelFolder, mProtoTxtPath, mCaffeModelPath, false, mTensorRtPrecision, spNetMemoryArena,
+                            mNetStages);
+                    // Network output cache: The network only runs on a miss
+                    const auto netOutputCacheKey = (spNetOutputCache != nullptr && !mWarmingUp
+                        ? spNetOutputCache->getKey(inputNetData, mNetOutputCacheModelKey) : "");
+                    if (netOutputCacheKey.empty() || !readNetOutputCache(netOutputCacheKey, numberScales))
+                    {
+                        for (auto i = 0u ; i < inputNetData.size(); i++)
+                            spNets.at(i)->forwardPass(inputNetData[i]);
+                        if (!netOutputCacheKey.empty())
+                            addNetOutputCache(netOutputCacheKey, numberScales);
+                    }
                 }
                 // If custom network output
                 else
@@ -260,362 +488,20 @@ namespace op
                     spCaffeNetOutputBlobs.emplace_back(
                         std::make_shared<ArrayCpuGpu<float>>(poseNetOutput, copyFromGpu));
                 }
-                // Reshape blobs if required
-                for (auto i = 0u ; i < inputNetData.size(); i++)
+                if (recordGpuTiming)
+                    recordGpuTimingEvent(1u, nullptr);
+                // 2-4. Resize heat maps + merge different scales, NMS, and body part connection
+                postProcessNetOutput(
+                    (tiled ? spTiledBlobs : scaleBatch ? spScaleBatchBlobs : spCaffeNetOutputBlobs), inputNetData,
+                    inputDataSize, scaleInputToNetInputs);
+                if (recordGpuTiming)
                 {
-                    // Reshape blobs if required - For dynamic sizes (e.g., images of different aspect ratio)
-                    const auto changedVectors = !vectorsAreEqual(
-                        mNetInput4DSizes.at(i), inputNetData[i].getSize());
-                    if (changedVectors)
-                    {
-                        mNetInput4DSizes.at(i) = inputNetData[i].getSize();
-                        reshapePoseExtractorCaffe(
-                            spResizeAndMergeCaffe, spNmsCaffe, spBodyPartConnectorCaffe,
-                            spMaximumCaffe, spCaffeNetOutputBlobs, spHeatMapsBlob,
-                            spPeaksBlob, spMaximumPeaksBlob, 1.f, mPoseModel,
-                            mGpuId, mUpsamplingRatio);
-                            // In order to resize to input size to have same results as Matlab
-                            // scaleInputToNetInputs[i] vs. 1.f
-                    }
-                    // Get scale net to output (i.e., image input)
-                    const auto ratio = (
-                        mUpsamplingRatio <= 0.f
-                            ? 1 : mUpsamplingRatio / getPoseNetDecreaseFactor(mPoseModel));
-                    if (changedVectors || TOP_DOWN_REFINEMENT)
-                        mNetOutputSize = Point<int>{
-                            positiveIntRound(ratio*mNetInput4DSizes[0][3]),
-                            positiveIntRound(ratio*mNetInput4DSizes[0][2])};
+                    recordGpuTimingEvent(2u, pCudaStream);
+                    finishGpuTiming();
                 }
-                // OP_CUDA_PROFILE_END(timeNormalize1, 1e3, REPS);
-                // OP_CUDA_PROFILE_INIT(REPS);
-                // 2. Resize heat maps + merge different scales
-                // ~5ms (GPU) / ~20ms (CPU)
-                const auto caffeNetOutputBlobs = arraySharedToPtr(spCaffeNetOutputBlobs);
-                // Set and fill floatScaleRatios
-                    // Option 1/2 (warning for double-to-float conversion)
-                // const std::vector<float> floatScaleRatios(scaleInputToNetInputs.begin(), scaleInputToNetInputs.end());
-                    // Option 2/2
-                std::vector<float> floatScaleRatios;
-                std::for_each(
-                    scaleInputToNetInputs.begin(), scaleInputToNetInputs.end(),
-                    [&floatScaleRatios](const double value) { floatScaleRatios.emplace_back(float(value)); });
-                spResizeAndMergeCaffe->setScaleRatios(floatScaleRatios);
-                spResizeAndMergeCaffe->Forward(caffeNetOutputBlobs, {spHeatMapsBlob.get()});
-                // Get scale net to output (i.e., image input)
-                // Note: In order to resize to input size, (un)comment the following lines
-                const auto scaleProducerToNetInput = resizeGetScaleFactor(inputDataSize, mNetOutputSize);
-                const Point<int> netSize{
-                    positiveIntRound(scaleProducerToNetInput*inputDataSize.x),
-                    positiveIntRound(scaleProducerToNetInput*inputDataSize.y)};
-                mScaleNetToOutput = {(float)resizeGetScaleFactor(netSize, inputDataSize)};
-                // mScaleNetToOutput = 1.f;
-                // 3. Get peaks by Non-Maximum Suppression
-                // ~2ms (GPU) / ~7ms (CPU)
-                // OP_CUDA_PROFILE_END(timeNormalize2, 1e3, REPS);
-                const auto nmsThreshold = (float)get(PoseProperty::NMSThreshold);
-                const auto nmsOffset = float(0.5/double(mScaleNetToOutput));
-                // OP_CUDA_PROFILE_INIT(REPS);
-                spNmsCaffe->setThreshold(nmsThreshold);
-                spNmsCaffe->setOffset(Point<float>{nmsOffset, nmsOffset});
-                spNmsCaffe->Forward({spHeatMapsBlob.get()}, {spPeaksBlob.get()});
-                // 4. Connecting body parts
-                // OP_CUDA_PROFILE_END(timeNormalize3, 1e3, REPS);
-                // OP_CUDA_PROFILE_INIT(REPS);
-                spBodyPartConnectorCaffe->setScaleNetToOutput(mScaleNetToOutput);
-                spBodyPartConnectorCaffe->setDefaultNmsThreshold((float)get(PoseProperty::NMSThreshold));
-                spBodyPartConnectorCaffe->setInterMinAboveThreshold(
-                    (float)get(PoseProperty::ConnectInterMinAboveThreshold));
-                spBodyPartConnectorCaffe->setInterThreshold((float)get(PoseProperty::ConnectInterThreshold));
-                spBodyPartConnectorCaffe->setMinSubsetCnt((int)get(PoseProperty::ConnectMinSubsetCnt));
-                spBodyPartConnectorCaffe->setMinSubsetScore((float)get(PoseProperty::ConnectMinSubsetScore));
-                // Note: BODY_25D will crash (only implemented for CPU version)
-                spBodyPartConnectorCaffe->Forward(
-                    {spHeatMapsBlob.get(), spPeaksBlob.get()}, mPoseKeypoints, mPoseScores);
-                // OP_CUDA_PROFILE_END(timeNormalize4, 1e3, REPS);
-                // opLog("1(caf)= " + std::to_string(timeNormalize1) + "ms");
-                // opLog("2(res) = " + std::to_string(timeNormalize2) + " ms");
-                // opLog("3(nms) = " + std::to_string(timeNormalize3) + " ms");
-                // opLog("4(bpp) = " + std::to_string(timeNormalize4) + " ms");
                 // Re-run on each person
                 if (TOP_DOWN_REFINEMENT)
-                {
-                    // Get each person rectangle
-                    for (auto person = 0 ; person < mPoseKeypoints.getSize(0) ; person++)
-                    {
-                        // Get person rectangle resized to input size
-                        const auto rectangleF = getKeypointsRectangle(mPoseKeypoints, person, nmsThreshold)
-                                              / mScaleNetToOutput;
-                        // Make rectangle bigger to make sure the whole body is inside
-                        Rectangle<int> rectangleInt{
-                            positiveIntRound(rectangleF.x - 0.2*rectangleF.width),
-                            positiveIntRound(rectangleF.y - 0.2*rectangleF.height),
-                            positiveIntRound(rectangleF.width*1.4),
-                            positiveIntRound(rectangleF.height*1.4)
-                        };
-                        keepRoiInside(rectangleInt, inputNetData[0].getSize(3), inputNetData[0].getSize(2));
-                        // Input size
-                        // // Note: In order to preserve speed but maximize accuracy
-                        // // If e.g. rectange = 10x1 and inputSize = 656x368 --> targetSize = 656x368
-                        // // Note: If e.g. rectange = 1x10 and inputSize = 656x368 --> targetSize = 368x656
-                        // const auto width = ( ? rectangleInt.width : rectangleInt.height);
-                        // const auto height = (width == rectangleInt.width ? rectangleInt.height : rectangleInt.width);
-                        // const Point<int> inputSize{width, height};
-                        // Note: If inputNetData.size = -1x368 --> TargetSize = 368x-1
-                        const Point<int> inputSizeInit{rectangleInt.width, rectangleInt.height};
-                        // Target size
-                        Point<int> targetSize;
-                        // Optimal case (using training size)
-                        if (inputNetData[0].getSize(2) >= 368 || inputNetData[0].getVolume(2,3) >= 135424) // 368^2
-                            targetSize = Point<int>{368, 368};
-                        // Low resolution cases: Keep same area than biggest scale
-                        else
-                        {
-                            const auto minSide = fastMin(
-                                368, fastMin(inputNetData[0].getSize(2), inputNetData[0].getSize(3)));
-                            const auto maxSide = fastMin(
-                                368, fastMax(inputNetData[0].getSize(2), inputNetData[0].getSize(3)));
-                            // Person bounding box is vertical
-                            if (rectangleInt.width < rectangleInt.height)
-                                targetSize = Point<int>{minSide, maxSide};
-                            // Person bounding box is horizontal
-                            else
-                                targetSize = Point<int>{maxSide, minSide};
-                        }
-                        // Fill resizedImage
-                        /*const*/ auto scaleNetToRoi = resizeGetScaleFactor(inputSizeInit, targetSize);
-                        // Update rectangle to avoid black padding and instead take full advantage of the network area
-                        const auto padding = Point<int>{
-                            (int)std::round((targetSize.x-1) / scaleNetToRoi + 1 - inputSizeInit.x),
-                            (int)std::round((targetSize.y-1) / scaleNetToRoi + 1 - inputSizeInit.y)
-                        };
-                        // Width requires padding
-                        if (padding.x > 2 || padding.y > 2) // 2 pixels as threshold
-                        {
-                            if (padding.x > 2) // 2 pixels as threshold
-                            {
-                                rectangleInt.x -= padding.x/2;
-                                rectangleInt.width += padding.x;
-                            }
-                            else if (padding.y > 2) // 2 pixels as threshold
-                            {
-                                rectangleInt.y -= padding.y/2;
-                                rectangleInt.height += padding.y;
-                            }
-                            keepRoiInside(rectangleInt, inputNetData[0].getSize(3), inputNetData[0].getSize(2));
-                            scaleNetToRoi = resizeGetScaleFactor(
-                                Point<int>{rectangleInt.width, rectangleInt.height}, targetSize);
-                        }
-                        // No if scaleNetToRoi < 1 (image would be shrinked, so we assume best result already obtained)
-                        if (scaleNetToRoi > 1)
-                        {
-                            const auto areaInput = inputNetData[0].getVolume(2,3);
-                            const auto areaRoi = targetSize.area();
-                            Array<float> inputNetDataRoi{{1, 3, targetSize.y, targetSize.x}};
-                            for (auto c = 0u ; c < 3u ; c++)
-                            {
-                                // Input image
-                                const cv::Mat wholeInputCvMat(
-                                    inputNetData[0].getSize(2), inputNetData[0].getSize(3), CV_32FC1,
-                                    inputNetData[0].getPseudoConstPtr() + c * areaInput);
-                                // Input image cropped
-                                const cv::Mat inputCvMat(
-                                    wholeInputCvMat, cv::Rect{rectangleInt.x, rectangleInt.y, rectangleInt.width, rectangleInt.height});
-                                // Resize image for inputNetDataRoi
-                                cv::Mat resizedImageCvMat(
-                                    inputNetDataRoi.getSize(2), inputNetDataRoi.getSize(3), CV_32FC1,
-                                    inputNetDataRoi.getPtr() + c * areaRoi);
-                                resizeFixedAspectRatio(resizedImageCvMat, inputCvMat, scaleNetToRoi, targetSize);
-                            }
-
-                            // Re-Process image
-                            // 1. Caffe deep network
-                            spNets.at(0)->forwardPass(inputNetDataRoi);
-                            std::vector<std::shared_ptr<ArrayCpuGpu<float>>> caffeNetOutputBlob{
-                                spCaffeNetOutputBlobs[0]};
-                            // Reshape blobs
-                            if (!vectorsAreEqual(mNetInput4DSizes.at(0), inputNetDataRoi.getSize()))
-                            {
-                                mNetInput4DSizes.at(0) = inputNetDataRoi.getSize();
-                                reshapePoseExtractorCaffe(
-                                    spResizeAndMergeCaffe, spNmsCaffe,
-                                    spBodyPartConnectorCaffe, spMaximumCaffe,
-                                    // spCaffeNetOutputBlobs,
-                                    caffeNetOutputBlob, spHeatMapsBlob, spPeaksBlob,
-                                    spMaximumPeaksBlob, 1.f, mPoseModel, mGpuId,
-                                    mUpsamplingRatio);
-                            }
-                            // 2. Resize heat maps + merge different scales
-                            const auto caffeNetOutputBlobsNew = arraySharedToPtr(caffeNetOutputBlob);
-                            // const std::vector<float> floatScaleRatiosNew(
-                            //     scaleInputToNetInputs.begin(), scaleInputToNetInputs.end());
-                            const std::vector<float> floatScaleRatiosNew{(float)scaleInputToNetInputs[0]};
-                            spResizeAndMergeCaffe->setScaleRatios(floatScaleRatiosNew);
-                            spResizeAndMergeCaffe->Forward(
-                                caffeNetOutputBlobsNew, {spHeatMapsBlob.get()});
-                            // Get scale net to output (i.e., image input)
-                            const auto scaleRoiToOutput = float(mScaleNetToOutput / scaleNetToRoi);
-                            // 3. Get peaks by Non-Maximum Suppression
-                            const auto nmsThresholdRefined = 0.02f;
-                            spNmsCaffe->setThreshold(nmsThresholdRefined);
-                            const auto nmsOffsetNew = float(0.5/double(scaleRoiToOutput));
-                            spNmsCaffe->setOffset(Point<float>{nmsOffsetNew, nmsOffsetNew});
-                            spNmsCaffe->Forward({spHeatMapsBlob.get()}, {spPeaksBlob.get()});
-                            // Define poseKeypoints
-                            Array<float> poseKeypoints;
-                            Array<float> poseScores;
-                            // 4. Connecting body parts
-                            // Get scale net to output (i.e., image input)
-                            spBodyPartConnectorCaffe->setScaleNetToOutput(scaleRoiToOutput);
-                            spBodyPartConnectorCaffe->setInterThreshold(0.01f);
-                            spBodyPartConnectorCaffe->Forward(
-                                {spHeatMapsBlob.get(), spPeaksBlob.get()}, poseKeypoints, poseScores);
-                            // If detected people in new subnet
-                            if (!poseKeypoints.empty())
-                            {
-                                // // Scale back keypoints
-                                const auto xOffset = float(rectangleInt.x*mScaleNetToOutput);
-                                const auto yOffset = float(rectangleInt.y*mScaleNetToOutput);
-                                scaleKeypoints2d(poseKeypoints, 1.f, 1.f, xOffset, yOffset);
-                                // Re-assign person back
-                                // // Option a) Just use biggest person (simplest but fails with crowded people)
-                                // const auto personRefined = getBiggestPerson(poseKeypoints, nmsThreshold);
-                                // Option b) Get minimum keypoint distance
-                                // Get min distance
-                                int personRefined = -1;
-                                float personAverageDistance = std::numeric_limits<float>::max();
-                                for (auto person2 = 0 ; person2 < poseKeypoints.getSize(0) ; person2++)
-                                {
-                                    // Get average distance
-                                    const auto currentAverageDistance = getDistanceAverage(
-                                        mPoseKeypoints, person, poseKeypoints, person2, nmsThreshold);
-                                    // Update person
-                                    if (personAverageDistance > currentAverageDistance
-                                        && getNonZeroKeypoints(poseKeypoints, person2, nmsThreshold)
-                                            >= 0.75*getNonZeroKeypoints(mPoseKeypoints, person, nmsThreshold))
-                                    {
-                                        personRefined = person2;
-                                        personAverageDistance = currentAverageDistance;
-                                    }
-                                }
-                                // Get max ROI
-                                int personRefinedRoi = -1;
-                                float personRoi = -1.f;
-                                for (auto person2 = 0 ; person2 < poseKeypoints.getSize(0) ; person2++)
-                                {
-                                    // Get ROI
-                                    const auto currentRoi = getKeypointsRoi(
-                                        mPoseKeypoints, person, poseKeypoints, person2, nmsThreshold);
-                                    // Update person
-                                    if (personRoi < currentRoi
-                                        && getNonZeroKeypoints(poseKeypoints, person2, nmsThreshold)
-                                            >= 0.75*getNonZeroKeypoints(mPoseKeypoints, person, nmsThreshold))
-                                    {
-                                        personRefinedRoi = person2;
-                                        personRoi = currentRoi;
-                                    }
-                                }
-                                // If good refined candidate found
-                                // I.e., if both max ROI and min dist match on same person id
-                                if (personRefined == personRefinedRoi && personRefined > -1)
-                                {
-                                    // Update only if avg dist is small enough
-                                    const auto personRectangle = getKeypointsRectangle(
-                                        mPoseKeypoints, person, nmsThreshold);
-                                    const auto personRatio = 0.1f * (float)std::sqrt(
-                                        personRectangle.x*personRectangle.x + personRectangle.y*personRectangle.y);
-                                    // if (mPoseScores[person] < poseScores[personRefined]) // This harms accuracy
-                                    if (personAverageDistance < personRatio)
-                                    {
-                                        const auto personArea = mPoseKeypoints.getVolume(1,2);
-                                        const auto personIndex = person * personArea;
-                                        const auto personRefinedIndex = personRefined * personArea;
-                                        // mPoseKeypoints: Update keypoints
-                                        // Option a) Using refined ones
-                                        std::copy(
-                                            poseKeypoints.getPtr() + personRefinedIndex,
-                                            poseKeypoints.getPtr() + personRefinedIndex + personArea,
-                                            mPoseKeypoints.getPtr() + personIndex);
-                                        mPoseScores[person] = poseScores[personRefined];
-                                        // // Option b) Using ones with highest score (-6% acc single scale)
-                                        // // Fill gaps
-                                        // for (auto part = 0 ; part < mPoseKeypoints.getSize(1) ; part++)
-                                        // {
-                                        //     // For currently empty keypoints
-                                        //     const auto partIndex = personIndex+3*part;
-                                        //     const auto partRefinedIndex = personRefinedIndex+3*part;
-                                        //     const auto scoreDifference = poseKeypoints[partRefinedIndex+2]
-                                        //                                - mPoseKeypoints[partIndex+2];
-                                        //     if (scoreDifference > 0)
-                                        //     {
-                                        //         const auto x = poseKeypoints[partRefinedIndex];
-                                        //         const auto y = poseKeypoints[partRefinedIndex + 1];
-                                        //         mPoseKeypoints[partIndex] = x;
-                                        //         mPoseKeypoints[partIndex+1] = y;
-                                        //         mPoseKeypoints[partIndex+2] += scoreDifference;
-                                        //         mPoseScores[person] += scoreDifference;
-                                        //     }
-                                        // }
-
-                                        // No acc improvement (-0.05% acc single scale)
-                                        // // Finding all missing peaks (CPM-style)
-                                        // // Only if no other person in there (otherwise 2% accuracy drop)
-                                        // if (getNonZeroKeypoints(mPoseKeypoints, person, nmsThresholdRefined) > 0)
-                                        // {
-                                        //     // Get whether 0% ROI with other people
-                                        //     // Get max ROI
-                                        //     bool overlappingPerson = false;
-                                        //     for (auto person2 = 0 ; person2 < mPoseKeypoints.getSize(0) ; person2++)
-                                        //     {
-                                        //         if (person != person2)
-                                        //         {
-                                        //             // Get ROI
-                                        //             const auto currentRoi = getKeypointsRoi(
-                                        //                 mPoseKeypoints, person, person2, nmsThreshold);
-                                        //             // Update person
-                                        //             if (currentRoi > 0.f)
-                                        //             {
-                                        //                 overlappingPerson = true;
-                                        //                 break;
-                                        //             }
-                                        //         }
-                                        //     }
-                                        //     if (!overlappingPerson)
-                                        //     {
-                                        //         // Get keypoint with maximum probability per channel
-                                        //         spMaximumCaffe->Forward(
-                                        //             {spHeatMapsBlob.get()}, {spMaximumPeaksBlob.get()});
-                                        //         // Fill gaps
-                                        //         const auto* posePeaksPtr = spMaximumPeaksBlob->mutable_cpu_data();
-                                        //         for (auto part = 0 ; part < mPoseKeypoints.getSize(1) ; part++)
-                                        //         {
-                                        //             // For currently empty keypoints
-                                        //             if (mPoseKeypoints[personIndex+3*part+2] < nmsThresholdRefined)
-                                        //             {
-                                        //                 const auto xyIndex = 3*part;
-                                        //                 const auto x = posePeaksPtr[xyIndex]*scaleRoiToOutput + xOffset;
-                                        //                 const auto y = posePeaksPtr[xyIndex + 1]*scaleRoiToOutput + yOffset;
-                                        //                 const auto rectangle = getKeypointsRectangle(
-                                        //                     mPoseKeypoints, person, nmsThresholdRefined);
-                                        //                 if (x >= rectangle.x && x < rectangle.x + rectangle.width
-                                        //                     && y >= rectangle.y && y < rectangle.y + rectangle.height)
-                                        //                 {
-                                        //                     const auto score = posePeaksPtr[xyIndex + 2];
-                                        //                     const auto baseIndex = personIndex + 3*part;
-                                        //                     mPoseKeypoints[baseIndex] = x;
-                                        //                     mPoseKeypoints[baseIndex+1] = y;
-                                        //                     mPoseKeypoints[baseIndex+2] = score;
-                                        //                     mPoseScores[person] += score;
-                                        //                 }
-                                        //             }
-                                        //         }
-                                        //     }
-                                        // }
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
+                    refinePeopleOnRois(inputNetData, scaleInputToNetInputs, 1.4f, false);
 
                 // 5. CUDA sanity check
                 #ifdef USE_CUDA
@@ -633,86 +519,1445 @@ namespace op
         }
     }
 
-    const float* PoseExtractorCaffe::getCandidatesCpuConstPtr() const
+    void PoseExtractorCaffe::forwardPassBatch(const std::vector<std::vector<Array<float>>>& inputNetDatas)
     {
         try
         {
             #ifdef USE_CAFFE
-                checkThread();
-                return spPeaksBlob->cpu_data();
+                // Sanity checks
+                if (inputNetDatas.empty())
+                    error("Empty inputNetDatas.", __LINE__, __FUNCTION__, __FILE__);
+                if (!mEnableNet)
+                    error("The batched forward pass requires the OpenPose network (`--body 1`).",
+                          __LINE__, __FUNCTION__, __FILE__);
+                const auto numberScales = inputNetDatas[0].size();
+                for (const auto& inputNetData : inputNetDatas)
+                {
+                    if (inputNetData.size() != numberScales)
+                        error("All the batch elements must have the same number of scales.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    for (auto i = 0u ; i < numberScales; i++)
+                        if (inputNetData[i].empty() || inputNetData[i].getSize(0) != 1
+                            || !vectorsAreEqual(inputNetData[i].getSize(), inputNetDatas[0][i].getSize()))
+                            error("All the batch elements must be non-empty and share the same size.",
+                                  __LINE__, __FUNCTION__, __FILE__);
+                }
+                // Add Caffe nets if required
+                while (spNets.size() < numberScales)
+                    addCaffeNetOnThread(
+                        spNets, spCaffeNetOutputBlobs, mPoseModel, mGpuId,
+                        mModelFolder, mProtoTxtPath, mCaffeModelPath, false, mTensorRtPrecision, spNetMemoryArena,
+                        mNetStages);
+                // Stack the frames along the batch (num) axis and run a single forward pass per scale
+                mBatchSize = (int)inputNetDatas.size();
+                mBatchInputNetData.resize(numberScales);
+                for (auto i = 0u ; i < numberScales; i++)
+                {
+                    auto batchSize4D = inputNetDatas[0][i].getSize();
+                    batchSize4D[0] = mBatchSize;
+                    if (!vectorsAreEqual(mBatchInputNetData[i].getSize(), batchSize4D))
+                        mBatchInputNetData[i].reset(batchSize4D);
+                    const auto volume = inputNetDatas[0][i].getVolume();
+                    for (auto batchIndex = 0 ; batchIndex < mBatchSize ; batchIndex++)
+                        std::copy(
+                            inputNetDatas[batchIndex][i].getConstPtr(),
+                            inputNetDatas[batchIndex][i].getConstPtr() + volume,
+                            mBatchInputNetData[i].getPtr() + batchIndex * volume);
+                    spNets.at(i)->forwardPass(mBatchInputNetData[i]);
+                }
+                // The top-down refinement of each element overwrites the network output
+                if (TOP_DOWN_REFINEMENT)
+                {
+                    spBatchNetOutputBlobs.resize(numberScales);
+                    for (auto i = 0u ; i < numberScales; i++)
+                    {
+                        const auto& netOutputBlob = spCaffeNetOutputBlobs.at(i);
+                        auto& batchBlob = spBatchNetOutputBlobs[i];
+                        if (batchBlob == nullptr)
+                            batchBlob = std::make_shared<ArrayCpuGpu<float>>(1,1,1,1);
+                        if (!vectorsAreEqual(batchBlob->shape(), netOutputBlob->shape()))
+                            batchBlob->Reshape(netOutputBlob->shape());
+                        const auto volume = batchBlob->count();
+                        #ifdef USE_CUDA
+                            cudaMemcpy(
+                                batchBlob->mutable_gpu_data(), netOutputBlob->gpu_data(), volume * sizeof(float),
+                                cudaMemcpyDeviceToDevice);
+                            AllocationTracker::recordCopy(volume * sizeof(float), MemoryCopy::DeviceToDevice);
+                        #else
+                            std::copy(netOutputBlob->cpu_data(), netOutputBlob->cpu_data() + volume,
+                                      batchBlob->mutable_cpu_data());
+                        #endif
+                    }
+                }
+                // Per-element blobs (filled by postProcessBatchElement)
+                while (spBatchElementBlobs.size() < numberScales)
+                    spBatchElementBlobs.emplace_back(std::make_shared<ArrayCpuGpu<float>>(1,1,1,1));
+                spBatchElementBlobs.resize(numberScales);
+                // CUDA sanity check
+                #ifdef USE_CUDA
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                #endif
             #else
-                return nullptr;
+                UNUSED(inputNetDatas);
             #endif
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return nullptr;
         }
     }
 
-    const float* PoseExtractorCaffe::getCandidatesGpuConstPtr() const
+    void PoseExtractorCaffe::postProcessBatchElement(
+        const int batchIndex, const std::vector<Array<float>>& inputNetData, const Point<int>& inputDataSize,
+        const std::vector<double>& scaleInputToNetInputs)
     {
         try
         {
             #ifdef USE_CAFFE
-                checkThread();
-                return spPeaksBlob->gpu_data();
+                // Sanity checks
+                if (batchIndex < 0 || batchIndex >= mBatchSize)
+                    error("Batch index out of bounds (" + std::to_string(batchIndex) + " vs. "
+                          + std::to_string(mBatchSize) + ").", __LINE__, __FUNCTION__, __FILE__);
+                if (inputNetData.size() != spBatchElementBlobs.size())
+                    error("Size(inputNetData) must match the number of scales of the batch.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (inputNetData.size() != scaleInputToNetInputs.size())
+                    error("Size(inputNetData) must be same than size(scaleInputToNetInputs).",
+                          __LINE__, __FUNCTION__, __FILE__);
+                // Extract the network output of this element for each scale
+                for (auto i = 0u ; i < spBatchElementBlobs.size() ; i++)
+                {
+                    const auto& batchBlob = (TOP_DOWN_REFINEMENT ? spBatchNetOutputBlobs : spCaffeNetOutputBlobs).at(i);
+                    auto& elementBlob = spBatchElementBlobs[i];
+                    auto elementShape = batchBlob->shape();
+                    elementShape[0] = 1;
+                    if (!vectorsAreEqual(elementBlob->shape(), elementShape))
+                        elementBlob->Reshape(elementShape);
+                    const auto volume = elementBlob->count();
+                    #ifdef USE_CUDA
+                        cudaMemcpy(
+                            elementBlob->mutable_gpu_data(), batchBlob->gpu_data() + batchIndex * volume,
+                            volume * sizeof(float), cudaMemcpyDeviceToDevice);
+                        AllocationTracker::recordCopy(volume * sizeof(float), MemoryCopy::DeviceToDevice);
+                    #else
+                        const auto* batchPtr = batchBlob->cpu_data() + batchIndex * volume;
+                        std::copy(batchPtr, batchPtr + volume, elementBlob->mutable_cpu_data());
+                    #endif
+                }
+                // 2-4. Resize heat maps + merge different scales, NMS, and body part connection
+                postProcessNetOutput(spBatchElementBlobs, inputNetData, inputDataSize, scaleInputToNetInputs);
+                // Re-run on each person (as forwardPass())
+                if (TOP_DOWN_REFINEMENT)
+                    refinePeopleOnRois(inputNetData, scaleInputToNetInputs, 1.4f, false);
+                // CUDA sanity check
+                #ifdef USE_CUDA
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                #endif
             #else
-                return nullptr;
+                UNUSED(batchIndex);
+                UNUSED(inputNetData);
+                UNUSED(inputDataSize);
+                UNUSED(scaleInputToNetInputs);
             #endif
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return nullptr;
         }
     }
 
-    const float* PoseExtractorCaffe::getHeatMapCpuConstPtr() const
+    void PoseExtractorCaffe::forwardPassPipelined(const std::vector<Array<float>>& inputNetData)
     {
         try
         {
             #ifdef USE_CAFFE
-                checkThread();
-                return spHeatMapsBlob->cpu_data();
+                // Sanity checks
+                if (inputNetData.empty())
+                    error("Empty inputNetData.", __LINE__, __FUNCTION__, __FILE__);
+                for (const auto& inputNetDataI : inputNetData)
+                    if (inputNetDataI.empty())
+                        error("Empty inputNetData.", __LINE__, __FUNCTION__, __FILE__);
+                // Only the CUDA full-frame detection is staged. Otherwise (e.g., the ROI tracking mode re-runs the
+                // network during its post-processing, or the network output cache), postProcessPipelined() runs the
+                // whole forwardPass()
+                #ifdef USE_CUDA
+                    const auto staged = (mEnableNet && mRoiTrackingInterval <= 1 && !TOP_DOWN_REFINEMENT
+                                         && pCudaStream != nullptr && spNetOutputCache == nullptr);
+                #else
+                    const auto staged = false;
+                #endif
+                if (!staged)
+                {
+                    mPipelinedSlots.emplace(-1);
+                    return;
+                }
+                #ifdef USE_CUDA
+                    // Process each image - Caffe deep network
+                    const auto numberScales = inputNetData.size();
+                    const auto scaleBatch = (mScaleBatch && numberScales > 1);
+                    if (scaleBatch)
+                        forwardPassScaleBatch(inputNetData);
+                    else
+                    {
+                        while (spNets.size() < numberScales)
+                            addCaffeNetOnThread(
+                                spNets, spCaffeNetOutputBlobs, mPoseModel, mGpuId,
+                                mModelFolder, mProtoTxtPath, mCaffeModelPath, false, mTensorRtPrecision,
+                                spNetMemoryArena, mNetStages);
+                        for (auto i = 0u ; i < numberScales; i++)
+                            spNets.at(i)->forwardPass(inputNetData[i]);
+                    }
+                    // Free slot (a new one if all of them are waiting for their post-processing)
+                    int slot;
+                    if (mPipelinedFreeSlots.empty())
+                    {
+                        slot = (int)spPipelinedBlobs.size();
+                        spPipelinedBlobs.emplace_back();
+                        cudaEvent_t cudaEvent;
+                        cudaEventCreateWithFlags(&cudaEvent, cudaEventDisableTiming);
+                        pPipelinedEvents.emplace_back(cudaEvent);
+                    }
+                    else
+                    {
+                        slot = mPipelinedFreeSlots.back();
+                        mPipelinedFreeSlots.pop_back();
+                    }
+                    // Copy the network output queued after the network itself (default stream), so the next frame
+                    // can overwrite it while this one is post-processed
+                    const auto& netOutputBlobs = (scaleBatch ? spScaleBatchBlobs : spCaffeNetOutputBlobs);
+                    auto& slotBlobs = spPipelinedBlobs[slot];
+                    while (slotBlobs.size() < numberScales)
+                        slotBlobs.emplace_back(std::make_shared<ArrayCpuGpu<float>>(1,1,1,1));
+                    slotBlobs.resize(numberScales);
+                    for (auto i = 0u ; i < numberScales; i++)
+                    {
+                        const auto& netOutputBlob = netOutputBlobs.at(i);
+                        if (!vectorsAreEqual(slotBlobs[i]->shape(), netOutputBlob->shape()))
+                            slotBlobs[i]->Reshape(netOutputBlob->shape());
+                        cudaMemcpyAsync(
+                            slotBlobs[i]->mutable_gpu_data(), netOutputBlob->gpu_data(),
+                            netOutputBlob->count() * sizeof(float), cudaMemcpyDeviceToDevice, 0);
+                        AllocationTracker::recordCopy(
+                            netOutputBlob->count() * sizeof(float), MemoryCopy::DeviceToDevice);
+                    }
+                    cudaEventRecord(pPipelinedEvents[slot], 0);
+                    mPipelinedSlots.emplace(slot);
+                    // CUDA sanity check
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                #endif
             #else
-                return nullptr;
+                UNUSED(inputNetData);
             #endif
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return nullptr;
         }
     }
 
-    const float* PoseExtractorCaffe::getHeatMapGpuConstPtr() const
+    void PoseExtractorCaffe::postProcessPipelined(
+        const std::vector<Array<float>>& inputNetData, const Point<int>& inputDataSize,
+        const std::vector<double>& scaleInputToNetInputs)
     {
         try
         {
             #ifdef USE_CAFFE
-                checkThread();
-                return spHeatMapsBlob->gpu_data();
+                // Sanity checks
+                if (mPipelinedSlots.empty())
+                    error("postProcessPipelined() must follow forwardPassPipelined().",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (inputNetData.size() != scaleInputToNetInputs.size())
+                    error("Size(inputNetData) must be same than size(scaleInputToNetInputs).",
+                          __LINE__, __FUNCTION__, __FILE__);
+                const auto slot = mPipelinedSlots.front();
+                mPipelinedSlots.pop();
+                // Not staged: Whole forward pass
+                if (slot < 0)
+                {
+                    forwardPass(inputNetData, inputDataSize, scaleInputToNetInputs);
+                    return;
+                }
+                // Sanity check
+                if (inputNetData.size() != spPipelinedBlobs.at(slot).size())
+                    error("Size(inputNetData) must match the number of scales of its forwardPassPipelined().",
+                          __LINE__, __FUNCTION__, __FILE__);
+                // 2-4. Resize heat maps + merge different scales, NMS, and body part connection. It only waits for
+                // the network output of this frame, not for the networks queued afterwards
+                pStagedNetOutputEvent = pPipelinedEvents.at(slot);
+                postProcessNetOutput(spPipelinedBlobs[slot], inputNetData, inputDataSize, scaleInputToNetInputs);
+                // The post-processing stream was synchronized, so the slot can be reused
+                mPipelinedFreeSlots.emplace_back(slot);
+                // CUDA sanity check
+                #ifdef USE_CUDA
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                #endif
             #else
-                return nullptr;
+                UNUSED(inputNetData);
+                UNUSED(inputDataSize);
+                UNUSED(scaleInputToNetInputs);
             #endif
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return nullptr;
         }
     }
 
-    std::vector<int> PoseExtractorCaffe::getHeatMapSize() const
+    void PoseExtractorCaffe::reserveNetInputSizes(const std::vector<std::vector<Point<int>>>& netInputSizes)
     {
         try
         {
             #ifdef USE_CAFFE
-                checkThread();
-                return spHeatMapsBlob->shape();
-            #else
+                if (mEnableNet)
+                {
+                    // Tiled inference: A single net, whose batch has all the tiles of the input
+                    if (mNetTileSize.x > 0)
+                    {
+                        if (spNets.empty())
+                            addCaffeNetOnThread(
+                                spNets, spCaffeNetOutputBlobs, mPoseModel, mGpuId,
+                                mModelFolder, mProtoTxtPath, mCaffeModelPath, false, mTensorRtPrecision,
+                                spNetMemoryArena, mNetStages);
+                        std::vector<std::vector<int>> inputSizes4D;
+                        for (const auto& netInputSizesI : netInputSizes)
+                        {
+                            if (netInputSizesI.size() == 1u && (netInputSizesI[0].x > mNetTileSize.x
+                                                                || netInputSizesI[0].y > mNetTileSize.y))
+                            {
+                                const auto tileGrid = getTileGrid(
+                                    netInputSizesI[0], mNetTileSize, mNetTileOverlap,
+                                    getPoseNetDecreaseFactor(mPoseModel));
+                                inputSizes4D.emplace_back(std::vector<int>{
+                                    tileGrid.numberX * tileGrid.numberY, 3, mNetTileSize.y, mNetTileSize.x});
+                            }
+                            else if (!netInputSizesI.empty())
+                                inputSizes4D.emplace_back(
+                                    std::vector<int>{1, 3, netInputSizesI[0].y, netInputSizesI[0].x});
+                        }
+                        spNets.at(0)->reserveInputSizes(inputSizes4D);
+                        return;
+                    }
+                    // Multi-scale batch: A single net, whose batch has all the scales padded to the largest one
+                    if (mScaleBatch)
+                    {
+                        if (spNets.empty())
+                            addCaffeNetOnThread(
+                                spNets, spCaffeNetOutputBlobs, mPoseModel, mGpuId,
+                                mModelFolder, mProtoTxtPath, mCaffeModelPath, false, mTensorRtPrecision,
+                                spNetMemoryArena, mNetStages);
+                        std::vector<std::vector<int>> inputSizes4D;
+                        for (const auto& netInputSizesI : netInputSizes)
+                        {
+                            auto maxSize = Point<int>{0, 0};
+                            for (const auto& netInputSize : netInputSizesI)
+                                maxSize = Point<int>{fastMax(maxSize.x, netInputSize.x),
+                                                     fastMax(maxSize.y, netInputSize.y)};
+                            if (!netInputSizesI.empty())
+                                inputSizes4D.emplace_back(
+                                    std::vector<int>{(int)netInputSizesI.size(), 3, maxSize.y, maxSize.x});
+                        }
+                        spNets.at(0)->reserveInputSizes(inputSizes4D);
+                        return;
+                    }
+                    // Each scale has its own net
+                    auto numberScales = 0u;
+                    for (const auto& netInputSizesI : netInputSizes)
+                        numberScales = fastMax(numberScales, (unsigned int)netInputSizesI.size());
+                    while (spNets.size() < numberScales)
+                        addCaffeNetOnThread(
+                            spNets, spCaffeNetOutputBlobs, mPoseModel, mGpuId,
+                            mModelFolder, mProtoTxtPath, mCaffeModelPath, false, mTensorRtPrecision, spNetMemoryArena,
+                            mNetStages);
+                    for (auto i = 0u ; i < numberScales; i++)
+                    {
+                        std::vector<std::vector<int>> inputSizes4D;
+                        for (const auto& netInputSizesI : netInputSizes)
+                            if (i < netInputSizesI.size())
+                                inputSizes4D.emplace_back(
+                                    std::vector<int>{1, 3, netInputSizesI[i].y, netInputSizesI[i].x});
+                        spNets.at(i)->reserveInputSizes(inputSizes4D);
+                    }
+                }
+            #else
+                UNUSED(netInputSizes);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorCaffe::forwardPassScaleBatch(const std::vector<Array<float>>& inputNetData)
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                if (spNets.empty())
+                    addCaffeNetOnThread(
+                        spNets, spCaffeNetOutputBlobs, mPoseModel, mGpuId,
+                        mModelFolder, mProtoTxtPath, mCaffeModelPath, false, mTensorRtPrecision, spNetMemoryArena,
+                        mNetStages);
+                // Common size (the largest width and height of all the scales)
+                const auto numberScales = (int)inputNetData.size();
+                auto maxWidth = 0;
+                auto maxHeight = 0;
+                for (const auto& inputNetDataI : inputNetData)
+                {
+                    if (inputNetDataI.getSize(0) != 1)
+                        error("Each scale of inputNetData must have a single image.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    maxWidth = fastMax(maxWidth, inputNetDataI.getSize(3));
+                    maxHeight = fastMax(maxHeight, inputNetDataI.getSize(2));
+                }
+                // Stack the scales along the batch axis, padded at the right and bottom with black pixels. The
+                // pinned buffer is uploaded with a single host-to-device copy by the net
+                const std::vector<int> batchSize4D{numberScales, 3, maxHeight, maxWidth};
+                if (!vectorsAreEqual(mScaleBatchInputNetData.getSize(), batchSize4D))
+                    mScaleBatchInputNetData.resetPinned(batchSize4D);
+                const auto paddingValues = getNetInputPaddingValues(mPoseModel);
+                const auto batchArea = maxWidth * maxHeight;
+                for (auto i = 0 ; i < numberScales ; i++)
+                {
+                    const auto width = inputNetData[i].getSize(3);
+                    const auto height = inputNetData[i].getSize(2);
+                    for (auto c = 0 ; c < 3 ; c++)
+                    {
+                        const auto* sourcePtr = inputNetData[i].getConstPtr() + c * width * height;
+                        auto* targetPtr = mScaleBatchInputNetData.getPtr() + (3 * i + c) * batchArea;
+                        for (auto y = 0 ; y < height ; y++)
+                        {
+                            std::copy(sourcePtr + y * width, sourcePtr + (y+1) * width, targetPtr + y * maxWidth);
+                            std::fill(targetPtr + y * maxWidth + width, targetPtr + (y+1) * maxWidth,
+                                      paddingValues[c]);
+                        }
+                        std::fill(targetPtr + height * maxWidth, targetPtr + batchArea, paddingValues[c]);
+                    }
+                }
+                // Single forward pass for all the scales
+                spNets.at(0)->forwardPass(mScaleBatchInputNetData);
+                if (spNets.at(0)->getOutputLayout() != BlobLayout::Nchw)
+                    error("`--scale_batch` requires a network with an NCHW output (the network output is cropped).",
+                          __LINE__, __FUNCTION__, __FILE__);
+                // Crop the valid (top-left) network output of each scale
+                const auto& batchBlob = spCaffeNetOutputBlobs.at(0);
+                const auto numberChannels = batchBlob->shape(1);
+                const auto batchOutputHeight = batchBlob->shape(2);
+                const auto batchOutputWidth = batchBlob->shape(3);
+                while (spScaleBatchBlobs.size() < inputNetData.size())
+                    spScaleBatchBlobs.emplace_back(std::make_shared<ArrayCpuGpu<float>>(1,1,1,1));
+                spScaleBatchBlobs.resize(inputNetData.size());
+                for (auto i = 0 ; i < numberScales ; i++)
+                {
+                    // The network output is proportional to its input (e.g., 1/8 for BODY_25)
+                    const auto outputWidth = batchOutputWidth * inputNetData[i].getSize(3) / maxWidth;
+                    const auto outputHeight = batchOutputHeight * inputNetData[i].getSize(2) / maxHeight;
+                    if (outputWidth * maxWidth != batchOutputWidth * inputNetData[i].getSize(3)
+                        || outputHeight * maxHeight != batchOutputHeight * inputNetData[i].getSize(2))
+                        error("The network output size of each scale must be proportional to its input size (use a"
+                              " `--net_resolution` multiple of 16).", __LINE__, __FUNCTION__, __FILE__);
+                    auto& scaleBlob = spScaleBatchBlobs[i];
+                    const std::vector<int> scaleShape{1, numberChannels, outputHeight, outputWidth};
+                    if (!vectorsAreEqual(scaleBlob->shape(), scaleShape))
+                        scaleBlob->Reshape(scaleShape);
+                    const auto batchOffset = i * numberChannels * batchOutputHeight * batchOutputWidth;
+                    #ifdef USE_CUDA
+                        // All the channels with a single (3-D) copy
+                        cudaMemcpy3DParms copyParameters = {};
+                        copyParameters.srcPtr = make_cudaPitchedPtr(
+                            (void*)(batchBlob->gpu_data() + batchOffset), batchOutputWidth * sizeof(float),
+                            batchOutputWidth, batchOutputHeight);
+                        copyParameters.dstPtr = make_cudaPitchedPtr(
+                            scaleBlob->mutable_gpu_data(), outputWidth * sizeof(float), outputWidth, outputHeight);
+                        copyParameters.extent = make_cudaExtent(
+                            outputWidth * sizeof(float), outputHeight, numberChannels);
+                        copyParameters.kind = cudaMemcpyDeviceToDevice;
+                        cudaMemcpy3D(&copyParameters);
+                        AllocationTracker::recordCopy(
+                            scaleBlob->count() * sizeof(float), MemoryCopy::DeviceToDevice);
+                    #else
+                        const auto* batchPtr = batchBlob->cpu_data() + batchOffset;
+                        auto* scalePtr = scaleBlob->mutable_cpu_data();
+                        for (auto c = 0 ; c < numberChannels ; c++)
+                            for (auto y = 0 ; y < outputHeight ; y++)
+                            {
+                                const auto* rowPtr = batchPtr + (c * batchOutputHeight + y) * batchOutputWidth;
+                                std::copy(rowPtr, rowPtr + outputWidth,
+                                          scalePtr + (c * outputHeight + y) * outputWidth);
+                            }
+                    #endif
+                }
+                #ifdef USE_CUDA
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                #endif
+            #else
+                UNUSED(inputNetData);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorCaffe::forwardPassTiled(const Array<float>& inputNetData)
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                if (spNets.empty())
+                    addCaffeNetOnThread(
+                        spNets, spCaffeNetOutputBlobs, mPoseModel, mGpuId,
+                        mModelFolder, mProtoTxtPath, mCaffeModelPath, false, mTensorRtPrecision, spNetMemoryArena,
+                        mNetStages);
+                if (inputNetData.getSize(0) != 1)
+                    error("The tiled inputNetData must have a single image.", __LINE__, __FUNCTION__, __FILE__);
+                const auto width = inputNetData.getSize(3);
+                const auto height = inputNetData.getSize(2);
+                const auto netDecreaseFactor = (int)getPoseNetDecreaseFactor(mPoseModel);
+                const auto tileGrid = getTileGrid(
+                    Point<int>{width, height}, mNetTileSize, mNetTileOverlap, netDecreaseFactor);
+                const auto numberTiles = tileGrid.numberX * tileGrid.numberY;
+                // Stack the tiles along the batch axis, padded with black pixels where they exceed the input. The
+                // pinned buffer is uploaded with a single host-to-device copy by the net
+                const std::vector<int> tilesSize4D{numberTiles, 3, mNetTileSize.y, mNetTileSize.x};
+                if (!vectorsAreEqual(mTiledInputNetData.getSize(), tilesSize4D))
+                    mTiledInputNetData.resetPinned(tilesSize4D);
+                const auto paddingValues = getNetInputPaddingValues(mPoseModel);
+                const auto tileArea = mNetTileSize.x * mNetTileSize.y;
+                for (auto tileY = 0 ; tileY < tileGrid.numberY ; tileY++)
+                {
+                    const auto originY = tileGrid.originsY[tileY];
+                    const auto validHeight = fastMin(mNetTileSize.y, height - originY);
+                    for (auto tileX = 0 ; tileX < tileGrid.numberX ; tileX++)
+                    {
+                        const auto originX = tileGrid.originsX[tileX];
+                        const auto validWidth = fastMin(mNetTileSize.x, width - originX);
+                        const auto tile = tileY * tileGrid.numberX + tileX;
+                        for (auto c = 0 ; c < 3 ; c++)
+                        {
+                            const auto* sourcePtr = inputNetData.getConstPtr() + (c * height + originY) * width
+                                                  + originX;
+                            auto* targetPtr = mTiledInputNetData.getPtr() + (3 * tile + c) * tileArea;
+                            for (auto y = 0 ; y < validHeight ; y++)
+                            {
+                                std::copy(sourcePtr + y * width, sourcePtr + y * width + validWidth,
+                                          targetPtr + y * mNetTileSize.x);
+                                std::fill(targetPtr + y * mNetTileSize.x + validWidth,
+                                          targetPtr + (y+1) * mNetTileSize.x, paddingValues[c]);
+                            }
+                            std::fill(targetPtr + validHeight * mNetTileSize.x, targetPtr + tileArea,
+                                      paddingValues[c]);
+                        }
+                    }
+                }
+                // Single forward pass for all the tiles
+                spNets.at(0)->forwardPass(mTiledInputNetData);
+                if (spNets.at(0)->getOutputLayout() != BlobLayout::Nchw)
+                    error("`--tiled_resolution` requires a network with an NCHW output (the tiles are stitched).",
+                          __LINE__, __FUNCTION__, __FILE__);
+                // Stitch the network output of the tiles (in network output pixels)
+                const auto& tilesBlob = spCaffeNetOutputBlobs.at(0);
+                const auto numberChannels = tilesBlob->shape(1);
+                if (tilesBlob->shape(2) * netDecreaseFactor != mNetTileSize.y
+                    || tilesBlob->shape(3) * netDecreaseFactor != mNetTileSize.x
+                    || height % netDecreaseFactor != 0 || width % netDecreaseFactor != 0)
+                    error("The tile size and the tiled resolution must be multiples of the network stride (use a"
+                          " `--net_resolution` and `--tiled_resolution` multiple of 16).",
+                          __LINE__, __FUNCTION__, __FILE__);
+                auto outputTileGrid = tileGrid;
+                outputTileGrid.tileWidth = tilesBlob->shape(3);
+                outputTileGrid.tileHeight = tilesBlob->shape(2);
+                for (auto tileX = 0 ; tileX < tileGrid.numberX ; tileX++)
+                    outputTileGrid.originsX[tileX] /= netDecreaseFactor;
+                for (auto tileY = 0 ; tileY < tileGrid.numberY ; tileY++)
+                    outputTileGrid.originsY[tileY] /= netDecreaseFactor;
+                if (spTiledBlobs.empty())
+                    spTiledBlobs.emplace_back(std::make_shared<ArrayCpuGpu<float>>(1,1,1,1));
+                auto& tiledBlob = spTiledBlobs.at(0);
+                const std::vector<int> tiledShape{
+                    1, numberChannels, height / netDecreaseFactor, width / netDecreaseFactor};
+                if (!vectorsAreEqual(tiledBlob->shape(), tiledShape))
+                    tiledBlob->Reshape(tiledShape);
+                const std::array<int, 4> targetSize{1, numberChannels, tiledShape[2], tiledShape[3]};
+                const std::array<int, 4> sourceSize{
+                    numberTiles, numberChannels, outputTileGrid.tileHeight, outputTileGrid.tileWidth};
+                #ifdef USE_CUDA
+                    tileStitchGpu(
+                        tiledBlob->mutable_gpu_data(), tilesBlob->gpu_data(), targetSize, sourceSize, outputTileGrid);
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                #else
+                    tileStitchCpu(
+                        tiledBlob->mutable_cpu_data(), tilesBlob->cpu_data(), targetSize, sourceSize, outputTileGrid);
+                #endif
+            #else
+                UNUSED(inputNetData);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorCaffe::waitForNetOutputOnStream()
+    {
+        try
+        {
+            #if defined USE_CAFFE && defined USE_CUDA
+                // Queue a dependency from the default stream (network forward passes and Caffe copies) into the
+                // post-processing stream, without blocking the CPU thread
+                if (pCudaStream != nullptr)
+                {
+                    // Pipelined forward pass: The network output was staged before the following frame was queued
+                    if (pStagedNetOutputEvent != nullptr)
+                    {
+                        cudaStreamWaitEvent(pCudaStream, pStagedNetOutputEvent, 0);
+                        pStagedNetOutputEvent = nullptr;
+                    }
+                    else
+                    {
+                        cudaEventRecord(pNetOutputEvent, 0);
+                        cudaStreamWaitEvent(pCudaStream, pNetOutputEvent, 0);
+                    }
+                }
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorCaffe::recordGpuTimingEvent(const unsigned int eventIndex, CUstream_st* const cudaStream)
+    {
+        try
+        {
+            #if defined USE_CAFFE && defined USE_CUDA
+                while (pGpuTimingEvents.size() <= eventIndex)
+                {
+                    cudaEvent_t cudaEvent;
+                    cudaEventCreate(&cudaEvent);
+                    pGpuTimingEvents.emplace_back(cudaEvent);
+                }
+                cudaEventRecord(pGpuTimingEvents[eventIndex], cudaStream);
+            #else
+                UNUSED(eventIndex);
+                UNUSED(cudaStream);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorCaffe::finishGpuTiming()
+    {
+        try
+        {
+            #if defined USE_CAFFE && defined USE_CUDA
+                if (pGpuTimingEvents.size() == 3u)
+                {
+                    cudaEventSynchronize(pGpuTimingEvents[2]);
+                    // CUDA events only measure durations, so they are anchored to the end of the post-processing
+                    const auto endNs = DatumTiming::now();
+                    auto netMs = 0.f;
+                    auto postProcessingMs = 0.f;
+                    cudaEventElapsedTime(&netMs, pGpuTimingEvents[0], pGpuTimingEvents[1]);
+                    cudaEventElapsedTime(&postProcessingMs, pGpuTimingEvents[1], pGpuTimingEvents[2]);
+                    const auto netEndNs = endNs - (long long)(1e6 * postProcessingMs);
+                    mGpuTimingEvents.clear();
+                    mGpuTimingEvents.emplace_back(
+                        DatumTimingEvent{"Pose network (GPU)", netEndNs - (long long)(1e6 * netMs), netEndNs});
+                    mGpuTimingEvents.emplace_back(DatumTimingEvent{"Pose post-processing (GPU)", netEndNs, endNs});
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                }
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool PoseExtractorCaffe::readNetOutputCache(const std::string& key, const std::size_t numberScales)
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                if (!spNetOutputCache->get(mNetOutputCacheArrays, key))
+                    return false;
+                // Sanity check
+                if (mNetOutputCacheArrays.size() != numberScales || numberScales > spCaffeNetOutputBlobs.size())
+                    error("The cached network output does not match the number of scales.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                // Copy it into the network output blobs (uploaded into the GPU when the post-processing reads them)
+                for (auto i = 0u ; i < mNetOutputCacheArrays.size() ; i++)
+                {
+                    const auto& netOutput = mNetOutputCacheArrays[i];
+                    auto& netOutputBlob = spCaffeNetOutputBlobs[i];
+                    const std::vector<int> netOutputShape{1, netOutput.getSize(0), netOutput.getSize(1),
+                                                          netOutput.getSize(2)};
+                    if (!vectorsAreEqual(netOutputBlob->shape(), netOutputShape))
+                        netOutputBlob->Reshape(netOutputShape);
+                    std::copy(netOutput.getConstPtr(), netOutput.getConstPtr() + netOutput.getVolume(),
+                              netOutputBlob->mutable_cpu_data());
+                }
+                return true;
+            #else
+                UNUSED(key);
+                UNUSED(numberScales);
+                return false;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void PoseExtractorCaffe::addNetOutputCache(const std::string& key, const std::size_t numberScales)
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                // Network output of each scale, as [#channels x height x width]
+                mNetOutputCacheArrays.resize(numberScales);
+                for (auto i = 0u ; i < mNetOutputCacheArrays.size() ; i++)
+                {
+                    const auto& netOutputBlob = spCaffeNetOutputBlobs.at(i);
+                    const std::vector<int> netOutputSize{
+                        netOutputBlob->shape(1), netOutputBlob->shape(2), netOutputBlob->shape(3)};
+                    if (!vectorsAreEqual(mNetOutputCacheArrays[i].getSize(), netOutputSize))
+                        mNetOutputCacheArrays[i].reset(netOutputSize);
+                    const auto* const netOutputPtr = netOutputBlob->cpu_data();
+                    std::copy(netOutputPtr, netOutputPtr + netOutputBlob->count(), mNetOutputCacheArrays[i].getPtr());
+                }
+                spNetOutputCache->add(mNetOutputCacheArrays, key);
+            #else
+                UNUSED(key);
+                UNUSED(numberScales);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorCaffe::updateHeatMapsBlob() const
+    {
+        try
+        {
+            #if defined USE_CAFFE && defined USE_CUDA
+                if (!mHeatMapsBlobUpdated)
+                {
+                    // Fused resize and NMS: The body part (and background) channels were not upsampled yet
+                    // Network resolution PAFs: The PAF channels were not upsampled yet
+                    if (mFusedNms || mPafLowResolution)
+                    {
+                        const auto numberBodyParts = (int)getPoseNumberBodyParts(mPoseModel);
+                        const auto firstPafChannel = numberBodyParts + (addBkgChannel(mPoseModel) ? 1 : 0);
+                        spResizeAndMergeCaffe->setChannelRange(
+                            (mFusedNms ? 0 : firstPafChannel), (mPafLowResolution ? -1 : firstPafChannel));
+                        spResizeAndMergeCaffe->Forward(mLowResolutionNetOutputBlobs, {spHeatMapsBlob.get()});
+                    }
+                    if (pHeatMapsHalfGpuPtr != nullptr)
+                        halfCast(spHeatMapsBlob->mutable_gpu_data(), pHeatMapsHalfGpuPtr, spHeatMapsBlob->count(),
+                                 pCudaStream);
+                    // Caffe reads the blob from the default stream
+                    cudaStreamSynchronize(pCudaStream);
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                }
+                mHeatMapsBlobUpdated = true;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    int PoseExtractorCaffe::refinePeopleOnRois(
+        const std::vector<Array<float>>& inputNetData, const std::vector<double>& scaleInputToNetInputs,
+        const float roiEnlargement, const bool trackingMode)
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                // The crops are processed with the unfused resize and NMS
+                mFusedNms = false;
+                mPafLowResolution = false;
+                mLowResolutionNetOutputBlobs.clear();
+                pSingleScaleNetOutputBlob = nullptr;
+                spResizeAndMergeCaffe->setChannelRange(0);
+                spNmsCaffe->setLowResolutionBottom(nullptr);
+                spBodyPartConnectorCaffe->setLowResolutionPafs(nullptr);
+                auto numberPeopleRefined = 0;
+                std::vector<bool> peopleRefined(mPoseKeypoints.getSize(0), false);
+                const auto nmsThreshold = (float)get(PoseProperty::NMSThreshold);
+                // Target size (squared, so the crops of all the people are run as a single batch)
+                const auto inputHeight = inputNetData[0].getSize(2);
+                const auto inputWidth = inputNetData[0].getSize(3);
+                // Optimal case (using training size)
+                auto targetSide = 368;
+                // Low resolution cases: Keep same area than biggest scale (rounded to a multiple of 16)
+                if (inputHeight < 368 && inputNetData[0].getVolume(2,3) < 135424) // 368^2
+                {
+                    const auto minSide = fastMin(368, fastMin(inputHeight, inputWidth));
+                    const auto maxSide = fastMin(368, fastMax(inputHeight, inputWidth));
+                    targetSide = fastMax(16, 16 * positiveIntRound(std::sqrt(float(minSide * maxSide)) / 16.f));
+                }
+                const Point<int> targetSize{targetSide, targetSide};
+                // Get each person rectangle
+                std::vector<int> cropPeople;
+                std::vector<Rectangle<int>> cropRectangles;
+                std::vector<double> cropScales;
+                for (auto person = 0 ; person < mPoseKeypoints.getSize(0) ; person++)
+                {
+                    // Get person rectangle resized to input size
+                    const auto rectangleF = getKeypointsRectangle(mPoseKeypoints, person, nmsThreshold)
+                                          / mScaleNetToOutput;
+                    // Make rectangle bigger to make sure the whole body is inside
+                    Rectangle<int> rectangleInt{
+                        positiveIntRound(rectangleF.x - 0.5f*(roiEnlargement-1.f)*rectangleF.width),
+                        positiveIntRound(rectangleF.y - 0.5f*(roiEnlargement-1.f)*rectangleF.height),
+                        positiveIntRound(rectangleF.width*roiEnlargement),
+                        positiveIntRound(rectangleF.height*roiEnlargement)
+                    };
+                    keepRoiInside(rectangleInt, inputWidth, inputHeight);
+                    if (rectangleInt.width < 1 || rectangleInt.height < 1)
+                        continue;
+                    const Point<int> inputSizeInit{rectangleInt.width, rectangleInt.height};
+                    /*const*/ auto scaleNetToRoi = resizeGetScaleFactor(inputSizeInit, targetSize);
+                    // Update rectangle to avoid black padding and instead take full advantage of the network area
+                    const auto padding = Point<int>{
+                        (int)std::round((targetSize.x-1) / scaleNetToRoi + 1 - inputSizeInit.x),
+                        (int)std::round((targetSize.y-1) / scaleNetToRoi + 1 - inputSizeInit.y)
+                    };
+                    // Width requires padding
+                    if (padding.x > 2 || padding.y > 2) // 2 pixels as threshold
+                    {
+                        if (padding.x > 2) // 2 pixels as threshold
+                        {
+                            rectangleInt.x -= padding.x/2;
+                            rectangleInt.width += padding.x;
+                        }
+                        else if (padding.y > 2) // 2 pixels as threshold
+                        {
+                            rectangleInt.y -= padding.y/2;
+                            rectangleInt.height += padding.y;
+                        }
+                        keepRoiInside(rectangleInt, inputWidth, inputHeight);
+                        scaleNetToRoi = resizeGetScaleFactor(
+                            Point<int>{rectangleInt.width, rectangleInt.height}, targetSize);
+                    }
+                    // No if scaleNetToRoi < 1 (image would be shrinked, so we assume best result already obtained)
+                    // Tracking: Always, as there is no other result for this frame
+                    if (scaleNetToRoi > 1 || trackingMode)
+                    {
+                        cropPeople.emplace_back(person);
+                        cropRectangles.emplace_back(rectangleInt);
+                        cropScales.emplace_back(scaleNetToRoi);
+                    }
+                }
+                // Re-Process the crops, in batches of up to TOP_DOWN_MAX_BATCH_SIZE crops
+                #ifdef USE_CUDA
+                    auto* const netCaffe = dynamic_cast<NetCaffe*>(spNets.at(0).get());
+                    if (netCaffe != nullptr && !cropPeople.empty())
+                    {
+                        // Whole network input to the GPU once, the crops are resized from it
+                        if (spRoiFrameBlob == nullptr)
+                            spRoiFrameBlob = std::make_shared<ArrayCpuGpu<float>>(1,1,1,1);
+                        if (!vectorsAreEqual(spRoiFrameBlob->shape(), inputNetData[0].getSize()))
+                            spRoiFrameBlob->Reshape(inputNetData[0].getSize());
+                        std::copy(
+                            inputNetData[0].getConstPtr(), inputNetData[0].getConstPtr() + inputNetData[0].getVolume(),
+                            spRoiFrameBlob->mutable_cpu_data());
+                    }
+                #else
+                    NetCaffe* const netCaffe = nullptr;
+                #endif
+                if (spRoiElementBlob == nullptr)
+                    spRoiElementBlob = std::make_shared<ArrayCpuGpu<float>>(1,1,1,1);
+                for (auto batchBegin = 0u ; batchBegin < cropPeople.size() ; batchBegin += TOP_DOWN_MAX_BATCH_SIZE)
+                {
+                    const auto batchSize = (int)fastMin(
+                        TOP_DOWN_MAX_BATCH_SIZE, (unsigned int)cropPeople.size() - batchBegin);
+                    const std::vector<int> batchSize4D{batchSize, 3, targetSide, targetSide};
+                    // 1. Caffe deep network
+                    // CUDA: The crops are resized on the GPU directly into the network input
+                    if (netCaffe != nullptr)
+                    {
+                        #ifdef USE_CUDA
+                            std::vector<std::array<float, 6>> affineMatrices(batchSize);
+                            for (auto crop = 0 ; crop < batchSize ; crop++)
+                            {
+                                const auto& rectangleInt = cropRectangles[batchBegin + crop];
+                                const auto scaleRoiToNet = float(1. / cropScales[batchBegin + crop]);
+                                affineMatrices[crop] = std::array<float, 6>{
+                                    scaleRoiToNet, 0.f, (float)rectangleInt.x,
+                                    0.f, scaleRoiToNet, (float)rectangleInt.y};
+                            }
+                            auto* netInputGpuPtr = netCaffe->getInputGpuPtr(batchSize4D);
+                            warpAffineCropsGpu(
+                                netInputGpuPtr, spRoiFrameBlob->gpu_data(), inputWidth, inputHeight, affineMatrices,
+                                targetSide, targetSide, getNetInputPaddingValues(mPoseModel));
+                            netCaffe->forwardPassOnGpuInput();
+                        #endif
+                    }
+                    // CPU: Each crop resized with OpenCV into its element of the batch
+                    else
+                    {
+                        if (!vectorsAreEqual(mRoiInputNetData.getSize(), batchSize4D))
+                            mRoiInputNetData.reset(batchSize4D);
+                        const auto areaInput = inputNetData[0].getVolume(2,3);
+                        const auto areaRoi = targetSize.area();
+                        for (auto crop = 0 ; crop < batchSize ; crop++)
+                        {
+                            const auto& rectangleInt = cropRectangles[batchBegin + crop];
+                            for (auto c = 0u ; c < 3u ; c++)
+                            {
+                                // Input image
+                                const cv::Mat wholeInputCvMat(
+                                    inputHeight, inputWidth, CV_32FC1,
+                                    inputNetData[0].getPseudoConstPtr() + c * areaInput);
+                                // Input image cropped
+                                const cv::Mat inputCvMat(
+                                    wholeInputCvMat,
+                                    cv::Rect{rectangleInt.x, rectangleInt.y, rectangleInt.width, rectangleInt.height});
+                                // Resize image for mRoiInputNetData
+                                cv::Mat resizedImageCvMat(
+                                    targetSide, targetSide, CV_32FC1,
+                                    mRoiInputNetData.getPtr() + (3 * crop + c) * areaRoi);
+                                resizeFixedAspectRatio(
+                                    resizedImageCvMat, inputCvMat, cropScales[batchBegin + crop], targetSize);
+                            }
+                        }
+                        spNets.at(0)->forwardPass(mRoiInputNetData);
+                    }
+                    const auto& netOutputBlob = spCaffeNetOutputBlobs[0];
+                    auto elementShape = netOutputBlob->shape();
+                    elementShape[0] = 1;
+                    if (!vectorsAreEqual(spRoiElementBlob->shape(), elementShape))
+                        spRoiElementBlob->Reshape(elementShape);
+                    const std::vector<std::shared_ptr<ArrayCpuGpu<float>>> caffeNetOutputBlob{spRoiElementBlob};
+                    // Reshape blobs (all the crops share the same size)
+                    const std::vector<int> roiSize4D{1, 3, targetSide, targetSide};
+                    if (!vectorsAreEqual(mNetInput4DSizes.at(0), roiSize4D))
+                    {
+                        mNetInput4DSizes.at(0) = roiSize4D;
+                        reshapePoseExtractorCaffe(
+                            spResizeAndMergeCaffe, spNmsCaffe,
+                            spBodyPartConnectorCaffe, spMaximumCaffe,
+                            caffeNetOutputBlob, spHeatMapsBlob, spPeaksBlob,
+                            spMaximumPeaksBlob, 1.f, mPoseModel, mGpuId,
+                            mUpsamplingRatio);
+                    }
+                    const auto caffeNetOutputBlobsNew = arraySharedToPtr(caffeNetOutputBlob);
+                    for (auto crop = 0 ; crop < batchSize ; crop++)
+                    {
+                        const auto person = cropPeople[batchBegin + crop];
+                        const auto& rectangleInt = cropRectangles[batchBegin + crop];
+                        const auto scaleNetToRoi = cropScales[batchBegin + crop];
+                        // Network output of this crop
+                        const auto volume = spRoiElementBlob->count();
+                        #ifdef USE_CUDA
+                            cudaMemcpy(
+                                spRoiElementBlob->mutable_gpu_data(), netOutputBlob->gpu_data() + crop * volume,
+                                volume * sizeof(float), cudaMemcpyDeviceToDevice);
+                            AllocationTracker::recordCopy(volume * sizeof(float), MemoryCopy::DeviceToDevice);
+                        #else
+                            const auto* batchPtr = netOutputBlob->cpu_data() + crop * volume;
+                            std::copy(batchPtr, batchPtr + volume, spRoiElementBlob->mutable_cpu_data());
+                        #endif
+                        waitForNetOutputOnStream();
+                        // 2. Resize heat maps + merge different scales
+                        const std::vector<float> floatScaleRatiosNew{(float)scaleInputToNetInputs[0]};
+                        spResizeAndMergeCaffe->setScaleRatios(floatScaleRatiosNew);
+                        spResizeAndMergeCaffe->Forward(
+                            caffeNetOutputBlobsNew, {spHeatMapsBlob.get()});
+                        // Get scale net to output (i.e., image input)
+                        const auto scaleRoiToOutput = float(mScaleNetToOutput / scaleNetToRoi);
+                        // 3. Get peaks by Non-Maximum Suppression
+                        const auto nmsThresholdRefined = (trackingMode ? nmsThreshold : 0.02f);
+                        spNmsCaffe->setThreshold(nmsThresholdRefined);
+                        const auto nmsOffsetNew = float(0.5/double(scaleRoiToOutput));
+                        spNmsCaffe->setOffset(Point<float>{nmsOffsetNew, nmsOffsetNew});
+                        spNmsCaffe->Forward({spHeatMapsBlob.get()}, {spPeaksBlob.get()});
+                        // Define poseKeypoints
+                        Array<float> poseKeypoints;
+                        Array<float> poseScores;
+                        // 4. Connecting body parts
+                        // Get scale net to output (i.e., image input)
+                        spBodyPartConnectorCaffe->setScaleNetToOutput(scaleRoiToOutput);
+                        spBodyPartConnectorCaffe->setInterThreshold(
+                            trackingMode ? (float)get(PoseProperty::ConnectInterThreshold) : 0.01f);
+                        spBodyPartConnectorCaffe->Forward(
+                            {spHeatMapsBlob.get(), spPeaksBlob.get()}, poseKeypoints, poseScores);
+                        // If detected people in new subnet
+                        if (!poseKeypoints.empty())
+                        {
+                            // // Scale back keypoints
+                            const auto xOffset = float(rectangleInt.x*mScaleNetToOutput);
+                            const auto yOffset = float(rectangleInt.y*mScaleNetToOutput);
+                            scaleKeypoints2d(poseKeypoints, 1.f, 1.f, xOffset, yOffset);
+                            // Re-assign person back
+                            // // Option a) Just use biggest person (simplest but fails with crowded people)
+                            // const auto personRefined = getBiggestPerson(poseKeypoints, nmsThreshold);
+                            // Option b) Get minimum keypoint distance
+                            // Get min distance
+                            int personRefined = -1;
+                            float personAverageDistance = std::numeric_limits<float>::max();
+                            for (auto person2 = 0 ; person2 < poseKeypoints.getSize(0) ; person2++)
+                            {
+                                // Get average distance
+                                const auto currentAverageDistance = getDistanceAverage(
+                                    mPoseKeypoints, person, poseKeypoints, person2, nmsThreshold);
+                                // Update person
+                                if (personAverageDistance > currentAverageDistance
+                                    && getNonZeroKeypoints(poseKeypoints, person2, nmsThreshold)
+                                        >= 0.75*getNonZeroKeypoints(mPoseKeypoints, person, nmsThreshold))
+                                {
+                                    personRefined = person2;
+                                    personAverageDistance = currentAverageDistance;
+                                }
+                            }
+                            // Get max ROI
+                            int personRefinedRoi = -1;
+                            float personRoi = -1.f;
+                            for (auto person2 = 0 ; person2 < poseKeypoints.getSize(0) ; person2++)
+                            {
+                                // Get ROI
+                                const auto currentRoi = getKeypointsRoi(
+                                    mPoseKeypoints, person, poseKeypoints, person2, nmsThreshold);
+                                // Update person
+                                if (personRoi < currentRoi
+                                    && getNonZeroKeypoints(poseKeypoints, person2, nmsThreshold)
+                                        >= 0.75*getNonZeroKeypoints(mPoseKeypoints, person, nmsThreshold))
+                                {
+                                    personRefinedRoi = person2;
+                                    personRoi = currentRoi;
+                                }
+                            }
+                            // If good refined candidate found
+                            // I.e., if both max ROI and min dist match on same person id
+                            if (personRefined == personRefinedRoi && personRefined > -1)
+                            {
+                                // Update only if avg dist is small enough
+                                const auto personRectangle = getKeypointsRectangle(
+                                    mPoseKeypoints, person, nmsThreshold);
+                                // Tracking: The person might have moved since the previous frame
+                                const auto personRatio = (trackingMode
+                                    ? 0.5f * (float)std::sqrt(personRectangle.width*personRectangle.width
+                                                              + personRectangle.height*personRectangle.height)
+                                    : 0.1f * (float)std::sqrt(personRectangle.x*personRectangle.x
+                                                              + personRectangle.y*personRectangle.y));
+                                // if (mPoseScores[person] < poseScores[personRefined]) // This harms accuracy
+                                if (personAverageDistance < personRatio)
+                                {
+                                    const auto personArea = mPoseKeypoints.getVolume(1,2);
+                                    const auto personIndex = person * personArea;
+                                    const auto personRefinedIndex = personRefined * personArea;
+                                    // mPoseKeypoints: Update keypoints
+                                    // Option a) Using refined ones
+                                    std::copy(
+                                        poseKeypoints.getPtr() + personRefinedIndex,
+                                        poseKeypoints.getPtr() + personRefinedIndex + personArea,
+                                        mPoseKeypoints.getPtr() + personIndex);
+                                    mPoseScores[person] = poseScores[personRefined];
+                                    peopleRefined[person] = true;
+                                    numberPeopleRefined++;
+                                    // // Option b) Using ones with highest score (-6% acc single scale)
+                                    // // Fill gaps
+                                    // for (auto part = 0 ; part < mPoseKeypoints.getSize(1) ; part++)
+                                    // {
+                                    //     // For currently empty keypoints
+                                    //     const auto partIndex = personIndex+3*part;
+                                    //     const auto partRefinedIndex = personRefinedIndex+3*part;
+                                    //     const auto scoreDifference = poseKeypoints[partRefinedIndex+2]
+                                    //                                - mPoseKeypoints[partIndex+2];
+                                    //     if (scoreDifference > 0)
+                                    //     {
+                                    //         const auto x = poseKeypoints[partRefinedIndex];
+                                    //         const auto y = poseKeypoints[partRefinedIndex + 1];
+                                    //         mPoseKeypoints[partIndex] = x;
+                                    //         mPoseKeypoints[partIndex+1] = y;
+                                    //         mPoseKeypoints[partIndex+2] += scoreDifference;
+                                    //         mPoseScores[person] += scoreDifference;
+                                    //     }
+                                    // }
+
+                                    // No acc improvement (-0.05% acc single scale)
+                                    // // Finding all missing peaks (CPM-style)
+                                    // // Only if no other person in there (otherwise 2% accuracy drop)
+                                    // if (getNonZeroKeypoints(mPoseKeypoints, person, nmsThresholdRefined) > 0)
+                                    // {
+                                    //     // Get whether 0% ROI with other people
+                                    //     // Get max ROI
+                                    //     bool overlappingPerson = false;
+                                    //     for (auto person2 = 0 ; person2 < mPoseKeypoints.getSize(0) ; person2++)
+                                    //     {
+                                    //         if (person != person2)
+                                    //         {
+                                    //             // Get ROI
+                                    //             const auto currentRoi = getKeypointsRoi(
+                                    //                 mPoseKeypoints, person, person2, nmsThreshold);
+                                    //             // Update person
+                                    //             if (currentRoi > 0.f)
+                                    //             {
+                                    //                 overlappingPerson = true;
+                                    //                 break;
+                                    //             }
+                                    //         }
+                                    //     }
+                                    //     if (!overlappingPerson)
+                                    //     {
+                                    //         // Get keypoint with maximum probability per channel
+                                    //         spMaximumCaffe->Forward(
+                                    //             {spHeatMapsBlob.get()}, {spMaximumPeaksBlob.get()});
+                                    //         // Fill gaps
+                                    //         const auto* posePeaksPtr = spMaximumPeaksBlob->mutable_cpu_data();
+                                    //         for (auto part = 0 ; part < mPoseKeypoints.getSize(1) ; part++)
+                                    //         {
+                                    //             // For currently empty keypoints
+                                    //             if (mPoseKeypoints[personIndex+3*part+2] < nmsThresholdRefined)
+                                    //             {
+                                    //                 const auto xyIndex = 3*part;
+                                    //                 const auto x = posePeaksPtr[xyIndex]*scaleRoiToOutput + xOffset;
+                                    //                 const auto y = posePeaksPtr[xyIndex + 1]*scaleRoiToOutput + yOffset;
+                                    //                 const auto rectangle = getKeypointsRectangle(
+                                    //                     mPoseKeypoints, person, nmsThresholdRefined);
+                                    //                 if (x >= rectangle.x && x < rectangle.x + rectangle.width
+                                    //                     && y >= rectangle.y && y < rectangle.y + rectangle.height)
+                                    //                 {
+                                    //                     const auto score = posePeaksPtr[xyIndex + 2];
+                                    //                     const auto baseIndex = personIndex + 3*part;
+                                    //                     mPoseKeypoints[baseIndex] = x;
+                                    //                     mPoseKeypoints[baseIndex+1] = y;
+                                    //                     mPoseKeypoints[baseIndex+2] = score;
+                                    //                     mPoseScores[person] += score;
+                                    //                 }
+                                    //             }
+                                    //         }
+                                    //     }
+                                    // }
+                                }
+                            }
+                        }
+                    }
+                }
+                // Tracking: The people not found again are removed
+                if (trackingMode && numberPeopleRefined < mPoseKeypoints.getSize(0))
+                {
+                    const auto personArea = mPoseKeypoints.getVolume(1,2);
+                    Array<float> poseKeypoints(
+                        {numberPeopleRefined, mPoseKeypoints.getSize(1), mPoseKeypoints.getSize(2)});
+                    Array<float> poseScores(numberPeopleRefined);
+                    auto personRefined = 0;
+                    for (auto person = 0 ; person < mPoseKeypoints.getSize(0) ; person++)
+                    {
+                        if (peopleRefined[person])
+                        {
+                            std::copy(
+                                mPoseKeypoints.getConstPtr() + person * personArea,
+                                mPoseKeypoints.getConstPtr() + (person+1) * personArea,
+                                poseKeypoints.getPtr() + personRefined * personArea);
+                            poseScores[personRefined] = mPoseScores[person];
+                            personRefined++;
+                        }
+                    }
+                    mPoseKeypoints = poseKeypoints;
+                    mPoseScores = poseScores;
+                }
+                return numberPeopleRefined;
+            #else
+                UNUSED(inputNetData);
+                UNUSED(scaleInputToNetInputs);
+                UNUSED(roiEnlargement);
+                UNUSED(trackingMode);
+                return 0;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0;
+        }
+    }
+
+    void PoseExtractorCaffe::postProcessNetOutput(
+        const std::vector<std::shared_ptr<ArrayCpuGpu<float>>>& netOutputBlobs,
+        const std::vector<Array<float>>& inputNetData, const Point<int>& inputDataSize,
+        const std::vector<double>& scaleInputToNetInputs)
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                // Resize std::vectors if required
+                mNetInput4DSizes.resize(inputNetData.size());
+                // Reshape blobs if required
+                for (auto i = 0u ; i < inputNetData.size(); i++)
+                {
+                    // Reshape blobs if required - For dynamic sizes (e.g., images of different aspect ratio)
+                    const auto changedVectors = !vectorsAreEqual(
+                        mNetInput4DSizes.at(i), inputNetData[i].getSize());
+                    if (changedVectors)
+                    {
+                        mNetInput4DSizes.at(i) = inputNetData[i].getSize();
+                        reshapePoseExtractorCaffe(
+                            spResizeAndMergeCaffe, spNmsCaffe, spBodyPartConnectorCaffe,
+                            spMaximumCaffe, netOutputBlobs, spHeatMapsBlob,
+                            spPeaksBlob, spMaximumPeaksBlob, 1.f, mPoseModel,
+                            mGpuId, mUpsamplingRatio);
+                            // In order to resize to input size to have same results as Matlab
+                            // scaleInputToNetInputs[i] vs. 1.f
+                        // FP16 heat maps: spHeatMapsBlob keeps the shape, but its memory is only allocated if the
+                        // heat maps are requested (see updateHeatMapsBlob)
+                        #ifdef USE_CUDA
+                            if (mHeatMapsFp16)
+                            {
+                                cudaPoolFree(pHeatMapsHalfGpuPtr, pCudaStream);
+                                pHeatMapsHalfGpuPtr = (__half*)cudaPoolMalloc(
+                                    spHeatMapsBlob->count() * sizeof(__half), pCudaStream);
+                                spResizeAndMergeCaffe->setHalfPrecisionTarget(pHeatMapsHalfGpuPtr);
+                                spNmsCaffe->setHalfPrecisionBottom(pHeatMapsHalfGpuPtr);
+                                spBodyPartConnectorCaffe->setHalfPrecisionHeatMaps(pHeatMapsHalfGpuPtr);
+                            }
+                        #endif
+                    }
+                    // Get scale net to output (i.e., image input)
+                    const auto ratio = (
+                        mUpsamplingRatio <= 0.f
+                            ? 1 : mUpsamplingRatio / getPoseNetDecreaseFactor(mPoseModel));
+                    if (changedVectors || TOP_DOWN_REFINEMENT)
+                        mNetOutputSize = Point<int>{
+                            positiveIntRound(ratio*mNetInput4DSizes[0][3]),
+                            positiveIntRound(ratio*mNetInput4DSizes[0][2])};
+                }
+                // OP_CUDA_PROFILE_END(timeNormalize1, 1e3, REPS);
+                // OP_CUDA_PROFILE_INIT(REPS);
+                // 2. Resize heat maps + merge different scales
+                // ~5ms (GPU) / ~20ms (CPU)
+                waitForNetOutputOnStream();
+                const auto caffeNetOutputBlobs = arraySharedToPtr(netOutputBlobs);
+                // Set and fill floatScaleRatios
+                    // Option 1/2 (warning for double-to-float conversion)
+                // const std::vector<float> floatScaleRatios(scaleInputToNetInputs.begin(), scaleInputToNetInputs.end());
+                    // Option 2/2
+                std::vector<float> floatScaleRatios;
+                std::for_each(
+                    scaleInputToNetInputs.begin(), scaleInputToNetInputs.end(),
+                    [&floatScaleRatios](const double value) { floatScaleRatios.emplace_back(float(value)); });
+                spResizeAndMergeCaffe->setScaleRatios(floatScaleRatios);
+                // Fused resize and NMS (single scale only): Only the PAF channels are upsampled here (required by
+                // the body part connector), the peaks are found on the network output itself
+                mFusedNms = (mFusedNmsEnabled && caffeNetOutputBlobs.size() == 1
+                             && caffeNetOutputBlobs[0]->shape(0) == 1);
+                // Network resolution PAFs (single scale only): The body part connector samples the PAF channels of
+                // the network output itself, so only the body part channels are upsampled here (if not fused NMS)
+                mPafLowResolution = (mPafLowResolutionEnabled && caffeNetOutputBlobs.size() == 1
+                                     && caffeNetOutputBlobs[0]->shape(0) == 1);
+                const auto numberBodyParts = (int)getPoseNumberBodyParts(mPoseModel);
+                const auto firstPafChannel = numberBodyParts + (addBkgChannel(mPoseModel) ? 1 : 0);
+                // The network output is read in the memory layout of the network (e.g., channel-last TensorRT
+                // engines), rather than transposed first
+                const auto netOutputLayout = spNets.at(0)->getOutputLayout();
+                spResizeAndMergeCaffe->setBottomLayout(netOutputLayout);
+                spNmsCaffe->setLowResolutionBottom(mFusedNms ? caffeNetOutputBlobs[0] : nullptr, netOutputLayout);
+                spBodyPartConnectorCaffe->setLowResolutionPafs(
+                    mPafLowResolution ? caffeNetOutputBlobs[0] : nullptr, netOutputLayout);
+                mLowResolutionNetOutputBlobs = (mFusedNms || mPafLowResolution
+                    ? caffeNetOutputBlobs : std::vector<ArrayCpuGpu<float>*>{});
+                // Both of them: Nothing is upsampled
+                if (!mFusedNms || !mPafLowResolution)
+                {
+                    spResizeAndMergeCaffe->setChannelRange(
+                        (mFusedNms ? firstPafChannel : 0), (mPafLowResolution ? firstPafChannel : -1));
+                    spResizeAndMergeCaffe->Forward(caffeNetOutputBlobs, {spHeatMapsBlob.get()});
+                }
+                mHeatMapsBlobUpdated = (!mHeatMapsFp16 && !mFusedNms && !mPafLowResolution);
+                // Heat map rendering from the network output (see getNetOutputGpuConstPtr())
+                pSingleScaleNetOutputBlob = (caffeNetOutputBlobs.size() == 1 && caffeNetOutputBlobs[0]->shape(0) == 1
+                                             && netOutputLayout == BlobLayout::Nchw
+                                                ? caffeNetOutputBlobs[0] : nullptr);
+                // Get scale net to output (i.e., image input)
+                // Note: In order to resize to input size, (un)comment the following lines
+                const auto scaleProducerToNetInput = resizeGetScaleFactor(inputDataSize, mNetOutputSize);
+                const Point<int> netSize{
+                    positiveIntRound(scaleProducerToNetInput*inputDataSize.x),
+                    positiveIntRound(scaleProducerToNetInput*inputDataSize.y)};
+                mScaleNetToOutput = {(float)resizeGetScaleFactor(netSize, inputDataSize)};
+                // mScaleNetToOutput = 1.f;
+                // 3. Get peaks by Non-Maximum Suppression
+                // ~2ms (GPU) / ~7ms (CPU)
+                // OP_CUDA_PROFILE_END(timeNormalize2, 1e3, REPS);
+                const auto nmsThreshold = (float)get(PoseProperty::NMSThreshold);
+                const auto nmsOffset = float(0.5/double(mScaleNetToOutput));
+                // OP_CUDA_PROFILE_INIT(REPS);
+                spNmsCaffe->setThreshold(nmsThreshold);
+                spNmsCaffe->setOffset(Point<float>{nmsOffset, nmsOffset});
+                spNmsCaffe->Forward({spHeatMapsBlob.get()}, {spPeaksBlob.get()});
+                // 4. Connecting body parts
+                // OP_CUDA_PROFILE_END(timeNormalize3, 1e3, REPS);
+                // OP_CUDA_PROFILE_INIT(REPS);
+                spBodyPartConnectorCaffe->setScaleNetToOutput(mScaleNetToOutput);
+                spBodyPartConnectorCaffe->setDefaultNmsThreshold((float)get(PoseProperty::NMSThreshold));
+                spBodyPartConnectorCaffe->setInterMinAboveThreshold(
+                    (float)get(PoseProperty::ConnectInterMinAboveThreshold));
+                spBodyPartConnectorCaffe->setInterThreshold((float)get(PoseProperty::ConnectInterThreshold));
+                spBodyPartConnectorCaffe->setMinSubsetCnt((int)get(PoseProperty::ConnectMinSubsetCnt));
+                spBodyPartConnectorCaffe->setMinSubsetScore((float)get(PoseProperty::ConnectMinSubsetScore));
+                spBodyPartConnectorCaffe->setMaxLimbLength((float)get(PoseProperty::ConnectMaxLimbLength));
+                spBodyPartConnectorCaffe->setMinPeakScore((float)get(PoseProperty::ConnectMinPeakScore));
+                // Note: BODY_25D will crash (only implemented for CPU version)
+                spBodyPartConnectorCaffe->Forward(
+                    {spHeatMapsBlob.get(), spPeaksBlob.get()}, mPoseKeypoints, mPoseScores);
+                // Heat maps and peaks are read (and the network output overwritten) from the default stream later on
+                #ifdef USE_CUDA
+                    if (pCudaStream != nullptr)
+                        cudaStreamSynchronize(pCudaStream);
+                #endif
+                // OP_CUDA_PROFILE_END(timeNormalize4, 1e3, REPS);
+                // opLog("1(caf)= " + std::to_string(timeNormalize1) + "ms");
+                // opLog("2(res) = " + std::to_string(timeNormalize2) + " ms");
+                // opLog("3(nms) = " + std::to_string(timeNormalize3) + " ms");
+                // opLog("4(bpp) = " + std::to_string(timeNormalize4) + " ms");
+            #else
+                UNUSED(netOutputBlobs);
+                UNUSED(inputNetData);
+                UNUSED(inputDataSize);
+                UNUSED(scaleInputToNetInputs);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    const float* PoseExtractorCaffe::getCandidatesCpuConstPtr() const
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                checkThread();
+                return spPeaksBlob->cpu_data();
+            #else
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    const float* PoseExtractorCaffe::getCandidatesGpuConstPtr() const
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                checkThread();
+                return spPeaksBlob->gpu_data();
+            #else
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    const float* PoseExtractorCaffe::getHeatMapCpuConstPtr() const
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                checkThread();
+                updateHeatMapsBlob();
+                return spHeatMapsBlob->cpu_data();
+            #else
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    const float* PoseExtractorCaffe::getHeatMapGpuConstPtr() const
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                checkThread();
+                updateHeatMapsBlob();
+                return spHeatMapsBlob->gpu_data();
+            #else
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    std::vector<int> PoseExtractorCaffe::getHeatMapSize() const
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                checkThread();
+                return spHeatMapsBlob->shape();
+            #else
+                return {};
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    const float* PoseExtractorCaffe::getNetOutputGpuConstPtr() const
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                checkThread();
+                return (!mHeatMapsBlobUpdated && pSingleScaleNetOutputBlob != nullptr
+                    ? pSingleScaleNetOutputBlob->gpu_data() : nullptr);
+            #else
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    std::vector<int> PoseExtractorCaffe::getNetOutputSize() const
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                checkThread();
+                return (!mHeatMapsBlobUpdated && pSingleScaleNetOutputBlob != nullptr
+                    ? pSingleScaleNetOutputBlob->shape() : std::vector<int>{});
+            #else
                 return {};
             #endif
         }
@@ -741,4 +1986,37 @@ namespace op
             return nullptr;
         }
     }
+
+    GpuMemoryFootprint PoseExtractorCaffe::getGpuMemoryFootprint(
+        const PoseModel poseModel, const std::string& modelFolder, const std::vector<Point<int>>& netInputSizes,
+        const std::string& caffeModelPath)
+    {
+        try
+        {
+            // Network blobs (Caffe keeps all of them) per network input pixel, approximated from the channels and
+            // strides of the layers of each model
+            auto blobBytesPerPixel = 2200ull; // BODY_25 and its variants
+            if (poseModel == PoseModel::COCO_18 || poseModel == PoseModel::MPI_15)
+                blobBytesPerPixel = 1800ull;
+            else if (poseModel == PoseModel::MPI_15_4)
+                blobBytesPerPixel = 1100ull;
+            else if (poseModel == PoseModel::BODY_135)
+                blobBytesPerPixel = 3000ull;
+            // Network input (3 float channels) and heat maps (upsampled to the network input resolution)
+            const auto numberChannels = getPoseNumberBodyParts(poseModel) + 1 + getPoseMapIndex(poseModel).size();
+            const auto bytesPerPixel = blobBytesPerPixel + 4ull * (3ull + numberChannels);
+            auto perFrameBytes = 0ull;
+            for (const auto& netInputSize : netInputSizes)
+                perFrameBytes += bytesPerPixel * (unsigned long long)netInputSize.area();
+            // Weights (as they are in the caffemodel) and cuDNN workspaces
+            const auto weightBytes = getModelFileBytes(
+                modelFolder + (caffeModelPath.empty() ? getPoseTrainedModel(poseModel) : caffeModelPath), 200ull << 20);
+            return GpuMemoryFootprint{"PoseExtractorCaffe", weightBytes + (100ull << 20), perFrameBytes};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return GpuMemoryFootprint{};
+        }
+    }
 }
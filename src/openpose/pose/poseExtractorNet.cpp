@@ -1,10 +1,14 @@
 #include <openpose/pose/poseExtractorNet.hpp>
-#include <cmath> // std::round
+#include <cmath> // std::abs, std::round
+#include <limits> // std::numeric_limits
+#include <mutex>
 #ifdef USE_CUDA
     #include <cuda_runtime_api.h>
     #include <openpose/gpu/cuda.hpp>
+    #include <openpose/gpu/cudaMemoryPool.hpp>
 #endif
 #include <openpose/core/enumClasses.hpp>
+#include <openpose/utilities/allocationTracker.hpp>
 #include <openpose/utilities/fastMath.hpp>
 
 namespace op
@@ -45,11 +49,248 @@ namespace op
         }
     }
 
+    // Channel range of the heat map blob, copied into Datum::poseHeatMaps
+    struct HeatMapsSegment
+    {
+        size_t offset;
+        size_t volume;
+        bool isPaf;
+    };
+
+    std::vector<HeatMapsSegment> getHeatMapsSegments(
+        const std::vector<HeatMapType>& heatMapTypes, const PoseModel poseModel, const size_t channelOffset)
+    {
+        try
+        {
+            std::vector<HeatMapsSegment> segments;
+            const auto volumeBodyParts = getPoseNumberBodyParts(poseModel) * channelOffset;
+            // Body parts
+            if (heatMapTypesHas(heatMapTypes, HeatMapType::Parts))
+                segments.emplace_back(HeatMapsSegment{0u, volumeBodyParts, false});
+            // Background
+            if (heatMapTypesHas(heatMapTypes, HeatMapType::Background))
+            {
+                if (addBkgChannel(poseModel))
+                    segments.emplace_back(HeatMapsSegment{volumeBodyParts, channelOffset, false});
+                else
+                {
+                    error("You enabled `--heatmaps_add_bkg` for a model that does not contain one. Please,"
+                          " remove this flag for this model.", __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+            // PAFs
+            if (heatMapTypesHas(heatMapTypes, HeatMapType::PAFs))
+                segments.emplace_back(HeatMapsSegment{
+                    volumeBodyParts + (addBkgChannel(poseModel) ? channelOffset : 0),
+                    getPosePartPairs(poseModel).size() * channelOffset, true});
+            return segments;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void scaleHeatMaps(float* const heatMapsPtr, const HeatMapsSegment& segment, const ScaleMode heatMapScaleMode)
+    {
+        try
+        {
+            if (heatMapScaleMode != ScaleMode::NoScale)
+            {
+                const auto volume = segment.volume;
+                // Body parts and background
+                if (!segment.isPaf)
+                {
+                    // Change from [0,1] to [-1,1]
+                    if (heatMapScaleMode == ScaleMode::PlusMinusOne
+                        || heatMapScaleMode == ScaleMode::PlusMinusOneFixedAspect)
+                        for (auto i = 0u ; i < volume ; i++)
+                            heatMapsPtr[i] = fastTruncate(heatMapsPtr[i]) * 2.f - 1.f;
+                    // [0, 255]
+                    else if (heatMapScaleMode == ScaleMode::UnsignedChar)
+                        for (auto i = 0u ; i < volume ; i++)
+                            heatMapsPtr[i] = (float)positiveIntRound(fastTruncate(heatMapsPtr[i]) * 255.f);
+                    // Avoid values outside original range
+                    else
+                        for (auto i = 0u ; i < volume ; i++)
+                            heatMapsPtr[i] = fastTruncate(heatMapsPtr[i]);
+                }
+                // PAFs
+                else
+                {
+                    // Change from [-1,1] to [0,1]. Note that PAFs are in [-1,1]
+                    if (heatMapScaleMode == ScaleMode::ZeroToOne
+                        || heatMapScaleMode == ScaleMode::ZeroToOneFixedAspect)
+                        for (auto i = 0u ; i < volume ; i++)
+                            heatMapsPtr[i] = fastTruncate(heatMapsPtr[i], -1.f) * 0.5f + 0.5f;
+                    // [0, 255] (1 would be rounded to 257, so it is saturated to 255)
+                    else if (heatMapScaleMode == ScaleMode::UnsignedChar)
+                        for (auto i = 0u ; i < volume ; i++)
+                            heatMapsPtr[i] = (float)fastMin(positiveIntRound(
+                                fastTruncate(heatMapsPtr[i], -1.f) * 128.5f + 128.5f
+                            ), 255);
+                    // Avoid values outside original range
+                    else
+                        for (auto i = 0u ; i < volume ; i++)
+                            heatMapsPtr[i] = fastTruncate(heatMapsPtr[i], -1.f);
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    #ifdef USE_CUDA
+        // GPU version of scaleHeatMaps(), applied by gatherScaledChannels() while gathering the segments
+        std::vector<GpuChannelRange> getHeatMapsChannelRanges(
+            const std::vector<HeatMapsSegment>& segments, const ScaleMode heatMapScaleMode)
+        {
+            try
+            {
+                std::vector<GpuChannelRange> channelRanges;
+                for (const auto& segment : segments)
+                {
+                    const auto maxValue = std::numeric_limits<float>::max();
+                    GpuChannelRange channelRange{segment.offset, segment.volume, -maxValue, maxValue, 1.f, 0.f, false};
+                    if (heatMapScaleMode != ScaleMode::NoScale)
+                    {
+                        // Avoid values outside original range
+                        channelRange.minValue = (segment.isPaf ? -1.f : 0.f);
+                        channelRange.maxValue = 1.f;
+                        // Body parts and background
+                        if (!segment.isPaf)
+                        {
+                            // Change from [0,1] to [-1,1]
+                            if (heatMapScaleMode == ScaleMode::PlusMinusOne
+                                || heatMapScaleMode == ScaleMode::PlusMinusOneFixedAspect)
+                            {
+                                channelRange.scale = 2.f;
+                                channelRange.shift = -1.f;
+                            }
+                            // [0, 255]
+                            else if (heatMapScaleMode == ScaleMode::UnsignedChar)
+                            {
+                                channelRange.scale = 255.f;
+                                channelRange.round = true;
+                            }
+                        }
+                        // PAFs
+                        else
+                        {
+                            // Change from [-1,1] to [0,1]
+                            if (heatMapScaleMode == ScaleMode::ZeroToOne
+                                || heatMapScaleMode == ScaleMode::ZeroToOneFixedAspect)
+                            {
+                                channelRange.scale = 0.5f;
+                                channelRange.shift = 0.5f;
+                            }
+                            // [0, 255]
+                            else if (heatMapScaleMode == ScaleMode::UnsignedChar)
+                            {
+                                channelRange.scale = 128.5f;
+                                channelRange.shift = 128.5f;
+                                channelRange.round = true;
+                            }
+                        }
+                    }
+                    channelRanges.emplace_back(channelRange);
+                }
+                return channelRanges;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return {};
+            }
+        }
+
+        // Device buffers of the pending heat map downloads. They are re-used across frames, since cudaMalloc and
+        // cudaFree are slow (and cudaFree synchronizes the whole device). The pending downloads share its ownership,
+        // so it is only destroyed once the extractor and all of them are gone.
+        struct PoseExtractorNet::HeatMapsDevicePool
+        {
+            std::mutex mMutex;
+            std::vector<float*> mFreeBuffers;
+            size_t mVolume{0};
+            int mGpuId{-1};
+
+            ~HeatMapsDevicePool()
+            {
+                try
+                {
+                    if (!mFreeBuffers.empty())
+                    {
+                        int previousGpuId;
+                        cudaGetDevice(&previousGpuId);
+                        cudaSetDevice(mGpuId);
+                        freeBuffers();
+                        cudaSetDevice(previousGpuId);
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            // Only from the thread of the extractor (i.e., with its GPU selected)
+            float* acquire(const size_t volume)
+            {
+                std::lock_guard<std::mutex> lock{mMutex};
+                cudaGetDevice(&mGpuId);
+                // New heat map size (e.g., new network resolution): All buffers are replaced
+                if (mVolume != volume)
+                {
+                    freeBuffers();
+                    mVolume = volume;
+                }
+                if (!mFreeBuffers.empty())
+                {
+                    auto* buffer = mFreeBuffers.back();
+                    mFreeBuffers.pop_back();
+                    return buffer;
+                }
+                float* buffer = nullptr;
+                if (cudaMalloc((void**)&buffer, volume * sizeof(float)) != cudaSuccess)
+                    error("The device buffer of the heat maps could not be allocated.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                return buffer;
+            }
+
+            // From any thread
+            void release(float* const buffer, const size_t volume)
+            {
+                std::lock_guard<std::mutex> lock{mMutex};
+                if (volume == mVolume)
+                    mFreeBuffers.emplace_back(buffer);
+                else
+                {
+                    int previousGpuId;
+                    cudaGetDevice(&previousGpuId);
+                    cudaSetDevice(mGpuId);
+                    cudaFree(buffer);
+                    cudaSetDevice(previousGpuId);
+                }
+            }
+
+            void freeBuffers()
+            {
+                for (auto* buffer : mFreeBuffers)
+                    cudaFree(buffer);
+                mFreeBuffers.clear();
+            }
+        };
+    #endif
+
     PoseExtractorNet::PoseExtractorNet(const PoseModel poseModel, const std::vector<HeatMapType>& heatMapTypes,
                                        const ScaleMode heatMapScaleMode, const bool addPartCandidates,
                                        const bool maximizePositives) :
         mPoseModel{poseModel},
         mNetOutputSize{0,0},
+        mWarmingUp{false},
         mHeatMapTypes{heatMapTypes},
         mHeatMapScaleMode{heatMapScaleMode},
         mAddPartCandidates{addPartCandidates}
@@ -77,6 +318,11 @@ namespace op
             mProperties[(int)PoseProperty::ConnectMinSubsetCnt] = getPoseDefaultMinSubsetCnt(maximizePositives);
             mProperties[(int)PoseProperty::ConnectMinSubsetScore] = getPoseDefaultConnectMinSubsetScore(
                 maximizePositives);
+            mProperties[(int)PoseProperty::ConnectMaxLimbLength] = getPoseDefaultConnectMaxLimbLength();
+            mProperties[(int)PoseProperty::ConnectMinPeakScore] = getPoseDefaultConnectMinPeakScore();
+            #ifdef USE_CUDA
+                spHeatMapsDevicePool = std::make_shared<HeatMapsDevicePool>();
+            #endif
         }
         catch (const std::exception& e)
         {
@@ -103,6 +349,115 @@ namespace op
         }
     }
 
+    void PoseExtractorNet::forwardPassBatch(const std::vector<std::vector<Array<float>>>& inputNetDatas)
+    {
+        try
+        {
+            // Batching not supported by default, postProcessBatchElement() runs the whole forwardPass()
+            UNUSED(inputNetDatas);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorNet::forwardPassPipelined(const std::vector<Array<float>>& inputNetData)
+    {
+        try
+        {
+            // Pipelining not supported by default, postProcessPipelined() runs the whole forwardPass()
+            UNUSED(inputNetData);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorNet::postProcessPipelined(
+        const std::vector<Array<float>>& inputNetData, const Point<int>& inputDataSize,
+        const std::vector<double>& scaleRatios)
+    {
+        try
+        {
+            forwardPass(inputNetData, inputDataSize, scaleRatios);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorNet::reserveNetInputSizes(const std::vector<std::vector<Point<int>>>& netInputSizes)
+    {
+        try
+        {
+            // Networks reshaped on demand by default
+            UNUSED(netInputSizes);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorNet::warmUp(const std::vector<std::vector<Point<int>>>& netInputSizes, const int batchSize)
+    {
+        try
+        {
+            // Allocate for the largest one first, so the following ones do not re-allocate
+            reserveNetInputSizes(netInputSizes);
+            mWarmingUp = true;
+            for (const auto& netInputSizesI : netInputSizes)
+            {
+                if (netInputSizesI.empty())
+                    continue;
+                // Blank (zero) input of each scale
+                std::vector<Array<float>> inputNetData(netInputSizesI.size());
+                std::vector<double> scaleInputToNetInputs(netInputSizesI.size());
+                for (auto i = 0u ; i < netInputSizesI.size(); i++)
+                {
+                    inputNetData[i].reset({1, 3, netInputSizesI[i].y, netInputSizesI[i].x}, 0.f);
+                    scaleInputToNetInputs[i] = netInputSizesI[i].x / (double)netInputSizesI[0].x;
+                }
+                if (batchSize > 1)
+                {
+                    forwardPassBatch(std::vector<std::vector<Array<float>>>(batchSize, inputNetData));
+                    postProcessBatchElement(0, inputNetData, netInputSizesI[0], scaleInputToNetInputs);
+                }
+                else
+                    forwardPass(inputNetData, netInputSizesI[0], scaleInputToNetInputs);
+                opLog("Network warmed up for " + std::to_string(netInputSizesI[0].x) + "x"
+                      + std::to_string(netInputSizesI[0].y) + " (" + std::to_string(netInputSizesI.size())
+                      + " scale(s)).", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+            mWarmingUp = false;
+            // Remove the blank results
+            clear();
+        }
+        catch (const std::exception& e)
+        {
+            mWarmingUp = false;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorNet::postProcessBatchElement(
+        const int batchIndex, const std::vector<Array<float>>& inputNetData, const Point<int>& inputDataSize,
+        const std::vector<double>& scaleRatios)
+    {
+        try
+        {
+            UNUSED(batchIndex);
+            forwardPass(inputNetData, inputDataSize, scaleRatios);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     Array<float> PoseExtractorNet::getHeatMapsCopy() const
     {
         try
@@ -117,129 +472,207 @@ namespace op
                 // Get heatmaps size
                 const auto heatMapSize = getHeatMapSize();
 
-                // Allocate memory
+                // Allocate memory (pinned, as it is downloaded from the GPU)
                 const auto numberHeatMapChannels = getNumberHeatMapChannels(mHeatMapTypes, mPoseModel);
-                heatMaps.reset({numberHeatMapChannels, heatMapSize[2], heatMapSize[3]});
-
-                // Copy memory
-                const auto channelOffset = heatMaps.getVolume(1, 2);
-                const auto volumeBodyParts = getPoseNumberBodyParts(mPoseModel) * channelOffset;
-                const auto volumePAFs = getPosePartPairs(mPoseModel).size() * channelOffset;
-                auto totalOffset = 0u;
-                // Body parts
-                if (heatMapTypesHas(mHeatMapTypes, HeatMapType::Parts))
-                {
-                    #ifdef USE_CUDA
-                        cudaMemcpy(heatMaps.getPtr(), getHeatMapGpuConstPtr(),
-                                   volumeBodyParts * sizeof(float), cudaMemcpyDeviceToHost);
-                    #else
-                        const auto* heatMapCpuPtr = getHeatMapCpuConstPtr();
-                        std::copy(heatMapCpuPtr, heatMapCpuPtr+volumeBodyParts, heatMaps.getPtr());
-                    #endif
-                    if (mHeatMapScaleMode != ScaleMode::NoScale)
+                heatMaps.resetPinned({numberHeatMapChannels, heatMapSize[2], heatMapSize[3]});
+                const auto segments = getHeatMapsSegments(mHeatMapTypes, mPoseModel, heatMaps.getVolume(1, 2));
+
+                #ifdef USE_CUDA
+                    // Gather and scale the requested channels (body parts, background and/or PAFs) on the GPU, and
+                    // download them at once (as 8-bit values if they are scaled into [0, 255])
+                    const auto volume = heatMaps.getVolume();
+                    const auto channelRanges = getHeatMapsChannelRanges(segments, mHeatMapScaleMode);
+                    if (mHeatMapScaleMode == ScaleMode::UnsignedChar)
                     {
-                        // Change from [0,1] to [-1,1]
-                        if (mHeatMapScaleMode == ScaleMode::PlusMinusOne
-                            || mHeatMapScaleMode == ScaleMode::PlusMinusOneFixedAspect)
-                            for (auto i = 0u ; i < volumeBodyParts ; i++)
-                                heatMaps[i] = fastTruncate(heatMaps[i]) * 2.f - 1.f;
-                        // [0, 255]
-                        else if (mHeatMapScaleMode == ScaleMode::UnsignedChar)
-                            for (auto i = 0u ; i < volumeBodyParts ; i++)
-                                heatMaps[i] = (float)positiveIntRound(fastTruncate(heatMaps[i]) * 255.f);
-                        // Avoid values outside original range
-                        else
-                            for (auto i = 0u ; i < volumeBodyParts ; i++)
-                                heatMaps[i] = fastTruncate(heatMaps[i]);
+                        auto* gatheredPtr = (unsigned char*)cudaPoolMalloc(volume);
+                        gatherScaledChannels(gatheredPtr, getHeatMapGpuConstPtr(), channelRanges);
+                        Array<unsigned char> heatMapsUChar;
+                        heatMapsUChar.resetPinned({(int)volume});
+                        cudaMemcpyAsync(heatMapsUChar.getPtr(), gatheredPtr, volume, cudaMemcpyDeviceToHost);
+                        cudaStreamSynchronize(nullptr);
+                        AllocationTracker::recordCopy(volume, MemoryCopy::DeviceToHost);
+                        cudaPoolFree(gatheredPtr);
+                        std::copy(heatMapsUChar.getConstPtr(), heatMapsUChar.getConstPtr() + volume,
+                                  heatMaps.getPtr());
                     }
-                    totalOffset += (unsigned int)volumeBodyParts;
-                }
-                // Background
-                if (heatMapTypesHas(mHeatMapTypes, HeatMapType::Background))
+                    else
+                    {
+                        auto* gatheredPtr = (float*)cudaPoolMalloc(volume * sizeof(float));
+                        gatherScaledChannels(gatheredPtr, getHeatMapGpuConstPtr(), channelRanges);
+                        cudaMemcpyAsync(heatMaps.getPtr(), gatheredPtr, volume * sizeof(float),
+                                        cudaMemcpyDeviceToHost);
+                        cudaStreamSynchronize(nullptr);
+                        AllocationTracker::recordCopy(volume * sizeof(float), MemoryCopy::DeviceToHost);
+                        cudaPoolFree(gatheredPtr);
+                    }
+                #else
+                    // Copy memory (body parts, background and/or PAFs)
+                    auto* heatMapsPtr = heatMaps.getPtr();
+                    for (const auto& segment : segments)
+                    {
+                        const auto* heatMapCpuPtr = getHeatMapCpuConstPtr() + segment.offset;
+                        std::copy(heatMapCpuPtr, heatMapCpuPtr + segment.volume, heatMapsPtr);
+                        scaleHeatMaps(heatMapsPtr, segment, mHeatMapScaleMode);
+                        heatMapsPtr += segment.volume;
+                    }
+                #endif
+            }
+            #ifdef USE_CUDA
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            #endif
+            return heatMaps;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<float>{};
+        }
+    }
+
+    const float* PoseExtractorNet::getNetOutputGpuConstPtr() const
+    {
+        return nullptr;
+    }
+
+    std::vector<int> PoseExtractorNet::getNetOutputSize() const
+    {
+        return {};
+    }
+
+    std::function<Array<float>()> PoseExtractorNet::getHeatMapsDownload() const
+    {
+        try
+        {
+            checkThread();
+            if (mHeatMapTypes.empty())
+                return nullptr;
+            #ifdef USE_CUDA
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                // Pending download of 1 frame. Its device buffer goes back to the pool once downloaded (or discarded)
+                struct PendingHeatMaps
                 {
-                    if (addBkgChannel(mPoseModel))
+                    std::shared_ptr<HeatMapsDevicePool> spPool;
+                    float* pDeviceBuffer{nullptr};
+                    size_t mVolume;
+                    std::vector<int> mSize;
+                    std::mutex mMutex;
+                    Array<float> mHeatMaps;
+
+                    ~PendingHeatMaps()
                     {
-                        auto* heatMapsPtr = heatMaps.getPtr() + totalOffset;
-                        #ifdef USE_CUDA
-                            cudaMemcpy(heatMapsPtr, getHeatMapGpuConstPtr() + volumeBodyParts,
-                                       channelOffset * sizeof(float), cudaMemcpyDeviceToHost);
-                        #else
-                            const auto* heatMapCpuPtr = getHeatMapCpuConstPtr();
-                            std::copy(
-                                heatMapCpuPtr + volumeBodyParts, heatMapCpuPtr + volumeBodyParts + channelOffset,
-                                heatMapsPtr);
-                        #endif
-                        if (mHeatMapScaleMode != ScaleMode::NoScale)
+                        try
                         {
-                            // Change from [0,1] to [-1,1]
-                            if (mHeatMapScaleMode == ScaleMode::PlusMinusOne
-                                || mHeatMapScaleMode == ScaleMode::PlusMinusOneFixedAspect)
-                                for (auto i = 0u ; i < channelOffset ; i++)
-                                    heatMapsPtr[i] = fastTruncate(heatMapsPtr[i]) * 2.f - 1.f;
-                            // [0, 255]
-                            else if (mHeatMapScaleMode == ScaleMode::UnsignedChar)
-                                for (auto i = 0u ; i < channelOffset ; i++)
-                                    heatMapsPtr[i] = (float)positiveIntRound(fastTruncate(heatMapsPtr[i]) * 255.f);
-                            // Avoid values outside original range
-                            else
-                                for (auto i = 0u ; i < channelOffset ; i++)
-                                    heatMapsPtr[i] = fastTruncate(heatMapsPtr[i]);
+                            if (pDeviceBuffer != nullptr)
+                                spPool->release(pDeviceBuffer, mVolume);
+                        }
+                        catch (const std::exception& e)
+                        {
+                            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
                         }
-                        totalOffset += (unsigned int)channelOffset;
                     }
-                    else
+
+                    Array<float> download()
                     {
-                        error("You enabled `--heatmaps_add_bkg` for a model that does not contain one. Please,"
-                              " remove this flag for this model.", __LINE__, __FUNCTION__, __FILE__);
+                        std::lock_guard<std::mutex> lock{mMutex};
+                        if (pDeviceBuffer != nullptr)
+                        {
+                            // Called from any thread, so it (temporarily) selects the GPU of the buffer
+                            int previousGpuId;
+                            cudaGetDevice(&previousGpuId);
+                            cudaSetDevice(spPool->mGpuId);
+                            mHeatMaps.resetPinned(mSize);
+                            cudaMemcpy(mHeatMaps.getPtr(), pDeviceBuffer, mVolume * sizeof(float),
+                                       cudaMemcpyDeviceToHost);
+                            AllocationTracker::recordCopy(mVolume * sizeof(float), MemoryCopy::DeviceToHost);
+                            cudaSetDevice(previousGpuId);
+                            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                            spPool->release(pDeviceBuffer, mVolume);
+                            pDeviceBuffer = nullptr;
+                        }
+                        return mHeatMaps;
                     }
-                }
-                // PAFs
-                if (heatMapTypesHas(mHeatMapTypes, HeatMapType::PAFs))
+                };
+                // Get heatmaps size and channels (body parts, background and/or PAFs)
+                const auto heatMapSize = getHeatMapSize();
+                auto pendingHeatMaps = std::make_shared<PendingHeatMaps>();
+                pendingHeatMaps->spPool = spHeatMapsDevicePool;
+                pendingHeatMaps->mSize = {
+                    getNumberHeatMapChannels(mHeatMapTypes, mPoseModel), heatMapSize[2], heatMapSize[3]};
+                pendingHeatMaps->mVolume = size_t(pendingHeatMaps->mSize[0]) * heatMapSize[2] * heatMapSize[3];
+                const auto segments = getHeatMapsSegments(
+                    mHeatMapTypes, mPoseModel, size_t(heatMapSize[2]) * heatMapSize[3]);
+                pendingHeatMaps->pDeviceBuffer = spHeatMapsDevicePool->acquire(pendingHeatMaps->mVolume);
+                // Device-to-device gather (already scaled), since the heat maps are overwritten by the next frame
+                gatherScaledChannels(
+                    pendingHeatMaps->pDeviceBuffer, getHeatMapGpuConstPtr(),
+                    getHeatMapsChannelRanges(segments, mHeatMapScaleMode));
+                AllocationTracker::recordCopy(
+                    pendingHeatMaps->mVolume * sizeof(float), MemoryCopy::DeviceToDevice);
+                // The kernel is asynchronous, while the next frame runs on a non-blocking stream (i.e., not ordered
+                // with respect to the legacy default stream)
+                cudaStreamSynchronize(0);
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                return [pendingHeatMaps]() { return pendingHeatMaps->download(); };
+            #else
+                const auto heatMaps = getHeatMapsCopy();
+                return [heatMaps]() { return heatMaps; };
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    void PoseExtractorNet::getHeatMapsSparse(SparseHeatMaps& heatMapsSparse, const float threshold) const
+    {
+        try
+        {
+            checkThread();
+            heatMapsSparse.clear();
+            if (!mHeatMapTypes.empty())
+            {
+                #ifdef USE_CUDA
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                #endif
+                // Get heatmaps size
+                const auto heatMapSize = getHeatMapSize();
+                const auto channelArea = heatMapSize[2] * heatMapSize[3];
+                heatMapsSparse.size = {
+                    getNumberHeatMapChannels(mHeatMapTypes, mPoseModel), heatMapSize[2], heatMapSize[3]};
+                heatMapsSparse.threshold = threshold;
+                // Threshold and compact each segment (body parts, background and/or PAFs)
+                for (const auto& segment : getHeatMapsSegments(mHeatMapTypes, mPoseModel, channelArea))
                 {
-                    auto* heatMapsPtr = heatMaps.getPtr() + totalOffset;
+                    const auto numberChannels = (int)(segment.volume / channelArea);
                     #ifdef USE_CUDA
-                        cudaMemcpy(heatMapsPtr,
-                                   getHeatMapGpuConstPtr() + volumeBodyParts + (addBkgChannel(mPoseModel) ? channelOffset : 0),
-                                   volumePAFs * sizeof(float), cudaMemcpyDeviceToHost);
+                        sparsifyChannels(
+                            heatMapsSparse.offsets, heatMapsSparse.indices, heatMapsSparse.values,
+                            getHeatMapGpuConstPtr() + segment.offset, numberChannels, channelArea, threshold);
                     #else
-                        const auto* heatMapCpuPtr = getHeatMapCpuConstPtr();
-                        std::copy(heatMapCpuPtr + volumeBodyParts + (addBkgChannel(mPoseModel) ? channelOffset : 0),
-                                  heatMapCpuPtr + volumeBodyParts + (addBkgChannel(mPoseModel) ? channelOffset : 0) + volumePAFs,
-                                  heatMapsPtr);
+                        const auto* const heatMapCpuPtr = getHeatMapCpuConstPtr() + segment.offset;
+                        for (auto channel = 0 ; channel < numberChannels ; channel++)
+                        {
+                            heatMapsSparse.offsets.emplace_back((int)heatMapsSparse.values.size());
+                            const auto* const channelPtr = heatMapCpuPtr + channel * channelArea;
+                            for (auto index = 0 ; index < channelArea ; index++)
+                            {
+                                if (std::abs(channelPtr[index]) > threshold)
+                                {
+                                    heatMapsSparse.indices.emplace_back(index);
+                                    heatMapsSparse.values.emplace_back(channelPtr[index]);
+                                }
+                            }
+                        }
                     #endif
-                    if (mHeatMapScaleMode != ScaleMode::NoScale)
-                    {
-                        // Change from [-1,1] to [0,1]. Note that PAFs are in [-1,1]
-                        if (mHeatMapScaleMode == ScaleMode::ZeroToOne
-                            || mHeatMapScaleMode == ScaleMode::ZeroToOneFixedAspect)
-                            for (auto i = 0u ; i < volumePAFs ; i++)
-                                heatMapsPtr[i] = fastTruncate(heatMapsPtr[i], -1.f) * 0.5f + 0.5f;
-                        // [0, 255]
-                        else if (mHeatMapScaleMode == ScaleMode::UnsignedChar)
-                            for (auto i = 0u ; i < volumePAFs ; i++)
-                                heatMapsPtr[i] = (float)positiveIntRound(
-                                    fastTruncate(heatMapsPtr[i], -1.f) * 128.5f + 128.5f
-                                );
-                        // Avoid values outside original range
-                        else
-                            for (auto i = 0u ; i < volumePAFs ; i++)
-                                heatMapsPtr[i] = fastTruncate(heatMapsPtr[i], -1.f);
-                    }
-                    totalOffset += (unsigned int)volumePAFs;
                 }
-                // Copy all at once
-                // cudaMemcpy(heatMaps.getPtr(), getHeatMapGpuConstPtr(), heatMaps.getVolume() * sizeof(float),
-                //            cudaMemcpyDeviceToHost);
+                heatMapsSparse.offsets.emplace_back((int)heatMapsSparse.values.size());
             }
-            #ifdef USE_CUDA
-                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
-            #endif
-            return heatMaps;
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return Array<float>{};
         }
     }
 
@@ -281,6 +714,53 @@ namespace op
         }
     }
 
+    void PoseExtractorNet::getCandidates(Array<float>& candidates, std::vector<int>& offsets) const
+    {
+        try
+        {
+            // Sanity check
+            checkThread();
+            // Initialization
+            candidates.reset();
+            offsets.clear();
+            // Fill candidates
+            if (mAddPartCandidates)
+            {
+                const auto numberBodyParts = getPoseNumberBodyParts(mPoseModel);
+                const auto peaksArea = (POSE_MAX_PEOPLE+1) * 3;
+                const auto* candidatesCpuPtr = getCandidatesCpuConstPtr();
+                // Offsets (from the number of peaks of each body part)
+                offsets.resize(numberBodyParts+1);
+                offsets[0] = 0;
+                for (auto part = 0u ; part < numberBodyParts ; part++)
+                    offsets[part+1] = offsets[part] + (int)std::round(candidatesCpuPtr[part*peaksArea]);
+                // Candidates (single allocation)
+                const auto numberCandidates = offsets.back();
+                if (numberCandidates > 0)
+                {
+                    candidates.reset({numberCandidates, 3});
+                    auto* candidatePtr = candidates.getPtr();
+                    for (auto part = 0u ; part < numberBodyParts ; part++)
+                    {
+                        const auto* partCandidatesPtr = &candidatesCpuPtr[part*peaksArea+3];
+                        const auto* const partCandidatesPtrEnd = partCandidatesPtr
+                                                               + 3*(offsets[part+1] - offsets[part]);
+                        for ( ; partCandidatesPtr < partCandidatesPtrEnd ; partCandidatesPtr += 3)
+                        {
+                            *candidatePtr++ = partCandidatesPtr[0] * mScaleNetToOutput;
+                            *candidatePtr++ = partCandidatesPtr[1] * mScaleNetToOutput;
+                            *candidatePtr++ = partCandidatesPtr[2];
+                        }
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     Array<float> PoseExtractorNet::getPoseKeypoints() const
     {
         try
@@ -323,6 +803,22 @@ namespace op
         }
     }
 
+    std::vector<DatumTimingEvent> PoseExtractorNet::takeGpuTimingEvents()
+    {
+        try
+        {
+            checkThread();
+            std::vector<DatumTimingEvent> gpuTimingEvents;
+            std::swap(gpuTimingEvents, mGpuTimingEvents);
+            return gpuTimingEvents;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
     double PoseExtractorNet::get(const PoseProperty property) const
     {
         try
@@ -0,0 +1,340 @@
+#include <openpose/pose/poseExtractorPool.hpp>
+#include <algorithm> // std::copy
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iomanip> // std::setprecision
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+    #include <openpose/gpu/cuda.hpp>
+#endif
+
+namespace op
+{
+    PoseExtractorPoolRequest::PoseExtractorPoolRequest() :
+        copyHeatMaps{false},
+        candidatesVolume{0},
+        scaleNetToOutput{-1.f},
+        heatMapsGpuPtr{nullptr},
+        heatMapsGpuVolume{0}
+    {
+    }
+
+    // Request waiting in (or being processed by) the pool
+    struct PoseExtractorPoolJob
+    {
+        PoseExtractorPoolRequest* pRequest;
+        bool done;
+        std::string errorMessage;
+    };
+
+    // Per-pipeline queue and statistics
+    struct PoseExtractorPoolClient
+    {
+        std::deque<PoseExtractorPoolJob*> jobs;
+        unsigned long long frames;
+        double waitMs;
+        bool removed;
+    };
+
+    struct PoseExtractorPool::ImplPoseExtractorPool
+    {
+        const std::shared_ptr<PoseExtractorNet> spPoseExtractorNet;
+        mutable std::mutex mMutex;
+        std::condition_variable mConditionVariable;
+        std::map<unsigned long long, PoseExtractorPoolClient> mClients;
+        unsigned long long mNextClientId;
+        // Next client to be served (round-robin)
+        unsigned long long mNextServedId;
+        bool mRunning;
+        bool mInitialized;
+        std::string mInitializationError;
+        std::thread mThread;
+
+        ImplPoseExtractorPool(const std::shared_ptr<PoseExtractorNet>& poseExtractorNet) :
+            spPoseExtractorNet{poseExtractorNet},
+            mNextClientId{0ull},
+            mNextServedId{0ull},
+            mRunning{false},
+            mInitialized{false}
+        {
+        }
+
+        // It returns the oldest job of the first client (starting from mNextServedId) with frames waiting
+        PoseExtractorPoolJob* nextJob(unsigned long long& clientId)
+        {
+            auto clientIterator = mClients.lower_bound(mNextServedId);
+            for (auto i = 0u ; i < mClients.size() ; i++, clientIterator++)
+            {
+                if (clientIterator == mClients.end())
+                    clientIterator = mClients.begin();
+                if (!clientIterator->second.jobs.empty())
+                {
+                    clientId = clientIterator->first;
+                    mNextServedId = clientId + 1;
+                    return clientIterator->second.jobs.front();
+                }
+            }
+            return nullptr;
+        }
+
+        void process(PoseExtractorPoolRequest& request)
+        {
+            auto& poseExtractorNet = *spPoseExtractorNet;
+            if (!request.netInputSizes.empty())
+            {
+                poseExtractorNet.reserveNetInputSizes(request.netInputSizes);
+                return;
+            }
+            // Post-processing parameters of the pipeline
+            for (auto i = 0u ; i < request.properties.size() && i < (unsigned int)PoseProperty::Size ; i++)
+                poseExtractorNet.set((PoseProperty)i, request.properties[i]);
+            poseExtractorNet.forwardPass(
+                request.inputNetData, request.inputDataSize, request.scaleInputToNetInputs, request.poseNetOutput);
+            request.poseKeypoints = poseExtractorNet.getPoseKeypoints().clone();
+            request.poseScores = poseExtractorNet.getPoseScores().clone();
+            request.scaleNetToOutput = poseExtractorNet.getScaleNetToOutput();
+            request.heatMapSize = poseExtractorNet.getHeatMapSize();
+            // Heat maps (the whole blob, its channels are selected by the pipeline)
+            if (request.copyHeatMaps && !request.heatMapSize.empty())
+            {
+                auto volume = size_t(1);
+                for (const auto dimension : request.heatMapSize)
+                    volume *= dimension;
+                #ifdef USE_CUDA
+                    // Device-to-device copy into the buffer of the pipeline (same GPU than this thread)
+                    if (request.heatMapsGpuVolume < volume)
+                    {
+                        if (request.heatMapsGpuPtr != nullptr)
+                            cudaFree(request.heatMapsGpuPtr);
+                        request.heatMapsGpuPtr = nullptr;
+                        request.heatMapsGpuVolume = 0;
+                        if (cudaMalloc((void**)&request.heatMapsGpuPtr, volume * sizeof(float)) != cudaSuccess)
+                            error("The device copy of the shared heat maps could not be allocated.",
+                                  __LINE__, __FUNCTION__, __FILE__);
+                        request.heatMapsGpuVolume = volume;
+                    }
+                    cudaMemcpy(request.heatMapsGpuPtr, poseExtractorNet.getHeatMapGpuConstPtr(),
+                               volume * sizeof(float), cudaMemcpyDeviceToDevice);
+                    // The pipeline reads it from its own thread (and stream)
+                    cudaStreamSynchronize(0);
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                #else
+                    request.heatMapsCpu.reset(request.heatMapSize);
+                    const auto* const heatMapsCpuPtr = poseExtractorNet.getHeatMapCpuConstPtr();
+                    std::copy(heatMapsCpuPtr, heatMapsCpuPtr + volume, request.heatMapsCpu.getPtr());
+                #endif
+            }
+            // Body part candidates
+            if (request.candidatesVolume > 0)
+            {
+                const auto* const candidatesCpuPtr = poseExtractorNet.getCandidatesCpuConstPtr();
+                if (candidatesCpuPtr != nullptr)
+                    request.candidates.assign(candidatesCpuPtr, candidatesCpuPtr + request.candidatesVolume);
+            }
+        }
+
+        void threadFunction()
+        {
+            try
+            {
+                // Network initialization on this thread, the only one that uses it
+                try
+                {
+                    spPoseExtractorNet->initializationOnThread();
+                }
+                catch (const std::exception& e)
+                {
+                    const std::lock_guard<std::mutex> lock{mMutex};
+                    mInitializationError = e.what();
+                }
+                {
+                    const std::lock_guard<std::mutex> lock{mMutex};
+                    mInitialized = true;
+                }
+                mConditionVariable.notify_all();
+                // Processing
+                std::unique_lock<std::mutex> lock{mMutex};
+                while (mRunning)
+                {
+                    unsigned long long clientId;
+                    auto* job = nextJob(clientId);
+                    if (job == nullptr)
+                    {
+                        mConditionVariable.wait(lock);
+                        continue;
+                    }
+                    lock.unlock();
+                    try
+                    {
+                        if (!mInitializationError.empty())
+                            error(mInitializationError, __LINE__, __FUNCTION__, __FILE__);
+                        process(*job->pRequest);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        job->errorMessage = e.what();
+                    }
+                    lock.lock();
+                    auto& client = mClients.at(clientId);
+                    client.jobs.pop_front();
+                    job->done = true;
+                    mConditionVariable.notify_all();
+                }
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+    };
+
+    std::shared_ptr<PoseExtractorPool> PoseExtractorPool::get(
+        const std::string& key, const std::function<std::shared_ptr<PoseExtractorNet>()>& netFactory)
+    {
+        try
+        {
+            // Process-wide registry (weak, so each pool dies with its last pipeline)
+            static std::mutex sMutex;
+            static std::map<std::string, std::weak_ptr<PoseExtractorPool>> sPools;
+            const std::lock_guard<std::mutex> lock{sMutex};
+            auto poseExtractorPool = sPools[key].lock();
+            if (poseExtractorPool == nullptr)
+            {
+                poseExtractorPool = std::make_shared<PoseExtractorPool>(netFactory());
+                sPools[key] = poseExtractorPool;
+                opLog("New shared body network pool: " + key, Priority::Low);
+            }
+            return poseExtractorPool;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    PoseExtractorPool::PoseExtractorPool(const std::shared_ptr<PoseExtractorNet>& poseExtractorNet) :
+        upImpl{new ImplPoseExtractorPool{poseExtractorNet}}
+    {
+        try
+        {
+            // Sanity check
+            if (poseExtractorNet == nullptr)
+                error("The network of PoseExtractorPool cannot be nullptr.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    PoseExtractorPool::~PoseExtractorPool()
+    {
+        try
+        {
+            {
+                const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+                upImpl->mRunning = false;
+            }
+            upImpl->mConditionVariable.notify_all();
+            if (upImpl->mThread.joinable())
+            {
+                upImpl->mThread.join();
+                opLog("Shared body network pool statistics:\n" + getStatsString(), Priority::High);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned long long PoseExtractorPool::addClient()
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{upImpl->mMutex};
+            const auto clientId = upImpl->mNextClientId++;
+            upImpl->mClients[clientId] = PoseExtractorPoolClient{{}, 0ull, 0., false};
+            if (!upImpl->mRunning)
+            {
+                upImpl->mRunning = true;
+                upImpl->mThread = std::thread{&ImplPoseExtractorPool::threadFunction, upImpl.get()};
+            }
+            upImpl->mConditionVariable.wait(lock, [this]{ return upImpl->mInitialized; });
+            if (!upImpl->mInitializationError.empty())
+                error("The shared body network could not be initialized: " + upImpl->mInitializationError,
+                      __LINE__, __FUNCTION__, __FILE__);
+            return clientId;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    void PoseExtractorPool::removeClient(const unsigned long long clientId)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->mClients.at(clientId).removed = true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorPool::run(const unsigned long long clientId, PoseExtractorPoolRequest& request)
+    {
+        try
+        {
+            const auto begin = std::chrono::high_resolution_clock::now();
+            PoseExtractorPoolJob job{&request, false, ""};
+            {
+                std::unique_lock<std::mutex> lock{upImpl->mMutex};
+                auto& client = upImpl->mClients.at(clientId);
+                client.jobs.emplace_back(&job);
+                upImpl->mConditionVariable.notify_all();
+                upImpl->mConditionVariable.wait(lock, [&job]{ return job.done; });
+                client.frames++;
+                client.waitMs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::high_resolution_clock::now() - begin).count() * 1e-6;
+            }
+            if (!job.errorMessage.empty())
+                error(job.errorMessage, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::string PoseExtractorPool::getStatsString() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            std::stringstream stringStream;
+            stringStream << std::fixed << std::setprecision(2);
+            for (const auto& client : upImpl->mClients)
+                stringStream << "Pipeline " << client.first << ": " << client.second.frames << " frames, "
+                             << (client.second.frames > 0ull ? client.second.waitMs / client.second.frames : 0.)
+                             << " ms per frame (waiting and processing)"
+                             << (client.second.removed ? " (finished)" : "") << ".\n";
+            return stringStream.str();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+}
@@ -0,0 +1,215 @@
+#include <openpose/pose/poseExtractorShared.hpp>
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+#endif
+
+namespace op
+{
+    PoseExtractorShared::PoseExtractorShared(
+        const std::shared_ptr<PoseExtractorPool>& poseExtractorPool, const PoseModel poseModel, const int gpuId,
+        const std::vector<HeatMapType>& heatMapTypes, const ScaleMode heatMapScaleMode, const bool addPartCandidates,
+        const bool maximizePositives, const bool copyHeatMaps) :
+        PoseExtractorNet{poseModel, heatMapTypes, heatMapScaleMode, addPartCandidates, maximizePositives},
+        spPoseExtractorPool{poseExtractorPool},
+        mGpuId{gpuId},
+        mRegistered{false},
+        mClientId{0ull}
+    {
+        try
+        {
+            // Sanity check
+            if (spPoseExtractorPool == nullptr)
+                error("The PoseExtractorPool of PoseExtractorShared cannot be nullptr.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            mRequest.copyHeatMaps = (copyHeatMaps || !heatMapTypes.empty());
+            mRequest.candidatesVolume = (addPartCandidates
+                ? size_t(getPoseNumberBodyParts(poseModel)) * (POSE_MAX_PEOPLE+1) * 3 : 0);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    PoseExtractorShared::~PoseExtractorShared()
+    {
+        try
+        {
+            if (mRegistered)
+                spPoseExtractorPool->removeClient(mClientId);
+            #ifdef USE_CUDA
+                if (mRequest.heatMapsGpuPtr != nullptr)
+                {
+                    int previousGpuId;
+                    cudaGetDevice(&previousGpuId);
+                    cudaSetDevice(mGpuId);
+                    cudaFree(mRequest.heatMapsGpuPtr);
+                    cudaSetDevice(previousGpuId);
+                }
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorShared::netInitializationOnThread()
+    {
+        try
+        {
+            if (!mRegistered)
+            {
+                mClientId = spPoseExtractorPool->addClient();
+                mRegistered = true;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorShared::forwardPass(
+        const std::vector<Array<float>>& inputNetData, const Point<int>& inputDataSize,
+        const std::vector<double>& scaleInputToNetInputs, const Array<float>& poseNetOutput)
+    {
+        try
+        {
+            checkThread();
+            mRequest.netInputSizes.clear();
+            mRequest.inputNetData = inputNetData;
+            mRequest.inputDataSize = inputDataSize;
+            mRequest.scaleInputToNetInputs = scaleInputToNetInputs;
+            mRequest.poseNetOutput = poseNetOutput;
+            mRequest.properties.resize((int)PoseProperty::Size);
+            for (auto i = 0u ; i < mRequest.properties.size() ; i++)
+                mRequest.properties[i] = get((PoseProperty)i);
+            spPoseExtractorPool->run(mClientId, mRequest);
+            // The inputs are not kept after the frame
+            mRequest.inputNetData.clear();
+            mRequest.poseNetOutput.reset();
+            // Results
+            mPoseKeypoints = mRequest.poseKeypoints;
+            mPoseScores = mRequest.poseScores;
+            mScaleNetToOutput = mRequest.scaleNetToOutput;
+            if (mRequest.heatMapSize.size() == 4)
+                mNetOutputSize = Point<int>{mRequest.heatMapSize[3], mRequest.heatMapSize[2]};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorShared::reserveNetInputSizes(const std::vector<std::vector<Point<int>>>& netInputSizes)
+    {
+        try
+        {
+            checkThread();
+            if (netInputSizes.empty())
+                return;
+            PoseExtractorPoolRequest request;
+            request.netInputSizes = netInputSizes;
+            spPoseExtractorPool->run(mClientId, request);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    const float* PoseExtractorShared::getCandidatesCpuConstPtr() const
+    {
+        try
+        {
+            checkThread();
+            return (mRequest.candidates.empty() ? nullptr : mRequest.candidates.data());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    const float* PoseExtractorShared::getCandidatesGpuConstPtr() const
+    {
+        try
+        {
+            error("GPU pointer for the part candidates of a shared network not available.",
+                  __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    const float* PoseExtractorShared::getHeatMapCpuConstPtr() const
+    {
+        try
+        {
+            checkThread();
+            #ifdef USE_CUDA
+                error("CPU pointer for the heat maps of a shared network not available with CUDA (use"
+                      " getHeatMapsCopy() instead).", __LINE__, __FUNCTION__, __FILE__);
+                return nullptr;
+            #else
+                return (mRequest.heatMapsCpu.empty() ? nullptr : mRequest.heatMapsCpu.getConstPtr());
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    const float* PoseExtractorShared::getHeatMapGpuConstPtr() const
+    {
+        try
+        {
+            checkThread();
+            if (!mRequest.copyHeatMaps)
+                error("The heat maps of this shared network are not copied (copyHeatMaps = false).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            return mRequest.heatMapsGpuPtr;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    std::vector<int> PoseExtractorShared::getHeatMapSize() const
+    {
+        try
+        {
+            checkThread();
+            return mRequest.heatMapSize;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    const float* PoseExtractorShared::getPoseGpuConstPtr() const
+    {
+        try
+        {
+            error("GPU pointer for people pose data not implemented yet.", __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+}
@@ -6,6 +6,7 @@
 #include <openpose/pose/poseParameters.hpp>
 #include <openpose/pose/renderPose.hpp>
 #include <openpose/gpu/cuda.hpp>
+#include <openpose/utilities/allocationTracker.hpp>
 #include <openpose/utilities/keypoint.hpp>
 
 namespace op
@@ -123,9 +124,10 @@ namespace op
                             const auto gpuPoseVolume = numberPeople * numberBodyParts * 3 * sizeof(float);
                             cudaMemcpy(
                                 pGpuPose, poseKeypointsRescaled.getConstPtr(), gpuPoseVolume, cudaMemcpyHostToDevice);
+                            AllocationTracker::recordCopy(gpuPoseVolume, MemoryCopy::HostToDevice);
                         }
                         renderPoseKeypointsGpu(
-                            *spGpuMemory, pMaxPtr, pMinPtr, pScalePtr, mPoseModel, numberPeople, frameSize, pGpuPose,
+                            getGpuMemory(), pMaxPtr, pMinPtr, pScalePtr, mPoseModel, numberPeople, frameSize, pGpuPose,
                             mRenderThreshold, mShowGooglyEyes, mBlendOriginalFrame, getAlphaKeypoint());
                     }
                     else
@@ -137,7 +139,21 @@ namespace op
                             error("Non valid scaleNetToOutput.", __LINE__, __FUNCTION__, __FILE__);
                         // Parameters
                         const auto& heatMapSizes = spPoseExtractorNet->getHeatMapSize();
-                        const Point<int> heatMapSize{heatMapSizes[3], heatMapSizes[2]};
+                        // Heat maps not upsampled yet (e.g., fused NMS or FP16 heat maps): They are rendered from
+                        // the network output, interpolated at the frame resolution, rather than upsampling all their
+                        // channels first
+                        const auto* heatMapGpuPtr = spPoseExtractorNet->getNetOutputGpuConstPtr();
+                        const auto fromNetOutput = (heatMapGpuPtr != nullptr);
+                        auto scaleHeatMapToOutput = scaleNetToOutput * scaleInputToOutput;
+                        Point<int> heatMapSize{heatMapSizes[3], heatMapSizes[2]};
+                        if (fromNetOutput)
+                        {
+                            const auto netOutputSizes = spPoseExtractorNet->getNetOutputSize();
+                            scaleHeatMapToOutput *= heatMapSizes[3] / (float)netOutputSizes[3];
+                            heatMapSize = Point<int>{netOutputSizes[3], netOutputSizes[2]};
+                        }
+                        else
+                            heatMapGpuPtr = spPoseExtractorNet->getHeatMapGpuConstPtr();
                         const auto lastPAFChannel = numberBodyPartsPlusBkg+2+numberBodyPAFChannels/2;
                         // Add all heatmaps
                         if (elementRendered == 2)
@@ -145,9 +161,8 @@ namespace op
                         {
                             elementRenderedName = "Heatmaps";
                             renderPoseHeatMapsGpu(
-                                *spGpuMemory, mPoseModel, frameSize, spPoseExtractorNet->getHeatMapGpuConstPtr(),
-                                heatMapSize, scaleNetToOutput * scaleInputToOutput,
-                                (mBlendOriginalFrame ? getAlphaHeatMap() : 1.f));
+                                getGpuMemory(), mPoseModel, frameSize, heatMapGpuPtr, heatMapSize, scaleHeatMapToOutput,
+                                (mBlendOriginalFrame ? getAlphaHeatMap() : 1.f), fromNetOutput);
                         }
                         // Draw PAFs (Part Affinity Fields)
                         else if (elementRendered == 3)
@@ -155,9 +170,8 @@ namespace op
                         {
                             elementRenderedName = "PAFs (Part Affinity Fields)";
                             renderPosePAFsGpu(
-                                *spGpuMemory, mPoseModel, frameSize, spPoseExtractorNet->getHeatMapGpuConstPtr(),
-                                heatMapSize, scaleNetToOutput * scaleInputToOutput,
-                                (mBlendOriginalFrame ? getAlphaHeatMap() : 1.f));
+                                getGpuMemory(), mPoseModel, frameSize, heatMapGpuPtr, heatMapSize, scaleHeatMapToOutput,
+                                (mBlendOriginalFrame ? getAlphaHeatMap() : 1.f), fromNetOutput);
                         }
                         // Draw specific body part or background
                         else if (elementRendered <= numberBodyPartsPlusBkg+2)
@@ -167,8 +181,8 @@ namespace op
                                                                 : elementRendered - 3 - (hasBkg ? 1:0));
                             elementRenderedName = mPartIndexToName.at(realElementRendered);
                             renderPoseHeatMapGpu(
-                                *spGpuMemory, frameSize, spPoseExtractorNet->getHeatMapGpuConstPtr(), heatMapSize,
-                                scaleNetToOutput * scaleInputToOutput, realElementRendered,
+                                getGpuMemory(), frameSize, heatMapGpuPtr, heatMapSize, scaleHeatMapToOutput,
+                                realElementRendered,
                                 (mBlendOriginalFrame ? getAlphaHeatMap() : 1.f));
                         }
                         // Draw affinity between 2 body parts
@@ -180,8 +194,8 @@ namespace op
                             elementRenderedName = mPartIndexToName.at(affinityPartMapped);
                             elementRenderedName = elementRenderedName.substr(0, elementRenderedName.find("("));
                             renderPosePAFGpu(
-                                *spGpuMemory, mPoseModel, frameSize, spPoseExtractorNet->getHeatMapGpuConstPtr(),
-                                heatMapSize, scaleNetToOutput * scaleInputToOutput, affinityPartMapped,
+                                getGpuMemory(), mPoseModel, frameSize, heatMapGpuPtr, heatMapSize, scaleHeatMapToOutput,
+                                affinityPartMapped,
                                 (mBlendOriginalFrame ? getAlphaHeatMap() : 1.f));
                         }
                         // Draw neck-part distance channel
@@ -195,8 +209,8 @@ namespace op
                                 numberBodyPartsPlusBkg + numberBodyPAFChannels + distancePart);
                             elementRenderedName = mPartIndexToName.at(distancePartMapped);
                             renderPoseDistanceGpu(
-                                *spGpuMemory, frameSize, spPoseExtractorNet->getHeatMapGpuConstPtr(), heatMapSize,
-                                scaleNetToOutput * scaleInputToOutput, distancePartMapped,
+                                getGpuMemory(), frameSize, heatMapGpuPtr, heatMapSize, scaleHeatMapToOutput,
+                                distancePartMapped,
                                 (mBlendOriginalFrame ? getAlphaHeatMap() : 1.f));
                         }
                     }
@@ -222,4 +236,18 @@ namespace op
             return std::make_pair(-1, "");
         }
     }
+
+    GpuMemoryFootprint PoseGpuRenderer::getGpuMemoryFootprint(const Point<int>& outputSize)
+    {
+        try
+        {
+            return GpuMemoryFootprint{
+                "GPU renderers", 3ull * sizeof(float) * outputSize.area() + (1ull << 20), 0ull};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return GpuMemoryFootprint{};
+        }
+    }
 }
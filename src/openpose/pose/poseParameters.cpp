@@ -755,6 +755,33 @@ namespace op
         }
     }
 
+    float getPoseDefaultConnectMaxLimbLength()
+    {
+        try
+        {
+            // No candidate pruning by default, so the results do not change
+            return 1.f;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.f;
+        }
+    }
+
+    float getPoseDefaultConnectMinPeakScore()
+    {
+        try
+        {
+            return 0.f;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.f;
+        }
+    }
+
     bool addBkgChannel(const PoseModel poseModel)
     {
         try
@@ -1,5 +1,7 @@
 #include <openpose/pose/renderPose.hpp>
 #include <openpose/gpu/cuda.hpp>
+#include <openpose/gpu/cudaAutotune.hpp>
+#include <openpose/gpu/cudaMemoryPool.hpp>
 #include <openpose/pose/poseParameters.hpp>
 #include <openpose_private/gpu/cuda.hu>
 #include <openpose_private/utilities/render.hu>
@@ -126,300 +128,59 @@ namespace op
             maxPtr, minPtr, scalePtr, targetWidth, targetHeight, keypointsPtr, numberPeople, numberParts, threshold);
     }
 
-    __global__ void renderPoseCoco(
-        float* targetPtr, float* minPtr, float* maxPtr, float* scalePtr, const unsigned int targetWidth,
-        const unsigned int targetHeight, const float* const posePtr, const int numberPeople, const float threshold,
-        const bool googlyEyes, const bool blendOriginalFrame, const float alphaColorToAdd)
-    {
-        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
-        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
-        const auto globalIdx = threadIdx.y * blockDim.x + threadIdx.x;
-
-        // Shared parameters
-        __shared__ float2 sharedMins[POSE_MAX_PEOPLE];
-        __shared__ float2 sharedMaxs[POSE_MAX_PEOPLE];
-        // __shared__ float sharedMins[2*POSE_MAX_PEOPLE];
-        // __shared__ float sharedMaxs[2*POSE_MAX_PEOPLE];
-        __shared__ float sharedScaleF[POSE_MAX_PEOPLE];
-
-        // Other parameters
-        const auto numberPartPairs = sizeof(COCO_PAIRS_GPU) / (2*sizeof(COCO_PAIRS_GPU[0]));
-        const auto numberScales = sizeof(COCO_SCALES) / sizeof(COCO_SCALES[0]);
-        const auto numberColors = sizeof(COCO_COLORS) / (3*sizeof(COCO_COLORS[0]));
-        const auto radius = fastMinCuda(targetWidth, targetHeight) / 100.f;
-        const auto lineWidth = fastMinCuda(targetWidth, targetHeight) / 120.f;
-
-        // Render key points
-        // Note: renderKeypoints is not working for videos with many people, renderKeypointsOld speed was slightly improved instead
-        renderKeypointsOld( // renderKeypoints(
-            targetPtr, sharedMaxs, sharedMins, sharedScaleF, // maxPtr, minPtr, scalePtr,
-            globalIdx, x, y, targetWidth, targetHeight, posePtr, COCO_PAIRS_GPU, numberPeople, 18, numberPartPairs,
-            COCO_COLORS, numberColors, radius, lineWidth, COCO_SCALES, numberScales, threshold, alphaColorToAdd,
-            blendOriginalFrame, (googlyEyes ? 14 : -1), (googlyEyes ? 15 : -1));
-    }
-
-    __global__ void renderPoseBody19(
-        float* targetPtr, float* minPtr, float* maxPtr, float* scalePtr, const unsigned int targetWidth,
-        const unsigned int targetHeight, const float* const posePtr, const int numberPeople, const float threshold,
-        const bool googlyEyes, const bool blendOriginalFrame, const float alphaColorToAdd)
-    {
-        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
-        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
-        const auto globalIdx = threadIdx.y * blockDim.x + threadIdx.x;
-
-        // Shared parameters
-        __shared__ float2 sharedMins[POSE_MAX_PEOPLE];
-        __shared__ float2 sharedMaxs[POSE_MAX_PEOPLE];
-        // __shared__ float sharedMins[2*POSE_MAX_PEOPLE];
-        // __shared__ float sharedMaxs[2*POSE_MAX_PEOPLE];
-        __shared__ float sharedScaleF[POSE_MAX_PEOPLE];
-
-        // Other parameters
-        const auto numberPartPairs = sizeof(BODY_19_PAIRS_GPU) / (2*sizeof(BODY_19_PAIRS_GPU[0]));
-        const auto numberScales = sizeof(BODY_19_SCALES) / sizeof(BODY_19_SCALES[0]);
-        const auto numberColors = sizeof(BODY_19_COLORS) / (3*sizeof(BODY_19_COLORS[0]));
-        const auto radius = fastMinCuda(targetWidth, targetHeight) / 100.f;
-        const auto lineWidth = fastMinCuda(targetWidth, targetHeight) / 120.f;
-
-        // Render key points
-        // Note: renderKeypoints is not working for videos with many people, renderKeypointsOld speed was slightly improved instead
-        renderKeypointsOld( // renderKeypoints(
-            targetPtr, sharedMaxs, sharedMins, sharedScaleF, // maxPtr, minPtr, scalePtr,
-            globalIdx, x, y, targetWidth, targetHeight, posePtr, BODY_19_PAIRS_GPU, numberPeople, 19, numberPartPairs,
-            BODY_19_COLORS, numberColors, radius, lineWidth, BODY_19_SCALES, numberScales, threshold, alphaColorToAdd,
-            blendOriginalFrame, (googlyEyes ? 15 : -1),
-            (googlyEyes ? 16 : -1));
-    }
-
-    __global__ void renderPoseBody23(
-        float* targetPtr, float* minPtr, float* maxPtr, float* scalePtr, const unsigned int targetWidth,
-        const unsigned int targetHeight, const float* const posePtr, const int numberPeople, const float threshold,
-        const bool googlyEyes, const bool blendOriginalFrame, const float alphaColorToAdd)
-    {
-        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
-        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
-        const auto globalIdx = threadIdx.y * blockDim.x + threadIdx.x;
-
-        // Shared parameters
-        __shared__ float2 sharedMins[POSE_MAX_PEOPLE];
-        __shared__ float2 sharedMaxs[POSE_MAX_PEOPLE];
-        // __shared__ float sharedMins[2*POSE_MAX_PEOPLE];
-        // __shared__ float sharedMaxs[2*POSE_MAX_PEOPLE];
-        __shared__ float sharedScaleF[POSE_MAX_PEOPLE];
-
-        // Other parameters
-        const auto numberPartPairs = sizeof(BODY_23_PAIRS_GPU) / (2*sizeof(BODY_23_PAIRS_GPU[0]));
-        const auto numberScales = sizeof(BODY_23_SCALES) / sizeof(BODY_23_SCALES[0]);
-        const auto numberColors = sizeof(BODY_23_COLORS) / (3*sizeof(BODY_23_COLORS[0]));
-        const auto radius = fastMinCuda(targetWidth, targetHeight) / 100.f;
-        const auto lineWidth = fastMinCuda(targetWidth, targetHeight) / 120.f;
-
-        // Render key points
-        // Note: renderKeypoints is not working for videos with many people, renderKeypointsOld speed was slightly improved instead
-        renderKeypointsOld( // renderKeypoints(
-            targetPtr, sharedMaxs, sharedMins, sharedScaleF, // maxPtr, minPtr, scalePtr,
-            globalIdx, x, y, targetWidth, targetHeight, posePtr, BODY_23_PAIRS_GPU, numberPeople, 23, numberPartPairs,
-            BODY_23_COLORS, numberColors, radius, lineWidth, BODY_23_SCALES, numberScales, threshold, alphaColorToAdd,
-            blendOriginalFrame, (googlyEyes ? 13 : -1), (googlyEyes ? 14 : -1));
-    }
-
-    __global__ void renderPoseBody25(
-        float* targetPtr, float* minPtr, float* maxPtr, float* scalePtr, const int targetWidth,
-        const int targetHeight, const float* const posePtr, const int numberPeople, const float threshold,
-        const bool googlyEyes, const bool blendOriginalFrame, const float alphaColorToAdd)
-    {
-        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
-        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
-        const auto globalIdx = threadIdx.y * blockDim.x + threadIdx.x;
-
-        // Shared parameters
-        __shared__ float2 sharedMins[POSE_MAX_PEOPLE];
-        __shared__ float2 sharedMaxs[POSE_MAX_PEOPLE];
-        // __shared__ float sharedMins[2*POSE_MAX_PEOPLE];
-        // __shared__ float sharedMaxs[2*POSE_MAX_PEOPLE];
-        __shared__ float sharedScaleF[POSE_MAX_PEOPLE];
-
-        // Other parameters
-        const auto numberPartPairs = sizeof(BODY_25_PAIRS_GPU) / (2*sizeof(BODY_25_PAIRS_GPU[0]));
-        const auto numberScales = sizeof(BODY_25_SCALES) / sizeof(BODY_25_SCALES[0]);
-        const auto numberColors = sizeof(BODY_25_COLORS) / (3*sizeof(BODY_25_COLORS[0]));
-        const auto radius = fastMinCuda(targetWidth, targetHeight) / 100.f;
-        const auto lineWidth = fastMinCuda(targetWidth, targetHeight) / 120.f;
-
-        // Render key points
-        // Note: renderKeypoints is not working for videos with many people, renderKeypointsOld speed was slightly improved instead
-        renderKeypointsOld( // renderKeypoints(
-            targetPtr, sharedMaxs, sharedMins, sharedScaleF, // maxPtr, minPtr, scalePtr,
-            globalIdx, x, y, targetWidth, targetHeight,
-            posePtr, BODY_25_PAIRS_GPU, numberPeople, 25, numberPartPairs, BODY_25_COLORS, numberColors,
-            radius, lineWidth, BODY_25_SCALES, numberScales, threshold, alphaColorToAdd,
-            blendOriginalFrame, (googlyEyes ? 15 : -1), (googlyEyes ? 16 : -1));
-    }
-
-    __global__ void renderPoseBody25b(
-        float* targetPtr, float* minPtr, float* maxPtr, float* scalePtr, const unsigned int targetWidth,
-        const unsigned int targetHeight, const float* const posePtr, const int numberPeople, const float threshold,
-        const bool googlyEyes, const bool blendOriginalFrame, const float alphaColorToAdd)
+    __global__ void binPeopleIntoTilesPose(
+        unsigned int* tileMasksPtr, const float* const maxPtr, const float* const minPtr, const unsigned int tileWidth,
+        const unsigned int tileHeight, const unsigned int numberTilesX, const unsigned int numberTilesY,
+        const int numberPeople)
     {
-        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
-        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
-        const auto globalIdx = threadIdx.y * blockDim.x + threadIdx.x;
-
-        // Shared parameters
-        __shared__ float2 sharedMins[POSE_MAX_PEOPLE];
-        __shared__ float2 sharedMaxs[POSE_MAX_PEOPLE];
-        // __shared__ float sharedMins[2*POSE_MAX_PEOPLE];
-        // __shared__ float sharedMaxs[2*POSE_MAX_PEOPLE];
-        __shared__ float sharedScaleF[POSE_MAX_PEOPLE];
-
-        // Other parameters
-        const auto numberPartPairs = sizeof(BODY_25B_PAIRS_GPU) / (2*sizeof(BODY_25B_PAIRS_GPU[0]));
-        const auto numberScales = sizeof(BODY_25B_SCALES) / sizeof(BODY_25B_SCALES[0]);
-        const auto numberColors = sizeof(BODY_25B_COLORS) / (3*sizeof(BODY_25B_COLORS[0]));
-        const auto radius = fastMinCuda(targetWidth, targetHeight) / 100.f;
-        const auto lineWidth = fastMinCuda(targetWidth, targetHeight) / 120.f;
-
-        // Render key points
-        // Note: renderKeypoints is not working for videos with many people, renderKeypointsOld speed was slightly improved instead
-        renderKeypointsOld( // renderKeypoints(
-            targetPtr, sharedMaxs, sharedMins, sharedScaleF, // maxPtr, minPtr, scalePtr,
-            globalIdx, x, y, targetWidth, targetHeight, posePtr, BODY_25B_PAIRS_GPU, numberPeople, 25, numberPartPairs,
-            BODY_25B_COLORS, numberColors, radius, lineWidth, BODY_25B_SCALES, numberScales, threshold, alphaColorToAdd,
-            blendOriginalFrame, (googlyEyes ? 1 : -1), (googlyEyes ? 2 : -1));
+        binPeopleIntoTiles(
+            tileMasksPtr, maxPtr, minPtr, tileWidth, tileHeight, numberTilesX, numberTilesY, numberPeople);
     }
 
-    __global__ void renderPoseBody135(
-        float* targetPtr, float* minPtr, float* maxPtr, float* scalePtr, const unsigned int targetWidth,
+    // Compile-time rendering tables of each model, i.e., name, #parts, pairs, colors, scales and googly eye parts
+    DEFINE_KEYPOINT_RENDER_TABLES(
+        PoseCocoRenderTables, 18, COCO_PAIRS_GPU, COCO_COLORS, COCO_SCALES, 14, 15);
+    DEFINE_KEYPOINT_RENDER_TABLES(
+        PoseBody19RenderTables, 19, BODY_19_PAIRS_GPU, BODY_19_COLORS, BODY_19_SCALES, 15, 16);
+    DEFINE_KEYPOINT_RENDER_TABLES(
+        PoseBody23RenderTables, 23, BODY_23_PAIRS_GPU, BODY_23_COLORS, BODY_23_SCALES, 13, 14);
+    DEFINE_KEYPOINT_RENDER_TABLES(
+        PoseBody25RenderTables, 25, BODY_25_PAIRS_GPU, BODY_25_COLORS, BODY_25_SCALES, 15, 16);
+    DEFINE_KEYPOINT_RENDER_TABLES(
+        PoseBody25bRenderTables, 25, BODY_25B_PAIRS_GPU, BODY_25B_COLORS, BODY_25B_SCALES, 1, 2);
+    DEFINE_KEYPOINT_RENDER_TABLES(
+        PoseBody135RenderTables, 135, BODY_135_PAIRS_GPU, BODY_135_COLORS, BODY_135_SCALES, 1, 2);
+    DEFINE_KEYPOINT_RENDER_TABLES(
+        PoseMpiRenderTables, 15, MPI_PAIRS_GPU, MPI_COLORS, MPI_SCALES, -1, -1);
+    DEFINE_KEYPOINT_RENDER_TABLES(
+        PoseCar12RenderTables, 12, CAR_12_PAIRS_GPU, CAR_12_COLORS, CAR_12_SCALES, 4, 5);
+    DEFINE_KEYPOINT_RENDER_TABLES(
+        PoseCar22RenderTables, 22, CAR_22_PAIRS_GPU, CAR_22_COLORS, CAR_22_SCALES, 6, 7);
+
+    template <typename TPoseRenderTables>
+    __global__ void renderPoseKeypointsTiled(
+        float* targetPtr, const unsigned int* const tileMasksPtr, const float* const minPtr,
+        const float* const maxPtr, const float* const scalePtr, const unsigned int targetWidth,
         const unsigned int targetHeight, const float* const posePtr, const int numberPeople, const float threshold,
         const bool googlyEyes, const bool blendOriginalFrame, const float alphaColorToAdd)
     {
         const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
         const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
-        const auto globalIdx = threadIdx.y * blockDim.x + threadIdx.x;
-
-        // Shared parameters
-        __shared__ float2 sharedMins[POSE_MAX_PEOPLE];
-        __shared__ float2 sharedMaxs[POSE_MAX_PEOPLE];
-        // __shared__ float sharedMins[2*POSE_MAX_PEOPLE];
-        // __shared__ float sharedMaxs[2*POSE_MAX_PEOPLE];
-        __shared__ float sharedScaleF[POSE_MAX_PEOPLE];
 
         // Other parameters
-        const auto numberPartPairs = sizeof(BODY_135_PAIRS_GPU) / (2*sizeof(BODY_135_PAIRS_GPU[0]));
-        const auto numberScales = sizeof(BODY_135_SCALES) / sizeof(BODY_135_SCALES[0]);
-        const auto numberColors = sizeof(BODY_135_COLORS) / (3*sizeof(BODY_135_COLORS[0]));
         const auto radius = fastMinCuda(targetWidth, targetHeight) / 100.f;
         const auto lineWidth = fastMinCuda(targetWidth, targetHeight) / 120.f;
 
         // Render key points
-        // Note: renderKeypoints is not working for videos with many people, renderKeypointsOld speed was slightly improved instead
-        renderKeypointsOld( // renderKeypoints(
-            targetPtr, sharedMaxs, sharedMins, sharedScaleF, // maxPtr, minPtr, scalePtr,
-            globalIdx, x, y, targetWidth, targetHeight, posePtr, BODY_135_PAIRS_GPU, numberPeople, 135,
-            numberPartPairs, BODY_135_COLORS, numberColors, radius, lineWidth, BODY_135_SCALES, numberScales,
-            threshold, alphaColorToAdd, blendOriginalFrame, (googlyEyes ? 1 : -1), (googlyEyes ? 2 : -1));
-    }
-
-    __global__ void renderPoseMpi29Parts(
-        float* targetPtr, float* minPtr, float* maxPtr, float* scalePtr, const unsigned int targetWidth,
-        const unsigned int targetHeight, const float* const posePtr, const int numberPeople, const float threshold,
-        const bool blendOriginalFrame, const float alphaColorToAdd)
-    {
-        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
-        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
-        const auto globalIdx = threadIdx.y * blockDim.x + threadIdx.x;
-
-        // Shared parameters
-        __shared__ float2 sharedMins[POSE_MAX_PEOPLE];
-        __shared__ float2 sharedMaxs[POSE_MAX_PEOPLE];
-        // __shared__ float sharedMins[2*POSE_MAX_PEOPLE];
-        // __shared__ float sharedMaxs[2*POSE_MAX_PEOPLE];
-        __shared__ float sharedScaleF[POSE_MAX_PEOPLE];
-
-        // Other parameters
-        const auto numberPartPairs = sizeof(MPI_PAIRS_GPU) / (2*sizeof(MPI_PAIRS_GPU[0]));
-        const auto numberScales = sizeof(MPI_SCALES) / sizeof(MPI_SCALES[0]);
-        const auto numberColors = sizeof(MPI_COLORS) / (3*sizeof(MPI_COLORS[0]));
-        const auto radius = fastMinCuda(targetWidth, targetHeight) / 100.f;
-        const auto lineWidth = fastMinCuda(targetWidth, targetHeight) / 120.f;
-
-        // Render key points
-        // Note: renderKeypoints is not working for videos with many people, renderKeypointsOld speed was slightly improved instead
-        renderKeypointsOld( // renderKeypoints(
-            targetPtr, sharedMaxs, sharedMins, sharedScaleF, // maxPtr, minPtr, scalePtr,
-            globalIdx, x, y, targetWidth, targetHeight, posePtr, MPI_PAIRS_GPU, numberPeople, 15, numberPartPairs,
-            MPI_COLORS, numberColors, radius, lineWidth, COCO_SCALES, numberScales, threshold, alphaColorToAdd,
-            blendOriginalFrame);
-    }
-
-    __global__ void renderPoseCar12(
-        float* targetPtr, float* minPtr, float* maxPtr, float* scalePtr, const unsigned int targetWidth,
-        const unsigned int targetHeight, const float* const posePtr, const int numberPeople, const float threshold,
-        const bool googlyEyes, const bool blendOriginalFrame, const float alphaColorToAdd)
-    {
-        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
-        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
-        const auto globalIdx = threadIdx.y * blockDim.x + threadIdx.x;
-
-        // Shared parameters
-        __shared__ float2 sharedMins[POSE_MAX_PEOPLE];
-        __shared__ float2 sharedMaxs[POSE_MAX_PEOPLE];
-        // __shared__ float sharedMins[2*POSE_MAX_PEOPLE];
-        // __shared__ float sharedMaxs[2*POSE_MAX_PEOPLE];
-        __shared__ float sharedScaleF[POSE_MAX_PEOPLE];
-
-        // Other parameters
-        const auto numberPartPairs = sizeof(CAR_12_PAIRS_GPU) / (2*sizeof(CAR_12_PAIRS_GPU[0]));
-        const auto numberScales = sizeof(CAR_12_SCALES) / sizeof(CAR_12_SCALES[0]);
-        const auto numberColors = sizeof(CAR_12_COLORS) / (3*sizeof(CAR_12_COLORS[0]));
-        const auto radius = fastMinCuda(targetWidth, targetHeight) / 100.f;
-        const auto lineWidth = fastMinCuda(targetWidth, targetHeight) / 120.f;
-
-        // Render key points
-        // Note: renderKeypoints is not working for videos with many people, renderKeypointsOld speed was slightly improved instead
-        renderKeypointsOld( // renderKeypoints(
-            targetPtr, sharedMaxs, sharedMins, sharedScaleF, // maxPtr, minPtr, scalePtr,
-            globalIdx, x, y, targetWidth, targetHeight, posePtr, CAR_12_PAIRS_GPU, numberPeople, 12, numberPartPairs,
-            CAR_12_COLORS, numberColors, radius, lineWidth, CAR_12_SCALES, numberScales, threshold, alphaColorToAdd,
-            blendOriginalFrame, (googlyEyes ? 4 : -1), (googlyEyes ? 5 : -1));
-    }
-
-    __global__ void renderPoseCar22(
-        float* targetPtr, float* minPtr, float* maxPtr, float* scalePtr, const unsigned int targetWidth,
-        const unsigned int targetHeight, const float* const posePtr, const int numberPeople, const float threshold,
-        const bool googlyEyes, const bool blendOriginalFrame, const float alphaColorToAdd)
-    {
-        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
-        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
-        const auto globalIdx = threadIdx.y * blockDim.x + threadIdx.x;
-
-        // Shared parameters
-        __shared__ float2 sharedMins[POSE_MAX_PEOPLE];
-        __shared__ float2 sharedMaxs[POSE_MAX_PEOPLE];
-        // __shared__ float sharedMins[2*POSE_MAX_PEOPLE];
-        // __shared__ float sharedMaxs[2*POSE_MAX_PEOPLE];
-        __shared__ float sharedScaleF[POSE_MAX_PEOPLE];
-
-        // Other parameters
-        const auto numberPartPairs = sizeof(CAR_22_PAIRS_GPU) / (2*sizeof(CAR_22_PAIRS_GPU[0]));
-        const auto numberScales = sizeof(CAR_22_SCALES) / sizeof(CAR_22_SCALES[0]);
-        const auto numberColors = sizeof(CAR_22_COLORS) / (3*sizeof(CAR_22_COLORS[0]));
-        const auto radius = fastMinCuda(targetWidth, targetHeight) / 100.f;
-        const auto lineWidth = fastMinCuda(targetWidth, targetHeight) / 120.f;
-
-        // Render key points
-        // Note: renderKeypoints is not working for videos with many people, renderKeypointsOld speed was slightly improved instead
-        renderKeypointsOld( // renderKeypoints(
-            targetPtr, sharedMaxs, sharedMins, sharedScaleF, // maxPtr, minPtr, scalePtr,
-            globalIdx, x, y, targetWidth, targetHeight, posePtr, CAR_22_PAIRS_GPU, numberPeople, 22, numberPartPairs,
-            CAR_22_COLORS, numberColors, radius, lineWidth, CAR_22_SCALES, numberScales, threshold, alphaColorToAdd,
-            blendOriginalFrame, (googlyEyes ? 6 : -1), (googlyEyes ? 7 : -1));
+        renderKeypointsTiled<TPoseRenderTables>(
+            targetPtr, tileMasksPtr, maxPtr, minPtr, scalePtr, x, y, targetWidth, targetHeight, posePtr,
+            numberPeople, radius, lineWidth, threshold, alphaColorToAdd, blendOriginalFrame, googlyEyes);
     }
 
     __global__ void renderBodyPartHeatMaps(
         float* targetPtr, const unsigned int targetWidth, const unsigned int targetHeight,
         const float* const heatMapPtr, const int widthHeatMap, const int heightHeatMap, const float scaleToKeepRatio,
-        const int numberBodyParts, const float alphaColorToAdd)
+        const int numberBodyParts, const float alphaColorToAdd, const bool interpolate)
     {
         const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
         const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
@@ -434,11 +195,24 @@ namespace op
             const auto xHeatMap = fastTruncateCuda(int(xSource + 1e-5), 0, widthHeatMap);
             const auto yHeatMap = fastTruncateCuda(int(ySource + 1e-5), 0, heightHeatMap);
             const auto heatMapArea = widthHeatMap * heightHeatMap;
+            // Bilinear interpolation (same neighbors and weights for all the channels)
+            int xIntArray[4];
+            int yIntArray[4];
+            float dx = 0.f;
+            float dy = 0.f;
+            if (interpolate)
+                cubicSequentialData(xIntArray, yIntArray, dx, dy, xSource, ySource, widthHeatMap, heightHeatMap);
             for (auto part = 0u ; part < numberBodyParts ; part++)
             {
                 const auto offsetOrigin = part * heatMapArea;
                 // __saturatef = trucate to [0,1]
-                const auto value = __saturatef(heatMapPtr[offsetOrigin + yHeatMap*widthHeatMap + xHeatMap]);
+                const auto value = __saturatef(
+                    interpolate
+                        ? (1-dx)*(1-dy)*heatMapPtr[offsetOrigin + yIntArray[1]*widthHeatMap + xIntArray[1]]
+                          + dx*(1-dy)*heatMapPtr[offsetOrigin + yIntArray[1]*widthHeatMap + xIntArray[2]]
+                          + (1-dx)*dy*heatMapPtr[offsetOrigin + yIntArray[2]*widthHeatMap + xIntArray[1]]
+                          + dx*dy*heatMapPtr[offsetOrigin + yIntArray[2]*widthHeatMap + xIntArray[2]]
+                        : heatMapPtr[offsetOrigin + yHeatMap*widthHeatMap + xHeatMap]);
                 const auto rgbColorIndex = (part%numberColors)*3;
                 rgbColor[0] += value*COCO_COLORS[rgbColorIndex];
                 rgbColor[1] += value*COCO_COLORS[rgbColorIndex+1];
@@ -482,7 +256,8 @@ namespace op
     __global__ void renderPartAffinities(
         float* targetPtr, const unsigned int targetWidth, const unsigned int targetHeight,
         const float* const heatMapPtr, const int widthHeatMap, const int heightHeatMap,
-        const float scaleToKeepRatio, const int partsToRender, const int initPart, const float alphaColorToAdd)
+        const float scaleToKeepRatio, const int partsToRender, const int initPart, const float alphaColorToAdd,
+        const bool interpolate)
     {
         const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
         const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
@@ -506,7 +281,7 @@ namespace op
                 const auto offsetOriginY = (part+1) * heatMapArea;
                 auto valueX = heatMapPtr[offsetOriginX + yIntArray[1]*widthHeatMap + xIntArray[1]];
                 auto valueY = heatMapPtr[offsetOriginY + yIntArray[1]*widthHeatMap + xIntArray[1]];
-                if (partsToRender == 1)
+                if (partsToRender == 1 || interpolate)
                 {
                     const auto xB = heatMapPtr[offsetOriginX + yIntArray[1]*widthHeatMap + xIntArray[2]];
                     const auto xC = heatMapPtr[offsetOriginX + yIntArray[2]*widthHeatMap + xIntArray[1]];
@@ -584,7 +359,7 @@ namespace op
     inline void renderPosePAFGpuAux(float* framePtr, const PoseModel poseModel, const Point<unsigned int>& frameSize,
                                     const float* const heatMapPtr, const Point<int>& heatMapSize,
                                     const float scaleToKeepRatio, const int part, const int partsToRender,
-                                    const float alphaBlending)
+                                    const float alphaBlending, const bool interpolate = false)
     {
         try
         {
@@ -597,7 +372,7 @@ namespace op
             getNumberCudaThreadsAndBlocks(threadsPerBlock, numBlocks, frameSize);
             renderPartAffinities<<<threadsPerBlock, numBlocks>>>(framePtr, frameSize.x, frameSize.y, heatMapPtr,
                                                                  heatMapSize.x, heatMapSize.y, scaleToKeepRatio,
-                                                                 partsToRender, part, alphaBlending);
+                                                                 partsToRender, part, alphaBlending, interpolate);
             cudaCheck(__LINE__, __FUNCTION__, __FILE__);
         }
         catch (const std::exception& e)
@@ -625,120 +400,137 @@ namespace op
                     error("Rendering assumes that numberPeople <= POSE_MAX_PEOPLE = " + std::to_string(POSE_MAX_PEOPLE)
                           + ".", __LINE__, __FUNCTION__, __FILE__);
 
-                //// Get bounding box per person
-                //const dim3 threadsPerBlockBoundBox = {1, 1, 1};
-                //const dim3 numBlocksBox{getNumberCudaBlocks(POSE_MAX_PEOPLE, threadsPerBlockBoundBox.x)};
-                //getBoundingBoxPerPersonPose<<<threadsPerBlockBoundBox, numBlocksBox>>>(
-                //    maxPtr, minPtr, scalePtr, frameSize.x, frameSize.y, posePtr, numberPeople,
-                //    getPoseNumberBodyParts(poseModel), renderThreshold);
+                // Get bounding box per person
+                if (numberPeople > 0)
+                    getBoundingBoxPerPersonPose<<<1, numberPeople>>>(
+                        maxPtr, minPtr, scalePtr, frameSize.x, frameSize.y, posePtr, numberPeople,
+                        getPoseNumberBodyParts(poseModel), renderThreshold);
 
                 // Body pose
+                const auto renderSkeleton = [&](const dim3& threadsPerBlock, const dim3& numBlocks, float* targetPtr)
+                {
+                    // Tile-binned rendering: Bin the people into tiles (1 per block of the rendering kernel), so each
+                    // block only renders the people overlapping its tile
+                    const auto numberTiles = threadsPerBlock.x * threadsPerBlock.y;
+                    auto* tileMasksPtr = (unsigned int*)cudaPoolMalloc(
+                        sizeof(unsigned int) * RENDER_TILE_MASK_WORDS * numberTiles);
+                    const dim3 threadsPerBlockBin{16, 16, 1};
+                    const dim3 numBlocksBin{getNumberCudaBlocks(threadsPerBlock.x, threadsPerBlockBin.x),
+                                            getNumberCudaBlocks(threadsPerBlock.y, threadsPerBlockBin.y)};
+                    binPeopleIntoTilesPose<<<numBlocksBin, threadsPerBlockBin>>>(
+                        tileMasksPtr, maxPtr, minPtr, numBlocks.x, numBlocks.y, threadsPerBlock.x, threadsPerBlock.y,
+                        numberPeople);
+                    if (poseModel == PoseModel::BODY_25 || poseModel == PoseModel::BODY_25D
+                        || poseModel == PoseModel::BODY_25E)
+                    {
+                        // const auto REPS = 1000;
+                        // double timeNormalize0 = 0.;
+                        // double timeNormalize1 = 0.;
+
+                        // // Non-optimized code
+                        // OP_CUDA_PROFILE_INIT(REPS);
+                        // renderPoseBody25Old<<<threadsPerBlock, numBlocks>>>(
+                        //     framePtr, frameSize.x, frameSize.y, posePtr, numberPeople, renderThreshold, googlyEyes,
+                        //     blendOriginalFrame, alphaBlending
+                        // );
+                        // OP_CUDA_PROFILE_END(timeNormalize0, 1e3, REPS);
+
+                        // Optimized code
+                        // OP_CUDA_PROFILE_INIT(REPS);
+                        // const dim3 threadsPerBlockBoundBox = {1, 1, 1};
+                        // const dim3 numBlocksBox{getNumberCudaBlocks(POSE_MAX_PEOPLE, threadsPerBlockBoundBox.x)};
+                        // getBoundingBoxPerPersonPose<<<threadsPerBlockBoundBox, numBlocksBox>>>(
+                        //     maxPtr, minPtr, scalePtr, frameSize.x, frameSize.y, posePtr, numberPeople, 25,
+                        //     renderThreshold);
+                        renderPoseKeypointsTiled<PoseBody25RenderTables><<<threadsPerBlock, numBlocks>>>(
+                            targetPtr, tileMasksPtr, minPtr, maxPtr, scalePtr, frameSize.x, frameSize.y, posePtr,
+                            numberPeople, renderThreshold, googlyEyes, blendOriginalFrame, alphaBlending
+                        );
+                        // OP_CUDA_PROFILE_END(timeNormalize1, 1e3, REPS);
+
+                        // // Profiling code
+                        // opLog("  renderOld=" + std::to_string(timeNormalize0) + "ms");
+                        // opLog("  renderNew=" + std::to_string(timeNormalize1) + "ms");
+                    }
+                    else if (poseModel == PoseModel::COCO_18)
+                        renderPoseKeypointsTiled<PoseCocoRenderTables><<<threadsPerBlock, numBlocks>>>(
+                            targetPtr, tileMasksPtr, minPtr, maxPtr, scalePtr, frameSize.x, frameSize.y, posePtr,
+                            numberPeople, renderThreshold, googlyEyes, blendOriginalFrame, alphaBlending
+                        );
+                    else if (poseModel == PoseModel::BODY_19 || poseModel == PoseModel::BODY_19E
+                             || poseModel == PoseModel::BODY_19N || poseModel == PoseModel::BODY_19_X2)
+                        renderPoseKeypointsTiled<PoseBody19RenderTables><<<threadsPerBlock, numBlocks>>>(
+                            targetPtr, tileMasksPtr, minPtr, maxPtr, scalePtr, frameSize.x, frameSize.y, posePtr,
+                            numberPeople, renderThreshold, googlyEyes, blendOriginalFrame, alphaBlending
+                        );
+                    else if (poseModel == PoseModel::BODY_23)
+                        renderPoseKeypointsTiled<PoseBody23RenderTables><<<threadsPerBlock, numBlocks>>>(
+                            targetPtr, tileMasksPtr, minPtr, maxPtr, scalePtr, frameSize.x, frameSize.y, posePtr,
+                            numberPeople, renderThreshold, googlyEyes, blendOriginalFrame, alphaBlending
+                        );
+                    else if (poseModel == PoseModel::BODY_25B)
+                        renderPoseKeypointsTiled<PoseBody25bRenderTables><<<threadsPerBlock, numBlocks>>>(
+                            targetPtr, tileMasksPtr, minPtr, maxPtr, scalePtr, frameSize.x, frameSize.y, posePtr,
+                            numberPeople, renderThreshold, googlyEyes, blendOriginalFrame, alphaBlending
+                        );
+                    else if (poseModel == PoseModel::BODY_135)
+                    {
+                        // const auto REPS = 500;
+                        // double timeNormalize1 = 0.;
+                        // double timeNormalize2 = 0.;
+
+                        // // Non-optimized code
+                        // OP_CUDA_PROFILE_INIT(REPS);
+                        //  renderPoseBody135Old<<<threadsPerBlock, numBlocks>>>(
+                        //      framePtr, frameSize.x, frameSize.y, posePtr, numberPeople, renderThreshold, googlyEyes,
+                        //      blendOriginalFrame, alphaBlending
+                        // );
+                        // OP_CUDA_PROFILE_END(timeNormalize1, 1e3, REPS);
+
+                        // Optimized code
+                        // OP_CUDA_PROFILE_INIT(REPS);
+                        // const dim3 threadsPerBlockBoundBox = {1, 1, 1};
+                        // const dim3 numBlocksBox{getNumberCudaBlocks(POSE_MAX_PEOPLE, threadsPerBlockBoundBox.x)};
+                        // getBoundingBoxPerPersonPose<<<threadsPerBlockBoundBox, numBlocksBox>>>(
+                        //     maxPtr, minPtr, scalePtr, frameSize.x, frameSize.y, posePtr, numberPeople, 135,
+                        //     renderThreshold);
+                        renderPoseKeypointsTiled<PoseBody135RenderTables><<<threadsPerBlock, numBlocks>>>(
+                            targetPtr, tileMasksPtr, minPtr, maxPtr, scalePtr, frameSize.x, frameSize.y, posePtr,
+                            numberPeople, renderThreshold, googlyEyes, blendOriginalFrame, alphaBlending
+                        );
+                        // OP_CUDA_PROFILE_END(timeNormalize2, 1e3, REPS);
+
+                        // // Profiling code
+                        // opLog("  renderOld=" + std::to_string(timeNormalize1) + "ms");
+                        // opLog("  renderNew=" + std::to_string(timeNormalize2) + "ms");
+                    }
+                    else if (poseModel == PoseModel::MPI_15 || poseModel == PoseModel::MPI_15_4)
+                        renderPoseKeypointsTiled<PoseMpiRenderTables><<<threadsPerBlock, numBlocks>>>(
+                            targetPtr, tileMasksPtr, minPtr, maxPtr, scalePtr, frameSize.x, frameSize.y, posePtr,
+                            numberPeople, renderThreshold, googlyEyes, blendOriginalFrame, alphaBlending
+                        );
+                    // Car pose
+                    else if (poseModel == PoseModel::CAR_12)
+                        renderPoseKeypointsTiled<PoseCar12RenderTables><<<threadsPerBlock, numBlocks>>>(
+                            targetPtr, tileMasksPtr, minPtr, maxPtr, scalePtr, frameSize.x, frameSize.y, posePtr,
+                            numberPeople, renderThreshold, googlyEyes, blendOriginalFrame, alphaBlending
+                        );
+                    else if (poseModel == PoseModel::CAR_22)
+                        renderPoseKeypointsTiled<PoseCar22RenderTables><<<threadsPerBlock, numBlocks>>>(
+                            targetPtr, tileMasksPtr, minPtr, maxPtr, scalePtr, frameSize.x, frameSize.y, posePtr,
+                            numberPeople, renderThreshold, googlyEyes, blendOriginalFrame, alphaBlending
+                        );
+                    // Unknown
+                    else
+                        error("Invalid Model.", __LINE__, __FUNCTION__, __FILE__);
+                    cudaPoolFree(tileMasksPtr);
+                };
                 dim3 threadsPerBlock;
                 dim3 numBlocks;
-                getNumberCudaThreadsAndBlocks(threadsPerBlock, numBlocks, frameSize);
-                if (poseModel == PoseModel::BODY_25 || poseModel == PoseModel::BODY_25D
-                    || poseModel == PoseModel::BODY_25E)
-                {
-                    // const auto REPS = 1000;
-                    // double timeNormalize0 = 0.;
-                    // double timeNormalize1 = 0.;
-
-                    // // Non-optimized code
-                    // OP_CUDA_PROFILE_INIT(REPS);
-                    // renderPoseBody25Old<<<threadsPerBlock, numBlocks>>>(
-                    //     framePtr, frameSize.x, frameSize.y, posePtr, numberPeople, renderThreshold, googlyEyes,
-                    //     blendOriginalFrame, alphaBlending
-                    // );
-                    // OP_CUDA_PROFILE_END(timeNormalize0, 1e3, REPS);
-
-                    // Optimized code
-                    // OP_CUDA_PROFILE_INIT(REPS);
-                    // const dim3 threadsPerBlockBoundBox = {1, 1, 1};
-                    // const dim3 numBlocksBox{getNumberCudaBlocks(POSE_MAX_PEOPLE, threadsPerBlockBoundBox.x)};
-                    // getBoundingBoxPerPersonPose<<<threadsPerBlockBoundBox, numBlocksBox>>>(
-                    //     maxPtr, minPtr, scalePtr, frameSize.x, frameSize.y, posePtr, numberPeople, 25,
-                    //     renderThreshold);
-                    renderPoseBody25<<<threadsPerBlock, numBlocks>>>(
-                        framePtr, minPtr, maxPtr, scalePtr, frameSize.x, frameSize.y, posePtr, numberPeople,
-                        renderThreshold, googlyEyes, blendOriginalFrame, alphaBlending
-                    );
-                    // OP_CUDA_PROFILE_END(timeNormalize1, 1e3, REPS);
-
-                    // // Profiling code
-                    // opLog("  renderOld=" + std::to_string(timeNormalize0) + "ms");
-                    // opLog("  renderNew=" + std::to_string(timeNormalize1) + "ms");
-                }
-                else if (poseModel == PoseModel::COCO_18)
-                    renderPoseCoco<<<threadsPerBlock, numBlocks>>>(
-                        framePtr, minPtr, maxPtr, scalePtr, frameSize.x, frameSize.y, posePtr, numberPeople,
-                        renderThreshold, googlyEyes, blendOriginalFrame, alphaBlending
-                    );
-                else if (poseModel == PoseModel::BODY_19 || poseModel == PoseModel::BODY_19E
-                         || poseModel == PoseModel::BODY_19N || poseModel == PoseModel::BODY_19_X2)
-                    renderPoseBody19<<<threadsPerBlock, numBlocks>>>(
-                        framePtr, minPtr, maxPtr, scalePtr, frameSize.x, frameSize.y, posePtr, numberPeople,
-                        renderThreshold, googlyEyes, blendOriginalFrame, alphaBlending
-                    );
-                else if (poseModel == PoseModel::BODY_23)
-                    renderPoseBody23<<<threadsPerBlock, numBlocks>>>(
-                        framePtr, minPtr, maxPtr, scalePtr, frameSize.x, frameSize.y, posePtr, numberPeople,
-                        renderThreshold, googlyEyes, blendOriginalFrame, alphaBlending
-                    );
-                else if (poseModel == PoseModel::BODY_25B)
-                    renderPoseBody25b<<<threadsPerBlock, numBlocks>>>(
-                        framePtr, minPtr, maxPtr, scalePtr, frameSize.x, frameSize.y, posePtr, numberPeople,
-                        renderThreshold, googlyEyes, blendOriginalFrame, alphaBlending
-                    );
-                else if (poseModel == PoseModel::BODY_135)
-                {
-                    // const auto REPS = 500;
-                    // double timeNormalize1 = 0.;
-                    // double timeNormalize2 = 0.;
-
-                    // // Non-optimized code
-                    // OP_CUDA_PROFILE_INIT(REPS);
-                    //  renderPoseBody135Old<<<threadsPerBlock, numBlocks>>>(
-                    //      framePtr, frameSize.x, frameSize.y, posePtr, numberPeople, renderThreshold, googlyEyes,
-                    //      blendOriginalFrame, alphaBlending
-                    // );
-                    // OP_CUDA_PROFILE_END(timeNormalize1, 1e3, REPS);
-
-                    // Optimized code
-                    // OP_CUDA_PROFILE_INIT(REPS);
-                    // const dim3 threadsPerBlockBoundBox = {1, 1, 1};
-                    // const dim3 numBlocksBox{getNumberCudaBlocks(POSE_MAX_PEOPLE, threadsPerBlockBoundBox.x)};
-                    // getBoundingBoxPerPersonPose<<<threadsPerBlockBoundBox, numBlocksBox>>>(
-                    //     maxPtr, minPtr, scalePtr, frameSize.x, frameSize.y, posePtr, numberPeople, 135,
-                    //     renderThreshold);
-                    renderPoseBody135<<<threadsPerBlock, numBlocks>>>(
-                        framePtr, minPtr, maxPtr, scalePtr, frameSize.x, frameSize.y, posePtr, numberPeople,
-                        renderThreshold, googlyEyes, blendOriginalFrame, alphaBlending
-                    );
-                    // OP_CUDA_PROFILE_END(timeNormalize2, 1e3, REPS);
-
-                    // // Profiling code
-                    // opLog("  renderOld=" + std::to_string(timeNormalize1) + "ms");
-                    // opLog("  renderNew=" + std::to_string(timeNormalize2) + "ms");
-                }
-                else if (poseModel == PoseModel::MPI_15 || poseModel == PoseModel::MPI_15_4)
-                    renderPoseMpi29Parts<<<threadsPerBlock, numBlocks>>>(
-                        framePtr, minPtr, maxPtr, scalePtr, frameSize.x, frameSize.y, posePtr, numberPeople,
-                        renderThreshold, blendOriginalFrame, alphaBlending
-                    );
-                // Car pose
-                else if (poseModel == PoseModel::CAR_12)
-                    renderPoseCar12<<<threadsPerBlock, numBlocks>>>(
-                        framePtr, minPtr, maxPtr, scalePtr, frameSize.x, frameSize.y, posePtr, numberPeople,
-                        renderThreshold, googlyEyes, blendOriginalFrame, alphaBlending
-                    );
-                else if (poseModel == PoseModel::CAR_22)
-                    renderPoseCar22<<<threadsPerBlock, numBlocks>>>(
-                        framePtr, minPtr, maxPtr, scalePtr, frameSize.x, frameSize.y, posePtr, numberPeople,
-                        renderThreshold, googlyEyes, blendOriginalFrame, alphaBlending
-                    );
-                // Unknown
-                else
-                    error("Invalid Model.", __LINE__, __FUNCTION__, __FILE__);
+                getAutotunedCudaThreadsAndBlocks(
+                    threadsPerBlock, numBlocks, frameSize, "renderPoseKeypoints " + std::to_string((int)poseModel),
+                    framePtr, sizeof(float) * 3 * frameSize.area(), renderSkeleton);
+                renderSkeleton(threadsPerBlock, numBlocks, framePtr);
                 cudaCheck(__LINE__, __FUNCTION__, __FILE__);
             }
         }
@@ -775,7 +567,7 @@ namespace op
 
     void renderPoseHeatMapsGpu(float* framePtr, const PoseModel poseModel, const Point<unsigned int>& frameSize,
                                const float* const heatMapPtr, const Point<int>& heatMapSize,
-                               const float scaleToKeepRatio, const float alphaBlending)
+                               const float scaleToKeepRatio, const float alphaBlending, const bool interpolate)
     {
         try
         {
@@ -790,7 +582,7 @@ namespace op
 
             renderBodyPartHeatMaps<<<threadsPerBlock, numBlocks>>>(
                 framePtr, frameSize.x, frameSize.y, heatMapPtr, heatMapSize.x, heatMapSize.y, scaleToKeepRatio,
-                numberBodyParts, alphaBlending
+                numberBodyParts, alphaBlending, interpolate
             );
             cudaCheck(__LINE__, __FUNCTION__, __FILE__);
         }
@@ -817,7 +609,8 @@ namespace op
 
     void renderPosePAFsGpu(
         float* framePtr, const PoseModel poseModel, const Point<unsigned int>& frameSize, const float* const heatMapPtr,
-        const Point<int>& heatMapSize, const float scaleToKeepRatio, const float alphaBlending)
+        const Point<int>& heatMapSize, const float scaleToKeepRatio, const float alphaBlending,
+        const bool interpolate)
     {
         try
         {
@@ -825,7 +618,7 @@ namespace op
             renderPosePAFGpuAux(
                 framePtr, poseModel, frameSize, heatMapPtr, heatMapSize, scaleToKeepRatio,
                 getPoseNumberBodyParts(poseModel) + (addBkgChannel(poseModel) ? 1 : 0),
-                numberBodyPartPairs, alphaBlending);
+                numberBodyPartPairs, alphaBlending, interpolate);
         }
         catch (const std::exception& e)
         {
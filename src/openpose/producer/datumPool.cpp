@@ -0,0 +1,107 @@
+#include <openpose/producer/datumPool.hpp>
+#include <limits> // std::numeric_limits
+
+namespace op
+{
+    template<typename T>
+    inline void resetIfNotEmpty(T& element)
+    {
+        // Empty ones are left untouched (no new allocation)
+        if (!element.empty())
+            element = T{};
+    }
+
+    template<typename T>
+    inline void resetIfNotEmpty(Array<T>& element)
+    {
+        // It keeps the memory it owns, so the next frame reuses it (see Array::reset())
+        if (!element.empty())
+            element.reset();
+    }
+
+    void resetPooledDatum(Datum& datum)
+    {
+        try
+        {
+            // ID
+            datum.id = std::numeric_limits<unsigned long long>::max();
+            datum.subId = 0;
+            datum.subIdMax = 0;
+            datum.name.clear();
+            datum.frameNumber = 0;
+            datum.sourceId = 0;
+            datum.sourceIdMax = 0;
+            datum.priority = 0;
+            datum.deadline = std::chrono::steady_clock::time_point{};
+            datum.timing.reset();
+            // Input image and rendered version
+            resetIfNotEmpty(datum.cvInputData);
+            resetIfNotEmpty(datum.inputDataGpu);
+            datum.inputDataLease.reset();
+            datum.frameCredit.reset();
+            datum.inputNetData.clear();
+            resetIfNotEmpty(datum.outputData);
+            resetIfNotEmpty(datum.outputDataGpu);
+            resetIfNotEmpty(datum.cvOutputData);
+            resetIfNotEmpty(datum.cvOutputData3D);
+            // Resulting Array<float> data parameters
+            resetIfNotEmpty(datum.poseKeypoints);
+            resetIfNotEmpty(datum.poseIds);
+            resetIfNotEmpty(datum.poseScores);
+            datum.poseKeypointsReused = false;
+            resetIfNotEmpty(datum.poseHeatMaps);
+            datum.poseHeatMapsDownload = nullptr;
+            datum.poseHeatMapsSparse.clear();
+            datum.poseCandidates.clear();
+            resetIfNotEmpty(datum.poseCandidatesArray);
+            datum.poseCandidatesOffsets.clear();
+            datum.faceRectangles.clear();
+            resetIfNotEmpty(datum.faceKeypoints);
+            resetIfNotEmpty(datum.faceHeatMaps);
+            datum.handRectangles.clear();
+            for (auto i = 0u ; i < datum.handKeypoints.size() ; i++)
+            {
+                resetIfNotEmpty(datum.handKeypoints[i]);
+                resetIfNotEmpty(datum.handHeatMaps[i]);
+                resetIfNotEmpty(datum.handKeypoints3D[i]);
+            }
+            // 3-D Reconstruction parameters
+            resetIfNotEmpty(datum.poseKeypoints3D);
+            resetIfNotEmpty(datum.faceKeypoints3D);
+            resetIfNotEmpty(datum.cameraMatrix);
+            resetIfNotEmpty(datum.cameraExtrinsics);
+            resetIfNotEmpty(datum.cameraIntrinsics);
+            resetIfNotEmpty(datum.cameraDistortion);
+            resetIfNotEmpty(datum.poseNetOutput);
+            datum.inputRoi.clear();
+            // Person crops
+            resetIfNotEmpty(datum.personCropsGpu);
+            resetIfNotEmpty(datum.personCrops);
+            datum.personCropMatrices.clear();
+            // Other parameters
+            datum.scaleInputToNetInputs.clear();
+            datum.netInputSizes.clear();
+            datum.scaleInputToOutput = 0.;
+            datum.netOutputSize = Point<int>{};
+            datum.scaleNetToOutput = 0.;
+            datum.elementRendered.first = 0;
+            datum.elementRendered.second.clear();
+            #ifdef USE_3D_ADAM_MODEL
+                // Adam/Unity params
+                datum.adamPosePtr.clear();
+                datum.adamPoseRows = 0;
+                datum.adamTranslationPtr.clear();
+                datum.vtVecPtr.clear();
+                datum.vtVecRows = 0;
+                datum.j0VecPtr.clear();
+                datum.j0VecRows = 0;
+                datum.adamFaceCoeffsExpPtr.clear();
+                datum.adamFaceCoeffsExpRows = 0;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -107,7 +107,7 @@ namespace op
         try
         {
             // Get next frame number
-            return (unsigned long long)producerSharedPtr->get(CV_CAP_PROP_POS_FRAMES);
+            return producerSharedPtr->getNextFrameNumber();
         }
         catch (const std::exception& e)
         {
@@ -120,8 +120,8 @@ namespace op
     {
         try
         {
-            // Image integrity
-            if (inputDataMatrix.channels() != 3)
+            // Image integrity (empty if the frame was only decoded into GPU memory)
+            if (!inputDataMatrix.empty() && inputDataMatrix.channels() != 3)
             {
                 const std::string commonMessage{"Input images must be 3-channel BGR."};
                 // Grey to RGB if required
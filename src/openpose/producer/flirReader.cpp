@@ -6,9 +6,11 @@
 namespace op
 {
     FlirReader::FlirReader(const std::string& cameraParameterPath, const Point<int>& cameraResolution,
-                           const bool undistortImage, const int cameraIndex) :
+                           const bool undistortImage, const int cameraIndex, const int bayerGpuId,
+                           const bool downloadFrames, const double syncToleranceMs) :
         Producer{ProducerType::FlirCamera, cameraParameterPath, undistortImage, -1},
-        mSpinnakerWrapper{cameraParameterPath, cameraResolution, undistortImage, cameraIndex},
+        mSpinnakerWrapper{cameraParameterPath, cameraResolution, undistortImage, cameraIndex, bayerGpuId,
+                          downloadFrames, syncToleranceMs},
         mFrameNameCounter{0ull}
     {
         try
@@ -37,6 +39,21 @@ namespace op
         }
     }
 
+    std::vector<FrameGpu> FlirReader::getLastFramesGpu()
+    {
+        try
+        {
+            auto framesGpu = mSpinnakerWrapper.getLastFramesGpu();
+            setOrientationGpu(framesGpu);
+            return framesGpu;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
     std::vector<Matrix> FlirReader::getCameraMatrices()
     {
         try
@@ -76,6 +93,31 @@ namespace op
         }
     }
 
+    std::vector<Matrix> FlirReader::getCameraDistortions()
+    {
+        try
+        {
+            return mSpinnakerWrapper.getCameraDistortions();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void FlirReader::setUndistortKeypoints(const bool undistortKeypoints)
+    {
+        try
+        {
+            mSpinnakerWrapper.setUndistortKeypoints(undistortKeypoints);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     std::string FlirReader::getNextFrameName()
     {
         try
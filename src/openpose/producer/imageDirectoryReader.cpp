@@ -1,4 +1,12 @@
 #include <openpose/producer/imageDirectoryReader.hpp>
+#include <algorithm> // std::remove_if
+#include <condition_variable>
+#include <deque>
+#include <limits> // std::numeric_limits
+#include <map>
+#include <mutex>
+#include <stdexcept> // std::runtime_error
+#include <thread>
 #include <openpose/filestream/fileStream.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/fileSystem.hpp>
@@ -25,26 +33,249 @@ namespace op
         }
     }
 
+    // List of image paths. If streaming, it is filled by a background thread while the first images are already
+    // being processed, so each access waits until the desired path has been listed (or the listing has finished).
+    struct ImageDirectoryReader::ImageDirectoryListing
+    {
+        std::mutex mMutex;
+        std::condition_variable mConditionVariable;
+        std::vector<std::string> mFilePaths;
+        bool mListed;
+        bool mRunning;
+        std::thread mThread;
+
+        ImageDirectoryListing(const std::string& imageDirectoryPath, const bool streamFiles) :
+            mListed{!streamFiles},
+            mRunning{true}
+        {
+            if (streamFiles)
+                mThread = std::thread{&ImageDirectoryListing::list, this, imageDirectoryPath};
+            else
+                mFilePaths = getImagePathsOnDirectory(imageDirectoryPath);
+        }
+
+        ~ImageDirectoryListing()
+        {
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                mRunning = false;
+            }
+            if (mThread.joinable())
+                mThread.join();
+        }
+
+        void list(const std::string& imageDirectoryPath)
+        {
+            try
+            {
+                forEachFileOnDirectory(
+                    imageDirectoryPath, Extensions::Images,
+                    [&](std::string&& filePath)
+                    {
+                        const std::lock_guard<std::mutex> lock{mMutex};
+                        // Stop listing (e.g., the producer was released)
+                        if (!mRunning)
+                            throw std::runtime_error{"Listing stopped."};
+                        mFilePaths.emplace_back(std::move(filePath));
+                        mConditionVariable.notify_all();
+                    });
+            }
+            catch (const std::exception& e)
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                if (mRunning)
+                    opLog(e.what(), Priority::High, __LINE__, __FUNCTION__, __FILE__);
+            }
+            const std::lock_guard<std::mutex> lock{mMutex};
+            if (mRunning && mFilePaths.empty())
+                opLog("No images were found on " + imageDirectoryPath, Priority::High,
+                      __LINE__, __FUNCTION__, __FILE__);
+            mListed = true;
+            mConditionVariable.notify_all();
+        }
+
+        std::string getPath(const long long index)
+        {
+            std::unique_lock<std::mutex> lock{mMutex};
+            mConditionVariable.wait(lock, [&]{return mListed || index < (long long)mFilePaths.size();});
+            if (mListed && mFilePaths.empty())
+                error("No images were found.", __LINE__, __FUNCTION__, __FILE__);
+            return mFilePaths.at(index);
+        }
+
+        // Paths listed so far (without waiting)
+        long long getListedSize()
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            return (long long)mFilePaths.size();
+        }
+
+        // Total number of images, or (while listing) a number greater than the current position as long as there
+        // might be more images, so the producer is not released before the listing finishes
+        long long getFrameCount(const long long position)
+        {
+            std::unique_lock<std::mutex> lock{mMutex};
+            mConditionVariable.wait(lock, [&]{return mListed || position < (long long)mFilePaths.size();});
+            return (long long)mFilePaths.size();
+        }
+
+        long long truncateIndex(const long long index)
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            return fastTruncate(
+                index, 0ll,
+                (mListed ? (long long)mFilePaths.size()-1 : std::numeric_limits<long long>::max()));
+        }
+    };
+
+    // Pool of threads decoding the next images (in a bounded look-ahead window) while the previous ones are
+    // processed. Each image is identified by its index in the listing, so they are returned in order.
+    struct ImageDirectoryReader::ImplImageDirectoryReader
+    {
+        ImageDirectoryListing& mListing;
+        const long long mLookAhead;
+        std::vector<std::thread> mThreads;
+        std::mutex mMutex;
+        std::condition_variable mConditionVariable;
+        bool mRunning;
+        // Images to decode (in order), and scheduled ones (pending or decoded) with their decoded image (if done)
+        std::deque<long long> mPendingIndexes;
+        std::map<long long, std::pair<bool, Matrix>> mScheduled;
+
+        ImplImageDirectoryReader(ImageDirectoryListing& listing, const int numberDecodingThreads) :
+            mListing(listing),
+            mLookAhead{2ll*numberDecodingThreads},
+            mRunning{true}
+        {
+            for (auto i = 0 ; i < numberDecodingThreads ; i++)
+                mThreads.emplace_back(&ImplImageDirectoryReader::decode, this);
+        }
+
+        ~ImplImageDirectoryReader()
+        {
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                mRunning = false;
+            }
+            mConditionVariable.notify_all();
+            for (auto& thread : mThreads)
+                if (thread.joinable())
+                    thread.join();
+        }
+
+        void decode()
+        {
+            std::unique_lock<std::mutex> lock{mMutex};
+            while (true)
+            {
+                mConditionVariable.wait(lock, [&]{return !mRunning || !mPendingIndexes.empty();});
+                if (!mRunning)
+                    break;
+                const auto index = mPendingIndexes.front();
+                mPendingIndexes.pop_front();
+                lock.unlock();
+                Matrix frame;
+                try
+                {
+                    frame = loadImage(mListing.getPath(index), CV_LOAD_IMAGE_COLOR);
+                }
+                catch (const std::exception& e)
+                {
+                    // An empty frame is returned (and reported by checkFrameIntegrity)
+                    opLog(e.what(), Priority::High, __LINE__, __FUNCTION__, __FILE__);
+                }
+                lock.lock();
+                // It might have been unscheduled meanwhile (e.g., after seeking)
+                auto scheduled = mScheduled.find(index);
+                if (scheduled != mScheduled.end())
+                    scheduled->second = std::make_pair(true, frame);
+                mConditionVariable.notify_all();
+            }
+        }
+
+        Matrix getFrame(const long long index, const long long frameStep)
+        {
+            std::unique_lock<std::mutex> lock{mMutex};
+            // Images expected next: index, index + frameStep, ..., in the look-ahead window
+            const auto isExpected = [&](const long long otherIndex)
+            {
+                return otherIndex >= index && (otherIndex - index) % frameStep == 0
+                    && (otherIndex - index) / frameStep < mLookAhead;
+            };
+            // Unschedule the images that are not expected anymore (e.g., after seeking)
+            for (auto scheduled = mScheduled.begin() ; scheduled != mScheduled.end() ; )
+                scheduled = (isExpected(scheduled->first) ? std::next(scheduled) : mScheduled.erase(scheduled));
+            mPendingIndexes.erase(
+                std::remove_if(mPendingIndexes.begin(), mPendingIndexes.end(),
+                               [&](const long long otherIndex){return !isExpected(otherIndex);}),
+                mPendingIndexes.end());
+            // Schedule the look-ahead window (the desired image has already been listed)
+            const auto listedSize = fastMax(index+1, mListing.getListedSize());
+            for (auto nextIndex = index ; nextIndex < index + mLookAhead*frameStep
+                 && nextIndex < listedSize ; nextIndex += frameStep)
+            {
+                if (mScheduled.emplace(nextIndex, std::make_pair(false, Matrix())).second)
+                    mPendingIndexes.emplace_back(nextIndex);
+            }
+            mConditionVariable.notify_all();
+            // Wait for the desired one
+            mConditionVariable.wait(lock, [&]{return mScheduled.at(index).first;});
+            auto frame = mScheduled.at(index).second;
+            mScheduled.erase(index);
+            return frame;
+        }
+    };
+
     ImageDirectoryReader::ImageDirectoryReader(const std::string& imageDirectoryPath,
                                                const std::string& cameraParameterPath,
                                                const bool undistortImage,
-                                               const int numberViews) :
+                                               const int numberViews,
+                                               const int numberDecodingThreads,
+                                               const bool streamFiles) :
         Producer{ProducerType::ImageDirectory, cameraParameterPath, undistortImage, numberViews},
         mImageDirectoryPath{imageDirectoryPath},
-        mFilePaths{getImagePathsOnDirectory(imageDirectoryPath)},
-        mFrameNameCounter{0ll}
+        mFrameNameCounter{0ll},
+        upListing{new ImageDirectoryListing{imageDirectoryPath, streamFiles}}
     {
+        try
+        {
+            // Sanity check
+            if (numberDecodingThreads < 0)
+                error("The number of image decoding threads must be 0 (synchronous loading) or positive.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Parallel decoding
+            if (numberDecodingThreads > 0)
+                upImpl.reset(new ImplImageDirectoryReader{*upListing, numberDecodingThreads});
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     ImageDirectoryReader::~ImageDirectoryReader()
     {
     }
 
+    void ImageDirectoryReader::release()
+    {
+        try
+        {
+            mFrameNameCounter = {-1ll};
+            // Stop decoding threads
+            upImpl.reset();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     std::string ImageDirectoryReader::getNextFrameName()
     {
         try
         {
-            return getFileNameNoExtension(mFilePaths.at(mFrameNameCounter));
+            return getFileNameNoExtension(upListing->getPath(mFrameNameCounter));
         }
         catch (const std::exception& e)
         {
@@ -57,10 +288,14 @@ namespace op
     {
         try
         {
-            // Read frame
-            auto frame = loadImage(mFilePaths.at(mFrameNameCounter++).c_str(), CV_LOAD_IMAGE_COLOR);
-            // Skip frames if frame step > 1
+            // Read frame (from the decoding threads if enabled), waiting for it to be listed if streaming
             const auto frameStep = Producer::get(ProducerProperty::FrameStep);
+            const auto framePath = upListing->getPath(mFrameNameCounter);
+            auto frame = (upImpl != nullptr
+                ? upImpl->getFrame(mFrameNameCounter, fastMax(1ll, positiveLongLongRound(frameStep)))
+                : loadImage(framePath, CV_LOAD_IMAGE_COLOR));
+            mFrameNameCounter++;
+            // Skip frames if frame step > 1
             if (frameStep > 1)
                 set(CV_CAP_PROP_POS_FRAMES, mFrameNameCounter + frameStep-1);
             // Check frame integrity. This function also checks width/height changes. However, if it is performed
@@ -117,7 +352,7 @@ namespace op
             else if (capProperty == CV_CAP_PROP_POS_FRAMES)
                 return (double)mFrameNameCounter;
             else if (capProperty == CV_CAP_PROP_FRAME_COUNT)
-                return (double)mFilePaths.size();
+                return (double)upListing->getFrameCount(mFrameNameCounter);
             else if (capProperty == CV_CAP_PROP_FPS)
                 return -1.;
             else
@@ -142,7 +377,7 @@ namespace op
             else if (capProperty == CV_CAP_PROP_FRAME_HEIGHT)
                 mResolution.y = {(int)value};
             else if (capProperty == CV_CAP_PROP_POS_FRAMES)
-                mFrameNameCounter = fastTruncate((long long)value, 0ll, (long long)mFilePaths.size()-1);
+                mFrameNameCounter = upListing->truncateIndex((long long)value);
             else if (capProperty == CV_CAP_PROP_FRAME_COUNT || capProperty == CV_CAP_PROP_FPS)
                 opLog("This property is read-only.", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
             else
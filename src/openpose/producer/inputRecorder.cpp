@@ -0,0 +1,196 @@
+#include <openpose/producer/inputRecorder.hpp>
+#include <chrono>
+#include <cstring> // std::memcpy
+#include <fstream>
+#include <openpose_private/producer/inputRecordingFormat.hpp>
+#include <openpose_private/utilities/asyncJobQueue.hpp>
+#include <openpose_private/utilities/openCvMultiversionHeaders.hpp> // cv::imencode
+
+namespace op
+{
+    // Maximum number of frames pending to be compressed (the producer waits if the encoding is slower than it)
+    const auto INPUT_RECORDER_MAX_QUEUE_SIZE = 16ull;
+
+    // Frame set copied by record() until it is compressed and written
+    struct RecordedFrame
+    {
+        std::string name;
+        long long timestampNs;
+        unsigned long long frameNumber;
+        unsigned long long sourceId;
+        unsigned long long sourceIdMax;
+        std::vector<Matrix> frames;
+        // [view][camera matrix, extrinsics, intrinsics, distortion]
+        std::vector<std::vector<Matrix>> cameraParameters;
+    };
+
+    void appendBytes(std::string& chunk, const void* const dataPtr, const size_t bytes)
+    {
+        chunk.append((const char*)dataPtr, bytes);
+        chunk.append(inputRecordingPaddedBytes(bytes) - bytes, '\0');
+    }
+
+    struct InputRecorder::ImplInputRecorder
+    {
+        const std::string mFilePath;
+        const std::string mImageExtension;
+        std::vector<int> mEncodingParameters;
+        std::ofstream mFile;
+        bool mFirstFrame;
+        std::chrono::steady_clock::time_point mTimeFirstFrame;
+        unsigned long long mNumberFrames;
+        // Last member, so its pending jobs finish before the file is closed
+        std::unique_ptr<AsyncJobQueue> upAsyncJobQueue;
+
+        ImplInputRecorder(const std::string& filePath, const std::string& imageFormat) :
+            mFilePath{filePath},
+            mImageExtension{"." + imageFormat},
+            mFirstFrame{true},
+            mNumberFrames{0ull}
+        {
+        }
+
+        // Background thread
+        void writeFrame(const RecordedFrame& recordedFrame)
+        {
+            // Compress each view
+            std::vector<std::vector<unsigned char>> encodedImages(recordedFrame.frames.size());
+            for (auto view = 0u ; view < recordedFrame.frames.size() ; view++)
+                if (!recordedFrame.frames[view].empty()
+                    && !cv::imencode(
+                        mImageExtension, OP_OP2CVCONSTMAT(recordedFrame.frames[view]), encodedImages[view],
+                        mEncodingParameters))
+                    error("Frame " + std::to_string(recordedFrame.frameNumber) + " could not be encoded as "
+                          + mImageExtension + ".", __LINE__, __FUNCTION__, __FILE__);
+            // Chunk
+            std::string chunk(sizeof(InputRecordingFrameHeader), '\0');
+            appendBytes(chunk, recordedFrame.name.data(), recordedFrame.name.size());
+            for (auto view = 0u ; view < recordedFrame.frames.size() ; view++)
+            {
+                const InputRecordingViewHeader viewHeader{(uint32_t)encodedImages[view].size(),
+                                                          INPUT_RECORDING_MATRICES};
+                appendBytes(chunk, &viewHeader, sizeof(viewHeader));
+                appendBytes(chunk, encodedImages[view].data(), encodedImages[view].size());
+                for (const auto& matrix : recordedFrame.cameraParameters[view])
+                {
+                    const cv::Mat cvMat = (matrix.empty() || matrix.isContinuous()
+                        ? OP_OP2CVCONSTMAT(matrix) : OP_OP2CVCONSTMAT(matrix).clone());
+                    const InputRecordingMatrixHeader matrixHeader{
+                        cvMat.rows, cvMat.cols, cvMat.type(), (uint32_t)(cvMat.total() * cvMat.elemSize())};
+                    appendBytes(chunk, &matrixHeader, sizeof(matrixHeader));
+                    appendBytes(chunk, cvMat.data, matrixHeader.dataBytes);
+                }
+            }
+            // Header (its size is known now)
+            InputRecordingFrameHeader frameHeader;
+            std::memset(&frameHeader, 0, sizeof(frameHeader));
+            frameHeader.magic = INPUT_RECORDING_FRAME_MAGIC;
+            frameHeader.numberViews = (uint32_t)recordedFrame.frames.size();
+            frameHeader.frameBytes = chunk.size();
+            frameHeader.timestampNs = recordedFrame.timestampNs;
+            frameHeader.frameNumber = recordedFrame.frameNumber;
+            frameHeader.sourceId = recordedFrame.sourceId;
+            frameHeader.sourceIdMax = recordedFrame.sourceIdMax;
+            frameHeader.nameBytes = (uint32_t)recordedFrame.name.size();
+            frameHeader.width = (recordedFrame.frames.empty() ? 0 : recordedFrame.frames[0].cols());
+            frameHeader.height = (recordedFrame.frames.empty() ? 0 : recordedFrame.frames[0].rows());
+            std::memcpy(&chunk[0], &frameHeader, sizeof(frameHeader));
+            // Flushed per frame, so an interrupted recording keeps all its complete frames
+            mFile.write(chunk.data(), chunk.size());
+            mFile.flush();
+            if (!mFile.good())
+                error("Could not write into the input recording " + mFilePath + ".", __LINE__, __FUNCTION__, __FILE__);
+        }
+    };
+
+    InputRecorder::InputRecorder(const std::string& filePath, const std::string& imageFormat) :
+        upImpl{new ImplInputRecorder{filePath, imageFormat}}
+    {
+        try
+        {
+            if (imageFormat.empty())
+                error("The image format of the input recording should not be empty.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (imageFormat == "jpg" || imageFormat == "jpeg")
+                upImpl->mEncodingParameters = {CV_IMWRITE_JPEG_QUALITY, 95};
+            else if (imageFormat == "png")
+                upImpl->mEncodingParameters = {CV_IMWRITE_PNG_COMPRESSION, 1};
+            // File header
+            upImpl->mFile.open(filePath, std::ios::binary | std::ios::trunc);
+            if (!upImpl->mFile.is_open())
+                error("Could not create the input recording " + filePath + ".", __LINE__, __FUNCTION__, __FILE__);
+            InputRecordingFileHeader fileHeader;
+            std::memcpy(fileHeader.magic, INPUT_RECORDING_MAGIC, sizeof(fileHeader.magic));
+            fileHeader.version = INPUT_RECORDING_VERSION;
+            fileHeader.reserved = 0u;
+            upImpl->mFile.write((const char*)&fileHeader, sizeof(fileHeader));
+            // 1 thread, so the frames are written in order
+            upImpl->upAsyncJobQueue.reset(new AsyncJobQueue{1u, INPUT_RECORDER_MAX_QUEUE_SIZE});
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    InputRecorder::~InputRecorder()
+    {
+        try
+        {
+            // Write pending frames
+            upImpl->upAsyncJobQueue.reset();
+            if (upImpl->mNumberFrames > 0ull)
+                opLog("Input recording: " + std::to_string(upImpl->mNumberFrames) + " frames saved into "
+                      + upImpl->mFilePath + ".", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void InputRecorder::record(
+        const std::string& frameName, const unsigned long long frameNumber, const unsigned long long sourceId,
+        const unsigned long long sourceIdMax, const std::vector<Matrix>& frames,
+        const std::vector<Matrix>& cameraMatrices, const std::vector<Matrix>& cameraExtrinsics,
+        const std::vector<Matrix>& cameraIntrinsics, const std::vector<Matrix>& cameraDistortions)
+    {
+        try
+        {
+            // Arrival time
+            const auto now = std::chrono::steady_clock::now();
+            if (upImpl->mFirstFrame)
+            {
+                upImpl->mFirstFrame = false;
+                upImpl->mTimeFirstFrame = now;
+            }
+            if (!frames.empty() && frames[0].empty())
+                error("The input recording requires the frames in CPU memory.", __LINE__, __FUNCTION__, __FILE__);
+            // Deep copies, the producer might re-use the memory of its frames
+            const auto recordedFrame = std::make_shared<RecordedFrame>();
+            recordedFrame->name = frameName;
+            recordedFrame->timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                now - upImpl->mTimeFirstFrame).count();
+            recordedFrame->frameNumber = frameNumber;
+            recordedFrame->sourceId = sourceId;
+            recordedFrame->sourceIdMax = sourceIdMax;
+            recordedFrame->cameraParameters.resize(frames.size());
+            for (auto view = 0u ; view < frames.size() ; view++)
+            {
+                recordedFrame->frames.emplace_back(frames[view].clone());
+                for (const auto* const parameters : {&cameraMatrices, &cameraExtrinsics, &cameraIntrinsics,
+                                                     &cameraDistortions})
+                    recordedFrame->cameraParameters[view].emplace_back(
+                        view < parameters->size() ? (*parameters)[view].clone() : Matrix());
+            }
+            auto* const implInputRecorder = upImpl.get();
+            upImpl->upAsyncJobQueue->push([implInputRecorder, recordedFrame]{
+                implInputRecorder->writeFrame(*recordedFrame); });
+            upImpl->mNumberFrames++;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -1,4 +1,16 @@
 #include <openpose/producer/ipCameraReader.hpp>
+#include <atomic>
+#include <chrono>
+#include <cmath> // std::abs, std::round
+#include <condition_variable>
+#include <cstdlib> // std::getenv, setenv, _putenv_s
+#include <mutex>
+#include <thread>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/openCv.hpp>
+#include <openpose/utilities/string.hpp>
+#include <openpose_private/utilities/openCvMultiversionHeaders.hpp>
+#include <openpose_private/utilities/openCvPrivate.hpp>
 
 namespace op
 {
@@ -6,22 +18,206 @@ namespace op
     // http://iris.not.iac.es/axis-cgi/mjpg/video.cgi?resolution=320x240?x.mjpeg
     // http://www.webcamxp.com/publicipcams.aspx
 
+    namespace
+    {
+        // FFmpeg options (OpenCV FFmpeg backend): RTSP over TCP (no artifacts from lost UDP packets), no input
+        // buffering, and a 5-second socket timeout (so a stalled camera does not block the receiving thread forever)
+        const auto IP_CAMERA_FFMPEG_OPTIONS = "rtsp_transport;tcp|fflags;nobuffer|flags;low_delay|stimeout;5000000";
+        // Time getRawFrame() waits for a new frame before returning the "reconnecting" one
+        const auto IP_CAMERA_WAIT_MS = 1000;
+        // Consecutive failed reads before the stream is considered lost
+        const auto IP_CAMERA_FAILED_READS = 25u;
+        // Maximum time between re-opening attempts (doubled on each failed one, starting from 250 ms)
+        const auto IP_CAMERA_MAX_RECONNECT_MS = 8000;
+
+        void setLowLatencyOptions()
+        {
+            // The user options (if any) are kept
+            if (std::getenv("OPENCV_FFMPEG_CAPTURE_OPTIONS") == nullptr)
+            {
+                #ifdef _WIN32
+                    _putenv_s("OPENCV_FFMPEG_CAPTURE_OPTIONS", IP_CAMERA_FFMPEG_OPTIONS);
+                #else
+                    setenv("OPENCV_FFMPEG_CAPTURE_OPTIONS", IP_CAMERA_FFMPEG_OPTIONS, 0);
+                #endif
+            }
+        }
+    }
+
+    struct IpCameraReader::ImplIpCameraReader
+    {
+        const std::string mPathName;
+        // Only used by the receiving thread (after the constructor)
+        cv::VideoCapture mVideoCapture;
+        // Latest decoded frame
+        mutable std::mutex mMutex;
+        std::condition_variable mConditionVariable;
+        cv::Mat mLatestFrame;
+        bool mNewFrame;
+        Point<int> mResolution;
+        double mFps;
+        IpCameraStats mStats;
+        std::chrono::steady_clock::time_point mLastArrival;
+        // Receiving thread
+        std::atomic<bool> mClosed;
+        std::thread mThread;
+        long long mFrameNameCounter;
+
+        ImplIpCameraReader(const std::string& pathName) :
+            mPathName{pathName},
+            mNewFrame{false},
+            mResolution{0, 0},
+            mFps{30.},
+            mStats{0ull, 0ull, 0ull, 0., 0., false},
+            mClosed{false},
+            mFrameNameCounter{0ll}
+        {
+        }
+
+        bool open()
+        {
+            setLowLatencyOptions();
+            mVideoCapture = cv::VideoCapture{mPathName};
+            if (!mVideoCapture.isOpened())
+                return false;
+            #if defined(CV_MAJOR_VERSION) && CV_MAJOR_VERSION > 2
+                // Only the latest frame (for the backends that support it)
+                mVideoCapture.set(cv::CAP_PROP_BUFFERSIZE, 1);
+            #endif
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mResolution = Point<int>{
+                positiveIntRound(mVideoCapture.get(CV_CAP_PROP_FRAME_WIDTH)),
+                positiveIntRound(mVideoCapture.get(CV_CAP_PROP_FRAME_HEIGHT))};
+            const auto fps = mVideoCapture.get(CV_CAP_PROP_FPS);
+            // Some streams do not report it (or report nonsense values)
+            if (fps > 0. && fps < 1000.)
+                mFps = fps;
+            mStats.connected = true;
+            mLastArrival = std::chrono::steady_clock::time_point{};
+            return true;
+        }
+
+        void receivingThread()
+        {
+            try
+            {
+                auto failedReads = 0u;
+                auto reconnectMs = 250;
+                while (!mClosed)
+                {
+                    // Stream lost: Re-open it in the background (the pipeline keeps running)
+                    if (!mVideoCapture.isOpened())
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds{reconnectMs});
+                        if (mClosed)
+                            break;
+                        if (open())
+                        {
+                            opLog("IP camera " + mPathName + " reconnected.", Priority::High);
+                            reconnectMs = 250;
+                            failedReads = 0u;
+                        }
+                        else
+                            reconnectMs = fastMin(2 * reconnectMs, IP_CAMERA_MAX_RECONNECT_MS);
+                        continue;
+                    }
+                    // Receive and decode
+                    cv::Mat frame;
+                    if (!mVideoCapture.read(frame) || frame.empty())
+                    {
+                        if (++failedReads >= IP_CAMERA_FAILED_READS)
+                        {
+                            opLog("IP camera " + mPathName + " lost, reconnecting in the background.",
+                                  Priority::High);
+                            mVideoCapture.release();
+                            const std::lock_guard<std::mutex> lock{mMutex};
+                            mStats.connected = false;
+                            mStats.reconnections++;
+                        }
+                        continue;
+                    }
+                    failedReads = 0u;
+                    // Keep only the latest frame
+                    const auto arrival = std::chrono::steady_clock::now();
+                    {
+                        const std::lock_guard<std::mutex> lock{mMutex};
+                        if (mNewFrame)
+                            mStats.framesDropped++;
+                        mLatestFrame = frame;
+                        mNewFrame = true;
+                        mResolution = Point<int>{frame.cols, frame.rows};
+                        // Inter-arrival time and its jitter (RFC 3550: J += (|D| - J) / 16)
+                        if (mLastArrival != std::chrono::steady_clock::time_point{})
+                        {
+                            const auto intervalMs = std::chrono::duration<double, std::milli>{
+                                arrival - mLastArrival}.count();
+                            mStats.intervalMs = (mStats.framesReceived > 1ull
+                                ? mStats.intervalMs + (intervalMs - mStats.intervalMs) / 16. : intervalMs);
+                            mStats.jitterMs += (std::abs(intervalMs - mStats.intervalMs) - mStats.jitterMs) / 16.;
+                        }
+                        mLastArrival = arrival;
+                        mStats.framesReceived++;
+                    }
+                    mConditionVariable.notify_one();
+                }
+                mVideoCapture.release();
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        void stopThread()
+        {
+            mClosed = true;
+            if (mThread.joinable())
+                mThread.join();
+        }
+    };
+
     IpCameraReader::IpCameraReader(const std::string & cameraPath, const std::string& cameraParameterPath,
                                    const bool undistortImage) :
-        VideoCaptureReader{cameraPath, ProducerType::IPCamera, cameraParameterPath, undistortImage, 1},
-        mPathName{cameraPath}
+        Producer{ProducerType::IPCamera, cameraParameterPath, undistortImage, 1},
+        upImpl{new ImplIpCameraReader{cameraPath}}
     {
+        try
+        {
+            // Make sure the stream was opened
+            if (!upImpl->open())
+                error("VideoCapture (IP camera) could not be opened for path: '" + cameraPath + "'.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Start receiving thread
+            upImpl->mThread = std::thread{&ImplIpCameraReader::receivingThread, upImpl.get()};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     IpCameraReader::~IpCameraReader()
     {
+        try
+        {
+            upImpl->stopThread();
+            const auto stats = getStats();
+            opLog("IP camera " + upImpl->mPathName + ": " + std::to_string(stats.framesReceived) + " frames received, "
+                  + std::to_string(stats.framesDropped) + " dropped, " + std::to_string(stats.reconnections)
+                  + " reconnections, " + std::to_string(stats.jitterMs) + " ms jitter.", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     std::string IpCameraReader::getNextFrameName()
     {
         try
         {
-            return VideoCaptureReader::getNextFrameName();
+            const auto stringLength = 12u;
+            return toFixedLengthString(fastMax(0ll, upImpl->mFrameNameCounter), stringLength);
         }
         catch (const std::exception& e)
         {
@@ -30,11 +226,124 @@ namespace op
         }
     }
 
+    IpCameraStats IpCameraReader::getStats() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            return upImpl->mStats;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return IpCameraStats{0ull, 0ull, 0ull, 0., 0., false};
+        }
+    }
+
+    bool IpCameraReader::isOpened() const
+    {
+        // Still opened while reconnecting
+        return !upImpl->mClosed;
+    }
+
+    void IpCameraReader::release()
+    {
+        try
+        {
+            upImpl->stopThread();
+            opLog("cv::VideoCapture released.", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    double IpCameraReader::get(const int capProperty)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            if (capProperty == CV_CAP_PROP_FRAME_WIDTH)
+                return upImpl->mResolution.x;
+            else if (capProperty == CV_CAP_PROP_FRAME_HEIGHT)
+                return upImpl->mResolution.y;
+            else if (capProperty == CV_CAP_PROP_POS_FRAMES)
+                return (double)upImpl->mFrameNameCounter;
+            else if (capProperty == CV_CAP_PROP_FRAME_COUNT)
+                return -1.;
+            else if (capProperty == CV_CAP_PROP_FPS)
+                return upImpl->mFps;
+            else
+            {
+                opLog("Unknown property", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+                return -1.;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.;
+        }
+    }
+
+    void IpCameraReader::set(const int capProperty, const double value)
+    {
+        try
+        {
+            UNUSED(value);
+            if (capProperty == CV_CAP_PROP_FRAME_WIDTH || capProperty == CV_CAP_PROP_FRAME_HEIGHT
+                || capProperty == CV_CAP_PROP_POS_FRAMES || capProperty == CV_CAP_PROP_FRAME_COUNT
+                || capProperty == CV_CAP_PROP_FPS)
+                opLog("This property is read-only for an IP camera.", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+            else
+                opLog("Unknown property", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     Matrix IpCameraReader::getRawFrame()
     {
         try
         {
-            return VideoCaptureReader::getRawFrame();
+            cv::Mat frame;
+            Point<int> resolution;
+            {
+                std::unique_lock<std::mutex> lock{upImpl->mMutex};
+                upImpl->mConditionVariable.wait_for(
+                    lock, std::chrono::milliseconds{IP_CAMERA_WAIT_MS},
+                    [this]{ return upImpl->mNewFrame || upImpl->mClosed; });
+                if (upImpl->mNewFrame)
+                {
+                    std::swap(frame, upImpl->mLatestFrame);
+                    upImpl->mNewFrame = false;
+                }
+                resolution = upImpl->mResolution;
+            }
+            if (upImpl->mClosed)
+                return Matrix();
+            upImpl->mFrameNameCounter++; // Simple counter: 0,1,2,3,...
+            // Stalled or lost stream: Black frame, so the pipeline keeps running (without blocking) meanwhile
+            if (frame.empty())
+            {
+                frame = cv::Mat(fastMax(1, resolution.y), fastMax(1, resolution.x), CV_8UC3, cv::Scalar{0,0,0});
+                putTextOnCvMat(frame, "IP camera stalled or disconnected, reconnecting...",
+                               {frame.cols/16, frame.rows/2}, cv::Scalar{255, 255, 255}, false,
+                               positiveIntRound(2.3*frame.cols));
+                // Anti flip + anti rotate frame (so it is balanced with the final flip + rotate)
+                auto rotationAngle = -Producer::get(ProducerProperty::Rotation);
+                // Not using 0 or 180 might provoke a row/col dimension swap, thus an OP error
+                if (int(std::round(rotationAngle)) % 180 != 0.)
+                    rotationAngle = 0;
+                const auto flipFrame = ((unsigned char)Producer::get(ProducerProperty::Flip) == 1.);
+                Matrix opMat = OP_CV2OPMAT(frame);
+                rotateAndFlipFrame(opMat, rotationAngle, flipFrame);
+                return opMat;
+            }
+            return OP_CV2OPMAT(frame);
         }
         catch (const std::exception& e)
         {
@@ -47,7 +356,7 @@ namespace op
     {
         try
         {
-            return VideoCaptureReader::getRawFrames();
+            return std::vector<Matrix>{getRawFrame()};
         }
         catch (const std::exception& e)
         {
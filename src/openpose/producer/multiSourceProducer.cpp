@@ -0,0 +1,711 @@
+#include <openpose/producer/multiSourceProducer.hpp>
+#include <algorithm> // std::max
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <limits> // std::numeric_limits
+#include <mutex>
+#include <thread>
+#include <utility> // std::pair
+#include <openpose_private/utilities/openCvMultiversionHeaders.hpp>
+
+namespace op
+{
+    ProducerType getMultiSourceProducerType(const std::vector<std::shared_ptr<Producer>>& producers)
+    {
+        try
+        {
+            // Sanity checks
+            if (producers.empty())
+                error("MultiSourceProducer requires at least 1 source.", __LINE__, __FUNCTION__, __FILE__);
+            for (const auto& producer : producers)
+            {
+                if (producer == nullptr)
+                    error("MultiSourceProducer received an empty (nullptr) source.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (producer->getType() != producers[0]->getType())
+                    error("All the sources of MultiSourceProducer must be of the same type.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (producer->get(ProducerProperty::NumberViews) > 1)
+                    error("MultiSourceProducer does not support multi-view sources (`--3d_views`).",
+                          __LINE__, __FUNCTION__, __FILE__);
+            }
+            const auto type = producers[0]->getType();
+            if (type == ProducerType::ImageDirectory || type == ProducerType::FlirCamera)
+                error("MultiSourceProducer does not support ProducerType::ImageDirectory nor FlirCamera.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            return type;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return ProducerType::None;
+        }
+    }
+
+    struct MultiSourceProducer::ImplMultiSourceProducer
+    {
+        struct SourceFrame
+        {
+            std::string name;
+            unsigned long long frameNumber;
+            std::vector<Matrix> frames;
+            std::vector<FrameGpu> framesGpu;
+            std::chrono::steady_clock::time_point deadline;
+        };
+
+        struct Source
+        {
+            std::shared_ptr<Producer> spProducer;
+            std::deque<SourceFrame> buffer;
+            bool finished;
+            std::thread thread;
+            // Scheduling (see setSourceSchedule())
+            int priority;
+            double maxLatencyMs;
+        };
+
+        const unsigned int mBufferSize;
+        const bool mLiveSources;
+        std::vector<Source> mSources;
+        // Synchronization between the reader threads and the consumer (DatumProducer) thread
+        mutable std::mutex mMutex;
+        std::condition_variable mConditionVariable;
+        std::atomic<bool> mRunning;
+        bool mThreadsStarted;
+        bool mReleased;
+        // Round-robin selection
+        unsigned long long mNextSourceId;
+        // Batch mode (see setSourceBatching()): Remaining frames of the current group, with their source index
+        bool mBatchSources;
+        std::deque<std::pair<unsigned long long, SourceFrame>> mBatchFrames;
+        bool mStaged;
+        unsigned long long mStagedSourceId;
+        SourceFrame mStagedFrame;
+        unsigned long long mLastSourceId;
+        SourceFrame mLastFrame;
+        unsigned long long mNumberExpired;
+
+        ImplMultiSourceProducer(
+            const std::vector<std::shared_ptr<Producer>>& producers, const unsigned int bufferSize,
+            const ProducerType type) :
+            mBufferSize{std::max(1u, bufferSize)},
+            mLiveSources{type == ProducerType::IPCamera || type == ProducerType::Webcam},
+            mSources(producers.size()),
+            mRunning{false},
+            mThreadsStarted{false},
+            mReleased{false},
+            mNextSourceId{0ull},
+            mBatchSources{false},
+            mStaged{false},
+            mStagedSourceId{0ull},
+            mStagedFrame{},
+            mLastSourceId{0ull},
+            mLastFrame{},
+            mNumberExpired{0ull}
+        {
+            for (auto i = 0u ; i < producers.size() ; i++)
+            {
+                mSources[i].spProducer = producers[i];
+                mSources[i].finished = false;
+                mSources[i].priority = 0;
+                mSources[i].maxLatencyMs = 0.;
+            }
+        }
+
+        void readSource(const unsigned long long sourceId)
+        {
+            auto& source = mSources[sourceId];
+            try
+            {
+                const auto prefix = "source" + std::to_string(sourceId) + "_";
+                while (mRunning && source.spProducer->isOpened())
+                {
+                    SourceFrame sourceFrame;
+                    sourceFrame.name = prefix + source.spProducer->getNextFrameName();
+                    sourceFrame.frameNumber = (unsigned long long)source.spProducer->get(CV_CAP_PROP_POS_FRAMES);
+                    sourceFrame.frames = source.spProducer->getFrames();
+                    sourceFrame.framesGpu = source.spProducer->getLastFramesGpu();
+                    // Empty (e.g., corrupted) frames are not forwarded, the source producer closes itself if it
+                    // keeps failing
+                    if (sourceFrame.frames.empty()
+                        || (sourceFrame.frames[0].empty()
+                            && (sourceFrame.framesGpu.empty() || sourceFrame.framesGpu[0].empty())))
+                        continue;
+                    std::unique_lock<std::mutex> lock{mMutex};
+                    // Live sources: Latest frames are kept (oldest ones dropped)
+                    if (mLiveSources)
+                        while (source.buffer.size() >= mBufferSize)
+                            source.buffer.pop_front();
+                    // Recorded sources: Wait until there is space in the buffer
+                    else
+                        mConditionVariable.wait(
+                            lock, [&]{return !mRunning || source.buffer.size() < mBufferSize;});
+                    if (!mRunning)
+                        break;
+                    if (source.maxLatencyMs > 0.)
+                        sourceFrame.deadline = std::chrono::steady_clock::now()
+                            + std::chrono::microseconds{(long long)(1e3 * source.maxLatencyMs)};
+                    source.buffer.emplace_back(std::move(sourceFrame));
+                    lock.unlock();
+                    mConditionVariable.notify_all();
+                }
+            }
+            catch (const std::exception& e)
+            {
+                // The error was already logged by error(), this source is simply closed
+                opLog("Source " + std::to_string(sourceId) + " of MultiSourceProducer closed due to an error: "
+                      + e.what(), Priority::High, __LINE__, __FUNCTION__, __FILE__);
+            }
+            std::unique_lock<std::mutex> lock{mMutex};
+            source.finished = true;
+            lock.unlock();
+            mConditionVariable.notify_all();
+        }
+
+        void startThreads(Producer& producer)
+        {
+            if (!mThreadsStarted && !mReleased)
+            {
+                // Frame step, auto-repeat and fps mode must be applied by each source (flip and rotation are
+                // applied by MultiSourceProducer itself)
+                const auto frameStep = producer.get(ProducerProperty::FrameStep);
+                const auto autoRepeat = producer.get(ProducerProperty::AutoRepeat);
+                for (auto& source : mSources)
+                {
+                    if (frameStep > 1)
+                        source.spProducer->set(ProducerProperty::FrameStep, frameStep);
+                    source.spProducer->set(ProducerProperty::AutoRepeat, autoRepeat);
+                    source.spProducer->setProducerFpsMode(producer.getProducerFpsMode());
+                }
+                producer.setProducerFpsMode(ProducerFpsMode::RetrievalFps);
+                // Reader threads
+                mRunning = true;
+                for (auto i = 0ull ; i < mSources.size() ; i++)
+                    mSources[i].thread = std::thread{&ImplMultiSourceProducer::readSource, this, i};
+                mThreadsStarted = true;
+            }
+        }
+
+        void stopThreads()
+        {
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                mRunning = false;
+            }
+            mConditionVariable.notify_all();
+            for (auto& source : mSources)
+                if (source.thread.joinable())
+                    source.thread.join();
+        }
+
+        // It drops the buffered frames whose deadline has passed. It returns whether any was dropped
+        bool dropExpiredFrames()
+        {
+            const auto now = std::chrono::steady_clock::now();
+            auto dropped = false;
+            for (auto& source : mSources)
+            {
+                while (!source.buffer.empty()
+                       && source.buffer.front().deadline != std::chrono::steady_clock::time_point{}
+                       && source.buffer.front().deadline < now)
+                {
+                    source.buffer.pop_front();
+                    mNumberExpired++;
+                    dropped = true;
+                }
+            }
+            return dropped;
+        }
+
+        // Batch mode: Once every unfinished source has a frame, it moves the oldest frame of each source into
+        // mBatchFrames (in source order). It must be called with mMutex locked. It returns false if all sources have
+        // finished (and no frame is left).
+        bool groupBatchFrames()
+        {
+            auto allReady = true;
+            auto anyFrame = false;
+            for (const auto& source : mSources)
+            {
+                allReady &= (!source.buffer.empty() || source.finished);
+                anyFrame |= !source.buffer.empty();
+            }
+            if (allReady)
+            {
+                for (auto sourceId = 0ull ; sourceId < mSources.size() ; sourceId++)
+                {
+                    auto& buffer = mSources[sourceId].buffer;
+                    if (!buffer.empty())
+                    {
+                        mBatchFrames.emplace_back(sourceId, std::move(buffer.front()));
+                        buffer.pop_front();
+                    }
+                }
+            }
+            return !allReady || anyFrame;
+        }
+
+        // It selects the next frame (round-robin across the sources with frames available and the highest priority
+        // among them, or the next one of the current group in batch mode), waiting for one if required. It returns
+        // false if all sources have finished.
+        bool stageNextFrame(Producer& producer)
+        {
+            if (mStaged)
+                return true;
+            if (mReleased)
+                return false;
+            startThreads(producer);
+            std::unique_lock<std::mutex> lock{mMutex};
+            while (true)
+            {
+                // Expired frames are dropped rather than processed late (it also frees space for the readers)
+                if (dropExpiredFrames())
+                    mConditionVariable.notify_all();
+                // Batch mode
+                if (mBatchSources)
+                {
+                    if (mBatchFrames.empty() && !groupBatchFrames())
+                        return false;
+                    if (!mBatchFrames.empty())
+                    {
+                        mStagedSourceId = mBatchFrames.front().first;
+                        mStagedFrame = std::move(mBatchFrames.front().second);
+                        mBatchFrames.pop_front();
+                        mStaged = true;
+                        lock.unlock();
+                        mConditionVariable.notify_all();
+                        return true;
+                    }
+                    mConditionVariable.wait(lock);
+                    continue;
+                }
+                // Highest priority among the sources with frames available
+                auto maxPriority = std::numeric_limits<int>::min();
+                for (const auto& source : mSources)
+                    if (!source.buffer.empty())
+                        maxPriority = std::max(maxPriority, source.priority);
+                auto allFinished = true;
+                for (auto i = 0ull ; i < mSources.size() ; i++)
+                {
+                    const auto sourceId = (mNextSourceId + i) % mSources.size();
+                    auto& source = mSources[sourceId];
+                    if (!source.buffer.empty() && source.priority == maxPriority)
+                    {
+                        mStagedFrame = std::move(source.buffer.front());
+                        source.buffer.pop_front();
+                        mStagedSourceId = sourceId;
+                        mNextSourceId = sourceId + 1;
+                        mStaged = true;
+                        lock.unlock();
+                        mConditionVariable.notify_all();
+                        return true;
+                    }
+                    allFinished &= source.finished;
+                }
+                if (allFinished)
+                    return false;
+                mConditionVariable.wait(lock);
+            }
+        }
+
+        // Source of the staged frame or, if none, of the last one
+        unsigned long long getCurrentSourceId() const
+        {
+            return (mStaged ? mStagedSourceId : mLastSourceId);
+        }
+    };
+
+    MultiSourceProducer::MultiSourceProducer(
+        const std::vector<std::shared_ptr<Producer>>& producers, const unsigned int bufferSize) :
+        Producer{getMultiSourceProducerType(producers), "", false, 1},
+        upImpl{new ImplMultiSourceProducer{producers, bufferSize, getType()}}
+    {
+    }
+
+    MultiSourceProducer::~MultiSourceProducer()
+    {
+        try
+        {
+            release();
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<Matrix> MultiSourceProducer::getCameraMatrices()
+    {
+        try
+        {
+            return upImpl->mSources.at(upImpl->mLastSourceId).spProducer->getCameraMatrices();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::vector<Matrix> MultiSourceProducer::getCameraExtrinsics()
+    {
+        try
+        {
+            return upImpl->mSources.at(upImpl->mLastSourceId).spProducer->getCameraExtrinsics();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::vector<Matrix> MultiSourceProducer::getCameraIntrinsics()
+    {
+        try
+        {
+            return upImpl->mSources.at(upImpl->mLastSourceId).spProducer->getCameraIntrinsics();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::vector<Matrix> MultiSourceProducer::getCameraDistortions()
+    {
+        try
+        {
+            return upImpl->mSources.at(upImpl->mLastSourceId).spProducer->getCameraDistortions();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::vector<std::vector<Point<int>>> MultiSourceProducer::getInputRois()
+    {
+        try
+        {
+            const auto inputRois = Producer::getInputRois();
+            if (inputRois.size() > 1 && inputRois.size() == upImpl->mSources.size())
+                return {inputRois.at(upImpl->mLastSourceId)};
+            else if (!inputRois.empty())
+                return inputRois;
+            return upImpl->mSources.at(upImpl->mLastSourceId).spProducer->getInputRois();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void MultiSourceProducer::setUndistortKeypoints(const bool undistortKeypoints)
+    {
+        try
+        {
+            for (auto& source : upImpl->mSources)
+                source.spProducer->setUndistortKeypoints(undistortKeypoints);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<FrameGpu> MultiSourceProducer::getLastFramesGpu()
+    {
+        try
+        {
+            // The sources are not rotated (see get())
+            auto framesGpu = upImpl->mLastFrame.framesGpu;
+            setOrientationGpu(framesGpu);
+            return framesGpu;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    unsigned long long MultiSourceProducer::getLastSourceId()
+    {
+        try
+        {
+            return upImpl->mLastSourceId;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    int MultiSourceProducer::getLastPriority()
+    {
+        try
+        {
+            return upImpl->mSources.at(upImpl->mLastSourceId).priority;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0;
+        }
+    }
+
+    std::chrono::steady_clock::time_point MultiSourceProducer::getLastDeadline()
+    {
+        try
+        {
+            return upImpl->mLastFrame.deadline;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::chrono::steady_clock::time_point{};
+        }
+    }
+
+    void MultiSourceProducer::setSourceSchedule(
+        const std::vector<int>& priorities, const std::vector<double>& maxLatenciesMs)
+    {
+        try
+        {
+            // Sanity checks
+            if (upImpl->mThreadsStarted)
+                error("The source schedule of MultiSourceProducer must be set before the first frame.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            const auto numberSources = upImpl->mSources.size();
+            if ((!priorities.empty() && priorities.size() != numberSources)
+                || (!maxLatenciesMs.empty() && maxLatenciesMs.size() != numberSources))
+                error("The number of source priorities (" + std::to_string(priorities.size()) + ") and maximum"
+                      " latencies (" + std::to_string(maxLatenciesMs.size()) + ") must match the number of sources ("
+                      + std::to_string(numberSources) + ") or be empty.", __LINE__, __FUNCTION__, __FILE__);
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            for (auto i = 0u ; i < numberSources ; i++)
+            {
+                upImpl->mSources[i].priority = (priorities.empty() ? 0 : priorities[i]);
+                upImpl->mSources[i].maxLatencyMs = (maxLatenciesMs.empty() ? 0. : maxLatenciesMs[i]);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void MultiSourceProducer::setSourceBatching(const bool batchSources)
+    {
+        try
+        {
+            // Sanity check
+            if (upImpl->mThreadsStarted)
+                error("The source batching of MultiSourceProducer must be set before the first frame.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->mBatchSources = batchSources;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned long long MultiSourceProducer::getNumberExpired() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            return upImpl->mNumberExpired;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    unsigned long long MultiSourceProducer::getNumberSources()
+    {
+        try
+        {
+            return upImpl->mSources.size();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 1ull;
+        }
+    }
+
+    std::string MultiSourceProducer::getNextFrameName()
+    {
+        try
+        {
+            return (upImpl->stageNextFrame(*this) ? upImpl->mStagedFrame.name : "");
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    bool MultiSourceProducer::isOpened() const
+    {
+        try
+        {
+            if (upImpl->mReleased)
+                return false;
+            if (upImpl->mStaged)
+                return true;
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            if (!upImpl->mBatchFrames.empty())
+                return true;
+            for (const auto& source : upImpl->mSources)
+                if (!source.buffer.empty()
+                    || (upImpl->mThreadsStarted ? !source.finished : source.spProducer->isOpened()))
+                    return true;
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void MultiSourceProducer::release()
+    {
+        try
+        {
+            if (!upImpl->mReleased)
+            {
+                upImpl->stopThreads();
+                if (upImpl->mNumberExpired > 0ull)
+                    opLog("MultiSourceProducer dropped " + std::to_string(upImpl->mNumberExpired) + " frames that"
+                          " exceeded the maximum latency of their source.", Priority::High);
+                for (auto& source : upImpl->mSources)
+                {
+                    source.spProducer->release();
+                    source.buffer.clear();
+                }
+                upImpl->mBatchFrames.clear();
+                upImpl->mStaged = false;
+                upImpl->mStagedFrame = ImplMultiSourceProducer::SourceFrame{};
+                upImpl->mLastFrame = ImplMultiSourceProducer::SourceFrame{};
+                upImpl->mReleased = true;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    double MultiSourceProducer::get(const int capProperty)
+    {
+        try
+        {
+            // Frame size of the current source (they might have different resolutions)
+            if (capProperty == CV_CAP_PROP_FRAME_WIDTH || capProperty == CV_CAP_PROP_FRAME_HEIGHT)
+            {
+                // If rotated 90 or 270 degrees, then width and height is exchanged (the sources are not rotated)
+                const auto rotated = (Producer::get(ProducerProperty::Rotation) != 0.
+                                      && Producer::get(ProducerProperty::Rotation) != 180.);
+                const auto width = ((capProperty == CV_CAP_PROP_FRAME_WIDTH) != rotated);
+                const auto& sourceFrame = (upImpl->mStaged ? upImpl->mStagedFrame : upImpl->mLastFrame);
+                if (!sourceFrame.frames.empty() && !sourceFrame.frames[0].empty())
+                    return (width ? sourceFrame.frames[0].cols() : sourceFrame.frames[0].rows());
+                if (!sourceFrame.framesGpu.empty() && !sourceFrame.framesGpu[0].empty())
+                    return (width ? sourceFrame.framesGpu[0].width : sourceFrame.framesGpu[0].height);
+                return upImpl->mSources.at(upImpl->getCurrentSourceId()).spProducer->get(
+                    width ? CV_CAP_PROP_FRAME_WIDTH : CV_CAP_PROP_FRAME_HEIGHT);
+            }
+            // Frame number within its own source
+            else if (capProperty == CV_CAP_PROP_POS_FRAMES)
+                return (double)(upImpl->mStaged ? upImpl->mStagedFrame.frameNumber : upImpl->mLastFrame.frameNumber);
+            // Total number of frames (all sources)
+            else if (capProperty == CV_CAP_PROP_FRAME_COUNT)
+            {
+                auto frameCount = 0.;
+                for (const auto& source : upImpl->mSources)
+                {
+                    const auto sourceFrameCount = source.spProducer->get(capProperty);
+                    if (sourceFrameCount < 0)
+                        return -1.;
+                    frameCount += sourceFrameCount;
+                }
+                return frameCount;
+            }
+            // Any other property (e.g., fps): The one of the current source
+            else
+                return upImpl->mSources.at(upImpl->getCurrentSourceId()).spProducer->get(capProperty);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.;
+        }
+    }
+
+    void MultiSourceProducer::set(const int capProperty, const double value)
+    {
+        try
+        {
+            // The sources can only be modified before their reader threads start
+            if (!upImpl->mThreadsStarted)
+                for (auto& source : upImpl->mSources)
+                    source.spProducer->set(capProperty, value);
+            else
+                opLog("MultiSourceProducer properties cannot be modified after the first frame (e.g., seeking is not"
+                      " supported). Ignoring it.", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    Matrix MultiSourceProducer::getRawFrame()
+    {
+        try
+        {
+            const auto frames = getRawFrames();
+            return (frames.empty() ? Matrix() : frames[0]);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Matrix();
+        }
+    }
+
+    std::vector<Matrix> MultiSourceProducer::getRawFrames()
+    {
+        try
+        {
+            if (!upImpl->stageNextFrame(*this))
+            {
+                upImpl->mLastFrame = ImplMultiSourceProducer::SourceFrame{};
+                return {Matrix()};
+            }
+            upImpl->mLastFrame = std::move(upImpl->mStagedFrame);
+            upImpl->mLastSourceId = upImpl->mStagedSourceId;
+            upImpl->mStaged = false;
+            return upImpl->mLastFrame.frames;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+}
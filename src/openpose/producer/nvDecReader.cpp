@@ -0,0 +1,779 @@
+#include <openpose/producer/nvDecReader.hpp>
+#ifdef USE_NVDEC
+    #include <cmath> // std::llround
+    #include <deque>
+    #include <cuda.h>
+    #include <cuda_runtime.h>
+    #include <nvcuvid.h>
+    extern "C"
+    {
+        #include <libavcodec/avcodec.h>
+        #include <libavformat/avformat.h>
+    }
+    #include <openpose/gpu/cuda.hpp>
+    #include <openpose/gpu/cudaMemoryPool.hpp>
+#endif
+#include <openpose/utilities/allocationTracker.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/fileSystem.hpp>
+#include <openpose/utilities/string.hpp>
+#include <openpose_private/utilities/openCvMultiversionHeaders.hpp>
+
+namespace op
+{
+    #ifdef USE_NVDEC
+        void nvDecCheck(const CUresult cuResult, const std::string& message, const int line,
+                        const std::string& function, const std::string& file)
+        {
+            if (cuResult != CUDA_SUCCESS)
+            {
+                const char* errorString = nullptr;
+                cuGetErrorString(cuResult, &errorString);
+                error(message + " (" + (errorString != nullptr ? std::string{errorString} : std::to_string(cuResult))
+                      + ").", line, function, file);
+            }
+        }
+
+        cudaVideoCodec avCodecIdToCudaVideoCodec(const AVCodecID avCodecId)
+        {
+            switch (avCodecId)
+            {
+                case AV_CODEC_ID_MPEG1VIDEO: return cudaVideoCodec_MPEG1;
+                case AV_CODEC_ID_MPEG2VIDEO: return cudaVideoCodec_MPEG2;
+                case AV_CODEC_ID_MPEG4: return cudaVideoCodec_MPEG4;
+                case AV_CODEC_ID_VC1: return cudaVideoCodec_VC1;
+                case AV_CODEC_ID_H264: return cudaVideoCodec_H264;
+                case AV_CODEC_ID_HEVC: return cudaVideoCodec_HEVC;
+                case AV_CODEC_ID_VP8: return cudaVideoCodec_VP8;
+                case AV_CODEC_ID_VP9: return cudaVideoCodec_VP9;
+                case AV_CODEC_ID_AV1: return cudaVideoCodec_AV1;
+                default:
+                    error("Video codec `" + std::string{avcodec_get_name(avCodecId)} + "` not supported by NVDEC.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                    return cudaVideoCodec_NumCodecs;
+            }
+        }
+    #else
+        const std::string USE_NVDEC_ERROR{"OpenPose CMake must be compiled with the `WITH_NVDEC` (and `GPU_MODE`"
+            " CUDA) flag in order to use the NVDEC video decoder. Alternatively, disable `--video_nvdec`."};
+    #endif
+
+    struct NvDecReader::ImplNvDecReader
+    {
+        #ifdef USE_NVDEC
+            const bool mDownloadFrames;
+            const int mGpuId;
+            // Demuxer (FFmpeg)
+            AVFormatContext* pFormatContext;
+            AVBSFContext* pBsfContext;
+            AVPacket* pPacket;
+            int mStreamIndex;
+            long long mStartPts;
+            double mPtsToFrames;
+            double mFps;
+            long long mFrameCount;
+            bool mUseTimestamps;
+            bool mEndOfFile;
+            // Decoder (NVDEC)
+            CUcontext mCuContext;
+            CUvideoctxlock mCtxLock;
+            CUvideoparser mParser;
+            CUvideodecoder mDecoder;
+            cudaVideoCodec mCodec;
+            CUVIDDECODECREATEINFO mDecoderInfo;
+            bool mBt709;
+            bool mFullRange;
+            std::string mCallbackError;
+            // Decoded frames (in display order) and their frame indexes
+            std::deque<std::pair<FrameGpu, long long>> mDecodedFrames;
+            long long mDecodedCounter;
+            FrameGpu mLastFrameGpu;
+            // Next frame to return (CV_CAP_PROP_POS_FRAMES) and frames to be skipped (seeking or frame step)
+            long long mFrameIndex;
+            long long mSkipUntil;
+            // Temporary BGR buffer (only if mDownloadFrames)
+            unsigned char* pBgrCuda;
+            unsigned long long mBgrMaxSize;
+
+            ImplNvDecReader(const bool downloadFrames, const int gpuId) :
+                mDownloadFrames{downloadFrames},
+                mGpuId{gpuId},
+                pFormatContext{nullptr},
+                pBsfContext{nullptr},
+                pPacket{nullptr},
+                mStreamIndex{-1},
+                mStartPts{0},
+                mPtsToFrames{1.},
+                mFps{0.},
+                mFrameCount{0},
+                mUseTimestamps{true},
+                mEndOfFile{false},
+                mCuContext{nullptr},
+                mCtxLock{nullptr},
+                mParser{nullptr},
+                mDecoder{nullptr},
+                mCodec{cudaVideoCodec_NumCodecs},
+                mDecoderInfo{},
+                mBt709{false},
+                mFullRange{false},
+                mDecodedCounter{0},
+                mFrameIndex{0},
+                mSkipUntil{0},
+                pBgrCuda{nullptr},
+                mBgrMaxSize{0ull}
+            {
+            }
+
+            void open(const std::string& videoPath)
+            {
+                try
+                {
+                    // Demuxer
+                    if (avformat_open_input(&pFormatContext, videoPath.c_str(), nullptr, nullptr) < 0)
+                        error("NvDecReader could not open the video: '" + videoPath + "'. Is the path correct?",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    if (avformat_find_stream_info(pFormatContext, nullptr) < 0)
+                        error("NvDecReader could not read the stream information of: '" + videoPath + "'.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    mStreamIndex = av_find_best_stream(pFormatContext, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+                    if (mStreamIndex < 0)
+                        error("No video stream found in: '" + videoPath + "'.", __LINE__, __FUNCTION__, __FILE__);
+                    const auto* const avStream = pFormatContext->streams[mStreamIndex];
+                    const auto* const codecParameters = avStream->codecpar;
+                    mCodec = avCodecIdToCudaVideoCodec(codecParameters->codec_id);
+                    if (codecParameters->format != AV_PIX_FMT_NONE && codecParameters->format != AV_PIX_FMT_YUV420P
+                        && codecParameters->format != AV_PIX_FMT_YUVJ420P && codecParameters->format != AV_PIX_FMT_NV12)
+                        error("NvDecReader only supports 8-bit YUV 4:2:0 videos.", __LINE__, __FUNCTION__, __FILE__);
+                    // Timing
+                    const auto frameRate = (avStream->avg_frame_rate.num > 0
+                                            ? avStream->avg_frame_rate : avStream->r_frame_rate);
+                    mFps = (frameRate.num > 0 && frameRate.den > 0 ? av_q2d(frameRate) : 30.);
+                    mStartPts = (avStream->start_time != AV_NOPTS_VALUE ? avStream->start_time : 0);
+                    mPtsToFrames = av_q2d(avStream->time_base) * mFps;
+                    if (avStream->nb_frames > 0)
+                        mFrameCount = avStream->nb_frames;
+                    else if (avStream->duration != AV_NOPTS_VALUE)
+                        mFrameCount = std::llround(avStream->duration * mPtsToFrames);
+                    else
+                        mFrameCount = std::llround(pFormatContext->duration / double(AV_TIME_BASE) * mFps);
+                    // H.264/HEVC in MP4/MKV/FLV (AVCC/HVCC extradata) must be converted into Annex B for NVDEC
+                    const auto annexBFilter = (codecParameters->codec_id == AV_CODEC_ID_H264 ? "h264_mp4toannexb"
+                                               : (codecParameters->codec_id == AV_CODEC_ID_HEVC ? "hevc_mp4toannexb"
+                                                  : nullptr));
+                    if (annexBFilter != nullptr && codecParameters->extradata_size > 0
+                        && codecParameters->extradata[0] == 1)
+                    {
+                        const auto* const bitStreamFilter = av_bsf_get_by_name(annexBFilter);
+                        if (bitStreamFilter == nullptr || av_bsf_alloc(bitStreamFilter, &pBsfContext) < 0
+                            || avcodec_parameters_copy(pBsfContext->par_in, codecParameters) < 0
+                            || av_bsf_init(pBsfContext) < 0)
+                            error("FFmpeg bitstream filter `" + std::string{annexBFilter} + "` could not be created.",
+                                  __LINE__, __FUNCTION__, __FILE__);
+                    }
+                    pPacket = av_packet_alloc();
+                    // CUDA context (primary context, i.e., the same one used by the CUDA runtime on that GPU)
+                    cudaSetDevice(mGpuId);
+                    cudaFree(0);
+                    CUdevice cuDevice;
+                    nvDecCheck(cuDeviceGet(&cuDevice, mGpuId), "cuDeviceGet failed", __LINE__, __FUNCTION__, __FILE__);
+                    nvDecCheck(cuDevicePrimaryCtxRetain(&mCuContext, cuDevice), "cuDevicePrimaryCtxRetain failed",
+                               __LINE__, __FUNCTION__, __FILE__);
+                    nvDecCheck(cuvidCtxLockCreate(&mCtxLock, mCuContext), "cuvidCtxLockCreate failed",
+                               __LINE__, __FUNCTION__, __FILE__);
+                    createParser();
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            void createParser()
+            {
+                try
+                {
+                    CUVIDPARSERPARAMS parserParameters{};
+                    parserParameters.CodecType = mCodec;
+                    parserParameters.ulMaxNumDecodeSurfaces = 1; // Updated in handleVideoSequence
+                    parserParameters.ulMaxDisplayDelay = 1;
+                    parserParameters.pUserData = this;
+                    parserParameters.pfnSequenceCallback = handleVideoSequence;
+                    parserParameters.pfnDecodePicture = handlePictureDecode;
+                    parserParameters.pfnDisplayPicture = handlePictureDisplay;
+                    nvDecCheck(cuvidCreateVideoParser(&mParser, &parserParameters), "cuvidCreateVideoParser failed",
+                               __LINE__, __FUNCTION__, __FILE__);
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            void release()
+            {
+                try
+                {
+                    mDecodedFrames.clear();
+                    mLastFrameGpu = FrameGpu{};
+                    if (mParser != nullptr)
+                    {
+                        cuvidDestroyVideoParser(mParser);
+                        mParser = nullptr;
+                    }
+                    if (mDecoder != nullptr)
+                    {
+                        cuCtxPushCurrent(mCuContext);
+                        cuvidDestroyDecoder(mDecoder);
+                        cuCtxPopCurrent(nullptr);
+                        mDecoder = nullptr;
+                    }
+                    if (mCtxLock != nullptr)
+                    {
+                        cuvidCtxLockDestroy(mCtxLock);
+                        mCtxLock = nullptr;
+                    }
+                    if (mCuContext != nullptr)
+                    {
+                        CUdevice cuDevice;
+                        if (cuDeviceGet(&cuDevice, mGpuId) == CUDA_SUCCESS)
+                            cuDevicePrimaryCtxRelease(cuDevice);
+                        mCuContext = nullptr;
+                    }
+                    if (pBgrCuda != nullptr)
+                    {
+                        cudaSetDevice(mGpuId);
+                        cudaPoolFree(pBgrCuda);
+                        pBgrCuda = nullptr;
+                        mBgrMaxSize = 0ull;
+                    }
+                    av_packet_free(&pPacket);
+                    av_bsf_free(&pBsfContext);
+                    avformat_close_input(&pFormatContext);
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            // Demux 1 packet and send it to the parser (which calls the callbacks below). At the end of the
+            // video, it flushes the parser
+            void parseNextPacket()
+            {
+                try
+                {
+                    CUVIDSOURCEDATAPACKET cuvidPacket{};
+                    auto packetRead = false;
+                    while (!packetRead)
+                    {
+                        av_packet_unref(pPacket);
+                        if (av_read_frame(pFormatContext, pPacket) < 0)
+                            break;
+                        packetRead = (pPacket->stream_index == mStreamIndex);
+                    }
+                    if (packetRead && pBsfContext != nullptr)
+                    {
+                        if (av_bsf_send_packet(pBsfContext, pPacket) < 0)
+                            error("FFmpeg bitstream filter failed.", __LINE__, __FUNCTION__, __FILE__);
+                        // h264/hevc_mp4toannexb outputs 1 packet per input packet
+                        if (av_bsf_receive_packet(pBsfContext, pPacket) < 0)
+                            return;
+                    }
+                    if (packetRead)
+                    {
+                        cuvidPacket.payload = pPacket->data;
+                        cuvidPacket.payload_size = (unsigned long)pPacket->size;
+                        if (pPacket->pts != AV_NOPTS_VALUE)
+                        {
+                            cuvidPacket.flags = CUVID_PKT_TIMESTAMP;
+                            cuvidPacket.timestamp = pPacket->pts;
+                        }
+                        else
+                            mUseTimestamps = false;
+                    }
+                    else
+                    {
+                        cuvidPacket.flags = CUVID_PKT_ENDOFSTREAM;
+                        mEndOfFile = true;
+                    }
+                    const auto cuResult = cuvidParseVideoData(mParser, &cuvidPacket);
+                    if (!mCallbackError.empty())
+                    {
+                        const auto callbackError = mCallbackError;
+                        mCallbackError.clear();
+                        error(callbackError, __LINE__, __FUNCTION__, __FILE__);
+                    }
+                    nvDecCheck(cuResult, "cuvidParseVideoData failed", __LINE__, __FUNCTION__, __FILE__);
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            // Next decoded frame (skipping the ones before mSkipUntil), or an empty FrameGpu at the end of the video
+            FrameGpu getNextFrameGpu()
+            {
+                try
+                {
+                    while (true)
+                    {
+                        while (mDecodedFrames.empty() && !mEndOfFile)
+                            parseNextPacket();
+                        if (mDecodedFrames.empty())
+                        {
+                            mFrameIndex = fastMax(mFrameIndex, mSkipUntil);
+                            return FrameGpu{};
+                        }
+                        auto frameAndIndex = mDecodedFrames.front();
+                        mDecodedFrames.pop_front();
+                        if (frameAndIndex.second >= mSkipUntil)
+                        {
+                            mFrameIndex = frameAndIndex.second + 1;
+                            return frameAndIndex.first;
+                        }
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                    return FrameGpu{};
+                }
+            }
+
+            void seek(const long long frameIndex)
+            {
+                try
+                {
+                    const auto currentFrame = fastMax(mFrameIndex, mSkipUntil);
+                    const auto targetFrame = fastMax(0ll, frameIndex);
+                    // Small forward jumps: decoding sequentially is faster than seeking
+                    if (targetFrame >= currentFrame && (targetFrame - currentFrame < 51 || mEndOfFile))
+                        mSkipUntil = targetFrame;
+                    // Seek to the previous key frame and decode from there. Without timestamps, the frame index is
+                    // only known from the beginning of the video
+                    else
+                    {
+                        const auto targetPts = (mUseTimestamps
+                            ? mStartPts + (long long)std::floor(targetFrame / mPtsToFrames) : mStartPts);
+                        if (av_seek_frame(pFormatContext, mStreamIndex, targetPts, AVSEEK_FLAG_BACKWARD) < 0)
+                            error("NvDecReader could not seek the video to frame " + std::to_string(targetFrame)
+                                  + ".", __LINE__, __FUNCTION__, __FILE__);
+                        if (pBsfContext != nullptr)
+                            av_bsf_flush(pBsfContext);
+                        // Restart the parser (the decoder is re-used if the sequence does not change)
+                        if (mParser != nullptr)
+                            cuvidDestroyVideoParser(mParser);
+                        mParser = nullptr;
+                        createParser();
+                        mDecodedFrames.clear();
+                        mEndOfFile = false;
+                        mDecodedCounter = 0;
+                        mFrameIndex = targetFrame;
+                        mSkipUntil = targetFrame;
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            void downloadBgr(Matrix& frame, const FrameGpu& frameGpu)
+            {
+                try
+                {
+                    const auto bgrSize = 3ull * frameGpu.width * frameGpu.height;
+                    if (mBgrMaxSize < bgrSize)
+                    {
+                        mBgrMaxSize = bgrSize;
+                        cudaPoolFree(pBgrCuda);
+                        pBgrCuda = (unsigned char*)cudaPoolMalloc(bgrSize);
+                    }
+                    nv12ToBgr(pBgrCuda, frameGpu.dataPtr.get(), frameGpu.width, frameGpu.height, frameGpu.pitch,
+                              frameGpu.bt709, frameGpu.fullRange);
+                    cv::Mat cvFrame(frameGpu.height, frameGpu.width, CV_8UC3);
+                    cudaMemcpy(cvFrame.data, pBgrCuda, bgrSize, cudaMemcpyDeviceToHost);
+                    AllocationTracker::recordCopy(bgrSize, MemoryCopy::DeviceToHost);
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    frame = OP_CV2OPMAT(cvFrame);
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            // NVDEC parser callbacks (they must not throw, errors are reported through mCallbackError)
+            // Return value: 0 = error, 1 = success, >1 = number of decode surfaces (handleVideoSequence only)
+            static int CUDAAPI handleVideoSequence(void* userData, CUVIDEOFORMAT* videoFormat)
+            {
+                auto& impl = *((ImplNvDecReader*)userData);
+                try
+                {
+                    if (videoFormat->bit_depth_luma_minus8 != 0
+                        || videoFormat->chroma_format != cudaVideoChromaFormat_420)
+                        error("NvDecReader only supports 8-bit YUV 4:2:0 videos.", __LINE__, __FUNCTION__, __FILE__);
+                    const auto numberDecodeSurfaces = (int)videoFormat->min_num_decode_surfaces + 4;
+                    // Same sequence (e.g., after seeking) --> re-use the decoder
+                    if (impl.mDecoder != nullptr && impl.mDecoderInfo.ulWidth == videoFormat->coded_width
+                        && impl.mDecoderInfo.ulHeight == videoFormat->coded_height
+                        && impl.mDecoderInfo.ulNumDecodeSurfaces == (unsigned long)numberDecodeSurfaces)
+                        return numberDecodeSurfaces;
+                    cuCtxPushCurrent(impl.mCuContext);
+                    if (impl.mDecoder != nullptr)
+                    {
+                        cuvidDestroyDecoder(impl.mDecoder);
+                        impl.mDecoder = nullptr;
+                    }
+                    auto& decoderInfo = impl.mDecoderInfo;
+                    decoderInfo = CUVIDDECODECREATEINFO{};
+                    decoderInfo.CodecType = videoFormat->codec;
+                    decoderInfo.ChromaFormat = videoFormat->chroma_format;
+                    decoderInfo.OutputFormat = cudaVideoSurfaceFormat_NV12;
+                    decoderInfo.bitDepthMinus8 = videoFormat->bit_depth_luma_minus8;
+                    decoderInfo.DeinterlaceMode = (videoFormat->progressive_sequence
+                                                   ? cudaVideoDeinterlaceMode_Weave
+                                                   : cudaVideoDeinterlaceMode_Adaptive);
+                    decoderInfo.ulNumOutputSurfaces = 2;
+                    decoderInfo.ulCreationFlags = cudaVideoCreate_PreferCUVID;
+                    decoderInfo.ulNumDecodeSurfaces = numberDecodeSurfaces;
+                    decoderInfo.vidLock = impl.mCtxLock;
+                    decoderInfo.ulWidth = videoFormat->coded_width;
+                    decoderInfo.ulHeight = videoFormat->coded_height;
+                    decoderInfo.ulMaxWidth = videoFormat->coded_width;
+                    decoderInfo.ulMaxHeight = videoFormat->coded_height;
+                    decoderInfo.display_area.left = (short)videoFormat->display_area.left;
+                    decoderInfo.display_area.top = (short)videoFormat->display_area.top;
+                    decoderInfo.display_area.right = (short)videoFormat->display_area.right;
+                    decoderInfo.display_area.bottom = (short)videoFormat->display_area.bottom;
+                    // NV12 requires even dimensions
+                    decoderInfo.ulTargetWidth =
+                        (videoFormat->display_area.right - videoFormat->display_area.left + 1) & ~1;
+                    decoderInfo.ulTargetHeight =
+                        (videoFormat->display_area.bottom - videoFormat->display_area.top + 1) & ~1;
+                    const auto cuResult = cuvidCreateDecoder(&impl.mDecoder, &decoderInfo);
+                    cuCtxPopCurrent(nullptr);
+                    nvDecCheck(cuResult, "cuvidCreateDecoder failed", __LINE__, __FUNCTION__, __FILE__);
+                    // Color space (BT.601 unless BT.709 is signaled) and range
+                    impl.mBt709 = (videoFormat->video_signal_description.matrix_coefficients == 1);
+                    impl.mFullRange = (videoFormat->video_signal_description.video_full_range_flag != 0);
+                    return numberDecodeSurfaces;
+                }
+                catch (const std::exception& e)
+                {
+                    impl.mCallbackError = e.what();
+                    return 0;
+                }
+            }
+
+            static int CUDAAPI handlePictureDecode(void* userData, CUVIDPICPARAMS* pictureParameters)
+            {
+                auto& impl = *((ImplNvDecReader*)userData);
+                try
+                {
+                    if (impl.mDecoder == nullptr)
+                        error("NVDEC decoder not initialized.", __LINE__, __FUNCTION__, __FILE__);
+                    nvDecCheck(cuvidDecodePicture(impl.mDecoder, pictureParameters), "cuvidDecodePicture failed",
+                               __LINE__, __FUNCTION__, __FILE__);
+                    return 1;
+                }
+                catch (const std::exception& e)
+                {
+                    impl.mCallbackError = e.what();
+                    return 0;
+                }
+            }
+
+            static int CUDAAPI handlePictureDisplay(void* userData, CUVIDPARSERDISPINFO* displayInfo)
+            {
+                auto& impl = *((ImplNvDecReader*)userData);
+                try
+                {
+                    // End of stream
+                    if (displayInfo == nullptr)
+                        return 1;
+                    // Frame index
+                    const auto frameIndex = (impl.mUseTimestamps
+                        ? std::llround((displayInfo->timestamp - impl.mStartPts) * impl.mPtsToFrames)
+                        : impl.mDecodedCounter);
+                    impl.mDecodedCounter++;
+                    // Not required (e.g., seeking or frame step) --> not even mapped
+                    if (frameIndex < impl.mSkipUntil)
+                        return 1;
+                    // Map decoded frame
+                    CUVIDPROCPARAMS procParameters{};
+                    procParameters.progressive_frame = displayInfo->progressive_frame;
+                    procParameters.second_field = displayInfo->repeat_first_field + 1;
+                    procParameters.top_field_first = displayInfo->top_field_first;
+                    procParameters.unpaired_field = (displayInfo->repeat_first_field < 0);
+                    CUdeviceptr decodedPtr = 0;
+                    unsigned int decodedPitch = 0;
+                    cuCtxPushCurrent(impl.mCuContext);
+                    auto cuResult = cuvidMapVideoFrame(
+                        impl.mDecoder, displayInfo->picture_index, &decodedPtr, &decodedPitch, &procParameters);
+                    if (cuResult != CUDA_SUCCESS)
+                        cuCtxPopCurrent(nullptr);
+                    nvDecCheck(cuResult, "cuvidMapVideoFrame failed", __LINE__, __FUNCTION__, __FILE__);
+                    // Copy it into a pool buffer owned by FrameGpu, so the decoder surface can be unmapped (and
+                    // re-used) right away
+                    FrameGpu frameGpu;
+                    frameGpu.width = (int)impl.mDecoderInfo.ulTargetWidth;
+                    frameGpu.height = (int)impl.mDecoderInfo.ulTargetHeight;
+                    frameGpu.pitch = (int)decodedPitch;
+                    frameGpu.gpuId = impl.mGpuId;
+                    frameGpu.bt709 = impl.mBt709;
+                    frameGpu.fullRange = impl.mFullRange;
+                    const auto lumaBytes = (unsigned long long)frameGpu.pitch * frameGpu.height;
+                    auto* framePtr = (unsigned char*)cudaPoolMalloc(lumaBytes + lumaBytes / 2);
+                    const auto gpuId = impl.mGpuId;
+                    frameGpu.dataPtr = std::shared_ptr<unsigned char>{
+                        framePtr,
+                        [gpuId](unsigned char* gpuPtr)
+                        {
+                            // It might be released from any thread (e.g., the one of the last Datum user)
+                            int currentGpuId;
+                            cudaGetDevice(&currentGpuId);
+                            cudaSetDevice(gpuId);
+                            cudaPoolFree(gpuPtr);
+                            cudaSetDevice(currentGpuId);
+                        }};
+                    // Luma plane + chroma one (which starts after the decoder surface height)
+                    cudaMemcpy2D(
+                        framePtr, decodedPitch, (const void*)decodedPtr, decodedPitch, frameGpu.width,
+                        frameGpu.height, cudaMemcpyDeviceToDevice);
+                    cudaMemcpy2D(
+                        framePtr + lumaBytes, decodedPitch,
+                        (const void*)(decodedPtr + (unsigned long long)decodedPitch * frameGpu.height), decodedPitch,
+                        frameGpu.width, frameGpu.height / 2, cudaMemcpyDeviceToDevice);
+                    cuResult = cuvidUnmapVideoFrame(impl.mDecoder, decodedPtr);
+                    cuCtxPopCurrent(nullptr);
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    nvDecCheck(cuResult, "cuvidUnmapVideoFrame failed", __LINE__, __FUNCTION__, __FILE__);
+                    impl.mDecodedFrames.emplace_back(std::make_pair(frameGpu, frameIndex));
+                    return 1;
+                }
+                catch (const std::exception& e)
+                {
+                    impl.mCallbackError = e.what();
+                    return 0;
+                }
+            }
+        #endif
+    };
+
+    NvDecReader::NvDecReader(
+        const std::string& videoPath, const bool downloadFrames, const int gpuId, const std::string& cameraParameterPath,
+        const bool undistortImage) :
+        Producer{ProducerType::Video, cameraParameterPath, undistortImage, 1},
+        mPathName{getFileNameNoExtension(videoPath)}
+        #ifdef USE_NVDEC
+            , upImpl{new ImplNvDecReader{downloadFrames, gpuId}}
+        #endif
+    {
+        try
+        {
+            #ifdef USE_NVDEC
+                upImpl->open(videoPath);
+                opLog("NVDEC video decoder enabled (GPU " + std::to_string(gpuId) + ").", Priority::High);
+            #else
+                UNUSED(downloadFrames);
+                UNUSED(gpuId);
+                error(USE_NVDEC_ERROR, __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    NvDecReader::~NvDecReader()
+    {
+        try
+        {
+            release();
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<FrameGpu> NvDecReader::getLastFramesGpu()
+    {
+        try
+        {
+            #ifdef USE_NVDEC
+                if (!upImpl->mLastFrameGpu.empty())
+                {
+                    std::vector<FrameGpu> framesGpu{upImpl->mLastFrameGpu};
+                    setUndistortMapsGpu(framesGpu);
+                    setOrientationGpu(framesGpu);
+                    return framesGpu;
+                }
+            #endif
+            return {};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::string NvDecReader::getNextFrameName()
+    {
+        try
+        {
+            const auto stringLength = 12u;
+            return mPathName + "_"
+                + toFixedLengthString(fastMax(0ull, uLongLongRound(get(CV_CAP_PROP_POS_FRAMES))), stringLength);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    bool NvDecReader::isOpened() const
+    {
+        try
+        {
+            #ifdef USE_NVDEC
+                return (upImpl->pFormatContext != nullptr);
+            #else
+                return false;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void NvDecReader::release()
+    {
+        try
+        {
+            #ifdef USE_NVDEC
+                if (upImpl != nullptr)
+                    upImpl->release();
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    double NvDecReader::get(const int capProperty)
+    {
+        try
+        {
+            #ifdef USE_NVDEC
+                if (!isOpened())
+                    return 0.;
+                const auto* const codecParameters = upImpl->pFormatContext->streams[upImpl->mStreamIndex]->codecpar;
+                if (capProperty == CV_CAP_PROP_FRAME_WIDTH)
+                    return (upImpl->mDecoder != nullptr
+                        ? (double)upImpl->mDecoderInfo.ulTargetWidth : (double)(codecParameters->width & ~1));
+                else if (capProperty == CV_CAP_PROP_FRAME_HEIGHT)
+                    return (upImpl->mDecoder != nullptr
+                        ? (double)upImpl->mDecoderInfo.ulTargetHeight : (double)(codecParameters->height & ~1));
+                else if (capProperty == CV_CAP_PROP_FPS)
+                    return upImpl->mFps;
+                else if (capProperty == CV_CAP_PROP_FRAME_COUNT)
+                    return (double)upImpl->mFrameCount;
+                else if (capProperty == CV_CAP_PROP_POS_FRAMES)
+                    return (double)fastMax(upImpl->mFrameIndex, upImpl->mSkipUntil);
+                else
+                {
+                    opLog("Unknown property " + std::to_string(capProperty) + " for NvDecReader.",
+                          Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+                    return -1.;
+                }
+            #else
+                UNUSED(capProperty);
+                return 0.;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.;
+        }
+    }
+
+    void NvDecReader::set(const int capProperty, const double value)
+    {
+        try
+        {
+            #ifdef USE_NVDEC
+                if (!isOpened())
+                    return;
+                if (capProperty == CV_CAP_PROP_POS_FRAMES)
+                {
+                    const auto frameIndex = (long long)std::llround(value);
+                    if (frameIndex != (long long)std::llround(get(CV_CAP_PROP_POS_FRAMES)))
+                        upImpl->seek(frameIndex);
+                }
+                else
+                    opLog("Unknown property " + std::to_string(capProperty) + " for NvDecReader.",
+                          Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+            #else
+                UNUSED(capProperty);
+                UNUSED(value);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    Matrix NvDecReader::getRawFrame()
+    {
+        try
+        {
+            #ifdef USE_NVDEC
+                Matrix frame;
+                cudaSetDevice(upImpl->mGpuId);
+                upImpl->mLastFrameGpu = upImpl->getNextFrameGpu();
+                if (!upImpl->mLastFrameGpu.empty())
+                {
+                    // Skip frames if frame step > 1 (they are dropped before being mapped)
+                    const auto frameStep = positiveLongLongRound(Producer::get(ProducerProperty::FrameStep));
+                    if (frameStep > 1)
+                        upImpl->mSkipUntil = upImpl->mFrameIndex + frameStep - 1;
+                    // BGR CPU copy only if required
+                    if (upImpl->mDownloadFrames)
+                        upImpl->downloadBgr(frame, upImpl->mLastFrameGpu);
+                }
+                return frame;
+            #else
+                return Matrix();
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Matrix();
+        }
+    }
+
+    std::vector<Matrix> NvDecReader::getRawFrames()
+    {
+        try
+        {
+            return std::vector<Matrix>{getRawFrame()};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+}
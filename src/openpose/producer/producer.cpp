@@ -1,10 +1,13 @@
 #include <openpose/producer/producer.hpp>
+#include <cmath> // std::round
 #include <openpose/producer/headers.hpp>
 #include <openpose/utilities/check.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/fileSystem.hpp>
 #include <openpose/utilities/openCv.hpp>
+#include <openpose/utilities/string.hpp>
 #include <openpose_private/utilities/openCvMultiversionHeaders.hpp>
+#include <openpose_private/utilities/parallelFor.hpp>
 
 namespace op
 {
@@ -28,6 +31,8 @@ namespace op
         mType{type},
         mProducerFpsMode{ProducerFpsMode::RetrievalFps},
         mNumberEmptyFrames{0},
+        mUndistortImage{undistortImage},
+        mUndistortKeypoints{false},
         mTrackingFps{false}
     {
         try
@@ -112,14 +117,25 @@ namespace op
                 keepDesiredFrameRate();
                 // Get frame
                 frames = getRawFrames();
-                // Undistort frames
-                // TODO: Multi-thread if > 1 frame
-                for (auto i = 0u ; i < frames.size() ; i++)
-                    if (!frames[i].empty() && mCameraParameterReader.getUndistortImage())
-                        mCameraParameterReader.undistort(frames[i], i);
+                const auto framesGpu = getLastFramesGpu();
+                // Undistort frames (1 thread per camera, each one with its own cached remap tables). The GPU frames
+                // are undistorted while resized (see setUndistortMapsGpu())
+                if (mCameraParameterReader.getUndistortImage())
+                    parallelFor(
+                        0, (int)frames.size(),
+                        [&](const int i)
+                        {
+                            if (!frames[i].empty())
+                                mCameraParameterReader.undistort(frames[i], i);
+                        });
                 // Post-process frames
-                for (auto& frame : frames)
+                for (auto i = 0u ; i < frames.size() ; i++)
                 {
+                    auto& frame = frames[i];
+                    // Frame only decoded into GPU memory (no CPU frame to post-process nor check, it is rotated and
+                    // flipped while resized, see setOrientationGpu())
+                    if (frame.empty() && i < framesGpu.size() && !framesGpu[i].empty())
+                        continue;
                     // Flip + rotate frame
                     const auto rotationAngle = mProperties[(unsigned char)ProducerProperty::Rotation];
                     const auto flipFrame = (mProperties[(unsigned char)ProducerProperty::Flip] == 1.);
@@ -184,6 +200,106 @@ namespace op
         }
     }
 
+    std::vector<Matrix> Producer::getCameraDistortions()
+    {
+        try
+        {
+            if (mUndistortKeypoints)
+                return mCameraParameterReader.getCameraDistortions();
+            return {};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void Producer::setUndistortKeypoints(const bool undistortKeypoints)
+    {
+        try
+        {
+            mUndistortKeypoints = undistortKeypoints;
+            // The FLIR cameras (SpinnakerWrapper) undistort their own frames
+            if (mType != ProducerType::FlirCamera)
+                mCameraParameterReader.setUndistortImage(mUndistortImage && !mUndistortKeypoints);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<FrameGpu> Producer::getLastFramesGpu()
+    {
+        return {};
+    }
+
+    std::vector<std::vector<Point<int>>> Producer::getInputRois()
+    {
+        try
+        {
+            if (!mInputRois.empty())
+                return mInputRois;
+            return mCameraParameterReader.getInputRois();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void Producer::setInputRois(const std::vector<std::vector<Point<int>>>& inputRois)
+    {
+        try
+        {
+            mInputRois = inputRois;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<std::shared_ptr<void>> Producer::getLastFrameLeases()
+    {
+        return {};
+    }
+
+    unsigned long long Producer::getLastSourceId()
+    {
+        return 0ull;
+    }
+
+    int Producer::getLastPriority()
+    {
+        return 0;
+    }
+
+    std::chrono::steady_clock::time_point Producer::getLastDeadline()
+    {
+        return std::chrono::steady_clock::time_point{};
+    }
+
+    unsigned long long Producer::getNumberSources()
+    {
+        return 1ull;
+    }
+
+    unsigned long long Producer::getNextFrameNumber()
+    {
+        try
+        {
+            return (unsigned long long)get(CV_CAP_PROP_POS_FRAMES);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
     void Producer::setProducerFpsMode(const ProducerFpsMode fpsMode)
     {
         try
@@ -191,17 +307,17 @@ namespace op
             checkBool(
                 fpsMode == ProducerFpsMode::RetrievalFps || fpsMode == ProducerFpsMode::OriginalFps,
                 "Unknown ProducerFpsMode.", __LINE__, __FUNCTION__, __FILE__);
-            // For webcam, ProducerFpsMode::OriginalFps == ProducerFpsMode::RetrievalFps, since the internal webcam
-            // cache will overwrite frames after it gets full
-            if (mType == ProducerType::Webcam)
+            // For webcam and IP camera, ProducerFpsMode::OriginalFps == ProducerFpsMode::RetrievalFps, since their
+            // buffering threads only keep the latest frame
+            if (mType == ProducerType::Webcam || mType == ProducerType::IPCamera)
             {
                 mProducerFpsMode = {ProducerFpsMode::RetrievalFps};
                 if (fpsMode == ProducerFpsMode::OriginalFps)
                     opLog("The producer fps mode set to `OriginalFps` (flag `process_real_time` on the demo) is not"
-                        " necessary, it is already assumed for webcam.",
+                        " necessary, it is already assumed for webcam and IP camera.",
                         Priority::Max, __LINE__, __FUNCTION__, __FILE__);
             }
-            // If no webcam
+            // If no webcam nor IP camera
             else
             {
                 checkBool(
@@ -247,9 +363,10 @@ namespace op
                 if (property == ProducerProperty::AutoRepeat)
                 {
                     checkBool(
-                        value != 1. || (mType == ProducerType::ImageDirectory || mType == ProducerType::Video),
-                        "ProducerProperty::AutoRepeat only implemented for ProducerType::ImageDirectory and"
-                        " Video.", __LINE__, __FUNCTION__, __FILE__);
+                        value != 1. || (mType == ProducerType::ImageDirectory || mType == ProducerType::Video
+                                        || mType == ProducerType::Replay),
+                        "ProducerProperty::AutoRepeat only implemented for ProducerType::ImageDirectory, Video,"
+                        " and Replay.", __LINE__, __FUNCTION__, __FILE__);
                 }
                 else if (property == ProducerProperty::Rotation)
                 {
@@ -324,7 +441,7 @@ namespace op
                 // closed keeping the 0-index frame counting
                 if (mNumberEmptyFrames > 2
                     || (mType != ProducerType::FlirCamera && mType != ProducerType::IPCamera
-                        && mType != ProducerType::Webcam
+                        && mType != ProducerType::Webcam && mType != ProducerType::SharedMemory
                         && get(CV_CAP_PROP_POS_FRAMES) >= get(CV_CAP_PROP_FRAME_COUNT)))
                 {
                     // Repeat video
@@ -344,14 +461,63 @@ namespace op
         }
     }
 
+    void Producer::setUndistortMapsGpu(std::vector<FrameGpu>& framesGpu)
+    {
+        try
+        {
+            if (mCameraParameterReader.getUndistortImage())
+                for (auto i = 0u ; i < framesGpu.size() ; i++)
+                    if (!framesGpu[i].empty())
+                        framesGpu[i].undistortMapPtr = mCameraParameterReader.getUndistortMapGpu(
+                            i, framesGpu[i].width, framesGpu[i].height, framesGpu[i].gpuId);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void Producer::setOrientationGpu(std::vector<FrameGpu>& framesGpu)
+    {
+        try
+        {
+            const auto rotation = (int)std::round(mProperties[(unsigned char)ProducerProperty::Rotation]) % 360;
+            const auto flip = (mProperties[(unsigned char)ProducerProperty::Flip] == 1.);
+            for (auto& frameGpu : framesGpu)
+            {
+                frameGpu.rotation = rotation;
+                frameGpu.flip = flip;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void Producer::skipRawFrames(const unsigned long long numberFrames)
+    {
+        try
+        {
+            for (auto i = 0ull ; i < numberFrames && isOpened() ; i++)
+                getRawFrames();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     void Producer::keepDesiredFrameRate()
     {
         try
         {
             if (isOpened())
             {
-                // Be sure fps is not slower than desired
-                if (mProducerFpsMode == ProducerFpsMode::OriginalFps)
+                // Be sure fps is not slower than desired (ReplayReader follows its recorded timestamps and
+                // SharedMemoryReader the pace of its writer process instead)
+                if (mProducerFpsMode == ProducerFpsMode::OriginalFps && mType != ProducerType::Replay
+                    && mType != ProducerType::SharedMemory)
                 {
                     if (mTrackingFps)
                     {
@@ -377,11 +543,7 @@ namespace op
                                                                         numberSetPositionThreshold);
                             }
                             else
-                            {
-                                std::vector<Matrix> frames;
-                                for (auto i = 0 ; i < std::floor(difference) ; i++)
-                                    frames = getRawFrames();
-                            }
+                                skipRawFrames((unsigned long long)std::floor(difference));
                         }
                         // Low down frame extraction - sleep thread unless it is too slow in most frames (using
                         // set(frames, X) sets to frame X+delta, due to codecs issues)
@@ -410,27 +572,78 @@ namespace op
 
     std::shared_ptr<Producer> createProducer(
         const ProducerType producerType, const std::string& producerString, const Point<int>& cameraResolution,
-        const std::string& cameraParameterPath, const bool undistortImage, const int numberViews)
+        const std::string& cameraParameterPath, const bool undistortImage, const int numberViews,
+        const int nvDecodeGpuId, const bool nvDecodeDownload, const int imageDecodingThreads,
+        const int flirBayerGpuId, const double flirSyncToleranceMs, const bool undistortKeypoints,
+        const int videoDecoders, const int videoSegmentFrames, const bool imageDirectoryStream, const bool webcamV4l2,
+        const int webcamFps)
     {
         try
         {
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
 
+            // Keypoint-only undistortion: the producer reads the camera parameters, but it keeps the frames distorted
+            if (undistortKeypoints)
+            {
+                auto producer = createProducer(
+                    producerType, producerString, cameraResolution, cameraParameterPath, true, numberViews,
+                    nvDecodeGpuId, nvDecodeDownload, imageDecodingThreads, flirBayerGpuId, flirSyncToleranceMs, false,
+                    videoDecoders, videoSegmentFrames, imageDirectoryStream, webcamV4l2, webcamFps);
+                producer->setUndistortKeypoints(true);
+                return producer;
+            }
+
+            // Sanity check
+            if (nvDecodeGpuId >= 0 && producerType != ProducerType::Video)
+                error("NVDEC decoding (NvDecReader) is only available for video files.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (flirBayerGpuId >= 0 && producerType != ProducerType::FlirCamera)
+                error("GPU debayering is only available for FLIR cameras.", __LINE__, __FUNCTION__, __FILE__);
+
+            // Several comma-separated videos or IP cameras multiplexed into a single producer
+            if (producerType == ProducerType::Video || producerType == ProducerType::IPCamera)
+            {
+                const auto producerStrings = splitString(producerString, ",");
+                if (producerStrings.size() > 1)
+                {
+                    std::vector<std::shared_ptr<Producer>> producers;
+                    for (const auto& sourceString : producerStrings)
+                        producers.emplace_back(createProducer(
+                            producerType, sourceString, cameraResolution, cameraParameterPath, undistortImage,
+                            numberViews, nvDecodeGpuId, nvDecodeDownload, imageDecodingThreads, flirBayerGpuId,
+                            flirSyncToleranceMs, false, videoDecoders, videoSegmentFrames, false, webcamV4l2,
+                            webcamFps));
+                    return std::make_shared<MultiSourceProducer>(producers);
+                }
+            }
             // Directory of images
             if (producerType == ProducerType::ImageDirectory)
                 return std::make_shared<ImageDirectoryReader>(
-                    producerString, cameraParameterPath, undistortImage, numberViews);
+                    producerString, cameraParameterPath, undistortImage, numberViews, imageDecodingThreads,
+                    imageDirectoryStream);
+            // Video (NVDEC)
+            else if (producerType == ProducerType::Video && nvDecodeGpuId >= 0)
+                return std::make_shared<NvDecReader>(
+                    producerString, nvDecodeDownload, nvDecodeGpuId, cameraParameterPath, undistortImage);
             // Video
             else if (producerType == ProducerType::Video)
                 return std::make_shared<VideoReader>(
-                    producerString, cameraParameterPath, undistortImage, numberViews);
+                    producerString, cameraParameterPath, undistortImage, numberViews, videoDecoders,
+                    videoSegmentFrames);
             // IP camera
             else if (producerType == ProducerType::IPCamera)
                 return std::make_shared<IpCameraReader>(producerString, cameraParameterPath, undistortImage);
             // Flir camera
             else if (producerType == ProducerType::FlirCamera)
                 return std::make_shared<FlirReader>(
-                    cameraParameterPath, cameraResolution, undistortImage, std::stoi(producerString));
+                    cameraParameterPath, cameraResolution, undistortImage, std::stoi(producerString),
+                    flirBayerGpuId, nvDecodeDownload, flirSyncToleranceMs);
+            // Input recording
+            else if (producerType == ProducerType::Replay)
+                return std::make_shared<ReplayReader>(producerString);
+            // Shared memory frame ring
+            else if (producerType == ProducerType::SharedMemory)
+                return std::make_shared<SharedMemoryReader>(producerString, cameraParameterPath, undistortImage);
             // Webcam
             else if (producerType == ProducerType::Webcam)
             {
@@ -438,7 +651,26 @@ namespace op
                 auto cameraResolutionFinal = cameraResolution;
                 if (cameraResolutionFinal.x < 0 || cameraResolutionFinal.y < 0)
                     cameraResolutionFinal = Point<int>{1280,720};
-                if (webcamIndex >= 0)
+                // V4L2 (Linux)
+                if (webcamV4l2)
+                {
+                    if (webcamIndex >= 0)
+                        return std::make_shared<V4l2Reader>(
+                            webcamIndex, cameraResolutionFinal, webcamFps, true, cameraParameterPath, undistortImage);
+                    for (auto index = 0 ; index < 10 ; index++)
+                    {
+                        auto v4l2Reader = std::make_shared<V4l2Reader>(
+                            index, cameraResolutionFinal, webcamFps, false, cameraParameterPath, undistortImage);
+                        if (v4l2Reader->isOpened())
+                        {
+                            opLog("Auto-detecting camera index... Detected and opened camera " + std::to_string(index)
+                                + ".", Priority::High);
+                            return v4l2Reader;
+                        }
+                    }
+                    error("No camera found.", __LINE__, __FUNCTION__, __FILE__);
+                }
+                else if (webcamIndex >= 0)
                 {
                     const auto throwExceptionIfNoOpened = true;
                     return std::make_shared<WebcamReader>(
@@ -0,0 +1,388 @@
+#include <openpose/producer/replayReader.hpp>
+#include <chrono>
+#include <cstring> // std::memcmp, std::memcpy
+#include <fstream>
+#include <thread>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose_private/producer/inputRecordingFormat.hpp>
+#include <openpose_private/utilities/openCvMultiversionHeaders.hpp>
+
+namespace op
+{
+    // Location and metadata of each frame chunk of the recording
+    struct ReplayFrameIndex
+    {
+        unsigned long long offset;
+        unsigned long long frameBytes;
+        long long timestampNs;
+        unsigned long long frameNumber;
+        unsigned long long sourceId;
+        unsigned long long sourceIdMax;
+        unsigned int numberViews;
+        std::string name;
+    };
+
+    struct ReplayReader::ImplReplayReader
+    {
+        const std::string mReplayPath;
+        std::ifstream mFile;
+        std::vector<ReplayFrameIndex> mFrameIndexes;
+        long long mNextIndex;
+        Point<int> mResolution;
+        unsigned long long mNumberSources;
+        // Frame set returned by the last getRawFrames()
+        unsigned long long mLastSourceId;
+        long long mLastTimestampNs;
+        std::vector<Matrix> mCameraMatrices;
+        std::vector<Matrix> mCameraExtrinsics;
+        std::vector<Matrix> mCameraIntrinsics;
+        std::vector<Matrix> mCameraDistortions;
+        std::vector<char> mBuffer;
+        // ProducerFpsMode::OriginalFps
+        bool mTimingStarted;
+        std::chrono::steady_clock::time_point mTimeFirstReplayed;
+        long long mTimestampFirstReplayedNs;
+
+        ImplReplayReader(const std::string& replayPath) :
+            mReplayPath{replayPath},
+            mNextIndex{0ll},
+            mResolution{0, 0},
+            mNumberSources{1ull},
+            mLastSourceId{0ull},
+            mLastTimestampNs{0ll},
+            mTimingStarted{false},
+            mTimestampFirstReplayedNs{0ll}
+        {
+        }
+
+        void readIndex()
+        {
+            mFile.open(mReplayPath, std::ios::binary);
+            if (!mFile.is_open())
+                error("Could not open the input recording " + mReplayPath + ".", __LINE__, __FUNCTION__, __FILE__);
+            mFile.seekg(0, std::ios::end);
+            const auto fileBytes = (unsigned long long)mFile.tellg();
+            mFile.seekg(0, std::ios::beg);
+            InputRecordingFileHeader fileHeader;
+            mFile.read((char*)&fileHeader, sizeof(fileHeader));
+            if (!mFile.good() || std::memcmp(fileHeader.magic, INPUT_RECORDING_MAGIC, sizeof(fileHeader.magic)) != 0)
+                error(mReplayPath + " is not an OpenPose input recording (`--input_record`).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (fileHeader.version != INPUT_RECORDING_VERSION)
+                error("Unsupported version (" + std::to_string(fileHeader.version) + ") of the input recording "
+                      + mReplayPath + ".", __LINE__, __FUNCTION__, __FILE__);
+            // Frame chunks (only their headers and names are read)
+            auto offset = (unsigned long long)sizeof(fileHeader);
+            while (offset + sizeof(InputRecordingFrameHeader) <= fileBytes)
+            {
+                InputRecordingFrameHeader frameHeader;
+                mFile.seekg(offset);
+                mFile.read((char*)&frameHeader, sizeof(frameHeader));
+                // Truncated last chunk (e.g., the recording was interrupted)
+                if (!mFile.good() || frameHeader.magic != INPUT_RECORDING_FRAME_MAGIC
+                    || frameHeader.frameBytes < sizeof(frameHeader) || offset + frameHeader.frameBytes > fileBytes)
+                {
+                    opLog("The input recording " + mReplayPath + " ends with an incomplete frame, which is ignored.",
+                          Priority::High);
+                    break;
+                }
+                ReplayFrameIndex frameIndex;
+                frameIndex.offset = offset;
+                frameIndex.frameBytes = frameHeader.frameBytes;
+                frameIndex.timestampNs = frameHeader.timestampNs;
+                frameIndex.frameNumber = frameHeader.frameNumber;
+                frameIndex.sourceId = frameHeader.sourceId;
+                frameIndex.sourceIdMax = frameHeader.sourceIdMax;
+                frameIndex.numberViews = frameHeader.numberViews;
+                frameIndex.name.resize(frameHeader.nameBytes);
+                if (frameHeader.nameBytes > 0u)
+                    mFile.read(&frameIndex.name[0], frameHeader.nameBytes);
+                mFrameIndexes.emplace_back(frameIndex);
+                mNumberSources = fastMax(mNumberSources, frameHeader.sourceIdMax + 1ull);
+                if (mFrameIndexes.size() == 1u)
+                    mResolution = Point<int>{frameHeader.width, frameHeader.height};
+                offset += frameHeader.frameBytes;
+            }
+            mFile.clear();
+            if (mFrameIndexes.empty())
+                error("The input recording " + mReplayPath + " does not contain any frame.",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+
+        std::vector<Matrix> readFrame(const ReplayFrameIndex& frameIndex)
+        {
+            // Whole chunk
+            mBuffer.resize(frameIndex.frameBytes);
+            mFile.seekg(frameIndex.offset);
+            mFile.read(mBuffer.data(), mBuffer.size());
+            if (!mFile.good())
+                error("Could not read frame " + std::to_string(frameIndex.frameNumber) + " of the input recording "
+                      + mReplayPath + ".", __LINE__, __FUNCTION__, __FILE__);
+            // Blocks of the chunk (padded to 8 bytes)
+            auto cursor = (unsigned long long)sizeof(InputRecordingFrameHeader);
+            const auto nextBlock = [&](const unsigned long long bytes) -> const char*
+            {
+                const auto* const blockPtr = mBuffer.data() + cursor;
+                cursor += inputRecordingPaddedBytes(bytes);
+                if (cursor > mBuffer.size())
+                    error("Corrupted frame " + std::to_string(frameIndex.frameNumber) + " in the input recording "
+                          + mReplayPath + ".", __LINE__, __FUNCTION__, __FILE__);
+                return blockPtr;
+            };
+            nextBlock(frameIndex.name.size());
+            std::vector<Matrix> frames;
+            std::vector<std::vector<Matrix>> cameraParameters(INPUT_RECORDING_MATRICES);
+            for (auto view = 0u ; view < frameIndex.numberViews ; view++)
+            {
+                InputRecordingViewHeader viewHeader;
+                std::memcpy(&viewHeader, nextBlock(sizeof(viewHeader)), sizeof(viewHeader));
+                // Image
+                const auto* const imagePtr = nextBlock(viewHeader.imageBytes);
+                cv::Mat frame;
+                if (viewHeader.imageBytes > 0u)
+                    frame = cv::imdecode(
+                        cv::Mat(1, (int)viewHeader.imageBytes, CV_8UC1, (void*)imagePtr), CV_LOAD_IMAGE_COLOR);
+                frames.emplace_back(OP_CV2OPCONSTMAT(frame));
+                // Camera parameters
+                for (auto matrix = 0u ; matrix < viewHeader.numberMatrices ; matrix++)
+                {
+                    InputRecordingMatrixHeader matrixHeader;
+                    std::memcpy(&matrixHeader, nextBlock(sizeof(matrixHeader)), sizeof(matrixHeader));
+                    const auto* const dataPtr = nextBlock(matrixHeader.dataBytes);
+                    cv::Mat cvMatrix;
+                    if (matrixHeader.rows > 0 && matrixHeader.cols > 0)
+                        cvMatrix = cv::Mat(matrixHeader.rows, matrixHeader.cols, matrixHeader.type, (void*)dataPtr)
+                            .clone();
+                    if (matrix < INPUT_RECORDING_MATRICES)
+                        cameraParameters[matrix].emplace_back(OP_CV2OPCONSTMAT(cvMatrix));
+                }
+            }
+            // As the other producers, no camera parameters if none was recorded
+            const auto nonEmptyOrNone = [](const std::vector<Matrix>& matrices) -> std::vector<Matrix>
+            {
+                for (const auto& matrix : matrices)
+                    if (!matrix.empty())
+                        return matrices;
+                return std::vector<Matrix>{};
+            };
+            mCameraMatrices = nonEmptyOrNone(cameraParameters[0]);
+            mCameraExtrinsics = nonEmptyOrNone(cameraParameters[1]);
+            mCameraIntrinsics = nonEmptyOrNone(cameraParameters[2]);
+            mCameraDistortions = nonEmptyOrNone(cameraParameters[3]);
+            mLastSourceId = frameIndex.sourceId;
+            mLastTimestampNs = frameIndex.timestampNs;
+            if (!frames.empty() && !frames[0].empty())
+                mResolution = Point<int>{frames[0].cols(), frames[0].rows()};
+            return frames;
+        }
+    };
+
+    ReplayReader::ReplayReader(const std::string& replayPath) :
+        // The camera parameters are recorded, so they are not read from any file
+        Producer{ProducerType::Replay, "", false, 1},
+        upImpl{new ImplReplayReader{replayPath}}
+    {
+        try
+        {
+            upImpl->readIndex();
+            Producer::set(ProducerProperty::NumberViews, upImpl->mFrameIndexes[0].numberViews);
+            opLog("Input recording " + replayPath + ": " + std::to_string(upImpl->mFrameIndexes.size())
+                  + " frames.", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    ReplayReader::~ReplayReader()
+    {
+    }
+
+    std::vector<Matrix> ReplayReader::getCameraMatrices()
+    {
+        return upImpl->mCameraMatrices;
+    }
+
+    std::vector<Matrix> ReplayReader::getCameraExtrinsics()
+    {
+        return upImpl->mCameraExtrinsics;
+    }
+
+    std::vector<Matrix> ReplayReader::getCameraIntrinsics()
+    {
+        return upImpl->mCameraIntrinsics;
+    }
+
+    std::vector<Matrix> ReplayReader::getCameraDistortions()
+    {
+        return upImpl->mCameraDistortions;
+    }
+
+    unsigned long long ReplayReader::getLastSourceId()
+    {
+        return upImpl->mLastSourceId;
+    }
+
+    unsigned long long ReplayReader::getNumberSources()
+    {
+        return upImpl->mNumberSources;
+    }
+
+    std::string ReplayReader::getNextFrameName()
+    {
+        try
+        {
+            return (hasNextFrame() ? upImpl->mFrameIndexes[upImpl->mNextIndex].name : "");
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    unsigned long long ReplayReader::getNextFrameNumber()
+    {
+        try
+        {
+            return (hasNextFrame() ? upImpl->mFrameIndexes[upImpl->mNextIndex].frameNumber : 0ull);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    double ReplayReader::getLastTimestampMs() const
+    {
+        return upImpl->mLastTimestampNs * 1e-6;
+    }
+
+    bool ReplayReader::hasNextFrame() const
+    {
+        return (upImpl->mNextIndex >= 0ll && upImpl->mNextIndex < (long long)upImpl->mFrameIndexes.size());
+    }
+
+    bool ReplayReader::isOpened() const
+    {
+        return (upImpl->mNextIndex >= 0ll);
+    }
+
+    void ReplayReader::release()
+    {
+        try
+        {
+            upImpl->mNextIndex = -1ll;
+            upImpl->mFile.close();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    Matrix ReplayReader::getRawFrame()
+    {
+        try
+        {
+            const auto frames = getRawFrames();
+            return (frames.empty() ? Matrix() : frames[0]);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Matrix();
+        }
+    }
+
+    std::vector<Matrix> ReplayReader::getRawFrames()
+    {
+        try
+        {
+            if (!hasNextFrame())
+                return {};
+            const auto& frameIndex = upImpl->mFrameIndexes[upImpl->mNextIndex];
+            // Original cadence: Wait until the recorded arrival time (relative to the first replayed frame)
+            if (getProducerFpsMode() == ProducerFpsMode::OriginalFps)
+            {
+                if (!upImpl->mTimingStarted)
+                {
+                    upImpl->mTimingStarted = true;
+                    upImpl->mTimeFirstReplayed = std::chrono::steady_clock::now();
+                    upImpl->mTimestampFirstReplayedNs = frameIndex.timestampNs;
+                }
+                std::this_thread::sleep_until(
+                    upImpl->mTimeFirstReplayed
+                    + std::chrono::nanoseconds{frameIndex.timestampNs - upImpl->mTimestampFirstReplayedNs});
+            }
+            auto frames = upImpl->readFrame(frameIndex);
+            // Skip frames if frame step > 1
+            upImpl->mNextIndex += fastMax(1ll, positiveLongLongRound(Producer::get(ProducerProperty::FrameStep)));
+            return frames;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    double ReplayReader::get(const int capProperty)
+    {
+        try
+        {
+            const auto rotated = (Producer::get(ProducerProperty::Rotation) == 90.
+                                  || Producer::get(ProducerProperty::Rotation) == 270.);
+            if (capProperty == CV_CAP_PROP_FRAME_WIDTH)
+                return (rotated ? upImpl->mResolution.y : upImpl->mResolution.x);
+            else if (capProperty == CV_CAP_PROP_FRAME_HEIGHT)
+                return (rotated ? upImpl->mResolution.x : upImpl->mResolution.y);
+            else if (capProperty == CV_CAP_PROP_POS_FRAMES)
+                return (double)fastMax(0ll, upImpl->mNextIndex);
+            else if (capProperty == CV_CAP_PROP_FRAME_COUNT)
+                return (double)upImpl->mFrameIndexes.size();
+            else if (capProperty == CV_CAP_PROP_FPS)
+            {
+                // Average frame rate of the recording
+                const auto& frameIndexes = upImpl->mFrameIndexes;
+                const auto durationNs = frameIndexes.back().timestampNs - frameIndexes.front().timestampNs;
+                return (durationNs > 0ll ? (frameIndexes.size() - 1) * 1e9 / durationNs : 30.);
+            }
+            else
+            {
+                opLog("Unknown property", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+                return -1.;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.;
+        }
+    }
+
+    void ReplayReader::set(const int capProperty, const double value)
+    {
+        try
+        {
+            if (capProperty == CV_CAP_PROP_POS_FRAMES)
+            {
+                upImpl->mNextIndex = fastTruncate(
+                    (long long)value, 0ll, (long long)upImpl->mFrameIndexes.size()-1);
+                // The original cadence restarts from the new position
+                upImpl->mTimingStarted = false;
+            }
+            else if (capProperty == CV_CAP_PROP_FRAME_WIDTH || capProperty == CV_CAP_PROP_FRAME_HEIGHT
+                     || capProperty == CV_CAP_PROP_FRAME_COUNT || capProperty == CV_CAP_PROP_FPS)
+                opLog("This property is read-only.", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+            else
+                opLog("Unknown property", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -0,0 +1,350 @@
+#include <openpose/producer/sharedMemoryReader.hpp>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <openpose/producer/frameRingFormat.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/string.hpp>
+#include <openpose_private/utilities/openCvMultiversionHeaders.hpp>
+#include <openpose_private/utilities/sharedMemory.hpp>
+
+namespace op
+{
+    namespace
+    {
+        // Maximum time getRawFrames() waits for a new frame before returning an empty one, so DatumProducer is not
+        // blocked forever if the writer process stalls (Producer is released after 3 consecutive empty frames)
+        const auto FRAME_RING_WAIT_MS = 1000;
+
+        // Shared by SharedMemoryReader and the leases of its frames, so the shared memory stays mapped until the last
+        // frame wrapping it is released (even if the reader is destroyed first)
+        struct SharedMemoryFrameRing
+        {
+            std::unique_ptr<SharedMemory> upSharedMemory;
+            unsigned int mNumberSlots;
+            unsigned long long mSlotBytes;
+            // Frames might be released out of order (e.g., by the WCvMatToOpInput of several GPUs), but the writer
+            // only reuses the slots of the contiguous released ones
+            std::mutex mReleaseMutex;
+            unsigned long long mReleaseSequence;
+            std::set<unsigned long long> mReleasedAhead;
+
+            SharedMemoryFrameRing(const std::string& sharedMemoryName) :
+                // Read-write, so the reader can update FrameRingHeader::releaseSequence
+                upSharedMemory{new SharedMemory{sharedMemoryName, true}},
+                mNumberSlots{0u},
+                mSlotBytes{0ull},
+                mReleaseSequence{0ull}
+            {
+            }
+
+            FrameRingHeader& getRingHeader() const
+            {
+                return *(FrameRingHeader*)upSharedMemory->getData();
+            }
+
+            unsigned char* getSlot(const unsigned long long sequence) const
+            {
+                return upSharedMemory->getData()
+                    + getFrameRingSlotOffset((uint32_t)(sequence % mNumberSlots), mSlotBytes);
+            }
+
+            void releaseFrame(const unsigned long long sequence)
+            {
+                const std::lock_guard<std::mutex> lock{mReleaseMutex};
+                if (sequence != mReleaseSequence)
+                    mReleasedAhead.emplace(sequence);
+                else
+                {
+                    mReleaseSequence++;
+                    while (!mReleasedAhead.empty() && *mReleasedAhead.begin() == mReleaseSequence)
+                    {
+                        mReleasedAhead.erase(mReleasedAhead.begin());
+                        mReleaseSequence++;
+                    }
+                    getRingHeader().releaseSequence.store(mReleaseSequence, std::memory_order_release);
+                }
+            }
+        };
+    }
+
+    struct SharedMemoryReader::ImplSharedMemoryReader
+    {
+        const std::string mSharedMemoryName;
+        std::shared_ptr<SharedMemoryFrameRing> spFrameRing;
+        bool mOpened;
+        unsigned long long mNextSequence;
+        Point<int> mResolution;
+        // Frame returned by the last getRawFrames()
+        std::vector<std::shared_ptr<void>> mLastFrameLeases;
+        unsigned long long mLastTimestampUs;
+        // Frame rate estimation (from the slot timestamps)
+        unsigned long long mNumberFramesRead;
+        unsigned long long mFirstTimestampUs;
+
+        ImplSharedMemoryReader(const std::string& sharedMemoryName) :
+            mSharedMemoryName{sharedMemoryName},
+            spFrameRing{std::make_shared<SharedMemoryFrameRing>(sharedMemoryName)},
+            mOpened{true},
+            mNextSequence{0ull},
+            mResolution{0, 0},
+            mLastTimestampUs{0ull},
+            mNumberFramesRead{0ull},
+            mFirstTimestampUs{0ull}
+        {
+        }
+
+        // It returns false if no frame was written within FRAME_RING_WAIT_MS (or if the writer closed the ring)
+        bool waitForFrame(const unsigned long long sequence)
+        {
+            const auto& ringHeader = spFrameRing->getRingHeader();
+            const auto timeEnd = std::chrono::steady_clock::now()
+                + std::chrono::milliseconds{FRAME_RING_WAIT_MS};
+            for (auto attempt = 0u ; ringHeader.writeSequence.load(std::memory_order_acquire) <= sequence ;
+                 attempt++)
+            {
+                if (ringHeader.writerClosed.load(std::memory_order_acquire) != 0u)
+                {
+                    // The writer might write its last frame and close the ring in between
+                    if (ringHeader.writeSequence.load(std::memory_order_acquire) > sequence)
+                        break;
+                    opLog("The writer process of the shared memory " + mSharedMemoryName + " closed it.",
+                          Priority::High);
+                    mOpened = false;
+                    return false;
+                }
+                if (std::chrono::steady_clock::now() > timeEnd)
+                    return false;
+                // Spinning for the first attempts (i.e., the frame is about to arrive), sleeping otherwise
+                if (attempt < 100u)
+                    std::this_thread::yield();
+                else
+                    std::this_thread::sleep_for(std::chrono::microseconds{100});
+            }
+            return true;
+        }
+
+        // Matrix wrapping (BGR) or converted from (NV12) the slot of frame sequence
+        Matrix readFrame(const unsigned long long sequence, const bool copyFrame)
+        {
+            const auto* const slot = spFrameRing->getSlot(sequence);
+            const auto& slotHeader = *(const FrameRingSlotHeader*)slot;
+            if (slotHeader.sequence.load(std::memory_order_acquire) != sequence + 1ull)
+                error("Frame " + std::to_string(sequence) + " of the shared memory " + mSharedMemoryName
+                      + " was overwritten before being released (the writer must wait for"
+                      " FrameRingHeader::releaseSequence).", __LINE__, __FUNCTION__, __FILE__);
+            const auto format = (FrameRingFormat)slotHeader.format;
+            const auto width = (int)slotHeader.width;
+            const auto height = (int)slotHeader.height;
+            const auto step = (std::size_t)slotHeader.step;
+            const auto rows = (format == FrameRingFormat::Nv12 ? height + height/2 : height);
+            const auto minStep = (std::size_t)width * (format == FrameRingFormat::Nv12 ? 1u : 3u);
+            if ((format != FrameRingFormat::Bgr && format != FrameRingFormat::Nv12) || width <= 0 || height <= 0
+                || step < minStep || (unsigned long long)rows * step > slotHeader.payloadBytes
+                || slotHeader.payloadBytes > spFrameRing->mSlotBytes)
+                error("Frame " + std::to_string(sequence) + " of the shared memory " + mSharedMemoryName
+                      + " has an invalid header.", __LINE__, __FUNCTION__, __FILE__);
+            auto* const payload = (void*)(slot + sizeof(FrameRingSlotHeader));
+            mLastTimestampUs = slotHeader.timestampUs;
+            if (mNumberFramesRead++ == 0ull)
+                mFirstTimestampUs = mLastTimestampUs;
+            mResolution = Point<int>{width, height};
+            // NV12: Converted into a new BGR frame
+            if (format == FrameRingFormat::Nv12)
+            {
+                cv::Mat frame;
+                cv::cvtColor(cv::Mat(rows, width, CV_8UC1, payload, step), frame, cv::COLOR_YUV2BGR_NV12);
+                spFrameRing->releaseFrame(sequence);
+                return OP_CV2OPCONSTMAT(frame);
+            }
+            // BGR: The Matrix wraps the slot until its lease is released
+            const cv::Mat slotFrame(height, width, CV_8UC3, payload, step);
+            if (copyFrame)
+            {
+                const cv::Mat frame = slotFrame.clone();
+                spFrameRing->releaseFrame(sequence);
+                return OP_CV2OPCONSTMAT(frame);
+            }
+            const auto frameRing = spFrameRing;
+            mLastFrameLeases.emplace_back(
+                payload, [frameRing, sequence](void*) { frameRing->releaseFrame(sequence); });
+            return OP_CV2OPCONSTMAT(slotFrame);
+        }
+    };
+
+    SharedMemoryReader::SharedMemoryReader(
+        const std::string& sharedMemoryName, const std::string& cameraParameterPath, const bool undistortImage) :
+        Producer{ProducerType::SharedMemory, cameraParameterPath, undistortImage, 1},
+        upImpl{new ImplSharedMemoryReader{sharedMemoryName}}
+    {
+        try
+        {
+            auto& frameRing = *upImpl->spFrameRing;
+            if (frameRing.upSharedMemory->getSize() < sizeof(FrameRingHeader))
+                error("Shared memory " + sharedMemoryName + " is not a frame ring buffer.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            const auto& ringHeader = frameRing.getRingHeader();
+            if (ringHeader.magic != FRAME_RING_MAGIC || ringHeader.version != FRAME_RING_VERSION)
+                error("Shared memory " + sharedMemoryName + " is not a frame ring buffer (or its version is not"
+                      " supported).", __LINE__, __FUNCTION__, __FILE__);
+            frameRing.mNumberSlots = ringHeader.numberSlots;
+            frameRing.mSlotBytes = ringHeader.slotBytes;
+            if (frameRing.mNumberSlots == 0u || frameRing.mSlotBytes % 8ull != 0ull
+                || getFrameRingSlotOffset(frameRing.mNumberSlots, frameRing.mSlotBytes)
+                    > frameRing.upSharedMemory->getSize())
+                error("Shared memory " + sharedMemoryName + " is corrupted.", __LINE__, __FUNCTION__, __FILE__);
+            // The frames not released by a previous reader are read again
+            frameRing.mReleaseSequence = ringHeader.releaseSequence.load(std::memory_order_acquire);
+            upImpl->mNextSequence = frameRing.mReleaseSequence;
+            opLog("Shared memory frame ring " + sharedMemoryName + ": " + std::to_string(frameRing.mNumberSlots)
+                  + " slots of " + std::to_string(frameRing.mSlotBytes) + " bytes.", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    SharedMemoryReader::~SharedMemoryReader()
+    {
+    }
+
+    std::vector<std::shared_ptr<void>> SharedMemoryReader::getLastFrameLeases()
+    {
+        return upImpl->mLastFrameLeases;
+    }
+
+    std::string SharedMemoryReader::getNextFrameName()
+    {
+        try
+        {
+            const auto stringLength = 12u;
+            return toFixedLengthString(upImpl->mNextSequence, stringLength);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    unsigned long long SharedMemoryReader::getLastTimestampUs() const
+    {
+        return upImpl->mLastTimestampUs;
+    }
+
+    bool SharedMemoryReader::isOpened() const
+    {
+        return upImpl->mOpened;
+    }
+
+    void SharedMemoryReader::release()
+    {
+        try
+        {
+            upImpl->mOpened = false;
+            // The frames still leased keep the shared memory mapped until they are released
+            upImpl->mLastFrameLeases.clear();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    Matrix SharedMemoryReader::getRawFrame()
+    {
+        try
+        {
+            const auto frames = getRawFrames();
+            return (frames.empty() ? Matrix() : frames[0]);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Matrix();
+        }
+    }
+
+    std::vector<Matrix> SharedMemoryReader::getRawFrames()
+    {
+        try
+        {
+            upImpl->mLastFrameLeases.clear();
+            if (!isOpened())
+                return {};
+            // Skip frames if frame step > 1 (they are released right away)
+            const auto frameStep = (unsigned long long)fastMax(
+                1ll, positiveLongLongRound(Producer::get(ProducerProperty::FrameStep)));
+            const auto sequence = upImpl->mNextSequence + frameStep - 1ull;
+            if (!upImpl->waitForFrame(sequence))
+                return {Matrix()};
+            for (auto skipped = upImpl->mNextSequence ; skipped < sequence ; skipped++)
+                upImpl->spFrameRing->releaseFrame(skipped);
+            upImpl->mNextSequence = sequence + 1ull;
+            // Flipped or rotated frames are modified in place, so they are copied rather than wrapped
+            const auto copyFrame = (Producer::get(ProducerProperty::Flip) == 1.
+                                    || Producer::get(ProducerProperty::Rotation) != 0.);
+            return {upImpl->readFrame(sequence, copyFrame)};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    double SharedMemoryReader::get(const int capProperty)
+    {
+        try
+        {
+            const auto rotated = (Producer::get(ProducerProperty::Rotation) == 90.
+                                  || Producer::get(ProducerProperty::Rotation) == 270.);
+            if (capProperty == CV_CAP_PROP_FRAME_WIDTH)
+                return (rotated ? upImpl->mResolution.y : upImpl->mResolution.x);
+            else if (capProperty == CV_CAP_PROP_FRAME_HEIGHT)
+                return (rotated ? upImpl->mResolution.x : upImpl->mResolution.y);
+            else if (capProperty == CV_CAP_PROP_POS_FRAMES)
+                return (double)upImpl->mNextSequence;
+            else if (capProperty == CV_CAP_PROP_FRAME_COUNT)
+                return -1.;
+            else if (capProperty == CV_CAP_PROP_FPS)
+            {
+                // Average frame rate of the frames read so far
+                const auto durationUs = upImpl->mLastTimestampUs - upImpl->mFirstTimestampUs;
+                return (upImpl->mNumberFramesRead > 1ull && upImpl->mLastTimestampUs > upImpl->mFirstTimestampUs
+                        ? (upImpl->mNumberFramesRead - 1ull) * 1e6 / durationUs : 30.);
+            }
+            else
+            {
+                opLog("Unknown property", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+                return -1.;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.;
+        }
+    }
+
+    void SharedMemoryReader::set(const int capProperty, const double value)
+    {
+        try
+        {
+            UNUSED(value);
+            if (capProperty == CV_CAP_PROP_FRAME_WIDTH || capProperty == CV_CAP_PROP_FRAME_HEIGHT
+                || capProperty == CV_CAP_PROP_POS_FRAMES || capProperty == CV_CAP_PROP_FRAME_COUNT
+                || capProperty == CV_CAP_PROP_FPS)
+                opLog("This property is read-only for a shared memory frame ring.",
+                      Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+            else
+                opLog("Unknown property", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
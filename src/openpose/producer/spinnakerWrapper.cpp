@@ -1,6 +1,7 @@
 #include <openpose/producer/spinnakerWrapper.hpp>
+#include <algorithm> // std::max_element
 #include <atomic>
-#include <mutex>
+#include <thread>
 #include <opencv2/imgproc/imgproc.hpp> // cv::undistort, cv::initUndistortRectifyMap
 #include <openpose_private/utilities/openCvMultiversionHeaders.hpp> // OPEN_CV_IS_4_OR_HIGHER
 #ifdef OPEN_CV_IS_4_OR_HIGHER
@@ -9,10 +10,23 @@
 #ifdef USE_FLIR_CAMERA
     #include <Spinnaker.h>
 #endif
+#ifdef USE_CUDA
+    #include <cuda_runtime.h>
+    #include <openpose/gpu/cuda.hpp>
+    #include <openpose/gpu/cudaMemoryPool.hpp>
+#endif
 #include <openpose/3d/cameraParameterReader.hpp>
+#include <openpose/thread/ringBufferQueue.hpp>
 
 namespace op
 {
+    // Images buffered per camera until the synchronization stage takes them (older ones are dropped)
+    const auto SPINNAKER_CAMERA_BUFFER_SIZE = 2ll;
+    // Maximum time each camera thread blocks in GetNextImage(), so it can check whether it must close
+    const auto SPINNAKER_GRAB_TIMEOUT_MILLISECONDS = 500ull;
+    // Weight of each synchronized set in the estimated clock offset of each camera (it follows the clock drift)
+    const auto SPINNAKER_OFFSET_WEIGHT = 0.1;
+
     #ifdef USE_FLIR_CAMERA
         std::vector<std::string> getSerialNumbers(const Spinnaker::CameraList& cameraList,
                                                   const bool sorted)
@@ -216,6 +230,31 @@ namespace op
             // return imagePtr->Convert(Spinnaker::PixelFormat_BGR8, Spinnaker::DIRECTIONAL_FILTER);
         }
 
+        FrameGpuFormat getBayerFormat(const Spinnaker::ImagePtr &imagePtr)
+        {
+            try
+            {
+                const auto pixelFormat = imagePtr->GetPixelFormat();
+                if (pixelFormat == Spinnaker::PixelFormat_BayerRG8)
+                    return FrameGpuFormat::BayerRggb;
+                else if (pixelFormat == Spinnaker::PixelFormat_BayerBG8)
+                    return FrameGpuFormat::BayerBggr;
+                else if (pixelFormat == Spinnaker::PixelFormat_BayerGR8)
+                    return FrameGpuFormat::BayerGrbg;
+                else if (pixelFormat == Spinnaker::PixelFormat_BayerGB8)
+                    return FrameGpuFormat::BayerGbrg;
+                error("GPU debayering (`--flir_camera_bayer_gpu`) requires the cameras to send 8-bit Bayer images"
+                      " (BayerRG8, BayerBG8, BayerGR8 or BayerGB8), but the pixel format is "
+                      + std::string{imagePtr->GetPixelFormatName().c_str()} + ".", __LINE__, __FUNCTION__, __FILE__);
+                return FrameGpuFormat::BayerRggb;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return FrameGpuFormat::BayerRggb;
+            }
+        }
+
         /*
          * This function converts between Spinnaker::ImagePtr container to cv::Mat container used in OpenCV.
         */
@@ -374,22 +413,141 @@ namespace op
             std::vector<std::string> mSerialNumbers;
             // Camera index
             const int mCameraIndex;
-            // Undistortion
-            const bool mUndistortImage;
+            // Undistortion (the camera parameters are read if mReadCameraParameters, but only the keypoints are
+            // undistorted if mUndistortKeypoints)
+            const bool mReadCameraParameters;
+            bool mUndistortImage;
+            bool mUndistortKeypoints;
             std::vector<cv::Mat> mRemoveDistortionMaps1;
             std::vector<cv::Mat> mRemoveDistortionMaps2;
-            // Thread
+            // Raw Bayer frames uploaded into GPU memory (if mBayerGpuId >= 0)
+            const int mBayerGpuId;
+            const bool mDownloadFrames;
+            std::vector<FrameGpu> mFramesGpu;
+            unsigned char* pBgrCuda;
+            unsigned long long mBgrMaxSize;
+            // Threads (1 per camera, each one with its own ring buffer)
             bool mThreadOpened;
-            std::vector<Spinnaker::ImagePtr> mBuffer;
-            std::mutex mBufferMutex;
             std::atomic<bool> mCloseThread;
-            std::thread mThread;
-
-            ImplSpinnakerWrapper(const bool undistortImage, const int cameraIndex) :
+            std::vector<std::thread> mThreads;
+            std::vector<std::shared_ptr<RingBufferQueue<Spinnaker::ImagePtr>>> mImageBuffers;
+            // Synchronization (timestamp of each camera minus the one of camera 0, in nanoseconds)
+            const double mSyncToleranceMs;
+            std::vector<double> mTimestampOffsets;
+
+            ImplSpinnakerWrapper(
+                const bool undistortImage, const int cameraIndex, const int bayerGpuId, const bool downloadFrames,
+                const double syncToleranceMs) :
                 mInitialized{false},
                 mCameraIndex{cameraIndex},
-                mUndistortImage{undistortImage}
+                mReadCameraParameters{undistortImage},
+                mUndistortImage{undistortImage},
+                mUndistortKeypoints{false},
+                mBayerGpuId{bayerGpuId},
+                mDownloadFrames{downloadFrames},
+                pBgrCuda{nullptr},
+                mBgrMaxSize{0ull},
+                mThreadOpened{false},
+                mCloseThread{false},
+                mSyncToleranceMs{syncToleranceMs}
+            {
+            }
+
+            ~ImplSpinnakerWrapper()
+            {
+                try
+                {
+                    #ifdef USE_CUDA
+                        if (pBgrCuda != nullptr)
+                        {
+                            cudaSetDevice(mBayerGpuId);
+                            cudaPoolFree(pBgrCuda);
+                        }
+                    #endif
+                }
+                catch (const std::exception& e)
+                {
+                    errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            // Raw Bayer image --> GPU memory (mFramesGpu[i]), and debayered on the GPU and downloaded into mCvMats[i]
+            // only if mDownloadFrames. It avoids the CPU Spinnaker::ImagePtr::Convert() of readAndUndistortImage()
+            void uploadBayerImage(const int i, const Spinnaker::ImagePtr& imagePtr)
             {
+                try
+                {
+                    #ifdef USE_CUDA
+                        cudaSetDevice(mBayerGpuId);
+                        FrameGpu frameGpu;
+                        frameGpu.width = (int)imagePtr->GetWidth();
+                        frameGpu.height = (int)imagePtr->GetHeight();
+                        frameGpu.pitch = frameGpu.width;
+                        frameGpu.gpuId = mBayerGpuId;
+                        frameGpu.format = getBayerFormat(imagePtr);
+                        frameGpu.timestamp = (unsigned long long)imagePtr->GetTimeStamp();
+                        auto* framePtr = (unsigned char*)cudaPoolMalloc(
+                            (unsigned long long)frameGpu.pitch * frameGpu.height);
+                        const auto gpuId = mBayerGpuId;
+                        frameGpu.dataPtr = std::shared_ptr<unsigned char>{
+                            framePtr,
+                            [gpuId](unsigned char* gpuPtr)
+                            {
+                                // Only this GPU copy outlives the grab: the Spinnaker image is copied synchronously
+                                // below, so its buffer is not referenced after this function. This copy goes with
+                                // Datum::inputDataGpu, so the thread destroying the last Datum copy frees it, after
+                                // selecting the device that allocated it
+                                int currentGpuId;
+                                cudaGetDevice(&currentGpuId);
+                                cudaSetDevice(gpuId);
+                                cudaPoolFree(gpuPtr);
+                                cudaSetDevice(currentGpuId);
+                            }};
+                        // Only the raw image (1 byte per pixel) goes through the PCIe bus
+                        cudaMemcpy2D(
+                            framePtr, frameGpu.pitch, imagePtr->GetData(), imagePtr->GetStride(), frameGpu.width,
+                            frameGpu.height, cudaMemcpyHostToDevice);
+                        // CPU copy (if something needs the image pixels)
+                        if (mDownloadFrames)
+                        {
+                            const auto bgrSize = 3ull * frameGpu.width * frameGpu.height;
+                            if (mBgrMaxSize < bgrSize)
+                            {
+                                mBgrMaxSize = bgrSize;
+                                cudaPoolFree(pBgrCuda);
+                                pBgrCuda = (unsigned char*)cudaPoolMalloc(bgrSize);
+                            }
+                            bayerToBgr(pBgrCuda, framePtr, frameGpu.width, frameGpu.height, frameGpu.pitch,
+                                       frameGpu.format);
+                            mCvMats[i] = cv::Mat(frameGpu.height, frameGpu.width, CV_8UC3);
+                            cudaMemcpy(mCvMats[i].data, pBgrCuda, bgrSize, cudaMemcpyDeviceToHost);
+                            // The GPU frame keeps the raw image, so its CPU copy is undistorted on its own
+                            if (mUndistortImage)
+                            {
+                                Matrix opMat = OP_CV2OPMAT(mCvMats[i]);
+                                mCameraParameterReader.undistort(opMat, i);
+                                mCvMats[i] = OP_OP2CVMAT(opMat);
+                            }
+                        }
+                        else
+                            mCvMats[i] = cv::Mat();
+                        cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                        // Undistorted while resized into the network input (cached remap table of the camera)
+                        if (mUndistortImage)
+                            frameGpu.undistortMapPtr = mCameraParameterReader.getUndistortMapGpu(
+                                i, frameGpu.width, frameGpu.height, frameGpu.gpuId);
+                        mFramesGpu[i] = frameGpu;
+                    #else
+                        UNUSED(i);
+                        UNUSED(imagePtr);
+                        error("GPU debayering (`--flir_camera_bayer_gpu`) requires the CUDA version of OpenPose.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    #endif
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
             }
 
             void readAndUndistortImage(const int i, const Spinnaker::ImagePtr& imagePtr,
@@ -454,52 +612,42 @@ namespace op
                 }
             }
 
-            void bufferingThread()
+            // Acquisition thread of the camera with index cameraIndex. It never waits for the other cameras, so the
+            // grab latency of one camera does not delay the others
+            void bufferingThread(const unsigned int cameraIndex)
             {
                 #ifdef USE_FLIR_CAMERA
                     try
                     {
-                        mCloseThread = false;
-                        // Get cameras - ~0.005 ms (3 cameras)
-                        std::vector<Spinnaker::CameraPtr> cameraPtrs(mCameraList.GetSize());
-                        for (auto i = 0u; i < cameraPtrs.size(); i++)
-                            cameraPtrs.at(i) = mCameraList.GetBySerial(mSerialNumbers.at(i)); // Sorted by Serial Number
-                            // cameraPtrs.at(i) = mCameraList.GetByIndex(i); // Sorted by however Spinnaker decided
+                        // Sorted by Serial Number
+                        auto cameraPtr = mCameraList.GetBySerial(mSerialNumbers.at(cameraIndex));
+                        auto& imageBuffer = *mImageBuffers.at(cameraIndex);
+                        auto& iNodeMap = cameraPtr->GetNodeMap();
                         while (!mCloseThread)
                         {
                             // Trigger
-                            for (auto i = 0u; i < cameraPtrs.size(); i++)
-                            {
-                                // Retrieve GenICam nodemap
-                                auto& iNodeMap = cameraPtrs[i]->GetNodeMap();
-                                Spinnaker::GenApi::CEnumerationPtr ptrAcquisitionMode = iNodeMap.GetNode("AcquisitionMode");
-                                const auto result = GrabNextImageByTrigger(iNodeMap);
-                                if (result != 0)
-                                    error("Error in GrabNextImageByTrigger.", __LINE__, __FUNCTION__, __FILE__);
-                            }
+                            const auto result = GrabNextImageByTrigger(iNodeMap);
+                            if (result != 0)
+                                error("Error in GrabNextImageByTrigger.", __LINE__, __FUNCTION__, __FILE__);
                             // Get frame
-                            std::vector<Spinnaker::ImagePtr> imagePtrs(cameraPtrs.size());
-                            for (auto i = 0u; i < cameraPtrs.size(); i++)
-                                imagePtrs.at(i) = cameraPtrs.at(i)->GetNextImage();
-                            // Move to buffer
-                            bool imagesExtracted = true;
-                            for (auto& imagePtr : imagePtrs)
+                            Spinnaker::ImagePtr imagePtr;
+                            try
                             {
-                                if (imagePtr->IsIncomplete())
-                                {
-                                    opLog("Image incomplete with image status " + std::to_string(imagePtr->GetImageStatus())
-                                        + "...", Priority::High, __LINE__, __FUNCTION__, __FILE__);
-                                    imagesExtracted = false;
-                                    break;
-                                }
+                                imagePtr = cameraPtr->GetNextImage(SPINNAKER_GRAB_TIMEOUT_MILLISECONDS);
                             }
-                            if (imagesExtracted)
+                            catch (const Spinnaker::Exception& e)
                             {
-                                std::unique_lock<std::mutex> lock{mBufferMutex};
-                                std::swap(mBuffer, imagePtrs);
-                                lock.unlock();
-                                std::this_thread::sleep_for(std::chrono::microseconds{1});
+                                if (e.GetError() == Spinnaker::SPINNAKER_ERR_TIMEOUT)
+                                    continue;
+                                throw;
                             }
+                            // Move to buffer (the oldest image is dropped if the synchronization is behind)
+                            if (imagePtr->IsIncomplete())
+                                opLog("Image incomplete with image status " + std::to_string(imagePtr->GetImageStatus())
+                                    + " (camera " + std::to_string(cameraIndex) + ")...", Priority::High,
+                                    __LINE__, __FUNCTION__, __FILE__);
+                            else
+                                imageBuffer.forceEmplace(imagePtr);
                         }
                     }
                     catch (const std::exception& e)
@@ -509,6 +657,75 @@ namespace op
                 #endif
             }
 
+            // Synchronization stage: It waits for an image of each camera and assembles the set whose timestamps
+            // (after removing the clock offset of each camera) are within mSyncToleranceMs, dropping the images that
+            // have no counterpart in the other cameras. It returns an empty vector if the threads are closed.
+            std::vector<Spinnaker::ImagePtr> getSynchronizedImages()
+            {
+                try
+                {
+                    std::vector<Spinnaker::ImagePtr> imagePtrs(mImageBuffers.size());
+                    while (!mCloseThread)
+                    {
+                        // Oldest image of each camera
+                        auto allCameras = true;
+                        for (auto i = 0u ; i < mImageBuffers.size() && allCameras ; i++)
+                        {
+                            allCameras = mImageBuffers[i]->waitUntilNotEmpty(
+                                1000ll*SPINNAKER_GRAB_TIMEOUT_MILLISECONDS);
+                            if (allCameras)
+                                imagePtrs[i] = mImageBuffers[i]->front();
+                            allCameras = allCameras && imagePtrs[i].IsValid();
+                        }
+                        if (!allCameras)
+                            continue;
+                        // First set: It defines the clock offset of each camera
+                        const auto timestamp0 = (double)imagePtrs[0]->GetTimeStamp();
+                        if (mTimestampOffsets.empty())
+                        {
+                            mTimestampOffsets.resize(imagePtrs.size());
+                            for (auto i = 0u ; i < imagePtrs.size() ; i++)
+                                mTimestampOffsets[i] = (double)imagePtrs[i]->GetTimeStamp() - timestamp0;
+                        }
+                        // Drop the images older than the newest one by more than the tolerance
+                        std::vector<double> timestamps(imagePtrs.size());
+                        for (auto i = 0u ; i < imagePtrs.size() ; i++)
+                            timestamps[i] = (double)imagePtrs[i]->GetTimeStamp() - mTimestampOffsets[i];
+                        const auto newestTimestamp = *std::max_element(timestamps.begin(), timestamps.end());
+                        auto imagesDropped = false;
+                        for (auto i = 0u ; i < imagePtrs.size() ; i++)
+                        {
+                            if ((newestTimestamp - timestamps[i]) * 1e-6 > mSyncToleranceMs)
+                            {
+                                mImageBuffers[i]->tryPop();
+                                imagesDropped = true;
+                            }
+                        }
+                        if (imagesDropped)
+                            continue;
+                        // Synchronized set
+                        for (auto i = 0u ; i < imagePtrs.size() ; i++)
+                        {
+                            mImageBuffers[i]->tryPop();
+                            mTimestampOffsets[i] += SPINNAKER_OFFSET_WEIGHT
+                                * ((double)imagePtrs[i]->GetTimeStamp() - timestamp0 - mTimestampOffsets[i]);
+                        }
+                        return imagePtrs;
+                    }
+                    return {};
+                }
+                catch (const Spinnaker::Exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                    return {};
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                    return {};
+                }
+            }
+
             // This function acquires and displays images from each device.
             std::vector<Matrix> acquireImages(
                 const std::vector<Matrix>& opCameraIntrinsics,
@@ -536,31 +753,14 @@ namespace op
                     // std::vector<Spinnaker::ImagePtr> imagePtrs(cameraPtrs.size());
                     // for (auto i = 0u; i < cameraPtrs.size(); i++)
                     //     imagePtrs.at(i) = cameraPtrs.at(i)->GetNextImage();
-                    std::vector<Spinnaker::ImagePtr> imagePtrs;
-                    // Retrieve frame
-                    auto cvMatRetrieved = false;
-                    while (!cvMatRetrieved)
-                    {
-                        // Retrieve frame
-                        std::unique_lock<std::mutex> lock{mBufferMutex};
-                        if (!mBuffer.empty())
-                        {
-                            std::swap(imagePtrs, mBuffer);
-                            cvMatRetrieved = true;
-                        }
-                        // No frames available -> sleep & wait
-                        else
-                        {
-                            lock.unlock();
-                            std::this_thread::sleep_for(std::chrono::microseconds{5});
-                        }
-                    }
+                    // Synchronized images of all the cameras (empty if closing)
+                    const auto imagePtrs = getSynchronizedImages();
                     // Getting frames
                     // Retrieve next received image and ensure image completion
                     // Spinnaker::ImagePtr imagePtr = cameraPtrs.at(i)->GetNextImage();
 
                     // All images completed
-                    bool imagesExtracted = true;
+                    bool imagesExtracted = !imagePtrs.empty();
                     for (auto& imagePtr : imagePtrs)
                     {
                         if (imagePtr->IsIncomplete())
@@ -572,8 +772,35 @@ namespace op
                         }
                     }
                     mCvMats.clear();
+                    mFramesGpu.clear();
+                    // Raw Bayer images into GPU memory
+                    if (imagesExtracted && mBayerGpuId >= 0)
+                    {
+                        mCvMats.resize(imagePtrs.size());
+                        mFramesGpu.resize(imagePtrs.size());
+                        // All cameras
+                        if (cameraIndex < 0)
+                        {
+                            for (auto i = 0u; i < imagePtrs.size(); i++)
+                                uploadBayerImage(i, imagePtrs.at(i));
+                        }
+                        // Only 1 camera
+                        else
+                        {
+                            // Sanity check
+                            if ((unsigned int)cameraIndex >= imagePtrs.size())
+                                error("There are only " + std::to_string(imagePtrs.size())
+                                      + " cameras, but you asked for the "
+                                      + std::to_string(cameraIndex+1) +"-th camera (i.e., `--flir_camera_index "
+                                      + std::to_string(cameraIndex) +"`), which doesn't exist. Note that the index is"
+                                      + " 0-based.", __LINE__, __FUNCTION__, __FILE__);
+                            uploadBayerImage(cameraIndex, imagePtrs.at(cameraIndex));
+                            mCvMats = std::vector<cv::Mat>{mCvMats[cameraIndex]};
+                            mFramesGpu = std::vector<FrameGpu>{mFramesGpu[cameraIndex]};
+                        }
+                    }
                     // Convert to cv::Mat
-                    if (imagesExtracted)
+                    else if (imagesExtracted)
                     {
                         // // Original image --> BGR uchar image - ~4 ms (3 cameras)
                         // for (auto& imagePtr : imagePtrs)
@@ -660,9 +887,11 @@ namespace op
     };
 
     SpinnakerWrapper::SpinnakerWrapper(const std::string& cameraParameterPath, const Point<int>& resolution,
-                                       const bool undistortImage, const int cameraIndex)
+                                       const bool undistortImage, const int cameraIndex, const int bayerGpuId,
+                                       const bool downloadFrames, const double syncToleranceMs)
         #ifdef USE_FLIR_CAMERA
-            : upImpl{new ImplSpinnakerWrapper{undistortImage, cameraIndex}}
+            : upImpl{new ImplSpinnakerWrapper{undistortImage, cameraIndex, bayerGpuId, downloadFrames,
+                                              syncToleranceMs}}
         #endif
     {
         #ifdef USE_FLIR_CAMERA
@@ -870,8 +1099,10 @@ namespace op
                         + serialNumbers[upImpl->mCameraIndex] + "...", Priority::High);
 
                 // Read camera parameters from SN
-                if (upImpl->mUndistortImage)
+                if (upImpl->mReadCameraParameters)
                 {
+                    // Only used by the GPU Bayer frames (see uploadBayerImage()), the CPU ones have their own maps
+                    upImpl->mCameraParameterReader.setUndistortImage(true);
                     // If all images required
                     if (upImpl->mCameraIndex < 0)
                         upImpl->mCameraParameterReader.readParameters(cameraParameterPath, serialNumbers);
@@ -884,9 +1115,17 @@ namespace op
                     }
                 }
 
-                // Start buffering thread
+                // Start buffering threads (1 per camera)
                 upImpl->mThreadOpened = true;
-                upImpl->mThread = std::thread{&SpinnakerWrapper::ImplSpinnakerWrapper::bufferingThread, this->upImpl};
+                for (auto i = 0u; i < serialNumbers.size(); i++)
+                {
+                    upImpl->mImageBuffers.emplace_back(
+                        std::make_shared<RingBufferQueue<Spinnaker::ImagePtr>>(SPINNAKER_CAMERA_BUFFER_SIZE));
+                    upImpl->mImageBuffers.back()->addPopper();
+                    upImpl->mImageBuffers.back()->addPusher();
+                    upImpl->mThreads.emplace_back(
+                        &SpinnakerWrapper::ImplSpinnakerWrapper::bufferingThread, this->upImpl, i);
+                }
 
                 // Get resolution
                 const auto cvMats = getRawFrames();
@@ -894,7 +1133,10 @@ namespace op
                 if (cvMats.empty())
                     error("Cameras could not be opened.", __LINE__, __FUNCTION__, __FILE__);
                 // Get resolution
-                upImpl->mResolution = Point<int>{cvMats[0].cols(), cvMats[0].rows()};
+                if (cvMats[0].empty() && !upImpl->mFramesGpu.empty())
+                    upImpl->mResolution = Point<int>{upImpl->mFramesGpu[0].width, upImpl->mFramesGpu[0].height};
+                else
+                    upImpl->mResolution = Point<int>{cvMats[0].cols(), cvMats[0].rows()};
 
                 const std::string numberCameras = std::to_string(upImpl->mCameraIndex < 0 ? serialNumbers.size() : 1);
                 opLog("\nRunning for " + numberCameras + " out of " + std::to_string(serialNumbers.size())
@@ -913,6 +1155,9 @@ namespace op
             UNUSED(resolution);
             UNUSED(undistortImage);
             UNUSED(cameraIndex);
+            UNUSED(bayerGpuId);
+            UNUSED(downloadFrames);
+            UNUSED(syncToleranceMs);
             error(USE_FLIR_CAMERA_ERROR, __LINE__, __FUNCTION__, __FILE__);
         #endif
     }
@@ -937,7 +1182,7 @@ namespace op
                 try
                 {
                     // Sanity check
-                    if (upImpl->mUndistortImage &&
+                    if (upImpl->mReadCameraParameters &&
                         (unsigned long long) upImpl->mCameraList.GetSize()
                             != upImpl->mCameraParameterReader.getNumberCameras())
                         error("The number of cameras must be the same as the INTRINSICS vector size.",
@@ -964,6 +1209,23 @@ namespace op
         }
     }
 
+    std::vector<FrameGpu> SpinnakerWrapper::getLastFramesGpu() const
+    {
+        try
+        {
+            #ifdef USE_FLIR_CAMERA
+                return upImpl->mFramesGpu;
+            #else
+                return {};
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
     std::vector<Matrix> SpinnakerWrapper::getCameraMatrices() const
     {
         try
@@ -1015,6 +1277,40 @@ namespace op
         }
     }
 
+    std::vector<Matrix> SpinnakerWrapper::getCameraDistortions() const
+    {
+        try
+        {
+            #ifdef USE_FLIR_CAMERA
+                if (upImpl->mUndistortKeypoints)
+                    return upImpl->mCameraParameterReader.getCameraDistortions();
+            #endif
+            return {};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void SpinnakerWrapper::setUndistortKeypoints(const bool undistortKeypoints)
+    {
+        try
+        {
+            #ifdef USE_FLIR_CAMERA
+                upImpl->mUndistortKeypoints = undistortKeypoints;
+                upImpl->mUndistortImage = upImpl->mReadCameraParameters && !undistortKeypoints;
+            #else
+                UNUSED(undistortKeypoints);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     Point<int> SpinnakerWrapper::getResolution() const
     {
         try
@@ -1061,7 +1357,12 @@ namespace op
                     if (upImpl->mThreadOpened)
                     {
                         upImpl->mCloseThread = true;
-                        upImpl->mThread.join();
+                        for (auto& imageBuffer : upImpl->mImageBuffers)
+                            imageBuffer->stop();
+                        for (auto& thread : upImpl->mThreads)
+                            thread.join();
+                        upImpl->mThreads.clear();
+                        upImpl->mImageBuffers.clear();
                     }
 
                     // End acquisition for each camera
@@ -0,0 +1,582 @@
+#include <openpose/producer/v4l2Reader.hpp>
+#ifdef USE_V4L2
+    #include <cerrno>
+    #include <chrono>
+    #include <cstring> // std::strerror
+    #include <mutex>
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <sys/ioctl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+    #include <linux/videodev2.h>
+    #ifdef USE_TURBOJPEG
+        #include <turbojpeg.h>
+    #endif
+#endif
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/string.hpp>
+#include <openpose_private/utilities/openCvMultiversionHeaders.hpp>
+
+namespace op
+{
+    #ifdef USE_V4L2
+        namespace
+        {
+            // Maximum time getRawFrames() waits for a new frame before returning an empty one (Producer is released
+            // after 3 consecutive empty frames)
+            const auto V4L2_WAIT_MS = 1000;
+            // Buffers requested to the driver (1 being decoded, the others being filled meanwhile)
+            const auto V4L2_NUMBER_BUFFERS = 4u;
+
+            int xioctl(const int fileDescriptor, const unsigned long request, void* argument)
+            {
+                int result;
+                do
+                    result = ioctl(fileDescriptor, request, argument);
+                while (result == -1 && errno == EINTR);
+                return result;
+            }
+
+            std::string getErrnoString()
+            {
+                return std::string{std::strerror(errno)};
+            }
+
+            // Shared by V4l2Reader and the leases of its frames, so the decoded frames still leased remain valid even
+            // if the reader is destroyed first
+            struct V4l2FramePool
+            {
+                // Only modified by the producer thread (the leases only give their index back)
+                std::vector<cv::Mat> mFrames;
+                std::mutex mFreeFramesMutex;
+                std::vector<std::size_t> mFreeFrames;
+
+                // Index of a frame not leased (a new one if all of them are leased)
+                std::size_t acquireFrame()
+                {
+                    const std::lock_guard<std::mutex> lock{mFreeFramesMutex};
+                    if (mFreeFrames.empty())
+                    {
+                        mFrames.emplace_back();
+                        return mFrames.size() - 1;
+                    }
+                    const auto index = mFreeFrames.back();
+                    mFreeFrames.pop_back();
+                    return index;
+                }
+
+                void releaseFrame(const std::size_t index)
+                {
+                    const std::lock_guard<std::mutex> lock{mFreeFramesMutex};
+                    mFreeFrames.emplace_back(index);
+                }
+            };
+        }
+    #else
+        const std::string USE_V4L2_ERROR{"OpenPose CMake must be compiled with the `WITH_V4L2` flag in order to"
+            " use the V4L2 webcam reader (`--camera_v4l2`). Alternatively, disable it."};
+    #endif
+
+    struct V4l2Reader::ImplV4l2Reader
+    {
+        #ifdef USE_V4L2
+            struct MappedBuffer
+            {
+                void* data;
+                std::size_t length;
+            };
+
+            const int mIndex;
+            int mFileDescriptor;
+            std::vector<MappedBuffer> mBuffers;
+            unsigned int mPixelFormat;
+            unsigned int mBytesPerLine;
+            Point<int> mResolution;
+            double mFps;
+            long long mFrameNameCounter;
+            // Frame step (counted on the frames captured by the driver)
+            unsigned long long mFramesCaptured;
+            unsigned long long mNextFrame;
+            std::shared_ptr<V4l2FramePool> spFramePool;
+            // Frame returned by the last getRawFrames()
+            std::vector<std::shared_ptr<void>> mLastFrameLeases;
+            // Frame rate estimation (from the frames read)
+            unsigned long long mNumberFramesRead;
+            std::chrono::high_resolution_clock::time_point mFirstFrameTime;
+            std::chrono::high_resolution_clock::time_point mLastFrameTime;
+            #ifdef USE_TURBOJPEG
+                tjhandle mTurboJpeg;
+            #endif
+
+            ImplV4l2Reader(const int index) :
+                mIndex{index},
+                mFileDescriptor{-1},
+                mPixelFormat{0u},
+                mBytesPerLine{0u},
+                mResolution{0, 0},
+                mFps{0.},
+                mFrameNameCounter{-1},
+                mFramesCaptured{0ull},
+                mNextFrame{0ull},
+                spFramePool{std::make_shared<V4l2FramePool>()},
+                mNumberFramesRead{0ull}
+                #ifdef USE_TURBOJPEG
+                    , mTurboJpeg{tjInitDecompress()}
+                #endif
+            {
+                #ifdef USE_TURBOJPEG
+                    if (mTurboJpeg == nullptr)
+                        error("libjpeg-turbo decompressor could not be initialized.", __LINE__, __FUNCTION__, __FILE__);
+                #endif
+            }
+
+            ~ImplV4l2Reader()
+            {
+                close();
+                #ifdef USE_TURBOJPEG
+                    tjDestroy(mTurboJpeg);
+                #endif
+            }
+
+            bool isOpened() const
+            {
+                return mFileDescriptor >= 0;
+            }
+
+            // It returns false if the device cannot be opened, and errors out if it is opened but not usable
+            bool open(const Point<int>& resolution, const int fps)
+            {
+                const auto devicePath = "/dev/video" + std::to_string(mIndex);
+                mFileDescriptor = ::open(devicePath.c_str(), O_RDWR | O_NONBLOCK);
+                if (mFileDescriptor < 0)
+                    return false;
+                // Capabilities
+                v4l2_capability capability{};
+                if (xioctl(mFileDescriptor, VIDIOC_QUERYCAP, &capability) != 0)
+                    error(devicePath + " is not a V4L2 device.", __LINE__, __FUNCTION__, __FILE__);
+                const auto capabilities = ((capability.capabilities & V4L2_CAP_DEVICE_CAPS)
+                                           ? capability.device_caps : capability.capabilities);
+                if (!(capabilities & V4L2_CAP_VIDEO_CAPTURE) || !(capabilities & V4L2_CAP_STREAMING))
+                    error(devicePath + " does not support video capture streaming.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                // Format: MJPEG (the highest frame rates at high resolutions on USB webcams), otherwise YUYV
+                v4l2_format format{};
+                const unsigned int pixelFormats[] = {V4L2_PIX_FMT_MJPEG, V4L2_PIX_FMT_YUYV};
+                for (const auto pixelFormat : pixelFormats)
+                {
+                    format = v4l2_format{};
+                    format.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                    format.fmt.pix.width = (unsigned int)(resolution.x > 0 ? resolution.x : 1280);
+                    format.fmt.pix.height = (unsigned int)(resolution.y > 0 ? resolution.y : 720);
+                    format.fmt.pix.pixelformat = pixelFormat;
+                    format.fmt.pix.field = V4L2_FIELD_ANY;
+                    if (xioctl(mFileDescriptor, VIDIOC_S_FMT, &format) == 0
+                        && format.fmt.pix.pixelformat == pixelFormat)
+                    {
+                        mPixelFormat = pixelFormat;
+                        break;
+                    }
+                }
+                if (mPixelFormat == 0u)
+                    error(devicePath + " supports neither MJPEG nor YUYV frames.", __LINE__, __FUNCTION__, __FILE__);
+                mResolution = Point<int>{(int)format.fmt.pix.width, (int)format.fmt.pix.height};
+                mBytesPerLine = fastMax(format.fmt.pix.bytesperline, 2u * format.fmt.pix.width);
+                // Frame rate
+                if (fps > 0)
+                {
+                    v4l2_streamparm streamParameters{};
+                    streamParameters.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                    streamParameters.parm.capture.timeperframe.numerator = 1u;
+                    streamParameters.parm.capture.timeperframe.denominator = (unsigned int)fps;
+                    if (xioctl(mFileDescriptor, VIDIOC_S_PARM, &streamParameters) != 0)
+                        opLog("Desired webcam frame rate " + std::to_string(fps) + " could not be set.",
+                              Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+                }
+                v4l2_streamparm streamParameters{};
+                streamParameters.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                if (xioctl(mFileDescriptor, VIDIOC_G_PARM, &streamParameters) == 0
+                    && streamParameters.parm.capture.timeperframe.numerator > 0u)
+                    mFps = streamParameters.parm.capture.timeperframe.denominator
+                         / (double)streamParameters.parm.capture.timeperframe.numerator;
+                // Memory-mapped buffers
+                v4l2_requestbuffers requestBuffers{};
+                requestBuffers.count = V4L2_NUMBER_BUFFERS;
+                requestBuffers.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                requestBuffers.memory = V4L2_MEMORY_MMAP;
+                if (xioctl(mFileDescriptor, VIDIOC_REQBUFS, &requestBuffers) != 0 || requestBuffers.count < 2u)
+                    error(devicePath + " does not support memory-mapped buffers (" + getErrnoString() + ").",
+                          __LINE__, __FUNCTION__, __FILE__);
+                for (auto index = 0u ; index < requestBuffers.count ; index++)
+                {
+                    v4l2_buffer buffer{};
+                    buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                    buffer.memory = V4L2_MEMORY_MMAP;
+                    buffer.index = index;
+                    if (xioctl(mFileDescriptor, VIDIOC_QUERYBUF, &buffer) != 0)
+                        error("VIDIOC_QUERYBUF failed (" + getErrnoString() + ").", __LINE__, __FUNCTION__, __FILE__);
+                    auto* data = mmap(nullptr, buffer.length, PROT_READ | PROT_WRITE, MAP_SHARED, mFileDescriptor,
+                                      buffer.m.offset);
+                    if (data == MAP_FAILED)
+                        error("Buffer " + std::to_string(index) + " of " + devicePath + " could not be mapped ("
+                              + getErrnoString() + ").", __LINE__, __FUNCTION__, __FILE__);
+                    mBuffers.emplace_back(MappedBuffer{data, (std::size_t)buffer.length});
+                }
+                for (auto index = 0u ; index < mBuffers.size() ; index++)
+                    queueBuffer(index);
+                auto bufferType = (int)V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                if (xioctl(mFileDescriptor, VIDIOC_STREAMON, &bufferType) != 0)
+                    error(devicePath + " could not start streaming (" + getErrnoString() + ").",
+                          __LINE__, __FUNCTION__, __FILE__);
+                mFrameNameCounter = 0;
+                return true;
+            }
+
+            void close()
+            {
+                if (mFileDescriptor >= 0)
+                {
+                    auto bufferType = (int)V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                    xioctl(mFileDescriptor, VIDIOC_STREAMOFF, &bufferType);
+                    for (const auto& buffer : mBuffers)
+                        munmap(buffer.data, buffer.length);
+                    mBuffers.clear();
+                    ::close(mFileDescriptor);
+                    mFileDescriptor = -1;
+                }
+            }
+
+            void queueBuffer(const unsigned int index)
+            {
+                v4l2_buffer buffer{};
+                buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                buffer.memory = V4L2_MEMORY_MMAP;
+                buffer.index = index;
+                if (xioctl(mFileDescriptor, VIDIOC_QBUF, &buffer) != 0)
+                    error("VIDIOC_QBUF failed (" + getErrnoString() + ").", __LINE__, __FUNCTION__, __FILE__);
+            }
+
+            // It dequeues all the filled buffers, queueing back all but the newest one, until a frame of the frame
+            // step lattice is found. False if none arrives within V4L2_WAIT_MS.
+            bool dequeueNewestBuffer(v4l2_buffer& newestBuffer, const unsigned long long frameStep)
+            {
+                auto found = false;
+                while (true)
+                {
+                    v4l2_buffer buffer{};
+                    buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                    buffer.memory = V4L2_MEMORY_MMAP;
+                    if (xioctl(mFileDescriptor, VIDIOC_DQBUF, &buffer) == 0)
+                    {
+                        // Corrupted frames are given back right away
+                        if (buffer.flags & V4L2_BUF_FLAG_ERROR)
+                            queueBuffer(buffer.index);
+                        else
+                        {
+                            mFramesCaptured++;
+                            if (found)
+                                queueBuffer(newestBuffer.index);
+                            newestBuffer = buffer;
+                            found = true;
+                        }
+                        continue;
+                    }
+                    if (errno != EAGAIN)
+                        error("VIDIOC_DQBUF failed (" + getErrnoString() + ").", __LINE__, __FUNCTION__, __FILE__);
+                    // No more filled buffers
+                    if (found)
+                    {
+                        if (mFramesCaptured >= mNextFrame)
+                        {
+                            mNextFrame = mFramesCaptured + frameStep;
+                            return true;
+                        }
+                        queueBuffer(newestBuffer.index);
+                        found = false;
+                    }
+                    pollfd pollFileDescriptor{mFileDescriptor, POLLIN, 0};
+                    const auto pollResult = poll(&pollFileDescriptor, 1, V4L2_WAIT_MS);
+                    if (pollResult == 0)
+                        return false;
+                    else if (pollResult < 0 && errno != EINTR)
+                        error("Webcam poll() failed (" + getErrnoString() + ").", __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            // It decodes the driver buffer into frame (which keeps its memory if the size does not change)
+            bool decode(cv::Mat& frame, const v4l2_buffer& buffer)
+            {
+                auto* const data = (unsigned char*)mBuffers.at(buffer.index).data;
+                const auto bytesUsed = (std::size_t)buffer.bytesused;
+                if (mPixelFormat == V4L2_PIX_FMT_YUYV)
+                {
+                    if (bytesUsed < (std::size_t)mBytesPerLine * mResolution.y)
+                        return false;
+                    cv::cvtColor(cv::Mat(mResolution.y, mResolution.x, CV_8UC2, data, mBytesPerLine), frame,
+                                 cv::COLOR_YUV2BGR_YUYV);
+                    return true;
+                }
+                // MJPEG
+                if (bytesUsed == 0u)
+                    return false;
+                #ifdef USE_TURBOJPEG
+                    int width;
+                    int height;
+                    int subsampling;
+                    int colorspace;
+                    if (tjDecompressHeader3(mTurboJpeg, data, (unsigned long)bytesUsed, &width, &height, &subsampling,
+                                            &colorspace) != 0)
+                        return false;
+                    frame.create(height, width, CV_8UC3);
+                    return tjDecompress2(mTurboJpeg, data, (unsigned long)bytesUsed, frame.data, width,
+                                         (int)frame.step, height, TJPF_BGR, TJFLAG_FASTDCT) == 0;
+                #else
+                    cv::imdecode(cv::Mat(1, (int)bytesUsed, CV_8UC1, data), cv::IMREAD_COLOR, &frame);
+                    return !frame.empty();
+                #endif
+            }
+
+            Matrix readFrame(const unsigned long long frameStep)
+            {
+                mLastFrameLeases.clear();
+                v4l2_buffer buffer{};
+                if (!dequeueNewestBuffer(buffer, frameStep))
+                    return Matrix();
+                // Decoded into a pooled frame not leased, so it is not reallocated
+                const auto poolIndex = spFramePool->acquireFrame();
+                auto& frame = spFramePool->mFrames[poolIndex];
+                const auto decoded = decode(frame, buffer);
+                queueBuffer(buffer.index);
+                auto framePool = spFramePool;
+                mLastFrameLeases.emplace_back(
+                    frame.data, [framePool, poolIndex](void*) { framePool->releaseFrame(poolIndex); });
+                if (!decoded)
+                {
+                    opLog("Corrupted webcam frame skipped.", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                    mLastFrameLeases.clear();
+                    return Matrix();
+                }
+                // Frame rate estimation
+                mLastFrameTime = std::chrono::high_resolution_clock::now();
+                if (mNumberFramesRead == 0ull)
+                    mFirstFrameTime = mLastFrameTime;
+                mNumberFramesRead++;
+                mFrameNameCounter++;
+                return OP_CV2OPCONSTMAT(frame);
+            }
+        #endif
+    };
+
+    V4l2Reader::V4l2Reader(
+        const int webcamIndex, const Point<int>& webcamResolution, const int fps, const bool throwExceptionIfNoOpened,
+        const std::string& cameraParameterPath, const bool undistortImage) :
+        Producer{ProducerType::Webcam, cameraParameterPath, undistortImage, 1}
+        #ifdef USE_V4L2
+            , upImpl{new ImplV4l2Reader{webcamIndex}}
+        #endif
+    {
+        try
+        {
+            #ifdef USE_V4L2
+                if (!upImpl->open(webcamResolution, fps))
+                {
+                    if (throwExceptionIfNoOpened)
+                        error("Webcam /dev/video" + std::to_string(webcamIndex) + " could not be opened ("
+                              + getErrnoString() + ").", __LINE__, __FUNCTION__, __FILE__);
+                    return;
+                }
+                if (webcamResolution != Point<int>{} && upImpl->mResolution != webcamResolution)
+                    opLog("Desired webcam resolution " + std::to_string(webcamResolution.x) + "x"
+                          + std::to_string(webcamResolution.y) + " could not being set. Final resolution: "
+                          + std::to_string(upImpl->mResolution.x) + "x" + std::to_string(upImpl->mResolution.y),
+                          Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+                opLog("V4L2 webcam /dev/video" + std::to_string(webcamIndex) + ": "
+                      + (upImpl->mPixelFormat == V4L2_PIX_FMT_MJPEG ? "MJPEG " : "YUYV ")
+                      + std::to_string(upImpl->mResolution.x) + "x" + std::to_string(upImpl->mResolution.y)
+                      + " at " + std::to_string(positiveIntRound(upImpl->mFps)) + " fps, "
+                      + std::to_string(upImpl->mBuffers.size()) + " buffers.", Priority::High);
+            #else
+                UNUSED(webcamIndex);
+                UNUSED(webcamResolution);
+                UNUSED(fps);
+                UNUSED(throwExceptionIfNoOpened);
+                error(USE_V4L2_ERROR, __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    V4l2Reader::~V4l2Reader()
+    {
+        try
+        {
+            release();
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<std::shared_ptr<void>> V4l2Reader::getLastFrameLeases()
+    {
+        #ifdef USE_V4L2
+            return upImpl->mLastFrameLeases;
+        #else
+            return {};
+        #endif
+    }
+
+    std::string V4l2Reader::getNextFrameName()
+    {
+        try
+        {
+            #ifdef USE_V4L2
+                const auto stringLength = 12u;
+                return toFixedLengthString(upImpl->mFrameNameCounter, stringLength);
+            #else
+                return "";
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    bool V4l2Reader::isOpened() const
+    {
+        try
+        {
+            #ifdef USE_V4L2
+                return upImpl->isOpened();
+            #else
+                return false;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void V4l2Reader::release()
+    {
+        try
+        {
+            #ifdef USE_V4L2
+                // The frames still leased keep their pooled memory until they are released
+                upImpl->mLastFrameLeases.clear();
+                upImpl->close();
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    Matrix V4l2Reader::getRawFrame()
+    {
+        try
+        {
+            const auto frames = getRawFrames();
+            return (frames.empty() ? Matrix() : frames[0]);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Matrix();
+        }
+    }
+
+    std::vector<Matrix> V4l2Reader::getRawFrames()
+    {
+        try
+        {
+            #ifdef USE_V4L2
+                if (!isOpened())
+                {
+                    upImpl->mLastFrameLeases.clear();
+                    return {};
+                }
+                const auto frameStep = (unsigned long long)fastMax(
+                    1ll, positiveLongLongRound(Producer::get(ProducerProperty::FrameStep)));
+                return {upImpl->readFrame(frameStep)};
+            #else
+                return {};
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    double V4l2Reader::get(const int capProperty)
+    {
+        try
+        {
+            #ifdef USE_V4L2
+                const auto rotated = (Producer::get(ProducerProperty::Rotation) == 90.
+                                      || Producer::get(ProducerProperty::Rotation) == 270.);
+                if (capProperty == CV_CAP_PROP_FRAME_WIDTH)
+                    return (rotated ? upImpl->mResolution.y : upImpl->mResolution.x);
+                else if (capProperty == CV_CAP_PROP_FRAME_HEIGHT)
+                    return (rotated ? upImpl->mResolution.x : upImpl->mResolution.y);
+                else if (capProperty == CV_CAP_PROP_POS_FRAMES)
+                    return (double)upImpl->mFrameNameCounter;
+                else if (capProperty == CV_CAP_PROP_FRAME_COUNT)
+                    return -1.;
+                else if (capProperty == CV_CAP_PROP_FPS)
+                {
+                    // Driver frame rate, otherwise the average one of the frames read so far
+                    if (upImpl->mFps > 0.)
+                        return upImpl->mFps;
+                    const auto durationSeconds = std::chrono::duration_cast<std::chrono::duration<double>>(
+                        upImpl->mLastFrameTime - upImpl->mFirstFrameTime).count();
+                    return (upImpl->mNumberFramesRead > 1ull && durationSeconds > 0.
+                            ? (upImpl->mNumberFramesRead - 1ull) / durationSeconds : 30.);
+                }
+                else
+                {
+                    opLog("Unknown property", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+                    return -1.;
+                }
+            #else
+                UNUSED(capProperty);
+                return -1.;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.;
+        }
+    }
+
+    void V4l2Reader::set(const int capProperty, const double value)
+    {
+        try
+        {
+            UNUSED(value);
+            if (capProperty == CV_CAP_PROP_FRAME_WIDTH || capProperty == CV_CAP_PROP_FRAME_HEIGHT
+                || capProperty == CV_CAP_PROP_POS_FRAMES || capProperty == CV_CAP_PROP_FRAME_COUNT
+                || capProperty == CV_CAP_PROP_FPS)
+                opLog("This property is read-only for a V4L2 webcam (set it on the constructor).",
+                      Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+            else
+                opLog("Unknown property", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
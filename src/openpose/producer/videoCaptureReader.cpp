@@ -1,4 +1,5 @@
 #include <openpose/producer/videoCaptureReader.hpp>
+#include <chrono>
 #include <iostream>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/string.hpp>
@@ -6,18 +7,64 @@
 
 namespace op
 {
+    // Minimum number of skipped frames to measure the cost of seeking (once the one of grabbing is known)
+    const auto SEEK_PROBE_FRAMES = 8.;
+
     struct VideoCaptureReader::ImplVideoCaptureReader
     {
         cv::VideoCapture mVideoCapture;
+        // Running averages of the time (in seconds) of grabbing 1 frame and of seeking (negative if not measured yet)
+        double mGrabSeconds;
+        double mSeekSeconds;
 
-        ImplVideoCaptureReader()
+        ImplVideoCaptureReader() :
+            mGrabSeconds{-1.},
+            mSeekSeconds{-1.}
         {
         }
 
         ImplVideoCaptureReader(const std::string& path) :
-            mVideoCapture{path}
+            mVideoCapture{path},
+            mGrabSeconds{-1.},
+            mSeekSeconds{-1.}
         {
         }
+
+        // It skips numberFrames frames without retrieving them (i.e., no BGR conversion nor copy): either by grabbing
+        // them, or, if seekable and measured to be cheaper, by seeking (which decodes from the previous keyframe, so
+        // its cost depends on the keyframe interval of the video)
+        void skipFrames(const double numberFrames, const bool seekable)
+        {
+            if (numberFrames < 1.)
+                return;
+            auto seek = false;
+            if (seekable)
+            {
+                // Nothing measured yet: set(CV_CAP_PROP_POS_FRAMES) is usually only cheaper for big steps
+                if (mGrabSeconds < 0.)
+                    seek = (numberFrames >= 50.);
+                // Seek cost not measured yet: it is probed once the frame step is not trivial
+                else if (mSeekSeconds < 0.)
+                    seek = (numberFrames >= SEEK_PROBE_FRAMES);
+                else
+                    seek = (mSeekSeconds < numberFrames * mGrabSeconds);
+            }
+            const auto begin = std::chrono::high_resolution_clock::now();
+            auto framesGrabbed = 0;
+            if (seek)
+                mVideoCapture.set(CV_CAP_PROP_POS_FRAMES, mVideoCapture.get(CV_CAP_PROP_POS_FRAMES) + numberFrames);
+            else
+                for ( ; framesGrabbed < numberFrames ; framesGrabbed++)
+                    if (!mVideoCapture.grab())
+                        break;
+            const auto seconds = std::chrono::duration_cast<std::chrono::duration<double>>(
+                std::chrono::high_resolution_clock::now() - begin).count();
+            // Running averages (only the relative cost matters, so a fast update rate is enough)
+            auto& average = (seek ? mSeekSeconds : mGrabSeconds);
+            const auto sample = (seek ? seconds : seconds / fastMax(1, framesGrabbed));
+            if (seek || framesGrabbed > 0)
+                average = (average < 0. ? sample : 0.8 * average + 0.2 * sample);
+        }
     };
 
     VideoCaptureReader::VideoCaptureReader(const int index, const bool throwExceptionIfNoOpened,
@@ -112,13 +159,9 @@ namespace op
                 // Close if end of video
                 if (get(CV_CAP_PROP_POS_FRAMES) + frameStep-1 >= get(CV_CAP_PROP_FRAME_COUNT))
                     upImpl->mVideoCapture.release();
-                // Frame step usually more efficient if just reading sequentially
-                else if (frameStep < 51)
-                    for (auto i = 1 ; i < frameStep ; i++)
-                        upImpl->mVideoCapture >> frame;
-                // Using set(CV_CAP_PROP_POS_FRAMES, value) is efficient only if step is big
+                // The skipped frames are grabbed or seeked over, whatever is cheaper, but never retrieved
                 else
-                    set(CV_CAP_PROP_POS_FRAMES, get(CV_CAP_PROP_POS_FRAMES) + frameStep-1);
+                    upImpl->skipFrames(frameStep-1, getType() == ProducerType::Video);
             }
             // Return frame
             Matrix opFrame = OP_CV2OPMAT(frame);
@@ -144,6 +187,18 @@ namespace op
         }
     }
 
+    void VideoCaptureReader::skipRawFrames(const unsigned long long numberFrames)
+    {
+        try
+        {
+            upImpl->skipFrames((double)numberFrames, getType() == ProducerType::Video);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     void VideoCaptureReader::resetWebcam(const int index, const bool throwExceptionIfNoOpened)
     {
         try
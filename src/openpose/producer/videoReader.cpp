@@ -1,21 +1,255 @@
 #include <openpose/producer/videoReader.hpp>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <thread>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/fileSystem.hpp>
 #include <openpose_private/utilities/openCvMultiversionHeaders.hpp>
 
 namespace op
 {
+    // Pool of decoders, each one with its own cv::VideoCapture, decoding the next segments of the video (1 per
+    // decoder) in parallel. Segments start at the multiples of mSegmentFrames (i.e., at keyframes if it is a multiple
+    // of the keyframe interval), and a decoder only seeks if its next segment does not continue its previous one.
+    // Frames are returned in order, from the oldest segment of the window. With frame step > 1, only the frames
+    // returned (firstFrame + k x frameStep) are retrieved, the other ones are only grabbed (no BGR conversion).
+    struct VideoReader::ImplVideoReader
+    {
+        struct Segment
+        {
+            long long frameBegin;
+            long long frameEnd; // Exclusive, the last segment is read until the end of the video
+            long long firstFrame; // First frame to retrieve (>= frameBegin)
+            long long frameStep;
+            bool assigned;
+            bool finished;
+            bool cancelled;
+            std::deque<std::pair<long long, Matrix>> frames;
+        };
+
+        const std::string mVideoPath;
+        const long long mSegmentFrames;
+        const long long mFrameCount;
+        const std::size_t mNumberDecoders;
+        std::vector<std::thread> mThreads;
+        std::mutex mMutex;
+        std::condition_variable mConditionVariable;
+        bool mRunning;
+        // Window of the next segments (in order)
+        std::deque<std::shared_ptr<Segment>> mSegments;
+
+        ImplVideoReader(
+            const std::string& videoPath, const int numberDecoders, const int segmentFrames,
+            const long long frameCount) :
+            mVideoPath{videoPath},
+            mSegmentFrames{segmentFrames},
+            mFrameCount{frameCount},
+            mNumberDecoders{(std::size_t)numberDecoders},
+            mRunning{true}
+        {
+            for (auto i = 0 ; i < numberDecoders ; i++)
+                mThreads.emplace_back(&ImplVideoReader::decode, this);
+        }
+
+        ~ImplVideoReader()
+        {
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                mRunning = false;
+                while (!mSegments.empty())
+                    cancelOldestSegment();
+            }
+            mConditionVariable.notify_all();
+            for (auto& thread : mThreads)
+                if (thread.joinable())
+                    thread.join();
+        }
+
+        // It must be called with mMutex locked
+        void cancelOldestSegment()
+        {
+            mSegments.front()->cancelled = true;
+            mSegments.front()->frames.clear();
+            mSegments.pop_front();
+        }
+
+        void decode()
+        {
+            cv::VideoCapture videoCapture;
+            // Next frame that videoCapture would read
+            auto nextFrame = -1ll;
+            std::unique_lock<std::mutex> lock{mMutex};
+            while (true)
+            {
+                std::shared_ptr<Segment> segment;
+                mConditionVariable.wait(lock, [&]
+                {
+                    if (!mRunning)
+                        return true;
+                    for (const auto& scheduledSegment : mSegments)
+                    {
+                        if (!scheduledSegment->assigned)
+                        {
+                            segment = scheduledSegment;
+                            return true;
+                        }
+                    }
+                    return false;
+                });
+                if (!mRunning)
+                    break;
+                segment->assigned = true;
+                lock.unlock();
+                try
+                {
+                    if (!videoCapture.isOpened() && !videoCapture.open(mVideoPath))
+                        error("The video decoder could not open " + mVideoPath + ".",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    if (nextFrame != segment->frameBegin)
+                    {
+                        videoCapture.set(CV_CAP_PROP_POS_FRAMES, (double)segment->frameBegin);
+                        nextFrame = segment->frameBegin;
+                    }
+                    auto cancelled = false;
+                    while (!cancelled && nextFrame < segment->frameEnd)
+                    {
+                        // Frames not returned (frame step > 1) are decoded (later frames might refer to them) but
+                        // not retrieved
+                        if (nextFrame < segment->firstFrame
+                            || (nextFrame - segment->firstFrame) % segment->frameStep != 0)
+                        {
+                            if (!videoCapture.grab())
+                                break;
+                            nextFrame++;
+                            lock.lock();
+                            cancelled = segment->cancelled;
+                            lock.unlock();
+                            continue;
+                        }
+                        // A new cv::Mat each time, read() would otherwise overwrite the buffer of the previous frame
+                        cv::Mat frame;
+                        if (!videoCapture.read(frame) || frame.empty())
+                            break;
+                        const Matrix opFrame = OP_CV2OPMAT(frame);
+                        lock.lock();
+                        cancelled = segment->cancelled;
+                        if (!cancelled)
+                            segment->frames.emplace_back(nextFrame, opFrame);
+                        lock.unlock();
+                        mConditionVariable.notify_all();
+                        nextFrame++;
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    // The rest of the segment is returned as empty frames (reported by checkFrameIntegrity)
+                    opLog(e.what(), Priority::High, __LINE__, __FUNCTION__, __FILE__);
+                    nextFrame = -1ll;
+                }
+                lock.lock();
+                segment->finished = true;
+                mConditionVariable.notify_all();
+            }
+        }
+
+        Matrix getFrame(const long long frameIndex, const long long frameStep)
+        {
+            std::unique_lock<std::mutex> lock{mMutex};
+            // Drop the segments already returned, or all of them if frameIndex is not in the window (e.g., after
+            // seeking) or not retrieved by it (e.g., after changing the frame step)
+            while (!mSegments.empty() && mSegments.front()->frameEnd <= frameIndex)
+                cancelOldestSegment();
+            if (!mSegments.empty()
+                && (mSegments.front()->frameBegin > frameIndex || mSegments.front()->frameStep != frameStep
+                    || frameIndex < mSegments.front()->firstFrame
+                    || (frameIndex - mSegments.front()->firstFrame) % frameStep != 0))
+                while (!mSegments.empty())
+                    cancelOldestSegment();
+            // Schedule the next segments (1 per decoder)
+            const auto frameEndUnknown = std::numeric_limits<long long>::max();
+            while (mSegments.size() < mNumberDecoders
+                   && (mSegments.empty() || mSegments.back()->frameEnd != frameEndUnknown))
+            {
+                const auto frameBegin = (mSegments.empty() ? frameIndex : mSegments.back()->frameEnd);
+                auto frameEnd = (frameBegin / mSegmentFrames + 1) * mSegmentFrames;
+                // The frame count is only approximated by some containers, so the last segment is read until the end
+                if (frameEnd >= mFrameCount)
+                    frameEnd = frameEndUnknown;
+                // Same frame step lattice than the previous segment
+                auto firstFrame = frameIndex;
+                if (!mSegments.empty())
+                {
+                    const auto previousFirstFrame = mSegments.back()->firstFrame;
+                    firstFrame = previousFirstFrame
+                        + (frameBegin - previousFirstFrame + frameStep - 1) / frameStep * frameStep;
+                }
+                mSegments.emplace_back(std::make_shared<Segment>(
+                    Segment{frameBegin, frameEnd, firstFrame, frameStep, false, false, false, {}}));
+            }
+            mConditionVariable.notify_all();
+            // Wait for the desired frame (or for the end of its segment)
+            const auto segment = mSegments.front();
+            mConditionVariable.wait(lock, [&]
+            {
+                return segment->finished || (!segment->frames.empty() && segment->frames.back().first >= frameIndex);
+            });
+            // Skip the previous frames (e.g., if frame step > 1)
+            while (!segment->frames.empty() && segment->frames.front().first < frameIndex)
+                segment->frames.pop_front();
+            // End of the video
+            if (segment->frames.empty() || segment->frames.front().first != frameIndex)
+                return Matrix();
+            const auto frame = segment->frames.front().second;
+            segment->frames.pop_front();
+            return frame;
+        }
+    };
+
     VideoReader::VideoReader(const std::string& videoPath, const std::string& cameraParameterPath,
-                             const bool undistortImage, const int numberViews) :
+                             const bool undistortImage, const int numberViews, const int numberDecoders,
+                             const int segmentFrames) :
         VideoCaptureReader{videoPath, ProducerType::Video, cameraParameterPath, undistortImage, numberViews},
-        mPathName{getFileNameNoExtension(videoPath)}
+        mPathName{getFileNameNoExtension(videoPath)},
+        mFramePosition{0ll}
     {
+        try
+        {
+            // Sanity check
+            if (numberDecoders < 0 || segmentFrames < 1)
+                error("The number of video decoders must be 0 (synchronous decoding) or positive, and the number of"
+                      " frames per segment positive.", __LINE__, __FUNCTION__, __FILE__);
+            // Parallel decoding
+            if (numberDecoders > 0)
+                upImpl.reset(new ImplVideoReader{
+                    videoPath, numberDecoders, segmentFrames,
+                    positiveLongLongRound(VideoCaptureReader::get(CV_CAP_PROP_FRAME_COUNT))});
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     VideoReader::~VideoReader()
     {
     }
 
+    void VideoReader::release()
+    {
+        try
+        {
+            // Stop decoding threads
+            upImpl.reset();
+            VideoCaptureReader::release();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     std::string VideoReader::getNextFrameName()
     {
         try
@@ -36,6 +270,9 @@ namespace op
             if (capProperty == CV_CAP_PROP_FRAME_WIDTH)
                 return VideoCaptureReader::get(capProperty)
                     / positiveIntRound(Producer::get(ProducerProperty::NumberViews));
+            // Parallel decoding: the cv::VideoCapture of VideoCaptureReader is only used for the video properties
+            else if (capProperty == CV_CAP_PROP_POS_FRAMES && upImpl != nullptr)
+                return (double)mFramePosition;
             else
                 return VideoCaptureReader::get(capProperty);
         }
@@ -50,7 +287,10 @@ namespace op
     {
         try
         {
-            VideoCaptureReader::set(capProperty, value);
+            if (capProperty == CV_CAP_PROP_POS_FRAMES && upImpl != nullptr)
+                mFramePosition = fastMax(0ll, positiveLongLongRound(value));
+            else
+                VideoCaptureReader::set(capProperty, value);
         }
         catch (const std::exception& e)
         {
@@ -62,6 +302,14 @@ namespace op
     {
         try
         {
+            // Parallel decoding
+            if (upImpl != nullptr)
+            {
+                const auto frameStep = fastMax(1ll, positiveLongLongRound(Producer::get(ProducerProperty::FrameStep)));
+                const auto frame = upImpl->getFrame(mFramePosition, frameStep);
+                mFramePosition += frameStep;
+                return frame;
+            }
             return VideoCaptureReader::getRawFrame();
         }
         catch (const std::exception& e)
@@ -71,6 +319,26 @@ namespace op
         }
     }
 
+    void VideoReader::skipRawFrames(const unsigned long long numberFrames)
+    {
+        try
+        {
+            // Parallel decoding: the next frame requested is moved, so the skipped ones are never retrieved. It is
+            // rounded up to a multiple of the frame step, so the scheduled segments remain valid
+            if (upImpl != nullptr)
+            {
+                const auto frameStep = fastMax(1ll, positiveLongLongRound(Producer::get(ProducerProperty::FrameStep)));
+                mFramePosition += ((long long)numberFrames + frameStep - 1) / frameStep * frameStep;
+            }
+            else
+                VideoCaptureReader::skipRawFrames(numberFrames);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     std::vector<Matrix> VideoReader::getRawFrames()
     {
         try
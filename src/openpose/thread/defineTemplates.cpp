@@ -3,8 +3,10 @@
 namespace op
 {
     // Queues
+    DEFINE_TEMPLATE_DATUM(DeadlineQueue);
     DEFINE_TEMPLATE_DATUM(PriorityQueue);
     DEFINE_TEMPLATE_DATUM(Queue);
+    DEFINE_TEMPLATE_DATUM(RingBufferQueue);
     template class OP_API QueueBase<BASE_DATUMS_SH, std::queue<BASE_DATUMS_SH>>;
     template class OP_API QueueBase<
         BASE_DATUMS_SH,
@@ -19,13 +21,17 @@ namespace op
     // Thread
     DEFINE_TEMPLATE_DATUM(Thread);
     DEFINE_TEMPLATE_DATUM(ThreadManager);
+    DEFINE_TEMPLATE_DATUM(ThreadPool);
     // Main workers
     DEFINE_TEMPLATE_DATUM(Worker);
     DEFINE_TEMPLATE_DATUM(WorkerConsumer);
     DEFINE_TEMPLATE_DATUM(WorkerProducer);
     // W-classes
     DEFINE_TEMPLATE_DATUM(WFpsMax);
+    DEFINE_TEMPLATE_DATUM(WFrameCredits);
+    DEFINE_TEMPLATE_DATUM(WGpuDispatch);
     DEFINE_TEMPLATE_DATUM(WIdGenerator);
     template class OP_API WQueueAssembler<BASE_DATUMS>;
     DEFINE_TEMPLATE_DATUM(WQueueOrderer);
+    DEFINE_TEMPLATE_DATUM(WViewGpuAffinity);
 }
@@ -0,0 +1,144 @@
+#include <openpose/thread/frameCredits.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <iomanip> // std::setprecision
+#include <mutex>
+#include <sstream>
+#include <openpose/utilities/fastMath.hpp>
+
+namespace op
+{
+    struct FrameCredits::ImplFrameCredits
+    {
+        const unsigned long long mNumberCredits;
+        mutable std::mutex mMutex;
+        std::condition_variable mConditionVariable;
+        unsigned long long mInFlight;
+        unsigned long long mPeakInFlight;
+        unsigned long long mTaken;
+        unsigned long long mDelayedFrames;
+        double mWaitMs;
+
+        ImplFrameCredits(const unsigned long long numberCredits) :
+            mNumberCredits{fastMax(1ull, numberCredits)},
+            mInFlight{0ull},
+            mPeakInFlight{0ull},
+            mTaken{0ull},
+            mDelayedFrames{0ull},
+            mWaitMs{0.}
+        {
+        }
+
+        void grant()
+        {
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                if (mInFlight > 0ull)
+                    mInFlight--;
+            }
+            mConditionVariable.notify_all();
+        }
+    };
+
+    FrameCredits::FrameCredits(const unsigned long long numberCredits) :
+        spImpl{std::make_shared<ImplFrameCredits>(numberCredits)}
+    {
+    }
+
+    FrameCredits::~FrameCredits()
+    {
+        try
+        {
+            if (spImpl->mTaken > 0ull)
+                opLog("Frame credits: " + getStatsString(), Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool FrameCredits::waitForCredit(const long long timeoutMicroseconds)
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{spImpl->mMutex};
+            if (spImpl->mInFlight < spImpl->mNumberCredits)
+                return true;
+            const auto begin = std::chrono::high_resolution_clock::now();
+            const auto hasCredit = spImpl->mConditionVariable.wait_for(
+                lock, std::chrono::microseconds{timeoutMicroseconds},
+                [this]{ return spImpl->mInFlight < spImpl->mNumberCredits; });
+            spImpl->mWaitMs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::high_resolution_clock::now() - begin).count() * 1e-6;
+            // A frame delayed by several timeouts is counted once
+            if (hasCredit)
+                spImpl->mDelayedFrames++;
+            return hasCredit;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    std::shared_ptr<void> FrameCredits::takeCredit()
+    {
+        try
+        {
+            {
+                const std::lock_guard<std::mutex> lock{spImpl->mMutex};
+                spImpl->mInFlight++;
+                spImpl->mTaken++;
+                spImpl->mPeakInFlight = fastMax(spImpl->mPeakInFlight, spImpl->mInFlight);
+            }
+            // The lease owns no memory (it points to the shared state), its deleter only grants the credit back
+            const auto spImplCopy = spImpl;
+            return std::shared_ptr<void>{(void*)spImplCopy.get(), [spImplCopy](void*) { spImplCopy->grant(); }};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    unsigned long long FrameCredits::getNumberCredits() const
+    {
+        return spImpl->mNumberCredits;
+    }
+
+    unsigned long long FrameCredits::getNumberInFlight() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{spImpl->mMutex};
+            return spImpl->mInFlight;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    std::string FrameCredits::getStatsString() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{spImpl->mMutex};
+            std::stringstream stringStream;
+            stringStream << std::fixed << std::setprecision(2) << spImpl->mTaken << " frames, peak of "
+                << spImpl->mPeakInFlight << " of " << spImpl->mNumberCredits << " frames in flight, the producer"
+                " waited for a credit on " << spImpl->mDelayedFrames << " frames (" << spImpl->mWaitMs * 1e-3
+                << " s in total).";
+            return stringStream.str();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+}
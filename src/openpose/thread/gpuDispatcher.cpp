@@ -0,0 +1,259 @@
+#include <openpose/thread/gpuDispatcher.hpp>
+#include <chrono>
+#include <deque>
+#include <iomanip> // std::setprecision
+#include <mutex>
+#include <sstream>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/metrics.hpp>
+
+namespace op
+{
+    // Frames finished before the average time of a GPU is used (until then, it takes any frame)
+    const auto GPU_DISPATCHER_WARMUP_FRAMES = 3u;
+    // Weight of each new frame in the exponential moving average of the frame time
+    const auto GPU_DISPATCHER_AVERAGE_WEIGHT = 0.1;
+    // Another GPU is only faster if it finishes at least 10% earlier, so similar GPUs do not defer to each other
+    const auto GPU_DISPATCHER_MARGIN = 0.9;
+
+    typedef std::chrono::high_resolution_clock::time_point TimePoint;
+
+    double getMilliseconds(const TimePoint& begin, const TimePoint& end)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() * 1e-6;
+    }
+
+    struct GpuDispatcherState
+    {
+        std::deque<TimePoint> startTimes;
+        TimePoint firstStart;
+        TimePoint lastFinish;
+        bool started;
+        unsigned long long frames;
+        unsigned long long deferrals;
+        double frameMs;
+        bool deferring;
+        TimePoint deferringBegin;
+        std::shared_ptr<Histogram> spFrameHistogram;
+
+        GpuDispatcherState() :
+            started{false},
+            frames{0ull},
+            deferrals{0ull},
+            frameMs{0.},
+            deferring{false}
+        {
+        }
+
+        // Expected time until a new frame would be finished by this GPU
+        inline double getExpectedMs() const
+        {
+            return (startTimes.size() + 1) * frameMs;
+        }
+    };
+
+    struct GpuDispatcher::ImplGpuDispatcher
+    {
+        mutable std::mutex mMutex;
+        const unsigned int mNumberGpus;
+        const unsigned long long mSpilloverQueueSize;
+        // GPUs first, then spillover workers
+        std::vector<GpuDispatcherState> mStates;
+
+        ImplGpuDispatcher(const int numberGpus, const int numberSpilloverWorkers,
+                          const unsigned long long spilloverQueueSize) :
+            mNumberGpus{(unsigned int)fastMax(1, numberGpus)},
+            mSpilloverQueueSize{spilloverQueueSize},
+            mStates(mNumberGpus + fastMax(0, numberSpilloverWorkers))
+        {
+        }
+    };
+
+    GpuDispatcher::GpuDispatcher(
+        const int numberGpus, const int numberSpilloverWorkers, const unsigned long long spilloverQueueSize) :
+        upImpl{new ImplGpuDispatcher{numberGpus, numberSpilloverWorkers, spilloverQueueSize}}
+    {
+        try
+        {
+            for (auto gpu = 0u ; gpu < upImpl->mStates.size() ; gpu++)
+                upImpl->mStates[gpu].spFrameHistogram = Metrics::getHistogram(
+                    "openpose_gpu_frame_seconds", "gpu=\"" + std::to_string(gpu) + "\"",
+                    "Processing time of each frame in each GPU (or CPU worker) pose thread.", true);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    GpuDispatcher::~GpuDispatcher()
+    {
+        try
+        {
+            opLog("GPU dispatch statistics:\n" + getStatsString(), Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool GpuDispatcher::shouldAccept(const int gpu, const unsigned long long queueSize)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            auto& state = upImpl->mStates.at(gpu);
+            // Spillover worker: Only the frames the GPUs cannot keep up with
+            if ((unsigned int)gpu >= upImpl->mNumberGpus)
+            {
+                const auto accept = (queueSize > upImpl->mSpilloverQueueSize);
+                // Idle with frames waiting, but left to the GPUs
+                const auto deferring = (!accept && queueSize > 0ull);
+                if (deferring && !state.deferring)
+                    state.deferrals++;
+                state.deferring = deferring;
+                return accept;
+            }
+            if (queueSize == 0ull || state.frames < GPU_DISPATCHER_WARMUP_FRAMES)
+                return true;
+            // Number of GPUs that would finish a new frame earlier than this one
+            const auto expectedMs = state.getExpectedMs();
+            auto fasterGpus = 0ull;
+            for (auto otherGpu = 0u ; otherGpu < upImpl->mNumberGpus ; otherGpu++)
+            {
+                const auto& otherState = upImpl->mStates[otherGpu];
+                if ((int)otherGpu != gpu && otherState.frames >= GPU_DISPATCHER_WARMUP_FRAMES
+                    && otherState.getExpectedMs() < GPU_DISPATCHER_MARGIN * expectedMs)
+                    fasterGpus++;
+            }
+            // Enough frames for all the faster GPUs
+            if (fasterGpus < queueSize)
+            {
+                state.deferring = false;
+                return true;
+            }
+            // Left to a faster GPU. If they do not take it by the time this one would have finished it (e.g.,
+            // because they are blocked), it is taken anyway
+            const auto now = std::chrono::high_resolution_clock::now();
+            if (!state.deferring)
+            {
+                state.deferring = true;
+                state.deferringBegin = now;
+                state.deferrals++;
+            }
+            else if (getMilliseconds(state.deferringBegin, now) > expectedMs)
+            {
+                state.deferring = false;
+                return true;
+            }
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    void GpuDispatcher::start(const int gpu, const unsigned int numberFrames)
+    {
+        try
+        {
+            const auto now = std::chrono::high_resolution_clock::now();
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            auto& state = upImpl->mStates.at(gpu);
+            if (!state.started)
+            {
+                state.started = true;
+                state.firstStart = now;
+                state.lastFinish = now;
+            }
+            state.deferring = false;
+            for (auto i = 0u ; i < numberFrames ; i++)
+                state.startTimes.emplace_back(now);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void GpuDispatcher::finish(const int gpu, const unsigned int numberFrames)
+    {
+        try
+        {
+            const auto now = std::chrono::high_resolution_clock::now();
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            auto& state = upImpl->mStates.at(gpu);
+            for (auto i = 0u ; i < numberFrames && !state.startTimes.empty() ; i++)
+            {
+                // Only the time since the previous frame finished, so frames waiting behind others (or stacked in a
+                // batch) are not counted twice
+                const auto begin = fastMax(state.startTimes.front(), state.lastFinish);
+                state.startTimes.pop_front();
+                const auto frameMs = getMilliseconds(begin, now);
+                state.frameMs = (state.frames == 0ull
+                    ? frameMs
+                    : (1. - GPU_DISPATCHER_AVERAGE_WEIGHT) * state.frameMs + GPU_DISPATCHER_AVERAGE_WEIGHT * frameMs);
+                state.frames++;
+                state.lastFinish = now;
+                if (Metrics::isEnabled())
+                    state.spFrameHistogram->record(Metrics::getMicroseconds(begin, now));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<GpuDispatcherStats> GpuDispatcher::getStats() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            std::vector<GpuDispatcherStats> gpuDispatcherStats;
+            for (const auto& state : upImpl->mStates)
+            {
+                const auto elapsedMs = (state.started ? getMilliseconds(state.firstStart, state.lastFinish) : 0.);
+                gpuDispatcherStats.emplace_back(GpuDispatcherStats{
+                    state.frames, state.deferrals, (unsigned int)state.startTimes.size(), state.frameMs,
+                    (elapsedMs > 0. ? 1e3 * state.frames / elapsedMs : 0.)});
+            }
+            return gpuDispatcherStats;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::string GpuDispatcher::getStatsString() const
+    {
+        try
+        {
+            const auto gpuDispatcherStats = getStats();
+            std::stringstream stringStream;
+            stringStream << std::fixed << std::setprecision(2);
+            for (auto gpu = 0u ; gpu < gpuDispatcherStats.size() ; gpu++)
+            {
+                const auto& stats = gpuDispatcherStats[gpu];
+                if (gpu < upImpl->mNumberGpus)
+                    stringStream << "GPU thread " << gpu << ": ";
+                else
+                    stringStream << "Spillover worker " << gpu - upImpl->mNumberGpus << ": ";
+                stringStream << stats.frames << " frames, " << stats.fps << " fps, "
+                    << stats.frameMs << " ms/frame, " << stats.inFlight << " in flight, " << stats.deferrals
+                    << " deferrals." << (gpu + 1 < gpuDispatcherStats.size() ? "\n" : "");
+            }
+            return stringStream.str();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+}
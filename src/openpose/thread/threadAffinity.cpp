@@ -0,0 +1,192 @@
+#include <openpose/thread/threadAffinity.hpp>
+#include <fstream>
+#ifdef _OPENMP
+    #include <omp.h> // omp_set_num_threads
+#endif
+#ifdef USE_MKL
+    #include <mkl.h> // mkl_set_num_threads_local
+#endif
+#ifdef _WIN32
+    #include <windows.h> // SetThreadAffinityMask, SetThreadPriority, GetNumaNodeProcessorMaskEx
+#elif defined __linux__
+    #include <pthread.h> // pthread_setaffinity_np, pthread_setschedparam
+    #include <sched.h> // cpu_set_t, SCHED_FIFO
+    #include <unistd.h> // syscall
+    #include <linux/mempolicy.h> // MPOL_PREFERRED
+    #include <sys/resource.h> // setpriority
+    #include <sys/syscall.h> // SYS_gettid, SYS_set_mempolicy
+#endif
+
+namespace op
+{
+    // Linux nice values of ThreadPriority::Low and ThreadPriority::High
+    const auto THREAD_NICE_LOW = 10;
+    const auto THREAD_NICE_HIGH = -10;
+
+    ThreadAffinity::ThreadAffinity(
+        const std::vector<int>& cpuIds_, const int numaNode_, const ThreadPriority priority_,
+        const int computeThreads_) :
+        cpuIds{cpuIds_},
+        numaNode{numaNode_},
+        priority{priority_},
+        computeThreads{computeThreads_}
+    {
+    }
+
+    bool ThreadAffinity::isDefault() const
+    {
+        return cpuIds.empty() && numaNode < 0 && priority == ThreadPriority::Default && computeThreads <= 0;
+    }
+
+    void setThreadCpuIds(const std::vector<int>& cpuIds)
+    {
+        #ifdef _WIN32
+            DWORD_PTR mask = 0;
+            for (const auto cpuId : cpuIds)
+                if (cpuId >= 0 && cpuId < (int)(8*sizeof(DWORD_PTR)))
+                    mask |= ((DWORD_PTR)1 << cpuId);
+            if (mask == 0 || SetThreadAffinityMask(GetCurrentThread(), mask) == 0)
+                opLog("Warning: The thread CPU affinity could not be set.", Priority::High);
+        #elif defined __linux__
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+            for (const auto cpuId : cpuIds)
+                if (cpuId >= 0 && cpuId < CPU_SETSIZE)
+                    CPU_SET(cpuId, &cpuSet);
+            if (CPU_COUNT(&cpuSet) == 0 || pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) != 0)
+                opLog("Warning: The thread CPU affinity could not be set.", Priority::High);
+        #else
+            UNUSED(cpuIds);
+            opLog("Warning: The thread CPU affinity is not supported in this operating system.", Priority::High);
+        #endif
+    }
+
+    void setThreadNumaMemory(const int numaNode)
+    {
+        #ifdef __linux__
+            // Preferred (rather than bound) policy, so allocations fall back to other nodes if this one is full
+            const auto bitsPerLong = 8*sizeof(unsigned long);
+            std::vector<unsigned long> nodeMask(numaNode / bitsPerLong + 1, 0ul);
+            nodeMask[numaNode / bitsPerLong] = 1ul << (numaNode % bitsPerLong);
+            if (syscall(SYS_set_mempolicy, MPOL_PREFERRED, nodeMask.data(), nodeMask.size() * bitsPerLong + 1) != 0)
+                opLog("Warning: The thread NUMA memory policy could not be set.", Priority::High);
+        #else
+            // Other OSs allocate from the node of the CPU running the thread by default
+            UNUSED(numaNode);
+        #endif
+    }
+
+    void setThreadPriority(const ThreadPriority threadPriority)
+    {
+        #ifdef _WIN32
+            const auto windowsPriority = (threadPriority == ThreadPriority::Low ? THREAD_PRIORITY_BELOW_NORMAL
+                : (threadPriority == ThreadPriority::High ? THREAD_PRIORITY_ABOVE_NORMAL
+                   : THREAD_PRIORITY_TIME_CRITICAL));
+            if (SetThreadPriority(GetCurrentThread(), windowsPriority) == 0)
+                opLog("Warning: The thread priority could not be set.", Priority::High);
+        #elif defined __linux__
+            if (threadPriority == ThreadPriority::RealTime)
+            {
+                sched_param schedParam{};
+                schedParam.sched_priority = sched_get_priority_min(SCHED_FIFO);
+                if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &schedParam) != 0)
+                    opLog("Warning: The real-time thread priority could not be set (it requires CAP_SYS_NICE).",
+                          Priority::High);
+            }
+            // Linux applies the nice value per thread (given its thread id)
+            else if (setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid),
+                                 (threadPriority == ThreadPriority::Low ? THREAD_NICE_LOW : THREAD_NICE_HIGH)) != 0)
+                opLog("Warning: The thread priority could not be set (higher priorities require CAP_SYS_NICE).",
+                      Priority::High);
+        #else
+            UNUSED(threadPriority);
+            opLog("Warning: The thread priority is not supported in this operating system.", Priority::High);
+        #endif
+    }
+
+    void setThreadComputeThreads(const int computeThreads)
+    {
+        // Both settings only affect the calling thread (and the parallel regions it opens)
+        #if defined _OPENMP || defined USE_MKL
+            #ifdef _OPENMP
+                omp_set_num_threads(computeThreads);
+            #endif
+            #ifdef USE_MKL
+                mkl_set_num_threads_local(computeThreads);
+            #endif
+        #else
+            UNUSED(computeThreads);
+            opLog("Warning: The number of compute threads can only be limited if OpenPose is compiled with OpenMP or"
+                  " MKL.", Priority::High);
+        #endif
+    }
+
+    void setThreadAffinity(const ThreadAffinity& threadAffinity)
+    {
+        try
+        {
+            // CPU cores (explicit ones or the ones of the NUMA node)
+            if (!threadAffinity.cpuIds.empty())
+                setThreadCpuIds(threadAffinity.cpuIds);
+            else if (threadAffinity.numaNode >= 0)
+            {
+                const auto numaNodeCpuIds = getNumaNodeCpuIds(threadAffinity.numaNode);
+                if (!numaNodeCpuIds.empty())
+                    setThreadCpuIds(numaNodeCpuIds);
+                else
+                    opLog("Warning: The CPUs of the NUMA node " + std::to_string(threadAffinity.numaNode)
+                          + " are unknown, so the thread is not bound to it.", Priority::High);
+            }
+            // Host memory
+            if (threadAffinity.numaNode >= 0)
+                setThreadNumaMemory(threadAffinity.numaNode);
+            // Priority
+            if (threadAffinity.priority != ThreadPriority::Default)
+                setThreadPriority(threadAffinity.priority);
+            // Compute threads
+            if (threadAffinity.computeThreads > 0)
+                setThreadComputeThreads(threadAffinity.computeThreads);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<int> getNumaNodeCpuIds(const int numaNode)
+    {
+        try
+        {
+            std::vector<int> cpuIds;
+            #ifdef _WIN32
+                GROUP_AFFINITY groupAffinity{};
+                if (numaNode >= 0 && GetNumaNodeProcessorMaskEx((USHORT)numaNode, &groupAffinity) != 0
+                    && groupAffinity.Group == 0)
+                {
+                    for (auto cpuId = 0 ; cpuId < (int)(8*sizeof(KAFFINITY)) ; cpuId++)
+                        if (groupAffinity.Mask & ((KAFFINITY)1 << cpuId))
+                            cpuIds.emplace_back(cpuId);
+                }
+            #else
+                // Linux sysfs format, e.g., `0-15,32-47`
+                std::ifstream cpuListFile{
+                    "/sys/devices/system/node/node" + std::to_string(numaNode) + "/cpulist"};
+                std::string cpuRange;
+                while (numaNode >= 0 && std::getline(cpuListFile, cpuRange, ','))
+                {
+                    const auto dash = cpuRange.find('-');
+                    const auto first = std::stoi(cpuRange.substr(0, dash));
+                    const auto last = (dash == std::string::npos ? first : std::stoi(cpuRange.substr(dash+1)));
+                    for (auto cpuId = first ; cpuId <= last ; cpuId++)
+                        cpuIds.emplace_back(cpuId);
+                }
+            #endif
+            return cpuIds;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+}
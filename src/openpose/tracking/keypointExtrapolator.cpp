@@ -0,0 +1,240 @@
+#include <openpose/tracking/keypointExtrapolator.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <openpose/core/arrayView.hpp>
+
+namespace op
+{
+    // Initial variance of the velocity of a new keypoint (in squared pixels per frame), i.e., unknown
+    const auto KEYPOINT_EXTRAPOLATOR_VELOCITY_VARIANCE = 100.f;
+    // Maximum time that a frame waits for the previous one (e.g., in case the previous one was dropped)
+    const auto KEYPOINT_EXTRAPOLATOR_MAX_WAIT = std::chrono::seconds{1};
+
+    // Constant-velocity Kalman filter of a keypoint. Both coordinates are independent and have the same noise, so
+    // they share the same covariance matrix [a b; b c]
+    struct KeypointFilter
+    {
+        bool valid;
+        float x;
+        float y;
+        float vx;
+        float vy;
+        float a;
+        float b;
+        float c;
+        float score;
+
+        KeypointFilter() :
+            valid{false}
+        {
+        }
+
+        void initialize(const float xMeasured, const float yMeasured, const float scoreMeasured,
+                        const float measurementNoise)
+        {
+            valid = true;
+            x = xMeasured;
+            y = yMeasured;
+            vx = 0.f;
+            vy = 0.f;
+            a = measurementNoise;
+            b = 0.f;
+            c = KEYPOINT_EXTRAPOLATOR_VELOCITY_VARIANCE;
+            score = scoreMeasured;
+        }
+
+        // 1 frame, with a white noise acceleration of variance processNoise
+        void predict(const float processNoise)
+        {
+            x += vx;
+            y += vy;
+            a += 2.f*b + c + 0.25f*processNoise;
+            b += c + 0.5f*processNoise;
+            c += processNoise;
+        }
+
+        void update(const float xMeasured, const float yMeasured, const float scoreMeasured,
+                    const float measurementNoise)
+        {
+            const auto s = a + measurementNoise;
+            const auto kPosition = a / s;
+            const auto kVelocity = b / s;
+            const auto xResidual = xMeasured - x;
+            const auto yResidual = yMeasured - y;
+            x += kPosition * xResidual;
+            y += kPosition * yResidual;
+            vx += kVelocity * xResidual;
+            vy += kVelocity * yResidual;
+            c -= kVelocity * b;
+            a *= (1.f - kPosition);
+            b *= (1.f - kPosition);
+            score = scoreMeasured;
+        }
+    };
+
+    struct KeypointExtrapolator::ImplKeypointExtrapolator
+    {
+        const float mConfidenceThreshold;
+        const float mProcessNoise;
+        const float mMeasurementNoise;
+        // Person ID --> filter of each keypoint
+        std::map<long long, std::vector<KeypointFilter>> mPeople;
+        // Person IDs in the order of the last keyframe
+        std::vector<long long> mLastPoseIds;
+        bool mHasIds;
+        int mNumberBodyParts;
+
+        // Thread-safe variables
+        std::mutex mMutex;
+        std::condition_variable mConditionVariable;
+        long long mLastFrameId;
+
+        ImplKeypointExtrapolator(
+            const float confidenceThreshold, const float processNoise, const float measurementNoise) :
+            mConfidenceThreshold{confidenceThreshold},
+            mProcessNoise{processNoise},
+            mMeasurementNoise{measurementNoise},
+            mHasIds{false},
+            mNumberBodyParts{0},
+            mLastFrameId{-1ll}
+        {
+        }
+    };
+
+    KeypointExtrapolator::KeypointExtrapolator(
+        const float confidenceThreshold, const float processNoise, const float measurementNoise) :
+        upImpl{new ImplKeypointExtrapolator{confidenceThreshold, processNoise, measurementNoise}}
+    {
+        try
+        {
+            if (processNoise <= 0.f || measurementNoise <= 0.f)
+                error("The process and measurement noises must be positive.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    KeypointExtrapolator::~KeypointExtrapolator()
+    {
+    }
+
+    void KeypointExtrapolator::track(Array<float>& poseKeypoints, Array<long long>& poseIds, const bool isKeyframe)
+    {
+        try
+        {
+            // Predict all the keypoints into this frame
+            for (auto& person : upImpl->mPeople)
+                for (auto& keypointFilter : person.second)
+                    if (keypointFilter.valid)
+                        keypointFilter.predict(upImpl->mProcessNoise);
+            // Keyframe: Update filters with the detected keypoints (the detected keypoints are not modified)
+            if (isKeyframe)
+            {
+                const auto numberPeople = (poseKeypoints.empty() ? 0 : poseKeypoints.getSize(0));
+                if (numberPeople > 0 && !poseIds.empty() && poseIds.getVolume() != (size_t)numberPeople)
+                    error("poseKeypoints and poseIds should have the same number of people.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                // Without person identification, the IDs are empty or -1
+                upImpl->mHasIds = !poseIds.empty();
+                for (auto person = 0u ; person < poseIds.getVolume() && upImpl->mHasIds ; person++)
+                    upImpl->mHasIds = (poseIds[person] >= 0);
+                upImpl->mNumberBodyParts = (numberPeople > 0 ? poseKeypoints.getSize(1) : 0);
+                std::map<long long, std::vector<KeypointFilter>> people;
+                const ArrayView3<const float> keypointsView{poseKeypoints};
+                upImpl->mLastPoseIds.clear();
+                for (auto person = 0 ; person < numberPeople ; person++)
+                {
+                    const auto id = (upImpl->mHasIds ? poseIds[person] : (long long)person);
+                    upImpl->mLastPoseIds.emplace_back(id);
+                    // Existing person (its filters are moved), or new one
+                    auto& keypointFilters = people[id];
+                    const auto previousPerson = upImpl->mPeople.find(id);
+                    if (previousPerson != upImpl->mPeople.end())
+                        keypointFilters.swap(previousPerson->second);
+                    keypointFilters.resize(upImpl->mNumberBodyParts);
+                    for (auto part = 0 ; part < upImpl->mNumberBodyParts ; part++)
+                    {
+                        const auto* const keypointPtr = keypointsView.getPtr(person, part);
+                        auto& keypointFilter = keypointFilters[part];
+                        if (keypointPtr[2] < upImpl->mConfidenceThreshold)
+                            keypointFilter.valid = false;
+                        else if (keypointFilter.valid)
+                            keypointFilter.update(
+                                keypointPtr[0], keypointPtr[1], keypointPtr[2], upImpl->mMeasurementNoise);
+                        else
+                            keypointFilter.initialize(
+                                keypointPtr[0], keypointPtr[1], keypointPtr[2], upImpl->mMeasurementNoise);
+                    }
+                }
+                // People not detected anymore are removed
+                upImpl->mPeople.swap(people);
+            }
+            // Any other frame: Predicted keypoints
+            else
+            {
+                if (upImpl->mLastPoseIds.empty())
+                {
+                    poseKeypoints.reset();
+                    poseIds.reset();
+                }
+                else
+                {
+                    const auto numberPeople = (int)upImpl->mLastPoseIds.size();
+                    poseKeypoints.reset({numberPeople, upImpl->mNumberBodyParts, 3}, 0.f);
+                    const ArrayView3<float> keypointsView{poseKeypoints};
+                    for (auto person = 0 ; person < numberPeople ; person++)
+                    {
+                        const auto& keypointFilters = upImpl->mPeople.at(upImpl->mLastPoseIds[person]);
+                        for (auto part = 0 ; part < upImpl->mNumberBodyParts ; part++)
+                        {
+                            const auto& keypointFilter = keypointFilters[part];
+                            if (keypointFilter.valid)
+                            {
+                                auto* const keypointPtr = keypointsView.getPtr(person, part);
+                                keypointPtr[0] = keypointFilter.x;
+                                keypointPtr[1] = keypointFilter.y;
+                                keypointPtr[2] = keypointFilter.score;
+                            }
+                        }
+                    }
+                    poseIds.reset(numberPeople, -1ll);
+                    if (upImpl->mHasIds)
+                        for (auto person = 0 ; person < numberPeople ; person++)
+                            poseIds[person] = upImpl->mLastPoseIds[person];
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void KeypointExtrapolator::trackLockThread(
+        Array<float>& poseKeypoints, Array<long long>& poseIds, const bool isKeyframe, const long long frameId)
+    {
+        try
+        {
+            // Wait for desired order
+            std::unique_lock<std::mutex> lock{upImpl->mMutex};
+            upImpl->mConditionVariable.wait_for(
+                lock, KEYPOINT_EXTRAPOLATOR_MAX_WAIT,
+                [&]{ return upImpl->mLastFrameId < 0 || upImpl->mLastFrameId >= frameId - 1; });
+            // Extrapolate keypoints
+            track(poseKeypoints, poseIds, isKeyframe);
+            // Update last frame id
+            if (upImpl->mLastFrameId < frameId)
+                upImpl->mLastFrameId = frameId;
+            lock.unlock();
+            upImpl->mConditionVariable.notify_all();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -1,8 +1,12 @@
 #include <openpose/tracking/personIdExtractor.hpp>
+#include <algorithm> // std::copy, std::sort
 #include <atomic>
+#include <limits> // std::numeric_limits
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
+#include <opencv2/imgproc/imgproc.hpp> // cv::cvtColor
+#include <openpose/core/arrayView.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose_private/tracking/pyramidalLK.hpp>
 
@@ -47,7 +51,8 @@ namespace op
         try
         {
             // Define result
-            std::vector<PersonEntry> personEntries(poseKeypoints.getSize(0));
+            const ArrayView3<const float> keypointsView{poseKeypoints};
+            std::vector<PersonEntry> personEntries(keypointsView.getSize(0));
             // Fill personEntries
             for (auto p = 0; p < (int)personEntries.size(); p++)
             {
@@ -57,14 +62,12 @@ namespace op
                 auto& status = personEntry.status;
                 personEntry.counterLastDetection = 0;
 
-                for (auto kp = 0; kp < poseKeypoints.getSize(1); kp++)
+                for (auto kp = 0; kp < keypointsView.getSize(1); kp++)
                 {
-                    cv::Point2f cp;
-                    cp.x = poseKeypoints[{p,kp,0}];
-                    cp.y = poseKeypoints[{p,kp,1}];
-                    keypoints.emplace_back(cp);
+                    const auto* const keypointPtr = keypointsView.getPtr(p, kp);
+                    keypoints.emplace_back(cv::Point2f{keypointPtr[0], keypointPtr[1]});
 
-                    if (poseKeypoints[{p,kp,2}] < confidenceThreshold)
+                    if (keypointPtr[2] < confidenceThreshold)
                         status.emplace_back(char(1));
                     else
                         status.emplace_back(char(0));
@@ -80,6 +83,26 @@ namespace op
         }
     }
 
+    // pyramidalLKCpu works on a single (gray) floating point channel
+    void getGrayFloatImage(cv::Mat& grayFloatImage, const cv::Mat& image)
+    {
+        try
+        {
+            if (image.channels() == 3)
+            {
+                cv::Mat grayImage;
+                cv::cvtColor(image, grayImage, cv::COLOR_BGR2GRAY);
+                grayImage.convertTo(grayFloatImage, CV_32F);
+            }
+            else
+                image.convertTo(grayFloatImage, CV_32F);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     void updateLK(std::unordered_map<int,PersonEntry>& personEntries, std::vector<cv::Mat>& pyramidImagesPrevious,
                   std::vector<cv::Mat>& pyramidImagesCurrent, const cv::Mat& imagePrevious,
                   const cv::Mat& imageCurrent, const int numberFramesToDeletePerson)
@@ -125,6 +148,52 @@ namespace op
         }
     }
 
+    #ifdef USE_CUDA
+        void updateLKGpu(std::unordered_map<int,PersonEntry>& personEntries, const PyramidGpu& pyramidPrevious,
+                         const PyramidGpu& pyramidCurrent, const int numberFramesToDeletePerson)
+        {
+            try
+            {
+                // Remove old people
+                std::vector<int> keyValues;
+                keyValues.reserve(personEntries.size());
+                for (const auto& entry : personEntries)
+                    keyValues.emplace_back(entry.first);
+                for (auto& key : keyValues)
+                    if (personEntries[key].counterLastDetection++ > numberFramesToDeletePerson)
+                        personEntries.erase(key);
+                // Concatenate the keypoints of all the people, and track all of them at once
+                std::vector<cv::Point2f> keypointsPrevious;
+                std::vector<char> status;
+                for (const auto& entry : personEntries)
+                {
+                    const auto& element = entry.second;
+                    keypointsPrevious.insert(keypointsPrevious.end(), element.keypoints.begin(),
+                                             element.keypoints.end());
+                    status.insert(status.end(), element.status.begin(), element.status.end());
+                }
+                std::vector<cv::Point2f> keypointsCurrent;
+                pyramidalLKGpu(keypointsPrevious, keypointsCurrent, status, pyramidPrevious, pyramidCurrent, 21);
+                // Split them back into people (same iteration order)
+                auto offset = 0u;
+                for (auto& entry : personEntries)
+                {
+                    auto& element = entry.second;
+                    const auto numberKeypoints = element.keypoints.size();
+                    std::copy(keypointsCurrent.begin() + offset, keypointsCurrent.begin() + offset + numberKeypoints,
+                              element.keypoints.begin());
+                    std::copy(status.begin() + offset, status.begin() + offset + numberKeypoints,
+                              element.status.begin());
+                    offset += (unsigned int)numberKeypoints;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+    #endif
+
     void initializeLK(std::unordered_map<int,PersonEntry>& personEntries,
                       long long& mNextPersonId,
                       const Array<float>& poseKeypoints,
@@ -132,7 +201,8 @@ namespace op
     {
         try
         {
-            for (auto p = 0; p < poseKeypoints.getSize(0); p++)
+            const ArrayView3<const float> keypointsView{poseKeypoints};
+            for (auto p = 0; p < keypointsView.getSize(0); p++)
             {
                 const auto currentPerson = int(mNextPersonId++);
 
@@ -142,12 +212,12 @@ namespace op
                 auto& status = personEntry.status;
                 personEntry.counterLastDetection = 0;
 
-                for (auto kp = 0; kp < poseKeypoints.getSize(1); kp++)
+                for (auto kp = 0; kp < keypointsView.getSize(1); kp++)
                 {
-                    const cv::Point2f cp{poseKeypoints[{p,kp,0}], poseKeypoints[{p,kp,1}]};
-                    keypoints.emplace_back(cp);
+                    const auto* const keypointPtr = keypointsView.getPtr(p, kp);
+                    keypoints.emplace_back(cv::Point2f{keypointPtr[0], keypointPtr[1]});
 
-                    if (poseKeypoints[{p,kp,2}] < confidenceThreshold)
+                    if (keypointPtr[2] < confidenceThreshold)
                         status.emplace_back(char(1));
                     else
                         status.emplace_back(char(0));
@@ -168,7 +238,7 @@ namespace op
     Array<long long> matchLKAndOPGreedy(std::unordered_map<int,PersonEntry>& personEntries,
                                         long long& nextPersonId,
                                         const std::vector<PersonEntry>& openposePersonEntries,
-                                        const cv::Mat& imagePrevious,
+                                        const cv::Size& imageSize,
                                         const float inlierRatioThreshold,
                                         const float distanceThreshold)
     {
@@ -194,7 +264,7 @@ namespace op
 
                     const auto& openposePersonEntry = openposePersonEntries.at(i);
                     const auto personDistanceThreshold = fastMax(10.f,
-                        distanceThreshold*float(std::sqrt(imagePrevious.cols*imagePrevious.rows)) / 960.f);
+                        distanceThreshold*float(std::sqrt(imageSize.area())) / 960.f);
 
                     // Find best correspondance in the LK set
                     for (const auto& personEntry : personEntries)
@@ -290,6 +360,322 @@ namespace op
     }
 
 
+    // Bounding box of the keypoints with status 0. It returns false if there is none
+    bool getActiveKeypointsRectangle(cv::Rect_<float>& rectangle, const PersonEntry& personEntry)
+    {
+        try
+        {
+            auto minX = std::numeric_limits<float>::max();
+            auto minY = std::numeric_limits<float>::max();
+            auto maxX = std::numeric_limits<float>::lowest();
+            auto maxY = std::numeric_limits<float>::lowest();
+            for (auto kp = 0u; kp < personEntry.keypoints.size(); kp++)
+            {
+                if (!personEntry.status[kp])
+                {
+                    const auto& keypoint = personEntry.keypoints[kp];
+                    minX = fastMin(minX, keypoint.x);
+                    minY = fastMin(minY, keypoint.y);
+                    maxX = fastMax(maxX, keypoint.x);
+                    maxY = fastMax(maxY, keypoint.y);
+                }
+            }
+            if (maxX < minX)
+                return false;
+            rectangle = cv::Rect_<float>{minX, minY, maxX - minX, maxY - minY};
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    // Minimum cost assignment (Hungarian algorithm, O(rows^2 x cols)) of the rows x cols matrix costs (row-major,
+    // with rows <= cols). It returns the column assigned to each row.
+    std::vector<int> solveAssignment(const std::vector<double>& costs, const int rows, const int cols)
+    {
+        try
+        {
+            // Potentials, column matches (1-based, p[j] = row of column j) and augmenting path
+            std::vector<double> u(rows+1, 0.), v(cols+1, 0.), minV(cols+1);
+            std::vector<int> p(cols+1, 0), way(cols+1, 0);
+            std::vector<char> used(cols+1);
+            for (auto i = 1; i <= rows; i++)
+            {
+                p[0] = i;
+                auto j0 = 0;
+                std::fill(minV.begin(), minV.end(), std::numeric_limits<double>::max());
+                std::fill(used.begin(), used.end(), char(0));
+                do
+                {
+                    used[j0] = 1;
+                    const auto i0 = p[j0];
+                    auto delta = std::numeric_limits<double>::max();
+                    auto j1 = 0;
+                    for (auto j = 1; j <= cols; j++)
+                    {
+                        if (!used[j])
+                        {
+                            const auto current = costs[(i0-1)*cols + j-1] - u[i0] - v[j];
+                            if (current < minV[j])
+                            {
+                                minV[j] = current;
+                                way[j] = j0;
+                            }
+                            if (minV[j] < delta)
+                            {
+                                delta = minV[j];
+                                j1 = j;
+                            }
+                        }
+                    }
+                    for (auto j = 0; j <= cols; j++)
+                    {
+                        if (used[j])
+                        {
+                            u[p[j]] += delta;
+                            v[j] -= delta;
+                        }
+                        else
+                            minV[j] -= delta;
+                    }
+                    j0 = j1;
+                } while (p[j0] != 0);
+                do
+                {
+                    const auto j1 = way[j0];
+                    p[j0] = p[j1];
+                    j0 = j1;
+                } while (j0 != 0);
+            }
+            std::vector<int> assignment(rows, -1);
+            for (auto j = 1; j <= cols; j++)
+                if (p[j] != 0)
+                    assignment[p[j]-1] = j-1;
+            return assignment;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    int findRoot(std::vector<int>& parents, int node)
+    {
+        while (parents[node] != node)
+            node = parents[node] = parents[parents[node]];
+        return node;
+    }
+
+    // Same criteria than matchLKAndOPGreedy (inlier ratio and distance), but:
+    // 1. The candidate pairs are found with a uniform grid of the bounding boxes of the tracked people (a pair can
+    //    only have inliers if their boxes are closer than the distance threshold), rather than comparing every
+    //    OpenPose person against every tracked one.
+    // 2. The IDs are then assigned with the Hungarian algorithm (maximum number of matches, and highest inlier ratio
+    //    among them), run independently on each connected component of the candidate graph, so each run is bounded
+    //    by the number of people close to each other rather than by the total number of people.
+    Array<long long> matchLKAndOPAssignment(std::unordered_map<int,PersonEntry>& personEntries,
+                                            long long& nextPersonId,
+                                            const std::vector<PersonEntry>& openposePersonEntries,
+                                            const cv::Size& imageSize,
+                                            const float inlierRatioThreshold,
+                                            const float distanceThreshold)
+    {
+        try
+        {
+            const auto numberPeople = (int)openposePersonEntries.size();
+            Array<long long> poseIds{numberPeople, -1};
+            if (numberPeople > 0 && !personEntries.empty())
+            {
+                const auto numberKeypoints = openposePersonEntries[0].keypoints.size();
+                const auto personDistanceThreshold = fastMax(10.f,
+                    distanceThreshold*float(std::sqrt(imageSize.area())) / 960.f);
+                // Tracked people and their bounding boxes
+                std::vector<int> trackedIds;
+                std::vector<const PersonEntry*> trackedEntries;
+                std::vector<cv::Rect_<float>> trackedRectangles;
+                trackedIds.reserve(personEntries.size());
+                trackedEntries.reserve(personEntries.size());
+                trackedRectangles.reserve(personEntries.size());
+                for (const auto& personEntry : personEntries)
+                {
+                    // Sanity checks
+                    if (personEntry.second.status.size() != numberKeypoints
+                        || personEntry.second.keypoints.size() != numberKeypoints)
+                        error("personEntry.keypoints/status.size() != numberKeypoints.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    cv::Rect_<float> rectangle;
+                    if (getActiveKeypointsRectangle(rectangle, personEntry.second))
+                    {
+                        trackedIds.emplace_back(personEntry.first);
+                        trackedEntries.emplace_back(&personEntry.second);
+                        trackedRectangles.emplace_back(rectangle);
+                    }
+                }
+                const auto numberTracked = (int)trackedIds.size();
+                // Uniform grid with the tracked bounding boxes (enlarged by the distance threshold)
+                const auto cellSize = fastMax(4.f * personDistanceThreshold, 32.f);
+                const auto gridWidth = fastMax(1, positiveIntRound(imageSize.width / cellSize) + 1);
+                const auto gridHeight = fastMax(1, positiveIntRound(imageSize.height / cellSize) + 1);
+                const auto getCell = [&](const float coordinate, const int gridSize)
+                {
+                    return fastTruncate(int(std::floor(coordinate / cellSize)), 0, gridSize - 1);
+                };
+                std::vector<std::vector<int>> grid(gridWidth * gridHeight);
+                for (auto t = 0; t < numberTracked; t++)
+                {
+                    const auto& rectangle = trackedRectangles[t];
+                    const auto xBegin = getCell(rectangle.x - personDistanceThreshold, gridWidth);
+                    const auto xEnd = getCell(rectangle.x + rectangle.width + personDistanceThreshold, gridWidth);
+                    const auto yBegin = getCell(rectangle.y - personDistanceThreshold, gridHeight);
+                    const auto yEnd = getCell(rectangle.y + rectangle.height + personDistanceThreshold, gridHeight);
+                    for (auto y = yBegin; y <= yEnd; y++)
+                        for (auto x = xBegin; x <= xEnd; x++)
+                            grid[y*gridWidth + x].emplace_back(t);
+                }
+                // Candidate pairs (OpenPose person, tracked person) and their costs
+                struct Candidate
+                {
+                    int person;
+                    int tracked;
+                    double cost;
+                };
+                std::vector<Candidate> candidates;
+                std::vector<int> lastVisited(numberTracked, -1);
+                for (auto i = 0; i < numberPeople; i++)
+                {
+                    const auto& openposePersonEntry = openposePersonEntries[i];
+                    if (openposePersonEntry.status.size() != numberKeypoints
+                        || openposePersonEntry.keypoints.size() != numberKeypoints)
+                        error("openposePersonEntry.keypoints/status.size() != numberKeypoints.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    cv::Rect_<float> rectangle;
+                    if (!getActiveKeypointsRectangle(rectangle, openposePersonEntry))
+                        continue;
+                    const auto xBegin = getCell(rectangle.x, gridWidth);
+                    const auto xEnd = getCell(rectangle.x + rectangle.width, gridWidth);
+                    const auto yBegin = getCell(rectangle.y, gridHeight);
+                    const auto yEnd = getCell(rectangle.y + rectangle.height, gridHeight);
+                    for (auto y = yBegin; y <= yEnd; y++)
+                    {
+                        for (auto x = xBegin; x <= xEnd; x++)
+                        {
+                            for (const auto t : grid[y*gridWidth + x])
+                            {
+                                if (lastVisited[t] == i)
+                                    continue;
+                                lastVisited[t] = i;
+                                // Exact test on the enlarged boxes
+                                const auto& trackedRectangle = trackedRectangles[t];
+                                if (rectangle.x > trackedRectangle.x + trackedRectangle.width + personDistanceThreshold
+                                    || trackedRectangle.x > rectangle.x + rectangle.width + personDistanceThreshold
+                                    || rectangle.y > trackedRectangle.y + trackedRectangle.height
+                                                     + personDistanceThreshold
+                                    || trackedRectangle.y > rectangle.y + rectangle.height + personDistanceThreshold)
+                                    continue;
+                                // Inlier ratio (same as matchLKAndOPGreedy)
+                                const auto& element = *trackedEntries[t];
+                                auto inliers = 0;
+                                auto active = 0;
+                                auto totalDistance = 0.f;
+                                for (auto kp = 0u; kp < numberKeypoints; kp++)
+                                {
+                                    if (!element.status[kp] && !openposePersonEntry.status[kp])
+                                    {
+                                        active++;
+                                        const auto distance = getEuclideanDistance(
+                                            element.keypoints[kp], openposePersonEntry.keypoints[kp]);
+                                        totalDistance += distance;
+                                        if (distance < personDistanceThreshold)
+                                            inliers++;
+                                    }
+                                }
+                                if (active > 0)
+                                {
+                                    const auto score = inliers / (float)active;
+                                    // Highest score first, and lowest average distance to break ties
+                                    if (score >= inlierRatioThreshold)
+                                        candidates.emplace_back(Candidate{i, t, 1. - score + 1e-3 * fastMin(
+                                            1., totalDistance / (10. * active * personDistanceThreshold))});
+                                }
+                            }
+                        }
+                    }
+                }
+                // Connected components of the candidate graph (nodes: people, then tracked people)
+                std::vector<int> parents(numberPeople + numberTracked);
+                for (auto node = 0u; node < parents.size(); node++)
+                    parents[node] = node;
+                for (const auto& candidate : candidates)
+                    parents[findRoot(parents, candidate.person)] = findRoot(parents, numberPeople + candidate.tracked);
+                std::unordered_map<int, std::vector<int>> components;
+                for (auto c = 0u; c < candidates.size(); c++)
+                    components[findRoot(parents, candidates[c].person)].emplace_back(c);
+                // Assignment of each component
+                // Forbidden pairs cost more than any set of valid ones, so the number of matches is maximized first
+                std::vector<int> rowIndexes(numberPeople + numberTracked, -1);
+                for (const auto& component : components)
+                {
+                    std::vector<int> people;
+                    std::vector<int> tracked;
+                    for (const auto c : component.second)
+                    {
+                        const auto& candidate = candidates[c];
+                        if (rowIndexes[candidate.person] < 0)
+                        {
+                            rowIndexes[candidate.person] = (int)people.size();
+                            people.emplace_back(candidate.person);
+                        }
+                        if (rowIndexes[numberPeople + candidate.tracked] < 0)
+                        {
+                            rowIndexes[numberPeople + candidate.tracked] = (int)tracked.size();
+                            tracked.emplace_back(candidate.tracked);
+                        }
+                    }
+                    // Rows = smallest side
+                    const auto transposed = people.size() > tracked.size();
+                    const auto rows = (int)(transposed ? tracked.size() : people.size());
+                    const auto cols = (int)(transposed ? people.size() : tracked.size());
+                    const auto forbiddenCost = 2. * (rows + 1);
+                    std::vector<double> costs(rows * cols, forbiddenCost);
+                    for (const auto c : component.second)
+                    {
+                        const auto& candidate = candidates[c];
+                        const auto row = rowIndexes[candidate.person];
+                        const auto col = rowIndexes[numberPeople + candidate.tracked];
+                        costs[transposed ? col*cols + row : row*cols + col] = candidate.cost;
+                    }
+                    const auto assignment = solveAssignment(costs, rows, cols);
+                    for (auto row = 0; row < rows; row++)
+                    {
+                        const auto col = assignment[row];
+                        if (col >= 0 && costs[row*cols + col] < forbiddenCost)
+                        {
+                            const auto person = people[transposed ? col : row];
+                            const auto t = tracked[transposed ? row : col];
+                            poseIds[person] = trackedIds[t];
+                        }
+                    }
+                }
+            }
+            for (auto i = 0; i < numberPeople; i++)
+            {
+                if (poseIds[i] == -1)
+                    poseIds[i] = nextPersonId++;
+                personEntries[(int)poseIds[i]] = openposePersonEntries[i];
+            }
+            return poseIds;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<long long>{};
+        }
+    }
+
     // Array<long long> matchLKAndOP(std::unordered_map<int,PersonEntry>& personEntries,
     //                               long long& nextPersonId,
     //                               const std::vector<PersonEntry>& openposePersonEntries,
@@ -387,8 +773,14 @@ namespace op
         const float mDistanceThreshold;
         const int mNumberFramesToDeletePerson;
         long long mNextPersonId;
-        cv::Mat mImagePrevious;
-        std::vector<cv::Mat> mPyramidImagesPrevious;
+        #ifdef USE_CUDA
+            // Previous and current frames (swapped after each frame)
+            std::unique_ptr<PyramidGpu> upPyramidGpuPrevious;
+            std::unique_ptr<PyramidGpu> upPyramidGpuCurrent;
+        #else
+            cv::Mat mImagePrevious;
+            std::vector<cv::Mat> mPyramidImagesPrevious;
+        #endif
         std::unordered_map<int, PersonEntry> mPersonEntries;
         // Thread-safe variables
         std::atomic<long long> mLastFrameId;
@@ -401,6 +793,10 @@ namespace op
             mDistanceThreshold{distanceThreshold},
             mNumberFramesToDeletePerson{numberFramesToDeletePerson},
             mNextPersonId{0ll},
+            #ifdef USE_CUDA
+                upPyramidGpuPrevious{new PyramidGpu{}},
+                upPyramidGpuCurrent{new PyramidGpu{}},
+            #endif
             mLastFrameId{-1ll}
         {
         }
@@ -439,32 +835,55 @@ namespace op
             Array<long long> poseIds;
             const auto openposePersonEntries = captureKeypoints(poseKeypoints, spImpl->mConfidenceThreshold);
 
-            // First frame
             const cv::Mat cvMatcvMatInput = OP_OP2CVCONSTMAT(cvMatInput);
-            if (spImpl->mImagePrevious.empty())
-            {
-                // Add first persons to the LK set
-                initializeLK(spImpl->mPersonEntries, spImpl->mNextPersonId, poseKeypoints, spImpl->mConfidenceThreshold);
-                // Capture current frame as floating point
-                cvMatcvMatInput.convertTo(spImpl->mImagePrevious, CV_32F);
-            }
-            // Rest
-            else
-            {
-                cv::Mat imageCurrent;
-                std::vector<cv::Mat> pyramidImagesCurrent;
-                cvMatcvMatInput.convertTo(imageCurrent, CV_32F);
-                updateLK(spImpl->mPersonEntries, spImpl->mPyramidImagesPrevious, pyramidImagesCurrent, spImpl->mImagePrevious, imageCurrent,
-                         spImpl->mNumberFramesToDeletePerson);
-                spImpl->mImagePrevious = imageCurrent;
-                spImpl->mPyramidImagesPrevious = pyramidImagesCurrent;
-            }
+            // GPU: Each frame is uploaded and its pyramid built only once, and all the people are tracked at once
+            #ifdef USE_CUDA
+                // First frame
+                if (spImpl->upPyramidGpuPrevious->empty())
+                {
+                    // Add first persons to the LK set
+                    initializeLK(
+                        spImpl->mPersonEntries, spImpl->mNextPersonId, poseKeypoints, spImpl->mConfidenceThreshold);
+                    buildPyramidGpu(*spImpl->upPyramidGpuPrevious, cvMatcvMatInput, 3);
+                }
+                // Rest
+                else
+                {
+                    buildPyramidGpu(*spImpl->upPyramidGpuCurrent, cvMatcvMatInput, 3);
+                    updateLKGpu(spImpl->mPersonEntries, *spImpl->upPyramidGpuPrevious, *spImpl->upPyramidGpuCurrent,
+                                spImpl->mNumberFramesToDeletePerson);
+                    std::swap(spImpl->upPyramidGpuPrevious, spImpl->upPyramidGpuCurrent);
+                }
+            // CPU
+            #else
+                // First frame
+                if (spImpl->mImagePrevious.empty())
+                {
+                    // Add first persons to the LK set
+                    initializeLK(
+                        spImpl->mPersonEntries, spImpl->mNextPersonId, poseKeypoints, spImpl->mConfidenceThreshold);
+                    // Capture current frame as floating point
+                    getGrayFloatImage(spImpl->mImagePrevious, cvMatcvMatInput);
+                }
+                // Rest
+                else
+                {
+                    cv::Mat imageCurrent;
+                    std::vector<cv::Mat> pyramidImagesCurrent;
+                    getGrayFloatImage(imageCurrent, cvMatcvMatInput);
+                    updateLK(spImpl->mPersonEntries, spImpl->mPyramidImagesPrevious, pyramidImagesCurrent,
+                             spImpl->mImagePrevious, imageCurrent, spImpl->mNumberFramesToDeletePerson);
+                    spImpl->mImagePrevious = imageCurrent;
+                    spImpl->mPyramidImagesPrevious = pyramidImagesCurrent;
+                }
+            #endif
 
             // Get poseIds and update LKset according to OpenPose set
             // poseIds = matchLKAndOP(
-            poseIds = matchLKAndOPGreedy(
-                spImpl->mPersonEntries, spImpl->mNextPersonId, openposePersonEntries, spImpl->mImagePrevious, spImpl->mInlierRatioThreshold,
-                spImpl->mDistanceThreshold);
+            // poseIds = matchLKAndOPGreedy(
+            poseIds = matchLKAndOPAssignment(
+                spImpl->mPersonEntries, spImpl->mNextPersonId, openposePersonEntries, cvMatcvMatInput.size(),
+                spImpl->mInlierRatioThreshold, spImpl->mDistanceThreshold);
 
             return poseIds;
         }
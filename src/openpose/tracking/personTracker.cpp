@@ -2,6 +2,7 @@
 #include <atomic>
 #include <iostream>
 #include <unordered_map>
+#include <openpose/core/arrayView.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose_private/tracking/pyramidalLK.hpp>
 #include <openpose_private/utilities/openCvMultiversionHeaders.hpp>
@@ -167,23 +168,18 @@ namespace op
         try
         {
             personEntries.clear();
-            for (int i=0; i<poseKeypoints.getSize(0); i++)
+            const ArrayView3<const float> keypointsView{poseKeypoints};
+            for (int i=0; i<keypointsView.getSize(0); i++)
             {
                 const auto id = int(poseIds[i]);
                 personEntries[id] = PersonTrackerEntry();
-                personEntries[id].keypoints.resize(poseKeypoints.getSize(1));
-                personEntries[id].status.resize(poseKeypoints.getSize(1));
-                for (int j=0; j<poseKeypoints.getSize(1); j++)
+                personEntries[id].keypoints.resize(keypointsView.getSize(1));
+                personEntries[id].status.resize(keypointsView.getSize(1));
+                for (int j=0; j<keypointsView.getSize(1); j++)
                 {
-                    personEntries[id].keypoints[j].x = poseKeypoints[
-                            i*poseKeypoints.getSize(1)*poseKeypoints.getSize(2) +
-                            j*poseKeypoints.getSize(2) + 0];
-                    personEntries[id].keypoints[j].y = poseKeypoints[
-                            i*poseKeypoints.getSize(1)*poseKeypoints.getSize(2) +
-                            j*poseKeypoints.getSize(2) + 1];
-                    const float prob = poseKeypoints[
-                            i*poseKeypoints.getSize(1)*poseKeypoints.getSize(2) +
-                            j*poseKeypoints.getSize(2) + 2];
+                    personEntries[id].keypoints[j].x = keypointsView(i, j, 0);
+                    personEntries[id].keypoints[j].y = keypointsView(i, j, 1);
+                    const float prob = keypointsView(i, j, 2);
                     if (prob < confidenceThreshold)
                         personEntries[id].status[j] = 0;
                     else
@@ -222,6 +218,7 @@ namespace op
                 }
 
                 // Update or Add
+                const ArrayView3<const float> keypointsView{poseKeypoints};
                 for (int i=0; i<poseIds.getSize(0); i++)
                 {
                     const auto id = int(poseIds[i]);
@@ -230,17 +227,11 @@ namespace op
                     if (personEntries.count(id) && mergeResults)
                     {
                         PersonTrackerEntry& personEntry = personEntries[id];
-                        for (int j=0; j<poseKeypoints.getSize(1); j++)
+                        for (int j=0; j<keypointsView.getSize(1); j++)
                         {
-                            const float x = poseKeypoints[
-                                    i*poseKeypoints.getSize(1)*poseKeypoints.getSize(2) +
-                                    j*poseKeypoints.getSize(2) + 0];
-                            const float y = poseKeypoints[
-                                    i*poseKeypoints.getSize(1)*poseKeypoints.getSize(2) +
-                                    j*poseKeypoints.getSize(2) + 1];
-                            const float prob = poseKeypoints[
-                                    i*poseKeypoints.getSize(1)*poseKeypoints.getSize(2) +
-                                    j*poseKeypoints.getSize(2) + 2];
+                            const float x = keypointsView(i, j, 0);
+                            const float y = keypointsView(i, j, 1);
+                            const float prob = keypointsView(i, j, 2);
                             const cv::Point lkPoint = personEntry.keypoints[j];
                             const cv::Point opPoint{positiveIntRound(x), positiveIntRound(y)};
 
@@ -266,19 +257,13 @@ namespace op
                     else
                     {
                         personEntries[id] = PersonTrackerEntry();
-                        personEntries[id].keypoints.resize(poseKeypoints.getSize(1));
-                        personEntries[id].status.resize(poseKeypoints.getSize(1));
-                        for (int j=0; j<poseKeypoints.getSize(1); j++)
+                        personEntries[id].keypoints.resize(keypointsView.getSize(1));
+                        personEntries[id].status.resize(keypointsView.getSize(1));
+                        for (int j=0; j<keypointsView.getSize(1); j++)
                         {
-                            personEntries[id].keypoints[j].x = poseKeypoints[
-                                    i*poseKeypoints.getSize(1)*poseKeypoints.getSize(2) +
-                                    j*poseKeypoints.getSize(2) + 0];
-                            personEntries[id].keypoints[j].y = poseKeypoints[
-                                    i*poseKeypoints.getSize(1)*poseKeypoints.getSize(2) +
-                                    j*poseKeypoints.getSize(2) + 1];
-                            const float prob = poseKeypoints[
-                                    i*poseKeypoints.getSize(1)*poseKeypoints.getSize(2) +
-                                    j*poseKeypoints.getSize(2) + 2];
+                            personEntries[id].keypoints[j].x = keypointsView(i, j, 0);
+                            personEntries[id].keypoints[j].y = keypointsView(i, j, 1);
+                            const float prob = keypointsView(i, j, 2);
                             if (prob < confidenceThreshold)
                                 personEntries[id].status[j] = 0;
                             else
@@ -320,19 +305,19 @@ namespace op
             {
                 poseKeypoints.reset(
                     {(int)personEntries.size(), (int)personEntries.begin()->second.keypoints.size(), 3});
+                const ArrayView3<float> keypointsView{poseKeypoints};
                 for (auto i=0; i<poseIds.getSize(0); i++)
                 {
                     const auto id = int(poseIds[i]);
                     const PersonTrackerEntry& pe = personEntries.at(id);
-                    const int baseIndexY = i*poseKeypoints.getSize(1)*poseKeypoints.getSize(2);
-                    for (int j=0 ; j<poseKeypoints.getSize(1) ; j++)
+                    for (int j=0 ; j<keypointsView.getSize(1) ; j++)
                     {
-                        const auto baseIndex = baseIndexY + j*poseKeypoints.getSize(2);
-                        poseKeypoints[baseIndex] = pe.keypoints[j].x;
-                        poseKeypoints[baseIndex+1] = pe.keypoints[j].y;
-                        poseKeypoints[baseIndex+2] = float(int(pe.status[j]));
+                        auto* const keypointPtr = keypointsView.getPtr(i, j);
+                        keypointPtr[0] = pe.keypoints[j].x;
+                        keypointPtr[1] = pe.keypoints[j].y;
+                        keypointPtr[2] = float(int(pe.status[j]));
                         if (pe.keypoints[j].x == 0 && pe.keypoints[j].y == 0)
-                            poseKeypoints[baseIndex+2] = 0;
+                            keypointPtr[2] = 0;
                     }
                 }
             }
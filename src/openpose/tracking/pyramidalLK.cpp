@@ -1,13 +1,6 @@
 #include <openpose_private/tracking/pyramidalLK.hpp>
-#ifdef WITH_SSE4
-    #include <emmintrin.h>
-    #include "smmintrin.h"
-#endif
-
-#ifdef WITH_AVX
-    #include <immintrin.h>
-#endif
-
+#include <openpose_private/utilities/avx.hpp>
+#include <openpose_private/utilities/neon.hpp>
 #include <iostream>
 #include <opencv2/core/core.hpp> // cv::Point2f, cv::Mat
 #include <opencv2/imgproc/imgproc.hpp> // cv::pyrDown
@@ -31,157 +24,19 @@
 
 namespace op
 {
-#ifdef WITH_SSE4
-    float sse_dot_product(std::vector<float> &av, std::vector<float> &bv)
-    {
-
-      /* Get SIMD-vector pointers to the start of each vector */
-      unsigned int niters = av.size() / 4;
-      float zeros[] = {0.0, 0.0, 0.0, 0.0};
-
-      float *a = (float *) aligned_alloc(16, av.size()*sizeof(float));
-      float *b = (float *) aligned_alloc(16, av.size()*sizeof(float));
-      memcpy(a,&av[0],av.size()*sizeof(float));
-      memcpy(b,&bv[0],bv.size()*sizeof(float));
-
-      __m128 *ptrA = (__m128*) &a[0], *ptrB = (__m128*) &b[0];
-      __m128 res = _mm_load_ps(zeros);
-
-      /* Do SIMD dot product */
-      for (unsigned int i = 0; i < niters; i++, ptrA++,ptrB++)
-        res = _mm_add_ps(_mm_dp_ps(*ptrA, *ptrB, 255), res);
-
-
-      /* Get result back from the SIMD vector */
-      float fres[4];
-      _mm_store_ps (fres, res);
-      int q = 4 * niters;
-
-      for (unsigned int i = 0; i < av.size() % 4; i++)
-        fres[0] += (a[i+q]*b[i+q]);
-
-      free(a);
-      free(b);
-
-      return fres[0];
-    }
-#endif
-
-// Function aligned_alloc requires C++17 in VS
-#if defined (WITH_AVX) && !defined (_WIN32)
-    float avx_dot_product(std::vector<float> &av, std::vector<float> &bv)
-    {
-        /* Get SIMD-vector pointers to the start of each vector */
-        const size_t niters = av.size() / 8;
-
-        float *a = (float *)aligned_alloc(32, av.size() * sizeof(float));
-        float *b = (float *)aligned_alloc(32, av.size() * sizeof(float));
-        memcpy(a, &av[0], av.size() * sizeof(float));
-        memcpy(b, &bv[0], bv.size() * sizeof(float));
-
-        __m256 *ptrA = (__m256*) &a[0], *ptrB = (__m256*) &b[0];
-        __m256 res = _mm256_set1_ps(0.0);
-
-        for (size_t i = 0; i < niters; i++, ptrA++, ptrB++)
-            res = _mm256_add_ps(_mm256_dp_ps(*ptrA, *ptrB, 255), res);
-
-        /* Get result back from the SIMD vector */
-        float fres[8];
-        _mm256_storeu_ps(fres, res);
-        const size_t q = 8 * niters;
-
-        for (size_t i = 0; i < av.size() % 8; i++)
-            fres[0] += (a[i + q] * b[i + q]);
-
-        free(a);
-        free(b);
-
-        return fres[0] + fres[4];
-    }
-#endif
-
-    char computeLK(cv::Point2f& delta,  std::vector<float>& ix,
-                  std::vector<float>& iy, std::vector<float>& it)
+    // Given an OpenCV image, build a gaussian pyramid of size 'levels'
+    void buildGaussianPyramid(std::vector<cv::Mat>& pyramidImages, const cv::Mat& image, const int levels)
     {
         try
         {
-            // Calculate sums
-#if defined (WITH_AVX) && !defined (_WIN32)
-            const float sumXX = avx_dot_product(ix,ix);
-            const float sumYY = avx_dot_product(iy,iy);
-            const float sumXY = avx_dot_product(ix,iy);
-            const float sumXT = avx_dot_product(ix,it);
-            const float sumYT = avx_dot_product(iy,it);
-#elif defined (WITH_SSE4)
-            const float sumXX = sse_dot_product(ix,ix);
-            const float sumYY = sse_dot_product(iy,iy);
-            const float sumXY = sse_dot_product(ix,iy);
-            const float sumXT = sse_dot_product(ix,it);
-            const float sumYT = sse_dot_product(iy,it);
-#else
-            auto sumXX = 0.f;
-            auto sumYY = 0.f;
-            auto sumXT = 0.f;
-            auto sumYT = 0.f;
-            auto sumXY = 0.f;
-            for (auto i = 0u; i < ix.size(); i++)
-            {
-                sumXX += ix[i] * ix[i];
-                sumYY += iy[i] * iy[i];
-                sumXY += ix[i] * iy[i];
-                sumXT += ix[i] * it[i];
-                sumYT += iy[i] * it[i];
-            }
-#endif
-
-            // Get numerator and denominator of u and v
-            const auto den = (sumXX*sumYY) - (sumXY * sumXY);
-
-            if (std::abs(den) < 1e-9f)
-                return ZERO_DENOMINATOR;
-
-            const auto numU = (-1.f * sumYY * sumXT) + (sumXY * sumYT);
-            const auto numV = (-1.f * sumXX * sumYT) + (sumXT * sumXY);
-
-            delta.x = numU / den;
-            delta.y = numV / den;
-
-            return SUCCESS;
-        }
-        catch (const std::exception& e)
-        {
-            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return UNDEFINED_ERROR;
-        }
-    }
+            pyramidImages.clear();
+            pyramidImages.emplace_back(image);
 
-    void getVectors(std::vector<float>& ix, std::vector<float>& iy, std::vector<float>& it,
-                    const std::vector<std::vector<float>>& patch, const std::vector<std::vector<float>>& patchIt,
-                    const int patchSize)
-    {
-        try
-        {
-            // Performance: resize faster than emplace_back/push_back
-            const auto numberElements = patchSize*patchSize;
-            // Get `ix` and `iy`
-            ix.resize(numberElements);
-            iy.resize(numberElements);
-            for (auto i = 1; i <= patchSize; i++)
-            {
-                const auto baseIndex = (i-1)*patchSize;
-                for (auto j = 1; j <= patchSize; j++)
-                {
-                    ix[baseIndex+j-1] = (patch[i][j+1] - patch[i][j-1])/2.f;
-                    iy[baseIndex+j-1] = (patch[i+1][j] - patch[i-1][j])/2.f;
-                }
-            }
-            // Get `it`
-            it.resize(numberElements);
-            for (auto i = 0; i < patchSize; i++)
+            for (auto i = 0; i < levels - 1; i++)
             {
-                const auto baseIndex = i*patchSize;
-                for (auto j = 0; j < patchSize; j++)
-                    it[baseIndex+j] = patchIt[i][j];
+                cv::Mat pyredImage;
+                cv::pyrDown(pyramidImages.back(), pyredImage);
+                pyramidImages.emplace_back(pyredImage);
             }
         }
         catch (const std::exception& e)
@@ -190,126 +45,208 @@ namespace op
         }
     }
 
-    char extractPatch(std::vector< std::vector<float>>& patch, const int x, const int y, const int patchSize,
-                      const cv::Mat& image)
-    {
-        try
-        {
-            int radix = patchSize / 2;
-
-            if ( ((x - radix) < 0) ||
-                 ((x + radix) >= image.cols) ||
-                 ((y - radix) < 0) ||
-                 ((y + radix) >= image.rows))
-                return OUT_OF_FRAME;
-
-            for (auto i = -radix; i <= radix; i++)
-                for (auto j = -radix; j <= radix; j++)
-                    patch[i+radix][j+radix] = image.at<float>(y+i,x+j);
+    // Allocation-free LK core
+    // The patch of each keypoint is read in place (scalar version) or gathered into a fixed-size stack buffer (SIMD
+    // version), so no std::vector is allocated per keypoint or per iteration.
+    const auto LK_MAX_PATCH_SIZE = 31;
 
-            return SUCCESS;
-        }
-        catch (const std::exception& e)
-        {
-            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return UNDEFINED_ERROR;
-        }
+    // Whether the patch of radius `radius` around (x,y) is inside the image
+    inline bool isPatchInside(const int x, const int y, const int radius, const cv::Mat& image)
+    {
+        return x - radius >= 0 && x + radius < image.cols && y - radius >= 0 && y + radius < image.rows;
     }
 
-    char extractPatchIt(std::vector<std::vector<float>>& patch, const int xI, const int yI, const int xJ,
-                        const int yJ, const cv::Mat& I, const cv::Mat& J, const int patchSize)
+    // Solution of the 2x2 LK system given its sums
+    inline char solveLK(
+        float& deltaX, float& deltaY, const float sumXX, const float sumYY, const float sumXY, const float sumXT,
+        const float sumYT)
     {
-        try
-        {
-            const int radix = patchSize / 2;
-
-            if (((xI - radix) < 0) ||
-                 ((xI + radix) >= I.cols) ||
-                 ((yI - radix) < 0) ||
-                 ((yI + radix) >= I.rows))
-                return OUT_OF_FRAME;
-
-            if (((xJ - radix) < 0) ||
-                 ((xJ + radix) >= J.cols) ||
-                 ((yJ - radix) < 0) ||
-                 ((yJ + radix) >= J.rows))
-                return OUT_OF_FRAME;
-
-            for (auto i = -radix; i <= radix; i++)
-                for (auto j = -radix; j <= radix; j++)
-                    patch[i+radix][j+radix] = J.at<float>(yJ+i,xJ+j) - I.at<float>(yI+i,xI+j);
-
-            return SUCCESS;
-        }
-        catch (const std::exception& e)
-        {
-            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return UNDEFINED_ERROR;
-        }
+        const auto den = (sumXX*sumYY) - (sumXY * sumXY);
+        if (std::abs(den) < 1e-9f)
+            return ZERO_DENOMINATOR;
+        deltaX = ((-1.f * sumYY * sumXT) + (sumXY * sumYT)) / den;
+        deltaY = ((-1.f * sumXX * sumYT) + (sumXT * sumXY)) / den;
+        return SUCCESS;
     }
 
-    // Given an OpenCV image, build a gaussian pyramid of size 'levels'
-    void buildGaussianPyramid(std::vector<cv::Mat>& pyramidImages, const cv::Mat& image, const int levels)
+    // One LK iteration of a single keypoint (its patches must be inside I and J)
+    char pyramidIteration(
+        float& deltaX, float& deltaY, const int xI, const int yI, const int xJ, const int yJ, const cv::Mat& I,
+        const cv::Mat& J, const int patchSize)
     {
-        try
+        const auto radius = patchSize / 2;
+        auto sumXX = 0.f;
+        auto sumYY = 0.f;
+        auto sumXY = 0.f;
+        auto sumXT = 0.f;
+        auto sumYT = 0.f;
+        for (auto i = -radius; i <= radius; i++)
         {
-            pyramidImages.clear();
-            pyramidImages.emplace_back(image);
-
-            for (auto i = 0; i < levels - 1; i++)
+            const auto* const rowIPtr = I.ptr<float>(yI+i) + xI;
+            const auto* const rowIUpPtr = I.ptr<float>(yI+i-1) + xI;
+            const auto* const rowIDownPtr = I.ptr<float>(yI+i+1) + xI;
+            const auto* const rowJPtr = J.ptr<float>(yJ+i) + xJ;
+            for (auto j = -radius; j <= radius; j++)
             {
-                cv::Mat pyredImage;
-                cv::pyrDown(pyramidImages.back(), pyredImage);
-                pyramidImages.emplace_back(pyredImage);
+                const auto ix = (rowIPtr[j+1] - rowIPtr[j-1]) * 0.5f;
+                const auto iy = (rowIDownPtr[j] - rowIUpPtr[j]) * 0.5f;
+                const auto it = rowJPtr[j] - rowIPtr[j];
+                sumXX += ix * ix;
+                sumYY += iy * iy;
+                sumXY += ix * iy;
+                sumXT += ix * it;
+                sumYT += iy * it;
             }
         }
-        catch (const std::exception& e)
-        {
-            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-        }
+        return solveLK(deltaX, deltaY, sumXX, sumYY, sumXY, sumXT, sumYT);
     }
 
-    cv::Point2f pyramidIteration(char& status, const cv::Point2f& pointI, const cv::Point2f& pointJ, const cv::Mat& I,
-                                 const cv::Mat& J, const int patchSize = 5)
-    {
-        try
+    #ifdef WITH_AVX
+        // One LK iteration of 8 keypoints at once (one per AVX lane, their patches must be inside I and J). Their
+        // patches are gathered into a fixed-size stack buffer interleaved by lane, so the gradients and sums are
+        // computed with aligned vector loads.
+        OP_TARGET_AVX2 void pyramidIterationAvx2(
+            float* deltaXs, float* deltaYs, char* statuses, const int* const xIs, const int* const yIs,
+            const int* const xJs, const int* const yJs, const cv::Mat& I, const cv::Mat& J, const int patchSize)
         {
-            cv::Point2f result;
-
-            // Extract a patch around the image
-            std::vector<std::vector<float>> patch(patchSize + 2, std::vector<float>(patchSize + 2));
-            std::vector<std::vector<float>> patchIt(patchSize, std::vector<float>(patchSize));
-
-            status = extractPatch(patch, (int)pointI.x,(int)pointI.y, patchSize + 2, I);
-            // if (status)
-            //     return result;
-
-            status = extractPatchIt(patchIt, int(pointI.x), int(pointI.y), int(pointJ.x), int(pointJ.y), I, J, patchSize);
-
-            // if (status)
-            //     return result;
-
-            // Get the Ix, Iy and It vectors
-            std::vector<float> ix, iy, it;
-            getVectors(ix, iy, it, patch, patchIt, patchSize);
-
-            // Calculate optical flow
-            cv::Point2f delta;
-            status = computeLK(delta, ix, iy, it);
-
-            // if (status)
-            //     return result;
-
-            result = pointJ + delta;
-
-            return result;
+            const auto radius = patchSize / 2;
+            const auto sideI = patchSize + 2;
+            alignas(32) float patchI[(LK_MAX_PATCH_SIZE+2)*(LK_MAX_PATCH_SIZE+2)*8];
+            alignas(32) float patchJ[LK_MAX_PATCH_SIZE*LK_MAX_PATCH_SIZE*8];
+            // Gather the patches (lane k = keypoint k)
+            const auto stepI = (int)I.step1();
+            const auto stepJ = (int)J.step1();
+            const auto offsetsI = _mm256_add_epi32(
+                _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i*)yIs), _mm256_set1_epi32(stepI)),
+                _mm256_loadu_si256((const __m256i*)xIs));
+            const auto offsetsJ = _mm256_add_epi32(
+                _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i*)yJs), _mm256_set1_epi32(stepJ)),
+                _mm256_loadu_si256((const __m256i*)xJs));
+            const auto* const ptrI = I.ptr<float>();
+            const auto* const ptrJ = J.ptr<float>();
+            auto* patchIPtr = patchI;
+            for (auto i = -radius-1; i <= radius+1; i++)
+            {
+                for (auto j = -radius-1; j <= radius+1; j++, patchIPtr += 8)
+                    _mm256_store_ps(patchIPtr, _mm256_i32gather_ps(
+                        ptrI, _mm256_add_epi32(offsetsI, _mm256_set1_epi32(i*stepI + j)), 4));
+            }
+            auto* patchJPtr = patchJ;
+            for (auto i = -radius; i <= radius; i++)
+            {
+                for (auto j = -radius; j <= radius; j++, patchJPtr += 8)
+                    _mm256_store_ps(patchJPtr, _mm256_i32gather_ps(
+                        ptrJ, _mm256_add_epi32(offsetsJ, _mm256_set1_epi32(i*stepJ + j)), 4));
+            }
+            // Accumulate the sums of the 8 keypoints
+            const auto halfAvx = _mm256_set1_ps(0.5f);
+            auto sumXX = _mm256_setzero_ps();
+            auto sumYY = _mm256_setzero_ps();
+            auto sumXY = _mm256_setzero_ps();
+            auto sumXT = _mm256_setzero_ps();
+            auto sumYT = _mm256_setzero_ps();
+            for (auto i = 0; i < patchSize; i++)
+            {
+                const auto* centerPtr = &patchI[8*((i+1)*sideI + 1)];
+                const auto* rowJPtr = &patchJ[8*i*patchSize];
+                for (auto j = 0; j < patchSize; j++, centerPtr += 8, rowJPtr += 8)
+                {
+                    const auto center = _mm256_load_ps(centerPtr);
+                    const auto ix = _mm256_mul_ps(
+                        halfAvx, _mm256_sub_ps(_mm256_load_ps(centerPtr + 8), _mm256_load_ps(centerPtr - 8)));
+                    const auto iy = _mm256_mul_ps(halfAvx, _mm256_sub_ps(
+                        _mm256_load_ps(centerPtr + 8*sideI), _mm256_load_ps(centerPtr - 8*sideI)));
+                    const auto it = _mm256_sub_ps(_mm256_load_ps(rowJPtr), center);
+                    sumXX = _mm256_add_ps(sumXX, _mm256_mul_ps(ix, ix));
+                    sumYY = _mm256_add_ps(sumYY, _mm256_mul_ps(iy, iy));
+                    sumXY = _mm256_add_ps(sumXY, _mm256_mul_ps(ix, iy));
+                    sumXT = _mm256_add_ps(sumXT, _mm256_mul_ps(ix, it));
+                    sumYT = _mm256_add_ps(sumYT, _mm256_mul_ps(iy, it));
+                }
+            }
+            // Solve each 2x2 system
+            alignas(32) float sums[5][8];
+            _mm256_store_ps(sums[0], sumXX);
+            _mm256_store_ps(sums[1], sumYY);
+            _mm256_store_ps(sums[2], sumXY);
+            _mm256_store_ps(sums[3], sumXT);
+            _mm256_store_ps(sums[4], sumYT);
+            for (auto k = 0; k < 8; k++)
+                statuses[k] = solveLK(
+                    deltaXs[k], deltaYs[k], sums[0][k], sums[1][k], sums[2][k], sums[3][k], sums[4][k]);
         }
-        catch (const std::exception& e)
+    #endif
+
+    #ifdef WITH_NEON
+        // Analogous to pyramidIterationAvx2 for 4 keypoints at once (one per NEON lane). NEON has no gather
+        // instruction, so the patches are interleaved with scalar loads
+        void pyramidIterationNeon(
+            float* deltaXs, float* deltaYs, char* statuses, const int* const xIs, const int* const yIs,
+            const int* const xJs, const int* const yJs, const cv::Mat& I, const cv::Mat& J, const int patchSize)
         {
-            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return cv::Point2f{};
+            const auto radius = patchSize / 2;
+            const auto sideI = patchSize + 2;
+            alignas(16) float patchI[(LK_MAX_PATCH_SIZE+2)*(LK_MAX_PATCH_SIZE+2)*4];
+            alignas(16) float patchJ[LK_MAX_PATCH_SIZE*LK_MAX_PATCH_SIZE*4];
+            // Gather the patches (lane k = keypoint k)
+            auto* patchIPtr = patchI;
+            for (auto i = -radius-1; i <= radius+1; i++)
+            {
+                const float* rowIPtrs[4];
+                for (auto lane = 0; lane < 4; lane++)
+                    rowIPtrs[lane] = I.ptr<float>(yIs[lane]+i) + xIs[lane];
+                for (auto j = -radius-1; j <= radius+1; j++)
+                    for (auto lane = 0; lane < 4; lane++)
+                        *patchIPtr++ = rowIPtrs[lane][j];
+            }
+            auto* patchJPtr = patchJ;
+            for (auto i = -radius; i <= radius; i++)
+            {
+                const float* rowJPtrs[4];
+                for (auto lane = 0; lane < 4; lane++)
+                    rowJPtrs[lane] = J.ptr<float>(yJs[lane]+i) + xJs[lane];
+                for (auto j = -radius; j <= radius; j++)
+                    for (auto lane = 0; lane < 4; lane++)
+                        *patchJPtr++ = rowJPtrs[lane][j];
+            }
+            // Accumulate the sums of the 4 keypoints
+            const auto halfNeon = vdupq_n_f32(0.5f);
+            auto sumXX = vdupq_n_f32(0.f);
+            auto sumYY = vdupq_n_f32(0.f);
+            auto sumXY = vdupq_n_f32(0.f);
+            auto sumXT = vdupq_n_f32(0.f);
+            auto sumYT = vdupq_n_f32(0.f);
+            for (auto i = 0; i < patchSize; i++)
+            {
+                const auto* centerPtr = &patchI[4*((i+1)*sideI + 1)];
+                const auto* rowJPtr = &patchJ[4*i*patchSize];
+                for (auto j = 0; j < patchSize; j++, centerPtr += 4, rowJPtr += 4)
+                {
+                    const auto center = vld1q_f32(centerPtr);
+                    const auto ix = vmulq_f32(halfNeon, vsubq_f32(vld1q_f32(centerPtr + 4), vld1q_f32(centerPtr - 4)));
+                    const auto iy = vmulq_f32(
+                        halfNeon, vsubq_f32(vld1q_f32(centerPtr + 4*sideI), vld1q_f32(centerPtr - 4*sideI)));
+                    const auto it = vsubq_f32(vld1q_f32(rowJPtr), center);
+                    // Multiply and add rather than fused multiply-add (vmlaq_f32), so it matches pyramidIteration
+                    sumXX = vaddq_f32(sumXX, vmulq_f32(ix, ix));
+                    sumYY = vaddq_f32(sumYY, vmulq_f32(iy, iy));
+                    sumXY = vaddq_f32(sumXY, vmulq_f32(ix, iy));
+                    sumXT = vaddq_f32(sumXT, vmulq_f32(ix, it));
+                    sumYT = vaddq_f32(sumYT, vmulq_f32(iy, it));
+                }
+            }
+            // Solve each 2x2 system
+            alignas(16) float sums[5][4];
+            vst1q_f32(sums[0], sumXX);
+            vst1q_f32(sums[1], sumYY);
+            vst1q_f32(sums[2], sumXY);
+            vst1q_f32(sums[3], sumXT);
+            vst1q_f32(sums[4], sumYT);
+            for (auto k = 0; k < 4; k++)
+                statuses[k] = solveLK(
+                    deltaXs[k], deltaYs[k], sums[0][k], sums[1][k], sums[2][k], sums[3][k], sums[4][k]);
         }
-    }
+    #endif
 
     void pyramidalLKCpu(std::vector<cv::Point2f>& coordI, std::vector<cv::Point2f>& coordJ,
                         std::vector<cv::Mat>& pyramidImagesPrevious, std::vector<cv::Mat>& pyramidImagesCurrent,
@@ -322,6 +259,15 @@ namespace op
             if (coordI.size() == 0)
                 return;
 
+            // Sanity checks
+            if (patchSize < 1 || patchSize > LK_MAX_PATCH_SIZE || patchSize % 2 == 0)
+                error("patchSize must be an odd number in the range [1, " + std::to_string(LK_MAX_PATCH_SIZE)
+                      + "].", __LINE__, __FUNCTION__, __FILE__);
+            if (imagePrevious.type() != CV_32FC1 || imageCurrent.type() != CV_32FC1)
+                error("Both images must be CV_32FC1 (gray).", __LINE__, __FUNCTION__, __FILE__);
+            if (status.size() != coordI.size())
+                error("status.size() != coordI.size().", __LINE__, __FUNCTION__, __FILE__);
+
             std::vector<cv::Point2f> I;
             I.assign(coordI.begin(), coordI.end());
 
@@ -337,27 +283,115 @@ namespace op
             if (pyramidImagesCurrent.empty())
                 buildGaussianPyramid(pyramidImagesCurrent, imageCurrent, levels);
 
-
-            // Process all pixel requests
-            for (auto i = 0u; i < coordI.size(); i++)
+            #ifdef WITH_AVX
+                static const auto sCpuSupportsAvx2 = cpuSupportsAvx2();
+            #endif
+            #ifdef WITH_NEON
+                static const auto sCpuSupportsNeon = cpuSupportsNeon();
+            #endif
+            // Process all the keypoints, level by level (coarse to fine)
+            const auto radius = patchSize / 2;
+            std::vector<int> indexes;
+            indexes.reserve(coordI.size());
+            for (auto l = levels - 1; l >= 0; l--)
             {
-                for (auto l = levels - 1; l >= 0; l--)
+                const auto& imageI = pyramidImagesPrevious[l];
+                const auto& imageJ = pyramidImagesCurrent[l];
+                // Keypoints still tracked whose patches are inside both images
+                indexes.clear();
+                for (auto i = 0u; i < coordI.size(); i++)
                 {
-                    char status_point = 0;
-                    cv::Point2f result;
-
-                    result = pyramidIteration(status_point, I[i], coordJ[i],pyramidImagesPrevious[l],
-                                              pyramidImagesCurrent[l], patchSize);
-                    if (status_point)
-                        status[i] = status_point;
-
-                    coordJ[i] = result;
-
-                    if (l == 0)
-                        break;
-
-                    I[i] *= 2.f;
-                    coordJ[i] *= 2.f;
+                    if (status[i] == 0)
+                    {
+                        if (isPatchInside((int)I[i].x, (int)I[i].y, radius + 1, imageI)
+                            && isPatchInside((int)coordJ[i].x, (int)coordJ[i].y, radius, imageJ))
+                            indexes.emplace_back(i);
+                        else
+                            status[i] = OUT_OF_FRAME;
+                    }
+                }
+                auto k = 0u;
+                // 8 keypoints at a time
+                #ifdef WITH_AVX
+                    if (sCpuSupportsAvx2)
+                    {
+                        for ( ; k + 8 <= indexes.size(); k += 8)
+                        {
+                            int xIs[8], yIs[8], xJs[8], yJs[8];
+                            for (auto lane = 0u; lane < 8; lane++)
+                            {
+                                const auto index = indexes[k+lane];
+                                xIs[lane] = (int)I[index].x;
+                                yIs[lane] = (int)I[index].y;
+                                xJs[lane] = (int)coordJ[index].x;
+                                yJs[lane] = (int)coordJ[index].y;
+                            }
+                            float deltaXs[8], deltaYs[8];
+                            char statuses[8];
+                            pyramidIterationAvx2(
+                                deltaXs, deltaYs, statuses, xIs, yIs, xJs, yJs, imageI, imageJ, patchSize);
+                            for (auto lane = 0u; lane < 8; lane++)
+                            {
+                                const auto index = indexes[k+lane];
+                                if (statuses[lane])
+                                    status[index] = statuses[lane];
+                                else
+                                    coordJ[index] += cv::Point2f{deltaXs[lane], deltaYs[lane]};
+                            }
+                        }
+                    }
+                #endif
+                // 4 keypoints at a time
+                #ifdef WITH_NEON
+                    if (sCpuSupportsNeon)
+                    {
+                        for ( ; k + 4 <= indexes.size(); k += 4)
+                        {
+                            int xIs[4], yIs[4], xJs[4], yJs[4];
+                            for (auto lane = 0u; lane < 4; lane++)
+                            {
+                                const auto index = indexes[k+lane];
+                                xIs[lane] = (int)I[index].x;
+                                yIs[lane] = (int)I[index].y;
+                                xJs[lane] = (int)coordJ[index].x;
+                                yJs[lane] = (int)coordJ[index].y;
+                            }
+                            float deltaXs[4], deltaYs[4];
+                            char statuses[4];
+                            pyramidIterationNeon(
+                                deltaXs, deltaYs, statuses, xIs, yIs, xJs, yJs, imageI, imageJ, patchSize);
+                            for (auto lane = 0u; lane < 4; lane++)
+                            {
+                                const auto index = indexes[k+lane];
+                                if (statuses[lane])
+                                    status[index] = statuses[lane];
+                                else
+                                    coordJ[index] += cv::Point2f{deltaXs[lane], deltaYs[lane]};
+                            }
+                        }
+                    }
+                #endif
+                // Remaining ones
+                for ( ; k < indexes.size(); k++)
+                {
+                    const auto index = indexes[k];
+                    cv::Point2f delta;
+                    const auto statusPoint = pyramidIteration(
+                        delta.x, delta.y, (int)I[index].x, (int)I[index].y, (int)coordJ[index].x,
+                        (int)coordJ[index].y, imageI, imageJ, patchSize);
+                    if (statusPoint)
+                        status[index] = statusPoint;
+                    else
+                        coordJ[index] += delta;
+                }
+                // Next level
+                if (l > 0)
+                {
+                    for (auto i = 0u; i < coordI.size(); i++)
+                    {
+                        I[i] *= 2.f;
+                        coordJ[i] *= 2.f;
+                    }
                 }
             }
         }
@@ -378,7 +412,8 @@ namespace op
             // Empty coordinates
             if (coordI.size() != 0)
             {
-                // const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // static const auto profilerTimerId = Profiler::registerTimer(__LINE__, __FUNCTION__, __FILE__);
+                // const auto profilerKey = Profiler::timerInit(profilerTimerId);
 
                 std::vector<cv::Point2f> I;
                 I.assign(coordI.begin(), coordI.end());
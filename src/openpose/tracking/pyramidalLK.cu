@@ -1,9 +1,13 @@
 #include <openpose_private/tracking/pyramidalLK.hpp>
+#include <cstring> // std::memcpy
+#include <openpose/gpu/cuda.hpp>
+#include <openpose/gpu/cudaMemoryPool.hpp>
 #ifdef WITH_TRACKING
     #include <iostream>
     #include <cuda.h>
     #include <cuda_runtime.h>
     #include <cuda_runtime_api.h>
+    #include <openpose/gpu/cudaMemoryPool.hpp>
     #include <opencv2/opencv.hpp>
     // OpenCV 2.X
     #if (defined(CV_VERSION_EPOCH) && CV_VERSION_EPOCH == 2)
@@ -212,16 +216,13 @@ namespace op
                 }
 
                 // Allocate pts on the GPU
-                float2* ptsI_gpu;
-                float2* ptsJ_gpu;
-                cudaMalloc(&ptsI_gpu, pts_size);
-                cudaMalloc(&ptsJ_gpu, pts_size);
+                auto* ptsI_gpu = (float2*)cudaPoolMalloc(pts_size);
+                auto* ptsJ_gpu = (float2*)cudaPoolMalloc(pts_size);
                 // Copy pts CPU -> GPU
                 cudaMemcpy(ptsI_gpu, ptsI_f2, pts_size, cudaMemcpyHostToDevice);
                 cudaMemcpy(ptsJ_gpu, ptsI_f2, pts_size, cudaMemcpyHostToDevice);
                 // Move status std::vector to the gpu
-                char* status_gpu;
-                cudaMalloc(&status_gpu, status.size());
+                auto* status_gpu = (char*)cudaPoolMalloc(status.size());
                 cudaMemcpy(status_gpu, status.data(), status.size(), cudaMemcpyHostToDevice);
 
                 float scale = 1.0 / (float) (1<<(levels));
@@ -256,9 +257,9 @@ namespace op
                 }
 
                 // Free GPU allocated memory
-                cudaFree(ptsI_gpu);
-                cudaFree(ptsJ_gpu);
-                cudaFree(status_gpu);
+                cudaPoolFree(ptsI_gpu);
+                cudaPoolFree(ptsJ_gpu);
+                cudaPoolFree(status_gpu);
 
                 return 0;
             #else
@@ -278,4 +279,326 @@ namespace op
             return UNDEFINED_ERROR;
         }
     }
+
+    // Batched GPU pyramidal LK (used by PersonIdExtractor)
+    const auto PYRAMIDAL_LK_MAX_LEVELS = 8;
+    const auto PYRAMIDAL_LK_MAX_ITERATIONS = 10;
+    const auto PYRAMIDAL_LK_NUMBER_THREADS = 128u;
+
+    // Passed by value to the kernel, so no extra GPU upload is required
+    struct PyramidLevelsGpu
+    {
+        const float* previousPtrs[PYRAMIDAL_LK_MAX_LEVELS];
+        const float* currentPtrs[PYRAMIDAL_LK_MAX_LEVELS];
+        int widths[PYRAMIDAL_LK_MAX_LEVELS];
+        int heights[PYRAMIDAL_LK_MAX_LEVELS];
+    };
+
+    __global__ void grayKernel(
+        float* targetPtr, const unsigned char* const srcPtr, const int width, const int height, const int channels)
+    {
+        const auto x = (int)(blockIdx.x * blockDim.x + threadIdx.x);
+        const auto y = (int)(blockIdx.y * blockDim.y + threadIdx.y);
+        if (x < width && y < height)
+        {
+            const auto* const pixelPtr = srcPtr + channels * (y * width + x);
+            targetPtr[y * width + x] = (channels == 1
+                ? float(pixelPtr[0]) : 0.114f * pixelPtr[0] + 0.587f * pixelPtr[1] + 0.299f * pixelPtr[2]);
+        }
+    }
+
+    __device__ inline int reflect101(const int index, const int size)
+    {
+        const auto reflected = (index < 0 ? -index : (index >= size ? 2 * size - 2 - index : index));
+        return max(0, min(size - 1, reflected));
+    }
+
+    // Same as cv::pyrDown (5x5 Gaussian kernel and BORDER_REFLECT_101)
+    __global__ void pyrDownKernel(
+        float* targetPtr, const float* const srcPtr, const int targetWidth, const int targetHeight,
+        const int srcWidth, const int srcHeight)
+    {
+        const auto x = (int)(blockIdx.x * blockDim.x + threadIdx.x);
+        const auto y = (int)(blockIdx.y * blockDim.y + threadIdx.y);
+        if (x < targetWidth && y < targetHeight)
+        {
+            const float weights[5] = {1.f, 4.f, 6.f, 4.f, 1.f};
+            auto sum = 0.f;
+            for (auto i = 0 ; i < 5 ; i++)
+            {
+                const auto* const srcRowPtr = srcPtr + reflect101(2 * y + i - 2, srcHeight) * srcWidth;
+                auto rowSum = 0.f;
+                for (auto j = 0 ; j < 5 ; j++)
+                    rowSum += weights[j] * srcRowPtr[reflect101(2 * x + j - 2, srcWidth)];
+                sum += weights[i] * rowSum;
+            }
+            targetPtr[y * targetWidth + x] = sum / 256.f;
+        }
+    }
+
+    // Bilinear interpolation, with the coordinates clamped to the image
+    __device__ inline float getPixel(
+        const float* const imagePtr, const int width, const int height, const float x, const float y)
+    {
+        const auto xClamped = fminf(fmaxf(x, 0.f), width - 1.f);
+        const auto yClamped = fminf(fmaxf(y, 0.f), height - 1.f);
+        const auto x0 = (int)xClamped;
+        const auto y0 = (int)yClamped;
+        const auto x1 = min(x0 + 1, width - 1);
+        const auto y1 = min(y0 + 1, height - 1);
+        const auto dx = xClamped - x0;
+        const auto dy = yClamped - y0;
+        const auto* const row0Ptr = imagePtr + y0 * width;
+        const auto* const row1Ptr = imagePtr + y1 * width;
+        return (1.f - dy) * ((1.f - dx) * row0Ptr[x0] + dx * row0Ptr[x1])
+            + dy * ((1.f - dx) * row1Ptr[x0] + dx * row1Ptr[x1]);
+    }
+
+    // One thread per keypoint, each one running all the pyramid levels (coarse to fine) with iterative refinement
+    __global__ void pyramidalLKBatchKernel(
+        float2* ptsJ, const float2* const ptsI, char* status, const PyramidLevelsGpu levels, const int numberLevels,
+        const int numberPoints, const int radius)
+    {
+        const auto index = (int)(blockIdx.x * blockDim.x + threadIdx.x);
+        if (index >= numberPoints || status[index] != 0)
+            return;
+
+        const auto pointI = ptsI[index];
+        // Displacement in the current level (propagated from the coarser ones)
+        auto guessX = 0.f;
+        auto guessY = 0.f;
+        for (auto l = numberLevels - 1 ; l >= 0 ; l--)
+        {
+            const auto scale = 1.f / float(1 << l);
+            const auto xI = pointI.x * scale;
+            const auto yI = pointI.y * scale;
+            const auto width = levels.widths[l];
+            const auto height = levels.heights[l];
+            const auto* const previousPtr = levels.previousPtrs[l];
+            const auto* const currentPtr = levels.currentPtrs[l];
+            if (xI < 0.f || yI < 0.f || xI > width - 1.f || yI > height - 1.f)
+            {
+                status[index] = OUT_OF_FRAME;
+                return;
+            }
+            // Spatial gradient matrix
+            auto sumXX = 0.f;
+            auto sumXY = 0.f;
+            auto sumYY = 0.f;
+            for (auto i = -radius ; i <= radius ; i++)
+            {
+                for (auto j = -radius ; j <= radius ; j++)
+                {
+                    const auto x = xI + j;
+                    const auto y = yI + i;
+                    const auto dx = 0.5f * (getPixel(previousPtr, width, height, x + 1.f, y)
+                                            - getPixel(previousPtr, width, height, x - 1.f, y));
+                    const auto dy = 0.5f * (getPixel(previousPtr, width, height, x, y + 1.f)
+                                            - getPixel(previousPtr, width, height, x, y - 1.f));
+                    sumXX += dx * dx;
+                    sumXY += dx * dy;
+                    sumYY += dy * dy;
+                }
+            }
+            const auto den = sumXX * sumYY - sumXY * sumXY;
+            if (fabsf(den) < 1e-9f)
+            {
+                status[index] = ZERO_DENOMINATOR;
+                return;
+            }
+            // Iterative refinement of the displacement (until it moves less than 0.01 pixels)
+            const auto epsilonSquared = 1e-4f;
+            auto flowX = guessX;
+            auto flowY = guessY;
+            for (auto iteration = 0 ; iteration < PYRAMIDAL_LK_MAX_ITERATIONS ; iteration++)
+            {
+                auto sumXT = 0.f;
+                auto sumYT = 0.f;
+                for (auto i = -radius ; i <= radius ; i++)
+                {
+                    for (auto j = -radius ; j <= radius ; j++)
+                    {
+                        const auto x = xI + j;
+                        const auto y = yI + i;
+                        const auto pixelPrevious = getPixel(previousPtr, width, height, x, y);
+                        const auto dx = 0.5f * (getPixel(previousPtr, width, height, x + 1.f, y)
+                                                - getPixel(previousPtr, width, height, x - 1.f, y));
+                        const auto dy = 0.5f * (getPixel(previousPtr, width, height, x, y + 1.f)
+                                                - getPixel(previousPtr, width, height, x, y - 1.f));
+                        const auto dt = getPixel(currentPtr, width, height, x + flowX, y + flowY) - pixelPrevious;
+                        sumXT += dx * dt;
+                        sumYT += dy * dt;
+                    }
+                }
+                const auto deltaX = (-sumYY * sumXT + sumXY * sumYT) / den;
+                const auto deltaY = (-sumXX * sumYT + sumXY * sumXT) / den;
+                flowX += deltaX;
+                flowY += deltaY;
+                if (deltaX * deltaX + deltaY * deltaY < epsilonSquared)
+                    break;
+            }
+            guessX = (l > 0 ? 2.f * flowX : flowX);
+            guessY = (l > 0 ? 2.f * flowY : flowY);
+        }
+        const auto xJ = pointI.x + guessX;
+        const auto yJ = pointI.y + guessY;
+        if (xJ < 0.f || yJ < 0.f || xJ > levels.widths[0] - 1.f || yJ > levels.heights[0] - 1.f)
+            status[index] = OUT_OF_FRAME;
+        else
+            ptsJ[index] = make_float2(xJ, yJ);
+    }
+
+    PyramidGpu::PyramidGpu() :
+        gpuPtr{nullptr},
+        gpuBytes{0ull},
+        frameGpuPtr{nullptr},
+        frameGpuBytes{0ull}
+    {
+    }
+
+    PyramidGpu::~PyramidGpu()
+    {
+        try
+        {
+            cudaPoolFree(gpuPtr);
+            cudaPoolFree(frameGpuPtr);
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool PyramidGpu::empty() const
+    {
+        return levelPtrs.empty();
+    }
+
+    void buildPyramidGpu(PyramidGpu& pyramid, const cv::Mat& image, const int levels)
+    {
+        try
+        {
+            // Sanity checks
+            if (image.empty())
+                error("Empty image.", __LINE__, __FUNCTION__, __FILE__);
+            if (image.type() != CV_8UC1 && image.type() != CV_8UC3)
+                error("Only CV_8UC1 and CV_8UC3 images are supported.", __LINE__, __FUNCTION__, __FILE__);
+            if (levels < 1 || levels > PYRAMIDAL_LK_MAX_LEVELS)
+                error("Number of levels must be in the range [1, " + std::to_string(PYRAMIDAL_LK_MAX_LEVELS)
+                      + "].", __LINE__, __FUNCTION__, __FILE__);
+            // Level sizes (the same ones than cv::pyrDown)
+            std::vector<cv::Size> levelSizes{image.size()};
+            auto totalArea = (unsigned long long)image.size().area();
+            for (auto l = 1 ; l < levels ; l++)
+            {
+                levelSizes.emplace_back((levelSizes.back().width + 1) / 2, (levelSizes.back().height + 1) / 2);
+                totalArea += levelSizes.back().area();
+            }
+            // GPU memory (only re-allocated if the frame size changes)
+            const auto bytes = totalArea * sizeof(float);
+            if (pyramid.gpuBytes != bytes)
+            {
+                cudaPoolFree(pyramid.gpuPtr);
+                pyramid.gpuPtr = (float*)cudaPoolMalloc(bytes);
+                pyramid.gpuBytes = bytes;
+            }
+            const auto frameBytes = (unsigned long long)image.total() * image.elemSize();
+            if (pyramid.frameGpuBytes != frameBytes)
+            {
+                cudaPoolFree(pyramid.frameGpuPtr);
+                pyramid.frameGpuPtr = (unsigned char*)cudaPoolMalloc(frameBytes);
+                pyramid.frameGpuBytes = frameBytes;
+            }
+            pyramid.levelSizes = levelSizes;
+            pyramid.levelPtrs.resize(levels);
+            auto* levelPtr = pyramid.gpuPtr;
+            for (auto l = 0 ; l < levels ; l++)
+            {
+                pyramid.levelPtrs[l] = levelPtr;
+                levelPtr += levelSizes[l].area();
+            }
+            // Upload frame (once) and convert it into gray
+            const auto rowBytes = image.cols * image.elemSize();
+            cudaMemcpy2D(pyramid.frameGpuPtr, rowBytes, image.data, image.step, rowBytes, image.rows,
+                         cudaMemcpyHostToDevice);
+            dim3 numberCudaThreads;
+            dim3 numberCudaBlocks;
+            getNumberCudaThreadsAndBlocks(
+                numberCudaThreads, numberCudaBlocks, Point<unsigned int>{(unsigned int)image.cols,
+                                                                         (unsigned int)image.rows});
+            grayKernel<<<numberCudaBlocks, numberCudaThreads>>>(
+                pyramid.levelPtrs[0], pyramid.frameGpuPtr, image.cols, image.rows, image.channels());
+            // Downsample it
+            for (auto l = 1 ; l < levels ; l++)
+            {
+                getNumberCudaThreadsAndBlocks(
+                    numberCudaThreads, numberCudaBlocks, Point<unsigned int>{(unsigned int)levelSizes[l].width,
+                                                                             (unsigned int)levelSizes[l].height});
+                pyrDownKernel<<<numberCudaBlocks, numberCudaThreads>>>(
+                    pyramid.levelPtrs[l], pyramid.levelPtrs[l-1], levelSizes[l].width, levelSizes[l].height,
+                    levelSizes[l-1].width, levelSizes[l-1].height);
+            }
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void pyramidalLKGpu(
+        std::vector<cv::Point2f>& ptsI, std::vector<cv::Point2f>& ptsJ, std::vector<char>& status,
+        const PyramidGpu& pyramidPrevious, const PyramidGpu& pyramidCurrent, const int patchSize)
+    {
+        try
+        {
+            // Failed points keep their previous location
+            ptsJ = ptsI;
+            if (ptsI.empty())
+                return;
+            // Sanity checks
+            if (status.size() != ptsI.size())
+                error("status.size() != ptsI.size().", __LINE__, __FUNCTION__, __FILE__);
+            if (pyramidPrevious.empty() || pyramidPrevious.levelSizes != pyramidCurrent.levelSizes)
+                error("Both pyramids must be built and have the same size.", __LINE__, __FUNCTION__, __FILE__);
+            static_assert(sizeof(cv::Point2f) == sizeof(float2), "cv::Point2f and float2 must match.");
+            // Pyramid levels
+            const auto numberLevels = (int)pyramidPrevious.levelPtrs.size();
+            PyramidLevelsGpu pyramidLevels;
+            for (auto l = 0 ; l < numberLevels ; l++)
+            {
+                pyramidLevels.previousPtrs[l] = pyramidPrevious.levelPtrs[l];
+                pyramidLevels.currentPtrs[l] = pyramidCurrent.levelPtrs[l];
+                pyramidLevels.widths[l] = pyramidPrevious.levelSizes[l].width;
+                pyramidLevels.heights[l] = pyramidPrevious.levelSizes[l].height;
+            }
+            // Points and status in a single buffer, so a single upload and a single download are required
+            const auto numberPoints = (int)ptsI.size();
+            const auto pointBytes = numberPoints * sizeof(float2);
+            const auto totalBytes = 2 * pointBytes + numberPoints;
+            std::vector<unsigned char> hostBuffer(totalBytes);
+            std::memcpy(hostBuffer.data(), ptsI.data(), pointBytes);
+            std::memcpy(hostBuffer.data() + pointBytes, ptsI.data(), pointBytes);
+            std::memcpy(hostBuffer.data() + 2 * pointBytes, status.data(), numberPoints);
+            auto* gpuPtr = (unsigned char*)cudaPoolMalloc(totalBytes);
+            const auto* const ptsIGpu = (float2*)gpuPtr;
+            auto* ptsJGpu = (float2*)(gpuPtr + pointBytes);
+            auto* statusGpu = (char*)(gpuPtr + 2 * pointBytes);
+            cudaMemcpy(gpuPtr, hostBuffer.data(), totalBytes, cudaMemcpyHostToDevice);
+            // All the keypoints of all the people at once
+            pyramidalLKBatchKernel<<<getNumberCudaBlocks(numberPoints, PYRAMIDAL_LK_NUMBER_THREADS),
+                                     PYRAMIDAL_LK_NUMBER_THREADS>>>(
+                ptsJGpu, ptsIGpu, statusGpu, pyramidLevels, numberLevels, numberPoints, patchSize / 2);
+            // Download ptsJ and status
+            cudaMemcpy(hostBuffer.data() + pointBytes, ptsJGpu, pointBytes + numberPoints, cudaMemcpyDeviceToHost);
+            cudaPoolFree(gpuPtr);
+            std::memcpy(ptsJ.data(), hostBuffer.data() + pointBytes, pointBytes);
+            std::memcpy(status.data(), hostBuffer.data() + 2 * pointBytes, numberPoints);
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 }
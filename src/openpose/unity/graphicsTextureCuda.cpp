@@ -0,0 +1,207 @@
+#include <openpose/unity/graphicsTextureCuda.hpp>
+#if defined(USE_UNITY_SUPPORT) && defined(USE_CUDA)
+    #ifdef _WIN32
+        #ifndef NOMINMAX
+            #define NOMINMAX
+        #endif
+        #ifndef WIN32_LEAN_AND_MEAN
+            #define WIN32_LEAN_AND_MEAN
+        #endif
+        #include <windows.h> // Required by GL/gl.h
+        #include <d3d11.h>
+        #include <cuda_d3d11_interop.h>
+    #endif
+    #include <cuda_runtime_api.h>
+    #include <cuda_gl_interop.h>
+    #include <openpose/gpu/cuda.hpp>
+#endif
+
+namespace op
+{
+    struct GraphicsTextureCuda::ImplGraphicsTextureCuda
+    {
+        void* const pNativeTexture;
+        const UnityGraphicsApi mGraphicsApi;
+        #if defined(USE_UNITY_SUPPORT) && defined(USE_CUDA)
+            cudaGraphicsResource_t mResource;
+            int mGpuId;
+
+            ImplGraphicsTextureCuda(void* const nativeTexture, const UnityGraphicsApi graphicsApi) :
+                pNativeTexture{nativeTexture},
+                mGraphicsApi{graphicsApi},
+                mResource{nullptr},
+                mGpuId{-1}
+            {
+            }
+
+            // It is registered on the device of the first copy (i.e., on the graphics thread, required by OpenGL)
+            void registerResource(const int gpuId)
+            {
+                try
+                {
+                    if (mGraphicsApi == UnityGraphicsApi::Direct3D11)
+                    {
+                        #ifdef _WIN32
+                            cudaGraphicsD3D11RegisterResource(
+                                &mResource, (ID3D11Resource*)pNativeTexture,
+                                cudaGraphicsRegisterFlagsSurfaceLoadStore);
+                        #else
+                            error("Direct3D 11 textures are only available on Windows.",
+                                  __LINE__, __FUNCTION__, __FILE__);
+                        #endif
+                    }
+                    else if (mGraphicsApi == UnityGraphicsApi::OpenGLCore)
+                        cudaGraphicsGLRegisterImage(
+                            &mResource, (GLuint)(size_t)pNativeTexture, GL_TEXTURE_2D,
+                            cudaGraphicsRegisterFlagsSurfaceLoadStore);
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    mGpuId = gpuId;
+                }
+                catch (const std::exception& e)
+                {
+                    mResource = nullptr;
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+        #else
+            ImplGraphicsTextureCuda(void* const nativeTexture, const UnityGraphicsApi graphicsApi) :
+                pNativeTexture{nativeTexture},
+                mGraphicsApi{graphicsApi}
+            {
+            }
+        #endif
+    };
+
+    GraphicsTextureCuda::GraphicsTextureCuda(void* const nativeTexture, const UnityGraphicsApi graphicsApi)
+    {
+        try
+        {
+            #if defined(USE_UNITY_SUPPORT) && defined(USE_CUDA)
+                if (nativeTexture == nullptr)
+                    error("The native texture cannot be null.", __LINE__, __FUNCTION__, __FILE__);
+                if (graphicsApi != UnityGraphicsApi::Direct3D11 && graphicsApi != UnityGraphicsApi::OpenGLCore)
+                    error("Only Direct3D 11 and OpenGL Core textures can be shared with CUDA (UnityGraphicsApi "
+                          + std::to_string(int(graphicsApi)) + " given). Direct3D 12 and Vulkan textures would"
+                          " require exportable (shared) memory.", __LINE__, __FUNCTION__, __FILE__);
+                upImpl.reset(new ImplGraphicsTextureCuda{nativeTexture, graphicsApi});
+            #else
+                UNUSED(nativeTexture);
+                UNUSED(graphicsApi);
+                error("OpenPose must be compiled with CUDA and the `BUILD_UNITY_SUPPORT` CMake flag in order to share"
+                      " its rendered frames as graphics textures.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    GraphicsTextureCuda::~GraphicsTextureCuda()
+    {
+        try
+        {
+            #if defined(USE_UNITY_SUPPORT) && defined(USE_CUDA)
+                if (upImpl != nullptr && upImpl->mResource != nullptr)
+                {
+                    int previousGpuId;
+                    cudaGetDevice(&previousGpuId);
+                    cudaSetDevice(upImpl->mGpuId);
+                    cudaGraphicsUnregisterResource(upImpl->mResource);
+                    cudaSetDevice(previousGpuId);
+                }
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void GraphicsTextureCuda::copyFrom(const RenderTargetGpu& renderTarget, const bool flipVertically)
+    {
+        try
+        {
+            #if defined(USE_UNITY_SUPPORT) && defined(USE_CUDA)
+                if (renderTarget.empty())
+                    return;
+                int previousGpuId;
+                cudaGetDevice(&previousGpuId);
+                cudaSetDevice(renderTarget.gpuId);
+                std::string errorMessage;
+                try
+                {
+                    if (upImpl->mResource == nullptr)
+                        upImpl->registerResource(renderTarget.gpuId);
+                    else if (upImpl->mGpuId != renderTarget.gpuId)
+                        error("The render target must be on the GPU of the texture (" + std::to_string(upImpl->mGpuId)
+                              + "), but it is on GPU " + std::to_string(renderTarget.gpuId) + ".",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    // Texture mapped as a CUDA array (the graphics API does not access it until it is unmapped)
+                    cudaGraphicsMapResources(1, &upImpl->mResource, nullptr);
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    try
+                    {
+                        cudaArray_t textureArray;
+                        cudaGraphicsSubResourceGetMappedArray(&textureArray, upImpl->mResource, 0, 0);
+                        cudaChannelFormatDesc channelFormatDesc;
+                        cudaExtent extent;
+                        unsigned int flags;
+                        cudaArrayGetInfo(&channelFormatDesc, &extent, &flags, textureArray);
+                        cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                        if (channelFormatDesc.x != 8 || channelFormatDesc.y != 8 || channelFormatDesc.z != 8
+                            || channelFormatDesc.w != 8)
+                            error("Only 8-bit RGBA textures (e.g., `TextureFormat.RGBA32`) are supported.",
+                                  __LINE__, __FUNCTION__, __FILE__);
+                        cudaResourceDesc resourceDesc{};
+                        resourceDesc.resType = cudaResourceTypeArray;
+                        resourceDesc.res.array.array = textureArray;
+                        cudaSurfaceObject_t surfaceObject;
+                        cudaCreateSurfaceObject(&surfaceObject, &resourceDesc);
+                        bgrFloatToRgbaSurface(
+                            surfaceObject, (int)extent.width, (int)extent.height, renderTarget.dataPtr.get(),
+                            renderTarget.width, renderTarget.height, flipVertically);
+                        cudaStreamSynchronize(nullptr);
+                        cudaDestroySurfaceObject(surfaceObject);
+                        cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        errorMessage = e.what();
+                    }
+                    cudaGraphicsUnmapResources(1, &upImpl->mResource, nullptr);
+                }
+                catch (const std::exception& e)
+                {
+                    if (errorMessage.empty())
+                        errorMessage = e.what();
+                }
+                cudaSetDevice(previousGpuId);
+                if (!errorMessage.empty())
+                    error(errorMessage, __LINE__, __FUNCTION__, __FILE__);
+            #else
+                UNUSED(renderTarget);
+                UNUSED(flipVertically);
+                error("OpenPose must be compiled with CUDA and the `BUILD_UNITY_SUPPORT` CMake flag in order to share"
+                      " its rendered frames as graphics textures.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void* GraphicsTextureCuda::getNativeTexture() const
+    {
+        try
+        {
+            return (upImpl != nullptr ? upImpl->pNativeTexture : nullptr);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+}
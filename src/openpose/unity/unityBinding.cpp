@@ -2,6 +2,9 @@
 // ------------------------- OpenPose Unity Binding -------------------------
 
 // OpenPose dependencies
+#include <atomic>
+#include <cstring> // std::memcpy
+#include <mutex>
 #include <openpose/headers.hpp>
 
 namespace op
@@ -18,6 +21,7 @@ namespace op
     bool sMultiThreadDisabled = false;
     bool sUnityOutputEnabled = true;
     bool sImageOutput = false;
+    bool sSharedBufferOutput = false;
 
     enum class OutputType : unsigned char
     {
@@ -41,9 +45,300 @@ namespace op
         CameraMatrix,
         CameraExtrinsics,
         CameraIntrinsics,
-        Image
+        Image,
+        SharedBuffer,
+        PoseCandidatesOffsets
     };
 
+    // ------------------------- Shared-buffer output -------------------------
+    // All the fields of each frame are packed into a single native block (SharedBufferHeader, followed by
+    // numberEntries SharedBufferEntry, followed by the data of each entry at its offset, 16-byte aligned), so Unity
+    // receives 1 callback per frame (OutputType::SharedBuffer, with the block as its only pointer and its size in
+    // bytes as its only size) and can read each field in place (e.g., NativeArray). The blocks are double buffered:
+    // the block of a frame is not modified until the callback of the following frame returns. Without callback (e.g.,
+    // non-Windows), the latest block can be polled with _OPGetSharedBuffer().
+    const unsigned int SHARED_BUFFER_MAGIC = 0x4253504f; // "OPSB"
+    const unsigned int SHARED_BUFFER_VERSION = 1u;
+    const auto SHARED_BUFFER_ALIGNMENT = 16ull;
+
+    enum class ElementType : unsigned char
+    {
+        Float32,
+        Int64,
+        UInt64,
+        UInt8,
+        Char,
+        Int32
+    };
+
+    struct SharedBufferHeader
+    {
+        unsigned int magic;
+        unsigned int version;
+        // Incremented for each frame
+        unsigned long long sequence;
+        // Size of the whole block (header included)
+        unsigned long long byteSize;
+        unsigned int numberEntries;
+        // Offset of the first SharedBufferEntry
+        unsigned int entriesOffset;
+    };
+
+    struct SharedBufferEntry
+    {
+        unsigned char outputType; // OutputType
+        unsigned char elementType; // ElementType
+        unsigned short numberDimensions;
+        int sizes[6];
+        unsigned long long offset;
+        unsigned long long byteSize;
+    };
+
+    // Entry being packed, with the memory chunks to be concatenated
+    struct SharedBufferPendingEntry
+    {
+        SharedBufferEntry entry;
+        std::vector<std::pair<const void*, unsigned long long>> chunks;
+    };
+
+    class SharedBuffer
+    {
+    public:
+        SharedBuffer() :
+            mFrontBuffer{-1},
+            mSequence{0ull}
+        {
+        }
+
+        // Not thread-safe (only called by the output worker)
+        void pack(const std::vector<SharedBufferPendingEntry>& pendingEntries)
+        {
+            try
+            {
+                // Layout
+                const auto alignUp = [](const unsigned long long value)
+                {
+                    return (value + SHARED_BUFFER_ALIGNMENT - 1ull) / SHARED_BUFFER_ALIGNMENT * SHARED_BUFFER_ALIGNMENT;
+                };
+                const auto entriesOffset = alignUp(sizeof(SharedBufferHeader));
+                auto byteSize = alignUp(entriesOffset + pendingEntries.size() * sizeof(SharedBufferEntry));
+                std::vector<unsigned long long> offsets(pendingEntries.size());
+                for (auto i = 0u ; i < pendingEntries.size() ; i++)
+                {
+                    offsets[i] = byteSize;
+                    byteSize = alignUp(byteSize + pendingEntries[i].entry.byteSize);
+                }
+                // Back buffer (it only grows, so it is not reallocated for each frame)
+                auto& buffer = mBuffers[(mFrontBuffer + 1) % 2 == 0 ? 0 : 1];
+                if (buffer.size() < byteSize)
+                    buffer.resize(byteSize);
+                auto* const bufferPtr = buffer.data();
+                // Header
+                SharedBufferHeader header;
+                header.magic = SHARED_BUFFER_MAGIC;
+                header.version = SHARED_BUFFER_VERSION;
+                header.sequence = ++mSequence;
+                header.byteSize = byteSize;
+                header.numberEntries = (unsigned int)pendingEntries.size();
+                header.entriesOffset = (unsigned int)entriesOffset;
+                std::memcpy(bufferPtr, &header, sizeof(header));
+                // Entries and data
+                for (auto i = 0u ; i < pendingEntries.size() ; i++)
+                {
+                    auto entry = pendingEntries[i].entry;
+                    entry.offset = offsets[i];
+                    std::memcpy(bufferPtr + entriesOffset + i * sizeof(SharedBufferEntry), &entry, sizeof(entry));
+                    auto dataOffset = offsets[i];
+                    for (const auto& chunk : pendingEntries[i].chunks)
+                    {
+                        if (chunk.second > 0ull)
+                            std::memcpy(bufferPtr + dataOffset, chunk.first, chunk.second);
+                        dataOffset += chunk.second;
+                    }
+                }
+                // Publish it
+                mFrontBuffer = (&buffer == &mBuffers[0] ? 0 : 1);
+            }
+            catch (const std::exception& e)
+            {
+                errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        // Latest packed block, or nullptr if none
+        unsigned char* getFrontBuffer()
+        {
+            const auto frontBuffer = mFrontBuffer.load();
+            return (frontBuffer < 0 ? nullptr : mBuffers[frontBuffer].data());
+        }
+
+    private:
+        std::vector<unsigned char> mBuffers[2];
+        std::atomic<int> mFrontBuffer;
+        unsigned long long mSequence;
+    };
+
+    SharedBuffer sSharedBuffer;
+
+    // ------------------------- Texture output -------------------------
+    // The GPU render target of each frame is written straight into a Unity native texture (see GraphicsTextureCuda),
+    // rather than sending its bytes (OutputType::Image) to be uploaded again. The output worker only keeps the latest
+    // render target, which is copied on the Unity render thread (the one owning the graphics context) by the
+    // _OPGetRenderEventFunc() callback (i.e., `GL.IssuePluginEvent()`), once per new frame.
+    #ifdef _WIN32
+        #define OP_UNITY_INTERFACE_API __stdcall
+    #else
+        #define OP_UNITY_INTERFACE_API
+    #endif
+    typedef void(OP_UNITY_INTERFACE_API * RenderEventCallback) (int eventId);
+
+    class TextureOutput
+    {
+    public:
+        TextureOutput() :
+            pNativeTexture{nullptr},
+            mGraphicsApi{UnityGraphicsApi::Direct3D11},
+            mFlipVertically{true},
+            mNewRenderTarget{false}
+        {
+        }
+
+        bool enabled()
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            return pNativeTexture != nullptr;
+        }
+
+        // Called from Unity (any thread), nullptr to disable it
+        void setTexture(void* const nativeTexture, const UnityGraphicsApi graphicsApi, const bool flipVertically)
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            pNativeTexture = nativeTexture;
+            mGraphicsApi = graphicsApi;
+            mFlipVertically = flipVertically;
+            mNewRenderTarget = (nativeTexture != nullptr && !mRenderTarget.empty());
+        }
+
+        // Called by the output worker (shallow copy, so the GPU memory is kept until the next frame)
+        void setRenderTarget(const RenderTargetGpu& renderTarget)
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mRenderTarget = renderTarget;
+            mNewRenderTarget = !renderTarget.empty();
+        }
+
+        // Called from the Unity render thread, so the texture is also (un)registered on it
+        void render()
+        {
+            try
+            {
+                RenderTargetGpu renderTarget;
+                bool flipVertically;
+                {
+                    const std::lock_guard<std::mutex> lock{mMutex};
+                    if (spTexture != nullptr && spTexture->getNativeTexture() != pNativeTexture)
+                        spTexture.reset();
+                    if (pNativeTexture == nullptr || !mNewRenderTarget)
+                        return;
+                    if (spTexture == nullptr)
+                        spTexture = std::make_shared<GraphicsTextureCuda>(pNativeTexture, mGraphicsApi);
+                    renderTarget = mRenderTarget;
+                    flipVertically = mFlipVertically;
+                    mNewRenderTarget = false;
+                }
+                spTexture->copyFrom(renderTarget, flipVertically);
+            }
+            catch (const std::exception& e)
+            {
+                errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+    private:
+        std::mutex mMutex;
+        void* pNativeTexture;
+        UnityGraphicsApi mGraphicsApi;
+        bool mFlipVertically;
+        RenderTargetGpu mRenderTarget;
+        bool mNewRenderTarget;
+        // Only accessed by the render thread
+        std::shared_ptr<GraphicsTextureCuda> spTexture;
+    };
+
+    TextureOutput sTextureOutput;
+
+    void OP_UNITY_INTERFACE_API onRenderEvent(int eventId)
+    {
+        UNUSED(eventId);
+        sTextureOutput.render();
+    }
+
+    template<typename T>
+    void addSharedBufferArray(
+        std::vector<SharedBufferPendingEntry>& pendingEntries, const OutputType outputType,
+        const ElementType elementType, const Array<T>& array, const Array<T>* const secondArrayPtr = nullptr)
+    {
+        try
+        {
+            // If secondArrayPtr (e.g., right hand), both arrays are concatenated (same size required)
+            if (array.empty())
+                return;
+            std::vector<const Array<T>*> arrays{&array};
+            if (secondArrayPtr != nullptr)
+                arrays.emplace_back(secondArrayPtr);
+            SharedBufferPendingEntry pendingEntry;
+            auto& entry = pendingEntry.entry;
+            std::memset(&entry, 0, sizeof(entry));
+            entry.outputType = (unsigned char)outputType;
+            entry.elementType = (unsigned char)elementType;
+            auto dimension = 0;
+            if (arrays.size() > 1)
+                entry.sizes[dimension++] = (int)arrays.size();
+            for (const auto size : arrays[0]->getSize())
+                if (dimension < 6)
+                    entry.sizes[dimension++] = size;
+            entry.numberDimensions = (unsigned short)dimension;
+            for (const auto* const arrayPtr : arrays)
+            {
+                if (arrayPtr->getVolume() != array.getVolume())
+                    return;
+                const auto bytes = arrayPtr->getVolume() * sizeof(T);
+                pendingEntry.chunks.emplace_back(std::make_pair((const void*)arrayPtr->getConstPtr(), bytes));
+                entry.byteSize += bytes;
+            }
+            pendingEntries.emplace_back(pendingEntry);
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void addSharedBufferRaw(
+        std::vector<SharedBufferPendingEntry>& pendingEntries, const OutputType outputType,
+        const ElementType elementType, const std::vector<int>& sizes, const void* const dataPtr,
+        const unsigned long long byteSize)
+    {
+        try
+        {
+            SharedBufferPendingEntry pendingEntry;
+            auto& entry = pendingEntry.entry;
+            std::memset(&entry, 0, sizeof(entry));
+            entry.outputType = (unsigned char)outputType;
+            entry.elementType = (unsigned char)elementType;
+            entry.numberDimensions = (unsigned short)fastMin((int)sizes.size(), 6);
+            for (auto i = 0 ; i < entry.numberDimensions ; i++)
+                entry.sizes[i] = sizes[i];
+            entry.byteSize = byteSize;
+            pendingEntry.chunks.emplace_back(std::make_pair(dataPtr, byteSize));
+            pendingEntries.emplace_back(pendingEntry);
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     // This worker will just read and return all the jpg files in a directory
     class UnityPluginUserOutput : public WorkerConsumer<std::shared_ptr<std::vector<std::shared_ptr<Datum>>>>
     {
@@ -58,20 +353,36 @@ namespace op
             {
                 if (datumsPtr != nullptr && !datumsPtr->empty())
                 {
-                    if (sUnityOutputEnabled)
+                    if (sTextureOutput.enabled())
+                        sTextureOutput.setRenderTarget(datumsPtr->at(0)->outputDataGpu);
+                    if (sUnityOutputEnabled && sSharedBufferOutput)
+                        sendSharedBuffer(datumsPtr);
+                    else if (sUnityOutputEnabled)
                     {
+                        // The fields disabled in this pipeline (see Datum::fields) are empty, so they are skipped
+                        const auto& datum = *datumsPtr->at(0);
                         sendDatumsInfoAndName(datumsPtr);
                         sendPoseKeypoints(datumsPtr);
                         sendPoseIds(datumsPtr);
                         sendPoseScores(datumsPtr);
-                        sendPoseHeatMaps(datumsPtr);
-                        sendPoseCandidates(datumsPtr);
-                        sendFaceRectangles(datumsPtr);
-                        sendFaceKeypoints(datumsPtr);
-                        sendFaceHeatMaps(datumsPtr);
-                        sendHandRectangles(datumsPtr);
-                        sendHandKeypoints(datumsPtr);
-                        sendHandHeatMaps(datumsPtr);
+                        if (datum.hasField(DatumField::PoseHeatMaps))
+                            sendPoseHeatMaps(datumsPtr);
+                        if (datum.hasField(DatumField::PoseCandidates))
+                            sendPoseCandidates(datumsPtr);
+                        if (datum.hasField(DatumField::Face))
+                        {
+                            sendFaceRectangles(datumsPtr);
+                            sendFaceKeypoints(datumsPtr);
+                            if (datum.hasField(DatumField::FaceHeatMaps))
+                                sendFaceHeatMaps(datumsPtr);
+                        }
+                        if (datum.hasField(DatumField::Hand))
+                        {
+                            sendHandRectangles(datumsPtr);
+                            sendHandKeypoints(datumsPtr);
+                            if (datum.hasField(DatumField::HandHeatMaps))
+                                sendHandHeatMaps(datumsPtr);
+                        }
                         if (sImageOutput)
                             sendImage(datumsPtr);
                         sendEndOfFrame();
@@ -193,7 +504,7 @@ namespace op
         {
             try
             {
-                auto& data = datumsPtr->at(0)->poseHeatMaps; // Array<float>
+                auto& data = datumsPtr->at(0)->getPoseHeatMaps(); // Array<float>
                 if (!data.empty())
                 {
                     auto sizeVector = data.getSize();
@@ -213,16 +524,22 @@ namespace op
         {
             try
             {
-                auto& data = datumsPtr->at(0)->poseCandidates; // std::vector<std::vector<std::array<float, 3>>>
-                if (!data.empty())
+                // Flat candidates (#candidates x 3) and their offsets per body part (#body parts + 1)
+                auto& data = datumsPtr->at(0)->poseCandidatesArray; // Array<float>
+                auto& offsets = datumsPtr->at(0)->poseCandidatesOffsets; // std::vector<int>
+                if (!offsets.empty())
                 {
-                    // TODO
-                    /*auto a = data[0][0].data();
-                    auto sizeVector = data.getSize();
-                    int sizeSize = sizeVector.size();
-                    int * sizes = &sizeVector[0];
-                    long long * val = data.getPtr();
-                    outputValue(&val, 1, sizes, sizeSize, OutputType::PoseIds);*/
+                    if (!data.empty())
+                    {
+                        auto sizeVector = data.getSize();
+                        const int sizeSize = (int)sizeVector.size();
+                        int* sizes = &sizeVector[0];
+                        float* val = data.getPtr();
+                        outputValue(&val, 1, sizes, sizeSize, OutputType::PoseCandidates);
+                    }
+                    int sizes[] = {(int)offsets.size()};
+                    int* val = offsets.data();
+                    outputValue(&val, 1, sizes, 1, OutputType::PoseCandidatesOffsets);
                 }
             }
             catch (const std::exception& e)
@@ -387,6 +704,107 @@ namespace op
             }
         }
 
+        void sendSharedBuffer(const std::shared_ptr<std::vector<std::shared_ptr<Datum>>>& datumsPtr)
+        {
+            try
+            {
+                auto& datum = datumsPtr->at(0);
+                std::vector<SharedBufferPendingEntry> pendingEntries;
+                // Datum info and name
+                const unsigned long long datumsInfo[] = {datum->id, datum->subId, datum->subIdMax, datum->frameNumber};
+                addSharedBufferRaw(
+                    pendingEntries, OutputType::DatumsInfo, ElementType::UInt64, {4}, datumsInfo, sizeof(datumsInfo));
+                addSharedBufferRaw(
+                    pendingEntries, OutputType::Name, ElementType::Char, {(int)datum->name.size()},
+                    datum->name.c_str(), datum->name.size());
+                // Body
+                addSharedBufferArray(
+                    pendingEntries, OutputType::PoseKeypoints, ElementType::Float32, datum->poseKeypoints);
+                addSharedBufferArray(pendingEntries, OutputType::PoseIds, ElementType::Int64, datum->poseIds);
+                addSharedBufferArray(pendingEntries, OutputType::PoseScores, ElementType::Float32, datum->poseScores);
+                addSharedBufferArray(
+                    pendingEntries, OutputType::PoseHeatMaps, ElementType::Float32, datum->getPoseHeatMaps());
+                addSharedBufferArray(
+                    pendingEntries, OutputType::PoseCandidates, ElementType::Float32, datum->poseCandidatesArray);
+                if (!datum->poseCandidatesOffsets.empty())
+                    addSharedBufferRaw(
+                        pendingEntries, OutputType::PoseCandidatesOffsets, ElementType::Int32,
+                        {(int)datum->poseCandidatesOffsets.size()}, datum->poseCandidatesOffsets.data(),
+                        datum->poseCandidatesOffsets.size() * sizeof(int));
+                // Face
+                std::vector<float> faceRectangles(4 * datum->faceRectangles.size());
+                for (auto i = 0u ; i < datum->faceRectangles.size() ; i++)
+                {
+                    const auto& rectangle = datum->faceRectangles[i];
+                    faceRectangles[4*i] = rectangle.x;
+                    faceRectangles[4*i+1] = rectangle.y;
+                    faceRectangles[4*i+2] = rectangle.width;
+                    faceRectangles[4*i+3] = rectangle.height;
+                }
+                if (!faceRectangles.empty())
+                    addSharedBufferRaw(
+                        pendingEntries, OutputType::FaceRectangles, ElementType::Float32,
+                        {(int)datum->faceRectangles.size(), 4}, faceRectangles.data(),
+                        faceRectangles.size() * sizeof(float));
+                addSharedBufferArray(
+                    pendingEntries, OutputType::FaceKeypoints, ElementType::Float32, datum->faceKeypoints);
+                addSharedBufferArray(
+                    pendingEntries, OutputType::FaceHeatMaps, ElementType::Float32, datum->faceHeatMaps);
+                // Hands (left and right concatenated)
+                std::vector<float> handRectangles(8 * datum->handRectangles.size());
+                for (auto i = 0u ; i < datum->handRectangles.size() ; i++)
+                {
+                    for (auto j = 0 ; j < 2 ; j++)
+                    {
+                        const auto& rectangle = datum->handRectangles[i][j];
+                        handRectangles[8*i+4*j] = rectangle.x;
+                        handRectangles[8*i+4*j+1] = rectangle.y;
+                        handRectangles[8*i+4*j+2] = rectangle.width;
+                        handRectangles[8*i+4*j+3] = rectangle.height;
+                    }
+                }
+                if (!handRectangles.empty())
+                    addSharedBufferRaw(
+                        pendingEntries, OutputType::HandRectangles, ElementType::Float32,
+                        {(int)datum->handRectangles.size(), 2, 4}, handRectangles.data(),
+                        handRectangles.size() * sizeof(float));
+                addSharedBufferArray(
+                    pendingEntries, OutputType::HandKeypoints, ElementType::Float32,
+                    datum->handKeypoints[0], &datum->handKeypoints[1]);
+                addSharedBufferArray(
+                    pendingEntries, OutputType::HandHeightMaps, ElementType::Float32,
+                    datum->handHeatMaps[0], &datum->handHeatMaps[1]);
+                // 3-D keypoints
+                addSharedBufferArray(
+                    pendingEntries, OutputType::PoseKeypoints3D, ElementType::Float32, datum->poseKeypoints3D);
+                addSharedBufferArray(
+                    pendingEntries, OutputType::FaceKeypoints3D, ElementType::Float32, datum->faceKeypoints3D);
+                addSharedBufferArray(
+                    pendingEntries, OutputType::HandKeypoints3D, ElementType::Float32,
+                    datum->handKeypoints3D[0], &datum->handKeypoints3D[1]);
+                // Image
+                if (sImageOutput && !datum->cvInputData.empty())
+                {
+                    const auto& image = datum->cvInputData;
+                    addSharedBufferRaw(
+                        pendingEntries, OutputType::Image, ElementType::UInt8,
+                        {image.rows(), image.cols(), image.channels()},
+                        image.dataPseudoConst(), image.total() * image.elemSize());
+                }
+                // Pack and signal Unity once
+                sSharedBuffer.pack(pendingEntries);
+                #ifdef _WIN32
+                    auto* bufferPtr = sSharedBuffer.getFrontBuffer();
+                    int sizes[] = {(int)reinterpret_cast<const SharedBufferHeader*>(bufferPtr)->byteSize};
+                    outputValue(&bufferPtr, 1, sizes, 1, OutputType::SharedBuffer);
+                #endif
+            }
+            catch (const std::exception& e)
+            {
+                errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
         void sendEndOfFrame()
         {
             try
@@ -437,6 +855,9 @@ namespace op
             spWrapper->configure(*spWrapperStructFace);
             spWrapper->configure(*spWrapperStructExtra);
             spWrapper->configure(*spWrapperStructInput);
+            // The texture output reads the GPU render target of each frame
+            if (sTextureOutput.enabled())
+                spWrapperStructOutput->keepRenderTargetGpu = true;
             spWrapper->configure(*spWrapperStructOutput);
 
             // Multi-threading
@@ -528,6 +949,55 @@ namespace op
             }
         }
 
+        // Enable/disable the shared-buffer output (1 callback per frame with all the fields, see SharedBuffer)
+        OP_API void _OPSetSharedBufferOutputEnable(bool enable)
+        {
+            try
+            {
+                sSharedBufferOutput = enable;
+            }
+            catch (const std::exception& e)
+            {
+                errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        // Latest shared-buffer block (or nullptr if none yet), e.g., to poll it without the output callback
+        OP_API void* _OPGetSharedBuffer()
+        {
+            try
+            {
+                return sSharedBuffer.getFrontBuffer();
+            }
+            catch (const std::exception& e)
+            {
+                errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return nullptr;
+            }
+        }
+
+        // Texture output (see TextureOutput): nativeTexture is the `Texture2D.GetNativeTexturePtr()` of an RGBA32
+        // texture (or nullptr to disable it), and graphicsApi the `SystemInfo.graphicsDeviceType`. It must be enabled
+        // before _OPRun(), so the GPU render targets are kept
+        OP_API void _OPSetOutputTexture(void* nativeTexture, unsigned char graphicsApi, bool flipVertically)
+        {
+            try
+            {
+                sTextureOutput.setTexture(nativeTexture, (UnityGraphicsApi)graphicsApi, flipVertically);
+            }
+            catch (const std::exception& e)
+            {
+                errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        // Render thread callback of the texture output, to be passed to `GL.IssuePluginEvent()` once per Unity frame
+        // (and once more after disabling it, so the texture is unregistered on the render thread)
+        OP_API RenderEventCallback _OPGetRenderEventFunc()
+        {
+            return onRenderEvent;
+        }
+
         // Configs
         OP_API void _OPConfigurePose(
             unsigned char poseMode,
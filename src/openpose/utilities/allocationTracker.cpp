@@ -0,0 +1,69 @@
+#include <openpose/utilities/allocationTracker.hpp>
+
+namespace op
+{
+    // Plain (not atomic) counters, each thread only modifies its own ones
+    thread_local AllocationCounters tAllocationCounters;
+
+    AllocationCounters::AllocationCounters() :
+        hostAllocations{0ull},
+        hostAllocatedBytes{0ull},
+        gpuAllocations{0ull},
+        gpuAllocatedBytes{0ull},
+        copiedBytes{}
+    {
+    }
+
+    AllocationCounters AllocationCounters::operator-(const AllocationCounters& begin) const
+    {
+        AllocationCounters difference;
+        difference.hostAllocations = hostAllocations - begin.hostAllocations;
+        difference.hostAllocatedBytes = hostAllocatedBytes - begin.hostAllocatedBytes;
+        difference.gpuAllocations = gpuAllocations - begin.gpuAllocations;
+        difference.gpuAllocatedBytes = gpuAllocatedBytes - begin.gpuAllocatedBytes;
+        for (auto i = 0u ; i < (unsigned char)MemoryCopy::Size ; i++)
+            difference.copiedBytes[i] = copiedBytes[i] - begin.copiedBytes[i];
+        return difference;
+    }
+
+    std::atomic<bool> AllocationTracker::sEnabled{false};
+
+    void AllocationTracker::setEnabled(const bool enabled)
+    {
+        sEnabled = enabled;
+    }
+
+    bool AllocationTracker::isEnabled()
+    {
+        return sEnabled.load(std::memory_order_relaxed);
+    }
+
+    AllocationCounters AllocationTracker::getThreadCounters()
+    {
+        return tAllocationCounters;
+    }
+
+    void AllocationTracker::recordHostAllocation(const unsigned long long bytes)
+    {
+        if (isEnabled() && bytes > 0ull)
+        {
+            tAllocationCounters.hostAllocations++;
+            tAllocationCounters.hostAllocatedBytes += bytes;
+        }
+    }
+
+    void AllocationTracker::recordGpuAllocation(const unsigned long long bytes)
+    {
+        if (isEnabled() && bytes > 0ull)
+        {
+            tAllocationCounters.gpuAllocations++;
+            tAllocationCounters.gpuAllocatedBytes += bytes;
+        }
+    }
+
+    void AllocationTracker::recordCopy(const unsigned long long bytes, const MemoryCopy memoryCopy)
+    {
+        if (isEnabled() && memoryCopy < MemoryCopy::Size)
+            tAllocationCounters.copiedBytes[(unsigned char)memoryCopy] += bytes;
+    }
+}
@@ -0,0 +1,139 @@
+#include <openpose_private/utilities/asyncJobQueue.hpp>
+#include <openpose/utilities/fastMath.hpp>
+
+namespace op
+{
+    AsyncJobQueue::AsyncJobQueue(const unsigned int numberThreads, const unsigned long long maxQueueSize) :
+        mMaxQueueSize{fastMax(1ull, maxQueueSize)},
+        mNumberRunningJobs{0ull},
+        mStop{false}
+    {
+        try
+        {
+            for (auto i = 0u ; i < fastMax(1u, numberThreads) ; i++)
+                mThreads.emplace_back(&AsyncJobQueue::threadFunction, this);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    AsyncJobQueue::~AsyncJobQueue()
+    {
+        try
+        {
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                mStop = true;
+            }
+            mConditionVariable.notify_all();
+            for (auto& thread : mThreads)
+                if (thread.joinable())
+                    thread.join();
+            if (!mErrorMessage.empty())
+                error(mErrorMessage, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void AsyncJobQueue::push(std::function<void()> job)
+    {
+        try
+        {
+            {
+                std::unique_lock<std::mutex> lock{mMutex};
+                mConditionVariable.wait(lock, [this]{ return mJobs.size() < mMaxQueueSize; });
+                throwPendingError();
+                mJobs.emplace_back(std::move(job));
+            }
+            mConditionVariable.notify_all();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void AsyncJobQueue::wait()
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{mMutex};
+            mConditionVariable.wait(lock, [this]{ return mJobs.empty() && mNumberRunningJobs == 0ull; });
+            throwPendingError();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void AsyncJobQueue::threadFunction()
+    {
+        while (true)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock{mMutex};
+                mConditionVariable.wait(lock, [this]{ return mStop || !mJobs.empty(); });
+                // The pending jobs are run before stopping
+                if (mJobs.empty())
+                    return;
+                job = std::move(mJobs.front());
+                mJobs.pop_front();
+                mNumberRunningJobs++;
+            }
+            mConditionVariable.notify_all();
+            std::string errorMessage;
+            try
+            {
+                job();
+            }
+            catch (const std::exception& e)
+            {
+                errorMessage = e.what();
+            }
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                if (!errorMessage.empty() && mErrorMessage.empty())
+                    mErrorMessage = errorMessage;
+                mNumberRunningJobs--;
+            }
+            mConditionVariable.notify_all();
+        }
+    }
+
+    void AsyncJobQueue::throwPendingError()
+    {
+        // mMutex must be locked
+        if (!mErrorMessage.empty())
+        {
+            const auto errorMessage = mErrorMessage;
+            mErrorMessage.clear();
+            error(errorMessage, __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::shared_ptr<AsyncJobQueue> createEncoderJobQueue(const int numberThreads)
+    {
+        try
+        {
+            // Synchronous
+            if (numberThreads == 0)
+                return nullptr;
+            // Default: up to 4, leaving half of the cores for the rest of the pipeline
+            const auto numberThreadsCleaned = (numberThreads > 0
+                ? (unsigned int)numberThreads : fastMax(1u, fastMin(4u, std::thread::hardware_concurrency() / 2u)));
+            return std::make_shared<AsyncJobQueue>(numberThreadsCleaned, 2ull*numberThreadsCleaned);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+}
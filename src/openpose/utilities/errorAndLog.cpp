@@ -1,10 +1,15 @@
 #include <openpose/utilities/errorAndLog.hpp>
+#include <algorithm> // std::sort
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
 #include <ctime> // std::tm, std::time_t
 #include <fstream> // std::ifstream, std::ofstream
 #include <iostream> // std::cout, std::endl
+#include <memory> // std::shared_ptr
 #include <stdexcept> // std::runtime_error
+#include <thread>
 
 namespace op
 {
@@ -111,12 +116,10 @@ namespace op
         return fullMessage;
     }
 
-    std::string getTime()
+    std::string getTime(const std::time_t rawtime = std::time(nullptr))
     {
         // Ubuntu version
-        std::time_t rawtime;
         struct std::tm timeStruct;
-        std::time(&rawtime);
         timeStruct = *localtime(&rawtime);
 
         // // Windows version
@@ -132,29 +135,55 @@ namespace op
                + '_' + std::to_string(timeStruct.tm_min) + '_' + std::to_string(timeStruct.tm_sec);
     }
 
-    void fileLogging(const std::string& message)
-    {
-        std::string fileToOpen{"errorLogging.txt"};
+    // errorLogging.txt is kept open (rather than re-opened for each message)
+    std::mutex sLoggingFileMutex;
+    std::ofstream sLoggingFile;
+    unsigned long long sLoggingFileBytes = 0ull;
 
-        // Get current file size
-        std::ifstream in{fileToOpen, std::ios::binary | std::ios::ate};
-        const auto currentSizeBytes = in.tellg();
-        in.close();
+    // It requires sLoggingFileMutex to be locked (so several messages can be written at once)
+    void fileLoggingUnlocked(const std::string& message, const std::string& time)
+    {
+        const std::string fileToOpen{"errorLogging.txt"};
+        const auto maxLogSize = 15ull * 1024 * 1024; // 15 MB
 
         // Continue at the end of the file or delete it and re-write it (according to current file size)
-        const auto maxLogSize = 15 * 1024 * 1024; // 15 MB
-        std::ofstream loggingFile{
-            fileToOpen, (currentSizeBytes < maxLogSize ? std::ios_base::app : std::ios_base::trunc)};
+        if (!sLoggingFile.is_open() || sLoggingFileBytes >= maxLogSize)
+        {
+            auto currentSizeBytes = sLoggingFileBytes;
+            if (!sLoggingFile.is_open())
+            {
+                std::ifstream in{fileToOpen, std::ios::binary | std::ios::ate};
+                const auto tellg = (long long)in.tellg();
+                currentSizeBytes = (unsigned long long)(tellg > 0 ? tellg : 0);
+            }
+            sLoggingFile.close();
+            sLoggingFile.clear();
+            const auto append = (currentSizeBytes < maxLogSize);
+            sLoggingFile.open(fileToOpen, (append ? std::ios_base::app : std::ios_base::trunc));
+            sLoggingFileBytes = (append ? currentSizeBytes : 0ull);
+        }
 
         // Message to write
-        loggingFile << getTime();
-        loggingFile << "\n";
-        loggingFile << message;
-        loggingFile << "\n\n\n\n\n";
+        sLoggingFile << time;
+        sLoggingFile << "\n";
+        sLoggingFile << message;
+        sLoggingFile << "\n\n\n\n\n";
+        sLoggingFileBytes += time.size() + message.size() + 6ull;
+    }
 
-        loggingFile.close();
+    void fileLogging(const std::string& message)
+    {
+        const std::lock_guard<std::mutex> lock{sLoggingFileMutex};
+        fileLoggingUnlocked(message, getTime());
+        sLoggingFile.flush();
     }
 
+    // Asynchronous logging (defined at the end, so its logger is destroyed before ConfigureLog's variables)
+    bool isLoggingAsynchronously();
+    void logAsynchronously(
+        const std::string& message, const int line, const std::string& function, const std::string& file);
+    void flushAsynchronousLog();
+
     void errorAux(
         const int errorMode, const std::string& message, const int line, const std::string& function,
         const std::string& file)
@@ -165,6 +194,9 @@ namespace op
         // 2: checkWorkerErrors
         // 3: errorDestructor
 
+        // Pending asynchronous messages are written first, so they are not printed after the error
+        flushAsynchronousLog();
+
         const std::string errorInitBase = "\nError";
         const std::string errorInit = errorInitBase + ":\n";
         const std::string errorEnum = "- ";
@@ -299,7 +331,10 @@ namespace op
         const std::string& message, const Priority priority, const int line, const std::string& function,
         const std::string& file)
     {
-        if (priority >= ConfigureLog::getPriorityThreshold())
+        // Asynchronous: only the raw message is enqueued, the logger thread composes and writes it
+        if (priority >= ConfigureLog::getPriorityThreshold() && isLoggingAsynchronously())
+            logAsynchronously(message, line, function, file);
+        else if (priority >= ConfigureLog::getPriorityThreshold())
         {
             const auto infoMessage = createFullMessage(message, line, function, file);
 
@@ -376,4 +411,282 @@ namespace op
             sLoggingModes = loggingModes;
         }
     }
+
+
+
+
+
+    // Asynchronous logging
+    // Capacity of the buffer of each thread (if full, the thread writes all the pending messages itself)
+    const auto LOG_QUEUE_CAPACITY = 1024ull;
+    // Maximum time between a message is enqueued and written
+    const auto LOG_FLUSH_PERIOD = std::chrono::milliseconds{10};
+
+    // Raw message, composed (createFullMessage() and getTime()) by the logger thread
+    struct LogRecord
+    {
+        unsigned long long sequence;
+        std::time_t time;
+        int line;
+        std::string message;
+        std::string function;
+        std::string file;
+    };
+
+    // Lock-free single-producer (its thread) single-consumer (the logger, see mDrainMutex) ring buffer
+    class LogQueue
+    {
+    public:
+        explicit LogQueue(const unsigned long long capacity) :
+            mRecords(capacity),
+            mHead{0ull},
+            mTail{0ull},
+            mOrphaned{false}
+        {
+        }
+
+        bool push(LogRecord& record)
+        {
+            const auto tail = mTail.load(std::memory_order_relaxed);
+            if (tail - mHead.load(std::memory_order_acquire) == mRecords.size())
+                return false;
+            mRecords[tail % mRecords.size()] = std::move(record);
+            mTail.store(tail + 1ull, std::memory_order_release);
+            return true;
+        }
+
+        bool pop(LogRecord& record)
+        {
+            const auto head = mHead.load(std::memory_order_relaxed);
+            if (head == mTail.load(std::memory_order_acquire))
+                return false;
+            record = std::move(mRecords[head % mRecords.size()]);
+            mHead.store(head + 1ull, std::memory_order_release);
+            return true;
+        }
+
+        // Its thread finished, so it can be removed once empty
+        bool isOrphaned() const
+        {
+            return mOrphaned.load(std::memory_order_acquire);
+        }
+
+        void setOrphaned()
+        {
+            mOrphaned.store(true, std::memory_order_release);
+        }
+
+    private:
+        std::vector<LogRecord> mRecords;
+        std::atomic<unsigned long long> mHead;
+        std::atomic<unsigned long long> mTail;
+        std::atomic<bool> mOrphaned;
+    };
+
+    struct LogQueueHolder
+    {
+        std::shared_ptr<LogQueue> spLogQueue;
+
+        ~LogQueueHolder()
+        {
+            if (spLogQueue != nullptr)
+                spLogQueue->setOrphaned();
+        }
+    };
+
+    // Whether this thread is writing the asynchronous messages (so errors while writing them do not flush again)
+    thread_local bool tIsDrainingLog = false;
+
+    class AsyncLogger
+    {
+    public:
+        AsyncLogger() :
+            mRunning{false},
+            mSequence{0ull},
+            mStopRequested{false}
+        {
+        }
+
+        ~AsyncLogger()
+        {
+            stop();
+        }
+
+        bool isRunning() const
+        {
+            return mRunning.load(std::memory_order_relaxed);
+        }
+
+        void start()
+        {
+            if (!mRunning)
+            {
+                mStopRequested = false;
+                mThread = std::thread{&AsyncLogger::loop, this};
+                mRunning = true;
+            }
+        }
+
+        void stop()
+        {
+            if (mRunning)
+            {
+                mRunning = false;
+                {
+                    const std::lock_guard<std::mutex> lock{mThreadMutex};
+                    mStopRequested = true;
+                }
+                mConditionVariable.notify_one();
+                if (mThread.joinable())
+                    mThread.join();
+                drain();
+            }
+        }
+
+        void push(const std::string& message, const int line, const std::string& function, const std::string& file)
+        {
+            LogRecord record{
+                mSequence.fetch_add(1ull, std::memory_order_relaxed), std::time(nullptr), line, message, function,
+                file};
+            auto& logQueue = getThreadLogQueue();
+            // Full buffer (e.g., burst of messages): this thread writes them itself, so no message is lost
+            while (!logQueue.push(record))
+                drain();
+        }
+
+        void drain()
+        {
+            if (tIsDrainingLog)
+                return;
+            const std::lock_guard<std::mutex> drainLock{mDrainMutex};
+            tIsDrainingLog = true;
+            // Pending messages of all threads, in the order they were enqueued
+            mRecords.clear();
+            {
+                const std::lock_guard<std::mutex> lock{mLogQueuesMutex};
+                for (auto i = 0u ; i < mLogQueues.size() ; )
+                {
+                    // Read before popping, so all the messages of an orphaned queue are popped
+                    const auto isOrphaned = mLogQueues[i]->isOrphaned();
+                    LogRecord record;
+                    while (mLogQueues[i]->pop(record))
+                        mRecords.emplace_back(std::move(record));
+                    if (isOrphaned)
+                        mLogQueues.erase(mLogQueues.begin() + i);
+                    else
+                        i++;
+                }
+            }
+            if (!mRecords.empty())
+            {
+                std::sort(mRecords.begin(), mRecords.end(),
+                          [](const LogRecord& a, const LogRecord& b) { return a.sequence < b.sequence; });
+                const auto stdCout = checkIfLoggingHas(LogMode::StdCout);
+                const auto fileLog = checkIfLoggingHas(LogMode::FileLogging);
+                std::unique_lock<std::mutex> fileLock{sLoggingFileMutex, std::defer_lock};
+                if (fileLog)
+                    fileLock.lock();
+                for (const auto& record : mRecords)
+                {
+                    const auto infoMessage = createFullMessage(
+                        record.message, record.line, record.function, record.file);
+                    // std::cout (flushed once for all the messages)
+                    if (stdCout)
+                        std::cout << infoMessage << "\n";
+                    // File logging
+                    if (fileLog)
+                        fileLoggingUnlocked(infoMessage, getTime(record.time));
+                    // Unity log
+                    #ifdef USE_UNITY_SUPPORT
+                        UnityDebugger::opLog(infoMessage);
+                    #endif
+                }
+                if (stdCout)
+                    std::cout.flush();
+                if (fileLog)
+                    sLoggingFile.flush();
+            }
+            tIsDrainingLog = false;
+        }
+
+    private:
+        std::atomic<bool> mRunning;
+        std::atomic<unsigned long long> mSequence;
+        // Consumer side (logger thread, ConfigureLog::flush(), or a thread whose buffer is full)
+        std::mutex mDrainMutex;
+        std::vector<LogRecord> mRecords;
+        std::mutex mLogQueuesMutex;
+        std::vector<std::shared_ptr<LogQueue>> mLogQueues;
+        // Logger thread
+        std::mutex mThreadMutex;
+        std::condition_variable mConditionVariable;
+        bool mStopRequested;
+        std::thread mThread;
+
+        LogQueue& getThreadLogQueue()
+        {
+            // Registered once per thread, the only locking of the producer side
+            thread_local LogQueueHolder logQueueHolder;
+            if (logQueueHolder.spLogQueue == nullptr)
+            {
+                logQueueHolder.spLogQueue = std::make_shared<LogQueue>(LOG_QUEUE_CAPACITY);
+                const std::lock_guard<std::mutex> lock{mLogQueuesMutex};
+                mLogQueues.emplace_back(logQueueHolder.spLogQueue);
+            }
+            return *logQueueHolder.spLogQueue;
+        }
+
+        void loop()
+        {
+            auto stopRequested = false;
+            while (!stopRequested)
+            {
+                std::unique_lock<std::mutex> lock{mThreadMutex};
+                mConditionVariable.wait_for(lock, LOG_FLUSH_PERIOD, [this]{ return mStopRequested; });
+                stopRequested = mStopRequested;
+                lock.unlock();
+                drain();
+            }
+        }
+    };
+
+    AsyncLogger sAsyncLogger;
+
+    bool isLoggingAsynchronously()
+    {
+        return sAsyncLogger.isRunning();
+    }
+
+    void logAsynchronously(
+        const std::string& message, const int line, const std::string& function, const std::string& file)
+    {
+        sAsyncLogger.push(message, line, function, file);
+    }
+
+    void flushAsynchronousLog()
+    {
+        if (sAsyncLogger.isRunning())
+            sAsyncLogger.drain();
+    }
+
+    namespace ConfigureLog
+    {
+        bool getAsynchronous()
+        {
+            return isLoggingAsynchronously();
+        }
+
+        void setAsynchronous(const bool asynchronous)
+        {
+            if (asynchronous)
+                sAsyncLogger.start();
+            else
+                sAsyncLogger.stop();
+        }
+
+        void flush()
+        {
+            flushAsynchronousLog();
+        }
+    }
 }
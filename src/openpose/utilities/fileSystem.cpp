@@ -12,50 +12,64 @@
 #else
     #error Unknown environment!
 #endif
+#include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/string.hpp>
 
 namespace op
 {
-    bool compareNat(const std::string& a, const std::string& b)
+    // Natural-order key of a string, so that natural sorting becomes a plain (allocation-free) string comparison.
+    // Text characters are kept upper-cased, while each number is encoded as '\x01' + its number of digits (2
+    // bytes, big endian) + its digits (without leading 0s). Given that std::char_traits<char> compares unsigned
+    // chars, digits go before text, shorter numbers before longer ones, and an empty (i.e., finished) string first.
+    std::string getNaturalKey(const std::string& string)
     {
-        // If any is empty, that one is shorter
-        if (a.empty())
-            return true;
-        else if (b.empty())
-            return false;
-        // If one is digit, return that one
-        else if (std::isdigit(a[0]) && !std::isdigit(b[0]))
-            return true;
-        else if (!std::isdigit(a[0]) && std::isdigit(b[0]))
-            return false;
-        // If none is digit, compare those strings
-        else if (!std::isdigit(a[0]) && !std::isdigit(b[0]))
-        {
-            if (std::toupper(a[0]) == std::toupper(b[0]))
-                return compareNat(a.substr(1), b.substr(1));
-            return (std::toupper(a[0]) < std::toupper(b[0]));
-        }
-        // Both strings begin with digit
-        else
-        {
-            // Remove 0s at the beginning
-            const std::string aNo0s = remove0sFromString(a);
-            const std::string bNo0s = remove0sFromString(b);
-            // Get only number
-            const std::string aNumberAsString = getFirstNumberOnString(aNo0s);
-            const std::string bNumberAsString = getFirstNumberOnString(bNo0s);
-            // 1 number is longer --> it is bigger
-            if (aNumberAsString.size() != bNumberAsString.size())
-                return aNumberAsString.size() < bNumberAsString.size();
-            // Both same length --> Compare them
-            for (auto i = 0u ; i < aNumberAsString.size() ; ++i)
-                if (aNumberAsString[i] != bNumberAsString[i])
-                    return aNumberAsString[i] < bNumberAsString[i];
-            // Both same number --> Remove and return compareNat after removing those characters
-            const std::string aWithoutFirstNumber = aNo0s.substr(aNumberAsString.size(), aNo0s.size());
-            const std::string bWithoutFirstNumber = bNo0s.substr(bNumberAsString.size(), bNo0s.size());
-            // Number removed, compared the rest of the string
-            return compareNat(aWithoutFirstNumber, bWithoutFirstNumber);
+        std::string key;
+        key.reserve(string.size() + 8);
+        for (auto i = 0u ; i < string.size() ; )
+        {
+            if (std::isdigit((unsigned char)string[i]))
+            {
+                // Remove 0s at the beginning (keeping one if the number is 0)
+                auto numberEnd = i;
+                while (numberEnd < string.size() && std::isdigit((unsigned char)string[numberEnd]))
+                    numberEnd++;
+                while (i+1 < numberEnd && string[i] == '0')
+                    i++;
+                const auto numberLength = fastMin(numberEnd - i, 0xFFFFu);
+                key.push_back('\x01');
+                key.push_back((char)(numberLength >> 8));
+                key.push_back((char)(numberLength & 0xFF));
+                key.append(string, i, numberLength);
+                i = numberEnd;
+            }
+            else
+                key.push_back((char)std::toupper((unsigned char)string[i++]));
+        }
+        return key;
+    }
+
+    std::vector<std::string> getExtensionNames(const Extensions extensions)
+    {
+        try
+        {
+            if (extensions == Extensions::Images)
+                return {
+                    // Completely supported by OpenCV
+                    "bmp", "dib", "pbm", "pgm", "ppm", "sr", "ras",
+                    // Most of them supported by OpenCV
+                    "jpg", "jpeg", "png"};
+            // Unknown kind of extensions
+            else
+            {
+                error("Unknown kind of extensions (id = " + std::to_string(int(extensions))
+                      + "). Notify us of this error.", __LINE__, __FUNCTION__, __FILE__);
+                return {};
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
         }
     }
 
@@ -296,25 +310,9 @@ namespace op
         }
     }
 
-    bool extensionIsDesired(const std::string& extension, const std::vector<std::string>& extensions)
-    {
-        try
-        {
-            const auto cleanedExtension = toLower(removeExtensionDot(extension));
-            for (auto& extensionI : extensions)
-                if (cleanedExtension == toLower(removeExtensionDot(extensionI)))
-                    return true;
-            return false;
-        }
-        catch (const std::exception& e)
-        {
-            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return false;
-        }
-    }
-
-    std::vector<std::string> getFilesOnDirectory(const std::string& directoryPath,
-                                                 const std::vector<std::string>& extensions)
+    unsigned long long forEachFileOnDirectory(
+        const std::string& directoryPath, const std::vector<std::string>& extensions,
+        const std::function<void(std::string&&)>& onFile)
     {
         try
         {
@@ -323,8 +321,21 @@ namespace op
             // Check folder exits
             if (!existDirectory(formatedPath))
                 error("Folder " + formatedPath + " does not exist.", __LINE__, __FUNCTION__, __FILE__);
+            // Clean the desired extensions only once
+            std::vector<std::string> cleanedExtensions;
+            for (const auto& extension : extensions)
+                cleanedExtensions.emplace_back(toLower(removeExtensionDot(extension)));
+            const auto isDesired = [&](const std::string& filePath)
+            {
+                if (cleanedExtensions.empty())
+                    return true;
+                const auto extension = toLower(getFileExtension(filePath));
+                return std::find(cleanedExtensions.begin(), cleanedExtensions.end(), extension)
+                    != cleanedExtensions.end();
+            };
             // Read all files in folder
-            std::vector<std::string> filePaths;
+            auto numberFiles = 0ull;
+            auto numberDesiredFiles = 0ull;
             #ifdef _WIN32
                 auto formatedPathWindows = formatedPath;
                 formatedPathWindows.append("\\*");
@@ -333,7 +344,18 @@ namespace op
                 if ((hFind = FindFirstFile(formatedPathWindows.c_str(), &data)) != INVALID_HANDLE_VALUE)
                 {
                     do
-                        filePaths.emplace_back(formatedPath + data.cFileName);
+                    {
+                        std::string currentPath = formatedPath + data.cFileName;
+                        if ((strncmp(data.cFileName, ".", 1) == 0)
+                            || (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+                            continue;
+                        numberFiles++;
+                        if (isDesired(currentPath))
+                        {
+                            numberDesiredFiles++;
+                            onFile(std::move(currentPath));
+                        }
+                    }
                     while (FindNextFile(hFind, &data) != 0);
                     FindClose(hFind);
                 }
@@ -345,32 +367,96 @@ namespace op
                 struct dirent* direntPtr;
                 while ((direntPtr = readdir(directoryPtr.get())) != nullptr)
                 {
+                    if (strncmp(direntPtr->d_name, ".", 1) == 0)
+                        continue;
                     std::string currentPath = formatedPath + direntPtr->d_name;
-                    if ((strncmp(direntPtr->d_name, ".", 1) == 0) || existDirectory(currentPath))
+                    // d_type avoids opening each entry, but some file systems do not fill it (DT_UNKNOWN)
+                    #ifdef _DIRENT_HAVE_D_TYPE
+                        if (direntPtr->d_type == DT_DIR
+                            || ((direntPtr->d_type == DT_UNKNOWN || direntPtr->d_type == DT_LNK)
+                                && existDirectory(currentPath)))
+                            continue;
+                    #else
+                        if (existDirectory(currentPath))
                             continue;
-                    filePaths.emplace_back(currentPath);
+                    #endif
+                    numberFiles++;
+                    if (isDesired(currentPath))
+                    {
+                        numberDesiredFiles++;
+                        onFile(std::move(currentPath));
+                    }
                 }
             #else
                 #error Unknown environment!
             #endif
             // Check #files > 0
-            if (filePaths.empty())
+            if (numberFiles == 0)
                 error("No files were found on " + formatedPath, __LINE__, __FUNCTION__, __FILE__);
-            // If specific extensions specified
-            if (!extensions.empty())
-            {
-                // Read images
-                std::vector<std::string> specificExtensionPaths;
-                specificExtensionPaths.reserve(filePaths.size());
-                for (const auto& filePath : filePaths)
-                    if (extensionIsDesired(getFileExtension(filePath), extensions))
-                        specificExtensionPaths.emplace_back(filePath);
-                std::swap(filePaths, specificExtensionPaths);
-            }
+            return numberDesiredFiles;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    unsigned long long forEachFileOnDirectory(
+        const std::string& directoryPath, const Extensions extensions,
+        const std::function<void(std::string&&)>& onFile)
+    {
+        try
+        {
+            return forEachFileOnDirectory(directoryPath, getExtensionNames(extensions), onFile);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    void sortNatural(std::vector<std::string>& strings)
+    {
+        try
+        {
+            // Tokenize each string only once, and sort its indexes by key (so no string is copied while sorting)
+            std::vector<std::string> keys;
+            keys.reserve(strings.size());
+            for (const auto& string : strings)
+                keys.emplace_back(getNaturalKey(string));
+            std::vector<std::size_t> indexes(strings.size());
+            for (auto i = 0u ; i < indexes.size() ; i++)
+                indexes[i] = i;
+            std::sort(indexes.begin(), indexes.end(),
+                      [&](const std::size_t a, const std::size_t b){ return keys[a] < keys[b]; });
+            // Move the strings into their sorted positions
+            std::vector<std::string> sortedStrings;
+            sortedStrings.reserve(strings.size());
+            for (const auto index : indexes)
+                sortedStrings.emplace_back(std::move(strings[index]));
+            std::swap(strings, sortedStrings);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<std::string> getFilesOnDirectory(const std::string& directoryPath,
+                                                 const std::vector<std::string>& extensions)
+    {
+        try
+        {
+            // Read all files in folder with the desired extensions
+            std::vector<std::string> filePaths;
+            forEachFileOnDirectory(
+                directoryPath, extensions, [&](std::string&& filePath){ filePaths.emplace_back(std::move(filePath)); });
             // // Sort alphabetically
             // std::sort(filePaths.begin(), filePaths.end());
             // Natural sort
-            std::sort(filePaths.begin(), filePaths.end(), compareNat);
+            sortNatural(filePaths);
             // Return result
             return filePaths;
         }
@@ -399,22 +485,7 @@ namespace op
         try
         {
             // Get files on directory with the desired extensions
-            if (extensions == Extensions::Images)
-            {
-                const std::vector<std::string> extensionNames{
-                    // Completely supported by OpenCV
-                    "bmp", "dib", "pbm", "pgm", "ppm", "sr", "ras",
-                    // Most of them supported by OpenCV
-                    "jpg", "jpeg", "png"};
-                return getFilesOnDirectory(directoryPath, extensionNames);
-            }
-            // Unknown kind of extensions
-            else
-            {
-                error("Unknown kind of extensions (id = " + std::to_string(int(extensions))
-                      + "). Notify us of this error.", __LINE__, __FUNCTION__, __FILE__);
-                return {};
-            }
+            return getFilesOnDirectory(directoryPath, getExtensionNames(extensions));
         }
         catch (const std::exception& e)
         {
@@ -1,6 +1,7 @@
 #include <openpose/utilities/flagsToOpenPose.hpp>
 #include <cstdio> // sscanf
 #include <openpose/utilities/check.hpp>
+#include <openpose/utilities/string.hpp>
 
 namespace op
 {
@@ -161,9 +162,51 @@ namespace op
         }
     }
 
+    ThreadPriority flagsToThreadPriority(const int threadPriority)
+    {
+        try
+        {
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            if (threadPriority >= 0 && threadPriority < (int)ThreadPriority::Size)
+                return (ThreadPriority)threadPriority;
+            else
+            {
+                error("Value (" + std::to_string(threadPriority) + ") does not correspond with any ThreadPriority.",
+                      __LINE__, __FUNCTION__, __FILE__);
+                return ThreadPriority::Default;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return ThreadPriority::Default;
+        }
+    }
+
+    QueueType flagsToQueueType(const int queueType)
+    {
+        try
+        {
+            opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            if (queueType >= 0 && queueType < (int)QueueType::Size)
+                return (QueueType)queueType;
+            else
+            {
+                error("Value (" + std::to_string(queueType) + ") does not correspond with any QueueType.",
+                      __LINE__, __FUNCTION__, __FILE__);
+                return QueueType::Mutex;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return QueueType::Mutex;
+        }
+    }
+
     ProducerType flagsToProducerType(
         const String& imageDirectory, const String& videoPath, const String& ipCameraPath,
-        const int webcamIndex, const bool flirCamera)
+        const int webcamIndex, const bool flirCamera, const String& replayPath, const String& sharedMemoryName)
     {
         try
         {
@@ -171,19 +214,29 @@ namespace op
             const std::string& imageDirectoryStd = imageDirectory.getStdString();
             const std::string& videoPathStd = videoPath.getStdString();
             const std::string& ipCameraPathStd = ipCameraPath.getStdString();
+            const std::string& replayPathStd = replayPath.getStdString();
+            const std::string& sharedMemoryNameStd = sharedMemoryName.getStdString();
             // Avoid duplicates (e.g., selecting at the time camera & video)
             if (int(!imageDirectoryStd.empty()) + int(!videoPathStd.empty()) + int(webcamIndex > 0)
-                + int(flirCamera) + int(!ipCameraPathStd.empty()) > 1)
+                + int(flirCamera) + int(!ipCameraPathStd.empty()) + int(!replayPathStd.empty())
+                + int(!sharedMemoryNameStd.empty()) > 1)
                 error("Selected simultaneously"
                       " image directory (seletected: " + (imageDirectoryStd.empty() ? "no" : imageDirectoryStd) + "),"
                       " video (seletected: " + (videoPathStd.empty() ? "no" : videoPathStd) + "),"
                       " camera (selected: " + (webcamIndex > 0 ? std::to_string(webcamIndex) : "no") + "),"
                       " flirCamera (selected: " + (flirCamera ? "yes" : "no") + ","
-                      " and/or IP camera (selected: " + (ipCameraPathStd.empty() ? "no" : ipCameraPathStd) + ")."
+                      " IP camera (selected: " + (ipCameraPathStd.empty() ? "no" : ipCameraPathStd) + "),"
+                      " input replay (selected: " + (replayPathStd.empty() ? "no" : replayPathStd) + "),"
+                      " and/or shared memory input (selected: "
+                      + (sharedMemoryNameStd.empty() ? "no" : sharedMemoryNameStd) + ")."
                       " Please, select only one.", __LINE__, __FUNCTION__, __FILE__);
 
             // Get desired ProducerType
-            if (!imageDirectoryStd.empty())
+            if (!replayPathStd.empty())
+                return ProducerType::Replay;
+            else if (!sharedMemoryNameStd.empty())
+                return ProducerType::SharedMemory;
+            else if (!imageDirectoryStd.empty())
                 return ProducerType::ImageDirectory;
             else if (!videoPathStd.empty())
                 return ProducerType::Video;
@@ -203,15 +256,20 @@ namespace op
 
     std::pair<ProducerType, String> flagsToProducer(
         const String& imageDirectory, const String& videoPath, const String& ipCameraPath,
-        const int webcamIndex, const bool flirCamera, const int flirCameraIndex)
+        const int webcamIndex, const bool flirCamera, const int flirCameraIndex, const String& replayPath,
+        const String& sharedMemoryName)
     {
         try
         {
             opLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             const auto type = flagsToProducerType(
-                imageDirectory, videoPath, ipCameraPath, webcamIndex, flirCamera);
+                imageDirectory, videoPath, ipCameraPath, webcamIndex, flirCamera, replayPath, sharedMemoryName);
 
-            if (type == ProducerType::ImageDirectory)
+            if (type == ProducerType::Replay)
+                return std::make_pair(ProducerType::Replay, replayPath);
+            else if (type == ProducerType::SharedMemory)
+                return std::make_pair(ProducerType::SharedMemory, sharedMemoryName);
+            else if (type == ProducerType::ImageDirectory)
                 return std::make_pair(ProducerType::ImageDirectory, imageDirectory);
             else if (type == ProducerType::Video)
                 return std::make_pair(ProducerType::Video, videoPath);
@@ -340,4 +398,99 @@ namespace op
             return Point<int>{};
         }
     }
+
+    std::vector<std::vector<Point<int>>> flagsToInputRois(const String& inputRoisString)
+    {
+        try
+        {
+            std::vector<std::vector<Point<int>>> inputRois;
+            if (inputRoisString.getStdString().empty())
+                return inputRois;
+            for (const auto& inputRoiString : splitString(inputRoisString.getStdString(), ";"))
+            {
+                std::vector<Point<int>> inputRoi;
+                for (const auto& pointString : splitString(inputRoiString, " "))
+                {
+                    if (pointString.empty())
+                        continue;
+                    Point<int> point;
+                    const auto nRead = sscanf(pointString.c_str(), "%d,%d", &point.x, &point.y);
+                    checkEqual(
+                        nRead, 2, "Invalid input ROI point: `" + pointString + "`, it should be e.g., `0,300`.",
+                        __LINE__, __FUNCTION__, __FILE__);
+                    inputRoi.emplace_back(point);
+                }
+                if (inputRoi.size() < 2)
+                    error("Invalid input ROI: `" + inputRoiString + "`, it needs at least 2 points (e.g., `0,300"
+                          " 1920,1080`).", __LINE__, __FUNCTION__, __FILE__);
+                inputRois.emplace_back(inputRoi);
+            }
+            return inputRois;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::vector<double> flagsToDoubles(const String& doublesString)
+    {
+        try
+        {
+            std::vector<double> doubles;
+            if (doublesString.getStdString().empty())
+                return doubles;
+            for (const auto& doubleString : splitString(doublesString.getStdString(), ","))
+            {
+                double value;
+                char trailing;
+                const auto nRead = sscanf(doubleString.c_str(), "%lf%c", &value, &trailing);
+                checkEqual(
+                    nRead, 1, "Invalid number: `" + doubleString + "` in `" + doublesString.getStdString() + "`.",
+                    __LINE__, __FUNCTION__, __FILE__);
+                doubles.emplace_back(value);
+            }
+            return doubles;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    DatumWireField flagsToDatumWireFields(const String& datumWireFieldsString)
+    {
+        try
+        {
+            auto datumWireFields = DatumWireField::None;
+            for (const auto& fieldString : splitString(datumWireFieldsString.getStdString(), ","))
+            {
+                const auto field = toLower(fieldString);
+                if (field == "frame")
+                    datumWireFields = datumWireFields | DatumWireField::Frame;
+                else if (field == "net_input")
+                    datumWireFields = datumWireFields | DatumWireField::NetInput;
+                else if (field == "keypoints")
+                    datumWireFields = datumWireFields | DatumWireField::Keypoints;
+                else if (field == "keypoints_3d")
+                    datumWireFields = datumWireFields | DatumWireField::Keypoints3D;
+                else if (field == "output_frame")
+                    datumWireFields = datumWireFields | DatumWireField::OutputFrame;
+                else if (field == "all")
+                    datumWireFields = datumWireFields | DatumWireField::All;
+                else if (!field.empty())
+                    error("Unknown Datum field `" + fieldString + "` in `" + datumWireFieldsString.getStdString()
+                          + "` (the options are `frame`, `net_input`, `keypoints`, `keypoints_3d`, `output_frame`"
+                          " and `all`).", __LINE__, __FUNCTION__, __FILE__);
+            }
+            return datumWireFields;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return DatumWireField::None;
+        }
+    }
 }
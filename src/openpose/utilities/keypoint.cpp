@@ -1,7 +1,9 @@
 #include <openpose/utilities/keypoint.hpp>
+#include <cmath> // std::sqrt
 #include <limits> // std::numeric_limits
-#include <opencv2/imgproc/imgproc.hpp> // cv::line, cv::circle
+#include <openpose/core/arrayView.hpp>
 #include <openpose/utilities/fastMath.hpp>
+#include <openpose_private/utilities/renderCpu.hpp>
 
 namespace op
 {
@@ -173,6 +175,36 @@ namespace op
         Array<double>& keypoints, const double scaleX, const double scaleY, const double offsetX,
         const double offsetY);
 
+    template <typename T>
+    void offsetKeypoints2d(Array<T>& keypoints, const T offsetX, const T offsetY)
+    {
+        try
+        {
+            if (!keypoints.empty() && (offsetX != T(0) || offsetY != T(0)))
+            {
+                // Error check
+                if (keypoints.getSize(keypoints.getNumberDimensions()-1) != 3)
+                    error(errorMessage, __LINE__, __FUNCTION__, __FILE__);
+                // For each (x,y,score) element
+                const auto volume = (int)keypoints.getVolume();
+                for (auto index = 0 ; index < volume ; index += 3)
+                {
+                    if (keypoints[index+2] > T(0))
+                    {
+                        keypoints[index] += offsetX;
+                        keypoints[index+1] += offsetY;
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+    template OP_API void offsetKeypoints2d(Array<float>& keypoints, const float offsetX, const float offsetY);
+    template OP_API void offsetKeypoints2d(Array<double>& keypoints, const double offsetX, const double offsetY);
+
     template <typename T>
     void renderKeypointsCpu(
         Array<T>& frameArray, const Array<T>& keypoints, const std::vector<unsigned int>& pairs,
@@ -183,29 +215,23 @@ namespace op
         {
             if (!frameArray.empty())
             {
-                // Array<T> --> cv::Mat
-                auto frame = frameArray.getCvMat();
-                cv::Mat cvFrame = OP_OP2CVMAT(frame);
-
                 // Sanity check
-                if (cvFrame.channels() != 3)
+                if (frameArray.getNumberDimensions() != 3 || frameArray.getSize(2) != 3)
                     error(errorMessage, __LINE__, __FUNCTION__, __FILE__);
 
                 // Get frame channels
-                const auto width = cvFrame.size[1];
-                const auto height = cvFrame.size[0];
+                const auto width = frameArray.getSize(1);
+                const auto height = frameArray.getSize(0);
                 const auto area = width * height;
-                cv::Mat frameBGR(height, width, CV_32FC3, cvFrame.data);
 
                 // Parameters
-                const auto lineType = 8;
-                const auto shift = 0;
                 const auto numberColors = colors.size();
                 const auto numberScales = poseScales.size();
                 const auto thresholdRectangle = T(0.1);
                 const auto numberKeypoints = keypoints.getSize(1);
 
                 // Keypoints
+                std::vector<RenderPrimitiveCpu<T>> primitives;
                 for (auto person = 0 ; person < keypoints.getSize(0) ; person++)
                 {
                     const auto personRectangle = getKeypointsRectangle(keypoints, person, thresholdRectangle);
@@ -217,13 +243,12 @@ namespace op
                         // Size-dependent variables
                         const auto thicknessRatio = fastMax(
                             positiveIntRound(std::sqrt(area)* thicknessCircleRatio * ratioAreas), 2);
-                        // Negative thickness in cv::circle means that a filled circle is to be drawn.
                         const auto thicknessCircle = fastMax(1, (ratioAreas > T(0.05) ? thicknessRatio : -1));
                         const auto thicknessLine = fastMax(
                             1, positiveIntRound(thicknessRatio * thicknessLineRatioWRTCircle));
                         const auto radius = thicknessRatio / 2;
 
-                        // Draw lines
+                        // Lines (capsules)
                         for (auto pair = 0u ; pair < pairs.size() ; pair+=2)
                         {
                             const auto index1 = (person * numberKeypoints + pairs[pair]) * keypoints.getSize(2);
@@ -233,20 +258,16 @@ namespace op
                                 const auto thicknessLineScaled = positiveIntRound(
                                     thicknessLine * poseScales[pairs[pair+1] % numberScales]);
                                 const auto colorIndex = pairs[pair+1]*3; // Before: colorIndex = pair/2*3;
-                                const cv::Scalar color{
-                                    colors[(colorIndex+2) % numberColors],
-                                    colors[(colorIndex+1) % numberColors],
-                                    colors[colorIndex % numberColors]
-                                };
-                                const cv::Point keypoint1{
-                                    positiveIntRound(keypoints[index1]), positiveIntRound(keypoints[index1+1])};
-                                const cv::Point keypoint2{
-                                    positiveIntRound(keypoints[index2]), positiveIntRound(keypoints[index2+1])};
-                                cv::line(frameBGR, keypoint1, keypoint2, color, thicknessLineScaled, lineType, shift);
+                                primitives.emplace_back(RenderPrimitiveCpu<T>{
+                                    keypoints[index1], keypoints[index1+1], keypoints[index2], keypoints[index2+1],
+                                    T(0.5)*thicknessLineScaled, T(0),
+                                    {colors[(colorIndex+2) % numberColors], colors[(colorIndex+1) % numberColors],
+                                     colors[colorIndex % numberColors]}});
                             }
                         }
 
-                        // Draw circles
+                        // Circles (rings of width thicknessCircleScaled, i.e., discs if it is >= 2*radiusScaled),
+                        // drawn over the lines
                         for (auto part = 0 ; part < numberKeypoints ; part++)
                         {
                             const auto faceIndex = (person * numberKeypoints + part) * keypoints.getSize(2);
@@ -256,19 +277,19 @@ namespace op
                                 const auto thicknessCircleScaled = positiveIntRound(
                                     thicknessCircle * poseScales[part % numberScales]);
                                 const auto colorIndex = part*3;
-                                const cv::Scalar color{
-                                    colors[(colorIndex+2) % numberColors],
-                                    colors[(colorIndex+1) % numberColors],
-                                    colors[colorIndex % numberColors]
-                                };
-                                const cv::Point center{positiveIntRound(keypoints[faceIndex]),
-                                                       positiveIntRound(keypoints[faceIndex+1])};
-                                cv::circle(frameBGR, center, radiusScaled, color, thicknessCircleScaled, lineType,
-                                           shift);
+                                primitives.emplace_back(RenderPrimitiveCpu<T>{
+                                    keypoints[faceIndex], keypoints[faceIndex+1], keypoints[faceIndex],
+                                    keypoints[faceIndex+1], radiusScaled + T(0.5)*thicknessCircleScaled,
+                                    radiusScaled - T(0.5)*thicknessCircleScaled,
+                                    {colors[(colorIndex+2) % numberColors], colors[(colorIndex+1) % numberColors],
+                                     colors[colorIndex % numberColors]}});
                             }
                         }
                     }
                 }
+
+                // Anti-aliased and tile-parallel, only touching the bounding boxes of the lines and circles
+                renderPrimitivesCpu(frameArray.getPtr(), width, height, primitives);
             }
         }
         catch (const std::exception& e)
@@ -358,11 +379,10 @@ namespace op
                 error("Person index out of bounds.", __LINE__, __FUNCTION__, __FILE__);
             // Get average score
             T score = T(0);
-            const auto numberKeypoints = keypoints.getSize(1);
-            const auto area = numberKeypoints * keypoints.getSize(2);
-            const auto personOffset = person * area;
+            const ArrayView3<const T> keypointsView{keypoints};
+            const auto numberKeypoints = keypointsView.getSize(1);
             for (auto part = 0 ; part < numberKeypoints ; part++)
-                score += keypoints[personOffset + part*keypoints.getSize(2) + 2];
+                score += keypointsView(person, part, 2);
             return score / numberKeypoints;
         }
         catch (const std::exception& e)
@@ -435,9 +455,9 @@ namespace op
                     error("Person index out of range.", __LINE__, __FUNCTION__, __FILE__);
                 // Count keypoints
                 auto nonZeroCounter = 0;
-                const auto baseIndex = person * (int)keypoints.getVolume(1,2);
-                for (auto part = 0 ; part < keypoints.getSize(1) ; part++)
-                    if (keypoints[baseIndex + 3*part + 2] >= threshold)
+                const ArrayView3<const T> keypointsView{keypoints};
+                for (auto part = 0 ; part < keypointsView.getSize(1) ; part++)
+                    if (keypointsView(person, part, 2) >= threshold)
                         nonZeroCounter++;
                 return nonZeroCounter;
             }
@@ -487,14 +507,16 @@ namespace op
             // Get total distance
             T totalDistance = 0;
             int nonZeroCounter = 0;
-            const auto baseIndexA = personA * (int)keypointsA.getVolume(1,2);
-            const auto baseIndexB = personB * (int)keypointsB.getVolume(1,2);
-            for (auto part = 0 ; part < keypointsA.getSize(1) ; part++)
+            const ArrayView3<const T> keypointsViewA{keypointsA};
+            const ArrayView3<const T> keypointsViewB{keypointsB};
+            for (auto part = 0 ; part < keypointsViewA.getSize(1) ; part++)
             {
-                if (keypointsA[baseIndexA+3*part+2] >= threshold && keypointsB[baseIndexB+3*part+2] >= threshold)
+                const auto* const keypointPtrA = keypointsViewA.getPtr(personA, part);
+                const auto* const keypointPtrB = keypointsViewB.getPtr(personB, part);
+                if (keypointPtrA[2] >= threshold && keypointPtrB[2] >= threshold)
                 {
-                    const auto x = keypointsA[baseIndexA+3*part] - keypointsB[baseIndexB+3*part];
-                    const auto y = keypointsA[baseIndexA+3*part+1] - keypointsB[baseIndexB+3*part+1];
+                    const auto x = keypointPtrA[0] - keypointPtrB[0];
+                    const auto y = keypointPtrA[1] - keypointPtrB[1];
                     totalDistance += T(std::sqrt(x*x+y*y));
                     nonZeroCounter++;
                 }
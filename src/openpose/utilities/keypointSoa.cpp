@@ -0,0 +1,525 @@
+#include <openpose/utilities/keypointSoa.hpp>
+#include <cmath> // std::sqrt
+#include <cstdint> // uintptr_t
+#include <limits> // std::numeric_limits
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/keypoint.hpp>
+#include <openpose_private/utilities/avx.hpp>
+
+namespace op
+{
+    const auto SOA_LANES = 8; // 8 floats = 32 bytes (1 AVX register)
+
+    // 32-byte aligned buffer of size floats, initialized to 0
+    std::shared_ptr<float> alignedFloatBuffer(const size_t size)
+    {
+        try
+        {
+            auto* const rawPtr = new float[size + SOA_LANES - 1]();
+            auto* const alignedPtr = (float*)(((uintptr_t)rawPtr + 31) & ~(uintptr_t)31);
+            return std::shared_ptr<float>(alignedPtr, [rawPtr](float*) { delete[] rawPtr; });
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    #ifdef WITH_AVX
+        OP_TARGET_AVX2 inline float horizontalMinAvx2(const __m256 value)
+        {
+            auto min4 = _mm_min_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1));
+            min4 = _mm_min_ps(min4, _mm_movehl_ps(min4, min4));
+            min4 = _mm_min_ss(min4, _mm_shuffle_ps(min4, min4, 1));
+            return _mm_cvtss_f32(min4);
+        }
+
+        OP_TARGET_AVX2 inline float horizontalMaxAvx2(const __m256 value)
+        {
+            auto max4 = _mm_max_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1));
+            max4 = _mm_max_ps(max4, _mm_movehl_ps(max4, max4));
+            max4 = _mm_max_ss(max4, _mm_shuffle_ps(max4, max4, 1));
+            return _mm_cvtss_f32(max4);
+        }
+
+        OP_TARGET_AVX2 inline float horizontalSumAvx2(const __m256 value)
+        {
+            auto sum4 = _mm_add_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1));
+            sum4 = _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4));
+            sum4 = _mm_add_ss(sum4, _mm_shuffle_ps(sum4, sum4, 1));
+            return _mm_cvtss_f32(sum4);
+        }
+
+        // Lanes of [index, index+8) inside [firstIndex, lastIndex)
+        OP_TARGET_AVX2 inline __m256 rangeMaskAvx2(const int index, const int firstIndex, const int lastIndex)
+        {
+            const auto indexes = _mm256_add_epi32(
+                _mm256_set1_epi32(index), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+            const auto mask = _mm256_and_si256(
+                _mm256_cmpgt_epi32(indexes, _mm256_set1_epi32(firstIndex - 1)),
+                _mm256_cmpgt_epi32(_mm256_set1_epi32(lastIndex), indexes));
+            return _mm256_castsi256_ps(mask);
+        }
+
+        OP_TARGET_AVX2 void getRectangleAvx2(
+            float& minX, float& maxX, float& minY, float& maxY, const float* const xPtr, const float* const yPtr,
+            const float* const scorePtr, const float threshold, const int firstIndex, const int lastIndex)
+        {
+            auto minXAvx = _mm256_set1_ps(minX);
+            auto maxXAvx = _mm256_set1_ps(maxX);
+            auto minYAvx = minXAvx;
+            auto maxYAvx = maxXAvx;
+            const auto thresholdAvx = _mm256_set1_ps(threshold);
+            for (auto part = firstIndex - firstIndex % SOA_LANES ; part < lastIndex ; part += SOA_LANES)
+            {
+                const auto valid = _mm256_and_ps(
+                    rangeMaskAvx2(part, firstIndex, lastIndex),
+                    _mm256_cmp_ps(_mm256_load_ps(scorePtr + part), thresholdAvx, _CMP_GT_OQ));
+                const auto x = _mm256_load_ps(xPtr + part);
+                const auto y = _mm256_load_ps(yPtr + part);
+                minXAvx = _mm256_blendv_ps(minXAvx, _mm256_min_ps(minXAvx, x), valid);
+                maxXAvx = _mm256_blendv_ps(maxXAvx, _mm256_max_ps(maxXAvx, x), valid);
+                minYAvx = _mm256_blendv_ps(minYAvx, _mm256_min_ps(minYAvx, y), valid);
+                maxYAvx = _mm256_blendv_ps(maxYAvx, _mm256_max_ps(maxYAvx, y), valid);
+            }
+            minX = horizontalMinAvx2(minXAvx);
+            maxX = horizontalMaxAvx2(maxXAvx);
+            minY = horizontalMinAvx2(minYAvx);
+            maxY = horizontalMaxAvx2(maxYAvx);
+        }
+
+        // The padded scores are 0, so they do not change the sum
+        // Valid lanes are -1 (all bits set), so subtracting them counts them
+        OP_TARGET_AVX2 inline int horizontalCountAvx2(const __m256i counters)
+        {
+            auto count4 = _mm_add_epi32(_mm256_castsi256_si128(counters), _mm256_extracti128_si256(counters, 1));
+            count4 = _mm_add_epi32(count4, _mm_shuffle_epi32(count4, _MM_SHUFFLE(1, 0, 3, 2)));
+            count4 = _mm_add_epi32(count4, _mm_shuffle_epi32(count4, _MM_SHUFFLE(2, 3, 0, 1)));
+            return _mm_cvtsi128_si32(count4);
+        }
+
+        OP_TARGET_AVX2 float getScoreSumAvx2(const float* const scorePtr, const int stride)
+        {
+            auto sumAvx = _mm256_setzero_ps();
+            for (auto part = 0 ; part < stride ; part += SOA_LANES)
+                sumAvx = _mm256_add_ps(sumAvx, _mm256_load_ps(scorePtr + part));
+            return horizontalSumAvx2(sumAvx);
+        }
+
+        OP_TARGET_AVX2 int getNonZeroKeypointsAvx2(
+            const float* const scorePtr, const float threshold, const int numberParts)
+        {
+            auto counters = _mm256_setzero_si256();
+            const auto thresholdAvx = _mm256_set1_ps(threshold);
+            for (auto part = 0 ; part < numberParts ; part += SOA_LANES)
+            {
+                const auto valid = _mm256_and_ps(
+                    rangeMaskAvx2(part, 0, numberParts),
+                    _mm256_cmp_ps(_mm256_load_ps(scorePtr + part), thresholdAvx, _CMP_GE_OQ));
+                counters = _mm256_sub_epi32(counters, _mm256_castps_si256(valid));
+            }
+            return horizontalCountAvx2(counters);
+        }
+
+        OP_TARGET_AVX2 float getDistanceSumAvx2(
+            int& counter, const float* const xPtrA, const float* const yPtrA, const float* const scorePtrA,
+            const float* const xPtrB, const float* const yPtrB, const float* const scorePtrB,
+            const float threshold, const int numberParts)
+        {
+            auto sumAvx = _mm256_setzero_ps();
+            auto counters = _mm256_setzero_si256();
+            const auto thresholdAvx = _mm256_set1_ps(threshold);
+            for (auto part = 0 ; part < numberParts ; part += SOA_LANES)
+            {
+                const auto valid = _mm256_and_ps(
+                    rangeMaskAvx2(part, 0, numberParts),
+                    _mm256_and_ps(
+                        _mm256_cmp_ps(_mm256_load_ps(scorePtrA + part), thresholdAvx, _CMP_GE_OQ),
+                        _mm256_cmp_ps(_mm256_load_ps(scorePtrB + part), thresholdAvx, _CMP_GE_OQ)));
+                const auto x = _mm256_sub_ps(_mm256_load_ps(xPtrA + part), _mm256_load_ps(xPtrB + part));
+                const auto y = _mm256_sub_ps(_mm256_load_ps(yPtrA + part), _mm256_load_ps(yPtrB + part));
+                const auto distance = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)));
+                sumAvx = _mm256_add_ps(sumAvx, _mm256_and_ps(distance, valid));
+                counters = _mm256_sub_epi32(counters, _mm256_castps_si256(valid));
+            }
+            counter = horizontalCountAvx2(counters);
+            return horizontalSumAvx2(sumAvx);
+        }
+
+        bool useAvx2()
+        {
+            static const auto sUseAvx2 = cpuSupportsAvx2();
+            return sUseAvx2;
+        }
+    #endif
+
+    KeypointSoa::KeypointSoa() :
+        mNumberPeople{0},
+        mNumberParts{0},
+        mStride{0}
+    {
+    }
+
+    KeypointSoa::KeypointSoa(const Array<float>& keypoints) :
+        KeypointSoa{}
+    {
+        try
+        {
+            reset(keypoints);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void KeypointSoa::reset(const Array<float>& keypoints)
+    {
+        try
+        {
+            // Sanity check
+            if (!keypoints.empty() && (keypoints.getNumberDimensions() != 3 || keypoints.getSize(2) != 3))
+                error("Keypoints must have size {#people, #parts, 3}.", __LINE__, __FUNCTION__, __FILE__);
+            mNumberPeople = (keypoints.empty() ? 0 : keypoints.getSize(0));
+            mNumberParts = (keypoints.empty() ? 0 : keypoints.getSize(1));
+            mStride = (mNumberParts + SOA_LANES - 1) / SOA_LANES * SOA_LANES;
+            if (mNumberPeople == 0)
+            {
+                spData.reset();
+                return;
+            }
+            // Always a new buffer, as the previous one might be shared with copies of this object
+            spData = alignedFloatBuffer(3 * mStride * mNumberPeople);
+            const auto* keypointPtr = keypoints.getConstPtr();
+            for (auto person = 0 ; person < mNumberPeople ; person++)
+            {
+                auto* const xPtr = getXPtr(person);
+                auto* const yPtr = getYPtr(person);
+                auto* const scorePtr = getScorePtr(person);
+                for (auto part = 0 ; part < mNumberParts ; part++, keypointPtr += 3)
+                {
+                    xPtr[part] = keypointPtr[0];
+                    yPtr[part] = keypointPtr[1];
+                    scorePtr[part] = keypointPtr[2];
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    KeypointSoa KeypointSoa::clone() const
+    {
+        try
+        {
+            KeypointSoa keypointSoa;
+            keypointSoa.mNumberPeople = mNumberPeople;
+            keypointSoa.mNumberParts = mNumberParts;
+            keypointSoa.mStride = mStride;
+            if (!empty())
+            {
+                const auto volume = 3 * mStride * mNumberPeople;
+                keypointSoa.spData = alignedFloatBuffer(volume);
+                std::copy(spData.get(), spData.get() + volume, keypointSoa.spData.get());
+            }
+            return keypointSoa;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return KeypointSoa{};
+        }
+    }
+
+    Array<float> KeypointSoa::toArray() const
+    {
+        try
+        {
+            Array<float> keypoints;
+            toArray(keypoints);
+            return keypoints;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<float>{};
+        }
+    }
+
+    void KeypointSoa::toArray(Array<float>& keypoints) const
+    {
+        try
+        {
+            if (empty())
+            {
+                keypoints.reset();
+                return;
+            }
+            keypoints.reset({mNumberPeople, mNumberParts, 3});
+            auto* keypointPtr = keypoints.getPtr();
+            for (auto person = 0 ; person < mNumberPeople ; person++)
+            {
+                const auto* const xPtr = getXPtr(person);
+                const auto* const yPtr = getYPtr(person);
+                const auto* const scorePtr = getScorePtr(person);
+                for (auto part = 0 ; part < mNumberParts ; part++, keypointPtr += 3)
+                {
+                    keypointPtr[0] = xPtr[part];
+                    keypointPtr[1] = yPtr[part];
+                    keypointPtr[2] = scorePtr[part];
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    const float* KeypointSoa::getXPtr(const int person) const
+    {
+        return spData.get() + 3 * mStride * person;
+    }
+
+    const float* KeypointSoa::getYPtr(const int person) const
+    {
+        return spData.get() + 3 * mStride * person + mStride;
+    }
+
+    const float* KeypointSoa::getScorePtr(const int person) const
+    {
+        return spData.get() + 3 * mStride * person + 2 * mStride;
+    }
+
+    float* KeypointSoa::getXPtr(const int person)
+    {
+        return spData.get() + 3 * mStride * person;
+    }
+
+    float* KeypointSoa::getYPtr(const int person)
+    {
+        return spData.get() + 3 * mStride * person + mStride;
+    }
+
+    float* KeypointSoa::getScorePtr(const int person)
+    {
+        return spData.get() + 3 * mStride * person + 2 * mStride;
+    }
+
+    Rectangle<float> KeypointSoa::getRectangle(
+        const int person, const float threshold, const int firstIndex, const int lastIndex) const
+    {
+        try
+        {
+            // Params
+            const auto lastIndexClean = (lastIndex < 0 ? mNumberParts : lastIndex);
+            // Sanity checks
+            checkPerson(person);
+            if (mNumberParts < 1)
+                error("Number body parts must be > 0.", __LINE__, __FUNCTION__, __FILE__);
+            if (lastIndexClean > mNumberParts)
+                error("The value of `lastIndex` must be less or equal than `numberKeypoints`. Currently: "
+                    + std::to_string(lastIndexClean) + " vs. " + std::to_string(mNumberParts),
+                    __LINE__, __FUNCTION__, __FILE__);
+            if (firstIndex > lastIndexClean)
+                error("The value of `firstIndex` must be less or equal than `lastIndex`. Currently: "
+                    + std::to_string(firstIndex) + " vs. " + std::to_string(lastIndex),
+                    __LINE__, __FUNCTION__, __FILE__);
+            const auto* const xPtr = getXPtr(person);
+            const auto* const yPtr = getYPtr(person);
+            const auto* const scorePtr = getScorePtr(person);
+            auto minX = std::numeric_limits<float>::max();
+            auto maxX = std::numeric_limits<float>::lowest();
+            auto minY = minX;
+            auto maxY = maxX;
+            #ifdef WITH_AVX
+                if (useAvx2())
+                    getRectangleAvx2(
+                        minX, maxX, minY, maxY, xPtr, yPtr, scorePtr, threshold, firstIndex, lastIndexClean);
+                else
+            #endif
+            for (auto part = firstIndex ; part < lastIndexClean ; part++)
+            {
+                if (scorePtr[part] > threshold)
+                {
+                    minX = fastMin(minX, xPtr[part]);
+                    maxX = fastMax(maxX, xPtr[part]);
+                    minY = fastMin(minY, yPtr[part]);
+                    maxY = fastMax(maxY, yPtr[part]);
+                }
+            }
+            if (maxX >= minX && maxY >= minY)
+                return Rectangle<float>{minX, minY, maxX-minX, maxY-minY};
+            else
+                return Rectangle<float>{};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Rectangle<float>{};
+        }
+    }
+
+    float KeypointSoa::getAverageScore(const int person) const
+    {
+        try
+        {
+            checkPerson(person);
+            const auto* const scorePtr = getScorePtr(person);
+            auto score = 0.f;
+            #ifdef WITH_AVX
+                if (useAvx2())
+                    score = getScoreSumAvx2(scorePtr, mStride);
+                else
+            #endif
+            for (auto part = 0 ; part < mNumberParts ; part++)
+                score += scorePtr[part];
+            return score / mNumberParts;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.f;
+        }
+    }
+
+    float KeypointSoa::getArea(const int person, const float threshold) const
+    {
+        try
+        {
+            return getRectangle(person, threshold).area();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.f;
+        }
+    }
+
+    int KeypointSoa::getBiggestPerson(const float threshold) const
+    {
+        try
+        {
+            auto biggestPoseIndex = -1;
+            auto biggestArea = -1.f;
+            for (auto person = 0 ; person < mNumberPeople ; person++)
+            {
+                const auto newPersonArea = getArea(person, threshold);
+                if (newPersonArea > biggestArea)
+                {
+                    biggestArea = newPersonArea;
+                    biggestPoseIndex = person;
+                }
+            }
+            return biggestPoseIndex;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1;
+        }
+    }
+
+    int KeypointSoa::getNonZeroKeypoints(const int person, const float threshold) const
+    {
+        try
+        {
+            if (empty())
+                return 0;
+            checkPerson(person);
+            const auto* const scorePtr = getScorePtr(person);
+            #ifdef WITH_AVX
+                if (useAvx2())
+                    return getNonZeroKeypointsAvx2(scorePtr, threshold, mNumberParts);
+            #endif
+            auto nonZeroCounter = 0;
+            for (auto part = 0 ; part < mNumberParts ; part++)
+                if (scorePtr[part] >= threshold)
+                    nonZeroCounter++;
+            return nonZeroCounter;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0;
+        }
+    }
+
+    float KeypointSoa::getDistanceAverage(
+        const int personA, const KeypointSoa& keypointsB, const int personB, const float threshold) const
+    {
+        try
+        {
+            // Sanity checks
+            if (mNumberPeople <= personA)
+                error("PersonA index out of range.", __LINE__, __FUNCTION__, __FILE__);
+            if (keypointsB.mNumberPeople <= personB)
+                error("PersonB index out of range.", __LINE__, __FUNCTION__, __FILE__);
+            if (mNumberParts != keypointsB.mNumberParts)
+                error("Keypoints should have the same number of keypoints.", __LINE__, __FUNCTION__, __FILE__);
+            const auto* const xPtrA = getXPtr(personA);
+            const auto* const yPtrA = getYPtr(personA);
+            const auto* const scorePtrA = getScorePtr(personA);
+            const auto* const xPtrB = keypointsB.getXPtr(personB);
+            const auto* const yPtrB = keypointsB.getYPtr(personB);
+            const auto* const scorePtrB = keypointsB.getScorePtr(personB);
+            // Get total distance
+            auto totalDistance = 0.f;
+            auto nonZeroCounter = 0;
+            #ifdef WITH_AVX
+                if (useAvx2())
+                    totalDistance = getDistanceSumAvx2(
+                        nonZeroCounter, xPtrA, yPtrA, scorePtrA, xPtrB, yPtrB, scorePtrB, threshold, mNumberParts);
+                else
+            #endif
+            for (auto part = 0 ; part < mNumberParts ; part++)
+            {
+                if (scorePtrA[part] >= threshold && scorePtrB[part] >= threshold)
+                {
+                    const auto x = xPtrA[part] - xPtrB[part];
+                    const auto y = yPtrA[part] - yPtrB[part];
+                    totalDistance += std::sqrt(x*x+y*y);
+                    nonZeroCounter++;
+                }
+            }
+            // Get distance average
+            return totalDistance / nonZeroCounter;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.f;
+        }
+    }
+
+    float KeypointSoa::getRoi(
+        const int personA, const KeypointSoa& keypointsB, const int personB, const float threshold) const
+    {
+        try
+        {
+            // Sanity checks
+            if (mNumberPeople <= personA)
+                error("PersonA index out of range.", __LINE__, __FUNCTION__, __FILE__);
+            if (keypointsB.mNumberPeople <= personB)
+                error("PersonB index out of range.", __LINE__, __FUNCTION__, __FILE__);
+            if (mNumberParts != keypointsB.mNumberParts)
+                error("Keypoints should have the same number of keypoints.", __LINE__, __FUNCTION__, __FILE__);
+            // Get ROI
+            return getKeypointsRoi(getRectangle(personA, threshold), keypointsB.getRectangle(personB, threshold));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.f;
+        }
+    }
+
+    void KeypointSoa::checkPerson(const int person) const
+    {
+        if (person < 0 || person >= mNumberPeople)
+            error("Person index out of bounds.", __LINE__, __FUNCTION__, __FILE__);
+    }
+}
@@ -0,0 +1,156 @@
+#include <openpose_private/utilities/memoryMappedFile.hpp>
+#include <map>
+#include <mutex>
+#ifdef _WIN32
+    #include <windows.h> // CreateFileA, CreateFileMappingA, MapViewOfFile
+#elif defined __unix__ || defined __APPLE__
+    #include <fcntl.h> // open
+    #include <sys/mman.h> // mmap
+    #include <sys/stat.h> // fstat
+    #include <unistd.h> // close
+#else
+    #error Unknown environment!
+#endif
+
+namespace op
+{
+    MemoryMappedFile::MemoryMappedFile(const std::string& filePath) :
+        mFilePath{filePath},
+        pData{nullptr},
+        mSize{0ull}
+        #ifdef _WIN32
+            ,
+            pFileHandle{nullptr},
+            pMappingHandle{nullptr}
+        #endif
+    {
+        try
+        {
+            #ifdef _WIN32
+                const auto fileHandle = CreateFileA(
+                    filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                    FILE_ATTRIBUTE_NORMAL, nullptr);
+                if (fileHandle == INVALID_HANDLE_VALUE)
+                    error("File could not be opened: " + filePath + ".", __LINE__, __FUNCTION__, __FILE__);
+                pFileHandle = fileHandle;
+                LARGE_INTEGER fileSize;
+                if (!GetFileSizeEx(fileHandle, &fileSize))
+                    error("Size of file " + filePath + " could not be read.", __LINE__, __FUNCTION__, __FILE__);
+                mSize = (unsigned long long)fileSize.QuadPart;
+                if (mSize > 0ull)
+                {
+                    pMappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                    if (pMappingHandle == nullptr)
+                        error("File could not be mapped: " + filePath + ".", __LINE__, __FUNCTION__, __FILE__);
+                    pData = (const unsigned char*)MapViewOfFile(pMappingHandle, FILE_MAP_READ, 0, 0, 0);
+                    if (pData == nullptr)
+                        error("File could not be mapped: " + filePath + ".", __LINE__, __FUNCTION__, __FILE__);
+                }
+            #else
+                const auto fileDescriptor = open(filePath.c_str(), O_RDONLY);
+                if (fileDescriptor < 0)
+                    error("File could not be opened: " + filePath + ".", __LINE__, __FUNCTION__, __FILE__);
+                struct stat fileStatus;
+                if (fstat(fileDescriptor, &fileStatus) != 0)
+                {
+                    close(fileDescriptor);
+                    error("Size of file " + filePath + " could not be read.", __LINE__, __FUNCTION__, __FILE__);
+                }
+                mSize = (unsigned long long)fileStatus.st_size;
+                if (mSize > 0ull)
+                {
+                    auto* data = mmap(nullptr, mSize, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+                    if (data == MAP_FAILED)
+                    {
+                        close(fileDescriptor);
+                        error("File could not be mapped: " + filePath + ".", __LINE__, __FUNCTION__, __FILE__);
+                    }
+                    // It is read once, from the beginning to the end
+                    madvise(data, mSize, MADV_SEQUENTIAL);
+                    pData = (const unsigned char*)data;
+                }
+                // The mapping keeps its own reference to the file
+                close(fileDescriptor);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            #ifdef _WIN32
+                if (pData != nullptr)
+                    UnmapViewOfFile(pData);
+                if (pMappingHandle != nullptr)
+                    CloseHandle(pMappingHandle);
+                if (pFileHandle != nullptr)
+                    CloseHandle(pFileHandle);
+            #endif
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    MemoryMappedFile::~MemoryMappedFile()
+    {
+        try
+        {
+            #ifdef _WIN32
+                if (pData != nullptr)
+                    UnmapViewOfFile(pData);
+                if (pMappingHandle != nullptr)
+                    CloseHandle(pMappingHandle);
+                if (pFileHandle != nullptr)
+                    CloseHandle(pFileHandle);
+            #else
+                if (pData != nullptr)
+                    munmap((void*)pData, mSize);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    const unsigned char* MemoryMappedFile::getData() const
+    {
+        return pData;
+    }
+
+    unsigned long long MemoryMappedFile::getSize() const
+    {
+        return mSize;
+    }
+
+    const std::string& MemoryMappedFile::getFilePath() const
+    {
+        return mFilePath;
+    }
+
+    std::shared_ptr<const MemoryMappedFile> getMemoryMappedFile(const std::string& filePath)
+    {
+        try
+        {
+            static std::mutex sMutex;
+            static std::map<std::string, std::weak_ptr<const MemoryMappedFile>> sMemoryMappedFiles;
+            const std::lock_guard<std::mutex> lock{sMutex};
+            auto memoryMappedFile = sMemoryMappedFiles[filePath].lock();
+            if (memoryMappedFile == nullptr)
+            {
+                memoryMappedFile = std::make_shared<const MemoryMappedFile>(filePath);
+                sMemoryMappedFiles[filePath] = memoryMappedFile;
+            }
+            // Expired ones are removed
+            for (auto iterator = sMemoryMappedFiles.begin() ; iterator != sMemoryMappedFiles.end() ; )
+            {
+                if (iterator->second.expired())
+                    iterator = sMemoryMappedFiles.erase(iterator);
+                else
+                    ++iterator;
+            }
+            return memoryMappedFile;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+}
@@ -0,0 +1,352 @@
+#include <openpose/utilities/metrics.hpp>
+#include <algorithm> // std::min
+#include <cmath> // std::ceil
+#include <iomanip> // std::setprecision
+#include <locale>
+#include <map>
+#include <mutex>
+#include <sstream> // std::ostringstream
+#ifdef __GNUG__
+    #include <cstdlib> // std::free
+    #include <cxxabi.h> // abi::__cxa_demangle
+#endif
+
+namespace op
+{
+    // Each power of 2 is split into 2^HISTOGRAM_SUB_BUCKET_BITS linear sub-buckets
+    const auto HISTOGRAM_SUB_BUCKET_BITS = 4u;
+    const auto HISTOGRAM_SUB_BUCKETS = 1ull << HISTOGRAM_SUB_BUCKET_BITS;
+    const auto HISTOGRAM_BUCKETS = HISTOGRAM_SUB_BUCKETS * (64u - HISTOGRAM_SUB_BUCKET_BITS + 1u);
+
+    unsigned int getHighestBit(const unsigned long long value)
+    {
+        #ifdef __GNUC__
+            return 63u - (unsigned int)__builtin_clzll(value);
+        #else
+            auto highestBit = 0u;
+            for (auto valueShifted = value >> 1 ; valueShifted > 0 ; valueShifted >>= 1)
+                highestBit++;
+            return highestBit;
+        #endif
+    }
+
+    unsigned long long getBucketIndex(const unsigned long long value)
+    {
+        // Values lower than HISTOGRAM_SUB_BUCKETS are exact
+        if (value < HISTOGRAM_SUB_BUCKETS)
+            return value;
+        const auto highestBit = getHighestBit(value);
+        const auto shift = highestBit - HISTOGRAM_SUB_BUCKET_BITS;
+        const auto subBucket = (value >> shift) & (HISTOGRAM_SUB_BUCKETS - 1);
+        return HISTOGRAM_SUB_BUCKETS * (shift + 1) + subBucket;
+    }
+
+    unsigned long long getBucketUpperBound(const unsigned long long bucketIndex)
+    {
+        if (bucketIndex < HISTOGRAM_SUB_BUCKETS)
+            return bucketIndex;
+        const auto shift = bucketIndex / HISTOGRAM_SUB_BUCKETS - 1;
+        const auto subBucket = bucketIndex % HISTOGRAM_SUB_BUCKETS;
+        const auto lowerBound = (HISTOGRAM_SUB_BUCKETS + subBucket) << shift;
+        return lowerBound + ((1ull << shift) - 1);
+    }
+
+    Histogram::Histogram() :
+        mBuckets(HISTOGRAM_BUCKETS)
+    {
+        try
+        {
+            reset();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    Histogram::~Histogram()
+    {
+    }
+
+    void Histogram::record(const unsigned long long value)
+    {
+        try
+        {
+            mBuckets[getBucketIndex(value)].fetch_add(1ull, std::memory_order_relaxed);
+            mSum.fetch_add(value, std::memory_order_relaxed);
+            auto currentMax = mMax.load(std::memory_order_relaxed);
+            while (currentMax < value && !mMax.compare_exchange_weak(currentMax, value, std::memory_order_relaxed))
+                {}
+            mCount.fetch_add(1ull, std::memory_order_relaxed);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned long long Histogram::getCount() const
+    {
+        return mCount.load(std::memory_order_relaxed);
+    }
+
+    unsigned long long Histogram::getSum() const
+    {
+        return mSum.load(std::memory_order_relaxed);
+    }
+
+    unsigned long long Histogram::getMax() const
+    {
+        return mMax.load(std::memory_order_relaxed);
+    }
+
+    unsigned long long Histogram::getValueAtQuantile(const double quantile) const
+    {
+        try
+        {
+            // Sanity check
+            if (quantile < 0. || quantile > 1.)
+                error("Quantile must be in the range [0, 1].", __LINE__, __FUNCTION__, __FILE__);
+            const auto count = getCount();
+            if (count == 0)
+                return 0ull;
+            const auto target = std::max(1ull, (unsigned long long)std::ceil(quantile * count));
+            auto cumulativeCount = 0ull;
+            for (auto i = 0ull ; i < mBuckets.size() ; i++)
+            {
+                cumulativeCount += mBuckets[i].load(std::memory_order_relaxed);
+                if (cumulativeCount >= target)
+                    return std::min(getBucketUpperBound(i), getMax());
+            }
+            return getMax();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    std::vector<unsigned long long> Histogram::getCumulativeCounts(
+        const std::vector<unsigned long long>& upperBounds) const
+    {
+        try
+        {
+            std::vector<unsigned long long> cumulativeCounts(upperBounds.size(), 0ull);
+            auto upperBoundIndex = 0ull;
+            for (auto i = 0ull ; i < mBuckets.size() && upperBoundIndex < upperBounds.size() ; i++)
+            {
+                const auto bucketCount = mBuckets[i].load(std::memory_order_relaxed);
+                if (bucketCount > 0)
+                {
+                    const auto bucketUpperBound = getBucketUpperBound(i);
+                    while (upperBoundIndex < upperBounds.size() && upperBounds[upperBoundIndex] < bucketUpperBound)
+                        upperBoundIndex++;
+                    if (upperBoundIndex < upperBounds.size())
+                        cumulativeCounts[upperBoundIndex] += bucketCount;
+                }
+            }
+            for (auto i = 1ull ; i < cumulativeCounts.size() ; i++)
+                cumulativeCounts[i] += cumulativeCounts[i-1];
+            return cumulativeCounts;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void Histogram::reset()
+    {
+        try
+        {
+            for (auto& bucket : mBuckets)
+                bucket.store(0ull, std::memory_order_relaxed);
+            mCount.store(0ull, std::memory_order_relaxed);
+            mSum.store(0ull, std::memory_order_relaxed);
+            mMax.store(0ull, std::memory_order_relaxed);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    struct MetricsFamily
+    {
+        std::string help;
+        bool isTime;
+        std::map<std::string, std::shared_ptr<Histogram>> histograms;
+    };
+
+    std::atomic<bool> Metrics::sEnabled{false};
+    std::map<std::string, MetricsFamily> sMetricsFamilies;
+    std::mutex sMetricsMutex;
+
+    // Exported OpenMetrics buckets (`le`): 0.1 msec to 10 sec for times (in usec), and powers of 2 for sizes
+    const std::vector<unsigned long long> METRICS_TIME_UPPER_BOUNDS{
+        100ull, 250ull, 500ull, 1000ull, 2500ull, 5000ull, 10000ull, 25000ull, 50000ull, 100000ull, 250000ull,
+        500000ull, 1000000ull, 2500000ull, 5000000ull, 10000000ull};
+    const std::vector<unsigned long long> METRICS_SIZE_UPPER_BOUNDS{
+        0ull, 1ull, 2ull, 4ull, 8ull, 16ull, 32ull, 64ull, 128ull, 256ull, 512ull, 1024ull};
+    // Powers of 4 from 1 KB to 1 GB for the `_bytes` families
+    const std::vector<unsigned long long> METRICS_BYTES_UPPER_BOUNDS{
+        0ull, 1ull << 10, 1ull << 12, 1ull << 14, 1ull << 16, 1ull << 18, 1ull << 20, 1ull << 22, 1ull << 24,
+        1ull << 26, 1ull << 28, 1ull << 30};
+
+    bool isBytesMetric(const std::string& name)
+    {
+        const std::string bytesSuffix{"_bytes"};
+        return name.size() > bytesSuffix.size()
+            && name.compare(name.size() - bytesSuffix.size(), bytesSuffix.size(), bytesSuffix) == 0;
+    }
+
+    std::string formatOpenMetricsFloat(const double value)
+    {
+        std::ostringstream oStringStream;
+        oStringStream.imbue(std::locale::classic());
+        oStringStream << std::setprecision(12) << value;
+        auto valueString = oStringStream.str();
+        // OpenMetrics canonical floats (e.g., `1.0` rather than `1`)
+        if (valueString.find_first_of(".e") == std::string::npos)
+            valueString += ".0";
+        return valueString;
+    }
+
+    void Metrics::setEnabled(const bool enabled)
+    {
+        sEnabled = enabled;
+    }
+
+    bool Metrics::isEnabled()
+    {
+        return sEnabled.load(std::memory_order_relaxed);
+    }
+
+    std::shared_ptr<Histogram> Metrics::getHistogram(
+        const std::string& name, const std::string& labels, const std::string& help, const bool isTime)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{sMetricsMutex};
+            auto& metricsFamily = sMetricsFamilies[name];
+            if (metricsFamily.histograms.empty())
+            {
+                metricsFamily.help = help;
+                metricsFamily.isTime = isTime;
+            }
+            // Sanity check
+            else if (metricsFamily.isTime != isTime)
+                error("Metric `" + name + "` was already registered with a different unit.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            auto& spHistogram = metricsFamily.histograms[labels];
+            if (spHistogram == nullptr)
+                spHistogram = std::make_shared<Histogram>();
+            return spHistogram;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    std::string Metrics::toOpenMetrics()
+    {
+        try
+        {
+            std::ostringstream oStringStream;
+            oStringStream.imbue(std::locale::classic());
+            const std::lock_guard<std::mutex> lock{sMetricsMutex};
+            for (const auto& nameAndFamily : sMetricsFamilies)
+            {
+                const auto& name = nameAndFamily.first;
+                const auto& metricsFamily = nameAndFamily.second;
+                const auto isBytes = (!metricsFamily.isTime && isBytesMetric(name));
+                const auto& upperBounds = (
+                    metricsFamily.isTime ? METRICS_TIME_UPPER_BOUNDS
+                    : (isBytes ? METRICS_BYTES_UPPER_BOUNDS : METRICS_SIZE_UPPER_BOUNDS));
+                const auto scale = (metricsFamily.isTime ? 1e-6 : 1.);
+                // Metadata
+                oStringStream << "# TYPE " << name << " histogram\n";
+                if (metricsFamily.isTime)
+                    oStringStream << "# UNIT " << name << " seconds\n";
+                else if (isBytes)
+                    oStringStream << "# UNIT " << name << " bytes\n";
+                oStringStream << "# HELP " << name << " " << metricsFamily.help << "\n";
+                // Samples
+                for (const auto& labelsAndHistogram : metricsFamily.histograms)
+                {
+                    const auto& labels = labelsAndHistogram.first;
+                    const auto& histogram = *labelsAndHistogram.second;
+                    const auto labelsPrefix = (labels.empty() ? "" : labels + ",");
+                    const auto cumulativeCounts = histogram.getCumulativeCounts(upperBounds);
+                    for (auto i = 0u ; i < upperBounds.size() ; i++)
+                        oStringStream << name << "_bucket{" << labelsPrefix << "le=\""
+                            << formatOpenMetricsFloat(upperBounds[i] * scale) << "\"} " << cumulativeCounts[i] << "\n";
+                    // Values might have been recorded while reading the buckets, but the count must not be lower
+                    const auto count = std::max(
+                        histogram.getCount(), (cumulativeCounts.empty() ? 0ull : cumulativeCounts.back()));
+                    oStringStream << name << "_bucket{" << labelsPrefix << "le=\"+Inf\"} " << count << "\n";
+                    oStringStream << name << "_count{" << labels << "} " << count << "\n";
+                    oStringStream << name << "_sum{" << labels << "} "
+                        << formatOpenMetricsFloat(histogram.getSum() * scale) << "\n";
+                }
+            }
+            oStringStream << "# EOF\n";
+            return oStringStream.str();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "# EOF\n";
+        }
+    }
+
+    void Metrics::reset()
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{sMetricsMutex};
+            for (auto& nameAndFamily : sMetricsFamilies)
+                for (auto& labelsAndHistogram : nameAndFamily.second.histograms)
+                    labelsAndHistogram.second->reset();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::string Metrics::getTypeName(const std::type_info& typeInfo)
+    {
+        try
+        {
+            std::string typeName = typeInfo.name();
+            // GCC and Clang mangle the names (e.g., `N2op14WPoseExtractorI...`)
+            #ifdef __GNUG__
+                auto status = -1;
+                char* demangledName = abi::__cxa_demangle(typeInfo.name(), nullptr, nullptr, &status);
+                if (status == 0 && demangledName != nullptr)
+                    typeName = demangledName;
+                std::free(demangledName);
+            #endif
+            // Remove template arguments (e.g., `op::WPoseExtractor<std::shared_ptr<...> >`)
+            typeName = typeName.substr(0, typeName.find('<'));
+            // Remove namespaces and MSVC `class ` and `struct ` prefixes
+            const auto namespaceEnd = typeName.rfind("::");
+            if (namespaceEnd != std::string::npos)
+                typeName = typeName.substr(namespaceEnd + 2);
+            const auto prefixEnd = typeName.rfind(' ');
+            if (prefixEnd != std::string::npos)
+                typeName = typeName.substr(prefixEnd + 1);
+            return typeName;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+}
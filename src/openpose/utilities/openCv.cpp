@@ -1,10 +1,157 @@
 #include <openpose/utilities/openCv.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose_private/utilities/avx.hpp>
+#include <openpose_private/utilities/neon.hpp>
 #include <openpose_private/utilities/openCvMultiversionHeaders.hpp>
+#include <openpose_private/utilities/parallelFor.hpp>
 
 namespace op
 {
+    // Source rows read by each parallelFor() element of resizeAndPadUCharCvMatToFloatPtrs() (for all the scales)
+    const auto RESIZE_INPUT_SOURCE_ROWS_PER_BAND = 32;
+
+    // Interpolation taps of each target pixel along 1 dimension, as cv::warpAffine with a scaling matrix (source
+    // coordinate = target coordinate / scaleFactor) and black border: bilinear if scaleFactor <= 1 (cv::INTER_AREA
+    // is bilinear in cv::warpAffine) and bicubic (A = -0.75) otherwise. The taps outside the source have weight 0
+    // (and a valid index), and the target pixels with all the taps outside the source (i.e., the padding) are the
+    // ones after targetLengthValid
+    struct InputTaps
+    {
+        int numberTaps;
+        int targetLengthValid;
+        std::vector<int> indexes;
+        std::vector<float> weights;
+    };
+
+    InputTaps getInputTaps(const int sourceLength, const int targetLength, const double scaleFactor)
+    {
+        InputTaps inputTaps;
+        inputTaps.numberTaps = (scaleFactor > 1. ? 4 : 2);
+        inputTaps.targetLengthValid = 0;
+        const auto numberTaps = inputTaps.numberTaps;
+        inputTaps.indexes.resize(numberTaps*targetLength);
+        inputTaps.weights.resize(numberTaps*targetLength);
+        for (auto t = 0 ; t < targetLength ; t++)
+        {
+            const auto sourceCoordinate = t / scaleFactor;
+            const auto s = (int)std::floor(sourceCoordinate);
+            const auto f = (float)(sourceCoordinate - s);
+            float weights[4];
+            if (numberTaps == 2)
+            {
+                weights[0] = 1.f - f;
+                weights[1] = f;
+            }
+            else
+            {
+                const auto A = -0.75f;
+                weights[0] = ((A*(f + 1) - 5*A)*(f + 1) + 8*A)*(f + 1) - 4*A;
+                weights[1] = ((A + 2)*f - (A + 3))*f*f + 1;
+                weights[2] = ((A + 2)*(1 - f) - (A + 3))*(1 - f)*(1 - f) + 1;
+                weights[3] = 1.f - weights[0] - weights[1] - weights[2];
+            }
+            const auto firstIndex = s - (numberTaps == 4 ? 1 : 0);
+            for (auto k = 0 ; k < numberTaps ; k++)
+            {
+                const auto index = firstIndex + k;
+                const auto inside = (index >= 0 && index < sourceLength);
+                inputTaps.indexes[numberTaps*t+k] = fastTruncate(index, 0, sourceLength - 1);
+                inputTaps.weights[numberTaps*t+k] = (inside ? weights[k] : 0.f);
+                if (inside)
+                    inputTaps.targetLengthValid = t + 1;
+            }
+        }
+        return inputTaps;
+    }
+
+    // targetRow = ratio * truncate(weights[0]*rows[0] + ... + weights[numberTaps-1]*rows[numberTaps-1], 0, 255) + bias
+    using InputVerticalRow = void (*)(
+        float* targetRow, const float* const* const rows, const float* const weights, const int numberTaps,
+        const int width, const float ratio, const float bias);
+
+    void inputVerticalRow(
+        float* targetRow, const float* const* const rows, const float* const weights, const int numberTaps,
+        const int width, const float ratio, const float bias)
+    {
+        for (auto x = 0 ; x < width ; x++)
+        {
+            auto value = 0.f;
+            for (auto k = 0 ; k < numberTaps ; k++)
+                value += weights[k] * rows[k][x];
+            // Bicubic might go out of range (saturated as the uchar cv::warpAffine)
+            targetRow[x] = ratio * fastTruncate(value, 0.f, 255.f) + bias;
+        }
+    }
+
+    #ifdef WITH_AVX
+        OP_TARGET_AVX2 void inputVerticalRowAvx2(
+            float* targetRow, const float* const* const rows, const float* const weights, const int numberTaps,
+            const int width, const float ratio, const float bias)
+        {
+            const auto zeroAvx = _mm256_setzero_ps();
+            const auto maxAvx = _mm256_set1_ps(255.f);
+            const auto ratioAvx = _mm256_set1_ps(ratio);
+            const auto biasAvx = _mm256_set1_ps(bias);
+            auto x = 0;
+            // 8 pixels at a time (no fused multiply-add, so it matches inputVerticalRow)
+            for ( ; x + 8 <= width ; x += 8)
+            {
+                auto value = zeroAvx;
+                for (auto k = 0 ; k < numberTaps ; k++)
+                    value = _mm256_add_ps(
+                        value, _mm256_mul_ps(_mm256_set1_ps(weights[k]), _mm256_loadu_ps(&rows[k][x])));
+                value = _mm256_min_ps(maxAvx, _mm256_max_ps(zeroAvx, value));
+                _mm256_storeu_ps(&targetRow[x], _mm256_add_ps(_mm256_mul_ps(ratioAvx, value), biasAvx));
+            }
+            // Remaining ones
+            const float* remainingRows[4];
+            for (auto k = 0 ; k < numberTaps ; k++)
+                remainingRows[k] = rows[k] + x;
+            inputVerticalRow(targetRow + x, remainingRows, weights, numberTaps, width - x, ratio, bias);
+        }
+    #endif
+
+    #ifdef WITH_NEON
+        void inputVerticalRowNeon(
+            float* targetRow, const float* const* const rows, const float* const weights, const int numberTaps,
+            const int width, const float ratio, const float bias)
+        {
+            const auto zeroNeon = vdupq_n_f32(0.f);
+            const auto maxNeon = vdupq_n_f32(255.f);
+            const auto ratioNeon = vdupq_n_f32(ratio);
+            const auto biasNeon = vdupq_n_f32(bias);
+            auto x = 0;
+            // 4 pixels at a time (no fused multiply-add, so it matches inputVerticalRow)
+            for ( ; x + 4 <= width ; x += 4)
+            {
+                auto value = zeroNeon;
+                for (auto k = 0 ; k < numberTaps ; k++)
+                    value = vaddq_f32(value, vmulq_f32(vdupq_n_f32(weights[k]), vld1q_f32(&rows[k][x])));
+                value = vminq_f32(maxNeon, vmaxq_f32(zeroNeon, value));
+                vst1q_f32(&targetRow[x], vaddq_f32(vmulq_f32(ratioNeon, value), biasNeon));
+            }
+            // Remaining ones
+            const float* remainingRows[4];
+            for (auto k = 0 ; k < numberTaps ; k++)
+                remainingRows[k] = rows[k] + x;
+            inputVerticalRow(targetRow + x, remainingRows, weights, numberTaps, width - x, ratio, bias);
+        }
+    #endif
+
+    // SIMD version selected at runtime
+    InputVerticalRow getInputVerticalRow()
+    {
+        #if defined WITH_AVX
+            static const auto sInputVerticalRow = (cpuSupportsAvx2() ? &inputVerticalRowAvx2 : &inputVerticalRow);
+            return sInputVerticalRow;
+        #elif defined WITH_NEON
+            static const auto sInputVerticalRow = (cpuSupportsNeon() ? &inputVerticalRowNeon : &inputVerticalRow);
+            return sInputVerticalRow;
+        #else
+            return &inputVerticalRow;
+        #endif
+    }
+
     void unrollArrayToUCharCvMat(Matrix& matResult, const Array<float>& array)
     {
         try
@@ -179,6 +326,161 @@ namespace op
         }
     }
 
+    void resizeAndPadUCharCvMatToFloatPtrs(
+        const std::vector<float*>& floatPtrImages, const Matrix& matImage, const std::vector<double>& scaleFactors,
+        const std::vector<Point<int>>& targetSizes, const int normalize)
+    {
+        try
+        {
+            const cv::Mat cvImage = OP_OP2CVCONSTMAT(matImage);
+            // Sanity checks
+            if (cvImage.empty() || cvImage.type() != CV_8UC3)
+                error("Only implemented for non-empty 3-channel uchar (BGR) images.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (floatPtrImages.size() != scaleFactors.size() || targetSizes.size() != scaleFactors.size())
+                error("floatPtrImages, scaleFactors and targetSizes must have the same size.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Normalization (see uCharCvMatToFloatPtr): normalized value = ratio * value + biases[channel]
+            // VGG
+            auto ratio = 1.f;
+            std::array<float,3> biases{0.f, 0.f, 0.f};
+            if (normalize == 1)
+            {
+                ratio = 1.f/256.f;
+                biases = {-0.5f, -0.5f, -0.5f};
+            }
+            // DenseNet
+            else if (normalize == 2)
+            {
+                ratio = 0.017f;
+                biases = {-0.017f*103.94f, -0.017f*116.78f, -0.017f*123.68f};
+            }
+            // Unknown
+            else if (normalize != 0)
+                error("Unknown normalization value (" + std::to_string(normalize) + ").",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Interpolation taps of each scale
+            const auto inputVerticalRowFunction = getInputVerticalRow();
+            const auto numberScales = (int)scaleFactors.size();
+            const auto sourceWidth = cvImage.cols;
+            const auto sourceHeight = cvImage.rows;
+            std::vector<InputTaps> horizontalTaps;
+            std::vector<InputTaps> verticalTaps;
+            for (auto i = 0 ; i < numberScales ; i++)
+            {
+                if (targetSizes[i].x <= 0 || targetSizes[i].y <= 0 || scaleFactors[i] <= 0.)
+                    error("Invalid target size or scale factor.", __LINE__, __FUNCTION__, __FILE__);
+                horizontalTaps.emplace_back(getInputTaps(sourceWidth, targetSizes[i].x, scaleFactors[i]));
+                verticalTaps.emplace_back(getInputTaps(sourceHeight, targetSizes[i].y, scaleFactors[i]));
+            }
+            // Target rows of each scale processed by each band of source rows, i.e., [bandFirstRows[i][band],
+            // bandFirstRows[i][band+1]), the ones whose first tap is in the band (the taps are sorted)
+            const auto numberBands = (sourceHeight + RESIZE_INPUT_SOURCE_ROWS_PER_BAND - 1)
+                                   / RESIZE_INPUT_SOURCE_ROWS_PER_BAND;
+            std::vector<std::vector<int>> bandFirstRows(numberScales, std::vector<int>(numberBands + 1));
+            for (auto i = 0 ; i < numberScales ; i++)
+            {
+                const auto& currentVerticalTaps = verticalTaps[i];
+                auto y = 0;
+                for (auto band = 0 ; band < numberBands ; band++)
+                {
+                    bandFirstRows[i][band] = y;
+                    while (y < currentVerticalTaps.targetLengthValid
+                           && currentVerticalTaps.indexes[currentVerticalTaps.numberTaps*y]
+                               < (band+1) * RESIZE_INPUT_SOURCE_ROWS_PER_BAND)
+                        y++;
+                }
+                bandFirstRows[i][numberBands] = currentVerticalTaps.targetLengthValid;
+            }
+            parallelFor(0, numberBands, [&](const int band)
+            {
+                // Horizontally resized (and split into channels) source rows
+                thread_local std::vector<float> tHorizontalRows;
+                thread_local std::vector<char> tHorizontalRowsUsed;
+                for (auto i = 0 ; i < numberScales ; i++)
+                {
+                    const auto& currentHorizontalTaps = horizontalTaps[i];
+                    const auto& currentVerticalTaps = verticalTaps[i];
+                    const auto targetWidth = targetSizes[i].x;
+                    const auto targetArea = targetWidth * targetSizes[i].y;
+                    const auto widthValid = currentHorizontalTaps.targetLengthValid;
+                    auto* const floatPtrImage = floatPtrImages[i];
+                    const auto yBegin = bandFirstRows[i][band];
+                    const auto yEnd = bandFirstRows[i][band+1];
+                    if (yBegin < yEnd)
+                    {
+                        const auto numberTapsX = currentHorizontalTaps.numberTaps;
+                        const auto numberTapsY = currentVerticalTaps.numberTaps;
+                        const auto sourceRowBegin = currentVerticalTaps.indexes[numberTapsY*yBegin];
+                        const auto sourceRowEnd = currentVerticalTaps.indexes[numberTapsY*yEnd - 1] + 1;
+                        const auto horizontalRowStride = 3 * widthValid;
+                        tHorizontalRows.resize((sourceRowEnd - sourceRowBegin) * horizontalRowStride);
+                        // Only the source rows used by some tap (e.g., 2 out of 3 if downsampling by 3)
+                        tHorizontalRowsUsed.assign(sourceRowEnd - sourceRowBegin, 0);
+                        for (auto tap = numberTapsY*yBegin ; tap < numberTapsY*yEnd ; tap++)
+                            tHorizontalRowsUsed[currentVerticalTaps.indexes[tap] - sourceRowBegin] = 1;
+                        // Horizontal pass (the only one reading the source image)
+                        for (auto sourceRow = sourceRowBegin ; sourceRow < sourceRowEnd ; sourceRow++)
+                        {
+                            if (!tHorizontalRowsUsed[sourceRow - sourceRowBegin])
+                                continue;
+                            const auto* const sourceRowPtr = cvImage.ptr<unsigned char>(sourceRow);
+                            auto* const horizontalRow = &tHorizontalRows[
+                                (sourceRow - sourceRowBegin) * horizontalRowStride];
+                            for (auto x = 0 ; x < widthValid ; x++)
+                            {
+                                const auto* const indexes = &currentHorizontalTaps.indexes[numberTapsX*x];
+                                const auto* const weights = &currentHorizontalTaps.weights[numberTapsX*x];
+                                auto b = 0.f;
+                                auto g = 0.f;
+                                auto r = 0.f;
+                                for (auto k = 0 ; k < numberTapsX ; k++)
+                                {
+                                    const auto* const pixel = &sourceRowPtr[3*indexes[k]];
+                                    b += weights[k] * pixel[0];
+                                    g += weights[k] * pixel[1];
+                                    r += weights[k] * pixel[2];
+                                }
+                                horizontalRow[x] = b;
+                                horizontalRow[widthValid + x] = g;
+                                horizontalRow[2*widthValid + x] = r;
+                            }
+                        }
+                        // Vertical pass, normalization and padding (the right columns)
+                        for (auto y = yBegin ; y < yEnd ; y++)
+                        {
+                            const auto* const indexes = &currentVerticalTaps.indexes[numberTapsY*y];
+                            const auto* const weights = &currentVerticalTaps.weights[numberTapsY*y];
+                            for (auto c = 0 ; c < 3 ; c++)
+                            {
+                                const float* rows[4];
+                                for (auto k = 0 ; k < numberTapsY ; k++)
+                                    rows[k] = &tHorizontalRows[
+                                        (indexes[k] - sourceRowBegin) * horizontalRowStride + c * widthValid];
+                                auto* const targetRow = &floatPtrImage[c * targetArea + y * targetWidth];
+                                inputVerticalRowFunction(
+                                    targetRow, rows, weights, numberTapsY, widthValid, ratio, biases[c]);
+                                std::fill(targetRow + widthValid, targetRow + targetWidth, biases[c]);
+                            }
+                        }
+                    }
+                    // Padding (the bottom rows)
+                    if (band == numberBands - 1)
+                    {
+                        const auto heightValid = currentVerticalTaps.targetLengthValid;
+                        for (auto c = 0 ; c < 3 ; c++)
+                            std::fill(&floatPtrImage[c * targetArea + heightValid * targetWidth],
+                                      &floatPtrImage[(c+1) * targetArea], biases[c]);
+                    }
+                }
+            });
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     double resizeGetScaleFactor(const Point<int>& initialSize, const Point<int>& targetSize)
     {
         try
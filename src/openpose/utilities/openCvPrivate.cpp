@@ -5,29 +5,80 @@
 
 namespace op
 {
+    struct TextParameters
+    {
+        int font;
+        double fontScale;
+        int fontThickness;
+        int shadowOffset;
+        int baseline;
+        cv::Size textSize;
+        cv::Point origin;
+    };
+
+    TextParameters getTextParameters(
+        const std::string& textToDisplay, const Point<int>& position, const bool normalizeWidth, const int imageWidth)
+    {
+        TextParameters textParameters;
+        textParameters.font = cv::FONT_HERSHEY_SIMPLEX;
+        const auto ratio = imageWidth/1280.;
+        // textParameters.fontScale = 0.75;
+        textParameters.fontScale = 0.8 * ratio;
+        textParameters.fontThickness = std::max(1, positiveIntRound(2*ratio));
+        textParameters.shadowOffset = std::max(1, positiveIntRound(2*ratio));
+        textParameters.baseline = 0;
+        textParameters.textSize = cv::getTextSize(
+            textToDisplay, textParameters.font, textParameters.fontScale, textParameters.fontThickness,
+            &textParameters.baseline);
+        textParameters.origin = cv::Point{position.x - (normalizeWidth ? textParameters.textSize.width : 0),
+                                          position.y + textParameters.textSize.height/2};
+        return textParameters;
+    }
+
     void putTextOnCvMat(cv::Mat& cvMat, const std::string& textToDisplay, const Point<int>& position,
-                        const cv::Scalar& color, const bool normalizeWidth, const int imageWidth)
+                        const cv::Scalar& color, const bool normalizeWidth, const int imageWidth, cv::Mat* mask)
+    {
+        try
+        {
+            const auto textParameters = getTextParameters(textToDisplay, position, normalizeWidth, imageWidth);
+            const cv::Point shadowOrigin{textParameters.origin.x + textParameters.shadowOffset,
+                                         textParameters.origin.y + textParameters.shadowOffset};
+            cv::putText(cvMat, textToDisplay, shadowOrigin, textParameters.font, textParameters.fontScale,
+                        cv::Scalar{0,0,0}, textParameters.fontThickness);
+            cv::putText(cvMat, textToDisplay, textParameters.origin, textParameters.font, textParameters.fontScale,
+                        color, textParameters.fontThickness);
+            if (mask != nullptr)
+            {
+                cv::putText(*mask, textToDisplay, shadowOrigin, textParameters.font, textParameters.fontScale,
+                            cv::Scalar{255}, textParameters.fontThickness);
+                cv::putText(*mask, textToDisplay, textParameters.origin, textParameters.font,
+                            textParameters.fontScale, cv::Scalar{255}, textParameters.fontThickness);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    cv::Rect getTextOnCvMatRectangle(
+        const std::string& textToDisplay, const Point<int>& position, const bool normalizeWidth, const int imageWidth)
     {
         try
         {
-            const auto font = cv::FONT_HERSHEY_SIMPLEX;
-            const auto ratio = imageWidth/1280.;
-            // const auto fontScale = 0.75;
-            const auto fontScale = 0.8 * ratio;
-            const auto fontThickness = std::max(1, positiveIntRound(2*ratio));
-            const auto shadowOffset = std::max(1, positiveIntRound(2*ratio));
-            int baseline = 0;
-            const auto textSize = cv::getTextSize(textToDisplay, font, fontScale, fontThickness, &baseline);
-            const cv::Size finalPosition{position.x - (normalizeWidth ? textSize.width : 0),
-                                         position.y + textSize.height/2};
-            cv::putText(cvMat, textToDisplay,
-                        cv::Size{finalPosition.width + shadowOffset, finalPosition.height + shadowOffset},
-                        font, fontScale, cv::Scalar{0,0,0}, fontThickness);
-            cv::putText(cvMat, textToDisplay, finalPosition, font, fontScale, color, fontThickness);
+            const auto textParameters = getTextParameters(textToDisplay, position, normalizeWidth, imageWidth);
+            // Extra margin of 1 thickness on each side (the strokes are centered on the glyph lines)
+            const auto margin = 2 * textParameters.fontThickness;
+            return cv::Rect{
+                textParameters.origin.x - margin,
+                textParameters.origin.y - textParameters.textSize.height - margin,
+                textParameters.textSize.width + textParameters.shadowOffset + 2*margin,
+                textParameters.textSize.height + textParameters.baseline + textParameters.shadowOffset + 2*margin};
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cv::Rect{};
         }
     }
 
@@ -0,0 +1,167 @@
+#include <openpose_private/utilities/parallelFor.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace op
+{
+    struct ParallelForJob
+    {
+        const std::function<void(const int)>& function;
+        const int end;
+        std::atomic<int> next;
+        std::atomic<int> pending;
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::string errorMessage;
+
+        ParallelForJob(const std::function<void(const int)>& function_, const int begin, const int end_) :
+            function(function_),
+            end{end_},
+            next{begin},
+            pending{end_ - begin}
+        {
+        }
+
+        // It runs elements of the job until none is left
+        void run()
+        {
+            for (auto i = next++ ; i < end ; i = next++)
+            {
+                try
+                {
+                    function(i);
+                }
+                catch (const std::exception& e)
+                {
+                    const std::lock_guard<std::mutex> lock{mutex};
+                    if (errorMessage.empty())
+                        errorMessage = e.what();
+                }
+                if (--pending == 0)
+                {
+                    const std::lock_guard<std::mutex> lock{mutex};
+                    finished.notify_all();
+                }
+            }
+        }
+    };
+
+    class ParallelForPool
+    {
+    public:
+        ParallelForPool() :
+            mStop{false}
+        {
+            // The calling thread is the extra one
+            const auto numberThreads = std::thread::hardware_concurrency();
+            for (auto i = 1u ; i < numberThreads ; i++)
+                mThreads.emplace_back(&ParallelForPool::threadFunction, this);
+        }
+
+        ~ParallelForPool()
+        {
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                mStop = true;
+            }
+            mJobAdded.notify_all();
+            for (auto& thread : mThreads)
+                if (thread.joinable())
+                    thread.join();
+        }
+
+        unsigned int getNumberThreads() const
+        {
+            return (unsigned int)mThreads.size() + 1u;
+        }
+
+        void run(const std::shared_ptr<ParallelForJob>& job)
+        {
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                mJobs.emplace_back(job);
+            }
+            mJobAdded.notify_all();
+            job->run();
+            std::unique_lock<std::mutex> lock{job->mutex};
+            job->finished.wait(lock, [&job]{ return job->pending == 0; });
+        }
+
+    private:
+        std::mutex mMutex;
+        std::condition_variable mJobAdded;
+        std::deque<std::shared_ptr<ParallelForJob>> mJobs;
+        std::vector<std::thread> mThreads;
+        bool mStop;
+
+        void threadFunction()
+        {
+            while (true)
+            {
+                std::shared_ptr<ParallelForJob> job;
+                {
+                    std::unique_lock<std::mutex> lock{mMutex};
+                    // Jobs whose elements are all taken are removed
+                    const auto popFinishedJobs = [this]
+                    {
+                        while (!mJobs.empty() && mJobs.front()->next >= mJobs.front()->end)
+                            mJobs.pop_front();
+                        return mStop || !mJobs.empty();
+                    };
+                    mJobAdded.wait(lock, popFinishedJobs);
+                    if (mStop)
+                        return;
+                    job = mJobs.front();
+                }
+                job->run();
+            }
+        }
+    };
+
+    ParallelForPool& getParallelForPool()
+    {
+        static ParallelForPool sParallelForPool;
+        return sParallelForPool;
+    }
+
+    void parallelFor(const int begin, const int end, const std::function<void(const int)>& function)
+    {
+        try
+        {
+            if (begin >= end)
+                return;
+            auto& parallelForPool = getParallelForPool();
+            // Not worth it (or no other thread available)
+            if (end - begin == 1 || parallelForPool.getNumberThreads() == 1u)
+            {
+                for (auto i = begin ; i < end ; i++)
+                    function(i);
+                return;
+            }
+            const auto job = std::make_shared<ParallelForJob>(function, begin, end);
+            parallelForPool.run(job);
+            if (!job->errorMessage.empty())
+                error(job->errorMessage, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned int getParallelForThreads()
+    {
+        try
+        {
+            return getParallelForPool().getNumberThreads();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 1u;
+        }
+    }
+}
@@ -1,10 +1,19 @@
 #include <openpose/utilities/profiler.hpp>
+#include <atomic>
+#include <condition_variable>
 #include <map>
+#include <memory> // std::shared_ptr
 #include <mutex>
+#include <thread>
+#if defined(_MSC_VER)
+    #include <intrin.h> // __rdtsc
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h> // __rdtsc
+#endif
 #include <openpose/utilities/errorAndLog.hpp>
 
-// First, I apologize for the ugliness of the code of this function. Nevertheless, it has been made
-// in this way so that it has no computational impact at all if PROFILER_ENABLED is not defined.
+// The timers are always compiled and running. Only printing their averages (and profileGpuMemory) requires
+// PROFILER_ENABLED, so it has no output impact at all if PROFILER_ENABLED is not defined.
 
 namespace op
 {
@@ -54,18 +63,228 @@ namespace op
         }
     }
 
-    #ifdef PROFILER_ENABLED
+    // Maximum number of registered timers (the accumulators of each thread are preallocated, so the aggregation
+    // thread can read them while they are being written)
+    const auto PROFILER_MAX_TIMERS = 1024u;
+    const auto PROFILER_INVALID_TIMER = PROFILER_MAX_TIMERS;
+    // Period of the background aggregation
+    const auto PROFILER_AGGREGATION_PERIOD = std::chrono::seconds{1};
+
+    // Time-stamp counter (or any monotonic clock otherwise), converted into seconds with getTicksPerSecond()
+    inline unsigned long long getTicks()
+    {
+        #if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+        #else
+            return (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        #endif
+    }
 
-        std::map<std::string, std::tuple<double, unsigned long long, std::chrono::high_resolution_clock::time_point>> sProfilerTuple{
-            std::map<std::string, std::tuple<double, unsigned long long, std::chrono::high_resolution_clock::time_point>>()
-        };
-        std::mutex sMutexProfiler{};
+    // Accumulators of 1 timer for 1 thread. ticks and calls are only written by their thread (no locking), and read
+    // by the aggregation
+    struct TimerAccumulator
+    {
+        std::atomic<unsigned long long> ticks;
+        std::atomic<unsigned long long> calls;
+        // Only used by its thread (printAveragedTimeMsEveryXIterations)
+        unsigned long long printTicks;
+        unsigned long long printCalls;
 
-        std::string getKey(const int line, const std::string& function, const std::string& file)
+        TimerAccumulator() :
+            ticks{0ull},
+            calls{0ull},
+            printTicks{0ull},
+            printCalls{0ull}
         {
-            return file + function + std::to_string(line) + getThreadId();
         }
+    };
 
+    struct ThreadTimers
+    {
+        std::vector<TimerAccumulator> accumulators;
+        // Its thread finished, so its values are moved into the retired totals
+        std::atomic<bool> orphaned;
+
+        ThreadTimers() :
+            accumulators(PROFILER_MAX_TIMERS),
+            orphaned{false}
+        {
+        }
+    };
+
+    struct ThreadTimersHolder
+    {
+        std::shared_ptr<ThreadTimers> spThreadTimers;
+
+        ~ThreadTimersHolder()
+        {
+            if (spThreadTimers != nullptr)
+                spThreadTimers->orphaned = true;
+        }
+    };
+
+    struct TimerTotals
+    {
+        unsigned long long ticks;
+        unsigned long long calls;
+    };
+
+    class ProfilerRegistry
+    {
+    public:
+        ProfilerRegistry() :
+            mStartTicks{getTicks()},
+            mStartTime{std::chrono::steady_clock::now()},
+            mRetired(PROFILER_MAX_TIMERS, TimerTotals{0ull, 0ull}),
+            mLastTotals(PROFILER_MAX_TIMERS, TimerTotals{0ull, 0ull}),
+            mPeriodTotals(PROFILER_MAX_TIMERS, TimerTotals{0ull, 0ull}),
+            mStopRequested{false}
+        {
+        }
+
+        ~ProfilerRegistry()
+        {
+            {
+                const std::lock_guard<std::mutex> lock{mThreadMutex};
+                mStopRequested = true;
+            }
+            mConditionVariable.notify_one();
+            if (mThread.joinable())
+                mThread.join();
+        }
+
+        unsigned int registerTimer(const std::string& name)
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            const auto timer = mTimerIds.find(name);
+            if (timer != mTimerIds.end())
+                return timer->second;
+            if (mNames.size() >= PROFILER_MAX_TIMERS)
+            {
+                opLog("Maximum number of profiler timers reached, " + name + " will not be timed.", Priority::High);
+                return PROFILER_INVALID_TIMER;
+            }
+            const auto timerId = (unsigned int)mNames.size();
+            mTimerIds[name] = timerId;
+            mNames.emplace_back(name);
+            // Aggregation thread started with the first timer
+            if (!mThread.joinable())
+                mThread = std::thread{&ProfilerRegistry::loop, this};
+            return timerId;
+        }
+
+        TimerAccumulator& getAccumulator(const unsigned int timerId)
+        {
+            // Registered once per thread, the only locking of the timers
+            thread_local ThreadTimersHolder threadTimersHolder;
+            if (threadTimersHolder.spThreadTimers == nullptr)
+            {
+                threadTimersHolder.spThreadTimers = std::make_shared<ThreadTimers>();
+                const std::lock_guard<std::mutex> lock{mMutex};
+                mThreadTimers.emplace_back(threadTimersHolder.spThreadTimers);
+            }
+            return threadTimersHolder.spThreadTimers->accumulators[timerId];
+        }
+
+        double getTicksPerSecond() const
+        {
+            const auto seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - mStartTime).count() * 1e-9;
+            const auto ticks = getTicks() - mStartTicks;
+            return (seconds > 0. && ticks > 0ull ? ticks / seconds : 1e9);
+        }
+
+        std::vector<ProfilerTimerStats> getTimerStats()
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            const auto totals = aggregate();
+            const auto msPerTick = 1e3 / getTicksPerSecond();
+            std::vector<ProfilerTimerStats> timerStats;
+            for (auto timerId = 0u ; timerId < mNames.size() ; timerId++)
+            {
+                const auto& total = totals[timerId];
+                const auto& period = mPeriodTotals[timerId];
+                if (total.calls > 0ull)
+                    timerStats.emplace_back(ProfilerTimerStats{
+                        mNames[timerId], total.calls, total.ticks * msPerTick,
+                        total.ticks * msPerTick / total.calls, period.calls,
+                        (period.calls > 0ull ? period.ticks * msPerTick / period.calls : 0.)});
+            }
+            return timerStats;
+        }
+
+    private:
+        const unsigned long long mStartTicks;
+        const std::chrono::steady_clock::time_point mStartTime;
+        // Protected by mMutex
+        std::mutex mMutex;
+        std::map<std::string, unsigned int> mTimerIds;
+        std::vector<std::string> mNames;
+        std::vector<std::shared_ptr<ThreadTimers>> mThreadTimers;
+        std::vector<TimerTotals> mRetired;
+        std::vector<TimerTotals> mLastTotals;
+        std::vector<TimerTotals> mPeriodTotals;
+        // Aggregation thread
+        std::mutex mThreadMutex;
+        std::condition_variable mConditionVariable;
+        bool mStopRequested;
+        std::thread mThread;
+
+        // It requires mMutex to be locked
+        std::vector<TimerTotals> aggregate()
+        {
+            auto totals = mRetired;
+            for (auto i = 0u ; i < mThreadTimers.size() ; )
+            {
+                // Read before the accumulators, so the final values of an orphaned thread are read
+                const auto isOrphaned = mThreadTimers[i]->orphaned.load();
+                auto& accumulators = mThreadTimers[i]->accumulators;
+                for (auto timerId = 0u ; timerId < mNames.size() ; timerId++)
+                {
+                    const auto ticks = accumulators[timerId].ticks.load(std::memory_order_relaxed);
+                    const auto calls = accumulators[timerId].calls.load(std::memory_order_relaxed);
+                    totals[timerId].ticks += ticks;
+                    totals[timerId].calls += calls;
+                    if (isOrphaned)
+                    {
+                        mRetired[timerId].ticks += ticks;
+                        mRetired[timerId].calls += calls;
+                    }
+                }
+                if (isOrphaned)
+                    mThreadTimers.erase(mThreadTimers.begin() + i);
+                else
+                    i++;
+            }
+            return totals;
+        }
+
+        void loop()
+        {
+            auto stopRequested = false;
+            while (!stopRequested)
+            {
+                std::unique_lock<std::mutex> threadLock{mThreadMutex};
+                mConditionVariable.wait_for(threadLock, PROFILER_AGGREGATION_PERIOD, [this]{ return mStopRequested; });
+                stopRequested = mStopRequested;
+                threadLock.unlock();
+                // Period statistics
+                const std::lock_guard<std::mutex> lock{mMutex};
+                const auto totals = aggregate();
+                for (auto timerId = 0u ; timerId < mNames.size() ; timerId++)
+                {
+                    mPeriodTotals[timerId].ticks = totals[timerId].ticks - mLastTotals[timerId].ticks;
+                    mPeriodTotals[timerId].calls = totals[timerId].calls - mLastTotals[timerId].calls;
+                }
+                mLastTotals = totals;
+            }
+        }
+    };
+
+    ProfilerRegistry sProfilerRegistry;
+
+    #ifdef PROFILER_ENABLED
         void printAveragedTimeMsCommon(const double timePast, const unsigned long long timeCounter, const int line,
                                        const std::string& function, const std::string& file)
         {
@@ -83,68 +302,68 @@ namespace op
         #endif
     }
 
-    const std::string Profiler::timerInit(const int line, const std::string& function, const std::string& file)
+    unsigned int Profiler::registerTimer(const int line, const std::string& function, const std::string& file)
     {
-        #ifdef PROFILER_ENABLED
-            const auto key = getKey(line, function, file);
-            std::unique_lock<std::mutex> lock{sMutexProfiler};
-            if (sProfilerTuple.count(key) > 0)
-                std::get<2>(sProfilerTuple[key]) = std::chrono::high_resolution_clock::now();
-            else
-                sProfilerTuple[key] = {std::make_tuple(0., 0ull, std::chrono::high_resolution_clock::now())};
-            lock.unlock();
-            return key;
-        #else
-            UNUSED(line);
-            UNUSED(function);
-            UNUSED(file);
-            return "";
-        #endif
+        try
+        {
+            return sProfilerRegistry.registerTimer(file + ":" + function + "():" + std::to_string(line));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return PROFILER_INVALID_TIMER;
+        }
     }
 
-    void Profiler::timerEnd(const std::string& key)
+    ProfilerKey Profiler::timerInit(const unsigned int timerId)
     {
-        #ifdef PROFILER_ENABLED
-            const std::lock_guard<std::mutex> lock{sMutexProfiler};
-            if (sProfilerTuple.count(key) > 0)
-            {
-                auto tuple = sProfilerTuple[key];
-                // Time between init & end
-                const auto timeNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
-                    std::chrono::high_resolution_clock::now() - std::get<2>(tuple)
-                ).count();
-                // Accumulate averaged time
-                std::get<0>(tuple) += timeNs;
-                std::get<1>(tuple)++;
-
-                sProfilerTuple[key] = tuple;
-            }
-            else
-                error("Profiler::timerEnd called with a non-existing key.", __LINE__, __FUNCTION__, __FILE__);
-        #else
-            UNUSED(key);
-        #endif
+        return ProfilerKey{timerId, getTicks()};
+    }
+
+    ProfilerKey Profiler::timerInit(const int line, const std::string& function, const std::string& file)
+    {
+        try
+        {
+            return timerInit(registerTimer(line, function, file));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return ProfilerKey{PROFILER_INVALID_TIMER, 0ull};
+        }
     }
 
-    void Profiler::printAveragedTimeMsOnIterationX(const std::string& key, const int line, const std::string& function,
-                                                   const std::string& file, const unsigned long long x)
+    void Profiler::timerEnd(const ProfilerKey& profilerKey)
+    {
+        const auto ticks = getTicks();
+        if (profilerKey.timerId < PROFILER_MAX_TIMERS)
+        {
+            // Only this thread writes them, so no atomic read-modify-write is required
+            auto& accumulator = sProfilerRegistry.getAccumulator(profilerKey.timerId);
+            accumulator.ticks.store(
+                accumulator.ticks.load(std::memory_order_relaxed)
+                + (ticks > profilerKey.ticks ? ticks - profilerKey.ticks : 0ull), std::memory_order_relaxed);
+            accumulator.calls.store(
+                accumulator.calls.load(std::memory_order_relaxed) + 1ull, std::memory_order_relaxed);
+        }
+    }
+
+    void Profiler::printAveragedTimeMsOnIterationX(
+        const ProfilerKey& profilerKey, const int line, const std::string& function, const std::string& file,
+        const unsigned long long x)
     {
         #ifdef PROFILER_ENABLED
-            std::unique_lock<std::mutex> lock{sMutexProfiler};
-            if (sProfilerTuple.count(key) > 0)
+            if (profilerKey.timerId < PROFILER_MAX_TIMERS)
             {
-                const auto tuple = sProfilerTuple[key];
-                lock.unlock();
-                if (std::get<1>(tuple) == x)
-                {
-                    printAveragedTimeMsCommon(std::get<0>(tuple), std::get<1>(tuple), line, function, file);
-                }
+                const auto& accumulator = sProfilerRegistry.getAccumulator(profilerKey.timerId);
+                const auto calls = accumulator.calls.load(std::memory_order_relaxed);
+                if (calls == x)
+                    printAveragedTimeMsCommon(
+                        accumulator.ticks.load(std::memory_order_relaxed) * 1e9 / sProfilerRegistry.getTicksPerSecond(),
+                        calls, line, function, file);
             }
-            else
-                error("Profiler::printAveragedTimeMsOnIterationX called with a non-existing key.",
-                      __LINE__, __FUNCTION__, __FILE__);
         #else
-            UNUSED(key);
+            UNUSED(profilerKey);
             UNUSED(line);
             UNUSED(function);
             UNUSED(file);
@@ -152,32 +371,28 @@ namespace op
         #endif
     }
 
-    void Profiler::printAveragedTimeMsEveryXIterations(const std::string& key, const int line,
-                                                       const std::string& function, const std::string& file,
-                                                       const unsigned long long x)
+    void Profiler::printAveragedTimeMsEveryXIterations(
+        const ProfilerKey& profilerKey, const int line, const std::string& function, const std::string& file,
+        const unsigned long long x)
     {
         #ifdef PROFILER_ENABLED
-            std::unique_lock<std::mutex> lock{sMutexProfiler};
-            if (sProfilerTuple.count(key) > 0)
+            if (profilerKey.timerId < PROFILER_MAX_TIMERS)
             {
-                const auto tupleElement = sProfilerTuple[key];
-                lock.unlock();
-                if (std::get<1>(tupleElement) == x)
+                auto& accumulator = sProfilerRegistry.getAccumulator(profilerKey.timerId);
+                const auto ticks = accumulator.ticks.load(std::memory_order_relaxed);
+                const auto calls = accumulator.calls.load(std::memory_order_relaxed);
+                if (calls - accumulator.printCalls == x)
                 {
-                    printAveragedTimeMsCommon(std::get<0>(tupleElement), std::get<1>(tupleElement), line, function, file);
-
+                    printAveragedTimeMsCommon(
+                        (ticks - accumulator.printTicks) * 1e9 / sProfilerRegistry.getTicksPerSecond(),
+                        calls - accumulator.printCalls, line, function, file);
                     // Reset
-                    const std::lock_guard<std::mutex> lockGuard{sMutexProfiler};
-                    auto& tuple = sProfilerTuple[key];
-                    std::get<0>(tuple) = 0.;
-                    std::get<1>(tuple) = 0;
+                    accumulator.printTicks = ticks;
+                    accumulator.printCalls = calls;
                 }
             }
-            else
-                error("Profiler::printAveragedTimeMsEveryXIterations called with a non-existing key.",
-                      __LINE__, __FUNCTION__, __FILE__);
         #else
-            UNUSED(key);
+            UNUSED(profilerKey);
             UNUSED(line);
             UNUSED(function);
             UNUSED(file);
@@ -185,6 +400,19 @@ namespace op
         #endif
     }
 
+    std::vector<ProfilerTimerStats> Profiler::getTimerStats()
+    {
+        try
+        {
+            return sProfilerRegistry.getTimerStats();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
     void Profiler::profileGpuMemory(const int line, const std::string& function, const std::string& file)
     {
         #ifdef PROFILER_ENABLED
@@ -0,0 +1,222 @@
+#include <openpose_private/utilities/renderCpu.hpp>
+#include <cmath> // std::ceil, std::floor, std::sqrt
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose_private/utilities/avx.hpp>
+#include <openpose_private/utilities/parallelFor.hpp>
+
+namespace op
+{
+    // Tiles of TILE_SIZE x TILE_SIZE pixels
+    const auto TILE_SIZE = 64;
+
+    // Per-primitive constants, shared by all the pixels
+    template <typename T>
+    struct RasterPrimitiveCpu
+    {
+        // Bounding box in pixels, [xBegin, xEnd) x [yBegin, yEnd)
+        int xBegin;
+        int xEnd;
+        int yBegin;
+        int yEnd;
+        T x1;
+        T y1;
+        T dx;
+        T dy;
+        T invLength2; // 0 for discs
+        T outer; // radiusOuter + 0.5 (1-pixel wide anti-aliased border)
+        T inner; // radiusInner - 0.5, only used if hasInner
+        bool hasInner;
+        T bgr[3];
+    };
+
+    template <typename T>
+    inline T getCoverage(const RasterPrimitiveCpu<T>& primitive, const T x, const T y)
+    {
+        // Distance to the closest point of the segment
+        const auto px = x - primitive.x1;
+        const auto py = y - primitive.y1;
+        const auto t = fastTruncate((px*primitive.dx + py*primitive.dy) * primitive.invLength2, T(0), T(1));
+        const auto ex = px - t*primitive.dx;
+        const auto ey = py - t*primitive.dy;
+        const auto distance = std::sqrt(ex*ex + ey*ey);
+        auto coverage = fastTruncate(primitive.outer - distance, T(0), T(1));
+        if (primitive.hasInner)
+            coverage *= fastTruncate(distance - primitive.inner, T(0), T(1));
+        return coverage;
+    }
+
+    template <typename T>
+    inline void blendPixel(T* pixelPtr, const T* const bgr, const T coverage)
+    {
+        pixelPtr[0] += coverage * (bgr[0] - pixelPtr[0]);
+        pixelPtr[1] += coverage * (bgr[1] - pixelPtr[1]);
+        pixelPtr[2] += coverage * (bgr[2] - pixelPtr[2]);
+    }
+
+    template <typename T>
+    void renderSpan(T* rowPtr, const RasterPrimitiveCpu<T>& primitive, const int xBegin, const int xEnd, const int y)
+    {
+        for (auto x = xBegin ; x < xEnd ; x++)
+        {
+            const auto coverage = getCoverage(primitive, T(x), T(y));
+            if (coverage > T(0))
+                blendPixel(rowPtr + 3*x, primitive.bgr, coverage);
+        }
+    }
+
+    #ifdef WITH_AVX
+        // The coverage of 8 consecutive pixels at once. Most of the bounding box of a (diagonal) capsule is empty,
+        // so the groups with no coverage are skipped without touching the frame.
+        OP_TARGET_AVX2 void renderSpanAvx2(
+            float* rowPtr, const RasterPrimitiveCpu<float>& primitive, const int xBegin, const int xEnd, const int y)
+        {
+            const auto zero = _mm256_setzero_ps();
+            const auto one = _mm256_set1_ps(1.f);
+            const auto dx = _mm256_set1_ps(primitive.dx);
+            const auto dy = _mm256_set1_ps(primitive.dy);
+            const auto invLength2 = _mm256_set1_ps(primitive.invLength2);
+            const auto outer = _mm256_set1_ps(primitive.outer);
+            const auto inner = _mm256_set1_ps(primitive.inner);
+            const auto py = _mm256_set1_ps(float(y) - primitive.y1);
+            const auto pyDy = _mm256_mul_ps(py, dy);
+            const auto laneOffsets = _mm256_setr_ps(0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f);
+            ALIGN32(float coverages[8]);
+            auto x = xBegin;
+            for ( ; x + 8 <= xEnd ; x += 8)
+            {
+                const auto px = _mm256_add_ps(_mm256_set1_ps(float(x) - primitive.x1), laneOffsets);
+                const auto t = _mm256_min_ps(_mm256_max_ps(
+                    _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(px, dx), pyDy), invLength2), zero), one);
+                const auto ex = _mm256_sub_ps(px, _mm256_mul_ps(t, dx));
+                const auto ey = _mm256_sub_ps(py, _mm256_mul_ps(t, dy));
+                const auto distance = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(ex, ex), _mm256_mul_ps(ey, ey)));
+                auto coverage = _mm256_min_ps(_mm256_max_ps(_mm256_sub_ps(outer, distance), zero), one);
+                if (primitive.hasInner)
+                    coverage = _mm256_mul_ps(
+                        coverage, _mm256_min_ps(_mm256_max_ps(_mm256_sub_ps(distance, inner), zero), one));
+                auto mask = _mm256_movemask_ps(_mm256_cmp_ps(coverage, zero, _CMP_GT_OQ));
+                if (mask == 0)
+                    continue;
+                _mm256_store_ps(coverages, coverage);
+                for (auto lane = 0 ; mask != 0 ; lane++, mask >>= 1)
+                    if (mask & 1)
+                        blendPixel(rowPtr + 3*(x+lane), primitive.bgr, coverages[lane]);
+            }
+            renderSpan(rowPtr, primitive, x, xEnd, y);
+        }
+    #endif
+
+    template <typename T>
+    void renderTileSpan(
+        T* rowPtr, const RasterPrimitiveCpu<T>& primitive, const int xBegin, const int xEnd, const int y)
+    {
+        renderSpan(rowPtr, primitive, xBegin, xEnd, y);
+    }
+
+    void renderTileSpan(
+        float* rowPtr, const RasterPrimitiveCpu<float>& primitive, const int xBegin, const int xEnd, const int y)
+    {
+        #ifdef WITH_AVX
+            static const auto sUseAvx2 = cpuSupportsAvx2();
+            if (sUseAvx2)
+            {
+                renderSpanAvx2(rowPtr, primitive, xBegin, xEnd, y);
+                return;
+            }
+        #endif
+        renderSpan(rowPtr, primitive, xBegin, xEnd, y);
+    }
+
+    template <typename T>
+    void renderPrimitivesCpu(
+        T* framePtr, const int width, const int height, const std::vector<RenderPrimitiveCpu<T>>& primitives)
+    {
+        try
+        {
+            if (framePtr == nullptr || width < 1 || height < 1 || primitives.empty())
+                return;
+
+            // Bounding boxes (clipped to the frame) and per-primitive constants
+            std::vector<RasterPrimitiveCpu<T>> rasterPrimitives;
+            rasterPrimitives.reserve(primitives.size());
+            Point<int> unionBegin{width, height};
+            Point<int> unionEnd{0, 0};
+            for (const auto& primitive : primitives)
+            {
+                if (primitive.radiusOuter <= T(0))
+                    continue;
+                const auto margin = primitive.radiusOuter + T(1);
+                RasterPrimitiveCpu<T> rasterPrimitive;
+                rasterPrimitive.xBegin = fastMax(0, (int)std::floor(fastMin(primitive.x1, primitive.x2) - margin));
+                rasterPrimitive.xEnd = fastMin(
+                    width, (int)std::ceil(fastMax(primitive.x1, primitive.x2) + margin) + 1);
+                rasterPrimitive.yBegin = fastMax(0, (int)std::floor(fastMin(primitive.y1, primitive.y2) - margin));
+                rasterPrimitive.yEnd = fastMin(
+                    height, (int)std::ceil(fastMax(primitive.y1, primitive.y2) + margin) + 1);
+                if (rasterPrimitive.xBegin >= rasterPrimitive.xEnd || rasterPrimitive.yBegin >= rasterPrimitive.yEnd)
+                    continue;
+                rasterPrimitive.x1 = primitive.x1;
+                rasterPrimitive.y1 = primitive.y1;
+                rasterPrimitive.dx = primitive.x2 - primitive.x1;
+                rasterPrimitive.dy = primitive.y2 - primitive.y1;
+                const auto length2 = rasterPrimitive.dx*rasterPrimitive.dx + rasterPrimitive.dy*rasterPrimitive.dy;
+                rasterPrimitive.invLength2 = (length2 > T(0) ? T(1) / length2 : T(0));
+                rasterPrimitive.outer = primitive.radiusOuter + T(0.5);
+                rasterPrimitive.inner = primitive.radiusInner - T(0.5);
+                rasterPrimitive.hasInner = primitive.radiusInner > T(0);
+                for (auto channel = 0 ; channel < 3 ; channel++)
+                    rasterPrimitive.bgr[channel] = primitive.bgr[channel];
+                unionBegin.x = fastMin(unionBegin.x, rasterPrimitive.xBegin);
+                unionBegin.y = fastMin(unionBegin.y, rasterPrimitive.yBegin);
+                unionEnd.x = fastMax(unionEnd.x, rasterPrimitive.xEnd);
+                unionEnd.y = fastMax(unionEnd.y, rasterPrimitive.yEnd);
+                rasterPrimitives.emplace_back(rasterPrimitive);
+            }
+            if (rasterPrimitives.empty())
+                return;
+
+            // Tiles intersecting at least 1 bounding box
+            std::vector<Rectangle<int>> tiles;
+            for (auto tileY = unionBegin.y ; tileY < unionEnd.y ; tileY += TILE_SIZE)
+            {
+                for (auto tileX = unionBegin.x ; tileX < unionEnd.x ; tileX += TILE_SIZE)
+                {
+                    const Rectangle<int> tile{
+                        tileX, tileY, fastMin(TILE_SIZE, unionEnd.x - tileX), fastMin(TILE_SIZE, unionEnd.y - tileY)};
+                    for (const auto& rasterPrimitive : rasterPrimitives)
+                    {
+                        if (rasterPrimitive.xBegin < tile.x + tile.width && rasterPrimitive.xEnd > tile.x
+                            && rasterPrimitive.yBegin < tile.y + tile.height && rasterPrimitive.yEnd > tile.y)
+                        {
+                            tiles.emplace_back(tile);
+                            break;
+                        }
+                    }
+                }
+            }
+
+            // Each tile draws all its primitives in order, so the overlaps are resolved as if drawn sequentially
+            parallelFor(0, (int)tiles.size(), [&](const int tileIndex)
+            {
+                const auto& tile = tiles[tileIndex];
+                for (const auto& rasterPrimitive : rasterPrimitives)
+                {
+                    const auto xBegin = fastMax(tile.x, rasterPrimitive.xBegin);
+                    const auto xEnd = fastMin(tile.x + tile.width, rasterPrimitive.xEnd);
+                    const auto yBegin = fastMax(tile.y, rasterPrimitive.yBegin);
+                    const auto yEnd = fastMin(tile.y + tile.height, rasterPrimitive.yEnd);
+                    for (auto y = yBegin ; y < yEnd ; y++)
+                        renderTileSpan(framePtr + 3*y*width, rasterPrimitive, xBegin, xEnd, y);
+                }
+            });
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+    template void renderPrimitivesCpu(
+        float* framePtr, const int width, const int height, const std::vector<RenderPrimitiveCpu<float>>& primitives);
+    template void renderPrimitivesCpu(
+        double* framePtr, const int width, const int height, const std::vector<RenderPrimitiveCpu<double>>& primitives);
+}
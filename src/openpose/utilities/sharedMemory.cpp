@@ -0,0 +1,166 @@
+#include <openpose_private/utilities/sharedMemory.hpp>
+#ifdef _WIN32
+    #include <windows.h> // CreateFileMappingA, OpenFileMappingA, MapViewOfFile
+#elif defined __unix__ || defined __APPLE__
+    #include <fcntl.h> // O_CREAT, O_RDWR
+    #include <sys/mman.h> // mmap, shm_open
+    #include <sys/stat.h> // fstat
+    #include <unistd.h> // close, ftruncate
+#else
+    #error Unknown environment!
+#endif
+
+namespace op
+{
+    namespace
+    {
+        // POSIX names start with `/`, Windows ones are local to the user session
+        std::string getSharedMemoryName(const std::string& name)
+        {
+            #ifdef _WIN32
+                return "Local\\" + name;
+            #else
+                return (!name.empty() && name[0] == '/' ? name : "/" + name);
+            #endif
+        }
+    }
+
+    SharedMemory::SharedMemory(const std::string& name, const unsigned long long size) :
+        mName{getSharedMemoryName(name)},
+        mOwner{true},
+        pData{nullptr},
+        mSize{size}
+        #ifdef _WIN32
+            ,
+            pMappingHandle{nullptr}
+        #endif
+    {
+        try
+        {
+            if (name.empty() || size == 0ull)
+                error("The shared memory name and size cannot be empty.", __LINE__, __FUNCTION__, __FILE__);
+            #ifdef _WIN32
+                pMappingHandle = CreateFileMappingA(
+                    INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, (DWORD)(size >> 32), (DWORD)(size & 0xffffffffull),
+                    mName.c_str());
+                if (pMappingHandle == nullptr)
+                    error("Shared memory " + name + " could not be created.", __LINE__, __FUNCTION__, __FILE__);
+                pData = (unsigned char*)MapViewOfFile(pMappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+                if (pData == nullptr)
+                    error("Shared memory " + name + " could not be mapped.", __LINE__, __FUNCTION__, __FILE__);
+            #else
+                const auto fileDescriptor = shm_open(mName.c_str(), O_CREAT | O_RDWR, 0644);
+                if (fileDescriptor < 0)
+                    error("Shared memory " + name + " could not be created.", __LINE__, __FUNCTION__, __FILE__);
+                if (ftruncate(fileDescriptor, (off_t)size) != 0)
+                {
+                    close(fileDescriptor);
+                    error("Shared memory " + name + " could not be resized.", __LINE__, __FUNCTION__, __FILE__);
+                }
+                auto* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+                // The mapping keeps its own reference
+                close(fileDescriptor);
+                if (data == MAP_FAILED)
+                    error("Shared memory " + name + " could not be mapped.", __LINE__, __FUNCTION__, __FILE__);
+                pData = (unsigned char*)data;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            release();
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    SharedMemory::SharedMemory(const std::string& name, const bool writable) :
+        mName{getSharedMemoryName(name)},
+        mOwner{false},
+        pData{nullptr},
+        mSize{0ull}
+        #ifdef _WIN32
+            ,
+            pMappingHandle{nullptr}
+        #endif
+    {
+        try
+        {
+            const auto notFoundMessage = "Shared memory " + name + " could not be opened (check that the process"
+                                         " writing into it is running).";
+            #ifdef _WIN32
+                const auto access = (writable ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ);
+                pMappingHandle = OpenFileMappingA(access, FALSE, mName.c_str());
+                if (pMappingHandle == nullptr)
+                    error(notFoundMessage, __LINE__, __FUNCTION__, __FILE__);
+                pData = (unsigned char*)MapViewOfFile(pMappingHandle, access, 0, 0, 0);
+                if (pData == nullptr)
+                    error("Shared memory " + name + " could not be mapped.", __LINE__, __FUNCTION__, __FILE__);
+                MEMORY_BASIC_INFORMATION memoryInformation;
+                if (VirtualQuery(pData, &memoryInformation, sizeof(memoryInformation)) == 0)
+                    error("Size of shared memory " + name + " could not be read.", __LINE__, __FUNCTION__, __FILE__);
+                mSize = (unsigned long long)memoryInformation.RegionSize;
+            #else
+                const auto fileDescriptor = shm_open(mName.c_str(), (writable ? O_RDWR : O_RDONLY), 0);
+                if (fileDescriptor < 0)
+                    error(notFoundMessage, __LINE__, __FUNCTION__, __FILE__);
+                struct stat fileStatus;
+                if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size <= 0)
+                {
+                    close(fileDescriptor);
+                    error("Size of shared memory " + name + " could not be read.", __LINE__, __FUNCTION__, __FILE__);
+                }
+                mSize = (unsigned long long)fileStatus.st_size;
+                auto* data = mmap(
+                    nullptr, mSize, (writable ? PROT_READ | PROT_WRITE : PROT_READ), MAP_SHARED, fileDescriptor, 0);
+                close(fileDescriptor);
+                if (data == MAP_FAILED)
+                    error("Shared memory " + name + " could not be mapped.", __LINE__, __FUNCTION__, __FILE__);
+                pData = (unsigned char*)data;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            release();
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    SharedMemory::~SharedMemory()
+    {
+        try
+        {
+            release();
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned char* SharedMemory::getData() const
+    {
+        return pData;
+    }
+
+    unsigned long long SharedMemory::getSize() const
+    {
+        return mSize;
+    }
+
+    void SharedMemory::release()
+    {
+        #ifdef _WIN32
+            if (pData != nullptr)
+                UnmapViewOfFile(pData);
+            if (pMappingHandle != nullptr)
+                CloseHandle(pMappingHandle);
+            pMappingHandle = nullptr;
+        #else
+            if (pData != nullptr)
+                munmap(pData, mSize);
+            // The processes that already mapped it keep it until they unmap it
+            if (mOwner)
+                shm_unlink(mName.c_str());
+        #endif
+        pData = nullptr;
+    }
+}
@@ -0,0 +1,241 @@
+#include <openpose/utilities/tracer.hpp>
+#include <fstream>
+#include <locale>
+#include <mutex>
+#include <set>
+#ifdef USE_NVTX
+    #include <nvtx3/nvToolsExt.h>
+#endif
+
+namespace op
+{
+    struct TraceEvent
+    {
+        const char* name;
+        long long id;
+        std::chrono::high_resolution_clock::time_point begin;
+        std::chrono::high_resolution_clock::time_point end;
+    };
+
+    // Ring buffer of the events of a single thread. Its mutex is only contended while saving the trace
+    struct TraceBuffer
+    {
+        std::mutex mutex;
+        std::string threadName;
+        std::vector<TraceEvent> events;
+        unsigned long long nextEvent;
+        bool isFull;
+
+        TraceBuffer() :
+            nextEvent{0ull},
+            isFull{false}
+        {
+        }
+    };
+
+    std::atomic<bool> Tracer::sEnabled{false};
+    std::atomic<unsigned long long> sTracerMaxEventsPerThread{100000ull};
+    std::chrono::high_resolution_clock::time_point sTracerBegin{std::chrono::high_resolution_clock::now()};
+    std::vector<std::shared_ptr<TraceBuffer>> sTraceBuffers;
+    std::set<std::string> sTraceNames;
+    std::mutex sTracerMutex;
+
+    TraceBuffer& getThreadTraceBuffer()
+    {
+        // Each thread registers its own buffer the first time it records
+        thread_local std::shared_ptr<TraceBuffer> spTraceBuffer;
+        if (spTraceBuffer == nullptr)
+        {
+            spTraceBuffer = std::make_shared<TraceBuffer>();
+            const std::lock_guard<std::mutex> lock{sTracerMutex};
+            spTraceBuffer->threadName = "Thread " + std::to_string(sTraceBuffers.size());
+            sTraceBuffers.emplace_back(spTraceBuffer);
+        }
+        return *spTraceBuffer;
+    }
+
+    std::string escapeJson(const std::string& text)
+    {
+        std::string textEscaped;
+        for (const auto character : text)
+        {
+            if (character == '"' || character == '\\')
+                textEscaped += '\\';
+            textEscaped += character;
+        }
+        return textEscaped;
+    }
+
+    double getTraceMicroseconds(const std::chrono::high_resolution_clock::time_point& timePoint)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(timePoint - sTracerBegin).count() * 1e-3;
+    }
+
+    void Tracer::setEnabled(const bool enabled, const unsigned long long maxEventsPerThread)
+    {
+        try
+        {
+            // Sanity check
+            if (maxEventsPerThread == 0)
+                error("maxEventsPerThread must be greater than 0.", __LINE__, __FUNCTION__, __FILE__);
+            if (enabled)
+            {
+                const std::lock_guard<std::mutex> lock{sTracerMutex};
+                sTracerMaxEventsPerThread = maxEventsPerThread;
+                sTracerBegin = std::chrono::high_resolution_clock::now();
+                for (auto& spTraceBuffer : sTraceBuffers)
+                {
+                    const std::lock_guard<std::mutex> lockBuffer{spTraceBuffer->mutex};
+                    spTraceBuffer->events.clear();
+                    spTraceBuffer->nextEvent = 0ull;
+                    spTraceBuffer->isFull = false;
+                }
+            }
+            sEnabled = enabled;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool Tracer::isEnabled()
+    {
+        return sEnabled.load(std::memory_order_relaxed);
+    }
+
+    const char* Tracer::getName(const std::string& name)
+    {
+        try
+        {
+            // std::set elements never move, so the pointer remains valid
+            const std::lock_guard<std::mutex> lock{sTracerMutex};
+            return sTraceNames.emplace(name).first->c_str();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    void Tracer::record(
+        const char* const name, const long long id, const std::chrono::high_resolution_clock::time_point& begin,
+        const std::chrono::high_resolution_clock::time_point& end)
+    {
+        try
+        {
+            if (isEnabled())
+            {
+                auto& traceBuffer = getThreadTraceBuffer();
+                const std::lock_guard<std::mutex> lock{traceBuffer.mutex};
+                const auto maxEvents = sTracerMaxEventsPerThread.load(std::memory_order_relaxed);
+                if (traceBuffer.events.size() != maxEvents)
+                {
+                    traceBuffer.events.resize(maxEvents);
+                    traceBuffer.nextEvent = 0ull;
+                    traceBuffer.isFull = false;
+                }
+                traceBuffer.events[traceBuffer.nextEvent] = TraceEvent{name, id, begin, end};
+                if (++traceBuffer.nextEvent == maxEvents)
+                {
+                    traceBuffer.nextEvent = 0ull;
+                    traceBuffer.isFull = true;
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void Tracer::setThreadName(const std::string& threadName)
+    {
+        try
+        {
+            auto& traceBuffer = getThreadTraceBuffer();
+            const std::lock_guard<std::mutex> lock{traceBuffer.mutex};
+            traceBuffer.threadName = threadName;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void Tracer::saveChromeTrace(const std::string& filePath)
+    {
+        try
+        {
+            std::ofstream traceFile{filePath};
+            if (!traceFile.is_open())
+                error("Trace file could not be opened (" + filePath + ").", __LINE__, __FUNCTION__, __FILE__);
+            traceFile.imbue(std::locale::classic());
+            traceFile << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+            auto firstEvent = true;
+            auto numberEvents = 0ull;
+            const std::lock_guard<std::mutex> lock{sTracerMutex};
+            for (auto threadIndex = 0u ; threadIndex < sTraceBuffers.size() ; threadIndex++)
+            {
+                auto& traceBuffer = *sTraceBuffers[threadIndex];
+                const std::lock_guard<std::mutex> lockBuffer{traceBuffer.mutex};
+                // Thread name
+                traceFile << (firstEvent ? "\n" : ",\n")
+                    << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadIndex
+                    << ",\"args\":{\"name\":\"" << escapeJson(traceBuffer.threadName) << "\"}}";
+                firstEvent = false;
+                // Events (from the oldest one)
+                const auto eventsSize = (traceBuffer.isFull ? traceBuffer.events.size() : traceBuffer.nextEvent);
+                const auto firstIndex = (traceBuffer.isFull ? traceBuffer.nextEvent : 0ull);
+                for (auto i = 0ull ; i < eventsSize ; i++)
+                {
+                    const auto& traceEvent = traceBuffer.events[(firstIndex + i) % traceBuffer.events.size()];
+                    const auto beginMicroseconds = getTraceMicroseconds(traceEvent.begin);
+                    traceFile << ",\n{\"name\":\"" << escapeJson(traceEvent.name)
+                        << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadIndex
+                        << ",\"ts\":" << std::fixed << beginMicroseconds
+                        << ",\"dur\":" << (getTraceMicroseconds(traceEvent.end) - beginMicroseconds);
+                    if (traceEvent.id >= 0)
+                        traceFile << ",\"args\":{\"id\":" << traceEvent.id << "}";
+                    traceFile << "}";
+                }
+                numberEvents += eventsSize;
+            }
+            traceFile << "\n]}\n";
+            opLog("Trace with " + std::to_string(numberEvents) + " events saved in " + filePath + ".",
+                  Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    TraceRange::TraceRange(const char* const name, const long long id) :
+        pName{name},
+        mId{id},
+        mEnabled{Tracer::isEnabled()},
+        mBegin{mEnabled ? std::chrono::high_resolution_clock::now() : std::chrono::high_resolution_clock::time_point{}}
+    {
+        #ifdef USE_NVTX
+            nvtxRangePushA(pName);
+        #endif
+    }
+
+    TraceRange::~TraceRange()
+    {
+        try
+        {
+            #ifdef USE_NVTX
+                nvtxRangePop();
+            #endif
+            if (mEnabled)
+                Tracer::record(pName, mId, mBegin, std::chrono::high_resolution_clock::now());
+        }
+        catch (const std::exception& e)
+        {
+            errorDestructor(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -0,0 +1,155 @@
+#include <openpose/wrapper/runtimeConfigurator.hpp>
+#include <mutex>
+
+namespace op
+{
+    struct RuntimeConfigurator::ImplRuntimeConfigurator
+    {
+        std::mutex mMutex;
+        std::shared_ptr<ScaleAndSizeExtractor> spScaleAndSizeExtractor;
+        bool mNetInputSizeEditable;
+        std::vector<std::shared_ptr<FaceExtractorNet>> mFaceExtractorNets;
+        std::vector<std::shared_ptr<HandExtractorNet>> mHandExtractorNets;
+        std::vector<std::shared_ptr<Renderer>> mPoseRenderers;
+        // Queued until the next applyPending() ({0, 0} if none)
+        Point<int> mPendingNetInputSize;
+
+        ImplRuntimeConfigurator() :
+            mNetInputSizeEditable{false},
+            mPendingNetInputSize{0, 0}
+        {
+        }
+    };
+
+    RuntimeConfigurator::RuntimeConfigurator() :
+        upImpl{new ImplRuntimeConfigurator{}}
+    {
+    }
+
+    RuntimeConfigurator::~RuntimeConfigurator()
+    {
+    }
+
+    void RuntimeConfigurator::setComponents(
+        const std::shared_ptr<ScaleAndSizeExtractor>& scaleAndSizeExtractor, const bool netInputSizeEditable,
+        const std::vector<std::shared_ptr<FaceExtractorNet>>& faceExtractorNets,
+        const std::vector<std::shared_ptr<HandExtractorNet>>& handExtractorNets,
+        const std::vector<std::shared_ptr<Renderer>>& poseRenderers)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->spScaleAndSizeExtractor = scaleAndSizeExtractor;
+            upImpl->mNetInputSizeEditable = netInputSizeEditable;
+            upImpl->mFaceExtractorNets = faceExtractorNets;
+            upImpl->mHandExtractorNets = handExtractorNets;
+            upImpl->mPoseRenderers = poseRenderers;
+            upImpl->mPendingNetInputSize = Point<int>{0, 0};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void RuntimeConfigurator::clear()
+    {
+        try
+        {
+            setComponents(nullptr, false, {}, {}, {});
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void RuntimeConfigurator::reconfigure(const WrapperStructRuntime& wrapperStructRuntime)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            // Sanity checks (before changing anything)
+            const auto& netInputSize = wrapperStructRuntime.netInputSize;
+            const auto changeNetInputSize = (netInputSize.x != 0 || netInputSize.y != 0);
+            if (changeNetInputSize)
+            {
+                if (upImpl->spScaleAndSizeExtractor == nullptr)
+                    error("The network input resolution can only be changed while the body network is running.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (!upImpl->mNetInputSizeEditable)
+                    error("The network input resolution cannot be changed with an adaptive network resolution"
+                          " (`--latency_target_ms`) nor with tiled inference (`--tiled_input_resolution`).",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if ((netInputSize.x <= 0 && netInputSize.y <= 0)
+                    || (netInputSize.x > 0 && netInputSize.x % 16 != 0)
+                    || (netInputSize.y > 0 && netInputSize.y % 16 != 0))
+                    error("The new network input resolution must be multiples of 16 (or -1 for 1 of its"
+                          " dimensions).", __LINE__, __FUNCTION__, __FILE__);
+            }
+            if (wrapperStructRuntime.face >= 0 && upImpl->mFaceExtractorNets.empty())
+                error("The face keypoint detection can only be enabled or disabled if it was configured"
+                      " (WrapperStructFace::enable).", __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructRuntime.hand >= 0 && upImpl->mHandExtractorNets.empty())
+                error("The hand keypoint detection can only be enabled or disabled if it was configured"
+                      " (WrapperStructHand::enable).", __LINE__, __FUNCTION__, __FILE__);
+            const auto changeRender = (wrapperStructRuntime.blendOriginalFrame >= 0
+                                       || wrapperStructRuntime.alphaKeypoint >= 0.f
+                                       || wrapperStructRuntime.alphaHeatMap >= 0.f
+                                       || wrapperStructRuntime.elementToRender >= 0);
+            if (changeRender && upImpl->mPoseRenderers.empty())
+                error("The render settings can only be changed if the body keypoints are rendered.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructRuntime.alphaKeypoint > 1.f || wrapperStructRuntime.alphaHeatMap > 1.f)
+                error("The new alphaKeypoint and alphaHeatMap must be between 0 and 1.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Face and hand (thread-safe, the networks are loaded by their own thread if needed)
+            if (wrapperStructRuntime.face >= 0)
+                for (const auto& faceExtractorNet : upImpl->mFaceExtractorNets)
+                    faceExtractorNet->setEnabled(wrapperStructRuntime.face > 0);
+            if (wrapperStructRuntime.hand >= 0)
+                for (const auto& handExtractorNet : upImpl->mHandExtractorNets)
+                    handExtractorNet->setEnabled(wrapperStructRuntime.hand > 0);
+            // Render settings (thread-safe)
+            for (const auto& poseRenderer : upImpl->mPoseRenderers)
+            {
+                if (wrapperStructRuntime.blendOriginalFrame >= 0)
+                    poseRenderer->setBlendOriginalFrame(wrapperStructRuntime.blendOriginalFrame > 0);
+                if (wrapperStructRuntime.alphaKeypoint >= 0.f)
+                    poseRenderer->setAlphaKeypoint(wrapperStructRuntime.alphaKeypoint);
+                if (wrapperStructRuntime.alphaHeatMap >= 0.f)
+                    poseRenderer->setAlphaHeatMap(wrapperStructRuntime.alphaHeatMap);
+                if (wrapperStructRuntime.elementToRender >= 0)
+                    poseRenderer->setElementToRender(wrapperStructRuntime.elementToRender);
+            }
+            // Network input resolution (applied between 2 frames)
+            if (changeNetInputSize)
+            {
+                upImpl->mPendingNetInputSize = netInputSize;
+                opLog("New network input resolution queued: " + netInputSize.toString() + ".", Priority::High);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void RuntimeConfigurator::applyPending()
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            if (upImpl->mPendingNetInputSize.x != 0 || upImpl->mPendingNetInputSize.y != 0)
+            {
+                if (upImpl->spScaleAndSizeExtractor != nullptr)
+                    upImpl->spScaleAndSizeExtractor->setNetInputResolution(upImpl->mPendingNetInputSize);
+                upImpl->mPendingNetInputSize = Point<int>{0, 0};
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -1,6 +1,10 @@
 #include <openpose/wrapper/wrapperAuxiliary.hpp>
+#include <limits> // std::numeric_limits
+#include <thread> // std::thread::hardware_concurrency
 #include <openpose/gpu/gpu.hpp>
 #include <openpose/thread/enumClasses.hpp>
+#include <openpose/utilities/fileSystem.hpp>
+#include <openpose/utilities/string.hpp>
 
 namespace op
 {
@@ -29,14 +33,17 @@ namespace op
                 || wrapperStructFace.alphaHeatMap < 0. || wrapperStructFace.alphaHeatMap > 1.
                 || wrapperStructHand.alphaHeatMap < 0. || wrapperStructHand.alphaHeatMap > 1.)
                 error("Alpha value for blending must be in the range [0,1].", __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructHand.concurrentWithFace && !(wrapperStructHand.enable && wrapperStructFace.enable))
+                opLog("Warning: `--face_hand_concurrent` has no effect unless both `--face` and `--hand` are"
+                      " enabled.", Priority::High);
             if (wrapperStructPose.scaleGap <= 0.f && wrapperStructPose.scalesNumber > 1)
                 error("The scale gap must be greater than 0 (it has no effect if the number of scales is 1).",
                       __LINE__, __FUNCTION__, __FILE__);
             if (!renderOutput && (!wrapperStructOutput.writeImages.empty()
-                || !wrapperStructOutput.writeVideo.empty()))
+                || !wrapperStructOutput.writeVideo.empty() || !wrapperStructOutput.streamVideo.empty()))
             {
-                const auto message = "In order to save the rendered frames (`--write_images` or `--write_video`), you"
-                                     " cannot disable `--render_pose`.";
+                const auto message = "In order to save or stream the rendered frames (`--write_images`,"
+                                     " `--write_video` or `--stream_video`), you cannot disable `--render_pose`.";
                 opLog(message, Priority::High);
             }
             if (!wrapperStructOutput.writeHeatMaps.empty() && wrapperStructPose.heatMapTypes.empty())
@@ -46,14 +53,23 @@ namespace op
                                      " wrapperStructPose.heatMapTypes.";
                 error(message, __LINE__, __FUNCTION__, __FILE__);
             }
+            const auto writeHeatMapsFormat = wrapperStructOutput.writeHeatMapsFormat.getStdString();
             if (!wrapperStructOutput.writeHeatMaps.empty()
-                && (wrapperStructPose.heatMapScaleMode != ScaleMode::UnsignedChar &&
-                        wrapperStructOutput.writeHeatMapsFormat.getStdString() != "float"))
+                && (wrapperStructPose.heatMapScaleMode != ScaleMode::UnsignedChar && writeHeatMapsFormat != "float"
+                    && writeHeatMapsFormat.find("opheat") != 0))
             {
                 const auto message = "In order to save the heatmaps, you must either set"
                                      " wrapperStructPose.heatMapScaleMode to ScaleMode::UnsignedChar (i.e., range"
-                                     " [0, 255]) or `--write_heatmaps_format` to `float` to storage floating numbers"
-                                     " in binary mode.";
+                                     " [0, 255]) or `--write_heatmaps_format` to `float` or `opheat` (or"
+                                     " `opheat_fp16` or `opheat_uint8`) to storage floating numbers in binary mode.";
+                error(message, __LINE__, __FUNCTION__, __FILE__);
+            }
+            if (!wrapperStructOutput.writeHeatMaps.empty() && wrapperStructPose.heatMapsSparseThreshold >= 0.f
+                && writeHeatMapsFormat != "float" && writeHeatMapsFormat.find("opheat") != 0)
+            {
+                const auto message = "The sparse heat maps (`--heatmaps_sparse_threshold`) are not scaled, so they can"
+                                     " only be saved with `--write_heatmaps_format` `float` or `opheat` (or"
+                                     " `opheat_fp16` or `opheat_uint8`).";
                 error(message, __LINE__, __FUNCTION__, __FILE__);
             }
             if (userOutputWsEmpty && threadManagerMode != ThreadManagerMode::Asynchronous
@@ -67,9 +83,16 @@ namespace op
                     !wrapperStructOutput.writeImages.empty() || !wrapperStructOutput.writeVideo.empty()
                         || !wrapperStructOutput.writeKeypoint.empty() || !wrapperStructOutput.writeJson.empty()
                         || !wrapperStructOutput.writeCocoJson.empty() || !wrapperStructOutput.writeHeatMaps.empty()
+                        || !wrapperStructOutput.writeBinary.empty() || !wrapperStructOutput.streamKeypointsUdp.empty()
+                        || !wrapperStructOutput.streamKeypointsShm.empty() || !wrapperStructOutput.streamVideo.empty()
+                        || !wrapperStructOutput.datumSend.empty()
                 );
                 const auto savingCvOutput = (
                     !wrapperStructOutput.writeImages.empty() || !wrapperStructOutput.writeVideo.empty()
+                        || !wrapperStructOutput.streamVideo.empty()
+                        || (!wrapperStructOutput.datumSend.empty()
+                            && (wrapperStructOutput.datumSendFields & DatumWireField::OutputFrame)
+                                != DatumWireField::None)
                 );
                 const bool guiEnabled = (wrapperStructGui.displayMode != DisplayMode::NoDisplay);
                 if (!guiEnabled && !savingCvOutput && renderOutput)
@@ -115,11 +138,106 @@ namespace op
                       " producerSharedPtr cannot be a nullptr). Otherwise, OpenPose would not know the frame rate"
                       " of that output video nor whether all the images maintain the same resolution. You might"
                       " use `--write_images` instead.", __LINE__, __FUNCTION__, __FILE__);
+            // Processes of a pipeline split across processes (see `--datum_send`) might only decode or save frames
+            const auto datumTransport = !wrapperStructInput.datumReceive.empty()
+                || !wrapperStructOutput.datumSend.empty();
             if (wrapperStructPose.poseMode == PoseMode::Disabled && !wrapperStructFace.enable
-                && !wrapperStructHand.enable)
+                && !wrapperStructHand.enable && !datumTransport)
                 error("Body, face, and hand keypoint detectors are disabled. You must enable at least one (i.e,"
                       " unselect `--body 0`, select `--face`, or select `--hand`.",
                       __LINE__, __FUNCTION__, __FILE__);
+            if (!wrapperStructInput.datumReceive.empty() && wrapperStructOutput.verbose > 0.)
+                error("The verbose printer (`--cli_verbose`) requires the OpenPose producer, so it is not available"
+                      " with `--datum_receive`.", __LINE__, __FUNCTION__, __FILE__);
+            if (!wrapperStructOutput.datumSend.empty()
+                && (wrapperStructOutput.datumSendJpegQuality < 0 || wrapperStructOutput.datumSendJpegQuality > 100))
+                error("The JPEG quality of `--datum_send_jpeg_quality` must be in the range [0, 100].",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (!wrapperStructOutput.datumSend.empty()
+                && wrapperStructOutput.datumSendFields == DatumWireField::None)
+                opLog("Warning: No Datum field is sent (`--datum_send_fields`), so the receiver only gets the frame"
+                      " numbers and names.", Priority::High);
+            if (!wrapperStructOutput.writeCocoJsonEval.empty() && wrapperStructOutput.writeCocoJson.empty())
+                error("COCO evaluation (`--write_coco_json_eval`) requires `--write_coco_json`.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            #ifndef USE_NVJPEG
+                if (wrapperStructOutput.writeJpgGpu)
+                    error("The GPU JPEG encoding (`--write_jpg_gpu`) requires OpenPose compiled with the"
+                          " `WITH_NVJPEG` CMake flag.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+            if (wrapperStructOutput.writeJpgGpu && wrapperStructOutput.writeImages.empty()
+                && wrapperStructOutput.writeHeatMaps.empty())
+                opLog("Warning: The GPU JPEG encoding (`--write_jpg_gpu`) has no effect without `--write_images`"
+                      " or `--write_heatmaps`.", Priority::High);
+            // Compressed keypoint packets
+            const auto compressesKeypoints = (wrapperStructOutput.streamKeypointsPrecision > 0.f
+                                              || wrapperStructOutput.streamKeypointsPrecision3D > 0.f);
+            if (wrapperStructOutput.streamKeypointsPrecision < 0.f
+                || wrapperStructOutput.streamKeypointsPrecision3D < 0.f)
+                error("The keypoint streaming precision (`--stream_keypoints_precision` and"
+                      " `--stream_keypoints_precision_3d`) cannot be negative.", __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructOutput.streamKeypointsKeyframe < 1)
+                error("The keyframe interval of the keypoint streaming (`--stream_keypoints_keyframe`) must be"
+                      " positive.", __LINE__, __FUNCTION__, __FILE__);
+            if (compressesKeypoints && wrapperStructOutput.streamKeypointsUdp.empty())
+                opLog("Warning: The keypoint packet compression (`--stream_keypoints_precision`) only applies to"
+                      " `--stream_keypoints_udp` (the shared memory packets are always raw floats).", Priority::High);
+            else if (wrapperStructOutput.streamKeypointsPrecision > 0.f && !wrapperStructExtra.identification
+                     && wrapperStructExtra.tracking < 0)
+                opLog("Warning: Without `--tracking` nor `--identification`, the compressed keypoint packets"
+                      " (`--stream_keypoints_precision`) cannot delta-encode the people, so they are larger.",
+                      Priority::High);
+            // Allocation metrics
+            if (wrapperStructOutput.allocationMetrics && wrapperStructOutput.metricsPort < 0)
+                opLog("Warning: The allocation metrics (`--allocation_metrics`) are recorded, but they are only"
+                      " exported with `--metrics_port`.", Priority::High);
+            // Per-frame timing
+            if (wrapperStructOutput.datumTiming && (wrapperStructPose.batchSize > 1 || wrapperStructPose.pipelined))
+                opLog("Warning: With `--batch_size` > 1 or `--pose_pipelined`, the frame timing (`--datum_timing`) does"
+                      " not include the GPU time of the pose network and post-processing.", Priority::High);
+            // ROI cache and adaptive crop size
+            const auto faceRoiCache = (wrapperStructFace.enable && wrapperStructFace.roiCacheMaxSkip > 0);
+            const auto handRoiCache = (wrapperStructHand.enable && wrapperStructHand.roiCacheMaxSkip > 0);
+            if (wrapperStructFace.roiCacheMaxSkip < 0 || wrapperStructHand.roiCacheMaxSkip < 0)
+                error("The face and hand ROI cache (`--face_hand_roi_cache`) cannot be negative.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if ((faceRoiCache || handRoiCache
+                 || (wrapperStructFace.enable && wrapperStructFace.adaptiveCropSize)
+                 || (wrapperStructHand.enable && wrapperStructHand.adaptiveCropSize))
+                && !wrapperStructPose.heatMapTypes.empty())
+                error("The face and hand ROI cache (`--face_hand_roi_cache`) and adaptive crop size"
+                      " (`--face_hand_adaptive_crop`) are not compatible with the heat maps (`--heatmaps_add_*`).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if ((faceRoiCache || handRoiCache) && !wrapperStructExtra.identification
+                && wrapperStructExtra.tracking < 0)
+                opLog("Warning: The face and hand ROI cache (`--face_hand_roi_cache`) requires the person IDs of"
+                      " `--identification` or `--tracking`, so it has no effect without them.", Priority::High);
+            // BODY_135 face and hand keypoints
+            const auto faceFromBody = (wrapperStructFace.enable && wrapperStructFace.fromBodyThreshold >= 0.f);
+            const auto handFromBody = (wrapperStructHand.enable && wrapperStructHand.fromBodyThreshold >= 0.f);
+            if (faceFromBody || handFromBody)
+            {
+                if (wrapperStructPose.poseMode == PoseMode::Disabled
+                    || wrapperStructPose.poseModel != PoseModel::BODY_135)
+                    error("Filling the face and hand keypoints from the body ones (`--face_hand_from_body`) requires"
+                          " the BODY_135 body model (`--model_pose BODY_135`).", __LINE__, __FUNCTION__, __FILE__);
+                if ((faceFromBody && wrapperStructFace.detector != Detector::Body)
+                    || (handFromBody && wrapperStructHand.detector != Detector::Body
+                        && wrapperStructHand.detector != Detector::BodyWithTracking))
+                    error("Filling the face and hand keypoints from the body ones (`--face_hand_from_body`) requires"
+                          " the body-based face and hand detectors (1 rectangle per person), i.e.,"
+                          " `--face_detector 0` and `--hand_detector 0` or `3`.", __LINE__, __FUNCTION__, __FILE__);
+                if (!wrapperStructPose.heatMapTypes.empty())
+                    error("Filling the face and hand keypoints from the body ones (`--face_hand_from_body`) is not"
+                          " compatible with the heat maps (`--heatmaps_add_*`).", __LINE__, __FUNCTION__, __FILE__);
+            }
+            if (wrapperStructHand.enable && wrapperStructHand.detector == Detector::Net)
+                error("The CNN rectangle detector (`--hand_detector 4`) is only implemented for the face. Select a"
+                      " different hand Detector (`--hand_detector`).", __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructFace.enable && wrapperStructFace.detector == Detector::Net
+                && wrapperStructFace.detectorScaleNumber < 1)
+                error("The number of scales of the CNN face detector (`--face_detector_scale_number`) must be at"
+                      " least 1.", __LINE__, __FUNCTION__, __FILE__);
             const auto ownDetectorProvided = (wrapperStructFace.detector == Detector::Provided
                                               || wrapperStructHand.detector == Detector::Provided);
             if (ownDetectorProvided && userInputAndPreprocessingWsEmpty
@@ -138,17 +256,533 @@ namespace op
                     " OpenPose will not detect face and/or hand keypoints based on the body keypoints. Are you sure"
                     " you want to keep enabled the body keypoint detector? (disable it with `--body 0`).",
                     Priority::High);
-            // If 3-D module, 1 person is the maximum
-            if (wrapperStructExtra.reconstruct3d && wrapperStructPose.numberPeopleMax != 1)
+            // If 3-D module, 1 person is the maximum (unless the people are associated across views)
+            if (wrapperStructExtra.reconstruct3d && !wrapperStructExtra.multiPerson3d
+                && wrapperStructPose.numberPeopleMax != 1)
             {
                 error("Set `--number_people_max 1` when using `--3d`. The 3-D reconstruction demo assumes there is"
-                      " at most 1 person on each image.", __LINE__, __FUNCTION__, __FILE__);
+                      " at most 1 person on each image (unless `--3d_multi_person` is enabled).",
+                      __LINE__, __FUNCTION__, __FILE__);
             }
-            // If CPU mode, #GPU cannot be > 0
-            if (getGpuMode() == GpuMode::NoGpu)
-                if (wrapperStructPose.gpuNumber > 0)
-                    error("GPU number must be negative or 0 if CPU_ONLY is enabled.",
+            if (wrapperStructExtra.multiPerson3d && !wrapperStructExtra.reconstruct3d)
+                opLog("The multi-person 3-D reconstruction (`--3d_multi_person`) only applies with `--3d`.",
+                      Priority::High);
+            if (wrapperStructExtra.temporal3d)
+            {
+                if (!wrapperStructExtra.reconstruct3d)
+                    opLog("The temporal 3-D reconstruction (`--3d_temporal`) only applies with `--3d`.",
+                          Priority::High);
+                else if (wrapperStructExtra.multiPerson3d && wrapperStructExtra.tracking < 0
+                         && !wrapperStructExtra.identification)
+                    opLog("The temporal 3-D reconstruction (`--3d_temporal`) with `--3d_multi_person` matches the"
+                          " people across frames by their ids, so without `--tracking` nor `--identification` it"
+                          " will always triangulate from scratch.", Priority::High);
+            }
+            if (wrapperStructExtra.viewGpuAffinity && !wrapperStructExtra.reconstruct3d)
+                opLog("The GPU affinity of the camera views (`--3d_gpu_affinity`) only applies with `--3d`.",
+                      Priority::High);
+            else if (wrapperStructExtra.viewGpuAffinity && wrapperStructExtra.spilloverWorkers > 0)
+                error("The GPU affinity of the camera views (`--3d_gpu_affinity`) cannot be combined with the CPU"
+                      " spillover workers (`--spillover_workers`).", __LINE__, __FUNCTION__, __FILE__);
+            // Keypoint extrapolation
+            if (wrapperStructExtra.trackingExtrapolation)
+            {
+                if (wrapperStructExtra.tracking < 1)
+                    opLog("The keypoint extrapolation (`--tracking_extrapolation`) only applies if `--tracking` > 0.",
+                          Priority::High);
+                else if (!wrapperStructExtra.identification && wrapperStructPose.numberPeopleMax != 1)
+                    error("Either person identification (`--identification`) must be enabled or"
+                          " `--number_people_max 1` in order to run the keypoint extrapolation"
+                          " (`--tracking_extrapolation`).", __LINE__, __FUNCTION__, __FILE__);
+            }
+            // Work-stealing thread pool
+            if (wrapperStructExtra.threadPool < -1)
+                error("The number of thread pool threads (`--thread_pool`) must be -1 (number of CPU cores), 0"
+                      " (disabled) or positive.", __LINE__, __FUNCTION__, __FILE__);
+            // Auto-configuration
+            if (wrapperStructExtra.autoConfigure < 0)
+                error("The number of auto-configuration frames (`--auto_configure`) must be 0 (disabled) or"
+                      " positive.", __LINE__, __FUNCTION__, __FILE__);
+            // Person crops
+            if (wrapperStructExtra.personCropSize.x > 0 || wrapperStructExtra.personCropSize.y > 0)
+            {
+                if (wrapperStructExtra.personCropSize.x < 1 || wrapperStructExtra.personCropSize.y < 1)
+                    error("Both the width and height of the person crops (`--person_crops`) must be positive, e.g.,"
+                          " `192x256`.", __LINE__, __FUNCTION__, __FILE__);
+                if (wrapperStructExtra.personCropScale <= 0.f)
+                    error("The person crop scale (`--person_crops_scale`) must be positive.",
                           __LINE__, __FUNCTION__, __FILE__);
+                if (wrapperStructPose.poseMode == PoseMode::Disabled)
+                    error("The person crops (`--person_crops`) require the body keypoint detector.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                #ifndef USE_CUDA
+                    error("The person crops (`--person_crops`) require OpenPose compiled with CUDA.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                #endif
+            }
+            // Stage-truncated body network
+            if (wrapperStructPose.netStages < 0)
+                error("The number of body network stages (`--net_stages`) must be 0 (all of them) or positive.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.netStages > 0)
+            {
+                const auto modelExtension = toLower(getFileExtension(wrapperStructPose.caffeModelPath.getStdString()));
+                if (modelExtension == "onnx" || modelExtension == "xml")
+                    error("The stage-truncated body network (`--net_stages`) requires a Caffe model, the ONNX and"
+                          " OpenVINO models are run as they are.", __LINE__, __FUNCTION__, __FILE__);
+                if (wrapperStructPose.poseMode != PoseMode::Enabled)
+                    opLog("The stage-truncated body network (`--net_stages`) only applies to the OpenPose body"
+                          " network (`--body 1`).", Priority::High);
+            }
+            // Tiled inference
+            if (wrapperStructPose.tiledInputSize.x != 0 || wrapperStructPose.tiledInputSize.y != 0)
+            {
+                if (wrapperStructPose.tileOverlap < 0.f || wrapperStructPose.tileOverlap >= 0.5f)
+                    error("The tile overlap (`--tile_overlap`) must be in the range [0, 0.5).",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (wrapperStructPose.tiledInputSize.x <= 0 && wrapperStructPose.tiledInputSize.y <= 0)
+                    error("At least 1 of the dimensions of the tiled resolution (`--tiled_resolution`) must be"
+                          " positive (e.g., `-1x2160`).", __LINE__, __FUNCTION__, __FILE__);
+                if (wrapperStructPose.poseMode != PoseMode::Enabled)
+                {
+                    opLog("The tiled inference (`--tiled_resolution`) requires the OpenPose body network"
+                          " (`--body 1`). OpenPose has automatically disabled it.", Priority::High);
+                    wrapperStructPose.tiledInputSize = Point<int>{0, 0};
+                }
+                else
+                {
+                    // Squared tiles if the tile size is dynamic
+                    if (wrapperStructPose.netInputSize.x <= 0)
+                        wrapperStructPose.netInputSize.x = wrapperStructPose.netInputSize.y;
+                    else if (wrapperStructPose.netInputSize.y <= 0)
+                        wrapperStructPose.netInputSize.y = wrapperStructPose.netInputSize.x;
+                    // The tiles of a frame already run as a single batch
+                    if (wrapperStructPose.scalesNumber > 1 || wrapperStructPose.batchSize > 1
+                        || wrapperStructPose.latencyTargetMs > 0. || wrapperStructPose.roiTrackingInterval > 1
+                        || wrapperStructPose.pipelined || !wrapperStructPose.netOutputCacheDirectory.empty())
+                    {
+                        opLog("The tiled inference (`--tiled_resolution`) is not compatible with `--scale_number`"
+                              " > 1, `--batch_size` > 1, `--latency_target`, `--roi_tracking_interval`,"
+                              " `--pose_pipelined` nor `--net_output_cache`. OpenPose has automatically disabled"
+                              " them.", Priority::High);
+                        wrapperStructPose.scalesNumber = 1;
+                        wrapperStructPose.batchSize = 1;
+                        wrapperStructPose.latencyTargetMs = 0.;
+                        wrapperStructPose.roiTrackingInterval = 0;
+                        wrapperStructPose.pipelined = false;
+                        wrapperStructPose.netOutputCacheDirectory = "";
+                    }
+                }
+            }
+            // Batched forward pass
+            if (wrapperStructPose.batchSize < 1)
+                error("The batch size (`--batch_size`) must be greater or equal than 1.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.batchSize > 1
+                && (wrapperStructPose.poseMode != PoseMode::Enabled || wrapperStructExtra.tracking > 0))
+            {
+                opLog("The batched forward pass (`--batch_size` > 1) requires the OpenPose body network (`--body 1`)"
+                    " and it is not compatible with `--tracking` > 0. OpenPose has automatically set"
+                    " `--batch_size 1`.", Priority::High);
+                wrapperStructPose.batchSize = 1;
+            }
+            // GPU memory budget
+            if (wrapperStructPose.gpuMemoryBudget < -1)
+                error("The GPU memory budget (`--gpu_memory_budget`) must be -1 (free GPU memory), 0 (disabled) or"
+                      " positive.", __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.gpuMemoryBudget != 0 && getGpuMode() != GpuMode::Cuda)
+            {
+                opLog("The GPU memory budget (`--gpu_memory_budget`) is only implemented for CUDA. OpenPose has"
+                      " automatically disabled it.", Priority::High);
+                wrapperStructPose.gpuMemoryBudget = 0;
+            }
+            // Warm-up
+            if (!wrapperStructPose.warmUpCacheFile.empty())
+                wrapperStructPose.warmUp = true;
+            if (wrapperStructPose.warmUp && wrapperStructPose.poseMode != PoseMode::Enabled)
+            {
+                opLog("The network warm-up (`--warm_up` and `--warm_up_cache`) requires the OpenPose body network"
+                      " (`--body 1`). OpenPose has automatically disabled it.", Priority::High);
+                wrapperStructPose.warmUp = false;
+                wrapperStructPose.warmUpCacheFile = "";
+            }
+            // Network memory sharing
+            if (wrapperStructPose.netMemorySharing && getGpuMode() != GpuMode::Cuda)
+            {
+                opLog("The network memory sharing (`--net_memory_sharing`) is only implemented for CUDA. OpenPose has"
+                      " automatically disabled it.", Priority::High);
+                wrapperStructPose.netMemorySharing = false;
+            }
+            // Shared body network
+            if (wrapperStructPose.sharedPool
+                && (wrapperStructPose.poseMode != PoseMode::Enabled || wrapperStructPose.roiTrackingInterval > 1))
+            {
+                opLog("The shared body network (`--pose_shared_pool`) requires the OpenPose body network (`--body 1`)"
+                      " and it is not compatible with `--roi_tracking_interval` > 1 (whose state is per video)."
+                      " OpenPose has automatically disabled it.", Priority::High);
+                wrapperStructPose.sharedPool = false;
+            }
+            // Multi-scale batch
+            if (wrapperStructPose.scaleBatch
+                && (wrapperStructPose.poseMode != PoseMode::Enabled || wrapperStructPose.scalesNumber < 2
+                    || wrapperStructPose.batchSize > 1))
+            {
+                opLog("The multi-scale batch (`--scale_batch`) requires the OpenPose body network (`--body 1`) and"
+                      " `--scale_number` > 1, and it is not compatible with `--batch_size` > 1. OpenPose has"
+                      " automatically disabled it.", Priority::High);
+                wrapperStructPose.scaleBatch = false;
+            }
+            // TensorRT backend
+            if (wrapperStructPose.tensorRtPrecision != 32 && wrapperStructPose.tensorRtPrecision != 16
+                && wrapperStructPose.tensorRtPrecision != 8)
+                error("The TensorRT precision (`--tensorrt_precision`) must be 32, 16 or 8.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // FP16 heat maps
+            if (wrapperStructPose.heatMapsFp16 && getGpuMode() != GpuMode::Cuda)
+            {
+                opLog("Half precision heat maps (`--heatmaps_fp16`) are only implemented for CUDA. OpenPose has"
+                      " automatically disabled it.", Priority::High);
+                wrapperStructPose.heatMapsFp16 = false;
+            }
+            // CUDA Graphs
+            if (wrapperStructPose.cudaGraphs && getGpuMode() != GpuMode::Cuda)
+            {
+                opLog("CUDA Graphs (`--cuda_graphs`) are only implemented for CUDA. OpenPose has automatically"
+                      " disabled them.", Priority::High);
+                wrapperStructPose.cudaGraphs = false;
+            }
+            // CUDA autotuning
+            if (!wrapperStructPose.cudaAutotuneCacheFile.empty() && getGpuMode() != GpuMode::Cuda)
+            {
+                opLog("The CUDA autotuning (`--cuda_autotune_cache`) is only implemented for CUDA. OpenPose has"
+                      " automatically disabled it.", Priority::High);
+                wrapperStructPose.cudaAutotuneCacheFile = "";
+            }
+            // Network resolution PAFs
+            if (wrapperStructPose.pafLowResolution && getGpuMode() != GpuMode::Cuda)
+            {
+                opLog("The network resolution PAFs (`--paf_low_resolution`) are only implemented for CUDA. OpenPose"
+                      " has automatically disabled them.", Priority::High);
+                wrapperStructPose.pafLowResolution = false;
+            }
+            // Lazy heat maps
+            if (wrapperStructPose.heatMapsLazy && getGpuMode() != GpuMode::Cuda)
+            {
+                opLog("The lazy heat maps (`--heatmaps_lazy`) are only implemented for CUDA. OpenPose has"
+                      " automatically disabled them.", Priority::High);
+                wrapperStructPose.heatMapsLazy = false;
+            }
+            // Sparse heat maps
+            if (wrapperStructPose.heatMapsSparseThreshold >= 0.f)
+            {
+                if (wrapperStructPose.heatMapTypes.empty())
+                    opLog("The sparse heat maps (`--heatmaps_sparse_threshold`) have no effect unless some heat maps"
+                          " are enabled (`--heatmaps_add_X` flags).", Priority::High);
+                if (wrapperStructPose.heatMapsLazy)
+                {
+                    opLog("The sparse heat maps (`--heatmaps_sparse_threshold`) are not compatible with the lazy heat"
+                          " maps (`--heatmaps_lazy`). OpenPose has automatically disabled the latter.",
+                          Priority::High);
+                    wrapperStructPose.heatMapsLazy = false;
+                }
+            }
+            // Network output cache
+            if (!wrapperStructPose.netOutputCacheDirectory.empty())
+            {
+                if (wrapperStructPose.poseMode != PoseMode::Enabled)
+                {
+                    opLog("The network output cache (`--net_output_cache`) requires the OpenPose body network"
+                          " (`--body 1`). OpenPose has automatically disabled it.", Priority::High);
+                    wrapperStructPose.netOutputCacheDirectory = "";
+                }
+                else if (wrapperStructPose.batchSize > 1)
+                    opLog("The network output cache (`--net_output_cache`) is not used with `--batch_size` > 1.",
+                          Priority::High);
+            }
+            // Adaptive network resolution
+            if (wrapperStructPose.latencyTargetMs < 0.)
+                error("The latency target (`--latency_target`) must be 0 (disabled) or positive.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.latencyTargetMs > 0.)
+            {
+                #if defined USE_MKL || defined USE_OPENCL
+                    opLog("The adaptive network resolution (`--latency_target`) is not supported in MKL (MKL CPU"
+                          " Caffe) and OpenCL Caffe versions (the network cannot be reshaped). OpenPose has"
+                          " automatically disabled it.", Priority::High);
+                    wrapperStructPose.latencyTargetMs = 0.;
+                #else
+                    if (wrapperStructPose.poseMode != PoseMode::Enabled)
+                    {
+                        opLog("The adaptive network resolution (`--latency_target`) requires the OpenPose body"
+                              " network (`--body 1`). OpenPose has automatically disabled it.", Priority::High);
+                        wrapperStructPose.latencyTargetMs = 0.;
+                    }
+                #endif
+            }
+            // ROI tracking mode
+            if (wrapperStructPose.roiTrackingInterval < 0)
+                error("The ROI tracking interval (`--roi_tracking_interval`) must be 0 (disabled) or positive.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.roiTrackingInterval > 1)
+            {
+                if (wrapperStructPose.poseMode != PoseMode::Enabled || wrapperStructPose.batchSize > 1
+                    || !wrapperStructPose.heatMapTypes.empty() || wrapperStructPose.addPartCandidates
+                    || wrapperStructPose.heatMapsFp16)
+                {
+                    opLog("The ROI tracking mode (`--roi_tracking_interval` > 1) requires the OpenPose body network"
+                          " (`--body 1`) and it is not compatible with `--batch_size` > 1, the heat maps,"
+                          " `--part_candidates` nor `--heatmaps_fp16`. OpenPose has automatically disabled it.",
+                          Priority::High);
+                    wrapperStructPose.roiTrackingInterval = 0;
+                }
+                else if (wrapperStructInput.producerType != ProducerType::Video
+                         && wrapperStructInput.producerType != ProducerType::Webcam
+                         && wrapperStructInput.producerType != ProducerType::IPCamera
+                         && wrapperStructInput.producerType != ProducerType::FlirCamera
+                         && wrapperStructInput.producerType != ProducerType::Replay
+                         && wrapperStructInput.producerType != ProducerType::SharedMemory)
+                    opLog("The ROI tracking mode (`--roi_tracking_interval` > 1) assumes consecutive frames of a"
+                          " video or camera.", Priority::High);
+            }
+            // Motion gate
+            if (wrapperStructPose.motionGateRatio < 0. || wrapperStructPose.motionGateRatio > 1.)
+                error("The motion gate ratio (`--motion_gate`) must be in the range [0, 1].",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.motionGateRatio > 0.)
+            {
+                if (wrapperStructPose.motionGatePixelThreshold < 0 || wrapperStructPose.motionGateMaxSkip < 0)
+                    error("The motion gate pixel threshold (`--motion_gate_pixel_threshold`) and maximum number of"
+                          " skipped frames (`--motion_gate_max_skip`) must be 0 or positive.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (wrapperStructPose.poseMode != PoseMode::Enabled || wrapperStructPose.batchSize > 1
+                    || !wrapperStructPose.heatMapTypes.empty() || wrapperStructPose.addPartCandidates)
+                {
+                    opLog("The motion gate (`--motion_gate` > 0) requires the OpenPose body network (`--body 1`) and"
+                          " it is not compatible with `--batch_size` > 1, the heat maps, nor `--part_candidates`."
+                          " OpenPose has automatically disabled it.", Priority::High);
+                    wrapperStructPose.motionGateRatio = 0.;
+                }
+                else if (wrapperStructInput.producerType != ProducerType::Video
+                         && wrapperStructInput.producerType != ProducerType::Webcam
+                         && wrapperStructInput.producerType != ProducerType::IPCamera
+                         && wrapperStructInput.producerType != ProducerType::FlirCamera
+                         && wrapperStructInput.producerType != ProducerType::Replay
+                         && wrapperStructInput.producerType != ProducerType::SharedMemory
+                         && wrapperStructInput.producerType != ProducerType::None)
+                    opLog("The motion gate (`--motion_gate` > 0) assumes consecutive frames of a video or camera.",
+                          Priority::High);
+            }
+            // Pipelined forward pass
+            if (wrapperStructPose.pipelined)
+            {
+                if (getGpuMode() != GpuMode::Cuda || wrapperStructPose.gpuNumber == 0)
+                {
+                    opLog("The pipelined forward pass (`--pose_pipelined`) is only implemented for CUDA. OpenPose has"
+                          " automatically disabled it.", Priority::High);
+                    wrapperStructPose.pipelined = false;
+                }
+                else if (wrapperStructPose.poseMode != PoseMode::Enabled || wrapperStructPose.batchSize > 1
+                         || wrapperStructPose.motionGateRatio > 0. || wrapperStructPose.roiTrackingInterval > 1
+                         || wrapperStructExtra.tracking > 0)
+                {
+                    opLog("The pipelined forward pass (`--pose_pipelined`) requires the OpenPose body network"
+                          " (`--body 1`) and it is not compatible with `--batch_size` > 1, `--motion_gate` > 0,"
+                          " `--roi_tracking_interval` > 1 nor `--tracking` > 0. OpenPose has automatically disabled"
+                          " it.", Priority::High);
+                    wrapperStructPose.pipelined = false;
+                }
+            }
+            // Adaptive multi-scale
+            if (wrapperStructPose.scaleAdaptiveHeight < 0.f)
+                error("The adaptive multi-scale height (`--scale_adaptive`) must be 0 or positive.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.scaleAdaptiveHeight > 0.f)
+            {
+                if (wrapperStructPose.scalesNumber < 2)
+                    opLog("The adaptive multi-scale mode (`--scale_adaptive` > 0) only has effect with"
+                          " `--scale_number` > 1.", Priority::High);
+                else if (wrapperStructPose.poseMode != PoseMode::Enabled || wrapperStructPose.batchSize > 1
+                         || wrapperStructPose.pipelined || wrapperStructPose.roiTrackingInterval > 1)
+                {
+                    opLog("The adaptive multi-scale mode (`--scale_adaptive` > 0) requires the OpenPose body"
+                          " network (`--body 1`) and it is not compatible with `--batch_size` > 1,"
+                          " `--pose_pipelined` nor `--roi_tracking_interval` > 1. OpenPose has automatically"
+                          " disabled it.", Priority::High);
+                    wrapperStructPose.scaleAdaptiveHeight = 0.f;
+                }
+            }
+            // NVDEC video decoding
+            if (wrapperStructInput.nvDecode)
+            {
+                if (getGpuMode() != GpuMode::Cuda)
+                    error("NVDEC video decoding (`--video_nvdec`) requires the CUDA version of OpenPose.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (wrapperStructInput.producerType != ProducerType::Video)
+                    error("NVDEC video decoding (`--video_nvdec`) is only available for video files (`--video`).",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (wrapperStructInput.numberViews > 1)
+                    error("NVDEC video decoding (`--video_nvdec`) is not compatible with `--3d_views` > 1.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (wrapperStructPose.gpuNumber == 0 || wrapperStructPose.poseMode != PoseMode::Enabled)
+                    opLog("NVDEC video decoding (`--video_nvdec`) only avoids the CPU frame copies when the body"
+                          " keypoint detector runs on the GPU.", Priority::High);
+            }
+            // FLIR GPU debayering
+            if (wrapperStructInput.flirBayerGpu)
+            {
+                if (getGpuMode() != GpuMode::Cuda)
+                    error("FLIR GPU debayering (`--flir_camera_bayer_gpu`) requires the CUDA version of OpenPose.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (wrapperStructInput.producerType != ProducerType::FlirCamera)
+                    error("FLIR GPU debayering (`--flir_camera_bayer_gpu`) is only available for FLIR cameras"
+                          " (`--flir_camera`).", __LINE__, __FUNCTION__, __FILE__);
+                if (wrapperStructPose.gpuNumber == 0 || wrapperStructPose.poseMode != PoseMode::Enabled)
+                    opLog("FLIR GPU debayering (`--flir_camera_bayer_gpu`) only avoids the CPU debayering when the"
+                          " body keypoint detector runs on the GPU.", Priority::High);
+            }
+            if (wrapperStructInput.flirSyncToleranceMs < 0.)
+                error("The FLIR camera synchronization tolerance (`--flir_camera_sync_ms`) must be 0 or positive.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Keypoint-only undistortion
+            if (wrapperStructInput.undistortKeypoints)
+            {
+                if (wrapperStructInput.undistortImage)
+                    error("`--frame_undistort_keypoints` is an alternative to `--frame_undistort`, they cannot be"
+                          " simultaneously enabled.", __LINE__, __FUNCTION__, __FILE__);
+                if (!wrapperStructExtra.reconstruct3d)
+                    opLog("`--frame_undistort_keypoints` only affects the 3-D reconstruction (`--3d`).",
+                          Priority::High);
+            }
+            // Static region of interest (the frames are cropped in CPU memory by CvMatToOpInput)
+            if (!wrapperStructInput.inputRoi.empty()
+                && (wrapperStructInput.nvDecode || wrapperStructInput.flirBayerGpu))
+                error("The input region of interest (`--input_roi`) requires the frames in CPU memory, so it is not"
+                      " compatible with `--video_nvdec` nor `--flir_camera_bayer_gpu`.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Adaptive multi-scale (the crops are taken from the frames in CPU memory)
+            if (wrapperStructPose.scaleAdaptiveHeight > 0.f && wrapperStructPose.scalesNumber > 1
+                && (wrapperStructInput.nvDecode || wrapperStructInput.flirBayerGpu))
+                error("The adaptive multi-scale mode (`--scale_adaptive` > 0) requires the frames in CPU memory, so"
+                      " it is not compatible with `--video_nvdec` nor `--flir_camera_bayer_gpu`.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Parallel image decoding
+            if (wrapperStructInput.imageDecodingThreads < 0)
+                error("The number of image decoding threads (`--image_dir_threads`) must be 0 or positive.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructInput.imageDecodingThreads > 0
+                && wrapperStructInput.producerType != ProducerType::ImageDirectory)
+                opLog("The number of image decoding threads (`--image_dir_threads`) only affects `--image_dir`.",
+                      Priority::High);
+            // Streaming directory listing
+            if (wrapperStructInput.imageDirectoryStream)
+            {
+                if (wrapperStructInput.producerType != ProducerType::ImageDirectory)
+                    opLog("The directory streaming (`--image_dir_stream`) only affects `--image_dir`.",
+                          Priority::High);
+                else if (wrapperStructInput.frameLast != std::numeric_limits<unsigned long long>::max())
+                    error("The number of images is unknown while the directory is listed, so `--image_dir_stream` is"
+                          " not compatible with `--frame_last`.", __LINE__, __FUNCTION__, __FILE__);
+            }
+            // Parallel video decoding
+            if (wrapperStructInput.videoDecoders < 0 || wrapperStructInput.videoSegmentFrames < 1)
+                error("The number of video decoders (`--video_decoders`) must be 0 or positive, and the number of"
+                      " frames per segment (`--video_segment_frames`) positive.", __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructInput.videoDecoders > 0
+                && (wrapperStructInput.producerType != ProducerType::Video || wrapperStructInput.nvDecode))
+                opLog("The number of video decoders (`--video_decoders`) only affects `--video` without"
+                      " `--video_nvdec`.", Priority::High);
+            if (wrapperStructInput.videoDecoders > 0 && wrapperStructInput.realTimeProcessing)
+                opLog("The parallel video decoding (`--video_decoders`) is meant for offline processing, with"
+                      " `--process_real_time` the frames skipped to keep the real-time speed are still decoded.",
+                      Priority::High);
+            // Input recording and replay
+            if (!wrapperStructInput.inputRecordPath.empty()
+                && wrapperStructInput.producerType == ProducerType::None)
+                opLog("The input recording (`--input_record`) only records the frames of the OpenPose producer, so it"
+                      " has no effect with a custom input.", Priority::High);
+            if (wrapperStructInput.producerType == ProducerType::Replay
+                && (wrapperStructInput.frameFlip || wrapperStructInput.frameRotate != 0))
+                opLog("The frames of an input replay (`--input_replay`) already include the flip and rotation of the"
+                      " recording, so `--frame_flip` and `--frame_rotate` are applied on top of them.",
+                      Priority::High);
+            // Shared memory input
+            if (wrapperStructInput.producerType == ProducerType::SharedMemory
+                && (wrapperStructInput.frameFlip || wrapperStructInput.frameRotate != 0
+                    || wrapperStructInput.undistortImage))
+                opLog("`--frame_flip`, `--frame_rotate` and `--frame_undistort` copy each frame of the shared memory"
+                      " input (`--shm_input`) rather than reading it in place.", Priority::High);
+            // Datum pool
+            if (wrapperStructInput.datumPoolSize < 0)
+                error("The Datum pool size (`--datum_pool_size`) must be 0 or positive.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Frame credits
+            if (wrapperStructInput.decodeAhead < -1)
+                error("The number of frames decoded ahead (`--decode_ahead`) must be -1 (disabled), 0 or positive.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructInput.decodeAhead >= 0 && wrapperStructInput.producerType != ProducerType::Video
+                && wrapperStructInput.producerType != ProducerType::ImageDirectory
+                && wrapperStructInput.producerType != ProducerType::Replay)
+                opLog("The frames decoded ahead (`--decode_ahead`) only apply to videos, image directories and input"
+                      " replays, the camera producers already keep up with their frame rate.", Priority::High);
+            // Pipeline-parallel face and hand
+            if (wrapperStructExtra.faceHandGpu < -1)
+                error("The face and hand GPU (`--face_hand_gpu`) must be -1 (disabled), 0 or positive.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructExtra.faceHandGpu >= 0)
+            {
+                if (!wrapperStructFace.enable && !wrapperStructHand.enable)
+                    opLog("The face and hand GPU (`--face_hand_gpu`) is ignored, since neither face nor hand are"
+                          " enabled.", Priority::High);
+                else if (getGpuMode() != GpuMode::Cuda)
+                    opLog("The face and hand GPU (`--face_hand_gpu`) is ignored in CPU-only mode.", Priority::High);
+                else if (wrapperStructExtra.faceHandGpu >= wrapperStructPose.gpuNumberStart
+                         && (wrapperStructPose.gpuNumber < 0
+                             || wrapperStructExtra.faceHandGpu
+                                < wrapperStructPose.gpuNumberStart + wrapperStructPose.gpuNumber))
+                    opLog("The face and hand GPU (`--face_hand_gpu`) is also used by the body. For lower latency,"
+                          " exclude it from the body GPUs (`--num_gpu` and `--num_gpu_start`).", Priority::High);
+            }
+            // CPU spillover workers
+            if (wrapperStructExtra.spilloverWorkers < 0)
+                error("The number of spillover workers (`--spillover_workers`) must be 0 or positive.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructExtra.spilloverWorkers > 0)
+            {
+                const auto modelExtension = toLower(getFileExtension(
+                    wrapperStructExtra.spilloverModelPath.getStdString()));
+                if (getGpuMode() != GpuMode::Cuda)
+                    opLog("The spillover workers (`--spillover_workers`) are ignored in CPU-only mode, where all the"
+                          " pose workers already run on CPU (`--num_gpu`).", Priority::High);
+                else if (modelExtension != "xml" && modelExtension != "onnx")
+                    error("The spillover workers (`--spillover_workers`) require an OpenVINO model"
+                          " (`--spillover_model`, .xml or .onnx).", __LINE__, __FUNCTION__, __FILE__);
+                else if ((wrapperStructFace.enable || wrapperStructHand.enable) && wrapperStructExtra.faceHandGpu < 0)
+                    error("The spillover workers (`--spillover_workers`) only run the body network, so the face and"
+                          " hand must run on their own GPU thread (`--face_hand_gpu`).",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (wrapperStructExtra.spilloverQueueSize < 0)
+                    error("The spillover queue size (`--spillover_queue`) must be 0 or positive.",
+                          __LINE__, __FUNCTION__, __FILE__);
+            }
+            // V4L2 webcam
+            if (wrapperStructInput.cameraV4l2 && wrapperStructInput.producerType != ProducerType::Webcam)
+                error("The V4L2 webcam reader (`--camera_v4l2`) only applies to the webcam producer (`--camera`).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructInput.cameraV4l2Fps < 0)
+                error("The V4L2 webcam frame rate (`--camera_v4l2_fps`) must be 0 (driver default) or positive.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // If CPU mode, #GPU is the number of CPU workers
+            if (getGpuMode() == GpuMode::NoGpu)
+            {
+                if (wrapperStructPose.gpuNumber > 1 && wrapperStructExtra.cpuWorkerThreads > 0
+                    && wrapperStructPose.gpuNumber * wrapperStructExtra.cpuWorkerThreads
+                        > (int)std::thread::hardware_concurrency())
+                    opLog("The CPU pose workers (`--num_gpu`) times their compute threads (`--cpu_worker_threads`)"
+                          " exceed the number of CPU cores, so they will compete for them.", Priority::High);
+            }
+            else if (wrapperStructExtra.cpuWorkerThreads > 0)
+                opLog("The number of compute threads per CPU worker (`--cpu_worker_threads`) only applies to the"
+                      " CPU-only version.", Priority::High);
             // If num_gpu 0 --> output_resolution has no effect
             if (wrapperStructPose.gpuNumber == 0 &&
                 (wrapperStructPose.outputSize.x > 0 || wrapperStructPose.outputSize.y > 0))
@@ -197,6 +831,43 @@ namespace op
         }
     }
 
+    DatumField getDatumFields(
+        const WrapperStructPose& wrapperStructPose, const WrapperStructFace& wrapperStructFace,
+        const WrapperStructHand& wrapperStructHand, const WrapperStructExtra& wrapperStructExtra,
+        const WrapperStructInput& wrapperStructInput)
+    {
+        try
+        {
+            // Heat maps (also used by the face and hand extractors)
+            const auto heatMaps = !wrapperStructPose.heatMapTypes.empty();
+            auto datumFields = DatumField::None;
+            if (heatMaps)
+                datumFields = datumFields | DatumField::PoseHeatMaps;
+            if (wrapperStructPose.addPartCandidates)
+                datumFields = datumFields | DatumField::PoseCandidates;
+            // Face and hand
+            if (wrapperStructFace.enable)
+                datumFields = datumFields | DatumField::Face | (heatMaps ? DatumField::FaceHeatMaps : DatumField::None);
+            if (wrapperStructHand.enable)
+                datumFields = datumFields | DatumField::Hand | (heatMaps ? DatumField::HandHeatMaps : DatumField::None);
+            // 3-D reconstruction and camera parameters (read by the producer)
+            if (wrapperStructExtra.reconstruct3d)
+                datumFields = datumFields | DatumField::Keypoints3D;
+            if (wrapperStructExtra.reconstruct3d || wrapperStructInput.undistortImage
+                || wrapperStructInput.undistortKeypoints || !wrapperStructInput.inputRecordPath.empty())
+                datumFields = datumFields | DatumField::CameraParameters;
+            // Adam (inverse kinematics)
+            if (wrapperStructExtra.ikThreads > 0)
+                datumFields = datumFields | DatumField::Adam;
+            return datumFields;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return DatumField::All;
+        }
+    }
+
     void threadIdPP(unsigned long long& threadId, const bool multiThreadEnabled)
     {
         try
@@ -4,12 +4,38 @@ namespace op
 {
     WrapperStructExtra::WrapperStructExtra(
         const bool reconstruct3d_, const int minViews3d_, const bool identification_, const int tracking_,
-        const int ikThreads_) :
+        const int ikThreads_, const int threadPool_, const bool gpuNumaAffinity_,
+        const ThreadPriority gpuThreadPriority_, const int cpuWorkerThreads_, const bool gpuDispatch_,
+        const double reorderWindowMs_, const bool trackingExtrapolation_, const bool multiPerson3d_,
+        const int autoConfigure_, const Point<int>& personCropSize_, const float personCropScale_,
+        const bool personCropAlign_, const bool personCropDownload_, const int faceHandGpu_,
+        const int spilloverWorkers_, const String& spilloverModelPath_, const int spilloverQueueSize_,
+        const bool temporal3d_, const bool viewGpuAffinity_, const QueueType queueType_) :
         reconstruct3d{reconstruct3d_},
         minViews3d{minViews3d_},
         identification{identification_},
         tracking{tracking_},
-        ikThreads{ikThreads_}
+        ikThreads{ikThreads_},
+        threadPool{threadPool_},
+        gpuNumaAffinity{gpuNumaAffinity_},
+        gpuThreadPriority{gpuThreadPriority_},
+        cpuWorkerThreads{cpuWorkerThreads_},
+        gpuDispatch{gpuDispatch_},
+        reorderWindowMs{reorderWindowMs_},
+        trackingExtrapolation{trackingExtrapolation_},
+        multiPerson3d{multiPerson3d_},
+        autoConfigure{autoConfigure_},
+        personCropSize{personCropSize_},
+        personCropScale{personCropScale_},
+        personCropAlign{personCropAlign_},
+        personCropDownload{personCropDownload_},
+        faceHandGpu{faceHandGpu_},
+        spilloverWorkers{spilloverWorkers_},
+        spilloverModelPath{spilloverModelPath_},
+        spilloverQueueSize{spilloverQueueSize_},
+        temporal3d{temporal3d_},
+        viewGpuAffinity{viewGpuAffinity_},
+        queueType{queueType_}
     {
     }
 }
@@ -4,14 +4,24 @@ namespace op
 {
     WrapperStructFace::WrapperStructFace(
         const bool enable_, const Detector detector_, const Point<int>& netInputSize_, const RenderMode renderMode_,
-        const float alphaKeypoint_, const float alphaHeatMap_, const float renderThreshold_) :
+        const float alphaKeypoint_, const float alphaHeatMap_, const float renderThreshold_,
+        const Point<int>& detectorNetInputSize_, const int detectorScaleNumber_,
+        const int roiCacheMaxSkip_, const bool adaptiveCropSize_, const float fromBodyThreshold_,
+        const bool startEnabled_, const double lazyIdleSeconds_) :
         enable{enable_},
         detector{detector_},
         netInputSize{netInputSize_},
         renderMode{renderMode_},
         alphaKeypoint{alphaKeypoint_},
         alphaHeatMap{alphaHeatMap_},
-        renderThreshold{renderThreshold_}
+        renderThreshold{renderThreshold_},
+        detectorNetInputSize{detectorNetInputSize_},
+        detectorScaleNumber{detectorScaleNumber_},
+        roiCacheMaxSkip{roiCacheMaxSkip_},
+        adaptiveCropSize{adaptiveCropSize_},
+        fromBodyThreshold{fromBodyThreshold_},
+        startEnabled{startEnabled_},
+        lazyIdleSeconds{lazyIdleSeconds_}
     {
     }
 }
@@ -3,10 +3,14 @@
 namespace op
 {
     WrapperStructGui::WrapperStructGui(
-        const DisplayMode displayMode_, const bool guiVerbose_, const bool fullScreen_) :
+        const DisplayMode displayMode_, const bool guiVerbose_, const bool fullScreen_, const bool vSync_,
+        const bool skipStaleFrames_, const bool overlay_) :
         displayMode{displayMode_},
         guiVerbose{guiVerbose_},
-        fullScreen{fullScreen_}
+        fullScreen{fullScreen_},
+        vSync{vSync_},
+        skipStaleFrames{skipStaleFrames_},
+        overlay{overlay_}
     {
     }
 }
@@ -5,7 +5,9 @@ namespace op
     WrapperStructHand::WrapperStructHand(
         const bool enable_, const Detector detector_, const Point<int>& netInputSize_, const int scalesNumber_,
         const float scaleRange_, const RenderMode renderMode_, const float alphaKeypoint_, const float alphaHeatMap_,
-        const float renderThreshold_) :
+        const float renderThreshold_, const bool concurrentWithFace_, const int roiCacheMaxSkip_,
+        const bool adaptiveCropSize_, const float fromBodyThreshold_,
+        const bool startEnabled_, const double lazyIdleSeconds_) :
         enable{enable_},
         detector{detector_},
         netInputSize{netInputSize_},
@@ -14,7 +16,13 @@ namespace op
         renderMode{renderMode_},
         alphaKeypoint{alphaKeypoint_},
         alphaHeatMap{alphaHeatMap_},
-        renderThreshold{renderThreshold_}
+        renderThreshold{renderThreshold_},
+        concurrentWithFace{concurrentWithFace_},
+        roiCacheMaxSkip{roiCacheMaxSkip_},
+        adaptiveCropSize{adaptiveCropSize_},
+        fromBodyThreshold{fromBodyThreshold_},
+        startEnabled{startEnabled_},
+        lazyIdleSeconds{lazyIdleSeconds_}
     {
     }
 }
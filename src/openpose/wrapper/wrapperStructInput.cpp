@@ -6,7 +6,14 @@ namespace op
         const ProducerType producerType_, const String& producerString_, const unsigned long long frameFirst_,
         const unsigned long long frameStep_, const unsigned long long frameLast_, const bool realTimeProcessing_,
         const bool frameFlip_, const int frameRotate_, const bool framesRepeat_, const Point<int>& cameraResolution_,
-        const String& cameraParameterPath_, const bool undistortImage_, const int numberViews_) :
+        const String& cameraParameterPath_, const bool undistortImage_, const int numberViews_,
+        const bool nvDecode_, const int imageDecodingThreads_, const int datumPoolSize_,
+        const bool flirBayerGpu_, const double flirSyncToleranceMs_,
+        const bool undistortKeypoints_, const String& inputRecordPath_, const String& inputRecordFormat_,
+        const int videoDecoders_, const int videoSegmentFrames_, const bool imageDirectoryStream_,
+        const String& inputRoi_, const String& sourcePriority_, const String& sourceMaxLatencyMs_,
+        const int decodeAhead_, const bool cameraV4l2_, const int cameraV4l2Fps_, const String& datumReceive_,
+        const int datumReceiveWindow_) :
         producerType{producerType_},
         producerString{producerString_},
         frameFirst{frameFirst_},
@@ -19,7 +26,26 @@ namespace op
         cameraResolution{cameraResolution_},
         cameraParameterPath{cameraParameterPath_},
         undistortImage{undistortImage_},
-        numberViews{numberViews_}
+        numberViews{numberViews_},
+        nvDecode{nvDecode_},
+        imageDecodingThreads{imageDecodingThreads_},
+        datumPoolSize{datumPoolSize_},
+        flirBayerGpu{flirBayerGpu_},
+        flirSyncToleranceMs{flirSyncToleranceMs_},
+        undistortKeypoints{undistortKeypoints_},
+        inputRecordPath{inputRecordPath_},
+        inputRecordFormat{inputRecordFormat_},
+        videoDecoders{videoDecoders_},
+        videoSegmentFrames{videoSegmentFrames_},
+        imageDirectoryStream{imageDirectoryStream_},
+        inputRoi{inputRoi_},
+        sourcePriority{sourcePriority_},
+        sourceMaxLatencyMs{sourceMaxLatencyMs_},
+        decodeAhead{decodeAhead_},
+        cameraV4l2{cameraV4l2_},
+        cameraV4l2Fps{cameraV4l2Fps_},
+        datumReceive{datumReceive_},
+        datumReceiveWindow{datumReceiveWindow_}
     {
     }
 }
@@ -9,7 +9,14 @@ namespace op
         const String& writeVideo_, const double writeVideoFps_, const bool writeVideoWithAudio_,
         const String& writeHeatMaps_, const String& writeHeatMapsFormat_, const String& writeVideo3D_,
         const String& writeVideoAdam_, const String& writeBvh_, const String& udpHost_,
-        const String& udpPort_) :
+        const String& udpPort_, const int metricsPort_, const String& traceFile_,
+        const String& writeBinary_, const int writeThreads_, const String& writeVideoEncoder_,
+        const String& streamKeypointsUdp_, const String& streamKeypointsShm_, const String& writeCocoJsonEval_,
+        const bool writeJpgGpu_, const String& streamVideo_, const String& streamVideoEncoder_,
+        const float streamKeypointsPrecision_, const float streamKeypointsPrecision3D_,
+        const int streamKeypointsKeyframe_, const bool allocationMetrics_, const bool keepRenderTargetGpu_,
+        const String& datumSend_, const DatumWireField datumSendFields_, const int datumSendJpegQuality_,
+        const bool datumTiming_) :
         verbose{verbose_},
         writeKeypoint{writeKeypoint_},
         writeKeypointFormat{writeKeypointFormat_},
@@ -28,7 +35,27 @@ namespace op
         writeVideoAdam{writeVideoAdam_},
         writeBvh{writeBvh_},
         udpHost{udpHost_},
-        udpPort{udpPort_}
+        udpPort{udpPort_},
+        metricsPort{metricsPort_},
+        traceFile{traceFile_},
+        writeBinary{writeBinary_},
+        writeThreads{writeThreads_},
+        writeVideoEncoder{writeVideoEncoder_},
+        streamKeypointsUdp{streamKeypointsUdp_},
+        streamKeypointsShm{streamKeypointsShm_},
+        writeCocoJsonEval{writeCocoJsonEval_},
+        writeJpgGpu{writeJpgGpu_},
+        streamVideo{streamVideo_},
+        streamVideoEncoder{streamVideoEncoder_},
+        streamKeypointsPrecision{streamKeypointsPrecision_},
+        streamKeypointsPrecision3D{streamKeypointsPrecision3D_},
+        streamKeypointsKeyframe{streamKeypointsKeyframe_},
+        allocationMetrics{allocationMetrics_},
+        keepRenderTargetGpu{keepRenderTargetGpu_},
+        datumSend{datumSend_},
+        datumSendFields{datumSendFields_},
+        datumSendJpegQuality{datumSendJpegQuality_},
+        datumTiming{datumTiming_}
     {
         try
         {
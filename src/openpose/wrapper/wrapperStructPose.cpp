@@ -11,7 +11,16 @@ namespace op
         const std::vector<HeatMapType>& heatMapTypes_, const ScaleMode heatMapScaleMode_,
         const bool addPartCandidates_, const float renderThreshold_, const int numberPeopleMax_,
         const bool maximizePositives_, const double fpsMax_, const String& protoTxtPath_,
-        const String& caffeModelPath_, const float upsamplingRatio_, const bool enableGoogleLogging_) :
+        const String& caffeModelPath_, const float upsamplingRatio_, const bool enableGoogleLogging_,
+        const int batchSize_, const long long batchMaxWaitMicroseconds_, const int tensorRtPrecision_,
+        const bool heatMapsFp16_, const double latencyTargetMs_, const Point<int>& netInputSizeMin_,
+        const int roiTrackingInterval_, const bool scaleBatch_, const double motionGateRatio_,
+        const int motionGatePixelThreshold_, const int motionGateMaxSkip_, const bool cudaGraphs_,
+        const bool pipelined_, const bool pafLowResolution_, const bool heatMapsLazy_,
+        const String& netOutputCacheDirectory_, const int gpuMemoryBudget_, const bool warmUp_,
+        const String& warmUpCacheFile_, const bool netMemorySharing_, const Point<int>& tiledInputSize_,
+        const float tileOverlap_, const int netStages_, const float scaleAdaptiveHeight_,
+        const bool sharedPool_, const String& cudaAutotuneCacheFile_, const float heatMapsSparseThreshold_) :
         poseMode{poseMode_},
         netInputSize{netInputSize_},
         netInputSizeDynamicBehavior{netInputSizeDynamicBehavior_},
@@ -38,7 +47,34 @@ namespace op
         protoTxtPath{protoTxtPath_},
         caffeModelPath{caffeModelPath_},
         upsamplingRatio{upsamplingRatio_},
-        enableGoogleLogging{enableGoogleLogging_}
+        enableGoogleLogging{enableGoogleLogging_},
+        batchSize{batchSize_},
+        batchMaxWaitMicroseconds{batchMaxWaitMicroseconds_},
+        tensorRtPrecision{tensorRtPrecision_},
+        heatMapsFp16{heatMapsFp16_},
+        latencyTargetMs{latencyTargetMs_},
+        netInputSizeMin{netInputSizeMin_},
+        roiTrackingInterval{roiTrackingInterval_},
+        scaleBatch{scaleBatch_},
+        motionGateRatio{motionGateRatio_},
+        motionGatePixelThreshold{motionGatePixelThreshold_},
+        motionGateMaxSkip{motionGateMaxSkip_},
+        cudaGraphs{cudaGraphs_},
+        pipelined{pipelined_},
+        pafLowResolution{pafLowResolution_},
+        heatMapsLazy{heatMapsLazy_},
+        netOutputCacheDirectory{netOutputCacheDirectory_},
+        gpuMemoryBudget{gpuMemoryBudget_},
+        warmUp{warmUp_},
+        warmUpCacheFile{warmUpCacheFile_},
+        netMemorySharing{netMemorySharing_},
+        tiledInputSize{tiledInputSize_},
+        tileOverlap{tileOverlap_},
+        netStages{netStages_},
+        scaleAdaptiveHeight{scaleAdaptiveHeight_},
+        sharedPool{sharedPool_},
+        cudaAutotuneCacheFile{cudaAutotuneCacheFile_},
+        heatMapsSparseThreshold{heatMapsSparseThreshold_}
     {
     }
 }
@@ -0,0 +1,17 @@
+#include <openpose/wrapper/wrapperStructRuntime.hpp>
+
+namespace op
+{
+    WrapperStructRuntime::WrapperStructRuntime(
+        const Point<int>& netInputSize_, const int face_, const int hand_, const int blendOriginalFrame_,
+        const float alphaKeypoint_, const float alphaHeatMap_, const int elementToRender_) :
+        netInputSize{netInputSize_},
+        face{face_},
+        hand{hand_},
+        blendOriginalFrame{blendOriginalFrame_},
+        alphaKeypoint{alphaKeypoint_},
+        alphaHeatMap{alphaHeatMap_},
+        elementToRender{elementToRender_}
+    {
+    }
+}